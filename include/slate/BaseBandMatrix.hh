@@ -61,6 +61,9 @@ public:
     Matrix<scalar_t> sub(int64_t i1, int64_t i2,
                          int64_t j1, int64_t j2);
 
+    void insertLocalTiles(Target origin=Target::Host);
+    void insertLocalTilesLazy(Target origin=Target::Host);
+
     void tileUpdateAllOrigin();
 
 protected:
@@ -289,6 +292,78 @@ void BaseBandMatrix<scalar_t>::reserveDeviceWorkspace()
     this->storage_->reserveDeviceWorkspace( getMaxDeviceTiles() );
 }
 
+//------------------------------------------------------------------------------
+/// Inserts all local tiles that touch the band into an empty matrix.
+///
+/// @param[in] origin
+///     - if origin = Devices, inserts tiles on appropriate GPU devices, or
+///     - if origin = Host,    inserts tiles on CPU host.
+///
+// todo: assumes uniform tile sizes.
+template <typename scalar_t>
+void BaseBandMatrix<scalar_t>::insertLocalTiles(Target origin)
+{
+    this->origin_ = origin;
+    bool on_devices = (origin == Target::Devices);
+    if (on_devices)
+        reserveDeviceWorkspace();
+
+    int64_t mt = this->mt();
+    int64_t nt = this->nt();
+    int64_t klt = ceildiv(
+            this->op() == Op::NoTrans ? this->kl_ : this->ku_, this->tileNb(0));
+    int64_t kut = ceildiv(
+            this->op() == Op::NoTrans ? this->ku_ : this->kl_, this->tileNb(0));
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t istart = blas::max( 0, j-kut );
+        int64_t iend   = blas::min( j+klt+1, mt );
+        for (int64_t i = istart; i < iend; ++i) {
+            if (this->tileIsLocal(i, j)) {
+                int dev = (on_devices ? this->tileDevice(i, j)
+                                      : HostNum);
+                this->tileInsert(i, j, dev);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inserts all local tiles that touch the band into an empty matrix,
+/// deferring allocation of each tile's data until it is first used,
+/// as by tileInsertLazy. Until written, tiles are zero, so tiles the
+/// application never sets, e.g., zero corner tiles when kl or ku isn't a
+/// multiple of nb, or fill-in tiles, are never allocated or transferred.
+///
+/// @param[in] origin
+///     - if origin = Devices, inserts tiles on appropriate GPU devices, or
+///     - if origin = Host,    inserts tiles on CPU host.
+///
+// todo: assumes uniform tile sizes.
+template <typename scalar_t>
+void BaseBandMatrix<scalar_t>::insertLocalTilesLazy(Target origin)
+{
+    this->origin_ = origin;
+    bool on_devices = (origin == Target::Devices);
+
+    int64_t mt = this->mt();
+    int64_t nt = this->nt();
+    int64_t klt = ceildiv(
+            this->op() == Op::NoTrans ? this->kl_ : this->ku_, this->tileNb(0));
+    int64_t kut = ceildiv(
+            this->op() == Op::NoTrans ? this->ku_ : this->kl_, this->tileNb(0));
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t istart = blas::max( 0, j-kut );
+        int64_t iend   = blas::min( j+klt+1, mt );
+        for (int64_t i = istart; i < iend; ++i) {
+            if (this->tileIsLocal(i, j)) {
+                int dev = (on_devices ? this->tileDevice(i, j)
+                                      : HostNum);
+                this->tileInsertLazy(i, j, dev);
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Move all tiles back to their origin.
 //
@@ -307,8 +382,8 @@ void BaseBandMatrix<scalar_t>::tileUpdateAllOrigin()
     int64_t kut = ceildiv(
             this->op() == Op::NoTrans ? this->ku_ : this->kl_, this->tileNb(0));
 
-    std::set<ij_tuple> tiles_set_host;
-    std::vector< std::set<ij_tuple> > tiles_set_dev(this->num_devices());
+    TileSet tiles_set_host;
+    std::vector< TileSet > tiles_set_dev(this->num_devices());
 
     for (int64_t j = 0; j < nt; ++j) {
         int64_t istart = blas::max( 0, j-kut );
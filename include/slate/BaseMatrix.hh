@@ -10,6 +10,7 @@
 #include "slate/internal/Memory.hh"
 #include "slate/internal/device.hh"
 #include "slate/internal/MatrixStorage.hh"
+#include "slate/internal/TileSet.hh"
 #include "slate/Tile.hh"
 #include "slate/Tile_blas.hh"
 #include "slate/types.hh"
@@ -22,6 +23,7 @@
 #include <memory>
 #include <set>
 #include <list>
+#include <map>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -56,6 +58,26 @@ public:
 
     using ij_tuple = typename MatrixStorage<scalar_t>::ij_tuple;
 
+    /// [internal]
+    /// Outstanding reductions of a ReduceList, started by listReduceBegin
+    /// and completed by listReduceEnd.
+    struct ReduceRequests {
+        /// This rank's part in the reduction of one tile.
+        struct TileReduce {
+            int64_t i, j;
+            int device;
+            int send_to;        ///< parent rank, or -1 on the root
+            bool is_root;
+            std::vector<scalar_t*>   buffers;        ///< one per child
+            std::vector<MPI_Request> recv_requests;  ///< one per child
+        };
+
+        std::vector<TileReduce>  tiles;
+        std::vector<MPI_Request> send_requests;
+        size_t next = 0;        ///< first tile not yet forwarded
+        int tag = 0;
+    };
+
     friend class Debug;
 
     // Make every class BaseMatrix<T2> a friend of BaseMatrix<scalar_t>.
@@ -210,13 +232,20 @@ public:
     /// Returns MPI rank of tile {i, j} of op(A).
     int tileRank(int64_t i, int64_t j) const
     {
-        return storage_->tileRank(globalIndex(i, j));
+        return storage_->tileRankAt(globalIndex(i, j));
     }
 
     /// Returns device of tile {i, j} of op(A).
     int tileDevice(int64_t i, int64_t j) const
     {
-        return storage_->tileDevice(globalIndex(i, j));
+        return storage_->tileDeviceAt(globalIndex(i, j));
+    }
+
+    /// Returns NUMA node of host tile {i, j} of op(A),
+    /// used if host_numa_placement() is set.
+    int tileNumaNode(int64_t i, int64_t j) const
+    {
+        return storage_->tileNumaNode(globalIndex(i, j));
     }
 
     /// Returns whether tile {i, j} of op(A) is local.
@@ -239,11 +268,13 @@ public:
 private:
     int64_t tileMbInternal(int64_t i) const;
     int64_t tileNbInternal(int64_t j) const;
+    bool tileIsWhole(int64_t i, int64_t j) const;
 
 public:
     Tile<scalar_t> tileInsert( int64_t i, int64_t j, int device=HostNum );
     Tile<scalar_t> tileInsert( int64_t i, int64_t j, int device,
                                 scalar_t* A, int64_t ld );
+    void tileInsertLazy( int64_t i, int64_t j, int device=HostNum );
 
     /// Insert tile with default device=HostNum. @see tileInsert.
     Tile<scalar_t> tileInsert(int64_t i, int64_t j,
@@ -277,11 +308,11 @@ public:
 private:
     void tileGet(int64_t i, int64_t j, int dst_device,
                  LayoutConvert layout, bool modify, bool hold,
-                 bool async);
+                 bool async, lapack::Queue* queue = nullptr);
 
-    void tileGet(std::set<ij_tuple>& tile_set, int dst_device,
+    void tileGet(TileSet& tile_set, int dst_device,
                  LayoutConvert layout, bool modify, bool hold,
-                 bool async);
+                 bool async, lapack::Queue* queue = nullptr);
 
     void tileCopyDataLayout(Tile<scalar_t>* src_tile,
                             Tile<scalar_t>* dst_tile,
@@ -350,16 +381,32 @@ public:
     void tileModified( int64_t i, int64_t j, int device=HostNum,
                        bool permissive=false );
 
-    void tileAcquire(int64_t i, int64_t j, int device, Layout layout);
+    TileStructure tileStructure( int64_t i, int64_t j ) const;
+
+    void tileStructure( int64_t i, int64_t j, TileStructure structure );
+
+    void tileAcquire(int64_t i, int64_t j, int device, Layout layout,
+                     lapack::Queue* queue = nullptr);
 
     void tileAcquire(int64_t i, int64_t j, Layout layout)
     {
         tileAcquire( i, j, HostNum, layout );
     }
 
+    void tileAcquireForOverwrite(int64_t i, int64_t j, int device,
+                                 Layout layout,
+                                 lapack::Queue* queue = nullptr);
+
+    void tileAcquireForOverwrite(TileSet& tile_set, int device,
+                                 Layout layout,
+                                 lapack::Queue* queue = nullptr);
+
     void tileGetForReading(int64_t i, int64_t j, int device, LayoutConvert layout);
 
-    void tileGetForReading(std::set<ij_tuple>& tile_set, int device, LayoutConvert layout);
+    void tileGetForReading(TileSet& tile_set, int device, LayoutConvert layout);
+
+    void tileGetForReading(TileSet& tile_set, int device,
+                           LayoutConvert layout, lapack::Queue& queue);
 
     /// Gets tile(i, j) for reading on host.
     /// @see tileGetForReading
@@ -369,13 +416,29 @@ public:
     }
 
     /// Gets a set of tiles for reading on host.
+    /// @see tileGetForReading
+    void tileGetForReading(TileSet& tile_set, LayoutConvert layout)
+    {
+        tileGetForReading( tile_set, HostNum, layout );
+    }
+
+    /// Gets a std::set of tiles for reading on device.
+    /// Internal routines should use TileSet, which doesn't allocate per tile.
+    /// @see tileGetForReading
+    void tileGetForReading(std::set<ij_tuple>& tile_set, int device,
+                           LayoutConvert layout)
+    {
+        TileSet tiles( tile_set.begin(), tile_set.end() );
+        tileGetForReading( tiles, device, layout );
+    }
+
     /// @see tileGetForReading
     void tileGetForReading(std::set<ij_tuple>& tile_set, LayoutConvert layout)
     {
         tileGetForReading( tile_set, HostNum, layout );
     }
     [[deprecated( "tileGetForReading no longer obeys from_device. Will be removed 2024-10." )]]
-    void tileGetForReading(std::set<ij_tuple>& tile_set, LayoutConvert layout,
+    void tileGetForReading(TileSet& tile_set, LayoutConvert layout,
                             int from_device)
     {
         tileGetForReading( tile_set, layout );
@@ -387,7 +450,14 @@ public:
 
     void tileGetForWriting(int64_t i, int64_t j, int device, LayoutConvert layout);
 
-    void tileGetForWriting(std::set<ij_tuple>& tile_set, int device, LayoutConvert layout);
+    void tileGetForWriting(TileSet& tile_set, int device, LayoutConvert layout);
+
+    void tileGetForWriting(TileSet& tile_set, int device,
+                           LayoutConvert layout, lapack::Queue& queue);
+
+    void tileRecordEvent(TileSet& tile_set, int device,
+                         std::shared_ptr< DeviceEvent > const& event,
+                         bool modify);
 
     /// Gets tile(i, j) for writing on host.
     /// @see tileGetForWriting
@@ -397,6 +467,22 @@ public:
     }
 
     /// Gets a set of tiles for writing on host.
+    /// @see tileGetForWriting
+    void tileGetForWriting(TileSet& tile_set, LayoutConvert layout)
+    {
+        tileGetForWriting( tile_set, HostNum, layout );
+    }
+
+    /// Gets a std::set of tiles for writing on device.
+    /// Internal routines should use TileSet, which doesn't allocate per tile.
+    /// @see tileGetForWriting
+    void tileGetForWriting(std::set<ij_tuple>& tile_set, int device,
+                           LayoutConvert layout)
+    {
+        TileSet tiles( tile_set.begin(), tile_set.end() );
+        tileGetForWriting( tiles, device, layout );
+    }
+
     /// @see tileGetForWriting
     void tileGetForWriting(std::set<ij_tuple>& tile_set, LayoutConvert layout)
     {
@@ -416,9 +502,26 @@ public:
         tileGetAndHold( i, j, HostNum, layout );
     }
 
-    void tileGetAndHold(std::set<ij_tuple>& tile_set, int device, LayoutConvert layout);
+    void tileGetAndHold(TileSet& tile_set, int device, LayoutConvert layout);
 
     /// Gets a set of tiles for reading on host and marks them as MOSI::OnHold.
+    /// @see tileGetAndHold
+    void tileGetAndHold(TileSet& tile_set, LayoutConvert layout)
+    {
+        tileGetAndHold( tile_set, HostNum, layout );
+    }
+
+    /// Gets a std::set of tiles for reading on device and marks them as
+    /// MOSI::OnHold.
+    /// Internal routines should use TileSet, which doesn't allocate per tile.
+    /// @see tileGetAndHold
+    void tileGetAndHold(std::set<ij_tuple>& tile_set, int device,
+                        LayoutConvert layout)
+    {
+        TileSet tiles( tile_set.begin(), tile_set.end() );
+        tileGetAndHold( tiles, device, layout );
+    }
+
     /// @see tileGetAndHold
     void tileGetAndHold(std::set<ij_tuple>& tile_set, LayoutConvert layout)
     {
@@ -433,6 +536,10 @@ public:
 
     void tileUpdateAllOrigin();
 
+    void tileUpdateAllOriginAsync();
+
+    void tilePrefetch(TileSet& tile_set, int device);
+
     /// Returns life counter of tile {i, j} of op(A).
     [[deprecated( "Tile life has been removed. Accessor stubs will be removed 2024-12." )]]
     int64_t tileLife(int64_t i, int64_t j) const
@@ -516,7 +623,22 @@ public:
     }
 
     template <Target target = Target::Host>
-    void listBcast( BcastList& bcast_list, Layout layout, int tag = 0, bool is_shared = false );
+    void listBcast( BcastList& bcast_list, Layout layout, int tag = 0,
+                    bool is_shared = false, int radix = 2,
+                    bool hierarchical = false );
+
+    template <Target target = Target::Host>
+    void listBcast( BcastList& bcast_list, Layout layout, int tag,
+                    bool is_shared, Options const& opts );
+
+    template <Target target = Target::Host>
+    void listBcastAggregated( BcastList& bcast_list, Layout layout,
+                              int tag = 0, bool is_shared = false );
+
+    template <Target target = Target::Host>
+    void listBcastAggregated( BcastList& bcast_list, BaseMatrix<scalar_t>& B,
+                              Layout layout, int tag = 0,
+                              bool is_shared = false );
 
     template <Target target = Target::Host>
     [[deprecated( "Tile life has been removed. The 5 argument listBcast will be removed 2024-12." )]]
@@ -530,7 +652,9 @@ public:
     // This variant takes a BcastListTag where each <i,j> tile has
     // its own message tag
     template <Target target = Target::Host>
-    void listBcastMT( BcastListTag& bcast_list, Layout layout, bool is_shared = false );
+    void listBcastMT( BcastListTag& bcast_list, Layout layout,
+                      bool is_shared = false, int radix = 4,
+                      bool hierarchical = false );
 
     template <Target target = Target::Host>
     [[deprecated( "Tile life has been removed. The 4 argument listBcastMT will be removed 2024-12." )]]
@@ -542,7 +666,24 @@ public:
     }
 
     template <Target target = Target::Host>
-    void listReduce(ReduceList& reduce_list, Layout layout, int tag = 0);
+    void listReduce(ReduceList& reduce_list, Layout layout, int tag = 0,
+                    int radix = 2);
+
+    template <Target target = Target::Host>
+    ReduceRequests listReduceBegin(ReduceList& reduce_list, Layout layout,
+                                   int tag = 0, int radix = 2);
+
+    void listReduceEnd(ReduceRequests& requests);
+
+protected:
+    void listReduceForward(ReduceRequests& requests, bool wait);
+
+    template <Target target>
+    void listBcastAggregated( std::vector< BaseMatrix<scalar_t>* > matrices,
+                              BcastList& bcast_list, Layout layout,
+                              int tag, bool is_shared );
+
+public:
 
     //--------------------------------------------------------------------------
     // LAYOUT
@@ -580,10 +721,10 @@ public:
     {
         tileLayoutConvert( i, j, HostNum, layout, reset, async );
     }
-    void tileLayoutConvert(std::set<ij_tuple>& tile_set, int device,
+    void tileLayoutConvert(TileSet& tile_set, int device,
                            Layout layout, bool reset = false);
     /// Convert layout of a set of tiles to layout on host, optionally reset
-    void tileLayoutConvert(std::set<ij_tuple>& tile_set, Layout layout, bool reset = false)
+    void tileLayoutConvert(TileSet& tile_set, Layout layout, bool reset = false)
     {
         tileLayoutConvert( tile_set, HostNum, layout, reset );
     }
@@ -595,8 +736,8 @@ public:
     {
         tileLayoutReset( i, j, HostNum, layout );
     }
-    void tileLayoutReset(std::set<ij_tuple>& tile_set, int device, Layout layout);
-    void tileLayoutReset(std::set<ij_tuple>& tile_set, Layout layout)
+    void tileLayoutReset(TileSet& tile_set, int device, Layout layout);
+    void tileLayoutReset(TileSet& tile_set, Layout layout)
     {
         tileLayoutReset( tile_set, HostNum, layout );
     }
@@ -607,11 +748,16 @@ protected:
     void tileBcastToSet(int64_t i, int64_t j, std::set<int> const& bcast_set);
     void tileBcastToSet(int64_t i, int64_t j, std::set<int> const& bcast_set,
                         int radix, int tag, Layout layout,
-                        Target target);
+                        Target target, bool hierarchical = false);
     void tileIbcastToSet(int64_t i, int64_t j, std::set<int> const& bcast_set,
                         int radix, int tag, Layout layout,
                         std::vector<MPI_Request>& send_requests,
-                        Target target);
+                        Target target, bool hierarchical = false);
+    bool tileIbcastNodeShared(int64_t i, int64_t j,
+                              std::vector<int> const& bcast_ranks,
+                              std::vector<int> const& nodes,
+                              int radix, int tag, Layout layout,
+                              std::vector<MPI_Request>& send_requests);
 
 public:
     // todo: should this be private?
@@ -627,6 +773,11 @@ public:
     int       mpiRank()  const { return mpi_rank_; }
     MPI_Group mpiGroup() const { return mpi_group_; }
 
+    /// [internal]
+    /// @return cache of sub-communicators of mpiComm(), shared by all
+    /// matrices with the same storage; see internal::commFromSet.
+    internal::CommCache& commCache() const { return storage_->commCache(); }
+
     /// Removes all tiles from matrix.
     /// WARNING: currently this clears the entire parent matrix,
     /// not just a sub-matrix.
@@ -648,11 +799,29 @@ public:
 
     void releaseLocalWorkspaceTile( int64_t i, int64_t j );
     void releaseLocalWorkspace();
-    void releaseLocalWorkspace( std::set<ij_tuple>& tile_set );
+    void releaseLocalWorkspace( TileSet& tile_set );
+
+    /// Releases local workspace tiles in a std::set.
+    /// @see releaseLocalWorkspace
+    void releaseLocalWorkspace( std::set<ij_tuple>& tile_set )
+    {
+        TileSet tiles( tile_set.begin(), tile_set.end() );
+        releaseLocalWorkspace( tiles );
+    }
 
     void releaseRemoteWorkspaceTile( int64_t i, int64_t j, int64_t release_count = 1 );
     void releaseRemoteWorkspace( int64_t recieve_count = 1 );
-    void releaseRemoteWorkspace( std::set<ij_tuple>& tile_set, int64_t release_count = 1 );
+    void releaseRemoteWorkspace( TileSet& tile_set, int64_t release_count = 1 );
+
+    /// Releases remote workspace tiles in a std::set.
+    /// Internal routines should use TileSet, which doesn't allocate per tile.
+    /// @see releaseRemoteWorkspace
+    void releaseRemoteWorkspace( std::set<ij_tuple>& tile_set,
+                                 int64_t release_count = 1 )
+    {
+        TileSet tiles( tile_set.begin(), tile_set.end() );
+        releaseRemoteWorkspace( tiles, release_count );
+    }
 
     /// Removes all temporary host and device workspace tiles from matrix.
     /// WARNING: currently, this clears the entire parent matrix,
@@ -687,6 +856,158 @@ public:
         storage_->clearBatchArrays();
     }
 
+    /// Attaches matrix to a workspace arena for the duration of a driver,
+    /// taking memory pools and batch arrays from it. Does nothing if
+    /// workspace is null or the matrix is already attached.
+    /// WARNING: this attaches the entire parent matrix,
+    /// not just a sub-matrix.
+    void attachWorkspace(Workspace* workspace)
+    {
+        storage_->attachWorkspace(workspace);
+    }
+
+    /// Detaches matrix from its workspace arena, parking free memory pools
+    /// and batch arrays in it for reuse by the next driver.
+    void detachWorkspace()
+    {
+        storage_->detachWorkspace();
+    }
+
+    /// Allocates tiles from the process-wide memory pool for the matrix's
+    /// block size, shared with other matrices, instead of its own pool.
+    /// Must be called before any tiles are allocated.
+    /// @see shared_memory_pool()
+    void useSharedMemory()
+    {
+        storage_->useSharedMemory();
+    }
+
+    /// @return true if matrix allocates from a shared memory pool.
+    bool usesSharedMemory() const
+    {
+        return storage_->usesSharedMemory();
+    }
+
+    /// @return size in bytes of a tile block in the matrix's memory pool,
+    /// e.g., for WorkspaceSize::Pool::block_size.
+    size_t memoryBlockSize() const
+    {
+        return storage_->memoryBlockSize();
+    }
+
+    /// @return number of blocks allocated by matrix on device,
+    /// which can be host.
+    int64_t memoryUsed(int device) const
+    {
+        return storage_->memoryUsed( device );
+    }
+
+    /// @return max number of blocks allocated at once by matrix on device,
+    /// which can be host, since creation or memoryPeakReset.
+    int64_t memoryPeak(int device) const
+    {
+        return storage_->memoryPeak( device );
+    }
+
+    /// Resets the matrix's memory peaks to its current usage.
+    /// WARNING: this applies to the entire parent matrix,
+    /// not just a sub-matrix.
+    void memoryPeakReset()
+    {
+        storage_->memoryPeakReset();
+    }
+
+    /// @return usage counters, in bytes, of the matrix's memory pool on
+    /// device, which can be host.
+    MemoryStats memoryStats(int device) const
+    {
+        return storage_->memoryStats( device );
+    }
+
+    /// @return max number of blocks matrix can allocate on each device.
+    int64_t memoryQuota() const
+    {
+        return storage_->memoryQuota();
+    }
+
+    /// Sets max number of blocks matrix can allocate on each device,
+    /// including host. Allocating beyond it throws an error.
+    /// WARNING: this applies to the entire parent matrix,
+    /// not just a sub-matrix.
+    void memoryQuota(int64_t quota)
+    {
+        storage_->memoryQuota( quota );
+    }
+
+    /// @return high-water mark, in blocks, of each device's pool,
+    /// above which tiles are evicted; 0 if eviction is disabled.
+    int64_t deviceHighWater() const
+    {
+        return storage_->deviceHighWater();
+    }
+
+    /// Sets high-water mark, in blocks, of each device's pool. Above it,
+    /// least-recently-used workspace tiles are evicted from the device,
+    /// writing back Modified ones to host, so matrices larger than device
+    /// memory can be processed. 0 disables eviction (default).
+    /// WARNING: this applies to the entire parent matrix,
+    /// not just a sub-matrix.
+    void deviceHighWater(int64_t num_blocks)
+    {
+        storage_->deviceHighWater( num_blocks );
+    }
+
+    /// @return whether set() and copy() record tiles that are Zero or
+    /// Identity, for gemm, herk, and trsm to skip (@see tileStructure).
+    bool trackTileStructure() const
+    {
+        return storage_->trackTileStructure();
+    }
+
+    /// Sets whether set() and copy() record tiles that are Zero or Identity,
+    /// for gemm, herk, and trsm to skip (@see tileStructure). Off by default.
+    /// If on, the caller must write tiles only through SLATE routines or
+    /// tileGetForWriting, not through a Tile, e.g., from A( i, j ),
+    /// that SLATE doesn't see written.
+    /// WARNING: this applies to the entire parent matrix,
+    /// not just a sub-matrix.
+    void trackTileStructure(bool track)
+    {
+        storage_->trackTileStructure( track );
+    }
+
+    /// @return counters of tile transfers between host and devices made by
+    /// tileGet, and of MOSI transitions and layout conversions.
+    /// WARNING: this counts the entire parent matrix,
+    /// not just a sub-matrix.
+    TransferStats transferStats() const
+    {
+        return storage_->transferStats();
+    }
+
+    /// Resets the transfer counters and heat map of the parent matrix.
+    void transferStatsReset()
+    {
+        storage_->transferStatsReset();
+    }
+
+    /// Enables or disables counting transfers per tile, for
+    /// transferHeatMapPrint. Default disabled, as it takes a lock per
+    /// transfer.
+    void transferHeatMap(bool enable)
+    {
+        storage_->transferHeatMap( enable );
+    }
+
+    /// @return number of transfers of each tile, by its {i, j} index in
+    /// the parent matrix, counted while transferHeatMap was enabled.
+    std::map< ij_tuple, int64_t > transferHeat() const
+    {
+        return storage_->transferHeat();
+    }
+
+    void transferHeatMapPrint(FILE* file=stdout) const;
+
     /// @return currently allocated batch array size
     int64_t batchArraySize()
     {
@@ -740,6 +1061,77 @@ public:
         return storage_->num_compute_queues();
     }
 
+    //--------------------------------------------------------------------------
+    /// Leases a compute queue, with its batch arrays, on device from the
+    /// pool shared with matrices sharing storage.
+    /// @see MatrixStorage::acquireComputeQueue
+    ///
+    typename MatrixStorage<scalar_t>::PooledQueue*
+        acquireComputeQueue( int device )
+    {
+        return storage_->acquireComputeQueue( device );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Returns a compute queue leased by acquireComputeQueue() to the pool.
+    ///
+    void releaseComputeQueue(
+        typename MatrixStorage<scalar_t>::PooledQueue* pooled )
+    {
+        storage_->releaseComputeQueue( pooled );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Sets the math mode of the compute queues, which is shared with
+    /// matrices sharing storage.
+    /// @see MatrixStorage::setMathMode
+    ///
+    void setMathMode( MathMode mode )
+    {
+        storage_->setMathMode( mode );
+    }
+
+    /// @return math mode of the compute queues.
+    MathMode mathMode() const
+    {
+        return storage_->mathMode();
+    }
+
+    //--------------------------------------------------------------------------
+    /// Sets the precision tile {i, j} is stored and updated in, which is
+    /// shared with matrices sharing storage. Not thread safe.
+    /// @see select_tile_precision
+    ///
+    void tileSetPrecision( int64_t i, int64_t j, TilePrecision precision )
+    {
+        storage_->setTilePrecision( globalIndex( i, j ), precision );
+    }
+
+    /// @return precision tile {i, j} is stored and updated in.
+    TilePrecision tilePrecision( int64_t i, int64_t j ) const
+    {
+        return storage_->tilePrecision( globalIndex( i, j ) );
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return true if B shares storage with this matrix.
+    bool sharesStorage( BaseMatrix const& B ) const
+    {
+        return storage_ == B.storage_;
+    }
+
+    /// @return true if B is a view of the same region of the same storage,
+    /// with the same op and uplo, so both refer to the same entries.
+    bool sameView( BaseMatrix const& B ) const
+    {
+        return storage_ == B.storage_
+            && ioffset_ == B.ioffset_ && joffset_ == B.joffset_
+            && mt_ == B.mt_ && nt_ == B.nt_
+            && row0_offset_ == B.row0_offset_ && col0_offset_ == B.col0_offset_
+            && last_mb_ == B.last_mb_ && last_nb_ == B.last_nb_
+            && op_ == B.op_ && uplo_ == B.uplo_;
+    }
+
 protected:
     std::tuple<int64_t, int64_t>
         globalIndex(int64_t i, int64_t j) const;
@@ -794,6 +1186,42 @@ protected:
     int mpi_rank_;
 };
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Destructor detaches a matrix from its workspace arena, if attached.
+/// Drivers declare one before calling BaseMatrix::attachWorkspace, so the
+/// matrix is detached both on return and when the driver throws, e.g.,
+/// when allocating batch arrays or workspace fails; otherwise it would keep
+/// the arena's memory pools and batch arrays, and the arena would count it
+/// as attached. Like LockGuard, but for workspace arenas.
+///
+template <typename scalar_t>
+class WorkspaceGuard {
+public:
+    /// @param[in,out] A
+    ///     Matrix to detach on destruction; must outlive the guard.
+    WorkspaceGuard( BaseMatrix<scalar_t>& A )
+        : A_( A )
+    {}
+
+    ~WorkspaceGuard()
+    {
+        try {
+            A_.detachWorkspace();
+        }
+        catch (...) {
+            // Destructors must not throw; the matrix stays attached.
+        }
+    }
+
+    // Not copyable, as it detaches the matrix on destruction.
+    WorkspaceGuard( WorkspaceGuard const& ) = delete;
+    WorkspaceGuard& operator=( WorkspaceGuard const& ) = delete;
+
+private:
+    BaseMatrix<scalar_t>& A_;
+};
+
 //------------------------------------------------------------------------------
 /// [internal]
 /// Default constructor creates an empty matrix.
@@ -1386,6 +1814,16 @@ Tile<scalar_t> BaseMatrix<scalar_t>::operator()(
         std::swap( i, j );
     }
     auto* tile = storage_->at( { ioffset_+i, joffset_+j, device } );
+    if (tile->data() == nullptr) {
+        // Allocate lazy tile on first use.
+        auto& tile_node = storage_->at( { ioffset_+i, joffset_+j } );
+        LockGuard guard( tile_node.getLock() );
+        storage_->tileMaterialize( tile_node, device,
+                                   tile->state() != MOSI::Invalid );
+        // The caller uses the tile on the host, outside event tracking.
+        if (device != HostNum)
+            tile_node.syncEvents( device, true );
+    }
     return tile->slice( op_, (i == 0 ? row0_offset_ : 0), (j == 0 ? col0_offset_ : 0),
                         tileMbInternal( i ), tileNbInternal( j ),
                         (i == j ? uplo_ : Uplo::General) );
@@ -1482,9 +1920,9 @@ int64_t BaseMatrix<scalar_t>::tileMbInternal(int64_t i) const
     if (i == mt_ - 1)
         return last_mb_;
     else if (i == 0)
-        return storage_->tileMb(ioffset_ + i) - row0_offset_;
+        return storage_->tileMbAt(ioffset_ + i) - row0_offset_;
     else
-        return storage_->tileMb(ioffset_ + i);
+        return storage_->tileMbAt(ioffset_ + i);
 }
 
 //------------------------------------------------------------------------------
@@ -1502,9 +1940,32 @@ int64_t BaseMatrix<scalar_t>::tileNbInternal(int64_t j) const
     if (j == nt_ - 1)
         return last_nb_;
     else if (j == 0)
-        return storage_->tileNb(joffset_ + j) - col0_offset_;
+        return storage_->tileNbAt(joffset_ + j) - col0_offset_;
     else
-        return storage_->tileNb(joffset_ + j);
+        return storage_->tileNbAt(joffset_ + j);
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Returns whether tile(i, j) of op(A) is the whole tile in storage,
+/// not a slice of it.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+template <typename scalar_t>
+bool BaseMatrix<scalar_t>::tileIsWhole(int64_t i, int64_t j) const
+{
+    // block row and col of A, ignoring transposition
+    int64_t ii = (op_ == Op::NoTrans ? i : j);
+    int64_t jj = (op_ == Op::NoTrans ? j : i);
+    return (ii != 0 || row0_offset_ == 0)
+        && (jj != 0 || col0_offset_ == 0)
+        && tileMbInternal( ii ) == storage_->tileMbAt( ioffset_ + ii )
+        && tileNbInternal( jj ) == storage_->tileNbAt( joffset_ + jj );
 }
 
 //------------------------------------------------------------------------------
@@ -1529,6 +1990,29 @@ Tile<scalar_t> BaseMatrix<scalar_t>::tileInsert(
     return *(storage_->tileInsert(index, TileKind::SlateOwned, layout_));
 }
 
+//------------------------------------------------------------------------------
+/// Insert tile {i, j} of op(A), deferring allocation of its data until
+/// it is first used, e.g., by tileGetForWriting, tileAcquire, or
+/// operator(). Until it is written, the tile is implicitly zero, so
+/// tileGetForReading gets a zero tile.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+/// @param[in] device
+///     Tile's device ID; default is HostNum.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileInsertLazy(
+    int64_t i, int64_t j, int device)
+{
+    auto index = globalIndex(i, j, device);
+    storage_->tileInsertLazy(index, layout_);
+}
+
 //------------------------------------------------------------------------------
 /// Insert a workspace tile {i, j} of op(A) and allocate its data.
 /// The tile will be freed
@@ -1654,6 +2138,9 @@ void BaseMatrix<scalar_t>::tileErase(int64_t i, int64_t j, int device)
 /// remaining tiles invalid, but this behavior may change in the future
 /// and should not be relied on.
 ///
+/// Also releases the caller's pin on the instance from tileGet;
+/// an instance still pinned by another caller is not erased.
+///
 /// @param[in] i
 ///     Tile's block row index. 0 <= i < mt.
 ///
@@ -1722,6 +2209,9 @@ void BaseMatrix<scalar_t>::tileModified(int64_t i, int64_t j, int device, bool p
 
     LockGuard guard(tile_node.getLock());
 
+    // The caller will write the tile, so its structure is no longer known.
+    tile_node.structure( TileStructure::Dense );
+
     auto tile = tile_node[device];
 
     // if no need to update
@@ -1730,13 +2220,84 @@ void BaseMatrix<scalar_t>::tileModified(int64_t i, int64_t j, int device, bool p
 
     tile->state(MOSI::Modified);
 
+    int64_t num_invalidated = 0;
     for (int d = HostNum; d < num_devices(); ++d) {
         if (d != device && tile_node.existsOn(d)) {
             if (! permissive)
                 slate_assert(tile_node[d]->stateOn(MOSI::Modified) == false);
+            if (! tile_node[d]->stateOn(MOSI::Invalid))
+                ++num_invalidated;
             tile_node[d]->state(MOSI::Invalid);
         }
     }
+    if (num_invalidated > 0)
+        storage_->countTransitions( num_invalidated );
+}
+
+//------------------------------------------------------------------------------
+/// Returns the known structure of tile(i, j): Zero, Identity, or Dense
+/// if unknown, as recorded by set() or copy() if trackTileStructure is on.
+/// Any write to the tile through SLATE, i.e., tileModified, as by
+/// tileGetForWriting, tileAcquireForOverwrite, or a receive, resets it
+/// to Dense. Callers that check the structure must do so before getting
+/// the tile.
+/// A slice of a Zero tile is Zero; a slice of an Identity tile
+/// is reported as Dense unless it is the whole tile.
+/// The tile must exist on some device.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+template <typename scalar_t>
+TileStructure BaseMatrix<scalar_t>::tileStructure(int64_t i, int64_t j) const
+{
+    auto& tile_node = storage_->at( globalIndex( i, j ) );
+    LockGuard guard( tile_node.getLock() );
+
+    TileStructure structure = tile_node.structure();
+    if (structure == TileStructure::Identity && ! tileIsWhole( i, j ))
+        structure = TileStructure::Dense;
+    return structure;
+}
+
+//------------------------------------------------------------------------------
+/// Records the known structure of tile(i, j), after the caller has
+/// written it, e.g., set() writing zeros.
+/// It is recorded only if trackTileStructure is on; otherwise the tile
+/// is Dense.
+/// Since the structure is kept for the whole tile, it is recorded only if
+/// tile(i, j) of this view is the whole tile; otherwise the tile is Dense.
+/// It is never recorded for tiles in user memory, e.g., from fromLAPACK or
+/// fromScaLAPACK, which the user can write without SLATE knowing.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+/// @param[in] structure
+///     Structure of the tile's data.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileStructure(
+    int64_t i, int64_t j, TileStructure structure)
+{
+    if (! storage_->trackTileStructure() || ! tileIsWhole( i, j ))
+        structure = TileStructure::Dense;
+
+    auto& tile_node = storage_->at( globalIndex( i, j ) );
+    LockGuard guard( tile_node.getLock() );
+    for (int device = HostNum; device < num_devices(); ++device) {
+        if (tile_node.existsOn( device )
+            && tile_node[ device ]->kind() == TileKind::UserOwned) {
+            structure = TileStructure::Dense;
+        }
+    }
+    tile_node.structure( structure );
 }
 
 //------------------------------------------------------------------------------
@@ -1764,7 +2325,7 @@ void BaseMatrix<scalar_t>::tileSend(
 {
     MPI_Request request;
     tileIsend( i, j, dst_rank, tag, &request );
-    slate_mpi_call( MPI_Wait( &request, MPI_STATUS_IGNORE ) );
+    internal::comm_wait( &request );
 }
 
 //------------------------------------------------------------------------------
@@ -1859,7 +2420,7 @@ void BaseMatrix<scalar_t>::tileRecv(
 {
     MPI_Request request;
     tileIrecv<target>( i, j, src_rank, layout, tag, &request );
-    slate_mpi_call( MPI_Wait( &request, MPI_STATUS_IGNORE ) );
+    internal::comm_wait( &request );
 
     // Copy to devices if not using GPU-aware MPI.
     if (target == Target::Devices) {
@@ -1994,10 +2555,22 @@ void BaseMatrix<scalar_t>::tileBcast(
 ///     WARNING: must set unhold these tiles before releasing them to free
 ///     up the allocated memories.
 ///
+/// @param[in] radix
+///     Radix of the hypercube broadcast pattern, default 2;
+///     see internal::cubeBcastPattern. Must be the same on all ranks.
+///     Tiles larger than bcast_chunk_size() are pipelined in chunks.
+///
+/// @param[in] hierarchical
+///     If true, and internal::commNodes was called for the matrix's
+///     communicator, broadcast between nodes first, then within nodes;
+///     see internal::hierarchicalBcastPattern. Default false.
+///     Must be the same on all ranks.
+///
 template <typename scalar_t>
 template <Target target>
 void BaseMatrix<scalar_t>::listBcast(
-    BcastList& bcast_list, Layout layout, int tag, bool is_shared )
+    BcastList& bcast_list, Layout layout, int tag, bool is_shared, int radix,
+    bool hierarchical )
 {
     if (target == Target::Devices) {
         assert(num_devices() > 0);
@@ -2012,9 +2585,9 @@ void BaseMatrix<scalar_t>::listBcast(
     // first tile has been discarded.
     // Also, currently, the message is received to the same buffer.
 
-    std::vector< std::set<ij_tuple> > tile_set(num_devices());
+    std::vector< TileSet > tile_set(num_devices());
     int mpi_size;
-    MPI_Comm_size(mpiComm(), &mpi_size);
+    slate_mpi_call( MPI_Comm_size(mpiComm(), &mpi_size) );
 
     std::vector<MPI_Request> send_requests;
 
@@ -2041,8 +2614,9 @@ void BaseMatrix<scalar_t>::listBcast(
 
             // Send across MPI ranks.
             // Previous used MPI bcast: tileBcastToSet(i, j, bcast_set);
-            // Currently uses 2D hypercube p2p send.
-            tileIbcastToSet(i, j, bcast_set, 2, tag, layout, send_requests, target);
+            // Currently uses radix-D hypercube p2p send.
+            tileIbcastToSet(i, j, bcast_set, radix, tag, layout, send_requests,
+                            target, hierarchical);
         }
 
         // Copy to devices.
@@ -2068,6 +2642,10 @@ void BaseMatrix<scalar_t>::listBcast(
                         if (is_shared) {
                             tileGetAndHold(i, j, device, LayoutConvert::None);
                         }
+                        else if (prefetch()) {
+                            TileSet tiles = { { i, j } };
+                            tilePrefetch(tiles, device);
+                        }
                         else {
                             tileGetForReading(i, j, device, LayoutConvert::None);
                         }
@@ -2088,6 +2666,9 @@ void BaseMatrix<scalar_t>::listBcast(
                         if (is_shared) {
                             tileGetAndHold(tile_set[d], d, LayoutConvert::None);
                         }
+                        else if (prefetch()) {
+                            tilePrefetch(tile_set[d], d);
+                        }
                         else {
                             tileGetForReading(tile_set[d], d, LayoutConvert::None);
                         }
@@ -2096,19 +2677,298 @@ void BaseMatrix<scalar_t>::listBcast(
             }
         }
     }
-    slate_mpi_call(
-        MPI_Waitall(send_requests.size(), send_requests.data(), MPI_STATUSES_IGNORE));
+    internal::comm_waitall( send_requests.size(), send_requests.data() );
 }
 
 //------------------------------------------------------------------------------
 /// Send tile {i, j} of op(A) to all MPI ranks in the list of submatrices
-/// bcast_list (using OpenMP tasksloop and multi-threaded MPI).
-/// Data received must be in 'layout' (ColMajor/RowMajor) major.
+/// bcast_list, selecting the method from options.
+/// If Option::AggregateBcast is true, uses listBcastAggregated,
+/// otherwise the hypercube listBcast.
+///
+/// @param[in] opts
+///     Options, as passed to the driver. Uses:
+///     - Option::AggregateBcast:
+///       whether to aggregate messages per destination rank; default false.
+///     - Option::HierarchicalBcast:
+///       whether to broadcast between nodes first, then within nodes;
+///       default false. The driver must call internal::commNodes on all
+///       ranks before using it. If the attached Workspace has node-shared
+///       memory, host tiles are then received once per node; see
+///       Workspace::enableNodeShared.
 ///
-/// @tparam target
-///     Destination to target; either Host (default) or Device.
-///
-/// @param[in] bcast_list
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listBcast(
+    BcastList& bcast_list, Layout layout, int tag, bool is_shared,
+    Options const& opts )
+{
+    if (get_option<Option::AggregateBcast>( opts, false ))
+        listBcastAggregated<target>( bcast_list, layout, tag, is_shared );
+    else
+        listBcast<target>( bcast_list, layout, tag, is_shared, 2,
+                           get_option<Option::HierarchicalBcast>( opts, false ) );
+}
+
+//------------------------------------------------------------------------------
+/// Broadcast the tiles in bcast_list with one message per pair of ranks:
+/// each root sends all its tiles bound for a destination rank as a single
+/// MPI struct datatype, which describes the tiles in place, so nothing is
+/// packed or copied. Roots send directly to every destination in the
+/// list of submatrices, instead of along a hypercube.
+/// This reduces the number of messages from one per (tile, destination)
+/// to one per destination, which helps when many small tiles are
+/// broadcast, e.g., narrow panels at small nb, where the message rate
+/// rather than the bandwidth is the limit.
+/// Must be called by all ranks with the same bcast_list.
+/// Data received must be in 'layout' (ColMajor/RowMajor) major.
+///
+/// @tparam target
+///     Destination to target; either Host (default) or Device.
+///
+/// @param[in] bcast_list
+///     List of submatrices defining the MPI ranks to send to.
+///     Usually it is the portion of the matrix to be updated by tile {i, j}.
+///
+/// @param[in] layout
+///     Indicates the Layout (ColMajor/RowMajor) of the broadcasted data.
+///     WARNING: must match the layout of the tile in the sender MPI rank.
+///
+/// @param[in] tag
+///     MPI tag, default 0.
+///
+/// @param[in] is_shared
+///     A flag to get and hold the broadcasted (prefetched) tiles on the
+///     devices; see listBcast.
+///
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listBcastAggregated(
+    BcastList& bcast_list, Layout layout, int tag, bool is_shared )
+{
+    listBcastAggregated<target>( { this }, bcast_list, layout, tag, is_shared );
+}
+
+//------------------------------------------------------------------------------
+/// Send tile {i, j} of op(A) and tile {i, j} of op(B) to all MPI ranks in
+/// the list of submatrices bcast_list, aggregating the tiles of both
+/// matrices that go between the same pair of ranks into one message;
+/// see listBcastAggregated above.
+/// For routines such as her2k and syr2k, which broadcast the same
+/// block column of A and B to the same ranks, this halves the number of
+/// messages compared to two listBcast calls.
+/// A and B must have the same tile indices and MPI communicator,
+/// but may have different distributions.
+/// Must be called by all ranks with the same bcast_list.
+///
+/// @param[in,out] B
+///     The second matrix, whose tiles {i, j} are sent along with A's.
+///
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listBcastAggregated(
+    BcastList& bcast_list, BaseMatrix<scalar_t>& B, Layout layout,
+    int tag, bool is_shared )
+{
+    assert( mpi_comm_ == B.mpi_comm_ );
+    listBcastAggregated<target>( { this, &B }, bcast_list, layout, tag,
+                                 is_shared );
+}
+
+//------------------------------------------------------------------------------
+/// Aggregated broadcast of tile {i, j} of each of the matrices;
+/// implements the listBcastAggregated variants.
+///
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listBcastAggregated(
+    std::vector< BaseMatrix<scalar_t>* > matrices,
+    BcastList& bcast_list, Layout layout, int tag, bool is_shared )
+{
+    if (target == Target::Devices) {
+        assert(num_devices() > 0);
+    }
+
+    // Tiles to send to or receive from each rank, in bcast_list order,
+    // grouped by device, since one datatype can't mix memory spaces.
+    // Tiles are (matrix index, i, j).
+    using PeerKey = std::pair<int, int>;  // (rank, device)
+    using TileKey = std::tuple<int, int64_t, int64_t>;
+    int num_matrices = int( matrices.size() );
+    std::map< PeerKey, std::vector<TileKey> > send_tiles;
+    std::map< PeerKey, std::vector<TileKey> > recv_tiles;
+    std::vector< std::vector< TileSet > > tile_set(
+        num_matrices, std::vector< TileSet >( num_devices() ) );
+
+    for (auto bcast : bcast_list) {
+
+        auto i = std::get<0>(bcast);
+        auto j = std::get<1>(bcast);
+        auto submatrices_list = std::get<2>(bcast);
+
+        // Destinations are the same for all matrices.
+        std::set<int> dst_set;
+        for (auto submatrix : submatrices_list)
+            submatrix.getRanks(&dst_set);
+
+        for (int m = 0; m < num_matrices; ++m) {
+            BaseMatrix<scalar_t>& X = *matrices[ m ];
+
+            // Find the set of participating ranks.
+            int root_rank = X.tileRank(i, j);
+            std::set<int> bcast_set = dst_set;
+            bcast_set.insert(root_rank);
+
+            // If this rank is in the set.
+            if (bcast_set.find(mpi_rank_) != bcast_set.end()) {
+                int device = HostNum;
+                if (target == Target::Devices && gpu_aware_mpi()) {
+                    device = X.tileDevice( i, j );
+                }
+                X.storage_->tilePrepareToReceive( X.globalIndex( i, j ),
+                                                  device, X.layout_ );
+
+                if (root_rank == mpi_rank_) {
+                    X.tileGetForReading(i, j, device, LayoutConvert(layout));
+                    for (int dst : bcast_set) {
+                        if (dst != mpi_rank_)
+                            send_tiles[ { dst, device } ].push_back( { m, i, j } );
+                    }
+                }
+                else {
+                    X.tileAcquire(i, j, device, layout);
+                    recv_tiles[ { root_rank, device } ].push_back( { m, i, j } );
+                }
+            }
+        }
+
+        if (target == Target::Devices) {
+            std::set<int> dev_set;
+            for (auto submatrix : submatrices_list)
+                submatrix.getLocalDevices(&dev_set);
+            for (auto dev : dev_set) {
+                for (int m = 0; m < num_matrices; ++m)
+                    tile_set[m][dev].insert({i, j});
+            }
+        }
+    }
+
+    // Builds a committed datatype for the tiles, at absolute addresses.
+    auto make_datatype = [&matrices]( std::vector<TileKey> const& tiles,
+                                      int device, MPI_Datatype* newtype )
+    {
+        int count = int( tiles.size() );
+        std::vector<int> blocklengths( count, 1 );
+        std::vector<MPI_Aint> displacements( count );
+        std::vector<MPI_Datatype> types( count );
+        for (int k = 0; k < count; ++k) {
+            auto& X = *matrices[ std::get<0>( tiles[ k ] ) ];
+            auto Xij = X.at( std::get<1>( tiles[ k ] ), std::get<2>( tiles[ k ] ),
+                             device );
+            Xij.mpiDatatype( &types[ k ] );
+            slate_mpi_call( MPI_Get_address( Xij.data(), &displacements[ k ] ) );
+        }
+        slate_mpi_call(
+            MPI_Type_create_struct( count, blocklengths.data(),
+                                    displacements.data(), types.data(),
+                                    newtype ) );
+        slate_mpi_call( MPI_Type_commit( newtype ) );
+        for (auto& type : types)
+            slate_mpi_call( MPI_Type_free( &type ) );
+    };
+
+    // Bytes of the tiles, for the communication counters.
+    auto tiles_bytes = [&matrices]( std::vector<TileKey> const& tiles )
+    {
+        int64_t bytes = 0;
+        for (auto const& key : tiles) {
+            auto& X = *matrices[ std::get<0>( key ) ];
+            bytes += X.tileMb( std::get<1>( key ) )
+                   * X.tileNb( std::get<2>( key ) ) * sizeof( scalar_t );
+        }
+        return bytes;
+    };
+
+    // Post one receive per source and one send per destination.
+    // Maps are ordered, and tiles are added in bcast_list order, so both
+    // sides post messages per (rank, device) with the same tiles.
+    std::vector<MPI_Request> recv_requests;
+    std::vector<MPI_Request> send_requests;
+    for (auto& iter : recv_tiles) {
+        MPI_Datatype type;
+        make_datatype( iter.second, iter.first.second, &type );
+        MPI_Request request;
+        slate_mpi_call(
+            MPI_Irecv( MPI_BOTTOM, 1, type, iter.first.first, tag, mpi_comm_,
+                       &request ) );
+        recv_requests.push_back( request );
+        internal::comm_stats_recv( iter.first.first,
+                                   tiles_bytes( iter.second ) );
+        slate_mpi_call( MPI_Type_free( &type ) );
+    }
+    for (auto& iter : send_tiles) {
+        MPI_Datatype type;
+        make_datatype( iter.second, iter.first.second, &type );
+        MPI_Request request;
+        slate_mpi_call(
+            MPI_Isend( MPI_BOTTOM, 1, type, iter.first.first, tag, mpi_comm_,
+                       &request ) );
+        send_requests.push_back( request );
+        internal::comm_stats_send( iter.first.first,
+                                   tiles_bytes( iter.second ) );
+        slate_mpi_call( MPI_Type_free( &type ) );
+    }
+
+    if (! recv_requests.empty()) {
+        internal::comm_waitall( recv_requests.size(), recv_requests.data() );
+    }
+    for (auto& iter : recv_tiles) {
+        for (auto& key : iter.second) {
+            matrices[ std::get<0>( key ) ]->tileModified(
+                std::get<1>( key ), std::get<2>( key ), iter.first.second, true );
+        }
+    }
+
+    // Copy to devices.
+    if (target == Target::Devices) {
+        #pragma omp taskgroup
+        for (int m = 0; m < num_matrices; ++m) {
+            for (int d = 0; d < num_devices(); ++d) {
+                if (! tile_set[m][d].empty()) {
+                    #pragma omp task slate_omp_default_none \
+                        firstprivate( m, d, is_shared ) \
+                        shared( tile_set, matrices )
+                    {
+                        auto& X = *matrices[ m ];
+                        if (is_shared) {
+                            X.tileGetAndHold(tile_set[m][d], d, LayoutConvert::None);
+                        }
+                        else if (prefetch()) {
+                            X.tilePrefetch(tile_set[m][d], d);
+                        }
+                        else {
+                            X.tileGetForReading(tile_set[m][d], d, LayoutConvert::None);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (! send_requests.empty()) {
+        internal::comm_waitall( send_requests.size(), send_requests.data() );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Send tile {i, j} of op(A) to all MPI ranks in the list of submatrices
+/// bcast_list (using OpenMP tasksloop and multi-threaded MPI).
+/// Data received must be in 'layout' (ColMajor/RowMajor) major.
+///
+/// @tparam target
+///     Destination to target; either Host (default) or Device.
+///
+/// @param[in] bcast_list
 ///     List of submatrices defining the MPI ranks to send to.
 ///     Usually it is the portion of the matrix to be updated by tile {i, j}.
 ///     Each tile {i, j} to be broadcast has a tag in the bcast_list.
@@ -2124,10 +2984,21 @@ void BaseMatrix<scalar_t>::listBcast(
 ///     WARNING: must set unhold these tiles before releasing them to free
 ///     up the allocated memories.
 ///
+/// @param[in] radix
+///     Radix of the hypercube broadcast pattern, default 4;
+///     see internal::cubeBcastPattern. Must be the same on all ranks.
+///     Tiles larger than bcast_chunk_size() are pipelined in chunks.
+///
+/// @param[in] hierarchical
+///     If true, and internal::commNodes was called for the matrix's
+///     communicator, broadcast between nodes first, then within nodes,
+///     as in listBcast. Default false. Must be the same on all ranks.
+///
 template <typename scalar_t>
 template <Target target>
 void BaseMatrix<scalar_t>::listBcastMT(
-    BcastListTag& bcast_list, Layout layout, bool is_shared )
+    BcastListTag& bcast_list, Layout layout, bool is_shared, int radix,
+    bool hierarchical )
 {
     if (target == Target::Devices) {
         assert(num_devices() > 0);
@@ -2143,7 +3014,7 @@ void BaseMatrix<scalar_t>::listBcastMT(
     // Also, currently, the message is received to the same buffer.
 
     int mpi_size;
-    MPI_Comm_size(mpiComm(), &mpi_size);
+    slate_mpi_call( MPI_Comm_size(mpiComm(), &mpi_size) );
 
     // This uses multiple OMP threads for MPI broadcast communication
     // todo: threads may clash with panel-threads slowing performance
@@ -2153,7 +3024,8 @@ void BaseMatrix<scalar_t>::listBcastMT(
 
     #if defined( SLATE_HAVE_MT_BCAST )
         #pragma omp taskloop slate_omp_default_none \
-            shared( bcast_list ) firstprivate( layout, mpi_size, is_shared )
+            shared( bcast_list ) \
+            firstprivate( layout, mpi_size, is_shared, radix, hierarchical )
     #endif
     for (size_t bcastnum = 0; bcastnum < bcast_list.size(); ++bcastnum) {
 
@@ -2166,7 +3038,7 @@ void BaseMatrix<scalar_t>::listBcastMT(
 
         {
             trace::Block trace_block(
-                std::string("listBcast("+std::to_string(i)+","+std::to_string(j)+")").c_str());
+                "listBcast", i, j, tileMb(i) * tileNb(j) * sizeof(scalar_t) );
 
             // Find the set of participating ranks.
             std::set<int> bcast_set;
@@ -2186,8 +3058,8 @@ void BaseMatrix<scalar_t>::listBcastMT(
                 // Send across MPI ranks.
                 // Previous used MPI bcast: tileBcastToSet(i, j, bcast_set);
                 // Currently uses radix-D hypercube p2p send.
-                int radix = 4; // bcast_set.size(); // 2;
-                tileBcastToSet(i, j, bcast_set, radix, tag, layout, target);
+                tileBcastToSet(i, j, bcast_set, radix, tag, layout, target,
+                               hierarchical);
             }
 
             // Copy to devices.
@@ -2213,11 +3085,65 @@ void BaseMatrix<scalar_t>::listBcastMT(
 }
 
 //------------------------------------------------------------------------------
+/// Reduce each tile {i, j} in reduce_list from the MPI ranks owning the
+/// submatrices in its list to the rank owning its destination submatrix.
+/// Equivalent to listReduceBegin followed by listReduceEnd, so the
+/// reductions of all tiles in the list proceed concurrently.
+/// Data sent and received must be in 'layout' (ColMajor/RowMajor) major.
+///
+/// @tparam target
+///     Host (default), or Devices to accumulate on the devices when MPI is
+///     GPU-aware.
+///
+/// @param[in] reduce_list
+///     List of {i, j, destination submatrix, list of source submatrices}.
+///
+/// @param[in] layout
+///     Layout (ColMajor/RowMajor) of the communicated data.
+///
+/// @param[in] tag
+///     MPI tag, default 0.
+///
+/// @param[in] radix
+///     Radix of the reduction tree, default 2;
+///     see internal::cubeReducePattern. Must be the same on all ranks.
+///
+template <typename scalar_t>
+template <Target target>
+void BaseMatrix<scalar_t>::listReduce(
+    ReduceList& reduce_list, Layout layout, int tag, int radix)
+{
+    auto requests = listReduceBegin<target>( reduce_list, layout, tag, radix );
+    listReduceEnd( requests );
+}
+
+//------------------------------------------------------------------------------
+/// Starts reducing each tile {i, j} in reduce_list, as listReduce does,
+/// without waiting for other ranks.
+/// Posts receives from this rank's children in the reduction tree of every
+/// tile, and forwards leading tiles that have no children to the parent.
+/// The caller can then do other work, e.g., the next lookahead step, and
+/// must complete the reductions with listReduceEnd on the same matrix
+/// before using or releasing the tiles. Tiles are forwarded in list order,
+/// so messages between each pair of ranks match in order.
+///
+/// With target Devices and GPU-aware MPI (see gpu_aware_mpi()), tiles are
+/// received into device workspace and accumulated on the device where
+/// tileDevice() places them, using device::geadd; otherwise on the host.
+///
+/// @return requests to pass to listReduceEnd.
+///
+/// @see listReduce for parameters.
 ///
 template <typename scalar_t>
 template <Target target>
-void BaseMatrix<scalar_t>::listReduce(ReduceList& reduce_list, Layout layout, int tag)
+typename BaseMatrix<scalar_t>::ReduceRequests
+BaseMatrix<scalar_t>::listReduceBegin(
+    ReduceList& reduce_list, Layout layout, int tag, int radix)
 {
+    ReduceRequests requests;
+    requests.tag = tag;
+
     for (auto reduce : reduce_list) {
 
         auto i = std::get<0>(reduce);
@@ -2231,25 +3157,168 @@ void BaseMatrix<scalar_t>::listReduce(ReduceList& reduce_list, Layout layout, in
         for (auto submatrix : submatrices_list) // Insert sources.
             submatrix.getRanks(&reduce_set);
 
-        // If this rank is in the set.
-        if (root_rank == mpi_rank_
-            || reduce_set.find(mpi_rank_) != reduce_set.end()) {
+        // If this rank is not in the set, or the set is empty.
+        if (reduce_set.empty()
+            || (root_rank != mpi_rank_
+                && reduce_set.find(mpi_rank_) == reduce_set.end())) {
+            continue;
+        }
+        reduce_set.insert(root_rank);
+
+        // Convert the set to a sorted vector, and shift root to position zero.
+        std::vector<int> reduce_vec(reduce_set.begin(), reduce_set.end());
+        auto root_iter = std::find(reduce_vec.begin(), reduce_vec.end(), root_rank);
+        std::vector<int> new_vec(root_iter, reduce_vec.end());
+        new_vec.insert(new_vec.end(), reduce_vec.begin(), root_iter);
+
+        // Find the new rank.
+        auto rank_iter = std::find(new_vec.begin(), new_vec.end(), mpi_rank_);
+        int new_rank = std::distance(new_vec.begin(), rank_iter);
+
+        // Get the send/recv pattern.
+        std::list<int> recv_from;
+        std::list<int> send_to;
+        internal::cubeReducePattern(new_vec.size(), new_rank, radix,
+                                    recv_from, send_to);
+        if (send_to.empty() && recv_from.empty())
+            continue;
+
+        int device = HostNum;
+        if (target == Target::Devices && gpu_aware_mpi()) {
+            device = tileDevice( i, j );
+        }
 
-            // Reduce across MPI ranks.
-            // Uses 2D hypercube p2p send.
-            tileReduceFromSet(i, j, root_rank, reduce_set, 2, tag, layout);
+        typename ReduceRequests::TileReduce tile_reduce;
+        tile_reduce.i = i;
+        tile_reduce.j = j;
+        tile_reduce.device = device;
+        tile_reduce.send_to = send_to.empty() ? -1 : new_vec[send_to.front()];
+        tile_reduce.is_root = root_rank == mpi_rank_;
 
-            // If not the tile owner.
-            if (! tileIsLocal(i, j)) {
+        if (recv_from.empty())
+            tileGetForReading(i, j, device, LayoutConvert(layout));
+        else
+            tileGetForWriting(i, j, device, LayoutConvert(layout));
 
-                // Destroy the tile.
-                // todo: should it be a tileRelease()?
-                if (mpi_rank_ != root_rank)
-                    tileErase( i, j, HostNum );
-            }
-            else if (root_rank == mpi_rank_ && reduce_set.size() > 1) {
-                tileModified( i, j );
+        // Post receives from children, each into its own buffer.
+        auto Aij = at(i, j, device);
+        int64_t mb = Aij.op() == Op::NoTrans ? Aij.mb() : Aij.nb();
+        int64_t nb = Aij.op() == Op::NoTrans ? Aij.nb() : Aij.mb();
+        int64_t lda = layout == Layout::ColMajor ? mb : nb;
+        for (int src : recv_from) {
+            scalar_t* buffer = allocWorkspaceBuffer( device, mb*nb );
+            Tile<scalar_t> tile( Aij, buffer, lda, TileKind::Workspace );
+            MPI_Request request;
+            tile.irecv( new_vec[src], mpi_comm_, layout, tag, &request,
+                        storage_->commPlan() );
+            tile_reduce.buffers.push_back( buffer );
+            tile_reduce.recv_requests.push_back( request );
+        }
+        requests.tiles.push_back( std::move( tile_reduce ) );
+    }
+
+    listReduceForward( requests, false );
+    return requests;
+}
+
+//------------------------------------------------------------------------------
+/// Completes the reductions started by listReduceBegin.
+/// Accumulates children's contributions as they arrive, forwards each
+/// partial sum to its parent, then waits for the sends and frees the
+/// receive buffers. Tiles sent by ranks that don't own them are erased
+/// from the host and all devices.
+///
+/// @param[in,out] requests
+///     Requests from listReduceBegin on this matrix. On exit, empty.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::listReduceEnd(ReduceRequests& requests)
+{
+    listReduceForward( requests, true );
+
+    if (! requests.send_requests.empty()) {
+        internal::comm_waitall( requests.send_requests.size(),
+                                requests.send_requests.data() );
+    }
+
+    for (auto& tile_reduce : requests.tiles) {
+        int64_t i = tile_reduce.i;
+        int64_t j = tile_reduce.j;
+        for (auto buffer : tile_reduce.buffers)
+            freeWorkspaceBuffer( tile_reduce.device, buffer );
+
+        // If not the tile owner.
+        if (! tileIsLocal(i, j)) {
+            // Destroy the tile, including any host or device copies
+            // made while computing or forwarding the partial sum.
+            if (! tile_reduce.is_root)
+                tileErase( i, j, AllDevices );
+        }
+        else if (tile_reduce.is_root) {
+            tileModified( i, j, tile_reduce.device );
+        }
+    }
+    requests.tiles.clear();
+    requests.send_requests.clear();
+    requests.next = 0;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Forwards the partial sums of reductions in requests, in list order.
+/// A tile with children is forwarded only after accumulating all of
+/// them, so if wait is false, stops at the first such tile; if wait is
+/// true, waits for children's contributions, accumulating each as it
+/// arrives.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::listReduceForward(
+    ReduceRequests& requests, bool wait)
+{
+    const scalar_t one = 1.0;
+
+    for (; requests.next < requests.tiles.size(); ++requests.next) {
+        auto& tile_reduce = requests.tiles[ requests.next ];
+        int64_t i = tile_reduce.i;
+        int64_t j = tile_reduce.j;
+        int device = tile_reduce.device;
+        auto Aij = at(i, j, device);
+
+        int num_children = tile_reduce.recv_requests.size();
+        if (num_children > 0) {
+            if (! wait)
+                break;
+
+            int64_t mb = Aij.op() == Op::NoTrans ? Aij.mb() : Aij.nb();
+            int64_t nb = Aij.op() == Op::NoTrans ? Aij.nb() : Aij.mb();
+            int64_t lda = Aij.layout() == Layout::ColMajor ? mb : nb;
+            for (int k = 0; k < num_children; ++k) {
+                int index;
+                internal::comm_waitany( num_children,
+                                        tile_reduce.recv_requests.data(),
+                                        &index );
+                scalar_t* buffer = tile_reduce.buffers[ index ];
+                if (device == HostNum) {
+                    Tile<scalar_t> tile( Aij, buffer, lda, TileKind::Workspace );
+                    tile::add( one, tile, Aij );
+                }
+                else {
+                    // Stored as ColMajor lda-by-n, whatever the layout.
+                    int64_t n = Aij.layout() == Layout::ColMajor ? nb : mb;
+                    device::geadd( lda, n, one, buffer, lda,
+                                   one, Aij.data(), Aij.stride(),
+                                   *comm_queue( device ) );
+                }
             }
+            if (device != HostNum)
+                comm_queue( device )->sync();
+        }
+
+        if (tile_reduce.send_to >= 0) {
+            MPI_Request request;
+            Aij.isend( tile_reduce.send_to, mpi_comm_, requests.tag, &request,
+                       storage_->commPlan() );
+            requests.send_requests.push_back( request );
         }
     }
 }
@@ -2280,16 +3349,21 @@ void BaseMatrix<scalar_t>::listReduce(ReduceList& reduce_list, Layout layout, in
 /// @param[in] layout
 ///     Indicates the Layout (ColMajor/RowMajor) of the received data.
 ///
+/// @param[in] hierarchical
+///     Whether to use internal::hierarchicalBcastPattern; see
+///     tileIbcastToSet.
+///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileBcastToSet(
     int64_t i, int64_t j, std::set<int> const& bcast_set,
-    int radix, int tag, Layout layout, Target target)
+    int radix, int tag, Layout layout, Target target, bool hierarchical)
 {
     std::vector<MPI_Request> requests;
     requests.reserve(radix);
 
-    tileIbcastToSet(i, j, bcast_set, radix, tag, layout, requests, target);
-    slate_mpi_call(MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE));
+    tileIbcastToSet(i, j, bcast_set, radix, tag, layout, requests, target,
+                    hierarchical);
+    internal::comm_waitall( requests.size(), requests.data() );
 }
 
 //------------------------------------------------------------------------------
@@ -2301,6 +3375,17 @@ void BaseMatrix<scalar_t>::tileBcastToSet(
 /// Data received must be in 'layout' (ColMajor/RowMajor) major.
 /// Nonblocking sends are used, with requests appended to the provided vector.
 ///
+/// Tiles larger than bcast_chunk_size() bytes are pipelined: they are sent
+/// in chunks of whole columns (rows if RowMajor), and each receiver
+/// forwards a chunk as soon as it arrives, so the broadcast takes about
+/// one tile transfer plus the per-hop latency, instead of one tile
+/// transfer per hop. Chunking depends only on the tile size, so all ranks
+/// agree on it.
+///
+/// If the matrix is attached to a workspace arena, messages use the
+/// persistent requests of its communication plan (see CommPlan), so
+/// repeated calls with the same pattern don't rebuild them.
+///
 /// @param[in] i
 ///     Tile's block row index. 0 <= i < mt.
 ///
@@ -2322,12 +3407,18 @@ void BaseMatrix<scalar_t>::tileBcastToSet(
 /// @param[in,out] send_requests
 ///     Vector where requests for this bcast are appended.
 ///
+/// @param[in] hierarchical
+///     Whether to use internal::hierarchicalBcastPattern, if the nodes of
+///     the matrix's communicator are known; see internal::commNodes.
+///     If the workspace arena also has node-shared memory, host tiles are
+///     received once per node; see tileIbcastNodeShared.
+///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileIbcastToSet(
     int64_t i, int64_t j, std::set<int> const& bcast_set,
     int radix, int tag, Layout layout,
     std::vector<MPI_Request>& send_requests,
-    Target target)
+    Target target, bool hierarchical)
 {
     // Quit if only root in the broadcast set.
     if (bcast_set.size() == 1)
@@ -2352,23 +3443,104 @@ void BaseMatrix<scalar_t>::tileIbcastToSet(
     auto rank_iter = std::find(new_vec.begin(), new_vec.end(), mpi_rank_);
     int new_rank = std::distance(new_vec.begin(), rank_iter);
 
-    // Get the send/recv pattern.
+    // Get the send/recv pattern, as ranks.
     std::list<int> recv_from;
     std::list<int> send_to;
-    internal::cubeBcastPattern(new_vec.size(), new_rank, radix,
-                               recv_from, send_to);
+    std::vector<int> const* nodes = nullptr;
+    if (hierarchical)
+        nodes = internal::commNodesCached( mpi_comm_ );
+    if (nodes != nullptr) {
+        internal::hierarchicalBcastPattern(new_vec, *nodes, mpi_rank_, radix,
+                                           recv_from, send_to);
+    }
+    else {
+        internal::cubeBcastPattern(new_vec.size(), new_rank, radix,
+                                   recv_from, send_to);
+        for (auto& r : recv_from)
+            r = new_vec[r];
+        for (auto& r : send_to)
+            r = new_vec[r];
+    }
 
     int device = HostNum;
     if (target == Target::Devices && gpu_aware_mpi()) {
         device = tileDevice( i, j );
     }
 
+    // Persistent requests of the attached workspace arena, if any.
+    CommPlan* plan = storage_->commPlan();
+
+    // Split tiles above the chunk size into chunks of whole columns
+    // (ColMajor) or rows (RowMajor) of the stored tile.
+    // The tile's op doesn't matter; chunks are in storage order.
+    int64_t mb = tileMb( i );
+    int64_t nb = tileNb( j );
+    if (op_ != Op::NoTrans)
+        std::swap( mb, nb );
+    int64_t outer = layout == Layout::ColMajor ? nb : mb;
+    int64_t tile_bytes = mb * nb * sizeof(scalar_t);
+    int64_t chunk_size = bcast_chunk_size();
+    int64_t num_chunks = 1;
+    if (chunk_size > 0 && tile_bytes > chunk_size)
+        num_chunks = std::min( ceildiv( tile_bytes, chunk_size ), outer );
+
+    // Within nodes, share one copy of the tile, if the workspace arena has
+    // node-shared memory; see Workspace::enableNodeShared.
+    if (nodes != nullptr && device == HostNum && num_chunks == 1
+        && tileIbcastNodeShared( i, j, new_vec, *nodes, radix, tag, layout,
+                                 send_requests )) {
+        return;
+    }
+
+    if (num_chunks > 1) {
+        int64_t chunk_outer = ceildiv( outer, num_chunks );
+        num_chunks = ceildiv( outer, chunk_outer );
+
+        // Receive all chunks, forwarding each one as soon as it arrives.
+        std::vector<MPI_Request> recv_requests;
+        if (! recv_from.empty()) {
+            tileAcquire(i, j, device, layout);
+            auto Aij = at(i, j, device);
+            int src = recv_from.front();
+            recv_requests.resize( num_chunks );
+            for (int64_t c = 0; c < num_chunks; ++c) {
+                int64_t first = c*chunk_outer;
+                int64_t count = std::min( chunk_outer, outer - first );
+                Aij.irecvChunk( first, count, src, mpi_comm_, tag,
+                                &recv_requests[ c ], plan );
+            }
+        }
+        else {
+            tileGetForReading(i, j, device, LayoutConvert(layout));
+        }
+
+        auto Aij = at(i, j, device);
+        for (int64_t c = 0; c < num_chunks; ++c) {
+            if (! recv_requests.empty()) {
+                internal::comm_wait( &recv_requests[ c ] );
+            }
+            int64_t first = c*chunk_outer;
+            int64_t count = std::min( chunk_outer, outer - first );
+            for (int dst : send_to) {
+                MPI_Request request;
+                Aij.isendChunk( first, count, dst, mpi_comm_, tag,
+                                &request, plan );
+                send_requests.push_back(request);
+            }
+        }
+
+        if (! recv_from.empty())
+            tileModified(i, j, device, true);
+        return;
+    }
+
     // Receive.
     if (! recv_from.empty()) {
         // read tile
         tileAcquire(i, j, device, layout);
 
-        at(i, j, device).recv(new_vec[recv_from.front()], mpi_comm_, layout, tag);
+        at(i, j, device).recv(recv_from.front(), mpi_comm_, layout, tag,
+                              plan);
         tileModified(i, j, device, true);
     }
 
@@ -2380,12 +3552,185 @@ void BaseMatrix<scalar_t>::tileIbcastToSet(
         // Forward using multiple mpi_isend() calls
         for (int dst : send_to) {
             MPI_Request request;
-            Aij.isend(new_vec[dst], mpi_comm_, tag, &request);
+            Aij.isend(dst, mpi_comm_, tag, &request, plan);
             send_requests.push_back(request);
         }
     }
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Broadcasts tile {i, j} as the hierarchical tileIbcastToSet does between
+/// nodes, but within each node, the tile goes through node-shared memory
+/// (see Workspace::enableNodeShared): the node's leader, its first rank in
+/// bcast_ranks, receives the tile once into a block of the pool, or copies
+/// it there if it is the root, then sends only the block's index to the
+/// node's other ranks in the broadcast, which read the block in place as
+/// a NodeShared tile, instead of each receiving a copy.
+/// If no block is free, the leader sends NodeSharedPool::no_block, then
+/// the tile itself, to each of them.
+///
+/// @param[in] bcast_ranks
+///     Ranks in the broadcast, root first.
+///
+/// @param[in] nodes
+///     Node of each rank, from internal::commNodes.
+///
+/// @return false, doing nothing, if the matrix's workspace arena has no
+///     node-shared memory for its communicator, the tile doesn't fit in a
+///     block, or the tile is a slice; the caller then broadcasts as usual.
+///     Since all ranks decide the same way, which does not depend on
+///     whether blocks are free, the messages between nodes match in all
+///     cases.
+///
+template <typename scalar_t>
+bool BaseMatrix<scalar_t>::tileIbcastNodeShared(
+    int64_t i, int64_t j, std::vector<int> const& bcast_ranks,
+    std::vector<int> const& nodes, int radix, int tag, Layout layout,
+    std::vector<MPI_Request>& send_requests)
+{
+    NodeSharedPool* pool = storage_->nodeSharedPool();
+    if (pool == nullptr || pool->mpiComm() != mpi_comm_
+        || ! tileIsWhole( i, j ))
+        return false;
+
+    // Blocks hold the stored tile, contiguous in layout.
+    int64_t mb = tileMb( i );
+    int64_t nb = tileNb( j );
+    if (op_ != Op::NoTrans)
+        std::swap( mb, nb );
+    if (size_t( mb * nb * sizeof(scalar_t) ) > pool->blockSize())
+        return false;
+    int64_t rows = layout == Layout::ColMajor ? mb : nb;
+    int64_t cols = layout == Layout::ColMajor ? nb : mb;
+    int64_t lda = rows;
+
+    CommPlan* plan = storage_->commPlan();
+
+    // Ranks of this node in the broadcast; the first one leads it.
+    std::vector<int> node_ranks;
+    for (int r : bcast_ranks) {
+        if (nodes[ r ] == nodes[ mpi_rank_ ])
+            node_ranks.push_back( r );
+    }
+    int leader = node_ranks.front();
+
+    // Makes the block the host instance of the tile. If a valid host
+    // instance exists, e.g., when the same tile is received twice, it may
+    // be in use, so copy the block into it instead, as a receive would.
+    auto use_block = [&]( scalar_t* data ) {
+        bool replace;
+        {
+            auto& tile_node = storage_->at( globalIndex( i, j ) );
+            LockGuard guard( tile_node.getLock() );
+            replace = ! tile_node.existsOn( HostNum )
+                      || tile_node[ HostNum ]->stateOn( MOSI::Invalid );
+        }
+        if (replace) {
+            storage_->tileInsertNodeShared( globalIndex( i, j ), data,
+                                            layout, pool );
+        }
+        else {
+            tileAcquire( i, j, HostNum, layout );
+            auto tile = storage_->at( globalIndex( i, j, HostNum ) );
+            lapack::lacpy( lapack::MatrixType::General, rows, cols,
+                           data, lda, tile->data(), tile->stride() );
+            pool->release( data );
+            tileModified( i, j, HostNum, true );
+        }
+    };
+
+    if (mpi_rank_ != leader) {
+        // Receive the block's index, or the tile if there is no block.
+        int64_t block;
+        slate_mpi_call(
+            MPI_Recv( &block, 1, MPI_INT64_T, leader, tag, mpi_comm_,
+                      MPI_STATUS_IGNORE ) );
+        if (block != NodeSharedPool::no_block) {
+            pool->sync();
+            use_block( (scalar_t*) pool->data( block ) );
+        }
+        else {
+            tileAcquire( i, j, HostNum, layout );
+            at( i, j ).recv( leader, mpi_comm_, layout, tag, plan );
+            tileModified( i, j, HostNum, true );
+        }
+        return true;
+    }
+
+    // Between nodes, as in hierarchicalBcastPattern.
+    std::list<int> recv_from;
+    std::list<int> send_to;
+    internal::hierarchicalBcastPattern( bcast_ranks, nodes, mpi_rank_, radix,
+                                        recv_from, send_to );
+    send_to.remove_if( [&]( int r ) { return nodes[ r ] == nodes[ mpi_rank_ ]; } );
+
+    // A block is read by the node's other ranks, and by the leader
+    // unless it is the root.
+    int64_t num_readers = node_ranks.size() - 1;
+    int64_t block = NodeSharedPool::no_block;
+    if (num_readers > 0)
+        block = pool->acquire( num_readers + (recv_from.empty() ? 0 : 1) );
+
+    if (! recv_from.empty()) {
+        if (block != NodeSharedPool::no_block) {
+            scalar_t* data = (scalar_t*) pool->data( block );
+            Tile<scalar_t> tile( mb, nb, data, lda, HostNum,
+                                 TileKind::NodeShared, layout );
+            tile.recv( recv_from.front(), mpi_comm_, layout, tag, plan );
+            use_block( data );
+        }
+        else {
+            tileAcquire( i, j, HostNum, layout );
+            at( i, j ).recv( recv_from.front(), mpi_comm_, layout, tag, plan );
+            tileModified( i, j, HostNum, true );
+        }
+    }
+    else if (block != NodeSharedPool::no_block) {
+        // Root copies its tile into the block.
+        tileGetForReading( i, j, HostNum, LayoutConvert( layout ) );
+        auto tile = storage_->at( globalIndex( i, j, HostNum ) );
+        lapack::lacpy( lapack::MatrixType::General, rows, cols,
+                       tile->data(), tile->stride(),
+                       (scalar_t*) pool->data( block ), lda );
+    }
+
+    // Send the block's index to the node's other ranks.
+    int64_t const* index = &NodeSharedPool::no_block;
+    if (block != NodeSharedPool::no_block) {
+        pool->sync();
+        index = pool->index( block );
+    }
+    for (int r : node_ranks) {
+        if (r != leader) {
+            MPI_Request request;
+            slate_mpi_call(
+                MPI_Isend( index, 1, MPI_INT64_T, r, tag, mpi_comm_,
+                           &request ) );
+            send_requests.push_back( request );
+        }
+    }
+
+    // Send the tile to other nodes' leaders, and, without a block,
+    // to the node's other ranks.
+    if (block == NodeSharedPool::no_block) {
+        for (int r : node_ranks) {
+            if (r != leader)
+                send_to.push_back( r );
+        }
+    }
+    if (! send_to.empty()) {
+        tileGetForReading( i, j, HostNum, LayoutConvert( layout ) );
+        auto Aij = at( i, j, HostNum );
+        for (int dst : send_to) {
+            MPI_Request request;
+            Aij.isend( dst, mpi_comm_, tag, &request, plan );
+            send_requests.push_back( request );
+        }
+    }
+    return true;
+}
+
 //------------------------------------------------------------------------------
 /// [internal]
 /// WARNING: Sent and Recevied tiles are converted to 'layout' major.
@@ -2563,6 +3908,26 @@ void BaseMatrix<scalar_t>::tileCopyDataLayout(Tile<scalar_t>* src_tile,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Prints this rank's per-tile transfer counts, counted while
+/// transferHeatMap was enabled, as "rank i j count" lines, one per tile
+/// transferred, with i, j indices in the parent matrix. Tiles that
+/// transfer many times, e.g., ping-pong between host and device, stand out.
+///
+/// @param[in] file
+///     File to print to. Default stdout.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::transferHeatMapPrint(FILE* file) const
+{
+    for (auto const& iter : transferHeat()) {
+        fprintf( file, "%d %lld %lld %lld\n", mpiRank(),
+                 llong( std::get<0>( iter.first ) ),
+                 llong( std::get<1>( iter.first ) ),
+                 llong( iter.second ) );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Acquire tile(i, j) on device without copying data if not already exists.
 /// This is used when the destination tile's data will be overriden.
@@ -2583,12 +3948,34 @@ void BaseMatrix<scalar_t>::tileCopyDataLayout(Tile<scalar_t>* src_tile,
 ///     - ColMajor: column major.
 ///     - RowMajor: row major.
 ///
+/// @param[in] queue
+///     If given, queue that will overwrite the tile waits for pending
+///     device work on it (see DeviceEvent); otherwise, the host waits.
+///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileAcquire(int64_t i, int64_t j, int device,
-                                       Layout layout)
+                                       Layout layout, lapack::Queue* queue)
 {
     auto tile = storage_->tileInsert( globalIndex(i, j, device),
                                       TileKind::Workspace, layout );
+    {
+        // Allocate lazy tile; its data will be overwritten.
+        auto& tile_node = storage_->at( globalIndex(i, j) );
+        LockGuard guard( tile_node.getLock() );
+        storage_->tileMaterialize( tile_node, device, false );
+        // Other ranks of the node read NodeShared memory; overwrite a copy.
+        storage_->tilePrivatize( tile, false );
+
+        // Overwriting must wait for earlier reads and writes.
+        if (queue != nullptr)
+            tile_node.waitEvents( device, *queue, true );
+        else
+            tile_node.syncEvents( device, true );
+
+        // Pin against eviction, as tileGet does.
+        if (device != HostNum)
+            tile_node.pin( device );
+    }
 
     // Change ColMajor <=> RowMajor if needed.
     if (tile->layout() != layout) {
@@ -2599,6 +3986,82 @@ void BaseMatrix<scalar_t>::tileAcquire(int64_t i, int64_t j, int device,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Gets tile(i, j) on device for writing, without copying in its data,
+/// for a tile that the caller will entirely overwrite, e.g., C in gemm
+/// with beta = 0, or the destination of a copy.
+/// Unlike tileGetForWriting, no valid instance is needed, and none is
+/// transferred; the tile's contents are undefined until written.
+/// Marks the tile as MOSI::Modified and invalidates other instances.
+/// If tile(i, j) of this view is only part of the tile, e.g., of a slice,
+/// the rest of the tile must be kept, so if the tile has a valid instance,
+/// this gets it as tileGetForWriting does.
+///
+/// @param[in] i
+///     Tile's block row index. 0 <= i < mt.
+///
+/// @param[in] j
+///     Tile's block column index. 0 <= j < nt.
+///
+/// @param[in] device
+///     Tile's destination: host or device ID.
+///
+/// @param[in] layout
+///     Layout of the tile's new data.
+///
+/// @param[in] queue
+///     If given, queue that will overwrite the tile waits for pending
+///     device work on it; otherwise, the host waits.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileAcquireForOverwrite(
+    int64_t i, int64_t j, int device, Layout layout, lapack::Queue* queue)
+{
+    if (! tileIsWhole( i, j )) {
+        auto& tile_node = storage_->at( globalIndex( i, j ) );
+        LockGuard guard( tile_node.getLock() );
+        for (int d = HostNum; d < num_devices(); ++d) {
+            if (tile_node.existsOn( d )
+                && ! tile_node[ d ]->stateOn( MOSI::Invalid )) {
+                tileGet( i, j, device, LayoutConvert( layout ),
+                         true, false, false, queue );
+                return;
+            }
+        }
+    }
+    tileAcquire( i, j, device, layout, queue );
+    tileModified( i, j, device, true );
+}
+
+//------------------------------------------------------------------------------
+/// Gets a set of tiles on device for writing, without copying in data.
+/// @see tileAcquireForOverwrite
+///
+/// @param[in] tile_set
+///     Set of (i, j) tuples indicating indices of Tiles' to be acquired.
+///
+/// @param[in] device
+///     Tiles' destination: host or device ID.
+///
+/// @param[in] layout
+///     Layout of the tiles' new data.
+///
+/// @param[in] queue
+///     If given, queue that will overwrite the tiles waits for pending
+///     device work on them; otherwise, the host waits.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileAcquireForOverwrite(
+    TileSet& tile_set, int device, Layout layout,
+    lapack::Queue* queue)
+{
+    for (auto ij : tile_set) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        tileAcquireForOverwrite( i, j, device, layout, queue );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Gets tile(i, j) on device.
 /// Will copy-in the tile if it does not exist or its state is MOSI::Invalid.
@@ -2635,11 +4098,17 @@ void BaseMatrix<scalar_t>::tileAcquire(int64_t i, int64_t j, int device,
 /// @param[in] async
 ///     true: does not synchronize with device stream.
 ///
+/// @param[in] queue
+///     Queue that will use the tile, for device routines that track
+///     dependencies with events (see DeviceEvent). If given, the queue
+///     waits for pending device work on the destination tile; otherwise,
+///     the host waits, as callers that don't track events expect.
+///
 // todo: async version
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGet(int64_t i, int64_t j, int dst_device,
                                    LayoutConvert layout, bool modify, bool hold,
-                                   bool async)
+                                   bool async, lapack::Queue* queue)
 {
     // todo: need to acquire read access to the TilesMap
     // LockGuard guard2(storage_->getTilesMapLock());
@@ -2698,10 +4167,43 @@ void BaseMatrix<scalar_t>::tileGet(int64_t i, int64_t j, int dst_device,
     }
 
     Tile<scalar_t>* dst_tile = tile_node[dst_device];
+    tile_node.touch( dst_device, storage_->lruTick() );
+    // Allocate a lazy tile; a valid one is zero. An invalid one is copied to,
+    // unless the source is also lazy, hence zero: then zero it instead.
+    bool src_lazy = src_tile != nullptr && src_tile->data() == nullptr;
+    storage_->tileMaterialize( tile_node, dst_device,
+                               dst_tile->state() != MOSI::Invalid || src_lazy );
+
+    // Copies and layout conversions use the comm queues and synchronize,
+    // so they first wait on the host for pending device work on the tiles.
+    if (dst_tile->state() == MOSI::Invalid
+        || (layout != LayoutConvert::None
+            && dst_tile->layout() != Layout(layout))) {
+        if (src_tile != nullptr)
+            tile_node.syncEvents( src_device, false );
+        tile_node.syncEvents( dst_device, true );
+    }
+    else if (queue != nullptr) {
+        tile_node.waitEvents( dst_device, *queue, modify );
+    }
+    else {
+        tile_node.syncEvents( dst_device, modify );
+    }
+
+    // Other ranks of the node read NodeShared memory; write to a copy.
+    if (modify || dst_tile->state() == MOSI::Invalid)
+        storage_->tilePrivatize( dst_tile, dst_tile->state() != MOSI::Invalid );
+
     if (dst_tile->state() == MOSI::Invalid) {
         // Update the destination tile's data.
-
-        tileCopyDataLayout( src_tile, dst_tile, target_layout, async );
+        if (! src_lazy) {
+            tileCopyDataLayout( src_tile, dst_tile, target_layout, async );
+            storage_->countTransfer( globalIndex(i, j), src_tile->device(),
+                                     dst_device, src_tile->bytes() );
+            storage_->countTransitions( 1 );
+            if (src_tile->layout() != target_layout)
+                storage_->countLayoutConversion();
+        }
 
         dst_tile->state(MOSI::Shared);
         src_tile->state(MOSI::Shared); // src was either shared or modified
@@ -2712,6 +4214,10 @@ void BaseMatrix<scalar_t>::tileGet(int64_t i, int64_t j, int dst_device,
     if (hold) {
         dst_tile->state(MOSI::OnHold);
     }
+    // Keep a device tile from being evicted before the caller's work on it
+    // is enqueued; released by tileRelease, tileRecordEvent, or tileUnsetHold.
+    if (dst_device != HostNum)
+        tile_node.pin( dst_device );
 
     // Change ColMajor <=> RowMajor if needed.
     if (layout != LayoutConvert::None && dst_tile->layout() != Layout(layout)) {
@@ -2748,11 +4254,15 @@ void BaseMatrix<scalar_t>::tileGet(int64_t i, int64_t j, int dst_device,
 /// @param[in] async
 ///     if true, does not synchronize with device stream.
 ///
+/// @param[in] queue
+///     If given, queue that will use the tiles waits for pending device work
+///     on them; otherwise, the host waits.
+///
 // todo: async version
 template <typename scalar_t>
-void BaseMatrix<scalar_t>::tileGet(std::set<ij_tuple>& tile_set, int device,
+void BaseMatrix<scalar_t>::tileGet(TileSet& tile_set, int device,
                                    LayoutConvert layoutConvert, bool modify, bool hold,
-                                   bool async)
+                                   bool async, lapack::Queue* queue)
 {
     if (device != HostNum) {
         LockGuard guard(storage_->getTilesMapLock());
@@ -2762,19 +4272,35 @@ void BaseMatrix<scalar_t>::tileGet(std::set<ij_tuple>& tile_set, int device,
         for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
             int64_t i = std::get<0>(*iter);
             int64_t j = std::get<1>(*iter);
-            existing_tiles += tileExists(i, j, device);
+            if (tileExists(i, j, device)) {
+                ++existing_tiles;
+                // Mark as recent so they aren't evicted to make room.
+                storage_->tileTouch( globalIndex(i, j, device) );
+            }
         }
 
         // ensure workspace exists for the rest
         if (tile_set.size() > size_t(existing_tiles))
             storage_->ensureDeviceWorkspace(device, tile_set.size() - existing_tiles);
+
+        // Enqueue zeroing of all valid lazy tiles first, so tileGet below
+        // waits on them together, rather than on each in turn.
+        for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
+            int64_t i = std::get<0>(*iter);
+            int64_t j = std::get<1>(*iter);
+            auto& tile_node = storage_->at( globalIndex(i, j) );
+            LockGuard guard( tile_node.getLock() );
+            if (tile_node.existsOn( device )
+                && tile_node[ device ]->state() != MOSI::Invalid)
+                storage_->tileMaterialize( tile_node, device, true );
+        }
     }
 
     for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
         int64_t i = std::get<0>(*iter);
         int64_t j = std::get<1>(*iter);
         {
-            tileGet(i, j, device, layoutConvert, modify, hold, true);
+            tileGet(i, j, device, layoutConvert, modify, hold, true, queue);
         }
     }
 
@@ -2832,13 +4358,42 @@ void BaseMatrix<scalar_t>::tileGetForReading(int64_t i, int64_t j, int device,
 ///
 // todo: async version
 template <typename scalar_t>
-void BaseMatrix<scalar_t>::tileGetForReading(std::set<ij_tuple>& tile_set,
+void BaseMatrix<scalar_t>::tileGetForReading(TileSet& tile_set,
                                              int device,
                                              LayoutConvert layout)
 {
     tileGet(tile_set, device, layout, false, false, false);
 }
 
+//------------------------------------------------------------------------------
+/// Gets a set of tiles for reading on device, for a device routine that
+/// reads them on queue and then records an event with tileRecordEvent,
+/// instead of synchronizing queue.
+/// Unlike tileGetForReading without a queue, the host doesn't wait for
+/// pending device work that writes the tiles; queue waits for it instead.
+/// @see tileGetForReading
+///
+/// @param[in] tile_set
+///     Set of (i, j) tuples indicating indices of Tiles' to be acquired.
+///
+/// @param[in] device
+///     Tile's destination device ID.
+///
+/// @param[in] layout
+///     Indicates whether to convert the Layout of the received data.
+///
+/// @param[in] queue
+///     Queue on device that will read the tiles.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileGetForReading(TileSet& tile_set,
+                                             int device,
+                                             LayoutConvert layout,
+                                             lapack::Queue& queue)
+{
+    tileGet(tile_set, device, layout, false, false, false, &queue);
+}
+
 //------------------------------------------------------------------------------
 /// Gets tile(i, j) for writing on device.
 /// Sets destination tile's state to MOSI::Modified.
@@ -2887,12 +4442,79 @@ void BaseMatrix<scalar_t>::tileGetForWriting(int64_t i, int64_t j, int device,
 ///     - None: do not convert layout.
 ///
 template <typename scalar_t>
-void BaseMatrix<scalar_t>::tileGetForWriting(std::set<ij_tuple>& tile_set,
+void BaseMatrix<scalar_t>::tileGetForWriting(TileSet& tile_set,
                                              int device, LayoutConvert layout)
 {
     tileGet( tile_set, device, layout, true, false, false );
 }
 
+//------------------------------------------------------------------------------
+/// Gets a set of tiles for writing on device, for a device routine that
+/// writes them on queue and then records an event with tileRecordEvent,
+/// instead of synchronizing queue.
+/// Unlike tileGetForWriting without a queue, the host doesn't wait for
+/// pending device work that reads or writes the tiles; queue waits for it.
+/// @see tileGetForWriting
+///
+/// @param[in] tile_set
+///     Set of (i, j) tuples indicating indices of Tiles' to be acquired.
+///
+/// @param[in] device
+///     Tile's destination device ID.
+///
+/// @param[in] layout
+///     Indicates whether to convert the Layout of the received data.
+///
+/// @param[in] queue
+///     Queue on device that will write the tiles.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileGetForWriting(TileSet& tile_set,
+                                             int device, LayoutConvert layout,
+                                             lapack::Queue& queue)
+{
+    tileGet( tile_set, device, layout, true, false, false, &queue );
+}
+
+//------------------------------------------------------------------------------
+/// Records that device work completing with event reads or writes a set
+/// of tiles on device. Later tileGet calls wait for the event before using
+/// the tiles: on the host, or on the caller's queue if it gives one.
+/// Freeing the tiles also waits for the event.
+/// The tiles must have been gotten with the queue that event was
+/// recorded on, e.g., by tileGetForWriting( tile_set, device, layout, queue ),
+/// so that queue already waits for earlier work on them.
+/// Releases the tiles' pins from tileGet, since the work is enqueued.
+///
+/// @param[in] tile_set
+///     Set of (i, j) tuples indicating indices of Tiles'.
+///
+/// @param[in] device
+///     Tiles' device ID.
+///
+/// @param[in] event
+///     Event from DeviceEvent::record. If null, the work is complete and
+///     nothing is recorded.
+///
+/// @param[in] modify
+///     true: the work writes the tiles; false: it only reads them.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileRecordEvent(
+    TileSet& tile_set, int device,
+    std::shared_ptr< DeviceEvent > const& event, bool modify)
+{
+    for (auto ij : tile_set) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        auto& tile_node = storage_->at( globalIndex( i, j ) );
+        LockGuard guard( tile_node.getLock() );
+        tile_node.recordEvent( device, event, modify );
+        // The work is enqueued, so the tile can be evicted after it.
+        tile_node.unpin( device );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Gets tile(i, j) on device for reading and marks it as MOSI::OnHold.
 /// Will copy tile in if it does not exist or its state is MOSI::Invalid.
@@ -2938,7 +4560,7 @@ void BaseMatrix<scalar_t>::tileGetAndHold(int64_t i, int64_t j, int device,
 ///     - None: do not convert layout.
 ///
 template <typename scalar_t>
-void BaseMatrix<scalar_t>::tileGetAndHold(std::set<ij_tuple>& tile_set, int device,
+void BaseMatrix<scalar_t>::tileGetAndHold(TileSet& tile_set, int device,
                                           LayoutConvert layout)
 {
     tileGet( tile_set, device, layout, false, true, false );
@@ -2962,7 +4584,7 @@ void BaseMatrix<scalar_t>::tileGetAndHold(std::set<ij_tuple>& tile_set, int devi
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGetAllForReading(int device, LayoutConvert layout)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     for (int64_t j = 0; j < nt(); ++j)
         for (int64_t i = 0; i < mt(); ++i)
             // todo: if (tileIsLocal(i, j) && (device == HostNum || device == tileDevice(i, j))) {
@@ -2991,7 +4613,7 @@ void BaseMatrix<scalar_t>::tileGetAllForReading(int device, LayoutConvert layout
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGetAllForWriting(int device, LayoutConvert layout)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     for (int64_t j = 0; j < nt(); ++j)
         for (int64_t i = 0; i < mt(); ++i)
             // todo: if (tileIsLocal(i, j) && (device == HostNum || device == tileDevice(i, j))) {
@@ -3020,7 +4642,7 @@ void BaseMatrix<scalar_t>::tileGetAllForWriting(int device, LayoutConvert layout
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGetAndHoldAll(int device, LayoutConvert layout)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     for (int64_t j = 0; j < nt(); ++j)
         for (int64_t i = 0; i < mt(); ++i)
             // todo: if (tileIsLocal(i, j) && (device == HostNum || device == tileDevice(i, j))) {
@@ -3044,7 +4666,7 @@ void BaseMatrix<scalar_t>::tileGetAndHoldAll(int device, LayoutConvert layout)
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGetAllForReadingOnDevices(LayoutConvert layout)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(num_devices());
+    std::vector< TileSet > tiles_set(num_devices());
     for (int64_t j = 0; j < nt(); ++j) {
         for (int64_t i = 0; i < mt(); ++i) {
             if (tileIsLocal(i, j)) {
@@ -3080,7 +4702,7 @@ void BaseMatrix<scalar_t>::tileGetAllForReadingOnDevices(LayoutConvert layout)
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGetAllForWritingOnDevices(LayoutConvert layout)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(num_devices());
+    std::vector< TileSet > tiles_set(num_devices());
     for (int64_t j = 0; j < nt(); ++j) {
         for (int64_t i = 0; i < mt(); ++i) {
             if (tileIsLocal(i, j)) {
@@ -3116,7 +4738,7 @@ void BaseMatrix<scalar_t>::tileGetAllForWritingOnDevices(LayoutConvert layout)
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileGetAndHoldAllOnDevices(LayoutConvert layout)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(num_devices());
+    std::vector< TileSet > tiles_set(num_devices());
     for (int64_t j = 0; j < nt(); ++j) {
         for (int64_t i = 0; i < mt(); ++i) {
             if (tileIsLocal(i, j)) {
@@ -3165,6 +4787,10 @@ Tile<scalar_t> BaseMatrix<scalar_t>::tileUpdateOrigin(int64_t i, int64_t j)
             // todo: should this request Layout conversion to this->layout() ?
             tileGetForReading(i, j, LayoutConvert::None);
         }
+        else {
+            // Complete a pending copy to the origin.
+            tile_node.syncEvents( HostNum, true );
+        }
         return *(tile_node[ HostNum ]);
     }
     else {
@@ -3175,6 +4801,10 @@ Tile<scalar_t> BaseMatrix<scalar_t>::tileUpdateOrigin(int64_t i, int64_t j)
                 // todo: should this request Layout conversion to this->layout() ?
                 tileGetForReading(i, j, device, LayoutConvert::None);
             }
+            else {
+                // Complete pending device work on the origin.
+                tile_node.syncEvents( device, true );
+            }
         }
         else
             slate_error( std::string("Origin tile not found! tile(")
@@ -3189,8 +4819,8 @@ Tile<scalar_t> BaseMatrix<scalar_t>::tileUpdateOrigin(int64_t i, int64_t j)
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileUpdateAllOrigin()
 {
-    std::set<ij_tuple> tiles_set_host;
-    std::vector< std::set<ij_tuple> > tiles_set_dev(num_devices());
+    TileSet tiles_set_host;
+    std::vector< TileSet > tiles_set_dev(num_devices());
     for (int64_t j = 0; j < this->nt(); ++j) {
         for (int64_t i = 0; i < this->mt(); ++i) {
             if (this->tileIsLocal(i, j)) {
@@ -3204,6 +4834,12 @@ void BaseMatrix<scalar_t>::tileUpdateAllOrigin()
                         // tileGetForReading(i, j, LayoutConvert::None);
                         tiles_set_host.insert({i, j});
                     }
+                    else {
+                        // Complete a pending copy to the origin, e.g., by
+                        // tileUpdateAllOriginAsync.
+                        LockGuard guard( tile_node.getLock() );
+                        tile_node.syncEvents( HostNum, true );
+                    }
                 }
                 else {
                     auto device = tileDevice(i, j);
@@ -3213,6 +4849,12 @@ void BaseMatrix<scalar_t>::tileUpdateAllOrigin()
                             // tileGetForReading(i, j, device, LayoutConvert::None);
                             tiles_set_dev[device].insert({i, j});
                         }
+                        else {
+                            // Complete pending device work on the origin,
+                            // so the caller can use its data.
+                            LockGuard guard( tile_node.getLock() );
+                            tile_node.syncEvents( device, true );
+                        }
                     }
                     else
                         slate_error( std::string("Origin tile not found! tile(")
@@ -3242,6 +4884,165 @@ void BaseMatrix<scalar_t>::tileUpdateAllOrigin()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Starts updating all origin instances of local tiles on host that are
+/// MOSI::Invalid, without waiting for the copies. Each copy from a device
+/// is queued on the device's comm queue after pending device work on the
+/// tile, and its event is recorded on both instances (see TileNode), so
+/// later accesses to the origin through tileGet, tileUpdateOrigin, or
+/// tileUpdateAllOrigin wait for it, as does erasing the device instance.
+/// Thus a driver can stream tiles that are final back to host while the
+/// factorization continues, and erase their device workspace later.
+///
+/// Origins on devices are updated as in tileUpdateAllOrigin.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tileUpdateAllOriginAsync()
+{
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            if (! this->tileIsLocal(i, j))
+                continue;
+
+            auto& tile_node = storage_->at(globalIndex(i, j));
+            LockGuard guard( tile_node.getLock() );
+
+            if (! (tile_node.existsOn( HostNum )
+                   && tile_node[ HostNum ]->origin())) {
+                tileUpdateOrigin(i, j);
+                continue;
+            }
+            Tile<scalar_t>* host_tile = tile_node[ HostNum ];
+            if (! host_tile->stateOn(MOSI::Invalid))
+                continue;
+
+            // find a valid source on a device
+            Tile<scalar_t>* src_tile = nullptr;
+            for (int d = num_devices()-1; d >= 0; --d) {
+                if (tile_node.existsOn(d)
+                    && tile_node[d]->state() != MOSI::Invalid) {
+                    src_tile = tile_node[d];
+                    break;
+                }
+            }
+            if (src_tile == nullptr) {
+                tileGetForReading(i, j, LayoutConvert::None);
+                continue;
+            }
+
+            // Copy in the source's layout, as LayoutConvert::None does,
+            // which needs no conversion, hence no synchronization.
+            int device = src_tile->device();
+            lapack::Queue* queue = comm_queue( device );
+            tile_node.syncEvents( HostNum, true );
+            tile_node.waitEvents( device, *queue, false );
+            tileCopyDataLayout( src_tile, host_tile, src_tile->layout(), true );
+
+            auto event = DeviceEvent::record( *queue );
+            tile_node.recordEvent( device, event, false );
+            tile_node.recordEvent( HostNum, event, true );
+
+            storage_->countTransfer( globalIndex(i, j), device, HostNum,
+                                     src_tile->bytes() );
+            storage_->countTransitions( 1 );
+            host_tile->state(MOSI::Shared);
+            src_tile->state(MOSI::Shared);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Starts copying a set of tiles from host to device, without waiting for
+/// the copies. Each copy is queued on the device's comm queue after pending
+/// device work on both instances, and its event is recorded on both
+/// (see TileNode), so later tileGet calls on the device, from the host or
+/// a queue, wait for it, as do writing the host tile and erasing either
+/// instance. Thus broadcasts can move the next panel to devices while
+/// tasks still compute on the current one.
+///
+/// Tiles that are already valid on device, or not valid on host, are
+/// skipped; tileGet fetches the latter later, as usual.
+///
+/// @param[in] tile_set
+///     Set of (i, j) tuples indicating indices of tiles to prefetch.
+///
+/// @param[in] device
+///     Tiles' destination device ID. For HostNum, does nothing.
+///
+template <typename scalar_t>
+void BaseMatrix<scalar_t>::tilePrefetch(TileSet& tile_set, int device)
+{
+    if (device == HostNum || tile_set.empty())
+        return;
+
+    {
+        LockGuard guard(storage_->getTilesMapLock());
+
+        // find number of already existing tiles on the device
+        int64_t existing_tiles = 0;
+        for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
+            int64_t i = std::get<0>(*iter);
+            int64_t j = std::get<1>(*iter);
+            if (tileExists(i, j, device)) {
+                ++existing_tiles;
+                // Mark as recent so they aren't evicted to make room.
+                storage_->tileTouch( globalIndex(i, j, device) );
+            }
+        }
+
+        // ensure workspace exists for the rest
+        if (tile_set.size() > size_t(existing_tiles))
+            storage_->ensureDeviceWorkspace(device, tile_set.size() - existing_tiles);
+    }
+
+    lapack::Queue* queue = comm_queue( device );
+    for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
+        int64_t i = std::get<0>(*iter);
+        int64_t j = std::get<1>(*iter);
+
+        auto& tile_node = storage_->at(globalIndex(i, j));
+        LockGuard guard( tile_node.getLock() );
+
+        if (tile_node.existsOn( device )
+            && tile_node[ device ]->state() != MOSI::Invalid)
+            continue;
+        if (! (tile_node.existsOn( HostNum )
+               && tile_node[ HostNum ]->state() != MOSI::Invalid))
+            continue;
+
+        // Copy in the source's layout, as LayoutConvert::None does,
+        // which needs no conversion, hence no synchronization.
+        Tile<scalar_t>* src_tile = tile_node[ HostNum ];
+        if (! tile_node.existsOn( device )) {
+            storage_->tileInsert( globalIndex(i, j, device),
+                                  TileKind::Workspace, src_tile->layout() );
+        }
+        Tile<scalar_t>* dst_tile = tile_node[ device ];
+        tile_node.touch( device, storage_->lruTick() );
+        if (src_tile->data() == nullptr) {
+            // A lazy source is zero, so zero the destination, on queue.
+            storage_->tileMaterialize( tile_node, device, true );
+        }
+        else {
+            storage_->tileMaterialize( tile_node, device, false );
+
+            tile_node.waitEvents( HostNum, *queue, false );
+            tile_node.waitEvents( device, *queue, true );
+            tileCopyDataLayout( src_tile, dst_tile, src_tile->layout(), true );
+
+            auto event = DeviceEvent::record( *queue );
+            tile_node.recordEvent( HostNum, event, false );
+            tile_node.recordEvent( device, event, true );
+
+            storage_->countTransfer( globalIndex(i, j), HostNum, device,
+                                     src_tile->bytes() );
+        }
+        storage_->countTransitions( 1 );
+        dst_tile->state(MOSI::Shared);
+        src_tile->state(MOSI::Shared);
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Returns whether tile(i, j, device) can be safely transposed.
 /// based on its 'TileKind', buffer size, Layout, and stride.
@@ -3294,19 +5095,33 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
     auto& tile_node = storage_->at( globalIndex(i, j) );
     LockGuard guard( tile_node.getLock() );
     auto tile = tile_node[ device ];
+    if (tile->layout() != layout || reset) {
+        // Converting rewrites the tile in place.
+        tile_node.syncEvents( device, true );
+    }
     if (tile->layout() != layout) {
+        storage_->countLayoutConversion();
+        // Other ranks of the node read NodeShared memory; convert a copy.
+        storage_->tilePrivatize( tile, true );
         if (! tile->isTransposable()) {
             assert(! reset); // Can't change to ext buffer then reset
             storage_->tileMakeTransposable(tile);
         }
 
         scalar_t* work_data = nullptr;
-        // if rectangular and not extended, need a workspace buffer
-        bool need_workspace = tile->mb() != tile->nb() && (! tile->extended());
-
-        if (need_workspace)
-            work_data = storage_->allocWorkspaceBuffer(tile->device(),
-                                                       tile->mb()*tile->nb());
+        // if rectangular and not extended, need a workspace buffer on host.
+        // Devices use one if the pool has a free block, as the out-of-place
+        // transpose is much faster; otherwise they transpose in place.
+        bool rect_contiguous = tile->mb() != tile->nb() && (! tile->extended());
+        if (rect_contiguous) {
+            if (tile->device() == HostNum)
+                work_data = storage_->allocWorkspaceBuffer(
+                                tile->device(), tile->mb()*tile->nb());
+            else
+                work_data = storage_->tryAllocWorkspaceBuffer(
+                                tile->device(), tile->mb()*tile->nb());
+        }
+        bool need_workspace = work_data != nullptr;
 
         if (tile->device() == HostNum) {
             tile->layoutConvert(work_data);
@@ -3352,7 +5167,7 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
 // todo: async API
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileLayoutConvert(
-    std::set<ij_tuple>& tile_set, int device, Layout layout, bool reset)
+    TileSet& tile_set, int device, Layout layout, bool reset)
 {
     if (device == HostNum) {
         #pragma omp taskgroup
@@ -3391,33 +5206,43 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
 
             // if we need to convert layout
             if (tile->layout() != layout) {
+                // Converting rewrites the tile in place.
+                storage_->at( globalIndex(i, j) ).syncEvents( device, true );
+                storage_->countLayoutConversion();
                 // make sure tile is transposable
                 if (! tile->isTransposable()) {
                     storage_->tileMakeTransposable(tile);
                 }
                 tile->setLayout( layout );
 
-                int64_t work_stride = (layout == Layout::ColMajor) ? nb : mb;
+                // Rectangular tiles that are not extended are contiguous.
+                // They use a workspace if the pool has a free block, else
+                // are transposed in place (work_stride 0).
+                scalar_t* work_data = nullptr;
+                int64_t work_stride = 0;
+                if (mb != nb) {
+                    if (tile->extended()) {
+                        work_data = tile->layoutBackData();
+                        work_stride = tile->layoutBackStride();
+                    }
+                    else {
+                        work_data = storage_->tryAllocWorkspaceBuffer(
+                                        device, mb*nb);
+                        if (work_data != nullptr)
+                            work_stride = (layout == Layout::ColMajor) ? nb : mb;
+                    }
+                }
 
                 // bucket index
                 mnss_tuple mns = {mb, nb, tile->extended(), tile->stride(),
-                                  mb != nb
-                                    ? (tile->extended()
-                                        ? tile->layoutBackStride() : work_stride)
-                                    : 0};
+                                  work_stride};
 
                 // add this tile's data to the corrsponding bucket of batch array
                 tilesBuckets[mns].first.push_back(tile->data());
 
-                // if rectangular, prepare a workspace
-                if (mb != nb) {
-                    if (tile->extended())
-                        tilesBuckets[mns].second.push_back(
-                            tile->layoutBackData());
-                    else
-                        tilesBuckets[mns].second.push_back(
-                            storage_->allocWorkspaceBuffer(device, mb*nb) );
-                }
+                // if rectangular with a workspace or back buffer
+                if (work_data != nullptr)
+                    tilesBuckets[mns].second.push_back(work_data);
             }
         }
 
@@ -3470,14 +5295,24 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
                                         array_dev, stride,
                                         batch_count, *queue);
             }
+            else if (work_stride == 0) {
+                // contiguous rectangular tiles without workspace:
+                // in-place transpose
+                device::transpose_batch(false,
+                                        layout == Layout::ColMajor ? nb : mb,
+                                        layout == Layout::ColMajor ? mb : nb,
+                                        array_dev,
+                                        batch_count, *queue);
+            }
             else {
                 // rectangular tiles: out-of-place transpose
+                // from the back buffer or workspace
                 blas::device_memcpy<scalar_t*>(
                     work_array_dev, bucket->second.second.data(),
                     batch_count, blas::MemcpyKind::HostToDevice, *queue);
 
                 if (! extended) {
-                    // copy back to data buffer
+                    // copy to the workspace
                     device::gecopy(layout == Layout::ColMajor ? nb : mb,
                                    layout == Layout::ColMajor ? mb : nb,
                                    array_dev, work_stride,
@@ -3492,21 +5327,20 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
                                         array_dev, stride,
                                         batch_count, *queue);
             }
+        }
 
-            // release workspace buffer if allocated
-            if ((mb != nb) && (! extended)) {
-                queue->sync();
+        queue->sync();
 
-                for (auto iter  = bucket->second.second.begin();
-                          iter != bucket->second.second.end();
-                          ++iter) {
-                    storage_->releaseWorkspaceBuffer(*iter, device);
-                }
+        // release workspace buffers
+        for (auto bucket  = tilesBuckets.begin();
+                  bucket != tilesBuckets.end();
+                ++bucket) {
+            if (! std::get<2>(bucket->first)) {
+                for (auto work_data : bucket->second.second)
+                    storage_->releaseWorkspaceBuffer(work_data, device);
             }
         }
 
-        queue->sync();
-
         if (reset) {
             for (auto iter = tile_set.begin(); iter != tile_set.end(); ++iter) {
                 // #pragma omp task default(none)
@@ -3540,7 +5374,7 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileLayoutConvert(int device, Layout layout, bool reset)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     for (int64_t j = 0; j < nt(); ++j) {
         for (int64_t i = 0; i < mt(); ++i) {
             // if (tileIsLocal(i, j) && device == tileDevice(i, j) && tileExists(i, j, device))
@@ -3570,7 +5404,7 @@ void BaseMatrix<scalar_t>::tileLayoutConvert(int device, Layout layout, bool res
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileLayoutConvertOnDevices(Layout layout, bool reset)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(num_devices());
+    std::vector< TileSet > tiles_set(num_devices());
     for (int64_t j = 0; j < nt(); ++j) {
         for (int64_t i = 0; i < mt(); ++i) {
             for (int d = 0; d < num_devices(); ++d) {
@@ -3634,7 +5468,7 @@ void BaseMatrix<scalar_t>::tileLayoutReset(int64_t i, int64_t j, int device,
 ///     - Layout::RowMajor.
 ///
 template <typename scalar_t>
-void BaseMatrix<scalar_t>::tileLayoutReset(std::set<ij_tuple>& tile_set,
+void BaseMatrix<scalar_t>::tileLayoutReset(TileSet& tile_set,
                                            int device, Layout layout)
 {
     tileLayoutConvert(tile_set, device, layout, true);
@@ -3647,8 +5481,8 @@ void BaseMatrix<scalar_t>::tileLayoutReset(std::set<ij_tuple>& tile_set,
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::tileLayoutReset()
 {
-    std::set<ij_tuple> tiles_set_host;
-    std::vector< std::set<ij_tuple> > tiles_set_dev(num_devices());
+    TileSet tiles_set_host;
+    std::vector< TileSet > tiles_set_dev(num_devices());
 
     for (int64_t i = 0; i < mt(); ++i) {
         for (int64_t j = 0; j < nt(); ++j) {
@@ -3795,6 +5629,42 @@ Tile<scalar_t> BaseMatrix<scalar_t>::originTile(int64_t i, int64_t j)
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::getLocalDevices(std::set<int>* dev_set) const
 {
+    auto const& grid = storage_->uniformGrid();
+    if (grid.valid) {
+        // On a uniform 2D block-cyclic grid, local tiles are in this rank's
+        // process row and column, and devices are cyclic over local block
+        // cols, device = (j / q) % num_devices. So visit only local block
+        // cols, at most num_devices of them, instead of every tile, as
+        // listBcast does this per tile.
+        // NB. We only use storage indices, so op_ doesn't affect it.
+        int p = grid.p, q = grid.q;
+        if (mpi_rank_ >= p*q)
+            return;
+        bool col_major = (grid.order == GridOrder::Col);
+        int my_row = col_major ? mpi_rank_ % p : mpi_rank_ / q;
+        int my_col = col_major ? mpi_rank_ / p : mpi_rank_ % q;
+
+        // First index k in [ offset, offset + count ) with k % size == r,
+        // or offset + count if none.
+        auto first_local = []( int64_t offset, int64_t count, int r, int size ) {
+            int64_t k = offset + (r - offset % size + size) % size;
+            return std::min( k, offset + count );
+        };
+        if (first_local( ioffset_, mt_, my_row, p ) == ioffset_ + mt_)
+            return;
+
+        int64_t j_end = joffset_ + nt_;
+        int64_t j = first_local( joffset_, nt_, my_col, q );
+        if (grid.num_devices == 0) {
+            if (j < j_end)
+                dev_set->insert( HostNum );
+            return;
+        }
+        for (int k = 0; j < j_end && k < grid.num_devices; j += q, ++k)
+            dev_set->insert( int( (j / q) % grid.num_devices ) );
+        return;
+    }
+
     for (int64_t i = 0; i < mt(); ++i)
         for (int64_t j = 0; j < nt(); ++j)
             if (tileIsLocal(i, j))
@@ -3903,7 +5773,7 @@ void BaseMatrix<scalar_t>::releaseLocalWorkspace()
 ///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::releaseLocalWorkspace(
-    std::set<ij_tuple>& tile_set)
+    TileSet& tile_set)
 {
     for (auto ij : tile_set) {
         int64_t i = std::get<0>( ij );
@@ -3959,7 +5829,7 @@ void BaseMatrix<scalar_t>::releaseRemoteWorkspace( int64_t release_count )
 ///
 template <typename scalar_t>
 void BaseMatrix<scalar_t>::releaseRemoteWorkspace(
-    std::set<ij_tuple>& tile_set, int64_t release_count )
+    TileSet& tile_set, int64_t release_count )
 {
     for (auto ij : tile_set) {
         int64_t i = std::get<0>( ij );
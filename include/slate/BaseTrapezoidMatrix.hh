@@ -100,6 +100,8 @@ public:
     Uplo uplo_logical() const { return this->uploLogical(); }  ///< @deprecated
     void insertLocalTiles(Target origin=Target::Host);
     void insertLocalTiles(bool on_devices);
+    void insertLocalTilesLazy(Target origin=Target::Host);
+    void eraseOppositeTriangle();
 
     void tileGetAllForReading(int device, LayoutConvert layout);
     void tileGetAllForReadingOnDevices(LayoutConvert layout);
@@ -786,8 +788,8 @@ template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileUpdateAllOrigin()
 {
     int64_t mt = this->mt();
-    std::set<ij_tuple> tiles_set_host;
-    std::vector< std::set<ij_tuple> > tiles_set_dev(this->num_devices());
+    TileSet tiles_set_host;
+    std::vector< TileSet > tiles_set_dev(this->num_devices());
 
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -844,6 +846,8 @@ void BaseTrapezoidMatrix<scalar_t>::tileUpdateAllOrigin()
 
 //------------------------------------------------------------------------------
 /// Inserts all local tiles into an empty matrix.
+/// Only tiles in the stored triangle (uplo) are inserted; off-diagonal
+/// tiles of the other triangle are never allocated.
 ///
 /// @param[in] target
 ///     - if target = Devices, inserts tiles on appropriate GPU devices, or
@@ -871,6 +875,62 @@ void BaseTrapezoidMatrix<scalar_t>::insertLocalTiles(Target origin)
     }
 }
 
+//------------------------------------------------------------------------------
+/// Inserts all local tiles into an empty matrix, deferring allocation of
+/// each tile's data until it is first used, as by tileInsertLazy.
+/// Until written, tiles are zero.
+///
+/// @param[in] target
+///     - if target = Devices, inserts tiles on appropriate GPU devices, or
+///     - if target = Host,    inserts tiles on CPU host.
+///
+template <typename scalar_t>
+void BaseTrapezoidMatrix<scalar_t>::insertLocalTilesLazy(Target origin)
+{
+    this->origin_ = origin;
+    bool on_devices = (origin == Target::Devices);
+
+    int64_t mt = this->mt();
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
+        int64_t iend   = (this->uplo() == Uplo::Lower ? mt : std::min( j+1, mt ));
+        for (int64_t i = istart; i < iend; ++i) {
+            if (this->tileIsLocal(i, j)) {
+                int dev = (on_devices ? this->tileDevice(i, j)
+                                      : HostNum);
+                this->tileInsertLazy(i, j, dev);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Erases the local tiles strictly in the triangle opposite uplo, on host
+/// and all devices, freeing memory that SLATE allocated for them.
+/// For example, when the application fills a full Matrix and then uses it
+/// as a HermitianMatrix, this drops the duplicate off-diagonal tiles,
+/// leaving the same tiles insertLocalTiles would have inserted.
+///
+/// The tiles are erased from the shared storage, so other views of the
+/// storage, e.g., the original Matrix, must no longer access them.
+/// Tiles the application owns, e.g., from fromLAPACK, are removed from
+/// the matrix but not freed. Diagonal tiles are kept in full.
+///
+template <typename scalar_t>
+void BaseTrapezoidMatrix<scalar_t>::eraseOppositeTriangle()
+{
+    int64_t mt = this->mt();
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        int64_t istart = (this->uplo() == Uplo::Lower ? 0 : j+1);
+        int64_t iend   = (this->uplo() == Uplo::Lower ? std::min( j, mt ) : mt);
+        for (int64_t i = istart; i < iend; ++i) {
+            if (this->tileIsLocal( i, j )) {
+                this->tileErase( i, j, AllDevices );
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// @deprecated
 ///
@@ -902,7 +962,7 @@ void BaseTrapezoidMatrix<scalar_t>::insertLocalTiles(bool on_devices)
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileGetAllForReading(int device, LayoutConvert layout)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -933,7 +993,7 @@ void BaseTrapezoidMatrix<scalar_t>::tileGetAllForReading(int device, LayoutConve
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileGetAllForWriting(int device, LayoutConvert layout)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -964,7 +1024,7 @@ void BaseTrapezoidMatrix<scalar_t>::tileGetAllForWriting(int device, LayoutConve
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileGetAndHoldAll(int device, LayoutConvert layout)
 {
-    std::set<ij_tuple> tiles_set;
+    TileSet tiles_set;
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -992,7 +1052,7 @@ void BaseTrapezoidMatrix<scalar_t>::tileGetAndHoldAll(int device, LayoutConvert
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileGetAllForReadingOnDevices(LayoutConvert layout)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(this->num_devices());
+    std::vector< TileSet > tiles_set(this->num_devices());
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -1031,7 +1091,7 @@ void BaseTrapezoidMatrix<scalar_t>::tileGetAllForReadingOnDevices(LayoutConvert
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileGetAllForWritingOnDevices(LayoutConvert layout)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(this->num_devices());
+    std::vector< TileSet > tiles_set(this->num_devices());
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -1070,7 +1130,7 @@ void BaseTrapezoidMatrix<scalar_t>::tileGetAllForWritingOnDevices(LayoutConvert
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileGetAndHoldAllOnDevices(LayoutConvert layout)
 {
-    std::vector< std::set<ij_tuple> > tiles_set(this->num_devices());
+    std::vector< TileSet > tiles_set(this->num_devices());
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
         int64_t istart = (this->uplo() == Uplo::Lower ? j : 0);
@@ -1140,8 +1200,8 @@ void BaseTrapezoidMatrix<scalar_t>::tileUnsetHoldAllOnDevices()
 template <typename scalar_t>
 void BaseTrapezoidMatrix<scalar_t>::tileLayoutReset()
 {
-    std::set<ij_tuple> tiles_set_host;
-    std::vector< std::set<ij_tuple> > tiles_set_dev(this->num_devices());
+    TileSet tiles_set_host;
+    std::vector< TileSet > tiles_set_dev(this->num_devices());
 
     int64_t mt = this->mt();
     for (int64_t j = 0; j < this->nt(); ++j) {
@@ -57,6 +57,7 @@ public:
     void    gather(scalar_t* A, int64_t lda);
 
     void    insertLocalTiles(Target origin=Target::Host);
+    void    insertLocalTilesLazy(Target origin=Target::Host);
 };
 
 //------------------------------------------------------------------------------
@@ -303,6 +304,37 @@ void BaseTriangularBandMatrix<scalar_t>::insertLocalTiles(Target origin)
     }
 }
 
+//------------------------------------------------------------------------------
+/// Inserts all local tiles into an empty matrix, deferring allocation of
+/// each tile's data until it is first used, as by tileInsertLazy.
+/// Until written, tiles are zero.
+///
+/// @param[in] target
+///     - if target = Devices, inserts tiles on appropriate GPU devices, or
+///     - if target = Host, inserts on tiles on CPU host.
+///
+template <typename scalar_t>
+void BaseTriangularBandMatrix<scalar_t>::insertLocalTilesLazy(Target origin)
+{
+    this->origin_ = origin;
+    bool on_devices = (origin == Target::Devices);
+    auto upper = this->uplo() == Uplo::Upper;
+    int64_t mt = this->mt();
+    int64_t nt = this->nt();
+    int64_t kdt = ceildiv( this->bandwidth(), this->tileNb(0) );
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t istart = upper ? blas::max( 0, j-kdt ) : j;
+        int64_t iend   = upper ? j : blas::min( j+kdt, mt-1 );
+        for (int64_t i = istart; i <= iend; ++i) {
+            if (this->tileIsLocal(i, j)) {
+                int dev = (on_devices ? this->tileDevice(i, j)
+                                      : HostNum);
+                this->tileInsertLazy(i, j, dev);
+            }
+        }
+    }
+}
+
 } // namespace slate
 
 #endif // SLATE_BASE_TRIANGULAR_BAND_MATRIX_HH
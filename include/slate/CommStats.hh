@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_COMM_STATS_HH
+#define SLATE_COMM_STATS_HH
+
+#include "slate/types.hh"
+#include "slate/internal/mpi.hh"
+
+#include <map>
+#include <string>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Communication counters of this rank: tile messages sent and received,
+/// their bytes, and time spent waiting for them to complete.
+/// Counted in Tile's send, receive, and broadcast routines, so they cover
+/// listBcast, tileBcast, listReduce, redistribute, etc.
+/// Peers are ranks in the communicator of each message, usually the
+/// matrix's communicator. A broadcast counts as a send on its root, with
+/// the root as peer, and as a receive on the other ranks.
+///
+/// @see comm_stats, comm_stats_drivers
+///
+struct CommStats {
+    int64_t calls          = 0;  ///< driver calls, in comm_stats_drivers
+    int64_t messages_sent  = 0;
+    int64_t bytes_sent     = 0;
+    int64_t messages_recv  = 0;
+    int64_t bytes_recv     = 0;
+    double  wait_time      = 0;  ///< seconds in MPI_Wait, Waitall, Waitany
+    std::map< int, int64_t > peer_bytes;  ///< bytes sent to each peer
+
+    CommStats& operator += ( CommStats const& other );
+    CommStats& operator -= ( CommStats const& other );
+};
+
+CommStats comm_stats();
+std::map< std::string, CommStats > comm_stats_drivers();
+void comm_stats_reset();
+
+namespace internal {
+
+void comm_stats_send( int peer, int64_t bytes );
+void comm_stats_recv( int peer, int64_t bytes );
+
+void comm_wait( MPI_Request* request );
+void comm_waitall( int count, MPI_Request* requests );
+void comm_waitany( int count, MPI_Request* requests, int* index );
+
+void comm_sendrecv(
+    void const* sendbuf, void* recvbuf, int count, MPI_Datatype datatype,
+    int peer, int tag, MPI_Comm comm );
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Accumulates the communication of a top-level driver call into
+/// comm_stats_drivers()[ name ]. Drivers called within another driver on
+/// the same thread are counted in the outer driver only.
+/// With Option::PrintVerbose >= 1, the counters summed over the ranks of
+/// comm are printed on rank 0 of comm, which makes the destructor
+/// collective.
+///
+class CommStatsScope {
+public:
+    CommStatsScope( const char* name, MPI_Comm comm, Options const& opts );
+    ~CommStatsScope();
+
+    // Not copyable, as it records on destruction.
+    CommStatsScope( CommStatsScope const& ) = delete;
+    CommStatsScope& operator=( CommStatsScope const& ) = delete;
+
+private:
+    const char* name_;
+    MPI_Comm comm_;
+    int verbose_;
+    bool outer_;
+    CommStats start_;
+};
+
+} // namespace internal
+
+} // namespace slate
+
+#endif // SLATE_COMM_STATS_HH
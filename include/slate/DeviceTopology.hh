@@ -0,0 +1,47 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_DEVICE_TOPOLOGY_HH
+#define SLATE_DEVICE_TOPOLOGY_HH
+
+#include <string>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Topology of the GPU devices visible to this process: where each device
+/// is attached, and which pairs of devices can access each other's memory
+/// directly, e.g., over NVLink, xGMI, or a shared PCIe switch.
+/// Discovered once per process, on the first call to device_topology().
+///
+/// @see device_topology, device_peer_groups, enable_peer_access
+///
+struct DeviceTopology {
+    int num_devices = 0;
+
+    /// PCI bus id of each device, e.g., "0000:3b:00.0",
+    /// or empty if unknown.
+    std::vector< std::string > pci_bus_id;
+
+    /// NUMA node the host memory closest to each device is on,
+    /// or -1 if unknown, e.g., on non-Linux systems.
+    std::vector< int > numa_node;
+
+    /// peer[ i ][ j ] is true if device i can access device j's memory
+    /// directly. The diagonal is true.
+    std::vector< std::vector< bool > > peer;
+};
+
+DeviceTopology const& device_topology();
+
+std::vector< std::vector< int > > device_peer_groups(
+    DeviceTopology const& topology = device_topology() );
+
+void enable_peer_access();
+
+} // namespace slate
+
+#endif // SLATE_DEVICE_TOPOLOGY_HH
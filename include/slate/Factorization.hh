@@ -0,0 +1,280 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_FACTORIZATION_HH
+#define SLATE_FACTORIZATION_HH
+
+// Included by slate.hh after the drivers, simplified API, and async API.
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// LU factorization of a matrix A, kept for repeated solves, e.g., with
+/// the right-hand sides of successive time steps.
+///
+/// factor overwrites A with its factors, as getrf does, and keeps a shallow
+/// copy of A and the pivots; each solve then runs only getrs. The pivots
+/// are reused by later factorizations. With Target::Devices, the factors
+/// are held on the devices until the next factor or release, so solves
+/// don't copy them to the devices again; A's batch arrays are kept with
+/// it, too.
+///
+/// Example:
+///
+///     slate::LU<double> F;
+///     F.factor( A, opts );
+///     for (int step = 0; step < num_steps; ++step) {
+///         // ... update B ...
+///         slate::lu_solve_using_factor( F, B, opts );
+///     }
+///
+template <typename scalar_t>
+class LU {
+public:
+    LU() = default;
+
+    ~LU()
+    {
+        try {
+            release();
+        }
+        catch (...) {
+            // Destructors must not throw.
+        }
+    }
+
+    // Not copyable, as it releases A's device tiles on destruction.
+    LU( LU const& ) = delete;
+    LU& operator=( LU const& ) = delete;
+
+    //--------------------------------------------------------------------------
+    /// Factors A in place with getrf, replacing any previous factorization.
+    /// @return getrf's info.
+    int64_t factor( Matrix<scalar_t>& A, Options const& opts = Options() )
+    {
+        release();
+        A_ = A;
+        info_ = getrf( A_, pivots_, opts );
+
+        Target target = get_option( opts, Option::Target, Target::HostTask );
+        if (target == Target::Devices && info_ == 0) {
+            A_.tileGetAndHoldAllOnDevices( LayoutConvert::ColMajor );
+            held_ = true;
+        }
+        return info_;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Solves A X = B with getrs, overwriting B with X.
+    void solve( Matrix<scalar_t>& B, Options const& opts = Options() )
+    {
+        wait_solves();
+        getrs( A_, pivots_, B, opts );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Queues the solve, as slate::async::getrs. This object and B must not
+    /// be modified until the future completes. Later solves, factor,
+    /// release, and the destructor wait for it.
+    Future<void> solve_async(
+        Matrix<scalar_t>& B, Options const& opts = Options() )
+    {
+        last_solve_ = async::getrs( A_, pivots_, B, opts );
+        return last_solve_;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Waits for queued solves, then releases the factors' device tiles.
+    void release()
+    {
+        wait_solves();
+        if (held_) {
+            A_.tileUnsetHoldAllOnDevices();
+            A_.releaseLocalWorkspace();
+            held_ = false;
+        }
+    }
+
+    /// @return the LU factors.
+    Matrix<scalar_t>& A() { return A_; }
+
+    /// @return the pivots.
+    Pivots& pivots() { return pivots_; }
+
+    /// @return getrf's info of the last factorization.
+    int64_t info() const { return info_; }
+
+private:
+    //--------------------------------------------------------------------------
+    /// Waits for the last solve_async, hence all earlier ones, since async
+    /// calls run in order. Their exceptions are left to their futures.
+    void wait_solves()
+    {
+        if (last_solve_.valid()) {
+            try {
+                last_solve_.wait();
+            }
+            catch (...) {
+                // Reported by the future solve_async returned.
+            }
+            last_solve_ = Future<void>();
+        }
+    }
+
+    Matrix<scalar_t> A_;
+    Pivots pivots_;
+    int64_t info_ = 0;
+    bool held_ = false;
+    Future<void> last_solve_;
+};
+
+//------------------------------------------------------------------------------
+/// Cholesky factorization of a Hermitian positive definite matrix A, kept
+/// for repeated solves. As for LU, with potrf and potrs.
+///
+template <typename scalar_t>
+class Cholesky {
+public:
+    Cholesky() = default;
+
+    ~Cholesky()
+    {
+        try {
+            release();
+        }
+        catch (...) {
+            // Destructors must not throw.
+        }
+    }
+
+    // Not copyable, as it releases A's device tiles on destruction.
+    Cholesky( Cholesky const& ) = delete;
+    Cholesky& operator=( Cholesky const& ) = delete;
+
+    //--------------------------------------------------------------------------
+    /// Factors A in place with potrf, replacing any previous factorization.
+    /// @return potrf's info.
+    int64_t factor( HermitianMatrix<scalar_t>& A, Options const& opts = Options() )
+    {
+        release();
+        A_ = A;
+        info_ = potrf( A_, opts );
+
+        Target target = get_option( opts, Option::Target, Target::HostTask );
+        if (target == Target::Devices && info_ == 0) {
+            A_.tileGetAndHoldAllOnDevices( LayoutConvert::ColMajor );
+            held_ = true;
+        }
+        return info_;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Solves A X = B with potrs, overwriting B with X.
+    void solve( Matrix<scalar_t>& B, Options const& opts = Options() )
+    {
+        wait_solves();
+        potrs( A_, B, opts );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Queues the solve, as slate::async::potrs. This object and B must not
+    /// be modified until the future completes. Later solves, factor,
+    /// release, and the destructor wait for it.
+    Future<void> solve_async(
+        Matrix<scalar_t>& B, Options const& opts = Options() )
+    {
+        last_solve_ = async::potrs( A_, B, opts );
+        return last_solve_;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Waits for queued solves, then releases the factor's device tiles.
+    void release()
+    {
+        wait_solves();
+        if (held_) {
+            A_.tileUnsetHoldAllOnDevices();
+            A_.releaseLocalWorkspace();
+            held_ = false;
+        }
+    }
+
+    /// @return the Cholesky factor.
+    HermitianMatrix<scalar_t>& A() { return A_; }
+
+    /// @return potrf's info of the last factorization.
+    int64_t info() const { return info_; }
+
+private:
+    //--------------------------------------------------------------------------
+    /// Waits for the last solve_async, hence all earlier ones, since async
+    /// calls run in order. Their exceptions are left to their futures.
+    void wait_solves()
+    {
+        if (last_solve_.valid()) {
+            try {
+                last_solve_.wait();
+            }
+            catch (...) {
+                // Reported by the future solve_async returned.
+            }
+            last_solve_ = Future<void>();
+        }
+    }
+
+    HermitianMatrix<scalar_t> A_;
+    int64_t info_ = 0;
+    bool held_ = false;
+    Future<void> last_solve_;
+};
+
+//------------------------------------------------------------------------------
+// Simplified API with factorization objects
+
+//-----------------------------------------
+// lu_factor()
+template <typename scalar_t>
+int64_t lu_factor(
+    Matrix<scalar_t>& A, LU<scalar_t>& F,
+    Options const& opts = Options())
+{
+    return F.factor( A, opts );
+}
+
+//-----------------------------------------
+// lu_solve_using_factor()
+template <typename scalar_t>
+void lu_solve_using_factor(
+    LU<scalar_t>& F,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    F.solve( B, opts );
+}
+
+//-----------------------------------------
+// chol_factor()
+template <typename scalar_t>
+int64_t chol_factor(
+    HermitianMatrix<scalar_t>& A, Cholesky<scalar_t>& F,
+    Options const& opts = Options())
+{
+    return F.factor( A, opts );
+}
+
+//-----------------------------------------
+// chol_solve_using_factor()
+template <typename scalar_t>
+void chol_solve_using_factor(
+    Cholesky<scalar_t>& F,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    F.solve( B, opts );
+}
+
+} // namespace slate
+
+#endif // SLATE_FACTORIZATION_HH
@@ -0,0 +1,107 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_FLOP_STATS_HH
+#define SLATE_FLOP_STATS_HH
+
+#include "slate/enums.hh"
+#include "slate/internal/mpi.hh"
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Flops and time of one internal routine on one target, summed over its
+/// calls on this rank.
+/// Time is the wall time of each call, from dispatch until its tasks or
+/// device queue finish; calls that overlap, e.g., with lookahead, each
+/// count their full time.
+///
+/// @see flop_stats, flop_stats_report
+///
+struct FlopStats {
+    int64_t calls = 0;
+    double  flops = 0;
+    double  time  = 0;  ///< seconds
+
+    /// @return achieved rate, in flop/s.
+    double rate() const { return time > 0 ? flops / time : 0; }
+};
+
+void flop_stats_enable( bool enable );
+bool flop_stats_enabled();
+std::map< std::string, FlopStats > flop_stats();
+void flop_stats_reset();
+void flop_stats_report( MPI_Comm comm, FILE* file=stdout );
+
+namespace internal {
+
+/// Internal routines counted by FlopCounter.
+enum class FlopRoutine {
+    Gemm,
+    Herk,
+    Trsm,
+    Potrf,          ///< panel
+    GetrfPanel,     ///< panel
+    Count,
+};
+
+void flop_stats_record( FlopRoutine routine, Target target,
+                        double flops, double time );
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Times the enclosing internal routine and records it with its flops,
+/// if flop_stats_enable( true ) was called. Otherwise does nothing; the
+/// flops functor is called only when enabled, so counting local tiles
+/// costs nothing by default.
+///
+template <typename FlopsFunc>
+class FlopCounter {
+public:
+    FlopCounter( FlopRoutine routine, Target target, FlopsFunc flops )
+        : routine_( routine ),
+          target_( target ),
+          flops_( flops ),
+          enabled_( flop_stats_enabled() ),
+          start_( enabled_ ? MPI_Wtime() : 0 )
+    {}
+
+    ~FlopCounter()
+    {
+        if (enabled_)
+            flop_stats_record( routine_, target_, flops_(),
+                               MPI_Wtime() - start_ );
+    }
+
+    // Not copyable, as it records on destruction.
+    FlopCounter( FlopCounter const& ) = delete;
+    FlopCounter& operator=( FlopCounter const& ) = delete;
+
+private:
+    FlopRoutine routine_;
+    Target target_;
+    FlopsFunc flops_;
+    bool enabled_;
+    double start_;
+};
+
+//------------------------------------------------------------------------------
+/// @return flops of a multiply-add in scalar_t, relative to real:
+/// 4 for complex (6 flops per multiply and 2 per add), 1 for real.
+template <typename scalar_t>
+constexpr double flop_scale()
+{
+    return blas::is_complex<scalar_t>::value ? 4.0 : 1.0;
+}
+
+} // namespace internal
+
+} // namespace slate
+
+#endif // SLATE_FLOP_STATS_HH
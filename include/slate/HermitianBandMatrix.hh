@@ -28,9 +28,17 @@ namespace slate {
 template <typename scalar_t>
 class HermitianBandMatrix: public BaseTriangularBandMatrix<scalar_t> {
 public:
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
     // constructors
     HermitianBandMatrix();
 
+    HermitianBandMatrix(Uplo uplo, int64_t n, int64_t kd,
+                        std::function<int64_t (int64_t j)>& inTileNb,
+                        std::function<int (ij_tuple ij)>& inTileRank,
+                        std::function<int (ij_tuple ij)>& inTileDevice,
+                        MPI_Comm mpi_comm);
+
     HermitianBandMatrix(
         Uplo uplo,
         int64_t n, int64_t kd,
@@ -62,6 +70,7 @@ public:
     }
 
     void    he2hbGather(HermitianMatrix<scalar_t>& A);
+    void    he2hbGather(HermitianMatrix<scalar_t>& A, int64_t j);
 };
 
 //------------------------------------------------------------------------------
@@ -71,6 +80,22 @@ HermitianBandMatrix<scalar_t>::HermitianBandMatrix()
     : BaseTriangularBandMatrix<scalar_t>()
 {}
 
+//------------------------------------------------------------------------------
+/// Constructor creates an n-by-n Hermitian band matrix, with no tiles
+/// allocated, where tileNb, tileRank, tileDevice are given as functions.
+/// Tiles can be added with tileInsert().
+///
+template <typename scalar_t>
+HermitianBandMatrix<scalar_t>::HermitianBandMatrix(
+    Uplo uplo, int64_t n, int64_t kd,
+    std::function<int64_t (int64_t j)>& inTileNb,
+    std::function<int (ij_tuple ij)>& inTileRank,
+    std::function<int (ij_tuple ij)>& inTileDevice,
+    MPI_Comm mpi_comm)
+    : BaseTriangularBandMatrix<scalar_t>(uplo, n, kd, inTileNb, inTileRank,
+                                         inTileDevice, mpi_comm)
+{}
+
 //------------------------------------------------------------------------------
 /// Constructor creates an n-by-n Hermitian band matrix, with no tiles allocated.
 /// Tiles can be added with tileInsert().
@@ -303,7 +328,9 @@ void HermitianBandMatrix<scalar_t>::gatherAll(std::set<int>& rank_set, int tag)
 
 //------------------------------------------------------------------------------
 /// Gather the distributed triangular band portion of a HermitianMatrix A
-//  to HermitianBandMatrix B on MPI rank 0.
+/// to this HermitianBandMatrix B, i.e., copy each band tile A(i, j) to
+/// the rank owning B(i, j). With B on a 1-by-1 grid, this gathers the band
+/// on MPI rank 0.
 /// Primarily for EVD code
 ///
 template <typename scalar_t>
@@ -311,48 +338,60 @@ void HermitianBandMatrix<scalar_t>::he2hbGather(HermitianMatrix<scalar_t>& A)
 {
     Op op_save = this->op();
     this->op_ = Op::NoTrans;
+
+    // j is tile (block col) index
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        he2hbGather( A, j );
+    }
+
+    this->op_ = op_save;
+}
+
+//------------------------------------------------------------------------------
+/// Gather block column j of the triangular band portion of a
+/// HermitianMatrix A to this HermitianBandMatrix B, as he2hbGather above.
+/// Messages use B's MPI communicator, so if it is a duplicate of A's,
+/// block columns can be gathered while other operations on A are in
+/// progress, as in the pipelined heev. B must not be transposed.
+///
+template <typename scalar_t>
+void HermitianBandMatrix<scalar_t>::he2hbGather(
+    HermitianMatrix<scalar_t>& A, int64_t j)
+{
+    slate_assert( this->op() == Op::NoTrans );
     auto upper = this->uplo() == Uplo::Upper;
 
     int64_t mt = A.mt();
-    int64_t nt = A.nt();
     int64_t kdt = ceildiv( this->bandwidth(), this->tileNb(0) );
-    // i, j are tile (block row, block col) indices
-    for (int64_t j = 0; j < nt; ++j) {
 
-        int64_t istart = upper ? blas::max( 0, j-kdt ) : j;
-        int64_t iend   = upper ? j : blas::min( j+kdt, mt-1 );
-        for (int64_t i = 0; i < mt; ++i) {
-            if (i >= istart && i <= iend) {
-                if (this->mpi_rank_ == 0) {
-                    if (! A.tileIsLocal(i, j)) {
-                        this->tileInsert( i, j, HostNum );
-                        auto Bij = this->at(i, j);
-                        Bij.recv(A.tileRank(i, j), this->mpi_comm_, this->layout());
-                    }
-                    else {
-                        A.tileGetForReading(i, j, LayoutConvert(this->layout()));
-                        // TODO add: this->tileGetForWriting(i, j, LayoutConvert(this->layout()));
-                        // copy local tiles if needed.
-                        auto Aij = A(i, j);
-                        auto Bij = this->at(i, j);
-                        if (Aij.data() != Bij.data() ) {
-                            tile::gecopy( A(i, j), Bij );
-                        }
-                    }
-                }
-                else if (A.tileIsLocal(i, j)) {
-                    A.tileGetForReading(i, j, LayoutConvert(this->layout()));
-                    auto Aij = A(i, j);
-                    Aij.send(0, this->mpi_comm_);
+    int64_t istart = upper ? blas::max( 0, j-kdt ) : j;
+    int64_t iend   = upper ? j : blas::min( j+kdt, mt-1 );
+    for (int64_t i = istart; i <= iend; ++i) {
+        if (this->tileIsLocal(i, j)) {
+            if (! A.tileIsLocal(i, j)) {
+                this->tileInsert( i, j, HostNum );
+                auto Bij = this->at(i, j);
+                Bij.recv(A.tileRank(i, j), this->mpi_comm_, this->layout());
+            }
+            else {
+                A.tileGetForReading(i, j, LayoutConvert(this->layout()));
+                // TODO add: this->tileGetForWriting(i, j, LayoutConvert(this->layout()));
+                // copy local tiles if needed.
+                auto Aij = A(i, j);
+                auto Bij = this->at(i, j);
+                if (Aij.data() != Bij.data() ) {
+                    tile::gecopy( A(i, j), Bij );
                 }
             }
         }
+        else if (A.tileIsLocal(i, j)) {
+            A.tileGetForReading(i, j, LayoutConvert(this->layout()));
+            auto Aij = A(i, j);
+            Aij.send(this->tileRank(i, j), this->mpi_comm_);
+        }
     }
-
-    this->op_ = op_save;
 }
 
-
 } // namespace slate
 
 #endif // SLATE_HERMITIAN_BAND_MATRIX_HH
@@ -150,6 +150,10 @@ protected:
            int num_devices, int64_t lda, int64_t mb, int64_t nb,
            int p, int q, MPI_Comm mpi_comm);
 
+    // used by LAPACK and ScaLAPACK constructors and rebind
+    void insertOriginTiles(scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+                           int p, int q, bool is_scalapack);
+
 public:
     template <typename T>
     friend void swap(Matrix<T>& A, Matrix<T>& B);
@@ -161,7 +165,10 @@ public:
     void reserveHostWorkspace();
     void reserveDeviceWorkspace();
     void gather(scalar_t* A, int64_t lda);
+    void rebindLAPACK(scalar_t* A, int64_t lda);
+    void rebindScaLAPACK(scalar_t* A, int64_t lda);
     void insertLocalTiles(Target origin=Target::Host);
+    void insertLocalTilesLazy(Target origin=Target::Host);
 };
 
 //------------------------------------------------------------------------------
@@ -490,7 +497,20 @@ Matrix<scalar_t>::Matrix(
     : BaseMatrix<scalar_t>( m, n, mb, nb, order, p, q, mpi_comm )
 {
     this->origin_ = Target::Host;
+    insertOriginTiles( A, lda, mb, nb, p, q, is_scalapack );
+}
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Inserts the local tiles of LAPACK or ScaLAPACK array A as host origin
+/// tiles.
+/// @see fromLAPACK, fromScaLAPACK
+///
+template <typename scalar_t>
+void Matrix<scalar_t>::insertOriginTiles(
+    scalar_t* A, int64_t lda, int64_t mb, int64_t nb,
+    int p, int q, bool is_scalapack)
+{
     // ii, jj are row, col indices
     // ii_local and jj_local are the local array indices in A
     // block-cyclic layout (indxg2l)
@@ -767,6 +787,61 @@ void Matrix<scalar_t>::reserveDeviceWorkspace()
     this->storage_->reserveDeviceWorkspace( getMaxDeviceTiles() );
 }
 
+//------------------------------------------------------------------------------
+/// Rebinds a matrix made by fromLAPACK to wrap the LAPACK array A of the
+/// same size, instead of its original array. All tiles are removed,
+/// including workspace copies of the old data, but the storage keeps its
+/// queues, batch arrays, and memory pool, so rebinding costs much less
+/// than constructing a new matrix. Shallow copies see the new data.
+/// Used to reuse matrices of the same shape across calls of the LAPACK API.
+///
+/// @param[in,out] A
+///     The m-by-n, column-major matrix A, in an lda-by-n array.
+///
+/// @param[in] lda
+///     Leading dimension of the array A. lda >= m.
+///
+template <typename scalar_t>
+void Matrix<scalar_t>::rebindLAPACK(scalar_t* A, int64_t lda)
+{
+    slate_assert( this->ioffset() == 0 && this->joffset() == 0 );
+    slate_assert( this->op() == Op::NoTrans );
+    slate_assert( this->origin() == Target::Host );
+
+    GridOrder order;
+    int p, q, myp, myq;
+    this->gridinfo( &order, &p, &q, &myp, &myq );
+    this->clear();
+    insertOriginTiles( A, lda, this->tileMb( 0 ), this->tileNb( 0 ), p, q,
+                       false );
+}
+
+//------------------------------------------------------------------------------
+/// Rebinds a matrix made by fromScaLAPACK to wrap the local ScaLAPACK array
+/// A of the same size and distribution, instead of its original array.
+/// @see rebindLAPACK
+///
+/// @param[in,out] A
+///     The local part of the ScaLAPACK matrix, in an lda-by-nlocal array.
+///
+/// @param[in] lda
+///     Local leading dimension of the array A.
+///
+template <typename scalar_t>
+void Matrix<scalar_t>::rebindScaLAPACK(scalar_t* A, int64_t lda)
+{
+    slate_assert( this->ioffset() == 0 && this->joffset() == 0 );
+    slate_assert( this->op() == Op::NoTrans );
+    slate_assert( this->origin() == Target::Host );
+
+    GridOrder order;
+    int p, q, myp, myq;
+    this->gridinfo( &order, &p, &q, &myp, &myq );
+    this->clear();
+    insertOriginTiles( A, lda, this->tileMb( 0 ), this->tileNb( 0 ), p, q,
+                       true );
+}
+
 //------------------------------------------------------------------------------
 /// Gathers the entire matrix to the LAPACK-style matrix A on MPI rank 0.
 /// Primarily for debugging purposes.
@@ -848,6 +923,33 @@ void Matrix<scalar_t>::insertLocalTiles(Target origin)
     }
 }
 
+//------------------------------------------------------------------------------
+/// Inserts all local tiles into an empty matrix, deferring allocation of
+/// each tile's data until it is first used, as by tileInsertLazy.
+/// Until written, tiles are zero. This saves memory and time for workspace
+/// matrices that are overwritten, such as the output of copy.
+///
+/// @param[in] target
+///     - if target = Devices, inserts tiles on appropriate GPU devices, or
+///     - if target = Host,    inserts tiles on CPU host.
+///
+template <typename scalar_t>
+void Matrix<scalar_t>::insertLocalTilesLazy(Target origin)
+{
+    this->origin_ = origin;
+
+    bool on_devices = (origin == Target::Devices);
+    for (int64_t j = 0; j < this->nt(); ++j) {
+        for (int64_t i = 0; i < this->mt(); ++i) {
+            if (this->tileIsLocal(i, j)) {
+                int dev = (on_devices ? this->tileDevice(i, j)
+                                      : HostNum);
+                this->tileInsertLazy(i, j, dev);
+            }
+        }
+    }
+}
+
 } // namespace slate
 
 #endif // SLATE_MATRIX_HH
@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_MIXED_FACTORIZATION_HH
+#define SLATE_MIXED_FACTORIZATION_HH
+
+#include "slate/Matrix.hh"
+#include "slate/types.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Low precision LU factorization of a matrix A, kept between mixed
+/// precision solves with the same A and different right-hand sides,
+/// e.g., Newton iterations with a frozen Jacobian.
+/// Filled in by gesv_mixed_factor, and used by gesv_mixed_solve and
+/// gesv_mixed_gmres_solve, which then run only the low precision solve and
+/// the refinement, instead of copying and factoring A on every call.
+///
+/// A is not stored; the same, unmodified A must be passed to each solve.
+///
+/// Example:
+///
+///     slate::MixedFactorization<double, float> F;
+///     slate::gesv_mixed_factor( A, F, opts );
+///     for (int step = 0; step < num_steps; ++step) {
+///         // ... update B ...
+///         slate::gesv_mixed_solve( A, F, B, X, iter, opts );
+///     }
+///
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+///
+template <typename scalar_hi, typename scalar_lo>
+class MixedFactorization {
+public:
+    using real_hi = blas::real_type<scalar_hi>;
+
+    /// LU factors of A, in low precision.
+    Matrix<scalar_lo> A_lo;
+
+    /// Pivots of the low precision factorization.
+    Pivots pivots;
+
+    /// Infinity norm of A, for the stopping criterion.
+    real_hi Anorm = 0;
+
+    /// getrf info of the low precision factorization;
+    /// if nonzero, solves fall back to high precision, if allowed.
+    int64_t info = 0;
+
+    /// GMRES test and solution bases, allocated by the first
+    /// gesv_mixed_gmres_solve.
+    Matrix<scalar_hi> V;
+    Matrix<scalar_hi> W;
+
+    /// LU factors of A in high precision, computed by the first solve that
+    /// falls back to high precision; later solves use them directly.
+    Matrix<scalar_hi> A_hi;
+    Pivots pivots_hi;
+    bool factored_hi = false;
+    int64_t info_hi = 0;
+};
+
+} // namespace slate
+
+#endif // SLATE_MIXED_FACTORIZATION_HH
@@ -0,0 +1,78 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_NORM_REQUEST_HH
+#define SLATE_NORM_REQUEST_HH
+
+#include "slate/internal/mpi.hh"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Reduction across MPI ranks of a split-phase norm, started by norms_start
+/// or colNorms_start. Those compute the local norms, start an
+/// MPI_Iallreduce, and return, so the application can compute, e.g., the
+/// next residual, while the reduction is in flight. wait() completes it
+/// and stores the norms in the output arrays given at the start; they
+/// must not be read before then.
+///
+/// As with blocking norms, all ranks must start the same reductions in the
+/// same order. The destructor waits for a pending reduction. Not copyable.
+///
+/// Example:
+///
+///     std::vector<double> colnorms_X( X.n() ), colnorms_R( R.n() );
+///     auto request = slate::colNorms_start(
+///         slate::Norm::Max, X, colnorms_X.data(),
+///                           R, colnorms_R.data(), opts );
+///     // ... compute something that doesn't need the norms ...
+///     request.wait();
+///
+template <typename real_t>
+class NormRequest {
+public:
+    /// Reduction of the local values across ranks.
+    enum class Reduce {
+        Max,                ///< max of each value, propagating NaN
+        Sum,                ///< sum of each value
+        MaxFirstSumRest,    ///< max of first value, sum of the others
+    };
+
+    /// Creates a request with no reduction pending.
+    NormRequest() = default;
+
+    NormRequest(
+        std::vector<real_t> local_values, Reduce reduce, MPI_Comm comm,
+        std::function< void (real_t const* global_values) > finish );
+
+    ~NormRequest();
+
+    NormRequest( NormRequest&& other ) = default;
+    NormRequest& operator=( NormRequest&& other );
+
+    NormRequest( NormRequest const& ) = delete;
+    NormRequest& operator=( NormRequest const& ) = delete;
+
+    void wait();
+    bool test();
+
+    /// @return true if a reduction is pending.
+    bool pending() const { return state_ != nullptr; }
+
+private:
+    struct State;
+
+    void finish();
+
+    std::unique_ptr< State > state_;
+};
+
+} // namespace slate
+
+#endif // SLATE_NORM_REQUEST_HH
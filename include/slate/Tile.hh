@@ -6,6 +6,8 @@
 #ifndef SLATE_TILE_HH
 #define SLATE_TILE_HH
 
+#include "slate/CommStats.hh"
+#include "slate/internal/CommPlan.hh"
 #include "slate/internal/Memory.hh"
 #include "slate/internal/Trace.hh"
 #include "slate/internal/device.hh"
@@ -22,6 +24,7 @@
 #include <cstring>
 #include <memory>
 
+#include "slate/internal/comm.hh"
 #include "slate/internal/mpi.hh"
 #include "slate/internal/openmp.hh"
 
@@ -121,6 +124,8 @@ enum class TileKind : char {
     Workspace  = 'w',  ///< SLATE allocated workspace tile
     SlateOwned = 'o',  ///< SLATE allocated origin tile
     UserOwned  = 'u',  ///< User owned origin tile
+    NodeShared = 'n',  ///< read-only workspace tile in memory shared by
+                       ///< the ranks of a node (@see NodeSharedPool)
 };
 
 //------------------------------------------------------------------------------
@@ -152,9 +157,17 @@ public:
     void copyData(Tile<scalar_t>* dst_tile) const;
 
     void send(int dst, MPI_Comm mpi_comm, int tag = 0) const;
-    void isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *req) const;
-    void recv(int src, MPI_Comm mpi_comm, Layout layout, int tag = 0);
-    void irecv(int src, MPI_Comm mpi_comm, Layout layout, int tag, MPI_Request *req);
+    void isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *req,
+               CommPlan* plan = nullptr) const;
+    void recv(int src, MPI_Comm mpi_comm, Layout layout, int tag = 0,
+              CommPlan* plan = nullptr);
+    void irecv(int src, MPI_Comm mpi_comm, Layout layout, int tag, MPI_Request *req,
+               CommPlan* plan = nullptr);
+    void isendChunk(int64_t first, int64_t count, int dst, MPI_Comm mpi_comm,
+                    int tag, MPI_Request *req, CommPlan* plan = nullptr) const;
+    void irecvChunk(int64_t first, int64_t count, int src, MPI_Comm mpi_comm,
+                    int tag, MPI_Request *req, CommPlan* plan = nullptr);
+    void mpiDatatype(MPI_Datatype* newtype) const;
     void bcast(int bcast_root, MPI_Comm mpi_comm);
 
     /// Returns shallow copy of tile that is transposed.
@@ -214,12 +227,18 @@ public:
     bool origin() const { return ! workspace(); }
 
     /// Returns true if this is a workspace tile.
-    bool workspace() const { return kind_ == TileKind::Workspace; }
+    bool workspace() const
+    {
+        return kind_ == TileKind::Workspace || kind_ == TileKind::NodeShared;
+    }
 
     /// Returns true if SLATE allocated this tile's memory,
     /// false if the user provided the tile's memory,
-    /// e.g., via a fromScaLAPACK constructor.
-    bool allocated() const { return kind_ != TileKind::UserOwned; }
+    /// e.g., via a fromScaLAPACK constructor, or the tile is NodeShared.
+    bool allocated() const
+    {
+        return kind_ != TileKind::UserOwned && kind_ != TileKind::NodeShared;
+    }
 
     /// Returns the TileKind of this tile
     TileKind kind()
@@ -274,9 +293,13 @@ public:
 
     /// Returns whether this tile can safely store its data in transposed form
     /// based on its 'TileKind', buffer size, Layout, and stride.
+    /// NodeShared tiles are read by other ranks, so are never transposed
+    /// in place.
     /// todo: validate and handle sliced-matrix
     bool isTransposable()
     {
+        if (kind_ == TileKind::NodeShared)
+            return extended();
         return    extended()                    // already extended buffer
                || mb_ == nb_                    // square tile
                || kind_ != TileKind::UserOwned  // SLATE allocated
@@ -322,7 +345,7 @@ public:
     /// Overload with work_data = nullptr.
     void layoutConvert(blas::Queue& queue, bool async = false)
     {
-        assert(mb() == nb() || extended());
+        assert(mb() == nb() || extended() || device_ != HostNum);
         layoutConvert(nullptr, queue, async);
     }
 
@@ -392,6 +415,33 @@ protected:
         }
     }
 
+    //--------------------------------------------------------------------------
+    /// @return contiguous mb-by-nb tile whose data is not yet allocated,
+    /// for MatrixStorage::tileInsertLazy. Its data is attached later
+    /// by attachData.
+    static Tile<scalar_t> lazy(
+        int64_t mb, int64_t nb, int device, TileKind kind, Layout layout)
+    {
+        Tile<scalar_t> tile;
+        tile.mb_          = mb;
+        tile.nb_          = nb;
+        tile.stride_      = (layout == Layout::ColMajor) ? mb : nb;
+        tile.user_stride_ = tile.stride_;
+        tile.kind_        = kind;
+        tile.layout_      = layout;
+        tile.user_layout_ = layout;
+        tile.device_      = device;
+        return tile;
+    }
+
+    /// Attaches contiguous data of size() elements to a lazy tile.
+    void attachData(scalar_t* data)
+    {
+        slate_assert( data_ == nullptr && data != nullptr );
+        data_      = data;
+        user_data_ = data;
+    }
+
     //--------------------
     // begin/end markup used by generate_matrix.py script; do not modify!
     // @begin data members
@@ -860,7 +910,8 @@ void Tile<scalar_t>::layoutConvert(scalar_t* work_data)
 /// Performs:
 ///     - In-place conversion for square tiles
 ///     - In-place conversion for contiguous rectangular tiles,
-///       using a workspace.
+///       using a workspace if given, otherwise following the
+///       permutation's cycles without a workspace.
 ///     - Out-of-place conversion if extended tile, swaps front buffer
 ///       accordingly.
 ///
@@ -868,7 +919,8 @@ void Tile<scalar_t>::layoutConvert(scalar_t* work_data)
 /// A BLAS++ queue should be provided if tile instance is on a device.
 ///
 /// @param[in] work_data
-///     Pointer to a workspace buffer, needed for out-of-place transpose.
+///     Optional pointer to a workspace buffer for contiguous rectangular
+///     tiles, or nullptr.
 ///
 /// @param[in] queue
 ///     BLAS++ queue to run the kernels on the device.
@@ -907,9 +959,16 @@ void Tile<scalar_t>::layoutConvert(
             src_data = layoutBackData();
             src_stride = layoutBackStride();
         }
+        else if (work_data == nullptr) { // tile already convertible
+            // in-place, without a workspace
+            slate_assert(isContiguous());
+            device::transpose(false, old_mb, old_nb, data_, queue);
+            if (! async)
+                queue.sync();
+            return;
+        }
         else { // tile already convertible
             slate_assert(isContiguous());
-            slate_assert(work_data != nullptr); // need a workspace buffer
 
             src_data = work_data;
             src_stride = old_layout == Layout::ColMajor ? mb() : nb();
@@ -1057,11 +1116,11 @@ void Tile<scalar_t>::copyData(
 template <typename scalar_t>
 void Tile<scalar_t>::send(int dst, MPI_Comm mpi_comm, int tag) const
 {
-    trace::Block trace_block("MPI_Send");
+    trace::Block trace_block("MPI_Send", -1, -1, mb_*nb_*sizeof(scalar_t));
 
     MPI_Request request;
     isend( dst, mpi_comm, tag, &request );
-    slate_mpi_call( MPI_Wait( &request, MPI_STATUS_IGNORE ) );
+    internal::comm_wait( &request );
 }
 
 //------------------------------------------------------------------------------
@@ -1079,36 +1138,42 @@ void Tile<scalar_t>::send(int dst, MPI_Comm mpi_comm, int tag) const
 /// @param[out] request
 ///     MPI Request object
 ///
+/// @param[in] plan
+///     Optional communication plan. If given, the send uses the plan's
+///     persistent request, which is owned by the plan and must not be freed.
+///
 // todo need to copy or verify metadata (sizes, op, uplo, ...)
 template <typename scalar_t>
-void Tile<scalar_t>::isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *request) const
+void Tile<scalar_t>::isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *request,
+                           CommPlan* plan) const
 {
-    trace::Block trace_block("MPI_Isend");
+    trace::Block trace_block("MPI_Isend", -1, -1, mb_*nb_*sizeof(scalar_t));
 
+    int count;
+    MPI_Datatype type;
     // If no stride.
     if (this->isContiguous()) {
         // Use simple send.
-        int count = mb_*nb_;
-
-        slate_mpi_call(
-            MPI_Isend(data_, count, mpi_type<scalar_t>::value, dst, tag,
-                      mpi_comm, request));
+        count = mb_*nb_;
+        type = mpi_type<scalar_t>::value;
     }
     else {
-        // Otherwise, use strided send.
-        int count = layout_ == Layout::ColMajor ? nb_ : mb_;
-        int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
-        int stride = stride_;
-        MPI_Datatype newtype;
+        // Otherwise, use strided send, with a cached datatype.
+        count = 1;
+        type = internal::mpi_vector_type(
+            layout_ == Layout::ColMajor ? nb_ : mb_,
+            layout_ == Layout::ColMajor ? mb_ : nb_,
+            stride_, mpi_type<scalar_t>::value);
+    }
 
+    if (plan != nullptr) {
+        plan->isend(data_, count, type, dst, tag, mpi_comm, request);
+    }
+    else {
         slate_mpi_call(
-            MPI_Type_vector(count, blocklength, stride,
-                            mpi_type<scalar_t>::value, &newtype));
-
-        slate_mpi_call(MPI_Type_commit(&newtype));
-        slate_mpi_call(MPI_Isend(data_, 1, newtype, dst, tag, mpi_comm, request));
-        slate_mpi_call(MPI_Type_free(&newtype));
+            MPI_Isend(data_, count, type, dst, tag, mpi_comm, request));
     }
+    internal::comm_stats_send( dst, mb_*nb_*sizeof(scalar_t) );
     // todo: would specializing to Triangular / Band tiles improve performance
     // by receiving less / compacted data
 }
@@ -1128,15 +1193,19 @@ void Tile<scalar_t>::isend(int dst, MPI_Comm mpi_comm, int tag, MPI_Request *req
 /// @param[in] tag
 ///     MPI tag
 ///
+/// @param[in] plan
+///     Optional communication plan; see irecv.
+///
 // todo need to copy or verify metadata (sizes, op, uplo, ...)
 template <typename scalar_t>
-void Tile<scalar_t>::recv(int src, MPI_Comm mpi_comm, Layout layout, int tag)
+void Tile<scalar_t>::recv(int src, MPI_Comm mpi_comm, Layout layout, int tag,
+                          CommPlan* plan)
 {
-    trace::Block trace_block("MPI_Recv");
+    trace::Block trace_block("MPI_Recv", -1, -1, mb_*nb_*sizeof(scalar_t));
 
     MPI_Request request;
-    irecv( src, mpi_comm, layout, tag, &request );
-    slate_mpi_call( MPI_Wait( &request, MPI_STATUS_IGNORE ) );
+    irecv( src, mpi_comm, layout, tag, &request, plan );
+    internal::comm_wait( &request );
 }
 
 //------------------------------------------------------------------------------
@@ -1157,46 +1226,199 @@ void Tile<scalar_t>::recv(int src, MPI_Comm mpi_comm, Layout layout, int tag)
 /// @param[out] request
 ///     MPI request object
 ///
+/// @param[in] plan
+///     Optional communication plan. If given, the receive uses the plan's
+///     persistent request, which is owned by the plan and must not be freed.
+///
 // todo need to copy or verify metadata (sizes, op, uplo, ...)
 template <typename scalar_t>
 void Tile<scalar_t>::irecv(int src, MPI_Comm mpi_comm, Layout layout,
-                           int tag, MPI_Request* request)
+                           int tag, MPI_Request* request, CommPlan* plan)
 {
-    trace::Block trace_block("MPI_Irecv");
+    trace::Block trace_block("MPI_Irecv", -1, -1, mb_*nb_*sizeof(scalar_t));
 
     this->setLayout( layout );
 
+    int count;
+    MPI_Datatype type;
     // If no stride.
     if (this->isContiguous()) {
         // Use simple recv.
-        int count = mb_*nb_;
+        count = mb_*nb_;
+        type = mpi_type<scalar_t>::value;
+    }
+    else {
+        // Otherwise, use strided recv, with a cached datatype.
+        count = 1;
+        type = internal::mpi_vector_type(
+            layout_ == Layout::ColMajor ? nb_ : mb_,
+            layout_ == Layout::ColMajor ? mb_ : nb_,
+            stride_, mpi_type<scalar_t>::value);
+    }
 
+    if (plan != nullptr) {
+        plan->irecv(data_, count, type, src, tag, mpi_comm, request);
+    }
+    else {
         slate_mpi_call(
-            MPI_Irecv(data_, count, mpi_type<scalar_t>::value, src, tag,
-                     mpi_comm, request));
+            MPI_Irecv(data_, count, type, src, tag, mpi_comm, request));
+    }
+    internal::comm_stats_recv( src, mb_*nb_*sizeof(scalar_t) );
+    // todo: would specializing to Triangular / Band tiles improve performance
+    // by receiving less / compacted data
+}
+
+//------------------------------------------------------------------------------
+/// Sends a chunk of the tile to MPI rank dst, using immediate mode.
+/// The chunk is count columns starting at column first if the tile is
+/// ColMajor, or count rows starting at row first if it is RowMajor,
+/// so it is a set of whole leading-dimension vectors.
+/// Used by pipelined broadcasts; the receiver must use irecvChunk with
+/// the same first, count, and layout.
+///
+/// @param[in] first
+///     First column (ColMajor) or row (RowMajor) of the chunk.
+///
+/// @param[in] count
+///     Number of columns (ColMajor) or rows (RowMajor) in the chunk.
+///
+/// @param[in] dst
+///     Destination MPI rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] tag
+///     MPI tag
+///
+/// @param[out] request
+///     MPI Request object
+///
+/// @param[in] plan
+///     Optional communication plan; see isend.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::isendChunk(
+    int64_t first, int64_t count, int dst, MPI_Comm mpi_comm,
+    int tag, MPI_Request *request, CommPlan* plan) const
+{
+    trace::Block trace_block("MPI_Isend", -1, -1, mb_*nb_*sizeof(scalar_t));
+
+    int64_t outer = layout_ == Layout::ColMajor ? nb_ : mb_;
+    int64_t inner = layout_ == Layout::ColMajor ? mb_ : nb_;
+    assert(0 <= first && 0 <= count && first + count <= outer);
+
+    scalar_t* chunk_data = &data_[ first*stride_ ];
+    int n;
+    MPI_Datatype type;
+    if (stride_ == inner || count == 1) {
+        // Use simple send.
+        n = int( inner*count );
+        type = mpi_type<scalar_t>::value;
     }
     else {
-        // Otherwise, use strided recv.
-        int count = layout_ == Layout::ColMajor ? nb_ : mb_;
-        int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
-        int stride = stride_;
-        MPI_Datatype newtype;
+        // Otherwise, use strided send, with a cached datatype.
+        n = 1;
+        type = internal::mpi_vector_type(
+            count, inner, stride_, mpi_type<scalar_t>::value);
+    }
 
+    if (plan != nullptr) {
+        plan->isend(chunk_data, n, type, dst, tag, mpi_comm, request);
+    }
+    else {
         slate_mpi_call(
-            MPI_Type_vector(
-                count, blocklength, stride, mpi_type<scalar_t>::value,
-                &newtype));
+            MPI_Isend(chunk_data, n, type, dst, tag, mpi_comm, request));
+    }
+    internal::comm_stats_send( dst, inner*count*sizeof(scalar_t) );
+}
 
-        slate_mpi_call(MPI_Type_commit(&newtype));
+//------------------------------------------------------------------------------
+/// Receives a chunk of the tile from MPI rank src, using immediate mode.
+/// The chunk is as in isendChunk, in the tile's current layout, which
+/// must already be the layout of the received data.
+///
+/// @param[in] first
+///     First column (ColMajor) or row (RowMajor) of the chunk.
+///
+/// @param[in] count
+///     Number of columns (ColMajor) or rows (RowMajor) in the chunk.
+///
+/// @param[in] src
+///     Source MPI rank in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     MPI communicator.
+///
+/// @param[in] tag
+///     MPI tag
+///
+/// @param[out] request
+///     MPI request object
+///
+/// @param[in] plan
+///     Optional communication plan; see irecv.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::irecvChunk(
+    int64_t first, int64_t count, int src, MPI_Comm mpi_comm,
+    int tag, MPI_Request* request, CommPlan* plan)
+{
+    trace::Block trace_block("MPI_Irecv", -1, -1, mb_*nb_*sizeof(scalar_t));
+
+    int64_t outer = layout_ == Layout::ColMajor ? nb_ : mb_;
+    int64_t inner = layout_ == Layout::ColMajor ? mb_ : nb_;
+    assert(0 <= first && 0 <= count && first + count <= outer);
 
+    scalar_t* chunk_data = &data_[ first*stride_ ];
+    int n;
+    MPI_Datatype type;
+    if (stride_ == inner || count == 1) {
+        // Use simple recv.
+        n = int( inner*count );
+        type = mpi_type<scalar_t>::value;
+    }
+    else {
+        // Otherwise, use strided recv, with a cached datatype.
+        n = 1;
+        type = internal::mpi_vector_type(
+            count, inner, stride_, mpi_type<scalar_t>::value);
+    }
+
+    if (plan != nullptr) {
+        plan->irecv(chunk_data, n, type, src, tag, mpi_comm, request);
+    }
+    else {
         slate_mpi_call(
-            MPI_Irecv(data_, 1, newtype, src, tag, mpi_comm,
-                      request));
+            MPI_Irecv(chunk_data, n, type, src, tag, mpi_comm, request));
+    }
+    internal::comm_stats_recv( src, inner*count*sizeof(scalar_t) );
+}
 
-        slate_mpi_call(MPI_Type_free(&newtype));
+//------------------------------------------------------------------------------
+/// Creates an MPI datatype describing the tile's data, starting at data(),
+/// in its current layout and stride. The datatype is not committed; it is
+/// meant to be combined with other tiles' datatypes, e.g., with
+/// MPI_Type_create_struct to send several tiles in one message.
+/// The caller must free it with MPI_Type_free.
+///
+/// @param[out] newtype
+///     The new MPI datatype.
+///
+template <typename scalar_t>
+void Tile<scalar_t>::mpiDatatype(MPI_Datatype* newtype) const
+{
+    if (this->isContiguous()) {
+        slate_mpi_call(
+            MPI_Type_contiguous(mb_*nb_, mpi_type<scalar_t>::value, newtype));
+    }
+    else {
+        int count = layout_ == Layout::ColMajor ? nb_ : mb_;
+        int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
+        slate_mpi_call(
+            MPI_Type_vector(count, blocklength, stride_,
+                            mpi_type<scalar_t>::value, newtype));
     }
-    // todo: would specializing to Triangular / Band tiles improve performance
-    // by receiving less / compacted data
 }
 
 //------------------------------------------------------------------------------
@@ -1231,38 +1453,37 @@ void Tile<scalar_t>::bcast(int bcast_root, MPI_Comm mpi_comm)
     //else
     {
         // Otherwise, use strided bcast.
-        trace::Block trace_block("MPI_Bcast");
+        trace::Block trace_block("MPI_Bcast", -1, -1, mb_*nb_*sizeof(scalar_t));
         // todo: layout
         int count = layout_ == Layout::ColMajor ? nb_ : mb_;
         int blocklength = layout_ == Layout::ColMajor ? mb_ : nb_;
-        int stride = stride_;
-        MPI_Datatype newtype;
-
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Type_vector(
-                    count, blocklength, stride, mpi_type<scalar_t>::value,
-                    &newtype));
-        }
-
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Type_commit(&newtype));
+        MPI_Datatype type = internal::mpi_vector_type(
+            count, blocklength, stride_, mpi_type<scalar_t>::value);
+
+        if (internal::comm_thread_active()) {
+            // Don't block the communication thread in MPI_Bcast.
+            MPI_Request request;
+            #pragma omp critical(slate_mpi)
+            {
+                slate_mpi_call(
+                    MPI_Ibcast(data_, 1, type, bcast_root, mpi_comm, &request));
+            }
+            internal::comm_wait( &request );
         }
-
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Bcast(data_, 1, newtype, bcast_root, mpi_comm));
+        else {
+            #pragma omp critical(slate_mpi)
+            {
+                slate_mpi_call(
+                    MPI_Bcast(data_, 1, type, bcast_root, mpi_comm));
+            }
         }
 
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Type_free(&newtype));
-        }
+        int mpi_rank;
+        slate_mpi_call( MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+        if (mpi_rank == bcast_root)
+            internal::comm_stats_send( bcast_root, mb_*nb_*sizeof(scalar_t) );
+        else
+            internal::comm_stats_recv( bcast_root, mb_*nb_*sizeof(scalar_t) );
     }
 }
 
@@ -0,0 +1,199 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_LOW_RANK_MATRIX_HH
+#define SLATE_TILE_LOW_RANK_MATRIX_HH
+
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "slate/Tile.hh"
+#include "slate/types.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Tile stored as low-rank factors, $A = U V^H$, where U is mb-by-rank and
+/// V is nb-by-rank, both column major. Rank 0 is a zero tile.
+///
+template <typename scalar_t>
+class LowRankTile {
+public:
+    LowRankTile( int64_t mb = 0, int64_t nb = 0, int64_t rank = 0 )
+        : mb_( mb ), nb_( nb ), rank_( 0 )
+    {
+        resize( rank );
+    }
+
+    int64_t mb() const { return mb_; }
+    int64_t nb() const { return nb_; }
+    int64_t rank() const { return rank_; }
+
+    /// Sets the rank, keeping the leading columns of U and V.
+    void resize( int64_t rank )
+    {
+        rank_ = rank;
+        U_.resize( mb_ * rank );
+        V_.resize( nb_ * rank );
+    }
+
+    scalar_t*       U()       { return U_.data(); }
+    scalar_t const* U() const { return U_.data(); }
+    scalar_t*       V()       { return V_.data(); }
+    scalar_t const* V() const { return V_.data(); }
+
+    /// @return leading dimension of U.
+    int64_t ldu() const { return mb_; }
+
+    /// @return leading dimension of V.
+    int64_t ldv() const { return nb_; }
+
+private:
+    int64_t mb_, nb_, rank_;
+    std::vector<scalar_t> U_;
+    std::vector<scalar_t> V_;
+};
+
+//------------------------------------------------------------------------------
+/// Hermitian tile-low-rank (TLR) matrix, for data-sparse problems such as
+/// covariance or boundary-element matrices, whose off-diagonal tiles have
+/// numerical rank well below nb. The lower triangle is stored: diagonal
+/// tiles dense, and off-diagonal tiles as LowRankTile, truncated at
+/// singular values <= tolerance(). Memory is O(n nb + n^2 k / nb) for
+/// ranks k, instead of O(n^2).
+///
+/// Created by tlr::compress from a HermitianMatrix; factored by
+/// tlr::potrf, applied by tlr::hemm, and solved with tlr::trsm and
+/// tlr::potrs. Tiles are held on the host of the calling process, so the
+/// source matrix must have all its tiles there, e.g., on one MPI rank.
+///
+template <typename scalar_t>
+class TileLowRankMatrix {
+public:
+    using real_t = blas::real_type<scalar_t>;
+
+    TileLowRankMatrix() = default;
+
+    /// Creates a matrix of zero tiles.
+    /// @param[in] tile_nb: size of each block row and column.
+    /// @param[in] tol: absolute truncation tolerance for each tile.
+    TileLowRankMatrix( std::vector<int64_t> const& tile_nb, real_t tol )
+        : tile_nb_( tile_nb ),
+          tol_( tol )
+    {
+        int64_t nt = tile_nb_.size();
+        diag_.resize( nt );
+        for (int64_t j = 0; j < nt; ++j) {
+            diag_[ j ].resize( tile_nb_[ j ] * tile_nb_[ j ] );
+            for (int64_t i = j+1; i < nt; ++i)
+                offdiag_.emplace_back( tile_nb_[ i ], tile_nb_[ j ] );
+        }
+    }
+
+    /// @return number of rows and columns.
+    int64_t n() const
+    {
+        int64_t sum = 0;
+        for (auto nb : tile_nb_)
+            sum += nb;
+        return sum;
+    }
+
+    /// @return number of block rows and columns.
+    int64_t nt() const { return tile_nb_.size(); }
+
+    /// @return size of block row and column j.
+    int64_t tileNb( int64_t j ) const { return tile_nb_[ j ]; }
+
+    /// @return absolute truncation tolerance for each tile.
+    real_t tolerance() const { return tol_; }
+
+    /// @return dense diagonal tile {j, j}, of which the lower triangle is
+    /// used.
+    Tile<scalar_t> diag( int64_t j )
+    {
+        int64_t nb = tile_nb_[ j ];
+        return Tile<scalar_t>( nb, nb, diag_[ j ].data(), nb, HostNum,
+                               TileKind::UserOwned, Layout::ColMajor,
+                               MOSI::Shared );
+    }
+
+    /// @return low-rank tile {i, j}, for i > j.
+    LowRankTile<scalar_t>& offdiag( int64_t i, int64_t j )
+    {
+        assert( 0 <= j && j < i && i < nt() );
+        return offdiag_[ j*nt() - j*(j+1)/2 + (i - j - 1) ];
+    }
+
+    /// @return maximum rank of the off-diagonal tiles.
+    int64_t maxRank() const
+    {
+        int64_t max_rank = 0;
+        for (auto& T : offdiag_)
+            max_rank = std::max( max_rank, T.rank() );
+        return max_rank;
+    }
+
+    /// @return number of elements stored, to compare with n^2/2 dense.
+    int64_t storedElements() const
+    {
+        int64_t count = 0;
+        for (auto& D : diag_)
+            count += D.size();
+        for (auto& T : offdiag_)
+            count += (T.mb() + T.nb()) * T.rank();
+        return count;
+    }
+
+private:
+    std::vector<int64_t> tile_nb_;
+    real_t tol_ = 0;
+    std::vector< std::vector<scalar_t> > diag_;
+    std::vector< LowRankTile<scalar_t> > offdiag_;  ///< column-wise, i > j
+};
+
+//------------------------------------------------------------------------------
+/// Tile-low-rank routines, run with OpenMP tasks on the host.
+namespace tlr {
+
+template <typename scalar_t>
+TileLowRankMatrix<scalar_t> compress(
+    HermitianMatrix<scalar_t>& A,
+    blas::real_type<scalar_t> tol,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+int64_t potrf(
+    TileLowRankMatrix<scalar_t>& A,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void trsm(
+    Op op,
+    TileLowRankMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void potrs(
+    TileLowRankMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+void hemm(
+    scalar_t alpha, TileLowRankMatrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts = Options());
+
+} // namespace tlr
+
+} // namespace slate
+
+#endif // SLATE_TILE_LOW_RANK_MATRIX_HH
@@ -18,6 +18,106 @@ class Tile;
 
 namespace tile {
 
+//------------------------------------------------------------------------------
+/// Block size of the cache-blocked host transposes, so a block of the
+/// source and one of the destination fit together in L1 cache.
+const int64_t transpose_nb = 32;
+
+//------------------------------------------------------------------------------
+/// @return conj( x ) if is_conj, else x.
+template <bool is_conj, typename scalar_t>
+inline scalar_t conj_if( scalar_t x )
+{
+    return is_conj ? blas::conj( x ) : x;
+}
+
+//------------------------------------------------------------------------------
+/// Copies an m-by-n matrix, $B = A$, or $B = conj(A)$ if is_conj,
+/// converting precision. Entry (i, j) of A is at
+/// A[ i*a_col_inc + j*a_row_inc ], likewise for B, so either can be stored
+/// transposed. Host implementation.
+///
+/// The loop over the unit-stride index is innermost, for the compiler to
+/// vectorize. If A and B have unit stride along different dimensions, the
+/// copy is a transpose; it is done in transpose_nb blocks that stay in
+/// cache, so both matrices are read and written in whole cache lines.
+///
+template <bool is_conj, typename src_scalar_t, typename dst_scalar_t>
+void copy_strided(
+    int64_t m, int64_t n,
+    src_scalar_t const* A, int64_t a_col_inc, int64_t a_row_inc,
+    dst_scalar_t*       B, int64_t b_col_inc, int64_t b_row_inc)
+{
+    if (a_col_inc == 1 && b_col_inc == 1) {
+        // Both column major.
+        for (int64_t j = 0; j < n; ++j) {
+            src_scalar_t const* Aj = &A[ j*a_row_inc ];
+            dst_scalar_t* Bj = &B[ j*b_row_inc ];
+            #pragma omp simd
+            for (int64_t i = 0; i < m; ++i)
+                Bj[ i ] = dst_scalar_t( conj_if<is_conj>( Aj[ i ] ) );
+        }
+    }
+    else if (a_row_inc == 1 && b_row_inc == 1) {
+        // Both row major.
+        for (int64_t i = 0; i < m; ++i) {
+            src_scalar_t const* Ai = &A[ i*a_col_inc ];
+            dst_scalar_t* Bi = &B[ i*b_col_inc ];
+            #pragma omp simd
+            for (int64_t j = 0; j < n; ++j)
+                Bi[ j ] = dst_scalar_t( conj_if<is_conj>( Ai[ j ] ) );
+        }
+    }
+    else {
+        // Transpose, in blocks; write B along its unit stride.
+        for (int64_t jj = 0; jj < n; jj += transpose_nb) {
+            int64_t jb = std::min( transpose_nb, n - jj );
+            for (int64_t ii = 0; ii < m; ii += transpose_nb) {
+                int64_t ib = std::min( transpose_nb, m - ii );
+                src_scalar_t const* Ab = &A[ ii*a_col_inc + jj*a_row_inc ];
+                dst_scalar_t* Bb = &B[ ii*b_col_inc + jj*b_row_inc ];
+                if (b_col_inc == 1) {
+                    for (int64_t j = 0; j < jb; ++j) {
+                        #pragma omp simd
+                        for (int64_t i = 0; i < ib; ++i) {
+                            Bb[ i + j*b_row_inc ] = dst_scalar_t(
+                                conj_if<is_conj>( Ab[ i*a_col_inc + j*a_row_inc ] ) );
+                        }
+                    }
+                }
+                else {
+                    for (int64_t i = 0; i < ib; ++i) {
+                        #pragma omp simd
+                        for (int64_t j = 0; j < jb; ++j) {
+                            Bb[ i*b_col_inc + j*b_row_inc ] = dst_scalar_t(
+                                conj_if<is_conj>( Ab[ i*a_col_inc + j*a_row_inc ] ) );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Runtime is_conj version of copy_strided.
+template <typename src_scalar_t, typename dst_scalar_t>
+void copy_strided(
+    int64_t m, int64_t n, bool is_conj,
+    src_scalar_t const* A, int64_t a_col_inc, int64_t a_row_inc,
+    dst_scalar_t*       B, int64_t b_col_inc, int64_t b_row_inc)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    if (is_conj)
+        copy_strided<true>( m, n, A, a_col_inc, a_row_inc,
+                                  B, b_col_inc, b_row_inc );
+    else
+        copy_strided<false>( m, n, A, a_col_inc, a_row_inc,
+                                   B, b_col_inc, b_row_inc );
+}
+
 //------------------------------------------------------------------------------
 /// Copy and precision conversion.
 /// @ingroup copy_tile
@@ -26,7 +126,6 @@ template <typename src_scalar_t, typename dst_scalar_t>
 void gecopy(Tile<src_scalar_t> const& A, Tile<dst_scalar_t>& B)
 {
 //  trace::Block trace_block("aux::copy");
-    using blas::conj;
 
     assert(A.mb() == B.mb());
     assert(A.nb() == B.nb());
@@ -34,38 +133,13 @@ void gecopy(Tile<src_scalar_t> const& A, Tile<dst_scalar_t>& B)
     if (A.mb() == 0 || A.nb() == 0)
         return;
 
-    const src_scalar_t* A00 = &A.at(0, 0);
-    int64_t a_col_inc = A.colIncrement();
-    int64_t a_row_inc = A.rowIncrement();
-    dst_scalar_t* B00 = &B.at(0, 0);
-    int64_t b_col_inc = B.colIncrement();
-    int64_t b_row_inc = B.rowIncrement();
-
     bool A_is_conj = A.op() == Op::ConjTrans;
     bool B_is_conj = B.op() == Op::ConjTrans;
 
-    if (A_is_conj != B_is_conj) {
-        // (A is conj) xor (B is conj)
-        for (int64_t j = 0; j < B.nb(); ++j) {
-            const src_scalar_t* Aj = &A00[j*a_row_inc];
-            dst_scalar_t* Bj = &B00[j*b_row_inc];
-
-            for (int64_t i = 0; i < B.mb(); ++i) {
-                Bj[i*b_col_inc] = conj( Aj[i*a_col_inc] );
-            }
-        }
-    }
-    else {
-        for (int64_t j = 0; j < B.nb(); ++j) {
-            const src_scalar_t* Aj = &A00[j*a_row_inc];
-            dst_scalar_t* Bj = &B00[j*b_row_inc];
-
-            for (int64_t i = 0; i < B.mb(); ++i) {
-                Bj[i*b_col_inc] = Aj[i*a_col_inc];
-            }
-        }
-    }
-
+    // (A is conj) xor (B is conj)
+    copy_strided( B.mb(), B.nb(), A_is_conj != B_is_conj,
+                  &A.at(0, 0), A.colIncrement(), A.rowIncrement(),
+                  &B.at(0, 0), B.colIncrement(), B.rowIncrement() );
 }
 
 //-----------------------------------------
@@ -97,28 +171,38 @@ void tzcopy(Tile<src_scalar_t> const& A, Tile<dst_scalar_t>& B)
     assert(A.mb() == B.mb());
     assert(A.nb() == B.nb());
 
+    // Quick return
+    if (A.mb() == 0 || A.nb() == 0)
+        return;
+
     const src_scalar_t* A00 = &A.at(0, 0);
     int64_t a_col_inc = A.colIncrement();
     int64_t a_row_inc = A.rowIncrement();
     dst_scalar_t* B00 = &B.at(0, 0);
     int64_t b_col_inc = B.colIncrement();
     int64_t b_row_inc = B.rowIncrement();
-
-    for (int64_t j = 0; j < B.nb(); ++j) {
-        const src_scalar_t* Aj = &A00[j*a_row_inc];
-        dst_scalar_t* Bj = &B00[j*b_row_inc];
-        if (j < B.mb()) {
-            Bj[j*b_col_inc] = Aj[j*a_col_inc];
-        }
-        if (B.uplo() == Uplo::Lower) {
-            for (int64_t i = j; i < B.mb(); ++i) {
-                Bj[i*b_col_inc] = Aj[i*a_col_inc];
-            }
+    int64_t mb = B.mb();
+    int64_t nb = B.nb();
+    bool lower = B.uplo() == Uplo::Lower;
+
+    // Copy the part of each column, or row, in the triangle, along B's
+    // unit stride, including the diagonal.
+    if (b_col_inc == 1) {
+        for (int64_t j = 0; j < nb; ++j) {
+            int64_t i1 = lower ? std::min( j, mb ) : 0;
+            int64_t i2 = lower ? mb : std::min( j+1, mb );
+            copy_strided( i2 - i1, 1, false,
+                          &A00[ i1*a_col_inc + j*a_row_inc ], a_col_inc, a_row_inc,
+                          &B00[ i1*b_col_inc + j*b_row_inc ], b_col_inc, b_row_inc );
         }
-        else {
-            for (int64_t i = 0; i <= j && i < B.mb(); ++i) {
-                Bj[i*b_col_inc] = Aj[i*a_col_inc];
-            }
+    }
+    else {
+        for (int64_t i = 0; i < mb; ++i) {
+            int64_t j1 = lower ? 0 : std::min( i, nb );
+            int64_t j2 = lower ? std::min( i+1, nb ) : nb;
+            copy_strided( 1, j2 - j1, false,
+                          &A00[ i*a_col_inc + j1*a_row_inc ], a_col_inc, a_row_inc,
+                          &B00[ i*b_col_inc + j1*b_row_inc ], b_col_inc, b_row_inc );
         }
     }
 }
@@ -195,9 +279,17 @@ void transpose(int64_t n,
                scalar_t* A, int64_t lda)
 {
     assert(lda >= n);
-    for (int64_t j = 0; j < n; ++j) {
-        for (int64_t i = 0; i < j; ++i) { // upper
-            std::swap(A[i + j*lda], A[j + i*lda]);
+    // Swap blocks (ii, jj) and (jj, ii) of the upper triangle, in cache
+    // blocks.
+    for (int64_t jj = 0; jj < n; jj += transpose_nb) {
+        int64_t j2 = std::min( jj + transpose_nb, n );
+        for (int64_t ii = 0; ii <= jj; ii += transpose_nb) {
+            int64_t i2 = std::min( ii + transpose_nb, n );
+            for (int64_t j = jj; j < j2; ++j) {
+                for (int64_t i = ii; i < i2 && i < j; ++i) { // upper
+                    std::swap(A[i + j*lda], A[j + i*lda]);
+                }
+            }
         }
     }
 }
@@ -232,11 +324,8 @@ void transpose(int64_t m, int64_t n,
 {
     assert(lda >= m);
     assert(ldat >= n);
-    for (int64_t j = 0; j < n; ++j) {
-        for (int64_t i = 0; i < m; ++i) {
-            AT[j + i*ldat] = A[i + j*lda];
-        }
-    }
+    // AT(j, i) = A(i, j), in cache blocks.
+    copy_strided( m, n, false, A, 1, lda, AT, ldat, 1 );
 }
 
 //------------------------------------------------------------------------------
@@ -259,14 +348,23 @@ void conjTranspose(int64_t n,
 {
     using blas::conj;
     assert(lda >= n);
-    for (int64_t j = 0; j < n; ++j) {
-        for (int64_t i = 0; i < j; ++i) { // upper
-            scalar_t tmp = A[i + j*lda];
-            A[i + j*lda] = conj(A[j + i*lda]);
-            A[j + i*lda] = conj(tmp);
+    // Swap blocks (ii, jj) and (jj, ii) of the upper triangle, in cache
+    // blocks.
+    for (int64_t jj = 0; jj < n; jj += transpose_nb) {
+        int64_t j2 = std::min( jj + transpose_nb, n );
+        for (int64_t ii = 0; ii <= jj; ii += transpose_nb) {
+            int64_t i2 = std::min( ii + transpose_nb, n );
+            for (int64_t j = jj; j < j2; ++j) {
+                for (int64_t i = ii; i < i2 && i < j; ++i) { // upper
+                    scalar_t tmp = A[i + j*lda];
+                    A[i + j*lda] = conj(A[j + i*lda]);
+                    A[j + i*lda] = conj(tmp);
+                }
+            }
         }
-        A[j + j*lda] = conj(A[j + j*lda]); // diag
     }
+    for (int64_t j = 0; j < n; ++j)
+        A[j + j*lda] = conj(A[j + j*lda]); // diag
 }
 
 //------------------------------------------------------------------------------
@@ -297,14 +395,10 @@ void conjTranspose(int64_t m, int64_t n,
                    scalar_t* A, int64_t lda,
                    scalar_t* AT, int64_t ldat)
 {
-    using blas::conj;
     assert(lda >= m);
     assert(ldat >= n);
-    for (int64_t j = 0; j < n; ++j) {
-        for (int64_t i = 0; i < m; ++i) {
-            AT[j + i*ldat] = conj(A[i + j*lda]);
-        }
-    }
+    // AT(j, i) = conj( A(i, j) ), in cache blocks.
+    copy_strided( m, n, true, A, 1, lda, AT, ldat, 1 );
 }
 
 //------------------------------------------------------------------------------
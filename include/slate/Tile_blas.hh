@@ -11,6 +11,8 @@
 #include "slate/Tile.hh"
 #include "slate/internal/util.hh"
 #include "slate/internal/device.hh"
+#include "slate/internal/Tile_blas_micro.hh"
+#include "slate/internal/Tile_gemm3m.hh"
 
 #include <list>
 
@@ -18,12 +20,69 @@ namespace slate {
 
 namespace tile {
 
+//------------------------------------------------------------------------------
+/// Finds the op that applies a tile's data in another layout.
+/// A tile stored in the other layout holds the transpose, so NoTrans and
+/// Trans swap; ConjTrans becomes NoTrans only in the real case, since in
+/// the complex case it would need conj without transpose.
+///
+/// @param[in] op
+///     op of the tile.
+///
+/// @param[in] tile_layout
+///     Layout the tile's data is stored in.
+///
+/// @param[in] layout
+///     Layout the BLAS call is made in.
+///
+/// @param[in] is_complex
+///     Whether the tile is complex.
+///
+/// @param[out] op_layout
+///     On exit, if possible, the op to use in layout.
+///
+/// @return true if the tile can be used in layout without conversion.
+///
+inline bool op_in_layout(
+    Op op, Layout tile_layout, Layout layout, bool is_complex,
+    Op* op_layout)
+{
+    if (tile_layout == layout) {
+        *op_layout = op;
+        return true;
+    }
+    if (op == Op::NoTrans) {
+        *op_layout = Op::Trans;
+        return true;
+    }
+    if (op == Op::Trans || ! is_complex) {
+        *op_layout = Op::NoTrans;
+        return true;
+    }
+    return false;
+}
+
+//-----------------------------------------
+/// @copydoc op_in_layout
+/// Takes the op and layout from tile A.
+/// @ingroup gemm_tile
+///
+template <typename scalar_t>
+bool op_in_layout(
+    Tile<scalar_t> const& A, Layout layout, Op* op_layout)
+{
+    return op_in_layout( A.op(), A.layout(), layout, A.is_complex,
+                         op_layout );
+}
+
 //------------------------------------------------------------------------------
 /// General matrix multiply: $op(C) = \alpha op(A) op(B) + \beta C$.
 /// Use transpose() or conj_transpose() to set $op(A)$, $op(B)$, and $op(C)$.
 /// In the complex case,
 /// if $op(C)$ is transpose, then $op(A)$ and $op(B)$ cannot be conj_transpose;
 /// if $op(C)$ is conj_transpose, then $op(A)$ and $op(B)$ cannot be transpose.
+/// A and B may be in either layout; one in the other layout than C is
+/// used in place via op_in_layout(), except a complex conj_transpose tile.
 /// @ingroup gemm_tile
 ///
 template <typename scalar_t>
@@ -42,17 +101,29 @@ void gemm(
     slate_assert(C.mb() == A.mb());  // m
     slate_assert(C.nb() == B.nb());  // n
     slate_assert(A.nb() == B.mb());  // k
-    slate_assert(A.layout() == C.layout());
-    slate_assert(B.layout() == C.layout());
+
+    // ops of A and B relative to C's layout
+    Op opA_layout, opB_layout;
+    slate_assert(op_in_layout( A, C.layout(), &opA_layout ));
+    slate_assert(op_in_layout( B, C.layout(), &opB_layout ));
 
     if (C.op() == Op::NoTrans) {
         // C = opA(A) opB(B) + C
-        blas::gemm(C.layout(),
-                   A.op(), B.op(),
+        if (use_gemm3m<scalar_t>( C.mb(), C.nb(), A.nb() )) {
+            gemm3m(C.layout(),
+                   opA_layout, opB_layout,
                    C.mb(), C.nb(), A.nb(),
                    alpha, A.data(), A.stride(),
                           B.data(), B.stride(),
                    beta,  C.data(), C.stride());
+            return;
+        }
+        micro::gemm(C.layout(),
+                    opA_layout, opB_layout,
+                    C.mb(), C.nb(), A.nb(),
+                    alpha, A.data(), A.stride(),
+                           B.data(), B.stride(),
+                    beta,  C.data(), C.stride());
     }
     else {
         // opC is Trans or ConjTrans
@@ -60,9 +131,9 @@ void gemm(
         // C = opC(opA(A) opB(B)) + C = opC(opB(B)) opC(opA(A)) + C
         // invert opA, opB if possible; swap A <=> B; swap m <=> n
         Op opA;
-        if (A.op() == Op::NoTrans)
+        if (opA_layout == Op::NoTrans)
             opA = C.op();
-        else if (A.op() == C.op() || C.is_real) {
+        else if (opA_layout == C.op() || C.is_real) {
             // A and C are both Trans or both ConjTrans;
             // Trans == ConjTrans if real
             opA = Op::NoTrans;
@@ -71,9 +142,9 @@ void gemm(
             throw std::exception();
 
         Op opB;
-        if (B.op() == Op::NoTrans)
+        if (opB_layout == Op::NoTrans)
             opB = C.op();
-        else if (B.op() == C.op() || C.is_real) {
+        else if (opB_layout == C.op() || C.is_real) {
             // B and C are both Trans or both ConjTrans;
             // Trans == ConjTrans if real
             opB = Op::NoTrans;
@@ -86,12 +157,21 @@ void gemm(
             beta  = conj(beta);
         }
 
-        blas::gemm(C.layout(),
+        if (use_gemm3m<scalar_t>( C.nb(), C.mb(), A.nb() )) {
+            gemm3m(C.layout(),
                    opB, opA,
                    C.nb(), C.mb(), A.nb(),
                    alpha, B.data(), B.stride(),
                           A.data(), A.stride(),
                    beta,  C.data(), C.stride());
+            return;
+        }
+        micro::gemm(C.layout(),
+                    opB, opA,
+                    C.nb(), C.mb(), A.nb(),
+                    alpha, B.data(), B.stride(),
+                           A.data(), A.stride(),
+                    beta,  C.data(), C.stride());
     }
 }
 
@@ -266,6 +346,7 @@ void hemm(
 /// Hermitian rank-k update: $C = \alpha op(A) op(A)^H + \beta C$.
 /// Use conj_transpose to set $op(A)$.
 /// In the complex case, C cannot be transpose.
+/// A may be in the other layout than C only in the real case.
 /// @ingroup herk_tile
 ///
 // Allowing C^T would require two conjugations: conj( conj(C) + A*A^H ).
@@ -282,11 +363,17 @@ void herk(
     if (C.is_complex && C.op() == Op::Trans)
         throw std::exception();
 
-    blas::herk(blas::Layout::ColMajor,
-               C.uploPhysical(), A.op(),
-               C.nb(), A.nb(),
-               alpha, A.data(), A.stride(),
-               beta,  C.data(), C.stride());
+    // In the complex case, herk takes only NoTrans or ConjTrans.
+    Op opA;
+    if (! op_in_layout( A, C.layout(), &opA )
+        || (A.is_complex && opA == Op::Trans))
+        throw std::exception();
+
+    micro::herk(C.layout(),
+                C.uploPhysical(), opA,
+                C.nb(), A.nb(),
+                alpha, A.data(), A.stride(),
+                beta,  C.data(), C.stride());
 }
 
 //-----------------------------------------
@@ -676,6 +763,7 @@ void trmm(
 /// In the complex case,
 /// if $op(B)$ is transpose, then $op(A)$ cannot be conj_transpose;
 /// if $op(B)$ is conj_transpose, then $op(A)$ cannot be transpose.
+/// A may be in the other layout than B, except a complex conj_transpose A.
 /// @ingroup trsm_tile
 ///
 template <typename scalar_t>
@@ -692,23 +780,33 @@ void trsm(
     assert(A.mb() == A.nb());  // square
     assert(side == Side::Left ? A.mb() == B.mb()    // m
                               : A.mb() == B.nb());  // n
+
+    // op and uplo of A relative to B's layout
+    Op opA_layout;
+    if (! op_in_layout( A, B.layout(), &opA_layout ))
+        throw std::exception();
+    Uplo uploA = A.uploPhysical();
+    if (A.layout() != B.layout())
+        uploA = (uploA == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+
     if (B.op() == Op::NoTrans) {
-        blas::trsm(blas::Layout::ColMajor,
-                   side, A.uploPhysical(), A.op(), diag,
-                   B.mb(), B.nb(),
-                   alpha, A.data(), A.stride(),
-                          B.data(), B.stride());
+        micro::trsm(B.layout(),
+                    side, uploA, opA_layout, diag,
+                    B.mb(), B.nb(),
+                    alpha, A.data(), A.stride(),
+                           B.data(), B.stride());
     }
     else {
-        if (A.is_complex && A.op() != Op::NoTrans && A.op() != B.op())
+        if (A.is_complex && opA_layout != Op::NoTrans
+            && opA_layout != B.op())
             throw std::exception();
 
         // switch op(A) <=> op(B), side left <=> right, m <=> n
         Side side2 = (side == Side::Left ? Side::Right : Side::Left);
         Op opA;
-        if (A.op() == Op::NoTrans)
+        if (opA_layout == Op::NoTrans)
             opA = B.op();
-        else if (A.op() == B.op() || A.is_real) {
+        else if (opA_layout == B.op() || A.is_real) {
             // A and B are both Trans or both ConjTrans;
             // Trans == ConjTrans if real
             opA = Op::NoTrans;
@@ -719,11 +817,11 @@ void trsm(
         if (B.op() == Op::ConjTrans)
             alpha = conj(alpha);
 
-        blas::trsm(blas::Layout::ColMajor,
-                   side2, A.uploPhysical(), opA, diag,
-                   B.nb(), B.mb(),
-                   alpha, A.data(), A.stride(),
-                          B.data(), B.stride());
+        micro::trsm(B.layout(),
+                    side2, uploA, opA, diag,
+                    B.nb(), B.mb(),
+                    alpha, A.data(), A.stride(),
+                           B.data(), B.stride());
     }
 }
 
@@ -0,0 +1,160 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TIMER_CONTEXT_HH
+#define SLATE_TIMER_CONTEXT_HH
+
+#include "slate/types.hh"
+#include "slate/internal/mpi.hh"
+
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace slate {
+
+/// Map of timers, in seconds, for top-level routines. For example:
+/// `timers[ "gels" ]` is time for gels,
+/// `timers[ "gels::geqrf" ]` is time for geqrf inside gels.
+/// Drivers fill it only if no TimerContext is given in Option::Timers.
+/// It is shared by all threads: updates are serialized, but concurrent
+/// drivers overwrite each other's times, so they should each pass a
+/// TimerContext instead.
+extern std::map< std::string, double > timers;
+
+//------------------------------------------------------------------------------
+/// Hierarchical timers of one caller, replacing the global slate::timers.
+/// Pass it to drivers as Option::Timers.
+/// Drivers record the time of each step under its usual name,
+/// e.g., "gesv::getrf", prefixed by the names of the enclosing scopes,
+/// e.g., "solve::gesv::getrf". Each name keeps a call count and the total,
+/// min, and max time of its calls, so repeated calls accumulate instead of
+/// overwriting each other.
+///
+/// A context must be used by only one thread at a time; threads that run
+/// drivers concurrently each pass their own context.
+///
+/// Example:
+///
+///     slate::TimerContext timers;
+///     slate::Options opts = { { slate::Option::Timers, &timers } };
+///     for (int iter = 0; iter < num_iters; ++iter) {
+///         slate::TimerContext::Scope scope( &timers, "step" );
+///         slate::gesv( A, pivots, B, opts );
+///     }
+///     timers.report( MPI_COMM_WORLD );
+///
+class TimerContext {
+public:
+    /// Statistics of the calls of one timer.
+    struct Stats {
+        int64_t count = 0;
+        double total = 0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = 0;
+
+        double mean() const { return count > 0 ? total / count : 0; }
+    };
+
+    //--------------------
+    /// Times the enclosing block and nests names recorded inside it.
+    /// Does nothing if the context is null.
+    class Scope {
+    public:
+        Scope( TimerContext* context, std::string const& name );
+        ~Scope();
+
+        // Not copyable, as it pops its name on destruction.
+        Scope( Scope const& ) = delete;
+        Scope& operator=( Scope const& ) = delete;
+
+    private:
+        TimerContext* context_;
+        double start_;
+    };
+
+    void record( std::string const& name, double seconds );
+
+    /// @return statistics, by full name.
+    std::map< std::string, Stats > const& stats() const
+    {
+        return stats_;
+    }
+
+    void clear();
+
+    void report( MPI_Comm comm, FILE* file=stdout, int root=0 ) const;
+
+private:
+    std::string path( std::string const& name ) const;
+
+    //----------------------------------------
+    // Data
+
+    /// Names of the open scopes, outermost first.
+    std::vector< std::string > scopes_;
+
+    /// Statistics, by full name, sorted so all ranks traverse them in
+    /// the same order.
+    std::map< std::string, Stats > stats_;
+};
+
+namespace internal {
+
+std::mutex& timers_mutex();
+
+//------------------------------------------------------------------------------
+/// Sets timer name to seconds: records a call in Option::Timers if given,
+/// else sets slate::timers[ name ].
+inline void timers_set(
+    Options const& opts, const char* name, double seconds )
+{
+    auto context = get_option<TimerContext*>( opts, Option::Timers, nullptr );
+    if (context != nullptr) {
+        context->record( name, seconds );
+    }
+    else {
+        std::lock_guard< std::mutex > guard( timers_mutex() );
+        timers[ name ] = seconds;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Adds seconds to timer name: records a call in Option::Timers if given,
+/// else adds to slate::timers[ name ], for steps repeated in a loop.
+inline void timers_add(
+    Options const& opts, const char* name, double seconds )
+{
+    auto context = get_option<TimerContext*>( opts, Option::Timers, nullptr );
+    if (context != nullptr) {
+        context->record( name, seconds );
+    }
+    else {
+        std::lock_guard< std::mutex > guard( timers_mutex() );
+        timers[ name ] += seconds;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Resets slate::timers[ name ] before a loop of timers_add.
+/// Does nothing with Option::Timers, which counts calls instead.
+inline void timers_reset(
+    Options const& opts, const char* name )
+{
+    auto context = get_option<TimerContext*>( opts, Option::Timers, nullptr );
+    if (context == nullptr) {
+        std::lock_guard< std::mutex > guard( timers_mutex() );
+        timers[ name ] = 0;
+    }
+}
+
+} // namespace internal
+
+} // namespace slate
+
+#endif // SLATE_TIMER_CONTEXT_HH
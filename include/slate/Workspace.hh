@@ -0,0 +1,175 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_WORKSPACE_HH
+#define SLATE_WORKSPACE_HH
+
+#include "slate/internal/CommPlan.hh"
+#include "slate/internal/Memory.hh"
+#include "slate/internal/NodeSharedPool.hh"
+
+#include "lapack.hh"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace slate {
+
+template <typename scalar_t>
+class MatrixStorage;
+
+//------------------------------------------------------------------------------
+/// Memory a driver predicts it needs on this rank, returned by its
+/// workspace query, e.g., getrf_workspace_size(), as LAPACK's lwork = -1
+/// query. Workspace::reserve preallocates it in an arena, so the driver
+/// doesn't grow memory pools or batch arrays during the run.
+///
+/// Tiles and batch arrays are listed per matrix that the driver attaches
+/// to the arena, in the order it attaches them; memory the driver
+/// allocates outside the arena, e.g., scratch matrices and vectors, is
+/// only counted in the auxiliary sizes.
+///
+/// @see Workspace::reserve
+///
+struct WorkspaceSize {
+    /// Memory pool and batch arrays of one attached matrix.
+    struct Pool {
+        size_t  block_size = 0;  ///< bytes per tile, mb * nb * sizeof( scalar_t )
+        int64_t host_tiles = 0;  ///< remote tiles received on host at once
+        std::vector< int64_t > local_tiles;   ///< per device, local tiles
+        std::vector< int64_t > remote_tiles;  ///< per device, remote tiles
+        int64_t num_batch_arrays = 0;  ///< batch arrays (queues) per device
+        int64_t batch_size = 0;        ///< entries of each batch array
+    };
+
+    std::vector< Pool > pools;
+
+    /// Bytes of the scratch buffer on each device (Workspace::deviceBuffer).
+    size_t device_buffer_size = 0;
+
+    /// Bytes allocated outside the arena, on host and on each device.
+    size_t host_aux_size = 0;
+    size_t device_aux_size = 0;
+
+    size_t hostBytes() const;
+    size_t deviceBytes( int device ) const;
+};
+
+//------------------------------------------------------------------------------
+/// Workspace arena that persists across driver calls.
+/// Pass it to drivers as Option::Workspace.
+/// While a matrix is attached to the arena during a driver, it takes its
+/// memory pool and batch arrays from the arena instead of allocating them,
+/// and at the end of the driver it returns them to the arena instead of
+/// freeing them. Drivers also take their device scratch buffers (e.g.,
+/// potrf's device info) from the arena. Once warmed up, repeated calls on
+/// same-shaped matrices allocate no host or device memory.
+///
+/// The arena also holds a communication plan (see CommPlan), so tile
+/// broadcasts and reductions of attached matrices reuse persistent MPI
+/// requests and datatypes recorded by previous calls.
+///
+/// Pools are kept per block size, so matrices with different tile sizes
+/// or precisions can share an arena.
+/// Optionally, enableNodeShared gives the arena memory shared by the ranks
+/// of each node, so hierarchical broadcasts receive a tile once per node
+/// (see Option::HierarchicalBcast).
+/// An arena must be used by only one driver at a time.
+///
+/// To allocate everything before the first call, reserve the size
+/// returned by the driver's workspace query, e.g.,
+/// workspace.reserve( slate::getrf_workspace_size( A, opts ) ).
+///
+/// Example:
+///
+///     slate::Workspace workspace;
+///     slate::Options opts = { { slate::Option::Target, target },
+///                             { slate::Option::Workspace, &workspace } };
+///     for (int iter = 0; iter < num_iters; ++iter) {
+///         slate::potrf( A, opts );
+///         slate::potrs( A, B, opts );
+///     }
+///
+class Workspace {
+public:
+    template <typename scalar_t>
+    friend class MatrixStorage;
+
+    Workspace();
+    ~Workspace();
+
+    // Not copyable, as it owns memory.
+    Workspace( Workspace const& ) = delete;
+    Workspace& operator=( Workspace const& ) = delete;
+
+    void* deviceBuffer( int device, size_t size );
+
+    void reserve( WorkspaceSize const& size );
+
+    /// @return communication plan of the arena.
+    CommPlan* commPlan()
+    {
+        return &comm_plan_;
+    }
+
+    void clear();
+
+    void enableNodeShared( MPI_Comm mpi_comm, size_t block_size,
+                           int64_t num_blocks );
+
+    /// @return pool of memory shared by the ranks of the node,
+    /// if enabled and the node has more than one rank, otherwise null.
+    NodeSharedPool* nodeSharedPool() const
+    {
+        return node_shared_ != nullptr && node_shared_->enabled()
+               ? node_shared_.get() : nullptr;
+    }
+
+private:
+    /// Batch arrays and compute queues of a matrix, for all devices,
+    /// stored type-erased since they are arrays of pointers.
+    struct BatchArrays {
+        std::vector< std::vector< void* > > host;
+        std::vector< std::vector< void* > > dev;
+        std::vector< std::vector< lapack::Queue* > > queues;
+        int64_t size = 0;
+    };
+
+    lapack::Queue* queue( int device );
+
+    void takePool( Memory& memory );
+    void returnPool( Memory& memory );
+
+    //----------------------------------------
+    // Data
+
+    /// Scratch buffer on each device, and its size in bytes.
+    std::vector< void* >  buffers_;
+    std::vector< size_t > buffer_sizes_;
+
+    /// Parked memory pools, by block size, in FIFO order.
+    std::map< size_t, std::deque< std::unique_ptr< Memory > > > pools_;
+    /// Empty memory pools, kept for reuse.
+    std::map< size_t, std::vector< std::unique_ptr< Memory > > > spare_pools_;
+
+    /// Parked batch arrays, in FIFO order, and batch arrays of attached
+    /// matrices, to give back to them when they are detached.
+    std::deque< BatchArrays > batch_arrays_;
+    std::vector< BatchArrays > spare_batch_arrays_;
+
+    /// Persistent MPI requests and datatypes, and number of attached
+    /// matrices; a new epoch of the plan starts with the first attach.
+    CommPlan comm_plan_;
+    int num_attached_ = 0;
+
+    /// Memory shared by the ranks of the node, or null.
+    std::unique_ptr< NodeSharedPool > node_shared_;
+};
+
+} // namespace slate
+
+#endif // SLATE_WORKSPACE_HH
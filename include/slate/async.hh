@@ -0,0 +1,194 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_ASYNC_HH
+#define SLATE_ASYNC_HH
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Result of a driver call started by one of the slate::async routines.
+/// Copies refer to the same call.
+///
+template <typename T>
+class Future {
+public:
+    Future() = default;
+
+    explicit Future( std::shared_future<T> future )
+        : future_( std::move( future ) )
+    {}
+
+    /// Blocks until the call completes.
+    /// @return the driver's result; rethrows its exception, if any.
+    T wait() const { return future_.get(); }
+
+    /// @return true if the call has completed, without blocking.
+    bool test() const
+    {
+        return future_.wait_for( std::chrono::seconds( 0 ) )
+               == std::future_status::ready;
+    }
+
+    /// @return true if this refers to a call.
+    bool valid() const { return future_.valid(); }
+
+private:
+    std::shared_future<T> future_;
+};
+
+//------------------------------------------------------------------------------
+/// Non-blocking variants of the drivers, which return a Future instead of
+/// waiting for the result, so the application can compute, or call other
+/// SLATE routines, while they run.
+///
+/// Calls run one at a time, in the order they are made, on a worker thread
+/// owned by the library, with its own OpenMP thread team. As in the
+/// blocking API, all MPI ranks must make the same calls in the same order;
+/// running them in that order on every rank keeps their communication
+/// matched. A call that depends on an earlier one, e.g., potrs after potrf
+/// of the same matrix, can be made immediately, without waiting for the
+/// earlier one.
+///
+/// Matrices are shallow copied, so their storage stays alive until the
+/// call completes, but the application must not access their data, or
+/// anything else passed by reference, such as pivots, until then.
+/// Communicating on other threads while calls run requires MPI to be
+/// initialized with MPI_THREAD_MULTIPLE. Otherwise, each call runs on the
+/// calling thread before its Future is returned.
+///
+/// Call wait_all before MPI_Finalize. Calls still queued when MPI is
+/// finalized, or when the program exits, are dropped; their Future::wait
+/// throws std::future_error.
+///
+/// Example:
+///
+///     auto info = slate::async::potrf( A, opts );
+///     // ... compute something else ...
+///     slate::async::potrs( A, B, opts );
+///     if (info.wait() != 0) { ... }
+///     slate::async::wait_all();
+///
+namespace async {
+
+void submit( std::function<void ()> call );
+void wait_all();
+
+//------------------------------------------------------------------------------
+/// Queues call to run after the calls already queued.
+/// @return the future of its result.
+///
+template <typename T>
+Future<T> launch( std::function<T ()> call )
+{
+    auto task = std::make_shared< std::packaged_task<T ()> >( std::move( call ) );
+    Future<T> future( task->get_future().share() );
+    submit( [task]() { (*task)(); } );
+    return future;
+}
+
+//-----------------------------------------
+// gemm()
+template <typename scalar_t>
+Future<void> gemm(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts = Options())
+{
+    return launch<void>( [=]() mutable {
+        slate::gemm( alpha, A, B, beta, C, opts );
+    } );
+}
+
+//-----------------------------------------
+// gesv()
+template <typename scalar_t>
+Future<int64_t> gesv(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    Pivots* pivots_ptr = &pivots;
+    return launch<int64_t>( [=]() mutable {
+        return slate::gesv( A, *pivots_ptr, B, opts );
+    } );
+}
+
+//-----------------------------------------
+// getrf()
+template <typename scalar_t>
+Future<int64_t> getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Options const& opts = Options())
+{
+    Pivots* pivots_ptr = &pivots;
+    return launch<int64_t>( [=]() mutable {
+        return slate::getrf( A, *pivots_ptr, opts );
+    } );
+}
+
+//-----------------------------------------
+// getrs()
+template <typename scalar_t>
+Future<void> getrs(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    Pivots* pivots_ptr = &pivots;
+    return launch<void>( [=]() mutable {
+        slate::getrs( A, *pivots_ptr, B, opts );
+    } );
+}
+
+//-----------------------------------------
+// posv()
+template <typename scalar_t>
+Future<int64_t> posv(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    return launch<int64_t>( [=]() mutable {
+        return slate::posv( A, B, opts );
+    } );
+}
+
+//-----------------------------------------
+// potrf()
+template <typename scalar_t>
+Future<int64_t> potrf(
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts = Options())
+{
+    return launch<int64_t>( [=]() mutable {
+        return slate::potrf( A, opts );
+    } );
+}
+
+//-----------------------------------------
+// potrs()
+template <typename scalar_t>
+Future<void> potrs(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options())
+{
+    return launch<void>( [=]() mutable {
+        slate::potrs( A, B, opts );
+    } );
+}
+
+} // namespace async
+} // namespace slate
+
+#endif // SLATE_ASYNC_HH
@@ -19,6 +19,7 @@ typedef char slate_TileKind; /* enum */               ///< slate::TileKind
 const slate_TileKind slate_TileKind_Workspace  = 'w'; ///< slate::TileKind::Workspace
 const slate_TileKind slate_TileKind_SlateOwned = 'o'; ///< slate::TileKind::SlateOwned
 const slate_TileKind slate_TileKind_UserOwned  = 'u'; ///< slate::TileKind::UserOwned
+const slate_TileKind slate_TileKind_NodeShared = 'n'; ///< slate::TileKind::NodeShared
 // end slate_TileKind
 
 //------------------------------------------------------------------------------
@@ -35,8 +36,21 @@ const slate_Target slate_Target_Devices     = 'D'; ///< slate::Target::Devices
 typedef char slate_MethodEig; /* enum */        ///< slate::MethodEig
 const slate_MethodEig slate_MethodEig_QR = 'Q'; ///< slate::MethodEig::QR
 const slate_MethodEig slate_MethodEig_DC = 'D'; ///< slate::MethodEig::DC
+const slate_MethodEig slate_MethodEig_Bisection = 'B'; ///< slate::MethodEig::Bisection
+const slate_MethodEig slate_MethodEig_QDWH = 'W'; ///< slate::MethodEig::QDWH
 // end slate_MethodEig
 
+typedef char slate_MathMode; /* enum */          ///< slate::MathMode
+const slate_MathMode slate_MathMode_Default = 'D'; ///< slate::MathMode::Default
+const slate_MathMode slate_MathMode_TF32    = 'T'; ///< slate::MathMode::TF32
+// end slate_MathMode
+
+typedef char slate_TournamentTree; /* enum */               ///< slate::TournamentTree
+const slate_TournamentTree slate_TournamentTree_Binary = 'B'; ///< slate::TournamentTree::Binary
+const slate_TournamentTree slate_TournamentTree_Flat   = 'F'; ///< slate::TournamentTree::Flat
+const slate_TournamentTree slate_TournamentTree_Hybrid = 'H'; ///< slate::TournamentTree::Hybrid
+// end slate_TournamentTree
+
 // todo: auto sync with include/slate/enums.hh
 typedef char slate_Option; /* enum */                      ///< slate::Option
 const slate_Option slate_Option_ChunkSize            =  0; ///< slate::Option::ChunkSize
@@ -51,6 +65,24 @@ const slate_Option slate_Option_Depth                =  8; ///< slate::Option::H
 const slate_Option slate_Option_MaxIterations        =  9; ///< slate::Option::HoldLocalWorkspace
 const slate_Option slate_Option_UseFallbackSolver    = 10; ///< slate::Option::HoldLocalWorkspace
 const slate_Option slate_Option_PivotThreshold       = 11; ///< slate::Option::PivotThreshold
+const slate_Option slate_Option_Workspace            = 12; ///< slate::Option::Workspace
+const slate_Option slate_Option_AggregateBcast       = 13; ///< slate::Option::AggregateBcast
+const slate_Option slate_Option_HierarchicalBcast    = 14; ///< slate::Option::HierarchicalBcast
+const slate_Option slate_Option_MathMode             = 15; ///< slate::Option::MathMode
+const slate_Option slate_Option_InvertDiagonal       = 16; ///< slate::Option::InvertDiagonal
+const slate_Option slate_Option_TournamentTree       = 17; ///< slate::Option::TournamentTree
+const slate_Option slate_Option_MaxLookahead         = 18; ///< slate::Option::MaxLookahead
+const slate_Option slate_Option_Pipeline             = 19; ///< slate::Option::Pipeline
+const slate_Option slate_Option_Layers               = 20; ///< slate::Option::Layers
+const slate_Option slate_Option_MaxWorkspace         = 21; ///< slate::Option::MaxWorkspace
+const slate_Option slate_Option_ColumnGroups         = 22; ///< slate::Option::ColumnGroups
+const slate_Option slate_Option_CholQRPasses         = 23; ///< slate::Option::CholQRPasses
+const slate_Option slate_Option_NormEstVectors       = 24; ///< slate::Option::NormEstVectors
+const slate_Option slate_Option_MixedLowMemory       = 25; ///< slate::Option::MixedLowMemory
+const slate_Option slate_Option_Rank                 = 26; ///< slate::Option::Rank
+const slate_Option slate_Option_Oversampling         = 27; ///< slate::Option::Oversampling
+const slate_Option slate_Option_PowerIterations      = 28; ///< slate::Option::PowerIterations
+const slate_Option slate_Option_Timers               = 29; ///< slate::Option::Timers
 const slate_Option slate_Option_PrintVerbose         = 50; ///< slate::Option::PrintVerbose
 const slate_Option slate_Option_PrintEdgeItems       = 51; ///< slate::Option::PrintEdgeItems
 const slate_Option slate_Option_PrintWidth           = 52; ///< slate::Option::PrintWidth
@@ -62,6 +94,8 @@ const slate_Option slate_Option_MethodGemm           = 63; ///< slate::Option::M
 const slate_Option slate_Option_MethodHemm           = 64; ///< slate::Option::MethodHemm
 const slate_Option slate_Option_MethodLU             = 65; ///< slate::Option::MethodLU
 const slate_Option slate_Option_MethodTrsm           = 66; ///< slate::Option::MethodTrsm
+const slate_Option slate_Option_MethodCholesky       = 67; ///< slate::Option::MethodCholesky
+const slate_Option slate_Option_MethodMatFunc        = 68; ///< slate::Option::MethodMatFunc
 // end slate_Option
 
 typedef short slate_MOSI_State;
@@ -6,11 +6,22 @@
 #ifndef SLATE_CONFIG_HH
 #define SLATE_CONFIG_HH
 
+#include <stdint.h>
 #include <string.h>
 #include <stdlib.h>
 
+#include <vector>
+
 namespace slate {
 
+namespace internal {
+
+bool query_gpu_aware_mpi();
+
+std::vector<int> parse_core_list( const char* str );
+
+} // namespace internal
+
 //------------------------------------------------------------------------------
 /// Query whether MPI is GPU-aware.
 class GPU_Aware_MPI
@@ -37,13 +48,18 @@ private:
         return singleton;
     }
 
-    /// Constructor checks $SLATE_GPU_AWARE_MPI.
+    /// Constructor checks $SLATE_GPU_AWARE_MPI; if it is not set,
+    /// asks the MPI library.
     GPU_Aware_MPI()
     {
         const char* env = getenv( "SLATE_GPU_AWARE_MPI" );
-        gpu_aware_mpi_ = env != nullptr
-                         && (strcmp( env, "" ) == 0
-                             || strcmp( env, "1" ) == 0);
+        if (env != nullptr) {
+            gpu_aware_mpi_ = strcmp( env, "" ) == 0
+                             || strcmp( env, "1" ) == 0;
+        }
+        else {
+            gpu_aware_mpi_ = internal::query_gpu_aware_mpi();
+        }
     }
 
     //----------------------------------------
@@ -56,10 +72,16 @@ private:
 //------------------------------------------------------------------------------
 /// @return true if MPI is GPU-aware.
 /// Initially checks if environment variable $SLATE_GPU_AWARE_MPI is set
-/// and either empty or 1. Can be overriden by gpu_aware_mpi( bool ).
-/// In the future, could also check
-/// `MPIX_GPU_query_support` (MPICH) or
-/// `MPIX_Query_cuda_support` (Open MPI).
+/// and either empty or 1; any other value disables it. If it is not set,
+/// queries the MPI library, via `MPIX_Query_cuda_support` or
+/// `MPIX_Query_rocm_support` (Open MPI), `MPIX_GPU_query_support` (MPICH),
+/// or $MPICH_GPU_SUPPORT_ENABLED (Cray MPICH); see
+/// internal::query_gpu_aware_mpi(). The first call should be after MPI_Init.
+/// Can be overriden by gpu_aware_mpi( bool ).
+///
+/// When true, tiles are sent directly from device memory, and with
+/// Target::Devices, received tiles land directly in device memory,
+/// leaving the host copy Invalid.
 inline bool gpu_aware_mpi()
 {
     return GPU_Aware_MPI::value();
@@ -73,6 +95,1247 @@ inline void gpu_aware_mpi( bool value )
     return GPU_Aware_MPI::value( value );
 }
 
+//------------------------------------------------------------------------------
+/// Query whether device workspace uses stream-ordered allocation.
+class GPU_Async_Alloc
+{
+public:
+    /// @see bool gpu_async_alloc()
+    static bool value()
+    {
+        return get().gpu_async_alloc_;
+    }
+
+    /// @see void gpu_async_alloc( bool )
+    static void value( bool val )
+    {
+        get().gpu_async_alloc_ = val;
+    }
+
+private:
+    /// @return GPU_Async_Alloc singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static GPU_Async_Alloc& get()
+    {
+        static GPU_Async_Alloc singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_GPU_ASYNC_ALLOC.
+    GPU_Async_Alloc()
+    {
+        const char* env = getenv( "SLATE_GPU_ASYNC_ALLOC" );
+        gpu_async_alloc_ = env != nullptr
+                           && (strcmp( env, "" ) == 0
+                               || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to use stream-ordered allocation.
+    bool gpu_async_alloc_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if device workspace is allocated with stream-ordered
+/// allocation (cudaMallocAsync / hipMallocAsync) from the device's memory
+/// pool, instead of device_malloc, which can synchronize the device.
+/// Initially checks if environment variable $SLATE_GPU_ASYNC_ALLOC is set
+/// and either empty or 1. Can be overriden by gpu_async_alloc( bool ).
+/// Ignored for SYCL, which lacks stream-ordered allocation.
+inline bool gpu_async_alloc()
+{
+    return GPU_Async_Alloc::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether device workspace uses stream-ordered allocation.
+/// Overrides $SLATE_GPU_ASYNC_ALLOC.
+/// @param[in] value: true to use stream-ordered allocation.
+inline void gpu_async_alloc( bool value )
+{
+    return GPU_Async_Alloc::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether peer access is enabled between devices.
+class GPU_Peer_Access
+{
+public:
+    /// @see bool gpu_peer_access()
+    static bool value()
+    {
+        return get().gpu_peer_access_;
+    }
+
+    /// @see void gpu_peer_access( bool )
+    static void value( bool val )
+    {
+        get().gpu_peer_access_ = val;
+    }
+
+private:
+    /// @return GPU_Peer_Access singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static GPU_Peer_Access& get()
+    {
+        static GPU_Peer_Access singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_GPU_PEER_ACCESS.
+    GPU_Peer_Access()
+    {
+        const char* env = getenv( "SLATE_GPU_PEER_ACCESS" );
+        gpu_peer_access_ = env == nullptr
+                           || strcmp( env, "" ) == 0
+                           || strcmp( env, "1" ) == 0;
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to enable peer access.
+    bool gpu_peer_access_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if matrices enable peer access between each pair of their
+/// devices that supports it, when they create their queues, so tile copies
+/// between those devices go directly over NVLink, xGMI, or PCIe,
+/// instead of through the host. See enable_peer_access().
+/// Initially checks environment variable $SLATE_GPU_PEER_ACCESS; enabled
+/// unless it is set to a value other than empty or 1.
+/// Can be overriden by gpu_peer_access( bool ).
+inline bool gpu_peer_access()
+{
+    return GPU_Peer_Access::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether peer access is enabled between devices.
+/// Overrides $SLATE_GPU_PEER_ACCESS. Does not disable peer access
+/// already enabled.
+/// @param[in] value: true to enable peer access.
+inline void gpu_peer_access( bool value )
+{
+    return GPU_Peer_Access::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether device routines track tile dependencies with events.
+class GPU_Events
+{
+public:
+    /// @see bool gpu_events()
+    static bool value()
+    {
+        return get().gpu_events_;
+    }
+
+    /// @see void gpu_events( bool )
+    static void value( bool val )
+    {
+        get().gpu_events_ = val;
+    }
+
+private:
+    /// @return GPU_Events singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static GPU_Events& get()
+    {
+        static GPU_Events singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_GPU_EVENTS.
+    GPU_Events()
+    {
+        const char* env = getenv( "SLATE_GPU_EVENTS" );
+        gpu_events_ = env == nullptr
+                      || strcmp( env, "" ) == 0
+                      || strcmp( env, "1" ) == 0;
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to use events.
+    bool gpu_events_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if device routines that support it, such as internal gemm,
+/// herk, trsm, and copy, record an event after enqueuing their kernels
+/// instead of synchronizing their queue; tasks that later use the tiles
+/// wait on the event, on their own queue if they support it, else on the
+/// host. See DeviceEvent.
+/// Initially checks environment variable $SLATE_GPU_EVENTS; enabled
+/// unless it is set to a value other than empty or 1.
+/// Can be overriden by gpu_events( bool ).
+inline bool gpu_events()
+{
+    return GPU_Events::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether device routines use events instead of synchronizing.
+/// Overrides $SLATE_GPU_EVENTS.
+/// @param[in] value: true to use events.
+inline void gpu_events( bool value )
+{
+    return GPU_Events::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether device routines replay captured graphs.
+class GPU_Graphs
+{
+public:
+    /// @see bool gpu_graphs()
+    static bool value()
+    {
+        return get().gpu_graphs_;
+    }
+
+    /// @see void gpu_graphs( bool )
+    static void value( bool val )
+    {
+        get().gpu_graphs_ = val;
+    }
+
+private:
+    /// @return GPU_Graphs singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static GPU_Graphs& get()
+    {
+        static GPU_Graphs singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_GPU_GRAPHS.
+    GPU_Graphs()
+    {
+        const char* env = getenv( "SLATE_GPU_GRAPHS" );
+        gpu_graphs_ = env != nullptr
+                      && (strcmp( env, "" ) == 0
+                          || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to use graphs.
+    bool gpu_graphs_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if device routines that support it capture their kernel
+/// launches on a queue into a CUDA or HIP graph, and replay the graph on
+/// later calls with identical launches, e.g., the same matrix in each
+/// iteration of a solver, to reduce launch overhead.
+/// See internal::device_graph_run().
+/// Initially checks if environment variable $SLATE_GPU_GRAPHS is set
+/// and either empty or 1. Can be overriden by gpu_graphs( bool ).
+inline bool gpu_graphs()
+{
+    return GPU_Graphs::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether device routines replay captured graphs.
+/// Overrides $SLATE_GPU_GRAPHS.
+/// @param[in] value: true to use graphs.
+inline void gpu_graphs( bool value )
+{
+    return GPU_Graphs::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether matrices use the process-wide shared memory pools.
+class Shared_Memory_Pool
+{
+public:
+    /// @see bool shared_memory_pool()
+    static bool value()
+    {
+        return get().shared_memory_pool_;
+    }
+
+    /// @see void shared_memory_pool( bool )
+    static void value( bool val )
+    {
+        get().shared_memory_pool_ = val;
+    }
+
+private:
+    /// @return Shared_Memory_Pool singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Shared_Memory_Pool& get()
+    {
+        static Shared_Memory_Pool singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_SHARED_MEMORY_POOL.
+    Shared_Memory_Pool()
+    {
+        const char* env = getenv( "SLATE_SHARED_MEMORY_POOL" );
+        shared_memory_pool_ = env != nullptr
+                              && (strcmp( env, "" ) == 0
+                                  || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to use shared memory pools.
+    bool shared_memory_pool_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if new matrices allocate tiles from the process-wide memory
+/// pool for their block size (Memory::shared), shared by all matrices with
+/// that block size, instead of from their own pool.
+/// Initially checks if environment variable $SLATE_SHARED_MEMORY_POOL is set
+/// and either empty or 1. Can be overriden by shared_memory_pool( bool ).
+/// Individual matrices can also opt in with BaseMatrix::useSharedMemory().
+inline bool shared_memory_pool()
+{
+    return Shared_Memory_Pool::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether new matrices use the process-wide shared memory pools.
+/// Overrides $SLATE_SHARED_MEMORY_POOL.
+/// @param[in] value: true to use shared memory pools.
+inline void shared_memory_pool( bool value )
+{
+    return Shared_Memory_Pool::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether host tiles are allocated with huge pages.
+class Host_Huge_Pages
+{
+public:
+    /// @see bool host_huge_pages()
+    static bool value()
+    {
+        return get().host_huge_pages_;
+    }
+
+    /// @see void host_huge_pages( bool )
+    static void value( bool val )
+    {
+        get().host_huge_pages_ = val;
+    }
+
+private:
+    /// @return Host_Huge_Pages singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Host_Huge_Pages& get()
+    {
+        static Host_Huge_Pages singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_HOST_HUGE_PAGES.
+    Host_Huge_Pages()
+    {
+        const char* env = getenv( "SLATE_HOST_HUGE_PAGES" );
+        host_huge_pages_ = env != nullptr
+                           && (strcmp( env, "" ) == 0
+                               || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to use huge pages.
+    bool host_huge_pages_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if pageable host memory blocks of at least 2 MiB are
+/// aligned to 2 MiB and marked for transparent huge pages (Linux), which
+/// reduces TLB misses when host tasks stream through tiles.
+/// Pinned host memory is not affected.
+/// Initially checks if environment variable $SLATE_HOST_HUGE_PAGES is set
+/// and either empty or 1. Can be overriden by host_huge_pages( bool ).
+inline bool host_huge_pages()
+{
+    return Host_Huge_Pages::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether host memory blocks use huge pages.
+/// Overrides $SLATE_HOST_HUGE_PAGES.
+/// @param[in] value: true to use huge pages.
+inline void host_huge_pages( bool value )
+{
+    return Host_Huge_Pages::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether host tiles are placed on NUMA nodes.
+class Host_NUMA_Placement
+{
+public:
+    /// @see bool host_numa_placement()
+    static bool value()
+    {
+        return get().host_numa_placement_;
+    }
+
+    /// @see void host_numa_placement( bool )
+    static void value( bool val )
+    {
+        get().host_numa_placement_ = val;
+    }
+
+private:
+    /// @return Host_NUMA_Placement singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Host_NUMA_Placement& get()
+    {
+        static Host_NUMA_Placement singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_HOST_NUMA_PLACEMENT.
+    Host_NUMA_Placement()
+    {
+        const char* env = getenv( "SLATE_HOST_NUMA_PLACEMENT" );
+        host_numa_placement_ = env != nullptr
+                               && (strcmp( env, "" ) == 0
+                                   || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to place host tiles on NUMA nodes.
+    bool host_numa_placement_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if each host tile's memory is bound to the NUMA node given
+/// by the matrix's tile-to-NUMA-node map, MatrixStorage::tileNumaNode,
+/// when the tile is inserted. By default, the map assigns local tile
+/// columns cyclically to NUMA nodes, as tileDevice assigns them to devices.
+/// Ignored if there is only one NUMA node, or on non-Linux systems.
+/// Initially checks if environment variable $SLATE_HOST_NUMA_PLACEMENT is
+/// set and either empty or 1. Can be overriden by host_numa_placement( bool ).
+inline bool host_numa_placement()
+{
+    return Host_NUMA_Placement::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether host tiles are placed on NUMA nodes.
+/// Overrides $SLATE_HOST_NUMA_PLACEMENT.
+/// @param[in] value: true to place host tiles on NUMA nodes.
+inline void host_numa_placement( bool value )
+{
+    return Host_NUMA_Placement::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query chunk size for pipelined tile broadcasts.
+class Bcast_Chunk_Size
+{
+public:
+    /// @see int64_t bcast_chunk_size()
+    static int64_t value()
+    {
+        return get().bcast_chunk_size_;
+    }
+
+    /// @see void bcast_chunk_size( int64_t )
+    static void value( int64_t val )
+    {
+        get().bcast_chunk_size_ = val;
+    }
+
+private:
+    /// @return Bcast_Chunk_Size singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Bcast_Chunk_Size& get()
+    {
+        static Bcast_Chunk_Size singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_BCAST_CHUNK_SIZE.
+    Bcast_Chunk_Size()
+    {
+        const char* env = getenv( "SLATE_BCAST_CHUNK_SIZE" );
+        bcast_chunk_size_ = 1024*1024;
+        if (env != nullptr && strcmp( env, "" ) != 0)
+            bcast_chunk_size_ = atoll( env );
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached chunk size in bytes; <= 0 disables pipelining.
+    int64_t bcast_chunk_size_;
+};
+
+//------------------------------------------------------------------------------
+/// @return chunk size in bytes for pipelined tile broadcasts, default 1 MiB.
+/// In the hypercube broadcast of listBcast and listBcastMT, tiles larger
+/// than this are sent in chunks of whole columns (rows if RowMajor) of
+/// about this size, and each rank forwards a chunk as soon as it arrives,
+/// instead of waiting for the whole tile. A value <= 0 disables chunking.
+/// Must be the same on all MPI ranks.
+/// Initially checks environment variable $SLATE_BCAST_CHUNK_SIZE.
+/// Can be overriden by bcast_chunk_size( int64_t ).
+inline int64_t bcast_chunk_size()
+{
+    return Bcast_Chunk_Size::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set chunk size for pipelined tile broadcasts.
+/// Overrides $SLATE_BCAST_CHUNK_SIZE.
+/// @param[in] value: chunk size in bytes; <= 0 disables chunking.
+inline void bcast_chunk_size( int64_t value )
+{
+    return Bcast_Chunk_Size::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether MPI calls are offloaded to a communication thread.
+class Comm_Thread
+{
+public:
+    /// @see bool comm_thread()
+    static bool value()
+    {
+        return get().comm_thread_;
+    }
+
+    /// @see void comm_thread( bool )
+    static void value( bool val )
+    {
+        get().comm_thread_ = val;
+    }
+
+private:
+    /// @return Comm_Thread singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Comm_Thread& get()
+    {
+        static Comm_Thread singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_COMM_THREAD.
+    Comm_Thread()
+    {
+        const char* env = getenv( "SLATE_COMM_THREAD" );
+        comm_thread_ = env != nullptr
+                       && (strcmp( env, "" ) == 0
+                           || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to use a communication thread.
+    bool comm_thread_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if MPI calls are offloaded to a communication thread,
+/// default false. If true, one thread per MPI rank makes the MPI calls
+/// of slate_mpi_call, and completes the tile messages that tasks wait on,
+/// so tasks never call MPI concurrently, and messages progress while the
+/// other threads compute. Then SLATE needs only MPI_THREAD_SERIALIZED,
+/// instead of MPI_THREAD_MULTIPLE. @see internal::comm_thread_call
+/// Initially checks environment variable $SLATE_COMM_THREAD.
+/// Can be overriden by comm_thread( bool ).
+inline bool comm_thread()
+{
+    return Comm_Thread::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether MPI calls are offloaded to a communication thread.
+/// Overrides $SLATE_COMM_THREAD. Must not be changed while messages are
+/// in flight.
+/// @param[in] value: true to use a communication thread.
+inline void comm_thread( bool value )
+{
+    return Comm_Thread::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Runtime that schedules the tasks of drivers ported to
+/// internal::TaskRuntime.
+enum class TaskBackend : char {
+    OpenMP   = 'O',     ///< OpenMP tasks with depend clauses
+    Stealing = 'S',     ///< native work-stealing scheduler
+};
+
+//------------------------------------------------------------------------------
+/// Query the task runtime backend.
+class Task_Backend
+{
+public:
+    /// @see TaskBackend task_backend()
+    static TaskBackend value()
+    {
+        return get().task_backend_;
+    }
+
+    /// @see void task_backend( TaskBackend )
+    static void value( TaskBackend val )
+    {
+        get().task_backend_ = val;
+    }
+
+private:
+    /// @return Task_Backend singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Task_Backend& get()
+    {
+        static Task_Backend singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_TASK_BACKEND.
+    Task_Backend()
+    {
+        const char* env = getenv( "SLATE_TASK_BACKEND" );
+        task_backend_ = env != nullptr && strcmp( env, "stealing" ) == 0
+                      ? TaskBackend::Stealing
+                      : TaskBackend::OpenMP;
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached task runtime backend.
+    TaskBackend task_backend_;
+};
+
+//------------------------------------------------------------------------------
+/// @return task runtime backend of the drivers ported to
+/// internal::TaskRuntime (gemmC, getrf, geqrf, potrf), default
+/// TaskBackend::OpenMP, which makes OpenMP tasks with depend clauses.
+/// TaskBackend::Stealing schedules tasks with SLATE's own work-stealing
+/// scheduler: per-thread deques ordered by priority, with thieves stealing
+/// from the nearest threads first.
+/// Initially checks environment variable $SLATE_TASK_BACKEND,
+/// "openmp" or "stealing".
+/// Can be overriden by task_backend( TaskBackend ).
+inline TaskBackend task_backend()
+{
+    return Task_Backend::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set the task runtime backend.
+/// Overrides $SLATE_TASK_BACKEND. Takes effect at the next driver call.
+/// @param[in] value: task runtime backend.
+inline void task_backend( TaskBackend value )
+{
+    return Task_Backend::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether concurrent driver calls share the threads.
+class Shared_Threads
+{
+public:
+    /// @see bool shared_threads()
+    static bool value()
+    {
+        return get().shared_threads_;
+    }
+
+    /// @see void shared_threads( bool )
+    static void value( bool val )
+    {
+        get().shared_threads_ = val;
+    }
+
+private:
+    /// @return Shared_Threads singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Shared_Threads& get()
+    {
+        static Shared_Threads singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_SHARED_THREADS.
+    Shared_Threads()
+    {
+        const char* env = getenv( "SLATE_SHARED_THREADS" );
+        shared_threads_ = env != nullptr
+                          && (strcmp( env, "" ) == 0
+                              || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether concurrent calls share the threads.
+    bool shared_threads_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if driver calls made concurrently from several application
+/// threads share the threads of the process, default false. Then each
+/// call's parallel regions use an equal share of the OpenMP threads the
+/// first call had, e.g., 4 each for 4 concurrent calls with 16 threads,
+/// instead of each using all of them and oversubscribing the cores.
+/// Shares are set when a call starts. @see OmpSetMaxActiveLevels
+/// Initially checks environment variable $SLATE_SHARED_THREADS.
+/// Can be overriden by shared_threads( bool ).
+inline bool shared_threads()
+{
+    return Shared_Threads::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether concurrent driver calls share the threads.
+/// Overrides $SLATE_SHARED_THREADS.
+/// @param[in] value: true to share threads among concurrent calls.
+inline void shared_threads( bool value )
+{
+    return Shared_Threads::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query cores of the panel thread pool.
+class Panel_Cores
+{
+public:
+    /// @see std::vector<int> panel_cores()
+    static std::vector<int> value()
+    {
+        return get().panel_cores_;
+    }
+
+    /// @see void panel_cores( std::vector<int> const& )
+    static void value( std::vector<int> const& val )
+    {
+        get().panel_cores_ = val;
+    }
+
+private:
+    /// @return Panel_Cores singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Panel_Cores& get()
+    {
+        static Panel_Cores singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_PANEL_CORES.
+    Panel_Cores()
+    {
+        const char* env = getenv( "SLATE_PANEL_CORES" );
+        if (env != nullptr)
+            panel_cores_ = internal::parse_core_list( env );
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached list of cores; empty disables the pool.
+    std::vector<int> panel_cores_;
+};
+
+//------------------------------------------------------------------------------
+/// @return cores of the persistent panel thread pool. The threads of the
+/// host panel factorizations (getrf, getrf_tntpiv, geqrf) run in a pool of
+/// one thread per listed core, each pinned to its core, that is created
+/// once and reused by every panel, instead of in a nested OpenMP parallel
+/// region per panel. If the list is empty (default), or the pool is busy
+/// with another panel, panels use a nested parallel region as before.
+/// Initially checks environment variable $SLATE_PANEL_CORES, a list of
+/// cores and ranges, e.g., "0-3,8,10".
+/// Can be overriden by panel_cores( std::vector<int> const& ).
+inline std::vector<int> panel_cores()
+{
+    return Panel_Cores::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set cores of the panel thread pool.
+/// Overrides $SLATE_PANEL_CORES. The pool is rebuilt at the next panel.
+/// @param[in] value: list of cores; empty disables the pool.
+inline void panel_cores( std::vector<int> const& value )
+{
+    return Panel_Cores::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query cores of the communication thread.
+class Comm_Cores
+{
+public:
+    /// @see std::vector<int> comm_cores()
+    static std::vector<int> value()
+    {
+        return get().comm_cores_;
+    }
+
+    /// @see void comm_cores( std::vector<int> const& )
+    static void value( std::vector<int> const& val )
+    {
+        get().comm_cores_ = val;
+    }
+
+private:
+    /// @return Comm_Cores singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Comm_Cores& get()
+    {
+        static Comm_Cores singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_COMM_CORES.
+    Comm_Cores()
+    {
+        const char* env = getenv( "SLATE_COMM_CORES" );
+        if (env != nullptr)
+            comm_cores_ = internal::parse_core_list( env );
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached list of cores; empty leaves the thread unpinned.
+    std::vector<int> comm_cores_;
+};
+
+//------------------------------------------------------------------------------
+/// @return cores reserved for the communication thread (see comm_thread()),
+/// which is pinned to them when it starts. Together with panel_cores(),
+/// these cores are also kept free of the OpenMP threads running the
+/// trailing updates of getrf, getrf_tntpiv, and geqrf, so panel and MPI
+/// threads aren't preempted by updates. Empty by default.
+/// Initially checks environment variable $SLATE_COMM_CORES, a list of
+/// cores and ranges, e.g., "0-3,8,10".
+/// Can be overriden by comm_cores( std::vector<int> const& ).
+inline std::vector<int> comm_cores()
+{
+    return Comm_Cores::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set cores reserved for the communication thread.
+/// Overrides $SLATE_COMM_CORES. Takes effect for the communication thread
+/// only if set before its first use.
+/// @param[in] value: list of cores; empty reserves none.
+inline void comm_cores( std::vector<int> const& value )
+{
+    return Comm_Cores::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether factorizations stream final tiles back to host origins.
+class Async_Origin
+{
+public:
+    /// @see bool async_origin()
+    static bool value()
+    {
+        return get().async_origin_;
+    }
+
+    /// @see void async_origin( bool )
+    static void value( bool val )
+    {
+        get().async_origin_ = val;
+    }
+
+private:
+    /// @return Async_Origin singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Async_Origin& get()
+    {
+        static Async_Origin singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_ASYNC_ORIGIN.
+    Async_Origin()
+    {
+        const char* env = getenv( "SLATE_ASYNC_ORIGIN" );
+        async_origin_ = env != nullptr
+                        && (strcmp( env, "" ) == 0
+                            || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to stream final tiles to host.
+    bool async_origin_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if getrf and potrf on devices copy each panel back to its
+/// host origin asynchronously, on the comm queues, as soon as the panel is
+/// final, and erase its device workspace a step later, so the copies
+/// overlap the rest of the factorization; default false, which copies and
+/// erases each panel in its release task, waiting for the copies.
+/// @see BaseMatrix::tileUpdateAllOriginAsync
+/// Initially checks environment variable $SLATE_ASYNC_ORIGIN.
+/// Can be overriden by async_origin( bool ).
+inline bool async_origin()
+{
+    return Async_Origin::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether factorizations stream final tiles back to host origins.
+/// Overrides $SLATE_ASYNC_ORIGIN.
+/// @param[in] value: true to copy panels back asynchronously.
+inline void async_origin( bool value )
+{
+    return Async_Origin::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query whether broadcasts prefetch received tiles to devices.
+class Prefetch
+{
+public:
+    /// @see bool prefetch()
+    static bool value()
+    {
+        return get().prefetch_;
+    }
+
+    /// @see void prefetch( bool )
+    static void value( bool val )
+    {
+        get().prefetch_ = val;
+    }
+
+private:
+    /// @return Prefetch singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Prefetch& get()
+    {
+        static Prefetch singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_PREFETCH.
+    Prefetch()
+    {
+        const char* env = getenv( "SLATE_PREFETCH" );
+        prefetch_ = env != nullptr
+                    && (strcmp( env, "" ) == 0
+                        || strcmp( env, "1" ) == 0);
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached value whether to prefetch broadcast tiles.
+    bool prefetch_;
+};
+
+//------------------------------------------------------------------------------
+/// @return true if, with Target::Devices, broadcasts start copying each
+/// received tile to the devices that need it on the comm queues as soon as
+/// it lands, without waiting, so the copies of the next panel overlap the
+/// trailing update; default false, which copies and waits for them.
+/// @see BaseMatrix::tilePrefetch
+/// Initially checks environment variable $SLATE_PREFETCH.
+/// Can be overriden by prefetch( bool ).
+inline bool prefetch()
+{
+    return Prefetch::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether broadcasts prefetch received tiles to devices.
+/// Overrides $SLATE_PREFETCH.
+/// @param[in] value: true to prefetch tiles asynchronously.
+inline void prefetch( bool value )
+{
+    return Prefetch::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query the fraction of trailing-update tile columns computed on the host
+/// with Target::Devices, and whether it adapts to measured throughput.
+class Hybrid
+{
+public:
+    /// @see double hybrid_host_fraction()
+    static double fraction()
+    {
+        return get().fraction_;
+    }
+
+    /// @see void hybrid_host_fraction( double )
+    static void fraction( double val )
+    {
+        get().fraction_ = val < 0 ? 0 : (val > max_fraction ? max_fraction : val);
+    }
+
+    /// @see bool hybrid_auto()
+    static bool is_auto()
+    {
+        return get().auto_;
+    }
+
+    /// @see void hybrid_auto( bool )
+    static void is_auto( bool val )
+    {
+        get().auto_ = val;
+    }
+
+    /// Largest fraction of columns given to the host.
+    static constexpr double max_fraction = 0.9;
+
+    /// Initial fraction with $SLATE_HYBRID=auto.
+    static constexpr double auto_fraction = 0.1;
+
+private:
+    /// @return Hybrid singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Hybrid& get()
+    {
+        static Hybrid singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_HYBRID, which is "auto" or a fraction.
+    Hybrid()
+        : fraction_( 0 ),
+          auto_( false )
+    {
+        const char* env = getenv( "SLATE_HYBRID" );
+        if (env != nullptr) {
+            if (strcmp( env, "auto" ) == 0) {
+                fraction_ = auto_fraction;
+                auto_ = true;
+            }
+            else {
+                double val = atof( env );
+                fraction_ = val < 0 ? 0 : (val > max_fraction ? max_fraction : val);
+            }
+        }
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached fraction of columns on the host.
+    double fraction_;
+
+    /// Cached value whether the fraction adapts.
+    bool auto_;
+};
+
+//------------------------------------------------------------------------------
+/// @return fraction, in [0, 0.9], of the tile columns of trailing-matrix
+/// updates, such as in gemm, getrf, and potrf, that Target::Devices
+/// computes with host BLAS instead of on the devices, so idle host cores
+/// share the work. 0 (the default) disables the hybrid split.
+/// Host columns are spread evenly, counting from the last column, so a
+/// column stays on the host in successive updates and its tiles stay
+/// there, coherent via MOSI.
+/// Initially checks environment variable $SLATE_HYBRID: "auto" starts at
+/// 0.1 and adapts (see hybrid_auto()); a number sets a fixed fraction.
+/// Can be overriden by hybrid_host_fraction( double ).
+inline double hybrid_host_fraction()
+{
+    return Hybrid::fraction();
+}
+
+//------------------------------------------------------------------------------
+/// Set the fraction of trailing-update tile columns computed on the host.
+/// Overrides $SLATE_HYBRID. Clamped to [0, 0.9].
+/// @param[in] value: fraction; 0 disables the hybrid split.
+inline void hybrid_host_fraction( double value )
+{
+    return Hybrid::fraction( value );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if the hybrid host fraction adapts after each update:
+/// it grows if the host finished its columns before the devices, and
+/// shrinks otherwise, balancing the two in proportion to their throughput.
+/// Enabled by $SLATE_HYBRID=auto. Can be overriden by hybrid_auto( bool ).
+inline bool hybrid_auto()
+{
+    return Hybrid::is_auto();
+}
+
+//------------------------------------------------------------------------------
+/// Set whether the hybrid host fraction adapts.
+/// Overrides $SLATE_HYBRID.
+/// @param[in] value: true to adapt.
+inline void hybrid_auto( bool value )
+{
+    return Hybrid::is_auto( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query the minimum tile dimension for 3M complex gemm.
+class Gemm3M
+{
+public:
+    /// @see int64_t gemm3m_threshold()
+    static int64_t value()
+    {
+        return get().threshold_;
+    }
+
+    /// @see void gemm3m_threshold( int64_t )
+    static void value( int64_t val )
+    {
+        get().threshold_ = val < 0 ? 0 : val;
+    }
+
+    /// Threshold with $SLATE_GEMM_3M=1.
+    static constexpr int64_t default_threshold = 256;
+
+private:
+    /// @return Gemm3M singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static Gemm3M& get()
+    {
+        static Gemm3M singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_GEMM_3M, which is 1 or a threshold.
+    Gemm3M()
+        : threshold_( 0 )
+    {
+        const char* env = getenv( "SLATE_GEMM_3M" );
+        if (env != nullptr) {
+            if (strcmp( env, "" ) == 0 || strcmp( env, "1" ) == 0) {
+                threshold_ = default_threshold;
+            }
+            else {
+                int64_t val = atoll( env );
+                threshold_ = val < 0 ? 0 : val;
+            }
+        }
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached minimum tile dimension; 0 disables 3M.
+    int64_t threshold_;
+};
+
+//------------------------------------------------------------------------------
+/// @return minimum of the tile dimensions m, n, k from which complex gemm
+/// updates of tiles, on the host and on the devices, use the 3M (Gauss)
+/// method: 3 real gemm's on the real and imaginary parts, instead of the
+/// 4 real multiplies per complex multiply of a complex gemm, which saves
+/// 25% of the flops. 0 (the default) disables it.
+/// The imaginary part of C can be less accurate, if the real and
+/// imaginary parts of A or B differ much in magnitude.
+/// Initially checks environment variable $SLATE_GEMM_3M: 1 sets it to 256;
+/// a larger number sets the threshold itself.
+/// Can be overriden by gemm3m_threshold( int64_t ).
+inline int64_t gemm3m_threshold()
+{
+    return Gemm3M::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set the minimum tile dimension of 3M complex gemm.
+/// Overrides $SLATE_GEMM_3M.
+/// @param[in] value: minimum of m, n, k; 0 disables 3M.
+inline void gemm3m_threshold( int64_t value )
+{
+    return Gemm3M::value( value );
+}
+
+//------------------------------------------------------------------------------
+/// Query the maximum size of device super-tiles, in tiles.
+class SuperTile
+{
+public:
+    /// @see int64_t super_tile()
+    static int64_t value()
+    {
+        return get().size_;
+    }
+
+    /// @see void super_tile( int64_t )
+    static void value( int64_t val )
+    {
+        get().size_ = val < 0 ? 0 : val;
+    }
+
+    /// Size without $SLATE_SUPER_TILE.
+    static constexpr int64_t default_size = 8;
+
+private:
+    /// @return SuperTile singleton.
+    /// Uses thread-safe Scott Meyers' singleton to query on first call only.
+    static SuperTile& get()
+    {
+        static SuperTile singleton;
+        return singleton;
+    }
+
+    /// Constructor checks $SLATE_SUPER_TILE.
+    SuperTile()
+        : size_( default_size )
+    {
+        const char* env = getenv( "SLATE_SUPER_TILE" );
+        if (env != nullptr && strcmp( env, "" ) != 0) {
+            int64_t val = atoll( env );
+            size_ = val < 0 ? 0 : val;
+        }
+    }
+
+    //----------------------------------------
+    // Data
+
+    /// Cached maximum super-tile size, in tiles per dimension;
+    /// 0 or 1 disables super-tiles.
+    int64_t size_;
+};
+
+//------------------------------------------------------------------------------
+/// @return maximum number of tile rows and of tile columns of a device
+/// super-tile. In gemm trailing updates on devices, a block of up to
+/// super_tile()-by-super_tile() local tiles of C whose data are contiguous
+/// on the device, as in one column-major array (e.g., a matrix created with
+/// fromDevices), is updated by one large gemm, instead of being batched
+/// tile by tile. Default 8; 0 or 1 disables super-tiles.
+/// Initially checks environment variable $SLATE_SUPER_TILE.
+/// Can be overriden by super_tile( int64_t ).
+inline int64_t super_tile()
+{
+    return SuperTile::value();
+}
+
+//------------------------------------------------------------------------------
+/// Set the maximum size of device super-tiles, in tiles.
+/// Overrides $SLATE_SUPER_TILE.
+/// @param[in] value: maximum tiles per dimension; 0 or 1 disables them.
+inline void super_tile( int64_t value )
+{
+    return SuperTile::value( value );
+}
+
 }  // namespace slate
 
 #endif // SLATE_CONFIG_HH
@@ -35,7 +35,8 @@ enum class Target : char {
     Host      = 'H',    ///< data resides on host
     HostTask  = 'T',    ///< computation using OpenMP nested tasks on host
     HostNest  = 'N',    ///< computation using OpenMP nested parallel for loops on host
-    HostBatch = 'B',    ///< computation using batch BLAS on host (Intel MKL)
+    HostBatch = 'B',    ///< computation using batch BLAS on host (Intel MKL;
+                        ///< gemm also batches by OpenMP tasks without it)
     Devices   = 'D',    ///< computation using batch BLAS on devices (cuBLAS)
 };
 
@@ -54,6 +55,54 @@ template <Target> class TargetType {};
 enum class MethodEig : char {
     QR        = 'Q',    ///< QR iteration for finding eigenvalues
     DC        = 'D',    ///< Divide and conquer algorithm for finding eigenvalues
+    Bisection = 'B',    ///< Bisection for eigenvalues and inverse iteration
+                        ///< for eigenvectors, distributed over ranks
+    QDWH      = 'W',    ///< QDWH-based spectral divide and conquer, without
+                        ///< tridiagonal reduction (heev only; see heev_qdwh)
+};
+
+//------------------------------------------------------------------------------
+/// Math mode of the device BLAS compute queues.
+/// @ingroup enum
+///
+enum class MathMode : char {
+    Default   = 'D',    ///< IEEE arithmetic in the matrix precision
+    TF32      = 'T',    ///< single precision gemm on tensor cores,
+                        ///< with TF32 inputs and FP32 accumulation
+};
+
+//------------------------------------------------------------------------------
+/// Reduction tree of tournament pivoting in the CALU panel (getrf_tntpiv).
+/// @ingroup enum
+///
+enum class TournamentTree : char {
+    Binary    = 'B',    ///< binary tree over the panel's ranks
+    Flat      = 'F',    ///< top rank merges each other rank's candidates in turn
+    Hybrid    = 'H',    ///< flat within each node, binary between nodes
+};
+
+//------------------------------------------------------------------------------
+/// Precision in which a tile is stored and updated, relative to the
+/// precision of its matrix (@see select_tile_precision, potrf_mixed).
+/// @ingroup enum
+///
+enum class TilePrecision : char {
+    Full      = 'F',    ///< precision of the matrix, e.g., double
+    Single    = 'S',    ///< single precision, e.g., float for a double matrix
+};
+
+//------------------------------------------------------------------------------
+/// Known structure of a tile's data, so kernels can skip trivial work
+/// (@see BaseMatrix::tileStructure).
+/// Recorded by set() and copy() only for matrices with trackTileStructure
+/// on, and never for tiles in user memory; any write to the tile through
+/// SLATE resets it to Dense.
+/// @ingroup enum
+///
+enum class TileStructure : char {
+    Dense     = 'D',    ///< no known structure
+    Zero      = 'Z',    ///< all zeros
+    Identity  = 'I',    ///< square identity
 };
 
 //------------------------------------------------------------------------------
@@ -74,6 +123,39 @@ enum class Option : char {
     MaxIterations,      ///< maximum iteration count
     UseFallbackSolver,  ///< whether to fallback to a robust solver if iterations do not converge
     PivotThreshold,     ///< threshold for pivoting, >= 0, <= 1
+    Workspace,          ///< workspace arena reused across drivers (@see Workspace)
+    AggregateBcast,     ///< aggregate broadcast tiles per destination rank
+    HierarchicalBcast,  ///< broadcast between nodes first, then within nodes;
+                        ///< honored only by getrf, gemmA, gemmC, trsmA,
+                        ///< and potrf; other drivers ignore it
+    MathMode,           ///< math mode of low precision factorizations
+                        ///< in mixed-precision solvers (@see MathMode)
+    InvertDiagonal,     ///< invert diagonal tiles to update panels with trmm
+    TournamentTree,     ///< reduction tree of tournament pivoting
+                        ///< (@see TournamentTree)
+    MaxLookahead,       ///< max lookahead depth; if > Lookahead, the depth
+                        ///< adapts per panel, >= 0
+    Pipeline,           ///< overlap the stages of two-stage reductions,
+                        ///< e.g., he2hb and hb2st in heev
+    Layers,             ///< number of replicated layers in 2.5D algorithms,
+                        ///< >= 1
+    MaxWorkspace,       ///< max bytes of remote panel tiles held at once
+                        ///< per rank, 0: no limit
+    ColumnGroups,       ///< number of independent groups of right-hand
+                        ///< sides in trsmB, >= 1
+    CholQRPasses,       ///< Cholesky QR passes: 1, 2 (CholeskyQR2),
+                        ///< or 3 (shifted CholeskyQR3)
+    NormEstVectors,     ///< number of vectors t in the block 1-norm
+                        ///< estimator of condest, >= 1
+    MixedLowMemory,     ///< keep only the low precision factors on the
+                        ///< devices in mixed-precision solvers
+    Rank,               ///< target rank k of low-rank approximations, >= 1
+    Oversampling,       ///< extra columns sampled in randomized
+                        ///< low-rank approximations, >= 0
+    PowerIterations,    ///< power iterations of the randomized range
+                        ///< finder, >= 0
+    Timers,             ///< hierarchical timers filled by drivers
+                        ///< (@see TimerContext)
 
     // Printing parameters
     PrintVerbose = 50,  ///< verbose, 0: no printing,
@@ -96,6 +178,8 @@ enum class Option : char {
     MethodHemm,         ///< Select the hemm algorithm
     MethodLU,           ///< Select the LU (getrf) algorithm
     MethodTrsm,         ///< Select the trsm algorithm
+    MethodCholesky,     ///< Select the Cholesky (potrf) algorithm
+    MethodMatFunc,      ///< Select the inv_sqrt and matrix_sign iteration
 };
 
 //------------------------------------------------------------------------------
@@ -128,11 +212,26 @@ enum class GridOrder : char {
     Unknown  = 'U',     ///< Unknown (e.g., if using lambda functions)
 };
 
+//------------------------------------------------------------------------------
+/// Layout of a matrix in a binary file, for read_file and write_file.
+/// @ingroup enum
+///
+enum class FileLayout : char {
+    ColMajor = 'C',     ///< whole matrix in column-major order, as in LAPACK
+    Tiled    = 'T',     ///< tiles in column-major order of tiles, each
+                        ///< tile column-major and contiguous
+};
+
 //------------------------------------------------------------------------------
 const int HostNum = -1;
 const int AllDevices = -2;
 const int AnyDevice  = -3;
 
+/// Queue index for internal routines: lease any free compute queue from the
+/// matrix's queue pool, instead of a fixed one.
+/// @see MatrixStorage::acquireComputeQueue
+const int AnyQueue = -1;
+
 //------------------------------------------------------------------------------
 /// A tile state in the MOSI coherency protocol
 enum MOSI {
@@ -0,0 +1,267 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_EXPR_HH
+#define SLATE_EXPR_HH
+
+#include <utility>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Lightweight matrix expressions, evaluated by slate::eval.
+/// An expression is a linear combination of at most two general matrices,
+/// held as shallow copies, e.g., `alpha*A + beta*B`, `A - B`, or `alpha*A`.
+namespace expr {
+
+/// Makes a parameter non-deduced, so `2.0 * A` works for complex A.
+template <typename T>
+struct identity { using type = T; };
+
+//------------------------------------------------------------------------------
+/// alpha A.
+template <typename scalar_t>
+struct Term {
+    scalar_t alpha;
+    Matrix<scalar_t> A;
+};
+
+//------------------------------------------------------------------------------
+/// alpha A + beta B.
+template <typename scalar_t>
+struct Sum {
+    Term<scalar_t> t1;
+    Term<scalar_t> t2;
+};
+
+template <typename scalar_t>
+Term<scalar_t> term( Matrix<scalar_t> const& A )
+{
+    return { scalar_t( 1.0 ), A };
+}
+
+template <typename scalar_t>
+Term<scalar_t> term( Term<scalar_t> const& t )
+{
+    return t;
+}
+
+} // namespace expr
+
+//------------------------------------------------------------------------------
+// Operators building expressions.
+
+template <typename scalar_t>
+expr::Term<scalar_t> operator*(
+    typename expr::identity<scalar_t>::type alpha, Matrix<scalar_t> const& A )
+{
+    return { alpha, A };
+}
+
+template <typename scalar_t>
+expr::Term<scalar_t> operator*(
+    typename expr::identity<scalar_t>::type alpha, expr::Term<scalar_t> const& t )
+{
+    return { alpha * t.alpha, t.A };
+}
+
+template <typename scalar_t>
+expr::Term<scalar_t> operator-( expr::Term<scalar_t> const& t )
+{
+    return { -t.alpha, t.A };
+}
+
+template <typename scalar_t>
+expr::Term<scalar_t> operator-( Matrix<scalar_t> const& A )
+{
+    return { scalar_t( -1.0 ), A };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator+(
+    expr::Term<scalar_t> const& t1, expr::Term<scalar_t> const& t2 )
+{
+    return { t1, t2 };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator+(
+    expr::Term<scalar_t> const& t1, Matrix<scalar_t> const& B )
+{
+    return { t1, expr::term( B ) };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator+(
+    Matrix<scalar_t> const& A, expr::Term<scalar_t> const& t2 )
+{
+    return { expr::term( A ), t2 };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator+(
+    Matrix<scalar_t> const& A, Matrix<scalar_t> const& B )
+{
+    return { expr::term( A ), expr::term( B ) };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator-(
+    expr::Term<scalar_t> const& t1, expr::Term<scalar_t> const& t2 )
+{
+    return { t1, -t2 };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator-(
+    expr::Term<scalar_t> const& t1, Matrix<scalar_t> const& B )
+{
+    return { t1, -B };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator-(
+    Matrix<scalar_t> const& A, expr::Term<scalar_t> const& t2 )
+{
+    return { expr::term( A ), -t2 };
+}
+
+template <typename scalar_t>
+expr::Sum<scalar_t> operator-(
+    Matrix<scalar_t> const& A, Matrix<scalar_t> const& B )
+{
+    return { expr::term( A ), -B };
+}
+
+namespace expr {
+
+//------------------------------------------------------------------------------
+/// Sets C = alpha C, in one pass.
+template <typename scalar_t>
+void scale_self( scalar_t alpha, Matrix<scalar_t>& C, Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    if (alpha == scalar_t( 1.0 ))
+        return;
+
+    if (alpha == scalar_t( 0.0 )) {
+        // As with beta = 0 in BLAS, C isn't read, so NaN in C doesn't
+        // propagate.
+        set( scalar_t( 0.0 ), C, opts );
+    }
+    else if (blas::imag( alpha ) == real_t( 0.0 )) {
+        scale( real_t( blas::real( alpha ) ), C, opts );
+    }
+    else {
+        // scale takes only a real scalar; a uniform row scaling
+        // applies a complex one.
+        std::vector<scalar_t> R( C.m(), alpha );
+        std::vector<scalar_t> unused( C.n() );
+        scale_row_col( Equed::Row, R, unused, C, opts );
+    }
+}
+
+} // namespace expr
+
+//------------------------------------------------------------------------------
+/// Evaluates C = alpha A, with the fewest passes over the tiles that
+/// the existing routines allow:
+/// - C = alpha C:  one pass (scale or set);
+/// - C = A:        one pass (copy);
+/// - C = alpha A:  copy, then scale.
+///
+/// Operands are general matrices with the same dimensions and
+/// distribution as C. An operand that is the same view as C
+/// (BaseMatrix::sameView) is taken as C; other operands must not share
+/// tiles with C.
+///
+/// Example:
+///
+///     slate::eval( C, 2.0*A, opts );
+///     slate::eval( R, B - A, opts );
+///
+/// @ingroup add
+///
+template <typename scalar_t>
+void eval(
+    Matrix<scalar_t>& C, expr::Term<scalar_t> const& t,
+    Options const& opts = Options())
+{
+    if (t.A.sameView( C )) {
+        expr::scale_self( t.alpha, C, opts );
+    }
+    else if (t.alpha == scalar_t( 0.0 )) {
+        set( scalar_t( 0.0 ), C, opts );
+    }
+    else {
+        Matrix<scalar_t> A = t.A;
+        copy( A, C, opts );
+        expr::scale_self( t.alpha, C, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Evaluates C = alpha A + beta B, with the fewest passes over the tiles
+/// that the existing routines allow:
+/// - C = alpha A + beta C, or alpha C + beta B: one pass (add);
+/// - C = alpha A + beta B, both distinct from C: copy B to C, then add.
+///
+/// A coefficient of 0 drops its term without reading its matrix, as
+/// with beta = 0 in BLAS. Aliasing rules are as for the single term.
+///
+/// Example:
+///
+///     slate::eval( C, alpha*A + beta*C, opts );  // same as slate::add
+///     slate::eval( R, B - A, opts );
+///
+/// @ingroup add
+///
+template <typename scalar_t>
+void eval(
+    Matrix<scalar_t>& C, expr::Sum<scalar_t> const& s,
+    Options const& opts = Options())
+{
+    expr::Term<scalar_t> t1 = s.t1;
+    expr::Term<scalar_t> t2 = s.t2;
+    if (t1.A.sameView( C ) && ! t2.A.sameView( C ))
+        std::swap( t1, t2 );
+
+    if (t1.alpha == scalar_t( 0.0 )) {
+        eval( C, t2, opts );
+    }
+    else if (t2.alpha == scalar_t( 0.0 )) {
+        eval( C, t1, opts );
+    }
+    else if (t1.A.sameView( C )) {
+        // Both terms are C.
+        eval( C, expr::Term<scalar_t>{ t1.alpha + t2.alpha, C }, opts );
+    }
+    else if (t2.A.sameView( C )) {
+        add( t1.alpha, t1.A, t2.alpha, C, opts );
+    }
+    else {
+        Matrix<scalar_t> B = t2.A;
+        copy( B, C, opts );
+        add( t1.alpha, t1.A, t2.alpha, C, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Evaluates C = A, as copy( A, C ).
+/// @ingroup copy
+///
+template <typename scalar_t>
+void eval(
+    Matrix<scalar_t>& C, Matrix<scalar_t> const& A,
+    Options const& opts = Options())
+{
+    eval( C, expr::term( A ), opts );
+}
+
+} // namespace slate
+
+#endif // SLATE_EXPR_HH
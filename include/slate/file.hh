@@ -0,0 +1,54 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_FILE_HH
+#define SLATE_FILE_HH
+
+#include "slate/Matrix.hh"
+#include "slate/enums.hh"
+#include "slate/types.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void read_file(
+    const char* filename,
+    Matrix<scalar_t>& A,
+    FileLayout layout = FileLayout::ColMajor,
+    Options const& opts = Options());
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void write_file(
+    Matrix<scalar_t>& A,
+    const char* filename,
+    FileLayout layout = FileLayout::ColMajor,
+    Options const& opts = Options());
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void write_checkpoint(
+    Matrix<scalar_t>& A,
+    const char* filename,
+    Options const& opts = Options());
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void read_checkpoint(
+    const char* filename,
+    Matrix<scalar_t>& A,
+    Options const& opts = Options());
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+Matrix<scalar_t> read_checkpoint(
+    const char* filename,
+    MPI_Comm mpi_comm,
+    Options const& opts = Options());
+
+} // namespace slate
+
+#endif // SLATE_FILE_HH
@@ -9,6 +9,7 @@
 #include "slate/enums.hh"
 
 #include <functional>
+#include <vector>
 
 namespace slate {
 
@@ -154,6 +155,43 @@ device_1d_grid(GridOrder order, int64_t block_size, int size)
     }
 }
 
+//------------------------------------------------------------------------------
+/// Distributes tiles to devices by groups of peer-connected devices,
+/// as given by device_peer_groups().
+///
+/// When the tiles are distributed across processes with a p-by-q
+/// process_2d_grid, local tile rows are assigned cyclicly to groups, and
+/// within a group, local tile columns are assigned cyclicly to its devices.
+/// Thus, in gemm or herk, the tiles of a row of A, which are needed by the
+/// devices updating that row of C, are exchanged only between peer-connected
+/// devices. With a single group, this is device_1d_grid( Row, q, size )
+/// with the group's device order.
+///
+/// @param[in] p
+///     The number of rows in the process grid
+///
+/// @param[in] q
+///     The number of columns in the process grid
+///
+/// @param[in] groups
+///     Groups of peer-connected devices; each group must be non-empty.
+///
+/// @return The distribution function
+///
+/// @ingroup func
+///
+inline std::function<int(ij_tuple)>
+device_peer_grid(int64_t p, int64_t q, std::vector< std::vector<int> > groups)
+{
+    slate_assert( ! groups.empty() );
+    return [p, q, groups]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij ) / p;
+        int64_t j = std::get<1>( ij ) / q;
+        auto const& group = groups[ i % groups.size() ];
+        return group[ j % group.size() ];
+    };
+}
+
 //------------------------------------------------------------------------------
 /// Distributes tiles to processes in a 2d cyclic fashion, resulting in the
 /// elements being distributed in a 2d block-cyclic fashion.
@@ -0,0 +1,54 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_AFFINITY_HH
+#define SLATE_AFFINITY_HH
+
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Pins the calling thread to the given cores. Does nothing if cores is
+/// empty, or on non-Linux systems. Pinning is a hint; failure, e.g., for
+/// a core not in the process's affinity mask, is ignored.
+void pin_thread( std::vector<int> const& cores );
+
+//------------------------------------------------------------------------------
+/// Keeps the threads of a driver's OpenMP parallel regions off the cores
+/// reserved for the panel thread pool (slate::panel_cores()) and the
+/// communication thread (slate::comm_cores()), so trailing update tasks
+/// don't preempt panel threads spinning in a ThreadBarrier, or the thread
+/// making MPI calls. The destructor restores the threads' affinity.
+///
+/// Affinity is per thread, so the constructor and destructor each run a
+/// parallel region of omp_get_max_threads() threads, as the driver's
+/// region does, which the OpenMP runtime serves from the same thread pool.
+/// A thread that wasn't in the first region is left as is.
+///
+/// Does nothing if no cores are reserved, or if excluding them would
+/// leave a thread no cores.
+///
+/// Usage, in a driver before its parallel region:
+///
+///     internal::ExcludeReservedCores exclude_reserved_cores;
+///
+class ExcludeReservedCores {
+public:
+    ExcludeReservedCores();
+    ~ExcludeReservedCores();
+
+    ExcludeReservedCores( ExcludeReservedCores const& ) = delete;
+    ExcludeReservedCores& operator=( ExcludeReservedCores const& ) = delete;
+
+private:
+    bool active_ = false;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_AFFINITY_HH
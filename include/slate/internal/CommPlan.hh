@@ -0,0 +1,88 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_COMMPLAN_HH
+#define SLATE_COMMPLAN_HH
+
+#include "slate/internal/mpi.hh"
+#include "slate/internal/openmp.hh"
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Communication plan that records the point-to-point messages of a
+/// driver, to replay them in later calls with the same pattern.
+/// Each distinct message, identified by its direction, buffer, count,
+/// datatype, peer, tag, and communicator, gets a persistent request
+/// (MPI_Send_init / MPI_Recv_init) the first time it is posted; later
+/// calls only MPI_Start it. Strided tiles use the datatypes cached by
+/// internal::mpi_vector_type.
+///
+/// A plan is owned by a Workspace arena, and used by tile broadcasts and
+/// reductions of matrices attached to it. Each driver call is an epoch,
+/// started by nextEpoch. A request is reused only in a later epoch,
+/// when the driver that started it has completed it; the same message
+/// posted twice in one epoch gets a second request. Requests not used for
+/// max_idle_epochs epochs, e.g., because a tile was received into a
+/// different workspace buffer, are freed.
+///
+/// Callers complete requests with MPI_Wait, MPI_Waitall, etc., as usual,
+/// but must not free them; the plan owns them.
+///
+class CommPlan {
+public:
+    /// Number of epochs a request is kept without being used.
+    static constexpr int64_t max_idle_epochs = 4;
+
+    CommPlan();
+    ~CommPlan();
+
+    // Not copyable, as it owns MPI requests.
+    CommPlan( CommPlan const& ) = delete;
+    CommPlan& operator=( CommPlan const& ) = delete;
+
+    void isend( void const* buf, int count, MPI_Datatype datatype,
+                int dst, int tag, MPI_Comm comm, MPI_Request* request );
+
+    void irecv( void* buf, int count, MPI_Datatype datatype,
+                int src, int tag, MPI_Comm comm, MPI_Request* request );
+
+    void nextEpoch();
+    void clear();
+
+    /// @return current epoch.
+    int64_t epoch() const { return epoch_; }
+
+    size_t numRequests() const;
+
+private:
+    /// Persistent request, and epoch in which it was last started.
+    struct Entry {
+        MPI_Request request;
+        int64_t epoch;
+    };
+
+    /// Message key: is_send, buffer, count, datatype, peer, tag, comm.
+    using Key = std::tuple< bool, void*, int, MPI_Datatype, int, int, MPI_Comm >;
+
+    void start( Key const& key, MPI_Request* request );
+
+    //----------------------------------------
+    // Data
+
+    std::map< Key, std::vector< Entry > > requests_;
+    int64_t epoch_;
+
+    mutable omp_nest_lock_t lock_;
+};
+
+} // namespace slate
+
+#endif // SLATE_COMMPLAN_HH
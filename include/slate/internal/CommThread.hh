@@ -0,0 +1,33 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_COMM_THREAD_HH
+#define SLATE_COMM_THREAD_HH
+
+#include "slate/internal/mpi.hh"
+
+#include <functional>
+#include <future>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Communication thread, enabled by comm_thread(). Tasks post MPI calls and
+// waits to it through a lock-free queue, and get futures of the MPI error
+// codes. The thread never blocks in a wait: it tests the requests of
+// pending waits in turn, which also progresses their messages.
+// slate_mpi_call posts calls with comm_thread_call, and comm_wait,
+// comm_waitall, and comm_waitany post waits.
+
+std::future< int > comm_thread_post( std::function< int () > call );
+
+std::future< int > comm_thread_wait(
+    int count, MPI_Request* requests, int* index );
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_COMM_THREAD_HH
@@ -0,0 +1,60 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_DEVICE_EVENT_HH
+#define SLATE_DEVICE_EVENT_HH
+
+#include <memory>
+
+namespace blas {
+class Queue;
+}
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Completion event of work enqueued on a device queue, via CUDA or HIP
+/// events. Device routines record an event after enqueuing their kernels,
+/// instead of synchronizing the queue, and attach it to the tiles they read
+/// and write (see TileNode). Tasks that use those tiles later wait on the
+/// event, either on their own queue, which doesn't block the host thread,
+/// or on the host when host data is needed or memory is freed.
+///
+/// Events are shared, since several tiles and tasks refer to the same
+/// event, and their handles are recycled in a per-process pool.
+///
+class DeviceEvent {
+public:
+    static std::shared_ptr< DeviceEvent > record( blas::Queue& queue );
+
+    ~DeviceEvent();
+
+    // not copyable or movable, since it owns the event handle.
+    DeviceEvent(DeviceEvent&  orig) = delete;
+    DeviceEvent(DeviceEvent&& orig) = delete;
+    DeviceEvent& operator = (DeviceEvent&  orig) = delete;
+    DeviceEvent& operator = (DeviceEvent&& orig) = delete;
+
+    void wait( blas::Queue& queue ) const;
+    void sync() const;
+    bool done() const;
+
+    /// @return device the event was recorded on.
+    int device() const { return device_; }
+
+private:
+    DeviceEvent( void* event, int device )
+        : event_( event ),
+          device_( device )
+    {}
+
+    /// cudaEvent_t or hipEvent_t
+    void* event_;
+    int device_;
+};
+
+} // namespace slate
+
+#endif // SLATE_DEVICE_EVENT_HH
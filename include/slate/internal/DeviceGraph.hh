@@ -0,0 +1,65 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_DEVICE_GRAPH_HH
+#define SLATE_DEVICE_GRAPH_HH
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace blas {
+class Queue;
+}
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Key identifying a sequence of device launches: every argument the
+/// launches depend on, such as dimensions, scalars, and device pointer
+/// arrays, packed into 64-bit words. @see device_graph_key
+using DeviceGraphKey = std::vector< int64_t >;
+
+//------------------------------------------------------------------------------
+/// Appends the bytes of value to key.
+template <typename T>
+void device_graph_key_append( DeviceGraphKey& key, T const& value )
+{
+    static_assert( std::is_trivially_copyable< T >::value,
+                   "graph key values must be trivially copyable" );
+    constexpr size_t nwords = (sizeof( T ) + sizeof( int64_t ) - 1)
+                              / sizeof( int64_t );
+    int64_t words[ nwords ] = {};
+    std::memcpy( words, &value, sizeof( T ) );
+    key.insert( key.end(), words, words + nwords );
+}
+
+//------------------------------------------------------------------------------
+/// @return key of the given values, e.g.,
+///     device_graph_key( "geset", typeid( scalar_t ).hash_code(),
+///                       mb, nb, alpha, a_array_dev, lda, batch_count )
+/// Device pointer arrays are keyed by address, not contents: a replay
+/// reads whatever pointers were copied to the arrays before it.
+template <typename... Ts>
+DeviceGraphKey device_graph_key( Ts const&... values )
+{
+    DeviceGraphKey key;
+    ( device_graph_key_append( key, values ), ... );
+    return key;
+}
+
+void device_graph_run(
+    blas::Queue& queue, DeviceGraphKey const& key,
+    std::function< void () > const& launch );
+
+void device_graph_clear();
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_DEVICE_GRAPH_HH
@@ -0,0 +1,42 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_DEVICE_QUEUES_HH
+#define SLATE_DEVICE_QUEUES_HH
+
+namespace lapack {
+class Queue;
+}
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Per-process registry of device queues shared by all matrices.
+/// Each device has a communication queue, used for tile transfers and
+/// memory allocation, and a default compute queue (queue index 0).
+/// Creating a queue creates its streams and BLAS and solver handles,
+/// which takes milliseconds per device. So matrices, including
+/// emptyLike() and scratch matrices in drivers, share these queues
+/// instead of creating their own. This also orders work on tiles of
+/// different matrices on the same stream.
+///
+/// Queues are created on first use, and destroyed when the last
+/// holder, a MatrixStorage or Workspace, detaches.
+///
+class DeviceQueues {
+public:
+    static void attach();
+    static void detach();
+
+    static lapack::Queue* comm_queue( int device );
+    static lapack::Queue* compute_queue( int device );
+
+    static bool is_shared( lapack::Queue* queue );
+    static void release( lapack::Queue* queue );
+};
+
+} // namespace slate
+
+#endif // SLATE_DEVICE_QUEUES_HH
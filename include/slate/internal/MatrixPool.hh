@@ -0,0 +1,139 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_MATRIX_POOL_HH
+#define SLATE_MATRIX_POOL_HH
+
+#include "slate/Matrix.hh"
+
+#include <cstdint>
+#include <list>
+#include <utility>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Matrix wrapping a LAPACK or ScaLAPACK array, taken from a pool of free
+/// matrices of the same shape, for the LAPACK and ScaLAPACK APIs.
+///
+/// Constructing a matrix creates its storage, device queues, locks, and
+/// memory pool, and the first driver call allocates its batch arrays;
+/// for small and medium calls, that costs more than the computation.
+/// Instead, a free matrix of the same shape is rebound to the new array
+/// (see Matrix::rebindLAPACK), keeping its queues, batch arrays, and memory
+/// blocks. On destruction, the matrix's tiles are removed and it returns
+/// to the pool, which keeps up to max_pooled free matrices, dropping the
+/// least recently used. With max_pooled = 0, this is just fromLAPACK or
+/// fromScaLAPACK.
+///
+/// Shallow copies of matrix() must be destroyed before this object, as
+/// usual for local variables declared after it.
+///
+template <typename scalar_t>
+class PooledMatrix {
+public:
+    //--------------------------------------------------------------------------
+    /// Arguments are as for Matrix::fromScaLAPACK, or Matrix::fromLAPACK
+    /// if is_scalapack is false; max_pooled is the pool size.
+    PooledMatrix(
+        int64_t m, int64_t n, scalar_t* A, int64_t lda,
+        int64_t mb, int64_t nb, GridOrder order, int p, int q,
+        MPI_Comm mpi_comm, bool is_scalapack, int max_pooled )
+        : shape_{ m, n, mb, nb, order, p, q, mpi_comm, is_scalapack },
+          max_pooled_( max_pooled )
+    {
+        bool found = false;
+        if (max_pooled_ > 0) {
+            #pragma omp critical(slate_matrix_pool)
+            {
+                auto& pool = freeList();
+                for (auto iter = pool.begin(); iter != pool.end(); ++iter) {
+                    if (iter->first == shape_) {
+                        A_ = std::move( iter->second );
+                        pool.erase( iter );
+                        found = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (found) {
+            if (is_scalapack)
+                A_.rebindScaLAPACK( A, lda );
+            else
+                A_.rebindLAPACK( A, lda );
+        }
+        else if (is_scalapack) {
+            A_ = Matrix<scalar_t>::fromScaLAPACK(
+                     m, n, A, lda, mb, nb, order, p, q, mpi_comm );
+        }
+        else {
+            A_ = Matrix<scalar_t>::fromLAPACK(
+                     m, n, A, lda, mb, nb, p, q, mpi_comm );
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Removes the matrix's tiles, so it no longer refers to the array, and
+    /// returns it to the pool.
+    ~PooledMatrix()
+    {
+        if (max_pooled_ <= 0)
+            return;
+
+        A_.clear();
+        #pragma omp critical(slate_matrix_pool)
+        {
+            auto& pool = freeList();
+            pool.emplace_front( shape_, std::move( A_ ) );
+            while (int( pool.size() ) > max_pooled_)
+                pool.pop_back();
+        }
+    }
+
+    // Not copyable, as it returns the matrix to the pool on destruction.
+    PooledMatrix( PooledMatrix const& ) = delete;
+    PooledMatrix& operator=( PooledMatrix const& ) = delete;
+
+    /// @return the matrix wrapping the array.
+    Matrix<scalar_t>& matrix() { return A_; }
+
+private:
+    struct Shape {
+        int64_t m, n, mb, nb;
+        GridOrder order;
+        int p, q;
+        MPI_Comm mpi_comm;
+        bool is_scalapack;
+
+        bool operator == ( Shape const& other ) const
+        {
+            return m == other.m && n == other.n
+                && mb == other.mb && nb == other.nb
+                && order == other.order && p == other.p && q == other.q
+                && mpi_comm == other.mpi_comm
+                && is_scalapack == other.is_scalapack;
+        }
+    };
+
+    /// @return free matrices, most recently used first,
+    /// in critical(slate_matrix_pool).
+    static std::list< std::pair< Shape, Matrix<scalar_t> > >& freeList()
+    {
+        static std::list< std::pair< Shape, Matrix<scalar_t> > > pool;
+        return pool;
+    }
+
+    Shape shape_;
+    int max_pooled_;
+    Matrix<scalar_t> A_;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_MATRIX_POOL_HH
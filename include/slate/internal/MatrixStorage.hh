@@ -6,10 +6,16 @@
 #ifndef SLATE_STORAGE_HH
 #define SLATE_STORAGE_HH
 
+#include "slate/config.hh"
+#include "slate/DeviceTopology.hh"
+#include "slate/internal/comm.hh"
+#include "slate/internal/DeviceEvent.hh"
+#include "slate/internal/DeviceQueues.hh"
 #include "slate/func.hh"
 #include "slate/internal/Memory.hh"
 #include "slate/Tile.hh"
 #include "slate/types.hh"
+#include "slate/Workspace.hh"
 #include "slate/internal/util.hh"
 
 #include "blas.hh"
@@ -17,9 +23,19 @@
 #include "lapack/device.hh"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <deque>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <set>
+#include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -29,32 +45,71 @@
 
 namespace slate {
 
+namespace internal {
+
+void set_math_mode( MathMode mode, blas::Queue& queue );
+
+} // namespace internal
+
 //------------------------------------------------------------------------------
+/// Node holding the instances of tile {i, j} on host and each device.
+/// The instances are stored inline, in a fixed-capacity array of
+/// num_devices + 1 slots that is allocated with the node by
+/// TileNodePool, so a node and its tiles are contiguous in memory and
+/// inserting or erasing an instance doesn't allocate.
 ///
 template <typename scalar_t>
 class TileNode {
+public:
+    /// Slot holding a tile instance.
+    struct Instance {
+        Tile<scalar_t> tile;
+        /// time of last use, for least-recently-used eviction.
+        int64_t last_use = 0;
+        bool exists = false;
+        /// pending device work that writes the instance, or null.
+        std::shared_ptr< DeviceEvent > write_event;
+        /// pending device work that reads the instance since the last write.
+        std::vector< std::shared_ptr< DeviceEvent > > read_events;
+        /// number of times the instance was handed out by tileGet and not
+        /// yet released; a pinned instance isn't evicted.
+        int64_t pins = 0;
+    };
+
 private:
-    /// vector of tile instances indexed by device id.
-    std::vector< Tile<scalar_t>* > tiles_;
+    /// array of tile instance slots, indexed by device id + 1.
+    Instance* instances_;
+    int num_slots_;
     int num_instances_;
     /// number of times a tile is received.
     /// This variable is used for only MPI communications.
     int64_t receive_count_;
+    /// known structure of the tile's data, shared by all instances.
+    TileStructure structure_;
 
     /// OMP lock used to protect operations that modify the Tiles within
     mutable omp_nest_lock_t lock_;
 
 public:
-    /// Constructor for TileNode class
-    TileNode(int num_devices)
-        : num_instances_(0),
-          receive_count_(0)
+    /// Constructor for TileNode class.
+    ///
+    /// @param[in] num_devices
+    ///     Number of devices; the node has num_devices + 1 slots.
+    ///
+    /// @param[in] storage
+    ///     Uninitialized memory for num_devices + 1 Instance slots,
+    ///     which must outlive the node.
+    TileNode(int num_devices, void* storage)
+        : num_slots_(num_devices+1),
+          num_instances_(0),
+          receive_count_(0),
+          structure_(TileStructure::Dense)
     {
         slate_assert(num_devices >= 0);
         omp_init_nest_lock(&lock_);
-        for (int d = 0; d < num_devices+1; ++d) {
-            tiles_.push_back( nullptr );
-        }
+        instances_ = static_cast< Instance* >( storage );
+        for (int d = 0; d < num_slots_; ++d)
+            new (&instances_[ d ]) Instance();
     }
 
     /// Destructor for TileNode class
@@ -63,13 +118,15 @@ public:
         omp_destroy_nest_lock(&lock_);
         // for debug mode
         assert(num_instances_ == 0);
+        for (int d = 0; d < num_slots_; ++d)
+            instances_[ d ].~Instance();
     }
 
     //--------------------------------------------------------------------------
-    // 2. copy constructor -- not allowed; lock_ and tiles_ are not copyable
-    // 3. move constructor -- not allowed; lock_ and tiles_ are not copyable
-    // 4. copy assignment  -- not allowed; lock_ and tiles_ are not copyable
-    // 5. move assignment  -- not allowed; lock_ and tiles_ are not copyable
+    // 2. copy constructor -- not allowed; lock_ and tiles are not copyable
+    // 3. move constructor -- not allowed; lock_ and tiles are not copyable
+    // 4. copy assignment  -- not allowed; lock_ and tiles are not copyable
+    // 5. move assignment  -- not allowed; lock_ and tiles are not copyable
     TileNode(TileNode&  orig) = delete;
     TileNode(TileNode&& orig) = delete;
     TileNode& operator = (TileNode&  orig) = delete;
@@ -83,22 +140,28 @@ public:
     }
 
     //--------------------------------------------------------------------------
-    /// Inserts a tile instance at device and increments the number of resident instances
-    void insertOn(int device, Tile<scalar_t>* tile, MOSI_State state)
+    /// Inserts a copy of tile as the instance at device and increments
+    /// the number of resident instances.
+    /// @return pointer to the inserted instance.
+    Tile<scalar_t>* insertOn(int device, Tile<scalar_t> const& tile,
+                             MOSI_State state)
     {
-        slate_assert(device >= -1 && device+1 < int(tiles_.size()));
-        slate_assert(tiles_[device+1] == nullptr);
-        tile->state( MOSI(state) );
-        tiles_[device+1] = tile;
+        slate_assert(device >= -1 && device+1 < num_slots_);
+        auto& instance = instances_[device+1];
+        slate_assert(! instance.exists);
+        instance.tile = tile;
+        instance.tile.state( MOSI(state) );
+        instance.exists = true;
         ++num_instances_;
+        return &instance.tile;
     }
 
     //--------------------------------------------------------------------------
     /// Returns whether a tile instance exists at device
     bool existsOn(int device) const
     {
-        slate_assert(device >= -1 && device+1 < int(tiles_.size()));
-        return tiles_[device+1] != nullptr;
+        slate_assert(device >= -1 && device+1 < num_slots_);
+        return instances_[device+1].exists;
     }
 
     //--------------------------------------------------------------------------
@@ -106,11 +169,14 @@ public:
     // CAUTION: tile's memory must have been already released to MatrixStorage Memory
     void eraseOn(int device)
     {
-        slate_assert(device >= -1 && device+1 < int(tiles_.size()));
-        auto tile = tiles_[device+1];
-        tiles_[device+1] = nullptr;
-        if (tile != nullptr) {
-            delete tile;
+        slate_assert(device >= -1 && device+1 < num_slots_);
+        auto& instance = instances_[device+1];
+        if (instance.exists) {
+            instance.tile = Tile<scalar_t>();
+            instance.write_event.reset();
+            instance.read_events.clear();
+            instance.pins = 0;
+            instance.exists = false;
             --num_instances_;
         }
     }
@@ -119,16 +185,38 @@ public:
     /// Returns a pointer to the tile instance at device
     Tile<scalar_t>* operator[](int device) const
     {
-        slate_assert(device >= -1 && device+1 < int(tiles_.size()));
-        return tiles_[device+1];
+        return at(device);
     }
 
     //--------------------------------------------------------------------------
     /// Returns a pointer to the tile instance at device
     Tile<scalar_t>* at(int dev) const
     {
-        slate_assert(dev >= -1 && dev+1 < int(tiles_.size()));
-        return tiles_[dev+1];
+        slate_assert(dev >= -1 && dev+1 < num_slots_);
+        auto& instance = instances_[dev+1];
+        return instance.exists ? &instance.tile : nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Pins the tile instance at device, so it isn't evicted while
+    /// the caller that got it hasn't yet enqueued its device work.
+    void pin(int device)
+    {
+        ++instances_[device+1].pins;
+    }
+
+    /// Releases one pin of the tile instance at device, if any.
+    void unpin(int device)
+    {
+        auto& instance = instances_[device+1];
+        if (instance.pins > 0)
+            --instance.pins;
+    }
+
+    /// Returns whether the tile instance at device is pinned.
+    bool pinned(int device) const
+    {
+        return instances_[device+1].pins > 0;
     }
 
     int64_t& receiveCount()
@@ -136,12 +224,489 @@ public:
         return receive_count_;
     }
 
+    //--------------------------------------------------------------------------
+    /// Returns the known structure of the tile's data.
+    TileStructure structure() const
+    {
+        return structure_;
+    }
+
+    /// Sets the known structure of the tile's data.
+    void structure(TileStructure structure)
+    {
+        structure_ = structure;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Records that device work completing with event reads (modify = false)
+    /// or writes (modify = true) the tile instance at device.
+    /// A null event, meaning the work is complete, is ignored.
+    /// The writer must have waited on the instance's pending events
+    /// (waitEvents with modify = true), so its event supersedes them.
+    void recordEvent(int device, std::shared_ptr< DeviceEvent > const& event,
+                     bool modify)
+    {
+        if (event == nullptr)
+            return;
+        auto& instance = instances_[device+1];
+        if (modify) {
+            instance.write_event = event;
+            instance.read_events.clear();
+        }
+        else {
+            // Drop completed reads, so repeated reads don't accumulate.
+            auto& reads = instance.read_events;
+            reads.erase( std::remove_if( reads.begin(), reads.end(),
+                             [](std::shared_ptr< DeviceEvent > const& e) {
+                                 return e->done();
+                             }),
+                         reads.end() );
+            reads.push_back( event );
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Makes queue wait, without blocking the host, for pending device work
+    /// on the tile instance at device: writes, so queue can read it,
+    /// and if modify, also reads, so queue can overwrite it.
+    void waitEvents(int device, blas::Queue& queue, bool modify) const
+    {
+        auto& instance = instances_[device+1];
+        if (instance.write_event != nullptr)
+            instance.write_event->wait( queue );
+        if (modify) {
+            for (auto& event : instance.read_events)
+                event->wait( queue );
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Blocks the host until pending device work on the tile instance at
+    /// device completes: writes, and if modify, also reads.
+    /// Completed events are dropped.
+    void syncEvents(int device, bool modify)
+    {
+        auto& instance = instances_[device+1];
+        if (instance.write_event != nullptr) {
+            instance.write_event->sync();
+            instance.write_event.reset();
+        }
+        if (modify) {
+            for (auto& event : instance.read_events)
+                event->sync();
+            instance.read_events.clear();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Records that the tile instance at device was used at time tick
+    void touch(int device, int64_t tick)
+    {
+        instances_[device+1].last_use = tick;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Returns time of last use of the tile instance at device
+    int64_t lastUse(int device) const
+    {
+        return instances_[device+1].last_use;
+    }
+
     bool empty() const
     {
         return num_instances_ == 0;
     }
 };
 
+//------------------------------------------------------------------------------
+/// Slab allocator for the tile nodes of a matrix.
+/// Each node is allocated together with its num_devices + 1 instance slots,
+/// and nodes are carved out of slabs of nodes_per_slab nodes, so inserting
+/// tiles doesn't call the heap allocator for each tile.
+/// Freed nodes are recycled; slabs are freed only by the destructor.
+/// Calls must be protected by the owner's tiles-map lock.
+///
+template <typename scalar_t>
+class TileNodePool {
+public:
+    using node_t   = TileNode<scalar_t>;
+    using Instance = typename node_t::Instance;
+
+    static constexpr int64_t nodes_per_slab = 256;
+
+    explicit TileNodePool(int num_devices)
+        : num_devices_( num_devices )
+    {
+        // Instance slots follow the node, each suitably aligned.
+        size_t align = std::max( alignof(node_t), alignof(Instance) );
+        header_size_ = roundup( sizeof(node_t), alignof(Instance) );
+        node_size_ = roundup( header_size_ + (num_devices + 1)*sizeof(Instance),
+                              align );
+        slate_assert( align <= alignof(std::max_align_t) );
+    }
+
+    /// Destructor frees all slabs. All nodes must have been freed.
+    ~TileNodePool()
+    {
+        assert( free_.size() == slabs_.size() * nodes_per_slab );
+    }
+
+    // not copyable or movable, since nodes point into slabs.
+    TileNodePool(TileNodePool&  orig) = delete;
+    TileNodePool(TileNodePool&& orig) = delete;
+    TileNodePool& operator = (TileNodePool&  orig) = delete;
+    TileNodePool& operator = (TileNodePool&& orig) = delete;
+
+    //--------------------------------------------------------------------------
+    /// @return new, empty tile node.
+    node_t* alloc()
+    {
+        if (free_.empty()) {
+            slabs_.emplace_back( new char[ nodes_per_slab * node_size_ ] );
+            char* slab = slabs_.back().get();
+            // Push in reverse so nodes are handed out in address order.
+            for (int64_t k = nodes_per_slab - 1; k >= 0; --k)
+                free_.push_back( slab + k*node_size_ );
+        }
+        char* memory = free_.back();
+        free_.pop_back();
+        return new (memory) node_t( num_devices_, memory + header_size_ );
+    }
+
+    //--------------------------------------------------------------------------
+    /// Destroys node and recycles its memory.
+    void free(node_t* node)
+    {
+        node->~node_t();
+        free_.push_back( reinterpret_cast< char* >( node ) );
+    }
+
+private:
+    static size_t roundup( size_t size, size_t align )
+    {
+        return ((size + align - 1) / align) * align;
+    }
+
+    int num_devices_;
+    size_t header_size_;
+    size_t node_size_;
+    std::vector< std::unique_ptr< char[] > > slabs_;
+    std::vector< char* > free_;
+};
+
+//------------------------------------------------------------------------------
+/// Directory of tile nodes, indexed by global tile indices {i, j}.
+///
+/// For a 2D block-cyclic distribution, the local tiles are kept in a dense
+/// array indexed by local tile indices, so lookups are O(1) arithmetic.
+/// Accesses to the dense slots are protected by lock stripes, which lets
+/// lookups of local tiles proceed without the tiles-map lock.
+/// Remote tiles, and all tiles of irregular distributions, are kept in a
+/// std::map fallback; its accesses must be protected by the owner's
+/// tiles-map lock, as must all modifications and iteration.
+///
+template <typename node_t>
+class TileDirectory {
+public:
+    using ij_tuple   = std::tuple<int64_t, int64_t>;
+    using Map        = std::map< ij_tuple, node_t* >;
+    using value_type = typename Map::value_type;
+
+    static constexpr int num_stripes = 64;
+
+    //--------------------------------------------------------------------------
+    /// Iterates over the dense slots that have a node, then over the map.
+    /// Like std::map, erasing another entry does not invalidate an iterator.
+    class iterator {
+    public:
+        value_type& operator * () const
+        {
+            return (index_ < dir_->dense_.size() ? dir_->dense_[ index_ ]
+                                                 : *map_iter_);
+        }
+
+        value_type* operator -> () const
+        {
+            return &(**this);
+        }
+
+        iterator& operator ++ ()
+        {
+            if (index_ < dir_->dense_.size()) {
+                ++index_;
+                skipEmpty();
+            }
+            else {
+                ++map_iter_;
+            }
+            return *this;
+        }
+
+        iterator operator ++ (int)
+        {
+            iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator == (iterator const& other) const
+        {
+            return index_ == other.index_
+                   && (index_ < dir_->dense_.size()
+                       || map_iter_ == other.map_iter_);
+        }
+
+        bool operator != (iterator const& other) const
+        {
+            return ! (*this == other);
+        }
+
+    private:
+        friend class TileDirectory;
+
+        iterator(TileDirectory* dir, size_t index,
+                 typename Map::iterator map_iter)
+            : dir_( dir ),
+              index_( index ),
+              map_iter_( map_iter )
+        {}
+
+        /// Advances past dense slots without a node.
+        /// At the end of the dense slots, moves to the start of the map.
+        void skipEmpty()
+        {
+            while (index_ < dir_->dense_.size()
+                   && dir_->dense_[ index_ ].second == nullptr)
+                ++index_;
+            if (index_ >= dir_->dense_.size())
+                map_iter_ = dir_->map_.begin();
+        }
+
+        TileDirectory* dir_;
+        size_t index_;
+        typename Map::iterator map_iter_;
+    };
+
+    //--------------------------------------------------------------------------
+    TileDirectory()
+        : mt_( 0 ), nt_( 0 ), p_( 1 ), q_( 1 ),
+          my_row_( -1 ), my_col_( -1 ), mt_local_( 0 ),
+          num_dense_( 0 )
+    {
+        for (int k = 0; k < num_stripes; ++k)
+            omp_init_nest_lock( &stripes_[ k ] );
+    }
+
+    ~TileDirectory()
+    {
+        for (int k = 0; k < num_stripes; ++k)
+            omp_destroy_nest_lock( &stripes_[ k ] );
+    }
+
+    // not copyable or movable, since the locks are not.
+    TileDirectory(TileDirectory&  orig) = delete;
+    TileDirectory(TileDirectory&& orig) = delete;
+    TileDirectory& operator = (TileDirectory&  orig) = delete;
+    TileDirectory& operator = (TileDirectory&& orig) = delete;
+
+    //--------------------------------------------------------------------------
+    /// Enables the dense directory for the local tiles of an mt-by-nt
+    /// matrix with a p-by-q 2D block-cyclic distribution.
+    /// Must be called before any tiles are inserted.
+    ///
+    /// @param[in] mt, nt
+    ///     Number of block rows and block columns.
+    ///
+    /// @param[in] order
+    ///     Order that MPI processes are mapped to the p-by-q grid.
+    ///
+    /// @param[in] p, q
+    ///     Process grid dimensions.
+    ///
+    /// @param[in] mpi_rank
+    ///     This process's MPI rank.
+    ///
+    void initDense( int64_t mt, int64_t nt, GridOrder order, int p, int q,
+                    int mpi_rank )
+    {
+        assert( size() == 0 );
+        if (mpi_rank >= p*q)
+            return;  // no local tiles
+
+        mt_ = mt;
+        nt_ = nt;
+        p_  = p;
+        q_  = q;
+        if (order == GridOrder::Col) {
+            my_row_ = mpi_rank % p;
+            my_col_ = mpi_rank / p;
+        }
+        else {
+            my_row_ = mpi_rank / q;
+            my_col_ = mpi_rank % q;
+        }
+        mt_local_ = (my_row_ < mt ? ceildiv( mt - my_row_, int64_t( p ) ) : 0);
+        int64_t nt_local
+            = (my_col_ < nt ? ceildiv( nt - my_col_, int64_t( q ) ) : 0);
+
+        // Keys are fixed when the slots are created; only nodes change.
+        dense_.reserve( mt_local_ * nt_local );
+        for (int64_t jj = 0; jj < nt_local; ++jj) {
+            for (int64_t ii = 0; ii < mt_local_; ++ii) {
+                dense_.emplace_back( ij_tuple( ii*p_ + my_row_, jj*q_ + my_col_ ),
+                                     nullptr );
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return whether tile {i, j} is stored in the dense directory.
+    bool isDense( ij_tuple ij ) const
+    {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return ! dense_.empty()
+               && 0 <= i && i < mt_ && 0 <= j && j < nt_
+               && i % p_ == my_row_ && j % q_ == my_col_;
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return iterator to tile node {i, j}, or end() if not found.
+    iterator find( ij_tuple ij )
+    {
+        if (isDense( ij )) {
+            size_t index = slot( ij );
+            LockGuard guard( stripeLock( index ) );
+            if (dense_[ index ].second != nullptr)
+                return iterator( this, index, map_.end() );
+            else
+                return end();
+        }
+        return iterator( this, dense_.size(), map_.find( ij ) );
+    }
+
+    iterator begin()
+    {
+        iterator iter( this, 0, map_.end() );
+        iter.skipEmpty();
+        return iter;
+    }
+
+    iterator end()
+    {
+        return iterator( this, dense_.size(), map_.end() );
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return pointer to tile node {i, j}, or nullptr if it doesn't exist.
+    node_t* get( ij_tuple ij )
+    {
+        if (isDense( ij )) {
+            size_t index = slot( ij );
+            LockGuard guard( stripeLock( index ) );
+            return dense_[ index ].second;
+        }
+        auto iter = map_.find( ij );
+        return (iter == map_.end() ? nullptr : iter->second);
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return reference to tile node {i, j}.
+    /// Throws std::out_of_range if it doesn't exist.
+    node_t& at( ij_tuple ij )
+    {
+        node_t* node = get( ij );
+        if (node == nullptr)
+            throw std::out_of_range( "TileDirectory::at" );
+        return *node;
+    }
+
+    //--------------------------------------------------------------------------
+    /// Inserts or replaces tile node {i, j}.
+    /// The directory doesn't own nodes; see TileNodePool.
+    void insert( ij_tuple ij, node_t* node )
+    {
+        if (isDense( ij )) {
+            size_t index = slot( ij );
+            LockGuard guard( stripeLock( index ) );
+            if (dense_[ index ].second == nullptr)
+                ++num_dense_;
+            dense_[ index ].second = node;
+        }
+        else {
+            map_[ ij ] = node;
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    /// Removes tile node {i, j}, if it exists.
+    /// @return number of nodes removed (0 or 1).
+    size_t erase( ij_tuple ij )
+    {
+        if (isDense( ij )) {
+            size_t index = slot( ij );
+            LockGuard guard( stripeLock( index ) );
+            if (dense_[ index ].second == nullptr)
+                return 0;
+            dense_[ index ].second = nullptr;
+            --num_dense_;
+            return 1;
+        }
+        return map_.erase( ij );
+    }
+
+    /// @return number of tile nodes.
+    size_t size() const
+    {
+        return num_dense_ + map_.size();
+    }
+
+private:
+    /// @return index of dense slot for local tile {i, j}.
+    size_t slot( ij_tuple ij ) const
+    {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return (j / q_) * mt_local_ + (i / p_);
+    }
+
+    omp_nest_lock_t* stripeLock( size_t index )
+    {
+        return &stripes_[ index % num_stripes ];
+    }
+
+    // dense directory of local tiles, in local column-major order
+    std::vector< value_type > dense_;
+    int64_t mt_, nt_;
+    int p_, q_;
+    int64_t my_row_, my_col_;
+    int64_t mt_local_;
+    std::atomic<int64_t> num_dense_;
+
+    // fallback for remote tiles and irregular distributions
+    Map map_;
+
+    mutable omp_nest_lock_t stripes_[ num_stripes ];
+};
+
+//------------------------------------------------------------------------------
+/// Counters of a matrix's tile transfers between host and devices, made by
+/// tileGet on MOSI misses, and of the state changes and layout conversions
+/// that go with them.
+/// @see BaseMatrix::transferStats
+///
+struct TransferStats {
+    int64_t h2d_bytes = 0;          ///< bytes copied host to device
+    int64_t d2h_bytes = 0;          ///< bytes copied device to host
+    int64_t d2d_bytes = 0;          ///< bytes copied device to device
+    int64_t h2d_count = 0;          ///< tiles copied host to device
+    int64_t d2h_count = 0;          ///< tiles copied device to host
+    int64_t d2d_count = 0;          ///< tiles copied device to device
+    int64_t mosi_transitions = 0;   ///< tile instances made valid by a copy,
+                                    ///< or made Invalid by a write elsewhere
+    int64_t layout_conversions = 0; ///< ColMajor <=> RowMajor conversions
+};
+
 //------------------------------------------------------------------------------
 /// Slate::MatrixStorage class
 /// Used to store the map of distributed tiles.
@@ -157,7 +722,7 @@ public:
 
     using ijdev_tuple = std::tuple<int64_t, int64_t, int>;
     using ij_tuple    = std::tuple<int64_t, int64_t>;
-    using TilesMap = std::map< ij_tuple, std::shared_ptr<TileNode_t> >;
+    using TilesMap = TileDirectory<TileNode_t>;
 
     MatrixStorage( int64_t m, int64_t n, int64_t mb, int64_t nb,
                    GridOrder order, int p, int q, MPI_Comm mpi_comm );
@@ -213,12 +778,71 @@ public:
         return compute_queues_.at( queue_index ).at( device );
     }
 
+    /// @return BLAS++ queue used to allocate memory on device.
+    /// For host, returns a queue used to allocate pinned memory,
+    /// or nullptr if the matrix doesn't use devices, e.g., in CPU-only
+    /// runs on a node with GPUs, so host memory isn't pinned needlessly.
+    ///
+    /// @param[in] device
+    ///     Tile's device ID, which can be host.
+    lapack::Queue* memory_queue( int device )
+    {
+        if (device == HostNum)
+            return (uses_devices_ ? comm_queues_[ 0 ] : nullptr);
+        else
+            return comm_queues_.at( device );
+    }
+
+    /// @return BLAS++ queue used to free host memory, which may be pinned,
+    /// or nullptr if there are no devices.
+    lapack::Queue* host_free_queue()
+    {
+        return (num_devices() > 0 ? comm_queues_[ 0 ] : nullptr);
+    }
+
     /// @return number of allocated BLAS++ compute queues
     int num_compute_queues()
     {
         return int(compute_queues_.size());
     }
 
+    void setMathMode( MathMode mode );
+
+    /// @return math mode of the compute queues.
+    MathMode mathMode() const
+    {
+        return math_mode_;
+    }
+
+    //--------------------------------------------------------------------------
+    // tile precisions
+    /// Sets the precision tile {i, j} is stored and updated in.
+    /// Not thread safe; set before tasks that read it.
+    void setTilePrecision( ij_tuple ij, TilePrecision precision )
+    {
+        if (precision == TilePrecision::Full)
+            tile_precisions_.erase( ij );
+        else
+            tile_precisions_[ ij ] = precision;
+    }
+
+    /// @return precision tile {i, j} is stored and updated in;
+    /// Full unless set otherwise.
+    TilePrecision tilePrecision( ij_tuple ij ) const
+    {
+        auto iter = tile_precisions_.find( ij );
+        if (iter == tile_precisions_.end())
+            return TilePrecision::Full;
+        else
+            return iter->second;
+    }
+
+    /// Resets all tiles to TilePrecision::Full.
+    void clearTilePrecisions()
+    {
+        tile_precisions_.clear();
+    }
+
     //--------------------------------------------------------------------------
     // batch arrays
     void allocateBatchArrays(int64_t batch_size, int64_t num_arrays);
@@ -244,6 +868,22 @@ public:
         return array_dev_.at( batch_arrays_index ).at( device );
     }
 
+    //--------------------------------------------------------------------------
+    // compute queue pool
+    /// A compute queue and its batch arrays on one device, leased from the
+    /// pool by acquireComputeQueue() and returned by releaseComputeQueue().
+    struct PooledQueue {
+        lapack::Queue* queue = nullptr;
+        scalar_t** array_host = nullptr;
+        scalar_t** array_dev = nullptr;
+        int64_t batch_size = 0;
+        int index = 0;      ///< position in the device's pool
+        bool busy = false;
+    };
+
+    PooledQueue* acquireComputeQueue( int device );
+    void releaseComputeQueue( PooledQueue* pooled );
+
     //--------------------------------------------------------------------------
     // workspace
     void reserveHostWorkspace(int64_t num_tiles);
@@ -253,9 +893,235 @@ public:
     void releaseWorkspace();
 
     scalar_t* allocWorkspaceBuffer(int device, int size);
+    scalar_t* tryAllocWorkspaceBuffer(int device, int size);
     void      releaseWorkspaceBuffer(scalar_t* data, int device);
 
+    void attachWorkspace(Workspace* workspace);
+    void detachWorkspace();
+
+    /// @return workspace arena that matrix is attached to, or null.
+    Workspace* workspace() const
+    {
+        return workspace_;
+    }
+
+    /// @return communication plan of the attached workspace arena, or null.
+    CommPlan* commPlan() const
+    {
+        return workspace_ != nullptr ? workspace_->commPlan() : nullptr;
+    }
+
+    /// @return node-shared memory of the attached workspace arena, or null;
+    /// see Workspace::enableNodeShared.
+    NodeSharedPool* nodeSharedPool() const
+    {
+        return workspace_ != nullptr ? workspace_->nodeSharedPool() : nullptr;
+    }
+
+    //--------------------------------------------------------------------------
+    // memory pool
+    void useSharedMemory();
+
+    /// @return true if matrix allocates from a shared pool, Memory::shared().
+    bool usesSharedMemory() const
+    {
+        return memory_ != &own_memory_;
+    }
+
+    /// @return size in bytes of the blocks of the pool in use.
+    size_t memoryBlockSize() const
+    {
+        return memory_->blockSize();
+    }
+
+    /// @return number of blocks currently allocated by this matrix on
+    /// device, which can be host, whether its pool is shared or its own.
+    int64_t memoryUsed(int device) const
+    {
+        return memory_used_.at( device+1 );
+    }
+
+    /// @return max number of blocks allocated at once by this matrix on
+    /// device, which can be host, since creation or memoryPeakReset.
+    int64_t memoryPeak(int device) const
+    {
+        int64_t peak;
+        #pragma omp critical(slate_memory_peak)
+        peak = memory_peak_.at( device+1 );
+        return peak;
+    }
+
+    /// Resets the matrix's peaks on all devices to the current usage.
+    void memoryPeakReset()
+    {
+        #pragma omp critical(slate_memory_peak)
+        {
+            for (size_t i = 0; i < memory_peak_.size(); ++i)
+                memory_peak_[ i ] = memory_used_[ i ];
+        }
+    }
+
+    /// @return usage counters of the matrix's memory pool on device,
+    /// which can be host. For a shared pool, they include other matrices.
+    MemoryStats memoryStats(int device) const
+    {
+        return memory_->stats( device );
+    }
+
+    /// @return max number of blocks the matrix can allocate on each device.
+    int64_t memoryQuota() const
+    {
+        return memory_quota_;
+    }
+
+    /// Sets max number of blocks the matrix can allocate on each device,
+    /// including host. Allocating beyond it throws an error.
+    void memoryQuota(int64_t quota)
+    {
+        slate_assert( quota >= 0 );
+        memory_quota_ = quota;
+    }
+
+    //--------------------------------------------------------------------------
+    // eviction
+    int64_t evictDeviceTiles(int device, int64_t num_blocks);
+
+    /// @return high-water mark, in blocks, of each device's pool,
+    /// above which tiles are evicted; 0 if eviction is disabled.
+    int64_t deviceHighWater() const
+    {
+        return high_water_;
+    }
+
+    /// Sets high-water mark, in blocks, of each device's pool. When getting
+    /// tiles on a device would grow its pool above it, least-recently-used
+    /// workspace tiles are evicted from the device first.
+    /// 0 disables eviction (default).
+    void deviceHighWater(int64_t num_blocks)
+    {
+        slate_assert( num_blocks >= 0 );
+        high_water_ = num_blocks;
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return whether tiles' Zero and Identity structure is recorded.
+    bool trackTileStructure() const
+    {
+        return track_structure_;
+    }
+
+    /// Sets whether tiles' Zero and Identity structure is recorded.
+    void trackTileStructure(bool track)
+    {
+        track_structure_ = track;
+    }
+
+    //--------------------------------------------------------------------------
+    // transfer accounting
+
+    /// Counts a copy of tile {i, j}, of bytes, from src_device to dst_device.
+    void countTransfer( ij_tuple ij, int src_device, int dst_device,
+                        int64_t bytes )
+    {
+        if (src_device == HostNum) {
+            transfers_.h2d_bytes += bytes;
+            transfers_.h2d_count += 1;
+        }
+        else if (dst_device == HostNum) {
+            transfers_.d2h_bytes += bytes;
+            transfers_.d2h_count += 1;
+        }
+        else {
+            transfers_.d2d_bytes += bytes;
+            transfers_.d2d_count += 1;
+        }
+        if (heat_map_) {
+            #pragma omp critical(slate_transfer_heat)
+            transfer_heat_[ ij ] += 1;
+        }
+    }
+
+    /// Counts num changes of tile instances between valid and Invalid.
+    void countTransitions( int64_t num )
+    {
+        transfers_.mosi_transitions += num;
+    }
+
+    /// Counts a layout conversion.
+    void countLayoutConversion()
+    {
+        transfers_.layout_conversions += 1;
+    }
+
+    /// @return snapshot of the transfer counters.
+    TransferStats transferStats() const
+    {
+        TransferStats stats;
+        stats.h2d_bytes          = transfers_.h2d_bytes;
+        stats.d2h_bytes          = transfers_.d2h_bytes;
+        stats.d2d_bytes          = transfers_.d2d_bytes;
+        stats.h2d_count          = transfers_.h2d_count;
+        stats.d2h_count          = transfers_.d2h_count;
+        stats.d2d_count          = transfers_.d2d_count;
+        stats.mosi_transitions   = transfers_.mosi_transitions;
+        stats.layout_conversions = transfers_.layout_conversions;
+        return stats;
+    }
+
+    /// Resets the transfer counters and the heat map to zero.
+    void transferStatsReset()
+    {
+        transfers_.h2d_bytes          = 0;
+        transfers_.d2h_bytes          = 0;
+        transfers_.d2d_bytes          = 0;
+        transfers_.h2d_count          = 0;
+        transfers_.d2h_count          = 0;
+        transfers_.d2d_count          = 0;
+        transfers_.mosi_transitions   = 0;
+        transfers_.layout_conversions = 0;
+        #pragma omp critical(slate_transfer_heat)
+        transfer_heat_.clear();
+    }
+
+    /// Enables or disables counting transfers per tile. Default disabled.
+    void transferHeatMap( bool enable )
+    {
+        heat_map_ = enable;
+    }
+
+    /// @return number of transfers of each tile, by global index,
+    /// counted while the heat map was enabled.
+    std::map< ij_tuple, int64_t > transferHeat() const
+    {
+        std::map< ij_tuple, int64_t > heat;
+        #pragma omp critical(slate_transfer_heat)
+        heat = transfer_heat_;
+        return heat;
+    }
+
+    /// @return next time on the clock for least-recently-used eviction.
+    int64_t lruTick()
+    {
+        return ++lru_clock_;
+    }
+
+    /// Records a use of tile {i, j} on device, for least-recently-used
+    /// eviction. The tile must exist.
+    void tileTouch(ijdev_tuple ijdev)
+    {
+        int64_t i  = std::get<0>(ijdev);
+        int64_t j  = std::get<1>(ijdev);
+        int device = std::get<2>(ijdev);
+        at({i, j}).touch( device, ++lru_clock_ );
+    }
+
 private:
+    void* allocMemory(int device, size_t size, blas::Queue* queue,
+                      int numa_node=-1);
+    void  freeMemory(void* block, int device);
+    void  releaseMemory();
+    int64_t reserveCount(int device, int64_t num_tiles) const;
+
     // Iterator routines should be called only within a Tiles Map LockGuard.
     // Otherwise, there may be race conditions with the returned iterator.
 
@@ -298,11 +1164,16 @@ public:
     //--------------------------------------------------------------------------
     /// @return reference to TileNode(i, j).
     /// Throws exception if entry doesn't exist.
-    // at() doesn't create new (null) entries in map as operator[] would
+    // at() doesn't create new (null) entries in map as operator[] would.
+    // Local tiles of a 2D block-cyclic matrix are found in the dense
+    // directory, which doesn't need the tiles-map lock.
     TileNode_t& at(ij_tuple ij)
     {
+        if (tiles_.isDense( ij ))
+            return tiles_.at( ij );
+
         LockGuard guard(getTilesMapLock());
-        return *(tiles_.at(ij));
+        return tiles_.at(ij);
     }
 
     /// @return pointer to an actual Tile object
@@ -323,11 +1194,20 @@ public:
     void erase(ij_tuple ij);
     void release(ijdev_tuple ijdev);
 private:
-    void release(typename TilesMap::iterator iter, int device);
+    void release(typename TilesMap::iterator iter, int device,
+                 bool keep_pinned);
+    void eraseInstance(TileNode<scalar_t>& tile_node, int device);
 public:
     void freeTileMemory(Tile<scalar_t>* tile);
     void clear();
 
+    //--------------------------------------------------------------------------
+    /// @return cache of sub-communicators, freed with the storage.
+    internal::CommCache& commCache()
+    {
+        return comm_cache_;
+    }
+
     //--------------------------------------------------------------------------
     /// Return pointer to tiles-map OMP lock
     omp_nest_lock_t* getTilesMapLock()
@@ -335,17 +1215,79 @@ public:
         return &lock_;
     }
 
-    //--------------------------------------------------------------------------
-    std::function<int64_t (int64_t i)> tileMb;
-    std::function<int64_t (int64_t j)> tileNb;
-    std::function<int (ij_tuple ij)> tileRank;
-    std::function<int (ij_tuple ij)> tileDevice;
-
+    //--------------------------------------------------------------------------
+    std::function<int64_t (int64_t i)> tileMb;
+    std::function<int64_t (int64_t j)> tileNb;
+    std::function<int (ij_tuple ij)> tileRank;
+    std::function<int (ij_tuple ij)> tileDevice;
+    /// NUMA node of host tiles, used if host_numa_placement() is set.
+    std::function<int (ij_tuple ij)> tileNumaNode;
+
+    //--------------------------------------------------------------------------
+    /// Uniform tile sizes and 2D block-cyclic distribution, set by the
+    /// constructor from m, n, mb, nb, order, p, q. The tileMbAt, tileNbAt,
+    /// tileRankAt, tileDeviceAt accessors compute it inline when valid,
+    /// instead of an indirect call of the functions above, which prevents
+    /// inlining in the inner loops of drivers, e.g., tileIsLocal.
+    /// The functions stay, and give the same results, for tileMbFunc(), etc.
+    struct UniformGrid {
+        int64_t m = 0, n = 0, mb = 0, nb = 0;
+        int p = 1, q = 1;
+        GridOrder order = GridOrder::Unknown;
+        int num_devices = 0;
+        bool valid = false;
+    };
+
+    /// @return uniform grid; valid only if set by the constructor.
+    UniformGrid const& uniformGrid() const
+    {
+        return grid_;
+    }
+
+    /// @return number of rows in block row i, as tileMb( i ).
+    int64_t tileMbAt(int64_t i) const
+    {
+        if (grid_.valid)
+            return (i + 1)*grid_.mb > grid_.m ? grid_.m % grid_.mb : grid_.mb;
+        return tileMb( i );
+    }
+
+    /// @return number of cols in block col j, as tileNb( j ).
+    int64_t tileNbAt(int64_t j) const
+    {
+        if (grid_.valid)
+            return (j + 1)*grid_.nb > grid_.n ? grid_.n % grid_.nb : grid_.nb;
+        return tileNb( j );
+    }
+
+    /// @return MPI rank of tile {i, j}, as tileRank( ij ).
+    int tileRankAt(ij_tuple ij) const
+    {
+        if (grid_.valid) {
+            int64_t i = std::get<0>( ij ) % grid_.p;
+            int64_t j = std::get<1>( ij ) % grid_.q;
+            return int( grid_.order == GridOrder::Col ? i + j*grid_.p
+                                                      : i*grid_.q + j );
+        }
+        return tileRank( ij );
+    }
+
+    /// @return device of tile {i, j}, as tileDevice( ij ).
+    int tileDeviceAt(ij_tuple ij) const
+    {
+        if (grid_.valid) {
+            if (grid_.num_devices == 0)
+                return HostNum;
+            return int( (std::get<1>( ij ) / grid_.q) % grid_.num_devices );
+        }
+        return tileDevice( ij );
+    }
+
     //--------------------------------------------------------------------------
     /// @return whether tile {i, j} is local.
-    bool tileIsLocal(ij_tuple ij)
+    bool tileIsLocal(ij_tuple ij) const
     {
-        return tileRank(ij) == mpi_rank_;
+        return tileRankAt(ij) == mpi_rank_;
     }
 
     Tile<scalar_t>* tileInsert(
@@ -353,17 +1295,31 @@ public:
     Tile<scalar_t>* tileInsert(
         ijdev_tuple ijdev, scalar_t* data, int64_t lda,
         Layout layout=Layout::ColMajor);
+    Tile<scalar_t>* tileInsertLazy(
+        ijdev_tuple ijdev, Layout layout=Layout::ColMajor);
 private:
     Tile<scalar_t>* tileInsert(
         ijdev_tuple ijdev, scalar_t* data, int64_t lda,
-        TileKind kind, Layout layout);
+        TileKind kind, Layout layout, bool lazy=false);
 public:
+    void tileMaterialize(TileNode<scalar_t>& tile_node, int device, bool zero);
+    Tile<scalar_t>* tileInsertNodeShared(
+        ij_tuple ij, scalar_t* data, Layout layout, NodeSharedPool* pool);
+    void tilePrivatize(Tile<scalar_t>* tile, bool copy);
+
     bool tileExists( ijdev_tuple ijdev )
     {
-        LockGuard guard( getTilesMapLock() );
         int64_t i  = std::get<0>(ijdev);
         int64_t j  = std::get<1>(ijdev);
         int device = std::get<2>(ijdev);
+        if (tiles_.isDense( {i, j} )) {
+            // Dense directory doesn't need the tiles-map lock.
+            TileNode_t* tile_node = tiles_.get( {i, j} );
+            return tile_node != nullptr
+                   && (device == AnyDevice || tile_node->existsOn( device ));
+        }
+
+        LockGuard guard( getTilesMapLock() );
         if (device == AnyDevice) {
             return find( {i, j} ) != end();
         }
@@ -380,7 +1336,7 @@ public:
     int64_t tileReceiveCount(ij_tuple ij)
     {
         LockGuard guard( getTilesMapLock() );
-        return tiles_.at( ij )->receiveCount();
+        return tiles_.at( ij ).receiveCount();
     }
 
     //--------------------------------------------------------------------------
@@ -388,7 +1344,7 @@ public:
     void tileIncrementReceiveCount(ij_tuple ij)
     {
         LockGuard guard( getTilesMapLock() );
-        tiles_.at( ij )->receiveCount()++;
+        tiles_.at( ij ).receiveCount()++;
     }
 
     //--------------------------------------------------------------------------
@@ -396,7 +1352,7 @@ public:
     void tileDecrementReceiveCount( ij_tuple ij, int64_t release_count = 1 )
     {
         LockGuard guard( getTilesMapLock() );
-        tiles_.at( ij )->receiveCount() -= release_count;
+        tiles_.at( ij ).receiveCount() -= release_count;
     }
 
     /// Ensures the tile node exists and increments the recieve count.
@@ -450,28 +1406,83 @@ public:
         if (iter != end()) {
             int device = std::get<2>(ijdev);
             iter->second->at(device)->state(~MOSI::OnHold);
+            iter->second->unpin( device );
         }
     }
 
 private:
     TilesMap tiles_;        ///< map of tiles and associated states
+    TileNodePool<scalar_t> node_pool_;  ///< allocator for tile nodes
     mutable omp_nest_lock_t lock_;  ///< TilesMap lock
-    slate::Memory memory_;  ///< memory allocator
+    slate::Memory own_memory_;  ///< matrix's own memory allocator
+    slate::Memory* memory_;     ///< allocator in use: own, or a shared pool
+
+    // number of blocks allocated by matrix, indexed by device+1
+    std::vector< int64_t > memory_used_;
+    // max of memory_used_, in critical(slate_memory_peak)
+    std::vector< int64_t > memory_peak_;
+    // max number of blocks matrix can allocate on each device
+    int64_t memory_quota_;
+    // high-water mark of device pools for eviction, or 0
+    int64_t high_water_;
+    // whether set() and copy() record tiles' structure, for kernels to skip
+    bool track_structure_;
+    // clock for least-recently-used eviction, incremented at each tile use
+    std::atomic<int64_t> lru_clock_;
+    // whether matrix has used device memory; if so, host blocks are pinned
+    std::atomic<bool> uses_devices_;
+
+    // host-device transfer counters, updated by concurrent tileGet calls
+    struct {
+        std::atomic<int64_t> h2d_bytes{ 0 };
+        std::atomic<int64_t> d2h_bytes{ 0 };
+        std::atomic<int64_t> d2d_bytes{ 0 };
+        std::atomic<int64_t> h2d_count{ 0 };
+        std::atomic<int64_t> d2h_count{ 0 };
+        std::atomic<int64_t> d2d_count{ 0 };
+        std::atomic<int64_t> mosi_transitions{ 0 };
+        std::atomic<int64_t> layout_conversions{ 0 };
+    } transfers_;
+    // transfers per tile, by global index, if heat_map_
+    bool heat_map_ = false;
+    std::map< ij_tuple, int64_t > transfer_heat_;
 
     int mpi_rank_;
 
+    // set only by the uniform constructor; see tileRankAt, etc.
+    UniformGrid grid_;
+
     int64_t batch_array_size_;
 
     // BLAS++ communication queues
     std::vector< lapack::Queue* > comm_queues_;
     // BLAS++ compute queues
     std::vector< std::vector< lapack::Queue* > > compute_queues_;
+    // math mode of compute queues, also set on queues allocated later
+    MathMode math_mode_;
+
+    // tiles stored in other than the matrix's precision, by global index
+    std::map< ij_tuple, TilePrecision > tile_precisions_;
 
     // host pointers arrays for batch GEMM
     std::vector< std::vector< scalar_t** > > array_host_;
 
     // device pointers arrays for batch GEMM
     std::vector< std::vector< scalar_t** > > array_dev_;
+
+    // pool of compute queues, with their batch arrays, per device;
+    // deque so entries don't move as the pool grows
+    std::vector< std::deque< PooledQueue > > queue_pool_;
+    std::mutex queue_pool_mutex_;
+
+    // workspace arena attached during a driver, or null
+    Workspace* workspace_;
+
+    // pool that NodeShared tiles' memory belongs to, or null
+    NodeSharedPool* node_shared_pool_;
+
+    // sub-communicators, e.g., of panels
+    internal::CommCache comm_cache_;
 };
 
 //------------------------------------------------------------------------------
@@ -480,8 +1491,20 @@ MatrixStorage<scalar_t>::MatrixStorage(
     int64_t m, int64_t n, int64_t mb, int64_t nb,
     GridOrder order, int p, int q, MPI_Comm mpi_comm)
     : tiles_(),
-      memory_(sizeof(scalar_t) * mb * nb),  // block size in bytes
-      batch_array_size_(0)
+      node_pool_(num_devices()),
+      own_memory_(sizeof(scalar_t) * mb * nb),  // block size in bytes
+      memory_(&own_memory_),
+      memory_used_(num_devices() + 1, 0),
+      memory_peak_(num_devices() + 1, 0),
+      memory_quota_(std::numeric_limits<int64_t>::max()),
+      high_water_(0),
+      track_structure_(false),
+      lru_clock_(0),
+      uses_devices_(false),
+      batch_array_size_(0),
+      math_mode_(MathMode::Default),
+      workspace_(nullptr),
+      node_shared_pool_(nullptr)
 {
     slate_mpi_call(
         MPI_Comm_rank(mpi_comm, &mpi_rank_));
@@ -509,9 +1532,32 @@ MatrixStorage<scalar_t>::MatrixStorage(
             return HostNum;
         };
     }
+    // function for computing the host tile's NUMA node,
+    // assuming 1d block cyclic, as for devices
+    tileNumaNode = func::device_1d_grid( GridOrder::Row, q,
+                                         Memory::num_numa_nodes_ );
+
+    if (mb > 0 && nb > 0) {
+        tiles_.initDense( ceildiv( m, mb ), ceildiv( n, nb ), order, p, q,
+                          mpi_rank_ );
+
+        // Same distribution as the functions above, for inline lookups.
+        grid_.m = m;
+        grid_.n = n;
+        grid_.mb = mb;
+        grid_.nb = nb;
+        grid_.p = p;
+        grid_.q = q;
+        grid_.order = order;
+        grid_.num_devices = num_devices();
+        grid_.valid = true;
+    }
 
     initQueues();
     omp_init_nest_lock(&lock_);
+
+    if (shared_memory_pool())
+        useSharedMemory();
 }
 
 //------------------------------------------------------------------------------
@@ -529,15 +1575,44 @@ MatrixStorage<scalar_t>::MatrixStorage(
       tileRank(inTileRank),
       tileDevice(inTileDevice),
       tiles_(),
-      memory_(sizeof(scalar_t) * func::max_blocksize(mt, inTileMb) // block size in bytes
-                               * func::max_blocksize(nt, inTileNb)),
-      batch_array_size_(0)
+      node_pool_(num_devices()),
+      own_memory_(sizeof(scalar_t) * func::max_blocksize(mt, inTileMb) // block size in bytes
+                                   * func::max_blocksize(nt, inTileNb)),
+      memory_(&own_memory_),
+      memory_used_(num_devices() + 1, 0),
+      memory_peak_(num_devices() + 1, 0),
+      memory_quota_(std::numeric_limits<int64_t>::max()),
+      high_water_(0),
+      track_structure_(false),
+      lru_clock_(0),
+      uses_devices_(false),
+      batch_array_size_(0),
+      math_mode_(MathMode::Default),
+      workspace_(nullptr),
+      node_shared_pool_(nullptr)
 {
     slate_mpi_call(
         MPI_Comm_rank(mpi_comm, &mpi_rank_));
 
+    // Use dense tile directory if tileRank is a 2D block-cyclic grid.
+    GridOrder order;
+    int p, q;
+    if (func::is_2d_cyclic_grid( mt, nt, tileRank, &order, &p, &q )) {
+        tiles_.initDense( mt, nt, order, p, q, mpi_rank_ );
+    }
+    else {
+        q = 1;
+    }
+    // function for computing the host tile's NUMA node,
+    // assuming 1d block cyclic, as for devices
+    tileNumaNode = func::device_1d_grid( GridOrder::Row, q,
+                                         Memory::num_numa_nodes_ );
+
     initQueues();
     omp_init_nest_lock(&lock_);
+
+    if (shared_memory_pool())
+        useSharedMemory();
 }
 
 //------------------------------------------------------------------------------
@@ -549,11 +1624,14 @@ MatrixStorage<scalar_t>::~MatrixStorage()
     try {
         clear();
         clearBatchArrays();
-        // Clear all host and device memory allocations
-        memory_.clearHostBlocks();
+        // Clear all host and device memory allocations.
+        // A shared pool is freed only if no other matrix uses it.
+        if (memory_ != &own_memory_)
+            releaseMemory();
+        own_memory_.clearHostBlocks( host_free_queue() );
         for (int device = 0; device < num_devices(); ++device) {
             blas::Queue* queue = comm_queues_[device];
-            memory_.clearDeviceBlocks(device, queue);
+            own_memory_.clearDeviceBlocks(device, queue);
         }
         destroyQueues(); // must occur after clearBatchArrays
         omp_destroy_nest_lock(&lock_);
@@ -567,30 +1645,76 @@ MatrixStorage<scalar_t>::~MatrixStorage()
 
 //------------------------------------------------------------------------------
 /// Initializes BLAS++ compute and communcation queues on each device.
+/// The communication queue and compute queue 0 are the process-wide
+/// shared queues (see DeviceQueues), so constructing a matrix doesn't
+/// create streams and handles, and work on tiles of different matrices
+/// is ordered on the same streams.
 /// Also initializes the host and device batch arrays.
 /// Called in constructor.
 ///
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::initQueues()
 {
+    DeviceQueues::attach();
+
     comm_queues_.resize(num_devices());
 
     compute_queues_.resize(1);
     compute_queues_.at(0).resize(num_devices(), nullptr);
     for (int device = 0; device < num_devices(); ++device) {
-        comm_queues_        [ device ] = new lapack::Queue( device );
-        compute_queues_[ 0 ][ device ] = new lapack::Queue( device );
+        comm_queues_        [ device ] = DeviceQueues::comm_queue( device );
+        compute_queues_[ 0 ][ device ] = DeviceQueues::compute_queue( device );
     }
+    if (num_devices() > 1)
+        enable_peer_access();
 
     array_host_.resize(1);
     array_dev_ .resize(1);
 
     array_host_.at(0).resize(num_devices(), nullptr);
     array_dev_ .at(0).resize(num_devices(), nullptr);
+
+    queue_pool_.resize(num_devices());
+}
+
+//------------------------------------------------------------------------------
+/// Sets the math mode of all compute queues, on each device, including
+/// queues allocated later by allocateBatchArrays. For instance,
+/// MathMode::TF32 lets single precision gemm, and hence the trailing
+/// matrix updates of factorizations, use tensor cores.
+/// Shared compute queues, which other matrices use, are first replaced
+/// by queues of this matrix, after their pending work.
+///
+/// @param[in] mode
+///     The math mode.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::setMathMode( MathMode mode )
+{
+    math_mode_ = mode;
+    for (auto& queues : compute_queues_) {
+        for (int device = 0; device < int( queues.size() ); ++device) {
+            lapack::Queue*& queue = queues[ device ];
+            if (mode != MathMode::Default && DeviceQueues::is_shared( queue )) {
+                queue->sync();
+                queue = new lapack::Queue( device );
+            }
+            if (queue != nullptr)
+                internal::set_math_mode( mode, *queue );
+        }
+    }
+    std::lock_guard< std::mutex > guard( queue_pool_mutex_ );
+    for (auto& pool : queue_pool_) {
+        for (auto& pooled : pool) {
+            if (pooled.queue != nullptr)
+                internal::set_math_mode( mode, *pooled.queue );
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
-/// Destroys BLAS++ compute and communcation queues on each device.
+/// Destroys BLAS++ compute queues on each device, except shared queues,
+/// and releases this matrix's hold on the shared queues.
 /// As this is called in the destructor, it should NOT throw exceptions.
 ///
 template <typename scalar_t>
@@ -598,14 +1722,89 @@ void MatrixStorage<scalar_t>::destroyQueues()
 {
     int num_queues = int(compute_queues_.size());
     for (int device = 0; device < num_devices(); ++device) {
-        delete comm_queues_[device];
-               comm_queues_[device] = nullptr;
+        comm_queues_[device] = nullptr;
 
         for (int queue = 0; queue < num_queues; ++queue) {
-            delete compute_queues_.at(queue)[device];
-                   compute_queues_.at(queue)[device] = nullptr;
+            DeviceQueues::release( compute_queues_.at(queue)[device] );
+            compute_queues_.at(queue)[device] = nullptr;
+        }
+        for (auto& pooled : queue_pool_.at(device)) {
+            delete pooled.queue;
+                   pooled.queue = nullptr;
+        }
+    }
+    DeviceQueues::detach();
+}
+
+//------------------------------------------------------------------------------
+/// Leases a compute queue on device from the pool, with batch arrays of at
+/// least batchArraySize() entries, for exclusive use until it is returned
+/// by releaseComputeQueue(). Takes a free queue if there is one, else adds
+/// a queue to the pool, so it never waits for another task. Unlike
+/// compute_queue(), this lets any number of concurrent tasks, e.g., of a
+/// deep lookahead, each use their own queue and batch arrays.
+/// Thread safe.
+///
+/// @param[in] device
+///     Device ID.
+///
+template <typename scalar_t>
+typename MatrixStorage<scalar_t>::PooledQueue*
+MatrixStorage<scalar_t>::acquireComputeQueue( int device )
+{
+    PooledQueue* pooled = nullptr;
+    int64_t batch_size;
+    {
+        std::lock_guard< std::mutex > guard( queue_pool_mutex_ );
+        auto& pool = queue_pool_.at( device );
+        for (auto& entry : pool) {
+            if (! entry.busy) {
+                pooled = &entry;
+                break;
+            }
+        }
+        if (pooled == nullptr) {
+            pool.emplace_back();
+            pooled = &pool.back();
+            pooled->index = int( pool.size() ) - 1;
         }
+        pooled->busy = true;
+        batch_size = batch_array_size_;
+    }
+
+    // Only the holder touches a busy entry, so allocate outside the lock.
+    if (pooled->queue == nullptr) {
+        pooled->queue = new lapack::Queue( device );
+        if (math_mode_ != MathMode::Default)
+            internal::set_math_mode( math_mode_, *pooled->queue );
+    }
+    if (pooled->batch_size < batch_size) {
+        // Get the original queue for malloc
+        blas::Queue* queue = comm_queues_[ device ];
+        blas::host_free_pinned( pooled->array_host, *queue );
+        blas::device_free( pooled->array_dev, *queue );
+        pooled->array_host
+            = blas::host_malloc_pinned<scalar_t*>( batch_size*3, *queue );
+        pooled->array_dev
+            = blas::device_malloc<scalar_t*>( batch_size*3, *queue );
+        pooled->batch_size = batch_size;
     }
+    return pooled;
+}
+
+//------------------------------------------------------------------------------
+/// Returns a compute queue leased by acquireComputeQueue() to the pool.
+/// The caller must have synchronized the queue, or recorded events for
+/// work still on it, before returning it. Thread safe.
+///
+/// @param[in] pooled
+///     Queue returned by acquireComputeQueue().
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::releaseComputeQueue( PooledQueue* pooled )
+{
+    std::lock_guard< std::mutex > guard( queue_pool_mutex_ );
+    pooled->busy = false;
 }
 
 //------------------------------------------------------------------------------
@@ -632,6 +1831,9 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
     assert(array_host_.size() ==      array_dev_.size());
     assert(array_host_.size() == compute_queues_.size());
 
+    if (num_devices() > 0)
+        uses_devices_ = true;
+
     bool is_resized = false;
     int64_t i_begin = 0;
 
@@ -678,6 +1880,10 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
                 if (compute_queues_[ i ][ device ] == nullptr) {
                     // Allocate queues.
                     compute_queues_[ i ][ device ] = new lapack::Queue( device );
+                    if (math_mode_ != MathMode::Default) {
+                        internal::set_math_mode(
+                            math_mode_, *compute_queues_[ i ][ device ] );
+                    }
                 }
 
                 // Allocate host arrays;
@@ -696,7 +1902,8 @@ void MatrixStorage<scalar_t>::allocateBatchArrays(
 }
 
 //------------------------------------------------------------------------------
-/// Frees device batch arrays that were allocated by allocateBatchArrays().
+/// Frees device batch arrays that were allocated by allocateBatchArrays()
+/// and acquireComputeQueue().
 ///
 // todo: rename destroyBatchArrays? freeBatchArrays?
 //
@@ -724,17 +1931,28 @@ void MatrixStorage<scalar_t>::clearBatchArrays()
             }
         }
     }
+    for (int device = 0; device < int(queue_pool_.size()); ++device) {
+        blas::Queue* queue = comm_queues_[device];
+        for (auto& pooled : queue_pool_[device]) {
+            blas::host_free_pinned(pooled.array_host, *queue);
+            blas::device_free(pooled.array_dev, *queue);
+            pooled.array_host = nullptr;
+            pooled.array_dev  = nullptr;
+            pooled.batch_size = 0;
+        }
+    }
     batch_array_size_ = 0;
 }
 
 //------------------------------------------------------------------------------
 /// Reserves num_tiles on host in allocator.
+/// If the matrix uses devices, the host blocks are pinned.
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::reserveHostWorkspace(int64_t num_tiles)
 {
-    int64_t n = num_tiles - memory_.capacity( HostNum );
+    int64_t n = reserveCount( HostNum, num_tiles );
     if (n > 0) {
-        memory_.addHostBlocks(n);
+        memory_->addHostBlocks( n, memory_queue( HostNum ) );
         // Usually now capacity == num_tiles, but if multiple
         // threads reserve memory, capacity >= num_tiles.
     }
@@ -745,11 +1963,13 @@ void MatrixStorage<scalar_t>::reserveHostWorkspace(int64_t num_tiles)
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::reserveDeviceWorkspace(int64_t num_tiles)
 {
+    if (num_devices() > 0)
+        uses_devices_ = true;
     for (int device = 0; device < num_devices(); ++device) {
-        int64_t n = num_tiles - memory_.capacity(device);
+        int64_t n = reserveCount( device, num_tiles );
         if (n > 0) {
             blas::Queue* queue = comm_queues_[device];
-            memory_.addDeviceBlocks(device, n, queue);
+            memory_->addDeviceBlocks(device, n, queue);
             // Usually now capacity == num_tiles, but if multiple
             // threads reserve memory, capacity >= num_tiles.
         }
@@ -762,11 +1982,133 @@ template <typename scalar_t>
 void MatrixStorage<scalar_t>::ensureDeviceWorkspace(int device, int64_t num_tiles)
 {
     slate_assert( device != HostNum );
-    int64_t n = num_tiles - memory_.available( device );
+    uses_devices_ = true;
+    int64_t n = std::min( num_tiles - int64_t( memory_->available( device ) ),
+                          memory_quota_ - memory_used_[ device+1 ] );
+    if (n > 0 && high_water_ > 0) {
+        int64_t over = int64_t( memory_->capacity( device ) ) + n - high_water_;
+        if (over > 0) {
+            evictDeviceTiles( device, over );
+            n = std::min( num_tiles - int64_t( memory_->available( device ) ),
+                          memory_quota_ - memory_used_[ device+1 ] );
+        }
+    }
     if (n > 0) {
         blas::Queue* queue = comm_queues_[ device ];
-        memory_.addDeviceBlocks( device, n, queue );
+        memory_->addDeviceBlocks( device, n, queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Evicts least-recently-used workspace tile instances from device, to free
+/// up to num_blocks blocks in its pool. Candidates are workspace instances
+/// that are not OnHold, not pinned (handed out by tileGet and not yet
+/// released), and not extended for layout conversion, and whose
+/// tile node is not locked by another thread. If an instance holds the last
+/// valid copy of the tile, e.g., it is Modified or a received remote tile,
+/// its data are first written back to a host instance, asynchronously on
+/// the device's comm queue. The device's queues are synced before the
+/// memory is freed, so no pending copy or kernel uses it.
+///
+/// @return number of blocks freed.
+///
+template <typename scalar_t>
+int64_t MatrixStorage<scalar_t>::evictDeviceTiles(int device, int64_t num_blocks)
+{
+    slate_assert( device != HostNum );
+    LockGuard guard(getTilesMapLock());
+
+    struct Candidate {
+        int64_t last_use;
+        ij_tuple ij;
+        TileNode_t* tile_node;
+    };
+    std::vector< Candidate > candidates;
+    for (auto iter = begin(); iter != end(); ++iter) {
+        auto& tile_node = *(iter->second);
+        if (tile_node.existsOn( device )) {
+            auto tile = tile_node[ device ];
+            if (tile->workspace()
+                && ! tile->stateOn( MOSI::OnHold )
+                && ! tile_node.pinned( device )
+                && ! tile->extended()) {
+                candidates.push_back(
+                    { tile_node.lastUse( device ), iter->first, &tile_node } );
+            }
+        }
+    }
+    std::sort( candidates.begin(), candidates.end(),
+               []( Candidate const& a, Candidate const& b ) {
+                   return a.last_use < b.last_use;
+               } );
+
+    lapack::Queue* queue = comm_queues_[ device ];
+    std::vector< Candidate > evicted;
+    for (auto& candidate : candidates) {
+        if (int64_t( evicted.size() ) >= num_blocks)
+            break;
+
+        // Skip tiles in use by other threads; waiting could deadlock.
+        auto& tile_node = *candidate.tile_node;
+        if (! omp_test_nest_lock( tile_node.getLock() ))
+            continue;
+        // It may have been handed out since the candidates were found.
+        if (tile_node.pinned( device )) {
+            omp_unset_nest_lock( tile_node.getLock() );
+            continue;
+        }
+
+        Tile<scalar_t>* tile = tile_node[ device ];
+        bool last_valid = ! tile->stateOn( MOSI::Invalid );
+        for (int d = HostNum; d < num_devices(); ++d) {
+            if (d != device && tile_node.existsOn( d )
+                && ! tile_node[ d ]->stateOn( MOSI::Invalid )) {
+                last_valid = false;
+                break;
+            }
+        }
+
+        if (last_valid) {
+            // Write back to host.
+            Tile<scalar_t>* host_tile;
+            if (tile_node.existsOn( HostNum )) {
+                host_tile = tile_node[ HostNum ];
+                if (host_tile->layout() != tile->layout()
+                    || host_tile->extended()) {
+                    omp_unset_nest_lock( tile_node.getLock() );
+                    continue;
+                }
+            }
+            else {
+                int64_t i = std::get<0>( candidate.ij );
+                int64_t j = std::get<1>( candidate.ij );
+                host_tile = tileInsert( { i, j, HostNum }, TileKind::Workspace,
+                                        tile->layout() );
+            }
+            // Copy after pending device work that writes the tile.
+            tile_node.waitEvents( device, *queue, false );
+            tile->copyData( host_tile, *queue, true );
+            host_tile->state( tile->state() );
+        }
+        evicted.push_back( candidate );
+    }
+
+    if (! evicted.empty()) {
+        queue->sync();
+        for (auto& queues : compute_queues_) {
+            if (queues[ device ] != nullptr)
+                queues[ device ]->sync();
+        }
+    }
+
+    for (auto& candidate : evicted) {
+        auto& tile_node = *candidate.tile_node;
+        eraseInstance( tile_node, device );
+        omp_unset_nest_lock( tile_node.getLock() );
+        if (tile_node.empty())
+            erase( candidate.ij );
     }
+    return evicted.size();
 }
 
 //------------------------------------------------------------------------------
@@ -775,11 +2117,28 @@ template <typename scalar_t>
 void MatrixStorage<scalar_t>::freeTileMemory(Tile<scalar_t>* tile)
 {
     slate_assert(tile != nullptr);
-    if (tile->allocated())
+    // Lazy tiles that were never used have no data.
+    if (tile->kind() == TileKind::NodeShared)
+        node_shared_pool_->release( tile->data() );
+    else if (tile->allocated() && tile->data() != nullptr)
         //delete[] tile->data();
-        memory_.free(tile->data(), tile->device());
+        freeMemory(tile->data(), tile->device());
     if (tile->extended())
-        memory_.free(tile->extData(), tile->device());
+        freeMemory(tile->extData(), tile->device());
+}
+
+//------------------------------------------------------------------------------
+/// Frees the memory of the tile instance at device and erases it.
+/// First waits for pending device work on the instance, since its memory
+/// can be reused by another tile as soon as it is freed.
+/// The caller must hold the tile node's lock or the TilesMap lock.
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::eraseInstance(
+    TileNode<scalar_t>& tile_node, int device)
+{
+    tile_node.syncEvents( device, true );
+    freeTileMemory( tile_node[ device ] );
+    tile_node.eraseOn( device );
 }
 
 //------------------------------------------------------------------------------
@@ -795,8 +2154,7 @@ void MatrixStorage<scalar_t>::clearWorkspace()
             if (tile_node.existsOn(d) &&
                 tile_node[d]->workspace())
             {
-                freeTileMemory(tile_node[d]);
-                tile_node.eraseOn(d);
+                eraseInstance( tile_node, d );
             }
         }
         if (tile_node.empty())
@@ -807,18 +2165,12 @@ void MatrixStorage<scalar_t>::clearWorkspace()
         else
             ++iter;
     }
-    // Free host & device memory only if there are no unallocated blocks
-    // from non-workspace (SlateOwned) tiles.
-    if (memory_.allocated( HostNum ) == 0) {
-        memory_.clearHostBlocks();
-    }
+    // If attached to a workspace arena, blocks are returned to it
+    // by detachWorkspace instead of being freed.
+    if (workspace_ != nullptr)
+        return;
 
-    for (int device = 0; device < num_devices(); ++device) {
-        if (memory_.allocated(device) == 0) {
-            blas::Queue* queue = comm_queues_[device];
-            memory_.clearDeviceBlocks(device, queue);
-        }
-    }
+    releaseMemory();
 }
 
 //------------------------------------------------------------------------------
@@ -836,19 +2188,14 @@ void MatrixStorage<scalar_t>::releaseWorkspace()
         // Since we can't increment the iterator after deleting the element
         // and release deletes empty nodes, use post-fix iter++ to
         // increment it but pass the current value to release.
-        release(iter++, AllDevices);
-    }
-    // Free host & device memory only if there are no unallocated blocks
-    // from non-workspace (SlateOwned) tiles.
-    if (memory_.allocated( HostNum ) == 0) {
-        memory_.clearHostBlocks();
-    }
-    for (int device = 0; device < num_devices(); ++device) {
-        if (memory_.allocated(device) == 0) {
-            blas::Queue* queue = comm_queues_[device];
-            memory_.clearDeviceBlocks(device, queue);
-        }
+        release(iter++, AllDevices, false);
     }
+    // If attached to a workspace arena, blocks are returned to it
+    // by detachWorkspace instead of being freed.
+    if (workspace_ != nullptr)
+        return;
+
+    releaseMemory();
 }
 
 //------------------------------------------------------------------------------
@@ -872,8 +2219,7 @@ void MatrixStorage<scalar_t>::erase(ijdev_tuple ijdev)
         int64_t j  = std::get<1>(ijdev);
         int device = std::get<2>(ijdev);
 
-        freeTileMemory(tile_node[device]);
-        tile_node.eraseOn(device);
+        eraseInstance( tile_node, device );
 
         if (tile_node.empty())
             erase({i, j});
@@ -887,13 +2233,15 @@ void MatrixStorage<scalar_t>::erase(ijdev_tuple ijdev)
 /// If tile's memory was allocated by SLATE, then its memory is freed back
 /// to the allocator memory pool.
 /// device can be AllDevices.
+/// Releases the caller's pin on the instance; if keep_pinned, an instance
+/// still pinned by other callers is kept.
 ///
 /// This is an internal version to share logic between release and
 /// releaseWorkspace.
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::release(
     typename MatrixStorage<scalar_t>::TilesMap::iterator iter,
-    int device)
+    int device, bool keep_pinned)
 {
     auto& tile_node = *(iter->second);
 
@@ -919,13 +2267,16 @@ void MatrixStorage<scalar_t>::release(
     // TODO consider copying to origin when last_valid
 
     for (int dev = begin; dev < end; ++dev) {
+        // Release the caller's pin; keep the instance if others hold one.
+        if (tile_node.existsOn( dev ))
+            tile_node.unpin( dev );
         if (tile_node.existsOn( dev )
             && tile_node[ dev ]->workspace()
             && ! tile_node[ dev ]->stateOn( MOSI::OnHold )
+            && ! (keep_pinned && tile_node.pinned( dev ))
             && (! last_valid || tile_node[ dev ]->stateOn( MOSI::Invalid ))) {
 
-            freeTileMemory( tile_node[ dev ] );
-            tile_node.eraseOn( dev );
+            eraseInstance( tile_node, dev );
         }
     }
     if (tile_node.empty())
@@ -956,7 +2307,7 @@ void MatrixStorage<scalar_t>::release(ijdev_tuple ijdev)
     int device = std::get<2>(ijdev);
     auto iter = find( { i, j } ); // not device, to allow AllDevices
     if (iter != end()) {
-        release(iter, device);
+        release(iter, device, true);
     }
 }
 
@@ -975,15 +2326,15 @@ void MatrixStorage<scalar_t>::erase(ij_tuple ij)
     auto iter = tiles_.find(ij);
     if (iter != tiles_.end()) {
 
-        auto& tile_node = iter->second;
+        auto tile_node = iter->second;
 
         for (int d = HostNum; (! tile_node->empty()) && d < num_devices(); ++d) {
             if (tile_node->existsOn(d)) {
-                freeTileMemory(tile_node->at(d));
-                tile_node->eraseOn(d);
+                eraseInstance( *tile_node, d );
             }
         }
         tiles_.erase(ij);
+        node_pool_.free(tile_node);
     }
 }
 
@@ -1018,9 +2369,44 @@ void MatrixStorage<scalar_t>::clear()
 template <typename scalar_t>
 scalar_t* MatrixStorage<scalar_t>::allocWorkspaceBuffer(int device, int size)
 {
-    // if device==HostNum (-1) use nullptr as queue (not comm_queues_[-1])
-    blas::Queue* queue = ( device == HostNum ? nullptr : comm_queues_[device]);
-    return (scalar_t*) memory_.alloc(device, sizeof(scalar_t) * size, queue);
+    blas::Queue* queue = memory_queue( device );
+    return (scalar_t*) allocMemory(device, sizeof(scalar_t) * size, queue);
+}
+
+//------------------------------------------------------------------------------
+/// Takes a free memory block on device to be used as a workspace buffer,
+/// without growing the pool or exceeding the matrix's quota.
+/// To be released with call to releaseWorkspaceBuffer().
+/// @return pointer to memory block on device, or nullptr if none is free.
+///
+/// @param[in] device
+///     Device ID (GPU or Host) where the memory block is needed.
+///
+/// @param[in] size
+///     Number of scalars needed in the memory block
+///
+template <typename scalar_t>
+scalar_t* MatrixStorage<scalar_t>::tryAllocWorkspaceBuffer(int device, int size)
+{
+    int64_t& count = memory_used_[ device+1 ];
+    int64_t used;
+    #pragma omp atomic capture
+    used = ++count;
+
+    void* block = nullptr;
+    if (used <= memory_quota_)
+        block = memory_->allocIfAvailable( device, sizeof(scalar_t) * size );
+    if (block == nullptr) {
+        #pragma omp atomic
+        --count;
+        return nullptr;
+    }
+    #pragma omp critical(slate_memory_peak)
+    {
+        int64_t& peak = memory_peak_[ device+1 ];
+        peak = std::max( peak, used );
+    }
+    return (scalar_t*) block;
 }
 
 //------------------------------------------------------------------------------
@@ -1035,7 +2421,226 @@ scalar_t* MatrixStorage<scalar_t>::allocWorkspaceBuffer(int device, int size)
 template <typename scalar_t>
 void MatrixStorage<scalar_t>::releaseWorkspaceBuffer(scalar_t* data, int device)
 {
-    memory_.free(data, device);
+    freeMemory(data, device);
+}
+
+//------------------------------------------------------------------------------
+/// Switches the matrix from its own memory pool to the process-wide pool
+/// for its block size, Memory::shared(), which all matrices with the same
+/// block size that opt in share. This avoids fragmenting device memory
+/// between the pools of, e.g., A, B, and C in gemm.
+/// Must be called before the matrix allocates any tiles.
+/// Called by the constructors if shared_memory_pool() is set.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::useSharedMemory()
+{
+    LockGuard guard(getTilesMapLock());
+    if (memory_ != &own_memory_)
+        return;
+
+    for (int device = HostNum; device < num_devices(); ++device) {
+        slate_assert( own_memory_.allocated( device ) == 0 );
+    }
+    releaseMemory();
+    memory_ = &Memory::shared( own_memory_.blockSize() );
+}
+
+//------------------------------------------------------------------------------
+/// @return block of at least size bytes on device, which can be host,
+/// from the matrix's memory pool. Counts it against the matrix's quota.
+/// For host, if numa_node >= 0, the block is placed on that NUMA node.
+///
+template <typename scalar_t>
+void* MatrixStorage<scalar_t>::allocMemory(
+    int device, size_t size, blas::Queue* queue, int numa_node)
+{
+    if (device != HostNum)
+        uses_devices_ = true;
+    int64_t& count = memory_used_[ device+1 ];
+    int64_t used;
+    #pragma omp atomic capture
+    used = ++count;
+
+    if (used > memory_quota_) {
+        #pragma omp atomic
+        --count;
+        slate_error( "matrix exceeded its memory quota of "
+                     + std::to_string( memory_quota_ )
+                     + " blocks on device " + std::to_string( device ) );
+    }
+    #pragma omp critical(slate_memory_peak)
+    {
+        int64_t& peak = memory_peak_[ device+1 ];
+        peak = std::max( peak, used );
+    }
+    return memory_->alloc( device, size, queue, numa_node );
+}
+
+//------------------------------------------------------------------------------
+/// Returns block on device, which can be host, to the matrix's memory pool.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::freeMemory(void* block, int device)
+{
+    memory_->free( block, device );
+    int64_t& count = memory_used_[ device+1 ];
+    #pragma omp atomic
+    --count;
+}
+
+//------------------------------------------------------------------------------
+/// Frees host and device memory of the matrix's pool on each device where
+/// no block is in use, e.g., by non-workspace (SlateOwned) tiles.
+/// For a shared pool, blocks in use by other matrices also count as in use.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::releaseMemory()
+{
+    memory_->releaseHostBlocks( host_free_queue() );
+    for (int device = 0; device < num_devices(); ++device) {
+        blas::Queue* queue = comm_queues_[device];
+        memory_->releaseDeviceBlocks(device, queue);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return number of blocks to add to the pool on device, which can be
+/// host, to reserve num_tiles blocks for this matrix, within its quota.
+/// For its own pool, that is the capacity; for a shared pool, the blocks
+/// it has plus the free blocks, since other matrices hold the rest.
+///
+template <typename scalar_t>
+int64_t MatrixStorage<scalar_t>::reserveCount(
+    int device, int64_t num_tiles) const
+{
+    int64_t used = memory_used_[ device+1 ];
+    int64_t reserved;
+    if (memory_ == &own_memory_)
+        reserved = memory_->capacity( device );
+    else
+        reserved = used + memory_->available( device );
+    int64_t n = std::min( num_tiles - reserved, memory_quota_ - used );
+    if (device != HostNum && high_water_ > 0)
+        n = std::min( n, high_water_ - int64_t( memory_->capacity( device ) ) );
+    return n;
+}
+
+//------------------------------------------------------------------------------
+/// Attaches the matrix to a workspace arena for the duration of a driver.
+/// Takes a parked memory pool with the same block size and parked batch
+/// arrays from the arena, if any, so reserving workspace and allocating
+/// batch arrays need not allocate memory.
+/// Does nothing if the matrix is already attached, e.g., when a submatrix
+/// of a matrix used by the same driver is passed.
+///
+/// @param[in,out] workspace
+///     Workspace arena; can be null, in which case this does nothing.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::attachWorkspace(Workspace* workspace)
+{
+    if (workspace == nullptr || workspace_ != nullptr)
+        return;
+
+    LockGuard guard(getTilesMapLock());
+    workspace_ = workspace;
+    if (workspace_->num_attached_++ == 0)
+        workspace_->comm_plan_.nextEpoch();
+    if (memory_ == &own_memory_)
+        workspace_->takePool( *memory_ );
+
+    if (num_devices() > 0 && ! workspace_->batch_arrays_.empty()) {
+        // Swap the matrix's batch arrays and queues with the parked ones,
+        // keeping the matrix's to give back on detach.
+        Workspace::BatchArrays mine;
+        mine.size   = batch_array_size_;
+        mine.queues = std::move( compute_queues_ );
+        mine.host.resize( array_host_.size() );
+        mine.dev .resize( array_dev_ .size() );
+        for (size_t i = 0; i < array_host_.size(); ++i) {
+            mine.host[ i ].assign( array_host_[ i ].begin(), array_host_[ i ].end() );
+            mine.dev [ i ].assign( array_dev_ [ i ].begin(), array_dev_ [ i ].end() );
+        }
+
+        auto& parked = workspace_->batch_arrays_.front();
+        batch_array_size_ = parked.size;
+        compute_queues_ = std::move( parked.queues );
+        array_host_.resize( parked.host.size() );
+        array_dev_ .resize( parked.dev .size() );
+        for (size_t i = 0; i < parked.host.size(); ++i) {
+            array_host_[ i ].resize( num_devices() );
+            array_dev_ [ i ].resize( num_devices() );
+            for (int device = 0; device < num_devices(); ++device) {
+                array_host_[ i ][ device ] = (scalar_t**) parked.host[ i ][ device ];
+                array_dev_ [ i ][ device ] = (scalar_t**) parked.dev [ i ][ device ];
+            }
+        }
+        workspace_->batch_arrays_.pop_front();
+        workspace_->spare_batch_arrays_.push_back( std::move( mine ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Detaches the matrix from its workspace arena at the end of a driver.
+/// Parks free memory blocks and batch arrays in the arena, to be reused by
+/// the next driver, instead of freeing them.
+/// Blocks on devices with tiles still allocated, e.g., because of
+/// Option::HoldLocalWorkspace, stay with the matrix.
+/// Does nothing if the matrix is not attached.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::detachWorkspace()
+{
+    if (workspace_ == nullptr)
+        return;
+
+    LockGuard guard(getTilesMapLock());
+    --workspace_->num_attached_;
+    if (memory_ == &own_memory_)
+        workspace_->returnPool( *memory_ );
+
+    if (num_devices() > 0) {
+        Workspace::BatchArrays parked;
+        parked.size   = batch_array_size_;
+        parked.queues = std::move( compute_queues_ );
+        parked.host.resize( array_host_.size() );
+        parked.dev .resize( array_dev_ .size() );
+        for (size_t i = 0; i < array_host_.size(); ++i) {
+            parked.host[ i ].assign( array_host_[ i ].begin(), array_host_[ i ].end() );
+            parked.dev [ i ].assign( array_dev_ [ i ].begin(), array_dev_ [ i ].end() );
+        }
+        workspace_->batch_arrays_.push_back( std::move( parked ) );
+
+        auto& spares = workspace_->spare_batch_arrays_;
+        if (spares.empty()) {
+            // Matrix wasn't given parked arrays on attach;
+            // go back to the shared queues.
+            batch_array_size_ = 0;
+            compute_queues_.assign( 1, std::vector< lapack::Queue* >( num_devices() ) );
+            for (int device = 0; device < num_devices(); ++device)
+                compute_queues_[ 0 ][ device ] = DeviceQueues::compute_queue( device );
+            array_host_.assign( 1, std::vector< scalar_t** >( num_devices(), nullptr ) );
+            array_dev_ .assign( 1, std::vector< scalar_t** >( num_devices(), nullptr ) );
+        }
+        else {
+            auto& mine = spares.back();
+            batch_array_size_ = mine.size;
+            compute_queues_ = std::move( mine.queues );
+            array_host_.resize( mine.host.size() );
+            array_dev_ .resize( mine.dev .size() );
+            for (size_t i = 0; i < mine.host.size(); ++i) {
+                array_host_[ i ].resize( num_devices() );
+                array_dev_ [ i ].resize( num_devices() );
+                for (int device = 0; device < num_devices(); ++device) {
+                    array_host_[ i ][ device ] = (scalar_t**) mine.host[ i ][ device ];
+                    array_dev_ [ i ][ device ] = (scalar_t**) mine.dev [ i ][ device ];
+                }
+            }
+            spares.pop_back();
+        }
+    }
+    workspace_ = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1071,11 +2676,29 @@ Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
 }
 
 
+//------------------------------------------------------------------------------
+/// This is intended for inserting origin tiles that will be overwritten,
+/// e.g., of a workspace matrix.
+/// Inserts tile {i, j} on given device, which can be host, but defers
+/// allocating its data until the tile is first used; see tileMaterialize.
+/// Until then, the tile's value is implicitly zero, so it is valid and
+/// its state is MOSI::Shared.
+/// Sets tile kind = TileKind::SlateOwned.
+/// @return Pointer to newly inserted Tile, whose data is null.
+///
+template <typename scalar_t>
+Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsertLazy(
+    ijdev_tuple ijdev, Layout layout)
+{
+    return tileInsert( ijdev, nullptr, 0, TileKind::SlateOwned, layout, true );
+}
+
 //------------------------------------------------------------------------------
 /// shared logic of tileInsert
 template <typename scalar_t>
 Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
-    ijdev_tuple ijdev, scalar_t* data, int64_t lda, TileKind kind, Layout layout )
+    ijdev_tuple ijdev, scalar_t* data, int64_t lda, TileKind kind, Layout layout,
+    bool lazy )
 {
     int64_t i  = std::get<0>(ijdev);
     int64_t j  = std::get<1>(ijdev);
@@ -1086,31 +2709,155 @@ Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsert(
 
     if (find({i, j}) == end()) {
         // insert new-entry in map
-        tiles_[{i, j}] = std::make_shared<TileNode_t>( num_devices() );
+        tiles_.insert( {i, j}, node_pool_.alloc() );
     }
 
     auto& tile_node = this->at({i, j});
 
     // if tile instance does not exist, insert new instance
     if (! tile_node.existsOn(device)) {
-        int64_t mb = tileMb(i);
-        int64_t nb = tileNb(j);
+        int64_t mb = tileMbAt(i);
+        int64_t nb = tileNbAt(j);
+        if (lazy) {
+            return tile_node.insertOn(
+                device, Tile<scalar_t>::lazy( mb, nb, device, kind, layout ),
+                MOSI::Shared );
+        }
         if (data == nullptr) {
-            // if device==HostNum (-1) use nullptr as queue (not comm_queues_[-1])
-            blas::Queue* queue = (device == HostNum) ? nullptr : comm_queues_[device];
-            data = (scalar_t*) memory_.alloc(device, sizeof(scalar_t) * mb * nb, queue);
+            blas::Queue* queue = memory_queue( device );
+            int numa_node = (device == HostNum && host_numa_placement()
+                             ? tileNumaNode( {i, j} ) : -1);
+            data = (scalar_t*) allocMemory(device, sizeof(scalar_t) * mb * nb,
+                                           queue, numa_node);
             lda = (layout == Layout::ColMajor) ? mb : nb;
         }
-        Tile<scalar_t>* tile
-            = new Tile<scalar_t>(
-                  mb, nb, data, lda, device, kind, layout);
-        tile_node.insertOn(device, tile, kind == TileKind::Workspace ?
-                                         MOSI::Invalid :
-                                         MOSI::Shared);
+        return tile_node.insertOn(
+            device, Tile<scalar_t>( mb, nb, data, lda, device, kind, layout ),
+            kind == TileKind::Workspace ? MOSI::Invalid : MOSI::Shared );
     }
     return tile_node[device];
 }
 
+//------------------------------------------------------------------------------
+/// Inserts the host instance of remote tile {i, j} as a NodeShared tile,
+/// reading data in node-shared memory, which the node's leader received
+/// in a broadcast; see BaseMatrix::tileIbcastToSet.
+/// The tile holds one reference to the block of pool holding data,
+/// released when the tile is erased or privatized.
+/// As for a receive, the tile becomes Dense, and other instances invalid.
+/// An existing host instance is replaced, so it must not be in use, e.g.,
+/// it is invalid, as inserted by tilePrepareToReceive.
+/// The tile node must exist.
+///
+/// @param[in] data
+///     The tile's data in node-shared memory, contiguous in layout.
+///
+/// @return Pointer to the host tile.
+///
+template <typename scalar_t>
+Tile<scalar_t>* MatrixStorage<scalar_t>::tileInsertNodeShared(
+    ij_tuple ij, scalar_t* data, Layout layout, NodeSharedPool* pool)
+{
+    LockGuard guard(getTilesMapLock());
+
+    node_shared_pool_ = pool;
+    auto& tile_node = this->at( ij );
+    if (tile_node.existsOn( HostNum ))
+        eraseInstance( tile_node, HostNum );
+    for (int d = 0; d < num_devices(); ++d) {
+        if (tile_node.existsOn( d ))
+            tile_node[ d ]->state( MOSI::Invalid );
+    }
+    tile_node.structure( TileStructure::Dense );
+
+    int64_t mb = tileMbAt( std::get<0>( ij ) );
+    int64_t nb = tileNbAt( std::get<1>( ij ) );
+    int64_t lda = (layout == Layout::ColMajor) ? mb : nb;
+    return tile_node.insertOn(
+        HostNum, Tile<scalar_t>( mb, nb, data, lda, HostNum,
+                                 TileKind::NodeShared, layout ),
+        MOSI::Shared );
+}
+
+//------------------------------------------------------------------------------
+/// Moves a NodeShared tile into workspace memory of its own, before it is
+/// written or its layout is converted, since other ranks of the node read
+/// its node-shared memory. Releases its reference to the node-shared block.
+/// Does nothing for other tiles.
+/// The caller must hold the tile node's lock.
+///
+/// @param[in,out] tile
+///     Pointer to tile.
+///
+/// @param[in] copy
+///     Whether to copy the tile's data; false if it will be overwritten.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tilePrivatize(Tile<scalar_t>* tile, bool copy)
+{
+    if (tile->kind() != TileKind::NodeShared)
+        return;
+
+    int device = tile->device();
+    int64_t mb = tile->mb();
+    int64_t nb = tile->nb();
+    Layout layout = tile->layout();
+    int64_t lda = (layout == Layout::ColMajor) ? mb : nb;
+    scalar_t* data = (scalar_t*) allocMemory(device, sizeof(scalar_t) * mb * nb,
+                                             memory_queue( device ));
+    // Both are contiguous.
+    if (copy)
+        std::memcpy( data, tile->data(), sizeof(scalar_t) * mb * nb );
+    node_shared_pool_->release( tile->data() );
+
+    *tile = Tile<scalar_t>( mb, nb, data, lda, device, TileKind::Workspace,
+                            layout, tile->mosi_state_ );
+}
+
+//------------------------------------------------------------------------------
+/// Allocates the data of a tile inserted by tileInsertLazy, if it isn't
+/// already allocated. The caller must hold the tile node's lock.
+/// On a device, zeroing is enqueued on the comm queue without waiting;
+/// its event is recorded as a write of the instance, so it is ordered
+/// before later uses by syncEvents or waitEvents, as in tileGet.
+///
+/// @param[in,out] tile_node
+///     Node of tile to allocate.
+///
+/// @param[in] device
+///     Tile instance to allocate: host or device ID.
+///
+/// @param[in] zero
+///     If true, sets the tile to zero, its implicit value. Use false if
+///     the tile's data will be overwritten, e.g., if it is Invalid.
+///
+template <typename scalar_t>
+void MatrixStorage<scalar_t>::tileMaterialize(
+    TileNode<scalar_t>& tile_node, int device, bool zero)
+{
+    Tile<scalar_t>* tile = tile_node[ device ];
+    if (tile->data() != nullptr)
+        return;
+
+    int64_t size = tile->size();
+    blas::Queue* queue = memory_queue( device );
+    scalar_t* data
+        = (scalar_t*) allocMemory( device, sizeof(scalar_t) * size, queue );
+    if (zero) {
+        if (device == HostNum) {
+            std::fill( data, data + size, scalar_t( 0 ) );
+        }
+        else {
+            blas::Queue* comm_queue = comm_queues_[ device ];
+            tile_node.waitEvents( device, *comm_queue, true );
+            blas::device_memset( data, 0, size, *comm_queue );
+            tile_node.recordEvent( device, DeviceEvent::record( *comm_queue ),
+                                   true );
+        }
+    }
+    tile->attachData( data );
+}
+
 //------------------------------------------------------------------------------
 /// Makes tile layout convertible by extending its data buffer.
 /// Attaches an auxiliary buffer to hold the transposed data when needed.
@@ -1128,9 +2875,8 @@ void MatrixStorage<scalar_t>::tileMakeTransposable(Tile<scalar_t>* tile)
     int device = tile->device();
     int64_t mb = tile->mb();
     int64_t nb = tile->nb();
-    // if device==HostNum (-1) use nullptr as queue (not comm_queues_[-1])
-    blas::Queue* queue = ( device == HostNum ? nullptr : comm_queues_[device]);
-    scalar_t* data = (scalar_t*) memory_.alloc(device, sizeof(scalar_t) * mb * nb, queue);
+    blas::Queue* queue = memory_queue( device );
+    scalar_t* data = (scalar_t*) allocMemory(device, sizeof(scalar_t) * mb * nb, queue);
     tile->makeTransposable(data);
 }
 
@@ -1146,7 +2892,7 @@ template <typename scalar_t>
 void MatrixStorage<scalar_t>::tileLayoutReset(Tile<scalar_t>* tile)
 {
     if (tile->extended()) {
-        memory_.free(tile->extData(), tile->device());
+        freeMemory(tile->extData(), tile->device());
         tile->layoutReset();
     }
 }
@@ -14,18 +14,67 @@
 
 #include <map>
 #include <stack>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "blas.hh"
 
-#include "slate/enums.hh"
+#include "slate/types.hh"
 #include "slate/internal/openmp.hh"
 
 namespace slate {
 
+//------------------------------------------------------------------------------
+/// Memory usage counters of a Memory pool, or of all pools in the process,
+/// on one device, which can be host.
+/// In use is bytes of blocks given by alloc and not yet freed; pooled is
+/// bytes allocated from the system, in use or free. Peaks are since the
+/// pool was created or the last resetPeak.
+///
+/// @see Memory::stats, Memory::totalStats, Memory::driverStats
+///
+struct MemoryStats {
+    int64_t in_use      = 0;
+    int64_t peak_in_use = 0;
+    int64_t pooled      = 0;
+    int64_t peak_pooled = 0;
+    int64_t allocs      = 0;  ///< alloc calls
+    int64_t frees       = 0;  ///< free calls
+    int64_t growths     = 0;  ///< addHostBlocks, addDeviceBlocks calls
+    int64_t fallbacks   = 0;  ///< alloc calls without a free block, which
+                              ///< allocate from the system, e.g.,
+                              ///< device_malloc
+};
+
 //------------------------------------------------------------------------------
 /// Allocates workspace blocks for host and GPU devices.
-/// Currently assumes a fixed-size block of block_size bytes,
+/// Most blocks are a fixed-size block of block_size bytes,
 /// e.g., block_size = sizeof(scalar_t) * mb * nb.
+/// Requests larger than block_size are served from size classes:
+/// class k >= 1 holds blocks of block_size * 2^k bytes. Blocks of each
+/// class are kept in their own free list after being freed, so that,
+/// once warmed up, varying sizes do not trigger new allocations.
+///
+/// Host blocks are page-aligned. If a queue is given when allocating
+/// host blocks, they are pinned (page-locked), so host <=> device
+/// transfers of tiles in them use full DMA bandwidth.
+///
+/// If gpu_async_alloc() is set, device blocks are allocated and freed in
+/// stream order on the given queue, from the device's memory pool, which
+/// is set to keep freed memory cached for later allocations. This avoids
+/// synchronizing the device when workspace is reserved. Freeing first
+/// waits for the device, since blocks may be in use on any of its queues.
+///
+/// Each matrix has its own pool by default. Memory::shared() gives the
+/// process-wide pool for a block size, which matrices can share to avoid
+/// fragmenting device memory between pools. Allocating, freeing, adding,
+/// and releasing blocks are thread safe, so a pool can be used by several
+/// matrices at once.
+///
+/// On Linux, host blocks can be placed on a NUMA node, given when
+/// allocating them, and host blocks of at least 2 MiB can use transparent
+/// huge pages; see host_huge_pages().
 class Memory {
 public:
     friend class Debug;
@@ -34,6 +83,8 @@ public:
         StaticConstructor()
         {
             num_devices_ = blas::get_device_count();
+            num_numa_nodes_ = numaNodeCount();
+            total_stats_.resize( num_devices_ + 1 );
         }
     } static_constructor_;
 
@@ -41,21 +92,43 @@ public:
     ~Memory();
 
     // todo: change add* to reserve*?
-    void addHostBlocks(int64_t num_blocks) { /* No host pool currently */ }
+    void addHostBlocks(int64_t num_blocks, blas::Queue *queue=nullptr);
     void addDeviceBlocks(int device, int64_t num_blocks, blas::Queue *queue);
 
-    void clearHostBlocks() { /* No host pool currently */ }
+    void clearHostBlocks(blas::Queue *queue=nullptr);
     void clearDeviceBlocks(int device, blas::Queue *queue);
 
-    void* alloc(int device, size_t size, blas::Queue *queue);
+    bool releaseHostBlocks(blas::Queue *queue=nullptr);
+    bool releaseDeviceBlocks(int device, blas::Queue *queue);
+
+    static Memory& shared(size_t block_size);
+
+    MemoryStats stats(int device) const;
+    void resetPeak(int device);
+
+    static MemoryStats totalStats(int device);
+    static void resetTotalPeaks();
+    static std::map< std::string, std::vector< MemoryStats > > driverStats();
+
+    void* alloc(int device, size_t size, blas::Queue *queue,
+                int numa_node=-1);
+    void* allocIfAvailable(int device, size_t size);
     void free(void* block, int device);
 
+    void moveBlocks(Memory& src, int device);
+
+    /// @return size in bytes of blocks in the default size class.
+    size_t blockSize() const
+    {
+        return block_size_;
+    }
+
     /// @return number of available free blocks in device's memory pool,
     /// which can be host.
     size_t available(int device) const
     {
         if (device == HostNum)
-            return 0;
+            return free_host_blocks_.size();
         else
             return free_blocks_.at(device).size();
     }
@@ -65,30 +138,103 @@ public:
     size_t capacity(int device) const
     {
         if (device == HostNum)
-            return 0;
+            return host_capacity_;
         else
             return capacity_.at(device);
     }
 
     /// @return total number of allocated blocks from device's memory pool,
-    /// which can be host.
+    /// which can be host, including blocks from all size classes.
     size_t allocated(int device) const
     {
-        return capacity(device) - available(device);
+        size_t num_blocks = capacity(device) - available(device);
+        for (auto const& size_class : size_classes_.at( device+1 ))
+            num_blocks += size_class.capacity - size_class.free_blocks.size();
+        return num_blocks;
+    }
+
+    int sizeClass(size_t size) const;
+
+    /// @return size in bytes of blocks in the given size class.
+    /// Class 0 is the default block size.
+    size_t classBlockSize(int size_class) const
+    {
+        return block_size_ << size_class;
+    }
+
+    /// @return number of size classes used on device, which can be host,
+    /// including the default class 0.
+    int numSizeClasses(int device) const
+    {
+        return 1 + int( size_classes_.at( device+1 ).size() );
+    }
+
+    /// @return number of available free blocks of given size class
+    /// in device's memory pool, which can be host.
+    size_t available(int device, int size_class) const
+    {
+        if (size_class == 0)
+            return available(device);
+        auto const& classes = size_classes_.at( device+1 );
+        if (size_class > int(classes.size()))
+            return 0;
+        return classes[ size_class-1 ].free_blocks.size();
+    }
+
+    /// @return total number of blocks of given size class
+    /// in device's memory pool, which can be host.
+    size_t capacity(int device, int size_class) const
+    {
+        if (size_class == 0)
+            return capacity(device);
+        auto const& classes = size_classes_.at( device+1 );
+        if (size_class > int(classes.size()))
+            return 0;
+        return classes[ size_class-1 ].capacity;
+    }
+
+    /// @return number of host blocks in use that are placed on numa_node,
+    /// 0 <= numa_node < num_numa_nodes_. Only blocks allocated for a
+    /// NUMA node are counted.
+    int64_t numaAllocated(int numa_node) const
+    {
+        return numa_allocated_.at( numa_node );
+    }
+
+    /// @return number of host blocks, in use or free, that are placed on
+    /// numa_node, 0 <= numa_node < num_numa_nodes_.
+    int64_t numaCapacity(int numa_node) const
+    {
+        int64_t num_blocks = 0;
+        for (auto const& iter : host_numa_nodes_) {
+            if (iter.second == numa_node)
+                ++num_blocks;
+        }
+        return num_blocks;
     }
 
     // ----------------------------------------
     // public static variables
     static int num_devices_;
+    static int num_numa_nodes_;
 
 private:
+    static int numaNodeCount();
+
     void* allocBlock(int device, blas::Queue *queue);
+    void* allocLargeBlock(int device, int size_class, blas::Queue *queue);
+    void clearSizeClasses(int device);
 
-    void* allocHostMemory(size_t size);
+    void* allocHostMemory(size_t size, blas::Queue *queue);
     void* allocDeviceMemory(int device, size_t size, blas::Queue *queue);
 
-    void freeHostMemory(void* host_mem);
-    void freeDeviceMemory(int device, void* dev_mem, blas::Queue *queue);
+    void freeHostMemory(void* host_mem, bool pinned, blas::Queue *queue);
+    void freeDeviceMemory(int device, void* dev_mem, bool async,
+                          blas::Queue *queue);
+
+    void countAlloc(int device, int64_t bytes, bool fallback);
+    void countFree(int device, int64_t bytes);
+    void countPooled(int device, int64_t bytes);
 
     // ----------------------------------------
     // member variables
@@ -96,10 +242,70 @@ private:
 
     // map device number to stack of blocks
     std::vector< std::stack<void*> > free_blocks_;
-    std::vector< std::stack<void*> > allocated_mem_;
+    // pairs of (allocation, is stream-ordered)
+    std::vector< std::stack< std::pair<void*, bool> > > allocated_mem_;
     std::vector< size_t > capacity_;
+
+    // host pool; pairs of (allocation, is pinned)
+    std::stack<void*> free_host_blocks_;
+    std::stack< std::pair<void*, bool> > allocated_host_mem_;
+    size_t host_capacity_;
+
+    /// Pool of blocks for one size class larger than block_size_.
+    struct SizeClass {
+        std::stack<void*> free_blocks;
+        size_t capacity = 0;
+    };
+
+    // Indexed by device+1, so host is index 0.
+    // size_classes_[ device+1 ][ k-1 ] is size class k.
+    std::vector< std::vector< SizeClass > > size_classes_;
+    // Maps each block of size class > 0 to its size class.
+    std::vector< std::map< void*, int > > large_blocks_;
+
+    // Maps each host block placed on a NUMA node to its node.
+    std::map< void*, int > host_numa_nodes_;
+    // Number of host blocks in use on each NUMA node.
+    std::vector< int64_t > numa_allocated_;
+
+    // Usage counters, indexed by device+1, so host is index 0;
+    // total_stats_ sums all pools. In critical(slate_memory).
+    std::vector< MemoryStats > stats_;
+    static std::vector< MemoryStats > total_stats_;
 };
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Records the memory usage of all pools during a top-level driver call
+/// into Memory::driverStats()[ name ]: the peaks in use and pooled, and
+/// the allocation counts. It resets the process-wide peaks at its start.
+/// Drivers called within another driver on the same thread are counted in
+/// the outer driver only.
+/// With Option::PrintVerbose >= 1, the max over the ranks of comm of the
+/// peaks is printed on rank 0 of comm, which makes the destructor
+/// collective.
+///
+class MemoryStatsScope {
+public:
+    MemoryStatsScope( const char* name, MPI_Comm comm, Options const& opts );
+    ~MemoryStatsScope();
+
+    // Not copyable, as it records on destruction.
+    MemoryStatsScope( MemoryStatsScope const& ) = delete;
+    MemoryStatsScope& operator=( MemoryStatsScope const& ) = delete;
+
+private:
+    const char* name_;
+    MPI_Comm comm_;
+    int verbose_;
+    bool outer_;
+    std::vector< MemoryStats > start_;
+};
+
+} // namespace internal
+
 } // namespace slate
 
 #endif // SLATE_MEMORY_HH
@@ -0,0 +1,101 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_NODESHAREDPOOL_HH
+#define SLATE_NODESHAREDPOOL_HH
+
+#include "slate/internal/mpi.hh"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Pool of fixed-size blocks in memory shared by the ranks of a node,
+/// allocated with MPI_Win_allocate_shared, used by broadcasts so that a
+/// tile is received once per node instead of once per rank
+/// (see Workspace::enableNodeShared).
+/// The rank of a node that receives a tile from the network puts it in a
+/// block and sends the block index to the other ranks of the node, which
+/// read the block in place as a NodeShared tile.
+///
+/// Each block has a reference count, kept in the shared memory.
+/// acquire sets it to the number of ranks that will read the block;
+/// each of them calls release when its tile is erased, and the block is
+/// free again when the count is back to 0.
+/// A block is written only by the rank that acquired it, before it sends
+/// the block index; sync orders the writes before the message on the
+/// writer, and the reads after it on the readers.
+///
+class NodeSharedPool {
+public:
+    /// Block index sent when no block is free.
+    static constexpr int64_t no_block = -1;
+
+    NodeSharedPool( MPI_Comm mpi_comm, size_t block_size, int64_t num_blocks );
+    ~NodeSharedPool();
+
+    // Not copyable, as it owns the MPI window.
+    NodeSharedPool( NodeSharedPool const& ) = delete;
+    NodeSharedPool& operator=( NodeSharedPool const& ) = delete;
+
+    int64_t acquire( int64_t count );
+    void release( void const* data );
+    void sync();
+
+    /// @return data of block.
+    void* data( int64_t block ) const
+    {
+        return blocks_ + block * block_stride_;
+    }
+
+    /// @return block's index, in memory that stays valid, to send with
+    /// MPI_Isend.
+    int64_t const* index( int64_t block ) const
+    {
+        return &indices_[ block ];
+    }
+
+    /// @return size of blocks in bytes.
+    size_t blockSize() const { return block_size_; }
+
+    /// @return number of blocks.
+    int64_t numBlocks() const { return num_blocks_; }
+
+    /// @return whether the pool has memory, i.e., whether the node has
+    /// more than one rank.
+    bool enabled() const { return blocks_ != nullptr; }
+
+    /// @return MPI communicator the pool was created on.
+    MPI_Comm mpiComm() const { return mpi_comm_; }
+
+private:
+    //----------------------------------------
+    // Data
+    MPI_Comm mpi_comm_;
+    MPI_Comm node_comm_;
+    MPI_Win win_;
+
+    size_t block_size_;
+    size_t block_stride_;
+    int64_t num_blocks_;
+
+    /// Reference counts, then blocks, in the shared memory.
+    std::atomic<int64_t>* refs_;
+    char* blocks_;
+
+    /// Block indices, as send buffers.
+    std::vector<int64_t> indices_;
+
+    /// Block to try first in acquire.
+    std::atomic<int64_t> next_;
+};
+
+} // namespace slate
+
+#endif // SLATE_NODESHAREDPOOL_HH
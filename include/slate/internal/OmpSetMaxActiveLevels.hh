@@ -22,39 +22,31 @@ const int MinOmpActiveLevels = 4;
 /// This provides safety in case an exception is thrown, which would otherwise
 /// by-pass the reset.
 ///
+/// max-active-levels-var may be shared by all threads (it is a device ICV
+/// in OpenMP 5.1), so the original value is kept process-wide and restored
+/// when the last object, across threads, is destroyed; drivers called
+/// concurrently from several application threads don't reset it under
+/// each other.
+///
+/// Drivers create one before their parallel regions. If
+/// slate::shared_threads() is enabled, the outermost one on each
+/// application thread also sets the thread's nthreads-var ICV to a fair
+/// share of the cores among concurrent driver calls, so their parallel
+/// regions don't oversubscribe the node.
+///
 class OmpSetMaxActiveLevels {
 
 private:
-    int orig_max_active_levels_ = -1;
+    /// Calling thread's original nthreads-var, if changed, else -1.
+    int orig_num_threads_ = -1;
 
 public:
-    //----------------------------------------
-    /// Require omp nested levels to have a minimum value.
-    ///
-    /// @param[in] min_active_levels
-    ///     Ensure that OpenMP max-active-levels-var ICV has this minimum.
-    OmpSetMaxActiveLevels(int min_active_levels)
-    {
-        int curr_max_active_levels = omp_get_max_active_levels();
-        #if defined(_OPENMP) && _OPENMP < 201811
-            // if OpenMP version < 5.0 then enable omp_set_nested
-            omp_set_nested(1);
-        #endif
-        if (min_active_levels > curr_max_active_levels) {
-            // record the original value
-            orig_max_active_levels_ = curr_max_active_levels;
-            omp_set_max_active_levels( min_active_levels );
-        }
-    }
-
-    //----------------------------------------
-    /// Reset omp nested levels variable.
-    ~OmpSetMaxActiveLevels()
-    {
-        // if original was changed, reset it
-        if (orig_max_active_levels_ != -1)
-            omp_set_max_active_levels( orig_max_active_levels_ );
-    }
+    OmpSetMaxActiveLevels( int min_active_levels );
+    ~OmpSetMaxActiveLevels();
+
+    // Not copyable, as it resets the ICVs on destruction.
+    OmpSetMaxActiveLevels( OmpSetMaxActiveLevels const& ) = delete;
+    OmpSetMaxActiveLevels& operator=( OmpSetMaxActiveLevels const& ) = delete;
 };
 
 }  // namespace slate
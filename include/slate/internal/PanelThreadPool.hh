@@ -0,0 +1,110 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_PANELTHREADPOOL_HH
+#define SLATE_PANELTHREADPOOL_HH
+
+#include "slate/internal/openmp.hh"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Persistent pool of threads for host panel factorizations.
+///
+/// Panels of getrf, getrf_tntpiv, and geqrf run thread_size threads that
+/// synchronize with a ThreadBarrier. Launching them in a nested OpenMP
+/// parallel region per panel forks and joins a team each time, and the
+/// team lands on whatever cores the runtime picks. The pool instead keeps
+/// one thread per core of slate::panel_cores(), pinned to that core,
+/// created once and reused by every panel. The threads wait on a condition
+/// variable between panels.
+///
+/// Only one panel runs in the pool at a time. run() does not wait for the
+/// pool: if it is busy, or disabled, the panel uses a nested parallel
+/// region, which always progresses. Hence panels of different matrices,
+/// whose MPI messages may be ordered differently on different ranks,
+/// cannot deadlock on the pool.
+///
+class PanelThreadPool {
+public:
+    static bool run( int thread_size, std::function< void (int) > const& body );
+
+    ~PanelThreadPool();
+
+    PanelThreadPool( PanelThreadPool const& ) = delete;
+    PanelThreadPool& operator=( PanelThreadPool const& ) = delete;
+
+private:
+    PanelThreadPool() = default;
+
+    static PanelThreadPool& get();
+
+    bool tryRun( int thread_size, std::function< void (int) > const& body );
+    void start( std::vector<int> const& cores );
+    void stop();
+    void worker( int thread_rank, int core, int64_t generation );
+
+    //----------------------------------------
+    // Data
+
+    /// Held by the panel running in the pool.
+    std::mutex run_mutex_;
+
+    /// Protects the fields below; signals new work and completion.
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+
+    std::vector<std::thread> threads_;
+    std::vector<int> cores_;
+
+    std::function< void (int) > const* body_ = nullptr;
+    int thread_size_ = 0;
+    int remaining_ = 0;
+    int64_t generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr exception_;
+};
+
+//------------------------------------------------------------------------------
+/// Runs body( thread_rank ) for thread_rank = 0, ..., thread_size-1
+/// concurrently, in the panel thread pool if possible, otherwise in a
+/// nested OpenMP parallel region. Returns when all have finished.
+///
+/// @param[in] thread_size
+///     Number of threads. The pool's threads may not be fewer; if there
+///     are fewer cores in the pool, a parallel region is used.
+///
+/// @param[in] body
+///     Panel code for one thread, e.g., calling tile::getrf.
+///
+template <typename body_t>
+void panel_parallel( int thread_size, body_t&& body )
+{
+    std::function< void (int) > func( body );
+    if (PanelThreadPool::run( thread_size, func ))
+        return;
+
+    // Launching new threads for the panel guarantees progression.
+    #pragma omp parallel num_threads( thread_size ) slate_omp_default_none \
+        shared( func )
+    {
+        func( omp_get_thread_num() );
+    }
+}
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_PANELTHREADPOOL_HH
@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TASK_GRAPH_HH
+#define SLATE_TASK_GRAPH_HH
+
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace slate {
+namespace trace {
+
+//------------------------------------------------------------------------------
+/// Debug recorder of the OpenMP task graph of drivers such as potrf and
+/// getrf. Drivers register each task before creating it, with the same
+/// in and inout dependencies as its depend clauses, and time it with a
+/// TaskBlock; the graph's edges are derived from the dependencies with
+/// OpenMP's rules. finish writes the graph of each rank as DOT and JSON,
+/// with the critical path and each task's slack from the measured times.
+///
+/// Recording is off by default; then task returns -1 and TaskBlock does
+/// nothing.
+///
+/// Usage:
+///
+///     trace::TaskGraph::on();
+///     slate::potrf( A );
+///     trace::TaskGraph::finish();
+///
+class TaskGraph {
+public:
+    /// Critical path summary of one driver call on this rank.
+    struct Summary {
+        std::string driver;
+        int64_t tasks   = 0;
+        int64_t edges   = 0;
+        double  work    = 0;  ///< sum of task times, in seconds
+        double  span    = 0;  ///< critical path length, in seconds
+        double  elapsed = 0;  ///< first task start to last task stop
+
+        /// @return average parallelism, work / span: how many threads
+        /// the graph could keep busy.
+        double parallelism() const { return span > 0 ? work / span : 0; }
+    };
+
+    static void on();
+    static void off() { enabled_ = false; }
+    static bool enabled() { return enabled_; }
+
+    static void region( const char* driver );
+    static int64_t task( const char* name, int64_t k, int64_t j,
+                         std::initializer_list< void const* > in,
+                         std::initializer_list< void const* > inout );
+    static void start( int64_t id );
+    static void stop( int64_t id );
+
+    static std::vector< Summary > summary();
+    static void finish();
+
+private:
+    struct Node {
+        const char* name;
+        int64_t region;
+        int64_t k;
+        int64_t j;
+        double start = 0;
+        double stop  = 0;
+        std::vector< int64_t > preds;
+    };
+
+    /// Tasks of the last writer and readers since of a dependency address.
+    struct Access {
+        int64_t last_out = -1;
+        std::vector< int64_t > readers;
+    };
+
+    struct Path {
+        std::vector< double > earliest;  ///< earliest finish of each task
+        std::vector< double > slack;     ///< latest - earliest finish
+    };
+
+    static Path criticalPath( std::vector< Summary >& summaries );
+
+    static bool enabled_;
+    // Nodes are in creation order, so predecessors precede each node;
+    // a deque keeps references stable while nodes are added.
+    static std::deque< Node > nodes_;
+    static std::vector< std::string > regions_;
+    static std::map< void const*, Access > access_;
+};
+
+//------------------------------------------------------------------------------
+/// Times the task id of TaskGraph::task from construction to destruction,
+/// on the thread running it.
+///
+class TaskBlock {
+public:
+    TaskBlock( int64_t id )
+        : id_( id )
+    {
+        if (id_ >= 0)
+            TaskGraph::start( id_ );
+    }
+
+    ~TaskBlock()
+    {
+        if (id_ >= 0)
+            TaskGraph::stop( id_ );
+    }
+
+private:
+    int64_t id_;
+};
+
+} // namespace trace
+} // namespace slate
+
+#endif // SLATE_TASK_GRAPH_HH
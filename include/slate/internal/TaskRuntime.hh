@@ -0,0 +1,82 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TASKRUNTIME_HH
+#define SLATE_TASKRUNTIME_HH
+
+#include "slate/config.hh"
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+
+namespace slate {
+namespace internal {
+
+class StealingScheduler;
+
+//------------------------------------------------------------------------------
+/// Task runtime of a driver: spawns tasks with read (in) and read-write
+/// (inout) dependencies on addresses, e.g., entries of the driver's
+/// column[] vectors, and a priority, as `#pragma omp task depend(...)
+/// priority(...)` does, on a pluggable backend (see slate::task_backend):
+///
+/// - TaskBackend::OpenMP makes an OpenMP task per spawn, with depend
+///   clauses on the addresses.
+///
+/// - TaskBackend::Stealing tracks dependencies itself, and runs ready
+///   tasks on the threads of the enclosing OpenMP team, each with its own
+///   deque ordered by priority. A thread runs the newest task of its
+///   highest priority, e.g., a successor made ready by the task it just
+///   finished, whose tiles are still in its cache; an idle thread steals
+///   the oldest task of the highest priority from the nearest thread.
+///
+/// Tasks may use OpenMP tasks internally, as internal routines do.
+///
+/// A TaskRuntime is created by the thread that spawns tasks, inside the
+/// driver's `#pragma omp parallel` and `#pragma omp master` region, and
+/// only that thread calls spawn and wait. The destructor waits for all
+/// tasks.
+///
+/// Usage:
+///
+///     #pragma omp parallel
+///     #pragma omp master
+///     {
+///         internal::TaskRuntime rt;
+///         for (int64_t k = 0; k < nt; ++k) {
+///             rt.spawn( { &column[ k ] }, { &column[ k+1 ] }, priority,
+///                       [=, &A]() { ... } );
+///         }
+///         rt.wait();
+///     }
+///
+class TaskRuntime {
+public:
+    explicit TaskRuntime( TaskBackend backend = task_backend() );
+    ~TaskRuntime();
+
+    TaskRuntime( TaskRuntime const& ) = delete;
+    TaskRuntime& operator=( TaskRuntime const& ) = delete;
+
+    void spawn(
+        std::initializer_list< void const* > in,
+        std::initializer_list< void const* > inout,
+        int priority, std::function< void () > body );
+
+    void wait();
+
+    /// @return backend of this runtime.
+    TaskBackend backend() const { return backend_; }
+
+private:
+    TaskBackend backend_;
+    std::unique_ptr< StealingScheduler > scheduler_;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_TASKRUNTIME_HH
@@ -0,0 +1,87 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_SET_HH
+#define SLATE_TILE_SET_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <vector>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Set of tile indices {i, j}, stored as a sorted vector without duplicates.
+/// Internal routines build one per task to get, hold, or release the tiles
+/// they use (tileGetForReading, etc.). Compared to std::set, it allocates
+/// once as it grows instead of once per tile, and iterates over contiguous
+/// memory. Inserting in increasing order, as the usual loops over a block
+/// column or block row do, appends at the end; duplicates are found by
+/// binary search and skipped.
+///
+class TileSet {
+public:
+    using ij_tuple = std::tuple<int64_t, int64_t>;
+    using value_type = ij_tuple;
+    using const_iterator = std::vector< ij_tuple >::const_iterator;
+    using iterator = const_iterator;
+
+    TileSet() = default;
+
+    TileSet( std::initializer_list< ij_tuple > list )
+    {
+        for (auto const& ij : list)
+            insert( ij );
+    }
+
+    /// Constructs from a range of indices, e.g., a std::set< ij_tuple >.
+    template <typename input_iterator>
+    TileSet( input_iterator first, input_iterator last )
+    {
+        for (; first != last; ++first)
+            insert( *first );
+    }
+
+    /// Inserts ij, unless it is already in the set.
+    /// @return true if ij was inserted.
+    bool insert( ij_tuple const& ij )
+    {
+        if (tiles_.empty() || tiles_.back() < ij) {
+            tiles_.push_back( ij );
+            return true;
+        }
+        auto iter = std::lower_bound( tiles_.begin(), tiles_.end(), ij );
+        if (iter != tiles_.end() && *iter == ij)
+            return false;
+        tiles_.insert( iter, ij );
+        return true;
+    }
+
+    /// @return 1 if ij is in the set, else 0, as std::set::count.
+    size_t count( ij_tuple const& ij ) const
+    {
+        return std::binary_search( tiles_.begin(), tiles_.end(), ij ) ? 1 : 0;
+    }
+
+    /// Removes all indices, keeping the memory for reuse.
+    void clear() { tiles_.clear(); }
+
+    void reserve( size_t n ) { tiles_.reserve( n ); }
+
+    size_t size() const { return tiles_.size(); }
+    bool empty() const { return tiles_.empty(); }
+
+    const_iterator begin() const { return tiles_.begin(); }
+    const_iterator end()   const { return tiles_.end(); }
+
+private:
+    std::vector< ij_tuple > tiles_;
+};
+
+} // namespace slate
+
+#endif // SLATE_TILE_SET_HH
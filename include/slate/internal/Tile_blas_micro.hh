@@ -0,0 +1,395 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_BLAS_MICRO_HH
+#define SLATE_TILE_BLAS_MICRO_HH
+
+#include <blas.hh>
+
+#include "slate/enums.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace slate {
+namespace tile {
+
+//------------------------------------------------------------------------------
+/// Register-blocked host kernels for small tiles.
+/// For tiles of dimension <= micro::max_nb, the BLAS++ and vendor call
+/// overhead dominates the few flops; these kernels pack the operands into
+/// zero-padded, fixed size buffers, then compute with loops whose bounds
+/// are known at compile time. The kernels are instantiated for sizes
+/// 16, 32, 48, 64, selected at runtime by a dispatch table.
+/// Larger tiles, and row-major layouts, fall back to BLAS++.
+///
+namespace micro {
+
+/// Largest tile dimension handled by the micro kernels.
+const int64_t max_nb = 64;
+
+/// Granularity of the instantiated sizes.
+const int64_t nb_step = 16;
+
+/// Register block of C in the gemm kernel.
+const int mr = 8;
+const int nr = 4;
+
+//------------------------------------------------------------------------------
+/// @return true if all dimensions are handled by the micro kernels.
+inline bool fits( int64_t m, int64_t n, int64_t k )
+{
+    return 0 < m && m <= max_nb
+        && 0 < n && n <= max_nb
+        && 0 <= k && k <= max_nb;
+}
+
+/// @return index into the dispatch tables for dimension n, 1 <= n <= max_nb.
+inline int64_t table_index( int64_t n )
+{
+    return (n - 1) / nb_step;
+}
+
+//------------------------------------------------------------------------------
+/// @return element (i, j) of op(A), with A column-major.
+template <typename scalar_t>
+inline scalar_t op_elem(
+    Op op, scalar_t const* A, int64_t lda, int64_t i, int64_t j )
+{
+    if (op == Op::NoTrans)
+        return A[ i + j*lda ];
+    else if (op == Op::Trans)
+        return A[ j + i*lda ];
+    else
+        return blas::conj( A[ j + i*lda ] );
+}
+
+//------------------------------------------------------------------------------
+/// @return per-thread buffer index of max_nb*max_nb elements, for packing.
+/// Kept on the heap: on the stack, two complex<double> buffers would take
+/// 128 KiB of each OpenMP thread's stack. Allocated once per thread; the
+/// kernels contain no task scheduling points, so the buffer is not reentered.
+template <typename scalar_t>
+scalar_t* workspace( int index )
+{
+    thread_local std::vector<scalar_t> buffers[ 2 ];
+    std::vector<scalar_t>& buffer = buffers[ index ];
+    if (buffer.empty())
+        buffer.resize( max_nb * max_nb );
+    return buffer.data();
+}
+
+//------------------------------------------------------------------------------
+/// Copies the m-by-n op(A) into the zero-padded, ld_max-by-n_max buffer Ap.
+template <int64_t ld_max, int64_t n_max, typename scalar_t>
+void pack(
+    Op op, int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda,
+    scalar_t* Ap )
+{
+    for (int64_t j = 0; j < n_max; ++j) {
+        if (j < n) {
+            for (int64_t i = 0; i < m; ++i)
+                Ap[ i + j*ld_max ] = op_elem( op, A, lda, i, j );
+        }
+        for (int64_t i = (j < n ? m : 0); i < ld_max; ++i)
+            Ap[ i + j*ld_max ] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// gemm kernel, C = alpha op(A) op(B) + beta C, for m, n <= nb.
+/// Column-major; k <= max_nb.
+template <int64_t nb, typename scalar_t>
+void gemm_kernel(
+    Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t const* B, int64_t ldb,
+    scalar_t beta,  scalar_t*       C, int64_t ldc )
+{
+    static_assert( nb % mr == 0 && nb % nr == 0, "nb must be a multiple of mr, nr" );
+
+    if (alpha == scalar_t( 0 ))
+        k = 0;
+
+    // Ap is nb-by-k, op(B) is packed transposed as Bp, nb-by-k,
+    // so both are walked with unit stride in i and j.
+    scalar_t* Ap = workspace<scalar_t>( 0 );
+    scalar_t* Bp = workspace<scalar_t>( 1 );
+    pack<nb, max_nb>( opA, m, k, A, lda, Ap );
+    if (opB == Op::ConjTrans) {
+        // conj( op(B)^T ) is B itself conjugated.
+        for (int64_t l = 0; l < max_nb; ++l) {
+            for (int64_t j = 0; j < nb; ++j) {
+                Bp[ j + l*nb ] = (j < n && l < k)
+                               ? blas::conj( B[ j + l*ldb ] )
+                               : scalar_t( 0 );
+            }
+        }
+    }
+    else {
+        pack<nb, max_nb>( (opB == Op::NoTrans ? Op::Trans : Op::NoTrans),
+                          n, k, B, ldb, Bp );
+    }
+
+    for (int64_t jb = 0; jb < n; jb += nr) {
+        for (int64_t ib = 0; ib < m; ib += mr) {
+            scalar_t acc[ nr ][ mr ] = {};
+            for (int64_t l = 0; l < k; ++l) {
+                scalar_t const* a = &Ap[ ib + l*nb ];
+                scalar_t const* b = &Bp[ jb + l*nb ];
+                for (int jj = 0; jj < nr; ++jj)
+                    for (int ii = 0; ii < mr; ++ii)
+                        acc[ jj ][ ii ] += a[ ii ] * b[ jj ];
+            }
+            int64_t mm = std::min( int64_t( mr ), m - ib );
+            int64_t nn = std::min( int64_t( nr ), n - jb );
+            for (int64_t jj = 0; jj < nn; ++jj) {
+                scalar_t* c = &C[ ib + (jb + jj)*ldc ];
+                if (beta == scalar_t( 0 )) {
+                    for (int64_t ii = 0; ii < mm; ++ii)
+                        c[ ii ] = alpha * acc[ jj ][ ii ];
+                }
+                else {
+                    for (int64_t ii = 0; ii < mm; ++ii)
+                        c[ ii ] = alpha * acc[ jj ][ ii ] + beta * c[ ii ];
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// herk kernel, C = alpha op(A) op(A)^H + beta C, for n <= nb.
+/// Column-major; k <= max_nb. Only the uplo triangle of C is updated,
+/// and the imaginary parts of its diagonal are set to zero.
+template <int64_t nb, typename scalar_t>
+void herk_kernel(
+    Uplo uplo, Op op,
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> alpha, scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t> beta,  scalar_t*       C, int64_t ldc )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    if (alpha == real_t( 0 ))
+        k = 0;
+
+    // Ap = op(A) is nb-by-k; for real, Trans == ConjTrans.
+    scalar_t* Ap = workspace<scalar_t>( 0 );
+    pack<nb, max_nb>( (op == Op::NoTrans ? Op::NoTrans : Op::ConjTrans),
+                      n, k, A, lda, Ap );
+
+    for (int64_t j = 0; j < n; ++j) {
+        int64_t ibegin = (uplo == Uplo::Lower ? j : 0);
+        int64_t iend   = (uplo == Uplo::Lower ? n : j + 1);
+        scalar_t acc[ nb ] = {};
+        for (int64_t l = 0; l < k; ++l) {
+            scalar_t bj = blas::conj( Ap[ j + l*nb ] );
+            scalar_t const* a = &Ap[ l*nb ];
+            for (int64_t i = 0; i < nb; ++i)
+                acc[ i ] += a[ i ] * bj;
+        }
+        scalar_t* c = &C[ j*ldc ];
+        for (int64_t i = ibegin; i < iend; ++i) {
+            scalar_t cij = alpha * acc[ i ];
+            if (beta != real_t( 0 ))
+                cij += beta * c[ i ];
+            c[ i ] = cij;
+        }
+        c[ j ] = blas::real( c[ j ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// trsm kernel, solves op(A) X = alpha B or X op(A) = alpha B,
+/// overwriting B with X, for A of dimension <= nb.
+/// Column-major; B is at most max_nb in the other dimension.
+template <int64_t nb, typename scalar_t>
+void trsm_kernel(
+    Side side, Uplo uplo, Op op, Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t*       B, int64_t ldb )
+{
+    int64_t na = (side == Side::Left ? m : n);
+
+    // Ap = op(A), with only its triangle set; the effective uplo of
+    // op(A) flips with transposition.
+    scalar_t* Ap = workspace<scalar_t>( 0 );
+    scalar_t inv_diag[ nb ];
+    Uplo uplo_eff = uplo;
+    if (op != Op::NoTrans)
+        uplo_eff = (uplo == Uplo::Lower ? Uplo::Upper : Uplo::Lower);
+    for (int64_t j = 0; j < na; ++j) {
+        for (int64_t i = 0; i < na; ++i) {
+            bool in_tri = (uplo_eff == Uplo::Lower ? i > j : i < j);
+            Ap[ i + j*nb ] = in_tri ? op_elem( op, A, lda, i, j )
+                                    : scalar_t( 0 );
+        }
+        inv_diag[ j ] = (diag == Diag::Unit)
+                      ? scalar_t( 1 )
+                      : scalar_t( 1 ) / op_elem( op, A, lda, j, j );
+    }
+
+    if (side == Side::Left) {
+        // Column by column of B, substitution with unit stride in i.
+        for (int64_t j = 0; j < n; ++j) {
+            scalar_t b[ nb ];
+            for (int64_t i = 0; i < m; ++i)
+                b[ i ] = alpha * B[ i + j*ldb ];
+            if (uplo_eff == Uplo::Lower) {
+                for (int64_t l = 0; l < m; ++l) {
+                    b[ l ] *= inv_diag[ l ];
+                    scalar_t const* a = &Ap[ l*nb ];
+                    for (int64_t i = l + 1; i < m; ++i)
+                        b[ i ] -= b[ l ] * a[ i ];
+                }
+            }
+            else {
+                for (int64_t l = m - 1; l >= 0; --l) {
+                    b[ l ] *= inv_diag[ l ];
+                    scalar_t const* a = &Ap[ l*nb ];
+                    for (int64_t i = 0; i < l; ++i)
+                        b[ i ] -= b[ l ] * a[ i ];
+                }
+            }
+            for (int64_t i = 0; i < m; ++i)
+                B[ i + j*ldb ] = b[ i ];
+        }
+    }
+    else {
+        // X op(A) = alpha B: column j of X depends on the columns of X
+        // before it (upper) or after it (lower).
+        bool forward = (uplo_eff == Uplo::Upper);
+        for (int64_t jj = 0; jj < n; ++jj) {
+            int64_t j = forward ? jj : n - 1 - jj;
+            scalar_t* bj = &B[ j*ldb ];
+            for (int64_t i = 0; i < m; ++i)
+                bj[ i ] *= alpha;
+            int64_t lbegin = forward ? 0 : j + 1;
+            int64_t lend   = forward ? j : n;
+            for (int64_t l = lbegin; l < lend; ++l) {
+                scalar_t alj = Ap[ l + j*nb ];
+                scalar_t const* bl = &B[ l*ldb ];
+                for (int64_t i = 0; i < m; ++i)
+                    bj[ i ] -= bl[ i ] * alj;
+            }
+            for (int64_t i = 0; i < m; ++i)
+                bj[ i ] *= inv_diag[ j ];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// General matrix multiply, as in blas::gemm, using the micro kernel
+/// if the tile fits, otherwise BLAS++.
+template <typename scalar_t>
+void gemm(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t const* B, int64_t ldb,
+    scalar_t beta,  scalar_t*       C, int64_t ldc )
+{
+    using kernel_t = void (*)(
+        Op, Op, int64_t, int64_t, int64_t,
+        scalar_t, scalar_t const*, int64_t, scalar_t const*, int64_t,
+        scalar_t, scalar_t*, int64_t );
+
+    static const kernel_t table[] = {
+        &gemm_kernel<16, scalar_t>,
+        &gemm_kernel<32, scalar_t>,
+        &gemm_kernel<48, scalar_t>,
+        &gemm_kernel<64, scalar_t>,
+    };
+
+    if (layout == Layout::ColMajor && fits( m, n, k )) {
+        table[ table_index( std::max( m, n ) ) ](
+            opA, opB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc );
+    }
+    else {
+        blas::gemm( layout, opA, opB, m, n, k,
+                    alpha, A, lda, B, ldb, beta, C, ldc );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Hermitian rank-k update, as in blas::herk, using the micro kernel
+/// if the tile fits, otherwise BLAS++.
+template <typename scalar_t>
+void herk(
+    Layout layout, Uplo uplo, Op op,
+    int64_t n, int64_t k,
+    blas::real_type<scalar_t> alpha, scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t> beta,  scalar_t*       C, int64_t ldc )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using kernel_t = void (*)(
+        Uplo, Op, int64_t, int64_t,
+        real_t, scalar_t const*, int64_t,
+        real_t, scalar_t*, int64_t );
+
+    static const kernel_t table[] = {
+        &herk_kernel<16, scalar_t>,
+        &herk_kernel<32, scalar_t>,
+        &herk_kernel<48, scalar_t>,
+        &herk_kernel<64, scalar_t>,
+    };
+
+    // Complex herk with Trans is invalid; let BLAS++ report it.
+    bool valid_op = ! (blas::is_complex<scalar_t>::value && op == Op::Trans);
+    if (layout == Layout::ColMajor && valid_op && fits( n, n, k )
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        table[ table_index( n ) ](
+            uplo, op, n, k, alpha, A, lda, beta, C, ldc );
+    }
+    else {
+        blas::herk( layout, uplo, op, n, k,
+                    alpha, A, lda, beta, C, ldc );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Triangular solve, as in blas::trsm, using the micro kernel
+/// if the tile fits, otherwise BLAS++.
+template <typename scalar_t>
+void trsm(
+    Layout layout, Side side, Uplo uplo, Op op, Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t*       B, int64_t ldb )
+{
+    using kernel_t = void (*)(
+        Side, Uplo, Op, Diag, int64_t, int64_t,
+        scalar_t, scalar_t const*, int64_t, scalar_t*, int64_t );
+
+    static const kernel_t table[] = {
+        &trsm_kernel<16, scalar_t>,
+        &trsm_kernel<32, scalar_t>,
+        &trsm_kernel<48, scalar_t>,
+        &trsm_kernel<64, scalar_t>,
+    };
+
+    if (layout == Layout::ColMajor && fits( m, n, 0 )
+        && (uplo == Uplo::Lower || uplo == Uplo::Upper)) {
+        int64_t na = (side == Side::Left ? m : n);
+        table[ table_index( na ) ](
+            side, uplo, op, diag, m, n, alpha, A, lda, B, ldb );
+    }
+    else {
+        blas::trsm( layout, side, uplo, op, diag, m, n,
+                    alpha, A, lda, B, ldb );
+    }
+}
+
+} // namespace micro
+
+} // namespace tile
+} // namespace slate
+
+#endif // SLATE_TILE_BLAS_MICRO_HH
@@ -0,0 +1,120 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_GEMM3M_HH
+#define SLATE_TILE_GEMM3M_HH
+
+#include <blas.hh>
+
+#include "slate/config.hh"
+#include "slate/enums.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace slate {
+namespace tile {
+
+//------------------------------------------------------------------------------
+/// @return true if a complex gemm with dimensions m, n, k uses the 3M
+/// method, i.e., all of them are at least gemm3m_threshold().
+/// Always false for real types.
+template <typename scalar_t>
+inline bool use_gemm3m( int64_t m, int64_t n, int64_t k )
+{
+    int64_t threshold = gemm3m_threshold();
+    return blas::is_complex<scalar_t>::value
+           && threshold > 0
+           && std::min( { m, n, k } ) >= threshold;
+}
+
+//------------------------------------------------------------------------------
+/// General matrix multiply by the 3M (Gauss) method, as in blas::gemm,
+/// $C = \alpha op(A) op(B) + \beta C$, for complex types.
+/// With op(A) = Ar + i Ai and op(B) = Br + i Bi, it computes 3 real gemm's
+/// \[
+///     T_1 = A_r B_r, \quad
+///     T_2 = A_i B_i, \quad
+///     T_3 = (A_r + A_i)(B_r + B_i),
+/// \]
+/// so op(A) op(B) = (T1 - T2) + i (T3 - T1 - T2), with 3/4 of the flops
+/// of a complex gemm, on real and imaginary parts packed into a workspace.
+/// @see gemm3m_threshold()
+///
+template <typename scalar_t>
+void gemm3m(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t const* B, int64_t ldb,
+    scalar_t beta,  scalar_t*       C, int64_t ldc )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::real;
+    using blas::imag;
+
+    if (layout == Layout::RowMajor) {
+        // Row-major C = op(A) op(B) is column-major C^T = op(B)^T op(A)^T.
+        gemm3m( Layout::ColMajor, opB, opA, n, m, k,
+                alpha, B, ldb, A, lda, beta, C, ldc );
+        return;
+    }
+
+    // Ar, Ai, As are m-by-k; Br, Bi, Bs are k-by-n; T1, T2, T3 are m-by-n.
+    std::vector<real_t> work( 3*(m*k + k*n + m*n) );
+    real_t* Ar = work.data();
+    real_t* Ai = Ar + m*k;
+    real_t* As = Ai + m*k;
+    real_t* Br = As + m*k;
+    real_t* Bi = Br + k*n;
+    real_t* Bs = Bi + k*n;
+    real_t* T1 = Bs + k*n;
+    real_t* T2 = T1 + m*n;
+    real_t* T3 = T2 + m*n;
+
+    // Splits the p-by-q op(X) into Xr, Xi, Xs = Xr + Xi.
+    auto split = []( Op op, int64_t p, int64_t q,
+                     scalar_t const* X, int64_t ldx,
+                     real_t* Xr, real_t* Xi, real_t* Xs )
+    {
+        for (int64_t j = 0; j < q; ++j) {
+            for (int64_t i = 0; i < p; ++i) {
+                scalar_t x = op == Op::NoTrans ? X[ i + j*ldx ] : X[ j + i*ldx ];
+                real_t xi = op == Op::ConjTrans ? -imag( x ) : imag( x );
+                Xr[ i + j*p ] = real( x );
+                Xi[ i + j*p ] = xi;
+                Xs[ i + j*p ] = real( x ) + xi;
+            }
+        }
+    };
+    split( opA, m, k, A, lda, Ar, Ai, As );
+    split( opB, k, n, B, ldb, Br, Bi, Bs );
+
+    const real_t one = 1, zero = 0;
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                one, Ar, m, Br, k, zero, T1, m );
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                one, Ai, m, Bi, k, zero, T2, m );
+    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans, m, n, k,
+                one, As, m, Bs, k, zero, T3, m );
+
+    // With beta = 0, C is not read, as in blas::gemm.
+    bool overwrite = beta == scalar_t( 0 );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            int64_t ij = i + j*m;
+            scalar_t t = blas::make_scalar<scalar_t>(
+                T1[ ij ] - T2[ ij ], T3[ ij ] - T1[ ij ] - T2[ ij ] );
+            scalar_t& c = C[ i + j*ldc ];
+            c = overwrite ? alpha * t : alpha * t + beta * c;
+        }
+    }
+}
+
+} // namespace tile
+} // namespace slate
+
+#endif // SLATE_TILE_GEMM3M_HH
@@ -6,57 +6,142 @@
 #ifndef SLATE_TRACE_HH
 #define SLATE_TRACE_HH
 
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <map>
 #include <set>
 #include <vector>
 #include <string>
 
-#include <cstring>
-
 #include "slate/internal/mpi.hh"
 #include "slate/internal/openmp.hh"
 
+namespace blas {
+class Queue;
+}
+
 namespace slate {
 namespace trace {
 
 //------------------------------------------------------------------------------
+/// Trace file format written by Trace::finish.
+///
+enum class Format : char {
+    SVG  = 's',     ///< one SVG timeline, gathered to rank 0
+    JSON = 'j',     ///< Chrome trace JSON, for Perfetto or chrome://tracing,
+                    ///< written by all ranks with MPI-IO, without a gather
+};
+
+//------------------------------------------------------------------------------
+/// Returns time in seconds on the steady clock, used for event times.
+///
+inline double now()
+{
+    using namespace std::chrono;
+    return duration<double>( steady_clock::now().time_since_epoch() ).count();
+}
+
+//------------------------------------------------------------------------------
+/// Fixed-size record of one block. The name is an id into Trace's table of
+/// interned names, so recording an event copies no strings.
 ///
 class Event {
 public:
     friend class Trace;
+    friend class Block;
 
     Event()
     {}
 
-    Event(const char* name, int index, int nest)
-        : start_(omp_get_wtime()),
+    Event(int name_id, int64_t index, int nest,
+          int64_t i = -1, int64_t j = -1, int64_t bytes = 0)
+        : start_( now() ),
           index_( index ),
+          i_( i ),
+          j_( j ),
+          bytes_( bytes ),
+          name_id_( name_id ),
           nest_(nest)
-    {
-        // todo: do with C++ instead of cstring?
-        strncpy(name_, name, 30);
-        name_[30]='\0';
-    }
+    {}
 
-    void stop() { stop_ = omp_get_wtime(); }
+    void stop() { stop_ = now(); }
 
 private:
-    char name_[31];
     double start_;
     double stop_;
     int64_t index_;
+    int64_t i_;     ///< tile row index, or -1
+    int64_t j_;     ///< tile col index, or -1
+    int64_t bytes_; ///< bytes moved, e.g., by a tile send
+    int name_id_ = -1;  ///< index in Trace::names_, or -1 if not recorded
     int nest_;
+    int queue_ = -1;    ///< for device events, queue index; index_ is
+                        ///< then the batch count
+};
+
+//------------------------------------------------------------------------------
+/// Device event not yet resolved: CUDA or HIP events recorded on a queue
+/// around a launch, timed when the trace is finished.
+///
+struct DeviceEvent {
+    void* start;
+    void* stop;
+    int device;
+    int queue;
+    int name_id;
+    int64_t batch_count;
+};
+
+//------------------------------------------------------------------------------
+/// Aggregate of events of one name that are not in the trace, because
+/// their step was not sampled or they were overwritten in the ring buffer:
+/// count, times, and a histogram of durations in powers of 2.
+///
+struct EventStats {
+    static const int num_bins = 32;
+
+    int64_t count = 0;
+    double total = 0;   ///< seconds
+    double min = std::numeric_limits<double>::max();
+    double max = 0;
+    /// bins[ 0 ] counts durations < 1 us; bins[ b ] counts durations in
+    /// [ 2^(b-1), 2^b ) us; the last bin counts all longer durations.
+    int64_t bins[ num_bins ] = {};
+
+    void add( double seconds );
+    EventStats& operator += ( EventStats const& other );
+};
+
+//------------------------------------------------------------------------------
+/// Preallocated ring buffer of one thread's events. Aligned to avoid false
+/// sharing of count between threads.
+///
+struct alignas(64) ThreadEvents {
+    std::vector<Event> events;  ///< capacity is a power of 2
+    int64_t count = 0;          ///< events recorded, including overwritten
+    std::vector<EventStats> stats;  ///< aggregates, indexed by name id
 };
+
 //------------------------------------------------------------------------------
+/// Records events of Blocks in per-thread ring buffers, and writes them
+/// as a timeline in finish.
+///
+/// To bound trace size on long runs, sampleSteps traces only some steps
+/// (see Step), and capacity bounds the events kept per thread. Events not
+/// kept, either not sampled or overwritten, are aggregated per name with a
+/// histogram of durations; finish prints the aggregates on rank 0.
 ///
 class Trace {
 public:
     friend class Block;
+    friend class DeviceBlock;
+    friend class Step;
 
-    static void on() { tracing_ = true; }
+    static void on();
     static void off() { tracing_ = false; }
 
-    static void insert(Event event);
+    static void insert(Event const& event);
     static void finish();
     static void comment(std::string const& str);
 
@@ -68,7 +153,34 @@ public:
     static double pixels_per_second() { return hscale_; }
     static void   pixels_per_second(double s) { hscale_ = s; }
 
+    // File format written by finish.
+    static Format format() { return format_; }
+    static void   format(Format f) { format_ = f; }
+
+    // Events kept per thread; older events are overwritten. Set before on().
+    static int64_t capacity() { return capacity_; }
+    static void    capacity(int64_t c) { capacity_ = c; }
+
+    static int intern(const char* name);
+
+    // Sampling by step, e.g., the k loop of a factorization; see Step.
+    static void sampleSteps(int64_t first, int64_t last, int64_t every=1);
+    static void sampleAll() { sampling_ = false; }
+    static bool stepSampled(int64_t k);
+
+    static std::map<std::string, EventStats> aggregated();
+
 private:
+    static bool sampled();
+    static void aggregate(ThreadEvents& buffer, int name_id, double seconds);
+    static void printAggregated(FILE* file);
+
+    static int internString(std::string const& name);
+    static const char* name(Event const& event)
+        { return names_[ event.name_id_ ].c_str(); }
+    static void collectEvents();
+    static void finishSVG();
+    static void finishJSON();
     static double getTimeSpan();
     static void printProcEvents(int mpi_rank, int mpi_size,
                                 double timespan, FILE* trace_file);
@@ -94,7 +206,30 @@ private:
 
     static bool tracing_;
     static int num_threads_;
+    static int num_rows_;
+    static Format format_;
+    static int64_t capacity_;
+
+    static bool sampling_;
+    static int64_t sample_first_;
+    static int64_t sample_last_;
+    static int64_t sample_every_;
+    // Number of sampled Steps running, on any thread.
+    static std::atomic<int> active_sampled_;
+
+    // Recorded events, and their names.
+    static std::vector<ThreadEvents> buffers_;
+    static std::vector<std::string> names_;
+    static std::map<std::string, int> name_ids_;
 
+    // Device events, per thread, and for each device, a reference event
+    // and its host time, to align device times with host times.
+    static std::vector<std::vector<DeviceEvent>> device_events_;
+    static std::vector<void*> device_ref_events_;
+    static std::vector<double> device_ref_times_;
+
+    // Events in order, collected from buffers_ and device_events_ by
+    // finish: one row per thread, then one row per device.
     static std::vector<std::vector<Event>> events_;
 };
 
@@ -103,12 +238,51 @@ private:
 class Block {
 public:
     Block( const char* name, int64_t index=0 );
+    Block( const char* name, int64_t i, int64_t j, int64_t bytes );
     ~Block();
 
 private:
     Event event_;
 };
 
+//------------------------------------------------------------------------------
+/// Marks the code in its scope, on this thread, as part of step k of a
+/// driver, e.g., a task of panel k. With Trace::sampleSteps, events in
+/// steps that are not sampled are only aggregated. Events outside any Step
+/// on their thread, e.g., in nested tasks of internal routines, are traced
+/// while some sampled Step runs.
+///
+class Step {
+public:
+    Step( int64_t k );
+    ~Step();
+
+private:
+    int64_t prev_;
+    bool counted_;
+};
+
+//------------------------------------------------------------------------------
+/// Marks device work launched on a queue, e.g., a batched BLAS call, by
+/// recording CUDA or HIP events on the queue before and after it. The
+/// device times, not the launch times, are shown in an extra row for each
+/// device, with the queue index and batch count.
+/// Does nothing without tracing or GPU support.
+///
+class DeviceBlock {
+public:
+    DeviceBlock( const char* name, blas::Queue& queue,
+                 int queue_index=0, int64_t batch_count=1 );
+    ~DeviceBlock();
+
+private:
+    blas::Queue* queue_ = nullptr;  ///< null if not recording
+    void* start_ = nullptr;
+    int name_id_;
+    int queue_index_;
+    int64_t batch_count_;
+};
+
 } // namespace trace
 } // namespace slate
 
@@ -10,23 +10,87 @@
 #define SLATE_INTERNAL_COMM_HH
 
 #include <list>
+#include <map>
 #include <set>
+#include <utility>
+#include <vector>
 
+#include "slate/enums.hh"
 #include "slate/internal/mpi.hh"
 
 namespace slate {
 namespace internal {
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Cache of sub-communicators, keyed by their set of ranks, so repeated
+/// panels over the same ranks don't each create and free a communicator.
+/// Each matrix has a cache, which frees its communicators when the matrix
+/// is destroyed.
+///
+/// Communicators are never evicted before then: creating one is collective
+/// over its ranks, so all of them must agree whether it is cached, which
+/// per-rank eviction, e.g., LRU, could not guarantee.
+///
+class CommCache {
+public:
+    CommCache() {}
+    ~CommCache();
+
+    // not copyable, since it owns communicators.
+    CommCache(CommCache const& orig) = delete;
+    CommCache& operator = (CommCache const& orig) = delete;
+
+    MPI_Comm get(const std::set<int>& ranks,
+                 MPI_Comm mpi_comm, MPI_Group mpi_group, int tag,
+                 MPI_Group* group);
+
+    void clear();
+
+    /// @return number of cached communicators.
+    size_t size() const
+    {
+        return comms_.size();
+    }
+
+private:
+    /// communicator and its group, by set of ranks
+    std::map< std::set<int>, std::pair<MPI_Comm, MPI_Group> > comms_;
+};
+
 MPI_Comm commFromSet(const std::set<int>& bcast_set,
                      MPI_Comm mpi_comm, MPI_Group mpi_group,
                      const int in_rank, int& out_rank, int tag = 0);
 
+MPI_Comm commFromSet(const std::set<int>& bcast_set,
+                     MPI_Comm mpi_comm, MPI_Group mpi_group,
+                     const int in_rank, int& out_rank, int tag,
+                     CommCache& cache);
+
 void cubeBcastPattern(int size, int rank, int radix,
                       std::list<int>& recv_from, std::list<int>& send_to);
 
 void cubeReducePattern(int size, int rank, int radix,
                        std::list<int>& recv_from, std::list<int>& send_to);
 
+std::vector<int> const& commNodes(MPI_Comm mpi_comm);
+std::vector<int> const* commNodesCached(MPI_Comm mpi_comm);
+
+void hierarchicalBcastPattern(std::vector<int> const& bcast_ranks,
+                              std::vector<int> const& nodes,
+                              int rank, int radix,
+                              std::list<int>& recv_from,
+                              std::list<int>& send_to);
+
+void tournamentReducePattern(std::vector<int> const& ranks,
+                             std::vector<int> const* nodes,
+                             TournamentTree tree, int rank,
+                             std::list<int>& recv_from,
+                             std::list<int>& send_to);
+
+MPI_Datatype mpi_vector_type(int count, int blocklength, int stride,
+                             MPI_Datatype oldtype);
+
 } // namespace internal
 } // namespace slate
 
@@ -96,6 +96,26 @@ void gecopy(
     dst_scalar_t** Barray, int64_t ldb,
     int64_t batch_count, blas::Queue& queue);
 
+//------------------------------------------------------------------------------
+template <typename src_scalar_t, typename dst_scalar_t>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* col_max,
+    int64_t ldv,
+    int64_t batch_count, blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* col_max,
+    int64_t ldv,
+    int64_t batch_count, blas::Queue& queue);
+
 //------------------------------------------------------------------------------
 template <typename src_scalar_t, typename dst_scalar_t>
 void tzcopy(
@@ -156,6 +176,57 @@ void tzset(
     scalar_t* A, int64_t lda,
     blas::Queue& queue );
 
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void genrand(
+    int dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    blas::real_type<scalar_t> diag_add, blas::real_type<scalar_t> scale,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    scalar_t** rows,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void iamax(
+    int64_t n, scalar_t const* x, int64_t incx,
+    int64_t* index, scalar_t* value,
+    blas::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Variable-size batched routines: per-tile m, n, ld arrays in GPU memory,
+// so one launch covers all tiles, including edge tiles.
+template <typename scalar_t>
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t const* lda,
+    scalar_t const& beta,  scalar_t** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename scalar_t2>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t2 numer, scalar_t2 denom,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
 namespace batch {
 
 //------------------------------------------------------------------------------
@@ -248,6 +319,77 @@ void trnorm(
     blas::real_type<scalar_t>* values, int64_t ldv,
     int64_t batch_count, blas::Queue& queue);
 
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void trtrm(
+    Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// 3M (Gauss) complex gemm; complex types only.
+template <typename scalar_t>
+void gemm3m_split(
+    int64_t m, int64_t n, bool conj_A,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* Ar,
+    blas::real_type<scalar_t>* Ai,
+    blas::real_type<scalar_t>* As, int64_t ldr,
+    blas::Queue& queue);
+
+template <typename scalar_t>
+void gemm3m_combine(
+    int64_t m, int64_t n,
+    scalar_t const& alpha,
+    blas::real_type<scalar_t> const* T1,
+    blas::real_type<scalar_t> const* T2,
+    blas::real_type<scalar_t> const* T3, int64_t ldt,
+    scalar_t const& beta, scalar_t* C, int64_t ldc,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
 //------------------------------------------------------------------------------
 // In-place, square.
 template <typename scalar_t>
@@ -280,6 +422,21 @@ void transpose_batch(
     scalar_t** dAT_array, int64_t ldat,
     int64_t batch_count, blas::Queue& queue);
 
+//------------------------------------------------------------------------------
+// In-place, rectangular, contiguous (lda = m).
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A, blas::Queue& queue);
+
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray,
+    int64_t batch_count, blas::Queue& queue);
+
 } // namespace device
 } // namespace slate
 
@@ -11,6 +11,8 @@
 
 #include "slate/Exception.hh"
 
+#include <functional>
+
 #ifndef SLATE_NO_MPI
     #include <mpi.h>
 #else
@@ -22,6 +24,9 @@ typedef int MPI_Request;
 typedef int MPI_Status;
 typedef int MPI_Op;
 typedef int MPI_Fint;
+typedef long MPI_Aint;
+typedef int MPI_Info;
+typedef int MPI_Win;
 
 enum {
     MPI_COMM_NULL,
@@ -45,11 +50,15 @@ enum {
 
     MPI_MAX,
     MPI_MAXLOC,
+    MPI_MIN,
     MPI_SUM,
 
     MPI_SUCCESS,
     MPI_THREAD_MULTIPLE,
     MPI_THREAD_SERIALIZED,
+
+    MPI_COMM_TYPE_SHARED,
+    MPI_MODE_NOCHECK,
 };
 
 #define MPI_MAX_ERROR_STRING 512
@@ -57,10 +66,23 @@ enum {
 extern int* MPI_STATUS_IGNORE;
 #define MPI_STATUSES_IGNORE NULL
 #define MPI_REQUEST_NULL 0
+#define MPI_BOTTOM nullptr
+#define MPI_INFO_NULL 0
+#define MPI_WIN_NULL 0
 
 typedef void (MPI_User_function) (void* a,
                                   void* b, int* len, MPI_Datatype* type);
 
+typedef int (MPI_Comm_copy_attr_function) (MPI_Comm comm, int keyval,
+                                           void* extra_state,
+                                           void* attribute_in,
+                                           void* attribute_out, int* flag);
+typedef int (MPI_Comm_delete_attr_function) (MPI_Comm comm, int keyval,
+                                             void* attribute,
+                                             void* extra_state);
+#define MPI_COMM_NULL_COPY_FN ((MPI_Comm_copy_attr_function*) nullptr)
+#define MPI_KEYVAL_INVALID -1
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -70,6 +92,10 @@ int MPI_Type_contiguous(int count, MPI_Datatype oldtype, MPI_Datatype* newtype);
 int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm);
 
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                  MPI_Comm comm);
+
 int MPI_Barrier(MPI_Comm comm);
 
 int MPI_Bcast(void* buffer, int count, MPI_Datatype datatype, int root,
@@ -78,10 +104,19 @@ int MPI_Bcast(void* buffer, int count, MPI_Datatype datatype, int root,
 int MPI_Comm_create_group(MPI_Comm comm, MPI_Group group, int tag,
                           MPI_Comm* newcomm);
 
+int MPI_Comm_create_keyval(MPI_Comm_copy_attr_function* copy_fn,
+                           MPI_Comm_delete_attr_function* delete_fn,
+                           int* keyval, void* extra_state);
+int MPI_Comm_get_attr(MPI_Comm comm, int keyval, void* attribute, int* flag);
+int MPI_Comm_set_attr(MPI_Comm comm, int keyval, void* attribute);
+
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm* newcomm);
 int MPI_Comm_free(MPI_Comm* comm);
 int MPI_Comm_group(MPI_Comm comm, MPI_Group* group);
 int MPI_Comm_rank(MPI_Comm comm, int* rank);
 int MPI_Comm_size(MPI_Comm comm, int* size);
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info info,
+                        MPI_Comm* newcomm);
 MPI_Fint MPI_Comm_f2c(MPI_Comm comm);
 
 int MPI_Group_free(MPI_Group* group);
@@ -98,6 +133,17 @@ int MPI_Init_thread(int* argc, char*** argv, int required, int* provided);
 
 int MPI_Initialized(int* flag);
 
+int MPI_Finalized(int* flag);
+
+int MPI_Query_thread(int* provided);
+
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count,
+                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request);
+
+int MPI_Ibcast(void* buffer, int count, MPI_Datatype datatype, int root,
+               MPI_Comm comm, MPI_Request* request);
+
 int MPI_Irecv(void* buf, int count, MPI_Datatype datatype, int source,
               int tag, MPI_Comm comm, MPI_Request* request);
 
@@ -107,6 +153,9 @@ int MPI_Isend(const void* buf, int count, MPI_Datatype datatype, int dest,
 int MPI_Recv(void* buf, int count, MPI_Datatype datatype, int source,
              int tag, MPI_Comm comm, MPI_Status* status);
 
+int MPI_Recv_init(void* buf, int count, MPI_Datatype datatype, int source,
+                  int tag, MPI_Comm comm, MPI_Request* request);
+
 int MPI_Op_create(MPI_User_function *user_fn, int commute, MPI_Op *op);
 
 int MPI_Op_free(MPI_Op *op);
@@ -119,22 +168,58 @@ int MPI_Request_free(MPI_Request* request);
 int MPI_Send(const void* buf, int count, MPI_Datatype datatype, int dest,
              int tag, MPI_Comm comm);
 
+int MPI_Send_init(const void* buf, int count, MPI_Datatype datatype,
+                  int dest, int tag, MPI_Comm comm, MPI_Request* request);
+
 int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                  int dest, int sendtag, void* recvbuf, int recvcount,
                  MPI_Datatype recvtype, int source, int recvtag,
                  MPI_Comm comm, MPI_Status *status);
 
+int MPI_Start(MPI_Request* request);
+
+int MPI_Get_address(const void* location, MPI_Aint* address);
+
 int MPI_Type_commit(MPI_Datatype* datatype);
 
+int MPI_Type_create_struct(int count, const int blocklengths[],
+                           const MPI_Aint displacements[],
+                           const MPI_Datatype types[], MPI_Datatype* newtype);
+
 int MPI_Type_free(MPI_Datatype* datatype);
 
 int MPI_Type_vector(int count, int blocklength, int stride,
                     MPI_Datatype oldtype, MPI_Datatype* newtype);
 
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status);
+
+int MPI_Testall(int count, MPI_Request requests[], int* flag,
+                MPI_Status statuses[]);
+
+int MPI_Testany(int count, MPI_Request requests[], int* index, int* flag,
+                MPI_Status* status);
+
 int MPI_Wait(MPI_Request* request, MPI_Status* status);
 
 int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[]);
 
+int MPI_Waitany(int count, MPI_Request requests[], int* index,
+                MPI_Status* status);
+
+int MPI_Win_allocate_shared(MPI_Aint size, int disp_unit, MPI_Info info,
+                            MPI_Comm comm, void* baseptr, MPI_Win* win);
+
+int MPI_Win_free(MPI_Win* win);
+
+int MPI_Win_lock_all(int mode, MPI_Win win);
+
+int MPI_Win_shared_query(MPI_Win win, int rank, MPI_Aint* size,
+                         int* disp_unit, void* baseptr);
+
+int MPI_Win_sync(MPI_Win win);
+
+int MPI_Win_unlock_all(MPI_Win win);
+
 int MPI_Error_string(int errorcode, char* string, int* resultlen);
 
 int MPI_Finalize(void);
@@ -169,7 +254,16 @@ public:
     }
 };
 
+namespace internal {
+
+bool comm_thread_active();
+int comm_thread_call( std::function< int () > const& call );
+
+} // namespace internal
+
 /// Throws an MpiException if the MPI call fails.
+/// If comm_thread() is enabled, the call is made on the communication
+/// thread. @see internal::comm_thread_call
 /// Example:
 ///
 ///     try {
@@ -181,7 +275,9 @@ public:
 ///
 #define slate_mpi_call(call) \
     do { \
-        int slate_mpi_call_ = call; \
+        int slate_mpi_call_ = slate::internal::comm_thread_active() \
+            ? slate::internal::comm_thread_call( [&]() { return call; } ) \
+            : call; \
         if (slate_mpi_call_ != MPI_SUCCESS) \
             throw slate::MpiException( \
                 #call, slate_mpi_call_, __func__, __FILE__, __LINE__); \
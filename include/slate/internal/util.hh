@@ -15,6 +15,7 @@
 
 #include <blas.hh>
 #include <atomic>
+#include <thread>
 
 namespace slate {
 
@@ -129,8 +130,14 @@ inline /*constexpr*/ double cabs1(std::complex<double> x)
 }
 
 //------------------------------------------------------------------------------
+/// Barrier for the threads of a panel factorization.
+/// Waiting threads spin, which is fastest while each has its own core; after
+/// max_spins, they yield between checks, so a thread preempted by another
+/// on its core, e.g., an update task, can reach the barrier.
 class ThreadBarrier {
 public:
+    static constexpr int max_spins = 4096;
+
     ThreadBarrier()
         : count_(0),
           passed_(0)
@@ -143,8 +150,12 @@ public:
         __sync_fetch_and_add(&count_, 1);
         if (__sync_bool_compare_and_swap(&count_, size, 0))
             ++passed_;
-        else
-            while (passed_ == passed_old) {}
+        else {
+            for (int spins = 0; passed_ == passed_old; ++spins) {
+                if (spins >= max_spins)
+                    std::this_thread::yield();
+            }
+        }
     }
 
 private:
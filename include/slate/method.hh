@@ -11,6 +11,15 @@
 
 #include "slate/types.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
 namespace slate {
 
 // This defines default values that MUST be considered in the inner namespaces
@@ -20,6 +29,170 @@ constexpr char baseMethodAuto_str[]   = "auto";
 const Method baseMethodError = -1;
 const Method baseMethodAuto  = 0;
 
+//------------------------------------------------------------------------------
+/// Analytic cost model used by select_algo below when the method is Auto.
+/// The time of each algorithm, per rank, is estimated as
+///     flops / flop_rate + bytes / bandwidth + messages * latency,
+/// from the data movement of its SUMMA variant on A's p-by-q grid.
+/// Machine parameters have generic defaults. If the environment variable
+/// SLATE_COST_MODEL names a file, they are read from it once; the file is
+/// written by CostModel::calibrate().
+/// With Option::PrintVerbose >= 1, rank 0 prints each choice and its costs.
+namespace CostModel {
+
+    struct Machine {
+        double host_flop_rate   = 2e10;  ///< flop/s per rank on the host
+        double device_flop_rate = 5e12;  ///< flop/s per GPU
+        double bandwidth        = 1e10;  ///< bytes/s between ranks
+        double latency          = 2e-6;  ///< seconds per message
+    };
+
+    /// Reads "name value" lines into machine; unknown names are ignored.
+    /// @return true if the file could be opened.
+    inline bool read( Machine& machine, const char* filename )
+    {
+        std::ifstream file( filename );
+        if (! file)
+            return false;
+        std::string name;
+        double value;
+        while (file >> name >> value) {
+            if (name == "host_flop_rate")
+                machine.host_flop_rate = value;
+            else if (name == "device_flop_rate")
+                machine.device_flop_rate = value;
+            else if (name == "bandwidth")
+                machine.bandwidth = value;
+            else if (name == "latency")
+                machine.latency = value;
+        }
+        return true;
+    }
+
+    /// @return machine parameters shared by all selectors.
+    inline Machine& machine()
+    {
+        static Machine machine_ = [] {
+            Machine m;
+            const char* filename = std::getenv( "SLATE_COST_MODEL" );
+            if (filename != nullptr)
+                read( m, filename );
+            return m;
+        }();
+        return machine_;
+    }
+
+    void calibrate( MPI_Comm comm, const char* filename = nullptr,
+                    int64_t nb = 256 );
+
+    /// Process grid and compute resources of a matrix.
+    struct Grid {
+        double p, q;
+        double flop_rate;  ///< flop/s per rank
+        double word;       ///< bytes per element
+    };
+
+    template <typename TA>
+    inline Grid grid( TA& A, Options const& opts )
+    {
+        Target target = get_option( opts, Option::Target, Target::HostTask );
+
+        GridOrder order;
+        int p, q, myrow, mycol;
+        A.gridinfo( &order, &p, &q, &myrow, &mycol );
+        if (p <= 0 || q <= 0) {
+            // Not 2D block cyclic; treat as a 1D grid.
+            slate_mpi_call(
+                MPI_Comm_size( A.mpiComm(), &p ) );
+            q = 1;
+        }
+
+        Grid g;
+        g.p = p;
+        g.q = q;
+        g.flop_rate = (target == Target::Devices && A.num_devices() > 0
+                       ? machine().device_flop_rate * A.num_devices()
+                       : machine().host_flop_rate);
+        g.word = sizeof( typename TA::value_type );
+        return g;
+    }
+
+    /// Depth of a broadcast or reduction tree over x ranks.
+    inline double depth( double x )
+    {
+        return std::ceil( std::log2( std::max( x, 1.0 ) ) );
+    }
+
+    /// SUMMA with C (m-by-n) stationary, as in gemmC, hemmC, trsmB, herkC:
+    /// each of the kt steps broadcasts a block col of A along process rows
+    /// and a block row of B along process cols. Flops are spread over the
+    /// ranks that own C.
+    inline double stationary_C(
+        Grid const& g, double flops, double m, double n, double k,
+        double mt, double nt, double kt )
+    {
+        Machine const& mc = machine();
+        double ranks = std::min( g.p, mt ) * std::min( g.q, nt );
+        double bytes = g.word * (m*k / g.p * depth( g.q )
+                                 + k*n / g.q * depth( g.p ));
+        double messages = kt * (std::ceil( mt / g.p ) * depth( g.q )
+                                + std::ceil( nt / g.q ) * depth( g.p ));
+        return flops / (ranks * g.flop_rate)
+               + bytes / mc.bandwidth + messages * mc.latency;
+    }
+
+    /// SUMMA with A (m-by-k) stationary, as in gemmA, hemmA, trsmA:
+    /// each of the nt block cols of B is broadcast to the ranks owning A,
+    /// and partial sums of C are reduced along process rows. Flops are
+    /// spread over the ranks that own A.
+    inline double stationary_A(
+        Grid const& g, double flops, double m, double n, double k,
+        double mt, double nt, double kt )
+    {
+        Machine const& mc = machine();
+        double ranks = std::min( g.p, mt ) * std::min( g.q, kt );
+        double bytes = g.word * (k*n / g.q * depth( g.p )
+                                 + m*n / g.p * depth( g.q ));
+        double messages = nt * (std::ceil( kt / g.q ) * depth( g.p )
+                                + std::ceil( mt / g.p ) * depth( g.q ));
+        return flops / (ranks * g.flop_rate)
+               + bytes / mc.bandwidth + messages * mc.latency;
+    }
+
+    /// @return index of the smallest cost; ties go to the first, so list
+    /// the usual default first. Methods that don't apply have infinite cost.
+    /// With Option::PrintVerbose >= 1, rank 0 prints the costs and the choice.
+    template <typename TA>
+    inline int choose(
+        TA& A, Options const& opts, const char* routine,
+        std::vector<const char*> const& names,
+        std::vector<double> const& costs )
+    {
+        int best = 0;
+        for (size_t i = 1; i < costs.size(); ++i) {
+            if (costs[ i ] < costs[ best ])
+                best = i;
+        }
+
+        int verbose = get_option<int>( opts, Option::PrintVerbose, 0 );
+        if (verbose >= 1 && A.mpiRank() == 0) {
+            std::string msg = std::string( "slate::" ) + routine + ": method "
+                            + names[ best ] + ", estimated";
+            for (size_t i = 0; i < costs.size(); ++i) {
+                char buf[ 80 ];
+                snprintf( buf, sizeof( buf ), " %s %.3g s", names[ i ],
+                          costs[ i ] );
+                msg += buf;
+            }
+            printf( "%s\n", msg.c_str() );
+        }
+        return best;
+    }
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+} // namespace CostModel
+
 //------------------------------------------------------------------------------
 /// Select the right algorithm to perform the trsm
 namespace MethodTrsm {
@@ -31,17 +204,48 @@ namespace MethodTrsm {
     const Method TrsmA  = 1;  ///< Select trsmA algorithm
     const Method TrsmB  = 2;  ///< Select trsmB algorithm
 
+    /// Uses CostModel: trsmB keeps B stationary, like gemmC with k = m;
+    /// trsmA keeps A stationary, like gemmA. trsmA supports one GPU only.
     template <typename TA, typename TB>
     inline Method select_algo(TA& A, TB& B, Options const& opts) {
         Target target = get_option( opts, Option::Target, Target::HostTask );
         int n_devices = A.num_devices();
 
-        Method method = (B.nt() < 2 ? TrsmA : TrsmB);
+        // For side = right, solve the transposed problem.
+        bool left = A.m() == B.m();
+        double m  = left ? B.m()  : B.n();
+        double n  = left ? B.n()  : B.m();
+        double mt = left ? B.mt() : B.nt();
+        double nt = left ? B.nt() : B.mt();
+        double flops = m * m * n;
+
+        auto g = CostModel::grid( A, opts );
+        double cost_A = CostModel::stationary_A( g, flops, m, n, m, mt, nt, mt );
+        double cost_B = CostModel::stationary_C( g, flops, m, n, m, mt, nt, mt );
+        if (target == Target::Devices && n_devices > 1)
+            cost_A = CostModel::infinity;
+
+        int i = CostModel::choose( A, opts, "trsm", { TrsmB_str, TrsmA_str },
+                                   { cost_B, cost_A } );
+        return i == 0 ? TrsmB : TrsmA;
+    }
 
-        if (method == TrsmA && target == Target::Devices && n_devices > 1)
-          method = TrsmB;
+    /// Options for the triangular solves of getrs, potrs, etc.
+    /// With one block column of right-hand sides (nrhs <= nb), the solve
+    /// is latency bound, so unless the caller chose a method, trsmA is
+    /// used: the factor stays in place and only the RHS blocks move, in
+    /// a pipeline along the grid.
+    template <typename TA, typename TB>
+    inline Options solve_options(TA& A, TB& B, Options const& opts) {
+        Target target = get_option( opts, Option::Target, Target::HostTask );
+        Method method = get_option( opts, Option::MethodTrsm, Auto );
 
-        return method;
+        Options opts2 = opts;
+        if (method == Auto && B.nt() == 1
+            && ! (target == Target::Devices && A.num_devices() > 1)) {
+            opts2[ Option::MethodTrsm ] = TrsmA;
+        }
+        return opts2;
     }
 
     inline Method str2methodTrsm(const char* method)
@@ -78,23 +282,37 @@ namespace MethodGemm {
 
     constexpr char GemmA_str[] = "A";
     constexpr char GemmC_str[] = "C";
+    constexpr char Gemm25D_str[] = "25D";
+    constexpr char GemmStrassen_str[] = "Strassen";
     const Method Error  = baseMethodError;
     const Method Auto   = baseMethodAuto;
     const Method GemmA  = 1;  ///< Select gemmA algorithm
     const Method GemmC  = 2;  ///< Select gemmC algorithm
+    const Method Gemm25D = 3; ///< Select gemm25D algorithm
+    const Method Strassen = 4; ///< Select gemmStrassen algorithm
 
+    /// Uses CostModel to pick gemmA or gemmC; gemmA supports one GPU only.
+    /// gemm25D needs Option::Layers, and Strassen loses accuracy,
+    /// so they are never picked automatically.
     template <typename TA, typename TB>
     inline Method select_algo(TA& A, TB& B, Options& opts) {
         // TODO replace the default value by a unique value located elsewhere
         Target target = get_option( opts, Option::Target, Target::HostTask );
         int n_devices = A.num_devices();
 
-        Method method = (B.nt() < 2 ? GemmA : GemmC);
+        double m = A.m(), n = B.n(), k = A.n();
+        double mt = A.mt(), nt = B.nt(), kt = A.nt();
+        double flops = 2 * m * n * k;
 
-        if (method == GemmA && target == Target::Devices && n_devices > 1)
-          method = GemmC;
+        auto g = CostModel::grid( A, opts );
+        double cost_A = CostModel::stationary_A( g, flops, m, n, k, mt, nt, kt );
+        double cost_C = CostModel::stationary_C( g, flops, m, n, k, mt, nt, kt );
+        if (target == Target::Devices && n_devices > 1)
+            cost_A = CostModel::infinity;
 
-        return method;
+        int i = CostModel::choose( A, opts, "gemm", { GemmC_str, GemmA_str },
+                                   { cost_C, cost_A } );
+        return i == 0 ? GemmC : GemmA;
     }
 
     inline Method str2methodGemm(const char* method)
@@ -109,6 +327,10 @@ namespace MethodGemm {
             return GemmA;
         else if (method_ == "c" || method_ == "gemmc")
             return GemmC;
+        else if (method_ == "25d" || method_ == "gemm25d")
+            return Gemm25D;
+        else if (method_ == "strassen" || method_ == "gemmstrassen")
+            return Strassen;
         else
             throw slate::Exception("unknown gemm method");
     }
@@ -119,6 +341,8 @@ namespace MethodGemm {
             case Auto:  return baseMethodAuto_str;
             case GemmA: return GemmA_str;
             case GemmC: return GemmC_str;
+            case Gemm25D: return Gemm25D_str;
+            case Strassen: return GemmStrassen_str;
             default:    return baseMethodError_str;
         }
     }
@@ -136,18 +360,31 @@ namespace MethodHemm {
     const Method HemmA  = 1;  ///< Select hemmA algorithm
     const Method HemmC  = 2;  ///< Select hemmC algorithm
 
+    /// Uses CostModel, as for gemm with k = m;
+    /// hemmA on devices supports only one GPU per rank.
     template <typename TA, typename TB>
     inline Method select_algo(TA& A, TB& B, Options const& opts) {
         // TODO replace the default value by a unique value located elsewhere
         Target target = get_option( opts, Option::Target, Target::HostTask );
+        int n_devices = A.num_devices();
 
-        Method method = (B.nt() < 2 ? HemmA : HemmC);
-
-        // XXX For now, when target == device, we fallback to HemmC on device
-        if (target == Target::Devices && method == HemmA)
-            method = HemmC;
-
-        return method;
+        // For side = right, consider the transposed problem.
+        bool left = A.m() == B.m();
+        double m  = left ? B.m()  : B.n();
+        double n  = left ? B.n()  : B.m();
+        double mt = left ? B.mt() : B.nt();
+        double nt = left ? B.nt() : B.mt();
+        double flops = 2 * m * m * n;
+
+        auto g = CostModel::grid( A, opts );
+        double cost_A = CostModel::stationary_A( g, flops, m, n, m, mt, nt, mt );
+        double cost_C = CostModel::stationary_C( g, flops, m, n, m, mt, nt, mt );
+        if (target == Target::Devices && n_devices > 1)
+            cost_A = CostModel::infinity;
+
+        int i = CostModel::choose( A, opts, "hemm", { HemmC_str, HemmA_str },
+                                   { cost_C, cost_A } );
+        return i == 0 ? HemmC : HemmA;
     }
 
     inline Method str2methodHemm(const char* method)
@@ -190,14 +427,33 @@ namespace MethodCholQR {
     static const Method GemmA = 2;  ///< Select gemmA algorithm
     static const Method GemmC = 3;  ///< Select gemmC algorithm
 
+    /// Uses CostModel for R = A^H A, with A m-by-n: herkC and gemmC keep
+    /// R stationary, herkC doing half the flops; gemmA keeps A^H
+    /// stationary and supports one GPU only.
     template <typename TA, typename TB>
     inline Method select_algo(TA& A, TB& B, Options const& opts) {
 
         Target target = get_option( opts, Option::Target, Target::HostTask );
+        int n_devices = A.num_devices();
 
-        Method method = (target == Target::Devices ? HerkC : GemmA);
-
-        return method;
+        double m = A.m(), n = A.n();
+        double mt = A.mt(), nt = A.nt();
+        double flops = 2 * m * n * n;
+
+        auto g = CostModel::grid( A, opts );
+        double cost_herkC
+            = CostModel::stationary_C( g, flops / 2, n, n, m, nt, nt, mt );
+        double cost_gemmA
+            = CostModel::stationary_A( g, flops, n, n, m, nt, nt, mt );
+        double cost_gemmC
+            = CostModel::stationary_C( g, flops, n, n, m, nt, nt, mt );
+        if (target == Target::Devices && n_devices > 1)
+            cost_gemmA = CostModel::infinity;
+
+        int i = CostModel::choose(
+            A, opts, "cholqr", { HerkC_str, GemmA_str, GemmC_str },
+            { cost_herkC, cost_gemmA, cost_gemmC } );
+        return i == 0 ? HerkC : (i == 1 ? GemmA : GemmC);
     }
 
     inline Method str2methodCholQR(const char* method)
@@ -236,14 +492,89 @@ namespace MethodCholQR {
 namespace MethodGels {
     static constexpr char Cholqr_str[]  = "cholqr";
     static constexpr char Geqrf_str[]   = "qr";
+    static constexpr char TSQR_str[]    = "tsqr";
+    static constexpr char Sketch_str[]  = "sketch";
     static const Method Error   = baseMethodError; ///< Error flag
     static const Method Auto    = baseMethodAuto;  ///< Let the algorithm decide
     static const Method Cholqr  = 1;  ///< Select cholqr algorithm
     static const Method Geqrf   = 2;  ///< Select geqrf algorithm
-
+    static const Method TSQR    = 3;  ///< Select tall-skinny QR algorithm
+    static const Method Sketch  = 4;  ///< Select sketch-preconditioned LSQR
+
+    /// Minimum m / n for which Auto considers CholQR. CholQR squares the
+    /// condition number of A, so it is used only for tall-skinny A, where
+    /// Householder QR is latency bound.
+    static const int64_t cholqr_min_aspect = 16;
+
+    /// Minimum m / n for which Auto considers Sketch. Its sketch has 4n
+    /// rows, and its O(m n) flops per LSQR iteration pay off only for
+    /// very tall A.
+    static const int64_t sketch_min_aspect = 64;
+
+    /// Uses CostModel: QR does one panel reduction per column, each a
+    /// reduction over the p process rows; CholQR does about the same flops
+    /// with one reduction of the n-by-n R; TSQR, on p-by-1 grids, does
+    /// log p reductions of n-by-n R factors, with stable Householder QR;
+    /// Sketch does O(m n) flops per LSQR iteration, each with a few
+    /// reductions of n-vectors.
     template <typename TA, typename TB>
     inline Method select_algo(TA& A, TB& B, Options const& opts) {
-        return Geqrf;
+        // A can be conj-transposed (minimum norm problem); use the
+        // tall shape that is factored.
+        bool trans = A.op() != Op::NoTrans;
+        double m  = trans ? A.n()  : A.m();
+        double n  = trans ? A.m()  : A.n();
+        double mt = trans ? A.nt() : A.mt();
+        double nt = trans ? A.mt() : A.nt();
+        if (m < cholqr_min_aspect * n)
+            return Geqrf;
+
+        auto g = CostModel::grid( A, opts );
+        CostModel::Machine const& mc = CostModel::machine();
+        double log_p = std::max( CostModel::depth( g.p ), 1.0 );
+
+        // geqrf: flops over all ranks; per column, a panel reduction
+        // along process rows, then a broadcast of V along process cols.
+        double qr_flops = 2*m*n*n - 2*n*n*n/3;
+        double cost_qr = qr_flops / (std::min( g.p*g.q, mt*nt ) * g.flop_rate)
+                       + n * log_p * mc.latency
+                       + g.word * (m*n / g.p) / mc.bandwidth;
+
+        // cholqr: herk, reduce R, potrf on R, then trsm.
+        double cost_cholqr
+            = CostModel::stationary_C( g, m*n*n, n, n, m, nt, nt, mt )
+            + CostModel::stationary_C( g, m*n*n, m, n, n, mt, nt, nt );
+
+        // tsqr: local QR of each rank's rows, then a binary tree of
+        // n-by-n R factors; needs whole block rows on each rank (q = 1).
+        double cost_tsqr = CostModel::infinity;
+        if (! trans && g.q == 1) {
+            double tree_flops = 10*n*n*n/3;
+            cost_tsqr = (qr_flops / g.p + log_p * tree_flops) / g.flop_rate
+                      + log_p * (mc.latency + g.word * n*n / mc.bandwidth);
+        }
+
+        // sketch: zeta = 8 nonzeros per row of A, reduce the s-by-n sketch,
+        // s = 4n, QR of it on each rank, then about 40 LSQR iterations,
+        // each with A, A^H, and two n-by-n trsm.
+        double cost_sketch = CostModel::infinity;
+        if (! trans && m >= sketch_min_aspect * n) {
+            double s = 4*n;
+            double iters = 40;
+            double flops = 8*2*m*n / (g.p*g.q) + 2*s*n*n
+                         + iters * (4*m*n / (g.p*g.q) + 2*n*n);
+            cost_sketch = flops / g.flop_rate
+                        + (1 + 4*iters) * log_p * mc.latency
+                        + g.word * s*n / mc.bandwidth;
+        }
+
+        int i = CostModel::choose( A, opts, "gels",
+                                   { Geqrf_str, Cholqr_str, TSQR_str,
+                                     Sketch_str },
+                                   { cost_qr, cost_cholqr, cost_tsqr,
+                                     cost_sketch } );
+        const Method methods[] = { Geqrf, Cholqr, TSQR, Sketch };
+        return methods[ i ];
     }
 
     inline Method str2methodGels(const char* method)
@@ -258,6 +589,10 @@ namespace MethodGels {
             return Geqrf;
         else if (method_ == "cholqr")
             return Cholqr;
+        else if (method_ == "tsqr")
+            return TSQR;
+        else if (method_ == "sketch")
+            return Sketch;
         else
             throw slate::Exception("unknown gels method");
     }
@@ -268,6 +603,8 @@ namespace MethodGels {
             case Auto:   return baseMethodAuto_str;
             case Geqrf:  return Geqrf_str;
             case Cholqr: return Cholqr_str;
+            case TSQR:   return TSQR_str;
+            case Sketch: return Sketch_str;
             default:     return baseMethodError_str;
         }
     }
@@ -314,6 +651,110 @@ namespace MethodLU {
 
 } // namespace MethodLU
 
+//------------------------------------------------------------------------------
+/// Select the Cholesky factorization algorithm.
+namespace MethodCholesky {
+
+    static constexpr char RightLooking_str[] = "right";
+    static constexpr char LeftLooking_str[]  = "left";
+    static constexpr char Recursive_str[]    = "recursive";
+    static const Method Error        = baseMethodError; ///< Error flag
+    static const Method Auto         = baseMethodAuto;  ///< Let the algorithm decide
+    static const Method RightLooking = 1;  ///< Select right-looking potrf
+    static const Method LeftLooking  = 2;  ///< Select left-looking potrf
+    static const Method Recursive    = 3;  ///< Select recursive potrf
+
+    /// Auto keeps the right-looking algorithm, with lookahead, for all
+    /// targets. Left-looking and recursive touch the trailing submatrix
+    /// less, which can help memory-bound host runs, but must be selected
+    /// explicitly.
+    template <typename TA>
+    inline Method select_algo(TA& A, Options const& opts) {
+        return RightLooking;
+    }
+
+    inline Method str2methodCholesky( const char* method )
+    {
+        std::string method_ = method;
+        std::transform(
+            method_.begin(), method_.end(), method_.begin(), ::tolower );
+
+        if (method_ == "auto")
+            return Auto;
+        else if (method_ == "right" || method_ == "rightlooking")
+            return RightLooking;
+        else if (method_ == "left" || method_ == "leftlooking")
+            return LeftLooking;
+        else if (method_ == "recursive" || method_ == "rec")
+            return Recursive;
+        else
+            throw slate::Exception("unknown Cholesky method");
+    }
+
+    inline const char* methodCholesky2str( Method method )
+    {
+        switch (method) {
+            case Auto:         return baseMethodAuto_str;
+            case RightLooking: return RightLooking_str;
+            case LeftLooking:  return LeftLooking_str;
+            case Recursive:    return Recursive_str;
+            default:           return baseMethodError_str;
+        }
+    }
+
+} // namespace MethodCholesky
+
+//------------------------------------------------------------------------------
+/// Select the iteration of the matrix function drivers, inv_sqrt and
+/// matrix_sign.
+namespace MethodMatFunc {
+
+    static constexpr char NewtonSchulz_str[]  = "NewtonSchulz";
+    static constexpr char DenmanBeavers_str[] = "DenmanBeavers";
+    static constexpr char Newton_str[]        = "Newton";
+    static const Method Error         = baseMethodError; ///< Error flag
+    static const Method Auto          = baseMethodAuto;  ///< Let the algorithm decide
+    static const Method NewtonSchulz  = 1;  ///< Select Newton-Schulz, gemm only
+    static const Method DenmanBeavers = 2;  ///< Select product form Denman-Beavers (inv_sqrt)
+    static const Method Newton        = 3;  ///< Select scaled Newton (matrix_sign)
+
+    /// Newton-Schulz is all gemm, so Auto always selects it.
+    template <typename TA>
+    inline Method select_algo(TA& A, Options const& opts) {
+        return NewtonSchulz;
+    }
+
+    inline Method str2methodMatFunc( const char* method )
+    {
+        std::string method_ = method;
+        std::transform(
+            method_.begin(), method_.end(), method_.begin(), ::tolower );
+
+        if (method_ == "auto")
+            return Auto;
+        else if (method_ == "newtonschulz" || method_ == "ns")
+            return NewtonSchulz;
+        else if (method_ == "denmanbeavers" || method_ == "db")
+            return DenmanBeavers;
+        else if (method_ == "newton")
+            return Newton;
+        else
+            throw slate::Exception("unknown matrix function method");
+    }
+
+    inline const char* methodMatFunc2str( Method method )
+    {
+        switch (method) {
+            case Auto:          return baseMethodAuto_str;
+            case NewtonSchulz:  return NewtonSchulz_str;
+            case DenmanBeavers: return DenmanBeavers_str;
+            case Newton:        return Newton_str;
+            default:            return baseMethodError_str;
+        }
+    }
+
+} // namespace MethodMatFunc
+
 } // namespace slate
 
 #endif // SLATE_METHOD_HH
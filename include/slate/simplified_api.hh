@@ -372,6 +372,21 @@ blas::real_type<scalar_t> lu_rcondest_using_factor(
     return gecondest( in_norm, A, Anorm, opts );
 }
 
+//-----------------------------------------
+// lu_factor_rcondest()
+
+// getrf, then gecondest on the fresh factors
+template <typename scalar_t>
+blas::real_type<scalar_t> lu_factor_rcondest(
+    Norm in_norm,
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Options const& opts = Options())
+{
+    blas::real_type<scalar_t> Anorm = norm( in_norm, A, opts );
+    getrf( A, pivots, opts );
+    return gecondest( in_norm, A, Anorm, opts );
+}
+
 //-----------------------------------------
 // Cholesky
 
@@ -503,6 +518,28 @@ blas::real_type<scalar_t> chol_rcondest_using_factor(
     return pocondest( in_norm, A, Anorm, opts );
 }
 
+//-----------------------------------------
+// chol_factor_rcondest()
+
+// potrf, then pocondest while the factor is still on the devices
+template <typename scalar_t>
+blas::real_type<scalar_t> chol_factor_rcondest(
+    Norm in_norm,
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts = Options())
+{
+    blas::real_type<scalar_t> Anorm = norm( in_norm, A, opts );
+
+    Options opts_hold = opts;
+    opts_hold[ Option::HoldLocalWorkspace ] = true;
+    potrf( A, opts_hold );
+    auto rcond = pocondest( in_norm, A, Anorm, opts_hold );
+
+    if (! get_option<Option::HoldLocalWorkspace>( opts, false ))
+        A.releaseWorkspace();
+    return rcond;
+}
+
 //-----------------------------------------
 // Symmetric indefinite -- block Aasen's
 
@@ -648,6 +685,19 @@ void qr_multiply_by_q(
     unmqr(side, op, A, T, C, opts);
 }
 
+//-----------------------------------------
+// qr_generate_q()
+
+// ungqr
+template <typename scalar_t>
+void qr_generate_q(
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts = Options())
+{
+    ungqr(A, T, Q, opts);
+}
+
 //-----------------------------------------
 // LQ
 
@@ -677,6 +727,19 @@ void lq_multiply_by_q(
     unmlq(side, op, A, T, C, opts);
 }
 
+//-----------------------------------------
+// lq_generate_q()
+
+// unglq
+template <typename scalar_t>
+void lq_generate_q(
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts = Options())
+{
+    unglq(A, T, Q, opts);
+}
+
 //-----------------------------------------
 // triangular_rcondest()
 
@@ -16,10 +16,19 @@
 #include "slate/HermitianBandMatrix.hh"
 
 #include "slate/method.hh"
+#include "slate/Workspace.hh"
+#include "slate/TimerContext.hh"
+#include "slate/CommStats.hh"
+#include "slate/DeviceTopology.hh"
+#include "slate/FlopStats.hh"
+#include "slate/NormRequest.hh"
+#include "slate/MixedFactorization.hh"
 
 #include "slate/func.hh"
 #include "slate/types.hh"
 #include "slate/print.hh"
+#include "slate/file.hh"
+#include "slate/tuning.hh"
 
 //------------------------------------------------------------------------------
 /// @namespace slate
@@ -34,11 +43,6 @@ namespace slate {
 int version();
 const char* id();
 
-/// Map of timers, in seconds, for top-level routines. For example:
-/// `timers[ "gels" ]` is time for gels,
-/// `timers[ "gels::geqrf" ]` is time for geqrf inside gels.
-extern std::map< std::string, double > timers;
-
 //------------------------------------------------------------------------------
 // Level 2 Auxiliary
 
@@ -211,6 +215,24 @@ void gemmC(
     scalar_t beta,  Matrix<scalar_t>& C,
     Options const& opts = Options());
 
+//-----------------------------------------
+// gemm25D()
+template <typename scalar_t>
+void gemm25D(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// gemmStrassen()
+template <typename scalar_t>
+void gemmStrassen(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // hbmm()
 template <typename scalar_t>
@@ -477,6 +499,37 @@ norm(
     return norm< TrapezoidMatrix<scalar_t> >( trnorm, A, opts );
 }
 
+//-----------------------------------------
+// norms()
+// several norms with one reduction
+template <typename matrix_type>
+std::vector< blas::real_type<typename matrix_type::value_type> >
+norms(
+    std::vector<Norm> const& norms,
+    matrix_type& A,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// norms for triangular case
+template <typename scalar_t>
+std::vector< blas::real_type<scalar_t> >
+norms(
+    std::vector<Norm> const& trnorms,
+    TriangularMatrix<scalar_t>& A,
+    Options const& opts = Options())
+{
+    return norms< TrapezoidMatrix<scalar_t> >( trnorms, A, opts );
+}
+
+// split-phase norms: starts the reduction, values set on wait()
+template <typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+norms_start(
+    std::vector<Norm> const& norms,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // colNorms()
 // all cols max norm
@@ -487,6 +540,35 @@ void colNorms(
     blas::real_type<typename matrix_type::value_type>* values,
     Options const& opts = Options());
 
+// all cols max norm of A and B, with one reduction
+template <typename matrix_type>
+void colNorms(
+    Norm norm,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values_A,
+    matrix_type& B,
+    blas::real_type<typename matrix_type::value_type>* values_B,
+    Options const& opts = Options());
+
+// split-phase colNorms: starts the reduction, values set on wait()
+template <typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+colNorms_start(
+    Norm norm,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values,
+    Options const& opts = Options());
+
+template <typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+colNorms_start(
+    Norm norm,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values_A,
+    matrix_type& B,
+    blas::real_type<typename matrix_type::value_type>* values_B,
+    Options const& opts = Options());
+
 //------------------------------------------------------------------------------
 // Linear systems
 
@@ -560,6 +642,23 @@ int64_t gesvMixed(
     return gesv_mixed( A, pivots, B, X, iter, opts );
 }
 
+//-----------------------------------------
+// gesv_mixed_factor(), gesv_mixed_solve()
+template <typename scalar_hi, typename scalar_lo>
+int64_t gesv_mixed_factor(
+    Matrix<scalar_hi>& A,
+    MixedFactorization<scalar_hi, scalar_lo>& F,
+    Options const& opts = Options());
+
+template <typename scalar_hi, typename scalar_lo>
+int64_t gesv_mixed_solve(
+    Matrix<scalar_hi>& A,
+    MixedFactorization<scalar_hi, scalar_lo>& F,
+    Matrix<scalar_hi>& B,
+    Matrix<scalar_hi>& X,
+    int& iter,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // gesv_mixed_gmres()
 template <typename scalar_t>
@@ -578,6 +677,27 @@ int64_t gesv_mixed_gmres(
     int& iter,
     Options const& opts = Options());
 
+template <typename scalar_t>
+WorkspaceSize gesv_mixed_gmres_workspace_size(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts = Options());
+
+template <typename scalar_hi, typename scalar_lo>
+WorkspaceSize gesv_mixed_gmres_workspace_size(
+    Matrix<scalar_hi>& A,
+    Matrix<scalar_hi>& B,
+    Options const& opts = Options());
+
+template <typename scalar_hi, typename scalar_lo>
+int64_t gesv_mixed_gmres_solve(
+    Matrix<scalar_hi>& A,
+    MixedFactorization<scalar_hi, scalar_lo>& F,
+    Matrix<scalar_hi>& B,
+    Matrix<scalar_hi>& X,
+    int& iter,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // gesv_rbt
 template<typename scalar_t>
@@ -602,6 +722,28 @@ int64_t getrf(
     Matrix<scalar_t>& A, Pivots& pivots,
     Options const& opts = Options());
 
+// also computes a norm of the original A, e.g., for gecondest
+template <typename scalar_t>
+int64_t getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Norm in_norm, blas::real_type<scalar_t>* Anorm,
+    Options const& opts = Options());
+
+// workspace query, see Workspace::reserve
+template <typename scalar_t>
+WorkspaceSize getrf_workspace_size(
+    Matrix<scalar_t>& A,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// getrf_batch()
+template <typename scalar_t>
+void getrf_batch(
+    std::vector< Matrix<scalar_t> >& A_array,
+    std::vector<Pivots>& pivots_array,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // getrf_nopiv()
 template <typename scalar_t>
@@ -766,6 +908,13 @@ int64_t potrf(
     HermitianMatrix<scalar_t>& A,
     Options const& opts = Options());
 
+// also computes a norm of the original A, e.g., for pocondest
+template <typename scalar_t>
+int64_t potrf(
+    HermitianMatrix<scalar_t>& A,
+    Norm in_norm, blas::real_type<scalar_t>* Anorm,
+    Options const& opts = Options());
+
 // forward real-symmetric matrices to potrf;
 // disabled for complex
 template <typename scalar_t>
@@ -778,6 +927,47 @@ int64_t potrf(
     return potrf( AH, opts );
 }
 
+//-----------------------------------------
+// potrf_batch()
+template <typename scalar_t>
+void potrf_batch(
+    std::vector< HermitianMatrix<scalar_t> >& A_array,
+    std::vector<int64_t>& info,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// select_tile_precision()
+template <typename scalar_t>
+int64_t select_tile_precision(
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// potrf_mixed()
+template <typename scalar_t>
+int64_t potrf_mixed(
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts = Options());
+
+template <typename scalar_hi, typename scalar_lo>
+int64_t potrf_mixed(
+    HermitianMatrix<scalar_hi>& A,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// potrf_update(), potrf_downdate()
+template <typename scalar_t>
+int64_t potrf_update(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+int64_t potrf_downdate(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // pbtrs()
 template <typename scalar_t>
@@ -814,6 +1004,14 @@ void potri(
     HermitianMatrix<scalar_t>& A,
     Options const& opts = Options());
 
+//-----------------------------------------
+// potri_diag()
+template <typename scalar_t>
+void potri_diag(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& D,
+    Options const& opts = Options());
+
 // todo:
 // forward real-symmetric matrices to potrs;
 // disabled for complex
@@ -926,6 +1124,20 @@ void gels_cholqr(
     Matrix<scalar_t>& BX,
     Options const& opts = Options());
 
+// Using tall-skinny QR, for 1D distributions
+template <typename scalar_t>
+void gels_tsqr(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    Options const& opts = Options());
+
+// Using a randomized sketch to precondition LSQR, for very tall A
+template <typename scalar_t>
+void gels_sketch(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    Options const& opts = Options());
+
 // Backward compatibility
 template <typename scalar_t>
 [[deprecated( "Use gels( A, BX[, opts] ) instead. Will be removed 2024-02." )]]
@@ -954,6 +1166,28 @@ void geqrf(
     Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
     Options const& opts = Options());
 
+//-----------------------------------------
+// geqrf_append(), geqrf_delete()
+template <typename scalar_t>
+int64_t geqrf_append(
+    Matrix<scalar_t>& R,
+    Matrix<scalar_t>& W,
+    Options const& opts = Options());
+
+template <typename scalar_t>
+int64_t geqrf_delete(
+    Matrix<scalar_t>& R,
+    Matrix<scalar_t>& W,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// geqrf_batch()
+template <typename scalar_t>
+void geqrf_batch(
+    std::vector< Matrix<scalar_t> >& A_array,
+    std::vector< TriangularFactors<scalar_t> >& T_array,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // unmqr()
 template <typename scalar_t>
@@ -963,6 +1197,21 @@ void unmqr(
     Matrix<scalar_t>& C,
     Options const& opts = Options());
 
+template <typename scalar_t>
+void unmqr(
+    Side side, Op op,
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    std::vector< Matrix<scalar_t> >& C_array,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// ungqr()
+template <typename scalar_t>
+void ungqr(
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // cholQR
 template <typename scalar_t>
@@ -990,6 +1239,21 @@ void unmlq(
     Matrix<scalar_t>& C,
     Options const& opts = Options());
 
+template <typename scalar_t>
+void unmlq(
+    Side side, Op op,
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    std::vector< Matrix<scalar_t> >& C_array,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// unglq()
+template <typename scalar_t>
+void unglq(
+    Matrix<scalar_t>& A, TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts = Options());
+
 //------------------------------------------------------------------------------
 // SVD
 
@@ -1023,6 +1287,50 @@ void svd_vals(
     svd( A, Sigma, opts );
 }
 
+/// Top k singular triplets, via a randomized range finder.
+template <typename scalar_t>
+void svd_rand(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// polar(): polar decomposition A = U H, via QDWH.
+template <typename scalar_t>
+void polar(
+    Matrix<scalar_t>& A,
+    HermitianMatrix<scalar_t>& H,
+    Options const& opts = Options());
+
+/// Without H, compute only the orthonormal polar factor U, in A.
+template <typename scalar_t>
+void polar(
+    Matrix<scalar_t>& A,
+    Options const& opts = Options())
+{
+    HermitianMatrix<scalar_t> H;
+    polar( A, H, opts );
+}
+
+//-----------------------------------------
+// inv_sqrt(): inverse square root X = A^{-1/2}, via Newton-Schulz or
+// Denman-Beavers.
+template <typename scalar_t>
+int64_t inv_sqrt(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& X,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// matrix_sign(): matrix sign function A = sign( A ), via Newton-Schulz or
+// Newton.
+template <typename scalar_t>
+int64_t matrix_sign(
+    Matrix<scalar_t>& A,
+    Options const& opts = Options());
+
 template <typename scalar_t>
 [[deprecated( "Use svd instead. To be removed 2024-07." )]]
 void gesvd(
@@ -1087,6 +1395,15 @@ void bdsqr(
     Matrix<scalar_t>& VT,
     Options const& opts = Options());
 
+// bdsdc()
+template <typename real_t>
+int64_t bdsdc(
+    std::vector<real_t>& D,
+    std::vector<real_t> const& E,
+    Matrix<real_t>& U,
+    Matrix<real_t>& VT,
+    Options const& opts = Options());
+
 //------------------------------------------------------------------------------
 // Symmetric/Hermitian eigenvalues
 
@@ -1108,6 +1425,59 @@ void heev(
     heev( A, Lambda, Z, opts );
 }
 
+// workspace query, see Workspace::reserve
+template <typename scalar_t>
+WorkspaceSize heev_workspace_size(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// heev_qdwh(): all eigenvalues by QDWH-based spectral divide and conquer.
+template <typename scalar_t>
+void heev_qdwh(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
+/// Without Z, compute only eigenvalues.
+template <typename scalar_t>
+void heev_qdwh(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Options const& opts = Options())
+{
+    Matrix<scalar_t> Z;
+    heev_qdwh( A, Lambda, Z, opts );
+}
+
+//-----------------------------------------
+// heevx(): subset of eigenvalues by index or value range.
+template <typename scalar_t>
+void heevx(
+    lapack::Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
+/// Without Z, compute only eigenvalues.
+template <typename scalar_t>
+void heevx(
+    lapack::Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Options const& opts = Options())
+{
+    Matrix<scalar_t> Z;
+    heevx( range, vl, vu, il, iu, A, Lambda, Z, opts );
+}
+
 //-----------------------------------------
 // forward real-symmetric matrices to heev;
 // disabled for complex
@@ -1161,6 +1531,29 @@ void hegv(
     hegv( itype, A, B, Lambda, Z, opts );
 }
 
+// With B already factored by potrf or hegv.
+template <typename scalar_t>
+void hegv_factored(
+    int64_t itype,
+    HermitianMatrix<scalar_t>& A,
+    HermitianMatrix<scalar_t>& B,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
+// Without Z, compute only eigenvalues.
+template <typename scalar_t>
+void hegv_factored(
+    int64_t itype,
+    HermitianMatrix<scalar_t>& A,
+    HermitianMatrix<scalar_t>& B,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Options const& opts = Options())
+{
+    Matrix<scalar_t> Z;
+    hegv_factored( itype, A, B, Lambda, Z, opts );
+}
+
 //-----------------------------------------
 // forward real-symmetric matrices to hegv;
 // disabled for complex
@@ -1231,6 +1624,13 @@ void he2hb(
     TriangularFactors<scalar_t>& T,
     Options const& opts = Options());
 
+template <typename scalar_t>
+void he2hb(
+    HermitianMatrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    std::function<void (int64_t)> const& band_ready,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // unmtr_he2hb()
 template <typename scalar_t>
@@ -1249,6 +1649,13 @@ void hb2st(
     Matrix<scalar_t>& V,
     Options const& opts = Options());
 
+template <typename scalar_t>
+void hb2st(
+    HermitianBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    std::function<void (int64_t)> const& band_wait,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // unmtr_hb2st()
 template <typename scalar_t>
@@ -1341,6 +1748,27 @@ void sterf(
     std::vector< scalar_t >& E,
     Options const& opts = Options());
 
+//-----------------------------------------
+// stebz()
+template <typename real_t>
+void stebz(
+    lapack::Range range, real_t vl, real_t vu, int64_t il, int64_t iu,
+    std::vector<real_t> const& D,
+    std::vector<real_t> const& E,
+    std::vector<real_t>& Lambda,
+    MPI_Comm mpi_comm,
+    Options const& opts = Options());
+
+//-----------------------------------------
+// stein()
+template <typename scalar_t>
+void stein(
+    std::vector< blas::real_type<scalar_t> > const& D,
+    std::vector< blas::real_type<scalar_t> > const& E,
+    std::vector< blas::real_type<scalar_t> > const& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts = Options());
+
 //-----------------------------------------
 // steqr2()
 template <typename scalar_t>
@@ -1411,4 +1839,20 @@ void trcondest(
 // Simplified C++ API
 #include "simplified_api.hh"
 
+//-----------------------------------------
+// Non-blocking C++ API
+#include "async.hh"
+
+//-----------------------------------------
+// Factorization objects for repeated solves
+#include "Factorization.hh"
+
+//-----------------------------------------
+// Matrix expressions, e.g., slate::eval( C, alpha*A + beta*B )
+#include "expr.hh"
+
+//-----------------------------------------
+// Tile-low-rank Hermitian matrices, slate::tlr
+#include "TileLowRankMatrix.hh"
+
 #endif // SLATE_HH
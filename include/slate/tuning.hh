@@ -0,0 +1,52 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TUNING_HH
+#define SLATE_TUNING_HH
+
+#include "slate/enums.hh"
+#include "slate/types.hh"
+
+#include <string>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Parameters tuned for a routine, target, and range of problem sizes,
+/// as read from a tuning file written by test/autotune.py.
+/// Values < 0 were not tuned, so the routine's own default applies.
+///
+/// The tuning file has one line per routine, target, and size range:
+///
+///     # routine  target    n_max  nb   ib  lookahead  panel_threads
+///     getrf      HostTask   4000  256  16  1          4
+///     getrf      HostTask  16000  384  32  2          8
+///     potrf      Devices       0  960  -1  2         -1
+///
+/// A line applies to sizes n <= n_max that are above the previous line's
+/// n_max for the same routine and target; n_max = 0 means any size.
+/// Sizes above the largest n_max use that largest range.
+/// Blank lines and text after # are ignored.
+///
+/// @see tuned_params, tuned_options, read_tuning_file
+///
+struct TunedParams {
+    int64_t nb            = -1;
+    int64_t ib            = -1;
+    int64_t lookahead     = -1;
+    int64_t panel_threads = -1;
+};
+
+bool read_tuning_file( const char* filename );
+
+TunedParams tuned_params( std::string const& routine, Target target,
+                          int64_t n );
+
+Options tuned_options( std::string const& routine, int64_t n,
+                       Options const& opts );
+
+} // namespace slate
+
+#endif // SLATE_TUNING_HH
@@ -20,6 +20,9 @@
 
 namespace slate {
 
+class Workspace;
+class TimerContext;
+
 //------------------------------------------------------------------------------
 /// Values for options to pass to SLATE routines.
 /// Value can be:
@@ -27,6 +30,8 @@ namespace slate {
 /// - int64_t
 /// - double
 /// - Target enum
+/// - pointer to Workspace arena
+/// - pointer to TimerContext
 /// @see Option
 ///
 class OptionValue {
@@ -49,9 +54,22 @@ public:
     OptionValue(MethodEig m) : i_(int(m))
     {}
 
+    OptionValue(MathMode m) : i_(int(m))
+    {}
+
+    OptionValue(TournamentTree t) : i_(int(t))
+    {}
+
+    OptionValue(Workspace* w) : p_(w)
+    {}
+
+    OptionValue(TimerContext* t) : p_(t)
+    {}
+
     union {
         int64_t i_;
         double d_;
+        void* p_;
     };
 };
 
@@ -217,6 +235,38 @@ inline double get_option<double>( Options opts, Option option, double defval )
     return retval;
 }
 
+//----------------------------
+/// Specialization for pointer to workspace arena.
+template <>
+inline Workspace* get_option<Workspace*>(
+    Options opts, Option option, Workspace* defval )
+{
+    Workspace* retval;
+    auto search = opts.find( option );
+    if (search != opts.end())
+        retval = (Workspace*) search->second.p_;
+    else
+        retval = defval;
+
+    return retval;
+}
+
+//----------------------------
+/// Specialization for pointer to timer context.
+template <>
+inline TimerContext* get_option<TimerContext*>(
+    Options opts, Option option, TimerContext* defval )
+{
+    TimerContext* retval;
+    auto search = opts.find( option );
+    if (search != opts.end())
+        retval = (TimerContext*) search->second.p_;
+    else
+        retval = defval;
+
+    return retval;
+}
+
 //------------------------------------------------------------------------------
 // Dispatch type mapping Option enum to corresponding types
 template <slate::Option option> struct OptValueType {};
@@ -232,6 +282,24 @@ template<> struct OptValueType<Option::Depth>              { using T = int64_t;
 template<> struct OptValueType<Option::MaxIterations>      { using T = int64_t; };
 template<> struct OptValueType<Option::UseFallbackSolver>  { using T = bool; };
 template<> struct OptValueType<Option::PivotThreshold>     { using T = double; };
+template<> struct OptValueType<Option::Workspace>          { using T = Workspace*; };
+template<> struct OptValueType<Option::AggregateBcast>     { using T = bool; };
+template<> struct OptValueType<Option::HierarchicalBcast>  { using T = bool; };
+template<> struct OptValueType<Option::MathMode>           { using T = MathMode; };
+template<> struct OptValueType<Option::InvertDiagonal>     { using T = bool; };
+template<> struct OptValueType<Option::TournamentTree>     { using T = TournamentTree; };
+template<> struct OptValueType<Option::MaxLookahead>       { using T = int64_t; };
+template<> struct OptValueType<Option::Pipeline>           { using T = bool; };
+template<> struct OptValueType<Option::Layers>             { using T = int64_t; };
+template<> struct OptValueType<Option::MaxWorkspace>       { using T = int64_t; };
+template<> struct OptValueType<Option::ColumnGroups>       { using T = int64_t; };
+template<> struct OptValueType<Option::CholQRPasses>       { using T = int64_t; };
+template<> struct OptValueType<Option::NormEstVectors>     { using T = int64_t; };
+template<> struct OptValueType<Option::MixedLowMemory>     { using T = bool; };
+template<> struct OptValueType<Option::Rank>               { using T = int64_t; };
+template<> struct OptValueType<Option::Oversampling>       { using T = int64_t; };
+template<> struct OptValueType<Option::PowerIterations>    { using T = int64_t; };
+template<> struct OptValueType<Option::Timers>             { using T = TimerContext*; };
 template<> struct OptValueType<Option::PrintVerbose>       { using T = int; };
 template<> struct OptValueType<Option::PrintEdgeItems>     { using T = int; };
 template<> struct OptValueType<Option::PrintWidth>         { using T = int; };
@@ -243,6 +311,8 @@ template<> struct OptValueType<Option::MethodGemm>         { using T = Method; }
 template<> struct OptValueType<Option::MethodHemm>         { using T = Method; };
 template<> struct OptValueType<Option::MethodLU>           { using T = Method; };
 template<> struct OptValueType<Option::MethodTrsm>         { using T = Method; };
+template<> struct OptValueType<Option::MethodCholesky>     { using T = Method; };
+template<> struct OptValueType<Option::MethodMatFunc>      { using T = Method; };
 
 template <slate::Option option>
 auto get_option( Options opts, typename OptValueType<option>::T defval )
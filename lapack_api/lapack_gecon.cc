@@ -97,9 +97,11 @@ void slate_gecon(const char* normstr, const int n, scalar_t* a, const int lda, b
     // sizes
     lapack::Norm norm = lapack::char2norm(normstr[0]);
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // create SLATE matrix from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(n, n, a, lda, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(n, n, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
 
     // solve
     *rcond = slate::gecondest( norm, A, Anorm, {
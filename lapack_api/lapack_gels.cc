@@ -73,9 +73,14 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     int64_t q = 1;
     int64_t lookahead = 1;
     static slate::Target target = slate_lapack_set_target();
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
     static int64_t panel_threads = slate_lapack_set_panelthreads();
     static int64_t inner_blocking = slate_lapack_set_ib();
+    slate::TunedParams tuned = slate_lapack_tuned("geqrf", target, std::min(m, n));
+    int64_t nb = tuned.nb > 0 ? tuned.nb : max_nb;
+    if (tuned.lookahead >= 0)
+        lookahead = tuned.lookahead;
 
     // sizes
     blas::Op trans = blas::char2op(transstr[0]);
@@ -88,8 +93,10 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     int64_t Bn = nrhs;
 
     // create SLATE matrices from the LAPACK layouts
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
 
     // Apply transpose
     auto opA = A;
@@ -101,8 +108,8 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     slate::gels(opA, B, {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
-        {slate::Option::MaxPanelThreads, panel_threads},
-        {slate::Option::InnerBlocking, inner_blocking}
+        {slate::Option::MaxPanelThreads, tuned.panel_threads > 0 ? tuned.panel_threads : panel_threads},
+        {slate::Option::InnerBlocking, tuned.ib > 0 ? tuned.ib : inner_blocking}
     });
 
     if (verbose) std::cout << "slate_lapack_api: " << slate_lapack_scalar_t_to_char(a) << "gels(" << transstr[0] << "," <<  m << "," <<  n << "," << nrhs << "," <<  (void*)a << "," <<  lda << "," << (void*)b << "," << ldb << "," << (void*)work << "," << lwork << "," << *info << ") " << (omp_get_wtime()-timestart) << " sec " << "nb:" << nb << " max_threads:" << omp_get_max_threads() << "\n";
@@ -59,6 +59,14 @@ void slate_gemm(const char* transastr, const char* transbstr, int m, int n, int
     if (! initialized)
         MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &provided);
 
+    // small problems go straight to BLAS
+    static int64_t crossover = slate_lapack_set_crossover();
+    if (m < crossover && n < crossover && k < crossover) {
+        blas::gemm(blas::Layout::ColMajor, blas::char2op(transastr[0]), blas::char2op(transbstr[0]), m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+        if (verbose) logprintf("%cgemm(%c,%c,%d,%d,%d) below crossover, BLAS %f sec\n", slate_lapack_scalar_t_to_char(a), transastr[0], transbstr[0], m, n, k, omp_get_wtime()-timestart);
+        return;
+    }
+
     int64_t p = 1;
     int64_t q = 1;
     int64_t lookahead = 1;
@@ -73,12 +81,17 @@ void slate_gemm(const char* transastr, const char* transbstr, int m, int n, int
     int64_t Bn = (transB == blas::Op::NoTrans ? n : k);
     int64_t Cm = m;
     int64_t Cn = n;
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    int64_t nb = slate_lapack_adapt_nb(max_nb, std::max({m, n, k}), target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // create SLATE matrices from the Lapack layouts
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
-    auto C = slate::Matrix<scalar_t>::fromLAPACK(Cm, Cn, c, ldc, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> C_pooled(Cm, Cn, c, ldc, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto C = C_pooled.matrix();
 
     if (transA == blas::Op::Trans)
         A = transpose(A);
@@ -61,6 +61,16 @@ void slate_gesv(const int n, const int nrhs, scalar_t* a, const int lda, int* ip
     if (! initialized)
         MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
 
+    // small problems go straight to LAPACK
+    static int64_t crossover = slate_lapack_set_crossover();
+    if (n < crossover) {
+        std::vector<int64_t> ipiv64(std::max(n, 0));
+        *info = lapack::gesv(n, nrhs, a, lda, ipiv64.data(), b, ldb);
+        std::copy(ipiv64.begin(), ipiv64.end(), ipiv);
+        if (verbose) logprintf("%cgesv(%d,%d) below crossover, LAPACK %f sec\n", slate_lapack_scalar_t_to_char(a), n, nrhs, omp_get_wtime()-timestart);
+        return;
+    }
+
     int64_t lookahead = 1;
     int64_t p = 1;
     int64_t q = 1;
@@ -70,19 +80,27 @@ void slate_gesv(const int n, const int nrhs, scalar_t* a, const int lda, int* ip
     // sizes
     int64_t Am = n, An = n;
     int64_t Bm = n, Bn = nrhs;
-    static int64_t nb = slate_lapack_set_nb(target);
-    static int64_t ib = std::min({slate_lapack_set_ib(), nb});
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    slate::TunedParams tuned = slate_lapack_tuned("getrf", target, n);
+    int64_t nb = tuned.nb > 0 ? tuned.nb : slate_lapack_adapt_nb(max_nb, n, target);
+    static int pool_size = slate_lapack_set_pool_size();
+    static int64_t max_ib = slate_lapack_set_ib();
+    int64_t ib = std::min(tuned.ib > 0 ? tuned.ib : max_ib, nb);
+    if (tuned.lookahead >= 0)
+        lookahead = tuned.lookahead;
     slate::Pivots pivots;
 
     // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
 
     // computes the solution to the system of linear equations with a square coefficient matrix A and multiple right-hand sides.
     slate::gesv(A, pivots, B, {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
-        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::MaxPanelThreads, tuned.panel_threads > 0 ? tuned.panel_threads : panel_threads},
         {slate::Option::InnerBlocking, ib}
     });
 
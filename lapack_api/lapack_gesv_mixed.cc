@@ -54,13 +54,17 @@ void slate_gesv(const int n, const int nrhs, scalar_t* a, const int lda, int* ip
     static slate::Target target = slate_lapack_set_target();
     static int64_t panel_threads = slate_lapack_set_panelthreads();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
     static int64_t ib = std::min({slate_lapack_set_ib(), nb});
     slate::Pivots pivots;
 
     // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(n, n, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(n, nrhs, b, ldb, nb, p, q, MPI_COMM_WORLD);
-    auto X = slate::Matrix<scalar_t>::fromLAPACK(n, nrhs, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(n, n, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> B_pooled(n, nrhs, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> X_pooled(n, nrhs, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto X = X_pooled.matrix();
 
     // computes the solution to the system of linear equations with a square coefficient matrix A and multiple right-hand sides.
     int iters;
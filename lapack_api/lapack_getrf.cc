@@ -73,6 +73,16 @@ void slate_getrf(const int m, const int n, scalar_t* a, const int lda, int* ipiv
     if (m == 0 || n == 0)
         return;
 
+    // small problems go straight to LAPACK
+    static int64_t crossover = slate_lapack_set_crossover();
+    if (m < crossover && n < crossover) {
+        std::vector<int64_t> ipiv64(std::min(m, n));
+        *info = lapack::getrf(m, n, a, lda, ipiv64.data());
+        std::copy(ipiv64.begin(), ipiv64.end(), ipiv);
+        if (verbose) logprintf("%cgetrf(%d,%d) below crossover, LAPACK %f sec\n", slate_lapack_scalar_t_to_char(a), m, n, omp_get_wtime()-timestart);
+        return;
+    }
+
     int64_t p = 1;
     int64_t q = 1;
     int64_t lookahead = 1;
@@ -81,18 +91,25 @@ void slate_getrf(const int m, const int n, scalar_t* a, const int lda, int* ipiv
 
     int64_t Am = m;
     int64_t An = n;
-    static int64_t nb = slate_lapack_set_nb(target);
-    static int64_t ib = std::min({slate_lapack_set_ib(), nb});
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    slate::TunedParams tuned = slate_lapack_tuned("getrf", target, std::min(m, n));
+    int64_t nb = tuned.nb > 0 ? tuned.nb : slate_lapack_adapt_nb(max_nb, std::max(m, n), target);
+    static int pool_size = slate_lapack_set_pool_size();
+    static int64_t max_ib = slate_lapack_set_ib();
+    int64_t ib = std::min(tuned.ib > 0 ? tuned.ib : max_ib, nb);
+    if (tuned.lookahead >= 0)
+        lookahead = tuned.lookahead;
     slate::Pivots pivots;
 
     // create SLATE matrices from the Lapack layouts
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
 
     // factorize using slate
     slate::getrf(A, pivots, {
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
-        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::MaxPanelThreads, tuned.panel_threads > 0 ? tuned.panel_threads : panel_threads},
         {slate::Option::InnerBlocking, ib}
     });
 
@@ -109,9 +109,11 @@ void slate_getri(const int n, scalar_t* a, const int lda, int* ipiv, scalar_t* w
 
     // sizes
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(n, n, a, lda, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(n, n, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
 
     // extract pivots from LAPACK ipiv to SLATES pivot structure
     slate::Pivots pivots; // std::vector< std::vector<Pivot> >
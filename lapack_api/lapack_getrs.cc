@@ -58,6 +58,15 @@ void slate_getrs(const char* transstr, const int n, const int nrhs, scalar_t* a,
     if (! initialized)
         MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
 
+    // small problems go straight to LAPACK
+    static int64_t crossover = slate_lapack_set_crossover();
+    if (n < crossover) {
+        std::vector<int64_t> ipiv64(ipiv, ipiv + std::max(n, 0));
+        *info = lapack::getrs(blas::char2op(transstr[0]), n, nrhs, a, lda, ipiv64.data(), b, ldb);
+        if (verbose) logprintf("%cgetrs(%c,%d,%d) below crossover, LAPACK %f sec\n", slate_lapack_scalar_t_to_char(a), transstr[0], n, nrhs, omp_get_wtime()-timestart);
+        return;
+    }
+
     int64_t lookahead = 1;
     int64_t p = 1;
     int64_t q = 1;
@@ -67,11 +76,15 @@ void slate_getrs(const char* transstr, const int n, const int nrhs, scalar_t* a,
     blas::Op trans = blas::char2op(transstr[0]);
     int64_t Am = n, An = n;
     int64_t Bm = n, Bn = nrhs;
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    int64_t nb = slate_lapack_adapt_nb(max_nb, n, target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
 
     // extract pivots from LAPACK ipiv to SLATES pivot structure
     slate::Pivots pivots; // std::vector< std::vector<Pivot> >
@@ -54,6 +54,7 @@ void slate_hemm(const char* sidestr, const char* uplostr, const int m, const int
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // sizes of data
     int64_t An = (side == blas::Side::Left ? m : n);
@@ -64,8 +65,10 @@ void slate_hemm(const char* sidestr, const char* uplostr, const int m, const int
 
     // create SLATE matrices from the Lapack layouts
     auto A = slate::HermitianMatrix<scalar_t>::fromLAPACK(uplo, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
-    auto C = slate::Matrix<scalar_t>::fromLAPACK(Cm, Cn, c, ldc, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> C_pooled(Cm, Cn, c, ldc, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto C = C_pooled.matrix();
 
     if (side == blas::Side::Left)
         assert(A.mt() == C.mt());
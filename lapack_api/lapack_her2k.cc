@@ -54,6 +54,7 @@ void slate_her2k(const char* uplostr, const char* transastr, const int n, const
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // setup so op(A) and op(B) are n-by-k
     int64_t Am = (trans == blas::Op::NoTrans ? n : k);
@@ -63,8 +64,10 @@ void slate_her2k(const char* uplostr, const char* transastr, const int n, const
     int64_t Cn = n;
 
     // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
     auto C = slate::HermitianMatrix<scalar_t>::fromLAPACK(uplo, Cn, c, ldc, nb, p, q, MPI_COMM_WORLD);
 
     if (trans == blas::Op::Trans) {
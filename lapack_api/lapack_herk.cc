@@ -54,6 +54,7 @@ void slate_herk(const char* uplostr, const char* transastr, const int n, const i
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // setup so op(A) is n-by-k
     int64_t Am = (transA == blas::Op::NoTrans ? n : k);
@@ -61,7 +62,8 @@ void slate_herk(const char* uplostr, const char* transastr, const int n, const i
     int64_t Cn = n;
 
     // create SLATE matrices from the LAPACK data
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
     auto C = slate::HermitianMatrix<scalar_t>::fromLAPACK(uplo, Cn, c, ldc, nb, p, q, MPI_COMM_WORLD);
 
     if (transA == blas::Op::Trans)
@@ -65,13 +65,15 @@ blas::real_type<scalar_t> slate_lange(const char* normstr, int m, int n, scalar_
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
 
     // sizes of matrices
     int64_t Am = m;
     int64_t An = n;
 
     // create SLATE matrix from the Lapack layouts
-    auto A = slate::Matrix<scalar_t>::fromLAPACK(Am, An, a, lda, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(Am, An, a, lda, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto A = A_pooled.matrix();
 
     blas::real_type<scalar_t> A_norm;
     A_norm = slate::norm(norm, A, {
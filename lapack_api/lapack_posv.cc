@@ -61,17 +61,31 @@ void slate_posv(const char* uplostr, const int n, const int nrhs, scalar_t* a, c
     if (! initialized)
         MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
 
+    // small problems go straight to LAPACK
+    static int64_t crossover = slate_lapack_set_crossover();
+    if (n < crossover) {
+        *info = lapack::posv(blas::char2uplo(uplostr[0]), n, nrhs, a, lda, b, ldb);
+        if (verbose) logprintf("%cposv(%c,%d,%d) below crossover, LAPACK %f sec\n", slate_lapack_scalar_t_to_char(a), uplostr[0], n, nrhs, omp_get_wtime()-timestart);
+        return;
+    }
+
     blas::Uplo uplo = blas::char2uplo(uplostr[0]);
     int64_t lookahead = 1;
     int64_t p = 1;
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    slate::TunedParams tuned = slate_lapack_tuned("potrf", target, n);
+    int64_t nb = tuned.nb > 0 ? tuned.nb : slate_lapack_adapt_nb(max_nb, n, target);
+    if (tuned.lookahead >= 0)
+        lookahead = tuned.lookahead;
+    static int pool_size = slate_lapack_set_pool_size();
     slate::Pivots pivots;
 
     // create SLATE matrices from the LAPACK data
     auto A = slate::HermitianMatrix<scalar_t>::fromLAPACK(uplo, n, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(n, nrhs, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(n, nrhs, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
 
     // computes the solution to the system of linear equations with a square coefficient matrix A and multiple right-hand sides.
     slate::posv(A, B, {
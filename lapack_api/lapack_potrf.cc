@@ -59,12 +59,24 @@ void slate_potrf(const char* uplostr, const int n, scalar_t* a, const int lda, i
     if (! initialized)
         MPI_Init_thread(nullptr, nullptr, MPI_THREAD_SERIALIZED, &provided);
 
+    // small problems go straight to LAPACK
+    static int64_t crossover = slate_lapack_set_crossover();
+    if (n < crossover) {
+        *info = lapack::potrf(blas::char2uplo(uplostr[0]), n, a, lda);
+        if (verbose) logprintf("%cpotrf(%c,%d) below crossover, LAPACK %f sec\n", slate_lapack_scalar_t_to_char(a), uplostr[0], n, omp_get_wtime()-timestart);
+        return;
+    }
+
     blas::Uplo uplo = blas::char2uplo(uplostr[0]);
     int64_t lookahead = 1;
     int64_t p = 1;
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
-    static int64_t nb = slate_lapack_set_nb(target);
+    static int64_t max_nb = slate_lapack_set_nb(target);
+    slate::TunedParams tuned = slate_lapack_tuned("potrf", target, n);
+    int64_t nb = tuned.nb > 0 ? tuned.nb : slate_lapack_adapt_nb(max_nb, n, target);
+    if (tuned.lookahead >= 0)
+        lookahead = tuned.lookahead;
 
     // sizes of data
     int64_t An = n;
@@ -10,6 +10,7 @@
 #include "blas/fortran.h"
 
 #include "slate/slate.hh"
+#include "slate/internal/MatrixPool.hh"
 
 #include <complex>
 
@@ -101,6 +102,65 @@ inline int64_t slate_lapack_set_nb(slate::Target target)
     return 256;
 }
 
+inline int slate_lapack_set_pool_size()
+{
+    // number of free matrices kept for reuse across calls (0: no reuse)
+    int pool_size = 8; // default
+    char* poolstr = std::getenv("SLATE_LAPACK_POOL");
+    if (poolstr)
+        pool_size = (int)strtol(poolstr, NULL, 0);
+    return pool_size;
+}
+
+inline int64_t slate_lapack_set_crossover()
+{
+    // problems with all dimensions below the crossover go straight to
+    // the vendor LAPACK or BLAS, avoiding SLATE's setup (0: always SLATE)
+    int64_t crossover = 128; // default
+    char* crossoverstr = std::getenv("SLATE_LAPACK_CROSSOVER");
+    if (crossoverstr)
+        crossover = (int64_t)strtol(crossoverstr, NULL, 0);
+    return crossover;
+}
+
+// Returns parameters tuned for routine at problem size n on target, from the
+// tuning file (see slate::tuned_params), with fields set by the SLATE_LAPACK_NB,
+// SLATE_LAPACK_IB, or SLATE_LAPACK_PANELTHREADS environment variables
+// cleared to -1, so explicit settings take precedence.
+// Fields < 0 use the usual defaults.
+inline slate::TunedParams slate_lapack_tuned(const char* routine, slate::Target target, int64_t n)
+{
+    slate::TunedParams tuned = slate::tuned_params(routine, target, n);
+    if (std::getenv("SLATE_LAPACK_NB"))
+        tuned.nb = -1;
+    if (std::getenv("SLATE_LAPACK_IB"))
+        tuned.ib = -1;
+    if (std::getenv("SLATE_LAPACK_PANELTHREADS"))
+        tuned.panel_threads = -1;
+    return tuned;
+}
+
+// Returns the tile size for a problem of dimension n: nb as set by
+// slate_lapack_set_nb if SLATE_LAPACK_NB is set, else nb reduced for small
+// n so the problem still has several block columns per device (with Devices)
+// or for lookahead (on the host). The default device distribution cycles
+// block columns over the devices, so this is what spreads a problem over
+// all of them.
+inline int64_t slate_lapack_adapt_nb(int64_t nb, int64_t n, slate::Target target)
+{
+    static bool nb_is_fixed = (std::getenv("SLATE_LAPACK_NB") != nullptr);
+    static int num_devices = blas::get_device_count();
+    if (nb_is_fixed)
+        return nb;
+
+    const int64_t min_nb = 64;
+    int64_t block_cols = 4;
+    if (target == slate::Target::Devices)
+        block_cols = std::max(block_cols, int64_t(2*num_devices));
+    int64_t adapted_nb = roundup(ceildiv(n, block_cols), min_nb);
+    return std::max(min_nb, std::min(nb, adapted_nb));
+}
+
 } // namespace lapack_api
 } // namespace slate
 
@@ -64,6 +64,7 @@ void slate_trsm(const char* sidestr, const char* uplostr, const char* transastr,
     int64_t q = 1;
     static slate::Target target = slate_lapack_set_target();
     static int64_t nb = slate_lapack_set_nb(target);
+    static int pool_size = slate_lapack_set_pool_size();
     blas::Side side = blas::char2side(sidestr[0]);
     blas::Uplo uplo = blas::char2uplo(uplostr[0]);
     blas::Op transA = blas::char2op(transastr[0]);
@@ -76,7 +77,8 @@ void slate_trsm(const char* sidestr, const char* uplostr, const char* transastr,
 
     // create SLATE matrices from the LAPACK data
     auto A = slate::TriangularMatrix<scalar_t>::fromLAPACK(uplo, diag, An, a, lda, nb, p, q, MPI_COMM_WORLD);
-    auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, b, ldb, nb, p, q, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(Bm, Bn, b, ldb, nb, nb, slate::GridOrder::Col, p, q, MPI_COMM_WORLD, false, pool_size);
+    auto B = B_pooled.matrix();
 
     if (transA == Op::Trans)
         A = transpose(A);
@@ -8,9 +8,11 @@
 
 #include "slate/slate.hh"
 #include "slate/generate_matrix.hh"
+#include "slate/internal/device.hh"
 #include "random.hh"
 
 #include <exception>
+#include <set>
 #include <string>
 #include <vector>
 #include <limits>
@@ -24,6 +26,63 @@
 
 namespace slate {
 
+//------------------------------------------------------------------------------
+/// Generates the tiles in tiles_set[ device ] directly on each device, with
+/// the same values as on the host. Used for matrices with device origin,
+/// whose tiles would otherwise be generated on the host and copied.
+///
+/// Internal function, called from generate_rand().
+///
+/// @ingroup generate_matrix
+template <typename scalar_t>
+void generate_rand_devices(
+    BaseMatrix<scalar_t>& A,
+    std::vector< std::set< std::tuple<int64_t, int64_t> > >& tiles_set,
+    slate::random::Dist rand_dist, bool dominant,
+    blas::real_type<scalar_t> sigma_max, int64_t seed )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t n = A.n();
+
+    // first row and column of each block row and column
+    std::vector<int64_t> row( A.mt(), 0 ), col( A.nt(), 0 );
+    for (int64_t i = 1; i < A.mt(); ++i)
+        row[ i ] = row[ i-1 ] + A.tileMb( i-1 );
+    for (int64_t j = 1; j < A.nt(); ++j)
+        col[ j ] = col[ j-1 ] + A.tileNb( j-1 );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int device = 0; device < A.num_devices(); ++device) {
+            if (! tiles_set[ device ].empty()) {
+                #pragma omp task slate_omp_default_none \
+                    shared( A, tiles_set, row, col ) \
+                    firstprivate( device, n, dominant, sigma_max, seed, \
+                                  rand_dist )
+                {
+                    A.tileGetForWriting( tiles_set[ device ], device,
+                                         LayoutConvert::ColMajor );
+                    blas::Queue* queue = A.compute_queue( device );
+                    for (auto ij : tiles_set[ device ]) {
+                        int64_t i = std::get<0>( ij );
+                        int64_t j = std::get<1>( ij );
+                        auto Aij = A( i, j, device );
+                        // Make it diagonally dominant
+                        real_t diag_add = (dominant && i == j) ? real_t( n ) : 0;
+                        device::genrand( int( rand_dist ), seed,
+                                         Aij.mb(), Aij.nb(), row[ i ], col[ j ],
+                                         diag_add, sigma_max,
+                                         Aij.data(), Aij.stride(), *queue );
+                    }
+                    queue->sync();
+                }
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Generates matrix using either:
 /// random uniform entries on (0, 1)
@@ -48,6 +107,20 @@ void generate_rand(
 
     auto rand_dist = slate::random::Dist(int(type));
 
+    if (A.origin() == Target::Devices && A.num_devices() > 0) {
+        std::vector< std::set< std::tuple<int64_t, int64_t> > >
+            tiles_set( A.num_devices() );
+        for (int64_t j = 0; j < nt; ++j) {
+            for (int64_t i = 0; i < mt; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    tiles_set[ A.tileDevice( i, j ) ].insert( { i, j } );
+            }
+        }
+        generate_rand_devices( A, tiles_set, rand_dist, dominant,
+                               sigma_max, seed );
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -103,6 +176,22 @@ void generate_rand(
 
     auto rand_dist = slate::random::Dist(int(type));
 
+    if (A.origin() == Target::Devices && A.num_devices() > 0) {
+        std::vector< std::set< std::tuple<int64_t, int64_t> > >
+            tiles_set( A.num_devices() );
+        for (int64_t j = 0; j < nt; ++j) {
+            int64_t i_start = A.uplo() == Uplo::Lower ? j  : 0;
+            int64_t i_end   = A.uplo() == Uplo::Lower ? mt : std::min( j+1, mt );
+            for (int64_t i = i_start; i < i_end; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    tiles_set[ A.tileDevice( i, j ) ].insert( { i, j } );
+            }
+        }
+        generate_rand_devices( A, tiles_set, rand_dist, dominant,
+                               sigma_max, seed );
+        return;
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -0,0 +1,68 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "scalapack_slate.hh"
+
+namespace slate {
+namespace scalapack_api {
+
+// -----------------------------------------------------------------------------
+// Generation of the residency cache, in critical(slate_scalapack_cache).
+static int64_t s_cache_generation = 0;
+
+int64_t slate_scalapack_cache_generation()
+{
+    int64_t generation;
+    #pragma omp critical(slate_scalapack_cache)
+    generation = s_cache_generation;
+    return generation;
+}
+
+// -----------------------------------------------------------------------------
+// Erases the entries of a from the cache of scalar_t, or all entries if a is
+// null. Destroying the last reference to a matrix frees its device tiles.
+template <typename scalar_t>
+void slate_scalapack_cache_erase(void* a)
+{
+    auto& cache = slate_scalapack_cache<scalar_t>();
+    if (a == nullptr) {
+        cache.clear();
+        return;
+    }
+    auto iter = cache.lower_bound(slate_scalapack_cache_key(a, std::vector<int>()));
+    while (iter != cache.end() && iter->first.first == a)
+        iter = cache.erase(iter);
+}
+
+// -----------------------------------------------------------------------------
+// C interfaces (FORTRAN_UPPER, FORTRAN_LOWER, FORTRAN_UNDERSCORE)
+// Drops cached device copies of matrix a, after the application changed it,
+// or of all matrices if a is null.
+
+extern "C" void slate_scalapack_cache_invalidate(void* a)
+{
+    #pragma omp critical(slate_scalapack_cache)
+    {
+        if (a == nullptr)
+            ++s_cache_generation;
+        slate_scalapack_cache_erase< float >(a);
+        slate_scalapack_cache_erase< double >(a);
+        slate_scalapack_cache_erase< std::complex<float> >(a);
+        slate_scalapack_cache_erase< std::complex<double> >(a);
+    }
+}
+
+extern "C" void SLATE_SCALAPACK_CACHE_INVALIDATE(void* a)
+{
+    slate_scalapack_cache_invalidate(a);
+}
+
+extern "C" void slate_scalapack_cache_invalidate_(void* a)
+{
+    slate_scalapack_cache_invalidate(a);
+}
+
+} // namespace scalapack_api
+} // namespace slate
@@ -97,7 +97,9 @@ void slate_pgecon(const char* normstr, int n, scalar_t* a, int ia, int ja, int*
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // todo: extract the real info from getrf
     *info = 0;
@@ -123,7 +125,8 @@ void slate_pgecon(const char* normstr, int n, scalar_t* a, int ia, int ja, int*
     int64_t An = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto A = A_pooled.matrix();
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     *rcond = slate::gecondest(norm, A, anorm, {
@@ -107,7 +107,9 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t inner_blocking = slate_scalapack_set_ib();
     static int64_t lookahead = slate_scalapack_set_lookahead();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // A is m-by-n, BX is max(m, n)-by-nrhs.
     // If op == NoTrans, op(A) is m-by-n, B is m-by-nrhs
@@ -120,11 +122,13 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto A = A_pooled.matrix();
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto B = B_pooled.matrix();
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     // Apply transpose
@@ -134,6 +138,8 @@ void slate_pgels(const char* transstr, int m, int n, int nrhs, scalar_t* a, int
     else if (trans == slate::Op::ConjTrans)
         opA = conj_transpose( A );
 
+    slate_scalapack_cache_invalidate_outputs(a, b);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "gels");
 
@@ -121,7 +121,9 @@ void slate_pgemm(const char* transastr, const char* transbstr, int m, int n, int
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // sizes of A and B
     int64_t Am = (transA == blas::Op::NoTrans ? m : k);
@@ -134,15 +136,16 @@ void slate_pgemm(const char* transastr, const char* transbstr, int m, int n, int
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate_scalapack_input_matrix(a, desca, target, grid_order, nprow, npcol);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto B = slate_scalapack_input_matrix(b, descb, target, grid_order, nprow, npcol);
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     Cblacs_gridinfo(desc_CTXT(descc), &nprow, &npcol, &myprow, &mypcol);
-    auto C = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descc), desc_N(descc), c, desc_LLD(descc), desc_MB(descc), desc_NB(descc), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> C_pooled(desc_M(descc), desc_N(descc), c, desc_LLD(descc), desc_MB(descc), desc_NB(descc), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto C = C_pooled.matrix();
     C = slate_scalapack_submatrix(Cm, Cn, C, ic, jc, descc);
 
     if (transA == blas::Op::Trans)
@@ -155,6 +158,8 @@ void slate_pgemm(const char* transastr, const char* transbstr, int m, int n, int
     else if (transB == blas::Op::ConjTrans)
         B = conj_transpose( B );
 
+    slate_scalapack_cache_invalidate_outputs(c);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "gemm");
 
@@ -96,7 +96,10 @@ void slate_pgetrf(int m, int n, scalar_t* a, int ia, int ja, int* desca, int* ip
     static int64_t lookahead = slate_scalapack_set_lookahead();
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
+    static int64_t reblock_nb = slate_scalapack_set_nb();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // Matrix sizes
     int64_t Am = m;
@@ -106,19 +109,41 @@ void slate_pgetrf(int m, int n, scalar_t* a, int ia, int ja, int* desca, int* ip
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> A_pooled(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto A = A_pooled.matrix();
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
+    // Tile size, lookahead, etc. from the tuning file, if any.
+    slate::TunedParams tuned = slate_scalapack_tuned("getrf", target, std::min(Am, An));
+
+    // Optionally factor in larger tiles than the ScaLAPACK blocks,
+    // re-blocked into a SLATE matrix on the same process grid.
+    int64_t factor_nb = desc_NB(desca);
+    if (desc_MB(desca) == desc_NB(desca))
+        factor_nb = slate_scalapack_reblock_nb(tuned.nb > 0 ? tuned.nb : reblock_nb, desc_NB(desca));
+    int64_t ratio = factor_nb / desc_NB(desca);
+    auto A_factor = A;
+    if (ratio > 1) {
+        A_factor = slate::Matrix<scalar_t>(Am, An, factor_nb, factor_nb, grid_order, nprow, npcol, mpi_comm);
+        A_factor.insertLocalTiles();
+        slate_scalapack_reblock(A, A_factor, ratio, true);
+    }
+
+    slate_scalapack_cache_invalidate_outputs(a);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "getrf");
 
-    slate::getrf(A, pivots, {
-        {slate::Option::Lookahead, lookahead},
+    slate::getrf(A_factor, pivots, {
+        {slate::Option::Lookahead, tuned.lookahead >= 0 ? tuned.lookahead : lookahead},
         {slate::Option::Target, target},
-        {slate::Option::MaxPanelThreads, panel_threads},
-        {slate::Option::InnerBlocking, ib}
+        {slate::Option::MaxPanelThreads, tuned.panel_threads > 0 ? tuned.panel_threads : panel_threads},
+        {slate::Option::InnerBlocking, tuned.ib > 0 ? tuned.ib : ib}
     });
 
+    if (ratio > 1)
+        slate_scalapack_reblock(A, A_factor, ratio, false);
+
     // Extract pivots from SLATE's global Pivots structure into ScaLAPACK local ipiv array
     {
         int isrcproc0 = 0;
@@ -129,10 +154,10 @@ void slate_pgetrf(int m, int n, scalar_t* a, int ia, int ja, int* desca, int* ip
         for (int l_ipiv_rindx=1; l_ipiv_rindx <= l_numrows; ++l_ipiv_rindx) {
             // for ipiv index, convert to global indexing
             int64_t g_ipiv_rindx = scalapack_indxl2g(&l_ipiv_rindx, &nb, &myprow, &isrcproc0, &nprow);
-            // assuming uniform nb from scalapack (note 1-indexing)
+            // assuming uniform tile size factor_nb of pivots (note 1-indexing)
             // figure out pivots(tile-index, offset)
-            int64_t g_ipiv_tile_indx = (g_ipiv_rindx - 1) / nb;
-            int64_t g_ipiv_tile_offset = (g_ipiv_rindx -1 ) % nb;
+            int64_t g_ipiv_tile_indx = (g_ipiv_rindx - 1) / factor_nb;
+            int64_t g_ipiv_tile_offset = (g_ipiv_rindx -1 ) % factor_nb;
             // get the reference to pivot corresponding to current ipiv
             Pivot pivot = pivots[g_ipiv_tile_indx][g_ipiv_tile_offset];
             // get swap information from pivot
@@ -140,7 +165,7 @@ void slate_pgetrf(int m, int n, scalar_t* a, int ia, int ja, int* desca, int* ip
             int64_t elementOffsetSwap = pivot.elementOffset();
             // scalapack 1-index
             // pivots reference local submatrix; so shift by g_ipiv_tile_indx
-            ipiv[l_ipiv_rindx-1] = ((tileIndexSwap+g_ipiv_tile_indx) * nb) + (elementOffsetSwap + 1);
+            ipiv[l_ipiv_rindx-1] = ((tileIndexSwap+g_ipiv_tile_indx) * factor_nb) + (elementOffsetSwap + 1);
         }
     }
 
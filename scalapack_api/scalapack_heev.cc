@@ -105,12 +105,15 @@ void slate_pheev(const char* jobzstr, const char* uplostr, int n, scalar_t* a, i
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // todo: extract the real info from heev
     *info = 0;
 
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
+    slate_scalapack_cache_invalidate_outputs(a, z);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "heev");
 
@@ -127,13 +130,13 @@ void slate_pheev(const char* jobzstr, const char* uplostr, int n, scalar_t* a, i
     int64_t Zn = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     slate::Matrix<scalar_t> Z;
     if (jobz == lapack::Job::Vec) {
         Cblacs_gridinfo(desc_CTXT(descz), &nprow, &npcol, &myprow, &mypcol);
-        Z = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descz), desc_N(descz), z, desc_LLD(descz), desc_MB(descz), desc_NB(descz), grid_order, nprow, npcol, MPI_COMM_WORLD);
+        Z = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descz), desc_N(descz), z, desc_LLD(descz), desc_MB(descz), desc_NB(descz), grid_order, nprow, npcol, mpi_comm);
         Z = slate_scalapack_submatrix(Zm, Zn, Z, iz, jz, descz);
     }
 
@@ -80,7 +80,9 @@ void slate_phemm(const char* sidestr, const char* uplostr, int m, int n, scalar_
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     int64_t An = (side == blas::Side::Left ? m : n);
     int64_t Am = An;
@@ -92,15 +94,17 @@ void slate_phemm(const char* sidestr, const char* uplostr, int m, int n, scalar_
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto AH = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto AH = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
     AH = slate_scalapack_submatrix(Am, An, AH, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto B = B_pooled.matrix();
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     Cblacs_gridinfo(desc_CTXT(descc), &nprow, &npcol, &myprow, &mypcol);
-    auto C = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descc), desc_N(descc), c, desc_LLD(descc), desc_MB(descc), desc_NB(descc), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> C_pooled(desc_M(descc), desc_N(descc), c, desc_LLD(descc), desc_MB(descc), desc_NB(descc), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto C = C_pooled.matrix();
     C = slate_scalapack_submatrix(Cm, Cn, C, ic, jc, descc);
 
     if (side == blas::Side::Left)
@@ -110,6 +114,8 @@ void slate_phemm(const char* sidestr, const char* uplostr, int m, int n, scalar_
     assert(B.mt() == C.mt());
     assert(B.nt() == C.nt());
 
+    slate_scalapack_cache_invalidate_outputs(c);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "hemm");
 
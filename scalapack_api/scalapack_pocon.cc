@@ -98,6 +98,7 @@ void slate_ppocon(const char* uplostr, int n, scalar_t* a, int ia, int ja, int*
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // todo: extract the real info from getrf
     *info = 0;
@@ -123,7 +124,7 @@ void slate_ppocon(const char* uplostr, int n, scalar_t* a, int ia, int ja, int*
     int64_t An = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     *rcond = slate::pocondest(slate::Norm::One, A, anorm, {
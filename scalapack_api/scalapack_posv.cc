@@ -98,7 +98,10 @@ void slate_pposv(const char* uplostr, int n, int nrhs, scalar_t* a, int ia, int
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
+    static int64_t reblock_nb = slate_scalapack_set_nb();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // Matrix sizes
     int64_t Am = n;
@@ -110,21 +113,52 @@ void slate_pposv(const char* uplostr, int n, int nrhs, scalar_t* a, int ia, int
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto A = slate::HermitianMatrix<scalar_t>::fromScaLAPACK(uplo, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
     A = slate_scalapack_submatrix(Am, An, A, ia, ja, desca);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto B = B_pooled.matrix();
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
+    // Tile size, lookahead, etc. from the tuning file, if any.
+    slate::TunedParams tuned = slate_scalapack_tuned("potrf", target, An);
+
+    // Optionally factor in larger tiles than the ScaLAPACK blocks,
+    // re-blocked into a SLATE matrix on the same process grid.
+    int64_t factor_nb = desc_NB(desca);
+    if (desc_MB(desca) == desc_NB(desca)
+        && desc_MB(descb) == desc_NB(desca) && desc_NB(descb) == desc_NB(desca))
+        factor_nb = slate_scalapack_reblock_nb(tuned.nb > 0 ? tuned.nb : reblock_nb, desc_NB(desca));
+    int64_t ratio = factor_nb / desc_NB(desca);
+    auto A_factor = A;
+    if (ratio > 1) {
+        A_factor = slate::HermitianMatrix<scalar_t>(uplo, An, factor_nb, grid_order, nprow, npcol, mpi_comm);
+        A_factor.insertLocalTiles();
+        slate_scalapack_reblock(A, A_factor, ratio, true);
+    }
+    auto B_factor = B;
+    if (ratio > 1) {
+        B_factor = slate::Matrix<scalar_t>(Bm, Bn, factor_nb, factor_nb, grid_order, nprow, npcol, mpi_comm);
+        B_factor.insertLocalTiles();
+        slate_scalapack_reblock(B, B_factor, ratio, true);
+    }
+
+    slate_scalapack_cache_invalidate_outputs(a, b);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "posv");
 
-    slate::posv(A, B, {
-        {slate::Option::Lookahead, lookahead},
+    slate::posv(A_factor, B_factor, {
+        {slate::Option::Lookahead, tuned.lookahead >= 0 ? tuned.lookahead : lookahead},
         {slate::Option::Target, target},
     });
 
+    if (ratio > 1) {
+        slate_scalapack_reblock(A, A_factor, ratio, false);
+        slate_scalapack_reblock(B, B_factor, ratio, false);
+    }
+
     // todo: extract the real info
     *info = 0;
 }
@@ -98,19 +98,24 @@ void slate_ppotrs(const char* uplostr, int n, int nrhs, scalar_t* a, int ia, int
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto Afull = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto Afull = slate_scalapack_input_matrix(a, desca, target, grid_order, nprow, npcol);
     auto Asub = slate_scalapack_submatrix(n, n, Afull, ia, ja, desca);
     slate::HermitianMatrix<scalar_t> A(uplo, Asub);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto Bfull = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> Bfull_pooled(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto Bfull = Bfull_pooled.matrix();
     slate::Matrix<scalar_t> B = slate_scalapack_submatrix(n, nrhs, Bfull, ia, ja, descb);
 
+    slate_scalapack_cache_invalidate_outputs(b);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "potrs");
 
@@ -10,12 +10,19 @@
 #include "blas/fortran.h"
 
 #include "slate/slate.hh"
+#include "slate/internal/MatrixPool.hh"
 
 extern "C" void Cblacs_pinfo(int* mypnum, int* nprocs);
 extern "C" void Cblacs_pcoord(int icontxt, int pnum, int* prow, int* pcol);
 extern "C" void Cblacs_get(int icontxt, int what, int* val);
+extern "C" void Cblacs_gridinfo(int context, int*  np_row, int* np_col, int*  my_row, int*  my_col);
+extern "C" void Cigsum2d(int context, const char* scope, const char* top, int m, int n, int* A, int lda, int rdest, int cdest);
+extern "C" MPI_Comm Cblacs2sys_handle(int sys_handle);
 
 #include <complex>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace slate {
 namespace scalapack_api {
@@ -77,6 +84,72 @@ inline slate::GridOrder slate_scalapack_blacs_grid_order()
     }
 }
 
+// -----------------------------------------------------------------------------
+// Returns the MPI communicator of the processes in the grid of BLACS context,
+// with ranks numbered in grid_order, as fromScaLAPACK expects, so that calls
+// on a subgrid only involve its processes. This is the communicator the grid
+// was made from if it matches, else a communicator created on first use and
+// kept for later calls. Collective over the grid; returns MPI_COMM_NULL on
+// processes outside it.
+inline MPI_Comm slate_scalapack_comm(int context, slate::GridOrder grid_order)
+{
+    int nprow, npcol, myprow, mypcol;
+    Cblacs_gridinfo(context, &nprow, &npcol, &myprow, &mypcol);
+    if (myprow < 0 || mypcol < 0)
+        return MPI_COMM_NULL;
+
+    // communicator the grid was made from, via the context's system handle
+    int sys_handle, what_sys_handle = 10;
+    Cblacs_get(context, what_sys_handle, &sys_handle);
+    MPI_Comm parent = Cblacs2sys_handle(sys_handle);
+    int parent_rank, parent_size;
+    MPI_Comm_rank(parent, &parent_rank);
+    MPI_Comm_size(parent, &parent_size);
+
+    // parent ranks of the grid's processes, in grid_order
+    std::vector<int> ranks(nprow * npcol, 0);
+    int myrank = (grid_order == slate::GridOrder::Col)
+               ? myprow + mypcol*nprow
+               : myprow*npcol + mypcol;
+    ranks[ myrank ] = parent_rank;
+    Cigsum2d(context, "All", " ", nprow*npcol, 1, ranks.data(), nprow*npcol, -1, -1);
+
+    bool is_parent = (int(ranks.size()) == parent_size);
+    for (int r = 0; r < int(ranks.size()) && is_parent; ++r)
+        is_parent = (ranks[ r ] == r);
+    if (is_parent)
+        return parent;
+
+    // keyed on the ranks, not the context, as BLACS reuses freed contexts;
+    // the key is the same on all processes of the grid, so all or none
+    // create the communicator
+    using key_type = std::pair< MPI_Comm, std::vector<int> >;
+    static std::map< key_type, MPI_Comm > comms;
+    key_type key(parent, ranks);
+    MPI_Comm comm = MPI_COMM_NULL;
+    #pragma omp critical(slate_scalapack_comm)
+    {
+        auto iter = comms.find(key);
+        if (iter != comms.end())
+            comm = iter->second;
+    }
+    if (comm == MPI_COMM_NULL) {
+        MPI_Group parent_group, group;
+        MPI_Comm_group(parent, &parent_group);
+        MPI_Group_incl(parent_group, ranks.size(), ranks.data(), &group);
+        int tag = 0;
+        slate_mpi_call(
+            MPI_Comm_create_group(parent, group, tag, &comm));
+        MPI_Group_free(&group);
+        MPI_Group_free(&parent_group);
+        #pragma omp critical(slate_scalapack_comm)
+        {
+            comms[ key ] = comm;
+        }
+    }
+    return comm;
+}
+
 template< typename scalar_t >
 inline slate::Matrix<scalar_t> slate_scalapack_submatrix(int Am, int An, slate::Matrix<scalar_t>& A, int ia, int ja, int* desca)
 {
@@ -199,6 +272,68 @@ inline int64_t slate_scalapack_set_lookahead()
     return 1;
 }
 
+inline int64_t slate_scalapack_set_nb()
+{
+    // tile size to factor in; 0 (default) keeps the ScaLAPACK nb
+    int64_t nb = 0;
+    char* nbstr = std::getenv("SLATE_SCALAPACK_NB");
+    if (nbstr) {
+        nb = (int64_t)strtol(nbstr, NULL, 0);
+        if (nb > 0) return nb;
+    }
+    return 0;
+}
+
+inline int slate_scalapack_set_pool_size()
+{
+    // number of free matrices kept for reuse across calls (0: no reuse)
+    int pool_size = 8; // default
+    char* poolstr = std::getenv("SLATE_SCALAPACK_POOL");
+    if (poolstr)
+        pool_size = (int)strtol(poolstr, NULL, 0);
+    return pool_size;
+}
+
+inline bool slate_scalapack_set_cache()
+{
+    // cache input matrices on devices between calls (0: off (default), 1: on)
+    char* cachestr = std::getenv("SLATE_SCALAPACK_CACHE");
+    return cachestr && cachestr[0] == '1';
+}
+
+// -----------------------------------------------------------------------------
+// Returns parameters tuned for routine at problem size n on target, from the
+// tuning file (see slate::tuned_params), with fields set by the
+// SLATE_SCALAPACK_NB, SLATE_SCALAPACK_IB, SLATE_SCALAPACK_LOOKAHEAD, or
+// SLATE_SCALAPACK_PANELTHREADS environment variables cleared to -1, so
+// explicit settings take precedence. Fields < 0 use the usual defaults.
+// A tuned nb is used as the re-blocking tile size.
+inline slate::TunedParams slate_scalapack_tuned(const char* routine, slate::Target target, int64_t n)
+{
+    slate::TunedParams tuned = slate::tuned_params(routine, target, n);
+    if (std::getenv("SLATE_SCALAPACK_NB"))
+        tuned.nb = -1;
+    if (std::getenv("SLATE_SCALAPACK_IB"))
+        tuned.ib = -1;
+    if (std::getenv("SLATE_SCALAPACK_LOOKAHEAD"))
+        tuned.lookahead = -1;
+    if (std::getenv("SLATE_SCALAPACK_PANELTHREADS"))
+        tuned.panel_threads = -1;
+    return tuned;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the tile size to re-block a matrix with square nb x nb ScaLAPACK
+// blocks into: SLATE_SCALAPACK_NB (reblock_nb) rounded up to a multiple of
+// nb, so each ScaLAPACK block lies in one SLATE tile. Returns nb if
+// re-blocking is off or wouldn't make tiles larger.
+inline int64_t slate_scalapack_reblock_nb(int64_t reblock_nb, int64_t nb)
+{
+    if (reblock_nb <= nb)
+        return nb;
+    return ((reblock_nb + nb - 1) / nb) * nb;
+}
+
 // -----------------------------------------------------------------------------
 // helper funtion to check and do type conversion
 // TODO: this is duplicated at the testing module
@@ -226,6 +361,193 @@ inline int64_t scalapack_numroc(int64_t n, int64_t nb, int iproc, int isrcproc,
 #define scalapack_indxl2g BLAS_FORTRAN_NAME(indxl2g,INDXL2G)
 extern "C" int scalapack_indxl2g(int* indxloc, int* nb, int* iproc, int* isrcproc, int* nprocs);
 
+// -----------------------------------------------------------------------------
+// Copies between A, with the ScaLAPACK nb x nb blocks, and B, the same
+// matrix on the same process grid with tiles ratio times larger:
+// A into B if to_big, else B back into A.
+// Each rank packs its blocks for each other rank into one buffer, so the
+// copy is a single MPI_Alltoallv rather than a message per small block.
+// For Hermitian matrices, only blocks in the uplo triangle are copied, and
+// only the uplo triangle of diagonal blocks, so the other triangle of A is
+// left untouched.
+template <typename matrix_type>
+void slate_scalapack_reblock(matrix_type& A, matrix_type& B, int64_t ratio, bool to_big)
+{
+    using scalar_t = typename matrix_type::value_type;
+
+    slate::Uplo uplo = A.uplo();
+    int mpi_rank = A.mpiRank();
+    int mpi_size;
+    MPI_Comm_size(A.mpiComm(), &mpi_size);
+
+    std::vector<int> send_counts(mpi_size, 0), recv_counts(mpi_size, 0);
+    std::vector<int> send_displs(mpi_size, 0), recv_displs(mpi_size, 0);
+
+    // Calls fn(i, j, src, dst) for each block (i, j) of A to copy, in the
+    // same (j, i) order on all ranks, so packed blocks match on both sides.
+    auto for_blocks = [&](auto fn) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            int64_t i_begin = uplo == slate::Uplo::Lower ? j : 0;
+            int64_t i_end   = uplo == slate::Uplo::Upper ? j+1 : A.mt();
+            for (int64_t i = i_begin; i < i_end; ++i) {
+                int small_rank = A.tileRank(i, j);
+                int big_rank   = B.tileRank(i / ratio, j / ratio);
+                if (to_big)
+                    fn(i, j, small_rank, big_rank);
+                else
+                    fn(i, j, big_rank, small_rank);
+            }
+        }
+    };
+
+    // Copies block (i, j) between its tile in A and its place in B,
+    // and the packed buffer.
+    auto copy_block = [&](int64_t i, int64_t j, scalar_t* buffer, bool pack) {
+        int64_t mb = A.tileMb(i);
+        int64_t nb = A.tileNb(j);
+        lapack::MatrixType type = lapack::MatrixType::General;
+        if (i == j && uplo == slate::Uplo::Lower)
+            type = lapack::MatrixType::Lower;
+        else if (i == j && uplo == slate::Uplo::Upper)
+            type = lapack::MatrixType::Upper;
+
+        scalar_t* data;
+        int64_t lda;
+        if (pack == to_big) {
+            auto T = A(i, j);
+            data = T.data();
+            lda  = T.stride();
+        }
+        else {
+            auto T = B(i / ratio, j / ratio);
+            int64_t ioffset = (i % ratio) * A.tileMb(0);
+            int64_t joffset = (j % ratio) * A.tileNb(0);
+            data = T.data() + ioffset + joffset*T.stride();
+            lda  = T.stride();
+        }
+        if (pack)
+            lapack::lacpy(type, mb, nb, data, lda, buffer, mb);
+        else
+            lapack::lacpy(type, mb, nb, buffer, mb, data, lda);
+    };
+
+    for_blocks([&](int64_t i, int64_t j, int src, int dst) {
+        int count = int64_to_int(A.tileMb(i) * A.tileNb(j));
+        if (src == mpi_rank)
+            send_counts[dst] += count;
+        if (dst == mpi_rank)
+            recv_counts[src] += count;
+    });
+    for (int r = 1; r < mpi_size; ++r) {
+        send_displs[r] = send_displs[r-1] + send_counts[r-1];
+        recv_displs[r] = recv_displs[r-1] + recv_counts[r-1];
+    }
+    std::vector<scalar_t> send_buffer(send_displs.back() + send_counts.back());
+    std::vector<scalar_t> recv_buffer(recv_displs.back() + recv_counts.back());
+
+    std::vector<int> offsets = send_displs;
+    for_blocks([&](int64_t i, int64_t j, int src, int dst) {
+        if (src == mpi_rank) {
+            copy_block(i, j, &send_buffer[offsets[dst]], true);
+            offsets[dst] += A.tileMb(i) * A.tileNb(j);
+        }
+    });
+
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_displs.data(),
+                  slate::mpi_type<scalar_t>::value,
+                  recv_buffer.data(), recv_counts.data(), recv_displs.data(),
+                  slate::mpi_type<scalar_t>::value, A.mpiComm());
+
+    offsets = recv_displs;
+    for_blocks([&](int64_t i, int64_t j, int src, int dst) {
+        if (dst == mpi_rank) {
+            copy_block(i, j, &recv_buffer[offsets[src]], false);
+            offsets[src] += A.tileMb(i) * A.tileNb(j);
+        }
+    });
+}
+
+// -----------------------------------------------------------------------------
+// Residency cache of input matrices, enabled with SLATE_SCALAPACK_CACHE=1
+// for Target::Devices. A cached matrix keeps its device tiles on hold, so
+// drivers don't release them, and later calls that read the same unchanged
+// ScaLAPACK matrix skip the host-to-device copy.
+// Entries are keyed by data pointer and descriptor, and stamped with the
+// generation when they were made. slate_scalapack_cache_invalidate(a) drops
+// the entries of a, or starts a new generation, dropping all entries, if a
+// is null. Routines of this API invalidate the matrices they overwrite;
+// applications must invalidate a matrix after changing its data themselves.
+
+extern "C" void slate_scalapack_cache_invalidate(void* a);
+
+// -----------------------------------------------------------------------------
+// Drops cached device copies of the matrices a routine overwrites, e.g., a
+// and b in gesv, before it runs, so later calls don't read stale tiles.
+// Every routine of this API that writes a matrix calls it with those
+// matrices.
+template <typename... ptr_t>
+void slate_scalapack_cache_invalidate_outputs(ptr_t... outputs)
+{
+    ( slate_scalapack_cache_invalidate(outputs), ... );
+}
+
+int64_t slate_scalapack_cache_generation();
+
+using slate_scalapack_cache_key = std::pair< void const*, std::vector<int> >;
+
+template <typename scalar_t>
+struct slate_scalapack_cache_entry {
+    slate::Matrix<scalar_t> A;
+    int64_t generation;
+};
+
+template <typename scalar_t>
+std::map< slate_scalapack_cache_key, slate_scalapack_cache_entry<scalar_t> >& slate_scalapack_cache()
+{
+    static std::map< slate_scalapack_cache_key, slate_scalapack_cache_entry<scalar_t> > cache;
+    return cache;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the SLATE matrix for ScaLAPACK input matrix a, like fromScaLAPACK,
+// but from the residency cache when it is enabled and target is Devices.
+// On a miss, the new matrix's tiles are copied to and held on devices.
+// The matrix must only be read.
+template <typename scalar_t>
+slate::Matrix<scalar_t> slate_scalapack_input_matrix(scalar_t* a, int* desca, slate::Target target, slate::GridOrder grid_order, int nprow, int npcol)
+{
+    static bool use_cache = slate_scalapack_set_cache();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
+    if (! use_cache || target != slate::Target::Devices) {
+        return slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
+    }
+
+    int desc_len = (desca[0] == BLOCK_CYCLIC_2D) ? 9 : 11;
+    slate_scalapack_cache_key key(a, std::vector<int>(desca, desca + desc_len));
+    int64_t generation = slate_scalapack_cache_generation();
+
+    slate::Matrix<scalar_t> A;
+    bool found = false;
+    #pragma omp critical(slate_scalapack_cache)
+    {
+        auto& cache = slate_scalapack_cache<scalar_t>();
+        auto iter = cache.find(key);
+        if (iter != cache.end() && iter->second.generation == generation) {
+            A = iter->second.A;
+            found = true;
+        }
+    }
+    if (! found) {
+        A = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(desca), desc_N(desca), a, desc_LLD(desca), desc_MB(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
+        A.tileGetAndHoldAllOnDevices(slate::LayoutConvert::ColMajor);
+        #pragma omp critical(slate_scalapack_cache)
+        {
+            slate_scalapack_cache<scalar_t>()[ key ] = { A, generation };
+        }
+    }
+    return A;
+}
+
 } // namespace scalapack_api
 } // namespace slate
 
@@ -100,6 +100,7 @@ void slate_ptrcon(const char* normstr, const char* uplostr, const char* diagstr,
     static int64_t panel_threads = slate_scalapack_set_panelthreads();
     static int64_t ib = slate_scalapack_set_ib();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // todo: extract the real info from getrf
     *info = 0;
@@ -125,7 +126,7 @@ void slate_ptrcon(const char* normstr, const char* uplostr, const char* diagstr,
     int64_t An = n;
 
     // create SLATE matrices from the ScaLAPACK layouts
-    auto AT = slate::TriangularMatrix<scalar_t>::fromScaLAPACK(uplo, diag, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    auto AT = slate::TriangularMatrix<scalar_t>::fromScaLAPACK(uplo, diag, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, mpi_comm);
     AT = slate_scalapack_submatrix(Am, An, AT, ia, ja, desca);
 
     blas::real_type<scalar_t> anorm = slate::norm( norm, AT, {
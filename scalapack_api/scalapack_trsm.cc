@@ -103,7 +103,9 @@ void slate_ptrsm(const char* sidestr, const char* uplostr, const char* transastr
     static slate::Target target = slate_scalapack_set_target();
     static int verbose = slate_scalapack_set_verbose();
     static int64_t lookahead = slate_scalapack_set_lookahead();
+    static int pool_size = slate_scalapack_set_pool_size();
     slate::GridOrder grid_order = slate_scalapack_blacs_grid_order();
+    MPI_Comm mpi_comm = slate_scalapack_comm(desc_CTXT(desca), grid_order);
 
     // setup so trans(B) is m-by-n
     int64_t An  = (side == blas::Side::Left ? m : n);
@@ -114,11 +116,13 @@ void slate_ptrsm(const char* sidestr, const char* uplostr, const char* transastr
     // create SLATE matrices from the ScaLAPACK layouts
     int nprow, npcol, myprow, mypcol;
     Cblacs_gridinfo(desc_CTXT(desca), &nprow, &npcol, &myprow, &mypcol);
-    auto AT = slate::TriangularMatrix<scalar_t>::fromScaLAPACK(uplo, diag, desc_N(desca), a, desc_LLD(desca), desc_NB(desca), grid_order, nprow, npcol, MPI_COMM_WORLD);
-    AT = slate_scalapack_submatrix(Am, An, AT, ia, ja, desca);
+    auto Afull = slate_scalapack_input_matrix(a, desca, target, grid_order, nprow, npcol);
+    auto Asub = slate_scalapack_submatrix(Am, An, Afull, ia, ja, desca);
+    slate::TriangularMatrix<scalar_t> AT(uplo, diag, Asub);
 
     Cblacs_gridinfo(desc_CTXT(descb), &nprow, &npcol, &myprow, &mypcol);
-    auto B = slate::Matrix<scalar_t>::fromScaLAPACK(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, MPI_COMM_WORLD);
+    slate::internal::PooledMatrix<scalar_t> B_pooled(desc_M(descb), desc_N(descb), b, desc_LLD(descb), desc_MB(descb), desc_NB(descb), grid_order, nprow, npcol, mpi_comm, true, pool_size);
+    auto B = B_pooled.matrix();
     B = slate_scalapack_submatrix(Bm, Bn, B, ib, jb, descb);
 
     if (transA == Op::Trans)
@@ -126,6 +130,8 @@ void slate_ptrsm(const char* sidestr, const char* uplostr, const char* transastr
     else if (transA == Op::ConjTrans)
         AT = conj_transpose( AT );
 
+    slate_scalapack_cache_invalidate_outputs(b);
+
     if (verbose && myprow == 0 && mypcol == 0)
         logprintf("%s\n", "trsm");
 
@@ -0,0 +1,155 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace slate {
+namespace async {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// @return true if MPI has been finalized.
+bool mpi_finalized()
+{
+    int finalized = 0;
+    MPI_Finalized( &finalized );
+    return finalized != 0;
+}
+
+//------------------------------------------------------------------------------
+/// @return true if calls can run on the worker thread, i.e., MPI is
+/// initialized with MPI_THREAD_MULTIPLE, and not finalized.
+bool mpi_thread_multiple()
+{
+    int initialized = 0;
+    MPI_Initialized( &initialized );
+    if (! initialized || mpi_finalized())
+        return false;
+
+    int provided = 0;
+    MPI_Query_thread( &provided );
+    return provided >= MPI_THREAD_MULTIPLE;
+}
+
+//------------------------------------------------------------------------------
+/// Worker thread running queued calls in order. Started by the first
+/// submit.
+///
+class Worker {
+public:
+    /// Runs at static destruction, usually after MPI_Finalize, when queued
+    /// calls can no longer communicate. So it drops the calls still queued,
+    /// whose futures then throw std::future_error (broken_promise), waits
+    /// for the running call, and joins the thread.
+    ~Worker()
+    {
+        std::deque< std::function<void ()> > dropped;
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if (! thread_.joinable())
+                return;
+            stop_ = true;
+            dropped.swap( calls_ );
+        }
+        queued_.notify_one();
+        thread_.join();
+    }
+
+    void submit( std::function<void ()> call )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            if (! thread_.joinable())
+                thread_ = std::thread( &Worker::run, this );
+            calls_.push_back( std::move( call ) );
+            ++submitted_;
+        }
+        queued_.notify_one();
+    }
+
+    void wait_all()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        int64_t target = submitted_;
+        done_.wait( lock, [this, target]() { return completed_ >= target; } );
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        while (true) {
+            queued_.wait( lock, [this]() { return stop_ || ! calls_.empty(); } );
+            if (calls_.empty())
+                return;  // stop_ and nothing left
+
+            std::function<void ()> call = std::move( calls_.front() );
+            calls_.pop_front();
+            lock.unlock();
+            // launch wraps calls in a packaged_task, which keeps exceptions
+            // for Future::wait. After MPI_Finalize, drop the call instead.
+            if (! mpi_finalized())
+                call();
+            call = nullptr;
+            lock.lock();
+            ++completed_;
+            done_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable done_;
+    std::deque< std::function<void ()> > calls_;
+    int64_t submitted_ = 0;
+    int64_t completed_ = 0;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+//------------------------------------------------------------------------------
+Worker& worker()
+{
+    static Worker worker_;
+    return worker_;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Queues call to run on the library's worker thread, after the calls
+/// already queued. Prefer launch, which returns a Future.
+///
+/// Without MPI_THREAD_MULTIPLE, the worker thread can't call MPI, so this
+/// instead waits for the calls already queued, then runs call on the
+/// calling thread.
+///
+void submit( std::function<void ()> call )
+{
+    if (mpi_thread_multiple()) {
+        worker().submit( std::move( call ) );
+    }
+    else {
+        wait_all();
+        call();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Blocks until all calls queued so far have completed.
+///
+void wait_all()
+{
+    worker().wait_all();
+}
+
+} // namespace async
+} // namespace slate
@@ -289,9 +289,19 @@ void Debug::printNumFreeMemBlocks(Memory const& m)
 {
     if (! debug_) return;
     printf("\n");
-    for (int dev = 0; dev < m.num_devices_; ++dev) {
-        printf("\tdevice: %d\tfree blocks: %lu\n",
-               dev, m.free_blocks_[dev].size());
+    for (int dev = HostNum; dev < m.num_devices_; ++dev) {
+        if (dev == HostNum)
+            printf("\thost\t");
+        else
+            printf("\tdevice: %d\t", dev);
+        printf("free blocks: %lu\n", m.available( dev ));
+
+        // per size class stats, for blocks larger than block size
+        for (int k = 1; k < m.numSizeClasses( dev ); ++k) {
+            printf("\t\tsize class %d (%lu bytes)\tfree blocks: %lu of %lu\n",
+                   k, m.classBlockSize( k ),
+                   m.available( dev, k ), m.capacity( dev, k ));
+        }
     }
 }
 
@@ -301,17 +311,17 @@ void Debug::checkHostMemoryLeaks(Memory const& m)
 {
     using llu = long long unsigned;
     if (! debug_) return;
-    if (m.free_blocks_.at( HostNum ).size() < m.capacity_.at( HostNum )) {
+    if (m.free_host_blocks_.size() < m.host_capacity_) {
         fprintf(stderr,
                 "Error: memory leak: freed %llu of %llu blocks on host\n",
-                (llu) m.free_blocks_.at( HostNum ).size(),
-                (llu) m.capacity_.at( HostNum ));
+                (llu) m.free_host_blocks_.size(),
+                (llu) m.host_capacity_);
     }
-    else if (m.free_blocks_.at( HostNum ).size() > m.capacity_.at( HostNum )) {
+    else if (m.free_host_blocks_.size() > m.host_capacity_) {
         fprintf(stderr,
                 "Error: freed too many: %llu of %llu blocks on host\n",
-                (llu) m.free_blocks_.at( HostNum ).size(),
-                (llu) m.capacity_.at( HostNum ));
+                (llu) m.free_host_blocks_.size(),
+                (llu) m.host_capacity_);
     }
 }
 
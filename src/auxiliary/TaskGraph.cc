@@ -0,0 +1,381 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/TaskGraph.hh"
+#include "slate/internal/Trace.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <limits>
+
+namespace slate {
+namespace trace {
+
+bool TaskGraph::enabled_ = false;
+std::deque< TaskGraph::Node > TaskGraph::nodes_;
+std::vector< std::string > TaskGraph::regions_;
+std::map< void const*, TaskGraph::Access > TaskGraph::access_;
+
+//------------------------------------------------------------------------------
+/// Starts recording, discarding any graph recorded before.
+void TaskGraph::on()
+{
+    #pragma omp critical(slate_task_graph)
+    {
+        nodes_.clear();
+        regions_.clear();
+        access_.clear();
+        enabled_ = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Starts the graph of a driver call. Dependencies don't carry over from
+/// the previous call, whose dependency addresses may be reused; its tasks
+/// finished before this call started anyway.
+/// Call before the driver's parallel region.
+///
+/// @param[in] driver
+///     Name of the driver, e.g., "potrf". Must be a string literal.
+///
+void TaskGraph::region( const char* driver )
+{
+    if (! enabled_)
+        return;
+
+    #pragma omp critical(slate_task_graph)
+    {
+        regions_.push_back( driver );
+        access_.clear();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Registers a task, before creating it, with the dependencies of its
+/// depend clauses. Its predecessors are, per OpenMP's rules, for each in
+/// address, the last task with it as inout; for each inout address, the
+/// tasks with it as in since then, or if none, the last task with it as
+/// inout.
+///
+/// @param[in] name
+///     Logical task, e.g., "panel". Must be a string literal.
+///
+/// @param[in] k
+///     Step of the driver's loop, or -1.
+///
+/// @param[in] j
+///     Block column updated, or -1.
+///
+/// @param[in] in
+///     Addresses of depend(in: ...) clauses.
+///
+/// @param[in] inout
+///     Addresses of depend(inout: ...) clauses.
+///
+/// @return id of the task, to pass to TaskBlock in the task;
+///         -1 if not recording.
+///
+int64_t TaskGraph::task(
+    const char* name, int64_t k, int64_t j,
+    std::initializer_list< void const* > in,
+    std::initializer_list< void const* > inout )
+{
+    if (! enabled_)
+        return -1;
+
+    int64_t id;
+    #pragma omp critical(slate_task_graph)
+    {
+        if (regions_.empty())
+            regions_.push_back( "" );
+
+        id = nodes_.size();
+        Node node;
+        node.name   = name;
+        node.region = regions_.size() - 1;
+        node.k      = k;
+        node.j      = j;
+
+        // Predecessors use the accesses of previous tasks only.
+        for (void const* addr : in) {
+            auto iter = access_.find( addr );
+            if (iter != access_.end() && iter->second.last_out >= 0)
+                node.preds.push_back( iter->second.last_out );
+        }
+        for (void const* addr : inout) {
+            auto iter = access_.find( addr );
+            if (iter == access_.end())
+                continue;
+            Access const& access = iter->second;
+            if (! access.readers.empty()) {
+                node.preds.insert( node.preds.end(), access.readers.begin(),
+                                   access.readers.end() );
+            }
+            else if (access.last_out >= 0) {
+                node.preds.push_back( access.last_out );
+            }
+        }
+        std::sort( node.preds.begin(), node.preds.end() );
+        node.preds.erase( std::unique( node.preds.begin(), node.preds.end() ),
+                          node.preds.end() );
+        // A task is not its own predecessor, e.g., with the same address
+        // in both lists.
+        node.preds.erase(
+            std::remove( node.preds.begin(), node.preds.end(), id ),
+            node.preds.end() );
+
+        for (void const* addr : in) {
+            auto& readers = access_[ addr ].readers;
+            if (readers.empty() || readers.back() != id)
+                readers.push_back( id );
+        }
+        for (void const* addr : inout) {
+            Access& access = access_[ addr ];
+            access.last_out = id;
+            access.readers.clear();
+        }
+        nodes_.push_back( std::move( node ) );
+    }
+    return id;
+}
+
+//------------------------------------------------------------------------------
+/// Records the start of task id.
+void TaskGraph::start( int64_t id )
+{
+    double time = now();
+    #pragma omp critical(slate_task_graph)
+    nodes_[ id ].start = time;
+}
+
+//------------------------------------------------------------------------------
+/// Records the stop of task id.
+void TaskGraph::stop( int64_t id )
+{
+    double time = now();
+    #pragma omp critical(slate_task_graph)
+    nodes_[ id ].stop = time;
+}
+
+//------------------------------------------------------------------------------
+/// Computes, from the measured task times, the earliest finish of each
+/// task and its slack: how much it could be delayed without lengthening
+/// its region's critical path. Fills a summary per region.
+/// Call with the graph complete, outside critical(slate_task_graph).
+///
+TaskGraph::Path TaskGraph::criticalPath( std::vector< Summary >& summaries )
+{
+    int64_t n = nodes_.size();
+    int64_t num_regions = regions_.size();
+
+    summaries.assign( num_regions, Summary() );
+    std::vector< double > first( num_regions,
+                                 std::numeric_limits<double>::max() );
+    std::vector< double > last( num_regions, 0 );
+    for (int64_t r = 0; r < num_regions; ++r)
+        summaries[ r ].driver = regions_[ r ];
+
+    // Forward: earliest finish = time + latest earliest finish of preds.
+    Path path;
+    path.earliest.resize( n );
+    for (int64_t i = 0; i < n; ++i) {
+        Node const& node = nodes_[ i ];
+        double time = node.stop - node.start;
+        double ready = 0;
+        for (int64_t p : node.preds)
+            ready = std::max( ready, path.earliest[ p ] );
+        path.earliest[ i ] = ready + time;
+
+        Summary& summary = summaries[ node.region ];
+        summary.tasks += 1;
+        summary.edges += node.preds.size();
+        summary.work  += time;
+        summary.span   = std::max( summary.span, path.earliest[ i ] );
+        first[ node.region ] = std::min( first[ node.region ], node.start );
+        last [ node.region ] = std::max( last [ node.region ], node.stop );
+    }
+    for (int64_t r = 0; r < num_regions; ++r) {
+        if (summaries[ r ].tasks > 0)
+            summaries[ r ].elapsed = last[ r ] - first[ r ];
+    }
+
+    // Backward: latest finish = min over succs of their latest start.
+    std::vector< double > latest( n );
+    for (int64_t i = 0; i < n; ++i)
+        latest[ i ] = summaries[ nodes_[ i ].region ].span;
+    for (int64_t i = n-1; i >= 0; --i) {
+        Node const& node = nodes_[ i ];
+        double latest_start = latest[ i ] - (node.stop - node.start);
+        for (int64_t p : node.preds)
+            latest[ p ] = std::min( latest[ p ], latest_start );
+    }
+    path.slack.resize( n );
+    for (int64_t i = 0; i < n; ++i)
+        path.slack[ i ] = latest[ i ] - path.earliest[ i ];
+
+    return path;
+}
+
+//------------------------------------------------------------------------------
+/// @return critical path summary of each driver call recorded on this rank.
+std::vector< TaskGraph::Summary > TaskGraph::summary()
+{
+    std::vector< Summary > summaries;
+    #pragma omp critical(slate_task_graph)
+    criticalPath( summaries );
+    return summaries;
+}
+
+//------------------------------------------------------------------------------
+/// Stops recording, and writes this rank's graph to
+/// task_graph_<time>_<rank>.dot, for Graphviz, and .json.
+/// Critical tasks and edges are red in DOT; in JSON, tasks have times,
+/// slack, and predecessors, and each driver call has its summary.
+/// Times are in milliseconds from the first task. Rank 0 prints its
+/// summaries and the file names.
+/// Collective on MPI_COMM_WORLD, as Trace::finish.
+///
+void TaskGraph::finish()
+{
+    using llong = long long;
+
+    enabled_ = false;
+
+    int mpi_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+
+    // All ranks use rank 0's time stamp.
+    llong stamp = time( nullptr );
+    MPI_Bcast( &stamp, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD );
+    std::string base = "task_graph_" + std::to_string( stamp )
+                     + "_" + std::to_string( mpi_rank );
+
+    std::vector< Summary > summaries;
+    Path path = criticalPath( summaries );
+    int64_t n = nodes_.size();
+
+    double time_begin = std::numeric_limits<double>::max();
+    for (auto const& node : nodes_)
+        time_begin = std::min( time_begin, node.start );
+
+    // Tolerance for slack and path lengths that are zero or equal.
+    double tol = 1e-9;
+    auto is_critical = [&]( int64_t i ) {
+        return path.slack[ i ] <= tol;
+    };
+    auto is_critical_edge = [&]( int64_t p, int64_t i ) {
+        Node const& node = nodes_[ i ];
+        double time = node.stop - node.start;
+        return is_critical( p ) && is_critical( i )
+               && path.earliest[ p ] >= path.earliest[ i ] - time - tol;
+    };
+    auto label = [&]( Node const& node ) {
+        std::string str = node.name;
+        if (node.k >= 0)
+            str += " k=" + std::to_string( node.k );
+        if (node.j >= 0)
+            str += " j=" + std::to_string( node.j );
+        return str;
+    };
+
+    // DOT, with a cluster per driver call.
+    std::string file_name = base + ".dot";
+    FILE* file = fopen( file_name.c_str(), "w" );
+    if (file != nullptr) {
+        fprintf( file, "digraph task_graph {\n"
+                       "    node [shape=box];\n" );
+        int64_t region = -1;
+        for (int64_t i = 0; i < n; ++i) {
+            Node const& node = nodes_[ i ];
+            if (node.region != region) {
+                if (region >= 0)
+                    fprintf( file, "    }\n" );
+                region = node.region;
+                Summary const& summary = summaries[ region ];
+                fprintf( file,
+                         "    subgraph cluster_%lld {\n"
+                         "    label=\"%s: span %.3f ms, work %.3f ms,"
+                         " parallelism %.2f\";\n",
+                         llong( region ), summary.driver.c_str(),
+                         summary.span * 1e3, summary.work * 1e3,
+                         summary.parallelism() );
+            }
+            fprintf( file,
+                     "    t%lld [label=\"%s\\n%.3f ms, slack %.3f ms\"%s];\n",
+                     llong( i ), label( node ).c_str(),
+                     (node.stop - node.start) * 1e3, path.slack[ i ] * 1e3,
+                     is_critical( i ) ? ", color=red" : "" );
+            for (int64_t p : node.preds) {
+                fprintf( file, "    t%lld -> t%lld%s;\n", llong( p ), llong( i ),
+                         is_critical_edge( p, i ) ? " [color=red]" : "" );
+            }
+        }
+        if (region >= 0)
+            fprintf( file, "    }\n" );
+        fprintf( file, "}\n" );
+        fclose( file );
+    }
+
+    // JSON.
+    file_name = base + ".json";
+    file = fopen( file_name.c_str(), "w" );
+    if (file != nullptr) {
+        fprintf( file, "{\"rank\": %d,\n\"regions\": [", mpi_rank );
+        for (size_t r = 0; r < summaries.size(); ++r) {
+            Summary const& summary = summaries[ r ];
+            fprintf( file,
+                     "%s\n{\"driver\": \"%s\", \"tasks\": %lld,"
+                     " \"edges\": %lld, \"work\": %.6f, \"span\": %.6f,"
+                     " \"elapsed\": %.6f, \"parallelism\": %.4f}",
+                     r > 0 ? "," : "", summary.driver.c_str(),
+                     llong( summary.tasks ), llong( summary.edges ),
+                     summary.work * 1e3, summary.span * 1e3,
+                     summary.elapsed * 1e3, summary.parallelism() );
+        }
+        fprintf( file, "],\n\"tasks\": [" );
+        for (int64_t i = 0; i < n; ++i) {
+            Node const& node = nodes_[ i ];
+            fprintf( file,
+                     "%s\n{\"id\": %lld, \"region\": %lld, \"name\": \"%s\","
+                     " \"k\": %lld, \"j\": %lld, \"start\": %.6f,"
+                     " \"time\": %.6f, \"slack\": %.6f, \"critical\": %s,"
+                     " \"preds\": [",
+                     i > 0 ? "," : "", llong( i ), llong( node.region ),
+                     node.name, llong( node.k ), llong( node.j ),
+                     (node.start - time_begin) * 1e3,
+                     (node.stop - node.start) * 1e3, path.slack[ i ] * 1e3,
+                     is_critical( i ) ? "true" : "false" );
+            for (size_t p = 0; p < node.preds.size(); ++p) {
+                fprintf( file, "%s%lld", p > 0 ? ", " : "",
+                         llong( node.preds[ p ] ) );
+            }
+            fprintf( file, "]}" );
+        }
+        fprintf( file, "]}\n" );
+        fclose( file );
+    }
+
+    if (mpi_rank == 0) {
+        for (auto const& summary : summaries) {
+            fprintf( stderr,
+                     "task graph %s: %lld tasks, work %.3f ms,"
+                     " critical path %.3f ms, parallelism %.2f,"
+                     " elapsed %.3f ms\n",
+                     summary.driver.c_str(), llong( summary.tasks ),
+                     summary.work * 1e3, summary.span * 1e3,
+                     summary.parallelism(), summary.elapsed * 1e3 );
+        }
+        fprintf( stderr, "task graph files: task_graph_%lld_<rank>.{dot,json}\n",
+                 stamp );
+    }
+
+    nodes_.clear();
+    regions_.clear();
+    access_.clear();
+}
+
+} // namespace trace
+} // namespace slate
@@ -5,6 +5,8 @@
 
 #include "slate/internal/Trace.hh"
 
+#include "blas.hh"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -12,10 +14,85 @@
 #include <ctime>
 #include <limits>
 #include <string>
+#include <unordered_map>
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
 
 namespace slate {
 namespace trace {
 
+namespace {
+
+//------------------------------------------------------------------------------
+// Device events, via CUDA or HIP; a void* holds cudaEvent_t or hipEvent_t.
+// Each call keeps the current device of the calling thread.
+//
+#if defined( BLAS_HAVE_CUBLAS )
+
+/// Records a new event on stream, on device.
+void* event_record( int device, cudaStream_t stream )
+{
+    int current;
+    cudaGetDevice( &current );
+    cudaSetDevice( device );
+    cudaEvent_t event;
+    cudaEventCreate( &event );
+    cudaEventRecord( event, stream );
+    cudaSetDevice( current );
+    return event;
+}
+
+/// Returns seconds from event begin to event end, waiting for end.
+double event_elapsed( void* begin, void* end )
+{
+    float ms = 0;
+    cudaEventSynchronize( (cudaEvent_t) end );
+    cudaEventElapsedTime( &ms, (cudaEvent_t) begin, (cudaEvent_t) end );
+    return ms * 1e-3;
+}
+
+void event_destroy( void* event )
+{
+    cudaEventDestroy( (cudaEvent_t) event );
+}
+
+#elif defined( BLAS_HAVE_ROCBLAS )
+
+/// Records a new event on stream, on device.
+void* event_record( int device, hipStream_t stream )
+{
+    int current;
+    hipGetDevice( &current );
+    hipSetDevice( device );
+    hipEvent_t event;
+    hipEventCreate( &event );
+    hipEventRecord( event, stream );
+    hipSetDevice( current );
+    return event;
+}
+
+/// Returns seconds from event begin to event end, waiting for end.
+double event_elapsed( void* begin, void* end )
+{
+    float ms = 0;
+    hipEventSynchronize( (hipEvent_t) end );
+    hipEventElapsedTime( &ms, (hipEvent_t) begin, (hipEvent_t) end );
+    return ms * 1e-3;
+}
+
+void event_destroy( void* event )
+{
+    hipEventDestroy( (hipEvent_t) event );
+}
+
+#endif
+
+} // namespace
+
 //------------------------------------------------------------------------------
 /// X11 color names (https://en.wikipedia.org/wiki/X11_color_names)
 ///
@@ -170,6 +247,10 @@ const int max_nest          = 4;
 static int s_nest = 0;
 #pragma omp threadprivate( s_nest )
 
+// Step of this thread, set by Step, or -1.
+static int64_t s_step = -1;
+#pragma omp threadprivate( s_step )
+
 int Trace::width_  = 0;
 int Trace::height_ = 0;
 
@@ -178,6 +259,24 @@ double Trace::hscale_ = 100;
 
 bool Trace::tracing_ = false;
 int Trace::num_threads_ = omp_get_max_threads();
+int Trace::num_rows_ = 0;
+Format Trace::format_ = Format::SVG;
+int64_t Trace::capacity_ = 1 << 16;
+
+bool Trace::sampling_ = false;
+int64_t Trace::sample_first_ = 0;
+int64_t Trace::sample_last_ = 0;
+int64_t Trace::sample_every_ = 1;
+std::atomic<int> Trace::active_sampled_( 0 );
+
+std::vector<std::vector<DeviceEvent>> Trace::device_events_(
+    omp_get_max_threads() );
+std::vector<void*> Trace::device_ref_events_;
+std::vector<double> Trace::device_ref_times_;
+
+std::vector<ThreadEvents> Trace::buffers_;
+std::vector<std::string> Trace::names_;
+std::map<std::string, int> Trace::name_ids_;
 
 std::string comment_;
 
@@ -258,9 +357,29 @@ std::map<std::string, Color> function_color_ = {
 //------------------------------------------------------------------------------
 /// Create a block, which marks the beginning of an event in the trace.
 ///
+/// If tracing is off, this only counts the nesting depth.
+///
+/// @param[in] name
+///     Name of the event; must be a string literal or otherwise stay
+///     unchanged at the same address for the whole run (@see Trace::intern).
+///
 Block::Block( const char* name, int64_t index )
-    : event_( name, index, s_nest++ )
-{}
+{
+    int nest = s_nest++;
+    if (Trace::tracing_)
+        event_ = Event( Trace::intern( name ), index, nest );
+}
+
+//------------------------------------------------------------------------------
+/// Create a block for an operation on tile (i, j) that moves bytes,
+/// e.g., a tile broadcast. These are written as args in JSON traces.
+///
+Block::Block( const char* name, int64_t i, int64_t j, int64_t bytes )
+{
+    int nest = s_nest++;
+    if (Trace::tracing_)
+        event_ = Event( Trace::intern( name ), 0, nest, i, j, bytes );
+}
 
 //------------------------------------------------------------------------------
 /// Destroy a block, which marks the end of an event in the trace.
@@ -268,17 +387,369 @@ Block::Block( const char* name, int64_t index )
 Block::~Block()
 {
     s_nest--;
-    Trace::insert( event_ );
+    if (event_.name_id_ >= 0)
+        Trace::insert( event_ );
+}
+
+//------------------------------------------------------------------------------
+/// Starts step k on this thread. Nested Steps restore the outer step.
+///
+Step::Step( int64_t k )
+    : prev_( s_step ),
+      counted_( Trace::tracing_ && Trace::sampling_
+                && Trace::stepSampled( k ) )
+{
+    s_step = k;
+    if (counted_)
+        ++Trace::active_sampled_;
+}
+
+//------------------------------------------------------------------------------
+/// Ends the step on this thread.
+///
+Step::~Step()
+{
+    s_step = prev_;
+    if (counted_)
+        --Trace::active_sampled_;
+}
+
+//------------------------------------------------------------------------------
+/// Create a device block, which records an event on queue before the
+/// device work that follows is launched.
+///
+/// @param[in] name
+///     Name of the event, as for Block.
+///
+/// @param[in] queue
+///     Queue the work is launched on.
+///
+/// @param[in] queue_index
+///     Index of queue among the compute queues of its device.
+///
+/// @param[in] batch_count
+///     Number of operations in the batch.
+///
+DeviceBlock::DeviceBlock(
+    const char* name, blas::Queue& queue, int queue_index,
+    int64_t batch_count )
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    if (Trace::tracing_
+        && queue.device() < int( Trace::device_ref_events_.size() )) {
+        name_id_ = Trace::intern( name );
+        queue_index_ = queue_index;
+        batch_count_ = batch_count;
+        start_ = event_record( queue.device(), queue.stream() );
+        queue_ = &queue;
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Destroy a device block, which records an event on the queue after the
+/// device work was launched. Both events are timed by Trace::finish.
+///
+DeviceBlock::~DeviceBlock()
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    if (queue_ != nullptr) {
+        void* stop = event_record( queue_->device(), queue_->stream() );
+        Trace::device_events_[ omp_get_thread_num() ].push_back(
+            { start_, stop, queue_->device(), queue_index_, name_id_,
+              batch_count_ } );
+    }
+#endif
 }
 
 //------------------------------------------------------------------------------
+/// Enables tracing. The first call allocates a ring buffer of capacity()
+/// events per thread, so recording events never allocates.
 ///
-void Trace::insert(Event event)
+void Trace::on()
+{
+    if (buffers_.empty()) {
+        // Round capacity up to a power of 2, so insert can mask the index.
+        int64_t capacity = 1;
+        while (capacity < capacity_)
+            capacity *= 2;
+        capacity_ = capacity;
+
+        buffers_ = std::vector<ThreadEvents>( num_threads_ );
+        for (auto& buffer : buffers_)
+            buffer.events.resize( capacity_ );
+    }
+
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    // Reference event on each device, at a known host time;
+    // device event times are relative to it.
+    if (device_ref_events_.empty()) {
+        int num_devices = blas::get_device_count();
+        for (int device = 0; device < num_devices; ++device) {
+            void* ref = event_record( device, 0 );
+            event_elapsed( ref, ref );  // waits for ref
+            device_ref_times_.push_back( now() );
+            device_ref_events_.push_back( ref );
+        }
+    }
+#endif
+    tracing_ = true;
+}
+
+//------------------------------------------------------------------------------
+/// Records a finished event in this thread's ring buffer, overwriting the
+/// oldest event if it is full. No locks or allocation.
+///
+void Trace::insert(Event const& event)
 {
     if (tracing_) {
-        event.stop();
-        events_[omp_get_thread_num()].push_back(event);
+        ThreadEvents& buffer = buffers_[ omp_get_thread_num() ];
+        if (! sampled()) {
+            aggregate( buffer, event.name_id_, now() - event.start_ );
+            return;
+        }
+        int64_t mask = buffer.events.size() - 1;
+        Event& slot = buffer.events[ buffer.count & mask ];
+        if (buffer.count > mask)
+            aggregate( buffer, slot.name_id_, slot.stop_ - slot.start_ );
+        slot = event;
+        slot.stop();
+        ++buffer.count;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Traces only steps k, set by Step, with first <= k <= last and
+/// (k - first) divisible by every, e.g., sampleSteps( 0, INT64_MAX, 10 )
+/// traces every 10th panel. Other steps' events are aggregated.
+/// sampleAll() turns sampling off, which is the default.
+///
+void Trace::sampleSteps(int64_t first, int64_t last, int64_t every)
+{
+    sample_first_ = first;
+    sample_last_  = last;
+    sample_every_ = std::max( every, int64_t( 1 ) );
+    sampling_ = true;
+}
+
+//------------------------------------------------------------------------------
+/// Returns whether step k is traced.
+///
+bool Trace::stepSampled(int64_t k)
+{
+    return ! sampling_
+           || (sample_first_ <= k && k <= sample_last_
+               && (k - sample_first_) % sample_every_ == 0);
+}
+
+//------------------------------------------------------------------------------
+/// Returns whether events on this thread are traced now: in a sampled
+/// step, or outside any step while a sampled step runs.
+///
+bool Trace::sampled()
+{
+    if (! sampling_)
+        return true;
+    if (s_step >= 0)
+        return stepSampled( s_step );
+    return active_sampled_ > 0;
+}
+
+//------------------------------------------------------------------------------
+/// Adds an event of seconds to the aggregates of this thread.
+/// Allocates only for the first event of a name on each thread.
+///
+void Trace::aggregate(ThreadEvents& buffer, int name_id, double seconds)
+{
+    if (name_id >= int( buffer.stats.size() ))
+        buffer.stats.resize( name_id + 1 );
+    buffer.stats[ name_id ].add( seconds );
+}
+
+//------------------------------------------------------------------------------
+/// Returns the aggregates of events not in the trace, summed over threads,
+/// by name.
+///
+std::map<std::string, EventStats> Trace::aggregated()
+{
+    std::map<std::string, EventStats> stats;
+    for (auto& buffer : buffers_) {
+        for (size_t id = 0; id < buffer.stats.size(); ++id) {
+            if (buffer.stats[ id ].count > 0)
+                stats[ names_[ id ] ] += buffer.stats[ id ];
+        }
     }
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Prints the aggregates of events not in the trace: count, total, min,
+/// mean, and max time, and the nonzero histogram bins as
+/// "<upper bound in us>:count".
+///
+void Trace::printAggregated(FILE* file)
+{
+    auto stats = aggregated();
+    if (stats.empty())
+        return;
+
+    fprintf( file, "trace: events not in the trace (not sampled or"
+             " overwritten), on rank 0:\n"
+             "%-32s  %10s  %10s  %10s  %10s  %10s  histogram (us)\n",
+             "name", "count", "total", "min", "mean", "max" );
+    for (auto const& iter : stats) {
+        EventStats const& stat = iter.second;
+        fprintf( file, "%-32s  %10lld  %10.4f  %10.6f  %10.6f  %10.6f ",
+                 iter.first.c_str(), (long long) stat.count, stat.total,
+                 stat.min, stat.total / stat.count, stat.max );
+        for (int b = 0; b < EventStats::num_bins; ++b) {
+            if (stat.bins[ b ] > 0)
+                fprintf( file, " %lld:%lld", 1LL << b, (long long) stat.bins[ b ] );
+        }
+        fprintf( file, "\n" );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Adds an event of seconds.
+///
+void EventStats::add( double seconds )
+{
+    count += 1;
+    total += seconds;
+    min = std::min( min, seconds );
+    max = std::max( max, seconds );
+
+    // Bin b holds [ 2^(b-1), 2^b ) us.
+    double us = seconds * 1e6;
+    int b = 0;
+    while (b < num_bins - 1 && us >= double( 1LL << b ))
+        ++b;
+    bins[ b ] += 1;
+}
+
+//------------------------------------------------------------------------------
+/// Adds other's events.
+///
+EventStats& EventStats::operator += ( EventStats const& other )
+{
+    count += other.count;
+    total += other.total;
+    min = std::min( min, other.min );
+    max = std::max( max, other.max );
+    for (int b = 0; b < num_bins; ++b)
+        bins[ b ] += other.bins[ b ];
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+/// Returns the id of name in the table of event names, adding it if needed.
+/// Each thread caches ids by the address of name, so only the first use
+/// of each name on a thread takes a lock; name must stay unchanged at the
+/// same address, as string literals do.
+///
+int Trace::intern(const char* name)
+{
+    thread_local std::unordered_map<const char*, int> cache;
+    auto iter = cache.find( name );
+    if (iter != cache.end())
+        return iter->second;
+
+    int id = internString( name );
+    cache[ name ] = id;
+    return id;
+}
+
+//------------------------------------------------------------------------------
+/// Returns the id of name in the table of event names, adding it if needed.
+///
+int Trace::internString(std::string const& name)
+{
+    int id;
+    #pragma omp critical(slate_trace)
+    {
+        auto iter = name_ids_.find( name );
+        if (iter != name_ids_.end()) {
+            id = iter->second;
+        }
+        else {
+            id = names_.size();
+            names_.push_back( name );
+            name_ids_[ name ] = id;
+        }
+    }
+    return id;
+}
+
+//------------------------------------------------------------------------------
+/// Copies each thread's events, oldest first, from its ring buffer into
+/// events_, and empties the ring buffers. Then times the device events
+/// and adds them in one row per device, after the thread rows.
+///
+void Trace::collectEvents()
+{
+    int num_devices = device_ref_events_.size();
+    events_.resize( num_threads_ + num_devices );
+    num_rows_ = events_.size();
+
+    int64_t dropped = 0;
+    for (int thread = 0; thread < num_threads_; ++thread) {
+        auto& events = events_[ thread ];
+        events.clear();
+        if (buffers_.empty())
+            continue;
+
+        ThreadEvents& buffer = buffers_[ thread ];
+        int64_t capacity = buffer.events.size();
+        int64_t begin = std::max( buffer.count - capacity, int64_t( 0 ) );
+        for (int64_t k = begin; k < buffer.count; ++k)
+            events.push_back( buffer.events[ k & (capacity - 1) ] );
+        dropped += begin;
+        buffer.count = 0;
+    }
+    if (dropped > 0) {
+        fprintf( stderr, "trace: %lld oldest events overwritten and"
+                 " aggregated; increase Trace::capacity to keep them\n",
+                 (long long) dropped );
+    }
+
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    for (int device = 0; device < num_devices; ++device)
+        events_[ num_threads_ + device ].clear();
+
+    for (auto& thread_events : device_events_) {
+        for (auto& device_event : thread_events) {
+            int device = device_event.device;
+            void* ref = device_ref_events_[ device ];
+            double ref_time = device_ref_times_[ device ];
+
+            Event event;
+            event.start_ = ref_time + event_elapsed( ref, device_event.start );
+            event.stop_  = ref_time + event_elapsed( ref, device_event.stop );
+            event.index_ = device_event.batch_count;
+            event.i_ = -1;
+            event.j_ = -1;
+            event.bytes_ = 0;
+            event.name_id_ = device_event.name_id;
+            event.nest_ = 0;
+            event.queue_ = device_event.queue;
+            events_[ num_threads_ + device ].push_back( event );
+
+            event_destroy( device_event.start );
+            event_destroy( device_event.stop );
+        }
+        thread_events.clear();
+    }
+
+    // Launches from several threads interleave; order each row by time.
+    for (int device = 0; device < num_devices; ++device) {
+        auto& row = events_[ num_threads_ + device ];
+        std::sort( row.begin(), row.end(),
+                   [](Event const& a, Event const& b) {
+                       return a.start_ < b.start_;
+                   } );
+    }
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -355,8 +826,58 @@ const char* gradient =
 "</linearGradient>\n";
 
 //------------------------------------------------------------------------------
+/// Returns str with quotes, backslashes, and control characters escaped,
+/// to be suitable as a JSON string.
+///
+std::string jsonEscape(std::string const& str)
+{
+    std::string escaped;
+    for (char ch : str) {
+        if (ch == '"' || ch == '\\') {
+            escaped += '\\';
+            escaped += ch;
+        }
+        else if (ch == '\n')
+            escaped += "\\n";
+        else if (static_cast<unsigned char>(ch) < 0x20)
+            escaped += ' ';
+        else
+            escaped += ch;
+    }
+    return escaped;
+}
+
+//------------------------------------------------------------------------------
+/// Writes the trace file in the format set by format(), prints the
+/// aggregates of events not in it on rank 0, then clears events.
+/// Collective over MPI_COMM_WORLD.
 ///
 void Trace::finish()
+{
+    collectEvents();
+
+    if (format_ == Format::JSON)
+        finishJSON();
+    else
+        finishSVG();
+
+    int mpi_rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    if (mpi_rank == 0)
+        printAggregated( stderr );
+
+    // Clear events and aggregates.
+    for (auto& thread : events_)
+        thread.clear();
+    for (auto& buffer : buffers_)
+        buffer.stats.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Writes one trace_<time>.svg on rank 0, receiving each rank's events
+/// in turn.
+///
+void Trace::finishSVG()
 {
     // Find rank and size.
     int mpi_rank;
@@ -374,7 +895,11 @@ void Trace::finish()
 
     // Compute width and vertical scaling factor.
     width_ = hscale_ * timespan;
-    height_ = vscale_ * (mpi_size * (num_threads_ + 1) - 1);
+    // Rows per rank: threads, then devices.
+    int max_rows;
+    MPI_Allreduce(&num_rows_, &max_rows, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    num_rows_ = max_rows;
+    height_ = vscale_ * (mpi_size * (num_rows_ + 1) - 1);
 
     // Print header.
     if (mpi_rank == 0) {
@@ -397,7 +922,7 @@ void Trace::finish()
         std::set<std::string> legend_set;
         for (auto& thread : events_)
             for (auto& event : thread)
-                legend_set.insert(event.name_);
+                legend_set.insert(name(event));
         h = std::max(h, int(legend_set.size() * 2 * legend_space_));
 
         fprintf(trace_file, header,
@@ -447,10 +972,136 @@ void Trace::finish()
         fclose(trace_file);
         fprintf(stderr, "trace file: %s\n", file_name.c_str());
     }
+}
 
-    // Clear events.
+//------------------------------------------------------------------------------
+/// Writes one trace_<time>.json in Chrome trace format, which Perfetto
+/// (ui.perfetto.dev) and chrome://tracing read, with one process per rank
+/// and one thread per OpenMP thread. Each rank formats its own events,
+/// and all ranks write them at their offsets with one collective MPI-IO
+/// write, so events are never gathered to rank 0.
+///
+/// Times are aligned across ranks at the barrier at the start of finish.
+/// Events have args index and, if set, tile indices i, j and bytes.
+/// Device events, in a thread per device, have args queue and batch_count.
+///
+void Trace::finishJSON()
+{
+    using llong = long long;
+
+    int mpi_rank;
+    int mpi_size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    // Times are in microseconds from the earliest event on any rank,
+    // counted back from the barrier.
+    double time_end = omp_get_wtime();
+    double span = 0;
     for (auto& thread : events_)
-        thread.clear();
+        for (auto& event : thread)
+            span = std::max(span, time_end - event.start_);
+    double max_span;
+    MPI_Allreduce(&span, &max_span, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    double time_begin = time_end - max_span;
+
+    // All ranks use rank 0's file name.
+    llong stamp = time(nullptr);
+#ifndef SLATE_NO_MPI
+    MPI_Bcast(&stamp, 1, MPI_LONG_LONG, 0, MPI_COMM_WORLD);
+#endif
+    std::string file_name("trace_" + std::to_string(stamp) + ".json");
+
+    // Format this rank's entries. All but rank 0's first start with a
+    // comma, so the ranks' pieces concatenate into one JSON array.
+    std::string buffer;
+    char line[256];
+    if (mpi_rank == 0) {
+        buffer += "{\"otherData\": {\"comment\": \"" + jsonEscape(comment_)
+                + "\"},\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n";
+    }
+    else {
+        buffer += ",\n";
+    }
+    snprintf(line, sizeof(line),
+             "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, "
+             "\"args\": {\"name\": \"rank %d\"}}",
+             mpi_rank, mpi_rank);
+    buffer += line;
+
+    // Rows after the threads are devices.
+    int num_rows = events_.size();
+    for (int row = num_threads_; row < num_rows; ++row) {
+        snprintf(line, sizeof(line),
+                 ",\n{\"name\": \"thread_name\", \"ph\": \"M\", "
+                 "\"pid\": %d, \"tid\": %d, "
+                 "\"args\": {\"name\": \"device %d\"}}",
+                 mpi_rank, row, row - num_threads_);
+        buffer += line;
+    }
+
+    for (int thread = 0; thread < num_rows; ++thread) {
+        for (auto& event : events_[thread]) {
+            snprintf(line, sizeof(line),
+                     ",\n{\"name\": \"%s\", \"ph\": \"X\", "
+                     "\"pid\": %d, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, ",
+                     jsonEscape(name(event)).c_str(), mpi_rank, thread,
+                     (event.start_ - time_begin) * 1e6,
+                     (event.stop_ - event.start_) * 1e6);
+            buffer += line;
+            if (event.queue_ >= 0) {
+                snprintf(line, sizeof(line),
+                         "\"args\": {\"queue\": %d, \"batch_count\": %lld",
+                         event.queue_, llong( event.index_ ));
+            }
+            else {
+                snprintf(line, sizeof(line), "\"args\": {\"index\": %lld",
+                         llong( event.index_ ));
+            }
+            buffer += line;
+            if (event.i_ >= 0) {
+                snprintf(line, sizeof(line), ", \"i\": %lld, \"j\": %lld",
+                         llong( event.i_ ), llong( event.j_ ));
+                buffer += line;
+            }
+            if (event.bytes_ > 0) {
+                snprintf(line, sizeof(line), ", \"bytes\": %lld",
+                         llong( event.bytes_ ));
+                buffer += line;
+            }
+            buffer += "}}";
+        }
+    }
+    if (mpi_rank == mpi_size - 1)
+        buffer += "\n]}\n";
+
+#ifdef SLATE_NO_MPI
+    FILE* file = fopen(file_name.c_str(), "w");
+    if (file != nullptr) {
+        fwrite(buffer.data(), 1, buffer.size(), file);
+        fclose(file);
+    }
+#else
+    // Each rank writes at the sum of the sizes of lower ranks.
+    llong size = buffer.size();
+    llong offset = 0;
+    MPI_Exscan(&size, &offset, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    if (mpi_rank == 0)
+        offset = 0;  // Exscan leaves rank 0's result undefined.
+    assert(size <= std::numeric_limits<int>::max());
+
+    MPI_File file;
+    MPI_File_open(MPI_COMM_WORLD, file_name.c_str(),
+                  MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file);
+    MPI_File_set_size(file, 0);
+    MPI_File_write_at_all(file, offset, buffer.data(), int(size), MPI_CHAR,
+                          MPI_STATUS_IGNORE);
+    MPI_File_close(&file);
+#endif
+
+    if (mpi_rank == 0)
+        fprintf(stderr, "trace file: %s\n", file_name.c_str());
 }
 
 //------------------------------------------------------------------------------
@@ -482,7 +1133,7 @@ double Trace::getTimeSpan()
 void Trace::printProcEvents(int mpi_rank, int mpi_size,
                             double timespan, FILE* trace_file)
 {
-    double y = mpi_rank * (num_threads_ + 1) * vscale_;
+    double y = mpi_rank * (num_rows_ + 1) * vscale_;
     double height = 0.9 * vscale_ / max_nest;
     using llong = long long;
 
@@ -496,15 +1147,22 @@ void Trace::printProcEvents(int mpi_rank, int mpi_size,
                     double x = (event.start_ - events_[0][0].stop_) * hscale_;
                     double width = (event.stop_ - event.start_) * hscale_;
 
+                    // Tile indices, if set, are part of the label.
+                    char ij[64] = "";
+                    if (event.i_ >= 0) {
+                        snprintf(ij, sizeof(ij), " (%lld, %lld)",
+                                 llong( event.i_ ), llong( event.j_ ));
+                    }
+
                     fprintf(trace_file,
                             "<rect x=\"%.4f\" y=\"%.0f\" "
                             "width=\"%.4f\" height=\"%.0f\" "
                             "class=\"%s\" "
-                            "inkscape:label=\"%s %lld\"/>\n",
+                            "inkscape:label=\"%s %lld%s\"/>\n",
                             x, y,
                             width, h,
-                            cleanName(event.name_).c_str(),
-                            event.name_, llong( event.index_ ));
+                            cleanName(name(event)).c_str(),
+                            name(event), llong( event.index_ ), ij);
                 }
             }
         }
@@ -576,7 +1234,7 @@ void Trace::printLegend(FILE* trace_file)
     // Build the set of labels.
     for (auto& thread : events_)
         for (auto& event : thread)
-            legend_set.insert(event.name_);
+            legend_set.insert(name(event));
 
     // Convert the set to a vector.
     std::vector<std::string> legend_vec(legend_set.begin(), legend_set.end());
@@ -609,7 +1267,24 @@ void Trace::printLegend(FILE* trace_file)
 ///
 void Trace::sendProcEvents()
 {
-    for (int thread = 0; thread < num_threads_; ++thread) {
+    // Send the names, '\0' terminated, since ids are local to each rank.
+    std::string table;
+    for (auto& name : names_) {
+        table += name;
+        table += '\0';
+    }
+    long int table_size = table.size();
+    MPI_Send(&table_size, 1, MPI_LONG,
+             0, 0, MPI_COMM_WORLD);
+    MPI_Send(table.data(), table_size, MPI_CHAR,
+             0, 0, MPI_COMM_WORLD);
+
+    // Send the number of rows, for threads and devices.
+    int num_rows = events_.size();
+    MPI_Send(&num_rows, 1, MPI_INT,
+             0, 0, MPI_COMM_WORLD);
+
+    for (int thread = 0; thread < num_rows; ++thread) {
 
         // Send the number of events.
         long int num_events = events_[thread].size();
@@ -626,7 +1301,26 @@ void Trace::sendProcEvents()
 ///
 void Trace::recvProcEvents(int rank)
 {
-    for (int thread = 0; thread < num_threads_; ++thread) {
+    // Receive the names, and map the sender's ids to ids on this rank.
+    long int table_size;
+    MPI_Recv(&table_size, 1, MPI_LONG,
+             rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    std::string table(table_size, '\0');
+    MPI_Recv(&table[0], table_size, MPI_CHAR,
+             rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    std::vector<int> ids;
+    for (size_t begin = 0; begin < table.size(); ) {
+        size_t end = table.find('\0', begin);
+        ids.push_back(internString(table.substr(begin, end - begin)));
+        begin = end + 1;
+    }
+
+    int num_rows;
+    MPI_Recv(&num_rows, 1, MPI_INT,
+             rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    events_.resize(num_rows);
+
+    for (int thread = 0; thread < num_rows; ++thread) {
 
         // Receive the number of events.
         long int num_events;
@@ -637,6 +1331,8 @@ void Trace::recvProcEvents(int rank)
         events_[thread].resize(num_events);
         MPI_Recv(&events_[thread][0], sizeof(Event)*num_events, MPI_BYTE,
                  rank, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        for (auto& event : events_[thread])
+            event.name_id_ = ids[event.name_id_];
     }
 }
 
@@ -0,0 +1,301 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Computes the singular values and singular vectors of a real upper
+/// bidiagonal matrix $B = U \Sigma V^T$ in parallel, using the divide and
+/// conquer tridiagonal eigensolver stedc.
+///
+/// The eigenvalues of the 2n-by-2n Golub-Kahan tridiagonal matrix, with
+/// zero diagonal and off-diagonal $d_1, e_1, d_2, e_2, \dots, d_n$, are
+/// $\pm\sigma_i$, and the eigenvector of $\sigma_i$ is
+/// $[ v_1, u_1, v_2, u_2, \dots, v_n, u_n ] / \sqrt{2}$, as in LAPACK bdsvdx.
+/// Its eigenvectors are computed by stedc, distributed like U; then the
+/// n eigenvectors of the positive eigenvalues are split into U and V^T,
+/// with one all-to-all exchange.
+///
+/// Eigenvectors of a pair $\pm\sigma$ that are numerically equal mix, which
+/// changes only the norms of the u and v parts, so each part is normalized.
+/// If a part is too small to normalize, or if several singular values
+/// are negligible, so the eigenvectors of different pairs can mix, the
+/// vectors can't be separated reliably. Then it returns info > 0, leaving
+/// D and E unchanged, and the caller should use bdsqr instead.
+///
+//------------------------------------------------------------------------------
+/// @tparam real_t
+///     One of float, double.
+//------------------------------------------------------------------------------
+/// @param[in,out] D
+///     On entry, the diagonal of B, of length n.
+///     On exit, if info = 0, the singular values of B in descending order.
+///     D is duplicated on all MPI ranks.
+///
+/// @param[in] E
+///     The superdiagonal of B, of length n-1.
+///     E is duplicated on all MPI ranks.
+///
+/// @param[out] U
+///     The n-by-n matrix U. On exit, if info = 0, the left singular vectors.
+///     U must have a 2D block-cyclic distribution, with column-major grid
+///     order, and fixed tile size nb.
+///
+/// @param[out] VT
+///     The n-by-n matrix V^T. On exit, if info = 0, the right singular
+///     vectors, by rows. VT must have fixed tile size nb, like U.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target, as for stedc.
+///
+/// @return 0: successful exit.
+/// @return 1: the singular vectors could not be separated; use bdsqr.
+///
+/// @ingroup svd_computational
+///
+template <typename real_t>
+int64_t bdsdc(
+    std::vector<real_t>& D,
+    std::vector<real_t> const& E,
+    Matrix<real_t>& U,
+    Matrix<real_t>& VT,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::bdsdc");
+
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const real_t sqrt2 = std::sqrt( real_t( 2 ) );
+    const auto mpi_real_type = mpi_type<real_t>::value;
+
+    int64_t n = D.size();
+    if (n == 0)
+        return 0;
+    int64_t n2 = 2*n;
+    int64_t nb = U.tileNb( 0 );  // assume fixed
+    slate_assert( VT.tileNb( 0 ) == nb );
+
+    GridOrder grid_order;
+    int nprow, npcol, myrow, mycol;
+    U.gridinfo( &grid_order, &nprow, &npcol, &myrow, &mycol );
+    slate_assert( nprow > 0 );  // require 2D block-cyclic
+    slate_assert( grid_order == GridOrder::Col );
+
+    MPI_Comm mpi_comm = U.mpiComm();
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size( mpi_comm, &mpi_size ) );
+
+    // Golub-Kahan tridiagonal matrix.
+    std::vector<real_t> Dtgk( n2, 0 ), Etgk( n2-1 );
+    for (int64_t i = 0; i < n; ++i) {
+        Etgk[ 2*i ] = D[ i ];
+        if (i < n-1)
+            Etgk[ 2*i+1 ] = E[ i ];
+    }
+
+    Matrix<real_t> Z( n2, n2, nb, nprow, npcol, mpi_comm );
+    Z.insertLocalTiles();
+    stedc( Dtgk, Etgk, Z, opts );
+
+    // Singular values are the n largest eigenvalues, in descending order.
+    // Several negligible ones can't be told apart from their negatives.
+    real_t sigma_max = std::abs( Dtgk[ n2-1 ] );
+    int64_t negligible = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        if (std::abs( Dtgk[ n2-1-i ] ) <= n2 * eps * sigma_max)
+            ++negligible;
+    }
+    if (negligible > 1)
+        return 1;
+
+    // Vector i is column c = 2n-1-i of Z. Its row r = 2j is V^T( i, j ),
+    // and row 2j+1 is U( j, i ). Elements are sent to each rank in order
+    // of (i, r), which both sides enumerate from their own tiles.
+    Z.tileGetAllForReading( HostNum, LayoutConvert::ColMajor );
+    U.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    VT.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+
+    auto dest_rank = [&]( int64_t r, int64_t i ) {
+        int64_t j = r / 2;
+        return r % 2 == 0 ? VT.tileRank( i / nb, j / nb )
+                          : U.tileRank( j / nb, i / nb );
+    };
+    auto src_rank = [&]( int64_t r, int64_t i ) {
+        return Z.tileRank( r / nb, (n2-1-i) / nb );
+    };
+
+    // Loops over this rank's elements of Z, in order of (i, r).
+    auto for_each_send = [&]( auto&& fn ) {
+        for (int64_t jt = Z.nt()-1; jt >= n / nb; --jt) {
+            std::vector< Tile<real_t> > tiles;
+            std::vector< int64_t > rows;
+            for (int64_t it = 0; it < Z.mt(); ++it) {
+                if (Z.tileIsLocal( it, jt )) {
+                    tiles.push_back( Z( it, jt ) );
+                    rows.push_back( it*nb );
+                }
+            }
+            int64_t c_begin = std::max( jt*nb, n );
+            int64_t c_end   = std::min( (jt+1)*nb, n2 );
+            for (int64_t c = c_end-1; c >= c_begin; --c) {
+                int64_t i = n2-1-c;
+                for (size_t k = 0; k < tiles.size(); ++k) {
+                    auto& T = tiles[ k ];
+                    for (int64_t ii = 0; ii < T.mb(); ++ii) {
+                        int64_t r = rows[ k ] + ii;
+                        fn( dest_rank( r, i ), T( ii, c - jt*nb ) );
+                    }
+                }
+            }
+        }
+    };
+
+    // Loops over this rank's elements of V^T and U, in order of (i, r).
+    auto for_each_recv = [&]( auto&& fn ) {
+        for (int64_t ti = 0; ti < U.nt(); ++ti) {
+            // Block columns j of U( :, i ) and V^T( i, : ), if local.
+            std::vector< Tile<real_t> > u_tiles( U.mt() ), v_tiles( U.mt() );
+            std::vector< uint8_t > u_local( U.mt() ), v_local( U.mt() );
+            for (int64_t tj = 0; tj < U.mt(); ++tj) {
+                u_local[ tj ] = U.tileIsLocal( tj, ti );
+                v_local[ tj ] = VT.tileIsLocal( ti, tj );
+                if (u_local[ tj ])
+                    u_tiles[ tj ] = U( tj, ti );
+                if (v_local[ tj ])
+                    v_tiles[ tj ] = VT( ti, tj );
+            }
+            int64_t ib = std::min( nb, n - ti*nb );
+            for (int64_t ii = 0; ii < ib; ++ii) {
+                int64_t i = ti*nb + ii;
+                for (int64_t tj = 0; tj < U.mt(); ++tj) {
+                    if (! u_local[ tj ] && ! v_local[ tj ])
+                        continue;
+                    int64_t jb = std::min( nb, n - tj*nb );
+                    for (int64_t jj = 0; jj < jb; ++jj) {
+                        int64_t j = tj*nb + jj;
+                        if (v_local[ tj ]) {
+                            fn( src_rank( 2*j, i ),
+                                &v_tiles[ tj ].at( ii, jj ) );
+                        }
+                        if (u_local[ tj ]) {
+                            fn( src_rank( 2*j+1, i ),
+                                &u_tiles[ tj ].at( jj, ii ) );
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<int> send_counts( mpi_size, 0 ), send_displs( mpi_size );
+    std::vector<int> recv_counts( mpi_size, 0 ), recv_displs( mpi_size );
+    for_each_send( [&]( int dest, real_t ) { ++send_counts[ dest ]; } );
+    for_each_recv( [&]( int src, real_t* ) { ++recv_counts[ src ]; } );
+    int send_total = 0, recv_total = 0;
+    for (int r = 0; r < mpi_size; ++r) {
+        send_displs[ r ] = send_total;
+        recv_displs[ r ] = recv_total;
+        send_total += send_counts[ r ];
+        recv_total += recv_counts[ r ];
+    }
+
+    std::vector<real_t> send_buffer( send_total ), recv_buffer( recv_total );
+    std::vector<int> offset = send_displs;
+    for_each_send( [&]( int dest, real_t value ) {
+        send_buffer[ offset[ dest ]++ ] = sqrt2 * value;
+    } );
+    slate_mpi_call(
+        MPI_Alltoallv( send_buffer.data(), send_counts.data(),
+                       send_displs.data(), mpi_real_type,
+                       recv_buffer.data(), recv_counts.data(),
+                       recv_displs.data(), mpi_real_type, mpi_comm ) );
+    offset = recv_displs;
+    for_each_recv( [&]( int src, real_t* dst ) {
+        *dst = recv_buffer[ offset[ src ]++ ];
+    } );
+
+    // Norms of the u and v parts of each vector, ideally 1.
+    std::vector<real_t> norms( 2*n, 0 );
+    for (int64_t tj = 0; tj < U.nt(); ++tj) {
+        for (int64_t ti = 0; ti < U.mt(); ++ti) {
+            if (U.tileIsLocal( ti, tj )) {
+                auto T = U( ti, tj );
+                for (int64_t jj = 0; jj < T.nb(); ++jj) {
+                    int64_t i = tj*nb + jj;
+                    for (int64_t k = 0; k < T.mb(); ++k)
+                        norms[ i ] += T( k, jj ) * T( k, jj );
+                }
+            }
+            if (VT.tileIsLocal( tj, ti )) {
+                auto T = VT( tj, ti );
+                for (int64_t k = 0; k < T.nb(); ++k) {
+                    for (int64_t jj = 0; jj < T.mb(); ++jj) {
+                        int64_t i = tj*nb + jj;
+                        norms[ n + i ] += T( jj, k ) * T( jj, k );
+                    }
+                }
+            }
+        }
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, norms.data(), 2*n, mpi_real_type,
+                       MPI_SUM, mpi_comm ) );
+    for (int64_t i = 0; i < 2*n; ++i) {
+        norms[ i ] = std::sqrt( norms[ i ] );
+        if (norms[ i ] < 0.5)
+            return 1;
+    }
+
+    for (int64_t tj = 0; tj < U.nt(); ++tj) {
+        for (int64_t ti = 0; ti < U.mt(); ++ti) {
+            if (U.tileIsLocal( ti, tj )) {
+                auto T = U( ti, tj );
+                for (int64_t jj = 0; jj < T.nb(); ++jj) {
+                    real_t s = 1 / norms[ tj*nb + jj ];
+                    blas::scal( T.mb(), s, &T.at( 0, jj ), 1 );
+                }
+            }
+            if (VT.tileIsLocal( tj, ti )) {
+                auto T = VT( tj, ti );
+                for (int64_t jj = 0; jj < T.mb(); ++jj) {
+                    real_t s = 1 / norms[ n + tj*nb + jj ];
+                    blas::scal( T.nb(), s, &T.at( jj, 0 ), T.stride() );
+                }
+            }
+        }
+    }
+
+    for (int64_t i = 0; i < n; ++i)
+        D[ i ] = std::abs( Dtgk[ n2-1-i ] );
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t bdsdc<float>(
+    std::vector<float>& D,
+    std::vector<float> const& E,
+    Matrix<float>& U,
+    Matrix<float>& VT,
+    Options const& opts);
+
+template
+int64_t bdsdc<double>(
+    std::vector<double>& D,
+    std::vector<double> const& E,
+    Matrix<double>& U,
+    Matrix<double>& VT,
+    Options const& opts);
+
+} // namespace slate
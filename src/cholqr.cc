@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
 
 #include <list>
 #include <tuple>
@@ -94,6 +95,182 @@ void cholqr(
     trsm( Side::Right, one, U, A, opts );
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Multi-pass Cholesky QR, with the Gram matrix replicated on all ranks:
+/// CholeskyQR2 if passes is 2, shifted CholeskyQR3 if passes is 3.
+///
+/// Each pass forms the n-by-n Gram matrix $G = A^H A$ and reduces it with
+/// one MPI_Allreduce, then every rank factors it with LAPACK potrf, instead
+/// of a distributed potrf on a small HermitianMatrix. If each block row of
+/// A is on one rank, as for 1D tall-skinny distributions, the Gram matrix
+/// is summed directly from local tiles; otherwise it is formed with the
+/// product selected by Option::MethodCholQR and replicated.
+/// Then $A = A R_k^{-1}$ with a distributed trsm, and $R = R_k R$.
+///
+/// The second pass of CholeskyQR2 restores orthogonality to
+/// $O(\epsilon)$ for $\kappa(A)$ up to about $\epsilon^{-1/2}$.
+/// Shifted CholeskyQR3 first factors $G + s I$, with
+/// $s = 11 (m n + n (n+1)) \epsilon \norm{A}_F^2$, which cannot break down
+/// for $\kappa(A)$ up to about $\epsilon^{-1}$, then does CholeskyQR2.
+///
+/// @ingroup geqrf_specialization
+///
+template <Target target, typename scalar_t>
+void cholqr_gram(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& R,
+    int64_t passes,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one  = 1.0;
+    const scalar_t zero = 0.0;
+    const Layout layout = Layout::ColMajor;
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    auto col_offset = internal::tile_offsets( RowCol::Col, A );
+
+    // Block rows entirely on one rank allow a local Gram matrix.
+    bool rows_local = true;
+    for (int64_t i = 0; i < mt && rows_local; ++i) {
+        for (int64_t k = 1; k < nt; ++k) {
+            if (A.tileRank( i, k ) != A.tileRank( i, 0 )) {
+                rows_local = false;
+                break;
+            }
+        }
+    }
+
+    // Replicated upper triangular R, accumulated over passes, and the
+    // Gram matrix / factor of the current pass.
+    std::vector<scalar_t> R_all( n*n, zero );
+    std::vector<scalar_t> G( n*n );
+    lapack::laset( lapack::MatrixType::General, n, n, zero, one,
+                   R_all.data(), n );
+
+    // G = A^H A, upper triangle, on all ranks.
+    auto gram = [&]() {
+        std::fill( G.begin(), G.end(), zero );
+        if (rows_local) {
+            for (int64_t i = 0; i < mt; ++i) {
+                if (! A.tileIsLocal( i, 0 ))
+                    continue;
+                for (int64_t k = 0; k < nt; ++k)
+                    A.tileGetForReading( i, k, LayoutConvert( layout ) );
+                for (int64_t k = 0; k < nt; ++k) {
+                    auto Aik = A( i, k );
+                    for (int64_t l = k; l < nt; ++l) {
+                        auto Ail = A( i, l );
+                        blas::gemm( blas::Layout::ColMajor,
+                                    Op::ConjTrans, Op::NoTrans,
+                                    Aik.nb(), Ail.nb(), Aik.mb(),
+                                    one,  Aik.data(), Aik.stride(),
+                                          Ail.data(), Ail.stride(),
+                                    one,  &G[ col_offset[ k ] + col_offset[ l ]*n ], n );
+                    }
+                }
+            }
+        }
+        else {
+            // Distributed product, then gather its upper tiles.
+            Method method = get_option(
+                opts, Option::MethodCholQR, MethodCholQR::Auto );
+            if (method == MethodCholQR::Auto)
+                method = MethodCholQR::select_algo( A, R, opts );
+            auto AH = conj_transpose( A );
+            if (method == MethodCholQR::HerkC) {
+                HermitianMatrix<scalar_t> R_herm( Uplo::Upper, R );
+                herk( real_t( 1.0 ), AH, real_t( 0.0 ), R_herm, opts );
+            }
+            else if (method == MethodCholQR::GemmA) {
+                gemmA( one, AH, A, zero, R, opts );
+            }
+            else {
+                gemmC( one, AH, A, zero, R, opts );
+            }
+            for (int64_t k = 0; k < nt; ++k) {
+                for (int64_t l = k; l < nt; ++l) {
+                    if (R.tileIsLocal( k, l )) {
+                        R.tileGetForReading( k, l, LayoutConvert( layout ) );
+                        auto Rkl = R( k, l );
+                        lapack::lacpy( lapack::MatrixType::General,
+                                       Rkl.mb(), Rkl.nb(),
+                                       Rkl.data(), Rkl.stride(),
+                                       &G[ col_offset[ k ] + col_offset[ l ]*n ], n );
+                    }
+                }
+            }
+        }
+        slate_mpi_call(
+            MPI_Allreduce( MPI_IN_PLACE, G.data(), n*n,
+                           mpi_type<scalar_t>::value, MPI_SUM,
+                           A.mpiComm() ) );
+    };
+
+    // Copies the upper triangle of X into the local tiles of R.
+    auto scatter = [&]( std::vector<scalar_t>& X ) {
+        for (int64_t k = 0; k < nt; ++k) {
+            for (int64_t l = 0; l < nt; ++l) {
+                if (R.tileIsLocal( k, l )) {
+                    R.tileGetForWriting( k, l, LayoutConvert( layout ) );
+                    auto Rkl = R( k, l );
+                    if (k > l) {
+                        Rkl.set( zero );
+                    }
+                    else {
+                        lapack::lacpy( lapack::MatrixType::General,
+                                       Rkl.mb(), Rkl.nb(),
+                                       &X[ col_offset[ k ] + col_offset[ l ]*n ], n,
+                                       Rkl.data(), Rkl.stride() );
+                    }
+                }
+            }
+        }
+    };
+
+    for (int64_t pass = 0; pass < passes; ++pass) {
+        gram();
+
+        if (passes >= 3 && pass == 0) {
+            // Shift by 11 (mn + n(n+1)) u ||A||^2, with ||A||_F^2 = trace(G).
+            real_t eps = std::numeric_limits<real_t>::epsilon();
+            real_t trace = 0;
+            for (int64_t j = 0; j < n; ++j)
+                trace += std::real( G[ j + j*n ] );
+            real_t shift = 11 * (m*n + n*(n + 1)) * eps * trace;
+            for (int64_t j = 0; j < n; ++j)
+                G[ j + j*n ] += shift;
+        }
+
+        // Every rank factors the same G, so all get the same R_k.
+        int64_t info = lapack::potrf( lapack::Uplo::Upper, n, G.data(), n );
+        if (info != 0) {
+            slate_error( "Cholesky QR: Gram matrix is not positive definite;"
+                         " try Option::CholQRPasses = 3" );
+        }
+        lapack::laset( lapack::MatrixType::Lower, n-1, n-1, zero, zero,
+                       &G[ 1 ], n );
+
+        // A = A R_k^{-1}.
+        scatter( G );
+        auto U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R );
+        trsm( Side::Right, one, U, A, opts );
+
+        // R = R_k R.
+        blas::trmm( blas::Layout::ColMajor, Side::Left, Uplo::Upper,
+                    Op::NoTrans, Diag::NonUnit, n, n,
+                    one, G.data(), n, R_all.data(), n );
+    }
+
+    scatter( R_all );
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -107,6 +284,13 @@ void cholqr(
     Matrix<scalar_t>& R,
     Options const& opts )
 {
+    int64_t passes = get_option<int64_t>( opts, Option::CholQRPasses, 1 );
+    if (passes > 1) {
+        impl::cholqr_gram<target>( A, R, blas::min( passes, int64_t( 3 ) ),
+                                   opts );
+        return;
+    }
+
     Method method = get_option(
         opts, Option::MethodCholQR, MethodCholQR::Auto );
 
@@ -171,6 +355,12 @@ void cholqr(
 ///       - GemmA:
 ///       - GemmC:
 ///       - HerkC:
+///     - Option::CholQRPasses:
+///       Number of Cholesky QR passes: 1 for CholeskyQR, 2 for
+///       CholeskyQR2, 3 for shifted CholeskyQR3, which are stable for
+///       increasingly ill-conditioned A, at 1, 2, and 3 times the cost.
+///       With 2 or 3 passes, each Gram matrix is reduced with one
+///       MPI_Allreduce and factored on every rank. Default 1.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -8,8 +8,10 @@
 #include "internal/internal_util.hh"
 #include "slate/internal/mpi.hh"
 
+#include <algorithm>
 #include <list>
 #include <tuple>
+#include <vector>
 
 namespace slate {
 
@@ -17,71 +19,87 @@ namespace impl {
 
 //------------------------------------------------------------------------------
 /// @internal
-/// Distributed parallel matrix norm.
+/// Undoes any transpose of A, for colNorms.
+///
+template <typename matrix_type>
+void colNorms_untranspose( matrix_type& A )
+{
+    // todo: if (in_norm == Norm::One) in_norm = Norm::Inf, and vice-versa.
+    if (A.op() == Op::ConjTrans)
+        A = conj_transpose( A );
+    else if (A.op() == Op::Trans)
+        A = transpose(A);
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel matrix norm, of one matrix A, or of two matrices
+/// A and B if values_B is not null.
+/// For two matrices, the local norms are computed in one parallel region,
+/// and reduced in one MPI call.
+/// Computes the local norms, and starts their reduction; the returned
+/// request stores the norms in values and values_B when it completes.
 /// Generic implementation for any target.
 /// @ingroup norm_impl
 ///
 template <Target target, typename matrix_type>
-void colNorms(
+NormRequest< blas::real_type< typename matrix_type::value_type > >
+colNorms_start(
     Norm in_norm,
     matrix_type A,
     blas::real_type< typename matrix_type::value_type >* values,
+    matrix_type B,
+    blas::real_type< typename matrix_type::value_type >* values_B,
     Options const& opts )
 {
-    using internal::mpi_max_nan;
     using scalar_t = typename matrix_type::value_type;
     using real_t = blas::real_type<scalar_t>;
+    using Reduce = typename NormRequest<real_t>::Reduce;
+
+    bool has_B = values_B != nullptr;
 
     // Undo any transpose.
-    if (A.op() == Op::ConjTrans || A.op() == Op::Trans) {
-        // todo:
-        // if (in_norm == Norm::One)
-        //     in_norm = Norm::Inf;
-        // else if (in_norm == Norm::Inf)
-        //     in_norm = Norm::One;
-    }
-    if (A.op() == Op::ConjTrans)
-        A = conj_transpose( A );
-    else if (A.op() == Op::Trans)
-        A = transpose(A);
+    colNorms_untranspose( A );
+    if (has_B)
+        colNorms_untranspose( B );
 
     //---------
     // all max norm (max of each column)
     // max_{i,j} abs( A_{i,j} )
     if (in_norm == Norm::Max) {
 
-        std::vector<real_t> local_maxes(A.n());
+        int64_t nA = A.n();
+        int64_t nB = has_B ? B.n() : 0;
+        std::vector<real_t> local_maxes(nA + nB);
 
-        if (target == Target::Devices)
+        if (target == Target::Devices) {
             A.reserveDeviceWorkspace();
+            if (has_B)
+                B.reserveDeviceWorkspace();
+        }
 
         #pragma omp parallel
         #pragma omp master
         {
             internal::norm<target>(in_norm, NormScope::Columns, std::move(A), local_maxes.data());
+            if (has_B) {
+                internal::norm<target>(in_norm, NormScope::Columns, std::move(B),
+                                       &local_maxes[nA]);
+            }
         }
 
-        MPI_Op op_max_nan;
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Op_create(mpi_max_nan, true, &op_max_nan));
-        }
-
-        #pragma omp critical(slate_mpi)
-        {
-            trace::Block trace_block("MPI_Allreduce");
-            slate_mpi_call(
-                MPI_Allreduce(local_maxes.data(), values,
-                              A.n(), mpi_type<real_t>::value,
-                              op_max_nan, A.mpiComm()));
-        }
+        // todo: is this correct here?
+        A.releaseWorkspace();
+        if (has_B)
+            B.releaseWorkspace();
 
-        #pragma omp critical(slate_mpi)
-        {
-            slate_mpi_call(
-                MPI_Op_free(&op_max_nan));
-        }
+        return NormRequest<real_t>(
+            std::move( local_maxes ), Reduce::Max, A.mpiComm(),
+            [=]( real_t const* maxes ) {
+                std::copy( maxes, maxes + nA, values );
+                if (has_B)
+                    std::copy( maxes + nA, maxes + nA + nB, values_B );
+            } );
     }
     //---------
     // one norm
@@ -104,9 +122,7 @@ void colNorms(
     else {
         slate_error("invalid norm");
     }
-
-    // todo: is this correct here?
-    A.releaseWorkspace();
+    return {};  // unreachable; silence error
 }
 
 } // namespace impl
@@ -149,24 +165,127 @@ void colNorms(
     matrix_type& A,
     blas::real_type<typename matrix_type::value_type>* values,
     Options const& opts )
+{
+    colNorms_start( in_norm, A, values, opts ).wait();
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel column norms of two matrices, as two calls
+/// colNorms( in_norm, A, values_A ) and colNorms( in_norm, B, values_B ),
+/// but with one parallel region and one MPI reduction.
+/// Used for the convergence check of iterative refinement,
+/// where A is the solution X and B is the residual R.
+///
+/// @param[in] in_norm
+///     Norm to compute. Currently only Norm::Max.
+///
+/// @param[in] A
+///     The first matrix A.
+///
+/// @param[out] values_A
+///     Array of length A.n(). On exit, the column norms of A.
+///
+/// @param[in] B
+///     The second matrix B, with the same MPI communicator as A.
+///
+/// @param[out] values_B
+///     Array of length B.n(). On exit, the column norms of B.
+///
+/// @param[in] opts
+///     Additional options, as for colNorms.
+///
+/// @ingroup norm
+///
+template <typename matrix_type>
+void colNorms(
+    Norm in_norm,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values_A,
+    matrix_type& B,
+    blas::real_type<typename matrix_type::value_type>* values_B,
+    Options const& opts )
+{
+    colNorms_start( in_norm, A, values_A, B, values_B, opts ).wait();
+}
+
+//------------------------------------------------------------------------------
+/// Split-phase version of colNorms( in_norm, A, values, opts ): computes
+/// the local column norms, and starts their reduction across MPI ranks
+/// without waiting for it, so the caller can overlap it with other work.
+/// values must not be read until the returned request completes.
+///
+/// @return request whose wait() completes the reduction and stores values.
+///
+/// @ingroup norm
+///
+template <typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+colNorms_start(
+    Norm in_norm,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values,
+    Options const& opts )
 {
     Target target = get_option( opts, Option::Target, Target::HostTask );
+    matrix_type empty;
 
     switch (target) {
         case Target::Host:
         case Target::HostTask:
-            impl::colNorms<Target::HostTask>( in_norm, A, values, opts );
-            break;
+            return impl::colNorms_start<Target::HostTask>(
+                in_norm, A, values, empty, nullptr, opts );
 
         case Target::HostBatch:
         case Target::HostNest:
-            impl::colNorms<Target::HostNest>( in_norm, A, values, opts );
-            break;
+            return impl::colNorms_start<Target::HostNest>(
+                in_norm, A, values, empty, nullptr, opts );
 
         case Target::Devices:
-            impl::colNorms<Target::Devices>( in_norm, A, values, opts );
-            break;
+            return impl::colNorms_start<Target::Devices>(
+                in_norm, A, values, empty, nullptr, opts );
     }
+    return {};  // unreachable; silence error
+}
+
+//------------------------------------------------------------------------------
+/// Split-phase version of colNorms( in_norm, A, values_A, B, values_B,
+/// opts ): the column norms of A and B are reduced in one non-blocking
+/// MPI call. values_A and values_B must not be read until the returned
+/// request completes.
+///
+/// @return request whose wait() completes the reduction and stores
+///     values_A and values_B.
+///
+/// @ingroup norm
+///
+template <typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+colNorms_start(
+    Norm in_norm,
+    matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values_A,
+    matrix_type& B,
+    blas::real_type<typename matrix_type::value_type>* values_B,
+    Options const& opts )
+{
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+            return impl::colNorms_start<Target::HostTask>(
+                in_norm, A, values_A, B, values_B, opts );
+
+        case Target::HostBatch:
+        case Target::HostNest:
+            return impl::colNorms_start<Target::HostNest>(
+                in_norm, A, values_A, B, values_B, opts );
+
+        case Target::Devices:
+            return impl::colNorms_start<Target::Devices>(
+                in_norm, A, values_A, B, values_B, opts );
+    }
+    return {};  // unreachable; silence error
 }
 
 //------------------------------------------------------------------------------
@@ -199,4 +318,104 @@ void colNorms(
     double* values,
     Options const& opts);
 
+template
+void colNorms(
+    Norm in_norm,
+    Matrix<float>& A,
+    float* values_A,
+    Matrix<float>& B,
+    float* values_B,
+    Options const& opts);
+
+template
+void colNorms(
+    Norm in_norm,
+    Matrix<double>& A,
+    double* values_A,
+    Matrix<double>& B,
+    double* values_B,
+    Options const& opts);
+
+template
+void colNorms(
+    Norm in_norm,
+    Matrix< std::complex<float> >& A,
+    float* values_A,
+    Matrix< std::complex<float> >& B,
+    float* values_B,
+    Options const& opts);
+
+template
+void colNorms(
+    Norm in_norm,
+    Matrix< std::complex<double> >& A,
+    double* values_A,
+    Matrix< std::complex<double> >& B,
+    double* values_B,
+    Options const& opts);
+
+template
+NormRequest<float> colNorms_start(
+    Norm in_norm,
+    Matrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> colNorms_start(
+    Norm in_norm,
+    Matrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> colNorms_start(
+    Norm in_norm,
+    Matrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> colNorms_start(
+    Norm in_norm,
+    Matrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> colNorms_start(
+    Norm in_norm,
+    Matrix<float>& A,
+    float* values_A,
+    Matrix<float>& B,
+    float* values_B,
+    Options const& opts);
+
+template
+NormRequest<double> colNorms_start(
+    Norm in_norm,
+    Matrix<double>& A,
+    double* values_A,
+    Matrix<double>& B,
+    double* values_B,
+    Options const& opts);
+
+template
+NormRequest<float> colNorms_start(
+    Norm in_norm,
+    Matrix< std::complex<float> >& A,
+    float* values_A,
+    Matrix< std::complex<float> >& B,
+    float* values_B,
+    Options const& opts);
+
+template
+NormRequest<double> colNorms_start(
+    Norm in_norm,
+    Matrix< std::complex<double> >& A,
+    double* values_A,
+    Matrix< std::complex<double> >& B,
+    double* values_B,
+    Options const& opts);
+
 } // namespace slate
@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/Affinity.hh"
+#include "slate/internal/openmp.hh"
+#include "slate/config.hh"
+
+#if defined( __linux__ )
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+#if defined( __linux__ )
+    /// Affinity of this thread before the outermost ExcludeReservedCores.
+    thread_local cpu_set_t t_orig_cpuset;
+#endif
+
+/// Whether the outermost ExcludeReservedCores changed this thread's
+/// affinity, so t_orig_cpuset must be restored.
+thread_local bool t_changed = false;
+
+/// Nesting depth of ExcludeReservedCores on this thread.
+thread_local int t_depth = 0;
+
+//------------------------------------------------------------------------------
+/// Removes cores from the calling thread's affinity, unless that would
+/// leave none. Only the outermost level changes it.
+void exclude_cores( std::vector<int> const& cores )
+{
+    if (t_depth++ > 0)
+        return;
+
+    t_changed = false;
+    #if defined( __linux__ )
+        cpu_set_t cpuset;
+        if (pthread_getaffinity_np( pthread_self(), sizeof( cpuset ),
+                                    &cpuset ) != 0)
+            return;
+
+        t_orig_cpuset = cpuset;
+        for (int core : cores) {
+            if (core < CPU_SETSIZE)
+                CPU_CLR( core, &cpuset );
+        }
+        if (CPU_COUNT( &cpuset ) == 0 || CPU_EQUAL( &cpuset, &t_orig_cpuset ))
+            return;
+
+        t_changed = pthread_setaffinity_np( pthread_self(), sizeof( cpuset ),
+                                            &cpuset ) == 0;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Undoes exclude_cores on the calling thread at the outermost level.
+void restore_cores()
+{
+    if (t_depth == 0 || --t_depth > 0)
+        return;
+
+    #if defined( __linux__ )
+        if (t_changed) {
+            pthread_setaffinity_np( pthread_self(), sizeof( t_orig_cpuset ),
+                                    &t_orig_cpuset );
+        }
+    #endif
+    t_changed = false;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+void pin_thread( std::vector<int> const& cores )
+{
+    #if defined( __linux__ )
+        if (cores.empty())
+            return;
+
+        cpu_set_t cpuset;
+        CPU_ZERO( &cpuset );
+        for (int core : cores) {
+            if (core < CPU_SETSIZE)
+                CPU_SET( core, &cpuset );
+        }
+        pthread_setaffinity_np( pthread_self(), sizeof( cpuset ), &cpuset );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+ExcludeReservedCores::ExcludeReservedCores()
+{
+    std::vector<int> reserved = panel_cores();
+    std::vector<int> comm = comm_cores();
+    reserved.insert( reserved.end(), comm.begin(), comm.end() );
+    if (reserved.empty())
+        return;
+
+    active_ = true;
+    #pragma omp parallel slate_omp_default_none shared( reserved )
+    {
+        exclude_cores( reserved );
+    }
+}
+
+//------------------------------------------------------------------------------
+ExcludeReservedCores::~ExcludeReservedCores()
+{
+    if (! active_)
+        return;
+
+    #pragma omp parallel
+    {
+        restore_cores();
+    }
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,160 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/CommPlan.hh"
+#include "slate/internal/LockGuard.hh"
+#include "slate/Exception.hh"
+
+#include <cassert>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Constructor creates an empty plan; requests are recorded as messages
+/// are posted.
+CommPlan::CommPlan():
+    epoch_( 0 )
+{
+    omp_init_nest_lock( &lock_ );
+}
+
+//------------------------------------------------------------------------------
+/// Destructor frees all requests.
+/// MPI must not be finalized yet, and no request may be active.
+CommPlan::~CommPlan()
+{
+    try {
+        clear();
+    }
+    catch (std::exception const& ex) {
+        // If debugging, die on exceptions.
+        // Otherwise, ignore errors: destructors should not throw errors!
+        assert(false);
+    }
+    omp_destroy_nest_lock( &lock_ );
+}
+
+//------------------------------------------------------------------------------
+/// Frees all requests. No request may be active.
+void CommPlan::clear()
+{
+    LockGuard guard( &lock_ );
+
+    // Nothing to free if MPI was already finalized, e.g., for a plan in a
+    // global Workspace.
+    int finalized = 0;
+    slate_mpi_call( MPI_Finalized( &finalized ) );
+    if (! finalized) {
+        for (auto& iter : requests_) {
+            for (auto& entry : iter.second)
+                slate_mpi_call( MPI_Request_free( &entry.request ) );
+        }
+    }
+    requests_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Starts a new epoch, at the start of a driver. All requests started
+/// in earlier epochs must be complete. Frees requests that have not been
+/// started in the last max_idle_epochs epochs.
+void CommPlan::nextEpoch()
+{
+    LockGuard guard( &lock_ );
+
+    ++epoch_;
+    for (auto iter = requests_.begin(); iter != requests_.end(); ) {
+        auto& entries = iter->second;
+        size_t kept = 0;
+        for (size_t k = 0; k < entries.size(); ++k) {
+            if (entries[ k ].epoch + max_idle_epochs < epoch_)
+                slate_mpi_call( MPI_Request_free( &entries[ k ].request ) );
+            else
+                entries[ kept++ ] = entries[ k ];
+        }
+        entries.resize( kept );
+        if (entries.empty())
+            iter = requests_.erase( iter );
+        else
+            ++iter;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Starts a send, like MPI_Isend, using the recorded persistent request
+/// for this message if there is one, otherwise recording a new one.
+///
+/// @param[out] request
+///     Started request, to be completed with MPI_Wait, etc.
+///     It remains owned by the plan.
+///
+void CommPlan::isend(
+    void const* buf, int count, MPI_Datatype datatype,
+    int dst, int tag, MPI_Comm comm, MPI_Request* request )
+{
+    start( Key( true, const_cast<void*>( buf ), count, datatype, dst, tag, comm ),
+           request );
+}
+
+//------------------------------------------------------------------------------
+/// Starts a receive, like MPI_Irecv; see isend.
+void CommPlan::irecv(
+    void* buf, int count, MPI_Datatype datatype,
+    int src, int tag, MPI_Comm comm, MPI_Request* request )
+{
+    start( Key( false, buf, count, datatype, src, tag, comm ), request );
+}
+
+//------------------------------------------------------------------------------
+/// Starts a request for message key: the first one not yet started in
+/// this epoch, or a new persistent request if all are in use.
+void CommPlan::start( Key const& key, MPI_Request* request )
+{
+    LockGuard guard( &lock_ );
+
+    auto& entries = requests_[ key ];
+    Entry* entry = nullptr;
+    for (auto& e : entries) {
+        if (e.epoch < epoch_) {
+            entry = &e;
+            break;
+        }
+    }
+    if (entry == nullptr) {
+        Entry e;
+        auto buf  = std::get<1>( key );
+        auto cnt  = std::get<2>( key );
+        auto type = std::get<3>( key );
+        auto peer = std::get<4>( key );
+        auto tag  = std::get<5>( key );
+        auto comm = std::get<6>( key );
+        if (std::get<0>( key )) {
+            slate_mpi_call(
+                MPI_Send_init( buf, cnt, type, peer, tag, comm, &e.request ) );
+        }
+        else {
+            slate_mpi_call(
+                MPI_Recv_init( buf, cnt, type, peer, tag, comm, &e.request ) );
+        }
+        entries.push_back( e );
+        entry = &entries.back();
+    }
+    entry->epoch = epoch_;
+    slate_mpi_call( MPI_Start( &entry->request ) );
+    *request = entry->request;
+}
+
+//------------------------------------------------------------------------------
+/// @return number of recorded persistent requests.
+size_t CommPlan::numRequests() const
+{
+    LockGuard guard( &lock_ );
+
+    size_t count = 0;
+    for (auto& iter : requests_)
+        count += iter.second.size();
+    return count;
+}
+
+} // namespace slate
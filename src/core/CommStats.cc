@@ -0,0 +1,263 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/CommStats.hh"
+#include "slate/internal/CommThread.hh"
+#include "slate/internal/openmp.hh"
+
+#include <cstdio>
+#include <exception>
+
+namespace slate {
+
+namespace {
+
+/// Counters of this rank, updated by all threads in critical(slate_comm_stats).
+CommStats g_stats;
+
+/// Counters of top-level driver calls, by driver name.
+std::map< std::string, CommStats > g_driver_stats;
+
+/// Depth of nested CommStatsScope on this thread.
+thread_local int g_scope_depth = 0;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Adds other's counters to this.
+CommStats& CommStats::operator += ( CommStats const& other )
+{
+    calls         += other.calls;
+    messages_sent += other.messages_sent;
+    bytes_sent    += other.bytes_sent;
+    messages_recv += other.messages_recv;
+    bytes_recv    += other.bytes_recv;
+    wait_time     += other.wait_time;
+    for (auto const& iter : other.peer_bytes)
+        peer_bytes[ iter.first ] += iter.second;
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+/// Subtracts other's counters from this, e.g., to get the counters of an
+/// interval from snapshots at its start and end.
+CommStats& CommStats::operator -= ( CommStats const& other )
+{
+    calls         -= other.calls;
+    messages_sent -= other.messages_sent;
+    bytes_sent    -= other.bytes_sent;
+    messages_recv -= other.messages_recv;
+    bytes_recv    -= other.bytes_recv;
+    wait_time     -= other.wait_time;
+    for (auto const& iter : other.peer_bytes) {
+        auto& bytes = peer_bytes[ iter.first ];
+        bytes -= iter.second;
+        if (bytes == 0)
+            peer_bytes.erase( iter.first );
+    }
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+/// @return snapshot of this rank's communication counters since the start
+/// or the last comm_stats_reset.
+CommStats comm_stats()
+{
+    CommStats stats;
+    #pragma omp critical(slate_comm_stats)
+    stats = g_stats;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// @return this rank's communication counters of top-level driver calls,
+/// by driver name, e.g., "gesv". Counters of repeated calls are summed,
+/// and calls counts them.
+std::map< std::string, CommStats > comm_stats_drivers()
+{
+    std::map< std::string, CommStats > stats;
+    #pragma omp critical(slate_comm_stats)
+    stats = g_driver_stats;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets all communication counters to zero.
+void comm_stats_reset()
+{
+    #pragma omp critical(slate_comm_stats)
+    {
+        g_stats = CommStats();
+        g_driver_stats.clear();
+    }
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Counts a message of bytes sent to peer.
+void comm_stats_send( int peer, int64_t bytes )
+{
+    #pragma omp critical(slate_comm_stats)
+    {
+        g_stats.messages_sent += 1;
+        g_stats.bytes_sent    += bytes;
+        g_stats.peer_bytes[ peer ] += bytes;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Counts a message of bytes received from peer.
+void comm_stats_recv( int peer, int64_t bytes )
+{
+    #pragma omp critical(slate_comm_stats)
+    {
+        g_stats.messages_recv += 1;
+        g_stats.bytes_recv    += bytes;
+    }
+}
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Waits on the communication thread for requests, as MPI_Waitall, or
+/// MPI_Waitany if index is given. The calling thread blocks on the
+/// future, not in MPI, so the thread keeps making other tasks' calls.
+void comm_thread_wait_sync(
+    const char* call, int count, MPI_Request* requests, int* index )
+{
+    int err = comm_thread_wait( count, requests, index ).get();
+    if (err != MPI_SUCCESS)
+        throw MpiException( call, err, __func__, __FILE__, __LINE__ );
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// MPI_Wait, counting the time waited.
+/// If comm_thread() is enabled, waits on the communication thread.
+void comm_wait( MPI_Request* request )
+{
+    double start = omp_get_wtime();
+    if (comm_thread_active())
+        comm_thread_wait_sync( "MPI_Wait", 1, request, nullptr );
+    else
+        slate_mpi_call( MPI_Wait( request, MPI_STATUS_IGNORE ) );
+    double time = omp_get_wtime() - start;
+
+    #pragma omp critical(slate_comm_stats)
+    g_stats.wait_time += time;
+}
+
+//------------------------------------------------------------------------------
+/// MPI_Waitall, counting the time waited.
+/// If comm_thread() is enabled, waits on the communication thread.
+void comm_waitall( int count, MPI_Request* requests )
+{
+    double start = omp_get_wtime();
+    if (comm_thread_active())
+        comm_thread_wait_sync( "MPI_Waitall", count, requests, nullptr );
+    else
+        slate_mpi_call( MPI_Waitall( count, requests, MPI_STATUSES_IGNORE ) );
+    double time = omp_get_wtime() - start;
+
+    #pragma omp critical(slate_comm_stats)
+    g_stats.wait_time += time;
+}
+
+//------------------------------------------------------------------------------
+/// MPI_Waitany, counting the time waited.
+/// If comm_thread() is enabled, waits on the communication thread.
+void comm_waitany( int count, MPI_Request* requests, int* index )
+{
+    double start = omp_get_wtime();
+    if (comm_thread_active()) {
+        comm_thread_wait_sync( "MPI_Waitany", count, requests, index );
+    }
+    else {
+        slate_mpi_call(
+            MPI_Waitany( count, requests, index, MPI_STATUS_IGNORE ) );
+    }
+    double time = omp_get_wtime() - start;
+
+    #pragma omp critical(slate_comm_stats)
+    g_stats.wait_time += time;
+}
+
+//------------------------------------------------------------------------------
+/// Exchanges count elements with peer, as MPI_Sendrecv with the same
+/// datatype, tag, and peer for both messages. Posts the receive and send,
+/// then waits with comm_waitall, so with comm_thread() enabled, the
+/// communication thread isn't blocked.
+void comm_sendrecv(
+    void const* sendbuf, void* recvbuf, int count, MPI_Datatype datatype,
+    int peer, int tag, MPI_Comm comm )
+{
+    MPI_Request requests[ 2 ];
+    slate_mpi_call(
+        MPI_Irecv( recvbuf, count, datatype, peer, tag, comm,
+                   &requests[ 0 ] ) );
+    slate_mpi_call(
+        MPI_Isend( sendbuf, count, datatype, peer, tag, comm,
+                   &requests[ 1 ] ) );
+    comm_waitall( 2, requests );
+}
+
+//------------------------------------------------------------------------------
+/// Starts counting the communication of driver name, if it is not nested
+/// in another driver.
+CommStatsScope::CommStatsScope(
+    const char* name, MPI_Comm comm, Options const& opts )
+    : name_( name ),
+      comm_( comm ),
+      verbose_( get_option<int>( opts, Option::PrintVerbose, 0 ) ),
+      outer_( g_scope_depth == 0 )
+{
+    ++g_scope_depth;
+    if (outer_)
+        start_ = comm_stats();
+}
+
+//------------------------------------------------------------------------------
+/// Adds the communication since the constructor to the driver's counters,
+/// and prints them if verbose.
+CommStatsScope::~CommStatsScope()
+{
+    --g_scope_depth;
+    if (! outer_)
+        return;
+
+    CommStats stats = comm_stats();
+    stats -= start_;
+    stats.calls = 1;
+
+    #pragma omp critical(slate_comm_stats)
+    g_driver_stats[ name_ ] += stats;
+
+    // Printing is collective; skip it while unwinding an error,
+    // as other ranks may not get here.
+    if (verbose_ >= 1 && std::uncaught_exceptions() == 0) {
+        int mpi_rank;
+        MPI_Comm_rank( comm_, &mpi_rank );
+        double local[ 4 ] = { double( stats.messages_sent ),
+                              double( stats.bytes_sent ),
+                              double( stats.peer_bytes.size() ),
+                              stats.wait_time };
+        double sum[ 4 ], max[ 4 ];
+        MPI_Reduce( local, sum, 4, MPI_DOUBLE, MPI_SUM, 0, comm_ );
+        MPI_Reduce( local, max, 4, MPI_DOUBLE, MPI_MAX, 0, comm_ );
+        if (mpi_rank == 0) {
+            printf( "slate::%s: sent %.0f messages, %.3g MB in total;"
+                    " per rank max %.0f messages, %.3g MB, %.0f peers,"
+                    " %.3g s wait\n",
+                    name_, sum[ 0 ], sum[ 1 ] * 1e-6,
+                    max[ 0 ], max[ 1 ] * 1e-6, max[ 2 ], max[ 3 ] );
+        }
+    }
+}
+
+} // namespace internal
+
+} // namespace slate
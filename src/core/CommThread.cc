@@ -0,0 +1,235 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/CommThread.hh"
+#include "slate/internal/Affinity.hh"
+#include "slate/config.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+/// True on the communication thread, which makes MPI calls directly.
+thread_local bool g_is_comm_thread = false;
+
+//------------------------------------------------------------------------------
+/// Operation posted to the communication thread: an MPI call, or a wait
+/// for requests to complete, like MPI_Waitall, or MPI_Waitany if index is
+/// given.
+struct CommOp {
+    std::function< int () > call;
+    int count = 0;
+    MPI_Request* requests = nullptr;
+    int* index = nullptr;
+    std::promise< int > promise;
+    CommOp* next = nullptr;
+};
+
+//------------------------------------------------------------------------------
+/// Thread that makes all MPI calls posted to it, in order, and completes
+/// waits as their requests complete.
+///
+/// Posting pushes onto a lock-free stack (Treiber), which the thread takes
+/// whole and reverses, so posting doesn't contend with the thread making
+/// MPI calls. While waits are pending, the thread polls; when idle, it
+/// sleeps on a condition variable, which a post to an empty stack signals.
+///
+class CommThread {
+public:
+    CommThread()
+        : head_( nullptr ),
+          thread_( [this] { run(); } )
+    {}
+
+    /// Enqueues op; the thread owns and deletes it.
+    void post( CommOp* op )
+    {
+        CommOp* head = head_.load( std::memory_order_relaxed );
+        do {
+            op->next = head;
+        } while (! head_.compare_exchange_weak(
+                       head, op, std::memory_order_release,
+                       std::memory_order_relaxed ));
+
+        // The thread checks for posts under the mutex before sleeping,
+        // so taking it here avoids a lost wakeup.
+        if (head == nullptr) {
+            { std::lock_guard< std::mutex > guard( mutex_ ); }
+            cv_.notify_one();
+        }
+    }
+
+private:
+    /// Main loop of the thread.
+    void run()
+    {
+        g_is_comm_thread = true;
+        pin_thread( comm_cores() );
+        std::list< CommOp* > waits;
+        while (true) {
+            CommOp* ops = head_.exchange( nullptr, std::memory_order_acquire );
+
+            // Reverse to posting order.
+            CommOp* fifo = nullptr;
+            while (ops != nullptr) {
+                CommOp* next = ops->next;
+                ops->next = fifo;
+                fifo = ops;
+                ops = next;
+            }
+            for (CommOp* op = fifo; op != nullptr; ) {
+                CommOp* next = op->next;
+                if (op->call) {
+                    try {
+                        op->promise.set_value( op->call() );
+                    }
+                    catch (...) {
+                        op->promise.set_exception( std::current_exception() );
+                    }
+                    delete op;
+                }
+                else {
+                    waits.push_back( op );
+                }
+                op = next;
+            }
+
+            // Test pending waits, in posting order.
+            for (auto iter = waits.begin(); iter != waits.end(); ) {
+                CommOp* op = *iter;
+                int flag = 0;
+                int err;
+                if (op->index == nullptr) {
+                    err = MPI_Testall( op->count, op->requests, &flag,
+                                       MPI_STATUSES_IGNORE );
+                }
+                else {
+                    err = MPI_Testany( op->count, op->requests, op->index,
+                                       &flag, MPI_STATUS_IGNORE );
+                }
+                if (flag || err != MPI_SUCCESS) {
+                    op->promise.set_value( err );
+                    delete op;
+                    iter = waits.erase( iter );
+                }
+                else {
+                    ++iter;
+                }
+            }
+
+            if (waits.empty()) {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                cv_.wait( lock, [this] {
+                    return head_.load( std::memory_order_acquire ) != nullptr;
+                });
+            }
+            else if (head_.load( std::memory_order_relaxed ) == nullptr) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    //----------------------------------------
+    // Data
+    std::atomic< CommOp* > head_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+};
+
+/// @return process-wide communication thread, started on first use.
+/// Intentionally never deleted: the thread sleeps when idle, and makes no
+/// MPI calls unless posted to, so it can outlive MPI_Finalize at exit.
+CommThread& comm_thread_instance()
+{
+    static CommThread* thread = new CommThread;
+    return *thread;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// @return true if comm_thread() is enabled and the calling thread isn't
+/// the communication thread, so MPI calls must be posted to it.
+bool comm_thread_active()
+{
+#ifdef SLATE_NO_MPI
+    return false;
+#else
+    return comm_thread() && ! g_is_comm_thread;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Posts an MPI call to the communication thread.
+/// Calls are made in the order they are posted from each thread.
+///
+/// @param[in] call
+///     Function that makes MPI calls and returns an MPI error code.
+///     It should not block on messages that may depend on later posts,
+///     e.g., by calling MPI_Wait; use comm_thread_wait instead.
+///
+/// @return future of call's return value.
+///
+std::future< int > comm_thread_post( std::function< int () > call )
+{
+    CommOp* op = new CommOp;
+    op->call = std::move( call );
+    std::future< int > future = op->promise.get_future();
+    comm_thread_instance().post( op );
+    return future;
+}
+
+//------------------------------------------------------------------------------
+/// Posts an MPI call to the communication thread and waits for it.
+/// Used by slate_mpi_call when comm_thread_active().
+///
+/// @return call's return value, an MPI error code.
+///
+int comm_thread_call( std::function< int () > const& call )
+{
+    return comm_thread_post( call ).get();
+}
+
+//------------------------------------------------------------------------------
+/// Posts a wait for requests to the communication thread. The thread tests
+/// the requests with MPI_Testall, or MPI_Testany if index is given, until
+/// they complete, without blocking other posts.
+///
+/// @param[in] count
+///     Number of requests.
+///
+/// @param[in,out] requests
+///     Array of count requests, which must stay valid until the future
+///     is ready. Completed requests are set to MPI_REQUEST_NULL,
+///     or inactive if persistent, as by MPI_Waitall or MPI_Waitany.
+///
+/// @param[out] index
+///     If not null, the wait completes when any request does, and *index
+///     is set to its index, or MPI_UNDEFINED if no request is active.
+///
+/// @return future of the MPI error code, ready when the wait completes.
+///
+std::future< int > comm_thread_wait(
+    int count, MPI_Request* requests, int* index )
+{
+    CommOp* op = new CommOp;
+    op->count = count;
+    op->requests = requests;
+    op->index = index;
+    std::future< int > future = op->promise.get_future();
+    comm_thread_instance().post( op );
+    return future;
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,178 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/DeviceEvent.hh"
+#include "slate/Exception.hh"
+#include "slate/config.hh"
+
+#include "blas.hh"
+
+#include <mutex>
+#include <vector>
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
+namespace slate {
+
+namespace {
+
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+
+//------------------------------------------------------------------------------
+/// Pool of free event handles, per device. Creating events is relatively
+/// expensive, and device routines record one per call, so handles are
+/// recycled. Handles are never destroyed, since the pool can outlive the
+/// CUDA or HIP runtime at exit.
+class EventPool {
+public:
+    /// @return free event on device, creating one if needed.
+    /// Assumes device is the current device.
+    void* get( int device )
+    {
+        {
+            std::lock_guard< std::mutex > guard( mutex_ );
+            if (size_t( device ) < free_.size() && ! free_[ device ].empty()) {
+                void* event = free_[ device ].back();
+                free_[ device ].pop_back();
+                return event;
+            }
+        }
+        #if defined( BLAS_HAVE_CUBLAS )
+            cudaEvent_t event;
+            slate_assert( cudaEventCreateWithFlags(
+                              &event, cudaEventDisableTiming ) == cudaSuccess );
+        #else
+            hipEvent_t event;
+            slate_assert( hipEventCreateWithFlags(
+                              &event, hipEventDisableTiming ) == hipSuccess );
+        #endif
+        return event;
+    }
+
+    /// Returns event on device to the pool.
+    void put( void* event, int device )
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        if (size_t( device ) >= free_.size())
+            free_.resize( device + 1 );
+        free_[ device ].push_back( event );
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector< std::vector< void* > > free_;
+};
+
+/// @return process-wide event pool; intentionally never deleted.
+EventPool& event_pool()
+{
+    static EventPool* pool = new EventPool;
+    return *pool;
+}
+
+#endif // CUBLAS || ROCBLAS
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Records an event on queue, after the work enqueued so far.
+/// Keeps the current device of the calling thread.
+///
+/// If events are not supported (no CUDA or HIP), or are disabled by
+/// gpu_events( false ), instead synchronizes the queue and returns null,
+/// so the work is already complete; callers treat a null event as complete.
+///
+/// @param[in] queue
+///     Queue to record the event on.
+///
+/// @return event, or null if the work is complete.
+///
+std::shared_ptr< DeviceEvent > DeviceEvent::record( blas::Queue& queue )
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    if (gpu_events()) {
+        int device = queue.device();
+        void* event;
+        #if defined( BLAS_HAVE_CUBLAS )
+            int current;
+            cudaGetDevice( &current );
+            cudaSetDevice( device );
+            event = event_pool().get( device );
+            slate_assert( cudaEventRecord( (cudaEvent_t) event,
+                                           queue.stream() ) == cudaSuccess );
+            cudaSetDevice( current );
+        #else
+            int current;
+            hipGetDevice( &current );
+            hipSetDevice( device );
+            event = event_pool().get( device );
+            slate_assert( hipEventRecord( (hipEvent_t) event,
+                                          queue.stream() ) == hipSuccess );
+            hipSetDevice( current );
+        #endif
+        return std::shared_ptr< DeviceEvent >( new DeviceEvent( event, device ) );
+    }
+#endif
+    queue.sync();
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+/// Returns the event handle to the pool. Waits already enqueued on
+/// the event are unaffected.
+DeviceEvent::~DeviceEvent()
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    event_pool().put( event_, device_ );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Makes work enqueued on queue after this call wait until the event
+/// completes, without blocking the host. The queue can be on another device.
+///
+/// @param[in] queue
+///     Queue that waits.
+///
+void DeviceEvent::wait( blas::Queue& queue ) const
+{
+#if defined( BLAS_HAVE_CUBLAS )
+    slate_assert( cudaStreamWaitEvent( queue.stream(), (cudaEvent_t) event_,
+                                       0 ) == cudaSuccess );
+#elif defined( BLAS_HAVE_ROCBLAS )
+    slate_assert( hipStreamWaitEvent( queue.stream(), (hipEvent_t) event_,
+                                      0 ) == hipSuccess );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Blocks the host thread until the event completes.
+void DeviceEvent::sync() const
+{
+#if defined( BLAS_HAVE_CUBLAS )
+    slate_assert( cudaEventSynchronize( (cudaEvent_t) event_ ) == cudaSuccess );
+#elif defined( BLAS_HAVE_ROCBLAS )
+    slate_assert( hipEventSynchronize( (hipEvent_t) event_ ) == hipSuccess );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// @return true if the event has completed; doesn't block.
+bool DeviceEvent::done() const
+{
+#if defined( BLAS_HAVE_CUBLAS )
+    return cudaEventQuery( (cudaEvent_t) event_ ) == cudaSuccess;
+#elif defined( BLAS_HAVE_ROCBLAS )
+    return hipEventQuery( (hipEvent_t) event_ ) == hipSuccess;
+#else
+    return true;
+#endif
+}
+
+} // namespace slate
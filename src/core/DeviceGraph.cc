@@ -0,0 +1,229 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/DeviceGraph.hh"
+#include "slate/Exception.hh"
+#include "slate/config.hh"
+
+#include "blas.hh"
+
+#include <map>
+#include <mutex>
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+
+//------------------------------------------------------------------------------
+/// Cache of instantiated graphs, cudaGraphExec_t or hipGraphExec_t, by key.
+/// The key includes the queue's stream, so each graph is replayed on the
+/// queue it was captured on.
+class GraphCache {
+public:
+    /// Limits the graphs kept, since keys include pointers that change
+    /// when matrices are reallocated.
+    static constexpr size_t max_graphs = 1024;
+
+    /// @return cached graph for key, or null.
+    void* find( DeviceGraphKey const& key )
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        auto iter = graphs_.find( key );
+        return iter == graphs_.end() ? nullptr : iter->second;
+    }
+
+    /// Inserts graph for key, unless it is already cached.
+    /// @return the cached graph.
+    void* insert( DeviceGraphKey const& key, void* graph )
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        if (graphs_.size() >= max_graphs)
+            clear_locked();
+        auto result = graphs_.insert( { key, graph } );
+        if (! result.second)
+            destroy( graph );
+        return result.first->second;
+    }
+
+    void clear()
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        clear_locked();
+    }
+
+private:
+    void clear_locked()
+    {
+        for (auto& iter : graphs_)
+            destroy( iter.second );
+        graphs_.clear();
+    }
+
+    /// Destroys graph; launches in flight still complete.
+    static void destroy( void* graph )
+    {
+        #if defined( BLAS_HAVE_CUBLAS )
+            cudaGraphExecDestroy( (cudaGraphExec_t) graph );
+        #else
+            hipGraphExecDestroy( (hipGraphExec_t) graph );
+        #endif
+    }
+
+    std::mutex mutex_;
+    std::map< DeviceGraphKey, void* > graphs_;
+};
+
+/// @return process-wide graph cache; intentionally never deleted,
+/// since it can outlive the CUDA or HIP runtime at exit.
+GraphCache& graph_cache()
+{
+    static GraphCache* cache = new GraphCache;
+    return *cache;
+}
+
+//------------------------------------------------------------------------------
+/// Captures the launches on queue into a graph and instantiates it.
+/// The captured launches don't execute.
+/// @return graph, or null if capture isn't supported for the launches,
+///         e.g., they synchronize.
+void* capture( blas::Queue& queue, std::function< void () > const& launch )
+{
+    #if defined( BLAS_HAVE_CUBLAS )
+        cudaStream_t stream = queue.stream();
+        slate_assert( cudaStreamBeginCapture(
+                          stream, cudaStreamCaptureModeThreadLocal )
+                      == cudaSuccess );
+        cudaGraph_t graph = nullptr;
+        try {
+            launch();
+        }
+        catch (...) {
+            cudaStreamEndCapture( stream, &graph );
+            if (graph != nullptr)
+                cudaGraphDestroy( graph );
+            throw;
+        }
+        cudaGraphExec_t exec = nullptr;
+        if (cudaStreamEndCapture( stream, &graph ) == cudaSuccess
+            && cudaGraphInstantiateWithFlags( &exec, graph, 0 ) != cudaSuccess)
+            exec = nullptr;
+        if (graph != nullptr)
+            cudaGraphDestroy( graph );
+        cudaGetLastError();  // clear error of unsupported capture
+        return exec;
+    #else
+        hipStream_t stream = queue.stream();
+        slate_assert( hipStreamBeginCapture(
+                          stream, hipStreamCaptureModeThreadLocal )
+                      == hipSuccess );
+        hipGraph_t graph = nullptr;
+        try {
+            launch();
+        }
+        catch (...) {
+            hipStreamEndCapture( stream, &graph );
+            if (graph != nullptr)
+                hipGraphDestroy( graph );
+            throw;
+        }
+        hipGraphExec_t exec = nullptr;
+        if (hipStreamEndCapture( stream, &graph ) == hipSuccess
+            && hipGraphInstantiate( &exec, graph, nullptr, nullptr, 0 )
+               != hipSuccess)
+            exec = nullptr;
+        if (graph != nullptr)
+            hipGraphDestroy( graph );
+        hipGetLastError();  // clear error of unsupported capture
+        return exec;
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Launches graph on queue.
+void replay( blas::Queue& queue, void* graph )
+{
+    #if defined( BLAS_HAVE_CUBLAS )
+        slate_assert( cudaGraphLaunch( (cudaGraphExec_t) graph, queue.stream() )
+                      == cudaSuccess );
+    #else
+        slate_assert( hipGraphLaunch( (hipGraphExec_t) graph, queue.stream() )
+                      == hipSuccess );
+    #endif
+}
+
+#endif // CUBLAS || ROCBLAS
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Enqueues the device launches of a routine on queue, replaying a graph
+/// captured from an earlier call with the same key if gpu_graphs() is
+/// enabled. On the first call with a key, launch's kernels are captured
+/// into a graph, which is then launched.
+///
+/// The key must include every argument of the launches, and the stream is
+/// added to it. Work that must happen on every call, such as copying
+/// pointer arrays to the device, stays outside launch, before this call.
+/// launch must only enqueue kernels on queue: it must not synchronize,
+/// allocate, or copy from pageable host memory, which can't be captured.
+/// If capture fails, launch is called again to enqueue the kernels directly.
+///
+/// Without CUDA or HIP, or if gpu_graphs() is false, calls launch.
+///
+/// @param[in] queue
+///     Queue that launch enqueues kernels on.
+///
+/// @param[in] key
+///     Key of the launches, from device_graph_key().
+///
+/// @param[in] launch
+///     Function that enqueues the kernels on queue.
+///
+void device_graph_run(
+    blas::Queue& queue, DeviceGraphKey const& key,
+    std::function< void () > const& launch )
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    if (gpu_graphs()) {
+        DeviceGraphKey stream_key = key;
+        device_graph_key_append( stream_key, queue.stream() );
+
+        void* graph = graph_cache().find( stream_key );
+        if (graph == nullptr) {
+            graph = capture( queue, launch );
+            if (graph == nullptr) {
+                launch();
+                return;
+            }
+            graph = graph_cache().insert( stream_key, graph );
+        }
+        replay( queue, graph );
+        return;
+    }
+#endif
+    launch();
+}
+
+//------------------------------------------------------------------------------
+/// Destroys all cached graphs, e.g., to release their resources after a
+/// solver finishes. Graphs are recaptured as needed.
+void device_graph_clear()
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    graph_cache().clear();
+#endif
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,137 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/DeviceQueues.hh"
+#include "slate/internal/Memory.hh"
+#include "slate/Exception.hh"
+
+#include "lapack.hh"
+
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+namespace slate {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Shared queues, per device, and the number of holders.
+/// Function-local static, so it is constructed before first use,
+/// regardless of the order of static constructors.
+struct Registry {
+    std::mutex mutex;
+    int num_holders = 0;
+    std::vector< lapack::Queue* > comm_queues;
+    std::vector< lapack::Queue* > compute_queues;
+};
+
+Registry& registry()
+{
+    static Registry registry_;
+    return registry_;
+}
+
+//------------------------------------------------------------------------------
+/// @return queues[ device ], creating it on first use.
+/// Caller holds the registry's mutex.
+lapack::Queue* get_queue( std::vector< lapack::Queue* >& queues, int device )
+{
+    slate_assert( 0 <= device && device < Memory::num_devices_ );
+    if (queues.empty())
+        queues.resize( Memory::num_devices_, nullptr );
+    if (queues[ device ] == nullptr)
+        queues[ device ] = new lapack::Queue( device );
+    return queues[ device ];
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Registers a holder of the shared queues, keeping them alive until it
+/// calls detach(). Does not create any queue. Thread safe.
+void DeviceQueues::attach()
+{
+    Registry& reg = registry();
+    std::lock_guard< std::mutex > guard( reg.mutex );
+    ++reg.num_holders;
+}
+
+//------------------------------------------------------------------------------
+/// Unregisters a holder of the shared queues. The last holder destroys
+/// them, after their work completes. Thread safe; does not throw, since
+/// it is called in destructors.
+void DeviceQueues::detach()
+{
+    Registry& reg = registry();
+    std::lock_guard< std::mutex > guard( reg.mutex );
+    assert( reg.num_holders > 0 );
+    if (--reg.num_holders == 0) {
+        for (auto queues : { &reg.comm_queues, &reg.compute_queues }) {
+            for (lapack::Queue* queue : *queues)
+                delete queue;
+            queues->clear();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return shared communication queue on device, creating it on first use.
+/// Caller must be attached. Thread safe.
+///
+/// @param[in] device
+///     Device ID, 0 <= device < number of devices.
+///
+lapack::Queue* DeviceQueues::comm_queue( int device )
+{
+    Registry& reg = registry();
+    std::lock_guard< std::mutex > guard( reg.mutex );
+    assert( reg.num_holders > 0 );
+    return get_queue( reg.comm_queues, device );
+}
+
+//------------------------------------------------------------------------------
+/// @return shared default compute queue on device, creating it on first
+/// use. Caller must be attached. Thread safe.
+///
+/// @param[in] device
+///     Device ID, 0 <= device < number of devices.
+///
+lapack::Queue* DeviceQueues::compute_queue( int device )
+{
+    Registry& reg = registry();
+    std::lock_guard< std::mutex > guard( reg.mutex );
+    assert( reg.num_holders > 0 );
+    return get_queue( reg.compute_queues, device );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if queue is one of the shared queues. Thread safe.
+bool DeviceQueues::is_shared( lapack::Queue* queue )
+{
+    if (queue == nullptr)
+        return false;
+
+    Registry& reg = registry();
+    std::lock_guard< std::mutex > guard( reg.mutex );
+    for (auto queues : { &reg.comm_queues, &reg.compute_queues }) {
+        for (lapack::Queue* q : *queues) {
+            if (q == queue)
+                return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+/// Deletes queue, unless it is shared or null, for code that holds a mix
+/// of shared and private queues. Thread safe.
+void DeviceQueues::release( lapack::Queue* queue )
+{
+    if (! is_shared( queue ))
+        delete queue;
+}
+
+} // namespace slate
@@ -0,0 +1,215 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/DeviceTopology.hh"
+#include "slate/Exception.hh"
+#include "slate/config.hh"
+
+#include "blas.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
+
+namespace slate {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// @return PCI bus id of device, in lowercase as in sysfs,
+/// or empty if unknown.
+std::string query_pci_bus_id( int device )
+{
+    char id[ 64 ] = "";
+    #if defined( BLAS_HAVE_CUBLAS )
+        if (cudaDeviceGetPCIBusId( id, sizeof( id ), device ) != cudaSuccess)
+            id[ 0 ] = '\0';
+    #elif defined( BLAS_HAVE_ROCBLAS )
+        if (hipDeviceGetPCIBusId( id, sizeof( id ), device ) != hipSuccess)
+            id[ 0 ] = '\0';
+    #endif
+    std::string str( id );
+    for (auto& c : str)
+        c = std::tolower( c );
+    return str;
+}
+
+//------------------------------------------------------------------------------
+/// @return NUMA node of the PCI device with given bus id, from sysfs,
+/// or -1 if unknown.
+int query_numa_node( std::string const& pci_bus_id )
+{
+    int node = -1;
+#if defined( __linux__ )
+    if (! pci_bus_id.empty()) {
+        std::ifstream file( "/sys/bus/pci/devices/" + pci_bus_id + "/numa_node" );
+        if (! (file >> node))
+            node = -1;
+    }
+#endif
+    return std::max( node, -1 );
+}
+
+//------------------------------------------------------------------------------
+/// @return true if device can access peer_device's memory directly.
+bool query_peer( int device, int peer_device )
+{
+    if (device == peer_device)
+        return true;
+    int can = 0;
+    #if defined( BLAS_HAVE_CUBLAS )
+        if (cudaDeviceCanAccessPeer( &can, device, peer_device ) != cudaSuccess)
+            can = 0;
+    #elif defined( BLAS_HAVE_ROCBLAS )
+        if (hipDeviceCanAccessPeer( &can, device, peer_device ) != hipSuccess)
+            can = 0;
+    #endif
+    return can != 0;
+}
+
+//------------------------------------------------------------------------------
+DeviceTopology discover_topology()
+{
+    DeviceTopology topology;
+    int num = blas::get_device_count();
+    topology.num_devices = num;
+    topology.pci_bus_id.resize( num );
+    topology.numa_node.resize( num );
+    topology.peer.assign( num, std::vector< bool >( num, false ) );
+    for (int i = 0; i < num; ++i) {
+        topology.pci_bus_id[ i ] = query_pci_bus_id( i );
+        topology.numa_node[ i ] = query_numa_node( topology.pci_bus_id[ i ] );
+        for (int j = 0; j < num; ++j)
+            topology.peer[ i ][ j ] = query_peer( i, j );
+    }
+    return topology;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// @return topology of the devices visible to this process. It is
+/// discovered on the first call, which is thread safe, and cached.
+/// Matrices discover it when they create their queues, if they have more
+/// than one device.
+///
+DeviceTopology const& device_topology()
+{
+    static DeviceTopology topology = discover_topology();
+    return topology;
+}
+
+//------------------------------------------------------------------------------
+/// Partitions the devices into groups in which each pair of devices can
+/// access each other's memory. Devices are taken in order of NUMA node, then
+/// device number, and each joins the first group it is a peer of all of;
+/// so with full NVLink or xGMI connectivity, there is one group of all
+/// devices, and without peer access, one group per device.
+///
+/// @see func::device_peer_grid, which distributes tiles to these groups.
+///
+/// @param[in] topology
+///     Device topology, by default device_topology().
+///
+/// @return groups of device numbers, each in increasing order of NUMA node,
+///         then device number.
+///
+std::vector< std::vector< int > > device_peer_groups(
+    DeviceTopology const& topology )
+{
+    int num = topology.num_devices;
+    std::vector< int > order( num );
+    for (int i = 0; i < num; ++i)
+        order[ i ] = i;
+    std::stable_sort( order.begin(), order.end(),
+        [&topology]( int a, int b ) {
+            return topology.numa_node[ a ] < topology.numa_node[ b ];
+        });
+
+    std::vector< std::vector< int > > groups;
+    for (int device : order) {
+        auto is_peer = [&topology, device]( int other ) {
+            return topology.peer[ device ][ other ]
+                   && topology.peer[ other ][ device ];
+        };
+        auto group = std::find_if( groups.begin(), groups.end(),
+            [&is_peer]( std::vector< int > const& g ) {
+                return std::all_of( g.begin(), g.end(), is_peer );
+            });
+        if (group == groups.end())
+            groups.push_back( { device } );
+        else
+            group->push_back( device );
+    }
+    return groups;
+}
+
+//------------------------------------------------------------------------------
+/// Enables peer access between each pair of devices that supports it, so
+/// device-to-device tile copies, such as from the device owning a tile to
+/// the other devices of a gemm or herk update, go directly between the
+/// devices instead of being staged through the host.
+/// Done once per process, unless gpu_peer_access() is false.
+/// Called when a matrix with more than one device creates its queues.
+/// Restores the current device.
+///
+void enable_peer_access()
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    if (! gpu_peer_access())
+        return;
+
+    static bool enabled = []() {
+        DeviceTopology const& topology = device_topology();
+        int num = topology.num_devices;
+        if (num < 2)
+            return true;
+
+        #if defined( BLAS_HAVE_CUBLAS )
+            int current;
+            slate_assert( cudaGetDevice( &current ) == cudaSuccess );
+            for (int i = 0; i < num; ++i) {
+                slate_assert( cudaSetDevice( i ) == cudaSuccess );
+                for (int j = 0; j < num; ++j) {
+                    if (i != j && topology.peer[ i ][ j ]) {
+                        cudaError_t err = cudaDeviceEnablePeerAccess( j, 0 );
+                        if (err == cudaErrorPeerAccessAlreadyEnabled)
+                            cudaGetLastError();  // clear error
+                        else
+                            slate_assert( err == cudaSuccess );
+                    }
+                }
+            }
+            slate_assert( cudaSetDevice( current ) == cudaSuccess );
+        #else
+            int current;
+            slate_assert( hipGetDevice( &current ) == hipSuccess );
+            for (int i = 0; i < num; ++i) {
+                slate_assert( hipSetDevice( i ) == hipSuccess );
+                for (int j = 0; j < num; ++j) {
+                    if (i != j && topology.peer[ i ][ j ]) {
+                        hipError_t err = hipDeviceEnablePeerAccess( j, 0 );
+                        if (err == hipErrorPeerAccessAlreadyEnabled)
+                            hipGetLastError();  // clear error
+                        else
+                            slate_assert( err == hipSuccess );
+                    }
+                }
+            }
+            slate_assert( hipSetDevice( current ) == hipSuccess );
+        #endif
+        return true;
+    }();
+    (void) enabled;
+#endif
+}
+
+} // namespace slate
@@ -0,0 +1,226 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/FlopStats.hh"
+#include "slate/CommStats.hh"
+#include "slate/method.hh"
+#include "slate/internal/Memory.hh"
+#include "slate/internal/openmp.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace slate {
+
+namespace {
+
+using internal::FlopRoutine;
+
+const int num_routines = int( FlopRoutine::Count );
+const int num_targets  = 4;
+
+const char* routine_names[ num_routines ] = {
+    "gemm", "herk", "trsm", "potrf", "getrf_panel"
+};
+
+const bool routine_is_panel[ num_routines ] = {
+    false, false, false, true, true
+};
+
+const char* target_names[ num_targets ] = {
+    "HostTask", "HostNest", "HostBatch", "Devices"
+};
+
+/// @return index of target in target_names. Host counts as HostTask.
+int target_index( Target target )
+{
+    switch (target) {
+        case Target::HostNest:  return 1;
+        case Target::HostBatch: return 2;
+        case Target::Devices:   return 3;
+        default:                return 0;
+    }
+}
+
+/// Whether counting is enabled.
+bool g_enabled = false;
+
+/// Counters, by routine and target, in critical(slate_flop_stats).
+FlopStats g_stats[ num_routines ][ num_targets ];
+
+/// Communication wait time at the last reset, to report the wait since.
+double g_wait_time_start = 0;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Enables or disables counting flops and time of internal routines
+/// (gemm, herk, trsm, potrf, getrf_panel). Disabled by default.
+void flop_stats_enable( bool enable )
+{
+    g_enabled = enable;
+}
+
+//------------------------------------------------------------------------------
+/// @return whether counting flops is enabled.
+bool flop_stats_enabled()
+{
+    return g_enabled;
+}
+
+//------------------------------------------------------------------------------
+/// @return this rank's flop counters, by "routine (target)", e.g.,
+/// "gemm (Devices)", for routines and targets that were called.
+std::map< std::string, FlopStats > flop_stats()
+{
+    std::map< std::string, FlopStats > stats;
+    #pragma omp critical(slate_flop_stats)
+    {
+        for (int r = 0; r < num_routines; ++r) {
+            for (int t = 0; t < num_targets; ++t) {
+                if (g_stats[ r ][ t ].calls > 0) {
+                    std::string name = std::string( routine_names[ r ] )
+                                     + " (" + target_names[ t ] + ")";
+                    stats[ name ] = g_stats[ r ][ t ];
+                }
+            }
+        }
+    }
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets the flop counters to zero, and starts the communication wait
+/// time reported by flop_stats_report.
+void flop_stats_reset()
+{
+    double wait_time = comm_stats().wait_time;
+    #pragma omp critical(slate_flop_stats)
+    {
+        for (int r = 0; r < num_routines; ++r) {
+            for (int t = 0; t < num_targets; ++t) {
+                g_stats[ r ][ t ] = FlopStats();
+            }
+        }
+        g_wait_time_start = wait_time;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Sums the flop counters over the ranks in comm and prints on rank 0, for
+/// each routine and target, the calls, Gflop, time per rank, achieved rate
+/// per rank, and its fraction of the peak rate of CostModel::machine():
+/// host_flop_rate for host targets, device_flop_rate times the number of
+/// devices for Devices. Then prints the same for the panel phase
+/// (potrf, getrf_panel) and the update phase (gemm, herk, trsm), and the
+/// communication phase as time in MPI waits (see comm_stats).
+/// Collective on comm.
+///
+/// @param[in] comm
+///     MPI communicator.
+///
+/// @param[in] file
+///     File to print to, on rank 0. Default stdout.
+///
+void flop_stats_report( MPI_Comm comm, FILE* file )
+{
+    int mpi_rank, mpi_size;
+    slate_mpi_call(
+        MPI_Comm_rank( comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_size( comm, &mpi_size ) );
+
+    // [ calls, flops, time ] per routine and target, then the wait time.
+    const int count = 3*num_routines*num_targets + 1;
+    std::vector<double> local( count ), sum( count );
+    double wait_time = comm_stats().wait_time;
+    #pragma omp critical(slate_flop_stats)
+    {
+        int k = 0;
+        for (int r = 0; r < num_routines; ++r) {
+            for (int t = 0; t < num_targets; ++t) {
+                local[ k++ ] = g_stats[ r ][ t ].calls;
+                local[ k++ ] = g_stats[ r ][ t ].flops;
+                local[ k++ ] = g_stats[ r ][ t ].time;
+            }
+        }
+        local[ k ] = wait_time - g_wait_time_start;
+    }
+    slate_mpi_call(
+        MPI_Reduce( local.data(), sum.data(), count, MPI_DOUBLE, MPI_SUM,
+                    0, comm ) );
+    if (mpi_rank != 0)
+        return;
+
+    auto& machine = CostModel::machine();
+    double peaks[ num_targets ];
+    for (int t = 0; t < num_targets; ++t)
+        peaks[ t ] = machine.host_flop_rate;
+    peaks[ 3 ] = machine.device_flop_rate * std::max( Memory::num_devices_, 1 );
+
+    // Time and rate are per rank: time summed over ranks / mpi_size.
+    auto print_row = [&]( const char* name, const char* target,
+                          double calls, double flops, double time,
+                          double peak )
+    {
+        double time_rank = time / mpi_size;
+        double rate = time > 0 ? flops / time : 0;
+        fprintf( file, "%-12s  %-9s  %8.0f  %10.2f  %10.4f  %10.2f",
+                 name, target, calls, flops * 1e-9, time_rank, rate * 1e-9 );
+        if (peak > 0)
+            fprintf( file, "  %6.1f%%\n", 100 * rate / peak );
+        else
+            fprintf( file, "  %7s\n", "" );
+    };
+
+    fprintf( file, "%-12s  %-9s  %8s  %10s  %10s  %10s  %7s\n",
+             "routine", "target", "calls", "Gflop", "time/rank",
+             "Gflop/s", "% peak" );
+    double phase_flops[ 2 ] = { 0, 0 }, phase_time[ 2 ] = { 0, 0 };
+    double phase_calls[ 2 ] = { 0, 0 };
+    int k = 0;
+    for (int r = 0; r < num_routines; ++r) {
+        for (int t = 0; t < num_targets; ++t) {
+            double calls = sum[ k++ ];
+            double flops = sum[ k++ ];
+            double time  = sum[ k++ ];
+            if (calls > 0) {
+                print_row( routine_names[ r ], target_names[ t ],
+                           calls, flops, time, peaks[ t ] );
+                int phase = routine_is_panel[ r ] ? 0 : 1;
+                phase_calls[ phase ] += calls;
+                phase_flops[ phase ] += flops;
+                phase_time [ phase ] += time;
+            }
+        }
+    }
+    print_row( "panel",  "", phase_calls[ 0 ], phase_flops[ 0 ],
+               phase_time[ 0 ], 0 );
+    print_row( "update", "", phase_calls[ 1 ], phase_flops[ 1 ],
+               phase_time[ 1 ], 0 );
+    fprintf( file, "%-12s  %-9s  %8s  %10s  %10.4f\n",
+             "comm wait", "", "", "", sum[ k ] / mpi_size );
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Adds a call of routine on target, of flops in time seconds.
+void flop_stats_record( FlopRoutine routine, Target target,
+                        double flops, double time )
+{
+    int r = int( routine );
+    int t = target_index( target );
+    #pragma omp critical(slate_flop_stats)
+    {
+        g_stats[ r ][ t ].calls += 1;
+        g_stats[ r ][ t ].flops += flops;
+        g_stats[ r ][ t ].time  += time;
+    }
+}
+
+} // namespace internal
+
+} // namespace slate
@@ -6,19 +6,79 @@
 #include "auxiliary/Debug.hh"
 #include "slate/internal/Memory.hh"
 #include "slate/Exception.hh"
+#include "slate/config.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#if defined( __linux__ )
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+#endif
+
+#if defined( BLAS_HAVE_CUBLAS )
+    #include <cuda_runtime.h>
+#elif defined( BLAS_HAVE_ROCBLAS )
+    #include <hip/hip_runtime.h>
+#endif
 
 namespace slate {
 
 int Memory::num_devices_;
+int Memory::num_numa_nodes_ = 1;
+// Defined before static_constructor_, which sizes it.
+std::vector< MemoryStats > Memory::total_stats_;
 Memory::StaticConstructor Memory::static_constructor_;
 
+namespace {
+
+/// Memory usage of top-level driver calls, by driver name, then device+1.
+/// In critical(slate_memory_stats).
+std::map< std::string, std::vector< MemoryStats > > g_driver_stats;
+
+/// Depth of nested MemoryStatsScope on this thread.
+thread_local int g_scope_depth = 0;
+
+//------------------------------------------------------------------------------
+/// Waits for all work on device, on every queue.
+/// Keeps the current device of the calling thread.
+///
+void syncDevice(int device)
+{
+#if defined( BLAS_HAVE_CUBLAS )
+    int current;
+    cudaGetDevice( &current );
+    cudaSetDevice( device );
+    slate_assert( cudaDeviceSynchronize() == cudaSuccess );
+    cudaSetDevice( current );
+#elif defined( BLAS_HAVE_ROCBLAS )
+    int current;
+    hipGetDevice( &current );
+    hipSetDevice( device );
+    slate_assert( hipDeviceSynchronize() == hipSuccess );
+    hipSetDevice( current );
+#endif
+}
+
+} // namespace
+
 //------------------------------------------------------------------------------
 /// Construct saves block size, but does not allocate any memory.
 Memory::Memory(size_t block_size):
     block_size_(block_size),
     free_blocks_( num_devices_ ),
     allocated_mem_( num_devices_ ),
-    capacity_( num_devices_ )
+    capacity_( num_devices_ ),
+    host_capacity_( 0 ),
+    size_classes_( num_devices_ + 1 ),
+    large_blocks_( num_devices_ + 1 ),
+    numa_allocated_( num_numa_nodes_, 0 ),
+    stats_( num_devices_ + 1 )
 {
 }
 
@@ -31,30 +91,51 @@ Memory::~Memory()
     // needed to release memory (and can't be passed in here).  So to
     // release the memory, an explicit clear must called using the
     // queue parameter ( Memory::clearDeviceBlocks(device, *queue) ).
-    //assert(capacity_[ HostNum ] == 0);
+    assert(host_capacity_ == 0);
     for (int device = 0; device < num_devices_; ++device) {
         assert(capacity_[ device ] == 0);
     }
     // Debug::printNumFreeMemBlocks(*this);
 }
 
-/*
 //------------------------------------------------------------------------------
 /// Allocates num_blocks in host memory
 /// and adds them to the pool of free blocks.
 ///
+/// @param[in] num_blocks
+///     Number of blocks to add.
+///
+/// @param[in] queue
+///     If not null, the blocks are allocated in pinned memory using queue's
+///     device context. Otherwise, the blocks are page-aligned pageable memory.
+///
 // todo: merge with addDeviceBlocks by recognizing HostNum?
-void Memory::addHostBlocks(int64_t num_blocks)
+void Memory::addHostBlocks(int64_t num_blocks, blas::Queue *queue)
 {
+    if (num_blocks <= 0)
+        return;
+
+    // Pinning is slow (it maps pages for the device), so allocate
+    // outside the critical section; only the bookkeeping is in it.
     // or std::byte* (C++17)
     uint8_t* host_mem;
-    host_mem = (uint8_t*) allocHostMemory(block_size_*num_blocks);
-    capacity_[ HostNum ] += num_blocks;
+    host_mem = (uint8_t*) allocHostMemory(block_size_*num_blocks, queue);
+
+    #pragma omp critical(slate_memory)
+    {
+        allocated_host_mem_.push( { host_mem, queue != nullptr } );
+        host_capacity_ += num_blocks;
+        countPooled( HostNum, block_size_*num_blocks );
+        #pragma omp critical(slate_memory_stats)
+        {
+            stats_[ 0 ].growths += 1;
+            total_stats_[ 0 ].growths += 1;
+        }
 
-    for (int64_t i = 0; i < num_blocks; ++i)
-        free_blocks_[ HostNum ].push(host_mem + i*block_size_);
+        for (int64_t i = 0; i < num_blocks; ++i)
+            free_host_blocks_.push(host_mem + i*block_size_);
+    }
 }
-*/
 
 //------------------------------------------------------------------------------
 /// Allocates num_blocks in given device's memory
@@ -62,35 +143,50 @@ void Memory::addHostBlocks(int64_t num_blocks)
 ///
 void Memory::addDeviceBlocks(int device, int64_t num_blocks, blas::Queue *queue)
 {
-    // or std::byte* (C++17)
-    uint8_t* dev_mem;
-    dev_mem = (uint8_t*) allocDeviceMemory(device, block_size_*num_blocks, queue);
-    capacity_[device] += num_blocks;
+    #pragma omp critical(slate_memory)
+    {
+        // or std::byte* (C++17)
+        uint8_t* dev_mem;
+        dev_mem = (uint8_t*) allocDeviceMemory(device, block_size_*num_blocks, queue);
+        capacity_[device] += num_blocks;
+        countPooled( device, block_size_*num_blocks );
+        #pragma omp critical(slate_memory_stats)
+        {
+            stats_[ device+1 ].growths += 1;
+            total_stats_[ device+1 ].growths += 1;
+        }
 
-    for (int64_t i = 0; i < num_blocks; ++i)
-        free_blocks_[device].push(dev_mem + i*block_size_);
+        for (int64_t i = 0; i < num_blocks; ++i)
+            free_blocks_[device].push(dev_mem + i*block_size_);
+    }
 }
 
-/*
 //------------------------------------------------------------------------------
 /// Empties the pool of free blocks of host memory and frees the allocations.
 ///
+/// @param[in] queue
+///     Queue used to free pinned host memory.
+///     Required if any blocks were allocated with a queue.
+///
 // todo: merge with clearDeviceBlocks by recognizing HostNum?
-void Memory::clearHostBlocks()
+void Memory::clearHostBlocks(blas::Queue *queue)
 {
     Debug::checkHostMemoryLeaks(*this);
 
-    while (! free_blocks_[ HostNum ].empty())
-        free_blocks_[ HostNum ].pop();
+    countPooled( HostNum, -stats( HostNum ).pooled );
+    while (! free_host_blocks_.empty())
+        free_host_blocks_.pop();
 
-    while (! allocated_mem_[ HostNum ].empty()) {
-        void* host_mem = allocated_mem_[ HostNum ].top();
-        freeHostMemory( host_mem );
-        allocated_mem_[ HostNum ].pop();
+    while (! allocated_host_mem_.empty()) {
+        auto host_mem = allocated_host_mem_.top();
+        freeHostMemory( host_mem.first, host_mem.second, queue );
+        allocated_host_mem_.pop();
     }
-    capacity_[ HostNum ] = 0;
+    host_capacity_ = 0;
+    clearSizeClasses( HostNum );
+    host_numa_nodes_.clear();
+    std::fill( numa_allocated_.begin(), numa_allocated_.end(), 0 );
 }
-*/
 
 //------------------------------------------------------------------------------
 /// Empties the pool of free blocks of given device's memory and frees the
@@ -98,44 +194,522 @@ void Memory::clearHostBlocks()
 ///
 void Memory::clearDeviceBlocks(int device, blas::Queue *queue)
 {
+    countPooled( device, -stats( device ).pooled );
     while (! free_blocks_[device].empty())
         free_blocks_[device].pop();
 
+    // Blocks may have last been used by kernels on any of the device's
+    // compute queues, which queue knows nothing of, so wait for all of
+    // them before stream-ordered frees, as cudaFree does implicitly.
+    // Later allocations on queue are ordered after the frees.
+    bool synced = false;
     while (! allocated_mem_[device].empty()) {
-        void* dev_mem = allocated_mem_[device].top();
-        freeDeviceMemory(device, dev_mem, queue);
+        auto dev_mem = allocated_mem_[device].top();
+        if (dev_mem.second && ! synced) {
+            syncDevice( device );
+            synced = true;
+        }
+        freeDeviceMemory(device, dev_mem.first, dev_mem.second, queue);
         allocated_mem_[device].pop();
     }
     capacity_[device] = 0;
+    clearSizeClasses( device );
 
     Debug::checkDeviceMemoryLeaks(*this, device);
 }
 
+//------------------------------------------------------------------------------
+/// Frees host memory, as clearHostBlocks does, but only if no host
+/// block is in use. The check and clear are atomic with respect to
+/// alloc and free, so this is safe for pools shared by several matrices.
+///
+/// @return true if the memory was freed.
+///
+bool Memory::releaseHostBlocks(blas::Queue *queue)
+{
+    bool released = false;
+    #pragma omp critical(slate_memory)
+    {
+        if (allocated( HostNum ) == 0) {
+            clearHostBlocks( queue );
+            released = true;
+        }
+    }
+    return released;
+}
+
+//------------------------------------------------------------------------------
+/// Frees given device's memory, as clearDeviceBlocks does, but only if
+/// no block is in use on device. The check and clear are atomic with
+/// respect to alloc and free, so this is safe for pools shared by several
+/// matrices.
+///
+/// @return true if the memory was freed.
+///
+bool Memory::releaseDeviceBlocks(int device, blas::Queue *queue)
+{
+    bool released = false;
+    #pragma omp critical(slate_memory)
+    {
+        if (allocated( device ) == 0) {
+            clearDeviceBlocks( device, queue );
+            released = true;
+        }
+    }
+    return released;
+}
+
+//------------------------------------------------------------------------------
+/// @return process-wide pool for blocks of block_size bytes, shared by all
+/// matrices that opt into it. Created on first use. Its memory is freed by
+/// releaseHostBlocks and releaseDeviceBlocks once no matrix uses it.
+///
+Memory& Memory::shared(size_t block_size)
+{
+    static std::map< size_t, std::unique_ptr< Memory > > pools;
+
+    Memory* pool;
+    #pragma omp critical(slate_memory_shared)
+    {
+        auto& ptr = pools[ block_size ];
+        if (ptr == nullptr)
+            ptr.reset( new Memory( block_size ) );
+        pool = ptr.get();
+    }
+    return *pool;
+}
+
+//------------------------------------------------------------------------------
+/// @return this pool's usage counters on device, which can be host.
+///
+MemoryStats Memory::stats(int device) const
+{
+    MemoryStats stats;
+    #pragma omp critical(slate_memory_stats)
+    stats = stats_[ device+1 ];
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets this pool's peaks on device, which can be host, to the current
+/// usage.
+///
+void Memory::resetPeak(int device)
+{
+    #pragma omp critical(slate_memory_stats)
+    {
+        MemoryStats& stats = stats_[ device+1 ];
+        stats.peak_in_use = stats.in_use;
+        stats.peak_pooled = stats.pooled;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return usage counters of all pools in the process on device, which can
+/// be host. The peaks are of the sums over pools, so peak_pooled is the
+/// most memory SLATE's pools held on the device at once.
+///
+MemoryStats Memory::totalStats(int device)
+{
+    MemoryStats stats;
+    #pragma omp critical(slate_memory_stats)
+    stats = total_stats_[ device+1 ];
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets the process-wide peaks on host and all devices to the current
+/// usage.
+///
+void Memory::resetTotalPeaks()
+{
+    #pragma omp critical(slate_memory_stats)
+    {
+        for (auto& stats : total_stats_) {
+            stats.peak_in_use = stats.in_use;
+            stats.peak_pooled = stats.pooled;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return memory usage of top-level driver calls, by driver name, e.g.,
+/// "gesv", then by device+1, so host is index 0. Peaks are the max over
+/// calls; counts are summed over calls; in use and pooled are at the end
+/// of the last call.
+///
+std::map< std::string, std::vector< MemoryStats > > Memory::driverStats()
+{
+    std::map< std::string, std::vector< MemoryStats > > stats;
+    #pragma omp critical(slate_memory_stats)
+    stats = g_driver_stats;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Counts an alloc of a block of bytes on device, which can be host;
+/// fallback if no free block was available, so memory is allocated.
+///
+void Memory::countAlloc(int device, int64_t bytes, bool fallback)
+{
+    #pragma omp critical(slate_memory_stats)
+    {
+        for (MemoryStats* stats : { &stats_[ device+1 ],
+                                    &total_stats_[ device+1 ] }) {
+            stats->in_use += bytes;
+            stats->peak_in_use = std::max( stats->peak_in_use, stats->in_use );
+            stats->allocs += 1;
+            if (fallback)
+                stats->fallbacks += 1;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Counts a free of a block of bytes on device, which can be host.
+///
+void Memory::countFree(int device, int64_t bytes)
+{
+    #pragma omp critical(slate_memory_stats)
+    {
+        for (MemoryStats* stats : { &stats_[ device+1 ],
+                                    &total_stats_[ device+1 ] }) {
+            stats->in_use -= bytes;
+            stats->frees += 1;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Counts bytes allocated from the system on device, which can be host,
+/// or freed to it if bytes < 0.
+///
+void Memory::countPooled(int device, int64_t bytes)
+{
+    #pragma omp critical(slate_memory_stats)
+    {
+        for (MemoryStats* stats : { &stats_[ device+1 ],
+                                    &total_stats_[ device+1 ] }) {
+            stats->pooled += bytes;
+            stats->peak_pooled = std::max( stats->peak_pooled, stats->pooled );
+        }
+    }
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Starts recording the memory usage of driver name, if it is not nested
+/// in another driver.
+///
+MemoryStatsScope::MemoryStatsScope(
+    const char* name, MPI_Comm comm, Options const& opts )
+    : name_( name ),
+      comm_( comm ),
+      verbose_( get_option<int>( opts, Option::PrintVerbose, 0 ) ),
+      outer_( g_scope_depth == 0 )
+{
+    ++g_scope_depth;
+    if (outer_) {
+        Memory::resetTotalPeaks();
+        for (int device = HostNum; device < Memory::num_devices_; ++device)
+            start_.push_back( Memory::totalStats( device ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Adds the memory usage since the constructor to the driver's record,
+/// and prints it if verbose.
+///
+MemoryStatsScope::~MemoryStatsScope()
+{
+    --g_scope_depth;
+    if (! outer_)
+        return;
+
+    int num = Memory::num_devices_ + 1;
+    std::vector< MemoryStats > stats( num );
+    for (int device = HostNum; device < Memory::num_devices_; ++device) {
+        MemoryStats& end = stats[ device+1 ];
+        MemoryStats const& start = start_[ device+1 ];
+        end = Memory::totalStats( device );
+        end.allocs    -= start.allocs;
+        end.frees     -= start.frees;
+        end.growths   -= start.growths;
+        end.fallbacks -= start.fallbacks;
+    }
+
+    #pragma omp critical(slate_memory_stats)
+    {
+        auto& record = g_driver_stats[ name_ ];
+        record.resize( num );
+        for (int i = 0; i < num; ++i) {
+            record[ i ].in_use      = stats[ i ].in_use;
+            record[ i ].pooled      = stats[ i ].pooled;
+            record[ i ].peak_in_use = std::max( record[ i ].peak_in_use,
+                                                stats[ i ].peak_in_use );
+            record[ i ].peak_pooled = std::max( record[ i ].peak_pooled,
+                                                stats[ i ].peak_pooled );
+            record[ i ].allocs    += stats[ i ].allocs;
+            record[ i ].frees     += stats[ i ].frees;
+            record[ i ].growths   += stats[ i ].growths;
+            record[ i ].fallbacks += stats[ i ].fallbacks;
+        }
+    }
+
+    // Printing is collective; skip it while unwinding an error,
+    // as other ranks may not get here.
+    if (verbose_ >= 1 && std::uncaught_exceptions() == 0) {
+        // [ host in use, host pooled, device in use, device pooled,
+        //   fallbacks ], with the max over devices.
+        double local[ 5 ] = { double( stats[ 0 ].peak_in_use ),
+                              double( stats[ 0 ].peak_pooled ), 0, 0,
+                              double( stats[ 0 ].fallbacks ) };
+        for (int i = 1; i < num; ++i) {
+            local[ 2 ] = std::max( local[ 2 ], double( stats[ i ].peak_in_use ) );
+            local[ 3 ] = std::max( local[ 3 ], double( stats[ i ].peak_pooled ) );
+            local[ 4 ] += stats[ i ].fallbacks;
+        }
+        double max[ 5 ];
+        int mpi_rank;
+        MPI_Comm_rank( comm_, &mpi_rank );
+        MPI_Reduce( local, max, 5, MPI_DOUBLE, MPI_MAX, 0, comm_ );
+        if (mpi_rank == 0) {
+            printf( "slate::%s: peak memory, max over ranks:"
+                    " host %.3g MB in use, %.3g MB pooled;"
+                    " per device %.3g MB in use, %.3g MB pooled;"
+                    " %.0f fallback allocations\n",
+                    name_, max[ 0 ] * 1e-6, max[ 1 ] * 1e-6,
+                    max[ 2 ] * 1e-6, max[ 3 ] * 1e-6, max[ 4 ] );
+        }
+    }
+}
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Moves all blocks of given device, which can be host, from src into this
+/// pool, including size classes, without allocating or freeing memory.
+/// Afterwards, src has no blocks on device. Both pools must have the same
+/// block size, and none of src's blocks on device can be in use.
+///
+void Memory::moveBlocks(Memory& src, int device)
+{
+    slate_assert( block_size_ == src.block_size_ );
+    slate_assert( src.allocated( device ) == 0 );
+
+    #pragma omp critical(slate_memory)
+    {
+        if (device == HostNum) {
+            while (! src.free_host_blocks_.empty()) {
+                free_host_blocks_.push( src.free_host_blocks_.top() );
+                src.free_host_blocks_.pop();
+            }
+            while (! src.allocated_host_mem_.empty()) {
+                allocated_host_mem_.push( src.allocated_host_mem_.top() );
+                src.allocated_host_mem_.pop();
+            }
+            host_capacity_ += src.host_capacity_;
+            src.host_capacity_ = 0;
+            // Blocks are distinct allocations, so keys don't collide.
+            host_numa_nodes_.merge( src.host_numa_nodes_ );
+            src.host_numa_nodes_.clear();
+        }
+        else {
+            while (! src.free_blocks_[ device ].empty()) {
+                free_blocks_[ device ].push( src.free_blocks_[ device ].top() );
+                src.free_blocks_[ device ].pop();
+            }
+            while (! src.allocated_mem_[ device ].empty()) {
+                allocated_mem_[ device ].push( src.allocated_mem_[ device ].top() );
+                src.allocated_mem_[ device ].pop();
+            }
+            capacity_[ device ] += src.capacity_[ device ];
+            src.capacity_[ device ] = 0;
+        }
+
+        auto& classes     = size_classes_[ device+1 ];
+        auto& src_classes = src.size_classes_[ device+1 ];
+        if (classes.size() < src_classes.size())
+            classes.resize( src_classes.size() );
+        for (size_t k = 0; k < src_classes.size(); ++k) {
+            auto& src_blocks = src_classes[ k ].free_blocks;
+            while (! src_blocks.empty()) {
+                classes[ k ].free_blocks.push( src_blocks.top() );
+                src_blocks.pop();
+            }
+            classes[ k ].capacity += src_classes[ k ].capacity;
+        }
+        // Large blocks are distinct allocations, so keys don't collide.
+        large_blocks_[ device+1 ].merge( src.large_blocks_[ device+1 ] );
+        src.clearSizeClasses( device );
+
+        // Pooled bytes move too; process-wide totals don't change.
+        #pragma omp critical(slate_memory_stats)
+        {
+            MemoryStats& stats = stats_[ device+1 ];
+            stats.pooled += src.stats_[ device+1 ].pooled;
+            stats.peak_pooled = std::max( stats.peak_pooled, stats.pooled );
+            src.stats_[ device+1 ].pooled = 0;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Resets the size classes of given device, which can be host.
+/// The memory itself is freed with the other allocations of the device.
+///
+void Memory::clearSizeClasses(int device)
+{
+    size_classes_[ device+1 ].clear();
+    large_blocks_[ device+1 ].clear();
+}
+
+//------------------------------------------------------------------------------
+/// @return size class for a block of size bytes: 0 if size <= block_size,
+/// otherwise the smallest k such that size <= block_size * 2^k.
+///
+int Memory::sizeClass(size_t size) const
+{
+    if (size <= block_size_)
+        return 0;
+
+    slate_assert( block_size_ > 0 );
+    int size_class = 1;
+    while (classBlockSize( size_class ) < size)
+        ++size_class;
+    return size_class;
+}
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Binds the whole pages in [ptr, ptr + size) to numa_node, moving pages
+/// already touched on another node. Errors are ignored, e.g., for pinned
+/// memory, since placement is only a performance hint.
+/// Uses the mbind system call directly, to avoid depending on libnuma.
+///
+void bind_numa_node(void* ptr, size_t size, int numa_node)
+{
+#if defined( __linux__ ) && defined( SYS_mbind )
+    // From <numaif.h>.
+    const int mpol_preferred = 1;
+    const unsigned mpol_mf_move = 1 << 1;
+
+    uintptr_t page_size = sysconf( _SC_PAGESIZE );
+    uintptr_t begin = (uintptr_t( ptr ) + page_size - 1) / page_size * page_size;
+    uintptr_t end   = (uintptr_t( ptr ) + size) / page_size * page_size;
+    if (end <= begin)
+        return;
+
+    const int bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask( numa_node / bits + 2, 0 );
+    mask[ numa_node / bits ] |= 1UL << (numa_node % bits);
+    syscall( SYS_mbind, begin, end - begin, mpol_preferred,
+             mask.data(), mask.size() * bits, mpol_mf_move );
+#endif
+}
+
+}  // anonymous namespace
+
+//------------------------------------------------------------------------------
+/// @return number of NUMA nodes, counted from /sys on Linux, or 1.
+///
+int Memory::numaNodeCount()
+{
+    int count = 0;
+#if defined( __linux__ )
+    std::string path = "/sys/devices/system/node/node";
+    while (access( (path + std::to_string( count )).c_str(), F_OK ) == 0)
+        ++count;
+#endif
+    return std::max( count, 1 );
+}
+
 //------------------------------------------------------------------------------
 /// @return single block of memory on the given device, which can be host,
 /// either from free blocks or by allocating a new block.
+/// If size > block_size, the block comes from the matching size class.
 ///
-void* Memory::alloc(int device, size_t size, blas::Queue* queue)
+/// @param[in] numa_node
+///     For host blocks, if numa_node >= 0 and there are several NUMA
+///     nodes, the block is placed on NUMA node
+///     (numa_node mod num_numa_nodes_). Otherwise, it is ignored.
+///
+void* Memory::alloc(int device, size_t size, blas::Queue* queue,
+                    int numa_node)
 {
     void* block;
+    int size_class = sizeClass( size );
+    bool place = device == HostNum && numa_node >= 0 && num_numa_nodes_ > 1;
+    if (place)
+        numa_node %= num_numa_nodes_;
+    bool bind = false;
 
-    if (device == HostNum) {
-        //block = malloc(size);
-        block = new char[size];
-    }
-    else {
-        slate_assert( size <= block_size_ );
-        // this block for device only
-        #pragma omp critical(slate_memory)
-        {
-            if (free_blocks_[device].size() > 0) {
-                block = free_blocks_[device].top();
-                free_blocks_[device].pop();
+    #pragma omp critical(slate_memory)
+    {
+        bool fallback = available( device, size_class ) == 0;
+        countAlloc( device, classBlockSize( size_class ), fallback );
+
+        if (size_class > 0) {
+            block = allocLargeBlock( device, size_class, queue );
+        }
+        else {
+            std::stack<void*>& free_blocks = (device == HostNum
+                                              ? free_host_blocks_
+                                              : free_blocks_[device]);
+            if (free_blocks.size() > 0) {
+                block = free_blocks.top();
+                free_blocks.pop();
             }
             else {
                 block = allocBlock(device, queue);
             }
         }
+        if (place) {
+            auto iter = host_numa_nodes_.find( block );
+            bind = iter == host_numa_nodes_.end() || iter->second != numa_node;
+            host_numa_nodes_[ block ] = numa_node;
+        }
+        if (device == HostNum && ! host_numa_nodes_.empty()) {
+            auto iter = host_numa_nodes_.find( block );
+            if (iter != host_numa_nodes_.end())
+                ++numa_allocated_[ iter->second ];
+        }
+    }
+    // Bind outside the critical section, as it may move pages.
+    if (bind)
+        bind_numa_node( block, classBlockSize( size_class ), numa_node );
+    return block;
+}
+
+//------------------------------------------------------------------------------
+/// @return single free block of memory on the given device, which can be
+/// host, or nullptr if none is free. Unlike alloc, never grows the pool,
+/// so callers can use an optional workspace when memory is at hand.
+/// Only blocks of the default size class are returned.
+///
+void* Memory::allocIfAvailable(int device, size_t size)
+{
+    if (sizeClass( size ) > 0)
+        return nullptr;
+
+    void* block = nullptr;
+    #pragma omp critical(slate_memory)
+    {
+        std::stack<void*>& free_blocks = (device == HostNum
+                                          ? free_host_blocks_
+                                          : free_blocks_[device]);
+        if (free_blocks.size() > 0) {
+            countAlloc( device, block_size_, false );
+            block = free_blocks.top();
+            free_blocks.pop();
+            if (device == HostNum && ! host_numa_nodes_.empty()) {
+                auto iter = host_numa_nodes_.find( block );
+                if (iter != host_numa_nodes_.end())
+                    ++numa_allocated_[ iter->second ];
+            }
+        }
     }
     return block;
 }
@@ -146,75 +720,235 @@ void* Memory::alloc(int device, size_t size, blas::Queue* queue)
 ///
 void Memory::free(void* block, int device)
 {
-    if (device == HostNum) {
-        //std::free(block);
-        delete[] (char*)block;
+    #pragma omp critical(slate_memory)
+    {
+        auto& large_blocks = large_blocks_[ device+1 ];
+        auto iter = (large_blocks.empty() ? large_blocks.end()
+                                          : large_blocks.find( block ));
+        int size_class = 0;
+        if (iter != large_blocks.end()) {
+            size_class = iter->second;
+            size_classes_[ device+1 ][ size_class-1 ].free_blocks.push( block );
+        }
+        else if (device == HostNum)
+            free_host_blocks_.push(block);
+        else
+            free_blocks_[device].push(block);
+
+        if (device == HostNum && ! host_numa_nodes_.empty()) {
+            auto numa_iter = host_numa_nodes_.find( block );
+            if (numa_iter != host_numa_nodes_.end())
+                --numa_allocated_[ numa_iter->second ];
+        }
+        countFree( device, classBlockSize( size_class ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return single block of given size class > 0 on the given device,
+/// which can be host, either from the class's free blocks or by allocating
+/// a new block. Must be called inside the slate_memory critical section.
+///
+void* Memory::allocLargeBlock(int device, int size_class, blas::Queue *queue)
+{
+    auto& classes = size_classes_[ device+1 ];
+    if (int(classes.size()) < size_class)
+        classes.resize( size_class );
+
+    auto& pool = classes[ size_class-1 ];
+    void* block;
+    if (pool.free_blocks.size() > 0) {
+        block = pool.free_blocks.top();
+        pool.free_blocks.pop();
     }
     else {
-        #pragma omp critical(slate_memory)
-        {
-            free_blocks_[device].push(block);
+        size_t size = classBlockSize( size_class );
+        if (device == HostNum) {
+            block = allocHostMemory( size, queue );
+            allocated_host_mem_.push( { block, queue != nullptr } );
         }
+        else
+            block = allocDeviceMemory( device, size, queue );
+        pool.capacity += 1;
+        countPooled( device, size );
+        large_blocks_[ device+1 ][ block ] = size_class;
     }
+    return block;
 }
 
 //------------------------------------------------------------------------------
 /// Allocates a single block of memory on the given device, which can be host.
+/// For host, if queue is not null, the block is pinned.
 ///
 void* Memory::allocBlock(int device, blas::Queue *queue)
 {
     void* block;
-    if (device == HostNum)
-        block = allocHostMemory(block_size_);
-    else
+    if (device == HostNum) {
+        block = allocHostMemory(block_size_, queue);
+        allocated_host_mem_.push( { block, queue != nullptr } );
+        host_capacity_ += 1;
+    }
+    else {
         block = allocDeviceMemory(device, block_size_, queue);
-
-    capacity_[device] += 1;
+        capacity_[device] += 1;
+    }
+    countPooled( device, block_size_ );
     return block;
 }
 
 //------------------------------------------------------------------------------
 /// Allocates host memory of given size.
+/// If queue is not null, allocates pinned memory, which is page-aligned;
+/// otherwise allocates page-aligned pageable memory.
+/// Doesn't touch the pool, so it can be called outside the slate_memory
+/// critical section; the caller records the allocation in
+/// allocated_host_mem_, inside it.
 ///
-void* Memory::allocHostMemory(size_t size)
+void* Memory::allocHostMemory(size_t size, blas::Queue *queue)
 {
-    slate_not_implemented( "Memory pool currently doesn't handle host memory" );
-    return nullptr;
-    /*
     void* host_mem;
-    host_mem = malloc(size);
-    assert(host_mem != nullptr);
-    allocated_mem_[ HostNum ].push( host_mem );
+    bool pinned = (queue != nullptr);
+    if (pinned) {
+        host_mem = blas::host_malloc_pinned<char>(size, *queue);
+    }
+    else {
+        // Large blocks can use 2 MiB huge pages; smaller blocks would waste
+        // most of a huge page.
+        const size_t huge_page_size = 2*1024*1024;
+        bool huge = host_huge_pages() && size >= huge_page_size;
+        size_t page_size = huge ? huge_page_size : sysconf( _SC_PAGESIZE );
+
+        // aligned_alloc requires size to be a multiple of the alignment.
+        size_t aligned_size = ((size + page_size - 1) / page_size) * page_size;
+        host_mem = std::aligned_alloc( page_size, aligned_size );
+        #if defined( MADV_HUGEPAGE )
+            if (huge && host_mem != nullptr)
+                madvise( host_mem, aligned_size, MADV_HUGEPAGE );
+        #endif
+    }
+    slate_assert( host_mem != nullptr );
 
     return host_mem;
-    */
 }
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// Configures the default memory pool of queue's device to keep freed
+/// memory cached, rather than releasing it to the OS at each sync.
+/// Done once per device.
+///
+void init_async_pool(blas::Queue& queue)
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    static std::vector<bool> initialized( Memory::num_devices_, false );
+    int device = queue.device();
+    bool done;
+    #pragma omp critical(slate_memory_async_pool)
+    {
+        done = initialized[ device ];
+        initialized[ device ] = true;
+    }
+    if (done)
+        return;
+
+    uint64_t threshold = UINT64_MAX;
+    #if defined( BLAS_HAVE_CUBLAS )
+        cudaMemPool_t pool;
+        slate_assert( cudaDeviceGetDefaultMemPool( &pool, device )
+                      == cudaSuccess );
+        slate_assert( cudaMemPoolSetAttribute(
+                          pool, cudaMemPoolAttrReleaseThreshold, &threshold )
+                      == cudaSuccess );
+    #else
+        hipMemPool_t pool;
+        slate_assert( hipDeviceGetDefaultMemPool( &pool, device )
+                      == hipSuccess );
+        slate_assert( hipMemPoolSetAttribute(
+                          pool, hipMemPoolAttrReleaseThreshold, &threshold )
+                      == hipSuccess );
+    #endif
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// @return true if stream-ordered allocation is enabled and supported.
+///
+bool use_async_alloc()
+{
+#if defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS )
+    return gpu_async_alloc();
+#else
+    return false;
+#endif
+}
+
+}  // anonymous namespace
+
 //------------------------------------------------------------------------------
 /// Allocates GPU device memory of given size.
+/// If gpu_async_alloc() is set, allocates in stream order on queue from the
+/// device's memory pool, then syncs queue (only), so the memory is usable
+/// on the device's other queues.
 ///
 void* Memory::allocDeviceMemory(int device, size_t size, blas::Queue *queue)
 {
-    void* dev_mem = blas::device_malloc<char>(size, *queue);
-    allocated_mem_[device].push(dev_mem);
+    void* dev_mem = nullptr;
+    bool async = use_async_alloc();
+    if (async) {
+        init_async_pool( *queue );
+        #if defined( BLAS_HAVE_CUBLAS )
+            slate_assert( cudaMallocAsync( &dev_mem, size, queue->stream() )
+                          == cudaSuccess );
+        #elif defined( BLAS_HAVE_ROCBLAS )
+            slate_assert( hipMallocAsync( &dev_mem, size, queue->stream() )
+                          == hipSuccess );
+        #endif
+        queue->sync();
+    }
+    else {
+        dev_mem = blas::device_malloc<char>(size, *queue);
+    }
+    allocated_mem_[device].push( { dev_mem, async } );
 
     return dev_mem;
 }
 
 //------------------------------------------------------------------------------
-/// Frees host memory.
+/// Frees host memory, either pinned or pageable.
 ///
-void Memory::freeHostMemory(void* host_mem)
+void Memory::freeHostMemory(void* host_mem, bool pinned, blas::Queue *queue)
 {
-    std::free(host_mem);
+    if (pinned) {
+        slate_assert( queue != nullptr );
+        blas::host_free_pinned(host_mem, *queue);
+    }
+    else {
+        std::free(host_mem);
+    }
 }
 
 //------------------------------------------------------------------------------
 /// Frees GPU device memory.
+/// If it was allocated in stream order, frees it in stream order on queue,
+/// returning it to the device's memory pool. The caller must ensure work
+/// using it on other queues is complete; see clearDeviceBlocks.
 ///
-void Memory::freeDeviceMemory(int device, void* dev_mem, blas::Queue *queue)
+void Memory::freeDeviceMemory(int device, void* dev_mem, bool async,
+                              blas::Queue *queue)
 {
-    blas::device_free(dev_mem, *queue);
+    if (async) {
+        #if defined( BLAS_HAVE_CUBLAS )
+            slate_assert( cudaFreeAsync( dev_mem, queue->stream() )
+                          == cudaSuccess );
+        #elif defined( BLAS_HAVE_ROCBLAS )
+            slate_assert( hipFreeAsync( dev_mem, queue->stream() )
+                          == hipSuccess );
+        #endif
+    }
+    else {
+        blas::device_free(dev_mem, *queue);
+    }
 }
 
 } // namespace slate
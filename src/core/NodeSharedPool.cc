@@ -0,0 +1,175 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/NodeSharedPool.hh"
+#include "slate/Exception.hh"
+
+#include <cassert>
+#include <new>
+#include <numeric>
+
+namespace slate {
+
+static_assert( std::atomic<int64_t>::is_always_lock_free,
+               "reference counts in shared memory must be lock free" );
+
+//------------------------------------------------------------------------------
+/// Constructor allocates num_blocks blocks of block_size bytes, shared by
+/// the ranks of each node of mpi_comm, found with
+/// MPI_Comm_split_type( MPI_COMM_TYPE_SHARED ). The memory is allocated
+/// by the node's first rank.
+/// Collective over mpi_comm, so it must be called by all ranks, outside
+/// of tasks, with the same arguments.
+/// If a rank is alone on its node, there is nothing to share, so no
+/// memory is allocated and enabled() is false.
+///
+/// @param[in] mpi_comm
+///     Communicator of the matrices whose broadcasts use the pool.
+///
+/// @param[in] block_size
+///     Size of blocks in bytes; tiles larger than this are not shared.
+///
+/// @param[in] num_blocks
+///     Number of blocks per node.
+///
+NodeSharedPool::NodeSharedPool(
+    MPI_Comm mpi_comm, size_t block_size, int64_t num_blocks )
+    : mpi_comm_( mpi_comm ),
+      node_comm_( MPI_COMM_NULL ),
+      win_( MPI_WIN_NULL ),
+      block_size_( block_size ),
+      block_stride_( 0 ),
+      num_blocks_( num_blocks ),
+      refs_( nullptr ),
+      blocks_( nullptr ),
+      indices_( num_blocks ),
+      next_( 0 )
+{
+    slate_assert( num_blocks >= 0 );
+    std::iota( indices_.begin(), indices_.end(), 0 );
+
+    int mpi_rank, node_rank, node_size;
+    slate_mpi_call( MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_split_type( mpi_comm, MPI_COMM_TYPE_SHARED, mpi_rank,
+                             MPI_INFO_NULL, &node_comm_ ) );
+    slate_mpi_call( MPI_Comm_rank( node_comm_, &node_rank ) );
+    slate_mpi_call( MPI_Comm_size( node_comm_, &node_size ) );
+    if (node_size == 1 || num_blocks == 0 || block_size == 0)
+        return;
+
+    // Reference counts first, then blocks, each on its own cache lines.
+    const size_t align = 64;
+    size_t header = (num_blocks * sizeof(std::atomic<int64_t>) + align - 1)
+                    / align * align;
+    block_stride_ = (block_size + align - 1) / align * align;
+    MPI_Aint size = 0;
+    if (node_rank == 0)
+        size = header + num_blocks * block_stride_;
+
+    void* base;
+    int disp_unit;
+    slate_mpi_call(
+        MPI_Win_allocate_shared( size, 1, MPI_INFO_NULL, node_comm_,
+                                 &base, &win_ ) );
+    slate_mpi_call(
+        MPI_Win_shared_query( win_, 0, &size, &disp_unit, &base ) );
+    refs_   = static_cast< std::atomic<int64_t>* >( base );
+    blocks_ = static_cast< char* >( base ) + header;
+
+    if (node_rank == 0) {
+        for (int64_t b = 0; b < num_blocks; ++b)
+            new ( &refs_[ b ] ) std::atomic<int64_t>( 0 );
+    }
+
+    // Passive target epoch for the life of the pool, needed by MPI_Win_sync.
+    slate_mpi_call( MPI_Win_lock_all( MPI_MODE_NOCHECK, win_ ) );
+    sync();
+    slate_mpi_call( MPI_Barrier( node_comm_ ) );
+    sync();
+}
+
+//------------------------------------------------------------------------------
+/// Destructor frees the shared memory.
+/// Collective over the constructor's mpi_comm. No tile may still use a
+/// block.
+NodeSharedPool::~NodeSharedPool()
+{
+    try {
+        // Nothing to free if MPI was already finalized, e.g., for a pool in
+        // a global Workspace.
+        int finalized = 0;
+        slate_mpi_call( MPI_Finalized( &finalized ) );
+        if (finalized)
+            return;
+
+        if (win_ != MPI_WIN_NULL) {
+            slate_mpi_call( MPI_Win_unlock_all( win_ ) );
+            slate_mpi_call( MPI_Win_free( &win_ ) );
+        }
+        if (node_comm_ != MPI_COMM_NULL)
+            slate_mpi_call( MPI_Comm_free( &node_comm_ ) );
+    }
+    catch (std::exception const& ex) {
+        // If debugging, die on exceptions.
+        // Otherwise, ignore errors: destructors should not throw errors!
+        assert(false);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Takes a free block, setting its reference count. Thread safe, and safe
+/// across the ranks of the node.
+///
+/// @param[in] count
+///     Number of ranks that will read the block, each of which calls
+///     release once. count >= 1.
+///
+/// @return index of the block, or no_block if none is free.
+///
+int64_t NodeSharedPool::acquire( int64_t count )
+{
+    assert( count >= 1 );
+    int64_t first = next_.load( std::memory_order_relaxed );
+    for (int64_t k = 0; k < num_blocks_; ++k) {
+        int64_t block = (first + k) % num_blocks_;
+        int64_t expected = 0;
+        if (refs_[ block ].compare_exchange_strong(
+                expected, count, std::memory_order_acquire,
+                std::memory_order_relaxed )) {
+            next_.store( block + 1, std::memory_order_relaxed );
+            return block;
+        }
+    }
+    return no_block;
+}
+
+//------------------------------------------------------------------------------
+/// Releases one reference to the block holding data, after the caller is
+/// done reading it.
+///
+/// @param[in] data
+///     Pointer to the block, from data().
+///
+void NodeSharedPool::release( void const* data )
+{
+    int64_t block = (static_cast< char const* >( data ) - blocks_)
+                    / int64_t( block_stride_ );
+    assert( 0 <= block && block < num_blocks_ );
+    int64_t prev = refs_[ block ].fetch_sub( 1, std::memory_order_release );
+    assert( prev >= 1 );
+    (void) prev;
+}
+
+//------------------------------------------------------------------------------
+/// Synchronizes the shared memory: a rank calls it after writing a block
+/// and before sending the block's index, and after receiving a block's
+/// index and before reading it.
+void NodeSharedPool::sync()
+{
+    slate_mpi_call( MPI_Win_sync( win_ ) );
+}
+
+} // namespace slate
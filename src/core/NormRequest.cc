@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/NormRequest.hh"
+#include "slate/internal/Trace.hh"
+#include "slate/internal/openmp.hh"
+#include "slate/types.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Buffers, MPI request, and MPI op and type of a pending reduction,
+/// kept at fixed addresses while MPI uses them.
+template <typename real_t>
+struct NormRequest<real_t>::State {
+    std::vector<real_t> local_values;
+    std::vector<real_t> global_values;
+    std::function< void (real_t const* global_values) > finish;
+    MPI_Request request = MPI_REQUEST_NULL;
+    MPI_Op op;
+    MPI_Datatype type;
+    bool free_op = false;
+    bool free_type = false;
+};
+
+//------------------------------------------------------------------------------
+/// Starts the reduction of local_values across the ranks of comm.
+///
+/// @param[in] local_values
+///     Values on this rank, e.g., local column maxes or sums.
+///
+/// @param[in] reduce
+///     How to combine the values of the ranks.
+///
+/// @param[in] comm
+///     Communicator of the matrix.
+///
+/// @param[in] finish
+///     Called by wait() or test() with the reduced values, to compute the
+///     norms from them and store them in the output arrays.
+///
+template <typename real_t>
+NormRequest<real_t>::NormRequest(
+    std::vector<real_t> local_values, Reduce reduce, MPI_Comm comm,
+    std::function< void (real_t const* global_values) > finish )
+    : state_( new State )
+{
+    using internal::mpi_max_nan;
+    using internal::mpi_max_nan_first_sum_rest;
+
+    State& s = *state_;
+    s.local_values = std::move( local_values );
+    s.global_values.resize( s.local_values.size() );
+    s.finish = std::move( finish );
+
+    int count = s.local_values.size();
+    s.type = mpi_type<real_t>::value;
+    if (reduce == Reduce::Sum) {
+        s.op = MPI_SUM;
+    }
+
+    #pragma omp critical(slate_mpi)
+    {
+        if (reduce == Reduce::Max) {
+            slate_mpi_call(
+                MPI_Op_create(mpi_max_nan, true, &s.op));
+            s.free_op = true;
+        }
+        else if (reduce == Reduce::MaxFirstSumRest) {
+            // The op tells the first value from the others by a
+            // contiguous type holding all of them.
+            slate_mpi_call(
+                MPI_Type_contiguous(count, mpi_type<real_t>::value,
+                                    &s.type));
+            slate_mpi_call(
+                MPI_Type_commit(&s.type));
+            s.free_type = true;
+            count = 1;
+            slate_mpi_call(
+                MPI_Op_create(mpi_max_nan_first_sum_rest, true, &s.op));
+            s.free_op = true;
+        }
+
+        trace::Block trace_block("MPI_Iallreduce");
+        slate_mpi_call(
+            MPI_Iallreduce(s.local_values.data(), s.global_values.data(),
+                           count, s.type, s.op, comm, &s.request));
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Waits for a pending reduction, as all ranks must complete it.
+template <typename real_t>
+NormRequest<real_t>::~NormRequest()
+{
+    wait();
+}
+
+//------------------------------------------------------------------------------
+/// Waits for this request's pending reduction, then takes other's.
+template <typename real_t>
+NormRequest<real_t>& NormRequest<real_t>::operator=( NormRequest&& other )
+{
+    if (this != &other) {
+        wait();
+        state_ = std::move( other.state_ );
+    }
+    return *this;
+}
+
+//------------------------------------------------------------------------------
+/// Completes the reduction, if pending, and stores the norms.
+template <typename real_t>
+void NormRequest<real_t>::wait()
+{
+    if (state_ == nullptr)
+        return;
+
+    {
+        trace::Block trace_block("MPI_Wait");
+        #pragma omp critical(slate_mpi)
+        {
+            slate_mpi_call(
+                MPI_Wait(&state_->request, MPI_STATUS_IGNORE));
+        }
+    }
+    finish();
+}
+
+//------------------------------------------------------------------------------
+/// Checks, without blocking, whether the reduction has completed;
+/// if so, stores the norms, as wait() does.
+/// @return true if no reduction is pending anymore.
+template <typename real_t>
+bool NormRequest<real_t>::test()
+{
+    if (state_ == nullptr)
+        return true;
+
+    int flag = 0;
+    #pragma omp critical(slate_mpi)
+    {
+        slate_mpi_call(
+            MPI_Test(&state_->request, &flag, MPI_STATUS_IGNORE));
+    }
+    if (flag)
+        finish();
+    return flag != 0;
+}
+
+//------------------------------------------------------------------------------
+/// Frees the MPI op and type, and stores the norms, after the reduction
+/// completed.
+template <typename real_t>
+void NormRequest<real_t>::finish()
+{
+    std::unique_ptr< State > s = std::move( state_ );
+
+    #pragma omp critical(slate_mpi)
+    {
+        if (s->free_op)
+            slate_mpi_call(
+                MPI_Op_free(&s->op));
+        if (s->free_type)
+            slate_mpi_call(
+                MPI_Type_free(&s->type));
+    }
+    s->finish( s->global_values.data() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template class NormRequest<float>;
+template class NormRequest<double>;
+
+} // namespace slate
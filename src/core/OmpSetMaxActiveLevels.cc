@@ -0,0 +1,99 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/OmpSetMaxActiveLevels.hh"
+#include "slate/config.hh"
+
+#include <algorithm>
+#include <mutex>
+
+namespace slate {
+
+namespace {
+
+/// Protects the variables below.
+std::mutex g_mutex;
+
+/// Number of live OmpSetMaxActiveLevels objects, across threads.
+int g_num_scopes = 0;
+
+/// max-active-levels-var before the first live object, if it was raised,
+/// else -1.
+int g_orig_max_active_levels = -1;
+
+/// Number of threads shared by concurrent driver calls, from nthreads-var
+/// of the first call with shared_threads().
+int g_shared_threads = 0;
+
+/// Number of concurrent driver calls sharing the threads.
+int g_num_shared_calls = 0;
+
+/// Nesting depth of OmpSetMaxActiveLevels objects on this thread.
+thread_local int t_depth = 0;
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Require omp nested levels to have a minimum value.
+///
+/// @param[in] min_active_levels
+///     Ensure that OpenMP max-active-levels-var ICV has this minimum.
+///
+OmpSetMaxActiveLevels::OmpSetMaxActiveLevels( int min_active_levels )
+{
+    int curr_max_active_levels = omp_get_max_active_levels();
+    #if defined(_OPENMP) && _OPENMP < 201811
+        // if OpenMP version < 5.0 then enable omp_set_nested
+        omp_set_nested(1);
+    #endif
+
+    // Only the outermost driver call on an application thread, outside of
+    // any parallel region, takes a share of the threads.
+    bool outermost = t_depth == 0 && ! omp_in_parallel();
+    ++t_depth;
+
+    std::lock_guard< std::mutex > guard( g_mutex );
+    ++g_num_scopes;
+    if (min_active_levels > curr_max_active_levels) {
+        // record the original value, unless another object raised it
+        if (g_orig_max_active_levels == -1)
+            g_orig_max_active_levels = curr_max_active_levels;
+        omp_set_max_active_levels( min_active_levels );
+    }
+
+    if (outermost && shared_threads()) {
+        orig_num_threads_ = omp_get_max_threads();
+        if (g_shared_threads == 0)
+            g_shared_threads = orig_num_threads_;
+        ++g_num_shared_calls;
+        // Calls started earlier keep their teams, so the sum may exceed
+        // the threads briefly, until they finish.
+        omp_set_num_threads(
+            std::max( 1, g_shared_threads / g_num_shared_calls ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Reset omp nested levels variable, and the calling thread's
+/// number of threads.
+OmpSetMaxActiveLevels::~OmpSetMaxActiveLevels()
+{
+    --t_depth;
+    if (orig_num_threads_ != -1)
+        omp_set_num_threads( orig_num_threads_ );
+
+    std::lock_guard< std::mutex > guard( g_mutex );
+    if (orig_num_threads_ != -1)
+        --g_num_shared_calls;
+
+    // if original was changed, reset it after the last object
+    --g_num_scopes;
+    if (g_num_scopes == 0 && g_orig_max_active_levels != -1) {
+        omp_set_max_active_levels( g_orig_max_active_levels );
+        g_orig_max_active_levels = -1;
+    }
+}
+
+}  // namespace slate
@@ -0,0 +1,146 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/PanelThreadPool.hh"
+#include "slate/internal/Affinity.hh"
+#include "slate/config.hh"
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return PanelThreadPool singleton. Threads are started by the first
+/// panel that uses the pool, and joined at program exit.
+PanelThreadPool& PanelThreadPool::get()
+{
+    static PanelThreadPool singleton;
+    return singleton;
+}
+
+//------------------------------------------------------------------------------
+/// Destructor joins the threads.
+PanelThreadPool::~PanelThreadPool()
+{
+    stop();
+}
+
+//------------------------------------------------------------------------------
+/// Runs body( thread_rank ) for thread_rank = 0, ..., thread_size-1 on the
+/// pool's threads, and waits for them. Rethrows the first exception thrown
+/// by body.
+///
+/// @return false, without running body, if the pool is disabled
+/// (slate::panel_cores() is empty), has fewer than thread_size threads,
+/// or is busy with another panel; the caller must then run body itself.
+///
+bool PanelThreadPool::run(
+    int thread_size, std::function< void (int) > const& body )
+{
+    return get().tryRun( thread_size, body );
+}
+
+//------------------------------------------------------------------------------
+bool PanelThreadPool::tryRun(
+    int thread_size, std::function< void (int) > const& body )
+{
+    std::unique_lock<std::mutex> run_lock( run_mutex_, std::try_to_lock );
+    if (! run_lock.owns_lock())
+        return false;
+
+    // (Re)build the pool if the cores were changed since it was started.
+    std::vector<int> cores = slate::panel_cores();
+    if (cores != cores_) {
+        stop();
+        start( cores );
+    }
+    if (thread_size > int( threads_.size() ))
+        return false;
+
+    std::unique_lock<std::mutex> lock( mutex_ );
+    body_ = &body;
+    thread_size_ = thread_size;
+    remaining_ = thread_size;
+    exception_ = nullptr;
+    ++generation_;
+    work_cv_.notify_all();
+    done_cv_.wait( lock, [this] { return remaining_ == 0; } );
+    body_ = nullptr;
+
+    if (exception_)
+        std::rethrow_exception( exception_ );
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Starts one thread per core. Called with run_mutex_ held.
+void PanelThreadPool::start( std::vector<int> const& cores )
+{
+    cores_ = cores;
+    stop_ = false;
+    for (int i = 0; i < int( cores.size() ); ++i) {
+        threads_.emplace_back( &PanelThreadPool::worker, this,
+                               i, cores[ i ], generation_ );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Joins the threads. Called with run_mutex_ held, or at exit.
+void PanelThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex_ );
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_)
+        thread.join();
+    threads_.clear();
+    cores_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Main loop of a pool thread: waits for each panel after the given
+/// generation, and runs its part if thread_rank < thread_size.
+void PanelThreadPool::worker( int thread_rank, int core, int64_t generation )
+{
+    pin_thread( { core } );
+
+    // The panel threads are the parallelism; BLAS calls in them,
+    // if multithreaded with OpenMP, run on one thread.
+    omp_set_num_threads( 1 );
+
+    while (true) {
+        std::function< void (int) > const* body;
+        {
+            std::unique_lock<std::mutex> lock( mutex_ );
+            work_cv_.wait( lock, [&] {
+                return stop_ || generation_ != generation;
+            } );
+            if (stop_)
+                return;
+            generation = generation_;
+            if (thread_rank >= thread_size_)
+                continue;
+            body = body_;
+        }
+
+        std::exception_ptr exception;
+        try {
+            (*body)( thread_rank );
+        }
+        catch (...) {
+            exception = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock( mutex_ );
+        if (exception && ! exception_)
+            exception_ = exception;
+        if (--remaining_ == 0)
+            done_cv_.notify_one();
+    }
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,480 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/TaskRuntime.hh"
+#include "slate/Exception.hh"
+#include "slate/internal/openmp.hh"
+#include "slate/internal/util.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Task of the work-stealing scheduler.
+struct TaskNode {
+    std::function< void () > body;
+    int priority = 0;
+
+    /// Number of unfinished predecessors, plus 1 while being spawned.
+    std::atomic<int> pending { 1 };
+
+    /// Protects done and successors.
+    std::mutex mutex;
+    bool done = false;
+    std::vector< std::shared_ptr< TaskNode > > successors;
+};
+
+using TaskNodePtr = std::shared_ptr< TaskNode >;
+
+//------------------------------------------------------------------------------
+/// Ready tasks of one thread, in buckets by priority, highest first.
+/// The owner takes the newest task of the highest priority (LIFO), which
+/// likely uses data still in its cache; thieves take the oldest (FIFO).
+class TaskDeque {
+public:
+    void push( TaskNodePtr node )
+    {
+        std::lock_guard< std::mutex > guard( mutex_ );
+        buckets_[ node->priority ].push_back( std::move( node ) );
+        ++size_;
+    }
+
+    TaskNodePtr pop()
+    {
+        return take( false );
+    }
+
+    TaskNodePtr steal()
+    {
+        return take( true );
+    }
+
+private:
+    TaskNodePtr take( bool oldest )
+    {
+        // Unlocked check, so thieves don't contend on empty deques.
+        if (size_.load( std::memory_order_relaxed ) == 0)
+            return nullptr;
+
+        std::lock_guard< std::mutex > guard( mutex_ );
+        if (buckets_.empty())
+            return nullptr;
+
+        auto bucket = buckets_.begin();
+        TaskNodePtr node;
+        if (oldest) {
+            node = std::move( bucket->second.front() );
+            bucket->second.pop_front();
+        }
+        else {
+            node = std::move( bucket->second.back() );
+            bucket->second.pop_back();
+        }
+        if (bucket->second.empty())
+            buckets_.erase( bucket );
+        --size_;
+        return node;
+    }
+
+    std::mutex mutex_;
+    std::map< int, std::deque< TaskNodePtr >, std::greater<int> > buckets_;
+    std::atomic<int64_t> size_ { 0 };
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Work-stealing scheduler of TaskBackend::Stealing.
+///
+/// Dependencies are tracked per address: the last task that wrote it, and
+/// the tasks that read it since. A task becomes ready when its last
+/// predecessor finishes, and goes to the deque of the thread that finished
+/// it, or of the spawning thread.
+///
+/// Worker loops are OpenMP tasks, launched when tasks become ready, up to
+/// one per thread of the team besides the spawning thread, which runs
+/// tasks in wait(). A worker loop returns after it finds no task for a
+/// while, so a thread never stays in one while OpenMP tasks of internal
+/// routines, or another worker loop it picked up at a scheduling point
+/// inside a task, wait for it.
+///
+class StealingScheduler {
+public:
+    StealingScheduler()
+        : num_threads_( omp_get_num_threads() ),
+          deques_( num_threads_ ),
+          victims_( num_threads_ )
+    {
+        // Locality-aware stealing: with threads bound to cores in order,
+        // e.g., OMP_PROC_BIND=close, nearby thread numbers share caches.
+        for (int i = 0; i < num_threads_; ++i) {
+            for (int j = 0; j < num_threads_; ++j) {
+                if (j != i)
+                    victims_[ i ].push_back( j );
+            }
+            std::stable_sort(
+                victims_[ i ].begin(), victims_[ i ].end(),
+                [i]( int a, int b ) {
+                    return std::abs( a - i ) < std::abs( b - i );
+                });
+        }
+    }
+
+    ~StealingScheduler()
+    {
+        try {
+            wait();
+        }
+        catch (...) {
+            // Destructors must not throw; wait() was skipped due to an
+            // exception already.
+        }
+        // Worker loops may still be checking the deques.
+        while (active_workers_.load( std::memory_order_acquire ) > 0) {
+            #pragma omp taskyield
+            std::this_thread::yield();
+        }
+    }
+
+    void spawn(
+        std::initializer_list< void const* > in,
+        std::initializer_list< void const* > inout,
+        int priority, std::function< void () > body );
+
+    void wait();
+
+private:
+    void add_edge( TaskNodePtr const& pred, TaskNodePtr const& succ );
+    void ready( TaskNodePtr node );
+    bool run_one();
+    void worker();
+
+    /// Last writer of an address, and readers since.
+    struct Access {
+        TaskNodePtr writer;
+        std::vector< TaskNodePtr > readers;
+    };
+
+    //----------------------------------------
+    // Data
+    int num_threads_;
+    std::vector< TaskDeque > deques_;
+    std::vector< std::vector<int> > victims_;
+
+    /// Accessed only by the spawning thread.
+    std::unordered_map< void const*, Access > accesses_;
+
+    /// Number of spawned tasks not yet finished.
+    std::atomic<int64_t> outstanding_ { 0 };
+
+    /// Number of worker loops launched and not yet returned.
+    std::atomic<int> active_workers_ { 0 };
+
+    std::mutex exception_mutex_;
+    std::exception_ptr exception_;
+};
+
+//------------------------------------------------------------------------------
+void StealingScheduler::spawn(
+    std::initializer_list< void const* > in,
+    std::initializer_list< void const* > inout,
+    int priority, std::function< void () > body )
+{
+    auto node = std::make_shared< TaskNode >();
+    node->body = std::move( body );
+    node->priority = priority;
+
+    for (void const* addr : in) {
+        Access& access = accesses_[ addr ];
+        if (access.writer)
+            add_edge( access.writer, node );
+
+        // Drop finished readers, so lists don't grow with many readers.
+        if (access.readers.size() >= 16) {
+            access.readers.erase(
+                std::remove_if(
+                    access.readers.begin(), access.readers.end(),
+                    []( TaskNodePtr const& reader ) {
+                        std::lock_guard< std::mutex > guard( reader->mutex );
+                        return reader->done;
+                    }),
+                access.readers.end() );
+        }
+        access.readers.push_back( node );
+    }
+    for (void const* addr : inout) {
+        Access& access = accesses_[ addr ];
+        if (! access.readers.empty()) {
+            // Readers since the last writer already depend on it.
+            for (auto& reader : access.readers)
+                add_edge( reader, node );
+        }
+        else if (access.writer) {
+            add_edge( access.writer, node );
+        }
+        access.writer = node;
+        access.readers.clear();
+    }
+
+    outstanding_.fetch_add( 1, std::memory_order_relaxed );
+    // Release the spawning count.
+    if (node->pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1)
+        ready( std::move( node ) );
+}
+
+//------------------------------------------------------------------------------
+/// Makes succ wait for pred, unless pred is already done.
+void StealingScheduler::add_edge(
+    TaskNodePtr const& pred, TaskNodePtr const& succ )
+{
+    // A task that both reads and writes an address doesn't wait for itself.
+    if (pred == succ)
+        return;
+
+    std::lock_guard< std::mutex > guard( pred->mutex );
+    if (! pred->done) {
+        succ->pending.fetch_add( 1, std::memory_order_relaxed );
+        pred->successors.push_back( succ );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Queues a ready task on the calling thread's deque, and launches another
+/// worker loop if not all threads run one.
+void StealingScheduler::ready( TaskNodePtr node )
+{
+    deques_[ omp_get_thread_num() ].push( std::move( node ) );
+
+    int active = active_workers_.load( std::memory_order_relaxed );
+    while (active < num_threads_ - 1) {
+        if (active_workers_.compare_exchange_weak( active, active + 1 )) {
+            #pragma omp task
+            worker();
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Runs one ready task, from the calling thread's deque, else stolen from
+/// the nearest thread that has one.
+/// @return true if a task was run.
+bool StealingScheduler::run_one()
+{
+    int tid = omp_get_thread_num();
+    TaskNodePtr node = deques_[ tid ].pop();
+    for (size_t i = 0; ! node && i < victims_[ tid ].size(); ++i) {
+        node = deques_[ victims_[ tid ][ i ] ].steal();
+    }
+    if (! node)
+        return false;
+
+    try {
+        node->body();
+    }
+    catch (...) {
+        std::lock_guard< std::mutex > guard( exception_mutex_ );
+        if (! exception_)
+            exception_ = std::current_exception();
+    }
+    // Free captured data now, not when the last reference goes away.
+    node->body = nullptr;
+
+    std::vector< TaskNodePtr > successors;
+    {
+        std::lock_guard< std::mutex > guard( node->mutex );
+        node->done = true;
+        successors.swap( node->successors );
+    }
+    for (auto& succ : successors) {
+        if (succ->pending.fetch_sub( 1, std::memory_order_acq_rel ) == 1)
+            ready( std::move( succ ) );
+    }
+    outstanding_.fetch_sub( 1, std::memory_order_release );
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// Worker loop: runs tasks until none is found for a while.
+void StealingScheduler::worker()
+{
+    const int max_idle = 100;
+    int idle = 0;
+    while (idle < max_idle) {
+        if (run_one()) {
+            idle = 0;
+        }
+        else {
+            ++idle;
+            std::this_thread::yield();
+        }
+    }
+    // Last access to this.
+    active_workers_.fetch_sub( 1, std::memory_order_release );
+}
+
+//------------------------------------------------------------------------------
+/// Runs tasks on the calling thread until all spawned tasks have finished.
+/// Rethrows the first exception thrown by a task.
+void StealingScheduler::wait()
+{
+    while (outstanding_.load( std::memory_order_acquire ) > 0) {
+        if (! run_one()) {
+            // Let the runtime run OpenMP tasks of other threads' tasks.
+            #pragma omp taskyield
+        }
+    }
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard< std::mutex > guard( exception_mutex_ );
+        exception.swap( exception_ );
+    }
+    if (exception)
+        std::rethrow_exception( exception );
+}
+
+//------------------------------------------------------------------------------
+/// Creates a task runtime. Must be called in the OpenMP parallel region
+/// whose threads run the tasks, by the thread that spawns them.
+///
+/// @param[in] backend
+///     Backend that schedules tasks, default slate::task_backend().
+///
+TaskRuntime::TaskRuntime( TaskBackend backend )
+    : backend_( backend )
+{
+    if (backend_ == TaskBackend::Stealing)
+        scheduler_.reset( new StealingScheduler );
+}
+
+//------------------------------------------------------------------------------
+/// Waits for all tasks.
+TaskRuntime::~TaskRuntime()
+{
+    if (backend_ == TaskBackend::OpenMP) {
+        #pragma omp taskwait
+    }
+    // Else ~StealingScheduler waits.
+}
+
+//------------------------------------------------------------------------------
+/// Spawns a task.
+///
+/// @param[in] in
+///     Addresses the task reads: it runs after earlier tasks that write
+///     any of them.
+///
+/// @param[in] inout
+///     Addresses the task writes: it runs after earlier tasks that read
+///     or write any of them.
+///
+/// @param[in] priority
+///     Task priority, as in OpenMP: a hint to run tasks with higher
+///     priority first, in [0, omp_get_max_task_priority()] for OpenMP.
+///
+/// @param[in] body
+///     Task body. Loop variables should be captured by value.
+///
+void TaskRuntime::spawn(
+    std::initializer_list< void const* > in,
+    std::initializer_list< void const* > inout,
+    int priority, std::function< void () > body )
+{
+    if (backend_ == TaskBackend::Stealing) {
+        scheduler_->spawn( in, inout, priority, std::move( body ) );
+        return;
+    }
+
+    int n_in    = int( in.size() );
+    int n_inout = int( inout.size() );
+    uint8_t const* const* in_ptr
+        = reinterpret_cast< uint8_t const* const* >( in.begin() );
+    uint8_t const* const* inout_ptr
+        = reinterpret_cast< uint8_t const* const* >( inout.begin() );
+    SLATE_UNUSED( in_ptr );    // Used only by OpenMP
+    SLATE_UNUSED( inout_ptr ); // Used only by OpenMP
+
+#if defined( _OPENMP ) && _OPENMP >= 201811
+    // Dependencies on a variable number of addresses need OpenMP 5.0
+    // iterators. The addresses are only compared, never dereferenced.
+    #pragma omp task slate_omp_default_none \
+        depend( iterator( i = 0 : n_in ), in: in_ptr[ i ][ 0 ] ) \
+        depend( iterator( j = 0 : n_inout ), inout: inout_ptr[ j ][ 0 ] ) \
+        firstprivate( body ) priority( priority )
+    {
+        body();
+    }
+#else
+    // Before OpenMP 5.0, depend clauses list a fixed number of addresses.
+    // Unused in slots get an address no task writes, which adds no
+    // dependency; unused inout slots repeat the first inout address.
+    const int max_deps = 4;
+    slate_assert( n_in <= max_deps && n_inout <= max_deps );
+
+    static uint8_t const no_dep = 0;
+    uint8_t const* in_dep[ max_deps ];
+    uint8_t const* inout_dep[ max_deps ];
+    for (int i = 0; i < max_deps; ++i) {
+        in_dep[ i ]    = i < n_in    ? in_ptr[ i ]    : &no_dep;
+        inout_dep[ i ] = i < n_inout ? inout_ptr[ i ]
+                       : n_inout > 0 ? inout_ptr[ 0 ] : &no_dep;
+    }
+    SLATE_UNUSED( in_dep );    // Used only by OpenMP
+    SLATE_UNUSED( inout_dep ); // Used only by OpenMP
+
+    if (n_inout > 0) {
+        #pragma omp task slate_omp_default_none \
+            depend( in: in_dep[ 0 ][ 0 ], in_dep[ 1 ][ 0 ], \
+                        in_dep[ 2 ][ 0 ], in_dep[ 3 ][ 0 ] ) \
+            depend( inout: inout_dep[ 0 ][ 0 ], inout_dep[ 1 ][ 0 ], \
+                           inout_dep[ 2 ][ 0 ], inout_dep[ 3 ][ 0 ] ) \
+            firstprivate( body ) priority( priority )
+        {
+            body();
+        }
+    }
+    else {
+        #pragma omp task slate_omp_default_none \
+            depend( in: in_dep[ 0 ][ 0 ], in_dep[ 1 ][ 0 ], \
+                        in_dep[ 2 ][ 0 ], in_dep[ 3 ][ 0 ] ) \
+            firstprivate( body ) priority( priority )
+        {
+            body();
+        }
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Waits for all tasks spawned so far, like `#pragma omp taskwait`.
+/// With TaskBackend::Stealing, the calling thread runs tasks meanwhile, and
+/// rethrows the first exception thrown by a task.
+void TaskRuntime::wait()
+{
+    if (backend_ == TaskBackend::Stealing) {
+        scheduler_->wait();
+    }
+    else {
+        #pragma omp taskwait
+    }
+}
+
+} // namespace internal
+} // namespace slate
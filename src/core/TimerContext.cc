@@ -0,0 +1,163 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/TimerContext.hh"
+#include "slate/Exception.hh"
+
+#include <algorithm>
+
+namespace slate {
+
+// The global map of timers, used if drivers are not given a TimerContext.
+std::map< std::string, double > timers;
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return mutex that serializes updates of the global slate::timers.
+std::mutex& timers_mutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Opens a scope named name in context, and starts its timer.
+TimerContext::Scope::Scope( TimerContext* context, std::string const& name ):
+    context_( context ),
+    start_( 0 )
+{
+    if (context_ != nullptr) {
+        context_->scopes_.push_back( name );
+        start_ = MPI_Wtime();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Closes the scope, and records its time under the scope's full name.
+TimerContext::Scope::~Scope()
+{
+    if (context_ != nullptr) {
+        double seconds = MPI_Wtime() - start_;
+        std::string name = context_->scopes_.back();
+        context_->scopes_.pop_back();
+        context_->record( name, seconds );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return name prefixed by the names of the open scopes, separated by "::".
+std::string TimerContext::path( std::string const& name ) const
+{
+    std::string full;
+    for (auto const& scope : scopes_) {
+        full += scope;
+        full += "::";
+    }
+    return full + name;
+}
+
+//------------------------------------------------------------------------------
+/// Records a call of seconds to timer name, within the open scopes.
+void TimerContext::record( std::string const& name, double seconds )
+{
+    Stats& stats = stats_[ path( name ) ];
+    stats.count += 1;
+    stats.total += seconds;
+    stats.min = std::min( stats.min, seconds );
+    stats.max = std::max( stats.max, seconds );
+}
+
+//------------------------------------------------------------------------------
+/// Erases all statistics. Scopes must be closed.
+void TimerContext::clear()
+{
+    slate_assert( scopes_.empty() );
+    stats_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// Reduces the statistics over the ranks in comm, and prints on root, for
+/// each timer, the number of calls, the total time averaged over ranks
+/// with its min and max over ranks, which show load imbalance, and the
+/// mean, min, and max time per call over all ranks.
+/// Collective on comm; all ranks must have recorded the same timers, as
+/// they do when calling the same drivers.
+///
+/// @param[in] comm
+///     MPI communicator of the ranks that recorded timers.
+///
+/// @param[in] file
+///     File to print to, on root. Default stdout.
+///
+/// @param[in] root
+///     Rank that prints the report. Default 0.
+///
+void TimerContext::report( MPI_Comm comm, FILE* file, int root ) const
+{
+    int mpi_rank, mpi_size;
+    slate_mpi_call(
+        MPI_Comm_rank( comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_size( comm, &mpi_size ) );
+
+    int n_local = int( stats_.size() );
+    int n_min, n_max;
+    slate_mpi_call(
+        MPI_Allreduce( &n_local, &n_min, 1, MPI_INT, MPI_MIN, comm ) );
+    slate_mpi_call(
+        MPI_Allreduce( &n_local, &n_max, 1, MPI_INT, MPI_MAX, comm ) );
+    if (n_min != n_max)
+        slate_error( "TimerContext::report: ranks recorded different timers" );
+
+    // Per timer: [ count, total ] summed; [ total, call min ] min'ed;
+    // [ total, call max ] max'ed.
+    int n = n_local;
+    std::vector<double> sum( 2*n ), min( 2*n ), max( 2*n );
+    int k = 0;
+    for (auto const& iter : stats_) {
+        Stats const& stats = iter.second;
+        sum[ 2*k     ] = stats.count;
+        sum[ 2*k + 1 ] = stats.total;
+        min[ 2*k     ] = stats.total;
+        min[ 2*k + 1 ] = stats.min;
+        max[ 2*k     ] = stats.total;
+        max[ 2*k + 1 ] = stats.max;
+        ++k;
+    }
+    bool is_root = (mpi_rank == root);
+    slate_mpi_call(
+        MPI_Reduce( is_root ? MPI_IN_PLACE : sum.data(), sum.data(), 2*n,
+                    MPI_DOUBLE, MPI_SUM, root, comm ) );
+    slate_mpi_call(
+        MPI_Reduce( is_root ? MPI_IN_PLACE : min.data(), min.data(), 2*n,
+                    MPI_DOUBLE, MPI_MIN, root, comm ) );
+    slate_mpi_call(
+        MPI_Reduce( is_root ? MPI_IN_PLACE : max.data(), max.data(), 2*n,
+                    MPI_DOUBLE, MPI_MAX, root, comm ) );
+
+    if (is_root) {
+        fprintf( file, "%-40s  %8s  %10s  %10s  %10s  %10s  %10s  %10s\n",
+                 "timer", "calls", "total", "total min", "total max",
+                 "mean", "min", "max" );
+        k = 0;
+        for (auto const& iter : stats_) {
+            double count = sum[ 2*k ];
+            double total = sum[ 2*k + 1 ];
+            fprintf( file,
+                     "%-40s  %8.0f  %10.4f  %10.4f  %10.4f"
+                     "  %10.4f  %10.4f  %10.4f\n",
+                     iter.first.c_str(), count / mpi_size,
+                     total / mpi_size, min[ 2*k ], max[ 2*k ],
+                     count > 0 ? total / count : 0.0,
+                     min[ 2*k + 1 ], max[ 2*k + 1 ] );
+            ++k;
+        }
+    }
+}
+
+} // namespace slate
@@ -0,0 +1,347 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Workspace.hh"
+#include "slate/Exception.hh"
+#include "slate/internal/DeviceQueues.hh"
+
+#include <algorithm>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Constructor does not allocate any memory; the arena is filled by the
+/// first drivers that use it.
+/// It holds the shared device queues (see DeviceQueues), since parked
+/// batch arrays can include them.
+Workspace::Workspace():
+    buffers_( Memory::num_devices_, nullptr ),
+    buffer_sizes_( Memory::num_devices_, 0 )
+{
+    DeviceQueues::attach();
+}
+
+//------------------------------------------------------------------------------
+/// Destructor frees all memory owned by the arena.
+/// No matrix may be attached to the arena.
+Workspace::~Workspace()
+{
+    try {
+        clear();
+        DeviceQueues::detach();
+    }
+    catch (std::exception const& ex) {
+        // If debugging, die on exceptions.
+        // Otherwise, ignore errors: destructors should not throw errors!
+        assert(false);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Frees all memory pools, batch arrays, buffers, and the communication
+/// plan's requests owned by the arena.
+/// No matrix may be attached to the arena.
+void Workspace::clear()
+{
+    comm_plan_.clear();
+
+    // Pinned host memory is freed using the first device's context.
+    blas::Queue* host_queue = (Memory::num_devices_ > 0 ? queue( 0 ) : nullptr);
+    for (auto& iter : pools_) {
+        for (auto& pool : iter.second) {
+            pool->clearHostBlocks( host_queue );
+            for (int device = 0; device < Memory::num_devices_; ++device)
+                pool->clearDeviceBlocks( device, queue( device ) );
+        }
+    }
+    pools_.clear();
+    spare_pools_.clear();
+
+    auto free_batch_arrays = [this]( BatchArrays& arrays ) {
+        for (size_t i = 0; i < arrays.queues.size(); ++i) {
+            for (int device = 0; device < Memory::num_devices_; ++device) {
+                if (arrays.host[ i ][ device ] != nullptr)
+                    blas::host_free_pinned( arrays.host[ i ][ device ],
+                                            *queue( device ) );
+                if (arrays.dev[ i ][ device ] != nullptr)
+                    blas::device_free( arrays.dev[ i ][ device ],
+                                       *queue( device ) );
+                DeviceQueues::release( arrays.queues[ i ][ device ] );
+            }
+        }
+    };
+    for (auto& arrays : batch_arrays_)
+        free_batch_arrays( arrays );
+    for (auto& arrays : spare_batch_arrays_)
+        free_batch_arrays( arrays );
+    batch_arrays_.clear();
+    spare_batch_arrays_.clear();
+
+    for (int device = 0; device < int( buffers_.size() ); ++device) {
+        if (buffers_[ device ] != nullptr) {
+            blas::device_free( buffers_[ device ], *queue( device ) );
+            buffers_[ device ] = nullptr;
+        }
+        buffer_sizes_[ device ] = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Allocates memory shared by the ranks of each node, used by hierarchical
+/// broadcasts of matrices attached to the arena
+/// (Option::HierarchicalBcast): the first rank of a node to receive a
+/// host tile receives it into the shared memory, and the node's other
+/// ranks in the broadcast read it there, instead of each receiving its own
+/// copy. Such tiles are read-only; a rank that writes one, or converts its
+/// layout, first copies it to its own memory.
+/// Tiles larger than block_size, tiles broadcast when no block is free,
+/// and tiles received directly into GPU memory are broadcast as usual.
+///
+/// Collective over mpi_comm, so it must be called by all ranks, outside
+/// of tasks, with the same arguments; replaces memory from a previous
+/// call. The arena's destructor is then also collective.
+/// Matrices using it must have communicator mpi_comm.
+///
+/// @param[in] mpi_comm
+///     Communicator of the matrices.
+///
+/// @param[in] block_size
+///     Size in bytes of the largest tile to share, usually
+///     mb * nb * sizeof( scalar_t ).
+///
+/// @param[in] num_blocks
+///     Number of tiles each node can share at once, e.g., the number of
+///     tiles in a few panels; 0 disables sharing.
+///
+void Workspace::enableNodeShared(
+    MPI_Comm mpi_comm, size_t block_size, int64_t num_blocks )
+{
+    slate_assert( num_attached_ == 0 );
+    node_shared_.reset();
+    node_shared_.reset( new NodeSharedPool( mpi_comm, block_size, num_blocks ) );
+}
+
+//------------------------------------------------------------------------------
+/// @return scratch buffer of at least size bytes on device.
+/// The buffer is reused by later calls, and grown if needed, so the
+/// previously returned buffer is invalidated if size grows. Therefore, a
+/// driver should get at most one buffer per device.
+///
+/// @param[in] device
+///     Device ID, 0 <= device < number of devices.
+///
+/// @param[in] size
+///     Size in bytes.
+///
+void* Workspace::deviceBuffer( int device, size_t size )
+{
+    slate_assert( 0 <= device && device < int( buffers_.size() ) );
+    if (buffer_sizes_[ device ] < size) {
+        blas::Queue* dev_queue = queue( device );
+        if (buffers_[ device ] != nullptr)
+            blas::device_free( buffers_[ device ], *dev_queue );
+        buffers_[ device ] = blas::device_malloc<char>( size, *dev_queue );
+        buffer_sizes_[ device ] = size;
+    }
+    return buffers_[ device ];
+}
+
+//------------------------------------------------------------------------------
+/// Preallocates the memory predicted by a driver's workspace query:
+/// parked memory pools with blocks for the tiles of each attached matrix,
+/// parked batch arrays, and the device scratch buffer. Memory already in
+/// the arena is reused and grown only where it is too small, so reserving
+/// the same size again allocates nothing.
+/// Pools and batch arrays are parked in the order the driver attaches its
+/// matrices, which take them in that order.
+/// No matrix may be attached to the arena.
+///
+/// @param[in] size
+///     Workspace size, e.g., from getrf_workspace_size().
+///
+void Workspace::reserve( WorkspaceSize const& size )
+{
+    slate_assert( num_attached_ == 0 );
+
+    // Pinned host memory is allocated using the first device's context.
+    // Host memory is pinned only if the driver uses devices.
+    bool uses_devices = false;
+    for (int device = 0; device < Memory::num_devices_; ++device) {
+        if (size.deviceBytes( device ) > 0)
+            uses_devices = true;
+    }
+    blas::Queue* host_queue = (uses_devices ? queue( 0 ) : nullptr);
+
+    // Pools of each block size, and batch arrays, taken by attach so far.
+    std::map< size_t, size_t > num_pools;
+    size_t num_arrays = 0;
+
+    for (auto const& need : size.pools) {
+        auto& parked = pools_[ need.block_size ];
+        size_t k = num_pools[ need.block_size ]++;
+        if (k == parked.size()) {
+            auto& spares = spare_pools_[ need.block_size ];
+            if (spares.empty()) {
+                parked.emplace_back( new Memory( need.block_size ) );
+            }
+            else {
+                parked.push_back( std::move( spares.back() ) );
+                spares.pop_back();
+            }
+        }
+        Memory& pool = *parked[ k ];
+
+        int64_t n = need.host_tiles - int64_t( pool.capacity( HostNum ) );
+        if (n > 0)
+            pool.addHostBlocks( n, host_queue );
+        for (int device = 0; device < Memory::num_devices_; ++device) {
+            int64_t tiles = 0;
+            if (device < int( need.local_tiles.size() ))
+                tiles += need.local_tiles[ device ];
+            if (device < int( need.remote_tiles.size() ))
+                tiles += need.remote_tiles[ device ];
+            n = tiles - int64_t( pool.capacity( device ) );
+            if (n > 0)
+                pool.addDeviceBlocks( device, n, queue( device ) );
+        }
+
+        if (Memory::num_devices_ == 0)
+            continue;
+
+        // Every attached matrix takes parked batch arrays, if any, so each
+        // gets at least the default compute queue.
+        size_t i = num_arrays++;
+        if (i == batch_arrays_.size())
+            batch_arrays_.emplace_back();
+        BatchArrays& arrays = batch_arrays_[ i ];
+        int64_t count = std::max( need.num_batch_arrays, int64_t( 1 ) );
+        int64_t batch_size = std::max( need.batch_size, arrays.size );
+        int64_t a_begin = arrays.size < batch_size ? 0 : arrays.queues.size();
+        if (int64_t( arrays.queues.size() ) < count) {
+            arrays.host  .resize( count, std::vector< void* >( Memory::num_devices_, nullptr ) );
+            arrays.dev   .resize( count, std::vector< void* >( Memory::num_devices_, nullptr ) );
+            arrays.queues.resize( count, std::vector< lapack::Queue* >( Memory::num_devices_, nullptr ) );
+        }
+        for (size_t a = a_begin; a < arrays.queues.size(); ++a) {
+            for (int device = 0; device < Memory::num_devices_; ++device) {
+                blas::Queue* dev_queue = queue( device );
+                if (arrays.host[ a ][ device ] != nullptr)
+                    blas::host_free_pinned( arrays.host[ a ][ device ], *dev_queue );
+                if (arrays.dev[ a ][ device ] != nullptr)
+                    blas::device_free( arrays.dev[ a ][ device ], *dev_queue );
+                if (arrays.queues[ a ][ device ] == nullptr) {
+                    arrays.queues[ a ][ device ]
+                        = a == 0 ? DeviceQueues::compute_queue( device )
+                                 : new lapack::Queue( device );
+                }
+                // As MatrixStorage::allocateBatchArrays: 3 arrays, A, B, C.
+                arrays.host[ a ][ device ]
+                    = blas::host_malloc_pinned<void*>( batch_size*3, *dev_queue );
+                arrays.dev[ a ][ device ]
+                    = blas::device_malloc<void*>( batch_size*3, *dev_queue );
+            }
+        }
+        arrays.size = batch_size;
+    }
+
+    if (size.device_buffer_size > 0) {
+        for (int device = 0; device < int( buffers_.size() ); ++device)
+            deviceBuffer( device, size.device_buffer_size );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return bytes of host memory: tiles, pinned batch arrays, and auxiliary
+/// memory.
+size_t WorkspaceSize::hostBytes() const
+{
+    size_t bytes = host_aux_size;
+    for (auto const& pool : pools) {
+        bytes += pool.host_tiles * pool.block_size;
+        // Pinned batch arrays, one per device.
+        bytes += pool.num_batch_arrays * pool.batch_size * 3 * sizeof(void*)
+                 * pool.local_tiles.size();
+    }
+    return bytes;
+}
+
+//------------------------------------------------------------------------------
+/// @return bytes of memory on device: tiles, batch arrays, scratch buffer,
+/// and auxiliary memory.
+///
+/// @param[in] device
+///     Device ID, 0 <= device < number of devices.
+///
+size_t WorkspaceSize::deviceBytes( int device ) const
+{
+    size_t bytes = device_buffer_size + device_aux_size;
+    for (auto const& pool : pools) {
+        if (device < int( pool.local_tiles.size() ))
+            bytes += pool.local_tiles[ device ] * pool.block_size;
+        if (device < int( pool.remote_tiles.size() ))
+            bytes += pool.remote_tiles[ device ] * pool.block_size;
+        bytes += pool.num_batch_arrays * pool.batch_size * 3 * sizeof(void*);
+    }
+    return bytes;
+}
+
+//------------------------------------------------------------------------------
+/// @return queue on device used to allocate and free the arena's memory,
+/// which is the shared communication queue.
+lapack::Queue* Workspace::queue( int device )
+{
+    return DeviceQueues::comm_queue( device );
+}
+
+//------------------------------------------------------------------------------
+/// Moves blocks of a parked pool with the same block size, if any,
+/// into memory, which is an attached matrix's pool.
+void Workspace::takePool( Memory& memory )
+{
+    auto iter = pools_.find( memory.blockSize() );
+    if (iter == pools_.end() || iter->second.empty())
+        return;
+
+    std::unique_ptr< Memory > pool = std::move( iter->second.front() );
+    iter->second.pop_front();
+    for (int device = HostNum; device < Memory::num_devices_; ++device)
+        memory.moveBlocks( *pool, device );
+    spare_pools_[ memory.blockSize() ].push_back( std::move( pool ) );
+}
+
+//------------------------------------------------------------------------------
+/// Moves blocks of memory, which is a detaching matrix's pool, into a new
+/// parked pool. Blocks on a device are moved only if none is in use there,
+/// e.g., because of Option::HoldLocalWorkspace; otherwise they stay with
+/// the matrix.
+void Workspace::returnPool( Memory& memory )
+{
+    size_t block_size = memory.blockSize();
+    auto& spares = spare_pools_[ block_size ];
+    std::unique_ptr< Memory > pool;
+    if (spares.empty()) {
+        pool.reset( new Memory( block_size ) );
+    }
+    else {
+        pool = std::move( spares.back() );
+        spares.pop_back();
+    }
+
+    bool is_empty = true;
+    for (int device = HostNum; device < Memory::num_devices_; ++device) {
+        if (memory.allocated( device ) == 0) {
+            pool->moveBlocks( memory, device );
+            if (pool->capacity( device ) > 0 || pool->numSizeClasses( device ) > 1)
+                is_empty = false;
+        }
+    }
+
+    if (is_empty)
+        spares.push_back( std::move( pool ) );
+    else
+        pools_[ block_size ].push_back( std::move( pool ) );
+}
+
+} // namespace slate
@@ -0,0 +1,145 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/config.hh"
+#include "slate/enums.hh"
+#include "slate/Exception.hh"
+#include "slate/internal/mpi.hh"
+
+#include "blas.hh"
+
+// Open MPI declares its CUDA and ROCm queries in mpi-ext.h.
+#if ! defined( SLATE_NO_MPI ) && defined( OPEN_MPI )
+    #include <mpi-ext.h>
+#endif
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return true if the MPI library reports that it can send and receive
+/// device memory of the GPU backend SLATE was built with.
+/// Checks, in order:
+/// - Open MPI:   `MPIX_Query_cuda_support` or `MPIX_Query_rocm_support`;
+/// - MPICH 4.1+: `MPIX_GPU_query_support`, once MPI is initialized;
+/// - otherwise (e.g., Cray MPICH): $MPICH_GPU_SUPPORT_ENABLED is 1.
+/// Always false without a GPU backend or without MPI.
+///
+bool query_gpu_aware_mpi()
+{
+    bool aware = false;
+
+#if defined( SLATE_NO_MPI ) \
+    || ! (defined( BLAS_HAVE_CUBLAS ) || defined( BLAS_HAVE_ROCBLAS ))
+    // No MPI or no GPU backend; nothing to query.
+
+#elif defined( BLAS_HAVE_CUBLAS ) \
+    && defined( MPIX_CUDA_AWARE_SUPPORT ) && MPIX_CUDA_AWARE_SUPPORT
+    aware = MPIX_Query_cuda_support() == 1;
+
+#elif defined( BLAS_HAVE_ROCBLAS ) \
+    && defined( MPIX_ROCM_AWARE_SUPPORT ) && MPIX_ROCM_AWARE_SUPPORT
+    aware = MPIX_Query_rocm_support() == 1;
+
+#elif defined( MPICH_NUMVERSION ) && MPICH_NUMVERSION >= 40100000
+    int initialized = 0;
+    MPI_Initialized( &initialized );
+    if (initialized) {
+        int supported = 0;
+        #if defined( BLAS_HAVE_CUBLAS )
+            MPIX_GPU_query_support( MPIX_GPU_SUPPORT_CUDA, &supported );
+        #else
+            MPIX_GPU_query_support( MPIX_GPU_SUPPORT_HIP, &supported );
+        #endif
+        aware = supported != 0;
+    }
+
+#else
+    const char* env = getenv( "MPICH_GPU_SUPPORT_ENABLED" );
+    aware = env != nullptr && strcmp( env, "1" ) == 0;
+#endif
+
+    return aware;
+}
+
+//------------------------------------------------------------------------------
+/// Parses a list of cores, as in taskset -c:
+/// comma-separated core numbers and inclusive ranges, e.g., "0-3,8,10".
+/// Invalid entries are ignored.
+///
+/// @param[in] str
+///     List of cores.
+///
+/// @return cores, in the order listed.
+///
+std::vector<int> parse_core_list( const char* str )
+{
+    std::vector<int> cores;
+    const char* p = str;
+    while (*p != '\0') {
+        char* end;
+        long first = strtol( p, &end, 10 );
+        if (end == p) {
+            // Skip an invalid character.
+            ++p;
+            continue;
+        }
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol( p + 1, &end, 10 );
+            if (end == p + 1)
+                last = first;
+            p = end;
+        }
+        for (long c = first; c <= last; ++c) {
+            if (c >= 0)
+                cores.push_back( int( c ) );
+        }
+        if (*p == ',')
+            ++p;
+    }
+    return cores;
+}
+
+//------------------------------------------------------------------------------
+/// Sets the math mode of the device BLAS handle of a queue.
+/// MathMode::TF32 maps to CUBLAS_TF32_TENSOR_OP_MATH (CUDA >= 11) or
+/// rocblas_xf32_xdl_math_op (rocBLAS >= 2.45); where it is not available,
+/// the queue keeps the default math, which is correct, only slower.
+/// MathMode::Default restores IEEE single precision.
+///
+/// @param[in] mode
+///     The math mode.
+///
+/// @param[in,out] queue
+///     BLAS++ queue whose handle to set.
+///
+void set_math_mode( MathMode mode, blas::Queue& queue )
+{
+#if defined( BLAS_HAVE_CUBLAS ) && defined( CUDART_VERSION ) \
+    && CUDART_VERSION >= 11000
+    cublasMath_t math = (mode == MathMode::TF32
+                         ? CUBLAS_TF32_TENSOR_OP_MATH
+                         : CUBLAS_DEFAULT_MATH);
+    cublasStatus_t status = cublasSetMathMode( queue.handle(), math );
+    slate_assert( status == CUBLAS_STATUS_SUCCESS );
+
+#elif defined( BLAS_HAVE_ROCBLAS ) && defined( ROCBLAS_VERSION_MAJOR ) \
+    && (ROCBLAS_VERSION_MAJOR > 2 \
+        || (ROCBLAS_VERSION_MAJOR == 2 && ROCBLAS_VERSION_MINOR >= 45))
+    rocblas_math_mode math = (mode == MathMode::TF32
+                              ? rocblas_xf32_xdl_math_op
+                              : rocblas_default_math);
+    rocblas_status status = rocblas_set_math_mode( queue.handle(), math );
+    slate_assert( status == rocblas_status_success );
+
+#else
+    // Default math only.
+#endif
+}
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,139 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/method.hh"
+#include "slate/internal/util.hh"
+
+#include "blas.hh"
+
+namespace slate {
+namespace CostModel {
+
+//------------------------------------------------------------------------------
+/// Measures the machine parameters of the cost model with short
+/// micro-benchmarks, sets them for this process, and, if filename is
+/// given, writes them there on rank 0, to be read back on later runs via
+/// the SLATE_COST_MODEL environment variable:
+/// - host and device flop rates, from nb-by-nb dgemm;
+/// - latency and bandwidth, from a ping-pong between ranks 0 and 1
+///   with 1 and nb*nb doubles.
+/// Rank 0's values are broadcast, so all ranks select the same methods.
+/// Collective over comm.
+///
+/// @param[in] comm
+///     MPI communicator.
+///
+/// @param[in] filename
+///     Cache file to write, or nullptr.
+///
+/// @param[in] nb
+///     Block size of the benchmarks, typically the tile size used.
+///
+void calibrate( MPI_Comm comm, const char* filename, int64_t nb )
+{
+    const int repeat = 10;
+    const int tag = 0;
+
+    int mpi_rank, mpi_size;
+    slate_mpi_call(
+        MPI_Comm_rank( comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_size( comm, &mpi_size ) );
+
+    Machine& mc = machine();
+    double params[ 4 ] = { mc.host_flop_rate, mc.device_flop_rate,
+                           mc.bandwidth, mc.latency };
+
+    int64_t n2 = nb*nb;
+    std::vector<double> A( n2, 1.0 ), B( n2, 1.0 ), C( n2, 0.0 );
+    double gemm_flops = 2.0 * nb * nb * nb * repeat;
+
+    if (mpi_rank == 0) {
+        // Host gemm; first call is a warmup.
+        blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                    nb, nb, nb, 1.0, A.data(), nb, B.data(), nb,
+                    0.0, C.data(), nb );
+        Timer timer;
+        for (int i = 0; i < repeat; ++i) {
+            blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                        blas::Op::NoTrans, nb, nb, nb,
+                        1.0, A.data(), nb, B.data(), nb,
+                        0.0, C.data(), nb );
+        }
+        params[ 0 ] = gemm_flops / timer.stop();
+
+        // Device gemm, on device 0.
+        if (blas::get_device_count() > 0) {
+            blas::Queue queue( 0 );
+            double* dA = blas::device_malloc<double>( 3*n2, queue );
+            double* dB = dA + n2;
+            double* dC = dB + n2;
+            blas::device_copy_matrix( nb, nb, A.data(), nb, dA, nb, queue );
+            blas::device_copy_matrix( nb, nb, B.data(), nb, dB, nb, queue );
+            blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                        blas::Op::NoTrans, nb, nb, nb,
+                        1.0, dA, nb, dB, nb, 0.0, dC, nb, queue );
+            queue.sync();
+            timer.start();
+            for (int i = 0; i < repeat; ++i) {
+                blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans,
+                            blas::Op::NoTrans, nb, nb, nb,
+                            1.0, dA, nb, dB, nb, 0.0, dC, nb, queue );
+            }
+            queue.sync();
+            params[ 1 ] = gemm_flops / timer.stop();
+            blas::device_free( dA, queue );
+        }
+    }
+
+    // Ping-pong between ranks 0 and 1: round trip of count doubles.
+    auto ping_pong = [&]( int count ) {
+        Timer timer;
+        for (int i = 0; i < repeat; ++i) {
+            if (mpi_rank == 0) {
+                slate_mpi_call(
+                    MPI_Send( A.data(), count, MPI_DOUBLE, 1, tag, comm ) );
+                slate_mpi_call(
+                    MPI_Recv( A.data(), count, MPI_DOUBLE, 1, tag, comm,
+                              MPI_STATUS_IGNORE ) );
+            }
+            else if (mpi_rank == 1) {
+                slate_mpi_call(
+                    MPI_Recv( A.data(), count, MPI_DOUBLE, 0, tag, comm,
+                              MPI_STATUS_IGNORE ) );
+                slate_mpi_call(
+                    MPI_Send( A.data(), count, MPI_DOUBLE, 0, tag, comm ) );
+            }
+        }
+        return timer.stop() / (2*repeat);
+    };
+    if (mpi_size > 1) {
+        double latency = ping_pong( 1 );
+        double time = ping_pong( int( n2 ) );
+        if (mpi_rank == 0) {
+            params[ 3 ] = latency;
+            params[ 2 ] = n2 * sizeof( double ) / std::max( time - latency,
+                                                             latency );
+        }
+    }
+
+    slate_mpi_call(
+        MPI_Bcast( params, 4, MPI_DOUBLE, 0, comm ) );
+    mc.host_flop_rate   = params[ 0 ];
+    mc.device_flop_rate = params[ 1 ];
+    mc.bandwidth        = params[ 2 ];
+    mc.latency          = params[ 3 ];
+
+    if (mpi_rank == 0 && filename != nullptr) {
+        std::ofstream file( filename );
+        file << "host_flop_rate "   << mc.host_flop_rate   << "\n"
+             << "device_flop_rate " << mc.device_flop_rate << "\n"
+             << "bandwidth "        << mc.bandwidth        << "\n"
+             << "latency "          << mc.latency          << "\n";
+    }
+}
+
+} // namespace CostModel
+} // namespace slate
@@ -0,0 +1,205 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/tuning.hh"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace slate {
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// One line of the tuning file.
+struct TuningEntry {
+    std::string routine;
+    Target target;
+    int64_t n_max;
+    TunedParams params;
+};
+
+//------------------------------------------------------------------------------
+/// Table of tuned parameters, sorted by routine, target, and n_max.
+/// Initially read from the file named by $SLATE_TUNING_FILE, if set.
+class TuningTable {
+public:
+    static TuningTable& get()
+    {
+        static TuningTable singleton;
+        return singleton;
+    }
+
+    std::mutex mutex;
+    std::vector<TuningEntry> entries;
+
+private:
+    TuningTable()
+    {
+        const char* filename = std::getenv( "SLATE_TUNING_FILE" );
+        if (filename != nullptr && filename[ 0 ] != '\0')
+            read( filename, entries );
+    }
+
+public:
+    //----------------------------------------
+    /// Parses filename into entries.
+    /// @return true if the file could be opened.
+    static bool read( const char* filename, std::vector<TuningEntry>& entries )
+    {
+        std::ifstream file( filename );
+        if (! file)
+            return false;
+
+        entries.clear();
+        std::string line;
+        while (std::getline( file, line )) {
+            line = line.substr( 0, line.find( '#' ) );
+            std::istringstream fields( line );
+            TuningEntry entry;
+            std::string target;
+            if (! (fields >> entry.routine >> target >> entry.n_max
+                          >> entry.params.nb >> entry.params.ib
+                          >> entry.params.lookahead
+                          >> entry.params.panel_threads))
+                continue;  // blank or invalid line
+
+            // Accept names, e.g., HostTask, or tester letters, e.g., t.
+            std::transform( target.begin(), target.end(), target.begin(),
+                            ::tolower );
+            if (target == "d" || target == "devices")
+                entry.target = Target::Devices;
+            else if (target == "n" || target == "hostnest")
+                entry.target = Target::HostNest;
+            else if (target == "b" || target == "hostbatch")
+                entry.target = Target::HostBatch;
+            else if (target == "t" || target == "hosttask"
+                     || target == "h" || target == "host")
+                entry.target = Target::HostTask;
+            else
+                continue;
+
+            entries.push_back( entry );
+        }
+
+        // n_max = 0 (any size) sorts after all other ranges.
+        auto key = []( TuningEntry const& e ) {
+            return std::make_tuple(
+                e.routine, e.target,
+                e.n_max > 0 ? e.n_max : std::numeric_limits<int64_t>::max() );
+        };
+        std::stable_sort( entries.begin(), entries.end(),
+            [&key]( TuningEntry const& a, TuningEntry const& b ) {
+                return key( a ) < key( b );
+            } );
+        return true;
+    }
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+/// Reads tuned parameters from a tuning file, replacing those read
+/// previously, including from $SLATE_TUNING_FILE. Should be called
+/// with the same file on all MPI ranks, so they use the same parameters.
+/// @see TunedParams for the file format.
+///
+/// @param[in] filename
+///     Tuning file, typically written by test/autotune.py.
+///
+/// @return true if the file could be opened; otherwise the parameters
+///         read previously are kept.
+///
+bool read_tuning_file( const char* filename )
+{
+    std::vector<TuningEntry> entries;
+    if (! TuningTable::read( filename, entries ))
+        return false;
+
+    TuningTable& table = TuningTable::get();
+    std::lock_guard<std::mutex> guard( table.mutex );
+    table.entries = std::move( entries );
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// @return parameters tuned for routine on target at problem size n,
+/// from the tuning file; fields < 0 were not tuned.
+/// The tuning file is initially named by $SLATE_TUNING_FILE,
+/// or set by read_tuning_file.
+///
+/// @param[in] routine
+///     Routine name, without precision, e.g., "getrf".
+///
+/// @param[in] target
+///     Target; Host is treated as HostTask.
+///
+/// @param[in] n
+///     Problem size, e.g., min( m, n ) for a factorization.
+///
+TunedParams tuned_params( std::string const& routine, Target target,
+                          int64_t n )
+{
+    if (target == Target::Host)
+        target = Target::HostTask;
+
+    TuningTable& table = TuningTable::get();
+    std::lock_guard<std::mutex> guard( table.mutex );
+
+    // Entries are sorted, so the first range containing n is the tightest;
+    // otherwise, use the largest range.
+    TuningEntry const* match = nullptr;
+    for (auto const& entry : table.entries) {
+        if (entry.routine == routine && entry.target == target) {
+            match = &entry;
+            if (entry.n_max <= 0 || n <= entry.n_max)
+                break;
+        }
+    }
+    return match != nullptr ? match->params : TunedParams();
+}
+
+//------------------------------------------------------------------------------
+/// @return copy of opts with tuned values for the options that are not in
+/// opts: Option::InnerBlocking, Option::Lookahead, Option::MaxPanelThreads.
+/// Explicit options always take precedence over the tuning file.
+/// The target is from Option::Target, default HostTask.
+/// The tile size is fixed by the matrix, so the tuned nb is not used here;
+/// code that creates matrices, such as the LAPACK and ScaLAPACK APIs, can
+/// use tuned_params().nb.
+///
+/// @param[in] routine
+///     Routine name, without precision, e.g., "getrf".
+///
+/// @param[in] n
+///     Problem size, e.g., min( m, n ) for a factorization.
+///
+/// @param[in] opts
+///     Options given by the caller.
+///
+Options tuned_options( std::string const& routine, int64_t n,
+                       Options const& opts )
+{
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    TunedParams tuned = tuned_params( routine, target, n );
+
+    Options tuned_opts = opts;
+    if (tuned.ib > 0)
+        tuned_opts.insert( { Option::InnerBlocking, tuned.ib } );
+    if (tuned.lookahead >= 0)
+        tuned_opts.insert( { Option::Lookahead, tuned.lookahead } );
+    if (tuned.panel_threads > 0)
+        tuned_opts.insert( { Option::MaxPanelThreads, tuned.panel_threads } );
+    return tuned_opts;
+}
+
+} // namespace slate
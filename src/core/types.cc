@@ -19,7 +19,4 @@ MPI_Datatype mpi_type< std::complex<double> >::value = MPI_C_DOUBLE_COMPLEX;
 MPI_Datatype mpi_type< max_loc_type<float>  >::value = MPI_FLOAT_INT;
 MPI_Datatype mpi_type< max_loc_type<double> >::value = MPI_DOUBLE_INT;
 
-//------------------------------------------------------------------------------
-std::map< std::string, double > timers;
-
 } // namespace slate
@@ -0,0 +1,265 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.cuh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel splitting a complex tile into real parts for 3M gemm.
+/// Each thread deals with one row.
+/// @copydoc gemm3m_split
+template <typename scalar_t, typename real_t>
+__global__ void gemm3m_split_kernel(
+    int64_t m, int64_t n, bool conj_A,
+    scalar_t const* A, int64_t lda,
+    real_t* Ar, real_t* Ai, real_t* As, int64_t ldr)
+{
+    // thread per row, if more rows than threads, loop by blockDim.x
+    for (int64_t i = threadIdx.x; i < m; i += blockDim.x) {
+        for (int64_t j = 0; j < n; ++j) {
+            scalar_t a = A[ i + j*lda ];
+            real_t a_i = conj_A ? -imag( a ) : imag( a );
+            Ar[ i + j*ldr ] = real( a );
+            Ai[ i + j*ldr ] = a_i;
+            As[ i + j*ldr ] = real( a ) + a_i;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel combining the real products of 3M gemm into a complex tile.
+/// Each thread deals with one row.
+/// @copydoc gemm3m_combine
+template <typename scalar_t, typename real_t>
+__global__ void gemm3m_combine_kernel(
+    int64_t m, int64_t n,
+    scalar_t alpha, scalar_t ialpha,
+    real_t const* T1, real_t const* T2, real_t const* T3, int64_t ldt,
+    scalar_t beta, bool overwrite, scalar_t* C, int64_t ldc)
+{
+    // thread per row, if more rows than threads, loop by blockDim.x
+    for (int64_t i = threadIdx.x; i < m; i += blockDim.x) {
+        for (int64_t j = 0; j < n; ++j) {
+            real_t t1 = T1[ i + j*ldt ];
+            real_t t2 = T2[ i + j*ldt ];
+            scalar_t re, im;
+            copy( t1 - t2, re );
+            copy( T3[ i + j*ldt ] - t1 - t2, im );
+            // alpha (re + i im) = alpha re + (i alpha) im
+            scalar_t c = alpha * re + ialpha * im;
+            if (! overwrite)
+                c = c + beta * C[ i + j*ldc ];
+            C[ i + j*ldc ] = c;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Launches gemm3m_split_kernel, for CUDA complex types.
+template <typename scalar_t, typename real_t>
+void gemm3m_split_launch(
+    int64_t m, int64_t n, bool conj_A,
+    scalar_t const* A, int64_t lda,
+    real_t* Ar, real_t* Ai, real_t* As, int64_t ldr,
+    blas::Queue& queue)
+{
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Max threads/block=1024 for current CUDA compute capability (<= 7.5)
+    int64_t nthreads = std::min( int64_t( 1024 ), m );
+
+    gemm3m_split_kernel<<<1, nthreads, 0, queue.stream()>>>(
+        m, n, conj_A, A, lda, Ar, Ai, As, ldr );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Launches gemm3m_combine_kernel, for CUDA complex types.
+template <typename scalar_t, typename real_t>
+void gemm3m_combine_launch(
+    int64_t m, int64_t n,
+    scalar_t alpha, scalar_t ialpha,
+    real_t const* T1, real_t const* T2, real_t const* T3, int64_t ldt,
+    scalar_t beta, bool overwrite, scalar_t* C, int64_t ldc,
+    blas::Queue& queue)
+{
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Max threads/block=1024 for current CUDA compute capability (<= 7.5)
+    int64_t nthreads = std::min( int64_t( 1024 ), m );
+
+    gemm3m_combine_kernel<<<1, nthreads, 0, queue.stream()>>>(
+        m, n, alpha, ialpha, T1, T2, T3, ldt, beta, overwrite, C, ldc );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Splits a complex tile into the real parts used by 3M gemm,
+/// \[
+///     A_r = \Re A, \quad
+///     A_i = \Im A, \quad
+///     A_s = A_r + A_i,
+/// \]
+/// where A is conjugated first if conj_A is true.
+/// Defined only for complex types; specializations cast
+/// std::complex => cuComplex.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] conj_A
+///     Whether to split conj( A ) instead of A.
+///
+/// @param[in] A
+///     The m-by-n complex tile, stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[out] Ar
+///     The m-by-n real part, stored in an ldr-by-n array in GPU memory.
+///
+/// @param[out] Ai
+///     The m-by-n imaginary part, stored in an ldr-by-n array in GPU memory.
+///
+/// @param[out] As
+///     The m-by-n sum Ar + Ai, stored in an ldr-by-n array in GPU memory.
+///
+/// @param[in] ldr
+///     Leading dimension of Ar, Ai, As. ldr >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <>
+void gemm3m_split(
+    int64_t m, int64_t n, bool conj_A,
+    std::complex<float> const* A, int64_t lda,
+    float* Ar, float* Ai, float* As, int64_t ldr,
+    blas::Queue& queue)
+{
+    gemm3m_split_launch(
+        m, n, conj_A, (cuFloatComplex const*) A, lda,
+        Ar, Ai, As, ldr, queue );
+}
+
+template <>
+void gemm3m_split(
+    int64_t m, int64_t n, bool conj_A,
+    std::complex<double> const* A, int64_t lda,
+    double* Ar, double* Ai, double* As, int64_t ldr,
+    blas::Queue& queue)
+{
+    gemm3m_split_launch(
+        m, n, conj_A, (cuDoubleComplex const*) A, lda,
+        Ar, Ai, As, ldr, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Combines the real products of 3M gemm,
+/// $T_1 = A_r B_r$, $T_2 = A_i B_i$, $T_3 = A_s B_s$, into
+/// \[
+///     C = \alpha ((T_1 - T_2) + i (T_3 - T_1 - T_2)) + \beta C.
+/// \]
+/// If beta = 0, C need not be set on input.
+/// Defined only for complex types; specializations cast
+/// std::complex => cuComplex.
+///
+/// @param[in] m
+///     Number of rows of C. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of C. n >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] T1
+///     The m-by-n real product Ar Br, stored in an ldt-by-n array
+///     in GPU memory.
+///
+/// @param[in] T2
+///     The m-by-n real product Ai Bi, stored in an ldt-by-n array
+///     in GPU memory.
+///
+/// @param[in] T3
+///     The m-by-n real product As Bs, stored in an ldt-by-n array
+///     in GPU memory.
+///
+/// @param[in] ldt
+///     Leading dimension of T1, T2, T3. ldt >= m.
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] C
+///     The m-by-n complex tile, stored in an ldc-by-n array in GPU memory.
+///
+/// @param[in] ldc
+///     Leading dimension of C. ldc >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <>
+void gemm3m_combine(
+    int64_t m, int64_t n,
+    std::complex<float> const& alpha,
+    float const* T1, float const* T2, float const* T3, int64_t ldt,
+    std::complex<float> const& beta, std::complex<float>* C, int64_t ldc,
+    blas::Queue& queue)
+{
+    bool overwrite = beta == std::complex<float>( 0 );
+    gemm3m_combine_launch(
+        m, n,
+        make_cuFloatComplex( real( alpha ), imag( alpha ) ),
+        make_cuFloatComplex( -imag( alpha ), real( alpha ) ),
+        T1, T2, T3, ldt,
+        make_cuFloatComplex( real( beta ), imag( beta ) ), overwrite,
+        (cuFloatComplex*) C, ldc, queue );
+}
+
+template <>
+void gemm3m_combine(
+    int64_t m, int64_t n,
+    std::complex<double> const& alpha,
+    double const* T1, double const* T2, double const* T3, int64_t ldt,
+    std::complex<double> const& beta, std::complex<double>* C, int64_t ldc,
+    blas::Queue& queue)
+{
+    bool overwrite = beta == std::complex<double>( 0 );
+    gemm3m_combine_launch(
+        m, n,
+        make_cuDoubleComplex( real( alpha ), imag( alpha ) ),
+        make_cuDoubleComplex( -imag( alpha ), real( alpha ) ),
+        T1, T2, T3, ldt,
+        make_cuDoubleComplex( real( beta ), imag( beta ) ), overwrite,
+        (cuDoubleComplex*) C, ldc, queue );
+}
+
+} // namespace device
+} // namespace slate
@@ -64,6 +64,23 @@ __global__ void geset_batch_kernel(
                 Aarray[ blockIdx.x ], lda );
 }
 
+//------------------------------------------------------------------------------
+/// Kernel implementing variable-size batched element-wise tile set.
+/// @copydoc geset_vbatch
+template <typename scalar_t>
+__global__ void geset_vbatch_kernel(
+    int64_t const* m, int64_t const* n,
+    scalar_t offdiag_value,
+    scalar_t diag_value,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal)
+{
+    int64_t k = blockIdx.x;
+    geset_func( m[ k ], n[ k ], offdiag_value,
+                (is_diagonal[ k ] ? diag_value : offdiag_value),
+                Aarray[ k ], lda[ k ] );
+}
+
 //------------------------------------------------------------------------------
 /// Element-wise m-by-n matrix A
 /// to diag_value on the diagonal and offdiag_value on the off-diagonals.
@@ -271,5 +288,129 @@ void geset(
 }
 
 } // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile set,
+/// where each tile has its own dimensions, so one launch covers interior
+/// and edge tiles alike.
+/// Sets tiles marked by is_diagonal to diag_value on the diagonal and
+/// offdiag_value on the off-diagonals, and all other tiles to offdiag_value.
+///
+/// @param[in] m
+///     Array in GPU memory of dimension batch_count.
+///     Number of rows of each tile. m[k] >= 0.
+///
+/// @param[in] n
+///     Array in GPU memory of dimension batch_count.
+///     Number of columns of each tile. n[k] >= 0.
+///
+/// @param[in] offdiag_value
+///     The value to set outside of the diagonal.
+///
+/// @param[in] diag_value
+///     The value to set on the diagonal of diagonal tiles.
+///
+/// @param[out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m[k]-by-n[k] matrix stored in an
+///     lda[k]-by-n[k] array in GPU memory.
+///
+/// @param[in] lda
+///     Array in GPU memory of dimension batch_count.
+///     Leading dimension of each tile in A. lda[k] >= m[k].
+///
+/// @param[in] is_diagonal
+///     Array in GPU memory of dimension batch_count.
+///     Non-zero if Aarray[k] is a diagonal tile.
+///
+/// @param[in] max_m
+///     Maximum of m[k], which sets the number of threads.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& offdiag_value,
+    scalar_t const& diag_value,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Max threads/block=1024 for current CUDA compute capability (<= 7.5)
+    int64_t nthreads = std::min( int64_t( 1024 ), max_m );
+
+    geset_vbatch_kernel<<<batch_count, nthreads, 0, queue.stream()>>>(
+        m, n,
+        offdiag_value, diag_value, Aarray, lda, is_diagonal);
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    float const& offdiag_value,
+    float const& diag_value,
+    float** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    double const& offdiag_value,
+    double const& diag_value,
+    double** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> const& offdiag_value,
+    std::complex<float> const& diag_value,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+    geset_vbatch( m, n,
+                  make_cuFloatComplex( real( offdiag_value ), imag( offdiag_value ) ),
+                  make_cuFloatComplex( real( diag_value    ), imag( diag_value    ) ),
+                  (cuFloatComplex**) Aarray, lda, is_diagonal,
+                  max_m, batch_count, queue );
+}
+
+template <>
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> const& offdiag_value,
+    std::complex<double> const& diag_value,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+    geset_vbatch( m, n,
+                  make_cuDoubleComplex( real( offdiag_value ), imag( offdiag_value ) ),
+                  make_cuDoubleComplex( real( diag_value    ), imag( diag_value    ) ),
+                  (cuDoubleComplex**) Aarray, lda, is_diagonal,
+                  max_m, batch_count, queue );
+}
+
 } // namespace device
 } // namespace slate
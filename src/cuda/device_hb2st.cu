@@ -0,0 +1,294 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_householder.cuh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Applies $H^H A H$, with $H = I - \tau v v^H$, to the m-by-m Hermitian
+/// block A( i0 : i0+m-1, i0 : i0+m-1 ), of which the lower triangle is
+/// stored, as SLATE's herf with conj( tau ).
+/// Called by all threads of the block.
+///
+/// @param[in] v
+///     Vector of length m in shared memory, with v[0] = 1.
+///
+/// @param[out] w
+///     Workspace of length m in shared memory.
+///
+/// @param[out] work
+///     Array of length blockDim.x in shared memory.
+///
+template <typename scalar_t>
+__device__ void herf(
+    scalar_t tau, scalar_t const* v,
+    BandStorage<scalar_t> A, int64_t i0, int64_t m,
+    scalar_t* w, scalar_t* work )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // w = A v
+    for (int64_t r = threadIdx.x; r < m; r += blockDim.x) {
+        scalar_t sum;
+        copy( real_t( 0 ), sum );
+        for (int64_t k = 0; k < m; ++k) {
+            scalar_t Ark = r >= k ? A( i0 + r, i0 + k )
+                                  : conj( A( i0 + k, i0 + r ) );
+            sum += Ark * v[ k ];
+        }
+        w[ r ] = sum;
+    }
+    __syncthreads();
+
+    // w = A v - 0.5 tau (w^H v) v
+    scalar_t dot;
+    copy( real_t( 0 ), dot );
+    for (int64_t r = threadIdx.x; r < m; r += blockDim.x)
+        dot += conj( w[ r ] ) * v[ r ];
+    dot = block_sum( dot, work );
+    scalar_t alpha = real_t( -0.5 ) * tau * dot;
+    for (int64_t r = threadIdx.x; r < m; r += blockDim.x)
+        w[ r ] += alpha * v[ r ];
+    __syncthreads();
+
+    // A = A - tau v w^H - conj( tau ) w v^H, lower triangle
+    for (int64_t idx = threadIdx.x; idx < m*m; idx += blockDim.x) {
+        int64_t r = idx % m;
+        int64_t k = idx / m;
+        if (r >= k) {
+            A( i0 + r, i0 + k ) -= tau * v[ r ] * conj( w[ k ] )
+                                   + conj( tau ) * w[ r ] * conj( v[ k ] );
+        }
+    }
+    __syncthreads();
+}
+
+//------------------------------------------------------------------------------
+/// Kernel for tridiagonal bulge chasing. Each thread block does whole
+/// sweeps, sweep = blockIdx.x, blockIdx.x + gridDim.x, ..., one step at a
+/// time, the threads cooperating on the Householder updates of each step.
+/// Before each step, a block waits until the previous sweep, done by the
+/// previous block, is two steps ahead, as in the host hb2st; hence all
+/// blocks must be resident at once.
+/// Launched by hb2st().
+///
+/// @copydoc hb2st
+///
+template <typename scalar_t>
+__global__ void hb2st_kernel(
+    int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* V, int64_t ldv,
+    int* progress)
+{
+    extern __shared__ char dynamic_data[];
+    scalar_t* v    = (scalar_t*) dynamic_data;  // band + 1
+    scalar_t* w    = v + band + 1;              // band + 1
+    scalar_t* work = w + band + 1;              // blockDim.x
+
+    BandStorage<scalar_t> A = { AB, ldab, 0 };
+
+    for (int64_t sweep = blockIdx.x; sweep < n-1; sweep += gridDim.x) {
+        int64_t nsteps = 2*ceildiv( n - 1 - sweep, band ) - 1;
+        int64_t nsteps_prev = 2*ceildiv( n - sweep, band ) - 1;
+
+        // Householder vector of step t is in column vindex*band + vj + t*band
+        // of V, starting in row vi, as in the host hb2st_step.
+        int64_t vj = sweep % band;
+        int64_t vi = vj + 1;
+        int64_t k  = sweep / band;
+        int64_t vindex = k*nt - k*(k - 1)/2;
+        scalar_t* Vsweep = &V[ vi + (vindex*band + vj)*ldv ];
+
+        for (int64_t step = 0; step < nsteps; ++step) {
+            if (sweep > 0) {
+                // Wait until sweep-1 is two tasks ahead,
+                // or sweep-1 is finished.
+                wait_progress( progress, sweep-1,
+                               min( step+2, nsteps_prev-1 ) );
+            }
+
+            int64_t block = step/2;
+            scalar_t tau;
+            if (step == 0) {
+                // Brings col i to tridiagonal and updates the diagonal block.
+                int64_t i = sweep;
+                int64_t m1 = min( i+band, n-1 ) - i;
+                larfg( m1, &A( i+1, i ), 1, false, v, work );
+                for (int64_t r = threadIdx.x; r < m1; r += blockDim.x)
+                    Vsweep[ r ] = v[ r ];
+                tau = unpack_tau( v );
+                apply_left( conj( tau ), v, A, i+1, i, m1, 1, w );
+                herf( conj( tau ), v, A, i+1, m1, w, work );
+            }
+            else if (step % 2 == 1) {
+                // Applies the update from the previous step to an
+                // off-diagonal block, creating a bulge, then brings col j
+                // back to the original bandwidth.
+                int64_t i = (block+1)*band + 1 + sweep;
+                int64_t j =  block   *band + 1 + sweep;
+                if (i < n) {
+                    int64_t m2 = min( i+band-1, n-1 ) - i + 1;
+                    scalar_t* V1 = &Vsweep[ ((step-1)/2)*band*ldv ];
+                    scalar_t* V2 = &Vsweep[ ((step+1)/2)*band*ldv ];
+                    for (int64_t r = threadIdx.x; r < band; r += blockDim.x)
+                        v[ r ] = V1[ r ];
+                    tau = unpack_tau( v );
+                    apply_right( tau, v, A, i, j, m2, band, w );
+
+                    larfg( m2, &A( i, j ), 1, false, v, work );
+                    for (int64_t r = threadIdx.x; r < m2; r += blockDim.x)
+                        V2[ r ] = v[ r ];
+                    tau = unpack_tau( v );
+                    apply_left( conj( tau ), v, A, i, j, m2, band, w );
+                }
+            }
+            else {
+                // Applies the update from the previous step to a
+                // diagonal block.
+                int64_t i = block*band + 1 + sweep;
+                if (i < n) {
+                    int64_t m1 = min( i+band-1, n-1 ) - i + 1;
+                    scalar_t* V1 = &Vsweep[ block*band*ldv ];
+                    for (int64_t r = threadIdx.x; r < m1; r += blockDim.x)
+                        v[ r ] = V1[ r ];
+                    tau = unpack_tau( v );
+                    herf( conj( tau ), v, A, i, m1, w, work );
+                }
+            }
+
+            // Mark step as done.
+            set_progress( progress, sweep, step );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Reduces a Hermitian band matrix to real symmetric tridiagonal form by
+/// bulge chasing, computing the same Householder vectors as the host
+/// hb2st. Sweeps run concurrently, one per thread block, pipelined as in
+/// the host version, so the whole second stage of heev is one launch.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in] band
+///     Bandwidth of A. band >= 1.
+///
+/// @param[in] nt
+///     Number of block columns of A, ceil( n / band ); determines
+///     where vectors are stored in V.
+///
+/// @param[in,out] AB
+///     The band of A, in GPU memory: A(i, j), for 0 <= i - j < 2*band,
+///     is AB[ i - j + j*ldab ]. On entry, rows band+1 to 2*band-1 of
+///     AB are zero, for the bulges. On exit, the real diagonal and
+///     subdiagonal of the tridiagonal matrix are in rows 0 and 1.
+///
+/// @param[in] ldab
+///     Leading dimension of AB. ldab >= 2*band.
+///
+/// @param[out] V
+///     The Householder vectors, in GPU memory, in the layout of the
+///     2*band-by-(nt*(nt + 1)/2*band) matrix V of hb2st with tile size
+///     band, stored column-wise. Entries not holding vectors are not
+///     referenced.
+///
+/// @param[in] ldv
+///     Leading dimension of V. ldv >= 2*band.
+///
+/// @param[out] progress
+///     Workspace of length n in GPU memory, on entry set to -1 in
+///     every entry.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+    if (n <= 1)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Progress between blocks requires they are all resident,
+    // so launch one block per multiprocessor, at most.
+    int sm_count;
+    cudaDeviceGetAttribute( &sm_count, cudaDevAttrMultiProcessorCount,
+                            queue.device() );
+    int64_t nblocks = std::min( n-1, int64_t( sm_count ) );
+    int64_t nthreads = 128;  // power of 2 for block_sum
+    size_t shared_bytes = sizeof(scalar_t) * (2*(band + 1) + nthreads);
+
+    hb2st_kernel<<<nblocks, nthreads, shared_bytes, queue.stream()>>>(
+        n, band, nt, AB, ldab, V, ldv, progress );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    float* AB, int64_t ldab,
+    float* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    double* AB, int64_t ldab,
+    double* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+    hb2st( n, band, nt,
+           (cuFloatComplex*) AB, ldab,
+           (cuFloatComplex*) V, ldv,
+           progress, queue );
+}
+
+template <>
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+    hb2st( n, band, nt,
+           (cuDoubleComplex*) AB, ldab,
+           (cuDoubleComplex*) V, ldv,
+           progress, queue );
+}
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,246 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_DEVICE_HOUSEHOLDER_CUH
+#define SLATE_DEVICE_HOUSEHOLDER_CUH
+
+#include "device_util.cuh"
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Band matrix stored by diagonals, as in LAPACK: element A(i, j) is
+/// AB[ ku + i - j + j*ldab ], where ku is the number of superdiagonals
+/// stored. Used by the bulge chasing kernels.
+template <typename scalar_t>
+struct BandStorage {
+    scalar_t* AB;
+    int64_t ldab;
+    int64_t ku;
+
+    __device__ scalar_t& operator()( int64_t i, int64_t j ) const
+    {
+        return AB[ ku + i - j + j*ldab ];
+    }
+};
+
+//------------------------------------------------------------------------------
+/// @return sum of x over all threads of the block, in every thread.
+/// blockDim.x must be a power of 2.
+///
+/// @param[in] x
+///     This thread's value.
+///
+/// @param[out] work
+///     Array of length blockDim.x in shared memory.
+///
+template <typename scalar_t>
+__device__ scalar_t block_sum( scalar_t x, scalar_t* work )
+{
+    work[ threadIdx.x ] = x;
+    __syncthreads();
+    for (int s = blockDim.x / 2; s > 0; s /= 2) {
+        if (threadIdx.x < s)
+            work[ threadIdx.x ] += work[ threadIdx.x + s ];
+        __syncthreads();
+    }
+    scalar_t sum = work[ 0 ];
+    __syncthreads();  // work can be reused
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+/// Generates a Householder reflector $H = I - \tau v v^H$ such that
+/// $H^H x = \beta e_1$, as LAPACK larfg, without the rescaling of tiny
+/// values. Called by all threads of the block.
+///
+/// @param[in] n
+///     Length of x. n >= 1.
+///
+/// @param[in] x
+///     Vector x in GPU memory, with stride incx.
+///
+/// @param[in] conj_x
+///     Whether to take conj( x ) instead, e.g., for a row of a matrix.
+///
+/// @param[out] v
+///     Vector of length n in shared memory. On exit, v[0] = tau and
+///     v[1:n-1] is the reflector, as in SLATE's gerfg.
+///
+/// @param[out] work
+///     Array of length blockDim.x in shared memory.
+///
+template <typename scalar_t>
+__device__ void larfg(
+    int64_t n, scalar_t const* x, int64_t incx, bool conj_x,
+    scalar_t* v, scalar_t* work )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    for (int64_t i = threadIdx.x; i < n; i += blockDim.x) {
+        scalar_t xi = x[ i*incx ];
+        v[ i ] = conj_x ? conj( xi ) : xi;
+    }
+    __syncthreads();
+
+    real_t sumsq = 0;
+    for (int64_t i = 1 + threadIdx.x; i < n; i += blockDim.x)
+        sumsq += real( v[ i ] ) * real( v[ i ] ) + imag( v[ i ] ) * imag( v[ i ] );
+    scalar_t sumsq_s;
+    copy( sumsq, sumsq_s );
+    real_t xnorm2 = real( block_sum( sumsq_s, work ) );
+
+    scalar_t alpha = v[ 0 ];
+    real_t alphr = real( alpha );
+    real_t alphi = imag( alpha );
+    scalar_t tau, scal;
+    if (xnorm2 == 0 && alphi == 0) {
+        // H = I
+        copy( real_t( 0 ), tau );
+        copy( real_t( 1 ), scal );
+    }
+    else {
+        real_t beta = -copysign(
+            sqrt( alphr*alphr + alphi*alphi + xnorm2 ), alphr );
+        scalar_t beta_s;
+        copy( beta, beta_s );
+        tau = (beta_s - alpha) / beta_s;
+        scal = real_t( 1 ) / (alpha - beta_s);
+    }
+    __syncthreads();  // everyone read v[ 0 ]
+
+    for (int64_t i = 1 + threadIdx.x; i < n; i += blockDim.x)
+        v[ i ] = v[ i ] * scal;
+    if (threadIdx.x == 0)
+        v[ 0 ] = tau;
+    __syncthreads();
+}
+
+//------------------------------------------------------------------------------
+/// @return tau of a reflector stored as by larfg, with tau in v[0],
+/// after setting v[0] = 1 for applying it.
+/// Called by all threads of the block.
+///
+/// @param[in,out] v
+///     Vector in shared memory.
+///
+template <typename scalar_t>
+__device__ scalar_t unpack_tau( scalar_t* v )
+{
+    __syncthreads();  // v is complete
+    scalar_t tau = v[ 0 ];
+    __syncthreads();  // everyone read tau
+    if (threadIdx.x == 0)
+        copy( blas::real_type<scalar_t>( 1 ), v[ 0 ] );
+    __syncthreads();
+    return tau;
+}
+
+//------------------------------------------------------------------------------
+/// Applies $H = I - \tau v v^H$ from the left, $M = H M$, to the m-by-nc
+/// block M = A( i0 : i0+m-1, j0 : j0+nc-1 ), as SLATE's gerf.
+/// Called by all threads of the block.
+///
+/// @param[in] v
+///     Vector of length m in shared memory, with v[0] = 1.
+///
+/// @param[out] w
+///     Workspace of length nc in shared memory.
+///
+template <typename scalar_t>
+__device__ void apply_left(
+    scalar_t tau, scalar_t const* v,
+    BandStorage<scalar_t> A, int64_t i0, int64_t j0, int64_t m, int64_t nc,
+    scalar_t* w )
+{
+    // w = M^H v
+    for (int64_t k = threadIdx.x; k < nc; k += blockDim.x) {
+        scalar_t sum;
+        copy( blas::real_type<scalar_t>( 0 ), sum );
+        for (int64_t r = 0; r < m; ++r)
+            sum += conj( A( i0 + r, j0 + k ) ) * v[ r ];
+        w[ k ] = sum;
+    }
+    __syncthreads();
+
+    // M -= tau v w^H
+    for (int64_t idx = threadIdx.x; idx < m*nc; idx += blockDim.x) {
+        int64_t r = idx % m;
+        int64_t k = idx / m;
+        A( i0 + r, j0 + k ) -= tau * v[ r ] * conj( w[ k ] );
+    }
+    __syncthreads();
+}
+
+//------------------------------------------------------------------------------
+/// Applies $H = I - \tau v v^H$ from the right, $M = M H$, to the m-by-nc
+/// block M = A( i0 : i0+m-1, j0 : j0+nc-1 ), as SLATE's gerf applied
+/// to $M^H$. Called by all threads of the block.
+///
+/// @param[in] v
+///     Vector of length nc in shared memory, with v[0] = 1.
+///
+/// @param[out] w
+///     Workspace of length m in shared memory.
+///
+template <typename scalar_t>
+__device__ void apply_right(
+    scalar_t tau, scalar_t const* v,
+    BandStorage<scalar_t> A, int64_t i0, int64_t j0, int64_t m, int64_t nc,
+    scalar_t* w )
+{
+    // w = M v
+    for (int64_t r = threadIdx.x; r < m; r += blockDim.x) {
+        scalar_t sum;
+        copy( blas::real_type<scalar_t>( 0 ), sum );
+        for (int64_t k = 0; k < nc; ++k)
+            sum += A( i0 + r, j0 + k ) * v[ k ];
+        w[ r ] = sum;
+    }
+    __syncthreads();
+
+    // M -= tau w v^H
+    for (int64_t idx = threadIdx.x; idx < m*nc; idx += blockDim.x) {
+        int64_t r = idx % m;
+        int64_t k = idx / m;
+        A( i0 + r, j0 + k ) -= tau * w[ r ] * conj( v[ k ] );
+    }
+    __syncthreads();
+}
+
+//------------------------------------------------------------------------------
+/// Waits until sweep `sweep` of a bulge chasing kernel has finished step
+/// `step`, as recorded in progress by another thread block.
+/// Called by all threads of the block.
+///
+__device__ inline void wait_progress( int const* progress, int64_t sweep,
+                                      int64_t step )
+{
+    if (threadIdx.x == 0) {
+        while (*((int const volatile*) &progress[ sweep ]) < step) {}
+    }
+    __syncthreads();
+    __threadfence();  // acquire the other block's updates
+}
+
+//------------------------------------------------------------------------------
+/// Records that sweep `sweep` has finished step `step`, after making this
+/// block's updates visible to other blocks.
+/// Called by all threads of the block.
+///
+__device__ inline void set_progress( int* progress, int64_t sweep,
+                                     int64_t step )
+{
+    __threadfence();  // release this block's updates
+    __syncthreads();
+    if (threadIdx.x == 0)
+        *((int volatile*) &progress[ sweep ]) = step;
+}
+
+} // namespace device
+} // namespace slate
+
+#endif // SLATE_DEVICE_HOUSEHOLDER_CUH
@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.cuh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel finding the first element of largest cabs1 = |real| + |imag|.
+/// Launched with one thread block; each thread strides through x,
+/// followed by a reduction. Uses dynamic shared memory arrays of
+/// length (sizeof(real_t) + sizeof(int64_t)) * blockDim.x.
+/// Launched by iamax().
+///
+/// @copydoc iamax
+///
+template <typename scalar_t>
+__global__ void iamax_kernel(
+    int64_t n, scalar_t const* x, int64_t incx,
+    int64_t* index, scalar_t* value)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    extern __shared__ char dynamic_data[];
+    real_t*  thread_max   = (real_t*) dynamic_data;
+    int64_t* thread_index = (int64_t*) &thread_max[ blockDim.x ];
+
+    // Each thread finds its first maximum; -1 < any cabs1 value.
+    real_t  max_value = -1;
+    int64_t max_index = 0;
+    for (int64_t i = threadIdx.x; i < n; i += blockDim.x) {
+        scalar_t xi = x[ i*incx ];
+        real_t absx = fabs( real( xi ) ) + fabs( imag( xi ) );
+        if (absx > max_value) {
+            max_value = absx;
+            max_index = i;
+        }
+    }
+    thread_max[ threadIdx.x ] = max_value;
+    thread_index[ threadIdx.x ] = max_index;
+    __syncthreads();
+
+    // Tree reduction; on ties, keep the smaller index.
+    for (int half = blockDim.x / 2; half > 0; half /= 2) {
+        if (threadIdx.x < half) {
+            int other = threadIdx.x + half;
+            if (thread_max[ other ] > thread_max[ threadIdx.x ]
+                || (thread_max[ other ] == thread_max[ threadIdx.x ]
+                    && thread_index[ other ] < thread_index[ threadIdx.x ])) {
+                thread_max[ threadIdx.x ] = thread_max[ other ];
+                thread_index[ threadIdx.x ] = thread_index[ other ];
+            }
+        }
+        __syncthreads();
+    }
+
+    if (threadIdx.x == 0) {
+        *index = thread_index[ 0 ];
+        *value = x[ thread_index[ 0 ]*incx ];
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Finds the first element of x with largest cabs1 = |real| + |imag|,
+/// as in BLAS iamax, without copying the result to the host.
+/// Used for the pivot search in the LU panel factorization.
+///
+/// @param[in] n
+///     Number of elements in x. n >= 1.
+///
+/// @param[in] x
+///     Array of dimension 1 + (n-1)*incx, in GPU memory.
+///
+/// @param[in] incx
+///     Stride between elements of x. incx >= 1.
+///
+/// @param[out] index
+///     On exit, 0-based index of the largest element, in GPU memory.
+///
+/// @param[out] value
+///     On exit, value of the largest element, in GPU memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void iamax(
+    int64_t n, scalar_t const* x, int64_t incx,
+    int64_t* index, scalar_t* value,
+    blas::Queue& queue)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (n == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Power of 2 threads, for the tree reduction.
+    int nthreads = 32;
+    while (nthreads < 512 && nthreads < n)
+        nthreads *= 2;
+
+    size_t shared_mem = (sizeof( real_t ) + sizeof( int64_t )) * nthreads;
+
+    iamax_kernel<<<1, nthreads, shared_mem, queue.stream()>>>(
+        n, x, incx, index, value );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void iamax(
+    int64_t n, float const* x, int64_t incx,
+    int64_t* index, float* value,
+    blas::Queue& queue);
+
+template
+void iamax(
+    int64_t n, double const* x, int64_t incx,
+    int64_t* index, double* value,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void iamax(
+    int64_t n, std::complex<float> const* x, int64_t incx,
+    int64_t* index, std::complex<float>* value,
+    blas::Queue& queue)
+{
+    iamax( n, (cuFloatComplex const*) x, incx,
+           index, (cuFloatComplex*) value, queue );
+}
+
+template <>
+void iamax(
+    int64_t n, std::complex<double> const* x, int64_t incx,
+    int64_t* index, std::complex<double>* value,
+    blas::Queue& queue)
+{
+    iamax( n, (cuDoubleComplex const*) x, incx,
+           index, (cuDoubleComplex*) value, queue );
+}
+
+} // namespace device
+} // namespace slate
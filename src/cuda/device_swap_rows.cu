@@ -0,0 +1,137 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.cuh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel applying groups of row swaps.
+/// Each thread block deals with one group. gridDim.x == group_count.
+/// Each thread deals with one column of the rows, applying the group's
+/// swaps in order, which keeps them sequential for rows swapped more
+/// than once.
+/// Launched by swap_rows_batch().
+///
+/// @copydoc swap_rows_batch
+///
+template <typename scalar_t>
+__global__ void swap_rows_batch_kernel(
+    int64_t const* offsets, int64_t const* lengths,
+    scalar_t** rows)
+{
+    int64_t begin = offsets[ blockIdx.x ];
+    int64_t end   = offsets[ blockIdx.x + 1 ];
+    int64_t n     = lengths[ blockIdx.x ];
+
+    // thread per column, if more columns than threads, loop by blockDim.x
+    for (int64_t j = threadIdx.x; j < n; j += blockDim.x) {
+        for (int64_t s = begin; s < end; ++s) {
+            scalar_t* row1 = rows[ 2*s ];
+            scalar_t* row2 = rows[ 2*s + 1 ];
+            scalar_t tmp = row1[ j ];
+            row1[ j ] = row2[ j ];
+            row2[ j ] = tmp;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Batched routine for row swaps, used to apply a pivot vector to all
+/// local tile columns on a device in one launch. Swaps are in groups,
+/// e.g., one group per tile column; within group g, swaps
+/// offsets[ g ], ..., offsets[ g+1 ] - 1 are applied in order to rows of
+/// length lengths[ g ], stored contiguously (row-major tiles).
+///
+/// @param[in] group_count
+///     Number of groups.
+///
+/// @param[in] offsets
+///     Array in GPU memory of dimension group_count + 1.
+///     Group g has swaps offsets[ g ] to offsets[ g+1 ] - 1.
+///
+/// @param[in] lengths
+///     Array in GPU memory of dimension group_count.
+///     Length of the rows in group g.
+///
+/// @param[in,out] rows
+///     Array in GPU memory of dimension 2*offsets[ group_count ],
+///     containing pointers to rows in GPU memory.
+///     Swap s exchanges rows[ 2*s ] and rows[ 2*s + 1 ].
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    scalar_t** rows,
+    blas::Queue& queue)
+{
+    // quick return
+    if (group_count == 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Rows are typically a tile wide.
+    int64_t nthreads = 256;
+
+    swap_rows_batch_kernel<<<group_count, nthreads, 0, queue.stream()>>>(
+        offsets, lengths, rows );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    float** rows,
+    blas::Queue& queue);
+
+template
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    double** rows,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    std::complex<float>** rows,
+    blas::Queue& queue)
+{
+    swap_rows_batch( group_count, offsets, lengths,
+                     (cuFloatComplex**) rows, queue );
+}
+
+template <>
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    std::complex<double>** rows,
+    blas::Queue& queue)
+{
+    swap_rows_batch( group_count, offsets, lengths,
+                     (cuDoubleComplex**) rows, queue );
+}
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,283 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_householder.cuh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel for bidiagonal bulge chasing. Each thread block does whole
+/// sweeps, sweep = blockIdx.x, blockIdx.x + gridDim.x, ..., one step at a
+/// time, the threads cooperating on the Householder updates of each step.
+/// Before each step, a block waits until the previous sweep, done by the
+/// previous block, is two steps ahead, as in the host tb2bd; hence all
+/// blocks must be resident at once.
+/// Launched by tb2bd().
+///
+/// @copydoc tb2bd
+///
+template <typename scalar_t>
+__global__ void tb2bd_kernel(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    int* progress)
+{
+    extern __shared__ char dynamic_data[];
+    scalar_t* v    = (scalar_t*) dynamic_data;  // band + 1
+    scalar_t* w    = v + band + 1;              // band + 1
+    scalar_t* work = w + band + 1;              // blockDim.x
+
+    BandStorage<scalar_t> A = { AB, ldab, 2*band - 1 };
+    // Rows of A are stored with stride ldab - 1.
+    int64_t inc_row = ldab - 1;
+
+    int64_t diag_len = min( m, n );
+    for (int64_t sweep = blockIdx.x; sweep < diag_len-1; sweep += gridDim.x) {
+        int64_t nsteps = 2*ceildiv( diag_len - 1 - sweep, band ) - 1;
+        int64_t nsteps_prev = 2*ceildiv( diag_len - sweep, band ) - 1;
+
+        // Householder vectors of step t are in column vindex*band + vj
+        // + t*band of U and V, starting in row vi, as in the host tb2bd_step.
+        int64_t vj = sweep % band;
+        int64_t vi = vj + 1;
+        int64_t k  = sweep / band;
+        int64_t vindex = k*nt - k*(k - 1)/2;
+        scalar_t* Usweep = &U[ vi + (vindex*band + vj)*ldu ];
+        scalar_t* Vsweep = &V[ vi + (vindex*band + vj)*ldv ];
+
+        for (int64_t step = 0; step < nsteps; ++step) {
+            if (sweep > 0) {
+                // Wait until sweep-1 is two tasks ahead,
+                // or sweep-1 is finished.
+                wait_progress( progress, sweep-1,
+                               min( step+2, nsteps_prev-1 ) );
+            }
+
+            int64_t block = (step + 1)/2;
+            scalar_t tau;
+            if (step == 0) {
+                // Brings row i, then col i, to bidiagonal.
+                int64_t i = sweep;
+                int64_t j = sweep + 1;
+                if (i < m && j < n) {
+                    int64_t mb = min( i+band,   m-1 ) - i + 1;
+                    int64_t nb = min( j+band-1, n-1 ) - j + 1;
+                    scalar_t* V1 = Vsweep;
+                    scalar_t* U1 = Usweep;
+
+                    // Zero A[ i, j+1 : j+nb-1 ].
+                    larfg( nb, &A( i, j ), inc_row, true, v, work );
+                    for (int64_t r = threadIdx.x; r < nb; r += blockDim.x)
+                        V1[ r ] = v[ r ];
+                    tau = unpack_tau( v );
+                    apply_right( tau, v, A, i, j, mb, nb, w );
+
+                    // Zero A[ i+2 : i+mb-1, j ].
+                    larfg( mb-1, &A( i+1, j ), 1, false, v, work );
+                    for (int64_t r = threadIdx.x; r < mb-1; r += blockDim.x)
+                        U1[ r ] = v[ r ];
+                    tau = unpack_tau( v );
+                    apply_left( conj( tau ), v, A, i+1, j, mb-1, nb, w );
+                }
+            }
+            else if (step % 2 == 1) {
+                // Applies the left update from the previous step to an
+                // off-diagonal block, creating a bulge, then brings row i
+                // back to the original bandwidth.
+                int64_t i = (block-1)*band + 1 + sweep;
+                int64_t j =  block   *band + 1 + sweep;
+                if (i < m && j < n) {
+                    int64_t mb = min( i+band-1, m-1 ) - i + 1;
+                    int64_t nb = min( j+band-1, n-1 ) - j + 1;
+                    scalar_t* U1 = &Usweep[ ((step-1)/2)*band*ldu ];
+                    scalar_t* V1 = &Vsweep[ ((step+1)/2)*band*ldv ];
+
+                    for (int64_t r = threadIdx.x; r < mb; r += blockDim.x)
+                        v[ r ] = U1[ r ];
+                    tau = unpack_tau( v );
+                    apply_left( conj( tau ), v, A, i, j, mb, nb, w );
+
+                    larfg( nb, &A( i, j ), inc_row, true, v, work );
+                    for (int64_t r = threadIdx.x; r < nb; r += blockDim.x)
+                        V1[ r ] = v[ r ];
+                    tau = unpack_tau( v );
+                    apply_right( tau, v, A, i, j, mb, nb, w );
+                }
+            }
+            else {
+                // Applies the right update from the previous step to a
+                // diagonal block, creating a bulge, then brings col j
+                // back to the original bandwidth.
+                int64_t i = block*band + 1 + sweep;
+                int64_t j = i;
+                if (i < m && j < n) {
+                    int64_t mb = min( i+band-1, m-1 ) - i + 1;
+                    int64_t nb = min( j+band-1, n-1 ) - j + 1;
+                    scalar_t* V1 = &Vsweep[ (step/2)*band*ldv ];
+                    scalar_t* U1 = &Usweep[ (step/2)*band*ldu ];
+
+                    for (int64_t r = threadIdx.x; r < nb; r += blockDim.x)
+                        v[ r ] = V1[ r ];
+                    tau = unpack_tau( v );
+                    apply_right( tau, v, A, i, j, mb, nb, w );
+
+                    larfg( mb, &A( i, j ), 1, false, v, work );
+                    for (int64_t r = threadIdx.x; r < mb; r += blockDim.x)
+                        U1[ r ] = v[ r ];
+                    tau = unpack_tau( v );
+                    apply_left( conj( tau ), v, A, i, j, mb, nb, w );
+                }
+            }
+
+            // Mark step as done.
+            set_progress( progress, sweep, step );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Reduces an upper triangular band matrix to bidiagonal form by bulge
+/// chasing, computing the same Householder vectors as the host tb2bd.
+/// Sweeps run concurrently, one per thread block, pipelined as in the host
+/// version, so the whole second stage of svd is one launch.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] band
+///     Upper bandwidth of A. band >= 1.
+///
+/// @param[in] nt
+///     Number of block columns of A, ceil( n / band ); determines
+///     where vectors are stored in U and V.
+///
+/// @param[in,out] AB
+///     The band of A, in GPU memory: A(i, j), for -band < j - i < 2*band,
+///     is AB[ 2*band - 1 + i - j + j*ldab ]. On entry, the diagonals
+///     outside the band are zero, for the bulges. On exit, the real
+///     diagonal and superdiagonal of the bidiagonal matrix are in rows
+///     2*band-1 and 2*band-2.
+///
+/// @param[in] ldab
+///     Leading dimension of AB. ldab >= 3*band - 1.
+///
+/// @param[out] U
+///     The Householder vectors applied from the left, in GPU memory, in the
+///     layout of the 2*band-by-(nt*(nt + 1)/2*band) matrix U of tb2bd with
+///     tile size band, stored column-wise.
+///
+/// @param[in] ldu
+///     Leading dimension of U. ldu >= 2*band.
+///
+/// @param[out] V
+///     The Householder vectors applied from the right, as for U.
+///
+/// @param[in] ldv
+///     Leading dimension of V. ldv >= 2*band.
+///
+/// @param[out] progress
+///     Workspace of length min( m, n ) in GPU memory, on entry set to -1
+///     in every entry.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+    if (std::min( m, n ) <= 1)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    // Progress between blocks requires they are all resident,
+    // so launch one block per multiprocessor, at most.
+    int sm_count;
+    cudaDeviceGetAttribute( &sm_count, cudaDevAttrMultiProcessorCount,
+                            queue.device() );
+    int64_t nblocks = std::min( std::min( m, n ) - 1, int64_t( sm_count ) );
+    int64_t nthreads = 128;  // power of 2 for block_sum
+    size_t shared_bytes = sizeof(scalar_t) * (2*(band + 1) + nthreads);
+
+    tb2bd_kernel<<<nblocks, nthreads, shared_bytes, queue.stream()>>>(
+        m, n, band, nt, AB, ldab, U, ldu, V, ldv, progress );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    float* AB, int64_t ldab,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    double* AB, int64_t ldab,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+    tb2bd( m, n, band, nt,
+           (cuFloatComplex*) AB, ldab,
+           (cuFloatComplex*) U, ldu,
+           (cuFloatComplex*) V, ldv,
+           progress, queue );
+}
+
+template <>
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+    tb2bd( m, n, band, nt,
+           (cuDoubleComplex*) AB, ldab,
+           (cuDoubleComplex*) U, ldu,
+           (cuDoubleComplex*) V, ldv,
+           progress, queue );
+}
+
+} // namespace device
+} // namespace slate
@@ -695,5 +695,251 @@ void transpose_batch(
         batch_count, queue );
 }
 
+//------------------------------------------------------------------------------
+/// Device routine does in-place transpose of one contiguous, rectangular
+/// m-by-n matrix into an n-by-m matrix, by following the cycles of the
+/// permutation. Element k = i + j*m moves to j + i*n = k*n mod (m*n - 1),
+/// and element p is replaced by element p*m mod (m*n - 1).
+/// Each thread takes start indices k, and rotates the cycle containing k
+/// only if k is its smallest index (cycle leader); other threads exit the
+/// leader test as soon as they find a smaller index. Elements 0 and
+/// m*n - 1 are fixed.
+///
+template <typename scalar_t>
+__device__ void transpose_cycles_func(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A)
+{
+    int64_t size = m*n;
+    if (m == 1 || n == 1) {
+        // Vectors are already transposed; only conjugate.
+        if (is_conj) {
+            for (int64_t k = threadIdx.x; k < size; k += blockDim.x)
+                A[ k ] = conj( A[ k ] );
+        }
+        return;
+    }
+
+    int64_t mod = size - 1;
+    for (int64_t k = threadIdx.x; k < size; k += blockDim.x) {
+        if (k == mod) {
+            if (is_conj)
+                A[ k ] = conj( A[ k ] );
+            continue;
+        }
+
+        // Leader test: walk forward until back at k or below k.
+        int64_t p = (k * n) % mod;
+        while (p > k)
+            p = (p * n) % mod;
+        if (p < k)
+            continue;
+
+        // Rotate the cycle, pulling each element from its source.
+        scalar_t tmp = A[ k ];
+        p = k;
+        int64_t q = (p * m) % mod;
+        while (q != k) {
+            A[ p ] = is_conj ? conj( A[ q ] ) : A[ q ];
+            p = q;
+            q = (p * m) % mod;
+        }
+        A[ p ] = is_conj ? conj( tmp ) : tmp;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// in-place transpose of a contiguous rectangular buffer
+template <typename scalar_t>
+__global__ void transpose_cycles_kernel(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A)
+{
+    transpose_cycles_func( is_conj, m, n, A );
+}
+
+//------------------------------------------------------------------------------
+/// in-place transpose of an array of contiguous rectangular buffers
+template <typename scalar_t>
+__global__ void transpose_cycles_batch_kernel(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray)
+{
+    transpose_cycles_func( is_conj, m, n, Aarray[ blockIdx.x ] );
+}
+
+/// Threads per thread block for transpose_cycles_func.
+static const int cycles_threads = 256;
+
+//------------------------------------------------------------------------------
+/// Physically transpose a rectangular matrix in place.
+/// Unlike the out-of-place transpose, this requires no workspace; it is
+/// used to convert the layout of contiguous rectangular tiles when no
+/// workspace block is free. It is slower than copying to a workspace and
+/// transposing out of place, since each cycle is rotated by one thread.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in,out] A
+///     A rectangular m-by-n matrix stored contiguously in an m-by-n array
+///     in GPU memory.
+///     On output, A is the n-by-m transpose, stored in an n-by-m array.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A,
+    blas::Queue& queue)
+{
+    if ((m <= 0) || (n <= 0))
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    transpose_cycles_kernel<<< 1, cycles_threads, 0, queue.stream() >>>
+        ( is_conj, m, n, A );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a batch of rectangular matrices in place.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to
+///     matrices, where each Aarray[k] is a rectangular m-by-n matrix stored
+///     contiguously in an m-by-n array in GPU memory.
+///     On output, each Aarray[k] is its n-by-m transpose.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+    if (batch_count <= 0 || m <= 0 || n <= 0)
+        return;
+
+    cudaSetDevice( queue.device() );
+
+    assert(batch_count <= 2147483647);  // CUDA limitation, 2^31 - 1
+
+    transpose_cycles_batch_kernel<<< batch_count, cycles_threads, 0,
+                                     queue.stream() >>>
+        ( is_conj, m, n, Aarray );
+
+    cudaError_t error = cudaGetLastError();
+    slate_assert(error == cudaSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+//----- rectangular, in-place
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double* A,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => cuComplex.
+template <>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>* A,
+    blas::Queue& queue)
+{
+    transpose( is_conj, m, n, (cuFloatComplex*) A, queue );
+}
+
+template <>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>* A,
+    blas::Queue& queue)
+{
+    transpose( is_conj, m, n, (cuDoubleComplex*) A, queue );
+}
+
+template <>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+    transpose_batch(
+        is_conj, m, n,
+        (cuFloatComplex**) Aarray,
+        batch_count, queue );
+}
+
+template <>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+    transpose_batch(
+        is_conj, m, n,
+        (cuDoubleComplex**) Aarray,
+        batch_count, queue );
+}
+
 } // namespace device
 } // namespace slate
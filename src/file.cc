@@ -0,0 +1,838 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/file.hh"
+#include "slate/internal/mpi.hh"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace slate {
+
+namespace impl {
+
+#ifndef SLATE_NO_MPI
+
+//------------------------------------------------------------------------------
+/// Pieces of local tiles that are contiguous both in the file and in memory,
+/// in file order, with the first piece of each chunk of block columns.
+///
+struct FilePieces {
+    std::vector<int>      counts;        ///< elements in each piece
+    std::vector<MPI_Aint> offsets;       ///< byte offsets in the file
+    std::vector<MPI_Aint> addresses;     ///< absolute addresses in memory
+    std::vector<int64_t>  chunk_begin;   ///< first piece of each chunk,
+                                         ///< with an end marker
+};
+
+//------------------------------------------------------------------------------
+/// Lists the pieces of A's local host tiles in the file, in chunks of
+/// chunk_size block columns. Column major files have one piece per tile
+/// column; tiled files, one per tile column, merged if the tile is
+/// contiguous in memory.
+///
+template <typename scalar_t>
+FilePieces file_pieces(
+    Matrix<scalar_t>& A, FileLayout layout, int64_t chunk_size)
+{
+    int64_t m  = A.m();
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+
+    // first row of each block row
+    std::vector<int64_t> row( mt + 1, 0 );
+    for (int64_t i = 0; i < mt; ++i)
+        row[ i+1 ] = row[ i ] + A.tileMb( i );
+
+    FilePieces pieces;
+    int64_t col = 0;  // first column of block column j
+    int64_t jb;
+    // appends column c of local tile (i, j)
+    auto add_piece = [&]( int64_t i, int64_t j, int64_t c ) {
+        auto T = A( i, j );
+        int64_t ib = T.mb();
+        MPI_Aint offset;
+        if (layout == FileLayout::ColMajor)
+            offset = ((col + c)*m + row[ i ]) * sizeof(scalar_t);
+        else
+            offset = (col*m + row[ i ]*jb + c*ib) * sizeof(scalar_t);
+        MPI_Aint address;
+        MPI_Get_address( T.data() + c*T.stride(), &address );
+
+        // merge with the previous piece of the chunk if both are contiguous
+        int64_t last = int64_t( pieces.counts.size() ) - 1;
+        MPI_Aint bytes = 0;
+        if (last >= pieces.chunk_begin.back())
+            bytes = pieces.counts[ last ] * MPI_Aint( sizeof(scalar_t) );
+        if (bytes > 0
+            && pieces.offsets[ last ] + bytes == offset
+            && pieces.addresses[ last ] + bytes == address
+            && pieces.counts[ last ] + ib <= std::numeric_limits<int>::max())
+        {
+            pieces.counts[ last ] += ib;
+        }
+        else {
+            pieces.counts.push_back( ib );
+            pieces.offsets.push_back( offset );
+            pieces.addresses.push_back( address );
+        }
+    };
+
+    // file views need pieces in increasing file offsets
+    for (int64_t j = 0; j < nt; ++j) {
+        if (j % chunk_size == 0)
+            pieces.chunk_begin.push_back( pieces.counts.size() );
+
+        jb = A.tileNb( j );
+        if (layout == FileLayout::ColMajor) {
+            for (int64_t c = 0; c < jb; ++c)
+                for (int64_t i = 0; i < mt; ++i)
+                    if (A.tileIsLocal( i, j ))
+                        add_piece( i, j, c );
+        }
+        else {
+            for (int64_t i = 0; i < mt; ++i)
+                if (A.tileIsLocal( i, j ))
+                    for (int64_t c = 0; c < jb; ++c)
+                        add_piece( i, j, c );
+        }
+        col += jb;
+    }
+    pieces.chunk_begin.push_back( pieces.counts.size() );
+    return pieces;
+}
+
+//------------------------------------------------------------------------------
+/// Sets the view of file to the local pieces, starting disp bytes into the
+/// file, so consecutive collective reads or writes of the chunks' memory
+/// types access the chunks in order.
+///
+template <typename scalar_t>
+void set_file_view(
+    MPI_File file, MPI_Offset disp, FilePieces& pieces)
+{
+    MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
+    MPI_Datatype filetype = mpi_scalar;
+    if (! pieces.counts.empty()) {
+        slate_mpi_call(
+            MPI_Type_create_hindexed(
+                pieces.counts.size(), pieces.counts.data(),
+                pieces.offsets.data(), mpi_scalar, &filetype ) );
+        slate_mpi_call(
+            MPI_Type_commit( &filetype ) );
+    }
+    char native[] = "native";
+    slate_mpi_call(
+        MPI_File_set_view( file, disp, mpi_scalar, filetype, native,
+                           MPI_INFO_NULL ) );
+    if (! pieces.counts.empty())
+        MPI_Type_free( &filetype );
+}
+
+//------------------------------------------------------------------------------
+/// @return memory type of the pieces of chunk k, relative to MPI_BOTTOM;
+/// with count set to 0 if the chunk has no local pieces.
+///
+template <typename scalar_t>
+MPI_Datatype chunk_type(
+    FilePieces& pieces, int64_t k, int* count)
+{
+    MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
+    int64_t begin = pieces.chunk_begin[ k ];
+    int64_t end   = pieces.chunk_begin[ k+1 ];
+    if (begin == end) {
+        *count = 0;
+        return mpi_scalar;
+    }
+    MPI_Datatype memtype;
+    slate_mpi_call(
+        MPI_Type_create_hindexed(
+            end - begin, &pieces.counts[ begin ],
+            &pieces.addresses[ begin ], mpi_scalar, &memtype ) );
+    slate_mpi_call(
+        MPI_Type_commit( &memtype ) );
+    *count = 1;
+    return memtype;
+}
+
+//------------------------------------------------------------------------------
+/// Reads A's local tiles from the file, which holds A in the given layout
+/// starting disp bytes into the file, in chunks of chunk_size block columns.
+/// With to_devices, the read of each chunk overlaps copying the previous
+/// chunk to the devices.
+///
+template <typename scalar_t>
+void read_pieces(
+    MPI_File file, MPI_Offset disp, Matrix<scalar_t>& A,
+    FileLayout layout, int64_t chunk_size, bool to_devices)
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // host tiles to read into, column major
+    A.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+
+    auto pieces = file_pieces( A, layout, chunk_size );
+    int64_t num_chunks = pieces.chunk_begin.size() - 1;
+    set_file_view<scalar_t>( file, disp, pieces );
+
+    // read chunk k+1 while chunk k goes to the devices
+    int count;
+    MPI_Request request;
+    MPI_Datatype memtype;
+    if (num_chunks > 0) {
+        memtype = chunk_type<scalar_t>( pieces, 0, &count );
+        slate_mpi_call(
+            MPI_File_iread_all( file, MPI_BOTTOM, count, memtype, &request ) );
+    }
+    for (int64_t k = 0; k < num_chunks; ++k) {
+        slate_mpi_call(
+            MPI_Wait( &request, MPI_STATUS_IGNORE ) );
+        if (count > 0)
+            MPI_Type_free( &memtype );
+
+        if (k+1 < num_chunks) {
+            memtype = chunk_type<scalar_t>( pieces, k+1, &count );
+            slate_mpi_call(
+                MPI_File_iread_all( file, MPI_BOTTOM, count, memtype,
+                                    &request ) );
+        }
+
+        if (to_devices) {
+            int64_t j_end = std::min( (k+1)*chunk_size, A.nt() );
+            std::vector< TileSet > tiles_set( A.num_devices() );
+            for (int64_t j = k*chunk_size; j < j_end; ++j) {
+                for (int64_t i = 0; i < A.mt(); ++i) {
+                    if (A.tileIsLocal( i, j ))
+                        tiles_set[ A.tileDevice( i, j ) ].insert( { i, j } );
+                }
+            }
+            for (int device = 0; device < A.num_devices(); ++device) {
+                if (! tiles_set[ device ].empty()) {
+                    A.tileGetForReading( tiles_set[ device ], device,
+                                         LayoutConvert::ColMajor );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Writes A's local tiles to the file, in the given layout starting disp
+/// bytes into the file, in chunks of chunk_size block columns.
+///
+template <typename scalar_t>
+void write_pieces(
+    MPI_File file, MPI_Offset disp, Matrix<scalar_t>& A,
+    FileLayout layout, int64_t chunk_size)
+{
+    A.tileGetAllForReading( HostNum, LayoutConvert::ColMajor );
+
+    auto pieces = file_pieces( A, layout, chunk_size );
+    int64_t num_chunks = pieces.chunk_begin.size() - 1;
+    set_file_view<scalar_t>( file, disp, pieces );
+
+    for (int64_t k = 0; k < num_chunks; ++k) {
+        int count;
+        MPI_Datatype memtype = chunk_type<scalar_t>( pieces, k, &count );
+        slate_mpi_call(
+            MPI_File_write_all( file, MPI_BOTTOM, count, memtype,
+                                MPI_STATUS_IGNORE ) );
+        if (count > 0)
+            MPI_Type_free( &memtype );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Checkpoint header, in 64-bit integers in native byte order:
+// magic "SLATECKP", version, scalar type ('s', 'd', 'c', or 'z'), codec,
+// m, n, mt, nt, then tileMb( 0 : mt-1 ), tileNb( 0 : nt-1 ), and
+// tileRank and tileDevice of each tile, with tiles in column major order.
+// Codec 0 is uncompressed tiles; other values are reserved.
+
+const char checkpoint_magic[] = "SLATECKP";
+const int64_t checkpoint_version = 1;
+const int64_t checkpoint_fixed = 8;  ///< words before the maps
+
+/// @return code of scalar_t in checkpoint headers.
+template <typename scalar_t>
+int64_t checkpoint_type()
+{
+    if (blas::is_complex<scalar_t>::value)
+        return sizeof(scalar_t) == 8 ? 'c' : 'z';
+    else
+        return sizeof(scalar_t) == 4 ? 's' : 'd';
+}
+
+//------------------------------------------------------------------------------
+/// Dimensions and tile maps of a checkpointed matrix.
+///
+struct CheckpointHeader {
+    int64_t m, n, mt, nt;
+    std::vector<int64_t> tileMb, tileNb;
+    std::vector<int64_t> tileRank, tileDevice;  ///< tiles in column major
+
+    /// @return size of the header in the file, in bytes.
+    MPI_Offset size() const
+    {
+        return (checkpoint_fixed + mt + nt + 2*mt*nt) * sizeof(int64_t);
+    }
+};
+
+//------------------------------------------------------------------------------
+/// @return A's header.
+///
+template <typename scalar_t>
+CheckpointHeader checkpoint_header(Matrix<scalar_t>& A)
+{
+    CheckpointHeader header;
+    header.m  = A.m();
+    header.n  = A.n();
+    header.mt = A.mt();
+    header.nt = A.nt();
+    for (int64_t i = 0; i < A.mt(); ++i)
+        header.tileMb.push_back( A.tileMb( i ) );
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        header.tileNb.push_back( A.tileNb( j ) );
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            header.tileRank.push_back( A.tileRank( i, j ) );
+            header.tileDevice.push_back( A.tileDevice( i, j ) );
+        }
+    }
+    return header;
+}
+
+//------------------------------------------------------------------------------
+/// Writes the header at the start of the file. Called by one rank.
+///
+template <typename scalar_t>
+void write_checkpoint_header(MPI_File file, CheckpointHeader const& header)
+{
+    std::vector<int64_t> words( checkpoint_fixed );
+    std::memcpy( &words[ 0 ], checkpoint_magic, sizeof(int64_t) );
+    words[ 1 ] = checkpoint_version;
+    words[ 2 ] = checkpoint_type<scalar_t>();
+    words[ 3 ] = 0;  // codec
+    words[ 4 ] = header.m;
+    words[ 5 ] = header.n;
+    words[ 6 ] = header.mt;
+    words[ 7 ] = header.nt;
+    for (auto* map : { &header.tileMb, &header.tileNb,
+                       &header.tileRank, &header.tileDevice })
+        words.insert( words.end(), map->begin(), map->end() );
+
+    slate_assert( words.size() <= size_t( std::numeric_limits<int>::max() ) );
+    slate_mpi_call(
+        MPI_File_write_at( file, 0, words.data(), words.size(), MPI_INT64_T,
+                           MPI_STATUS_IGNORE ) );
+}
+
+//------------------------------------------------------------------------------
+/// Reads and checks the header at the start of the file. Collective.
+///
+template <typename scalar_t>
+CheckpointHeader read_checkpoint_header(MPI_File file)
+{
+    std::vector<int64_t> words( checkpoint_fixed );
+    slate_mpi_call(
+        MPI_File_read_at_all( file, 0, words.data(), words.size(),
+                              MPI_INT64_T, MPI_STATUS_IGNORE ) );
+    if (std::memcmp( &words[ 0 ], checkpoint_magic, sizeof(int64_t) ) != 0)
+        slate_error( "read_checkpoint: not a SLATE checkpoint" );
+    if (words[ 1 ] != checkpoint_version)
+        slate_error( "read_checkpoint: unsupported checkpoint version" );
+    if (words[ 2 ] != checkpoint_type<scalar_t>())
+        slate_error( "read_checkpoint: checkpoint has a different scalar type" );
+    if (words[ 3 ] != 0)
+        slate_error( "read_checkpoint: unsupported checkpoint codec" );
+
+    CheckpointHeader header;
+    header.m  = words[ 4 ];
+    header.n  = words[ 5 ];
+    header.mt = words[ 6 ];
+    header.nt = words[ 7 ];
+    int64_t mt = header.mt;
+    int64_t nt = header.nt;
+    int64_t count = mt + nt + 2*mt*nt;
+    slate_assert( count <= std::numeric_limits<int>::max() );
+    words.resize( count );
+    slate_mpi_call(
+        MPI_File_read_at_all( file, checkpoint_fixed * sizeof(int64_t),
+                              words.data(), count, MPI_INT64_T,
+                              MPI_STATUS_IGNORE ) );
+    auto w = words.begin();
+    header.tileMb    .assign( w, w + mt );     w += mt;
+    header.tileNb    .assign( w, w + nt );     w += nt;
+    header.tileRank  .assign( w, w + mt*nt );  w += mt*nt;
+    header.tileDevice.assign( w, w + mt*nt );
+    return header;
+}
+
+#endif // SLATE_NO_MPI
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Reads matrix A from a binary file with collective MPI-IO, directly into
+/// each rank's local tiles, without a full copy of the local part.
+/// The file holds the m-by-n matrix in native byte order, without a header,
+/// in the given layout. A's tiles must already be inserted,
+/// e.g., with insertLocalTiles.
+///
+/// The matrix is read in chunks of block columns; the read of each chunk
+/// overlaps copying the previous chunk to the devices, with
+/// Target::Devices, so tiles are loaded to the devices as they arrive.
+///
+/// @param[in] filename
+///     Name of the file.
+///
+/// @param[in,out] A
+///     On exit, the matrix read.
+///
+/// @param[in] layout
+///     Layout of the file: FileLayout::ColMajor or FileLayout::Tiled.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::ChunkSize:
+///       Number of block columns per collective read. Default q, the
+///       number of process columns.
+///     - Option::Target:
+///       With Devices, also copies the tiles to the devices.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void read_file(
+    const char* filename,
+    Matrix<scalar_t>& A,
+    FileLayout layout,
+    Options const& opts)
+{
+#ifdef SLATE_NO_MPI
+    slate_not_implemented( "read_file requires MPI-IO" );
+#else
+    slate_assert( A.op() == Op::NoTrans );
+
+    GridOrder grid_order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+    int64_t chunk_size = get_option<int64_t>( opts, Option::ChunkSize, q );
+    chunk_size = std::max( chunk_size, int64_t( 1 ) );
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    bool to_devices = target == Target::Devices && A.num_devices() > 0;
+
+    MPI_File file;
+    slate_mpi_call(
+        MPI_File_open( A.mpiComm(), filename, MPI_MODE_RDONLY,
+                       MPI_INFO_NULL, &file ) );
+    impl::read_pieces( file, 0, A, layout, chunk_size, to_devices );
+    slate_mpi_call(
+        MPI_File_close( &file ) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Writes matrix A to a binary file with collective MPI-IO, directly from
+/// each rank's local tiles, in chunks of block columns. The file format is
+/// as for read_file. Tiles on devices are first copied to the host.
+///
+/// @param[in] A
+///     The matrix to write.
+///
+/// @param[in] filename
+///     Name of the file, which is created or overwritten.
+///
+/// @param[in] layout
+///     Layout of the file: FileLayout::ColMajor or FileLayout::Tiled.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::ChunkSize:
+///       Number of block columns per collective write. Default q, the
+///       number of process columns.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void write_file(
+    Matrix<scalar_t>& A,
+    const char* filename,
+    FileLayout layout,
+    Options const& opts)
+{
+#ifdef SLATE_NO_MPI
+    slate_not_implemented( "write_file requires MPI-IO" );
+#else
+    slate_assert( A.op() == Op::NoTrans );
+
+    GridOrder grid_order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+    int64_t chunk_size = get_option<int64_t>( opts, Option::ChunkSize, q );
+    chunk_size = std::max( chunk_size, int64_t( 1 ) );
+
+    MPI_File file;
+    slate_mpi_call(
+        MPI_File_open( A.mpiComm(), filename,
+                       MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                       MPI_INFO_NULL, &file ) );
+    MPI_Offset size = MPI_Offset( A.m() ) * A.n() * sizeof(scalar_t);
+    slate_mpi_call(
+        MPI_File_set_size( file, size ) );
+    impl::write_pieces( file, 0, A, layout, chunk_size );
+    slate_mpi_call(
+        MPI_File_close( &file ) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Writes a checkpoint of matrix A, with collective MPI-IO, directly from
+/// each rank's local tiles. The file has a header with A's dimensions and
+/// its tileMb, tileNb, tileRank, and tileDevice maps, followed by the tiles,
+/// each column major, in column major order of tiles, as
+/// FileLayout::Tiled. Each rank writes its own tiles, in parallel, so
+/// read_checkpoint can restore them without redistribution.
+/// Tiles on devices are first copied to the host.
+///
+/// Tiles are stored uncompressed; the header has a codec field, reserved
+/// for compressed tiles.
+///
+/// @param[in] A
+///     The matrix to checkpoint.
+///
+/// @param[in] filename
+///     Name of the file, which is created or overwritten.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::ChunkSize:
+///       Number of block columns per collective write. Default q, the
+///       number of process columns.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void write_checkpoint(
+    Matrix<scalar_t>& A,
+    const char* filename,
+    Options const& opts)
+{
+#ifdef SLATE_NO_MPI
+    slate_not_implemented( "write_checkpoint requires MPI-IO" );
+#else
+    slate_assert( A.op() == Op::NoTrans );
+
+    GridOrder grid_order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+    int64_t chunk_size = get_option<int64_t>( opts, Option::ChunkSize, q );
+    chunk_size = std::max( chunk_size, int64_t( 1 ) );
+
+    auto header = impl::checkpoint_header( A );
+
+    MPI_File file;
+    slate_mpi_call(
+        MPI_File_open( A.mpiComm(), filename,
+                       MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                       MPI_INFO_NULL, &file ) );
+    MPI_Offset size = header.size()
+                    + MPI_Offset( A.m() ) * A.n() * sizeof(scalar_t);
+    slate_mpi_call(
+        MPI_File_set_size( file, size ) );
+    if (A.mpiRank() == 0)
+        impl::write_checkpoint_header<scalar_t>( file, header );
+    impl::write_pieces( file, header.size(), A, FileLayout::Tiled,
+                        chunk_size );
+    slate_mpi_call(
+        MPI_File_close( &file ) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Restores matrix A from a checkpoint written by write_checkpoint.
+/// A must have the checkpoint's dimensions, tile sizes, and tileRank map,
+/// and its tiles must already be inserted; each rank reads only its local
+/// tiles. A's tileDevice map may differ from the checkpoint's.
+///
+/// @param[in] filename
+///     Name of the file.
+///
+/// @param[in,out] A
+///     On exit, the matrix restored.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::ChunkSize:
+///       Number of block columns per collective read. Default q, the
+///       number of process columns.
+///     - Option::Target:
+///       With Devices, also copies the tiles to the devices.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+void read_checkpoint(
+    const char* filename,
+    Matrix<scalar_t>& A,
+    Options const& opts)
+{
+#ifdef SLATE_NO_MPI
+    slate_not_implemented( "read_checkpoint requires MPI-IO" );
+#else
+    slate_assert( A.op() == Op::NoTrans );
+
+    GridOrder grid_order;
+    int p, q, myrow, mycol;
+    A.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+    int64_t chunk_size = get_option<int64_t>( opts, Option::ChunkSize, q );
+    chunk_size = std::max( chunk_size, int64_t( 1 ) );
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    bool to_devices = target == Target::Devices && A.num_devices() > 0;
+
+    MPI_File file;
+    slate_mpi_call(
+        MPI_File_open( A.mpiComm(), filename, MPI_MODE_RDONLY,
+                       MPI_INFO_NULL, &file ) );
+    auto header = impl::read_checkpoint_header<scalar_t>( file );
+
+    auto expect = impl::checkpoint_header( A );
+    if (header.m != expect.m || header.n != expect.n
+        || header.tileMb != expect.tileMb || header.tileNb != expect.tileNb
+        || header.tileRank != expect.tileRank)
+    {
+        MPI_File_close( &file );
+        slate_error( "read_checkpoint: A's tiles or distribution differ"
+                     " from the checkpoint's" );
+    }
+
+    impl::read_pieces( file, header.size(), A, FileLayout::Tiled,
+                       chunk_size, to_devices );
+    slate_mpi_call(
+        MPI_File_close( &file ) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Restores a matrix from a checkpoint written by write_checkpoint, with
+/// the checkpoint's tile sizes and tileRank map, so each rank reads only
+/// its local tiles. Tiles keep their checkpointed devices, modulo the
+/// number of devices available; without devices, they stay on the host.
+///
+/// @param[in] filename
+///     Name of the file.
+///
+/// @param[in] mpi_comm
+///     MPI communicator of the matrix, with at least as many ranks as the
+///     checkpointed matrix.
+///
+/// @param[in] opts
+///     Options, as for read_checkpoint( filename, A, opts ).
+///
+/// @return the matrix restored, with its local tiles inserted on the host.
+///
+/// @ingroup util
+///
+template <typename scalar_t>
+Matrix<scalar_t> read_checkpoint(
+    const char* filename,
+    MPI_Comm mpi_comm,
+    Options const& opts)
+{
+#ifdef SLATE_NO_MPI
+    slate_not_implemented( "read_checkpoint requires MPI-IO" );
+#else
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t chunk_size = get_option<int64_t>( opts, Option::ChunkSize, 1 );
+    chunk_size = std::max( chunk_size, int64_t( 1 ) );
+
+    MPI_File file;
+    slate_mpi_call(
+        MPI_File_open( mpi_comm, filename, MPI_MODE_RDONLY,
+                       MPI_INFO_NULL, &file ) );
+    auto header = std::make_shared<impl::CheckpointHeader>(
+        impl::read_checkpoint_header<scalar_t>( file ) );
+
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size( mpi_comm, &mpi_size ) );
+    for (int64_t rank : header->tileRank) {
+        if (rank >= mpi_size) {
+            MPI_File_close( &file );
+            slate_error( "read_checkpoint: checkpoint has more ranks"
+                         " than mpi_comm" );
+        }
+    }
+
+    int num_devices = MatrixStorage<scalar_t>::num_devices();
+    std::function<int64_t (int64_t)> tileMb = [header]( int64_t i ) {
+        return header->tileMb[ i ];
+    };
+    std::function<int64_t (int64_t)> tileNb = [header]( int64_t j ) {
+        return header->tileNb[ j ];
+    };
+    std::function<int (ij_tuple)> tileRank = [header]( ij_tuple ij ) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        return int( header->tileRank[ i + j*header->mt ] );
+    };
+    std::function<int (ij_tuple)> tileDevice
+        = [header, num_devices]( ij_tuple ij ) {
+        if (num_devices == 0)
+            return HostNum;
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        int64_t device = header->tileDevice[ i + j*header->mt ];
+        return int( std::max( device, int64_t( 0 ) ) % num_devices );
+    };
+
+    Matrix<scalar_t> A( header->m, header->n, tileMb, tileNb,
+                        tileRank, tileDevice, mpi_comm );
+    A.insertLocalTiles();
+
+    bool to_devices = target == Target::Devices && A.num_devices() > 0;
+    impl::read_pieces( file, header->size(), A, FileLayout::Tiled,
+                       chunk_size, to_devices );
+    slate_mpi_call(
+        MPI_File_close( &file ) );
+    return A;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void read_file(
+    const char* filename,
+    Matrix<float>& A,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void read_file(
+    const char* filename,
+    Matrix<double>& A,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void read_file(
+    const char* filename,
+    Matrix< std::complex<float> >& A,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void read_file(
+    const char* filename,
+    Matrix< std::complex<double> >& A,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void write_file(
+    Matrix<float>& A,
+    const char* filename,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void write_file(
+    Matrix<double>& A,
+    const char* filename,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void write_file(
+    Matrix< std::complex<float> >& A,
+    const char* filename,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void write_file(
+    Matrix< std::complex<double> >& A,
+    const char* filename,
+    FileLayout layout,
+    Options const& opts);
+
+template
+void write_checkpoint(
+    Matrix<float>& A,
+    const char* filename,
+    Options const& opts);
+
+template
+void write_checkpoint(
+    Matrix<double>& A,
+    const char* filename,
+    Options const& opts);
+
+template
+void write_checkpoint(
+    Matrix< std::complex<float> >& A,
+    const char* filename,
+    Options const& opts);
+
+template
+void write_checkpoint(
+    Matrix< std::complex<double> >& A,
+    const char* filename,
+    Options const& opts);
+
+template
+void read_checkpoint(
+    const char* filename,
+    Matrix<float>& A,
+    Options const& opts);
+
+template
+void read_checkpoint(
+    const char* filename,
+    Matrix<double>& A,
+    Options const& opts);
+
+template
+void read_checkpoint(
+    const char* filename,
+    Matrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+void read_checkpoint(
+    const char* filename,
+    Matrix< std::complex<double> >& A,
+    Options const& opts);
+
+template
+Matrix<float> read_checkpoint<float>(
+    const char* filename,
+    MPI_Comm mpi_comm,
+    Options const& opts);
+
+template
+Matrix<double> read_checkpoint<double>(
+    const char* filename,
+    MPI_Comm mpi_comm,
+    Options const& opts);
+
+template
+Matrix< std::complex<float> > read_checkpoint< std::complex<float> >(
+    const char* filename,
+    MPI_Comm mpi_comm,
+    Options const& opts);
+
+template
+Matrix< std::complex<double> > read_checkpoint< std::complex<double> >(
+    const char* filename,
+    MPI_Comm mpi_comm,
+    Options const& opts);
+
+} // namespace slate
@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_band.hh"
 
 #include <list>
 #include <tuple>
@@ -61,6 +62,25 @@ void gbmm(
     int64_t klt = ceildiv(kl, A.tileNb(0));
     int64_t kut = ceildiv(ku, A.tileNb(0));
 
+    // Narrow band on devices: one batch per window of block columns of A.
+    if (target == Target::Devices
+        && klt <= internal::band_window_max_tiles
+        && kut <= internal::band_window_max_tiles
+        && B.op() == Op::NoTrans && C.op() == Op::NoTrans) {
+        using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+        internal::band_window_mm(
+            alpha, A, B, beta, C, klt, kut,
+            [] (int64_t i, int64_t k) {
+                return ij_tuple( i, k );
+            },
+            [&] (int64_t i, int64_t k, Tile<scalar_t>& T) {
+                A.tileGetForReading( i, k, HostNum, LayoutConvert( layout ) );
+                tile::gecopy( A( i, k ), T );
+            },
+            opts );
+        return;
+    }
+
     if (target == Target::Devices) {
         C.allocateBatchArrays();
         C.reserveDeviceWorkspace();
@@ -87,16 +87,16 @@ int64_t gbsv(
     // factorization
     Timer t_gbtrf;
     int64_t info = gbtrf( A, pivots, opts );
-    timers[ "gbsv::gbtrf" ] = t_gbtrf.stop();
+    internal::timers_set( opts, "gbsv::gbtrf", t_gbtrf.stop() );
 
     // solve
     Timer t_gbtrs;
     if (info == 0) {
         gbtrs( A, pivots, B, opts );
     }
-    timers[ "gbsv::gbtrs" ] = t_gbtrs.stop();
+    internal::timers_set( opts, "gbsv::gbtrs", t_gbtrs.stop() );
 
-    timers[ "gbsv" ] = t_gbsv.stop();
+    internal::timers_set( opts, "gbsv", t_gbsv.stop() );
 
     return info;
 }
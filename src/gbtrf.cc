@@ -17,7 +17,9 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel band LU factorization.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// Panel computed on host using Host OpenMP task.
+/// For Target::Devices, row swaps, trsm, and gemm of the lookahead and
+/// trailing band window run on the GPU device in RowMajor layout.
 ///
 /// Warning: ColMajor layout is assumed
 ///
@@ -30,13 +32,16 @@ int64_t gbtrf(
     using BcastList = typename BandMatrix<scalar_t>::BcastList;
 
     // Constants
-    const scalar_t zero = 0.0;
     const scalar_t one = 1.0;
     const int priority_0 = 0;
     const int priority_1 = 1;
     const int tag_0 = 0;
+    const int queue_1 = 1;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // GPU Devices use RowMajor for efficient row swapping.
+    const Layout target_layout = target == Target::Devices
+                               ? Layout::RowMajor : Layout::ColMajor;
 
     // Options
     real_t pivot_threshold
@@ -66,7 +71,8 @@ int64_t gbtrf(
     int64_t kut = ceildiv( ku, A.tileNb(0) );
     int64_t ku2t = ceildiv( (ku + kl), A.tileNb(0) );
 
-    // Insert & zero potential fill above upper bandwidth
+    // Insert potential fill above upper bandwidth, as lazy tiles, which
+    // are zero and allocated when first used, instead of zeroing them here.
     A.upperBandwidth(kl + ku);
     //printf( "kl %lld, ku %lld, kl+ku %lld, A.lowerBW %lld, A.upperBW %lld\n",
     //        kl, ku, kl + ku, A.lowerBandwidth(), A.upperBandwidth() );
@@ -74,15 +80,21 @@ int64_t gbtrf(
         for (int64_t j = i + 1 + kut; j < std::min(i + 1 + ku2t, A.nt()); ++j) {
             if (A.tileIsLocal(i, j)) {
                 // todo: device?
-                A.tileInsert(i, j);
-                auto T = A(i, j);
-                lapack::laset(lapack::MatrixType::General, T.mb(), T.nb(),
-                              zero, zero, T.data(), T.stride());
-                A.tileModified(i, j);
+                A.tileInsertLazy(i, j);
             }
         }
     }
 
+    // Allocate batch arrays = number of kernels without lookahead + lookahead
+    // number of kernels without lookahead = 2
+    // (i.e., the trailing band window and the panel)
+    if (target == Target::Devices) {
+        const int64_t batch_size_default = 0;
+        int num_queues = 2 + lookahead;
+        A.allocateBatchArrays( batch_size_default, num_queues );
+        A.reserveDeviceWorkspace();
+    }
+
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
@@ -116,7 +128,8 @@ int64_t gbtrf(
                     // send A(i, k) across row A(i, k+1:nt-1)
                     bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, j_end-1)}});
                 }
-                A.template listBcast(bcast_list_A, layout, tag_k);
+                A.template listBcast<target>(
+                    bcast_list_A, target_layout, tag_k );
 
                 // Root broadcasts the pivot to all ranks.
                 // todo: Panel ranks send the pivots to the right.
@@ -135,29 +148,31 @@ int64_t gbtrf(
                 {
                     // swap rows in A(k:mt-1, j)
                     int tag_j = j;
-                    internal::permuteRows<Target::HostTask>(
+                    int queue_jk1 = j-k+1;
+                    internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, i_end-1, j, j), pivots.at(k),
-                        layout, priority_1, tag_j );
+                        target_layout, priority_1, tag_j, queue_jk1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
                     // solve A(k, k) A(k, j) = A(k, j)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ), A.sub(k, k, j, j),
-                        priority_1, layout );
+                        priority_1, target_layout, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
+                    // todo: trsm still operates in ColMajor
                     A.tileBcast(k, j, A.sub(k+1, i_end-1, j, j), layout, tag_j);
 
                     // A(k+1:mt-1, j) -= A(k+1:mt-1, k) * A(k, j)
-                    internal::gemm<Target::HostTask>(
+                    internal::gemm<target>(
                         -one, A.sub(k+1, i_end-1, k, k),
                               A.sub(k, k, j, j),
                         one,  A.sub(k+1, i_end-1, j, j),
-                        layout, priority_1 );
+                        target_layout, priority_1, queue_jk1 );
                 }
             }
             // Update trailing submatrix, normal priority.
@@ -170,20 +185,20 @@ int64_t gbtrf(
                 {
                     // swap rows in A(k:mt-1, kl+1:nt-1)
                     int tag_kl1 = k+1+lookahead;
-                    internal::permuteRows<Target::HostTask>(
+                    internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, i_end-1, k+1+lookahead, j_end-1),
-                        pivots.at(k), layout, priority_0, tag_kl1 );
+                        pivots.at(k), target_layout, priority_0, tag_kl1, queue_1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
                         TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Akk);
 
                     // solve A(k, k) A(k, kl+1:nt-1) = A(k, kl+1:nt-1)
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ),
                              A.sub(k, k, k+1+lookahead, j_end-1),
-                        priority_0, layout );
+                        priority_0, target_layout, queue_1 );
 
                     // send A(k, kl+1:j_end-1) across A(k+1:mt-1, kl+1:nt-1)
                     BcastList bcast_list_A;
@@ -191,14 +206,15 @@ int64_t gbtrf(
                         // send A(k, j) across column A(k+1:mt-1, j)
                         bcast_list_A.push_back({k, j, {A.sub(k+1, i_end-1, j, j)}});
                     }
-                    A.template listBcast(bcast_list_A, layout, tag_kl1);
+                    A.template listBcast<target>(
+                        bcast_list_A, target_layout, tag_kl1 );
 
                     // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
-                    internal::gemm<Target::HostTask>(
+                    internal::gemm<target>(
                         -one, A.sub(k+1, i_end-1, k, k),
                               A.sub(k, k, k+1+lookahead, j_end-1),
                         one,  A.sub(k+1, i_end-1, k+1+lookahead, j_end-1),
-                        layout, priority_0 );
+                        target_layout, priority_0, queue_1 );
                 }
             }
 
@@ -223,6 +239,7 @@ int64_t gbtrf(
         }
 
         #pragma omp taskwait
+        A.tileLayoutReset();
         A.tileUpdateAllOrigin();
     }
     // Band LU does NOT pivot to the left of the panel, since it would
@@ -40,6 +40,10 @@ namespace slate {
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::NormEstVectors:
+///       Number of vectors t in the block 1-norm estimator; each iteration
+///       does two trsm with t right-hand sides. If 1, uses
+///       the one-vector estimator of LAPACK's lacn2. Default 2.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -91,6 +95,37 @@ blas::real_type<scalar_t> gecondest(
     scalar_t alpha = 1.;
     real_t Ainvnorm = 0.0;
 
+    int64_t t = std::min( get_option<Option::NormEstVectors>( opts, 2 ), m );
+    if (t > 1) {
+        slate::Matrix<scalar_t> X( m, t, A.tileMbFunc(),
+                                   func::uniform_blocksize( t, t ),
+                                   A.tileRankFunc(), A.tileDeviceFunc(),
+                                   A.mpiComm() );
+        X.insertLocalTiles( Target::Host );
+
+        // Block estimate of the 1-norm of inv(A) for Norm::One, of
+        // inv(A^H) for Norm::Inf; each step solves with all t vectors.
+        auto L = TriangularMatrix<scalar_t>( Uplo::Lower, Diag::Unit, A );
+        auto U = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, A );
+        auto apply = [&]( Op op, Matrix<scalar_t>& Y ) {
+            if ((op == Op::NoTrans) == (kase1 == 1)) {
+                slate::trsm( Side::Left, alpha, L, Y, opts );
+                slate::trsm( Side::Left, alpha, U, Y, opts );
+            }
+            else {
+                auto UH = conj_transpose( U );
+                auto LH = conj_transpose( L );
+                slate::trsm( Side::Left, alpha, UH, Y, opts );
+                slate::trsm( Side::Left, alpha, LH, Y, opts );
+            }
+        };
+        Ainvnorm = internal::norm1est_block<scalar_t>( X, apply );
+        if (Ainvnorm != 0.0) {
+            return (1.0 / Ainvnorm) / Anorm;
+        }
+        return 0.;
+    }
+
     std::vector<int64_t> isave = {0, 0, 0, 0};
 
     auto tileMb = A.tileMbFunc();
@@ -8,6 +8,7 @@
 #include "slate/Matrix.hh"
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
+#include "internal/internal_priority.hh"
 
 namespace slate {
 
@@ -33,8 +34,6 @@ void gelqf(
     using blas::real;
 
     // Constants
-    const int priority_0 = 0;
-    const int priority_1 = 1;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
@@ -155,8 +154,18 @@ void gelqf(
             std::vector< int64_t > first_indices
                             = internal::gelqf_compute_first_indices(A_panel, k);
 
-            // panel, high priority
-            #pragma omp task depend(inout:block[k]) priority(1)
+            // Priorities of step k, see internal::task_priority: the panel
+            // LQ and its triangle-triangle reduction, the lookahead rows,
+            // and the trailing rows, over min( mt, nt ) steps.
+            int priority_panel = internal::task_priority(
+                internal::TaskKind::Panel, k, A_min_mtnt );
+            int priority_lookahead = internal::task_priority(
+                internal::TaskKind::Lookahead, k, A_min_mtnt );
+            int priority_trailing = internal::task_priority(
+                internal::TaskKind::Trailing, k, A_min_mtnt );
+
+            // panel, highest priority
+            #pragma omp task depend(inout:block[k]) priority( priority_panel )
             {
                 //--------------------
                 // Instead of doing LQ of panel, we do QR of transpose( panel ),
@@ -176,7 +185,7 @@ void gelqf(
                 internal::geqrf<target>(
                     std::move(AT_panel), std::move(TlT_panel),
                     dwork_array, work_size, ib,
-                    max_panel_threads, priority_1 );
+                    max_panel_threads, priority_panel );
 
                 // Find first local tile, which is triangular factor (T in I - VTV^H),
                 // and copy it to Tlocal.
@@ -249,7 +258,7 @@ void gelqf(
 
                 #pragma omp task depend(in:block[k]) \
                                  depend(inout:block[i]) \
-                                 priority(1)
+                                 priority( priority_lookahead )
                 {
                     // Apply local reflectors
                     int queue_ik1 = i-k+1;
@@ -259,7 +268,7 @@ void gelqf(
                                     std::move(Tl_panel),
                                     std::move(A_trail_i),
                                     W.sub(i, i, k, A_nt-1),
-                                    priority_1, queue_ik1 );
+                                    priority_lookahead, queue_ik1 );
 
                     // Apply triangle-triangle reduction reflectors
                     // ttmlq handles the tile broadcasting internally
@@ -273,14 +282,15 @@ void gelqf(
                 }
             }
 
-            // update trailing submatrix, normal priority
+            // update trailing submatrix, lower priority
             if (k+1+lookahead < A_mt) {
                 int64_t i = k+1+lookahead;
                 auto A_trail_i = A.sub(i, A_mt-1, k, A_nt-1);
 
                 #pragma omp task depend(in:block[k]) \
                                  depend(inout:block[k+1+lookahead]) \
-                                 depend(inout:block[A_mt-1])
+                                 depend(inout:block[A_mt-1]) \
+                                 priority( priority_trailing )
                 {
                     // Apply local reflectors
                     int queue_ik1 = i-k+1;
@@ -290,7 +300,7 @@ void gelqf(
                                     std::move(Tl_panel),
                                     std::move(A_trail_i),
                                     W.sub(i, A_mt-1, k, A_nt-1),
-                                    priority_0, queue_ik1 );
+                                    priority_trailing, queue_ik1 );
 
                     // Apply triangle-triangle reduction reflectors
                     // ttmlq handles the tile broadcasting internally
@@ -93,6 +93,9 @@ void gels(
     Matrix<scalar_t>& BX,
     Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "gels", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "gels", A.mpiComm(), opts );
+
     Method method = get_option( opts, Option::MethodGels, MethodGels::Auto );
 
     if (method == MethodGels::Auto)
@@ -109,6 +112,14 @@ void gels(
             gels_cholqr( A, R, BX, opts );
             break;
         }
+        case MethodGels::TSQR: {
+            gels_tsqr( A, BX, opts );
+            break;
+        }
+        case MethodGels::Sketch: {
+            gels_sketch( A, BX, opts );
+            break;
+        }
     }
 }
 
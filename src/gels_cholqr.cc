@@ -76,6 +76,9 @@ namespace slate {
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::CholQRPasses:
+///       1, 2 (CholeskyQR2), or 3 (shifted CholeskyQR3); more passes
+///       handle more ill-conditioned A; see cholqr. Default 1.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -131,7 +134,7 @@ void gels_cholqr(
 
         Timer t_cholqr;
         cholqr( A0, R, opts );
-        timers[ "gels_cholqr::cholqr" ] = t_cholqr.stop();
+        internal::timers_set( opts, "gels_cholqr::cholqr", t_cholqr.stop() );
 
         auto R_U = TriangularMatrix( Uplo::Upper, Diag::NonUnit, R );
 
@@ -151,7 +154,7 @@ void gels_cholqr(
             // Y = Q^H B
             Timer t_gemm;
             gemm( one, QH, BX, zero, Y );
-            timers[ "gels_cholqr::gemm" ] = t_gemm.stop();
+            internal::timers_set( opts, "gels_cholqr::gemm", t_gemm.stop() );
 
             // Copy back the result
             copy( Y, X );
@@ -159,7 +162,7 @@ void gels_cholqr(
             // X = R^{-1} Y
             Timer t_trsm;
             trsm( Side::Left, one, R_U, X, opts );
-            timers[ "gels_cholqr::trsm" ] = t_trsm.stop();
+            internal::timers_set( opts, "gels_cholqr::trsm", t_trsm.stop() );
         }
         else {
             // Solve A X = A0^H X = (QR)^H X = B.
@@ -177,19 +180,19 @@ void gels_cholqr(
             auto RH = conj_transpose( R_U );
             Timer t_trsm;
             trsm( Side::Left, one, RH, Y, opts );
-            timers[ "gels_cholqr::trsm" ] = t_trsm.stop();
+            internal::timers_set( opts, "gels_cholqr::trsm", t_trsm.stop() );
 
             // X = Q Y, with Q stored in A0.
             Timer t_gemm;
             gemm( one, A0, Y, zero, BX );
-            timers[ "gels_cholqr::gemm" ] = t_gemm.stop();
+            internal::timers_set( opts, "gels_cholqr::gemm", t_gemm.stop() );
         }
     }
     else {
         // todo: LQ factorization
         slate_not_implemented( "least squares using LQ" );
     }
-    timers[ "gels_cholqr" ] = t_gels_cholqr.stop();
+    internal::timers_set( opts, "gels_cholqr", t_gels_cholqr.stop() );
     // todo: return value for errors?
     // R or L is singular => A is not full rank
 }
@@ -0,0 +1,347 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "slate/TriangularMatrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Hash of row i and nonzero l of the sparse sketch; the same on all ranks.
+///
+inline uint64_t sketch_hash( uint64_t i, uint64_t l )
+{
+    uint64_t z = i * 0x9E3779B97F4A7C15ull + l * 0xD1B54A32D192ED03ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Computes the R factor of a sketch S A of the m-by-n A, replicated on all
+/// ranks, and copies it into the local tiles of the n-by-n R.
+///
+/// S is an s-by-m sparse sign matrix, with zeta nonzeros +-1 per column at
+/// rows chosen by sketch_hash. Each rank adds its local tiles of A into a
+/// replicated s-by-n S A, which is summed with one MPI_Allreduce; then
+/// every rank factors it with LAPACK geqrf. This costs O(zeta m n) flops,
+/// instead of the O(s m n) of a dense Gaussian sketch.
+///
+/// @ingroup gels_internal
+///
+template <typename scalar_t>
+void sketch_qr(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& R,
+    int64_t s, int64_t zeta )
+{
+    const scalar_t zero = 0.0;
+    const Layout layout = Layout::ColMajor;
+
+    int64_t n  = A.n();
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    auto row_offset = internal::tile_offsets( RowCol::Row, A );
+    auto col_offset = internal::tile_offsets( RowCol::Col, A );
+
+    // SA = S A; block column k of A updates only block column k of SA.
+    std::vector<scalar_t> SA( s*n, zero );
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t k = 0; k < nt; ++k) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, SA, row_offset, col_offset ) \
+                firstprivate( k, mt, s, zeta, layout )
+            {
+                std::vector<int64_t> rows( zeta );
+                std::vector<scalar_t> signs( zeta );
+                for (int64_t i = 0; i < mt; ++i) {
+                    if (! A.tileIsLocal( i, k ))
+                        continue;
+                    A.tileGetForReading( i, k, LayoutConvert( layout ) );
+                    auto Aik = A( i, k );
+                    for (int64_t ii = 0; ii < Aik.mb(); ++ii) {
+                        for (int64_t l = 0; l < zeta; ++l) {
+                            uint64_t h = sketch_hash( row_offset[ i ] + ii, l );
+                            rows[ l ]  = (h >> 1) % s;
+                            signs[ l ] = (h & 1) ? 1.0 : -1.0;
+                        }
+                        for (int64_t jj = 0; jj < Aik.nb(); ++jj) {
+                            scalar_t* SA_j = &SA[ (col_offset[ k ] + jj)*s ];
+                            scalar_t a = Aik( ii, jj );
+                            for (int64_t l = 0; l < zeta; ++l)
+                                SA_j[ rows[ l ] ] += signs[ l ] * a;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, SA.data(), s*n,
+                       mpi_type<scalar_t>::value, MPI_SUM, A.mpiComm() ) );
+
+    // Every rank factors the same SA, so all get the same R.
+    std::vector<scalar_t> tau( n );
+    lapack::geqrf( s, n, SA.data(), s, tau.data() );
+
+    for (int64_t k = 0; k < nt; ++k) {
+        for (int64_t l = 0; l < nt; ++l) {
+            if (R.tileIsLocal( k, l )) {
+                R.tileGetForWriting( k, l, LayoutConvert( layout ) );
+                auto Rkl = R( k, l );
+                if (k > l) {
+                    Rkl.set( zero );
+                }
+                else {
+                    lapack::lacpy( lapack::MatrixType::General,
+                                   Rkl.mb(), Rkl.nb(),
+                                   &SA[ col_offset[ k ] + col_offset[ l ]*s ], s,
+                                   Rkl.data(), Rkl.stride() );
+                    if (k == l) {
+                        lapack::laset( lapack::MatrixType::Lower,
+                                       Rkl.mb()-1, Rkl.nb()-1, zero, zero,
+                                       &Rkl.at( 1, 0 ), Rkl.stride() );
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Whether gels_sketch applies: A is not transposed, m >= s, and A and BX
+/// have uniform, square tiles with the same row blocking, so n-vectors
+/// can be sliced from BX.
+///
+/// @ingroup gels_internal
+///
+template <typename scalar_t>
+bool sketch_applicable(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    int64_t s )
+{
+    if (A.op() != Op::NoTrans || BX.op() != Op::NoTrans
+        || A.m() < s || BX.mt() != A.mt())
+        return false;
+
+    int64_t nb = A.tileNb( 0 );
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        if (BX.tileMb( i ) != A.tileMb( i )
+            || (i < A.mt()-1 && A.tileMb( i ) != nb))
+            return false;
+    }
+    for (int64_t k = 0; k < A.nt()-1; ++k) {
+        if (A.tileNb( k ) != nb)
+            return false;
+    }
+    return true;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel least squares solve via a randomized sketch and
+/// preconditioned LSQR (sketch-and-precondition, as in Blendenpik and
+/// LSRN), for very overdetermined $A$.
+///
+/// Solves the overdetermined $A X = B$, m >= n,
+/// with least squares solution $X$ that minimizes $\norm{ A X - B }_2$.
+/// $BX$ is m-by-nrhs.
+/// On input, $B$ is all m rows of $BX$.
+/// On output, $X$ is first n rows of $BX$.
+///
+/// A sparse sign sketch $S A$, with s = 4n rows and 8 nonzeros per column
+/// of S, is formed in one pass over A and one MPI_Allreduce, and factored
+/// $S A = Q R$ on each rank. $A R^{-1}$ is then well conditioned with high
+/// probability, so LSQR on $\min \norm{ A R^{-1} y - b }_2$, with
+/// $x = R^{-1} y$, converges in a few tens of iterations, each a gemm with
+/// $A$, a gemm with $A^H$, and two trsm with the n-by-n R.
+/// That is O(m n) flops per iteration, instead of the O(m n^2) of gels_qr.
+/// Each column of B is solved in turn.
+///
+/// If A is transposed, m < 4n, or the tiles are not uniform, this calls
+/// gels_qr.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$, m >= n, of full rank.
+///     Not modified, unless this calls gels_qr.
+///
+/// @param[in,out] BX
+///     Matrix of size m-by-nrhs, with the same row tiles as A.
+///     On entry, the m-by-nrhs right hand side matrix $B$.
+///     On exit, the n-by-nrhs solution matrix $X$ is in its first n rows;
+///     the other rows are unchanged.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Tolerance:
+///       LSQR stops when $\norm{ (A R^{-1})^H r } \le tol
+///       \norm{A R^{-1}} \norm{r}$, or $\norm{r} \le tol \norm{b}$.
+///       Default epsilon * sqrt(n).
+///     - Option::MaxIterations:
+///       Maximum number of LSQR iterations per column. Default 100.
+///     - Option::Target:
+///       Implementation to target, as for gemm and trsm.
+///
+/// @ingroup gels
+///
+template <typename scalar_t>
+void gels_sketch(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    trace::Block trace_block( "slate::gels_sketch" );
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const int64_t zeta = 8;
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t nrhs = BX.n();
+    int64_t s = 4*n;
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 100 );
+    real_t tol = get_option<double>( opts, Option::Tolerance,
+                                     eps*std::sqrt( n ) );
+
+    if (! impl::sketch_applicable( A, BX, s )) {
+        TriangularFactors<scalar_t> T;
+        gels_qr( A, T, BX, opts );
+        return;
+    }
+
+    // Preconditioner R from the sketch.
+    auto R = A.emptyLike().slice( 0, n-1, 0, n-1 );
+    R.insertLocalTiles( target );
+    impl::sketch_qr( A, R, s, std::min( zeta, s ) );
+    auto R_tri = TriangularMatrix<scalar_t>( Uplo::Upper, Diag::NonUnit, R );
+    auto RH = conj_transpose( R_tri );
+    auto AH = conj_transpose( A );
+
+    // m-vector u, and n-vectors v, w, y, and t, with the rows of BX.
+    auto u = BX.emptyLike( 0, 1 ).slice( 0, m-1, 0, 0 );
+    auto v = BX.emptyLike( 0, 1 ).slice( 0, n-1, 0, 0 );
+    auto w = BX.emptyLike( 0, 1 ).slice( 0, n-1, 0, 0 );
+    auto y = BX.emptyLike( 0, 1 ).slice( 0, n-1, 0, 0 );
+    auto t = BX.emptyLike( 0, 1 ).slice( 0, n-1, 0, 0 );
+    u.insertLocalTiles( target );
+    v.insertLocalTiles( target );
+    w.insertLocalTiles( target );
+    y.insertLocalTiles( target );
+    t.insertLocalTiles( target );
+
+    for (int64_t j = 0; j < nrhs; ++j) {
+        auto b = BX.slice( 0, m-1, j, j );
+        auto x = BX.slice( 0, n-1, j, j );
+
+        // Golub-Kahan bidiagonalization of A R^{-1}, started from b:
+        // beta u = b, alpha v = R^{-H} A^H u.
+        copy( b, u, opts );
+        real_t beta = norm( Norm::Fro, u, opts );
+        real_t bnorm = beta;
+        set( zero, zero, y, opts );
+        if (beta == 0) {
+            copy( y, x, opts );
+            continue;
+        }
+        scale( 1.0, beta, u, opts );
+        gemm( one, AH, u, zero, v, opts );
+        trsm( Side::Left, one, RH, v, opts );
+        real_t alpha = norm( Norm::Fro, v, opts );
+        if (alpha != 0)
+            scale( 1.0, alpha, v, opts );
+        copy( v, w, opts );
+
+        real_t phibar = beta, rhobar = alpha, anorm = 0;
+        for (int64_t iter = 0; iter < itermax && alpha != 0; ++iter) {
+            // beta u = A R^{-1} v - alpha u.
+            copy( v, t, opts );
+            trsm( Side::Left, one, R_tri, t, opts );
+            gemm( one, A, t, scalar_t( -alpha ), u, opts );
+            beta = norm( Norm::Fro, u, opts );
+            if (beta != 0)
+                scale( 1.0, beta, u, opts );
+            anorm = std::sqrt( anorm*anorm + alpha*alpha + beta*beta );
+
+            // alpha v = R^{-H} A^H u - beta v.
+            gemm( one, AH, u, zero, t, opts );
+            trsm( Side::Left, one, RH, t, opts );
+            add( one, t, scalar_t( -beta ), v, opts );
+            alpha = norm( Norm::Fro, v, opts );
+            if (alpha != 0)
+                scale( 1.0, alpha, v, opts );
+
+            // Givens rotation to eliminate beta; update y and w.
+            real_t rho = std::hypot( rhobar, beta );
+            real_t c   = rhobar / rho;
+            real_t sn  = beta / rho;
+            real_t theta = sn * alpha;
+            real_t phi = c * phibar;
+            rhobar = -c * alpha;
+            phibar = sn * phibar;
+            add( scalar_t( phi / rho ), w, one, y, opts );
+            add( one, v, scalar_t( -theta / rho ), w, opts );
+
+            // phibar = norm(r); phibar alpha |c| = norm((A R^{-1})^H r).
+            if (phibar <= tol * bnorm
+                || alpha * std::abs( c ) <= tol * anorm)
+                break;
+        }
+
+        // x = R^{-1} y.
+        trsm( Side::Left, one, R_tri, y, opts );
+        copy( y, x, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gels_sketch<float>(
+    Matrix<float>& A,
+    Matrix<float>& BX,
+    Options const& opts);
+
+template
+void gels_sketch<double>(
+    Matrix<double>& A,
+    Matrix<double>& BX,
+    Options const& opts);
+
+template
+void gels_sketch< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& BX,
+    Options const& opts);
+
+template
+void gels_sketch< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& BX,
+    Options const& opts);
+
+} // namespace slate
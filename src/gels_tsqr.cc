@@ -0,0 +1,259 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Whether gels_tsqr applies: A is tall and not transposed, each block row
+/// of A is on one rank, and each block row of BX is on the same rank as
+/// that of A, with the same height.
+///
+/// @ingroup gels_internal
+///
+template <typename scalar_t>
+bool tsqr_applicable(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX )
+{
+    if (A.op() != Op::NoTrans || BX.op() != Op::NoTrans
+        || A.m() < A.n() || BX.mt() != A.mt())
+        return false;
+
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        int rank = A.tileRank( i, 0 );
+        if (BX.tileMb( i ) != A.tileMb( i ))
+            return false;
+        for (int64_t k = 1; k < A.nt(); ++k) {
+            if (A.tileRank( i, k ) != rank)
+                return false;
+        }
+        for (int64_t j = 0; j < BX.nt(); ++j) {
+            if (BX.tileRank( i, j ) != rank)
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel least squares solve via tall-skinny QR (TSQR),
+/// for tall-skinny $A$ with whole block rows on each rank, e.g., on a
+/// p-by-1 grid.
+///
+/// Solves the overdetermined $A X = B$, m >= n,
+/// with least squares solution $X$ that minimizes $\norm{ A X - B }_2$.
+/// $BX$ is m-by-nrhs.
+/// On input, $B$ is all m rows of $BX$.
+/// On output, $X$ is first n rows of $BX$.
+///
+/// Each rank stacks its block rows of $A$ and $B$, factors them with one
+/// LAPACK geqrf, and applies $Q^H$ to its rows of $B$ with unmqr. The n-by-n
+/// R factors, with the top n rows of $Q^H B$, are then combined up a binary
+/// tree over the ranks, one geqrf of a stacked 2n-by-n [ R; R ] per level,
+/// instead of one panel reduction per block column as in gels_qr.
+/// $Q$ is applied implicitly, level by level, as it is formed, and is not
+/// kept. Rank 0 solves $R X = Q^H B$ and broadcasts $X$.
+///
+/// If A is transposed, m < n, or the distributions don't allow this,
+/// this calls gels_qr.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$, m >= n, with each block row on one rank.
+///     Not modified, unless this calls gels_qr.
+///
+/// @param[in,out] BX
+///     Matrix of size m-by-nrhs, with the same block rows and ranks as A.
+///     On entry, the m-by-nrhs right hand side matrix $B$.
+///     On exit, the n-by-nrhs solution matrix $X$ is in its first n rows;
+///     the other rows are unspecified.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs.
+///     Used only if this calls gels_qr.
+///
+/// @ingroup gels
+///
+template <typename scalar_t>
+void gels_tsqr(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& BX,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::gels_tsqr" );
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+    const Layout layout = Layout::ColMajor;
+    const int tag = 0;
+
+    if (! impl::tsqr_applicable( A, BX )) {
+        TriangularFactors<scalar_t> T;
+        gels_qr( A, T, BX, opts );
+        return;
+    }
+
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    int64_t n = A.n();
+    int64_t nrhs = BX.n();
+    auto A_col_offset = internal::tile_offsets( RowCol::Col, A );
+    auto B_col_offset = internal::tile_offsets( RowCol::Col, BX );
+    auto row_offset   = internal::tile_offsets( RowCol::Row, A );
+
+    // Stack the local block rows of A and B.
+    std::vector<int64_t> rows;
+    int64_t m_loc = 0;
+    for (int64_t i = 0; i < mt; ++i) {
+        if (A.tileIsLocal( i, 0 )) {
+            rows.push_back( i );
+            m_loc += A.tileMb( i );
+        }
+    }
+    int64_t ld = std::max( m_loc, int64_t( 1 ) );
+    std::vector<scalar_t> A_loc( ld*n ), B_loc( ld*nrhs );
+    int64_t ii = 0;
+    for (int64_t i : rows) {
+        for (int64_t k = 0; k < nt; ++k) {
+            A.tileGetForReading( i, k, LayoutConvert( layout ) );
+            auto Aik = A( i, k );
+            lapack::lacpy( lapack::MatrixType::General, Aik.mb(), Aik.nb(),
+                           Aik.data(), Aik.stride(),
+                           &A_loc[ ii + A_col_offset[ k ]*ld ], ld );
+        }
+        for (int64_t j = 0; j < BX.nt(); ++j) {
+            BX.tileGetForReading( i, j, LayoutConvert( layout ) );
+            auto Bij = BX( i, j );
+            lapack::lacpy( lapack::MatrixType::General, Bij.mb(), Bij.nb(),
+                           Bij.data(), Bij.stride(),
+                           &B_loc[ ii + B_col_offset[ j ]*ld ], ld );
+        }
+        ii += A.tileMb( i );
+    }
+
+    // RY = [ R  Y ], with R the n-by-n upper triangle of the local QR,
+    // padded with zero rows if m_loc < n, and Y the top n rows of Q^H B.
+    // The tree stacks two of them into the 2n-by-(n + nrhs) [ RY; RY ].
+    int64_t ld2 = 2*n;
+    std::vector<scalar_t> RY( ld2*(n + nrhs), zero );
+    std::vector<scalar_t> tau( n );
+    int64_t k_loc = std::min( m_loc, n );
+    if (m_loc > 0) {
+        lapack::geqrf( m_loc, n, A_loc.data(), ld, tau.data() );
+        lapack::unmqr( Side::Left, Op::ConjTrans, m_loc, nrhs, k_loc,
+                       A_loc.data(), ld, tau.data(), B_loc.data(), ld );
+        lapack::lacpy( lapack::MatrixType::Upper, k_loc, n,
+                       A_loc.data(), ld, RY.data(), ld2 );
+        lapack::lacpy( lapack::MatrixType::General, k_loc, nrhs,
+                       B_loc.data(), ld, &RY[ n*ld2 ], ld2 );
+    }
+    A_loc.clear();
+    B_loc.clear();
+
+    // Binary reduction tree: at level s, rank r with r % 2s == 0
+    // combines the RY of rank r + s into its own; rank 0 gets the result.
+    int mpi_rank = A.mpiRank();
+    int mpi_size;
+    MPI_Comm comm = A.mpiComm();
+    slate_mpi_call(
+        MPI_Comm_size( comm, &mpi_size ) );
+
+    // Packs the top n rows of RY, i.e., one n-by-(n + nrhs) block.
+    std::vector<scalar_t> msg( n*(n + nrhs) );
+    for (int s = 1; s < mpi_size; s *= 2) {
+        if (mpi_rank % (2*s) == s) {
+            lapack::lacpy( lapack::MatrixType::General, n, n + nrhs,
+                           RY.data(), ld2, msg.data(), n );
+            slate_mpi_call(
+                MPI_Send( msg.data(), msg.size(), mpi_type<scalar_t>::value,
+                          mpi_rank - s, tag, comm ) );
+            break;
+        }
+        else if (mpi_rank + s < mpi_size) {
+            slate_mpi_call(
+                MPI_Recv( msg.data(), msg.size(), mpi_type<scalar_t>::value,
+                          mpi_rank + s, tag, comm, MPI_STATUS_IGNORE ) );
+            lapack::lacpy( lapack::MatrixType::General, n, n + nrhs,
+                           msg.data(), n, &RY[ n ], ld2 );
+            lapack::laset( lapack::MatrixType::Lower, n-1, n-1, zero, zero,
+                           &RY[ 1 ], ld2 );
+            lapack::laset( lapack::MatrixType::Lower, n-1, n-1, zero, zero,
+                           &RY[ n+1 ], ld2 );
+
+            // QR of [ R_r; R_{r+s} ], and Q^H [ Y_r; Y_{r+s} ].
+            lapack::geqrf( 2*n, n, RY.data(), ld2, tau.data() );
+            lapack::unmqr( Side::Left, Op::ConjTrans, 2*n, nrhs, n,
+                           RY.data(), ld2, tau.data(), &RY[ n*ld2 ], ld2 );
+        }
+    }
+
+    // Solve R X = Y on rank 0, and broadcast X.
+    std::vector<scalar_t> X( n*nrhs );
+    if (mpi_rank == 0) {
+        blas::trsm( blas::Layout::ColMajor, Side::Left, Uplo::Upper,
+                    Op::NoTrans, Diag::NonUnit, n, nrhs,
+                    one, RY.data(), ld2, &RY[ n*ld2 ], ld2 );
+        lapack::lacpy( lapack::MatrixType::General, n, nrhs,
+                       &RY[ n*ld2 ], ld2, X.data(), n );
+    }
+    slate_mpi_call(
+        MPI_Bcast( X.data(), X.size(), mpi_type<scalar_t>::value, 0, comm ) );
+
+    // Copy X into the first n rows of BX.
+    for (int64_t i = 0; i < mt && row_offset[ i ] < n; ++i) {
+        for (int64_t j = 0; j < BX.nt(); ++j) {
+            if (BX.tileIsLocal( i, j )) {
+                BX.tileGetForWriting( i, j, LayoutConvert( layout ) );
+                auto Bij = BX( i, j );
+                int64_t mb = std::min( Bij.mb(), n - row_offset[ i ] );
+                lapack::lacpy( lapack::MatrixType::General, mb, Bij.nb(),
+                               &X[ row_offset[ i ] + B_col_offset[ j ]*n ], n,
+                               Bij.data(), Bij.stride() );
+            }
+        }
+    }
+    BX.tileUpdateAllOrigin();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gels_tsqr<float>(
+    Matrix<float>& A,
+    Matrix<float>& BX,
+    Options const& opts);
+
+template
+void gels_tsqr<double>(
+    Matrix<double>& A,
+    Matrix<double>& BX,
+    Options const& opts);
+
+template
+void gels_tsqr< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& BX,
+    Options const& opts);
+
+template
+void gels_tsqr< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& BX,
+    Options const& opts);
+
+} // namespace slate
@@ -53,6 +53,10 @@ namespace slate {
 ///           - Auto: let the routine decides [default]
 ///           - gemmA: select gemmA routine
 ///           - gemmC: select gemmC routine
+///           - gemm25D: select gemm25D routine, with Option::Layers
+///             replicas of C
+///           - Strassen: select gemmStrassen routine, with fewer flops
+///             but a weaker, normwise error bound
 ///         - Option::Target:
 ///           Implementation to target. Possible values:
 ///           - HostTask:  OpenMP tasks on CPU host [default].
@@ -68,6 +72,9 @@ void gemm(scalar_t alpha, Matrix<scalar_t>& A,
           scalar_t beta,  Matrix<scalar_t>& C,
           Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "gemm", C.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "gemm", C.mpiComm(), opts );
+
     Method method = get_option(
         opts, Option::MethodGemm, MethodGemm::Auto );
 
@@ -84,6 +91,12 @@ void gemm(scalar_t alpha, Matrix<scalar_t>& A,
         case MethodGemm::GemmC:
             gemmC( alpha, A, B, beta, C, tuned_opts );
             break;
+        case MethodGemm::Gemm25D:
+            gemm25D( alpha, A, B, beta, C, tuned_opts );
+            break;
+        case MethodGemm::Strassen:
+            gemmStrassen( alpha, A, B, beta, C, tuned_opts );
+            break;
     }
 }
 
@@ -0,0 +1,227 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel general matrix-matrix multiplication,
+/// communication-avoiding 2.5D variant.
+/// Performs the matrix-matrix operation
+/// \[
+///     C = \alpha A B + \beta C,
+/// \]
+/// where alpha and beta are scalars, and $A$, $B$, and $C$ are matrices, with
+/// $A$ an m-by-k matrix, $B$ a k-by-n matrix, and $C$ an m-by-n matrix.
+///
+/// The p-by-q process grid of C is split into c layers, each a
+/// p-by-(q/c) grid of every c-th process column (or (p/c)-by-q, of every
+/// c-th process row, if c doesn't divide q). Layer l gets the l-th slice
+/// of the block columns of A and block rows of B, redistributed onto its
+/// grid, and a replica of C, and computes its part of the k-sum with gemmC
+/// on its grid only. The replicas are then summed into C with listReduce.
+/// SUMMA bandwidth per rank drops by about $\sqrt{c}$, at the cost of c
+/// replicas of C.
+///
+/// If c is 1, or divides neither p nor q, or A has fewer than c block
+/// columns, this calls gemmC.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         The m-by-k matrix A.
+///
+/// @param[in] B
+///         The k-by-n matrix B.
+///
+/// @param[in] beta
+///         The scalar beta.
+///
+/// @param[in,out] C
+///         On entry, the m-by-n matrix C.
+///         C must have a 2D block-cyclic distribution.
+///         On exit, overwritten by the result $\alpha A B + \beta C$.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Layers:
+///           Number of layers c, >= 1. Default 2.
+///         - Option::Lookahead:
+///           Number of blocks to overlap communication and computation
+///           in each layer. lookahead >= 0. Default 1.
+///         - Option::Target:
+///           Implementation to target, as for gemmC.
+///
+/// @ingroup gemm
+///
+template <typename scalar_t>
+void gemm25D(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts)
+{
+    using ReduceList = typename Matrix<scalar_t>::ReduceList;
+
+    trace::Block trace_block( "slate::gemm25D" );
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    int64_t layers = get_option<int64_t>( opts, Option::Layers, 2 );
+
+    GridOrder grid_order;
+    int p, q, myrow, mycol;
+    C.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+
+    int64_t kt = A.nt();
+    bool split_cols = p > 0 && q % layers == 0;
+    bool split_rows = p > 0 && ! split_cols && p % layers == 0;
+    if (layers <= 1 || kt < layers || C.op() != Op::NoTrans
+        || ! (split_cols || split_rows)) {
+        gemmC( alpha, A, B, beta, C, opts );
+        return;
+    }
+
+    // Layer l is process columns (or rows) l, l + c, l + 2c, ... of C's grid.
+    int p_l = split_rows ? p / layers : p;
+    int q_l = split_cols ? q / layers : q;
+    int64_t my_layer = split_cols ? mycol % layers : myrow % layers;
+    auto layer_rank = [=]( int64_t l, int64_t i, int64_t j ) {
+        int64_t row = i % p_l;
+        int64_t col = j % q_l;
+        if (split_cols)
+            col = col*layers + l;
+        else
+            row = row*layers + l;
+        return int( grid_order == GridOrder::Col ? row + col*p : row*q + col );
+    };
+
+    // Matrix with X's tiles, distributed 2D block-cyclic on layer l.
+    int num_devices = std::max( C.num_devices(), 1 );
+    auto layer_like = [&]( Matrix<scalar_t>& X, int64_t l ) {
+        std::vector<int64_t> mb( X.mt() ), nb( X.nt() );
+        for (int64_t i = 0; i < X.mt(); ++i)
+            mb[ i ] = X.tileMb( i );
+        for (int64_t j = 0; j < X.nt(); ++j)
+            nb[ j ] = X.tileNb( j );
+        std::function<int64_t (int64_t)> tileMb = [mb]( int64_t i ) {
+            return mb[ i ];
+        };
+        std::function<int64_t (int64_t)> tileNb = [nb]( int64_t j ) {
+            return nb[ j ];
+        };
+        std::function<int (ij_tuple)> tileRank = [=]( ij_tuple ij ) {
+            return layer_rank( l, std::get<0>( ij ), std::get<1>( ij ) );
+        };
+        std::function<int (ij_tuple)> tileDevice
+            = func::device_1d_grid( GridOrder::Col, p_l, num_devices );
+        Matrix<scalar_t> X_l( X.m(), X.n(), tileMb, tileNb, tileRank,
+                              tileDevice, X.mpiComm() );
+        X_l.insertLocalTiles();
+        return X_l;
+    };
+
+    // Each layer gets its slice of A and B, and a replica of C.
+    // Every rank takes part in every redistribute, in the same order.
+    std::vector< Matrix<scalar_t> > A_layer, B_layer, C_layer;
+    for (int64_t l = 0; l < layers; ++l) {
+        int64_t k_begin = l*kt / layers;
+        int64_t k_end   = (l + 1)*kt / layers;
+        auto A_slice = A.sub( 0, A.mt()-1, k_begin, k_end-1 );
+        auto B_slice = B.sub( k_begin, k_end-1, 0, B.nt()-1 );
+        A_layer.push_back( layer_like( A_slice, l ) );
+        B_layer.push_back( layer_like( B_slice, l ) );
+        C_layer.push_back( layer_like( C, l ) );
+        redistribute( A_slice, A_layer[ l ], opts );
+        redistribute( B_slice, B_layer[ l ], opts );
+    }
+
+    // Each layer sums its slice of k, with SUMMA on its own grid.
+    gemmC( alpha, A_layer[ my_layer ], B_layer[ my_layer ],
+           zero,  C_layer[ my_layer ], opts );
+    A_layer.clear();
+    B_layer.clear();
+
+    // C = beta C + sum of the replicas. Replicas of tiles C owns are added
+    // locally; others are copied into workspace tiles of C and reduced.
+    auto& C_my = C_layer[ my_layer ];
+    ReduceList reduce_list;
+    for (int64_t j = 0; j < C.nt(); ++j) {
+        for (int64_t i = 0; i < C.mt(); ++i) {
+            if (C.tileIsLocal( i, j )) {
+                C.tileGetForWriting( i, j, LayoutConvert( layout ) );
+                auto Cij = C( i, j );
+                if (beta == zero)
+                    Cij.set( zero );
+                else
+                    tile::scale( beta, Cij );
+            }
+            if (C_my.tileIsLocal( i, j )) {
+                C_my.tileGetForReading( i, j, LayoutConvert( layout ) );
+                auto C_ij = C_my( i, j );
+                if (C.tileIsLocal( i, j )) {
+                    auto Cij = C( i, j );
+                    tile::add( one, C_ij, Cij );
+                }
+                else {
+                    C.tileInsertWorkspace( i, j );
+                    auto Cij = C( i, j );
+                    tile::gecopy( C_ij, Cij );
+                }
+            }
+
+            std::vector< Matrix<scalar_t> > sources;
+            for (int64_t l = 0; l < layers; ++l)
+                sources.push_back( C_layer[ l ].sub( i, i, j, j ) );
+            reduce_list.push_back( { i, j, C.sub( i, i, j, j ), sources } );
+        }
+    }
+    // listReduce erases the workspace tiles once they are sent.
+    C.template listReduce<Target::HostTask>( reduce_list, layout );
+
+    C.tileUpdateAllOrigin();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemm25D<float>(
+    float alpha, Matrix<float>& A,
+                 Matrix<float>& B,
+    float beta,  Matrix<float>& C,
+    Options const& opts);
+
+template
+void gemm25D<double>(
+    double alpha, Matrix<double>& A,
+                  Matrix<double>& B,
+    double beta,  Matrix<double>& C,
+    Options const& opts);
+
+template
+void gemm25D< std::complex<float> >(
+    std::complex<float> alpha, Matrix< std::complex<float> >& A,
+                               Matrix< std::complex<float> >& B,
+    std::complex<float> beta,  Matrix< std::complex<float> >& C,
+    Options const& opts);
+
+template
+void gemm25D< std::complex<double> >(
+    std::complex<double> alpha, Matrix< std::complex<double> >& A,
+                                Matrix< std::complex<double> >& B,
+    std::complex<double> beta,  Matrix< std::complex<double> >& C,
+    Options const& opts);
+
+} // namespace slate
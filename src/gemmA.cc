@@ -38,25 +38,41 @@ void gemmA(
     Options const& opts )
 {
     using BcastList = typename Matrix<scalar_t>::BcastList;
+    using ReduceList = typename Matrix<scalar_t>::ReduceList;
+    using ReduceRequests = typename Matrix<scalar_t>::ReduceRequests;
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
     // Options
     int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    Workspace* workspace = get_option<Workspace*>( opts, Option::Workspace, nullptr );
+
+    // Collective; node grouping for Option::HierarchicalBcast.
+    if (get_option<Option::HierarchicalBcast>( opts, false ))
+        internal::commNodes( B.mpiComm() );
 
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> bcast_vector( A.nt() );
     std::vector<uint8_t> gemmA_vector( A.nt() );
+    std::vector<uint8_t> reduce_vector( B.nt() );
     uint8_t* bcast = bcast_vector.data();
     uint8_t* gemmA = gemmA_vector.data();
+    uint8_t* reduce = reduce_vector.data();
     SLATE_UNUSED( bcast ); // Used only by OpenMP
     SLATE_UNUSED( gemmA ); // Used only by OpenMP
+    SLATE_UNUSED( reduce ); // Used only by OpenMP
+
+    // Reductions of C(:, k) are started in gemmA[ k ] and completed in
+    // reduce[ k ], so they overlap with the multiply of the next column.
+    std::vector<ReduceRequests> reduce_requests( B.nt() );
 
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
         if (A.num_devices() > 1)
             slate_not_implemented( "gemmA doesn't support multiple GPUs" );
 
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays();
         A.reserveDeviceWorkspace();
     }
@@ -76,7 +92,8 @@ void gemmA(
                 bcast_list_B.push_back(
                     {i, 0, {A.sub( 0, A.mt()-1, i, i )}} );
             int tag_0 = 0;
-            B.template listBcast<target>( bcast_list_B, layout, tag_0 );
+            B.template listBcast<target>(
+                bcast_list_B, layout, tag_0, false, opts );
         }
 
         // broadcast lookahead block cols of B
@@ -91,7 +108,8 @@ void gemmA(
                     bcast_list_B.push_back(
                         {i, k, {A.sub( 0, A.mt()-1, i, i )}} );
                 int tag_k = k;
-                B.template listBcast<target>( bcast_list_B, layout, tag_k );
+                B.template listBcast<target>(
+                    bcast_list_B, layout, tag_k, false, opts );
             }
         }
 
@@ -108,8 +126,7 @@ void gemmA(
                 beta,  C.sub( 0, C.mt()-1, 0, 0 ),
                 layout );
 
-            // reduce C(:, 0)
-            using ReduceList = typename Matrix<scalar_t>::ReduceList;
+            // start reducing C(:, 0)
             ReduceList reduce_list_C;
             for (int64_t i = 0; i < C.mt(); ++i)
                 // reduce C(i, 0) across i_th row of A
@@ -118,11 +135,20 @@ void gemmA(
                                           {A.sub( i, i, 0, A.nt()-1 )}
                                         } );
             int tag_0 = 0;
-            C.template listReduce( reduce_list_C, layout, tag_0 );
+            reduce_requests[ 0 ] = C.template listReduceBegin<target>(
+                reduce_list_C, layout, tag_0 );
         }
 
-        // Clean up workspace
+        // finish reducing C(:, 0)
         #pragma omp task depend( in:gemmA[ 0 ] ) \
+                         depend( out:reduce[ 0 ] ) \
+                         shared( C, reduce_requests )
+        {
+            C.listReduceEnd( reduce_requests[ 0 ] );
+        }
+
+        // Clean up workspace
+        #pragma omp task depend( in:reduce[ 0 ] ) \
                           shared( B, C )
         {
             auto B_col_0 = B.sub( 0, B.mt()-1, 0, 0 );
@@ -152,7 +178,7 @@ void gemmA(
                             {i, k+lookahead, {A.sub( 0, A.mt()-1, i, i )}} );
                     int tag_kl = k+lookahead;
                     B.template listBcast<target>(
-                        bcast_list_B, layout, tag_kl );
+                        bcast_list_B, layout, tag_kl, false, opts );
                 }
             }
 
@@ -170,8 +196,7 @@ void gemmA(
                     beta,  C.sub( 0, C.mt()-1, k, k ),
                     layout );
 
-                // reduce C(:, k)
-                using ReduceList = typename Matrix<scalar_t>::ReduceList;
+                // start reducing C(:, k)
                 ReduceList reduce_list_C;
                 for (int64_t i = 0; i < C.mt(); ++i)
                     // reduce C(i, 0) across i_th row of A
@@ -180,11 +205,21 @@ void gemmA(
                                               {A.sub( i, i, 0, A.nt()-1 )}
                                             } );
                 int tag_k = k;
-                C.template listReduce( reduce_list_C, layout, tag_k );
+                reduce_requests[ k ] = C.template listReduceBegin<target>(
+                    reduce_list_C, layout, tag_k );
             }
 
-            // Clean up workspace
+            // finish reducing C(:, k)
             #pragma omp task depend( in:gemmA[ k ] ) \
+                             depend( out:reduce[ k ] ) \
+                             shared( C, reduce_requests ) \
+                             firstprivate( k )
+            {
+                C.listReduceEnd( reduce_requests[ k ] );
+            }
+
+            // Clean up workspace
+            #pragma omp task depend( in:reduce[ k ] ) \
                               shared( B, C ) \
                               firstprivate( k )
             {
@@ -258,6 +293,13 @@ void gemmA(
 ///           - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///           - HostBatch: batched BLAS on CPU host.
 ///           - Devices:   batched BLAS on GPU device.
+///         - Option::AggregateBcast:
+///           Whether to send all tiles of B going to the same rank in one
+///           message; see BaseMatrix::listBcastAggregated. Default false.
+///
+///         - Option::HierarchicalBcast:
+///           Whether to broadcast tiles between nodes first, then within
+///           nodes; see internal::hierarchicalBcastPattern. Default false.
 ///
 /// @ingroup gemm
 ///
@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "slate/internal/TaskRuntime.hh"
 
 #include <list>
 #include <tuple>
@@ -37,11 +38,69 @@ void gemmC(
     trace::Block gemm_block( "gemm" );
 
     // Constants
-    const scalar_t one = 1.0;
+    const scalar_t zero = 0.0, one = 1.0;
     const Layout layout = Layout::ColMajor;
 
     // Options
     int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    Workspace* workspace = get_option<Workspace*>( opts, Option::Workspace, nullptr );
+    int64_t max_workspace = get_option<int64_t>( opts, Option::MaxWorkspace, 0 );
+    bool hierarchical = get_option<Option::HierarchicalBcast>( opts, false );
+
+    // Collective; node grouping for Option::HierarchicalBcast.
+    if (hierarchical)
+        internal::commNodes( C.mpiComm() );
+
+    if (max_workspace > 0 && A.nt() > 0) {
+        // Bound the remote tiles of A and B held at once: up to
+        // lookahead + 2 panels are live, counting the one being released
+        // while the next is received. Estimates must match on all ranks, so
+        // they use the grid, not this rank's tiles; with no 2D grid,
+        // assume one rank owns all of C.
+        GridOrder grid_order;
+        int p, q, myrow, mycol;
+        C.gridinfo( &grid_order, &p, &q, &myrow, &mycol );
+        if (p <= 0 || q <= 0)
+            p = q = 1;
+
+        int64_t word = sizeof( scalar_t );
+        int64_t kb = A.tileNb( 0 );
+        int64_t row_bytes = A.tileMb( 0 ) * kb * word;  // one tile A(i, k)
+        int64_t col_bytes = kb * B.tileNb( 0 ) * word;  // one tile B(k, j)
+        int64_t B_bytes = ceildiv( C.nt(), int64_t( q ) ) * col_bytes;
+        int64_t panel_bytes
+            = ceildiv( C.mt(), int64_t( p ) ) * row_bytes + B_bytes;
+
+        int64_t panels = max_workspace / panel_bytes;
+        if (panels >= 2) {
+            lookahead = std::min( lookahead, panels - 2 );
+        }
+        else if (C.mt() > 1) {
+            // Even one panel is too big: stream blocks of rows of C,
+            // each with a sub-panel of A and no lookahead. B(k, :) is
+            // broadcast once per block of rows.
+            int64_t local_rows = std::max(
+                int64_t( 1 ), (max_workspace/2 - B_bytes) / row_bytes );
+            int64_t chunk = std::min( C.mt(), local_rows * p );
+
+            Options opts_chunk = opts;
+            opts_chunk[ Option::Lookahead ] = int64_t( 0 );
+            opts_chunk[ Option::MaxWorkspace ] = int64_t( 0 );
+            for (int64_t i1 = 0; i1 < C.mt(); i1 += chunk) {
+                int64_t i2 = std::min( i1 + chunk, C.mt() ) - 1;
+                auto A_chunk = A.sub( i1, i2, 0, A.nt()-1 );
+                auto C_chunk = C.sub( i1, i2, 0, C.nt()-1 );
+                gemmC<target>( alpha, A_chunk, B, beta, C_chunk, opts_chunk );
+
+                // Free device copies of this block of C for the next one.
+                C_chunk.releaseLocalWorkspace();
+            }
+            return;
+        }
+        else {
+            lookahead = 0;
+        }
+    }
 
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> bcast_vector(A.nt());
@@ -50,11 +109,10 @@ void gemmC(
     uint8_t* bcast = bcast_vector.data();
     uint8_t* gemm  =  gemm_vector.data();
     uint8_t* c     =     c_vector.data();
-    SLATE_UNUSED( bcast ); // Used only by OpenMP
-    SLATE_UNUSED( gemm  ); // Used only by OpenMP
-    SLATE_UNUSED( c     ); // Used only by OpenMP
 
+    WorkspaceGuard<scalar_t> workspace_guard_C( C );
     if (target == Target::Devices) {
+        C.attachWorkspace( workspace );
         C.allocateBatchArrays();
         C.reserveDeviceWorkspace();
     }
@@ -65,54 +123,69 @@ void gemmC(
     #pragma omp parallel
     #pragma omp master
     {
+        internal::TaskRuntime rt;
         if (target == Target::Devices) {
             // fetch C matrix tiles into devices in parallel with first MPI broadcast
-            #pragma omp task depend(out:c[0])
+            rt.spawn( {}, { &c[0] }, 0, [=, &A, &B, &C]()
             {
                 trace::Block trace_block("fetch_C");
-                C.tileGetAllForWritingOnDevices(LayoutConvert(layout));
-            }
+                if (beta == zero) {
+                    // C is overwritten, so allocate it without copying.
+                    for (int64_t j = 0; j < C.nt(); ++j) {
+                        for (int64_t i = 0; i < C.mt(); ++i) {
+                            if (C.tileIsLocal( i, j )) {
+                                C.tileAcquireForOverwrite(
+                                    i, j, C.tileDevice( i, j ), layout );
+                            }
+                        }
+                    }
+                }
+                else {
+                    C.tileGetAllForWritingOnDevices(LayoutConvert(layout));
+                }
+            });
         }
 
         // send first block col of A and block row of B
-        #pragma omp task depend(out:bcast[0])
+        rt.spawn( {}, { &bcast[0] }, 0, [=, &A, &B, &C]()
         {
             // broadcast A(i, 0) to ranks owning block row C(i, :)
             BcastListTag bcast_list_A;
             for (int64_t i = 0; i < A.mt(); ++i)
                 bcast_list_A.push_back({i, 0, {C.sub(i, i, 0, C.nt()-1)}, i});
-            A.template listBcastMT<target>(bcast_list_A, layout);
+            A.template listBcastMT<target>(
+                bcast_list_A, layout, false, 4, hierarchical);
 
             // broadcast B(0, j) to ranks owning block col C(:, j)
             BcastListTag bcast_list_B;
             for (int64_t j = 0; j < B.nt(); ++j)
                 bcast_list_B.push_back({0, j, {C.sub(0, C.mt()-1, j, j)}, j});
-            B.template listBcastMT<target>(bcast_list_B, layout);
-        }
+            B.template listBcastMT<target>(
+                bcast_list_B, layout, false, 4, hierarchical);
+        });
 
         // send next lookahead block cols of A and block rows of B
         for (int64_t k = 1; k < lookahead+1 && k < A.nt(); ++k) {
-            #pragma omp task depend(in:bcast[k-1]) \
-                             depend(out:bcast[k])
+            rt.spawn( { &bcast[k-1] }, { &bcast[k] }, 0, [=, &A, &B, &C]()
             {
                 // broadcast A(i, k) to ranks owning block row C(i, :)
                 BcastListTag bcast_list_A;
                 for (int64_t i = 0; i < A.mt(); ++i)
                     bcast_list_A.push_back({i, k, {C.sub(i, i, 0, C.nt()-1)}, i});
-                A.template listBcastMT<target>(bcast_list_A, layout);
+                A.template listBcastMT<target>(
+                    bcast_list_A, layout, false, 4, hierarchical);
 
                 // broadcast B(k, j) to ranks owning block col C(:, j)
                 BcastListTag bcast_list_B;
                 for (int64_t j = 0; j < B.nt(); ++j)
                     bcast_list_B.push_back({k, j, {C.sub(0, C.mt()-1, j, j)}, j});
-                B.template listBcastMT<target>(bcast_list_B, layout);
-            }
+                B.template listBcastMT<target>(
+                    bcast_list_B, layout, false, 4, hierarchical);
+            });
         }
 
         // multiply alpha A(:, 0) B(0, :) + beta C
-        #pragma omp task depend(in:bcast[0]) \
-                         depend(in:c[0]) \
-                         depend(out:gemm[0])
+        rt.spawn( { &bcast[0], &c[0] }, { &gemm[0] }, 0, [=, &A, &B, &C]()
         {
             internal::gemm<target>(
                     alpha, A.sub(0, A.mt()-1, 0, 0),
@@ -130,15 +203,14 @@ void gemmC(
             // Erase local workspace on devices.
             A_colblock.releaseLocalWorkspace();
             B_rowblock.releaseLocalWorkspace();
-        }
+        });
 
         for (int64_t k = 1; k < A.nt(); ++k) {
 
             // send next block col of A and block row of B
             if (k+lookahead < A.nt()) {
-                #pragma omp task depend(in:gemm[k-1]) \
-                                 depend(in:bcast[k+lookahead-1]) \
-                                 depend(out:bcast[k+lookahead])
+                rt.spawn( { &gemm[k-1], &bcast[k+lookahead-1] },
+                          { &bcast[k+lookahead] }, 0, [=, &A, &B, &C]()
                 {
                     // broadcast A(i, k+la) to ranks owning block row C(i, :)
                     BcastListTag bcast_list_A;
@@ -146,7 +218,8 @@ void gemmC(
                         bcast_list_A.push_back(
                             {i, k+lookahead, {C.sub(i, i, 0, C.nt()-1)}, i});
                     }
-                    A.template listBcastMT<target>(bcast_list_A, layout);
+                    A.template listBcastMT<target>(
+                        bcast_list_A, layout, false, 4, hierarchical);
 
                     // broadcast B(k+la, j) to ranks owning block col C(:, j)
                     BcastListTag bcast_list_B;
@@ -154,23 +227,22 @@ void gemmC(
                         bcast_list_B.push_back(
                             {k+lookahead, j, {C.sub(0, C.mt()-1, j, j)}, j});
                     }
-                    B.template listBcastMT<target>(bcast_list_B, layout);
-                }
+                    B.template listBcastMT<target>(
+                        bcast_list_B, layout, false, 4, hierarchical);
+                });
             }
 
             // multiply alpha A(:, k) B(k, :) + C, no beta
-            #pragma omp task depend(in:bcast[k]) \
-                             depend(in:gemm[k-1]) \
-                             depend(out:gemm[k])
+            rt.spawn( { &bcast[k], &gemm[k-1] }, { &gemm[k] }, 0, [=, &A, &B, &C]()
             {
                 internal::gemm<target>(
                     alpha, A.sub(0, A.mt()-1, k, k),
                            B.sub(k, k, 0, B.nt()-1),
                     one,   std::move( C ),
                     layout );
-            }
+            });
 
-            #pragma omp task depend(in:gemm[k])
+            rt.spawn( { &gemm[k] }, {}, 0, [=, &A, &B, &C]()
             {
                 auto A_colblock = A.sub(0, A.mt()-1, k, k);
                 auto B_rowblock = B.sub(k, k, 0, B.nt()-1);
@@ -182,9 +254,9 @@ void gemmC(
                 // Erase local workspace on devices.
                 A_colblock.releaseLocalWorkspace();
                 B_rowblock.releaseLocalWorkspace();
-            }
+            });
         }
-        #pragma omp taskwait
+        rt.wait();
         C.tileUpdateAllOrigin();
     }
     C.releaseWorkspace();
@@ -231,12 +303,22 @@ void gemmC(
 ///         - Option::Lookahead:
 ///           Number of blocks to overlap communication and computation.
 ///           lookahead >= 0. Default 1.
+///         - Option::MaxWorkspace:
+///           Max bytes of remote tiles of A and B to hold at once per rank,
+///           estimated from the process grid; 0 for no limit [default].
+///           Lookahead is reduced to fit. If two panels don't fit, C is
+///           computed in blocks of rows, re-broadcasting B for each block.
 ///         - Option::Target:
 ///           Implementation to target. Possible values:
 ///           - HostTask:  OpenMP tasks on CPU host [default].
 ///           - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///           - HostBatch: batched BLAS on CPU host.
 ///           - Devices:   batched BLAS on GPU device.
+///         - Option::HierarchicalBcast:
+///           Whether to broadcast tiles between nodes first, then within
+///           nodes; see internal::hierarchicalBcastPattern. With a
+///           Workspace that has node-shared memory, each node receives
+///           a tile once; see Workspace::enableNodeShared. Default false.
 ///
 /// @ingroup gemm
 ///
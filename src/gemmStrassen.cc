@@ -0,0 +1,271 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Whether X splits at tile (hi, hj) into 4 quadrants with the same tile
+/// sizes and tile ranks, so quadrants can be added tile by tile.
+///
+template <typename scalar_t>
+bool strassen_conformal( Matrix<scalar_t>& X, int64_t hi, int64_t hj )
+{
+    if (hi < 1 || hj < 1 || X.mt() != 2*hi || X.nt() != 2*hj)
+        return false;
+
+    for (int64_t i = 0; i < hi; ++i) {
+        if (X.tileMb( i ) != X.tileMb( i + hi ))
+            return false;
+    }
+    for (int64_t j = 0; j < hj; ++j) {
+        if (X.tileNb( j ) != X.tileNb( j + hj ))
+            return false;
+    }
+    for (int64_t j = 0; j < hj; ++j) {
+        for (int64_t i = 0; i < hi; ++i) {
+            int rank = X.tileRank( i, j );
+            if (rank != X.tileRank( i + hi, j      )
+                || rank != X.tileRank( i,      j + hj )
+                || rank != X.tileRank( i + hi, j + hj ))
+                return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Strassen-Winograd recursion, down to at most `levels` levels;
+/// leaves call gemmC.
+/// @ingroup gemm_specialization
+///
+template <typename scalar_t>
+void gemmStrassen(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    int levels, Options const& opts)
+{
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+    // Smallest m, n, k to recurse on; below this the saved flops don't
+    // pay for the additions.
+    const int64_t min_dim = 16384;
+
+    int64_t hm = C.mt() / 2;
+    int64_t hn = C.nt() / 2;
+    int64_t hk = A.nt() / 2;
+    if (levels < 1
+        || std::min( { C.m(), C.n(), A.n() } ) < min_dim
+        || ! strassen_conformal( A, hm, hk )
+        || ! strassen_conformal( B, hk, hn )
+        || ! strassen_conformal( C, hm, hn )) {
+        gemmC( alpha, A, B, beta, C, opts );
+        return;
+    }
+
+    auto A11 = A.sub( 0,  hm-1,   0,  hk-1   );
+    auto A12 = A.sub( 0,  hm-1,   hk, 2*hk-1 );
+    auto A21 = A.sub( hm, 2*hm-1, 0,  hk-1   );
+    auto A22 = A.sub( hm, 2*hm-1, hk, 2*hk-1 );
+
+    auto B11 = B.sub( 0,  hk-1,   0,  hn-1   );
+    auto B12 = B.sub( 0,  hk-1,   hn, 2*hn-1 );
+    auto B21 = B.sub( hk, 2*hk-1, 0,  hn-1   );
+    auto B22 = B.sub( hk, 2*hk-1, hn, 2*hn-1 );
+
+    auto C11 = C.sub( 0,  hm-1,   0,  hn-1   );
+    auto C12 = C.sub( 0,  hm-1,   hn, 2*hn-1 );
+    auto C21 = C.sub( hm, 2*hm-1, 0,  hn-1   );
+    auto C22 = C.sub( hm, 2*hm-1, hn, 2*hn-1 );
+
+    // Workspace shaped like X11, with the same distribution.
+    auto like = [&]( Matrix<scalar_t>& X11 ) {
+        auto W = X11.template emptyLike<scalar_t>();
+        W.insertLocalTiles();
+        return W;
+    };
+
+    // Z = X + sign Y. Z is set first, since new tiles may hold NaN.
+    auto combine = [&]( Matrix<scalar_t>& X, scalar_t sign,
+                        Matrix<scalar_t>& Y, Matrix<scalar_t>& Z ) {
+        set( zero, Z, opts );
+        add( one,  X, one, Z, opts );
+        add( sign, Y, one, Z, opts );
+    };
+
+    // Y = X + beta Y. If beta = 0, Y is set first, since scaling by 0
+    // would keep NaN or Inf in Y.
+    auto add_scaled = [&]( Matrix<scalar_t>& X, Matrix<scalar_t>& Y ) {
+        if (beta == zero) {
+            set( zero, Y, opts );
+            add( one, X, one, Y, opts );
+        }
+        else {
+            add( one, X, beta, Y, opts );
+        }
+    };
+
+    // Winograd's form: 7 products, 15 additions.
+    auto S1 = like( A11 ), S2 = like( A11 ), S3 = like( A11 ), S4 = like( A11 );
+    auto T1 = like( B11 ), T2 = like( B11 ), T3 = like( B11 ), T4 = like( B11 );
+    combine( A21,  one, A22, S1 );  // S1 = A21 + A22
+    combine( S1,  -one, A11, S2 );  // S2 = S1  - A11
+    combine( A11, -one, A21, S3 );  // S3 = A11 - A21
+    combine( A12, -one, S2,  S4 );  // S4 = A12 - S2
+    combine( B12, -one, B11, T1 );  // T1 = B12 - B11
+    combine( B22, -one, T1,  T2 );  // T2 = B22 - T1
+    combine( B22, -one, B12, T3 );  // T3 = B22 - B12
+    combine( T2,  -one, B21, T4 );  // T4 = T2  - B21
+
+    // U accumulates alpha (M1 + M6 [+ M7]); P holds one product.
+    auto U = like( C11 ), P = like( C11 );
+
+    // U = alpha M1 = alpha A11 B11
+    gemmStrassen( alpha, A11, B11, zero, U, levels-1, opts );
+
+    // C11 = alpha (M1 + M2) + beta C11, M2 = A12 B21
+    gemmStrassen( alpha, A12, B21, beta, C11, levels-1, opts );
+    add( one, U, one, C11, opts );
+
+    // U = alpha (M1 + M6), M6 = S2 T2
+    gemmStrassen( alpha, S2, T2, zero, P, levels-1, opts );
+    add( one, P, one, U, opts );
+
+    // C12 = alpha (M1 + M6) + beta C12
+    add_scaled( U, C12 );
+
+    // U = alpha (M1 + M6 + M7), M7 = S3 T3
+    gemmStrassen( alpha, S3, T3, zero, P, levels-1, opts );
+    add( one, P, one, U, opts );
+
+    // C21, C22 = alpha (M1 + M6 + M7) + beta C21, C22
+    add_scaled( U, C21 );
+    add_scaled( U, C22 );
+
+    // C12, C22 += alpha M5, M5 = S1 T1
+    gemmStrassen( alpha, S1, T1, zero, P, levels-1, opts );
+    add( one, P, one, C12, opts );
+    add( one, P, one, C22, opts );
+
+    // C12 += alpha M3, M3 = S4 B22
+    gemmStrassen( alpha, S4, B22, one, C12, levels-1, opts );
+
+    // C21 -= alpha M4, M4 = A22 T4
+    gemmStrassen( -alpha, A22, T4, one, C21, levels-1, opts );
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel general matrix-matrix multiplication,
+/// Strassen-Winograd variant.
+/// Performs the matrix-matrix operation
+/// \[
+///     C = \alpha A B + \beta C,
+/// \]
+/// where alpha and beta are scalars, and $A$, $B$, and $C$ are matrices, with
+/// $A$ an m-by-k matrix, $B$ a k-by-n matrix, and $C$ an m-by-n matrix.
+///
+/// Up to 2 levels of Strassen-Winograd recursion are applied over the
+/// quadrants of A, B, and C, with gemmC at the leaves. Each level replaces
+/// 8 products by 7 at the cost of 15 matrix additions and workspace of
+/// 4 quadrants of A, 4 of B, and 2 of C, saving 12.5% of the flops for
+/// one level and 23% for two.
+///
+/// A level is applied only if m, n, and k are all at least 16384, and
+/// each of A, B, and C has an even number of block rows and columns,
+/// with quadrants of matching tile sizes and process distribution, e.g.,
+/// uniform tile sizes and half the block rows a multiple of p, half the
+/// block columns a multiple of q. Otherwise this calls gemmC.
+///
+/// Strassen's methods are not componentwise stable. The computed C
+/// satisfies the normwise bound (Higham, 2002, sec. 23.2.2)
+/// \[
+///     \| C - \hat{C} \| \le c_{\ell}\, u\, \|A\| \|B\| + O(u^2),
+///     \quad c_{\ell} \approx 18^{\ell} (n_0^2 + 6 n_0),
+/// \]
+/// for $\ell$ levels and leaf dimension $n_0$, versus $n$ for gemm. Errors
+/// in entries of C much smaller than $\|A\| \|B\|$ can be relatively large.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         The m-by-k matrix A.
+///
+/// @param[in] B
+///         The k-by-n matrix B.
+///
+/// @param[in] beta
+///         The scalar beta.
+///
+/// @param[in,out] C
+///         On entry, the m-by-n matrix C.
+///         On exit, overwritten by the result $\alpha A B + \beta C$.
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Lookahead:
+///           Number of blocks to overlap communication and computation
+///           in gemmC. lookahead >= 0. Default 1.
+///         - Option::Target:
+///           Implementation to target, as for gemmC.
+///
+/// @ingroup gemm
+///
+template <typename scalar_t>
+void gemmStrassen(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::gemmStrassen" );
+
+    const int max_levels = 2;
+    impl::gemmStrassen( alpha, A, B, beta, C, max_levels, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemmStrassen<float>(
+    float alpha, Matrix<float>& A,
+                 Matrix<float>& B,
+    float beta,  Matrix<float>& C,
+    Options const& opts);
+
+template
+void gemmStrassen<double>(
+    double alpha, Matrix<double>& A,
+                  Matrix<double>& B,
+    double beta,  Matrix<double>& C,
+    Options const& opts);
+
+template
+void gemmStrassen< std::complex<float> >(
+    std::complex<float> alpha, Matrix< std::complex<float> >& A,
+                               Matrix< std::complex<float> >& B,
+    std::complex<float> beta,  Matrix< std::complex<float> >& C,
+    Options const& opts);
+
+template
+void gemmStrassen< std::complex<double> >(
+    std::complex<double> alpha, Matrix< std::complex<double> >& A,
+                                Matrix< std::complex<double> >& B,
+    std::complex<double> beta,  Matrix< std::complex<double> >& C,
+    Options const& opts);
+
+} // namespace slate
@@ -8,6 +8,10 @@
 #include "slate/Matrix.hh"
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
+#include "internal/internal_priority.hh"
+#include "internal/internal_lookahead.hh"
+#include "slate/internal/TaskRuntime.hh"
+#include "slate/internal/Affinity.hh"
 
 namespace slate {
 
@@ -33,14 +37,18 @@ void geqrf(
     using blas::real;
 
     // Constants
-    const int priority_0 = 0;
-    const int priority_1 = 1;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // ttqrt is host only; ttmqr also has a device implementation.
+    constexpr Target target_tt = (target == Target::Devices
+                                  ? Target::Devices : Target::HostTask);
 
     // Options
     int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    int64_t max_lookahead = get_option<int64_t>( opts, Option::MaxLookahead,
+                                                 lookahead );
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+    Workspace* workspace = get_option<Workspace*>( opts, Option::Workspace, nullptr );
     int64_t max_panel_threads  = std::max(omp_get_max_threads()/2, 1);
     max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
                                              max_panel_threads );
@@ -58,6 +66,9 @@ void geqrf(
     // workspace
     auto W = A.emptyLike();
 
+    // Collective; lookahead depth per step.
+    internal::Lookahead depths( lookahead, max_lookahead, A.mpiComm() );
+
     // setting up dummy variables for case the when target == host
     int64_t num_devices  = A.num_devices();
     int     panel_device = -1;
@@ -65,9 +76,11 @@ void geqrf(
 
     std::vector< scalar_t* > dwork_array( num_devices, nullptr );
 
+    const int64_t batch_size_default = 0; // use default batch size
+    int num_queues = 3 + lookahead;
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
-        const int64_t batch_size_default = 0; // use default batch size
-        int num_queues = 3 + lookahead;
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays( batch_size_default, num_queues );
         A.reserveDeviceWorkspace();
         W.allocateBatchArrays( batch_size_default, num_queues );
@@ -120,7 +133,13 @@ void geqrf(
 
             for (int64_t dev = 0; dev < num_devices; ++dev) {
                 lapack::Queue* queue = A.comm_queue( dev );
-                dwork_array[dev] = blas::device_malloc<scalar_t>(work_size, *queue);
+                if (workspace != nullptr) {
+                    dwork_array[dev] = (scalar_t*) workspace->deviceBuffer(
+                                           dev, work_size * sizeof(scalar_t) );
+                }
+                else {
+                    dwork_array[dev] = blas::device_malloc<scalar_t>(work_size, *queue);
+                }
             }
         }
     }
@@ -129,14 +148,19 @@ void geqrf(
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector< uint8_t > block_vector(A_nt);
     uint8_t* block = block_vector.data();
-    SLATE_UNUSED( block ); // Used only by OpenMP
+    // Placeholder dependency for lookahead columns without an extra one.
+    uint8_t no_block;
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    // keep update tasks off the panel and communication cores
+    internal::ExcludeReservedCores exclude_reserved_cores;
+
     #pragma omp parallel
     #pragma omp master
     {
+        internal::TaskRuntime rt;
         for (int64_t k = 0; k < A_min_mtnt; ++k) {
             auto  A_panel =       A.sub(k, A_mt-1, k, k);
             auto Tl_panel =  Tlocal.sub(k, A_mt-1, k, k);
@@ -146,15 +170,40 @@ void geqrf(
                             = internal::geqrf_compute_first_indices(A_panel, k);
             // todo: pass first_indices into internal geqrf or ttqrt?
 
-            // panel, high priority
-            #pragma omp task depend(inout:block[k]) priority(1)
+            int64_t lookahead_k = depths.next( k );
+            if (target == Target::Devices && 3 + lookahead_k > num_queues) {
+                // Queues for the deeper lookahead; batch arrays can't be
+                // reallocated while tasks use them.
+                rt.wait();
+                num_queues = 3 + lookahead_k;
+                A.allocateBatchArrays( batch_size_default, num_queues );
+                W.allocateBatchArrays( batch_size_default, num_queues );
+            }
+
+            // Priorities of step k, see internal::task_priority: the panel
+            // QR and its triangle-triangle reduction, the lookahead
+            // columns, and the trailing columns, over min( mt, nt ) steps.
+            int priority_panel = internal::task_priority(
+                internal::TaskKind::Panel, k, A_min_mtnt );
+            int priority_lookahead = internal::task_priority(
+                internal::TaskKind::Lookahead, k, A_min_mtnt );
+            int priority_trailing = internal::task_priority(
+                internal::TaskKind::Trailing, k, A_min_mtnt );
+
+            // panel, highest priority
+            // Captured panels are private copies, moved into the routines.
+            rt.spawn( {}, { &block[k] }, priority_panel,
+                      [=, &A, &Tlocal, &Treduce, &W, &depths,
+                       &dwork_array]() mutable
             {
+                Timer t_panel;
+
                 // local panel factorization
                 internal::geqrf<target>(
                                 std::move(A_panel),
                                 std::move(Tl_panel),
                                 dwork_array, work_size,
-                                ib, max_panel_threads, priority_1 );
+                                ib, max_panel_threads, priority_panel );
 
                 // triangle-triangle reductions
                 // ttqrt handles tile transfers internally
@@ -191,18 +240,25 @@ void geqrf(
                             if (row > k) // exclude the first row of this panel that has no Treduce tile
                                 bcast_list_T.push_back({row, k, {Treduce.sub(row, row, k+1, A_nt-1)}});
                         }
-                        Treduce.template listBcast(bcast_list_T, layout);
+                        Treduce.template listBcast<target>( bcast_list_T, layout );
                     }
                 }
-            }
+
+                depths.panel_time( t_panel.stop() );
+            });
 
             // update lookahead column(s) on CPU, high priority
-            for (int64_t j = k+1; j < (k+1+lookahead) && j < A_nt; ++j) {
+            for (int64_t j = k+1; j < (k+1+lookahead_k) && j < A_nt; ++j) {
                 auto A_trail_j = A.sub(k, A_mt-1, j, j);
 
-                #pragma omp task depend(in:block[k]) \
-                                 depend(inout:block[j]) \
-                                 priority(1)
+                // A column joining the lookahead follows the trailing update.
+                uint8_t* trailing = depths.follows_trailing( k, j, A_nt )
+                                  ? &block[ A_nt-1 ] : &no_block;
+
+                rt.spawn( { &block[k], trailing }, { &block[j] },
+                          priority_lookahead,
+                          [=, &A, &Tlocal, &Treduce, &W, &depths,
+                           &dwork_array]() mutable
                 {
                     // Apply local reflectors
                     int queue_jk1 = j-k+1;
@@ -212,29 +268,33 @@ void geqrf(
                                     std::move(Tl_panel),
                                     std::move(A_trail_j),
                                     W.sub(k, A_mt-1, j, j),
-                                    priority_1, queue_jk1 );
+                                    priority_lookahead, queue_jk1 );
 
                     // Apply triangle-triangle reduction reflectors
                     // ttmqr handles the tile broadcasting internally
                     int tag_j = j;
-                    internal::ttmqr<Target::HostTask>(
+                    internal::ttmqr<target_tt>(
                                     Side::Left, Op::ConjTrans,
                                     std::move(A_panel),
                                     std::move(Tr_panel),
                                     std::move(A_trail_j),
                                     tag_j );
-                }
+                });
             }
 
-            // update trailing submatrix, normal priority
-            if (k+1+lookahead < A_nt) {
-                int64_t j = k+1+lookahead;
+            // update trailing submatrix, lower priority
+            if (k+1+lookahead_k < A_nt) {
+                int64_t j = k+1+lookahead_k;
                 auto A_trail_j = A.sub(k, A_mt-1, j, A_nt-1);
 
-                #pragma omp task depend(in:block[k]) \
-                                 depend(inout:block[k+1+lookahead]) \
-                                 depend(inout:block[A_nt-1])
+                rt.spawn( { &block[k] },
+                          { &block[k+1+lookahead_k], &block[A_nt-1] },
+                          priority_trailing,
+                          [=, &A, &Tlocal, &Treduce, &W, &depths,
+                           &dwork_array]() mutable
                 {
+                    Timer t_update;
+
                     // Apply local reflectors.
                     int queue_jk1 = j-k+1;
                     internal::unmqr<target>(
@@ -243,21 +303,25 @@ void geqrf(
                                     std::move(Tl_panel),
                                     std::move(A_trail_j),
                                     W.sub(k, A_mt-1, j, A_nt-1),
-                                    priority_0, queue_jk1 );
+                                    priority_trailing, queue_jk1 );
 
                     // Apply triangle-triangle reduction reflectors.
                     // ttmqr handles the tile broadcasting internally.
                     int tag_j = j;
-                    internal::ttmqr<Target::HostTask>(
+                    internal::ttmqr<target_tt>(
                                     Side::Left, Op::ConjTrans,
                                     std::move(A_panel),
                                     std::move(Tr_panel),
                                     std::move(A_trail_j),
                                     tag_j );
-                }
+
+                    depths.update_time( t_update.stop() );
+                });
             }
 
-            #pragma omp task depend(inout:block[k])
+            rt.spawn( {}, { &block[k] }, 0,
+                      [=, &A, &Tlocal, &Treduce, &W, &depths,
+                       &dwork_array]() mutable
             {
                 // Release the whole column, not just the panel
                 for (int64_t i = 0; i < A_mt; ++i) {
@@ -287,16 +351,16 @@ void geqrf(
                         Treduce.releaseRemoteWorkspaceTile( i, k );
                     }
                 }
-            }
+            });
         }
 
-        #pragma omp taskwait
+        rt.wait();
         A.tileUpdateAllOrigin();
     }
 
     A.releaseWorkspace();
 
-    if (target == Target::Devices) {
+    if (target == Target::Devices && workspace == nullptr) {
         for (int64_t dev = 0; dev < num_devices; ++dev) {
             blas::Queue* queue = A.comm_queue( dev );
             blas::device_free( dwork_array[dev], *queue );
@@ -338,10 +402,16 @@ void geqrf(
 ///     On exit, triangular matrices of the block reflectors.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
+///     Additional options, as map of name = value pairs.
+///     Lookahead, InnerBlocking, and MaxPanelThreads not given here
+///     default to the tuning file's values, if any; see tuned_options.
+///     Possible options:
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::MaxLookahead:
+///       If > lookahead, the lookahead adapts per panel, up to MaxLookahead,
+///       to the measured panel and trailing update times. Default lookahead.
 ///     - Option::InnerBlocking:
 ///       Inner blocking to use for panel. Default 16.
 ///     - Option::MaxPanelThreads:
@@ -361,24 +431,30 @@ void geqrf(
     TriangularFactors<scalar_t>& T,
     Options const& opts )
 {
+    internal::CommStatsScope comm_stats_scope( "geqrf", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "geqrf", A.mpiComm(), opts );
+
+    // Defaults for options not given, from the tuning file, if any.
+    Options tuned_opts = tuned_options( "geqrf", std::min( A.m(), A.n() ), opts );
+
     Target target = get_option( opts, Option::Target, Target::HostTask );
 
     switch (target) {
         case Target::Host:
         case Target::HostTask:
-            impl::geqrf<Target::HostTask>( A, T, opts );
+            impl::geqrf<Target::HostTask>( A, T, tuned_opts );
             break;
 
         case Target::HostNest:
-            impl::geqrf<Target::HostNest>( A, T, opts );
+            impl::geqrf<Target::HostNest>( A, T, tuned_opts );
             break;
 
         case Target::HostBatch:
-            impl::geqrf<Target::HostBatch>( A, T, opts );
+            impl::geqrf<Target::HostBatch>( A, T, tuned_opts );
             break;
 
         case Target::Devices:
-            impl::geqrf<Target::Devices>( A, T, opts );
+            impl::geqrf<Target::Devices>( A, T, tuned_opts );
             break;
     }
     // todo: return value for errors?
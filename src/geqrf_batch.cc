@@ -0,0 +1,181 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Creates the tasks of a right-looking tile QR factorization of a matrix
+/// whose tiles are all local. With a single rank per matrix, the local panel
+/// factorization is the whole panel, so there are no triangle-triangle
+/// reductions and no MPI. Tasks depend on column[ 0 : A.nt()-1 ], which are
+/// distinct for each matrix of the batch, so the factorizations of all
+/// matrices proceed concurrently.
+/// Called by the master thread.
+/// @ingroup geqrf_impl
+///
+template <typename scalar_t>
+void geqrf_batch_tasks(
+    Matrix<scalar_t> A, Matrix<scalar_t> Tlocal, Matrix<scalar_t> W,
+    int64_t ib, uint8_t* column )
+{
+    const int priority_0 = 0;
+    const int max_panel_threads = 1;
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t A_min_mtnt = std::min( A_mt, A_nt );
+    SLATE_UNUSED( column ); // Used only by OpenMP
+
+    for (int64_t k = 0; k < A_min_mtnt; ++k) {
+        auto  A_panel =      A.sub( k, A_mt-1, k, k );
+        auto Tl_panel = Tlocal.sub( k, A_mt-1, k, k );
+
+        // panel
+        #pragma omp task depend(inout:column[k]) \
+                         firstprivate( A_panel, Tl_panel, ib )
+        {
+            internal::geqrf<Target::HostTask>(
+                std::move( A_panel ), std::move( Tl_panel ),
+                ib, max_panel_threads, priority_0 );
+        }
+
+        // trailing columns; each one starts as soon as its own
+        // previous update is done, giving a wavefront across steps
+        for (int64_t j = k+1; j < A_nt; ++j) {
+            #pragma omp task depend(in:column[k]) \
+                             depend(inout:column[j]) \
+                             firstprivate( A, W, A_panel, Tl_panel, k, j )
+            {
+                internal::unmqr<Target::HostTask>(
+                    Side::Left, Op::ConjTrans,
+                    std::move( A_panel ),
+                    std::move( Tl_panel ),
+                    A.sub( k, A_mt-1, j, j ),
+                    W.sub( k, A_mt-1, j, j ),
+                    priority_0 );
+            }
+        }
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// QR factorization of a batch of independent general matrices.
+///
+/// Each matrix is factored as in geqrf, but all factorizations are
+/// scheduled in one OpenMP task graph, so the parallel region, option
+/// parsing, and workspace setup are paid once for the batch, and small
+/// matrices run concurrently rather than one after another.
+///
+/// Intended for many small matrices: the tiles of each matrix must all be
+/// local to the calling MPI rank, e.g., a matrix created on a 1-by-1
+/// process grid. The call is not collective; each rank factors its own
+/// batch. Computation is on the host.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A_array
+///     On entry, the m_i-by-n_i matrices $A_i$.
+///     On exit, $R_i$ and the reflectors of $Q_i$, as in geqrf.
+///
+/// @param[out] T_array
+///     Resized to A_array.size(). On exit, the triangular matrices of the
+///     block reflectors of each matrix, as in geqrf.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::InnerBlocking:
+///       Inner blocking to use for panel. Default 16.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void geqrf_batch(
+    std::vector< Matrix<scalar_t> >& A_array,
+    std::vector< TriangularFactors<scalar_t> >& T_array,
+    Options const& opts )
+{
+    // Options
+    int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+
+    int64_t batch_count = A_array.size();
+    T_array.resize( batch_count );
+
+    std::vector< Matrix<scalar_t> > W_array;
+    W_array.reserve( batch_count );
+    for (int64_t b = 0; b < batch_count; ++b) {
+        auto& A = A_array[ b ];
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                slate_error_if( ! A.tileIsLocal( i, j ) );
+            }
+        }
+        auto& T = T_array[ b ];
+        T.clear();
+        T.push_back( A.emptyLike() );
+        T.push_back( A.emptyLike( ib, 0 ) );
+        W_array.push_back( A.emptyLike() );
+    }
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< std::vector<uint8_t> > column_array( batch_count );
+    for (int64_t b = 0; b < batch_count; ++b)
+        column_array[ b ].resize( A_array[ b ].nt() );
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t b = 0; b < batch_count; ++b) {
+            impl::geqrf_batch_tasks( A_array[ b ], T_array[ b ][ 0 ],
+                                     W_array[ b ], ib,
+                                     column_array[ b ].data() );
+        }
+        #pragma omp taskwait
+    }
+
+    for (auto& A : A_array) {
+        A.tileUpdateAllOrigin();
+        A.releaseWorkspace();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geqrf_batch<float>(
+    std::vector< Matrix<float> >& A_array,
+    std::vector< TriangularFactors<float> >& T_array,
+    Options const& opts);
+
+template
+void geqrf_batch<double>(
+    std::vector< Matrix<double> >& A_array,
+    std::vector< TriangularFactors<double> >& T_array,
+    Options const& opts);
+
+template
+void geqrf_batch< std::complex<float> >(
+    std::vector< Matrix< std::complex<float> > >& A_array,
+    std::vector< TriangularFactors< std::complex<float> > >& T_array,
+    Options const& opts);
+
+template
+void geqrf_batch< std::complex<double> >(
+    std::vector< Matrix< std::complex<double> > >& A_array,
+    std::vector< TriangularFactors< std::complex<double> > >& T_array,
+    Options const& opts);
+
+} // namespace slate
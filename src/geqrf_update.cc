@@ -0,0 +1,161 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel QR update by appending rows,
+/// \[
+///     \begin{bmatrix} Q & 0 \\ 0 & I \end{bmatrix}^H
+///     \begin{bmatrix} A \\ W \end{bmatrix}
+///     = \begin{bmatrix} R \\ W \end{bmatrix}
+///     = \tilde{Q} \tilde{R},
+/// \]
+/// of the R factor from geqrf, for streaming least squares.
+/// Since $\tilde{R}^H \tilde{R} = R^H R + W^H W$, this is the Cholesky
+/// update of $R^H$ by $W^H$, done by potrf_update(): each row of W is
+/// eliminated by one Givens rotation per column of R, so appending k rows
+/// costs $O(n^2 k)$ flops, instead of $O(m n^2)$ to refactor.
+/// Q is not updated. For least squares, append the right-hand sides as
+/// extra columns of A and W, and take the solution from the trailing
+/// columns of $\tilde{R}$.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] R
+///     On entry, the n-by-n upper triangular factor R, e.g., the top
+///     n-by-n block of A after geqrf. R must be nonsingular.
+///     Only the upper triangle is referenced.
+///     On exit, the R factor of $[ A; W ]$.
+///
+/// @param[in,out] W
+///     The k-by-n rows to append, distributed with the same column tile
+///     sizes as R. On exit, W is destroyed.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. None are used.
+///
+/// @return 0: successful exit.
+/// @return i > 0: R(i, i) is exactly zero (1-based index).
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+int64_t geqrf_append(
+    Matrix<scalar_t>& R,
+    Matrix<scalar_t>& W,
+    Options const& opts)
+{
+    slate_assert( R.m() == R.n() );
+    slate_assert( W.n() == R.n() );
+
+    HermitianMatrix<scalar_t> A( Uplo::Upper, R );
+    auto WH = conj_transpose( W );
+    return potrf_update( A, WH, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel QR downdate by deleting rows,
+/// the inverse of geqrf_append(): given the R factor of $[ A; W ]$,
+/// computes the R factor of A, with
+/// $\tilde{R}^H \tilde{R} = R^H R - W^H W$.
+/// This is the Cholesky downdate of $R^H$ by $W^H$, done by
+/// potrf_downdate() with hyperbolic rotations, so deleting k rows costs
+/// $O(n^2 k)$ flops. Q is not needed. As for any downdate without Q,
+/// accuracy degrades when the deleted rows carry most of the weight of
+/// a column, i.e., when A is close to rank deficient.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] R
+///     On entry, the n-by-n upper triangular factor R of $[ A; W ]$.
+///     Only the upper triangle is referenced.
+///     On exit, the R factor of A.
+///
+/// @param[in,out] W
+///     The k-by-n rows to delete, distributed with the same column tile
+///     sizes as R. On exit, W is destroyed.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. None are used.
+///
+/// @return 0: successful exit.
+/// @return i > 0: A is rank deficient, found at column i (1-based index);
+///         R is not valid.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+int64_t geqrf_delete(
+    Matrix<scalar_t>& R,
+    Matrix<scalar_t>& W,
+    Options const& opts)
+{
+    slate_assert( R.m() == R.n() );
+    slate_assert( W.n() == R.n() );
+
+    HermitianMatrix<scalar_t> A( Uplo::Upper, R );
+    auto WH = conj_transpose( W );
+    return potrf_downdate( A, WH, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t geqrf_append<float>(
+    Matrix<float>& R,
+    Matrix<float>& W,
+    Options const& opts);
+
+template
+int64_t geqrf_append<double>(
+    Matrix<double>& R,
+    Matrix<double>& W,
+    Options const& opts);
+
+template
+int64_t geqrf_append< std::complex<float> >(
+    Matrix< std::complex<float> >& R,
+    Matrix< std::complex<float> >& W,
+    Options const& opts);
+
+template
+int64_t geqrf_append< std::complex<double> >(
+    Matrix< std::complex<double> >& R,
+    Matrix< std::complex<double> >& W,
+    Options const& opts);
+
+template
+int64_t geqrf_delete<float>(
+    Matrix<float>& R,
+    Matrix<float>& W,
+    Options const& opts);
+
+template
+int64_t geqrf_delete<double>(
+    Matrix<double>& R,
+    Matrix<double>& W,
+    Options const& opts);
+
+template
+int64_t geqrf_delete< std::complex<float> >(
+    Matrix< std::complex<float> >& R,
+    Matrix< std::complex<float> >& W,
+    Options const& opts);
+
+template
+int64_t geqrf_delete< std::complex<double> >(
+    Matrix< std::complex<double> >& R,
+    Matrix< std::complex<double> >& W,
+    Options const& opts);
+
+} // namespace slate
@@ -13,95 +13,18 @@ namespace slate {
 
 namespace internal {
 
-// Helper function to build a bcast list for U and V
-template<typename scalar_t>
-void gerbt_setup_bcast(Side side, Matrix<scalar_t> A, int64_t i1, int64_t i2,
+//------------------------------------------------------------------------------
+/// Builds the bcast list sending each row i of a packed transform to the
+/// ranks owning the leading tiles of the butterfly groups containing i,
+/// i.e., to dest( i % inner_len ).
+///
+template<typename scalar_t, typename dest_t>
+void gerbt_setup_bcast(int64_t n, int64_t d, int64_t inner_len, dest_t dest,
                        typename Matrix<scalar_t>::BcastListTag& bcast_list)
 {
-    int64_t n = i2-i1;
-    if (side == Side::Left) {
-        for (int64_t ii = 0; ii < n && ii < A.mt(); ++ii) {
-            int64_t tag = ii+i1;
-            bcast_list.push_back( {ii+i1, 0, {A.sub(ii, ii, 0, A.nt()-1)}, tag} );
-        }
-    }
-    else {
-        for (int64_t jj = 0; jj < n && jj < A.nt(); ++jj) {
-            int64_t tag = jj+i1;
-            bcast_list.push_back( {jj+i1, 0, {A.sub(0, A.mt()-1, jj, jj)}, tag} );
-        }
-    }
-}
-
-// Combine entries for the same source tile
-template<typename scalar_t>
-void gerbt_bcast_filter_duplicates(typename Matrix<scalar_t>::BcastListTag& bcast_list)
-{
-    for (auto outer = bcast_list.begin(); outer < bcast_list.end(); ++outer) {
-        // For each entry in the bcast list, check if there are any subsequent
-        // entries that have the same source tile
-        for (auto inner = outer+1; inner < bcast_list.end(); ) {
-            if (std::get<0>(*outer) == std::get<0>(*inner)
-                && std::get<1>(*outer) == std::get<1>(*inner)) {
-
-                // If so, add the destination tiles to the first entry
-                // and remove the subsequent entry
-                std::get<2>(*outer).splice(std::get<2>(*outer).begin(), std::get<2>(*inner));
-                inner = bcast_list.erase(inner);
-            }
-            else {
-                ++inner;
-            }
-        }
-    }
-}
-
-// Helper functions to iterate over the butterfly indices
-void gerbt_iterate_2d(int64_t d, int64_t inner_len, int64_t mt, int64_t nt,
-                      std::function<void(int64_t, int64_t, int64_t,
-                                      int64_t, int64_t, int64_t)> body)
-{
-    // 2-sided butterflies are applied smallest to largest
-    for (int64_t k = d-1; k >= 0; --k) {
-        const int64_t num_bt = 1 << k;
-        // bt_len = ceil(nt * 2^-d) * 2^d * 2^-k
-        // half_len = 1/2 * bt_len
-        const int64_t half_len = (1 << (d-k-1))*inner_len;
-
-        for (int64_t bi = 0; bi < num_bt; ++bi) {
-            const int64_t i1 = bi*2*half_len;
-            const int64_t i2 = std::min(i1+half_len, mt);
-            const int64_t i3 = std::min(i2+half_len, mt);
-            for (int64_t bj = 0; bj < num_bt; ++bj) {
-                const int64_t j1 = bj*2*half_len;
-                const int64_t j2 = std::min(j1+half_len, nt);
-                const int64_t j3 = std::min(j2+half_len, nt);
-
-                body(i1, i2, i3, j1, j2, j3);
-            }
-        }
-    }
-}
-void gerbt_iterate_1d(Op trans, int64_t d, int64_t inner_len, int64_t mt,
-                      std::function<void(int64_t, int64_t, int64_t)> body)
-{
-    for (int64_t k_iter = 0; k_iter < d; ++k_iter) {
-        // Regular butterflies are applied largest to smallest
-        // Transposed butterflies are applied smallest to largest
-        const int64_t k = (trans == Op::NoTrans) ? k_iter : d-k_iter-1;
-
-        const int64_t num_bt = 1 << k;
-        // bt_len = ceil(mt * 2^-d) * 2^d * 2^-k
-        // half_len = 1/2 * bt_len
-        const int64_t half_len = (1 << (d-k-1))*inner_len;
-
-        for (int64_t bi = 0; bi < num_bt; ++bi) {
-            const int64_t i1 = bi*2*half_len;
-            const int64_t i2 = std::min(i1+half_len, mt);
-            const int64_t i3 = std::min(i2+half_len, mt);
-
-            body(i1, i2, i3);
-        }
+    n = std::min( n, (int64_t(1) << d)*inner_len );
+    for (int64_t i = 0; i < n; ++i) {
+        bcast_list.push_back( {i, 0, {dest( i % inner_len )}, i} );
     }
 }
 
@@ -157,53 +80,22 @@ void gerbt(Matrix<scalar_t>& U_in,
     #pragma omp parallel
     #pragma omp master
     {
-        // Loop over the butterflies twice to reduce transfer of random factors
-
-        // Plan which random factors are needed where
+        // Send random factors to the butterfly groups that need them
+        const int64_t gmt = std::min( inner_len, mt );
+        const int64_t gnt = std::min( inner_len, nt );
         BcastListTag bcast_list_U, bcast_list_V;
-        internal::gerbt_iterate_2d(d, inner_len, mt, nt,
-                [&](int64_t i1, int64_t i2, int64_t i3,
-                    int64_t j1, int64_t j2, int64_t j3) {
-
-                    auto A11 = A.sub(i1, i2-1, j1, j2-1);
-                    internal::gerbt_setup_bcast( Side::Left, A11, i1, i2, bcast_list_U );
-                    internal::gerbt_setup_bcast( Side::Right, A11, j1, j2, bcast_list_V );
-
-                    if (i2 < i3) {
-                        internal::gerbt_setup_bcast( Side::Left, A11, i2, i3, bcast_list_U );
-                    }
-                    if (j2 < j3) {
-                        internal::gerbt_setup_bcast( Side::Right, A11, j2, j3, bcast_list_V );
-                    }
-                });
-
-        // Bcast random factors
-        internal::gerbt_bcast_filter_duplicates<scalar_t>(bcast_list_U);
-        internal::gerbt_bcast_filter_duplicates<scalar_t>(bcast_list_V);
+        internal::gerbt_setup_bcast<scalar_t>( mt, d, inner_len,
+                [&](int64_t gi) { return A.sub( gi, gi, 0, gnt-1 ); },
+                bcast_list_U );
+        internal::gerbt_setup_bcast<scalar_t>( nt, d, inner_len,
+                [&](int64_t gj) { return A.sub( 0, gmt-1, gj, gj ); },
+                bcast_list_V );
 
         U.template listBcastMT(bcast_list_U, Layout::ColMajor);
         V.template listBcastMT(bcast_list_V, Layout::ColMajor);
 
-        // NB: only tasks created so far are in listBcastMT
-
-        // Do computation
-        internal::gerbt_iterate_2d(d, inner_len, mt, nt,
-                [&](int64_t i1, int64_t i2, int64_t i3,
-                    int64_t j1, int64_t j2, int64_t j3) {
-
-                    auto A11 = A.sub(i1, i2-1, j1, j2-1);
-                    auto A12 = A.sub(i1, i2-1, j2, j3-1);
-                    auto A21 = A.sub(i2, i3-1, j1, j2-1);
-                    auto A22 = A.sub(i2, i3-1, j2, j3-1);
-
-                    auto U1 = U.sub(i1, i2-1, 0, 0);
-                    auto U2 = U.sub(i2, i3-1, 0, 0);
-                    auto V1 = V.sub(j1, j2-1, 0, 0);
-                    auto V2 = V.sub(j2, j3-1, 0, 0);
-
-                    internal::gerbt( A11, A12, A21, A22, U1, U2, V1, V2 );
-                    // NB internal::gerbt ends with taskwait
-            });
+        // Apply all levels in one pass over the butterfly groups
+        internal::gerbt( inner_len, A, U, V );
 
         #pragma omp taskwait
         U.releaseRemoteWorkspace();
@@ -280,38 +172,16 @@ void gerbt(Matrix<scalar_t>& Uin,
     #pragma omp parallel
     #pragma omp master
     {
-        // Loop over the butterflies twice to reduce transfer of random factors
-
-        // Plan which random factors are needed where
+        // Send random factors to the butterfly groups that need them
         BcastListTag bcast_list;
-        internal::gerbt_iterate_1d(trans, d, inner_len, mt,
-                [&](int64_t i1, int64_t i2, int64_t i3) {
-
-                    if (i2 < i3) {
-                        auto B1 = B.sub(i1, i2-1, 0, nt-1);
-
-                        internal::gerbt_setup_bcast( Side::Left, B1, i1, i2, bcast_list );
-                        internal::gerbt_setup_bcast( Side::Left, B1, i2, i3, bcast_list );
-                    }
-                });
+        internal::gerbt_setup_bcast<scalar_t>( mt, d, inner_len,
+                [&](int64_t gi) { return B.sub( gi, gi, 0, nt-1 ); },
+                bcast_list );
 
-        // Bcast random factors
-        internal::gerbt_bcast_filter_duplicates<scalar_t>(bcast_list);
         U.template listBcastMT(bcast_list, Layout::ColMajor);
 
-        // NB: only tasks created so far are in listBcastMT
-
-        internal::gerbt_iterate_1d(trans, d, inner_len, mt,
-                [&](int64_t i1, int64_t i2, int64_t i3) {
-                    auto B1 = B.sub(i1, i2-1, 0, nt-1);
-                    auto B2 = B.sub(i2, i3-1, 0, nt-1);
-
-                    auto U1 = U.sub(i1, i2-1, 0, 0);
-                    auto U2 = U.sub(i2, i3-1, 0, 0);
-
-                    internal::gerbt( Side::Left, trans, B1, B2, U1, U2 );
-                    // NB internal::gerbt ends with taskwait
-                });
+        // Apply all levels in one pass over the butterfly groups
+        internal::gerbt( trans, inner_len, B, U );
 
         #pragma omp taskwait
         U.releaseRemoteWorkspace();
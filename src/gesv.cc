@@ -88,6 +88,9 @@ int64_t gesv(
     Matrix<scalar_t>& B,
     Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "gesv", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "gesv", A.mpiComm(), opts );
+
     Timer t_gesv;
 
     slate_assert(A.mt() == A.nt());  // square
@@ -96,16 +99,16 @@ int64_t gesv(
     // factorization
     Timer t_getrf;
     int64_t info = getrf(A, pivots, opts);
-    timers[ "gesv::getrf" ] = t_getrf.stop();
+    internal::timers_set( opts, "gesv::getrf", t_getrf.stop() );
 
     // solve
     Timer t_getrs;
     if (info == 0) {
         getrs( A, pivots, B, opts );
     }
-    timers[ "gesv::getrs" ] = t_getrs.stop();
+    internal::timers_set( opts, "gesv::getrs", t_getrs.stop() );
 
-    timers[ "gesv" ] = t_gesv.stop();
+    internal::timers_set( opts, "gesv", t_gesv.stop() );
     return info;
 }
 
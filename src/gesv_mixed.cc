@@ -12,6 +12,128 @@
 
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Iterative refinement for gesv_mixed and gesv_mixed_solve, given the
+/// low precision LU factors A_lo of A.
+/// Sets iter to the number of iterations on convergence.
+///
+/// @param[in] cte
+///     Stopping criterion, $\norm{A}_{inf}$ times the tolerance.
+///
+/// @return true if refinement converged within itermax iterations.
+///
+/// @ingroup gesv_impl
+///
+template <typename scalar_hi, typename scalar_lo>
+bool gesv_mixed_refine(
+    Matrix<scalar_hi>& A,
+    Matrix<scalar_lo>& A_lo, Pivots& pivots,
+    blas::real_type<scalar_hi> cte,
+    Matrix<scalar_hi>& B,
+    Matrix<scalar_hi>& X,
+    int& iter,
+    Options const& opts)
+{
+    using real_hi = blas::real_type<scalar_hi>;
+
+    // Constants
+    const scalar_hi one_hi = 1.0;
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+
+    // With Option::MixedLowMemory, A is on the host, so products with it are.
+    Options opts_hi = opts;
+    if (get_option<Option::MixedLowMemory>( opts, false ))
+        opts_hi[ Option::Target ] = Target::HostTask;
+
+    bool converged = false;
+
+    // workspace
+    auto R    = B.emptyLike();
+    auto X_lo = X.template emptyLike<scalar_lo>();
+
+    std::vector<real_hi> colnorms_X( X.n() );
+    std::vector<real_hi> colnorms_R( R.n() );
+
+    // insert local tiles
+    X_lo.insertLocalTilesLazy( target );
+    R.   insertLocalTiles( target );
+
+    // Convert B from high to low precision, store result in X_lo.
+    copy( B, X_lo, opts );
+
+    // Solve the system A_lo * X_lo = B_lo.
+    Timer t_getrs_lo;
+    getrs( A_lo, pivots, X_lo, opts );
+    internal::timers_set( opts, "gesv_mixed::getrs_lo", t_getrs_lo.stop() );
+
+    // Convert X_lo to high precision, with the column norms of X.
+    internal::copy_colNorms( X_lo, X, colnorms_X.data(), opts );
+
+    // Compute R = B - A * X.
+    slate::copy( B, R, opts );
+    Timer t_gemm_hi;
+    gemm<scalar_hi>(
+        -one_hi, A,
+                 X,
+        one_hi,  R, opts_hi );
+    internal::timers_set( opts, "gesv_mixed::gemm_hi", t_gemm_hi.stop() );
+
+    // Convert R from high to low precision, store result in X_lo,
+    // with the column norms of R.
+    // Check whether the nrhs normwise backward error satisfies the
+    // stopping criterion. If yes, set iter=0 and return.
+    internal::copy_colNorms( R, X_lo, colnorms_R.data(), opts );
+
+    if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
+        iter = 0;
+        converged = true;
+    }
+
+    internal::timers_reset( opts, "gesv_mixed::add_hi" );
+    // iterative refinement
+    for (int iiter = 0; iiter < itermax && ! converged; ++iiter) {
+        // Solve the system A_lo * X_lo = R_lo.
+        t_getrs_lo.start();
+        getrs( A_lo, pivots, X_lo, opts );
+        internal::timers_add( opts, "gesv_mixed::getrs_lo", t_getrs_lo.stop() );
+
+        // Convert X_lo back to double precision and update the current
+        // iterate, X += X_lo, with the column norms of X.
+        Timer t_add_hi;
+        internal::add_colNorms( X_lo, X, colnorms_X.data(), opts );
+        internal::timers_add( opts, "gesv_mixed::add_hi", t_add_hi.stop() );
+
+        // Compute R = B - A * X.
+        slate::copy( B, R, opts );
+        t_gemm_hi.start();
+        gemm<scalar_hi>(
+            -one_hi, A,
+                     X,
+            one_hi,  R, opts_hi );
+        internal::timers_add( opts, "gesv_mixed::gemm_hi", t_gemm_hi.stop() );
+
+        // Convert R from high to low precision, store result in X_lo,
+        // with the column norms of R.
+        // Check whether nrhs normwise backward error satisfies the
+        // stopping criterion. If yes, set iter = iiter > 0 and return.
+        internal::copy_colNorms( R, X_lo, colnorms_R.data(), opts );
+
+        if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
+            iter = iiter+1;
+            converged = true;
+        }
+    }
+
+    return converged;
+}
+
+} // namespace impl
+
 //------------------------------------------------------------------------------
 /// Distributed parallel iterative-refinement LU factorization and solve.
 ///
@@ -95,6 +217,17 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to convergene, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::MathMode:
+///       Math mode of the low precision factorization on devices.
+///       MathMode::TF32 runs its single precision gemm updates on tensor
+///       cores; refinement recovers the accuracy. Default MathMode::Default
+///     - Option::MixedLowMemory:
+///       If true, with Target::Devices, the high precision A is not copied
+///       to the devices: it is converted to low precision on the host,
+///       and the residuals are computed on the host, so device memory
+///       holds only the low precision factors, half the size of A,
+///       instead of both. The fallback solver, if used, still factors A on
+///       the devices. Default false
 ///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
@@ -119,13 +252,22 @@ int64_t gesv_mixed(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
     const real_hi eps = std::numeric_limits<real_hi>::epsilon();
-    const scalar_hi one_hi = 1.0;
 
     // Options
     Target target = get_option( opts, Option::Target, Target::HostTask );
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    MathMode math_mode = get_option<Option::MathMode>( opts, MathMode::Default );
+
+    // With Option::MixedLowMemory, A stays on the host: its norm,
+    // conversion, and residual products run there, and only the low
+    // precision factors go to the devices.
+    bool low_memory = target == Target::Devices
+                      && get_option<Option::MixedLowMemory>( opts, false );
+    Options opts_host = opts;
+    if (low_memory)
+        opts_host[ Option::Target ] = Target::HostTask;
 
     bool converged = false;
     iter = 0;
@@ -133,19 +275,16 @@ int64_t gesv_mixed(
     assert( B.mt() == A.mt() );
 
     // workspace
-    auto R    = B.emptyLike();
+    // In low memory mode, A_lo has host tiles, moved to the devices by getrf.
     auto A_lo = A.template emptyLike<scalar_lo>();
-    auto X_lo = X.template emptyLike<scalar_lo>();
-
-    std::vector<real_hi> colnorms_X( X.n() );
-    std::vector<real_hi> colnorms_R( R.n() );
-
-    // insert local tiles
-    X_lo.insertLocalTiles( target );
-    R.   insertLocalTiles( target );
-    A_lo.insertLocalTiles( target );
+    A_lo.insertLocalTilesLazy( low_memory ? Target::Host : target );
 
     if (target == Target::Devices) {
+        // Low precision factorization may use reduced precision math.
+        A_lo.setMathMode( math_mode );
+    }
+
+    if (target == Target::Devices && ! low_memory) {
         #pragma omp parallel
         #pragma omp master
         {
@@ -168,90 +307,21 @@ int64_t gesv_mixed(
     }
 
     // norm of A
-    real_hi Anorm = norm( Norm::Inf, A, opts );
-
-    // stopping criteria
-    real_hi cte = Anorm * tol;
-
-    // Convert B from high to low precision, store result in X_lo.
-    copy( B, X_lo, opts );
+    real_hi Anorm = norm( Norm::Inf, A, opts_host );
 
     // Convert A from high to low precision, store result in A_lo.
-    copy( A, A_lo, opts );
+    copy( A, A_lo, opts_host );
 
     // Compute the LU factorization of A_lo.
     Timer t_getrf_lo;
     int64_t info = getrf( A_lo, pivots, opts );
-    timers[ "gesv_mixed::getrf_lo" ] = t_getrf_lo.stop();
+    internal::timers_set( opts, "gesv_mixed::getrf_lo", t_getrf_lo.stop() );
     if (info != 0) {
         iter = -3;
     }
     else {
-        // Solve the system A_lo * X_lo = B_lo.
-        Timer t_getrs_lo;
-        getrs( A_lo, pivots, X_lo, opts );
-        timers[ "gesv_mixed::getrs_lo" ] = t_getrs_lo.stop();
-
-        // Convert X_lo to high precision.
-        copy( X_lo, X, opts );
-
-        // Compute R = B - A * X.
-        slate::copy( B, R, opts );
-        Timer t_gemm_hi;
-        gemm<scalar_hi>(
-            -one_hi, A,
-                     X,
-            one_hi,  R, opts );
-        timers[ "gesv_mixed::gemm_hi" ] = t_gemm_hi.stop();
-
-        // Check whether the nrhs normwise backward error satisfies the
-        // stopping criterion. If yes, set iter=0 and return.
-        colNorms( Norm::Max, X, colnorms_X.data(), opts );
-        colNorms( Norm::Max, R, colnorms_R.data(), opts );
-
-        if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
-            iter = 0;
-            converged = true;
-        }
-
-        timers[ "gesv_mixed::add_hi" ] = 0;
-        // iterative refinement
-        for (int iiter = 0; iiter < itermax && ! converged; ++iiter) {
-            // Convert R from high to low precision, store result in X_lo.
-            copy( R, X_lo, opts );
-
-            // Solve the system A_lo * X_lo = R_lo.
-            t_getrs_lo.start();
-            getrs( A_lo, pivots, X_lo, opts );
-            timers[ "gesv_mixed::getrs_lo" ] += t_getrs_lo.stop();
-
-            // Convert X_lo back to double precision and update the current iterate.
-            copy( X_lo, R, opts );
-            Timer t_add_hi;
-            add<scalar_hi>(
-                  one_hi, R,
-                  one_hi, X, opts );
-            timers[ "gesv_mixed::add_hi" ] += t_add_hi.stop();
-
-            // Compute R = B - A * X.
-            slate::copy( B, R, opts );
-            t_gemm_hi.start();
-            gemm<scalar_hi>(
-                -one_hi, A,
-                         X,
-                one_hi,  R, opts );
-            timers[ "gesv_mixed::gemm_hi" ] += t_gemm_hi.stop();
-
-            // Check whether nrhs normwise backward error satisfies the
-            // stopping criterion. If yes, set iter = iiter > 0 and return.
-            colNorms( Norm::Max, X, colnorms_X.data(), opts );
-            colNorms( Norm::Max, R, colnorms_R.data(), opts );
-
-            if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
-                iter = iiter+1;
-                converged = true;
-            }
-        }
+        converged = impl::gesv_mixed_refine(
+            A, A_lo, pivots, Anorm * tol, B, X, iter, opts );
     }
 
     if (! converged) {
@@ -266,7 +336,8 @@ int64_t gesv_mixed(
             // Compute the LU factorization of A.
             Timer t_getrf_hi;
             info = getrf( A, pivots, opts );
-            timers[ "gesv_mixed::getrf_hi" ] = t_getrf_hi.stop();
+            internal::timers_set( opts, "gesv_mixed::getrf_hi",
+                                  t_getrf_hi.stop() );
 
             // Solve the system A * X = B.
             Timer t_getrs_hi;
@@ -274,17 +345,256 @@ int64_t gesv_mixed(
                 slate::copy( B, X, opts );
                 getrs( A, pivots, X, opts );
             }
-            timers[ "gesv_mixed::getrs_hi" ] = t_getrs_hi.stop();
+            internal::timers_set( opts, "gesv_mixed::getrs_hi",
+                                  t_getrs_hi.stop() );
         }
     }
 
+    if (target == Target::Devices && ! low_memory) {
+        // clear instead of release due to previous hold
+        A.clearWorkspace();
+        B.clearWorkspace();
+        X.clearWorkspace();
+    }
+    internal::timers_set( opts, "gesv_mixed", t_gesv_mixed.stop() );
+
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel low precision LU factorization of A, for repeated
+/// mixed precision solves with gesv_mixed_solve or gesv_mixed_gmres_solve.
+///
+/// Does the part of gesv_mixed that depends only on A: converts A to low
+/// precision, factors it with getrf, and computes $\norm{A}_{inf}$,
+/// storing all three in F. A is not modified.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n matrix $A$.
+///
+/// @param[out] F
+///     On exit, the low precision factorization of $A$.
+///     Previous contents, including any bases or high precision factors,
+///     are discarded.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of panels to overlap with matrix updates.
+///       lookahead >= 0. Default 1.
+///     - Option::Target:
+///       Implementation to target. See gesv_mixed.
+///     - Option::MathMode:
+///       Math mode of the low precision factorization on devices.
+///       Default MathMode::Default
+///     - Option::MixedLowMemory:
+///       Keep A on the host and convert it there. See gesv_mixed.
+///
+/// @return 0: successful exit
+/// @return i > 0: $U(i,i)$ of the low precision factors is exactly zero,
+///         where $i$ is a 1-based index. Solves then fall back to high
+///         precision, if allowed.
+///
+/// @ingroup gesv
+///
+template <typename scalar_hi, typename scalar_lo>
+int64_t gesv_mixed_factor(
+    Matrix<scalar_hi>& A,
+    MixedFactorization<scalar_hi, scalar_lo>& F,
+    Options const& opts)
+{
+    Timer t_gesv_mixed_factor;
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    MathMode math_mode = get_option<Option::MathMode>( opts, MathMode::Default );
+
+    // As in gesv_mixed, A stays on the host with Option::MixedLowMemory.
+    bool low_memory = target == Target::Devices
+                      && get_option<Option::MixedLowMemory>( opts, false );
+    Options opts_host = opts;
+    if (low_memory)
+        opts_host[ Option::Target ] = Target::HostTask;
+
+    F = MixedFactorization<scalar_hi, scalar_lo>();
+
+    F.A_lo = A.template emptyLike<scalar_lo>();
+    F.A_lo.insertLocalTilesLazy( low_memory ? Target::Host : target );
     if (target == Target::Devices) {
+        // Low precision factorization may use reduced precision math.
+        F.A_lo.setMathMode( math_mode );
+    }
+
+    // norm of A
+    F.Anorm = norm( Norm::Inf, A, opts_host );
+
+    // Convert A from high to low precision, store result in A_lo.
+    copy( A, F.A_lo, opts_host );
+
+    // Compute the LU factorization of A_lo.
+    Timer t_getrf_lo;
+    F.info = getrf( F.A_lo, F.pivots, opts );
+    internal::timers_set( opts, "gesv_mixed_factor::getrf_lo",
+                          t_getrf_lo.stop() );
+
+    internal::timers_set( opts, "gesv_mixed_factor",
+                          t_gesv_mixed_factor.stop() );
+    return F.info;
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel iterative-refinement solve, using the low precision
+/// LU factorization F of A from gesv_mixed_factor.
+///
+/// Solves $A X = B$ as gesv_mixed does, but without converting and
+/// factoring A: each call runs only the low precision solves, getrs with
+/// F.A_lo, and the high precision residuals with A.
+///
+/// If refinement fails and Option::UseFallbackSolver is true, a copy of A
+/// is factored in high precision and kept in F, so A is not modified, and
+/// later solves with F use the high precision factors directly.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n matrix $A$, unchanged since gesv_mixed_factor.
+///
+/// @param[in,out] F
+///     The factorization of $A$ from gesv_mixed_factor.
+///     On exit, may hold the high precision factors of $A$, see above.
+///
+/// @param[in] B
+///     On entry, the n-by-nrhs right hand side matrix $B$.
+///
+/// @param[out] X
+///     On exit, if return value = 0, the n-by-nrhs solution matrix $X$.
+///
+/// @param[out] iter
+///     The number of refinement iterations, as for gesv_mixed.
+///     < 0 if the solution is from the high precision factors.
+///
+/// @param[in] opts
+///     Additional options, as for gesv_mixed.
+///
+/// @return 0: successful exit
+/// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index,
+///         so the solution could not be computed.
+///
+/// @ingroup gesv
+///
+template <typename scalar_hi, typename scalar_lo>
+int64_t gesv_mixed_solve(
+    Matrix<scalar_hi>& A,
+    MixedFactorization<scalar_hi, scalar_lo>& F,
+    Matrix<scalar_hi>& B,
+    Matrix<scalar_hi>& X,
+    int& iter,
+    Options const& opts)
+{
+    using real_hi = blas::real_type<scalar_hi>;
+
+    Timer t_gesv_mixed_solve;
+
+    // Constants
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+    const real_hi eps = std::numeric_limits<real_hi>::epsilon();
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+    double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
+    bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    bool low_memory = target == Target::Devices
+                      && get_option<Option::MixedLowMemory>( opts, false );
+
+    bool converged = false;
+    iter = 0;
+
+    assert( B.mt() == A.mt() );
+    assert( F.A_lo.mt() == A.mt() );
+
+    if (target == Target::Devices && ! low_memory) {
+        #pragma omp parallel
+        #pragma omp master
+        {
+            #pragma omp task slate_omp_default_none \
+                shared( A ) firstprivate( layout )
+            {
+                A.tileGetAndHoldAllOnDevices( LayoutConvert( layout ) );
+            }
+            #pragma omp task slate_omp_default_none \
+                shared( B ) firstprivate( layout )
+            {
+                B.tileGetAndHoldAllOnDevices( LayoutConvert( layout ) );
+            }
+            #pragma omp task slate_omp_default_none \
+                shared( X ) firstprivate( layout )
+            {
+                X.tileGetAndHoldAllOnDevices( LayoutConvert( layout ) );
+            }
+        }
+    }
+
+    int64_t info = F.info;
+    if (info != 0) {
+        iter = -3;
+    }
+    else if (F.factored_hi) {
+        // Refinement already failed with these factors.
+        iter = -itermax - 1;
+    }
+    else {
+        converged = impl::gesv_mixed_refine(
+            A, F.A_lo, F.pivots, F.Anorm * tol, B, X, iter, opts );
+        if (! converged)
+            iter = -itermax - 1;
+    }
+
+    if (! converged && (use_fallback || F.factored_hi)) {
+        // Fall back to double precision factor and solve,
+        // factoring a copy of A the first time.
+        if (! F.factored_hi) {
+            Timer t_getrf_hi;
+            F.A_hi = A.emptyLike();
+            F.A_hi.insertLocalTiles( target );
+            slate::copy( A, F.A_hi, opts );
+            F.info_hi = getrf( F.A_hi, F.pivots_hi, opts );
+            F.factored_hi = true;
+            internal::timers_set( opts, "gesv_mixed_solve::getrf_hi",
+                                  t_getrf_hi.stop() );
+        }
+        info = F.info_hi;
+
+        // Solve the system A * X = B.
+        Timer t_getrs_hi;
+        if (info == 0) {
+            slate::copy( B, X, opts );
+            getrs( F.A_hi, F.pivots_hi, X, opts );
+        }
+        internal::timers_set( opts, "gesv_mixed_solve::getrs_hi",
+                              t_getrs_hi.stop() );
+    }
+
+    if (target == Target::Devices && ! low_memory) {
         // clear instead of release due to previous hold
         A.clearWorkspace();
         B.clearWorkspace();
         X.clearWorkspace();
     }
-    timers[ "gesv_mixed" ] = t_gesv_mixed.stop();
+    internal::timers_set( opts, "gesv_mixed_solve", t_gesv_mixed_solve.stop() );
 
     return info;
 }
@@ -314,4 +624,34 @@ int64_t gesv_mixed< std::complex<double> >(
         A, pivots, B, X, iter, opts );
 }
 
+template
+int64_t gesv_mixed_factor<double, float>(
+    Matrix<double>& A,
+    MixedFactorization<double, float>& F,
+    Options const& opts);
+
+template
+int64_t gesv_mixed_factor< std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >& A,
+    MixedFactorization< std::complex<double>, std::complex<float> >& F,
+    Options const& opts);
+
+template
+int64_t gesv_mixed_solve<double, float>(
+    Matrix<double>& A,
+    MixedFactorization<double, float>& F,
+    Matrix<double>& B,
+    Matrix<double>& X,
+    int& iter,
+    Options const& opts);
+
+template
+int64_t gesv_mixed_solve< std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >& A,
+    MixedFactorization< std::complex<double>, std::complex<float> >& F,
+    Matrix< std::complex<double> >& B,
+    Matrix< std::complex<double> >& X,
+    int& iter,
+    Options const& opts);
+
 } // namespace slate
@@ -12,6 +12,435 @@
 
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// GMRES-based iterative refinement for gesv_mixed_gmres and
+/// gesv_mixed_gmres_solve, given the low precision LU factors A_lo of A,
+/// used as preconditioner.
+/// Sets iter to the number of iterations on convergence.
+///
+/// Each right-hand side runs its own GMRES, but the nrhs Arnoldi processes
+/// are done together: the j-th vectors of all right-hand sides form block
+/// j of the bases, so the preconditioner solve and the product with A are
+/// one getrs and one gemm over nrhs columns. The CGS2 orthogonalization
+/// computes the inner products of the whole new block with all previous
+/// blocks in one gemm, then keeps only those of each right-hand side with
+/// its own basis, so the projection is a gemm with a block diagonal matrix.
+/// Right-hand sides that converge drop out, with their columns zeroed.
+///
+/// To reduce synchronization, the second CGS2 pass also computes the Gram
+/// matrix of the new block, from which the root gets its norms, and the
+/// norms and Arnoldi residuals are broadcast together, so each step has
+/// two reductions and one broadcast, instead of three reductions and two
+/// broadcasts. If cancellation makes the fused norms inaccurate, they are
+/// recomputed explicitly.
+///
+/// @param[in,out] V
+///     Test basis workspace, n-by-((restart+1) nrhs),
+///     from internal::alloc_basis.
+///
+/// @param[in,out] W
+///     Solution basis workspace, n-by-((restart+1) nrhs).
+///
+/// @param[in] cte
+///     Stopping criterion, $\norm{A}_{inf}$ times the tolerance.
+///
+/// @return true if refinement converged within itermax iterations.
+///
+/// @ingroup gesv_impl
+///
+template <typename scalar_hi, typename scalar_lo>
+bool gesv_mixed_gmres_refine(
+    Matrix<scalar_hi>& A,
+    Matrix<scalar_lo>& A_lo, Pivots& pivots,
+    Matrix<scalar_hi>& V,
+    Matrix<scalar_hi>& W,
+    blas::real_type<scalar_hi> cte,
+    Matrix<scalar_hi>& B,
+    Matrix<scalar_hi>& X,
+    int& iter,
+    Options const& opts)
+{
+    using real_hi = blas::real_type<scalar_hi>;
+
+    // Constants
+    const int64_t mpi_rank = A.mpiRank();
+    const scalar_hi zero = 0.0;
+    const scalar_hi one  = 1.0;
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+
+    int64_t nrhs = B.n();
+    int64_t restart = V.n() / nrhs - 1;
+    int64_t ldh = restart+1;
+
+    bool converged = false;
+
+    // workspace
+    auto R    = B.emptyLike();
+    R.insertLocalTiles( target );
+    auto X_lo = X.template emptyLike<scalar_lo>();
+    X_lo.insertLocalTilesLazy( target );
+
+    std::vector<real_hi> colnorms_X( nrhs );
+    std::vector<real_hi> colnorms_R( nrhs );
+
+    // Blocks j_begin to j_end of basis Q.
+    auto block = [nrhs]( Matrix<scalar_hi>& Q, int64_t j_begin, int64_t j_end ) {
+        return Q.slice( 0, Q.m()-1, j_begin*nrhs, (j_end + 1)*nrhs - 1 );
+    };
+
+    // Inner products of the basis with the new block, Gram matrix of the
+    // new block, and coefficients of the update of X, block diagonal as G.
+    // Allocate each as a single tile.
+    int64_t g_size = (restart+1)*nrhs;
+    int64_t y_size = blas::max( restart, int64_t( 1 ) )*nrhs;
+    slate::Matrix<scalar_hi> G( g_size, nrhs, g_size, 1, 1, A.mpiComm() );
+    G.insertLocalTiles( Target::Host );
+    slate::Matrix<scalar_hi> D( nrhs, nrhs, nrhs, 1, 1, A.mpiComm() );
+    D.insertLocalTiles( Target::Host );
+    slate::Matrix<scalar_hi> Y( y_size, nrhs, y_size, 1, 1, A.mpiComm() );
+    Y.insertLocalTiles( Target::Host );
+    int root = G.tileRank( 0, 0 );
+
+    // Hessenberg matrix, least squares RHS, and rotations of each RHS,
+    // used on the root rank only.
+    std::vector<scalar_hi> H( nrhs*ldh*restart );
+    std::vector<scalar_hi> S( nrhs*ldh );
+    std::vector<real_hi>   givens_alpha( nrhs*restart );
+    std::vector<scalar_hi> givens_beta ( nrhs*restart );
+    std::vector<int64_t>   steps( nrhs );
+
+    std::vector<real_hi> arnoldi_residual( nrhs );
+    std::vector<real_hi> vnorms( nrhs );
+    std::vector<char> active( nrhs );
+
+    // norms[ c ] = 2-norm of column c of block Qb, from its Gram matrix.
+    auto block_norms = [&]( Matrix<scalar_hi>& Qb, std::vector<real_hi>& norms ) {
+        auto QbH = conj_transpose( Qb );
+        gemm<scalar_hi>(
+            one,  QbH,
+                  Qb,
+            zero, D,
+            opts );
+        if (mpi_rank == root) {
+            D.tileGetForReading( 0, 0, LayoutConvert::ColMajor );
+            auto D_00 = D( 0, 0 );
+            for (int64_t c = 0; c < nrhs; ++c)
+                norms[ c ] = std::sqrt( std::real( D_00.at( c, c ) ) );
+        }
+        MPI_Bcast( norms.data(), nrhs, mpi_type<real_hi>::value, root,
+                   A.mpiComm() );
+    };
+
+    // Normalizes the columns of block Qb of active RHS, and zeros the rest.
+    auto normalize = [&]( Matrix<scalar_hi>& Qb, std::vector<real_hi>& norms ) {
+        for (int64_t c = 0; c < nrhs; ++c) {
+            auto q = Qb.slice( 0, Qb.m()-1, c, c );
+            if (! active[ c ])
+                set( zero, zero, q, opts );
+            else if (norms[ c ] != 0)
+                scale( 1.0, norms[ c ], q, opts );
+        }
+    };
+
+    // Keeps in G only the inner products of each active RHS with its own
+    // basis, G(i nrhs + c, c) for blocks i = 0, ..., j, and adds them to
+    // column j of its Hessenberg matrix.
+    auto project = [&]( int64_t j ) {
+        if (mpi_rank == root) {
+            G.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+            auto G_00 = G( 0, 0 );
+            for (int64_t c = 0; c < nrhs; ++c) {
+                scalar_hi* H_c = &H[ c*ldh*restart ];
+                for (int64_t i = 0; i <= j; ++i) {
+                    for (int64_t c2 = 0; c2 < nrhs; ++c2) {
+                        if (c2 == c && active[ c ])
+                            H_c[ i + j*ldh ] += G_00.at( i*nrhs + c, c );
+                        else
+                            G_00.at( i*nrhs + c2, c ) = zero;
+                    }
+                }
+            }
+        }
+    };
+
+    // On the root, norms of the new block j+1, after its second projection,
+    // from its Gram matrix and the projections in G. If cancellation makes
+    // them inaccurate, sets recompute.
+    const real_hi tiny = std::sqrt( std::numeric_limits<real_hi>::epsilon() );
+    bool recompute = false;
+    auto fused_norms = [&]( int64_t j ) {
+        if (mpi_rank == root) {
+            auto G_00 = G( 0, 0 );
+            recompute = false;
+            for (int64_t c = 0; c < nrhs; ++c) {
+                real_hi gram = std::real( G_00.at( (j+1)*nrhs + c, c ) );
+                real_hi norm2 = gram;
+                for (int64_t i = 0; i <= j; ++i)
+                    norm2 -= std::norm( G_00.at( i*nrhs + c, c ) );
+                if (active[ c ] && norm2 <= tiny * gram)
+                    recompute = true;
+                vnorms[ c ] = std::sqrt( blas::max( norm2, real_hi( 0 ) ) );
+            }
+        }
+    };
+
+    // On the root, applies the rotations to column j of each active RHS's
+    // Hessenberg matrix, and gets its residual.
+    auto rotate = [&]( int64_t j ) {
+        Timer t_gesv_mixed_gmres_rotations;
+        for (int64_t c = 0; c < nrhs; ++c) {
+            if (! active[ c ])
+                continue;
+            scalar_hi* H_c = &H[ c*ldh*restart ];
+            scalar_hi* S_c = &S[ c*ldh ];
+            real_hi*   ga  = &givens_alpha[ c*restart ];
+            scalar_hi* gb  = &givens_beta [ c*restart ];
+            H_c[ j+1 + j*ldh ] = vnorms[ c ];
+            for (int64_t i = 0; i < j; ++i) {
+                blas::rot( 1, &H_c[ i + j*ldh ], 1, &H_c[ i+1 + j*ldh ], 1,
+                           ga[ i ], gb[ i ] );
+            }
+            scalar_hi H_jj = H_c[ j + j*ldh ], H_j1j = H_c[ j+1 + j*ldh ];
+            blas::rotg( &H_jj, &H_j1j, &ga[ j ], &gb[ j ] );
+            blas::rot( 1, &H_c[ j + j*ldh ], 1, &H_c[ j+1 + j*ldh ], 1,
+                       ga[ j ], gb[ j ] );
+            blas::rot( 1, &S_c[ j ], 1, &S_c[ j+1 ], 1, ga[ j ], gb[ j ] );
+            arnoldi_residual[ c ] = cabs1( S_c[ j+1 ] );
+            steps[ c ] = j+1;
+        }
+        internal::timers_add( opts, "gesv_mixed_gmres::rotations",
+                              t_gesv_mixed_gmres_rotations.stop() );
+    };
+
+    // Broadcasts the norms, residuals, and recompute flag from the root,
+    // in one message.
+    std::vector<real_hi> sync_buffer( 2*nrhs + 1 );
+    auto sync_norms = [&]() {
+        if (mpi_rank == root) {
+            std::copy( vnorms.begin(), vnorms.end(), sync_buffer.begin() );
+            std::copy( arnoldi_residual.begin(), arnoldi_residual.end(),
+                       sync_buffer.begin() + nrhs );
+            sync_buffer[ 2*nrhs ] = recompute ? 1 : 0;
+        }
+        MPI_Bcast(
+                sync_buffer.data(), 2*nrhs + 1,
+                mpi_type<real_hi>::value, root, A.mpiComm() );
+        std::copy( sync_buffer.begin(), sync_buffer.begin() + nrhs,
+                   vnorms.begin() );
+        std::copy( sync_buffer.begin() + nrhs, sync_buffer.begin() + 2*nrhs,
+                   arnoldi_residual.begin() );
+        recompute = sync_buffer[ 2*nrhs ] != 0;
+    };
+
+    // Solve the system A * X = B in low precision.
+    slate::copy( B, X_lo, opts );
+    Timer t_getrs_lo;
+    getrs( A_lo, pivots, X_lo, opts );
+    internal::timers_set( opts, "gesv_mixed_gmres::getrs_lo",
+                          t_getrs_lo.stop() );
+    slate::copy( X_lo, X, opts );
+
+    // IR
+    internal::timers_reset( opts, "gesv_mixed_gmres::gemm_hi" );
+    internal::timers_reset( opts, "gesv_mixed_gmres::add_hi" );
+    internal::timers_reset( opts, "gesv_mixed_gmres::rotations" );
+    internal::timers_reset( opts, "gesv_mixed_gmres::trsm_hi" );
+    int iiter = 0;
+    while (iiter < itermax) {
+
+        // Check for convergence
+        slate::copy( B, R, opts );
+        Timer t_gemm_hi;
+        gemm<scalar_hi>(
+            -one, A,
+                  X,
+            one,  R,
+            opts);
+        internal::timers_add( opts, "gesv_mixed_gmres::gemm_hi",
+                              t_gemm_hi.stop() );
+        // Copy R to the first Krylov vectors, needed unless converged,
+        // while the column norms are reduced.
+        auto colnorms_request = colNorms_start(
+            Norm::Max, X, colnorms_X.data(),
+                       R, colnorms_R.data(), opts );
+        auto V0 = block( V, 0, 0 );
+        slate::copy( R, V0, opts );
+        colnorms_request.wait();
+        if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
+            iter = iiter;
+            converged = true;
+            break;
+        }
+
+        // GMRES
+
+        // Compute initial vectors
+        block_norms( V0, arnoldi_residual );
+
+        bool any_active = false;
+        for (int64_t c = 0; c < nrhs; ++c) {
+            active[ c ] = arnoldi_residual[ c ] > colnorms_X[ c ] * cte;
+            any_active = any_active || active[ c ];
+        }
+        if (! any_active) {
+            // Solver broke down, but residual is not small enough yet.
+            iter = iiter;
+            converged = false;
+            break;
+        }
+        normalize( V0, arnoldi_residual );
+
+        std::fill( H.begin(), H.end(), zero );
+        std::fill( S.begin(), S.end(), zero );
+        std::fill( steps.begin(), steps.end(), 0 );
+        for (int64_t c = 0; c < nrhs; ++c)
+            S[ c*ldh ] = arnoldi_residual[ c ];
+
+        // N.B. convergence is detected using norm(X) at the beginning of the
+        // outer iteration. Thus, changes in the magnitude of X may lead to
+        // excessive restarting or delayed completion.
+        int64_t j = 0;
+        for (; j < restart && iiter < itermax && any_active; ++j, ++iiter) {
+            auto Vj1 = block( V, j+1, j+1 );
+            auto Wj1 = block( W, j+1, j+1 );
+
+            auto Vj = block( V, j, j );
+
+            // Wj1 = M^-1 A Vj, for all RHS
+            slate::copy( Vj, X_lo, opts );
+            t_getrs_lo.start();
+            getrs( A_lo, pivots, X_lo, opts );
+            internal::timers_add( opts, "gesv_mixed_gmres::getrs_lo",
+                                  t_getrs_lo.stop() );
+            slate::copy( X_lo, Wj1, opts );
+
+            t_gemm_hi.start();
+            gemm<scalar_hi>(
+                one,  A,
+                      Wj1,
+                zero, Vj1,
+                opts );
+            internal::timers_add( opts, "gesv_mixed_gmres::gemm_hi",
+                                  t_gemm_hi.stop() );
+
+            // orthogonalize w/ CGS2, each RHS against its own basis.
+            // The second pass also computes the Gram matrix of the new
+            // block, so the norms follow without another reduction, from
+            // ||v - V h||^2 = ||v||^2 - ||h||^2, as V is orthonormal.
+            auto V0j = block( V, 0, j );
+            auto V0jT = conj_transpose( V0j );
+            auto V0j1 = block( V, 0, j+1 );
+            auto V0j1T = conj_transpose( V0j1 );
+            auto Gj  = G.slice( 0, (j+1)*nrhs - 1, 0, nrhs-1 );
+            auto Gj1 = G.slice( 0, (j+2)*nrhs - 1, 0, nrhs-1 );
+            for (int pass = 0; pass < 2; ++pass) {
+                t_gemm_hi.start();
+                if (pass == 0) {
+                    gemm<scalar_hi>(
+                        one,  V0jT,
+                              Vj1,
+                        zero, Gj,
+                        opts );
+                }
+                else {
+                    gemm<scalar_hi>(
+                        one,  V0j1T,
+                              Vj1,
+                        zero, Gj1,
+                        opts );
+                }
+                internal::timers_add( opts, "gesv_mixed_gmres::gemm_hi",
+                                      t_gemm_hi.stop() );
+                project( j );
+                if (pass == 1) {
+                    // On the root: norms, then rotations if the norms are
+                    // accurate; then one broadcast of both.
+                    fused_norms( j );
+                    if (mpi_rank == root && ! recompute)
+                        rotate( j );
+                    sync_norms();
+                }
+                t_gemm_hi.start();
+                gemm<scalar_hi>(
+                    -one, V0j,
+                          Gj,
+                    one,  Vj1,
+                    opts );
+                internal::timers_add( opts, "gesv_mixed_gmres::gemm_hi",
+                                      t_gemm_hi.stop() );
+            }
+            if (recompute) {
+                // Cancellation in the fused norms; compute them explicitly.
+                block_norms( Vj1, vnorms );
+                if (mpi_rank == root)
+                    rotate( j );
+                MPI_Bcast(
+                        arnoldi_residual.data(), nrhs,
+                        mpi_type<real_hi>::value, root, A.mpiComm() );
+            }
+            normalize( Vj1, vnorms );
+
+            // Converged RHS drop out; zero their next vector.
+            any_active = false;
+            for (int64_t c = 0; c < nrhs; ++c) {
+                if (active[ c ] && arnoldi_residual[ c ] <= colnorms_X[ c ] * cte) {
+                    active[ c ] = false;
+                    auto v = Vj1.slice( 0, Vj1.m()-1, c, c );
+                    set( zero, zero, v, opts );
+                }
+                any_active = any_active || active[ c ];
+            }
+        }
+        if (j == 0) {
+            // No room for a step, e.g., restart is 0.
+            iter = iiter;
+            converged = false;
+            break;
+        }
+
+        // update X += W(:, blocks 1:j) Y, with Y(i nrhs + c, c) = y_c(i),
+        // where H_c y_c = S_c for the steps of RHS c.
+        Timer t_trsm_hi;
+        if (mpi_rank == root) {
+            Y.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+            auto Y_00 = Y( 0, 0 );
+            Y_00.set( zero );
+            for (int64_t c = 0; c < nrhs; ++c) {
+                int64_t j_c = steps[ c ];
+                if (j_c == 0)
+                    continue;
+                scalar_hi* S_c = &S[ c*ldh ];
+                blas::trsv( blas::Layout::ColMajor, Uplo::Upper, Op::NoTrans,
+                            Diag::NonUnit, j_c, &H[ c*ldh*restart ], ldh,
+                            S_c, 1 );
+                for (int64_t i = 0; i < j_c; ++i)
+                    Y_00.at( i*nrhs + c, c ) = S_c[ i ];
+            }
+        }
+        internal::timers_add( opts, "gesv_mixed_gmres::trsm_hi",
+                              t_trsm_hi.stop() );
+        auto W_1j = block( W, 1, j ); // first block of W is unused
+        auto Y_j = Y.slice( 0, j*nrhs - 1, 0, nrhs-1 );
+        t_gemm_hi.start();
+        gemm<scalar_hi>(
+            one, W_1j,
+                 Y_j,
+            one, X,
+            opts );
+        internal::timers_add( opts, "gesv_mixed_gmres::gemm_hi",
+                              t_gemm_hi.stop() );
+    }
+
+    return converged;
+}
+
+} // namespace impl
+
 //------------------------------------------------------------------------------
 /// Distributed parallel GMRES-IR LU factorization and solve.
 ///
@@ -33,6 +462,11 @@ namespace slate {
 /// the size of the matrix into account. This might be automated in the future.
 /// Up to now, we always try iterative refinement.
 ///
+/// With several right-hand sides, each runs its own GMRES, but the
+/// low precision solves, products with A, and orthogonalizations of all
+/// right-hand sides are batched into gemm-shaped operations over nrhs
+/// columns; see impl::gesv_mixed_gmres_refine.
+///
 /// GMRES-IR process is stopped if iter > itermax or for all the RHS,
 /// $1 \le j \le nrhs$, we have:
 ///     $\norm{r_j}_{inf} < tol \norm{x_j}_{inf} \norm{A}_{inf},$
@@ -100,6 +534,10 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to convergene, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::MathMode:
+///       Math mode of the low precision factorization on devices.
+///       MathMode::TF32 runs its single precision gemm updates on tensor
+///       cores; refinement recovers the accuracy. Default MathMode::Default
 ///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
@@ -122,9 +560,6 @@ int64_t gesv_mixed_gmres(
 
     // Constants
     const real_hi eps = std::numeric_limits<real_hi>::epsilon();
-    const int64_t mpi_rank = A.mpiRank();
-    const scalar_hi zero = 0.0;
-    const scalar_hi one  = 1.0;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
@@ -133,6 +568,7 @@ int64_t gesv_mixed_gmres(
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    MathMode math_mode = get_option<Option::MathMode>( opts, MathMode::Default );
     int64_t restart = blas::min( 30, itermax, A.tileMb( 0 )-1 );
 
     bool converged = false;
@@ -141,42 +577,19 @@ int64_t gesv_mixed_gmres(
     assert( B.mt() == A.mt() );
     assert( A.tileMb( 0 ) >= restart );
 
-    // TODO: implement block gmres
-    if (B.n() != 1) {
-        slate_not_implemented( "block-GMRES for multiple RHS is not yet supported" );
-    }
-
     // workspace
-    auto R    = B.emptyLike();
-    R.insertLocalTiles( target );
     auto A_lo = A.template emptyLike<scalar_lo>();
-    A_lo.insertLocalTiles( target );
-    auto X_lo = X.template emptyLike<scalar_lo>();
-    X_lo.insertLocalTiles( target );
-
-    std::vector<real_hi> colnorms_X( X.n() );
-    std::vector<real_hi> colnorms_R( R.n() );
-
-    // test basis.  First column corresponds to the residual
-    auto V = internal::alloc_basis( A, restart+1, target );
-    // solution basis.  Columns correspond to those in V. First column is unused
-    auto W = internal::alloc_basis( A, restart+1, target );
-
-    // workspace vector for the orthogonalization process
-    auto z = X.template emptyLike<scalar_hi>();
-    z.insertLocalTiles( target );
-
-    // Hessenberg Matrix. Allocate as a single tile
-    slate::Matrix<scalar_hi> H(
-            restart+1, restart+1, restart+1, 1, 1, A.mpiComm() );
-    H.insertLocalTiles( Target::Host );
-    // least squares RHS. Allocate as a single tile
-    slate::Matrix<scalar_hi> S( restart+1, 1, restart+1, 1, 1, A.mpiComm() );
-    S.insertLocalTiles( Target::Host );
-    // Rotations
-    std::vector<real_hi>   givens_alpha( restart );
-    std::vector<scalar_hi> givens_beta ( restart );
+    A_lo.insertLocalTilesLazy( target );
+    if (target == Target::Devices) {
+        // Low precision factorization may use reduced precision math.
+        A_lo.setMathMode( math_mode );
+    }
 
+    // test basis, a block of nrhs columns per step.
+    // First block corresponds to the residual
+    auto V = internal::alloc_basis( A, (restart+1)*B.n(), target );
+    // solution basis.  Blocks correspond to those in V. First block is unused
+    auto W = internal::alloc_basis( A, (restart+1)*B.n(), target );
 
     if (target == Target::Devices) {
         #pragma omp parallel
@@ -200,180 +613,18 @@ int64_t gesv_mixed_gmres(
     // norm of A
     real_hi Anorm = norm( Norm::Inf, A, opts );
 
-    // stopping criteria
-    real_hi cte = Anorm * tol;
-
     // Compute the LU factorization of A in single-precision.
     slate::copy( A, A_lo, opts );
     Timer t_getrf_lo;
     int64_t info = getrf( A_lo, pivots, opts );
-    timers[ "gesv_mixed_gmres::getrf_lo" ] = t_getrf_lo.stop();
+    internal::timers_set( opts, "gesv_mixed_gmres::getrf_lo",
+                          t_getrf_lo.stop() );
     if (info != 0) {
         iter = -3;
     }
     else {
-        // Solve the system A * X = B in low precision.
-        slate::copy( B, X_lo, opts );
-        Timer t_getrs_lo;
-        getrs( A_lo, pivots, X_lo, opts );
-        timers[ "gesv_mixed_gmres::getrs_lo" ] = t_getrs_lo.stop();
-        slate::copy( X_lo, X, opts );
-
-        // IR
-        timers[ "gesv_mixed_gmres::gemm_hi" ] = 0;
-        timers[ "gesv_mixed_gmres::add_hi" ] = 0;
-        int iiter = 0;
-        while (iiter < itermax) {
-
-            // Check for convergence
-            slate::copy( B, R, opts );
-            Timer t_gemm_hi;
-            gemm<scalar_hi>(
-                -one, A,
-                      X,
-                one,  R,
-                opts);
-            timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-            colNorms( Norm::Max, X, colnorms_X.data(), opts );
-            colNorms( Norm::Max, R, colnorms_R.data(), opts );
-            if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
-                iter = iiter;
-                converged = true;
-                break;
-            }
-
-            // GMRES
-
-            // Compute initial vector
-            auto v0 = V.slice( 0, V.m()-1, 0, 0 );
-            slate::copy( R, v0, opts );
-
-            std::vector<real_hi> arnoldi_residual = { norm( Norm::Fro, v0, opts ) };
-            if (arnoldi_residual[0] == 0) {
-                // Solver broke down, but residual is not small enough yet.
-                iter = iiter;
-                converged = false;
-                break;
-            }
-            scale( 1.0, arnoldi_residual[0], v0, opts );
-            if (S.tileRank( 0, 0 ) == mpi_rank) {
-                S.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
-                auto S_00 = S( 0, 0 );
-                S_00.at( 0, 0 ) = arnoldi_residual[0];
-                for (int i = 1; i < S_00.mb(); ++i) {
-                    S_00.at( i, 0 ) = 0.0;
-                }
-            }
-
-
-            // N.B. convergence is detected using norm(X) at the beginning of the
-            // outer iteration. Thus, changes in the magnitude of X may lead to
-            // excessive restarting or delayed completion.
-            int j = 0;
-            for (; j < restart && iiter < itermax
-                       && ! internal::iterRefConverged(
-                                arnoldi_residual, colnorms_X, cte );
-                 ++j, ++iiter) {
-                auto Vj1 = V.slice( 0, V.m()-1, j+1, j+1 );
-                auto Wj1 = W.slice( 0, W.m()-1, j+1, j+1 );
-
-                auto Vj = V.slice( 0, V.m()-1, j, j );
-
-                // Wj1 = M^-1 A Vj
-                slate::copy( Vj, X_lo, opts );
-                t_getrs_lo.start();
-                getrs( A_lo, pivots, X_lo, opts );
-                timers[ "gesv_mixed_gmres::getrs_lo" ] += t_getrs_lo.stop();
-                slate::copy( X_lo, Wj1, opts );
-
-                t_gemm_hi.start();
-                gemm<scalar_hi>(
-                    one,  A,
-                          Wj1,
-                    zero, Vj1,
-                    opts );
-                timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-
-                // orthogonalize w/ CGS2
-                auto V0j = V.slice( 0, V.m()-1, 0, j );
-                auto V0jT = conj_transpose( V0j );
-                auto Hj = H.slice( 0, j, j, j );
-                t_gemm_hi.start();
-                gemm<scalar_hi>(
-                    one,  V0jT,
-                          Vj1,
-                    zero, Hj,
-                    opts );
-                gemm<scalar_hi>(
-                    -one, V0j,
-                          Hj,
-                    one,  Vj1,
-                    opts );
-                timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-                auto zj = z.slice( 0, j, 0, 0 );
-                t_gemm_hi.start();
-                gemm<scalar_hi>(
-                    one,  V0jT,
-                          Vj1,
-                    zero, zj,
-                    opts );
-                gemm<scalar_hi>(
-                    -one, V0j,
-                          zj,
-                    one,  Vj1,
-                    opts );
-                timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-                Timer t_add_hi;
-                add( one, zj, one, Hj, opts );
-                timers[ "gesv_mixed_gmres::add_hi" ] += t_add_hi.stop();
-                auto Vj1_norm = norm( Norm::Fro, Vj1, opts );
-                scale( 1.0, Vj1_norm, Vj1, opts );
-                if (H.tileRank( 0, 0 ) == mpi_rank) {
-                    H.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
-                    auto H_00 = H( 0, 0 );
-                    H_00.at( j+1, j ) = Vj1_norm;
-                }
-
-                // apply givens rotations
-                Timer t_gesv_mixed_gmres_rotations;
-                if (H.tileRank( 0, 0 ) == mpi_rank) {
-                    auto H_00 = H( 0, 0 );
-                    for (int64_t i = 0; i < j; ++i) {
-                        blas::rot( 1, &H_00.at( i, j ), 1, &H_00.at( i+1, j ), 1,
-                                   givens_alpha[i], givens_beta[i] );
-                    }
-                    scalar_hi H_jj = H_00.at( j, j ), H_j1j = H_00.at( j+1, j );
-                    blas::rotg( &H_jj, & H_j1j, &givens_alpha[j], &givens_beta[j] );
-                    blas::rot( 1, &H_00.at( j, j ), 1, &H_00.at( j+1, j ), 1,
-                               givens_alpha[j], givens_beta[j] );
-                    auto S_00 = S( 0, 0 );
-                    blas::rot( 1, &S_00.at( j, 0 ), 1, &S_00.at( j+1, 0 ), 1,
-                               givens_alpha[j], givens_beta[j] );
-                    arnoldi_residual[0] = cabs1( S_00.at( j+1, 0 ) );
-                }
-                timers[ "gesv_mixed_gmres::rotations" ] += t_gesv_mixed_gmres_rotations.stop();
-                MPI_Bcast(
-                        arnoldi_residual.data(), arnoldi_residual.size(),
-                        mpi_type<scalar_hi>::value, S.tileRank( 0, 0 ),
-                        A.mpiComm() );
-            }
-            // update X
-            auto H_j = H.slice( 0, j-1, 0, j-1 );
-            auto S_j = S.slice( 0, j-1, 0, 0 );
-            auto H_tri = TriangularMatrix<scalar_hi>(
-                    Uplo::Upper, Diag::NonUnit, H_j );
-            Timer t_trsm_hi;
-            trsm( Side::Left, one, H_tri, S_j, opts );
-            timers[ "gesv_mixed_gmres::trsm_hi" ] += t_trsm_hi.stop();
-            auto W_0j = W.slice( 0, W.m()-1, 1, j ); // first column of W is unused
-            t_gemm_hi.start();
-            gemm<scalar_hi>(
-                one, W_0j,
-                     S_j,
-                one, X,
-                opts );
-            timers[ "gesv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
-        }
+        converged = impl::gesv_mixed_gmres_refine(
+            A, A_lo, pivots, V, W, Anorm * tol, B, X, iter, opts );
     }
 
     if (! converged) {
@@ -388,7 +639,8 @@ int64_t gesv_mixed_gmres(
             // Compute the LU factorization of A.
             Timer t_getrf_hi;
             info = getrf( A, pivots, opts );
-            timers[ "gesv_mixed_gmres::getrf_hi" ] = t_getrf_hi.stop();
+            internal::timers_set( opts, "gesv_mixed_gmres::getrf_hi",
+                                  t_getrf_hi.stop() );
 
             // Solve the system A * X = B.
             Timer t_getrs_hi;
@@ -396,8 +648,164 @@ int64_t gesv_mixed_gmres(
                 slate::copy( B, X, opts );
                 getrs( A, pivots, X, opts );
             }
-            timers[ "gesv_mixed_gmres::getrs_hi" ] = t_getrs_hi.stop();
+            internal::timers_set( opts, "gesv_mixed_gmres::getrs_hi",
+                                  t_getrs_hi.stop() );
+        }
+    }
+
+    if (target == Target::Devices) {
+        // clear instead of release due to previous hold
+        A.clearWorkspace();
+        B.clearWorkspace();
+        X.clearWorkspace();
+    }
+    internal::timers_set( opts, "gesv_mixed_gmres", t_gesv_mixed_gmres.stop() );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel GMRES-IR solve, using the low precision LU
+/// factorization F of A from gesv_mixed_factor.
+///
+/// Solves $A X = B$ as gesv_mixed_gmres does, but without converting and
+/// factoring A. The GMRES bases are allocated in F by the first call and
+/// reused by later calls with the same restart length.
+///
+/// If refinement fails and Option::UseFallbackSolver is true, a copy of A
+/// is factored in high precision and kept in F, as in gesv_mixed_solve.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n matrix $A$, unchanged since gesv_mixed_factor.
+///
+/// @param[in,out] F
+///     The factorization of $A$ from gesv_mixed_factor.
+///     On exit, holds the GMRES bases, and may hold the high precision
+///     factors of $A$.
+///
+/// @param[in] B
+///     On entry, the n-by-nrhs right hand side matrix $B$.
+///
+/// @param[out] X
+///     On exit, if return value = 0, the n-by-nrhs solution matrix $X$.
+///
+/// @param[out] iter
+///     The number of refinement iterations, as for gesv_mixed_gmres.
+///     < 0 if the solution is from the high precision factors.
+///
+/// @param[in] opts
+///     Additional options, as for gesv_mixed_gmres.
+///
+/// @return 0: successful exit
+/// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index,
+///         so the solution could not be computed.
+///
+/// @ingroup gesv
+///
+template <typename scalar_hi, typename scalar_lo>
+int64_t gesv_mixed_gmres_solve(
+    Matrix<scalar_hi>& A,
+    MixedFactorization<scalar_hi, scalar_lo>& F,
+    Matrix<scalar_hi>& B,
+    Matrix<scalar_hi>& X,
+    int& iter,
+    Options const& opts)
+{
+    Timer t_gesv_mixed_gmres_solve;
+
+    using real_hi = blas::real_type<scalar_hi>;
+
+    // Constants
+    const real_hi eps = std::numeric_limits<real_hi>::epsilon();
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+    double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
+    bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    int64_t restart = blas::min( 30, itermax, A.tileMb( 0 )-1 );
+
+    bool converged = false;
+    iter = 0;
+
+    assert( B.mt() == A.mt() );
+    assert( F.A_lo.mt() == A.mt() );
+    assert( A.tileMb( 0 ) >= restart );
+
+    // Bases are kept in F between solves.
+    if (F.V.n() != (restart+1)*B.n()) {
+        // test basis, a block of nrhs columns per step.
+        // First block corresponds to the residual
+        F.V = internal::alloc_basis( A, (restart+1)*B.n(), target );
+        // solution basis.  Blocks correspond to those in V. First block is unused
+        F.W = internal::alloc_basis( A, (restart+1)*B.n(), target );
+    }
+
+    if (target == Target::Devices) {
+        #pragma omp parallel
+        #pragma omp master
+        {
+            #pragma omp task default(shared)
+            {
+                A.tileGetAndHoldAllOnDevices( LayoutConvert( layout ) );
+            }
+            #pragma omp task default(shared)
+            {
+                B.tileGetAndHoldAllOnDevices( LayoutConvert( layout ) );
+            }
+            #pragma omp task default(shared)
+            {
+                X.tileGetAndHoldAllOnDevices( LayoutConvert( layout ) );
+            }
+        }
+    }
+
+    int64_t info = F.info;
+    if (info != 0) {
+        iter = -3;
+    }
+    else if (F.factored_hi) {
+        // Refinement already failed with these factors.
+        iter = -itermax - 1;
+    }
+    else {
+        converged = impl::gesv_mixed_gmres_refine(
+            A, F.A_lo, F.pivots, F.V, F.W, F.Anorm * tol, B, X, iter, opts );
+        if (! converged)
+            iter = -itermax - 1;
+    }
+
+    if (! converged && (use_fallback || F.factored_hi)) {
+        // Fall back to double precision factor and solve,
+        // factoring a copy of A the first time.
+        if (! F.factored_hi) {
+            Timer t_getrf_hi;
+            F.A_hi = A.emptyLike();
+            F.A_hi.insertLocalTiles( target );
+            slate::copy( A, F.A_hi, opts );
+            F.info_hi = getrf( F.A_hi, F.pivots_hi, opts );
+            F.factored_hi = true;
+            internal::timers_set( opts, "gesv_mixed_gmres_solve::getrf_hi",
+                                  t_getrf_hi.stop() );
         }
+        info = F.info_hi;
+
+        // Solve the system A * X = B.
+        Timer t_getrs_hi;
+        if (info == 0) {
+            slate::copy( B, X, opts );
+            getrs( F.A_hi, F.pivots_hi, X, opts );
+        }
+        internal::timers_set( opts, "gesv_mixed_gmres_solve::getrs_hi",
+                              t_getrs_hi.stop() );
     }
 
     if (target == Target::Devices) {
@@ -406,10 +814,104 @@ int64_t gesv_mixed_gmres(
         B.clearWorkspace();
         X.clearWorkspace();
     }
-    timers[ "gesv_mixed_gmres" ] = t_gesv_mixed_gmres.stop();
+    internal::timers_set( opts, "gesv_mixed_gmres_solve",
+                          t_gesv_mixed_gmres_solve.stop() );
     return info;
 }
 
+//------------------------------------------------------------------------------
+/// Workspace query for gesv_mixed_gmres: predicts, without solving, the
+/// memory that gesv_mixed_gmres( A, pivots, B, X, iter, opts ) needs on
+/// this rank, as LAPACK's lwork = -1 query. Pass it to Workspace::reserve,
+/// with the same arena in Option::Workspace, so the low precision
+/// factorization allocates nothing during the run.
+///
+/// The pools are those of getrf on the low precision copy of A; see
+/// getrf_workspace_size(). The low precision copy, the GMRES bases V and
+/// W, the residual, the low precision solution, and the Hessenberg
+/// matrices are allocated outside the arena, and counted in host_aux_size,
+/// or, with Target::Devices, device_aux_size, with the tiles of A, B, and
+/// X that are held on the devices.
+/// The high precision fallback factorization, run only if refinement
+/// fails, is not included; its size is getrf_workspace_size( A, opts ).
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n matrix $A$; it is not accessed, only its distribution.
+///
+/// @param[in] B
+///     The n-by-nrhs right hand side matrix $B$; only its distribution
+///     is used.
+///
+/// @param[in] opts
+///     Options, as for gesv_mixed_gmres. Used: MaxIterations and Target,
+///     and those of getrf_workspace_size().
+///
+/// @return predicted workspace on this rank.
+///
+/// @ingroup gesv
+///
+template <typename scalar_hi, typename scalar_lo>
+WorkspaceSize gesv_mixed_gmres_workspace_size(
+    Matrix<scalar_hi>& A,
+    Matrix<scalar_hi>& B,
+    Options const& opts)
+{
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
+    int64_t restart = blas::min( 30, itermax, A.tileMb( 0 )-1 );
+    int64_t nrhs = B.n();
+
+    auto A_lo = A.template emptyLike<scalar_lo>();
+    WorkspaceSize size = getrf_workspace_size( A_lo, opts );
+
+    // Same distribution as internal::alloc_basis, without tiles.
+    Matrix<scalar_hi> V( A.m(), (restart+1)*nrhs, A.tileMbFunc(),
+                         A.tileNbFunc(), A.tileRankFunc(),
+                         A.tileDeviceFunc(), A.mpiComm() );
+    auto R    = B.emptyLike();
+    auto X_lo = B.template emptyLike<scalar_lo>();
+
+    // A_lo, V and W, R, and X_lo.
+    auto tiles_bytes = [&]( int64_t A_tiles, int64_t V_tiles, int64_t B_tiles ) {
+        return A_tiles * A_lo.memoryBlockSize()
+               + 2 * V_tiles * V.memoryBlockSize()
+               + B_tiles * (R.memoryBlockSize() + X_lo.memoryBlockSize());
+    };
+    if (target == Target::Devices) {
+        size.device_aux_size
+            = tiles_bytes( A.getMaxDeviceTiles(), V.getMaxDeviceTiles(),
+                           B.getMaxDeviceTiles() )
+              // A, B, and X held on the devices.
+              + A.getMaxDeviceTiles() * A.memoryBlockSize()
+              + 2 * B.getMaxDeviceTiles() * B.memoryBlockSize();
+    }
+    else {
+        size.host_aux_size
+            += tiles_bytes( A.getMaxHostTiles(), V.getMaxHostTiles(),
+                            B.getMaxHostTiles() );
+    }
+
+    if (A.mpiRank() == 0) {
+        // G, D, and Y, and the Hessenberg matrices, right-hand sides,
+        // and rotations, on the root.
+        int64_t ldh = restart+1;
+        int64_t y_size = blas::max( restart, int64_t( 1 ) )*nrhs;
+        size.host_aux_size
+            += ((restart+1)*nrhs*nrhs + nrhs*nrhs + y_size*nrhs
+                + nrhs*ldh*restart + nrhs*ldh + nrhs*restart)
+               * sizeof( scalar_hi )
+               + nrhs*restart * sizeof( blas::real_type<scalar_hi> );
+    }
+    return size;
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template <>
@@ -436,4 +938,54 @@ int64_t gesv_mixed_gmres< std::complex<double> >(
         A, pivots, B, X, iter, opts );
 }
 
+template
+int64_t gesv_mixed_gmres_solve<double, float>(
+    Matrix<double>& A,
+    MixedFactorization<double, float>& F,
+    Matrix<double>& B,
+    Matrix<double>& X,
+    int& iter,
+    Options const& opts);
+
+template
+int64_t gesv_mixed_gmres_solve< std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >& A,
+    MixedFactorization< std::complex<double>, std::complex<float> >& F,
+    Matrix< std::complex<double> >& B,
+    Matrix< std::complex<double> >& X,
+    int& iter,
+    Options const& opts);
+
+template <>
+WorkspaceSize gesv_mixed_gmres_workspace_size<double>(
+    Matrix<double>& A,
+    Matrix<double>& B,
+    Options const& opts)
+{
+    return gesv_mixed_gmres_workspace_size<double, float>( A, B, opts );
+}
+
+template <>
+WorkspaceSize gesv_mixed_gmres_workspace_size< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts)
+{
+    return gesv_mixed_gmres_workspace_size<
+        std::complex<double>, std::complex<float> >( A, B, opts );
+}
+
+template
+WorkspaceSize gesv_mixed_gmres_workspace_size<double, float>(
+    Matrix<double>& A,
+    Matrix<double>& B,
+    Options const& opts);
+
+template
+WorkspaceSize gesv_mixed_gmres_workspace_size<
+    std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
 } // namespace slate
@@ -182,8 +182,8 @@ void gesv_rbt(Matrix<scalar_t>& A,
 
     // Check whether the nrhs normwise backward error satisfies the
     // stopping criterion. If yes, set iter=0 and return.
-    colNorms( Norm::Max, X, colnorms_X.data(), opts );
-    colNorms( Norm::Max, R, colnorms_R.data(), opts );
+    colNorms( Norm::Max, X, colnorms_X.data(),
+                         R, colnorms_R.data(), opts );
 
     if (internal::iterRefConverged<real_t>( colnorms_R, colnorms_X, cte )) {
         iter = 0;
@@ -201,8 +201,8 @@ void gesv_rbt(Matrix<scalar_t>& A,
 
         // Check whether nrhs normwise backward error satisfies the
         // stopping criterion. If yes, set iter = iiter > 0 and return.
-        colNorms( Norm::Max, X, colnorms_X.data(), opts );
-        colNorms( Norm::Max, R, colnorms_R.data(), opts );
+        colNorms( Norm::Max, X, colnorms_X.data(),
+                             R, colnorms_R.data(), opts );
 
         if (internal::iterRefConverged<real_t>( colnorms_R, colnorms_X, cte )) {
             iter = iiter+1;
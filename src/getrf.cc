@@ -9,6 +9,12 @@
 #include "slate/Tile_blas.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_lookahead.hh"
+#include "internal/internal_priority.hh"
+#include "internal/internal_util.hh"
+#include "slate/internal/TaskGraph.hh"
+#include "slate/internal/TaskRuntime.hh"
+#include "slate/internal/Affinity.hh"
 
 namespace slate {
 
@@ -17,32 +23,52 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel LU factorization.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// Panel computed on host using Host OpenMP task, or on the GPU device
+/// for Target::Devices.
+///
+/// If Anorm isn't null, also computes the one or inf norm of the original
+/// A, from sums of |A| by column or row, taken by tasks that read each
+/// block column just before the first step modifies it, so A isn't read
+/// in a separate pass; on devices, the tiles they bring stay for the
+/// factorization. The sums are reduced once, at the end.
 /// @ingroup gesv_impl
 ///
 template <Target target, typename scalar_t>
 int64_t getrf(
     Matrix<scalar_t>& A, Pivots& pivots,
+    Norm in_norm, blas::real_type<scalar_t>* Anorm,
     Options const& opts )
 {
     using real_t = blas::real_type<scalar_t>;
     using BcastList = typename Matrix<scalar_t>::BcastList;
 
+    // Norms of tiles on devices use device kernels, otherwise host tasks.
+    const Target norm_target = target == Target::Devices
+                             ? Target::Devices : Target::HostTask;
+
     // Constants
     const scalar_t one = 1.0;
     const int priority_0 = 0;
-    const int priority_1 = 1;
     const int queue_0 = 0;
     const int queue_1 = 1;
 
     // Options
     real_t pivot_threshold = get_option<Option::PivotThreshold>( opts, 1.0 );
     int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
+    int64_t max_lookahead = get_option<Option::MaxLookahead>( opts, lookahead );
     int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
+    Workspace* workspace = get_option<Option::Workspace>( opts, nullptr );
     int64_t max_panel_threads  = std::max( omp_get_max_threads()/2, 1 );
     max_panel_threads = get_option<Option::MaxPanelThreads>(
                                                       opts, max_panel_threads );
 
+    // Collective; node grouping for Option::HierarchicalBcast.
+    if (get_option<Option::HierarchicalBcast>( opts, false ))
+        internal::commNodes( A.mpiComm() );
+
+    // Collective; lookahead depth per step.
+    internal::Lookahead depths( lookahead, max_lookahead, A.mpiComm() );
+
     // Host can use Col/RowMajor for row swapping,
     // RowMajor is slightly more efficient.
     // Layout host_layout = Layout::RowMajor;
@@ -64,38 +90,160 @@ int64_t getrf(
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector< uint8_t > column_vector(A_nt);
     uint8_t* column = column_vector.data();
-    SLATE_UNUSED( column ); // Used only by OpenMP
+    // Placeholder dependency for lookahead columns without an extra one.
+    uint8_t no_column;
+
+    // Stream final panels back to host while the factorization continues.
+    bool stream_origin = target == Target::Devices && async_origin();
+    // Placeholder dependency for the release of the first column.
+    uint8_t no_prev_column;
+
+    // Local sums of |A| by column (one norm) or row (inf norm).
+    std::vector<real_t> norm_sums;
+    if (Anorm != nullptr)
+        norm_sums.assign( in_norm == Norm::One ? A.n() : A.m(), 0.0 );
 
     // Communication of the jth tile column uses the MPI tag j
     // So, the data dependencies protect the corresponding MPI tags
 
+    // Device workspace for the panel, sized for the first panel with local
+    // tiles, which has the most local rows.
+    int64_t num_devices = A.num_devices();
+    size_t  dwork_bytes = 0;
+    std::vector< char* > dwork_array( num_devices, nullptr );
+
+    const int64_t batch_size_default = 0;
+    int num_queues = 2 + lookahead;
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
-        const int64_t batch_size_default = 0;
-        int num_queues = 2 + lookahead;
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays( batch_size_default, num_queues );
         A.reserveDeviceWorkspace();
+
+        int64_t mlocal = 0;
+        for (int64_t j = 0; j < A_nt && mlocal == 0; ++j) {
+            for (int64_t i = j; i < A_mt; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    mlocal += A.tileMb( i );
+            }
+        }
+        if (mlocal > 0) {
+            dwork_bytes = internal::getrf_panel_work_bytes<scalar_t>(
+                              mlocal, A.tileNb( 0 ), ib );
+            for (int64_t dev = 0; dev < num_devices; ++dev) {
+                blas::Queue* queue = A.comm_queue( dev );
+                if (workspace != nullptr) {
+                    dwork_array[ dev ]
+                        = (char*) workspace->deviceBuffer( dev, dwork_bytes );
+                }
+                else {
+                    dwork_array[ dev ]
+                        = blas::device_malloc<char>( dwork_bytes, *queue );
+                }
+            }
+        }
     }
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    // keep update tasks off the panel and communication cores
+    internal::ExcludeReservedCores exclude_reserved_cores;
+
+    trace::TaskGraph::region( "getrf" );
+
     #pragma omp parallel
     #pragma omp master
     {
+        internal::TaskRuntime rt;
         int64_t kk = 0;  // column index (not block-column)
         for (int64_t k = 0; k < min_mt_nt; ++k) {
 
             int64_t diag_len = std::min(A.tileMb(k), A.tileNb(k));
             pivots.at(k).resize(diag_len);
 
-            // panel, high priority
-            #pragma omp task depend(inout:column[k]) priority(1)
+            int64_t lookahead_k = depths.next( k );
+            if (target == Target::Devices && 2 + lookahead_k > num_queues) {
+                // Queues for the deeper lookahead; batch arrays can't be
+                // reallocated while tasks use them.
+                rt.wait();
+                num_queues = 2 + lookahead_k;
+                A.allocateBatchArrays( batch_size_default, num_queues );
+            }
+
+            // Priorities of step k, see internal::task_priority: the panel
+            // with its pivot search, then the swaps and updates of the
+            // lookahead and trailing columns; swaps to the left stay at
+            // priority_0.
+            int priority_panel = internal::task_priority(
+                internal::TaskKind::Panel, k, min_mt_nt );
+            int priority_lookahead = internal::task_priority(
+                internal::TaskKind::Lookahead, k, min_mt_nt );
+            int priority_trailing = internal::task_priority(
+                internal::TaskKind::Trailing, k, min_mt_nt );
+
+            // Sums of |A| over block columns A(:, j1:j2) before step 0
+            // modifies them: one task per column of the panel and the
+            // lookahead, and one for the trailing matrix, which the
+            // trailing update follows through column[ k+1+lookahead ].
+            if (Anorm != nullptr && k == 0) {
+                int64_t kl1 = std::min( 1 + lookahead_k, A_nt );
+                int64_t jj1 = 0;
+                for (int64_t j1 = 0; j1 <= kl1 && j1 < A_nt; ++j1) {
+                    int64_t j2 = j1 < kl1 ? j1 : A_nt-1;
+                    int priority_norm = j1 == 0 ? priority_panel
+                                                : priority_lookahead;
+                    int64_t task_norm = trace::TaskGraph::task(
+                        "norm", k, j1, {}, { &column[ j1 ] } );
+                    rt.spawn( {}, { &column[ j1 ] }, priority_norm,
+                              [=, &A, &norm_sums]()
+                    {
+                        trace::TaskBlock task_block( task_norm );
+                        trace::Step trace_step( k );
+
+                        auto Aj = A.sub( 0, A_mt-1, j1, j2 );
+                        int64_t offset = in_norm == Norm::One ? jj1 : 0;
+                        std::vector<real_t> sums(
+                            in_norm == Norm::One ? Aj.n() : Aj.m() );
+                        internal::norm<norm_target>(
+                            in_norm, NormScope::Matrix, std::move( Aj ),
+                            sums.data(), priority_norm, AnyQueue );
+
+                        #pragma omp critical(slate_norm_sums)
+                        {
+                            for (size_t i = 0; i < sums.size(); ++i)
+                                norm_sums[ offset + i ] += sums[ i ];
+                        }
+                    });
+                    jj1 += A.tileNb( j1 );
+                }
+            }
+
+            // panel, highest priority
+            int64_t task_panel = trace::TaskGraph::task(
+                "panel", k, k, {}, { &column[k] } );
+            rt.spawn( {}, { &column[k] }, priority_panel,
+                      [=, &A, &pivots, &opts, &info, &depths,
+                       &dwork_array]()
             {
+                trace::TaskBlock task_block( task_panel );
+                trace::Step trace_step( k );
+                Timer t_panel;
+
                 // factor A(k:mt-1, k)
                 int64_t iinfo;
-                internal::getrf_panel<Target::HostTask>(
-                    A.sub(k, A_mt-1, k, k), diag_len, ib, pivots.at(k),
-                    pivot_threshold, max_panel_threads, priority_1, k, &iinfo );
+                if (target == Target::Devices) {
+                    internal::getrf_panel<Target::Devices>(
+                        A.sub(k, A_mt-1, k, k), dwork_array, dwork_bytes,
+                        diag_len, ib, pivots.at(k), pivot_threshold,
+                        max_panel_threads, priority_panel, k, &iinfo );
+                }
+                else {
+                    internal::getrf_panel<Target::HostTask>(
+                        A.sub(k, A_mt-1, k, k), diag_len, ib, pivots.at(k),
+                        pivot_threshold, max_panel_threads, priority_panel, k,
+                        &iinfo );
+                }
                 if (info == 0 && iinfo > 0)
                     info = kk + iinfo;
 
@@ -106,29 +254,56 @@ int64_t getrf(
                     bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, A_nt-1)}});
                 }
                 A.template listBcast<target>(
-                    bcast_list_A, target_layout, tag_k );
-
-                // Root broadcasts the pivot to all ranks.
-                // todo: Panel ranks send the pivots to the right.
-                {
+                    bcast_list_A, target_layout, tag_k, false, opts );
+
+                // Root broadcasts the pivots to the ranks that swap rows
+                // with them, those owning tiles in A(k:mt-1, :), using a
+                // communicator cached by the matrix, so other ranks don't
+                // synchronize on each panel. They get all pivots at the end.
+                std::set<int> pivot_set;
+                A.sub(k, A_mt-1, 0, A_nt-1).getRanks(&pivot_set);
+                if (pivot_set.find( A.mpiRank() ) != pivot_set.end()) {
                     trace::Block trace_block("MPI_Bcast");
 
-                    MPI_Bcast(pivots.at(k).data(),
-                              sizeof(Pivot)*pivots.at(k).size(),
-                              MPI_BYTE, A.tileRank(k, k), A.mpiComm());
+                    int pivot_root;
+                    MPI_Comm pivot_comm = internal::commFromSet(
+                        pivot_set, A.mpiComm(), A.mpiGroup(),
+                        A.tileRank(k, k), pivot_root, tag_k, A.commCache() );
+                    slate_mpi_call(
+                        MPI_Bcast(pivots.at(k).data(),
+                                  sizeof(Pivot)*pivots.at(k).size(),
+                                  MPI_BYTE, pivot_root, pivot_comm));
                 }
-            }
+                else {
+                    // No local rows to swap; identity pivots until the end.
+                    for (int64_t i = 0; i < diag_len; ++i)
+                        pivots.at(k)[ i ] = Pivot(0, i);
+                }
+                depths.panel_time( t_panel.stop() );
+            });
             // update lookahead column(s), high priority
-            for (int64_t j = k+1; j < k+1+lookahead && j < A_nt; ++j) {
-                #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[j]) priority(1)
+            for (int64_t j = k+1; j < k+1+lookahead_k && j < A_nt; ++j) {
+                // A column joining the lookahead follows the trailing update.
+                uint8_t* trailing = depths.follows_trailing( k, j, A_nt )
+                                  ? &column[ A_nt-1 ] : &no_column;
+
+                int64_t task_lookahead = trace::TaskGraph::task(
+                    "lookahead", k, j, { &column[k], trailing },
+                    { &column[j] } );
+                rt.spawn( { &column[k], trailing }, { &column[j] },
+                          priority_lookahead,
+                          [=, &A, &pivots, &opts, &info, &depths,
+                           &dwork_array]()
                 {
+                    trace::TaskBlock task_block( task_lookahead );
+                    trace::Step trace_step( k );
+
                     // swap rows in A(k:mt-1, j)
                     int tag_j = j;
                     int queue_jk1 = j-k+1;
                     internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, A_mt-1, j, j), pivots.at(k),
-                        target_layout, priority_1, tag_j, queue_jk1 );
+                        target_layout, priority_lookahead, tag_j, queue_jk1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
@@ -138,7 +313,7 @@ int64_t getrf(
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ), A.sub(k, k, j, j),
-                        priority_1, target_layout, queue_jk1 );
+                        priority_lookahead, target_layout, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
                     // todo: trsm still operates in ColMajor
@@ -149,15 +324,22 @@ int64_t getrf(
                         -one, A.sub(k+1, A_mt-1, k, k),
                               A.sub(k, k, j, j),
                         one,  A.sub(k+1, A_mt-1, j, j),
-                        target_layout, priority_1, queue_jk1 );
-                }
+                        target_layout, priority_lookahead, queue_jk1 );
+                });
             }
             // pivot to the left
             if (k > 0) {
-                #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[0]) \
-                                 depend(inout:column[k-1])
+                int64_t task_pivot = trace::TaskGraph::task(
+                    "pivot left", k, -1, { &column[k] },
+                    { &column[0], &column[k-1] } );
+                rt.spawn( { &column[k] }, { &column[0], &column[k-1] },
+                          priority_0,
+                          [=, &A, &pivots, &opts, &info, &depths,
+                           &dwork_array]()
                 {
+                    trace::TaskBlock task_block( task_pivot );
+                    trace::Step trace_step( k );
+
                     // swap rows in A(k:mt-1, 0:k-1)
                     const int tag_0 = 0;
                     if (A.origin() == Target::Devices && target == Target::Devices) {
@@ -170,20 +352,30 @@ int64_t getrf(
                             Direction::Forward, A.sub(k, A_mt-1, 0, k-1), pivots.at(k),
                             host_layout, priority_0, tag_0, queue_0 );
                     }
-                }
+                });
             }
-            // update trailing submatrix, normal priority
-            if (k+1+lookahead < A_nt) {
-                #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+            // update trailing submatrix, lower priority
+            if (k+1+lookahead_k < A_nt) {
+                int64_t task_update = trace::TaskGraph::task(
+                    "update", k, k+1+lookahead_k, { &column[k] },
+                    { &column[k+1+lookahead_k], &column[A_nt-1] } );
+                rt.spawn( { &column[k] },
+                          { &column[k+1+lookahead_k], &column[A_nt-1] },
+                          priority_trailing,
+                          [=, &A, &pivots, &opts, &info, &depths,
+                           &dwork_array]()
                 {
+                    trace::TaskBlock task_block( task_update );
+                    trace::Step trace_step( k );
+                    Timer t_update;
+
                     // swap rows in A(k:mt-1, kl+1:nt-1)
-                    int tag_kl1 = k+1+lookahead;
+                    int tag_kl1 = k+1+lookahead_k;
                     // todo: target
                     internal::permuteRows<target>(
-                        Direction::Forward, A.sub(k, A_mt-1, k+1+lookahead, A_nt-1),
-                        pivots.at(k), target_layout, priority_0, tag_kl1, queue_1 );
+                        Direction::Forward, A.sub(k, A_mt-1, k+1+lookahead_k, A_nt-1),
+                        pivots.at(k), target_layout, priority_trailing, tag_kl1,
+                        queue_1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
@@ -194,28 +386,39 @@ int64_t getrf(
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ),
-                             A.sub(k, k, k+1+lookahead, A_nt-1),
-                        priority_0, target_layout, queue_1 );
+                             A.sub(k, k, k+1+lookahead_k, A_nt-1),
+                        priority_trailing, target_layout, queue_1 );
 
                     // send A(k, kl+1:A_nt-1) across A(k+1:mt-1, kl+1:nt-1)
                     BcastList bcast_list_A;
-                    for (int64_t j = k+1+lookahead; j < A_nt; ++j) {
+                    for (int64_t j = k+1+lookahead_k; j < A_nt; ++j) {
                         // send A(k, j) across column A(k+1:mt-1, j)
                         bcast_list_A.push_back({k, j, {A.sub(k+1, A_mt-1, j, j)}});
                     }
                     A.template listBcast<target>(
-                        bcast_list_A, target_layout, tag_kl1);
+                        bcast_list_A, target_layout, tag_kl1, false, opts );
 
                     // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
                     internal::gemm<target>(
                         -one, A.sub(k+1, A_mt-1, k, k),
-                              A.sub(k, k, k+1+lookahead, A_nt-1),
-                        one,  A.sub(k+1, A_mt-1, k+1+lookahead, A_nt-1),
-                        target_layout, priority_0, queue_1 );
-                }
+                              A.sub(k, k, k+1+lookahead_k, A_nt-1),
+                        one,  A.sub(k+1, A_mt-1, k+1+lookahead_k, A_nt-1),
+                        target_layout, priority_trailing, queue_1 );
+
+                    depths.update_time( t_update.stop() );
+                });
             }
-            #pragma omp task depend(inout:column[k])
+            // When streaming, the release of column k also erases the
+            // device workspace of column k-1, so it follows that release.
+            uint8_t* prev_column = k > 0 ? &column[k-1] : &no_prev_column;
+            int64_t task_release = trace::TaskGraph::task(
+                "release", k, k, {}, { prev_column, &column[k] } );
+            rt.spawn( {}, { prev_column, &column[k] }, priority_0,
+                      [=, &A, &pivots, &opts, &info, &depths,
+                       &dwork_array]()
             {
+                trace::TaskBlock task_block( task_release );
+                trace::Step trace_step( k );
                 auto left_panel = A.sub( k, A_mt-1, k, k );
                 auto top_panel = A.sub( k, k, k+1, A_nt-1 );
 
@@ -223,22 +426,84 @@ int64_t getrf(
                 left_panel.releaseRemoteWorkspace();
                 top_panel.releaseRemoteWorkspace();
 
-                // Update the origin tiles before their
-                // workspace copies on devices are erased.
-                left_panel.tileUpdateAllOrigin();
-                top_panel.tileUpdateAllOrigin();
-
-                // Erase local workspace on devices.
-                left_panel.releaseLocalWorkspace();
-                top_panel.releaseLocalWorkspace();
-            }
+                if (stream_origin) {
+                    // Start copying the final panel to the origin tiles,
+                    // and erase the previous panel's local workspace,
+                    // whose copies have had a step to complete.
+                    left_panel.tileUpdateAllOriginAsync();
+                    top_panel.tileUpdateAllOriginAsync();
+                    if (k > 0) {
+                        A.sub( k-1, A_mt-1, k-1, k-1 ).releaseLocalWorkspace();
+                        A.sub( k-1, k-1, k, A_nt-1 ).releaseLocalWorkspace();
+                    }
+                }
+                else {
+                    // Update the origin tiles before their
+                    // workspace copies on devices are erased.
+                    left_panel.tileUpdateAllOrigin();
+                    top_panel.tileUpdateAllOrigin();
+
+                    // Erase local workspace on devices.
+                    left_panel.releaseLocalWorkspace();
+                    top_panel.releaseLocalWorkspace();
+                }
+            });
             kk += A.tileNb( k );
         }
-        #pragma omp taskwait
+        rt.wait();
 
         A.tileLayoutReset();
     }
+
+    // Ranks not owning tiles in the last block row missed some pivots.
+    // Sets of ranks owning A(k:mt-1, :) shrink as k grows, so the owner of
+    // the last diagonal tile has all the pivots; it sends them in one bcast.
+    if (min_mt_nt > 0) {
+        int64_t k_last = min_mt_nt - 1;
+        std::set<int> last_set;
+        A.sub(k_last, A_mt-1, 0, A_nt-1).getRanks(&last_set);
+        int mpi_size;
+        MPI_Comm_size(A.mpiComm(), &mpi_size);
+        if (int( last_set.size() ) < mpi_size) {
+            trace::Block trace_block("MPI_Bcast");
+
+            std::vector<Pivot> all_pivots;
+            for (auto& pivots_k : pivots)
+                all_pivots.insert(all_pivots.end(), pivots_k.begin(), pivots_k.end());
+            slate_mpi_call(
+                MPI_Bcast(all_pivots.data(), sizeof(Pivot)*all_pivots.size(),
+                          MPI_BYTE, A.tileRank(k_last, k_last), A.mpiComm()));
+            auto iter = all_pivots.begin();
+            for (auto& pivots_k : pivots) {
+                std::copy(iter, iter + pivots_k.size(), pivots_k.begin());
+                iter += pivots_k.size();
+            }
+        }
+    }
+    if (Anorm != nullptr) {
+        std::vector<real_t> global_sums( norm_sums.size() );
+
+        #pragma omp critical(slate_mpi)
+        {
+            trace::Block trace_block("MPI_Allreduce");
+            slate_mpi_call(
+                MPI_Allreduce(norm_sums.data(), global_sums.data(),
+                              norm_sums.size(), mpi_type<real_t>::value,
+                              MPI_SUM, A.mpiComm()));
+        }
+
+        *Anorm = lapack::lange(Norm::Max, 1, global_sums.size(),
+                               global_sums.data(), 1);
+    }
+
     A.clearWorkspace();
+    if (target == Target::Devices && workspace == nullptr && dwork_bytes > 0) {
+        for (int64_t dev = 0; dev < num_devices; ++dev) {
+            blas::Queue* queue = A.comm_queue( dev );
+            blas::device_free( dwork_array[dev], *queue );
+            dwork_array[dev] = nullptr;
+        }
+    }
 
     internal::reduce_info( &info, A.mpiComm() );
     return info;
@@ -279,12 +544,20 @@ int64_t getrf(
 ///     The pivot indices that define the permutation matrix $P$.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
+///     Additional options, as map of name = value pairs.
+///     Lookahead, InnerBlocking, and MaxPanelThreads not given here
+///     default to the tuning file's values, if any; see tuned_options.
+///     Possible options:
 ///
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
 ///
+///     - Option::MaxLookahead:
+///       If > lookahead, the lookahead starts at Option::Lookahead and adapts
+///       per panel, up to MaxLookahead, to the measured panel and trailing
+///       update times; see internal::Lookahead. Default lookahead (fixed).
+///
 ///     - Option::InnerBlocking:
 ///       Inner blocking to use for panel. Default 16.
 ///
@@ -302,6 +575,14 @@ int64_t getrf(
 ///       Strictness of the pivot selection.  Between 0 and 1 with 1 giving
 ///       partial pivoting and 0 giving no pivoting.  Default 1.
 ///
+///     - Option::AggregateBcast:
+///       Whether to send all panel tiles going to the same rank in one
+///       message; see BaseMatrix::listBcastAggregated. Default false.
+///
+///     - Option::HierarchicalBcast:
+///       Whether to broadcast panel tiles between nodes first, then within
+///       nodes; see internal::hierarchicalBcastPattern. Default false.
+///
 ///     - Option::MethodLU:
 ///       Algorithm for LU factorization.
 ///       - MethodLU::PartialPiv: partial pivoting [default].
@@ -322,15 +603,58 @@ int64_t getrf(
     Matrix<scalar_t>& A, Pivots& pivots,
     Options const& opts )
 {
+    return getrf( A, pivots, Norm::One, nullptr, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel LU factorization, that also computes a norm of
+/// the original $A$, e.g., for gecondest, without a separate pass over
+/// $A$ before the factorization.
+///
+/// With MethodLU::PartialPiv, the one and inf norms are summed from the
+/// tiles of each block column as the factorization first reads them, and
+/// reduced once at the end. Other norms and methods compute the norm with
+/// slate::norm before factoring.
+///
+/// Arguments are as in getrf( A, pivots, opts ), plus:
+///
+/// @param[in] in_norm
+///     Norm to compute: Norm::One, Norm::Inf, Norm::Max, or Norm::Fro.
+///
+/// @param[out] Anorm
+///     The norm of the original matrix $A$. If null, no norm is computed.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+int64_t getrf(
+    Matrix<scalar_t>& A, Pivots& pivots,
+    Norm in_norm, blas::real_type<scalar_t>* Anorm,
+    Options const& opts )
+{
+    internal::CommStatsScope comm_stats_scope( "getrf", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "getrf", A.mpiComm(), opts );
+
+    // Defaults for options not given, from the tuning file, if any.
+    Options tuned_opts = tuned_options( "getrf", std::min( A.m(), A.n() ), opts );
+
     Method method = get_option<Option::MethodLU>( opts, MethodLU::PartialPiv );
 
+    if (Anorm != nullptr
+        && (method != MethodLU::PartialPiv
+            || (in_norm != Norm::One && in_norm != Norm::Inf))) {
+        // Not fused with the factorization; norm A before it's overwritten.
+        *Anorm = norm( in_norm, A, opts );
+        Anorm = nullptr;
+    }
+
     // todo: info for tntpiv, nopiv
     if (method == MethodLU::CALU) {
-        return getrf_tntpiv( A, pivots, opts );
+        return getrf_tntpiv( A, pivots, tuned_opts );
     }
     else if (method == MethodLU::NoPiv) {
         // todo: fill in pivots vector?
-        return getrf_nopiv( A, opts );
+        return getrf_nopiv( A, tuned_opts );
     }
     else if (method == MethodLU::PartialPiv) {
         Target target = get_option<Option::Target>( opts, Target::HostTask );
@@ -338,16 +662,20 @@ int64_t getrf(
         switch (target) {
             case Target::Host:
             case Target::HostTask:
-                return impl::getrf<Target::HostTask>( A, pivots, opts );
+                return impl::getrf<Target::HostTask>(
+                    A, pivots, in_norm, Anorm, tuned_opts );
 
             case Target::HostNest:
-                return impl::getrf<Target::HostNest>( A, pivots, opts );
+                return impl::getrf<Target::HostNest>(
+                    A, pivots, in_norm, Anorm, tuned_opts );
 
             case Target::HostBatch:
-                return impl::getrf<Target::HostBatch>( A, pivots, opts );
+                return impl::getrf<Target::HostBatch>(
+                    A, pivots, in_norm, Anorm, tuned_opts );
 
             case Target::Devices:
-                return impl::getrf<Target::Devices>( A, pivots, opts );
+                return impl::getrf<Target::Devices>(
+                    A, pivots, in_norm, Anorm, tuned_opts );
         }
     }
     else {
@@ -356,6 +684,97 @@ int64_t getrf(
     return -3;  // shouldn't happen
 }
 
+//------------------------------------------------------------------------------
+/// Workspace query for getrf: predicts, without factoring, the memory that
+/// getrf( A, pivots, opts ) needs on this rank, as LAPACK's lwork = -1
+/// query. Use it to check that a factorization fits before running it, or
+/// pass it to Workspace::reserve, with the same arena in
+/// Option::Workspace, so getrf allocates nothing during the run.
+///
+/// Estimates are for MethodLU::PartialPiv. At most lookahead + 2 panels
+/// are live at once, each with one remote tile per block row and block
+/// column in which this rank (or device) has local tiles; this is an upper
+/// bound, as it counts local panel tiles too.
+/// With Target::Devices, A is attached to the arena and its local tiles
+/// are held on the devices; with host targets, remote tiles come from A's
+/// own pool, so they are counted in host_aux_size.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The matrix $A$ to be factored; it is not accessed, only its
+///     distribution.
+///
+/// @param[in] opts
+///     Options, as for getrf. Used: Lookahead, MaxLookahead,
+///     InnerBlocking, and Target.
+///
+/// @return predicted workspace on this rank.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+WorkspaceSize getrf_workspace_size(
+    Matrix<scalar_t>& A,
+    Options const& opts )
+{
+    Options tuned_opts = tuned_options( "getrf", std::min( A.m(), A.n() ), opts );
+
+    Target target = get_option<Option::Target>( opts, Target::HostTask );
+    int64_t lookahead = get_option<Option::Lookahead>( tuned_opts, 1 );
+    int64_t max_lookahead = get_option<Option::MaxLookahead>(
+                                tuned_opts, lookahead );
+    int64_t ib = get_option<Option::InnerBlocking>( tuned_opts, 16 );
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t min_mt_nt = std::min( A_mt, A_nt );
+    int num_devices = A.num_devices();
+    size_t block_size = A.memoryBlockSize();
+
+    std::vector<int64_t> rows, cols;
+    internal::local_rows_cols( A, rows, cols );
+    int64_t live_panels = std::min( max_lookahead + 2, min_mt_nt );
+
+    WorkspaceSize size;
+    size.host_aux_size = std::min( A.m(), A.n() ) * sizeof( Pivot );
+    int64_t host_remote = live_panels * (rows[ 0 ] + cols[ 0 ]);
+
+    if (target == Target::Devices) {
+        WorkspaceSize::Pool pool;
+        pool.block_size = block_size;
+        pool.host_tiles = host_remote;
+        pool.local_tiles.assign( num_devices, A.getMaxDeviceTiles() );
+        pool.remote_tiles.resize( num_devices );
+        for (int dev = 0; dev < num_devices; ++dev) {
+            pool.remote_tiles[ dev ]
+                = live_panels * (rows[ dev+1 ] + cols[ dev+1 ]);
+        }
+        pool.num_batch_arrays = 2 + max_lookahead;
+        pool.batch_size = A.getMaxDeviceTiles();
+        size.pools.push_back( pool );
+
+        // Panel buffer, as in getrf: first panel with local tiles.
+        int64_t mlocal = 0;
+        for (int64_t j = 0; j < A_nt && mlocal == 0; ++j) {
+            for (int64_t i = j; i < A_mt; ++i) {
+                if (A.tileIsLocal( i, j ))
+                    mlocal += A.tileMb( i );
+            }
+        }
+        if (mlocal > 0) {
+            size.device_buffer_size = internal::getrf_panel_work_bytes<scalar_t>(
+                                          mlocal, A.tileNb( 0 ), ib );
+        }
+    }
+    else {
+        size.host_aux_size += host_remote * block_size;
+    }
+    return size;
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -378,4 +797,48 @@ int64_t getrf< std::complex<double> >(
     Matrix< std::complex<double> >& A, Pivots& pivots,
     Options const& opts);
 
+template
+int64_t getrf<float>(
+    Matrix<float>& A, Pivots& pivots,
+    Norm in_norm, float* Anorm,
+    Options const& opts);
+
+template
+int64_t getrf<double>(
+    Matrix<double>& A, Pivots& pivots,
+    Norm in_norm, double* Anorm,
+    Options const& opts);
+
+template
+int64_t getrf< std::complex<float> >(
+    Matrix< std::complex<float> >& A, Pivots& pivots,
+    Norm in_norm, float* Anorm,
+    Options const& opts);
+
+template
+int64_t getrf< std::complex<double> >(
+    Matrix< std::complex<double> >& A, Pivots& pivots,
+    Norm in_norm, double* Anorm,
+    Options const& opts);
+
+template
+WorkspaceSize getrf_workspace_size<float>(
+    Matrix<float>& A,
+    Options const& opts);
+
+template
+WorkspaceSize getrf_workspace_size<double>(
+    Matrix<double>& A,
+    Options const& opts);
+
+template
+WorkspaceSize getrf_workspace_size< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+WorkspaceSize getrf_workspace_size< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Options const& opts);
+
 } // namespace slate
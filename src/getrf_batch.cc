@@ -0,0 +1,251 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Tile_blas.hh"
+#include "internal/internal.hh"
+#include "internal/internal_swap.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Creates the tasks of a right-looking tile LU factorization with partial
+/// pivoting of a matrix whose tiles are all local and on the host.
+/// Each panel is copied to contiguous memory and factored by LAPACK getrf,
+/// so no MPI is involved. Tasks depend on column[ 0 : A.nt()-1 ], which are
+/// distinct for each matrix of the batch, so the factorizations of all
+/// matrices proceed concurrently.
+/// Called by the master thread.
+/// @ingroup gesv_impl
+///
+template <typename scalar_t>
+void getrf_batch_tasks(
+    Matrix<scalar_t> A, Pivots* pivots, uint8_t* column, int64_t* info )
+{
+    const scalar_t one = 1.0;
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t min_mt_nt = std::min( A_mt, A_nt );
+    SLATE_UNUSED( column ); // Used only by OpenMP
+
+    pivots->resize( min_mt_nt );
+
+    int64_t kk = 0;  // column index (not block-column)
+    for (int64_t k = 0; k < min_mt_nt; ++k) {
+        int64_t diag_len = std::min( A.tileMb( k ), A.tileNb( k ) );
+        pivots->at( k ).resize( diag_len );
+
+        // panel
+        #pragma omp task depend(inout:column[k]) \
+                         firstprivate( A, k, kk, diag_len, pivots, info )
+        {
+            int64_t nb = A.tileNb( k );
+            int64_t mlocal = 0;
+            for (int64_t i = k; i < A_mt; ++i)
+                mlocal += A.tileMb( i );
+
+            // Copy the panel to contiguous memory.
+            std::vector<scalar_t> panel( mlocal*nb );
+            std::vector<int64_t> ipiv( diag_len );
+            int64_t row = 0;
+            for (int64_t i = k; i < A_mt; ++i) {
+                auto T = A( i, k );
+                lapack::lacpy( lapack::MatrixType::General, T.mb(), nb,
+                               T.data(), T.stride(), &panel[ row ], mlocal );
+                row += T.mb();
+            }
+
+            int64_t iinfo = lapack::getrf( mlocal, diag_len, panel.data(),
+                                           mlocal, ipiv.data() );
+            if (diag_len < nb) {
+                // Columns right of a short diagonal tile, as in getrf_panel.
+                lapack::laswp( nb-diag_len, &panel[ diag_len*mlocal ], mlocal,
+                               1, diag_len, ipiv.data(), 1 );
+                blas::trsm( Layout::ColMajor, Side::Left, Uplo::Lower,
+                            Op::NoTrans, Diag::Unit, diag_len, nb-diag_len,
+                            one, panel.data(), mlocal,
+                                 &panel[ diag_len*mlocal ], mlocal );
+            }
+            if (iinfo != 0 && *info == 0)
+                *info = kk + iinfo;
+
+            row = 0;
+            for (int64_t i = k; i < A_mt; ++i) {
+                auto T = A( i, k );
+                lapack::lacpy( lapack::MatrixType::General, T.mb(), nb,
+                               &panel[ row ], mlocal, T.data(), T.stride() );
+                row += T.mb();
+            }
+
+            // Convert LAPACK's 1-based rows to (tile, offset) pivots,
+            // relative to the panel.
+            for (int64_t j = 0; j < diag_len; ++j) {
+                int64_t p = ipiv[ j ] - 1;
+                int64_t i = 0;
+                while (p >= A.tileMb( k+i )) {
+                    p -= A.tileMb( k+i );
+                    ++i;
+                }
+                pivots->at( k )[ j ] = Pivot( i, p );
+            }
+        }
+
+        // Apply the panel to every other column; each one starts as soon as
+        // its own previous update is done, giving a wavefront across steps.
+        for (int64_t j = 0; j < A_nt; ++j) {
+            if (j == k)
+                continue;
+
+            #pragma omp task depend(in:column[k]) \
+                             depend(inout:column[j]) \
+                             firstprivate( A, k, j, pivots )
+            {
+                std::vector<Pivot>& pivot = pivots->at( k );
+                int64_t nb = A.tileNb( j );
+                for (int64_t i = 0; i < int64_t( pivot.size() ); ++i) {
+                    int64_t i2 = k + pivot[ i ].tileIndex();
+                    int64_t off = pivot[ i ].elementOffset();
+                    if (i2 != k || off != i) {
+                        internal::swapLocalRow( 0, nb, A( k, j ), i,
+                                                A( i2, j ), off );
+                    }
+                }
+
+                // Right of the panel: solve A(k, k) A(k, j) = A(k, j) and
+                // A(k+1:mt-1, j) -= A(k+1:mt-1, k) A(k, j).
+                if (j > k) {
+                    auto Lkk = A( k, k );
+                    Lkk.uplo( Uplo::Lower );
+                    tile::trsm( Side::Left, Diag::Unit,
+                                one, std::move( Lkk ), A( k, j ) );
+                    for (int64_t i = k+1; i < A_mt; ++i) {
+                        tile::gemm( -one, A( i, k ), A( k, j ),
+                                    one,  A( i, j ) );
+                    }
+                }
+            }
+        }
+        kk += A.tileNb( k );
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// LU factorization with partial pivoting of a batch of independent
+/// general matrices.
+///
+/// Each matrix is factored as in getrf, with its row interchanges also
+/// applied to the left of each panel, but all factorizations are scheduled
+/// in one OpenMP task graph, so the parallel region and option parsing are
+/// paid once for the batch, and small matrices run concurrently rather
+/// than one after another.
+///
+/// Intended for many small matrices: the tiles of each matrix must all be
+/// local to the calling MPI rank, e.g., a matrix created on a 1-by-1
+/// process grid. The call is not collective; each rank factors its own
+/// batch. Computation is on the host. Diagonal tiles must be square,
+/// except possibly the last one.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A_array
+///     On entry, the m_i-by-n_i matrices $A_i$.
+///     On exit, the factors $L_i$ and $U_i$, as in getrf.
+///
+/// @param[out] pivots_array
+///     Resized to A_array.size(). The pivot indices of each matrix,
+///     as in getrf.
+///
+/// @param[out] info
+///     Resized to A_array.size(). For each matrix, 0 on success,
+///     or i > 0 if its $U(i,i)$ is exactly zero (1-based index).
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Currently unused.
+///
+/// @ingroup gesv_computational
+///
+template <typename scalar_t>
+void getrf_batch(
+    std::vector< Matrix<scalar_t> >& A_array,
+    std::vector<Pivots>& pivots_array,
+    std::vector<int64_t>& info,
+    Options const& opts )
+{
+    int64_t batch_count = A_array.size();
+    info.assign( batch_count, 0 );
+    pivots_array.resize( batch_count );
+
+    for (auto& A : A_array) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                slate_error_if( ! A.tileIsLocal( i, j ) );
+            }
+        }
+        for (int64_t k = 0; k < std::min( A.mt(), A.nt() ) - 1; ++k) {
+            slate_error_if( A.tileMb( k ) != A.tileNb( k ) );
+        }
+        A.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    }
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< std::vector<uint8_t> > column_array( batch_count );
+    for (int64_t b = 0; b < batch_count; ++b)
+        column_array[ b ].resize( A_array[ b ].nt() );
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t b = 0; b < batch_count; ++b) {
+            impl::getrf_batch_tasks( A_array[ b ], &pivots_array[ b ],
+                                     column_array[ b ].data(), &info[ b ] );
+        }
+        #pragma omp taskwait
+    }
+
+    for (auto& A : A_array)
+        A.tileUpdateAllOrigin();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf_batch<float>(
+    std::vector< Matrix<float> >& A_array,
+    std::vector<Pivots>& pivots_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf_batch<double>(
+    std::vector< Matrix<double> >& A_array,
+    std::vector<Pivots>& pivots_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf_batch< std::complex<float> >(
+    std::vector< Matrix< std::complex<float> > >& A_array,
+    std::vector<Pivots>& pivots_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void getrf_batch< std::complex<double> >(
+    std::vector< Matrix< std::complex<double> > >& A_array,
+    std::vector<Pivots>& pivots_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+} // namespace slate
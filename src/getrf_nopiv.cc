@@ -9,6 +9,7 @@
 #include "slate/Tile_blas.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_priority.hh"
 
 namespace slate {
 
@@ -17,7 +18,8 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel LU factorization without pivoting.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// For Devices, the diagonal tile is factored on its device;
+/// otherwise, the panel is computed on host using Host OpenMP task.
 /// @ingroup gesv_impl
 ///
 template <Target target, typename scalar_t>
@@ -30,8 +32,6 @@ int64_t getrf_nopiv(
 
     // Constants
     const scalar_t one = 1.0;
-    const int priority_0 = 0;
-    const int priority_1 = 1;
     const int queue_0 = 0;
     const int queue_1 = 1;
     const Layout layout = Layout::ColMajor;
@@ -39,12 +39,30 @@ int64_t getrf_nopiv(
     // Options
     int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
     int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
+    Workspace* workspace = get_option<Option::Workspace>( opts, nullptr );
 
+    using lapack::device_info_int;
+    std::vector< device_info_int* > device_info_array( A.num_devices(), nullptr );
+
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
         // two batch arrays plus one for each lookahead
         // batch array size will be set as needed
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays(0, 2 + lookahead);
         A.reserveDeviceWorkspace();
+
+        // Allocate, or reuse from workspace arena
+        for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
+            if (workspace != nullptr) {
+                device_info_array[dev] = (device_info_int*)
+                    workspace->deviceBuffer( dev, sizeof(device_info_int) );
+            }
+            else {
+                blas::Queue* queue = A.comm_queue(dev);
+                device_info_array[dev] = blas::device_malloc<device_info_int>( 1, *queue );
+            }
+        }
     }
 
     int64_t info = 0;
@@ -74,15 +92,34 @@ int64_t getrf_nopiv(
         int64_t kk = 0;  // column index (not block-column)
         for (int64_t k = 0; k < min_mt_nt; ++k) {
 
-            // panel, high priority
+            // Priorities of step k, see internal::task_priority: the
+            // diagonal tile factor with the trsm and broadcast of its
+            // column, then the lookahead and trailing columns.
+            int priority_panel = internal::task_priority(
+                internal::TaskKind::Panel, k, min_mt_nt );
+            int priority_lookahead = internal::task_priority(
+                internal::TaskKind::Lookahead, k, min_mt_nt );
+            int priority_trailing = internal::task_priority(
+                internal::TaskKind::Trailing, k, min_mt_nt );
+
+            // panel, highest priority
             #pragma omp task depend(inout:column[k]) \
                              depend(out:diag[k]) \
-                             priority(1)
+                             priority( priority_panel )
             {
-                // factor A(k, k)
+                // factor A(k, k), on its device for Devices, so the tile
+                // is not copied to the host and back; queue_0 is the
+                // queue the panel trsm runs in next.
                 int64_t iinfo;
-                internal::getrf_nopiv<Target::HostTask>(
-                    A.sub(k, k, k, k), ib, priority_1, &iinfo );
+                if (target == Target::Devices) {
+                    internal::getrf_nopiv<Target::Devices>(
+                        A.sub(k, k, k, k), ib, priority_panel, &iinfo,
+                        queue_0, device_info_array[ A.tileDevice( k, k ) ] );
+                }
+                else {
+                    internal::getrf_nopiv<Target::HostTask>(
+                        A.sub(k, k, k, k), ib, priority_panel, &iinfo );
+                }
                 if (info == 0 && iinfo > 0) {
                     info = kk + iinfo;
                 }
@@ -99,7 +136,7 @@ int64_t getrf_nopiv(
             #pragma omp task depend(inout:column[k]) \
                              depend(in:diag[k]) \
                              depend(inout:listBcastMT_token) \
-                             priority(1)
+                             priority( priority_panel )
             {
                 auto Akk = A.sub(k, k, k, k);
                 auto Tkk = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, Akk);
@@ -107,7 +144,7 @@ int64_t getrf_nopiv(
                 internal::trsm<target>(
                     Side::Right,
                     one, std::move( Tkk ), A.sub(k+1, A_mt-1, k, k),
-                    priority_1, layout, queue_0 );
+                    priority_panel, layout, queue_0 );
 
 
                 BcastListTag bcast_list;
@@ -124,7 +161,7 @@ int64_t getrf_nopiv(
             for (int64_t j = k+1; j < k+1+lookahead && j < A_nt; ++j) {
                 #pragma omp task depend(in:diag[k]) \
                                  depend(inout:column[j]) \
-                                 priority(1)
+                                 priority( priority_lookahead )
                 {
                     int tag_j = j;
                     int queue_jk1 = j-k+1;
@@ -136,7 +173,7 @@ int64_t getrf_nopiv(
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ), A.sub(k, k, j, j),
-                        priority_1, layout, queue_jk1 );
+                        priority_lookahead, layout, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
                     A.tileBcast(k, j, A.sub(k+1, A_mt-1, j, j), layout, tag_j);
@@ -144,7 +181,7 @@ int64_t getrf_nopiv(
 
                 #pragma omp task depend(in:column[k]) \
                                  depend(inout:column[j]) \
-                                 priority(1)
+                                 priority( priority_lookahead )
                 {
                     int queue_jk1 = j-k+1;
                     // A(k+1:mt-1, j) -= A(k+1:mt-1, k) * A(k, j)
@@ -152,15 +189,16 @@ int64_t getrf_nopiv(
                         -one, A.sub(k+1, A_mt-1, k, k),
                               A.sub(k, k, j, j),
                         one,  A.sub(k+1, A_mt-1, j, j),
-                        layout, priority_1, queue_jk1 );
+                        layout, priority_lookahead, queue_jk1 );
                 }
             }
-            // update trailing submatrix, normal priority
+            // update trailing submatrix, lower priority
             if (k+1+lookahead < A_nt) {
                 #pragma omp task depend(in:diag[k]) \
                                  depend(inout:column[k+1+lookahead]) \
                                  depend(inout:column[A_nt-1]) \
-                                 depend(inout:listBcastMT_token)
+                                 depend(inout:listBcastMT_token) \
+                                 priority( priority_trailing )
                 {
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
@@ -171,7 +209,7 @@ int64_t getrf_nopiv(
                         Side::Left,
                         one, std::move( Tkk ),
                              A.sub(k, k, k+1+lookahead, A_nt-1),
-                        priority_0, layout, queue_1 );
+                        priority_trailing, layout, queue_1 );
 
                     // send A(k, kl+1:A_nt-1) across A(k+1:mt-1, kl+1:nt-1)
                     BcastListTag bcast_list;
@@ -188,14 +226,15 @@ int64_t getrf_nopiv(
 
                 #pragma omp task depend(in:column[k]) \
                                  depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+                                 depend(inout:column[A_nt-1]) \
+                                 priority( priority_trailing )
                 {
                     // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
                     internal::gemm<target>(
                         -one, A.sub(k+1, A_mt-1, k, k),
                               A.sub(k, k, k+1+lookahead, A_nt-1),
                         one,  A.sub(k+1, A_mt-1, k+1+lookahead, A_nt-1),
-                        layout, priority_0, queue_1 );
+                        layout, priority_trailing, queue_1 );
                 }
             }
             #pragma omp task depend(inout:column[k])
@@ -224,6 +263,13 @@ int64_t getrf_nopiv(
     }
     A.clearWorkspace();
 
+    if (target == Target::Devices && workspace == nullptr) {
+        for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
+            blas::Queue* queue = A.comm_queue(dev);
+            blas::device_free( device_info_array[dev], *queue );
+        }
+    }
+
     internal::reduce_info( &info, A.mpiComm() );
     return info;
 }
@@ -266,7 +312,8 @@ int64_t getrf_nopiv(
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   batched BLAS on GPU device; the diagonal tile is
+///         factored on its device too, so the factorization stays on GPUs.
 ///
 /// @return 0: successful exit
 /// @return i > 0: $U(i,i)$ is exactly zero, where $i$ is a 1-based index.
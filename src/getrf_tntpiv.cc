@@ -9,6 +9,8 @@
 #include "slate/Tile_blas.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_priority.hh"
+#include "slate/internal/Affinity.hh"
 
 namespace slate {
 
@@ -33,7 +35,6 @@ int64_t getrf_tntpiv(
     // Constants
     const scalar_t one = 1.0;
     const int priority_0 = 0;
-    const int priority_1 = 1;
     const int queue_0 = 0;
     const int queue_1 = 1;
     const int queue_2 = 2;
@@ -41,9 +42,17 @@ int64_t getrf_tntpiv(
     // Options
     int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
     int64_t ib = get_option<Option::InnerBlocking>( opts, 16 );
+    Workspace* workspace = get_option<Option::Workspace>( opts, nullptr );
     int64_t max_panel_threads  = std::max( omp_get_max_threads()/2, 1 );
     max_panel_threads = get_option<Option::MaxPanelThreads>(
                                                       opts, max_panel_threads );
+    TournamentTree tree = get_option<Option::TournamentTree>(
+                                                opts, TournamentTree::Binary );
+
+    // Collective; node grouping for TournamentTree::Hybrid, found once
+    // here rather than per panel.
+    if (tree == TournamentTree::Hybrid)
+        internal::commNodes( A.mpiComm() );
 
     // Host can use Col/RowMajor for row swapping,
     // RowMajor is slightly more efficient.
@@ -70,9 +79,11 @@ int64_t getrf_tntpiv(
 
     std::vector< char* > dwork_array( num_devices, nullptr );
 
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
         const int64_t batch_size_default = 0;
         int num_queues = 3 + lookahead;
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays( batch_size_default, num_queues );
         A.reserveDeviceWorkspace();
 
@@ -124,8 +135,14 @@ int64_t getrf_tntpiv(
 
             for (int64_t dev = 0; dev < num_devices; ++dev) {
                 lapack::Queue* queue = A.comm_queue( dev );
-                dwork_array[ dev ]
-                    = blas::device_malloc<char>( dwork_bytes, *queue );
+                if (workspace != nullptr) {
+                    dwork_array[ dev ]
+                        = (char*) workspace->deviceBuffer( dev, dwork_bytes );
+                }
+                else {
+                    dwork_array[ dev ]
+                        = blas::device_malloc<char>( dwork_bytes, *queue );
+                }
             }
         }
     }
@@ -149,6 +166,9 @@ int64_t getrf_tntpiv(
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    // keep update tasks off the panel and communication cores
+    internal::ExcludeReservedCores exclude_reserved_cores;
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -158,10 +178,21 @@ int64_t getrf_tntpiv(
             int64_t diag_len = std::min(A.tileMb(k), A.tileNb(k));
             pivots.at(k).resize(diag_len);
 
-            // panel, high priority
+            // Priorities of step k, see internal::task_priority: the
+            // tournament panel, with its pivot broadcast, trsm below the
+            // diagonal, and broadcast to the right, then the lookahead and
+            // trailing columns; swaps to the left stay at priority_0.
+            int priority_panel = internal::task_priority(
+                internal::TaskKind::Panel, k, min_mt_nt );
+            int priority_lookahead = internal::task_priority(
+                internal::TaskKind::Lookahead, k, min_mt_nt );
+            int priority_trailing = internal::task_priority(
+                internal::TaskKind::Trailing, k, min_mt_nt );
+
+            // panel, highest priority
             #pragma omp task depend(inout:column[k]) \
                              depend(inout:diag[k]) \
-                             priority(1)
+                             priority( priority_panel )
             {
                 auto Apanel = Awork.sub( k, A_mt-1, k, k );
                 Apanel.insertLocalTiles();
@@ -172,7 +203,7 @@ int64_t getrf_tntpiv(
                 internal::getrf_tntpiv_panel<target>(
                     A.sub(k, A_mt-1, k, k), std::move(Apanel),
                     dwork_array, dwork_bytes, diag_len, ib,
-                    pivots.at(k), max_panel_threads, priority_1, &iinfo );
+                    pivots.at(k), max_panel_threads, tree, priority_panel, &iinfo );
                 if (info == 0 && iinfo > 0) {
                     info = kk + iinfo;
                 }
@@ -191,7 +222,7 @@ int64_t getrf_tntpiv(
                 int tag_k = k;
                 internal::permuteRows<target>(
                     Direction::Forward, A.sub(k, A_mt-1, k, k),
-                    pivots.at(k), target_layout, priority_1, tag_k, queue_0 );
+                    pivots.at(k), target_layout, priority_panel, tag_k, queue_0 );
 
                 // Copy factored diagonal tile into place.
                 internal::copy<Target::HostTask>(
@@ -213,7 +244,7 @@ int64_t getrf_tntpiv(
             // A_k+1:mt,k = A_k+1:mt,k * Tkk^{-1}
             #pragma omp task depend(in:diag[k]) \
                              depend(inout:column[k]) \
-                             priority(1)
+                             priority( priority_panel )
             {
                 auto Akk = A.sub(k, k, k, k);
                 auto Tkk = TriangularMatrix<scalar_t>(
@@ -223,12 +254,12 @@ int64_t getrf_tntpiv(
                     Side::Right,
                     one, std::move(Tkk),
                          A.sub( k+1, A_mt-1, k, k ),
-                    priority_1, target_layout, queue_0 );
+                    priority_panel, target_layout, queue_0 );
             }
 
             #pragma omp task depend(inout:column[k]) \
                              depend(inout:listBcastMT_token) \
-                             priority(1)
+                             priority( priority_panel )
             {
                 BcastListTag bcast_list;
                 // bcast the tiles of the panel to the right hand side
@@ -245,14 +276,14 @@ int64_t getrf_tntpiv(
             for (int64_t j = k+1; j < k+1+lookahead && j < A_nt; ++j) {
                 #pragma omp task depend(in:diag[k]) \
                                  depend(inout:column[j]) \
-                                 priority(1)
+                                 priority( priority_lookahead )
                 {
                     // swap rows in A(k:mt-1, j)
                     int tag_j = j + A_mt;
                     int queue_jk1 = j-(k+1)+3;
                     internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, A_mt-1, j, j), pivots.at(k),
-                        target_layout, priority_1, tag_j, queue_jk1 );
+                        target_layout, priority_lookahead, tag_j, queue_jk1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk = TriangularMatrix<scalar_t>(
@@ -262,7 +293,7 @@ int64_t getrf_tntpiv(
                     internal::trsm<target>(
                         Side::Left,
                         one, std::move( Tkk ), A.sub( k, k, j, j ),
-                        priority_1, target_layout, queue_jk1 );
+                        priority_lookahead, target_layout, queue_jk1 );
 
                     // send A(k, j) across column A(k+1:mt-1, j)
                     // todo: trsm still operates in ColMajor
@@ -273,7 +304,7 @@ int64_t getrf_tntpiv(
 
                 #pragma omp task depend(in:column[k]) \
                                  depend(inout:column[j]) \
-                                 priority(1)
+                                 priority( priority_lookahead )
                 {
                     int queue_jk1 = j-(k+1)+3;
                     // A(k+1:mt-1, j) -= A(k+1:mt-1, k) * A(k, j)
@@ -281,21 +312,22 @@ int64_t getrf_tntpiv(
                         -one, A.sub( k+1, A_mt-1, k, k ),
                               A.sub( k, k, j, j ),
                         one,  A.sub( k+1, A_mt-1, j, j ),
-                        host_layout, priority_1, queue_jk1 );
+                        host_layout, priority_lookahead, queue_jk1 );
                 }
             }
 
-            // update trailing submatrix, normal priority
+            // update trailing submatrix, lower priority
             if (k+1+lookahead < A_nt) {
                 #pragma omp task depend(in:diag[k]) \
                                  depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+                                 depend(inout:column[A_nt-1]) \
+                                 priority( priority_trailing )
                 {
                     // swap rows in A(k:mt-1, kl+1:nt-1)
                     int tag_kl1 = k+1+lookahead + A_mt;
                     internal::permuteRows<target>(
                         Direction::Forward, A.sub(k, A_mt-1, k+1+lookahead, A_nt-1),
-                        pivots.at(k), target_layout, priority_0, tag_kl1, queue_1 );
+                        pivots.at(k), target_layout, priority_trailing, tag_kl1, queue_1 );
 
                     auto Akk = A.sub(k, k, k, k);
                     auto Tkk =
@@ -306,12 +338,13 @@ int64_t getrf_tntpiv(
                         Side::Left,
                         one, std::move( Tkk ),
                              A.sub( k, k, k+1+lookahead, A_nt-1 ),
-                        priority_0, target_layout, queue_1 );
+                        priority_trailing, target_layout, queue_1 );
                 }
 
                 #pragma omp task depend(inout:column[k+1+lookahead]) \
                                  depend(inout:column[A_nt-1]) \
-                                 depend(inout:listBcastMT_token)
+                                 depend(inout:listBcastMT_token) \
+                                 priority( priority_trailing )
                 {
                     // send A(k, kl+1:A_nt-1) across A(k+1:mt-1, kl+1:nt-1)
                     BcastListTag bcast_list;
@@ -328,14 +361,15 @@ int64_t getrf_tntpiv(
 
                 #pragma omp task depend(in:column[k]) \
                                  depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+                                 depend(inout:column[A_nt-1]) \
+                                 priority( priority_trailing )
                 {
                     // A(k+1:mt-1, kl+1:nt-1) -= A(k+1:mt-1, k) * A(k, kl+1:nt-1)
                     internal::gemm<target>(
                         -one, A.sub( k+1, A_mt-1, k, k ),
                               A.sub( k, k, k+1+lookahead, A_nt-1 ),
                         one,  A.sub( k+1, A_mt-1, k+1+lookahead, A_nt-1 ),
-                        host_layout, priority_0, queue_1 );
+                        host_layout, priority_trailing, queue_1 );
                 }
             }
             // pivot to the left
@@ -384,7 +418,7 @@ int64_t getrf_tntpiv(
         A.tileLayoutReset();
     }
     A.clearWorkspace();
-    if (target == Target::Devices) {
+    if (target == Target::Devices && workspace == nullptr) {
         for (int64_t dev = 0; dev < num_devices; ++dev) {
             blas::Queue* queue = A.comm_queue( dev );
             blas::device_free( dwork_array[dev], *queue );
@@ -435,6 +469,11 @@ int64_t getrf_tntpiv(
 ///       Inner blocking to use for panel. Default 16.
 ///     - Option::MaxPanelThreads:
 ///       Number of threads to use for panel. Default omp_get_max_threads()/2.
+///     - Option::TournamentTree:
+///       Reduction tree of tournament pivoting over the panel's ranks.
+///       - Binary: binary tree [default].
+///       - Flat:   the top rank merges every other rank in turn.
+///       - Hybrid: flat within each node, binary between nodes.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
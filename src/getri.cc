@@ -17,13 +17,31 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel inverse of a general matrix.
 /// Generic implementation for any target.
+/// Inversion of U and the solve with L are one task graph.
 /// @ingroup gesv_impl
 ///
-/// todo: This routine is in-place and does not support GPUs.
-///       There is another one (out-of-place) that does.
-///       What if this one is called with Target::Devices?
-///       a) execute on CPUs,
-///       b) error out (not supported)?
+/// $A^{-1} = U^{-1} L^{-1}$ is formed by block rows: block row i of the
+/// inverse solves $X(i, :) L = U^{-1}(i, :)$, which needs only block row i
+/// of $U^{-1}$. U is inverted from the bottom block row up, so the solve
+/// with L of the finished block rows overlaps the inversion of the block
+/// rows above them. The solves are done on groups of block rows that
+/// double in size going up: small groups while the inversion runs, large
+/// groups, with more parallelism, after it ends.
+///
+/// Tasks depend on:
+/// - col[ k ]: column k of U scaled by -U(k, k)^{-1}; chained across k.
+/// - row[ nt ]: updates of the leading block rows and finishing of each
+///   block row; chained across k.
+/// - row[ k ]: block row k of $U^{-1}$ is final.
+/// - lsolve[ 0 ]: L broadcast and solves with L; chained across groups.
+///
+/// The L factor is copied to a workspace W before L is zeroed, and is
+/// broadcast once to all block columns that use it.
+///
+/// The solves with L, like the trsm and trtri of the diagonal tiles of U,
+/// run on the host for every target, since they overlap the inversion of
+/// U, whose updates use the target's queues; only the updates of the
+/// leading block rows of $U^{-1}$ use target.
 ///
 template <Target target, typename scalar_t>
 void getri(
@@ -42,113 +60,212 @@ void getri(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
-    // auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
+    int64_t A_nt = A.nt();
+
+    auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
     auto L = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, A);
 
+    // W holds a copy of L, the lower trapezoid of A.
+    auto W = A.emptyLike();
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > col_vector(A_nt+1);
+    std::vector< uint8_t > row_vector(A_nt+1);
+    std::vector< uint8_t > lsolve_vector(1);
+    uint8_t* col = col_vector.data();
+    uint8_t* row = row_vector.data();
+    uint8_t* lsolve = lsolve_vector.data();
+    SLATE_UNUSED( col );    // Used only by OpenMP
+    SLATE_UNUSED( row );    // Used only by OpenMP
+    SLATE_UNUSED( lsolve ); // Used only by OpenMP
+
+    int tag = 0;
+
+    if (target == Target::Devices) {
+        A.allocateBatchArrays();
+        A.reserveDeviceWorkspace();
+    }
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
     #pragma omp parallel
     #pragma omp master
     {
-        int64_t k = A.nt()-1;
-        {
-            auto Akk = A.sub(k, k, k, k);
-            auto W = Akk.template emptyLike<scalar_t>();
-            W.insertLocalTiles(Target::HostTask);
-
-            // Copy A(k, k) to W.
-            // todo: Copy L(k, k) to W.
-            internal::copy<Target::HostTask>(std::move(Akk), std::move(W));
-
-            // Zero L(k, k).
-            if (L.tileIsLocal(k, k)) {
-                auto Lkk = L(k, k);
-                tile::tzset( zero, Lkk );
-            }
-
-            // send W down col A(0:nt-1, k)
-            W.template tileBcast(
-                0, 0, A.sub(0, A.nt()-1, k, k), layout);
-
-            auto Wkk = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, W);
-            internal::trsm<Target::HostTask>(
-                Side::Right,
-                one, std::move( Wkk ), A.sub(0, A.nt()-1, k, k),
-                priority_0, layout );
-
-            // W is deleted here, releasing its tiles
+        // Copy L to W, then zero L, leaving U in A.
+        for (int64_t k = 0; k < A_nt; ++k) {
+            auto Lk = A.sub(k, A_nt-1, k, k);
+            auto Wk = W.sub(k, A_nt-1, k, k);
+            Wk.insertLocalTiles(Target::HostTask);
+            internal::copy<Target::HostTask>(std::move(Lk), std::move(Wk));
         }
-        --k;
-
-        for (; k >= 0; --k) {
-
-            auto Lk = A.sub(k, A.nt()-1, k, k);
-            auto W = Lk.template emptyLike<scalar_t>();
-            W.insertLocalTiles(Target::HostTask);
-
-            // Copy L(:, k) to W.
-            internal::copy<Target::HostTask>(std::move(Lk), std::move(W));
-
-            // Zero L(k, k).
-            if (L.tileIsLocal(k, k)) {
-                auto Lkk = L(k, k);
-                tile::tzset( zero, Lkk );
-            }
-
-            // Zero L(k+1:A_nt-1, k).
-            for (int64_t i = k+1; i < A.nt(); ++i) {
-                if (L.tileIsLocal(i, k)) {
-                    L(i, k).set(0.0);
+        for (int64_t k = 0; k < A_nt; ++k) {
+            for (int64_t i = k; i < A_nt; ++i) {
+                if (A.tileIsLocal(i, k)) {
+                    #pragma omp task firstprivate(i, k)
+                    {
+                        A.tileGetForWriting(i, k, LayoutConvert(layout));
+                        if (i == k) {
+                            // Zero strictly lower L(k, k).
+                            auto Lkk = L(k, k);
+                            tile::tzset( zero, Lkk );
+                        }
+                        else {
+                            A(i, k).set(zero);
+                        }
+                    }
                 }
             }
+        }
+        #pragma omp taskwait
 
-            // send W across A
+        // send W(j, k) down col A(0:nt-1, j), for j >= k
+        #pragma omp task depend(out:lsolve[0]) firstprivate(tag)
+        {
             BcastList bcast_list_W;
-            for (int64_t i = 1; i < W.mt(); ++i) {
-                // send W(i) down column A(0:nt-1, k+i)
-                bcast_list_W.push_back({i, 0, {A.sub(0, A.nt()-1, k+i, k+i)}});
+            for (int64_t k = 0; k < A_nt; ++k) {
+                for (int64_t j = k; j < A_nt; ++j) {
+                    bcast_list_W.push_back({j, k, {A.sub(0, A_nt-1, j, j)}});
+                }
             }
-            W.template listBcast(bcast_list_W, layout);
-
-            // A(:, k) -= A(:, k+1:nt-1) * W
-            internal::gemmA<Target::HostTask>(
-                -one, A.sub(0, A.nt()-1, k+1, A.nt()-1),
-                      W.sub(1, W.mt()-1, 0, 0),
-                one,  A.sub(0, A.nt()-1, k, k),
-                layout );
-
-            // reduce A(0:nt-1, k)
-            ReduceList reduce_list_A;
-            for (int64_t i = 0; i < A.nt(); ++i) {
-                // recude A(i, k) across A(i, k+1:nt-1)
-                reduce_list_A.push_back({i, k,
-                                          A.sub(i, i, k, k),
-                                          {A.sub(i, i, k+1, A.nt()-1)}
-                                        });
+            W.template listBcast(bcast_list_W, layout, tag);
+        }
+        ++tag;
+
+        // Invert U bottom up; after step k, block row k of U is final.
+        int64_t group_size = 1;
+        int64_t group_end = A_nt - 1;
+        for (int64_t k = A_nt-1; k >= 0; --k) {
+            // A(0:k-1, k) = -A(0:k-1, k) * U(k, k)^{-1}
+            if (k > 0) {
+                #pragma omp task depend(in:col[k+1]) \
+                                 depend(inout:col[k]) firstprivate(tag)
+                {
+                    // send U(k, k) up col A(0:k-1, k)
+                    A.tileBcast(k, k, A.sub(0, k-1, k, k), layout, tag);
+
+                    internal::trsm<Target::HostTask>(
+                        Side::Right,
+                        -one, U.sub(k, k), A.sub(0, k-1, k, k),
+                        priority_0, layout );
+
+                    if (k < A_nt-1) {
+                        BcastList bcast_list_A;
+                        for (int64_t i = 0; i < k; ++i) {
+                            // send A(i, k) across row A(i, k+1:nt-1)
+                            bcast_list_A.push_back(
+                                {i, k, {A.sub(i, i, k+1, A_nt-1)}});
+                        }
+                        A.template listBcast<target>(
+                            bcast_list_A, layout, tag+1);
+                    }
+                }
             }
-            A.template listReduce(reduce_list_A, layout);
-
-            // Release workspace tiles from gemmA
-            A.sub(0, A.nt()-1, k, k).releaseRemoteWorkspace();
-
-            // send W(0, 0) down col A(0:nt-1, k)
-            W.tileBcast(0, 0, A.sub(0, A.nt()-1, k, k), layout);
+            tag += 2;
+
+            // A(0:k-1, k+1:nt-1) += A(0:k-1, k) * A(k, k+1:nt-1)
+            if (k > 0 && k < A_nt-1) {
+                #pragma omp task depend(in:col[k]) \
+                                 depend(inout:row[A_nt]) firstprivate(tag)
+                {
+                    BcastList bcast_list_A;
+                    for (int64_t j = k+1; j < A_nt; ++j) {
+                        // send A(k, j) up col A(0:k-1, j)
+                        bcast_list_A.push_back({k, j, {A.sub(0, k-1, j, j)}});
+                    }
+                    A.template listBcast<target>(bcast_list_A, layout, tag);
+
+                    internal::gemm<target>(
+                        one, A.sub(0, k-1, k, k),
+                             A.sub(k, k, k+1, A_nt-1),
+                        one, A.sub(0, k-1, k+1, A_nt-1),
+                        layout, priority_0 );
+
+                    A.sub(0, k-1, k, k).releaseRemoteWorkspace();
+                    A.sub(k, k, k+1, A_nt-1).releaseRemoteWorkspace();
+                }
+            }
+            ++tag;
+
+            // A(k, k+1:nt-1) = U(k, k)^{-1} * A(k, k+1:nt-1), then invert U(k, k)
+            // Depends on col[k] so trtri doesn't overwrite U(k, k) while the
+            // col task above still uses it; U(k, k) is released here, last.
+            #pragma omp task depend(in:col[k]) \
+                             depend(inout:row[A_nt]) \
+                             depend(inout:row[k]) firstprivate(tag)
+            {
+                if (k < A_nt-1) {
+                    // send U(k, k) across row A(k, k+1:nt-1)
+                    A.tileBcast(k, k, A.sub(k, k, k+1, A_nt-1), layout, tag);
+
+                    internal::trsm<Target::HostTask>(
+                        Side::Left,
+                        one, U.sub(k, k), A.sub(k, k, k+1, A_nt-1),
+                        priority_0, layout );
+                }
 
-            auto Wkk = W.sub(0, 0, 0, 0);
-            auto Tkk = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, Wkk);
-            internal::trsm<Target::HostTask>(
-                Side::Right,
-                one, std::move( Tkk ), A.sub(0, A.nt()-1, k, k),
-                priority_0, layout );
+                internal::trtri<Target::HostTask>(U.sub(k, k));
 
-            // W is deleted here, releasing its tiles
+                A.sub(k, k).releaseRemoteWorkspace();
+            }
+            ++tag;
+
+            // Solve X(k:group_end, :) L = A(k:group_end, :) once the group
+            // of block rows is final.
+            if (k == std::max(group_end - group_size + 1, int64_t(0))) {
+                #pragma omp task depend(in:row[k]) \
+                                 depend(inout:lsolve[0]) \
+                                 firstprivate(tag, group_end)
+                {
+                    for (int64_t j = A_nt-1; j >= 0; --j) {
+                        if (j < A_nt-1) {
+                            // A(k:ge, j) -= A(k:ge, j+1:nt-1) * W(j+1:nt-1, j)
+                            internal::gemmA<Target::HostTask>(
+                                -one, A.sub(k, group_end, j+1, A_nt-1),
+                                      W.sub(j+1, A_nt-1, j, j),
+                                one,  A.sub(k, group_end, j, j),
+                                layout );
+
+                            ReduceList reduce_list_A;
+                            for (int64_t i = k; i <= group_end; ++i) {
+                                // reduce A(i, j) across A(i, j+1:nt-1)
+                                reduce_list_A.push_back({i, j,
+                                    A.sub(i, i, j, j),
+                                    {A.sub(i, i, j+1, A_nt-1)}
+                                });
+                            }
+                            A.template listReduce(reduce_list_A, layout, tag);
+
+                            // Release workspace tiles from gemmA
+                            A.sub(k, group_end, j, j).releaseRemoteWorkspace();
+                        }
+
+                        auto Wjj = TriangularMatrix<scalar_t>(
+                            Uplo::Lower, Diag::Unit, W.sub(j, j, j, j));
+                        internal::trsm<Target::HostTask>(
+                            Side::Right,
+                            one, std::move( Wjj ), A.sub(k, group_end, j, j),
+                            priority_0, layout );
+                    }
+                }
+                group_end = k - 1;
+                group_size *= 2;
+            }
+            ++tag;
         }
 
+        #pragma omp taskwait
+
         // Apply column pivoting.
-        for (int64_t j = A.nt()-1; j >= 0; --j) {
+        for (int64_t j = A_nt-1; j >= 0; --j) {
             internal::permuteRows<Target::HostTask>(
-                Direction::Backward, transpose(A).sub(j, A.nt()-1, 0, A.nt()-1),
+                Direction::Backward, transpose(A).sub(j, A_nt-1, 0, A_nt-1),
                 pivots.at(j), Layout::ColMajor);
         }
+        A.tileUpdateAllOrigin();
     }
+
+    A.releaseWorkspace();
 }
 
 } // namespace impl
@@ -182,6 +299,9 @@ void getri(
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///       With Devices, only the updates of $U^{-1}$ run on the devices; the
+///       solves with L, and the operations on diagonal tiles, run on the
+///       host.
 ///
 /// @ingroup gesv_computational
 ///
@@ -190,10 +310,6 @@ void getri(
     Matrix<scalar_t>& A, Pivots& pivots,
     Options const& opts )
 {
-    // triangular inversion
-    auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
-    trtri(U, opts);
-
     Target target = get_option( opts, Option::Target, Target::HostTask );
 
     switch (target) {
@@ -61,6 +61,11 @@ namespace slate {
 ///       - MethodLU::NoPiv: no pivoting.
 ///         Note pivots vector is currently ignored for NoPiv.
 ///
+///    - Option::MethodTrsm:
+///      Algorithm for the triangular solves; see trsm.
+///      Default trsmA if nrhs <= nb, which keeps the factors in place,
+///      else chosen by the cost model.
+///
 /// @ingroup gesv_computational
 ///
 template <typename scalar_t>
@@ -68,6 +73,9 @@ void getrs(Matrix<scalar_t>& A, Pivots& pivots,
            Matrix<scalar_t>& B,
            Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "getrs", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "getrs", A.mpiComm(), opts );
+
     // Constants
     const scalar_t one  = 1;
 
@@ -80,38 +88,31 @@ void getrs(Matrix<scalar_t>& A, Pivots& pivots,
     auto L = TriangularMatrix<scalar_t>(Uplo::Lower, Diag::Unit, A);
     auto U = TriangularMatrix<scalar_t>(Uplo::Upper, Diag::NonUnit, A);
 
+    Options opts_trsm = MethodTrsm::solve_options( A, B, opts );
+
     if (A.op() == Op::NoTrans) {
         if (method != MethodLU::NoPiv) {
-            // Pivot the right hand side matrix.
-            for (int64_t k = 0; k < B.mt(); ++k) {
-                // swap rows in B(k:mt-1, 0:nt-1)
-                internal::permuteRows<Target::HostTask>(
-                    Direction::Forward, B.sub(k, B.mt()-1, 0, B.nt()-1),
-                    pivots.at(k), Layout::ColMajor);
-            }
+            // Pivot the right hand side matrix, moving each row once
+            // rather than once per panel.
+            internal::permuteRowsAll( Direction::Forward, B, pivots );
         }
 
         // Forward substitution, Y = L^{-1} P B.
-        trsm(Side::Left, one, L, B, opts);
+        trsm(Side::Left, one, L, B, opts_trsm);
 
         // Backward substitution, X = U^{-1} Y.
-        trsm(Side::Left, one, U, B, opts);
+        trsm(Side::Left, one, U, B, opts_trsm);
     }
     else {
         // Forward substitution, Y = U^{-T} B.
-        trsm(Side::Left, one, U, B, opts);
+        trsm(Side::Left, one, U, B, opts_trsm);
 
         // Backward substitution, Xhat = L^{-T} Y.
-        trsm(Side::Left, one, L, B, opts);
+        trsm(Side::Left, one, L, B, opts_trsm);
 
         if (method != MethodLU::NoPiv) {
             // Pivot the right hand side matrix, X = P^T Xhat
-            for (int64_t k = B.mt()-1; k >= 0; --k) {
-                // swap rows in B(k:mt-1, 0:nt-1)
-                internal::permuteRows<Target::HostTask>(
-                    Direction::Backward, B.sub(k, B.mt()-1, 0, B.nt()-1),
-                    pivots.at(k), Layout::ColMajor);
-            }
+            internal::permuteRowsAll( Direction::Backward, B, pivots );
         }
     }
     // todo: return value for errors?
@@ -11,6 +11,7 @@
 #include "internal/internal.hh"
 
 #include <atomic>
+#include <mutex>
 
 namespace slate {
 
@@ -114,6 +115,452 @@ void hb2st_step(
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// @return number of steps in sweep `sweep` of bulge chasing.
+///
+inline int64_t hb2st_nsteps( int64_t n, int64_t band, int64_t sweep )
+{
+    return 2*ceildiv( n - 1 - sweep, band ) - 1;
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// @return last row and column of A updated by step `step` of sweep `sweep`,
+/// as in hb2st_step, so the step touches only block columns up to the one
+/// containing it.
+///
+inline int64_t hb2st_last_row(
+    int64_t n, int64_t band, int64_t sweep, int64_t step )
+{
+    if (step == 0)
+        return std::min( sweep + band, n-1 );
+    int64_t block = step/2;
+    int64_t i = step % 2 == 1 ? (block+1)*band + 1 + sweep
+                              :  block   *band + 1 + sweep;
+    return std::min( i + band - 1, n-1 );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Local part of the bulge chasing, and its messages with neighboring ranks.
+///
+/// If the band's tiles are all local, there are no messages, and the local
+/// part is every step of every sweep. Otherwise, the band must be
+/// distributed by contiguous block columns over a 1D grid, with
+/// band == nb, and hb2st is collective over the ranks of A.
+/// Step `step` of sweep `sweep` is labeled with block column
+///     T = sweep/band + step/2,
+/// and is done by the rank owning block column T. It updates tiles in
+/// block columns T and T+1: in column T+1, the tile above the diagonal,
+/// which is workspace used only by this rank, and tiles (T+1, T+1) and
+/// (T+2, T+1). So at the boundary between the rank owning block column
+/// b-1 and the rank owning b, tiles (b, b) and (b+1, b) are updated by
+/// both. They move between the two ranks as a token: in each sweep, the
+/// left rank's steps touching them precede the right rank's, and before
+/// its steps, a rank receives the tiles if the other rank updated them
+/// last. The left rank also sends the Householder vector of its last step
+/// of the sweep, which the right rank's first step applies. The tiles
+/// start and end on their owner, the right rank.
+///
+/// V's tile for the vectors of steps labeled T must be local on the rank
+/// owning block column T; see heev.
+///
+template <typename scalar_t>
+class Hb2stComm
+{
+public:
+    Hb2stComm( HermitianBandMatrix<scalar_t>& A, Matrix<scalar_t>& V );
+    ~Hb2stComm();
+
+    Hb2stComm( Hb2stComm const& ) = delete;
+    Hb2stComm& operator=( Hb2stComm const& ) = delete;
+
+    /// @return true if this rank has steps to do.
+    bool active() const { return col_begin_ < col_end_; }
+
+    /// @return true if the band is on several ranks.
+    bool distributed() const { return distributed_; }
+
+    /// @return first local step of sweep; local steps may be empty.
+    int64_t firstStep( int64_t sweep ) const
+    {
+        if (! distributed_)
+            return 0;
+        return std::max( int64_t( 0 ), 2*(col_begin_ - sweep/band_) );
+    }
+
+    /// @return last local step of sweep; local steps may be empty.
+    int64_t lastStep( int64_t sweep ) const
+    {
+        int64_t nsteps = hb2st_nsteps( n_, band_, sweep );
+        if (! distributed_)
+            return nsteps - 1;
+        return std::min( nsteps - 1, 2*(col_end_ - sweep/band_) - 1 );
+    }
+
+    void start();
+    void before( int64_t sweep, int64_t step, ProgressVector& progress );
+    void after( int64_t sweep, int64_t step );
+    void finish();
+
+private:
+    /// Messages at the boundary with one neighbor.
+    struct Boundary {
+        int rank = -1;      ///< neighbor, or -1 if none
+        int64_t col = 0;    ///< shared block column b
+        int64_t label = 0;  ///< label of this rank's steps touching it
+        int send_tag = 0;
+        int recv_tag = 0;
+        std::vector<uint8_t> recv_before;   ///< per sweep
+        std::vector<uint8_t> send_after;    ///< per sweep
+        std::vector<int64_t> prev_sweep;    ///< per sweep, or -1
+        bool send_initial = false;
+        bool recv_final = false;
+        std::vector<scalar_t> send_buffer;
+        std::vector<scalar_t> recv_buffer;
+        MPI_Request request = MPI_REQUEST_NULL;
+    };
+
+    /// @return true if sweep has a step labeled T.
+    bool touches( int64_t sweep, int64_t T ) const
+    {
+        int64_t k = sweep / band_;
+        return k <= T && T <= k + (hb2st_nsteps( n_, band_, sweep ) - 1)/2;
+    }
+
+    /// @return first step of sweep labeled T.
+    int64_t firstStepOf( int64_t sweep, int64_t T ) const
+    {
+        return 2*(T - sweep/band_);
+    }
+
+    /// @return last step of sweep labeled T.
+    int64_t lastStepOf( int64_t sweep, int64_t T ) const
+    {
+        return std::min( 2*(T - sweep/band_) + 1,
+                         hb2st_nsteps( n_, band_, sweep ) - 1 );
+    }
+
+    /// @return index of V's tile applied by steps of sweep labeled T.
+    int64_t vIndex( int64_t sweep, int64_t T ) const
+    {
+        int64_t k = sweep / band_;
+        return k*nt_ - k*(k - 1)/2 + T - k;
+    }
+
+    void setup( Boundary& bdry, int64_t col, bool left_of_col );
+    void send( Boundary& bdry, int64_t sweep, bool with_v );
+    void recv( Boundary& bdry, int64_t sweep, bool with_v );
+
+    HermitianBandMatrix<scalar_t> A_;
+    Matrix<scalar_t> V_;
+    int64_t n_;
+    int64_t nt_;
+    int64_t band_;
+    int64_t col_begin_;
+    int64_t col_end_;
+    int64_t v_workspace_;
+    bool distributed_;
+    MPI_Comm mpi_comm_;
+    Boundary left_;
+    Boundary right_;
+};
+
+//------------------------------------------------------------------------------
+/// Finds the local block columns and neighbors. Collective over the ranks
+/// of A if the band is distributed.
+///
+template <typename scalar_t>
+Hb2stComm<scalar_t>::Hb2stComm(
+    HermitianBandMatrix<scalar_t>& A, Matrix<scalar_t>& V )
+    : A_( A ),
+      V_( V ),
+      n_( A.n() ),
+      nt_( A.nt() ),
+      band_( A.bandwidth() ),
+      col_begin_( A.nt() ),
+      col_end_( 0 ),
+      v_workspace_( -1 ),
+      distributed_( false ),
+      mpi_comm_( MPI_COMM_NULL )
+{
+    for (int64_t j = 0; j < nt_; ++j) {
+        if (A.tileIsLocal( j, j )) {
+            col_begin_ = std::min( col_begin_, j );
+            col_end_   = std::max( col_end_, j+1 );
+        }
+        else {
+            distributed_ = true;
+        }
+    }
+    if (! active())
+        col_begin_ = col_end_ = 0;
+    if (! distributed_)
+        return;
+
+    slate_error_if( band_ != A.tileNb( 0 ) );
+    for (int64_t j = col_begin_; j < col_end_; ++j) {
+        // Contiguous block columns, each on one rank.
+        slate_error_if( ! A.tileIsLocal( j, j ) );
+        slate_error_if( j+1 < A.mt() && ! A.tileIsLocal( j+1, j ) );
+    }
+    slate_mpi_call( MPI_Comm_dup( A.mpiComm(), &mpi_comm_ ) );
+
+    if (active() && col_begin_ > 0) {
+        left_.rank = A.tileRank( col_begin_-1, col_begin_-1 );
+        setup( left_, col_begin_, false );
+    }
+    if (active() && col_end_ < nt_) {
+        right_.rank = A.tileRank( col_end_, col_end_ );
+        setup( right_, col_end_, true );
+
+        // Workspace for the shared tiles, received before the first use.
+        for (int64_t i = col_end_; i <= std::min( col_end_+1, A.mt()-1 ); ++i)
+            A.tileInsertWorkspace( i, col_end_ );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+Hb2stComm<scalar_t>::~Hb2stComm()
+{
+    if (mpi_comm_ != MPI_COMM_NULL)
+        MPI_Comm_free( &mpi_comm_ );
+}
+
+//------------------------------------------------------------------------------
+/// Determines, for each sweep, whether the tiles of block column col must
+/// be received before this rank's steps touching them, and sent after,
+/// from the order in which the left and right ranks touch them.
+///
+/// @param[in] left_of_col
+///     True if this rank owns block column col-1 (it is the left rank),
+///     false if it owns col.
+///
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::setup(
+    Boundary& bdry, int64_t col, bool left_of_col )
+{
+    int64_t nsweeps = n_ - 1;
+    bdry.col = col;
+    bdry.label = left_of_col ? col-1 : col;
+    bdry.send_tag = left_of_col ? 0 : 1;
+    bdry.recv_tag = left_of_col ? 1 : 0;
+    bdry.recv_before.assign( nsweeps, false );
+    bdry.send_after.assign( nsweeps, false );
+    bdry.prev_sweep.assign( nsweeps, -1 );
+
+    // Sequence of steps touching col: (sweep, done by the left rank).
+    std::vector< std::pair<int64_t, bool> > events;
+    for (int64_t sweep = 0; sweep < nsweeps && sweep/band_ <= col; ++sweep) {
+        if (touches( sweep, col-1 ))
+            events.push_back( { sweep, true } );
+        if (touches( sweep, col ))
+            events.push_back( { sweep, false } );
+    }
+
+    // Tiles are held initially and finally by their owner, the right rank.
+    int64_t prev_mine = -1;
+    int64_t nevents = events.size();
+    for (int64_t e = 0; e < nevents; ++e) {
+        int64_t sweep = events[ e ].first;
+        bool by_left  = events[ e ].second;
+        if (by_left != left_of_col)
+            continue;
+        bool prev_left = e > 0         && events[ e-1 ].second;
+        bool next_left = e+1 < nevents && events[ e+1 ].second;
+        bdry.recv_before[ sweep ] = prev_left != by_left;
+        bdry.send_after[ sweep ]  = next_left != by_left;
+        bdry.prev_sweep[ sweep ]  = prev_mine;
+        prev_mine = sweep;
+    }
+    if (! left_of_col && nevents > 0) {
+        bdry.send_initial = events.front().second;
+        bdry.recv_final   = events.back().second;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Sends the shared tiles, and if with_v, the Householder vector of sweep
+/// applied by the neighbor's first step. Waits for the previous send on
+/// this boundary, which was received before the neighbor sent back.
+///
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::send( Boundary& bdry, int64_t sweep, bool with_v )
+{
+    internal::comm_wait( &bdry.request );
+
+    auto& buffer = bdry.send_buffer;
+    buffer.clear();
+    int64_t col = bdry.col;
+    for (int64_t i = col; i <= std::min( col+1, A_.mt()-1 ); ++i) {
+        auto T = A_( i, col );
+        for (int64_t j = 0; j < T.nb(); ++j)
+            buffer.insert( buffer.end(), &T.at( 0, j ), &T.at( 0, j ) + T.mb() );
+    }
+    if (with_v) {
+        auto T = V_( 0, vIndex( sweep, col ) );
+        int64_t vj = sweep % band_;
+        buffer.insert( buffer.end(), &T.at( 0, vj ), &T.at( 0, vj ) + T.mb() );
+    }
+    slate_mpi_call(
+        MPI_Isend( buffer.data(), int( buffer.size() ),
+                   mpi_type<scalar_t>::value, bdry.rank, bdry.send_tag,
+                   mpi_comm_, &bdry.request ) );
+}
+
+//------------------------------------------------------------------------------
+/// Receives the shared tiles, and if with_v, the Householder vector of
+/// sweep, into a workspace tile of V that replaces the previous one.
+///
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::recv( Boundary& bdry, int64_t sweep, bool with_v )
+{
+    int64_t col = bdry.col;
+    int64_t i_end = std::min( col+1, A_.mt()-1 );
+    int64_t count = 0;
+    for (int64_t i = col; i <= i_end; ++i)
+        count += A_.tileMb( i ) * A_.tileNb( col );
+    if (with_v)
+        count += V_.tileMb( 0 );
+
+    auto& buffer = bdry.recv_buffer;
+    buffer.resize( count );
+    slate_mpi_call(
+        MPI_Recv( buffer.data(), int( count ), mpi_type<scalar_t>::value,
+                  bdry.rank, bdry.recv_tag, mpi_comm_, MPI_STATUS_IGNORE ) );
+
+    scalar_t* ptr = buffer.data();
+    for (int64_t i = col; i <= i_end; ++i) {
+        auto T = A_( i, col );
+        for (int64_t j = 0; j < T.nb(); ++j) {
+            std::copy( ptr, ptr + T.mb(), &T.at( 0, j ) );
+            ptr += T.mb();
+        }
+    }
+    if (with_v) {
+        int64_t index = vIndex( sweep, col );
+        if (! V_.tileExists( 0, index )) {
+            if (v_workspace_ >= 0)
+                V_.tileErase( 0, v_workspace_ );
+            V_.tileInsertWorkspace( 0, index );
+            v_workspace_ = index;
+        }
+        auto T = V_( 0, index );
+        std::copy( ptr, ptr + T.mb(), &T.at( 0, sweep % band_ ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Sends the owner's shared tiles to the left rank, if it touches them first.
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::start()
+{
+    if (left_.rank >= 0 && left_.send_initial)
+        send( left_, -1, false );
+}
+
+//------------------------------------------------------------------------------
+/// Before a local step: receives shared tiles needed by it.
+/// Called by the thread doing the step.
+///
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::before(
+    int64_t sweep, int64_t step, ProgressVector& progress )
+{
+    for (Boundary* bdry : { &left_, &right_ }) {
+        if (bdry->rank >= 0 && bdry->recv_before[ sweep ]
+            && step == firstStepOf( sweep, bdry->label ))
+        {
+            // Finish this rank's previous steps touching the tiles,
+            // which also sent them.
+            int64_t prev = bdry->prev_sweep[ sweep ];
+            if (prev >= 0) {
+                int64_t depend = lastStepOf( prev, bdry->label );
+                while (progress.at( prev ).load() < depend) {}
+            }
+            // From the left, with the vector of the left's last step,
+            // if it was in this sweep.
+            bool with_v = bdry == &left_ && touches( sweep, bdry->col-1 );
+            recv( *bdry, sweep, with_v );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// After a local step: sends shared tiles if it was this rank's last step
+/// touching them before the neighbor's.
+/// Called by the thread doing the step.
+///
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::after( int64_t sweep, int64_t step )
+{
+    for (Boundary* bdry : { &left_, &right_ }) {
+        if (bdry->rank >= 0 && bdry->send_after[ sweep ]
+            && step == lastStepOf( sweep, bdry->label ))
+        {
+            // To the right, with the vector, if the right is next in
+            // this sweep.
+            bool with_v = bdry == &right_ && touches( sweep, bdry->col );
+            send( *bdry, sweep, with_v );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Receives the owner's shared tiles back from the left rank, if it touched
+/// them last; completes sends and releases V's workspace.
+template <typename scalar_t>
+void Hb2stComm<scalar_t>::finish()
+{
+    if (left_.rank >= 0 && left_.recv_final)
+        recv( left_, -1, false );
+    for (Boundary* bdry : { &left_, &right_ })
+        internal::comm_wait( &bdry->request );
+    if (v_workspace_ >= 0)
+        V_.tileErase( 0, v_workspace_ );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// When the Householder vectors are discarded, inserts the tile of V that
+/// step `step` of sweep `sweep` writes or reads, unless an earlier step or
+/// sweep of the same group of band sweeps has inserted it already.
+/// Steps of a group reach each tile in order, so there is no race.
+///
+template <typename scalar_t>
+void hb2st_v_insert(
+    Matrix<scalar_t>& V, int64_t nt, int64_t band,
+    int64_t sweep, int64_t step)
+{
+    const scalar_t zero = 0.0;
+
+    int64_t k = sweep / band;
+    int64_t index = k*nt - k*(k - 1)/2 + (step + 1)/2;
+    if (! V.tileExists( 0, index )) {
+        auto T = V.tileInsertWorkspace( 0, index );
+        lapack::laset(
+            lapack::MatrixType::General, T.mb(), T.nb(),
+            zero, zero, T.data(), T.stride());
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// When the Householder vectors are discarded, erases this rank's tiles of
+/// V for group k of band sweeps, once its sweeps are done.
+///
+template <typename scalar_t>
+void hb2st_v_erase( Matrix<scalar_t>& V, int64_t nt, int64_t k )
+{
+    int64_t vindex = k*nt - k*(k - 1)/2;
+    for (int64_t c = 0; c < nt - k; ++c) {
+        if (V.tileIsLocal( 0, vindex + c ) && V.tileExists( 0, vindex + c ))
+            V.tileErase( 0, vindex + c );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// @internal
 /// Implements multithreaded tridiagonal bulge chasing.
@@ -126,6 +573,9 @@ void hb2st_step(
 ///     Matrix of Householder reflectors produced in the process.
 ///     Dimension 2*band-by-XYZ todo
 ///
+/// @param[in,out] comm
+///     Local steps of each sweep, and messages with neighboring ranks.
+///
 /// @param[in] thread_rank
 ///     rank of this thread
 ///
@@ -135,17 +585,43 @@ void hb2st_step(
 /// @param[in] progress
 ///     progress table for synchronizing threads
 ///
+/// @param[in] prepare
+///     If set, called as prepare( j ) before the first step touching block
+///     column j, to wait until the band's column j is available; see hb2st.
+///     Assumes uniform tile size.
+///
+/// @param[in] discard
+///     If true, tiles of V are inserted as steps need them and erased
+///     once their group of band sweeps is done; see hb2st.
+///
 template <typename scalar_t>
 void hb2st_run(
     HermitianBandMatrix<scalar_t>& A,
     Matrix<scalar_t>& V,
+    Hb2stComm<scalar_t>& comm,
     int thread_rank, int thread_size,
-    ProgressVector& progress)
+    ProgressVector& progress,
+    std::function<void (int64_t)> const& prepare,
+    bool discard)
 {
     int64_t n = A.n();
+    int64_t nt = A.nt();
+    int64_t nb = A.tileNb(0);
     int64_t band = A.bandwidth();
     int64_t pass_size = ceildiv(thread_size, 3);
 
+    // @return true if sweep is the last in its group of band sweeps with
+    // local steps. Local sweeps of a group are a prefix of it, and each
+    // waits for the previous one to finish before its last step.
+    auto last_local_in_group = [&]( int64_t sweep ) {
+        int64_t next = sweep + 1;
+        return next == n-1 || next % band == 0
+               || comm.firstStep( next ) > comm.lastStep( next );
+    };
+
+    // Block columns prepared so far by this thread.
+    int64_t prepared_col = -1;
+
     // Thread that starts each pass.
     int64_t start_thread = 0;
 
@@ -155,31 +631,45 @@ void hb2st_run(
     for (int64_t pass = 0; pass < n-1; pass += pass_size) {
         int64_t sweep_end = std::min(pass + pass_size, n-1);
         // Steps in first sweep of this pass; later sweeps may have fewer steps.
-        int64_t nsteps_pass = 2*ceildiv(n - 1 - pass, band) - 1;
+        int64_t nsteps_pass = hb2st_nsteps(n, band, pass);
         // Step that this thread starts on, in this pass.
         int64_t step_begin = (thread_rank - start_thread + thread_size) % thread_size;
         for (int64_t step = step_begin; step < nsteps_pass; step += thread_size) {
             for (int64_t sweep = pass; sweep < sweep_end; ++sweep) {
-                int64_t nsteps_sweep = 2*ceildiv(n - 1 - sweep, band) - 1;
-                int64_t nsteps_last  = 2*ceildiv(n - 1 - (sweep-1), band) - 1;
+                // Local steps of this sweep; all steps if not distributed.
+                int64_t first = comm.firstStep(sweep);
+                int64_t last  = comm.lastStep(sweep);
 
-                if (step < nsteps_sweep) {
-                    if (sweep > 0) {
+                if (step >= first && step <= last) {
+                    if (sweep > 0
+                        && comm.firstStep(sweep-1) <= comm.lastStep(sweep-1)) {
                         // Wait until sweep-1 is two tasks ahead,
-                        // or sweep-1 is finished.
-                        int64_t depend = std::min(step+2, nsteps_last-1);
+                        // or sweep-1 is finished (locally).
+                        int64_t depend = std::min(step+2, comm.lastStep(sweep-1));
                         while (progress.at(sweep-1).load() < depend) {}
                     }
-                    if (step > 0) {
+                    if (step > first) {
                         // Wait until step-1 is done in this sweep.
                         while (progress.at(sweep).load() < step-1) {}
                     }
+                    if (prepare) {
+                        int64_t col = hb2st_last_row(n, band, sweep, step) / nb;
+                        while (prepared_col < col)
+                            prepare(++prepared_col);
+                    }
                     ///printf( "tid %d pass %lld, task %lld, %lld\n",
                     //         thread_rank, pass, sweep, step );
+                    comm.before(sweep, step, progress);
+                    if (discard)
+                        hb2st_v_insert(V, nt, band, sweep, step);
                     hb2st_step(A, V, sweep, step);
+                    comm.after(sweep, step);
 
                     // Mark step as done.
                     progress.at(sweep).store(step);
+
+                    if (discard && step == last && last_local_in_group(sweep))
+                        hb2st_v_erase(V, nt, sweep / band);
                 }
             }
         }
@@ -188,97 +678,241 @@ void hb2st_run(
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Tridiagonal bulge chasing on a GPU, in one kernel launch.
+/// The band, including zeros for the bulges, is copied to LAPACK-style band
+/// storage on the device, reduced by device::hb2st, and copied back with
+/// the Householder vectors. Requires all tiles of A and V on this rank,
+/// and band equal to the tile size.
+///
+/// @param[in,out] A
+///     The band Hermitian matrix A, with workspace tiles set up as in hb2st.
+///
+/// @param[out] V
+///     Matrix of Householder reflectors produced in the process.
+///
+template <typename scalar_t>
+void hb2st_device(
+    HermitianBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V)
+{
+    int64_t n = A.n();
+    int64_t nt = A.nt();
+    int64_t band = A.bandwidth();
+
+    int device = A.tileDevice( 0, 0 );
+    blas::Queue* queue = A.compute_queue( device );
+
+    // A(i, j), for -band < i - j < 2*band, is in dAB[ band-1 + i - j + j*ldab ],
+    // so tile (i, j), including the upper triangle of diagonal tiles,
+    // is a 2D copy with leading dimension ldab-1. The kernel uses only
+    // i - j >= 0.
+    int64_t ldab = 3*band - 1;
+    int64_t ldv  = V.m();
+    scalar_t* dAB = blas::device_malloc<scalar_t>( ldab*n, *queue );
+    scalar_t* dV  = blas::device_malloc<scalar_t>( ldv*V.n(), *queue );
+    int* dprogress = blas::device_malloc<int>( n, *queue );
+    blas::device_memset( dAB, 0, ldab*n, *queue );
+    blas::device_memset( dV,  0, ldv*V.n(), *queue );
+    blas::device_memset( dprogress, 0xff, n, *queue );  // -1
+
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = j; i < std::min( j+2, nt ); ++i) {
+            auto T = A( i, j );
+            blas::device_copy_matrix(
+                T.mb(), T.nb(), T.data(), T.stride(),
+                &dAB[ band-1 + i*band + j*band*(ldab-1) ], ldab-1, *queue );
+        }
+    }
+
+    device::hb2st( n, band, nt, &dAB[ band-1 ], ldab, dV, ldv,
+                   dprogress, *queue );
+
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = j; i < std::min( j+2, nt ); ++i) {
+            auto T = A( i, j );
+            blas::device_copy_matrix(
+                T.mb(), T.nb(), &dAB[ band-1 + i*band + j*band*(ldab-1) ],
+                ldab-1, T.data(), T.stride(), *queue );
+        }
+    }
+    for (int64_t t = 0; t < V.nt(); ++t) {
+        auto T = V( 0, t );
+        blas::device_copy_matrix(
+            T.mb(), T.nb(), &dV[ t*band*ldv ], ldv,
+            T.data(), T.stride(), *queue );
+    }
+    queue->sync();
+
+    blas::device_free( dAB, *queue );
+    blas::device_free( dV, *queue );
+    blas::device_free( dprogress, *queue );
+}
+
 //------------------------------------------------------------------------------
 /// @internal
 /// Reduces a band Hermitian matrix to a tridiagonal matrix using bulge chasing.
+/// If band_wait is set, block columns of the band are waited on as the
+/// steps reach them, instead of all being available on entry.
 /// @ingroup heev_impl
 ///
 template <Target target, typename scalar_t>
 void hb2st(
     HermitianBandMatrix<scalar_t>& A,
     Matrix<scalar_t>& V,
+    std::function<void (int64_t)> const& band_wait,
     Options const& opts )
 {
     const scalar_t zero = 0.0;
 
     int64_t n = A.n();
-    int64_t band = A.bandwidth();
 
     ProgressVector progress(n-1);
     for (int64_t i = 0; i < n-1; ++i)
         progress.at(i).store(-1);
 
-    set(zero, V);
+    // If V is empty, the Householder vectors are discarded, e.g., for
+    // eigenvalues only. V_work then has V's layout from heev, but its
+    // tiles exist only while their group of band sweeps is in progress.
+    bool discard = V.n() == 0;
+    Matrix<scalar_t> V_work = V;
+    if (discard) {
+        int64_t nb = A.tileNb( 0 );
+        int64_t nt = A.nt();
+        auto V_ranks = std::make_shared< std::vector<int> >();
+        V_ranks->reserve( nt*(nt + 1)/2 );
+        for (int64_t k = 0; k < nt; ++k) {
+            for (int64_t c = 0; c < nt - k; ++c) {
+                int64_t col = k + std::max( c-1, int64_t( 0 ) );
+                V_ranks->push_back( A.tileRank( col, col ) );
+            }
+        }
+        std::function<int (func::ij_tuple)> tileRank_V
+            = [V_ranks]( func::ij_tuple ij ) {
+                return V_ranks->at( std::get<1>( ij ) );
+            };
+        V_work = Matrix<scalar_t>(
+            2*nb, nt*(nt + 1)/2*nb,
+            func::uniform_blocksize( 2*nb, 2*nb ),
+            func::uniform_blocksize( nt*(nt + 1)/2*nb, nb ),
+            tileRank_V, A.tileDeviceFunc(), A.mpiComm() );
+    }
+    else {
+        set(zero, V);
+    }
+
+    // Collective if the band is distributed.
+    impl::Hb2stComm<scalar_t> comm( A, V_work );
 
-    // Insert workspace tiles needed for fill-in in bulge chasing
-    // and set tile entries outside the band to 0.
+    // Insert workspace tiles needed for fill-in in bulge chasing.
     // todo: should release these tiles when done
     // WARNING: assumes lower matrix, todo:
-    int jj = 0; // col index
-    for (int j = 0; j < A.nt(); ++j) {
-        int ii = 0; // row index
-        for (int i = 0; i < A.mt(); ++i) {
-            if (A.tileIsLocal(i, j)
-                && (ii == jj
-                    || (ii > jj && ii - (jj + A.tileNb(j) - 1) <= band + 1) ) )
-            {
-                if (i == j && j < A.nt()-1) {
-                    auto tile = A.tileInsertWorkspace( i, j+1 );
-                    A.tileModified( i, j+1 );
-                    lapack::laset(
-                        lapack::MatrixType::General, tile.mb(), tile.nb(),
-                        zero, zero, tile.data(), tile.stride());
-                }
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        if (! A.tileIsLocal(j, j))
+            continue;
 
-                if (j > 0 && i == j + 1) {
-                    auto tile = A.tileInsertWorkspace( i, j-1 );
-                    A.tileModified( i, j-1 );
-                    lapack::laset(
-                        lapack::MatrixType::General, tile.mb(), tile.nb(),
-                        zero, zero, tile.data(), tile.stride());
-                }
+        // Above the diagonal, updated by steps with diagonal blocks
+        // straddling tiles j and j+1.
+        if (j < A.nt()-1) {
+            auto tile = A.tileInsertWorkspace( j, j+1 );
+            A.tileModified( j, j+1 );
+            lapack::laset(
+                lapack::MatrixType::General, tile.mb(), tile.nb(),
+                zero, zero, tile.data(), tile.stride());
+        }
 
-                if (i == j) {
-                    auto Aij = A(i, j);
-                    Aij.uplo(Uplo::Upper);
-                    tile::tzset( zero, Aij );
-                }
+        // Fill-in below the band.
+        if (j+2 < A.mt()) {
+            auto tile = A.tileInsertWorkspace( j+2, j );
+            A.tileModified( j+2, j );
+            lapack::laset(
+                lapack::MatrixType::General, tile.mb(), tile.nb(),
+                zero, zero, tile.data(), tile.stride());
+        }
+    }
 
-                if (i == j + 1) {
-                    auto Aij = A(i, j);
-                    Aij.uplo(Uplo::Lower);
-                    tile::tzset( zero, Aij );
-                }
+    // Once block column j of the band is available, set its tile entries
+    // outside the band to 0. Only the owner does; the left neighbor gets
+    // the boundary tiles from it.
+    std::vector<std::once_flag> prepared( A.nt() );
+    std::function<void (int64_t)> prepare = [&]( int64_t j ) {
+        if (! A.tileIsLocal(j, j))
+            return;
+
+        std::call_once( prepared[ j ], [&] {
+            if (band_wait)
+                band_wait( j );
+
+            auto Ajj = A(j, j);
+            Ajj.uplo(Uplo::Upper);
+            tile::tzset( zero, Ajj );
+
+            if (j+1 < A.mt()) {
+                auto Aij = A(j+1, j);
+                Aij.uplo(Uplo::Lower);
+                tile::tzset( zero, Aij );
             }
-            ii += A.tileMb(i);
+        } );
+    };
+    if (! band_wait) {
+        for (int64_t j = 0; j < A.nt(); ++j)
+            prepare( j );
+        prepare = nullptr;
+    }
+
+    bool on_device = target == Target::Devices && ! comm.distributed()
+                     && A.tileIsLocal( 0, 0 ) && A.num_devices() > 0
+                     && A.tileNb( 0 ) == A.bandwidth()
+                     && ! discard
+                     && V.mt() == 1 && V.tileNb( 0 ) == A.bandwidth();
+    if (on_device) {
+        if (prepare) {
+            for (int64_t j = 0; j < A.nt(); ++j)
+                prepare( j );
         }
-        jj += A.tileNb(j);
+        hb2st_device( A, V );
     }
+    else if (comm.active()) {
+        if (prepare) {
+            // start may send the first local block column to the left.
+            for (int64_t j = 0; j < A.nt(); ++j) {
+                if (A.tileIsLocal(j, j)) {
+                    prepare( j );
+                    break;
+                }
+            }
+        }
+        comm.start();
 
-    // set min number for omp nested active parallel regions
-    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+        // set min number for omp nested active parallel regions
+        slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
-    #pragma omp parallel
-    #pragma omp master
-    {
-        int thread_size = omp_get_max_threads();
-
-        #if 1
-            // Launching new threads for the band reduction guarantees progress.
-            // This should never deadlock, but may be detrimental to performance.
-            #pragma omp parallel for \
-                        num_threads(thread_size) \
-                        shared(V, progress)
-        #else
-            // Issuing panel operation as tasks may cause a deadlock.
-            #pragma omp taskloop \
-                        num_tasks(thread_size) \
-                        shared(V, progress)
-        #endif
-        for (int thread_rank = 0; thread_rank < thread_size; ++thread_rank) {
-            hb2st_run(A, V, thread_rank, thread_size, progress);
+        #pragma omp parallel
+        #pragma omp master
+        {
+            int thread_size = omp_get_max_threads();
+
+            #if 1
+                // Launching new threads for the band reduction guarantees progress.
+                // This should never deadlock, but may be detrimental to performance.
+                #pragma omp parallel for \
+                            num_threads(thread_size) \
+                            shared(V_work, progress, comm, prepare)
+            #else
+                // Issuing panel operation as tasks may cause a deadlock.
+                #pragma omp taskloop \
+                            num_tasks(thread_size) \
+                            shared(V_work, progress, comm, prepare)
+            #endif
+            for (int thread_rank = 0; thread_rank < thread_size; ++thread_rank) {
+                hb2st_run(A, V_work, comm, thread_rank, thread_size, progress,
+                          prepare, discard);
+            }
+            #pragma omp taskwait
         }
-        #pragma omp taskwait
+
+        comm.finish();
     }
 
     // Now that chasing is over, matrix is reduced to symmetric tridiagonal.
@@ -290,6 +924,19 @@ void hb2st(
 //------------------------------------------------------------------------------
 /// Reduces a band Hermitian matrix to a bidiagonal matrix using bulge chasing.
 ///
+/// If A's tiles are all local, runs on the calling rank only. Otherwise,
+/// A must be lower, with bandwidth equal to its tile size, distributed by
+/// contiguous block columns over a 1D grid; the call is then collective
+/// over A's ranks, which chase bulges in a pipeline, exchanging the tiles
+/// at their boundaries with neighbors after each sweep. Each tile of V
+/// must be on the rank owning the block column whose steps write it, as
+/// set up in heev.
+///
+/// If only eigenvalues are needed, pass an empty V, e.g., Matrix<scalar_t>().
+/// The Householder vectors are then discarded: each rank holds only the
+/// tiles of V for the groups of band sweeps in progress, instead of its
+/// O(n^2/p) share of all of V.
+///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///     One of float, double, std::complex<float>, std::complex<double>.
@@ -300,6 +947,7 @@ void hb2st(
 /// @param[out] V
 ///     Matrix of Householder reflectors produced in the process.
 ///     Dimension 2*band-by-XYZ todo
+///     If empty, the reflectors are discarded, e.g., for eigenvalues only.
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
@@ -308,7 +956,41 @@ void hb2st(
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   bulge chasing kernel on GPU device, if the band is
+///         on one rank and its bandwidth is the tile size; otherwise as
+///         HostTask.
+///
+/// @ingroup heev_computational
+///
+template <typename scalar_t>
+void hb2st(
+    HermitianBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    Options const& opts)
+{
+    hb2st( A, V, std::function<void (int64_t)>(), opts );
+}
+
+//------------------------------------------------------------------------------
+/// Reduces a band Hermitian matrix to a bidiagonal matrix using bulge
+/// chasing, as above, while the band is still being computed, e.g., by
+/// he2hb; see heev with Option::Pipeline. Each step waits only for the
+/// block columns of the band it touches, so the first sweeps progress
+/// while later block columns are produced. A must have uniform tile size.
+///
+/// @param[in,out] A
+///     The band Hermitian matrix A, as above. Its block column j, tiles
+///     A(j, j) and A(j+1, j), need be set only once band_wait( j ) returns.
+///
+/// @param[out] V
+///     Matrix of Householder reflectors produced in the process.
+///
+/// @param[in] band_wait
+///     Called as band_wait( j ) on the rank owning block column j of A,
+///     once per j, from any thread; returns once that block column is set.
+///
+/// @param[in] opts
+///     Additional options, as above.
 ///
 /// @ingroup heev_computational
 ///
@@ -316,6 +998,7 @@ template <typename scalar_t>
 void hb2st(
     HermitianBandMatrix<scalar_t>& A,
     Matrix<scalar_t>& V,
+    std::function<void (int64_t)> const& band_wait,
     Options const& opts)
 {
     Target target = get_option( opts, Option::Target, Target::HostTask );
@@ -323,16 +1006,16 @@ void hb2st(
     switch (target) {
         case Target::Host:
         case Target::HostTask:
-            impl::hb2st<Target::HostTask>(A, V, opts);
+            impl::hb2st<Target::HostTask>(A, V, band_wait, opts);
             break;
         case Target::HostNest:
-            impl::hb2st<Target::HostNest>(A, V, opts);
+            impl::hb2st<Target::HostNest>(A, V, band_wait, opts);
             break;
         case Target::HostBatch:
-            impl::hb2st<Target::HostBatch>(A, V, opts);
+            impl::hb2st<Target::HostBatch>(A, V, band_wait, opts);
             break;
         case Target::Devices:
-            impl::hb2st<Target::Devices>(A, V, opts);
+            impl::hb2st<Target::Devices>(A, V, band_wait, opts);
             break;
     }
 }
@@ -345,22 +1028,50 @@ void hb2st<float>(
     Matrix<float>& V,
     Options const& opts);
 
+template
+void hb2st<float>(
+    HermitianBandMatrix<float>& A,
+    Matrix<float>& V,
+    std::function<void (int64_t)> const& band_wait,
+    Options const& opts);
+
 template
 void hb2st<double>(
     HermitianBandMatrix<double>& A,
     Matrix<double>& V,
     Options const& opts);
 
+template
+void hb2st<double>(
+    HermitianBandMatrix<double>& A,
+    Matrix<double>& V,
+    std::function<void (int64_t)> const& band_wait,
+    Options const& opts);
+
 template
 void hb2st< std::complex<float> >(
     HermitianBandMatrix< std::complex<float> >& A,
     Matrix< std::complex<float> >& V,
     Options const& opts);
 
+template
+void hb2st< std::complex<float> >(
+    HermitianBandMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& V,
+    std::function<void (int64_t)> const& band_wait,
+    Options const& opts);
+
+template
+void hb2st< std::complex<double> >(
+    HermitianBandMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& V,
+    Options const& opts);
+
 template
 void hb2st< std::complex<double> >(
     HermitianBandMatrix< std::complex<double> >& A,
     Matrix< std::complex<double> >& V,
+    std::function<void (int64_t)> const& band_wait,
     Options const& opts);
 
 } // namespace slate
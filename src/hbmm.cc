@@ -5,6 +5,7 @@
 
 #include "slate/slate.hh"
 #include "internal/internal.hh"
+#include "internal/internal_band.hh"
 
 namespace slate {
 
@@ -81,6 +82,49 @@ void hbmm(
     // todo: initially, assume fixed size, square tiles for simplicity
     int64_t kdt = ceildiv( kd, A.tileNb(0) );
 
+    // Narrow band on devices: one batch per window of block columns of A.
+    if (target == Target::Devices
+        && kdt <= internal::band_window_max_tiles
+        && B.op() == Op::NoTrans && C.op() == Op::NoTrans) {
+        using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+        bool lower = A.uplo() == Uplo::Lower;
+        // A(i, k) is stored in the lower or upper triangle,
+        // else A(i, k) = A(k, i)^H.
+        auto stored = [lower] (int64_t i, int64_t k) {
+            bool in_triangle = lower ? i >= k : i <= k;
+            return in_triangle ? ij_tuple( i, k ) : ij_tuple( k, i );
+        };
+        internal::band_window_mm(
+            alpha, A, B, beta, C, kdt, kdt, stored,
+            [&] (int64_t i, int64_t k, Tile<scalar_t>& T) {
+                auto ij = stored( i, k );
+                int64_t i_s = std::get<0>( ij ), k_s = std::get<1>( ij );
+                A.tileGetForReading( i_s, k_s, HostNum, LayoutConvert( layout ) );
+                if (i_s == i) {
+                    tile::gecopy( A( i, k ), T );
+                }
+                else {
+                    auto Aki = A( k, i );
+                    tile::gecopy( conj_transpose( Aki ), T );
+                }
+
+                if (i == k) {
+                    // Fill in the other triangle of the diagonal tile.
+                    for (int64_t jj = 0; jj < T.nb(); ++jj) {
+                        T.at( jj, jj ) = std::real( T.at( jj, jj ) );
+                        for (int64_t ii = jj+1; ii < T.mb(); ++ii) {
+                            if (lower)
+                                T.at( jj, ii ) = conj( T.at( ii, jj ) );
+                            else
+                                T.at( ii, jj ) = conj( T.at( jj, ii ) );
+                        }
+                    }
+                }
+            },
+            opts );
+        return;
+    }
+
     if (target == Target::Devices) {
         C.allocateBatchArrays();
         C.reserveDeviceWorkspace();
@@ -18,14 +18,24 @@ namespace impl {
 /// Generic implementation for any target.
 /// Panel computed on host using Host OpenMP task.
 ///
+/// With lookahead on a single MPI rank, the two-sided update of the next
+/// panel's block column is done first, so the next panel's QR overlaps
+/// with the rest of the trailing matrix update, as in MAGMA's one-stage
+/// lookahead. With several ranks, the triangle-triangle reductions
+/// (hettmqr) update the whole trailing matrix, so there is no lookahead.
+///
 /// ColMajor layout is assumed
 ///
+/// If band_ready is set, it is called by a task on every rank as soon as
+/// block column k of the band, tiles A(k, k) and A(k+1, k), is final.
+///
 /// @ingroup heev_impl
 ///
 template <Target target, typename scalar_t>
 void he2hb(
     HermitianMatrix<scalar_t>& A,
     TriangularFactors<scalar_t>& T,
+    std::function<void (int64_t)> const& band_ready,
     Options const& opts )
 {
     using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
@@ -51,6 +61,8 @@ void he2hb(
 
     // Options
     int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    Workspace* workspace = get_option<Workspace*>( opts, Option::Workspace, nullptr );
 
     int64_t max_panel_threads = std::max( omp_get_max_threads()/2, 1 );
     max_panel_threads = get_option<int64_t>( opts, Option::MaxPanelThreads,
@@ -81,6 +93,7 @@ void he2hb(
     // which will improve the performance.
     A.gridinfo( &grid_order, &nprow, &npcol, &myrow, &mycol );
     assert( grid_order == GridOrder::Col );  // todo: update for Row
+    bool use_lookahead = lookahead > 0 && nprow * npcol == 1;
 
     auto tileNb = A.tileNbFunc();
     auto tileRank = A.tileRankFunc();
@@ -100,7 +113,12 @@ void he2hb(
     size_t  work_size    = 0;
     using device_info_t = lapack::device_info_int;
 
+    // Guards detach in reverse order: A, then W, as they attach.
+    WorkspaceGuard<scalar_t> workspace_guard_W( W );
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
+        A.attachWorkspace( workspace );
+        W.attachWorkspace( workspace );
         A.allocateBatchArrays();
         A.reserveDeviceWorkspace();
         W.allocateBatchArrays( batch_size_default, num_queues );
@@ -149,9 +167,15 @@ void he2hb(
                 + ceildiv(sizeof(device_info_t), sizeof(scalar_t));
 
             for (int64_t dev = 0; dev < num_devices; ++dev) {
-                blas::Queue* dev_queue = A.compute_queue( dev, queue_0 );
-                dwork_array[dev] =
-                  blas::device_malloc<scalar_t>( work_size, *dev_queue );
+                if (workspace != nullptr) {
+                    dwork_array[dev] = (scalar_t*) workspace->deviceBuffer(
+                        dev, work_size * sizeof(scalar_t) );
+                }
+                else {
+                    blas::Queue* dev_queue = A.compute_queue( dev, queue_0 );
+                    dwork_array[dev] =
+                      blas::device_malloc<scalar_t>( work_size, *dev_queue );
+                }
             }
         }
     }
@@ -196,6 +220,9 @@ void he2hb(
                 firstprivate(  A_panel, Tlocal_panel, Treduce_panel, ib, \
                                max_panel_threads, work_size, priority_1 )
             {
+                // The geqrf panel for Devices is on the panel device;
+                // the triangle-triangle reductions are O(log p) tiles,
+                // and stay on host.
                 internal::geqrf<target>(
                     std::move( A_panel ),
                     std::move( Tlocal_panel ),
@@ -307,7 +334,7 @@ void he2hb(
                                     firstprivate( k, nt, device, panel_rank_rows, \
                                                   layoutc )
                                 {
-                                    std::set<ij_tuple> A_tiles_set, A_panel_tiles_set, W_tiles_set;
+                                    TileSet A_tiles_set, A_panel_tiles_set, W_tiles_set;
                                     for (int64_t j : panel_rank_rows) {
                                         for (int64_t i = k+1; i < nt; ++i) {
                                             if (i >= j) { // lower or diagonal
@@ -393,6 +420,7 @@ void he2hb(
                         firstprivate( zero, half, one, r_one, i0, k, nt, \
                                       panel_rank, panel_rank_rows, \
                                       panel_rank_rows_sub, mpi_rank, \
+                                      use_lookahead, \
                                       layout, layoutc, priority_0, queue_0 )
                     {
                         // Compute W = A V T.
@@ -442,7 +470,7 @@ void he2hb(
                                         W  .tileIsend( i, k, neighbor, tag_i1, &req );
                                         Wtmp.tileRecv( i, k, neighbor, layout, tag_i );
                                     }
-                                    MPI_Wait( &req, MPI_STATUS_IGNORE );
+                                    internal::comm_wait( &req );
                                     auto Wtmp_ik = Wtmp( i, k );
                                     auto W_ik = W( i, k );
                                     blas::axpy( W_ik.nb()*W_ik.nb(),
@@ -512,11 +540,14 @@ void he2hb(
 
                             // 2. Update trailing matrix.
                             // A = A - V Y^H - Y V^H, with Y in W.
-                            internal::her2k<target>(
-                                -one,  A.sub( k+1, nt-1, k, k ),
-                                       W.sub( k+1, nt-1, k, k ),
-                                r_one, A.sub( k+1, nt-1 ),
-                                priority_0, queue_0, layout );
+                            // With lookahead, it is done in the tasks below.
+                            if (! use_lookahead) {
+                                internal::her2k<target>(
+                                    -one,  A.sub( k+1, nt-1, k, k ),
+                                           W.sub( k+1, nt-1, k, k ),
+                                    r_one, A.sub( k+1, nt-1 ),
+                                    priority_0, queue_0, layout );
+                            }
                         }
                         else { // off-diag
                             //--------------------
@@ -542,6 +573,60 @@ void he2hb(
                         }
                     }
 
+                    if (use_lookahead) {
+                        //--------------------
+                        // 2a. Update the next panel's block column,
+                        // A(k+1:nt-1, k+1) -= V Y(k+1)^H + Y V(k+1)^H,
+                        // first, then release it to the next panel's QR.
+                        #pragma omp task slate_omp_default_none \
+                            depend( inout:block[ k ] ) \
+                            depend( inout:block[ k+1 ] ) \
+                            shared( A, W ) \
+                            firstprivate( one, r_one, k, nt, layout, \
+                                          priority_1, queue_0 )
+                        {
+                            internal::her2k<target>(
+                                -one,  A.sub( k+1, k+1, k, k ),
+                                       W.sub( k+1, k+1, k, k ),
+                                r_one, A.sub( k+1, k+1 ),
+                                priority_1, queue_0, layout );
+
+                            if (k+2 < nt) {
+                                internal::gemm<target>(
+                                    -one, A.sub( k+2, nt-1, k, k ),
+                                          conj_transpose( W.sub( k+1, k+1, k, k ) ),
+                                    one,  A.sub( k+2, nt-1, k+1, k+1 ),
+                                    layout, priority_1, queue_0 );
+                                internal::gemm<target>(
+                                    -one, W.sub( k+2, nt-1, k, k ),
+                                          conj_transpose( A.sub( k+1, k+1, k, k ) ),
+                                    one,  A.sub( k+2, nt-1, k+1, k+1 ),
+                                    layout, priority_1, queue_0 );
+                            }
+                        }
+
+                        //--------------------
+                        // 2b. Update the rest of the trailing matrix,
+                        // overlapped with the next panel's QR.
+                        if (k+2 < nt) {
+                            #pragma omp task slate_omp_default_none \
+                                depend( inout:block[ k ] ) \
+                                depend( inout:block[ k+2 ] ) \
+                                depend( inout:block[ nt-1 ] ) \
+                                depend( inout:fetch_trailing[ 0 ] ) \
+                                shared( A, W ) \
+                                firstprivate( one, r_one, k, nt, layout, \
+                                              priority_0, queue_0 )
+                            {
+                                internal::her2k<target>(
+                                    -one,  A.sub( k+2, nt-1, k, k ),
+                                           W.sub( k+2, nt-1, k, k ),
+                                    r_one, A.sub( k+2, nt-1 ),
+                                    priority_0, queue_0, layout );
+                            }
+                        }
+                    }
+
                     // Restore V0.
                     #pragma omp task slate_omp_default_none \
                         depend( inout:block[ k ] ) \
@@ -557,24 +642,27 @@ void he2hb(
                 } // for panel_rank
 
                 //--------------------
-                // Update trailing matrix from triangle reductions.
-                #pragma omp task slate_omp_default_none \
-                    depend( in:block[ k ] ) \
-                    depend( inout:block[ k+1 ] ) \
-                    depend( inout:block[ nt-1 ] ) \
-                    depend( inout:fetch_trailing[ 0 ] ) \
-                    shared( A ) \
-                    firstprivate( A_panel, Treduce_panel, k, nt )
-                {
-                    int tag_base = A.mt()*A.mt();
-                    // Do 2-sided Hermitian update:
-                    // 3. A = Q^H A Q
-                    internal::hettmqr<Target::HostTask>(
-                        Op::ConjTrans,
-                        std::move( A_panel ),
-                        std::move( Treduce_panel ),
-                        A.sub( k+1, nt-1 ),
-                        tag_base );
+                // Update trailing matrix from triangle reductions,
+                // if the panel has more than one rank.
+                if (first_indices.size() > 1) {
+                    #pragma omp task slate_omp_default_none \
+                        depend( in:block[ k ] ) \
+                        depend( inout:block[ k+1 ] ) \
+                        depend( inout:block[ nt-1 ] ) \
+                        depend( inout:fetch_trailing[ 0 ] ) \
+                        shared( A ) \
+                        firstprivate( A_panel, Treduce_panel, k, nt )
+                    {
+                        int tag_base = A.mt()*A.mt();
+                        // Do 2-sided Hermitian update:
+                        // 3. A = Q^H A Q
+                        internal::hettmqr<target>(
+                            Op::ConjTrans,
+                            std::move( A_panel ),
+                            std::move( Treduce_panel ),
+                            A.sub( k+1, nt-1 ),
+                            tag_base );
+                    }
                 }
             }
 
@@ -607,8 +695,30 @@ void he2hb(
                     }
                 }
             }
+
+            // Band column k is final: A(k, k) was last updated by the
+            // trailing update of panel k-1, and A(k+1, k) by panel k.
+            if (band_ready) {
+                #pragma omp task slate_omp_default_none \
+                    depend( in:block[ k ] ) \
+                    shared( band_ready ) \
+                    firstprivate( k )
+                {
+                    band_ready( k );
+                }
+            }
         } // for k
 
+        if (band_ready) {
+            #pragma omp task slate_omp_default_none \
+                depend( in:block[ nt-1 ] ) \
+                shared( band_ready ) \
+                firstprivate( nt )
+            {
+                band_ready( nt-1 );
+            }
+        }
+
         #pragma omp taskwait
         A.tileUpdateAllOrigin();
     } // parallel, master
@@ -616,7 +726,7 @@ void he2hb(
     A.releaseWorkspace();
     W.releaseWorkspace();
 
-    if (target == Target::Devices) {
+    if (target == Target::Devices && workspace == nullptr) {
         for (int64_t dev = 0; dev < num_devices; ++dev) {
             blas::Queue* queue = A.compute_queue( dev, queue_0 );
 
@@ -663,6 +773,12 @@ void he2hb(
 ///     Additional options, as map of name = value pairs. Possible options:
 ///     - Option::InnerBlocking:
 ///       Inner blocking to use for panel. Default 16.
+///     - Option::Lookahead:
+///       If > 0, on a single MPI rank, update the next panel's block column
+///       first, so the next panel's QR overlaps with the rest of the
+///       trailing matrix update. Default 1.
+///       With several ranks, a lookahead is not possible due to
+///       dependencies from updating on both left and right sides.
 ///     - Option::MaxPanelThreads:
 ///       Number of threads to use for panel. Default omp_get_max_threads()/2.
 ///     - Option::Target:
@@ -671,8 +787,10 @@ void he2hb(
 ///       - HostNest:  not implemented.
 ///       - HostBatch: not implemented.
 ///       - Devices:   batched BLAS on GPU device.
-///     Note a lookahead is not possible with he2hb due to dependencies from
-///     updating on both left and right sides.
+///     - Option::Workspace:
+///       Workspace arena to take device workspace from and return it to,
+///       instead of allocating and freeing it; A, then the internal
+///       workspace matrix, are attached to it. Default none.
 ///
 /// @ingroup heev_computational
 ///
@@ -681,6 +799,40 @@ void he2hb(
     HermitianMatrix<scalar_t>& A,
     TriangularFactors<scalar_t>& T,
     Options const& opts )
+{
+    he2hb( A, T, std::function<void (int64_t)>(), opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel reduction to band, as above, signaling each block
+/// column of the band as soon as it is final, so the next stage can start
+/// on it while later panels are reduced; see heev with Option::Pipeline.
+///
+/// @param[in,out] A
+///     The n-by-n Hermitian matrix $A$, as above.
+///
+/// @param[out] T
+///     On exit, triangular matrices of the block reflectors for Q.
+///
+/// @param[in] band_ready
+///     Called as band_ready( k ), for k = 0, ..., nt-1, on every rank,
+///     once tiles A(k, k) and A(k+1, k) of the band are final. Calls are
+///     from OpenMP tasks, concurrent with he2hb and possibly with each
+///     other, not necessarily in order of k.
+///     If A is on the devices, the host copies of these tiles may be
+///     stale; use tileGetForReading to read them.
+///
+/// @param[in] opts
+///     Additional options, as above.
+///
+/// @ingroup heev_computational
+///
+template <typename scalar_t>
+void he2hb(
+    HermitianMatrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    std::function<void (int64_t)> const& band_ready,
+    Options const& opts )
 {
     Target target = get_option( opts, Option::Target, Target::HostTask );
 
@@ -690,11 +842,11 @@ void he2hb(
         case Target::HostTask:
         case Target::HostNest:
         case Target::HostBatch:
-            impl::he2hb<Target::HostTask>( A, T, opts );
+            impl::he2hb<Target::HostTask>( A, T, band_ready, opts );
             break;
 
         case Target::Devices:
-            impl::he2hb<Target::Devices>( A, T, opts );
+            impl::he2hb<Target::Devices>( A, T, band_ready, opts );
             break;
     }
     // todo: return value for errors?
@@ -708,22 +860,50 @@ void he2hb<float>(
     TriangularFactors<float>& T,
     Options const& opts);
 
+template
+void he2hb<float>(
+    HermitianMatrix<float>& A,
+    TriangularFactors<float>& T,
+    std::function<void (int64_t)> const& band_ready,
+    Options const& opts);
+
+template
+void he2hb<double>(
+    HermitianMatrix<double>& A,
+    TriangularFactors<double>& T,
+    Options const& opts);
+
 template
 void he2hb<double>(
     HermitianMatrix<double>& A,
     TriangularFactors<double>& T,
+    std::function<void (int64_t)> const& band_ready,
+    Options const& opts);
+
+template
+void he2hb< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    TriangularFactors< std::complex<float> >& T,
     Options const& opts);
 
 template
 void he2hb< std::complex<float> >(
     HermitianMatrix< std::complex<float> >& A,
     TriangularFactors< std::complex<float> >& T,
+    std::function<void (int64_t)> const& band_ready,
+    Options const& opts);
+
+template
+void he2hb< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    TriangularFactors< std::complex<double> >& T,
     Options const& opts);
 
 template
 void he2hb< std::complex<double> >(
     HermitianMatrix< std::complex<double> >& A,
     TriangularFactors< std::complex<double> >& T,
+    std::function<void (int64_t)> const& band_ready,
     Options const& opts);
 
 } // namespace slate
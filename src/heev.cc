@@ -9,56 +9,79 @@
 #include "slate/Tile_blas.hh"
 #include "slate/HermitianBandMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+#include <atomic>
+#include <thread>
 
 namespace slate {
 
 //------------------------------------------------------------------------------
-/// Distributed parallel Hermitian matrix eigen decomposition.
-/// heev Computes all eigenvalues and, optionally, eigenvectors of a
-/// Hermitian matrix A. The matrix A is preliminary reduced to
-/// tridiagonal form using a two-stage approach:
-/// First stage: reduction to band tridiagonal form (see he2hb);
-/// Second stage: reduction from band to tridiagonal form (see hb2st).
+/// Distributed parallel Hermitian matrix eigen decomposition, for a subset
+/// of the spectrum.
+/// heevx computes selected eigenvalues and, optionally, eigenvectors of a
+/// Hermitian matrix A, as heev. The tridiagonal eigenvalues are found by
+/// bisection (see stebz) and eigenvectors by inverse iteration (see stein),
+/// both only for the selection. The back-transformation is applied to only
+/// the k selected vectors, so it costs O(n^2 k) instead of O(n^3).
 ///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///         One of float, double, std::complex<float>, std::complex<double>.
 //------------------------------------------------------------------------------
+/// @param[in] range
+///     - Range::All:   all eigenvalues, as heev;
+///     - Range::Value: eigenvalues in the half-open interval [vl, vu);
+///     - Range::Index: eigenvalues il to iu.
+///
+/// @param[in] vl
+///     If range = Value, lower bound of the interval. Otherwise not used.
+///
+/// @param[in] vu
+///     If range = Value, upper bound of the interval, vl < vu.
+///     Otherwise not used.
+///
+/// @param[in] il
+///     If range = Index, 0-based index of the smallest eigenvalue returned,
+///     0 <= il <= iu + 1. Otherwise not used.
+///
+/// @param[in] iu
+///     If range = Index, 0-based index of the largest eigenvalue returned,
+///     iu < n. Otherwise not used.
+///
 /// @param[in] A
 ///         On entry, the n-by-n Hermitian matrix $A$.
 ///         On exit, contents are destroyed.
 ///
 /// @param[out] Lambda
-///     The vector Lambda of length n.
-///     If successful, the eigenvalues in ascending order.
+///     On exit, resized to the number of eigenvalues found, k, and holds
+///     them in ascending order.
 ///
 /// @param[out] Z
 ///     On entry, if Z is empty, does not compute eigenvectors.
-///     Otherwise, the n-by-n matrix $Z$ to store eigenvectors.
-///     On exit, orthonormal eigenvectors of the matrix A.
+///     Otherwise, an n-by-m matrix $Z$, with m >= k, e.g., m = iu - il + 1
+///     for range = Index, or m = n.
+///     On exit, its first k columns are orthonormal eigenvectors of A.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
-///     - Option::InnerBlocking:
-///       Inner blocking to use for panel. Default 16.
-///     - Option::MaxPanelThreads:
-///       Number of threads to use for panel. Default omp_get_max_threads()/2.
-///     - Option::Target:
-///       Implementation to target. Possible values:
-///       - HostTask:  OpenMP tasks on CPU host [default].
-///       - HostNest:  nested OpenMP parallel for loop on CPU host.
-///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///     Additional options, as for heev. Option::MethodEig applies only
+///     to range = All; QDWH is treated as DC.
 ///
 /// @ingroup heev
 ///
 template <typename scalar_t>
-void heev(
+void heevx(
+    lapack::Range range,
+    blas::real_type<scalar_t> vl, blas::real_type<scalar_t> vu,
+    int64_t il, int64_t iu,
     HermitianMatrix<scalar_t>& A,
     std::vector< blas::real_type<scalar_t> >& Lambda,
     Matrix<scalar_t>& Z,
     Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "heev", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "heev", A.mpiComm(), opts );
+
     Timer t_heev;
 
     using real_t = blas::real_type<scalar_t>;
@@ -97,54 +120,161 @@ void heev(
     }
 
     if (alpha != 1.0) {
-        // Scale by sqrt_sml/Anorm or sqrt_big/Anorm.
+        // Scale by sqrt_sml/Anorm or sqrt_big/Anorm, and the interval too.
         scale( alpha, Anorm, A, opts );
+        vl *= alpha/Anorm;
+        vu *= alpha/Anorm;
     }
 
-    // 1. Reduce to band form.
-    TriangularFactors<scalar_t> T;
-    Timer t_he2hb;
-    he2hb(A, T, opts);
-    timers[ "heev::he2hb" ] = t_he2hb.stop();
+    bool pipeline = get_option<Option::Pipeline>( opts, false );
 
-    // Copy band.
-    // Currently, gathers band matrix to rank 0.
+    // Band, distributed by contiguous block columns over a 1D grid
+    // of all ranks, for the pipelined bulge chasing in hb2st.
+    // If pipelined, it is gathered while he2hb is in progress,
+    // so it uses its own communicator.
     int64_t nb = A.tileNb(0);
-    HermitianBandMatrix<scalar_t> Aband(A.uplo(), n, nb, nb, 1, 1, A.mpiComm());
+    int64_t nt = A.nt();
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size(A.mpiComm(), &mpi_size));
+    MPI_Comm band_comm = A.mpiComm();
+    if (pipeline) {
+        slate_mpi_call(
+            MPI_Comm_dup(A.mpiComm(), &band_comm));
+    }
+    int64_t band_cols = ceildiv( nt, int64_t( mpi_size ) );
+    std::function<int64_t (int64_t)> tileNb = func::uniform_blocksize( n, nb );
+    std::function<int (func::ij_tuple)> band_rank
+        = func::device_1d_grid( GridOrder::Row, band_cols, mpi_size );
+    std::function<int (func::ij_tuple)> tileDevice = A.tileDeviceFunc();
+    HermitianBandMatrix<scalar_t> Aband(
+        A.uplo(), n, nb, tileNb, band_rank, tileDevice, band_comm);
     Aband.insertLocalTiles();
-    Aband.he2hbGather(A);
 
-    // Currently, hb2st and sterf are run on a single node.
     Lambda.resize(n);
     std::vector<real_t> E(n - 1);
-    Matrix<scalar_t> V;
-    // Matrix to store Householder vectors.
+    // Matrix to store Householder vectors, only if eigenvectors are wanted;
+    // otherwise hb2st discards them as it goes.
     // Could pack into a lower triangular matrix, but we store each
     // parallelogram in a 2nb-by-nb tile, with nt(nt + 1)/2 tiles.
+    // Tile k*nt - k*(k - 1)/2 + c holds vectors of sweeps k*nb, ...,
+    // (k+1)*nb - 1 written by steps in block column k + max( c-1, 0 ),
+    // so it is on the rank owning that block column of the band.
     int64_t vm = 2*nb;
-    int64_t nt = A.nt();
     int64_t vn = nt*(nt + 1)/2*nb;
-    V = Matrix<scalar_t>(vm, vn, vm, nb, 1, 1, A.mpiComm());
-    if (A.mpiRank() == 0) {
+    auto V_ranks = std::make_shared< std::vector<int> >();
+    V_ranks->reserve( nt*(nt + 1)/2 );
+    for (int64_t k = 0; k < nt; ++k) {
+        for (int64_t c = 0; c < nt - k; ++c) {
+            int64_t col = k + std::max( c-1, int64_t( 0 ) );
+            V_ranks->push_back( band_rank( { col, col } ) );
+        }
+    }
+    std::function<int64_t (int64_t)> tileMb_V = func::uniform_blocksize( vm, vm );
+    std::function<int64_t (int64_t)> tileNb_V = func::uniform_blocksize( vn, nb );
+    std::function<int (func::ij_tuple)> tileRank_V
+        = [V_ranks]( func::ij_tuple ij ) {
+            return V_ranks->at( std::get<1>( ij ) );
+        };
+    Matrix<scalar_t> V;
+    if (wantz) {
+        V = Matrix<scalar_t>(vm, vn, tileMb_V, tileNb_V, tileRank_V, tileDevice,
+                             A.mpiComm());
         V.insertLocalTiles();
+    }
+
+    TriangularFactors<scalar_t> T;
+    if (pipeline) {
+        // 1-2. Reduce to band form, and band to real symmetric
+        // tri-diagonal, overlapped: each block column of the band is
+        // gathered as soon as he2hb finishes it, and hb2st sweeps
+        // proceed on the gathered block columns meanwhile.
+        std::vector< std::atomic<int> > band_ready( nt );
+        for (int64_t k = 0; k < nt; ++k)
+            band_ready[ k ].store( 0 );
+
+        std::function<void (int64_t)> gather = [&]( int64_t k ) {
+            Aband.he2hbGather( A, k );
+            band_ready[ k ].store( 1 );
+        };
+        std::function<void (int64_t)> wait = [&]( int64_t k ) {
+            while (band_ready[ k ].load() == 0)
+                std::this_thread::yield();
+        };
+
+        // Split the threads between the stages.
+        int hb2st_threads = std::max( omp_get_max_threads()/2, 1 );
+        int he2hb_threads = std::max( omp_get_max_threads() - hb2st_threads, 1 );
+        double time_he2hb = 0, time_hb2st = 0;
+
+        // One more level for the stages.
+        slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels + 1 );
+
+        #pragma omp parallel num_threads( 2 )
+        {
+            // With only one thread, he2hb runs to completion first.
+            if (omp_get_thread_num() == 0) {
+                omp_set_num_threads( he2hb_threads );
+                Timer t_he2hb;
+                he2hb( A, T, gather, opts );
+                time_he2hb = t_he2hb.stop();
+            }
+            if (omp_get_thread_num() == 1 || omp_get_num_threads() == 1) {
+                omp_set_num_threads( hb2st_threads );
+                Timer t_hb2st;
+                hb2st( Aband, V, wait, opts );
+                time_hb2st = t_hb2st.stop();
+            }
+        }
+        internal::timers_set( opts, "heev::he2hb", time_he2hb );
+        internal::timers_set( opts, "heev::hb2st", time_hb2st );
+
+        // T is needed only to back-transform eigenvectors.
+        if (! wantz)
+            T.clear();
+    }
+    else {
+        // 1. Reduce to band form.
+        Timer t_he2hb;
+        he2hb(A, T, opts);
+        internal::timers_set( opts, "heev::he2hb", t_he2hb.stop() );
+
+        // T is needed only to back-transform eigenvectors.
+        if (! wantz)
+            T.clear();
+
+        Aband.he2hbGather(A);
 
         // 2. Reduce band to real symmetric tri-diagonal.
         Timer t_hb2st;
         hb2st(Aband, V, opts);
-        timers[ "heev::hb2st" ] = t_hb2st.stop();
+        internal::timers_set( opts, "heev::hb2st", t_hb2st.stop() );
+    }
 
-        // Copy diagonal and super-diagonal to vectors.
-        internal::copyhb2st( Aband, Lambda, E );
+    // Copy diagonal and super-diagonal to vectors, summing the ranks' parts.
+    internal::copyhb2st( Aband, Lambda, E );
+    MPI_Allreduce( MPI_IN_PLACE, &Lambda[0], n, mpi_real_type, MPI_SUM,
+                   A.mpiComm() );
+    MPI_Allreduce( MPI_IN_PLACE, &E[0], n-1, mpi_real_type, MPI_SUM,
+                   A.mpiComm() );
 
-        Aband.releaseRemoteWorkspace();
-    }
+    Aband.releaseRemoteWorkspace();
 
     // 3. Tri-diagonal eigenvalue solver.
-    if (wantz) {
-        // Bcast the Lambda and E vectors (diagonal and sup/super-diagonal).
-        MPI_Bcast( &Lambda[0], n,   mpi_real_type, 0, A.mpiComm() );
-        MPI_Bcast( &E[0],      n-1, mpi_real_type, 0, A.mpiComm() );
-        Timer t_stev;
+    Timer t_stev;
+    if (range != lapack::Range::All || method == MethodEig::Bisection) {
+        // Bisection for eigvals, split over ranks, then inverse
+        // iteration for eigvecs in each rank's block columns of Z,
+        // both only for the selected eigenvalues.
+        std::vector<real_t> D = Lambda;
+        stebz<real_t>( range, vl, vu, il, iu, D, E, Lambda,
+                       A.mpiComm(), opts );
+        if (wantz && ! Lambda.empty()) {
+            auto Zk = Z.slice( 0, n-1, 0, Lambda.size()-1 );
+            stein( D, E, Lambda, Zk, opts );
+        }
+    }
+    else if (wantz) {
         if (method == MethodEig::QR) {
             // QR iteration to get eigenvalues and eigenvectors of tridiagonal.
             steqr2( Job::Vec, Lambda, E, Z );
@@ -153,55 +283,293 @@ void heev(
             // Divide and conquer to get eigvals and eigvecs of tridiagonal.
             if constexpr (! is_complex<scalar_t>::value) {
                 // real
-                stedc( Lambda, E, Z );
+                stedc( Lambda, E, Z, opts );
             }
             else {
                 // D&C computes real Z, then copy to complex Z to back-transform.
                 auto Zreal = Z.template emptyLike<real_t>();
                 Zreal.insertLocalTiles();
-                stedc( Lambda, E, Zreal );
+                stedc( Lambda, E, Zreal, opts );
                 copy( Zreal, Z );
             }
         }
-        timers[ "heev::stev" ] = t_stev.stop();
-
-        // Find the total number of processors.
-        int mpi_size;
-        slate_mpi_call(
-            MPI_Comm_size(A.mpiComm(), &mpi_size));
-
-        Matrix<scalar_t> Z1d(Z.m(), Z.n(), Z.tileNb(0), 1, mpi_size, Z.mpiComm());
-        Z1d.insertLocalTiles(target);
-        redistribute(Z, Z1d, opts);
-
-        // Back-transform: Z = Q1 * Q2 * Z.
-        Timer t_unmtr_hb2st;
-        unmtr_hb2st( Side::Left, Op::NoTrans, V, Z1d, opts );
-        timers[ "heev::unmtr_hb2st" ] = t_unmtr_hb2st.stop();
-
-        redistribute(Z1d, Z, opts);
-        Timer t_unmtr_he2hb;
-        unmtr_he2hb( Side::Left, Op::NoTrans, A, T, Z, opts );
-        timers[ "heev::unmtr_he2hb" ] = t_unmtr_he2hb.stop();
     }
     else {
-        Timer t_stev;
         if (A.mpiRank() == 0) {
             // QR iteration to get eigenvalues.
             sterf<real_t>( Lambda, E, opts );
         }
         // Bcast eigenvalues.
         MPI_Bcast( &Lambda[0], n, mpi_real_type, 0, A.mpiComm() );
-        timers[ "heev::stev" ] = t_stev.stop();
+    }
+    internal::timers_set( opts, "heev::stev", t_stev.stop() );
+
+    if (wantz && ! Lambda.empty()) {
+        // Back-transform only the k computed vectors.
+        int64_t k = Lambda.size();
+        auto Zk = Z.slice( 0, n-1, 0, k-1 );
+
+        Matrix<scalar_t> Z1d(n, k, Zk.tileNb(0), 1, mpi_size, Z.mpiComm());
+        Z1d.insertLocalTilesLazy(target);
+        redistribute(Zk, Z1d, opts);
+
+        // Back-transform: Z = Q1 * Q2 * Z.
+        Timer t_unmtr_hb2st;
+        unmtr_hb2st( Side::Left, Op::NoTrans, V, Z1d, opts );
+        internal::timers_set( opts, "heev::unmtr_hb2st", t_unmtr_hb2st.stop() );
+
+        redistribute(Z1d, Zk, opts);
+        Timer t_unmtr_he2hb;
+        unmtr_he2hb( Side::Left, Op::NoTrans, A, T, Zk, opts );
+        internal::timers_set( opts, "heev::unmtr_he2hb", t_unmtr_he2hb.stop() );
     }
 
     // If matrix was scaled, then rescale eigenvalues appropriately.
     if (alpha != 1.0) {
         // Scale by Anorm/sqrt_sml or Anorm/sqrt_big.
         // todo: deal with not all eigenvalues converging, cf. LAPACK.
-        blas::scal( n, Anorm/alpha, &Lambda[0], 1 );
+        blas::scal( Lambda.size(), Anorm/alpha, Lambda.data(), 1 );
+    }
+
+    if (band_comm != A.mpiComm()) {
+        slate_mpi_call(
+            MPI_Comm_free(&band_comm));
+    }
+    internal::timers_set( opts, "heev", t_heev.stop() );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Hermitian matrix eigen decomposition.
+/// heev Computes all eigenvalues and, optionally, eigenvectors of a
+/// Hermitian matrix A. The matrix A is preliminary reduced to
+/// tridiagonal form using a two-stage approach:
+/// First stage: reduction to band tridiagonal form (see he2hb);
+/// Second stage: reduction from band to tridiagonal form (see hb2st).
+/// For a subset of eigenpairs, see heevx.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///         On entry, the n-by-n Hermitian matrix $A$.
+///         On exit, contents are destroyed.
+///
+/// @param[out] Lambda
+///     The vector Lambda of length n.
+///     If successful, the eigenvalues in ascending order.
+///
+/// @param[out] Z
+///     On entry, if Z is empty, does not compute eigenvectors.
+///     Otherwise, the n-by-n matrix $Z$ to store eigenvectors.
+///     On exit, orthonormal eigenvectors of the matrix A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::InnerBlocking:
+///       Inner blocking to use for panel. Default 16.
+///     - Option::MaxPanelThreads:
+///       Number of threads to use for panel. Default omp_get_max_threads()/2.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///     - Option::MethodEig:
+///       Tridiagonal eigensolver. Possible values:
+///       - DC:        divide and conquer [default]; QR without eigenvectors.
+///       - QR:        QR iteration.
+///       - Bisection: bisection and inverse iteration, distributed over
+///         ranks, also without eigenvectors.
+///       - QDWH:      no tridiagonal reduction; QDWH-based spectral divide
+///         and conquer, see heev_qdwh.
+///     - Option::Pipeline:
+///       If true, overlap the reductions: hb2st chases bulges in each
+///       block column of the band as soon as he2hb has finished it and it
+///       has been gathered, with half the threads each. Default false.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+void heev(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
+{
+    MethodEig method = get_option( opts, Option::MethodEig, MethodEig::DC );
+    if (method == MethodEig::QDWH) {
+        heev_qdwh( A, Lambda, Z, opts );
+        return;
     }
-    timers[ "heev" ] = t_heev.stop();
+
+    heevx( lapack::Range::All, blas::real_type<scalar_t>( 0 ),
+           blas::real_type<scalar_t>( 0 ), 0, 0, A, Lambda, Z, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Workspace query for heev: predicts, without computing anything, the
+/// memory that heev( A, Lambda, Z, opts ) needs on this rank, as LAPACK's
+/// lwork = -1 query. Pass it to Workspace::reserve, with the same arena
+/// in Option::Workspace, so the reduction to band allocates nothing
+/// during the run.
+///
+/// With Target::Devices, he2hb attaches A, then its workspace matrix W,
+/// to the arena; their tiles, batch arrays, and the panel QR buffer are
+/// listed in pools and device_buffer_size. Each he2hb step holds the
+/// panel, broadcast along block rows and columns, and the previous one.
+/// The band, Householder vectors, triangular factors, 1D copy of the
+/// eigenvectors, and vectors of the tridiagonal matrix are allocated
+/// outside the arena, and counted in host_aux_size; the tridiagonal
+/// eigensolver's internal workspace is not counted.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n Hermitian matrix $A$; it is not accessed, only its
+///     distribution.
+///
+/// @param[in] Z
+///     The matrix for eigenvectors, as for heev; if empty, eigenvectors
+///     are not computed.
+///
+/// @param[in] opts
+///     Options, as for heev. Used: InnerBlocking and Target.
+///
+/// @return predicted workspace on this rank.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+WorkspaceSize heev_workspace_size(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t ib = get_option<int64_t>( opts, Option::InnerBlocking, 16 );
+
+    int64_t n = A.n();
+    int64_t nb = A.tileNb( 0 );
+    int64_t nt = A.nt();
+    bool wantz = (Z.mt() > 0);
+    int num_devices = A.num_devices();
+    size_t block_size = A.memoryBlockSize();
+
+    int mpi_rank = A.mpiRank();
+    int mpi_size;
+    slate_mpi_call(
+        MPI_Comm_size( A.mpiComm(), &mpi_size ) );
+
+    WorkspaceSize size;
+
+    // Lambda and E; band, with a diagonal and a sub-diagonal tile per
+    // block column, over a 1D grid of all ranks.
+    int64_t band_cols = ceildiv( nt, int64_t( mpi_size ) );
+    int64_t my_band_cols = std::max(
+        int64_t( 0 ), std::min( band_cols, nt - mpi_rank*band_cols ) );
+    size.host_aux_size = (2*n - 1) * sizeof( real_t )
+                       + 2 * my_band_cols * nb * nb * sizeof( scalar_t );
+
+    // Triangular factors, Tlocal and Treduce, for local tiles below the
+    // diagonal.
+    int64_t local_tiles = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = j+1; i < nt; ++i) {
+            if (A.tileIsLocal( i, j ))
+                ++local_tiles;
+        }
+    }
+    size.host_aux_size += 2 * local_tiles * ib * nb * sizeof( scalar_t );
+
+    if (wantz) {
+        // Householder vectors of hb2st: a 2nb-by-nb tile per block column
+        // of the band per sweep, on the band's owner; and the 1D copy of Z.
+        int64_t my_V_tiles = 0;
+        for (int64_t k = 0; k < nt; ++k) {
+            for (int64_t c = 0; c < nt - k; ++c) {
+                int64_t col = k + std::max( c-1, int64_t( 0 ) );
+                if (col / band_cols == mpi_rank)
+                    ++my_V_tiles;
+            }
+        }
+        int64_t z_nt = Z.nt();
+        int64_t my_z_cols = ceildiv( z_nt, int64_t( mpi_size ) );
+        size.host_aux_size
+            += (my_V_tiles * 2*nb * nb + n * my_z_cols * Z.tileNb( 0 ))
+               * sizeof( scalar_t );
+    }
+
+    if (target == Target::Devices) {
+        // A and W in he2hb. W is distributed as A, but within a node the
+        // devices are assigned row-cyclically.
+        std::vector<int64_t> rows, cols;
+        internal::local_rows_cols( A, rows, cols );
+
+        GridOrder grid_order;
+        int nprow, npcol, myrow, mycol;
+        A.gridinfo( &grid_order, &nprow, &npcol, &myrow, &mycol );
+        HermitianMatrix<scalar_t> W(
+            Uplo::Lower, n, A.tileNbFunc(), A.tileRankFunc(),
+            func::device_1d_grid( GridOrder::Col, nprow, num_devices ),
+            A.mpiComm() );
+
+        WorkspaceSize::Pool pool;
+        pool.block_size = block_size;
+        pool.host_tiles = 2 * (rows[ 0 ] + cols[ 0 ]);
+        pool.local_tiles.assign( num_devices, A.getMaxDeviceTiles() );
+        pool.remote_tiles.resize( num_devices );
+        for (int dev = 0; dev < num_devices; ++dev)
+            pool.remote_tiles[ dev ] = 2 * (rows[ dev+1 ] + cols[ dev+1 ]);
+        pool.num_batch_arrays = 1;
+        pool.batch_size = A.getMaxDeviceTiles();
+        size.pools.push_back( pool );
+
+        // W's remote tiles are those of A, spread over the devices.
+        pool.block_size = W.memoryBlockSize();
+        pool.local_tiles.assign( num_devices, W.getMaxDeviceTiles() );
+        for (int dev = 0; dev < num_devices; ++dev) {
+            pool.remote_tiles[ dev ] = ceildiv(
+                2 * (rows[ 0 ] + cols[ 0 ]), int64_t( num_devices ) );
+        }
+        pool.num_batch_arrays = 10;
+        pool.batch_size = W.getMaxDeviceTiles();
+        size.pools.push_back( pool );
+
+        // Panel QR buffer of he2hb, sized for the first panel with local
+        // tiles.
+        int64_t mlocal = 0;
+        int panel_device = -1;
+        for (int64_t j = 0; j < nt && mlocal == 0; ++j) {
+            for (int64_t i = j+1; i < nt; ++i) {
+                if (A.tileIsLocal( i, j )) {
+                    if (panel_device < 0)
+                        panel_device = A.tileDevice( i, j );
+                    mlocal += A.tileMb( i );
+                }
+            }
+        }
+        if (panel_device >= 0) {
+            lapack::Queue* queue = A.compute_queue( panel_device, 0 );
+            int64_t max_nb = func::max_blocksize( nt, A.tileNbFunc() );
+            size_t dsize, hsize;
+            lapack::geqrf_work_size_bytes(
+                mlocal, max_nb, (scalar_t*) nullptr, mlocal,
+                &dsize, &hsize, *queue );
+            size_t work_size
+                = blas::max( 1, mlocal ) * max_nb + std::min( mlocal, max_nb )
+                  + ceildiv( dsize, sizeof( scalar_t ) )
+                  + ceildiv( sizeof( lapack::device_info_int ),
+                             sizeof( scalar_t ) );
+            size.device_buffer_size = work_size * sizeof( scalar_t );
+        }
+    }
+    return size;
 }
 
 //------------------------------------------------------------------------------
@@ -234,4 +602,60 @@ void heev< std::complex<double> >(
     Matrix< std::complex<double> >& Z,
     Options const& opts);
 
+template
+void heevx<float>(
+    lapack::Range range, float vl, float vu, int64_t il, int64_t iu,
+    HermitianMatrix<float>& A,
+    std::vector<float>& Lambda,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+void heevx<double>(
+    lapack::Range range, double vl, double vu, int64_t il, int64_t iu,
+    HermitianMatrix<double>& A,
+    std::vector<double>& Lambda,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+void heevx< std::complex<float> >(
+    lapack::Range range, float vl, float vu, int64_t il, int64_t iu,
+    HermitianMatrix<std::complex<float>>& A,
+    std::vector<float>& Lambda,
+    Matrix<std::complex<float>>& Z,
+    Options const& opts);
+
+template
+void heevx< std::complex<double> >(
+    lapack::Range range, double vl, double vu, int64_t il, int64_t iu,
+    HermitianMatrix<std::complex<double>>& A,
+    std::vector<double>& Lambda,
+    Matrix<std::complex<double>>& Z,
+    Options const& opts);
+
+template
+WorkspaceSize heev_workspace_size<float>(
+    HermitianMatrix<float>& A,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+WorkspaceSize heev_workspace_size<double>(
+    HermitianMatrix<double>& A,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+WorkspaceSize heev_workspace_size< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& Z,
+    Options const& opts);
+
+template
+WorkspaceSize heev_workspace_size< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& Z,
+    Options const& opts);
+
 } // namespace slate
@@ -0,0 +1,373 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "internal/internal.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Gets the real parts of the diagonal of the n-by-n matrix A,
+/// with square tiles, replicated on all ranks.
+///
+/// @ingroup heev_internal
+///
+template <typename scalar_t>
+void heev_qdwh_diag(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& D )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::real;
+
+    const Layout layout = Layout::ColMajor;
+
+    D.assign( A.n(), real_t( 0 ) );
+    int64_t offset = 0;
+    for (int64_t i = 0; i < A.nt(); ++i) {
+        if (A.tileIsLocal( i, i )) {
+            A.tileGetForReading( i, i, HostNum, LayoutConvert( layout ) );
+            auto Aii = A( i, i );
+            for (int64_t ii = 0; ii < Aii.nb(); ++ii)
+                D[ offset + ii ] = real( Aii( ii, ii ) );
+        }
+        offset += A.tileNb( i );
+    }
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, D.data(), D.size(),
+                       mpi_type<real_t>::value, MPI_SUM, A.mpiComm() ) );
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Subtracts sigma from the diagonal of the n-by-n matrix A,
+/// with square tiles.
+///
+/// @ingroup heev_internal
+///
+template <typename scalar_t>
+void heev_qdwh_shift(
+    Matrix<scalar_t>& A,
+    blas::real_type<scalar_t> sigma )
+{
+    const Layout layout = Layout::ColMajor;
+
+    for (int64_t i = 0; i < A.nt(); ++i) {
+        if (A.tileIsLocal( i, i )) {
+            A.tileGetForWriting( i, i, HostNum, LayoutConvert( layout ) );
+            auto Aii = A( i, i );
+            for (int64_t ii = 0; ii < Aii.nb(); ++ii)
+                Aii.at( ii, ii ) -= sigma;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// QDWH-based spectral divide and conquer, on the n-by-n Hermitian matrix
+/// A, stored in full in a general matrix. Splits the spectrum at a shift
+/// sigma with the polar factor U of A - sigma I: P = (U + I)/2 projects
+/// onto the invariant subspace of the k eigenvalues > sigma, k = trace( P ).
+/// The QR of P Omega, for a Gaussian n-by-k Omega, gives orthonormal bases
+/// V1 (n-by-k) of that subspace and V2 (n-by-(n - k)) of its complement,
+/// and the two halves V1^H A V1 and V2^H A V2 are solved recursively.
+/// Blocks of at most 2 nb, or that the shift fails to split, are solved
+/// by heev with opts, which must not select MethodEig::QDWH.
+/// @see slate::heev_qdwh
+///
+/// @ingroup heev_internal
+///
+template <typename scalar_t>
+void heev_qdwh(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0.0, half = 0.5, one = 1.0;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const Layout layout = Layout::ColMajor;
+
+    int64_t n = A.n();
+    int64_t nb = A.tileNb( 0 );
+    bool wantz = (Z.mt() > 0);
+
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    // Blocks too small to be worth splitting, with the two-stage heev.
+    auto heev_block = [&]() {
+        HermitianMatrix<scalar_t> A_lower( Uplo::Lower, A );
+        slate::heev( A_lower, Lambda, Z, opts );
+    };
+    if (n <= 2*nb) {
+        heev_block();
+        return;
+    }
+
+    // Shift at the median of the diagonal, which splits the spectrum
+    // roughly in half for most matrices.
+    std::vector<real_t> D;
+    heev_qdwh_diag( A, D );
+    std::nth_element( D.begin(), D.begin() + n/2, D.end() );
+    real_t sigma = D[ n/2 ];
+
+    // U = polar factor of A - sigma I, and k = trace( (U + I)/2 ).
+    auto U = A.emptyLike();
+    U.insertLocalTiles( target );
+    copy( A, U, opts );
+    heev_qdwh_shift( U, sigma );
+    polar( U, opts );
+    heev_qdwh_diag( U, D );
+    real_t trace = std::accumulate( D.begin(), D.end(), real_t( 0 ) );
+    int64_t k = std::llround( (n + trace) / 2 );
+    if (k <= 0 || k >= n) {
+        heev_block();
+        return;
+    }
+
+    // Y = P Omega = (U Omega + Omega)/2, with Gaussian n-by-k Omega,
+    // seeded by tile, so independent of the grid.
+    auto Omega = A.emptyLike().slice( 0, n-1, 0, k-1 );
+    auto Y = Omega.emptyLike();
+    Omega.insertLocalTiles( target );
+    Y.insertLocalTiles( target );
+    for (int64_t i = 0; i < Omega.mt(); ++i) {
+        for (int64_t j = 0; j < Omega.nt(); ++j) {
+            if (Omega.tileIsLocal( i, j )) {
+                Omega.tileGetForWriting( i, j, HostNum, LayoutConvert( layout ) );
+                auto Oij = Omega( i, j );
+                int64_t iseed[ 4 ] = { i % 4096, j % 4096, 0, 1 };
+                for (int64_t jj = 0; jj < Oij.nb(); ++jj)
+                    lapack::larnv( 3, iseed, Oij.mb(), &Oij.at( 0, jj ) );
+            }
+        }
+    }
+    copy( Omega, Y, opts );
+    gemm( half, U, Omega, half, Y, opts );
+    Omega = Matrix<scalar_t>();
+    U = Matrix<scalar_t>();
+
+    // V = [ V1 V2 ] from Y = V R; V1 = V [ I; 0 ], V2 = V [ 0; I ].
+    TriangularFactors<scalar_t> T;
+    geqrf( Y, T, opts );
+    auto V1 = A.emptyLike().slice( 0, n-1, 0, k-1 );
+    auto V2 = A.emptyLike().slice( 0, n-1, 0, n-k-1 );
+    V1.insertLocalTiles( target );
+    V2.insertLocalTiles( target );
+    set( zero, one, V1, opts );
+    std::function< scalar_t (int64_t, int64_t) > shifted_identity
+        = [k]( int64_t i, int64_t j ) {
+            return i == j + k ? scalar_t( 1 ) : scalar_t( 0 );
+        };
+    set( shifted_identity, V2, opts );
+    unmqr( Side::Left, Op::NoTrans, Y, T, V1, opts );
+    unmqr( Side::Left, Op::NoTrans, Y, T, V2, opts );
+    Y = Matrix<scalar_t>();
+    T.clear();
+
+    // A1 = V1^H A V1 and A2 = V2^H A V2. The coupling V2^H A V1 should
+    // be at the level of the polar decomposition's accuracy; if not,
+    // e.g., if sigma was an eigenvalue, solve this block directly instead.
+    auto V1H = conj_transpose( V1 );
+    auto V2H = conj_transpose( V2 );
+    auto AV1 = V1.emptyLike();
+    auto AV2 = V2.emptyLike();
+    AV1.insertLocalTiles( target );
+    AV2.insertLocalTiles( target );
+    gemm( one, A, V1, zero, AV1, opts );
+
+    auto E = A.emptyLike().slice( 0, n-k-1, 0, k-1 );
+    E.insertLocalTiles( target );
+    gemm( one, V2H, AV1, zero, E, opts );
+    real_t Enorm = norm( Norm::Fro, E, opts );
+    real_t Anorm = norm( Norm::Fro, A, opts );
+    E = Matrix<scalar_t>();
+    if (Enorm > n * eps * Anorm) {
+        heev_block();
+        return;
+    }
+
+    gemm( one, A, V2, zero, AV2, opts );
+    auto A1 = A.emptyLike().slice( 0, k-1, 0, k-1 );
+    auto A2 = A.emptyLike().slice( 0, n-k-1, 0, n-k-1 );
+    A1.insertLocalTiles( target );
+    A2.insertLocalTiles( target );
+    gemm( one, V1H, AV1, zero, A1, opts );
+    gemm( one, V2H, AV2, zero, A2, opts );
+    AV2 = Matrix<scalar_t>();
+
+    // Eigenvalues of A2 are <= sigma < eigenvalues of A1.
+    std::vector<real_t> Lambda1, Lambda2;
+    Matrix<scalar_t> Z1, Z2;
+    if (wantz) {
+        Z1 = A1.emptyLike();
+        Z2 = A2.emptyLike();
+        Z1.insertLocalTiles( target );
+        Z2.insertLocalTiles( target );
+    }
+    heev_qdwh( A1, Lambda1, Z1, opts );
+    A1 = Matrix<scalar_t>();
+    heev_qdwh( A2, Lambda2, Z2, opts );
+    A2 = Matrix<scalar_t>();
+
+    Lambda = Lambda2;
+    Lambda.insert( Lambda.end(), Lambda1.begin(), Lambda1.end() );
+
+    if (wantz) {
+        // Z = [ V2 Z2, V1 Z1 ]. The first block column starts at a tile
+        // boundary; the second one generally doesn't, so it is added by a
+        // gemm with the k-by-n selection matrix S = [ 0 I ].
+        set( zero, Z, opts );
+        auto Z_left = Z.slice( 0, n-1, 0, n-k-1 );
+        gemm( one, V2, Z2, zero, Z_left, opts );
+
+        gemm( one, V1, Z1, zero, AV1, opts );
+        auto S = A.emptyLike().slice( 0, k-1, 0, n-1 );
+        S.insertLocalTiles( target );
+        std::function< scalar_t (int64_t, int64_t) > selection
+            = [n, k]( int64_t i, int64_t j ) {
+                return j == i + n - k ? scalar_t( 1 ) : scalar_t( 0 );
+            };
+        set( selection, S, opts );
+        gemm( one, AV1, S, one, Z, opts );
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Hermitian matrix eigen decomposition, by QDWH-based
+/// spectral divide and conquer (QDWH-eig) of Nakatsukasa and Higham (2013).
+/// Computes all eigenvalues and, optionally, eigenvectors of a Hermitian
+/// matrix A, as heev, but without reducing A to tridiagonal form.
+///
+/// The spectrum is split recursively: at each level, the polar
+/// decomposition (see polar) of A - sigma I, with sigma the median of the
+/// diagonal, gives the spectral projector onto the eigenvalues > sigma,
+/// an orthonormal basis V = [ V1 V2 ] of that invariant subspace and its
+/// complement from the QR of a random sample of the projector, and the
+/// two smaller problems V1^H A V1 and V2^H A V2. Blocks of at most 2 nb,
+/// or that a shift fails to split, are solved by heev.
+///
+/// This costs several times the flops of heev, but all in gemm, geqrf,
+/// and potrf, which scale on devices and across ranks much better than
+/// the memory-bound band-to-tridiagonal reduction (hb2st) in heev.
+///
+/// Tiles of A are assumed square (mb = nb).
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     On entry, the n-by-n Hermitian matrix $A$.
+///     On exit, contents are destroyed.
+///
+/// @param[out] Lambda
+///     The vector Lambda of length n.
+///     If successful, the eigenvalues in ascending order.
+///
+/// @param[out] Z
+///     On entry, if Z is empty, does not compute eigenvectors.
+///     Otherwise, the n-by-n matrix $Z$, with A's tiles,
+///     to store eigenvectors.
+///     On exit, orthonormal eigenvectors of the matrix A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target, as for heev.
+///     - Option::MethodEig:
+///       Tridiagonal eigensolver of the blocks solved by heev, as for heev;
+///       QDWH selects DC [default].
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+void heev_qdwh(
+    HermitianMatrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
+{
+    trace::Block trace_block( "slate::heev_qdwh" );
+    Timer t_heev_qdwh;
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+
+    int64_t n = A.n();
+    int64_t nb = A.tileNb( 0 );
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    Options opts_heev = opts;
+    MethodEig method = get_option( opts, Option::MethodEig, MethodEig::DC );
+    if (method == MethodEig::QDWH)
+        opts_heev[ Option::MethodEig ] = MethodEig::DC;
+
+    // The recursion works on both triangles: A_full = A I.
+    std::function<int64_t (int64_t)> tileNb = func::uniform_blocksize( n, nb );
+    std::function<int (func::ij_tuple)> tileRank = A.tileRankFunc();
+    std::function<int (func::ij_tuple)> tileDevice = A.tileDeviceFunc();
+    Matrix<scalar_t> A_full( n, n, tileNb, tileNb, tileRank, tileDevice,
+                             A.mpiComm() );
+    A_full.insertLocalTiles( target );
+    {
+        auto Id = A_full.emptyLike();
+        Id.insertLocalTiles( target );
+        set( zero, one, Id, opts );
+        hemm( Side::Left, one, A, Id, zero, A_full, opts );
+    }
+
+    Lambda.resize( n );
+    impl::heev_qdwh( A_full, Lambda, Z, opts_heev );
+
+    internal::timers_set( opts, "heev_qdwh", t_heev_qdwh.stop() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void heev_qdwh<float>(
+    HermitianMatrix<float>& A,
+    std::vector<float>& Lambda,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+void heev_qdwh<double>(
+    HermitianMatrix<double>& A,
+    std::vector<double>& Lambda,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+void heev_qdwh< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    std::vector<float>& Lambda,
+    Matrix< std::complex<float> >& Z,
+    Options const& opts);
+
+template
+void heev_qdwh< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    std::vector<double>& Lambda,
+    Matrix< std::complex<double> >& Z,
+    Options const& opts);
+
+} // namespace slate
@@ -31,6 +31,7 @@ void hegst(
     const scalar_t one  = 1.0;
     const real_t r_one  = 1.0;
     const int priority_0 = 0;
+    const int priority_1 = 1;
     const int queue_0 = 0;
     const Layout layout = Layout::ColMajor;
 
@@ -50,16 +51,23 @@ void hegst(
 
     int64_t nt = A.nt();
 
+    // With Devices, diagonal tiles are also reduced on the devices.
+    constexpr Target target_tile = (target == Target::Devices
+                                    ? Target::Devices : Target::HostTask);
+
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector<uint8_t> column_vector(nt);
     uint8_t* column = column_vector.data();
+    // Orders the panel solves of itype = 1.
+    uint8_t solve_chain;
+    SLATE_UNUSED( solve_chain ); // Used only by OpenMP
 
     if (target == Target::Devices) {
-        // The work::trsm (itype=1) routine uses 2 queues (queue 0,1).
-        // The work::trmm (itype=2,3) routine uses 1 queue (queue 0).
-        // All other internal::routines here use the default queue (queue 0).
-        int64_t num_queues = (itype == 1) ? 2 : 1;
-        A.allocateBatchArrays(0, num_queues+lookahead); // (batch size, num_queues)
+        // itype = 1: her2k uses queue 0 for the trailing matrix and
+        // queues 1, ..., lookahead for the lookahead columns; the other
+        // device tasks lease queues from the pool (AnyQueue).
+        // itype = 2, 3: work::trmm uses queues 0, ..., lookahead.
+        A.allocateBatchArrays(0, 1+lookahead); // (batch size, num_queues)
         A.reserveDeviceWorkspace();
     }
 
@@ -75,73 +83,152 @@ void hegst(
             auto TBkk = TriangularMatrix<scalar_t>(Diag::NonUnit, Bkk);
 
             if (itype == 1) {
-                #pragma omp task depend(inout:column[k])
+                // MPI tags: the step's panel uses tag 2k, its solve 2k+1,
+                // so both overlap with other steps' messages.
+                int tag_panel = 2*k;
+                int tag_solve = 2*k + 1;
+
+                // Diagonal tile and panel:
+                // A(k, k) = L(k, k)^{-1} A(k, k) L(k, k)^{-H},
+                // A(k+1:nt-1, k) = A(k+1:nt-1, k) L(k, k)^{-H}
+                //                  - 1/2 L(k+1:nt-1, k) A(k, k),
+                // then send A(:, k) and L(:, k) for the trailing update.
+                #pragma omp task depend(inout:column[k]) priority(1)
                 {
-                    internal::hegst<Target::HostTask>(
-                        itype, std::move(Akk),
-                               std::move(Bkk));
-                }
+                    internal::hegst<target_tile>(
+                        itype, A.sub(k, k), B.sub(k, k),
+                        priority_1, AnyQueue );
 
-                if (k+1 <= nt-1) {
-                    auto Asub = A.sub(k+1, nt-1, k, k);
-                    auto Bsub = B.sub(k+1, nt-1, k, k);
+                    if (k+1 <= nt-1) {
+                        auto Asub = A.sub(k+1, nt-1, k, k);
 
-                    #pragma omp task depend(inout:column[k])
-                    {
-                        B.template tileBcast<target>(k, k, Asub, layout);
+                        B.template tileBcast<target>(
+                            k, k, Asub, layout, tag_panel );
 
                         internal::trsm<target>(
                             Side::Right,  one,  conj_transpose( TBkk ),
-                                                std::move(Asub),
-                            priority_0, layout );
-                    }
+                                                A.sub(k+1, nt-1, k, k),
+                            priority_1, layout, AnyQueue );
 
-                    #pragma omp task depend(inout:column[k])
-                    {
-                        A.tileBcast( k, k, Asub, layout );
+                        A.tileBcast( k, k, Asub, layout, tag_panel );
 
                         BcastList bcast_list;
                         for (int64_t i = k+1; i < nt; ++i) {
                             bcast_list.push_back({i, k, {A.sub(i, i, k+1, i),
                                                          A.sub(i, nt-1, i, i)}});
                         }
-                        B.template listBcast<target>( bcast_list, layout );
+                        B.template listBcast<target>(
+                            bcast_list, layout, tag_panel );
+
+                        internal::hemm<Target::HostTask>(
+                            Side::Right, -half, A.sub(k, k),
+                                                B.sub(k+1, nt-1, k, k),
+                                          one,  A.sub(k+1, nt-1, k, k),
+                            priority_1 );
+
+                        A.template listBcast<target>(
+                            bcast_list, layout, tag_panel );
                     }
+                }
 
+                // Lookahead columns of the trailing update,
+                // A(j:nt-1, j) -= A(j:nt-1, k) L(j, k)^H + L(j:nt-1, k) A(j, k)^H.
+                for (int64_t j = k+1; j < k+1+lookahead && j < nt; ++j) {
                     #pragma omp task depend(in:column[k]) \
-                                     depend(inout:column[k+1]) \
-                                     depend(inout:column[nt-1])
+                                     depend(inout:column[j]) priority(1)
                     {
-                        internal::hemm<Target::HostTask>(
-                            Side::Right, -half, std::move(Akk),
-                                                std::move(Bsub),
-                                          one,  std::move(Asub) );
-
-                        BcastList bcast_list;
-                        for (int64_t i = k+1; i < nt; ++i) {
-                            bcast_list.push_back({i, k, {A.sub(i, i, k+1, i),
-                                                         A.sub(i, nt-1, i, i)}});
+                        int64_t queue_j = 1 + j % lookahead;
+                        internal::her2k<target>(
+                            -one,  A.sub(j, j, k, k),
+                                   B.sub(j, j, k, k),
+                            r_one, A.sub(j, j),
+                            priority_1, queue_j, layout );
+
+                        if (j+1 < nt) {
+                            auto Ajk = A.sub(j, j, k, k);
+                            auto Bjk = B.sub(j, j, k, k);
+                            internal::gemm<target>(
+                                -one, A.sub(j+1, nt-1, k, k),
+                                      conj_transpose( Bjk ),
+                                one,  A.sub(j+1, nt-1, j, j),
+                                layout, priority_1, AnyQueue );
+                            internal::gemm<target>(
+                                -one, B.sub(j+1, nt-1, k, k),
+                                      conj_transpose( Ajk ),
+                                one,  A.sub(j+1, nt-1, j, j),
+                                layout, priority_1, AnyQueue );
                         }
-                        A.template listBcast<target>(bcast_list, layout);
+                    }
+                }
 
+                // Rest of the trailing update.
+                if (k+1+lookahead < nt) {
+                    #pragma omp task depend(in:column[k]) \
+                                     depend(inout:column[k+1+lookahead]) \
+                                     depend(inout:column[nt-1])
+                    {
+                        int64_t i0 = k+1+lookahead;
                         internal::her2k<target>(
-                            -one,  std::move( Asub ),
-                                   std::move( Bsub ),
-                            r_one, A.sub(k+1, nt-1),
+                            -one,  A.sub(i0, nt-1, k, k),
+                                   B.sub(i0, nt-1, k, k),
+                            r_one, A.sub(i0, nt-1),
                             priority_0, queue_0, layout );
+                    }
+                }
 
+                // Finish the panel, once the trailing update has read it:
+                // A(k+1:nt-1, k) = L(k+1:nt-1, k+1:nt-1)^{-1}
+                //     (A(k+1:nt-1, k) - 1/2 L(k+1:nt-1, k) A(k, k)).
+                // Nothing later reads it, so the next steps go on meanwhile;
+                // the solves are chained to keep their messages in order.
+                if (k+1 <= nt-1) {
+                    #pragma omp task depend(inout:column[k]) \
+                                     depend(inout:solve_chain)
+                    {
                         internal::hemm<Target::HostTask>(
-                            Side::Right,
-                            -half, std::move( Akk  ),
-                                   std::move( Bsub ),
-                            one,   std::move( Asub ) );
+                            Side::Right, -half, A.sub(k, k),
+                                                B.sub(k+1, nt-1, k, k),
+                                          one,  A.sub(k+1, nt-1, k, k),
+                            priority_0 );
 
-                        auto Bk1  = B.sub(k+1, nt-1);
-                        auto TBk1 = TriangularMatrix<scalar_t>(Diag::NonUnit, Bk1);
-                        work::trsm<target, scalar_t>(
-                            Side::Left,  one,  TBk1,
-                                               Asub, column,
-                            opts );
+                        for (int64_t i = k+1; i < nt; ++i) {
+                            auto Bii  = B.sub(i, i);
+                            auto TBii = TriangularMatrix<scalar_t>(
+                                            Diag::NonUnit, Bii);
+
+                            // A(i, k) = L(i, i)^{-1} A(i, k)
+                            B.template tileBcast<target>(
+                                i, i, A.sub(i, i, k, k), layout, tag_solve );
+                            internal::trsm<target>(
+                                Side::Left,  one,  std::move( TBii ),
+                                                   A.sub(i, i, k, k),
+                                priority_0, layout, AnyQueue );
+
+                            // A(i+1:nt-1, k) -= L(i+1:nt-1, i) A(i, k)
+                            if (i+1 < nt) {
+                                A.template tileBcast<target>(
+                                    i, k, A.sub(i+1, nt-1, k, k),
+                                    layout, tag_solve );
+
+                                BcastList bcast_list_L;
+                                for (int64_t r = i+1; r < nt; ++r) {
+                                    bcast_list_L.push_back(
+                                        {r, i, {A.sub(r, r, k, k)}});
+                                }
+                                B.template listBcast<target>(
+                                    bcast_list_L, layout, tag_solve );
+
+                                internal::gemm<target>(
+                                    -one, B.sub(i+1, nt-1, i, i),
+                                          A.sub(i, i, k, k),
+                                    one,  A.sub(i+1, nt-1, k, k),
+                                    layout, priority_0, AnyQueue );
+
+                                B.sub(i+1, nt-1, i, i).releaseRemoteWorkspace();
+                                A.sub(i, i, k, k).releaseRemoteWorkspace();
+                            }
+                            B.sub(i, i).releaseRemoteWorkspace();
+                        }
                     }
                 }
             }
@@ -202,16 +289,17 @@ void hegst(
 
                 #pragma omp task depend(inout:column[0]) depend(inout:column[k])
                 {
-                    internal::hegst<Target::HostTask>(
+                    internal::hegst<target_tile>(
                       itype,  std::move(Akk),
-                              std::move(Bkk));
+                              std::move(Bkk),
+                      priority_0, queue_0);
                 }
             }
 
             #pragma omp task depend(inout:column[k])
             {
                 auto A_panel = A.sub( k, nt-1, k, k );
-                auto B_panel = A.sub( k, nt-1, k, k );
+                auto B_panel = B.sub( k, nt-1, k, k );
 
                 A_panel.releaseRemoteWorkspace();
                 B_panel.releaseRemoteWorkspace();
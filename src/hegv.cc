@@ -42,6 +42,8 @@ namespace slate {
 ///     On entry, the n-by-n Hermitian positive definite matrix $B$.
 ///     On exit, B is overwritten by the triangular factor U or L from
 ///     the Cholesky factorization $B = U^H U$ or $B = L L^H$.
+///     For another A with the same B, call hegv_factored with this B
+///     to skip the factorization.
 ///
 /// @param[out] Lambda
 ///     The vector Lambda of length n.
@@ -79,6 +81,66 @@ void hegv(
     std::vector< blas::real_type<scalar_t> >& Lambda,
     Matrix<scalar_t>& Z,
     Options const& opts)
+{
+    Timer t_hegv;
+
+    // 1. Form a Cholesky factorization of B.
+    Timer t_potrf;
+    potrf( B, opts );
+    double time_potrf = t_potrf.stop();
+
+    // 2-4. Transform, solve, and backtransform, reusing the factor of B.
+    hegv_factored( itype, A, B, Lambda, Z, opts );
+
+    internal::timers_set( opts, "hegv::potrf", time_potrf );
+    internal::timers_set( opts, "hegv", t_hegv.stop() );
+}
+
+//------------------------------------------------------------------------------
+/// Same as hegv, but with B already factored by potrf, e.g., by a previous
+/// call to hegv with the same B. This skips the Cholesky factorization,
+/// which in a Rayleigh-Ritz iteration, where A changes every iteration but
+/// B rarely changes, would otherwise be repeated for each A.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] itype
+///     - itype = 1: Compute $A   z = \lambda B z$;
+///     - itype = 2: Compute $A B z = \lambda   z$;
+///     - itype = 3: Compute $B A z = \lambda   z$.
+///
+/// @param[in,out] A
+///     On entry, the n-by-n Hermitian matrix $A$.
+///     On exit, contents are destroyed.
+///
+/// @param[in] B
+///     The triangular factor U or L from the Cholesky factorization
+///     $B = U^H U$ or $B = L L^H$, as computed by potrf or hegv.
+///     B is not modified.
+///
+/// @param[out] Lambda
+///     The vector Lambda of length n.
+///     If successful, the eigenvalues in ascending order.
+///
+/// @param[out] Z
+///     On entry, if Z is empty, does not compute eigenvectors.
+///     On exit, orthonormal eigenvectors of the matrix A.
+///
+/// @param[in] opts
+///     Additional options, as for hegv.
+///
+/// @ingroup hegv
+///
+template <typename scalar_t>
+void hegv_factored(
+    int64_t itype,
+    HermitianMatrix<scalar_t>& A,
+    HermitianMatrix<scalar_t>& B,
+    std::vector< blas::real_type<scalar_t> >& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts)
 {
     // Constants
     const scalar_t one = 1.0;
@@ -87,23 +149,21 @@ void hegv(
 
     Timer t_hegv;
 
-    // 1. Form a Cholesky factorization of B.
-    Timer t_potrf;
-    potrf( B, opts );
-    timers[ "hegv::potrf" ] = t_potrf.stop();
+    // 1. B is already factored.
+    internal::timers_reset( opts, "hegv::potrf" );
 
     // 2. Transform problem to standard eigenvalue problem.
     Timer t_hegst;
     hegst( itype, A, B, opts );
-    timers[ "hegv::hegst" ] = t_hegst.stop();
+    internal::timers_set( opts, "hegv::hegst", t_hegst.stop() );
 
     // 3. Solve the standard eigenvalue problem and solve.
     Timer t_heev;
     heev( A, Lambda, Z, opts );
-    timers[ "hegv::heev" ] = t_heev.stop();
+    internal::timers_set( opts, "hegv::heev", t_heev.stop() );
 
-    timers[ "hegv::trsm" ] = 0;
-    timers[ "hegv::trmm" ] = 0;
+    internal::timers_reset( opts, "hegv::trsm" );
+    internal::timers_reset( opts, "hegv::trmm" );
     if (wantz) {
         // 4. Backtransform eigenvectors to the original problem.
         auto L = TriangularMatrix<scalar_t>( Diag::NonUnit, B );
@@ -113,17 +173,17 @@ void hegv(
             auto LH = conj_transpose( L );
             Timer t_trsm;
             trsm( Side::Left, one, LH, Z, opts );
-            timers[ "hegv::trsm" ] += t_trsm.stop();
+            internal::timers_add( opts, "hegv::trsm", t_trsm.stop() );
         }
         else {
             // For B A x = lambda x,
             // backtransform eigenvectors: x = L y.
             Timer t_trmm;
             trmm( Side::Left, one, L, Z, opts );
-            timers[ "hegv::trmm" ] += t_trmm.stop();
+            internal::timers_add( opts, "hegv::trmm", t_trmm.stop() );
         }
     }
-    timers[ "hegv" ] = t_hegv.stop();
+    internal::timers_set( opts, "hegv", t_hegv.stop() );
 }
 
 //------------------------------------------------------------------------------
@@ -164,4 +224,40 @@ void hegv< std::complex<double> >(
     Matrix< std::complex<double> >& Z,
     Options const& opts);
 
+template
+void hegv_factored<float>(
+    int64_t itype,
+    HermitianMatrix<float>& A,
+    HermitianMatrix<float>& B,
+    std::vector<float>& Lambda,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+void hegv_factored<double>(
+    int64_t itype,
+    HermitianMatrix<double>& A,
+    HermitianMatrix<double>& B,
+    std::vector<double>& Lambda,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+void hegv_factored< std::complex<float> >(
+    int64_t itype,
+    HermitianMatrix< std::complex<float> >& A,
+    HermitianMatrix< std::complex<float> >& B,
+    std::vector<float>& Lambda,
+    Matrix< std::complex<float> >& Z,
+    Options const& opts);
+
+template
+void hegv_factored< std::complex<double> >(
+    int64_t itype,
+    HermitianMatrix< std::complex<double> >& A,
+    HermitianMatrix< std::complex<double> >& B,
+    std::vector<double>& Lambda,
+    Matrix< std::complex<double> >& Z,
+    Options const& opts);
+
 } // namespace slate
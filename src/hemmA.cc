@@ -72,7 +72,9 @@ void hemmA(
         if (A.num_devices() > 1)
             slate_not_implemented( "hemmA doesn't support multiple GPUs" );
 
-        C.allocateBatchArrays();
+        // internal::gemmA uses A's batch arrays.
+        A.allocateBatchArrays();
+        A.reserveDeviceWorkspace();
         C.reserveDeviceWorkspace();
     }
 
@@ -186,7 +188,7 @@ void hemmA(
             #pragma omp task depend(in:bcast[0]) \
                              depend(out:gemm[0])
             {
-                internal::hemmA<Target::HostTask>(
+                internal::hemmA<target>(
                     Side::Left,
                     alpha, A.sub(0, 0),
                            B.sub(0, 0, 0, B.nt()-1),
@@ -278,7 +280,7 @@ void hemmA(
                         one,   C.sub(0, k-1, 0, C.nt()-1),
                         layout );
 
-                    internal::hemmA<Target::HostTask>(
+                    internal::hemmA<target>(
                         Side::Left,
                         alpha, A.sub(k, k),
                                B.sub(k, k, 0, B.nt()-1),
@@ -434,7 +436,7 @@ void hemmA(
             #pragma omp task depend(in:bcast[0]) \
                              depend(out:gemm[0])
             {
-                internal::hemmA<Target::HostTask>(
+                internal::hemmA<target>(
                     Side::Left,
                     alpha, A.sub(0, 0),
                            B.sub(0, 0, 0, B.nt()-1),
@@ -525,7 +527,7 @@ void hemmA(
                         one,   C.sub(0, k-1, 0, C.nt()-1),
                         layout );
 
-                    internal::hemmA<Target::HostTask>(
+                    internal::hemmA<target>(
                         Side::Left,
                         alpha, A.sub(k, k),
                                B.sub(k, k, 0, B.nt()-1),
@@ -659,9 +661,12 @@ void hemmA(
             impl::hemmA<Target::HostTask>( side, alpha, A, B, beta, C, opts );
             break;
 
+        case Target::Devices:
+            impl::hemmA<Target::Devices>( side, alpha, A, B, beta, C, opts );
+            break;
+
         case Target::HostNest:
         case Target::HostBatch:
-        case Target::Devices:
             slate_not_implemented("target not yet supported");
             break;
     }
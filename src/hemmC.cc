@@ -167,7 +167,7 @@ void hemmC(
 
                     // Figure out what tiles were bcast to this rank and
                     // release them.
-                    std::set<ij_tuple> tile_set;
+                    TileSet tile_set;
                     for (int64_t i = 1; i < A.mt(); ++i) {
                         if (! A.tileIsLocal( i, 0 ) ) {
                             for (int64_t j = 0; j < C.nt(); ++j) {
@@ -260,7 +260,7 @@ void hemmC(
 
                         // Figure out what tiles were bcast to this rank and
                         // release them.
-                        std::set<ij_tuple> tile_set;
+                        TileSet tile_set;
                         for (int64_t i = k+1; i < A.mt(); ++i) {
                             if (! A.tileIsLocal( i, k ) ) {
                                 for (int64_t j = 0; j < C.nt(); ++j) {
@@ -357,7 +357,7 @@ void hemmC(
 
                     // Figure out what tiles were bcast to this rank and
                     // release them.
-                    std::set<ij_tuple> tile_set;
+                    TileSet tile_set;
                     for (int64_t i = 1; i < A.mt(); ++i) {
                         for (int64_t j = 0; j < C.nt(); ++j) {
                             if (C.tileIsLocal( i, j ) && ! A.tileIsLocal( 0, i )) {
@@ -448,7 +448,7 @@ void hemmC(
 
                         // Figure out what tiles were bcast to this rank and
                         // release them.
-                        std::set<ij_tuple> tile_set;
+                        TileSet tile_set;
                         for (int64_t i = k+1; i < A.mt(); ++i) {
                             for (int64_t j = 0; j < C.nt(); ++j) {
                                 if (C.tileIsLocal( i, j ) && ! A.tileIsLocal( k, i )) {
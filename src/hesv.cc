@@ -112,16 +112,16 @@ int64_t hesv(
     // factorization
     Timer t_hetrf;
     int64_t info = hetrf( A_, pivots, T, pivots2, H, opts );
-    timers[ "hesv::hetrf" ] = t_hetrf.stop();
+    internal::timers_set( opts, "hesv::hetrf", t_hetrf.stop() );
 
     // solve
     Timer t_hetrs;
     if (info == 0) {
         hetrs( A_, pivots, T, pivots2, B, opts );
     }
-    timers[ "hesv::hetrs" ] = t_hetrs.stop();
+    internal::timers_set( opts, "hesv::hetrs", t_hetrs.stop() );
 
-    timers[ "hesv" ] = t_hesv.stop();
+    internal::timers_set( opts, "hesv", t_hesv.stop() );
 
     return info;
 }
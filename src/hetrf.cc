@@ -20,7 +20,9 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel Hermitian indefinite $LTL^T$ factorization.
 /// Generic implementation for any target.
-/// <b>GPU version not yet implemented.</b>
+/// For Target::Devices, the left-looking updates of the L panel run on
+/// the devices, while the column panel, the updates of T, and the symmetric
+/// row and column swaps stay on the host.
 /// @ingroup hesv_impl
 ///
 template <Target target, typename scalar_t>
@@ -45,6 +47,9 @@ int64_t hetrf(
     const int tag_0 = 0;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
+    // Only HostTask and Devices are used for the updates of L.
+    constexpr Target target_dev
+        = (target == Target::Devices ? Target::Devices : Target::HostTask);
 
     // Options
     real_t pivot_threshold
@@ -78,6 +83,13 @@ int64_t hetrf(
 
     pivots.resize(A_mt);
 
+    if (target == Target::Devices) {
+        // One queue is used by internal::gemm and internal::gemmA.
+        const int64_t batch_size_default = 0;
+        A.allocateBatchArrays( batch_size_default, 1 );
+        A.reserveDeviceWorkspace();
+    }
+
     int rank;
     MPI_Comm_rank(A.mpiComm(), &rank);
     #pragma omp parallel
@@ -180,7 +192,8 @@ int64_t hetrf(
                                         T.sub(k, k, k, k),
                                         {A.sub(k, k, 0, k-2)}
                                       });
-                T.template listReduce<target>(reduce_list, layout, tag);
+                // T is updated by host tile operations, so reduce on host.
+                T.template listReduce<Target::HostTask>(reduce_list, layout, tag);
 
                 T.sub( k, k, k, k ).releaseRemoteWorkspace();
 
@@ -296,7 +309,7 @@ int64_t hetrf(
                             Hj = conj_transpose( Hj );
 
                             #if 1
-                                slate::internal::gemmA<Target::HostTask>(
+                                slate::internal::gemmA<target_dev>(
                                     -one, A.sub(k+1, A_mt-1, 0, k-2),
                                           Hj.sub(0, k-2, 0, 0),
                                     one,  A.sub(k+1, A_mt-1, k, k),
@@ -324,7 +337,7 @@ int64_t hetrf(
                                                         {A.sub(i, i, 0, k-2)}
                                                       });
                             }
-                            A.template listReduce<target>(reduce_list, layout, tag1);
+                            A.template listReduce<target_dev>(reduce_list, layout, tag1);
                         }
                         else {
                             for (int64_t j = 0; j < k-1; ++j) {
@@ -509,6 +522,7 @@ int64_t hetrf(
 
     // second-stage (factorization of band matrix)
     gbtrf(T, pivots2, {
+        {Option::Target, target_dev},
         {Option::InnerBlocking, ib},
         {slate::Option::Lookahead, lookahead},
         {slate::Option::MaxPanelThreads, max_panel_threads}});
@@ -603,8 +617,7 @@ int64_t hetrf(
             return impl::hetrf<Target::HostBatch>( A, pivots, T, pivots2, H, opts );
 
         case Target::Devices:
-            slate_not_implemented( "hetrf not yet implemented for GPU devices" );
-            break;
+            return impl::hetrf<Target::Devices>( A, pivots, T, pivots2, H, opts );
     }
     return -6;  // shouldn't happen
 }
@@ -85,6 +85,22 @@ __global__ void geadd_batch_kernel(
         beta,  Barray[ blockIdx.x ], ldb );
 }
 
+//------------------------------------------------------------------------------
+/// Kernel implementing variable-size batched element-wise tile addition.
+/// @copydoc geadd_vbatch
+template <typename scalar_t>
+__global__ void geadd_vbatch_kernel(
+    int64_t const* m, int64_t const* n,
+    scalar_t alpha, scalar_t** Aarray, int64_t const* lda,
+    scalar_t beta,  scalar_t** Barray, int64_t const* ldb)
+{
+    int64_t k = blockIdx.x;
+    geadd_func(
+        m[ k ], n[ k ],
+        alpha, Aarray[ k ], lda[ k ],
+        beta,  Barray[ k ], ldb[ k ] );
+}
+
 //------------------------------------------------------------------------------
 /// Routine for element-wise tile addition.
 /// Sets
@@ -309,5 +325,129 @@ void geadd(
 }
 
 } // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile addition.
+/// Sets
+/// \[
+///     Barray[k] = \alpha Aarray[k] + \beta Barray[k],
+/// \]
+/// where each tile has its own dimensions, so one launch covers interior
+/// and edge tiles alike.
+///
+/// @param[in] m
+///     Array in GPU memory of dimension batch_count.
+///     Number of rows of each tile. m[k] >= 0.
+///
+/// @param[in] n
+///     Array in GPU memory of dimension batch_count.
+///     Number of columns of each tile. n[k] >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m[k]-by-n[k] matrix stored in an
+///     lda[k]-by-n[k] array in GPU memory.
+///
+/// @param[in] lda
+///     Array in GPU memory of dimension batch_count.
+///     Leading dimension of each tile in A. lda[k] >= m[k].
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m[k]-by-n[k] matrix stored in an
+///     ldb[k]-by-n[k] array in GPU memory.
+///
+/// @param[in] ldb
+///     Array in GPU memory of dimension batch_count.
+///     Leading dimension of each tile in B. ldb[k] >= m[k].
+///
+/// @param[in] max_m
+///     Maximum of m[k], which sets the number of threads.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t const* lda,
+    scalar_t const& beta,  scalar_t** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    // Max threads/block=1024 for current CUDA compute capability (<= 7.5)
+    int64_t nthreads = std::min( int64_t( 1024 ), max_m );
+
+    geadd_vbatch_kernel<<<batch_count, nthreads, 0, queue.stream()>>>(
+        m, n,
+        alpha, Aarray, lda,
+        beta, Barray, ldb);
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    float const& alpha, float** Aarray, int64_t const* lda,
+    float const& beta,  float** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    double const& alpha, double** Aarray, int64_t const* lda,
+    double const& beta,  double** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> const& alpha, std::complex<float>** Aarray, int64_t const* lda,
+    std::complex<float> const& beta,  std::complex<float>** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+    geadd_vbatch( m, n,
+                  rocblas_float_complex( real( alpha ), imag( alpha ) ),
+                  (rocblas_float_complex**) Aarray, lda,
+                  rocblas_float_complex( real( beta ), imag( beta ) ),
+                  (rocblas_float_complex**) Barray, ldb,
+                  max_m, batch_count, queue );
+}
+
+template <>
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> const& alpha, std::complex<double>** Aarray, int64_t const* lda,
+    std::complex<double> const& beta,  std::complex<double>** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+    geadd_vbatch( m, n,
+                  rocblas_double_complex( real( alpha ), imag( alpha ) ),
+                  (rocblas_double_complex**) Aarray, lda,
+                  rocblas_double_complex( real( beta ), imag( beta ) ),
+                  (rocblas_double_complex**) Barray, ldb,
+                  max_m, batch_count, queue );
+}
+
 } // namespace device
 } // namespace slate
@@ -0,0 +1,385 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel implementing copy or add with precision conversion, fused with
+/// the max norm of each column, for mixed-precision iterative refinement.
+/// If add is false, sets B = A; col_max is the max norm of columns of A.
+/// If add is true,  sets B = A + B; col_max is the max norm of columns of
+/// the updated B.
+/// Each thread block deals with one tile, with ib threads.
+/// Each thread copies one row of each ib-by-ib sub-tile, coalesced,
+/// saving absolute values in shared memory; then each thread takes the max
+/// of one column of the sub-tile.
+/// Launched by gecopy_col_max() and geadd_col_max().
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 1.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 1.
+///
+/// @param[in] Aarray
+///     Array of tiles of dimension gridDim.x,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in Aarray. lda >= m.
+///
+/// @param[in,out] Barray
+///     Array of tiles of dimension gridDim.x,
+///     where each Barray[k] is an m-by-n matrix stored in an ldb-by-n array.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in Barray. ldb >= m.
+///
+/// @param[out] col_max
+///     Array of dimension gridDim.x * ldv.
+///     On exit, col_max[ k*ldv + j ] is the max norm of column j of tile k.
+///
+/// @param[in] ldv
+///     Leading dimension of col_max. ldv >= n.
+///
+template <bool add, typename src_scalar_t, typename dst_scalar_t,
+          typename real_t>
+__global__ void gecopy_col_max_kernel(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    real_t* col_max, int64_t ldv)
+{
+    src_scalar_t const* tileA = Aarray[ blockIdx.x ];
+    dst_scalar_t*       tileB = Barray[ blockIdx.x ];
+    extern __shared__ char dynamic_data[];
+    real_t* shmem_tile = (real_t*)dynamic_data;
+    const int k = threadIdx.x;
+
+    for (int64_t jj = 0; jj < n; jj += ib) {
+        real_t max = 0.0;
+        for (int64_t ii = 0; ii < m; ii += ib) {
+            // Copy ib-by-ib sub-tile, one column at a time in parallel,
+            // saving absolute values into shared memory.
+            for (int64_t j = 0; j < ib; ++j) {
+                if (jj+j < n && ii+k < m) {
+                    src_scalar_t a = tileA[ (jj+j)*lda + ii+k ];
+                    dst_scalar_t& b = tileB[ (jj+j)*ldb + ii+k ];
+                    if (add) {
+                        dst_scalar_t tmp;
+                        copy( a, tmp );
+                        b += tmp;
+                        shmem_tile[ j*ib1 + k ] = abs( b );
+                    }
+                    else {
+                        copy( a, b );
+                        shmem_tile[ j*ib1 + k ] = abs( a );
+                    }
+                }
+            }
+            __syncthreads();  // shmem_tile loaded
+
+            // Each thread computes max of one column.
+            for (int64_t i = 0; i < ib; ++i)
+                if (jj+k < n && ii+i < m)
+                    max = max_nan( shmem_tile[ k*ib1 + i ], max );
+            __syncthreads();  // done with shmem_tile
+        }
+
+        if (jj+k < n)
+            col_max[ blockIdx.x*ldv + jj+k ] = max;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Launches gecopy_col_max_kernel, after casting std::complex to the
+/// device complex types.
+///
+template <bool add, typename src_scalar_t, typename dst_scalar_t,
+          typename real_t>
+void gecopy_col_max_launch(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    real_t* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    if (m == 0 || n == 0) {
+        blas::device_memset( col_max, 0, batch_count * ldv, queue );
+    }
+    else {
+        assert( ldv >= n );
+        size_t shared_mem = sizeof(real_t) * ib * ib1;
+        gecopy_col_max_kernel<add>
+            <<<batch_count, ib, shared_mem, queue.stream()>>>(
+                m, n, Aarray, lda, Barray, ldb, col_max, ldv );
+    }
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise copy and precision conversion,
+/// copying A to B, fused with the max norm of each column of A. Sets
+/// \[
+///     Barray[k] = Aarray[k],
+///     col_max[ k*ldv + j ] = max_i abs( Aarray[k]_(i, j) ).
+/// \]
+/// Used to down-convert the residual in mixed-precision iterative
+/// refinement while computing its column norms, in one pass.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m-by-n matrix stored in an ldb-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[out] col_max
+///     Array in GPU memory of dimension batch_count * ldv, in the higher
+///     precision of A and B.
+///
+/// @param[in] ldv
+///     Leading dimension of col_max. ldv >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+//------------------------------------------------------------------------------
+// Specializations, for the precision conversions of mixed-precision solvers,
+// casting std::complex => hipComplex.
+
+// double => float
+template <>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    double const* const* Aarray, int64_t lda,
+    float** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<false>(
+        m, n,
+        (double const* const*) Aarray, lda,
+        (float**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+// float => double
+template <>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    float const* const* Aarray, int64_t lda,
+    double** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<false>(
+        m, n,
+        (float const* const*) Aarray, lda,
+        (double**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+// complex-double => complex-float
+template <>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    std::complex<float>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<false>(
+        m, n,
+        (rocblas_double_complex const* const*) Aarray, lda,
+        (rocblas_float_complex**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+// complex-float => complex-double
+template <>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    std::complex<double>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<false>(
+        m, n,
+        (rocblas_float_complex const* const*) Aarray, lda,
+        (rocblas_double_complex**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise add and precision conversion,
+/// adding A to B, fused with the max norm of each column of the result. Sets
+/// \[
+///     Barray[k] = Aarray[k] + Barray[k],
+///     col_max[ k*ldv + j ] = max_i abs( Barray[k]_(i, j) ).
+/// \]
+/// Used to up-convert the correction and update the solution in
+/// mixed-precision iterative refinement while computing its column norms,
+/// in one pass.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in,out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m-by-n matrix stored in an ldb-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[out] col_max
+///     Array in GPU memory of dimension batch_count * ldv, in the higher
+///     precision of A and B.
+///
+/// @param[in] ldv
+///     Leading dimension of col_max. ldv >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+//------------------------------------------------------------------------------
+// Specializations, for the precision conversions of mixed-precision solvers,
+// casting std::complex => hipComplex.
+
+// double => float
+template <>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    double const* const* Aarray, int64_t lda,
+    float** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<true>(
+        m, n,
+        (double const* const*) Aarray, lda,
+        (float**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+// float => double
+template <>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    float const* const* Aarray, int64_t lda,
+    double** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<true>(
+        m, n,
+        (float const* const*) Aarray, lda,
+        (double**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+// complex-double => complex-float
+template <>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    std::complex<float>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<true>(
+        m, n,
+        (rocblas_double_complex const* const*) Aarray, lda,
+        (rocblas_float_complex**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+// complex-float => complex-double
+template <>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    std::complex<double>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_launch<true>(
+        m, n,
+        (rocblas_float_complex const* const*) Aarray, lda,
+        (rocblas_double_complex**) Barray, ldb,
+        col_max, ldv,
+        batch_count, queue );
+}
+
+} // namespace device
+} // namespace slate
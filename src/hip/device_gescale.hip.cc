@@ -60,6 +60,19 @@ __global__ void gescale_batch_kernel(
     gescale_func( m, n, mul, Aarray[ blockIdx.x ], lda );
 }
 
+//------------------------------------------------------------------------------
+/// Kernel implementing variable-size batched element-wise tile scale.
+/// @copydoc gescale_vbatch
+template <typename scalar_t, typename scalar_t2>
+__global__ void gescale_vbatch_kernel(
+    int64_t const* m, int64_t const* n,
+    scalar_t2 mul,
+    scalar_t** Aarray, int64_t const* lda)
+{
+    int64_t k = blockIdx.x;
+    gescale_func( m[ k ], n[ k ], mul, Aarray[ k ], lda[ k ] );
+}
+
 //------------------------------------------------------------------------------
 /// Kernel implementing element-wise tile scale.
 /// Each thread block deals with one tile.
@@ -311,5 +324,140 @@ void gescale(
 }
 
 } // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile scale,
+/// Aarray[k] = (numer / denom) Aarray[k],
+/// where each tile has its own dimensions, so one launch covers interior
+/// and edge tiles alike.
+///
+/// @param[in] m
+///     Array in GPU memory of dimension batch_count.
+///     Number of rows of each tile. m[k] >= 0.
+///
+/// @param[in] n
+///     Array in GPU memory of dimension batch_count.
+///     Number of columns of each tile. n[k] >= 0.
+///
+/// @param[in] numer
+///     Scale value numerator.
+///
+/// @param[in] denom
+///     Scale value denominator.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m[k]-by-n[k] matrix stored in an
+///     lda[k]-by-n[k] array in GPU memory.
+///
+/// @param[in] lda
+///     Array in GPU memory of dimension batch_count.
+///     Leading dimension of each tile in A. lda[k] >= m[k].
+///
+/// @param[in] max_m
+///     Maximum of m[k], which sets the number of threads.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t, typename scalar_t2>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t2 numer, scalar_t2 denom,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    // Max threads/block=1024 for current CUDA compute capability (<= 7.5)
+    int64_t nthreads = std::min( int64_t( 1024 ), max_m );
+
+    scalar_t2 mul = numer / denom;
+
+    gescale_vbatch_kernel<<<batch_count, nthreads, 0, queue.stream()>>>(
+        m, n,
+        mul, Aarray, lda);
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    float numer, float denom,
+    float** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    double numer, double denom,
+    double** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    float numer, float denom,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+    gescale_vbatch( m, n, numer, denom,
+                    (rocblas_float_complex**) Aarray, lda,
+                    max_m, batch_count, queue );
+}
+
+template <>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> numer, std::complex<float> denom,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+    gescale_vbatch( m, n,
+                    rocblas_float_complex( real( numer ), imag( numer ) ),
+                    rocblas_float_complex( real( denom ), imag( denom ) ),
+                    (rocblas_float_complex**) Aarray, lda,
+                    max_m, batch_count, queue );
+}
+
+template <>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    double numer,  double denom,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+    gescale_vbatch( m, n, numer, denom,
+                    (rocblas_double_complex**) Aarray, lda,
+                    max_m, batch_count, queue );
+}
+
+template <>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> numer, std::complex<double> denom,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+    gescale_vbatch( m, n,
+                    rocblas_double_complex( real( numer ), imag( numer ) ),
+                    rocblas_double_complex( real( denom ), imag( denom ) ),
+                    (rocblas_double_complex**) Aarray, lda,
+                    max_m, batch_count, queue );
+}
+
 } // namespace device
 } // namespace slate
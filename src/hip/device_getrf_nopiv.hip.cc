@@ -0,0 +1,157 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel factoring one tile, A = L U, without pivoting.
+/// One thread block does the whole tile: the factorization is
+/// right-looking, one column per step, with the block synchronizing
+/// between steps.
+/// Launched by getrf_nopiv().
+///
+/// @copydoc getrf_nopiv
+///
+template <typename scalar_t>
+__global__ void getrf_nopiv_kernel(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    lapack::device_info_int* info)
+{
+    __shared__ int64_t s_info;
+
+    if (threadIdx.x == 0)
+        s_info = 0;
+
+    int64_t kmax = m < n ? m : n;
+    for (int64_t j = 0; j < kmax; ++j) {
+        __syncthreads();  // previous trailing update done
+        scalar_t ajj = A[ j + j*lda ];
+        if (threadIdx.x == 0 && s_info == 0
+            && real( ajj ) == 0 && imag( ajj ) == 0) {
+            // As in LAPACK, continue; the factors will have Inf or NaN.
+            s_info = j + 1;
+        }
+
+        // L(j+1:m, j) = A(j+1:m, j) / U(j, j)
+        for (int64_t i = j + 1 + threadIdx.x; i < m; i += blockDim.x) {
+            A[ i + j*lda ] = A[ i + j*lda ] / ajj;
+        }
+        __syncthreads();
+
+        // A(j+1:m, j+1:n) -= L(j+1:m, j) U(j, j+1:n)
+        int64_t mt = m - j - 1;
+        int64_t nt = n - j - 1;
+        for (int64_t idx = threadIdx.x; idx < mt*nt; idx += blockDim.x) {
+            int64_t i = j + 1 + idx % mt;
+            int64_t l = j + 1 + idx / mt;
+            A[ i + l*lda ] = A[ i + l*lda ] - A[ i + j*lda ] * A[ j + l*lda ];
+        }
+    }
+    __syncthreads();
+
+    if (threadIdx.x == 0)
+        *info = s_info;
+}
+
+//------------------------------------------------------------------------------
+/// LU factorization of one tile without pivoting, A = L U, in a single
+/// kernel launch, so the diagonal tile of getrf_nopiv stays on the device.
+/// L is unit lower triangular (trapezoidal if m > n), U is upper
+/// triangular (trapezoidal if m < n).
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array in GPU memory.
+///     On exit, the factors L and U; the unit diagonal of L is not stored.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[out] info
+///     In GPU memory. On exit, 0 if successful, or i > 0 if U(i, i) is
+///     exactly zero (1-based index); the factorization is completed, but
+///     will have Inf or NaN due to division by zero.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+    hipSetDevice( queue.device() );
+
+    if (m == 0 || n == 0) {
+        blas::device_memset( info, 0, 1, queue );
+        return;
+    }
+
+    int64_t nthreads = 256;
+
+    getrf_nopiv_kernel<<<1, nthreads, 0, queue.stream()>>>(
+        m, n, A, lda, info );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+    getrf_nopiv( m, n, (rocblas_float_complex*) A, lda, info, queue );
+}
+
+template <>
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+    getrf_nopiv( m, n, (rocblas_double_complex*) A, lda, info, queue );
+}
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,220 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel factoring one Hermitian positive definite tile, A = L L^H,
+/// then computing Ainv = L^{-1}. One thread block does the whole tile:
+/// the factorization is right-looking, one column per step, with the
+/// block synchronizing between steps; the inverse is computed by
+/// forward substitution, one thread per column of L^{-1}.
+/// Launched by potrf_trtri().
+///
+/// @copydoc potrf_trtri
+///
+template <typename scalar_t>
+__global__ void potrf_trtri_kernel(
+    bool lower, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* Ainv, int64_t ldainv,
+    lapack::device_info_int* info)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    __shared__ real_t s_diag;
+    __shared__ int64_t s_info;
+
+    if (threadIdx.x == 0)
+        s_info = 0;
+
+    for (int64_t j = 0; j < n; ++j) {
+        __syncthreads();  // previous trailing update done
+        if (threadIdx.x == 0) {
+            real_t ajj = real( load_L( lower, A, lda, j, j ) );
+            // ! (ajj > 0) also catches NaN.
+            if (! (ajj > 0)) {
+                s_info = j + 1;
+            }
+            else {
+                ajj = sqrt( ajj );
+                scalar_t ajj_s;
+                copy( ajj, ajj_s );
+                store_L( lower, A, lda, j, j, ajj_s );
+            }
+            s_diag = ajj;
+        }
+        __syncthreads();
+        if (s_info != 0)
+            break;
+
+        // L(j+1:n, j) = A(j+1:n, j) / L(j, j)
+        real_t ajj = s_diag;
+        for (int64_t i = j + 1 + threadIdx.x; i < n; i += blockDim.x) {
+            store_L( lower, A, lda, i, j, load_L( lower, A, lda, i, j ) / ajj );
+        }
+        __syncthreads();
+
+        // Lower triangle of A(j+1:n, j+1:n) -= L(j+1:n, j) L(j+1:n, j)^H
+        int64_t nt = n - j - 1;
+        for (int64_t idx = threadIdx.x; idx < nt*nt; idx += blockDim.x) {
+            int64_t i = j + 1 + idx % nt;
+            int64_t l = j + 1 + idx / nt;
+            if (i >= l) {
+                store_L( lower, A, lda, i, l,
+                         load_L( lower, A, lda, i, l )
+                         - load_L( lower, A, lda, i, j )
+                           * conj( load_L( lower, A, lda, l, j ) ) );
+            }
+        }
+    }
+    __syncthreads();
+
+    if (threadIdx.x == 0)
+        *info = s_info;
+    if (s_info != 0)
+        return;
+
+    // Column j of L^{-1} solves L x = e_j; x(0:j-1) = 0.
+    scalar_t zero, one;
+    copy( real_t( 0 ), zero );
+    copy( real_t( 1 ), one );
+    for (int64_t j = threadIdx.x; j < n; j += blockDim.x) {
+        for (int64_t i = 0; i < j; ++i)
+            store_L( lower, Ainv, ldainv, i, j, zero );
+        store_L( lower, Ainv, ldainv, j, j,
+                 one / load_L( lower, A, lda, j, j ) );
+        for (int64_t i = j + 1; i < n; ++i) {
+            scalar_t sum = zero;
+            for (int64_t l = j; l < i; ++l) {
+                sum += load_L( lower, A, lda, i, l )
+                       * load_L( lower, Ainv, ldainv, l, j );
+            }
+            store_L( lower, Ainv, ldainv, i, j,
+                     -sum / load_L( lower, A, lda, i, i ) );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Fused Cholesky factorization and triangular inverse of one tile,
+/// computing A = L L^H (lower) or A = U^H U (upper), and
+/// Ainv = L^{-1} or U^{-1}, in a single kernel launch.
+/// Replaces a device potrf followed by trsm with the factor, which for
+/// small tiles is a chain of latency bound library calls; the panel can
+/// then be updated by trmm with Ainv.
+///
+/// @param[in] uplo
+///     Whether the lower or upper triangle of A is stored.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n Hermitian positive definite matrix A,
+///     stored in an lda-by-n array in GPU memory.
+///     On exit, the uplo triangle holds the Cholesky factor.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[out] Ainv
+///     The n-by-n array in GPU memory. On exit, if info = 0,
+///     the uplo triangle holds the inverse of the Cholesky factor, and
+///     the opposite triangle is set to zero.
+///
+/// @param[in] ldainv
+///     Leading dimension of Ainv. ldainv >= n.
+///
+/// @param[out] info
+///     In GPU memory. On exit, 0 if successful, or i > 0 if the leading
+///     minor of order i is not positive definite; then Ainv is not set.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+    hipSetDevice( queue.device() );
+
+    if (n == 0) {
+        blas::device_memset( info, 0, 1, queue );
+        return;
+    }
+
+    int64_t nthreads = 256;
+
+    potrf_trtri_kernel<<<1, nthreads, 0, queue.stream()>>>(
+        uplo == Uplo::Lower, n, A, lda, Ainv, ldainv, info );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+    potrf_trtri( uplo, n,
+                 (rocblas_float_complex*) A, lda,
+                 (rocblas_float_complex*) Ainv, ldainv,
+                 info, queue );
+}
+
+template <>
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+    potrf_trtri( uplo, n,
+                 (rocblas_double_complex*) A, lda,
+                 (rocblas_double_complex*) Ainv, ldainv,
+                 info, queue );
+}
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,263 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hip.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Kernel inverting one triangular tile in place. One thread block does the
+/// whole tile, as LAPACK trti2: columns from right to left, each multiplied
+/// by the already inverted trailing triangle. Rows of a column are updated
+/// bottom up, blockDim.x rows at a time, so each thread reads only rows
+/// not yet overwritten.
+/// Launched by trtri().
+///
+/// @copydoc trtri
+///
+template <typename scalar_t>
+__global__ void trtri_kernel(
+    bool lower, bool unit, int64_t n,
+    scalar_t* A, int64_t lda)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    __shared__ scalar_t s_ajj;
+
+    scalar_t zero, one;
+    copy( real_t( 0 ), zero );
+    copy( real_t( 1 ), one );
+
+    for (int64_t j = n-1; j >= 0; --j) {
+        __syncthreads();  // previous column done
+        if (threadIdx.x == 0) {
+            scalar_t ajj = one;
+            if (! unit) {
+                ajj = one / load_L( lower, A, lda, j, j );
+                store_L( lower, A, lda, j, j, ajj );
+            }
+            s_ajj = -ajj;
+        }
+        __syncthreads();
+        scalar_t ajj = s_ajj;
+
+        // L(j+1:n, j) = -L(j, j)^{-1} L(j+1:n, j+1:n)^{-1} L(j+1:n, j),
+        // with the trailing triangle already inverted.
+        for (int64_t i_end = n; i_end > j + 1; i_end -= blockDim.x) {
+            int64_t i = i_end - 1 - threadIdx.x;
+            scalar_t sum = zero;
+            if (i > j) {
+                sum = load_L( lower, A, lda, i, j );
+                if (! unit)
+                    sum *= load_L( lower, A, lda, i, i );
+                for (int64_t l = j + 1; l < i; ++l) {
+                    sum += load_L( lower, A, lda, i, l )
+                           * load_L( lower, A, lda, l, j );
+                }
+            }
+            __syncthreads();  // rows of this chunk read
+            if (i > j)
+                store_L( lower, A, lda, i, j, ajj * sum );
+            __syncthreads();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Kernel computing L^H L or U U^H of one triangular tile in place.
+/// One thread block does the whole tile, as LAPACK lauu2: row i of the
+/// result needs only rows i:n-1 of L, so rows are done top down, one per
+/// step, with one thread per column of the row.
+/// Launched by trtrm().
+///
+/// @copydoc trtrm
+///
+template <typename scalar_t>
+__global__ void trtrm_kernel(
+    bool lower, int64_t n,
+    scalar_t* A, int64_t lda)
+{
+    __shared__ scalar_t s_aii;
+
+    for (int64_t i = 0; i < n; ++i) {
+        __syncthreads();  // previous row done
+        if (threadIdx.x == 0)
+            s_aii = load_L( lower, A, lda, i, i );
+        __syncthreads();
+        scalar_t aii = conj( s_aii );
+
+        // L(i, 0:i) = L(i:n, i)^H L(i:n, 0:i)
+        for (int64_t l = threadIdx.x; l <= i; l += blockDim.x) {
+            scalar_t sum = aii * load_L( lower, A, lda, i, l );
+            for (int64_t k = i + 1; k < n; ++k) {
+                sum += conj( load_L( lower, A, lda, k, i ) )
+                       * load_L( lower, A, lda, k, l );
+            }
+            store_L( lower, A, lda, i, l, sum );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Inverse of one triangular tile, in place, in a single kernel launch.
+/// Replaces a round trip of the diagonal tile to the host for LAPACK trtri
+/// in each step of the distributed trtri.
+///
+/// @param[in] uplo
+///     Whether A is lower or upper triangular.
+///
+/// @param[in] diag
+///     Whether A has a unit or non-unit diagonal.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n triangular matrix A,
+///     stored in an lda-by-n array in GPU memory.
+///     On exit, the uplo triangle holds the inverse of A.
+///     If A is singular, the result has Inf or NaN entries.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+    if (n == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = 256;
+
+    trtri_kernel<<<1, nthreads, 0, queue.stream()>>>(
+        uplo == Uplo::Lower, diag == Diag::Unit, n, A, lda );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+/// Product of one triangular tile with its conjugate transpose, in place,
+/// A = L^H L (lower) or A = U U^H (upper), as LAPACK lauum,
+/// in a single kernel launch.
+///
+/// @param[in] uplo
+///     Whether A is lower or upper triangular.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n triangular matrix L or U,
+///     stored in an lda-by-n array in GPU memory.
+///     On exit, the uplo triangle holds L^H L or U U^H.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void trtrm(
+    Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+    if (n == 0)
+        return;
+
+    hipSetDevice( queue.device() );
+
+    int64_t nthreads = 256;
+
+    trtrm_kernel<<<1, nthreads, 0, queue.stream()>>>(
+        uplo == Uplo::Lower, n, A, lda );
+
+    hipError_t error = hipGetLastError();
+    slate_assert(error == hipSuccess);
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtrm(
+    Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtrm(
+    Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+//------------------------------------------------------------------------------
+// Specializations to cast std::complex => hipComplex.
+template <>
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue)
+{
+    trtri( uplo, diag, n, (rocblas_float_complex*) A, lda, queue );
+}
+
+template <>
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue)
+{
+    trtri( uplo, diag, n, (rocblas_double_complex*) A, lda, queue );
+}
+
+template <>
+void trtrm(
+    Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue)
+{
+    trtrm( uplo, n, (rocblas_float_complex*) A, lda, queue );
+}
+
+template <>
+void trtrm(
+    Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue)
+{
+    trtrm( uplo, n, (rocblas_double_complex*) A, lda, queue );
+}
+
+} // namespace device
+} // namespace slate
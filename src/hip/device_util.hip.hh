@@ -784,6 +784,31 @@ operator != (const float s, const rocblas_float_complex a)
 
 #endif // BLAS_WITH_CUBLAS
 
+//------------------------------------------------------------------------------
+/// @return element L(i, j), i >= j, of a lower triangular matrix L stored
+/// in A, either in the lower triangle, or as U = L^H in the upper triangle,
+/// e.g., a Cholesky factor.
+template <typename scalar_t>
+__device__ inline scalar_t load_L(
+    bool lower, scalar_t const* A, int64_t lda, int64_t i, int64_t j)
+{
+    return lower ? A[ i + j*lda ] : conj( A[ j + i*lda ] );
+}
+
+//------------------------------------------------------------------------------
+/// Sets element L(i, j) of the lower triangular matrix L stored in A;
+/// see load_L.
+template <typename scalar_t>
+__device__ inline void store_L(
+    bool lower, scalar_t* A, int64_t lda, int64_t i, int64_t j,
+    scalar_t value)
+{
+    if (lower)
+        A[ i + j*lda ] = value;
+    else
+        A[ j + i*lda ] = conj( value );
+}
+
 } // namespace device
 } // namespace slate
 
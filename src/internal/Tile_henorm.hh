@@ -43,24 +43,28 @@ void henorm(Norm norm, Tile<scalar_t> const& A,
     else if (norm == Norm::One || norm == Norm::Inf) {
         // one norm
         // values[j] = sum_i abs( A_{i,j} )
+        // Inner loops vectorize as in synorm.
         std::fill_n(values, A.nb(), 0);
         for (int64_t j = 0; j < A.nb(); ++j) {
+            const scalar_t* Aj = &A.at(0, j);
+            real_t sum = std::abs( real( A(j, j) ) );  // diag (real)
             if (A.uplo() == Uplo::Lower) {
-                values[j] += std::abs( real( A(j, j) ) );  // diag (real)
+                #pragma omp simd reduction(+:sum)
                 for (int64_t i = j+1; i < A.mb(); ++i) { // strictly lower
-                    real_t tmp = std::abs(A(i, j));
-                    values[j] += tmp;
+                    real_t tmp = std::abs(Aj[i]);  // A(i, j)
+                    sum += tmp;
                     values[i] += tmp;
                 }
             }
             else { // upper
+                #pragma omp simd reduction(+:sum)
                 for (int64_t i = 0; i < j; ++i) { // strictly upper
-                    real_t tmp = std::abs(A(i, j));
-                    values[j] += tmp;
+                    real_t tmp = std::abs(Aj[i]);  // A(i, j)
+                    sum += tmp;
                     values[i] += tmp;
                 }
-                values[j] += std::abs( real( A(j, j) ) );  // diag (real)
             }
+            values[j] += sum;
         }
     }
     else if (norm == Norm::Fro) {
@@ -42,12 +42,16 @@ void genorm(Norm norm, NormScope scope, Tile<scalar_t> const& A,
         // one norm
         // values[j] = sum_i abs( A_{i,j} )
         else if (norm == Norm::One) {
+            using real_t = blas::real_type<scalar_t>;
             for (int64_t j = 0; j < nb; ++j) {
                 const scalar_t* Aj = &A.at(0, j);
-                values[j] = std::abs( Aj[0] ); // A(0, j)
-                for (int64_t i = 1; i < mb; ++i) {
-                    values[j] += std::abs( Aj[i] );  // A(i, j)
+                // Local sum, so the compiler can vectorize the reduction.
+                real_t sum = 0;
+                #pragma omp simd reduction(+:sum)
+                for (int64_t i = 0; i < mb; ++i) {
+                    sum += std::abs( Aj[i] );  // A(i, j)
                 }
+                values[j] = sum;
             }
         }
         // inf norm
@@ -59,6 +63,7 @@ void genorm(Norm norm, NormScope scope, Tile<scalar_t> const& A,
             }
             for (int64_t j = 1; j < nb; ++j) {
                 Aj = &A.at(0, j);
+                #pragma omp simd
                 for (int64_t i = 0; i < mb; ++i) {
                     values[i] += std::abs( Aj[i] );  // A(i, j)
                 }
@@ -70,8 +75,14 @@ void genorm(Norm norm, NormScope scope, Tile<scalar_t> const& A,
         else if (norm == Norm::Fro) {
             values[0] = 0;  // scale
             values[1] = 1;  // sumsq
-            for (int64_t j = 0; j < nb; ++j) {
-                lapack::lassq(mb, &A.at(0, j), 1, &values[0], &values[1]);
+            if (A.stride() == mb) {
+                // Contiguous tile: one pass over all mb*nb elements.
+                lapack::lassq(mb*nb, A.data(), 1, &values[0], &values[1]);
+            }
+            else {
+                for (int64_t j = 0; j < nb; ++j) {
+                    lapack::lassq(mb, &A.at(0, j), 1, &values[0], &values[1]);
+                }
             }
         }
         else {
@@ -119,6 +130,7 @@ template <typename scalar_t>
 void trnorm(Norm norm, Diag diag, Tile<scalar_t> const& A,
             blas::real_type<scalar_t>* values)
 {
+    using real_t = blas::real_type<scalar_t>;
     using blas::max;
     using blas::min;
 
@@ -152,16 +164,21 @@ void trnorm(Norm norm, Diag diag, Tile<scalar_t> const& A,
                 }
             }
             // off-diagonal elements
+            real_t sum = 0;
             if (A.uplo() == Uplo::Lower) {
+                #pragma omp simd reduction(+:sum)
                 for (int64_t i = j+1; i < mb; ++i) { // strictly lower
-                    values[j] += std::abs(Aj[i]);  // A(i, j)
+                    sum += std::abs(Aj[i]);  // A(i, j)
                 }
             }
             else {
-                for (int64_t i = 0; i < j && i < mb; ++i) { // strictly upper
-                    values[j] += std::abs(Aj[i]);  // A(i, j)
+                int64_t ib = min(j, mb);
+                #pragma omp simd reduction(+:sum)
+                for (int64_t i = 0; i < ib; ++i) { // strictly upper
+                    sum += std::abs(Aj[i]);  // A(i, j)
                 }
             }
+            values[j] += sum;
         }
     }
     else if (norm == Norm::Inf) {
@@ -183,12 +200,15 @@ void trnorm(Norm norm, Diag diag, Tile<scalar_t> const& A,
             }
             // off-diagonal elements
             if (A.uplo() == Uplo::Lower) {
+                #pragma omp simd
                 for (int64_t i = j+1; i < mb; ++i) { // strictly lower
                     values[i] += std::abs(Aj[i]);  // A(i, j)
                 }
             }
             else {
-                for (int64_t i = 0; i < j && i < mb; ++i) { // strictly upper
+                int64_t ib = min(j, mb);
+                #pragma omp simd
+                for (int64_t i = 0; i < ib; ++i) { // strictly upper
                     values[i] += std::abs(Aj[i]);  // A(i, j)
                 }
             }
@@ -0,0 +1,166 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_POTRF_UPDATE_HH
+#define SLATE_TILE_POTRF_UPDATE_HH
+
+#include "slate/Tile.hh"
+#include "slate/types.hh"
+#include "slate/internal/util.hh"
+
+#include <cmath>
+
+#include <blas.hh>
+
+namespace slate {
+namespace tile {
+
+//------------------------------------------------------------------------------
+/// Updates the diagonal tile L of a Cholesky factor, $L L^H$, by the rows
+/// X of the update, to $L L^H + sign X X^H$, by one rotation per element
+/// of X, eliminating X.
+/// For each column x of X in turn, for each column p of L in turn,
+/// with $s = x_p / L_{pp}$ and $c = \sqrt{ 1 + sign |s|^2 }$,
+/// the rotation is
+/// \[
+///     [ L_{:,p} \; x ] = [ (L_{:,p} + sign \bar{s} x) / c
+///                        \; \; c x - s L_{:,p} ],
+/// \]
+/// a Givens rotation for an update (sign = 1) and a hyperbolic rotation
+/// for a downdate (sign = -1).
+/// The diagonal of L need not be real or positive, as for the R factor
+/// from geqrf; each diagonal element keeps its phase.
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in,out] L
+///     On entry, the n-by-n lower triangular tile L, with nonzero
+///     diagonal; if L is conj-transposed, its data is upper triangular.
+///     On exit, the updated factor.
+///
+/// @param[in,out] X
+///     On entry, the n-by-k tile X; it may be conj-transposed, but not
+///     transposed.
+///     On exit, the rotations $s$, to apply to the tiles below L by
+///     potrf_update_apply().
+///
+/// @return 0 if successful, or p > 0 if L(p, p) is zero or the downdated
+///     matrix is not positive definite at column p (1-based index) of L.
+///
+/// @ingroup posv_tile
+///
+template <typename scalar_t>
+int64_t potrf_update_diag(
+    blas::real_type<scalar_t> sign,
+    Tile<scalar_t> L,
+    Tile<scalar_t> X)
+{
+    trace::Block trace_block("slate::potrf_update_diag");
+
+    using blas::conj;
+    using blas::real;
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t n = L.mb();
+    assert( L.nb() == n );
+    assert( X.mb() == n );
+    assert( X.op() != Op::Trans );
+    bool conj_L = L.op() == Op::ConjTrans;
+    bool conj_X = X.op() == Op::ConjTrans;
+
+    for (int64_t q = 0; q < X.nb(); ++q) {
+        for (int64_t p = 0; p < n; ++p) {
+            scalar_t lpp = conj_L ? conj( L.at( p, p ) ) : L.at( p, p );
+            if (lpp == scalar_t( 0 ))
+                return p + 1;
+            scalar_t xpq = conj_X ? conj( X.at( p, q ) ) : X.at( p, q );
+            scalar_t s = xpq / lpp;
+            real_t c2 = 1 + sign * real( s * conj( s ) );
+            if (! (c2 > 0))  // also catches NaN
+                return p + 1;
+            real_t c = std::sqrt( c2 );
+
+            L.at( p, p ) = conj_L ? conj( lpp * c ) : lpp * c;
+            // x_p is eliminated; keep the rotation
+            X.at( p, q ) = conj_X ? conj( s ) : s;
+            for (int64_t i = p + 1; i < n; ++i) {
+                scalar_t lip = conj_L ? conj( L.at( i, p ) ) : L.at( i, p );
+                scalar_t xiq = conj_X ? conj( X.at( i, q ) ) : X.at( i, q );
+                lip = (lip + sign * conj( s ) * xiq) / c;
+                xiq = c * xiq - s * lip;
+                L.at( i, p ) = conj_L ? conj( lip ) : lip;
+                X.at( i, q ) = conj_X ? conj( xiq ) : xiq;
+            }
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations S of potrf_update_diag() to a tile L below the
+/// diagonal tile of a Cholesky factor, and the rows X of the update in
+/// the same block row, in the same order.
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate, as in potrf_update_diag().
+///
+/// @param[in] S
+///     The nb-by-k rotations, from potrf_update_diag(); conj-transposed
+///     if X is.
+///
+/// @param[in,out] L
+///     The m-by-nb tile of the factor below the diagonal tile;
+///     it may be conj-transposed.
+///
+/// @param[in,out] X
+///     The m-by-k tile of the update rows; it may be conj-transposed,
+///     but not transposed.
+///
+/// @ingroup posv_tile
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    blas::real_type<scalar_t> sign,
+    Tile<scalar_t> S,
+    Tile<scalar_t> L,
+    Tile<scalar_t> X)
+{
+    trace::Block trace_block("slate::potrf_update_apply");
+
+    using blas::conj;
+    using blas::real;
+    using real_t = blas::real_type<scalar_t>;
+
+    int64_t m = L.mb();
+    int64_t nb = L.nb();
+    assert( S.mb() == nb );
+    assert( X.mb() == m );
+    assert( X.nb() == S.nb() );
+    assert( X.op() != Op::Trans );
+    assert( S.op() == X.op() );
+    bool conj_L = L.op() == Op::ConjTrans;
+    bool conj_X = X.op() == Op::ConjTrans;
+
+    for (int64_t q = 0; q < X.nb(); ++q) {
+        for (int64_t p = 0; p < nb; ++p) {
+            scalar_t s = conj_X ? conj( S.at( p, q ) ) : S.at( p, q );
+            real_t c = std::sqrt( 1 + sign * real( s * conj( s ) ) );
+            for (int64_t i = 0; i < m; ++i) {
+                scalar_t lip = conj_L ? conj( L.at( i, p ) ) : L.at( i, p );
+                scalar_t xiq = conj_X ? conj( X.at( i, q ) ) : X.at( i, q );
+                lip = (lip + sign * conj( s ) * xiq) / c;
+                xiq = c * xiq - s * lip;
+                L.at( i, p ) = conj_L ? conj( lip ) : lip;
+                X.at( i, q ) = conj_X ? conj( xiq ) : xiq;
+            }
+        }
+    }
+}
+
+} // namespace tile
+} // namespace slate
+
+#endif // SLATE_TILE_POTRF_UPDATE_HH
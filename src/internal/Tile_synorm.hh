@@ -40,24 +40,29 @@ void synorm(Norm norm, Tile<scalar_t> const& A,
     else if (norm == Norm::One || norm == Norm::Inf) {
         // one norm
         // values[j] = sum_i abs( A_{i,j} )
+        // Column j's sum is a local reduction, and rows i != j are
+        // independent, so the compiler can vectorize the inner loops.
         std::fill_n(values, A.nb(), 0);
         for (int64_t j = 0; j < A.nb(); ++j) {
+            const scalar_t* Aj = &A.at(0, j);
+            real_t sum = std::abs(A(j, j));  // diag
             if (A.uplo() == Uplo::Lower) {
-                values[j] += std::abs(A(j, j));  // diag
+                #pragma omp simd reduction(+:sum)
                 for (int64_t i = j+1; i < A.mb(); ++i) { // strictly lower
-                    real_t tmp = std::abs(A(i, j));
-                    values[j] += tmp;
+                    real_t tmp = std::abs(Aj[i]);  // A(i, j)
+                    sum += tmp;
                     values[i] += tmp;
                 }
             }
             else { // upper
+                #pragma omp simd reduction(+:sum)
                 for (int64_t i = 0; i < j; ++i) { // strictly upper
-                    real_t tmp = std::abs(A(i, j));
-                    values[j] += tmp;
+                    real_t tmp = std::abs(Aj[i]);  // A(i, j)
+                    sum += tmp;
                     values[i] += tmp;
                 }
-                values[j] += std::abs(A(j, j));  // diag
             }
+            values[j] += sum;
         }
     }
     else if (norm == Norm::Fro) {
@@ -122,14 +127,15 @@ void synormOffdiag(Norm norm, Tile<scalar_t> const& A,
     if (norm == Norm::One || norm == Norm::Inf) {
         std::fill_n(row_sums, A.mb(), 0);
         for (int64_t j = 0; j < A.nb(); ++j) {
-            real_t tmp = std::abs(A(0, j));
-            col_sums[j] = tmp;
-            row_sums[0] += tmp;
-            for (int64_t i = 1; i < A.mb(); ++i) {
-                tmp = std::abs(A(i, j));
-                col_sums[j] += tmp;
+            const scalar_t* Aj = &A.at(0, j);
+            real_t sum = 0;
+            #pragma omp simd reduction(+:sum)
+            for (int64_t i = 0; i < A.mb(); ++i) {
+                real_t tmp = std::abs(Aj[i]);  // A(i, j)
+                sum += tmp;
                 row_sums[i] += tmp;
             }
+            col_sums[j] = sum;
         }
     }
     else {
@@ -0,0 +1,314 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_TILE_TLR_HH
+#define SLATE_TILE_TLR_HH
+
+#include <blas.hh>
+#include <lapack.hh>
+
+#include "slate/Tile.hh"
+#include "slate/TileLowRankMatrix.hh"
+#include "slate/internal/Trace.hh"
+
+#include <vector>
+
+namespace slate {
+namespace tile {
+
+//------------------------------------------------------------------------------
+/// Compresses the product $A = U V^H$ of an mb-by-r U and an nb-by-r V,
+/// truncated at singular values <= tol, into L. Uses QR factorizations
+/// U = Qu Ru and V = Qv Rv, and the SVD of the small Ru Rv^H, so costs
+/// O((mb + nb) r^2).
+/// @ingroup tlr_tile
+///
+template <typename scalar_t>
+void tlr_recompress(
+    int64_t mb, int64_t nb, int64_t r,
+    scalar_t const* U, int64_t ldu,
+    scalar_t const* V, int64_t ldv,
+    blas::real_type<scalar_t> tol,
+    LowRankTile<scalar_t>& L)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::Op;
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    L = LowRankTile<scalar_t>( mb, nb );
+    if (r == 0)
+        return;
+
+    int64_t ru = std::min( mb, r );
+    int64_t rv = std::min( nb, r );
+    std::vector<scalar_t> Qu( mb*r ), Qv( nb*r ), tau_u( ru ), tau_v( rv );
+    lapack::lacpy( lapack::MatrixType::General, mb, r, U, ldu, Qu.data(), mb );
+    lapack::lacpy( lapack::MatrixType::General, nb, r, V, ldv, Qv.data(), nb );
+    lapack::geqrf( mb, r, Qu.data(), mb, tau_u.data() );
+    lapack::geqrf( nb, r, Qv.data(), nb, tau_v.data() );
+
+    // M = Ru Rv^H, with Ru ru-by-r and Rv rv-by-r upper trapezoidal.
+    std::vector<scalar_t> Ru( ru*r, zero ), Rv( rv*r, zero ), M( ru*rv );
+    lapack::lacpy( lapack::MatrixType::Upper, ru, r, Qu.data(), mb, Ru.data(), ru );
+    lapack::lacpy( lapack::MatrixType::Upper, rv, r, Qv.data(), nb, Rv.data(), rv );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                ru, rv, r,
+                one,  Ru.data(), ru,
+                      Rv.data(), rv,
+                zero, M.data(), ru );
+
+    // M = W S Z^H, truncated to the singular values > tol.
+    int64_t k = std::min( ru, rv );
+    std::vector<real_t> S( k );
+    std::vector<scalar_t> W( ru*k ), ZH( k*rv );
+    lapack::gesvd( lapack::Job::SomeVec, lapack::Job::SomeVec, ru, rv,
+                   M.data(), ru, S.data(), W.data(), ru, ZH.data(), k );
+    int64_t rank = 0;
+    while (rank < k && S[ rank ] > tol)
+        ++rank;
+    if (rank == 0)
+        return;
+
+    // U = Qu W S, V = Qv Z.
+    lapack::ungqr( mb, ru, ru, Qu.data(), mb, tau_u.data() );
+    lapack::ungqr( nb, rv, rv, Qv.data(), nb, tau_v.data() );
+    for (int64_t l = 0; l < rank; ++l) {
+        for (int64_t i = 0; i < ru; ++i)
+            W[ i + l*ru ] *= S[ l ];
+    }
+    L.resize( rank );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                mb, rank, ru,
+                one,  Qu.data(), mb,
+                      W.data(), ru,
+                zero, L.U(), L.ldu() );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                nb, rank, rv,
+                one,  Qv.data(), nb,
+                      ZH.data(), k,
+                zero, L.V(), L.ldv() );
+}
+
+//------------------------------------------------------------------------------
+/// Compresses dense tile A into L, truncated at singular values <= tol,
+/// so $\|A - U V^H\|_2 \le tol$.
+/// @ingroup tlr_tile
+///
+template <typename scalar_t>
+void tlr_compress(
+    Tile<scalar_t> const& A,
+    blas::real_type<scalar_t> tol,
+    LowRankTile<scalar_t>& L)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    trace::Block trace_block("tlr_compress");
+
+    assert( A.layout() == Layout::ColMajor );
+    assert( A.op() == Op::NoTrans );
+
+    int64_t mb = A.mb();
+    int64_t nb = A.nb();
+    int64_t k = std::min( mb, nb );
+    std::vector<scalar_t> work( mb*nb ), U( mb*k ), VH( k*nb );
+    std::vector<real_t> S( k );
+    lapack::lacpy( lapack::MatrixType::General, mb, nb,
+                   A.data(), A.stride(), work.data(), mb );
+    lapack::gesvd( lapack::Job::SomeVec, lapack::Job::SomeVec, mb, nb,
+                   work.data(), mb, S.data(), U.data(), mb, VH.data(), k );
+
+    int64_t rank = 0;
+    while (rank < k && S[ rank ] > tol)
+        ++rank;
+
+    L = LowRankTile<scalar_t>( mb, nb, rank );
+    for (int64_t l = 0; l < rank; ++l) {
+        for (int64_t i = 0; i < mb; ++i)
+            L.U()[ i + l*mb ] = U[ i + l*mb ] * S[ l ];
+        for (int64_t j = 0; j < nb; ++j)
+            L.V()[ j + l*nb ] = conj( VH[ l + j*k ] );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Low-rank update $C = \alpha A B^H + C$ of low-rank tiles, where A is
+/// mb-by-k and B is nb-by-k, with C recompressed at tolerance tol.
+/// @ingroup tlr_tile
+///
+template <typename scalar_t>
+void tlr_gemm(
+    scalar_t alpha, LowRankTile<scalar_t> const& A,
+                    LowRankTile<scalar_t> const& B,
+    LowRankTile<scalar_t>& C,
+    blas::real_type<scalar_t> tol)
+{
+    using blas::Op;
+
+    trace::Block trace_block("tlr_gemm");
+
+    const scalar_t zero = 0.0;
+
+    int64_t ka = A.rank();
+    int64_t kb = B.rank();
+    if (ka == 0 || kb == 0)
+        return;
+
+    int64_t mb = C.mb();
+    int64_t nb = C.nb();
+    int64_t kc = C.rank();
+    int64_t r  = kc + ka;
+
+    // X = A.V^H B.V, ka-by-kb.
+    std::vector<scalar_t> X( ka*kb );
+    blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                ka, kb, A.nb(),
+                scalar_t( 1.0 ), A.V(), A.ldv(),
+                                 B.V(), B.ldv(),
+                zero,            X.data(), ka );
+
+    // alpha A B^H = (alpha A.U) (B.U X^H)^H, appended to C's factors.
+    std::vector<scalar_t> U( mb*r ), V( nb*r );
+    lapack::lacpy( lapack::MatrixType::General, mb, kc,
+                   C.U(), C.ldu(), U.data(), mb );
+    lapack::lacpy( lapack::MatrixType::General, nb, kc,
+                   C.V(), C.ldv(), V.data(), nb );
+    for (int64_t l = 0; l < ka; ++l) {
+        for (int64_t i = 0; i < mb; ++i)
+            U[ i + (kc + l)*mb ] = alpha * A.U()[ i + l*A.ldu() ];
+    }
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                nb, ka, kb,
+                scalar_t( 1.0 ), B.U(), B.ldu(),
+                                 X.data(), ka,
+                zero,            &V[ kc*nb ], nb );
+
+    tlr_recompress( mb, nb, r, U.data(), mb, V.data(), nb, tol, C );
+}
+
+//------------------------------------------------------------------------------
+/// Hermitian rank-k update $C = \alpha A A^H + C$ of dense tile C by
+/// low-rank tile A.
+/// @ingroup tlr_tile
+///
+template <typename scalar_t>
+void tlr_herk(
+    blas::real_type<scalar_t> alpha, LowRankTile<scalar_t> const& A,
+    Tile<scalar_t>&& C)
+{
+    using blas::Op;
+
+    trace::Block trace_block("tlr_herk");
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    int64_t k = A.rank();
+    if (k == 0)
+        return;
+
+    // A A^H = (A.U X) A.U^H, where X = A.V^H A.V.
+    int64_t mb = A.mb();
+    std::vector<scalar_t> X( k*k ), T( mb*k );
+    blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                k, k, A.nb(),
+                one,  A.V(), A.ldv(),
+                      A.V(), A.ldv(),
+                zero, X.data(), k );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                mb, k, k,
+                one,  A.U(), A.ldu(),
+                      X.data(), k,
+                zero, T.data(), mb );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::ConjTrans,
+                mb, mb, k,
+                scalar_t( alpha ), T.data(), mb,
+                                   A.U(), A.ldu(),
+                one,               C.data(), C.stride() );
+}
+
+//------------------------------------------------------------------------------
+/// Triangular solve $A = A L^{-H}$ of low-rank tile A, where L is the
+/// lower triangle of dense tile L. Since $A L^{-H} = U (L^{-1} V)^H$,
+/// only V is updated.
+/// @ingroup tlr_tile
+///
+template <typename scalar_t>
+void tlr_trsm(
+    Tile<scalar_t>&& L,
+    LowRankTile<scalar_t>& A)
+{
+    trace::Block trace_block("tlr_trsm");
+
+    if (A.rank() == 0)
+        return;
+
+    blas::trsm( blas::Layout::ColMajor, blas::Side::Left, blas::Uplo::Lower,
+                blas::Op::NoTrans, blas::Diag::NonUnit,
+                A.nb(), A.rank(),
+                scalar_t( 1.0 ), L.data(), L.stride(),
+                                 A.V(), A.ldv() );
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies $C = \alpha op(A) B + \beta C$, where A is a low-rank tile
+/// and B and C are dense tiles; op is NoTrans or ConjTrans.
+/// @ingroup tlr_tile
+///
+template <typename scalar_t>
+void tlr_gemm(
+    Op op,
+    scalar_t alpha, LowRankTile<scalar_t> const& A,
+                    Tile<scalar_t> const& B,
+    scalar_t beta,  Tile<scalar_t>&& C)
+{
+    using blas::Op;
+
+    trace::Block trace_block("tlr_gemm");
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    int64_t k = A.rank();
+    int64_t n = C.nb();
+    if (k == 0) {
+        // C = beta C; as in BLAS, beta = 0 doesn't read C.
+        if (beta != one) {
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t i = 0; i < C.mb(); ++i) {
+                    scalar_t& c = C.data()[ i + j*C.stride() ];
+                    c = (beta == zero ? zero : beta * c);
+                }
+            }
+        }
+        return;
+    }
+
+    // op = NoTrans:   A B   = U (V^H B);
+    // op = ConjTrans: A^H B = V (U^H B).
+    scalar_t const* X = (op == Op::NoTrans ? A.V() : A.U());
+    scalar_t const* Y = (op == Op::NoTrans ? A.U() : A.V());
+    int64_t ldx = (op == Op::NoTrans ? A.ldv() : A.ldu());
+    int64_t ldy = (op == Op::NoTrans ? A.ldu() : A.ldv());
+    int64_t kb  = (op == Op::NoTrans ? A.nb() : A.mb());
+
+    std::vector<scalar_t> T( k*n );
+    blas::gemm( blas::Layout::ColMajor, Op::ConjTrans, Op::NoTrans,
+                k, n, kb,
+                one,  X, ldx,
+                      B.data(), B.stride(),
+                zero, T.data(), k );
+    blas::gemm( blas::Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                C.mb(), n, k,
+                alpha, Y, ldy,
+                       T.data(), k,
+                beta,  C.data(), C.stride() );
+}
+
+} // namespace tile
+} // namespace slate
+
+#endif // SLATE_TILE_TLR_HH
@@ -8,6 +8,7 @@
 
 #include "slate/Tile.hh"
 #include "slate/types.hh"
+#include "slate/internal/device.hh"
 
 #include <list>
 #include <vector>
@@ -148,6 +149,168 @@ void tpmqrt(
 #endif
 }
 
+
+//------------------------------------------------------------------------------
+/// Multiply the matrix C by the unitary matrix Q obtained from a
+/// "triangular-pentagonal" block reflector H, on a GPU device.
+/// Same as the host tpmqrt, but V2, T, C1, C2 reside on the device of queue,
+/// and each ib-block of reflectors is applied as in LAPACK's tprfb,
+/// with gemm and trmm calls on queue, which stays asynchronous.
+///
+/// @param[in] work
+///     Device workspace of dimension 2*ib*n if side == Left,
+///     2*ib*m if side == Right, where ib = min( T.mb(), k ).
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+/// @see tpmqrt
+///
+template <typename scalar_t>
+void tpmqrt(
+    Side side, Op op, int64_t l,
+    Tile<scalar_t> V2,
+    Tile<scalar_t> T,
+    Tile<scalar_t> C1,
+    Tile<scalar_t> C2,
+    scalar_t* work,
+    blas::Queue& queue)
+{
+    trace::Block trace_block("slate::device::tpmqrt");
+
+    const scalar_t one = 1.0;
+    const Layout col = Layout::ColMajor;
+
+    // Same dimensions as the host version.
+    int64_t m, n, k, mv;
+    k = V2.nb();
+    if (side == Side::Left) {
+        m  = std::min( V2.mb(), k );
+        n  = C1.nb();
+        mv = m;
+    }
+    else {
+        m  = C1.mb();
+        n  = std::min( V2.mb(), k );
+        mv = n;
+    }
+    assert( l == mv || l == 0 );
+    int64_t ib = std::min( T.mb(), k );
+
+    int64_t ldv = V2.stride();
+    int64_t ldt = T.stride();
+    int64_t ld1 = C1.stride();
+    int64_t ld2 = C2.stride();
+    scalar_t* V  = V2.data();
+    scalar_t* Tp = T.data();
+    scalar_t* c1 = C1.data();
+    scalar_t* c2 = C2.data();
+
+    // W is ib-by-n (Left) or m-by-ib (Right); P holds the product with
+    // the trapezoidal part of V, at most the same size.
+    int64_t ldw = (side == Side::Left ? ib : m);
+    scalar_t* W = work;
+    scalar_t* P = work + (side == Side::Left ? ib*n : m*ib);
+
+    // Left, ConjTrans and Right, NoTrans apply the blocks forward.
+    bool forward = (side == Side::Left) == (op != Op::NoTrans);
+    int64_t nblocks = ceildiv( k, ib );
+    for (int64_t b = 0; b < nblocks; ++b) {
+        int64_t i = (forward ? b : nblocks - 1 - b) * ib;
+        int64_t kb = std::min( ib, k - i );
+        // Rows of V in this block: rectangular mr, then lb trapezoidal.
+        int64_t mb = std::min( mv - l + i + kb, mv );
+        int64_t lb = (i >= l ? 0 : mb - mv + l - i);
+        int64_t mr = mb - lb;
+        scalar_t* Vr = &V[ i*ldv ];         // mr-by-kb
+        scalar_t* Vt = &V[ mr + i*ldv ];    // lb-by-kb, upper trapezoid
+        scalar_t* Ti = &Tp[ i*ldt ];        // kb-by-kb, upper triangle
+
+        if (side == Side::Left) {
+            // W = C1( i:i+kb, : ) + V^H C2( 0:mb, : )
+            blas::device_copy_matrix( kb, n, &c1[ i ], ld1, W, ldw, queue );
+            if (mr > 0) {
+                blas::gemm( col, Op::ConjTrans, Op::NoTrans, kb, n, mr,
+                            one, Vr, ldv, c2, ld2, one, W, ldw, queue );
+            }
+            if (lb > 0) {
+                blas::device_copy_matrix( lb, n, &c2[ mr ], ld2, P, ldw, queue );
+                blas::trmm( col, Side::Left, Uplo::Upper, Op::ConjTrans,
+                            Diag::NonUnit, lb, n, one, Vt, ldv, P, ldw, queue );
+                device::geadd( lb, n, one, P, ldw, one, W, ldw, queue );
+                if (kb > lb) {
+                    blas::gemm( col, Op::ConjTrans, Op::NoTrans, kb - lb, n, lb,
+                                one, &Vt[ lb*ldv ], ldv, &c2[ mr ], ld2,
+                                one, &W[ lb ], ldw, queue );
+                }
+            }
+
+            // W = op( T ) W
+            blas::trmm( col, Side::Left, Uplo::Upper, op, Diag::NonUnit,
+                        kb, n, one, Ti, ldt, W, ldw, queue );
+
+            // C1( i:i+kb, : ) -= W;  C2( 0:mb, : ) -= V W
+            device::geadd( kb, n, -one, W, ldw, one, &c1[ i ], ld1, queue );
+            if (mr > 0) {
+                blas::gemm( col, Op::NoTrans, Op::NoTrans, mr, n, kb,
+                            -one, Vr, ldv, W, ldw, one, c2, ld2, queue );
+            }
+            if (lb > 0) {
+                blas::device_copy_matrix( lb, n, W, ldw, P, ldw, queue );
+                blas::trmm( col, Side::Left, Uplo::Upper, Op::NoTrans,
+                            Diag::NonUnit, lb, n, one, Vt, ldv, P, ldw, queue );
+                if (kb > lb) {
+                    blas::gemm( col, Op::NoTrans, Op::NoTrans, lb, n, kb - lb,
+                                one, &Vt[ lb*ldv ], ldv, &W[ lb ], ldw,
+                                one, P, ldw, queue );
+                }
+                device::geadd( lb, n, -one, P, ldw, one, &c2[ mr ], ld2, queue );
+            }
+        }
+        else {
+            // W = C1( :, i:i+kb ) + C2( :, 0:mb ) V
+            blas::device_copy_matrix( m, kb, &c1[ i*ld1 ], ld1, W, ldw, queue );
+            if (mr > 0) {
+                blas::gemm( col, Op::NoTrans, Op::NoTrans, m, kb, mr,
+                            one, c2, ld2, Vr, ldv, one, W, ldw, queue );
+            }
+            if (lb > 0) {
+                blas::device_copy_matrix( m, lb, &c2[ mr*ld2 ], ld2, P, ldw, queue );
+                blas::trmm( col, Side::Right, Uplo::Upper, Op::NoTrans,
+                            Diag::NonUnit, m, lb, one, Vt, ldv, P, ldw, queue );
+                device::geadd( m, lb, one, P, ldw, one, W, ldw, queue );
+                if (kb > lb) {
+                    blas::gemm( col, Op::NoTrans, Op::NoTrans, m, kb - lb, lb,
+                                one, &c2[ mr*ld2 ], ld2, &Vt[ lb*ldv ], ldv,
+                                one, &W[ lb*ldw ], ldw, queue );
+                }
+            }
+
+            // W = W op( T )
+            blas::trmm( col, Side::Right, Uplo::Upper, op, Diag::NonUnit,
+                        m, kb, one, Ti, ldt, W, ldw, queue );
+
+            // C1( :, i:i+kb ) -= W;  C2( :, 0:mb ) -= W V^H
+            device::geadd( m, kb, -one, W, ldw, one, &c1[ i*ld1 ], ld1, queue );
+            if (mr > 0) {
+                blas::gemm( col, Op::NoTrans, Op::ConjTrans, m, mr, kb,
+                            -one, W, ldw, Vr, ldv, one, c2, ld2, queue );
+            }
+            if (lb > 0) {
+                blas::device_copy_matrix( m, lb, W, ldw, P, ldw, queue );
+                blas::trmm( col, Side::Right, Uplo::Upper, Op::ConjTrans,
+                            Diag::NonUnit, m, lb, one, Vt, ldv, P, ldw, queue );
+                if (kb > lb) {
+                    blas::gemm( col, Op::NoTrans, Op::ConjTrans, m, lb, kb - lb,
+                                one, &W[ lb*ldw ], ldw, &Vt[ lb*ldv ], ldv,
+                                one, P, ldw, queue );
+                }
+                device::geadd( m, lb, -one, P, ldw, one, &c2[ mr*ld2 ], ld2, queue );
+            }
+        }
+    }
+}
+
 } // namespace slate
 
 #endif // SLATE_TILE_TPMQRT_HH
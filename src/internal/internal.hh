@@ -120,6 +120,40 @@ void copy(BaseTrapezoidMatrix<src_scalar_t>&& A,
           BaseTrapezoidMatrix<dst_scalar_t>&& B,
           int priority=0, int queue_index=0 );
 
+//-----------------------------------------
+// copy_col_max(), add_col_max()
+// fused precision conversion and column max norms, for iterative refinement
+template <Target target=Target::HostTask,
+          typename src_scalar_t, typename dst_scalar_t>
+void copy_col_max(
+    Matrix<src_scalar_t>&& A,
+    Matrix<dst_scalar_t>&& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    int priority=0, int queue_index=0 );
+
+template <Target target=Target::HostTask,
+          typename src_scalar_t, typename dst_scalar_t>
+void add_col_max(
+    Matrix<src_scalar_t>&& A,
+    Matrix<dst_scalar_t>&& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    int priority=0, int queue_index=0 );
+
+// with their own parallel region and MPI reduction, for the solver drivers
+template <typename src_scalar_t, typename dst_scalar_t>
+void copy_colNorms(
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    Options const& opts );
+
+template <typename src_scalar_t, typename dst_scalar_t>
+void add_colNorms(
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    Options const& opts );
+
 //-----------------------------------------
 // scale()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -353,13 +387,13 @@ void trsmA(Side side,
 // trtri()
 template <Target target=Target::HostTask, typename scalar_t>
 void trtri(TriangularMatrix<scalar_t>&& A,
-           int priority=0);
+           int priority=0, int64_t queue_index=0);
 
 //-----------------------------------------
 // trtrm()
 template <Target target=Target::HostTask, typename scalar_t>
 void trtrm(TriangularMatrix<scalar_t>&& A,
-           int priority=0);
+           int priority=0, int64_t queue_index=0);
 
 //------------------------------------------------------------------------------
 // LAPACK auxiliary
@@ -369,6 +403,11 @@ void permuteRows(
     Matrix<scalar_t>&& A, std::vector<Pivot>& pivot,
     Layout layout, int priority=0, int tag=0, int queue_index=0);
 
+template <typename scalar_t>
+void permuteRowsAll(
+    Direction direction,
+    Matrix<scalar_t>& A, Pivots& pivots, int tag=0);
+
 template <Target target=Target::HostTask, typename scalar_t>
 void permuteRowsCols(
     Direction direction,
@@ -388,22 +427,16 @@ void add(scalar_t alpha, BaseTrapezoidMatrix<scalar_t>&& A,
          int priority=0, int queue_index=0 );
 
 template<typename scalar_t>
-void gerbt(Matrix<scalar_t> A11,
-           Matrix<scalar_t> A12,
-           Matrix<scalar_t> A21,
-           Matrix<scalar_t> A22,
-           Matrix<scalar_t> U1,
-           Matrix<scalar_t> U2,
-           Matrix<scalar_t> V1,
-           Matrix<scalar_t> V2);
+void gerbt(int64_t inner_len,
+           Matrix<scalar_t> A,
+           Matrix<scalar_t> U,
+           Matrix<scalar_t> V);
 
 template<typename scalar_t>
-void gerbt(Side side,
-           Op trans,
-           Matrix<scalar_t> B1,
-           Matrix<scalar_t> B2,
-           Matrix<scalar_t> U1,
-           Matrix<scalar_t> U2);
+void gerbt(Op trans,
+           int64_t inner_len,
+           Matrix<scalar_t> B,
+           Matrix<scalar_t> U);
 
 template<typename scalar_t>
 std::pair<Matrix<scalar_t>, Matrix<scalar_t>> rbt_generate(
@@ -491,17 +524,49 @@ void norm(Norm in_norm, NormScope scope, HermitianBandMatrix<scalar_t>&& A,
 //       Possibly compute diag_len in internal.
 template <Target target=Target::HostTask, typename scalar_t>
 void getrf_panel(
-    Matrix<scalar_t>&& A, int64_t diag_len, int64_t ib,
+    Matrix<scalar_t>&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     blas::real_type<scalar_t> remote_pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
 
+//-----------------------------------------
+// For host targets, which don't need device workspace.
+template <Target target=Target::HostTask, typename scalar_t>
+void getrf_panel(
+    Matrix<scalar_t>&& A, int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    blas::real_type<scalar_t> remote_pivot_threshold,
+    int max_panel_threads, int priority, int tag, int64_t* info )
+{
+    std::vector< char* > dwork_array;
+    getrf_panel<target>(
+        std::move( A ), dwork_array, 0, diag_len, ib, pivot,
+        remote_pivot_threshold, max_panel_threads, priority, tag, info );
+}
+
+//-----------------------------------------
+// Size in bytes of the device workspace for getrf_panel<Target::Devices>,
+// for a panel with mlocal local rows.
+template <typename scalar_t>
+size_t getrf_panel_work_bytes( int64_t mlocal, int64_t nb, int64_t ib )
+{
+    return roundup( std::max( mlocal, int64_t( 1 ) ) * nb * sizeof( scalar_t ),
+                    size_t( 8 ) )
+         + roundup( ib * nb * sizeof( scalar_t ), size_t( 8 ) )
+         + roundup( sizeof( scalar_t ), size_t( 8 ) )
+         + sizeof( int64_t );
+}
+
 //-----------------------------------------
 // getrf_nopiv()
 template <Target target=Target::HostTask, typename scalar_t>
 void getrf_nopiv(
     Matrix<scalar_t>&& A,
-    int64_t ib, int priority, int64_t* info );
+    int64_t ib, int priority, int64_t* info,
+    int64_t queue_index=0,
+    lapack::device_info_int* device_info=nullptr );
 
 //-----------------------------------------
 // getrf_tntpiv()
@@ -511,7 +576,7 @@ void getrf_tntpiv_panel(
     std::vector< char* > dwork_array, size_t dwork_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 //-----------------------------------------
 // geqrf()
@@ -632,7 +697,8 @@ void unmlq(Side side, Op op,
 template <Target target=Target::HostTask, typename scalar_t>
 void unmtr_hb2st(Side side, Op op,
                  Matrix<scalar_t>& V,
-                 Matrix<scalar_t>& C );
+                 Matrix<scalar_t>& C,
+                 int64_t group_size = 1 );
 
 //-----------------------------------------
 // unmbr_tb2bd()
@@ -649,11 +715,38 @@ int64_t potrf(
     int priority=0, int64_t queue_index=0,
     lapack::device_info_int* device_info=nullptr );
 
+//-----------------------------------------
+// potrf_update_diag(), potrf_update_apply()
+template <Target target=Target::HostTask, typename scalar_t>
+int64_t potrf_update_diag(
+    blas::real_type<scalar_t> sign,
+    Matrix<scalar_t>&& A,
+    Matrix<scalar_t>&& X,
+    int priority=0 );
+
+template <Target target=Target::HostTask, typename scalar_t>
+void potrf_update_apply(
+    blas::real_type<scalar_t> sign,
+    Matrix<scalar_t>&& S,
+    Matrix<scalar_t>&& A,
+    Matrix<scalar_t>&& X,
+    int priority=0 );
+
+//-----------------------------------------
+// potrf_trtri()
+template <Target target=Target::Devices, typename scalar_t>
+int64_t potrf_trtri(
+    HermitianMatrix<scalar_t>&& A,
+    HermitianMatrix<scalar_t>&& Ainv,
+    int priority=0, int64_t queue_index=0,
+    lapack::device_info_int* device_info=nullptr );
+
 //-----------------------------------------
 // hegst()
 template <Target target=Target::HostTask, typename scalar_t>
 void hegst(int64_t itype, HermitianMatrix<scalar_t>&& A,
-                          HermitianMatrix<scalar_t>&& B);
+                          HermitianMatrix<scalar_t>&& B,
+           int priority=0, int64_t queue_index=0);
 
 //------------------------------------------------------------------------------
 // Norm 1 estimate
@@ -666,6 +759,12 @@ void norm1est(
     int* kase,
     std::vector<int64_t>& isave );
 
+// Block norm 1 estimate, t vectors at a time
+template <typename scalar_t>
+blas::real_type<scalar_t> norm1est_block(
+    Matrix<scalar_t>& X,
+    std::function< void (Op, Matrix<scalar_t>&) > const& apply );
+
 //------------------------------------------------------------------------------
 // MPI reduce info, used in getrf, hetrf, etc.
 void reduce_info( int64_t* info, MPI_Comm mpi_comm );
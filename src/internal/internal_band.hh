@@ -0,0 +1,306 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+#ifndef SLATE_INTERNAL_BAND_HH
+#define SLATE_INTERNAL_BAND_HH
+
+#include "slate/Matrix.hh"
+#include "slate/Tile_aux.hh"
+#include "internal/internal.hh"
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Largest lower or upper bandwidth, in tiles, for which band_window_mm
+/// is used instead of one batch per block column of A.
+const int64_t band_window_max_tiles = 4;
+
+//------------------------------------------------------------------------------
+/// Band matrix times dense matrix on devices, a window of block columns
+/// of A at a time:
+/// \[
+///     C = \alpha \hat{A} B + \beta C,
+/// \]
+/// where $\hat{A}$ has lower and upper bandwidths klt and kut, in tiles.
+///
+/// For narrow bands, one batch per block column of A has only a few
+/// tiles, so kernel launches dominate. Instead, for each window of
+/// klt + kut + 1 block columns k of A, the tiles $\hat{A}(i, k)$ of each
+/// block row i are staged side by side, with zeros outside the band, into
+/// one tile of width the window, and the tiles B(k, j) stacked into one
+/// tile; then C(i, j) gets one gemm per window, all in one batch.
+/// Staging is on the host, from tiles broadcast to the host; the staged
+/// tiles are then copied to the devices by internal::gemm. Up to about
+/// twice the flops are done, on the zeros at the corners of the band.
+///
+/// A and B are broadcast a window at a time, lookahead windows ahead.
+///
+/// @param[in] stored
+///     stored( i, k ) returns the index of the tile of A that holds
+///     $\hat{A}(i, k)$, for i, k within the band.
+///
+/// @param[in] stage
+///     stage( i, k, T ) copies $\hat{A}(i, k)$, within the band, into the
+///     host tile T, from the tile stored( i, k ) of A on the host.
+///
+/// C and B must be NoTrans, and target Devices.
+///
+template <typename scalar_t, typename matrix_t,
+          typename stored_t, typename stage_t>
+void band_window_mm(
+    scalar_t alpha, matrix_t& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    int64_t klt, int64_t kut,
+    stored_t&& stored, stage_t&& stage,
+    Options const& opts )
+{
+    using blas::max;
+    using blas::min;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    const scalar_t zero = 0.0, one = 1.0;
+    const Layout layout = Layout::ColMajor;
+
+    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+
+    assert( B.op() == Op::NoTrans && C.op() == Op::NoTrans );
+
+    int64_t mt = C.mt();
+    int64_t nt = C.nt();
+    int64_t kt = A.nt();
+    int64_t width = klt + kut + 1;
+    int64_t num_windows = ceildiv( kt, width );
+
+    // Block columns of A in window w, and block rows of C they update.
+    auto k_begin = [=]( int64_t w ) { return w*width; };
+    auto k_end   = [=]( int64_t w ) { return min( (w + 1)*width, kt ); };
+    auto i_begin = [=]( int64_t w ) { return max( k_begin( w ) - kut, 0 ); };
+    auto i_end   = [=]( int64_t w ) { return min( k_end( w ) + klt, mt ); };
+
+    // Stored tiles of A needed in window w, with the rows of C to send to.
+    auto A_tiles = [&]( int64_t w ) {
+        std::map< ij_tuple, std::set<int64_t> > tiles;
+        for (int64_t k = k_begin( w ); k < k_end( w ); ++k) {
+            for (int64_t i = max( k - kut, 0 ); i < min( k + klt + 1, mt ); ++i)
+                tiles[ stored( i, k ) ].insert( i );
+        }
+        return tiles;
+    };
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector<uint8_t> bcast_vector( num_windows );
+    std::vector<uint8_t>  gemm_vector( num_windows );
+    uint8_t* bcast = bcast_vector.data();
+    uint8_t* gemm  =  gemm_vector.data();
+    SLATE_UNUSED( bcast ); // Used only by OpenMP
+    SLATE_UNUSED( gemm  ); // Used only by OpenMP
+
+    // Tiles stay on the host, where they are staged.
+    auto bcast_window = [&]( int64_t w ) {
+        BcastList bcast_list_A;
+        for (auto& tile_rows : A_tiles( w )) {
+            std::list< BaseMatrix<scalar_t> > dests;
+            for (int64_t i : tile_rows.second)
+                dests.push_back( C.sub( i, i, 0, nt-1 ) );
+            bcast_list_A.push_back( { std::get<0>( tile_rows.first ),
+                                      std::get<1>( tile_rows.first ),
+                                      dests } );
+        }
+        A.template listBcast<Target::HostTask>( bcast_list_A, layout );
+
+        BcastList bcast_list_B;
+        for (int64_t k = k_begin( w ); k < k_end( w ); ++k) {
+            for (int64_t j = 0; j < nt; ++j) {
+                bcast_list_B.push_back(
+                    { k, j, { C.sub( i_begin( w ), i_end( w )-1, j, j ) } } );
+            }
+        }
+        B.template listBcast<Target::HostTask>( bcast_list_B, layout );
+    };
+
+    // C(i_begin:i_end-1, :) = alpha Ahat(:, window) B(window, :) + beta C.
+    auto gemm_window = [&]( int64_t w, scalar_t beta_w ) {
+        int64_t kb = k_begin( w ), ke = k_end( w );
+        std::vector<int64_t> offset( ke - kb + 1, 0 );
+        for (int64_t k = kb; k < ke; ++k)
+            offset[ k-kb+1 ] = offset[ k-kb ] + B.tileMb( k );
+        int64_t kw = offset[ ke-kb ];
+
+        auto C_w = C.sub( i_begin( w ), i_end( w )-1, 0, nt-1 );
+        auto A_w = C_w.sub( 0, C_w.mt()-1, 0, 0 ).template emptyLike<scalar_t>( 0, kw );
+        auto B_w = C_w.sub( 0, 0, 0, nt-1 ).template emptyLike<scalar_t>( kw, 0 );
+
+        // Staged tiles are needed where C_w has local tiles.
+        std::set<int64_t> rows, cols;
+        for (int64_t i = 0; i < C_w.mt(); ++i) {
+            for (int64_t j = 0; j < nt; ++j) {
+                if (C_w.tileIsLocal( i, j )) {
+                    rows.insert( i );
+                    cols.insert( j );
+                }
+            }
+        }
+
+        int64_t i0 = i_begin( w );
+
+        #pragma omp taskgroup
+        {
+            for (int64_t i : rows) {
+                #pragma omp task slate_omp_default_none \
+                    shared( A_w, stage, offset ) \
+                    firstprivate( i, i0, kb, ke, klt, kut, zero, layout )
+                {
+                    auto T = A_w.tileInsertWorkspace( i, 0, HostNum, layout );
+                    T.set( zero );
+                    int64_t ii = i0 + i;
+                    for (int64_t k = max( kb, ii - klt ); k < min( ke, ii + kut + 1 ); ++k) {
+                        Tile<scalar_t> T_k(
+                            T.mb(), offset[ k-kb+1 ] - offset[ k-kb ],
+                            &T.at( 0, offset[ k-kb ] ), T.stride(),
+                            HostNum, TileKind::UserOwned, layout );
+                        stage( ii, k, T_k );
+                    }
+                    A_w.tileModified( i, 0, HostNum, true );
+                }
+            }
+            for (int64_t j : cols) {
+                #pragma omp task slate_omp_default_none \
+                    shared( B, B_w, offset ) \
+                    firstprivate( j, kb, ke, layout )
+                {
+                    auto T = B_w.tileInsertWorkspace( 0, j, HostNum, layout );
+                    for (int64_t k = kb; k < ke; ++k) {
+                        B.tileGetForReading( k, j, HostNum, LayoutConvert( layout ) );
+                        Tile<scalar_t> T_k(
+                            offset[ k-kb+1 ] - offset[ k-kb ], T.nb(),
+                            &T.at( offset[ k-kb ], 0 ), T.stride(),
+                            HostNum, TileKind::UserOwned, layout );
+                        tile::gecopy( B( k, j ), T_k );
+                    }
+                    B_w.tileModified( 0, j, HostNum, true );
+                }
+            }
+        }
+
+        internal::gemm<Target::Devices>(
+            alpha,  std::move( A_w ),
+                    std::move( B_w ),
+            beta_w, std::move( C_w ),
+            layout );
+    };
+
+    // Rows of C below the first window get beta when it runs.
+    auto scale_rest = [&]() {
+        if (beta == one)
+            return;
+        #pragma omp taskgroup
+        for (int64_t i = i_end( 0 ); i < mt; ++i) {
+            for (int64_t j = 0; j < nt; ++j) {
+                if (C.tileIsLocal( i, j )) {
+                    #pragma omp task slate_omp_default_none \
+                        shared( C ) \
+                        firstprivate( i, j, layout, beta, zero )
+                    {
+                        C.tileGetForWriting( i, j, LayoutConvert( layout ) );
+                        if (beta == zero)
+                            C( i, j ).set( zero );
+                        else
+                            tile::scale( beta, C( i, j ) );
+                    }
+                }
+            }
+        }
+    };
+
+    auto release_window = [&]( int64_t w ) {
+        TileSet A_set, B_set;
+        for (auto& tile_rows : A_tiles( w ))
+            A_set.insert( tile_rows.first );
+        for (int64_t k = k_begin( w ); k < k_end( w ); ++k) {
+            for (int64_t j = 0; j < nt; ++j)
+                B_set.insert( { k, j } );
+        }
+        A.releaseRemoteWorkspace( A_set );
+        B.releaseRemoteWorkspace( B_set );
+    };
+
+    C.allocateBatchArrays();
+    C.reserveDeviceWorkspace();
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        // send first window
+        #pragma omp task depend(out:bcast[0])
+        {
+            bcast_window( 0 );
+        }
+
+        // send next lookahead windows
+        for (int64_t w = 1; w < lookahead+1 && w < num_windows; ++w) {
+            #pragma omp task depend(in:bcast[w-1]) \
+                             depend(out:bcast[w])
+            {
+                bcast_window( w );
+            }
+        }
+
+        for (int64_t w = 0; w < num_windows; ++w) {
+            // send next window
+            if (w > 0 && w+lookahead < num_windows) {
+                #pragma omp task depend(in:gemm[w-1]) \
+                                 depend(in:bcast[w+lookahead-1]) \
+                                 depend(out:bcast[w+lookahead])
+                {
+                    bcast_window( w+lookahead );
+                }
+            }
+
+            if (w == 0) {
+                // multiply, with beta
+                #pragma omp task depend(in:bcast[0]) \
+                                 depend(out:gemm[0])
+                {
+                    gemm_window( 0, beta );
+                    scale_rest();
+                }
+            }
+            else {
+                #pragma omp task depend(in:bcast[w]) \
+                                 depend(in:gemm[w-1]) \
+                                 depend(out:gemm[w])
+                {
+                    gemm_window( w, one );
+                }
+            }
+
+            #pragma omp task depend(in:gemm[w])
+            {
+                release_window( w );
+            }
+        }
+
+        #pragma omp taskwait
+        C.tileUpdateAllOrigin();
+    }
+
+    C.clearWorkspace();
+}
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_BAND_HH
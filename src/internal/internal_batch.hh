@@ -215,7 +215,7 @@ public:
 };
 
 //------------------------------------------------------------------------------
-/// @copydoc device_regions_build(std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count >, std::array< scalar_t**, mat_count >, int64_t, std::function<void(int64_t, int64_t, int64_t)>)
+/// @copydoc device_regions_build(std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count >, std::array< scalar_t**, mat_count >, int64_t, std::function<void(int64_t, int64_t, int64_t)>, std::function<bool(int64_t, int64_t)>)
 ///
 /// @params[in] irange
 ///     The ranges of tiles with a uniform number of rows
@@ -230,7 +230,8 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
         int64_t device,
         std::function<void(int64_t, int64_t, int64_t)> extra_setup,
         std::vector<int64_t>& irange,
-        std::vector<int64_t>& jrange)
+        std::vector<int64_t>& jrange,
+        std::function<bool(int64_t, int64_t)> tile_filter = {})
 {
     // The first two arguments should be valid targets for brace-initialization
     // reference_wrapper works around fact that C++ doesn't allow array of references
@@ -277,7 +278,8 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
             int64_t iend   = std::min(irange[ ii+1 ], (A.uplo() == Uplo::Upper ? j : mt));
             for (int64_t i = istart; i < iend; ++i) {
                 if ((diag_same || i != j)
-                    && A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )) {
+                    && A.tileIsLocal( i, j ) && device == A.tileDevice( i, j )
+                    && (! tile_filter || tile_filter( i, j ))) {
 
                     // Add tiles to current group
                     for (int m = 0; m < mat_count; ++m) {
@@ -316,7 +318,8 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
             int64_t ijend   = std::min(irange[ ii+1 ], jrange[ jj+1 ]);
             for (int64_t ij = ijstart; ij < ijend; ++ij) {
                 if (A.tileIsLocal( ij, ij )
-                    && device == A.tileDevice( ij, ij )) {
+                    && device == A.tileDevice( ij, ij )
+                    && (! tile_filter || tile_filter( ij, ij ))) {
 
                     // Add tiles to current group
                     // This logic matches that of above
@@ -375,6 +378,10 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
 ///     Callback that is called whenever a tile is added to a group.
 ///     The group index and the tile indices are passed as arguments
 ///
+/// @param[in] tile_filter
+///     If set, only tiles (i, j) for which tile_filter( i, j ) is true
+///     are added to groups; the others are computed elsewhere.
+///
 /// @return A list of batches with identical size.
 ///
 template< bool store_diag, int mat_count, typename scalar_t, bool diag_same=!store_diag >
@@ -382,7 +389,8 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
         std::array< std::reference_wrapper<BaseMatrix<scalar_t>>, mat_count > mats,
         std::array< scalar_t**, mat_count > mats_array_host,
         int64_t device,
-        std::function<void(int64_t, int64_t, int64_t)> extra_setup = {})
+        std::function<void(int64_t, int64_t, int64_t)> extra_setup = {},
+        std::function<bool(int64_t, int64_t)> tile_filter = {})
 {
     // Find ranges of matching mb's and ranges of matching nb's.
     auto irange = device_regions_range( RowCol::Row, mats[0].get() );
@@ -390,9 +398,54 @@ std::vector< device_regions_params<store_diag, mat_count> > device_regions_build
 
     return device_regions_build< store_diag, mat_count, scalar_t, diag_same >(
                                  mats, mats_array_host, device, extra_setup,
-                                 irange, jrange );
+                                 irange, jrange, tile_filter );
 }
 
+//------------------------------------------------------------------------------
+/// Expands the groups built by device_regions_build into per-tile
+/// dimensions, for the variable-size batched (vbatch) device routines,
+/// which cover all groups in one launch.
+///
+/// @param[in] group_params
+///     The groups from device_regions_build.
+///
+/// @param[out] dims
+///     On exit, the arrays m, n, ld[0], ..., ld[mat_count-1], and,
+///     if store_diag, is_diagonal, each of dimension batch_count and
+///     stored one after the other, where batch_count is the total number
+///     of tiles in the groups.
+///
+/// @return The maximum m over all tiles.
+///
+template< bool store_diag, int mat_count >
+int64_t device_regions_vbatch_dims(
+        std::vector< device_regions_params<store_diag, mat_count> > const& group_params,
+        std::vector<int64_t>& dims)
+{
+    int64_t batch_count = 0;
+    for (auto& group : group_params) {
+        batch_count += group.count;
+    }
+    int64_t num_arrays = 2 + mat_count + (store_diag ? 1 : 0);
+    dims.resize( num_arrays * batch_count );
+
+    int64_t max_m = 0;
+    int64_t k = 0;
+    for (auto& group : group_params) {
+        for (int64_t t = 0; t < group.count; ++t, ++k) {
+            dims[ k ]               = group.mb;
+            dims[ k + batch_count ] = group.nb;
+            for (int m = 0; m < mat_count; ++m) {
+                dims[ k + (2 + m)*batch_count ] = group.ld[ m ];
+            }
+            if constexpr (store_diag) {
+                dims[ k + (2 + mat_count)*batch_count ] = group.is_diagonal;
+            }
+        }
+        max_m = std::max( max_m, group.mb );
+    }
+    return max_m;
+}
 
 } // namespace internal
 } // namespace slate
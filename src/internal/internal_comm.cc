@@ -6,14 +6,112 @@
 #include "slate/Exception.hh"
 #include "slate/internal/comm.hh"
 #include "internal/internal_util.hh"
+#include "slate/internal/LockGuard.hh"
 #include "slate/internal/Trace.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <tuple>
 #include <vector>
 
 namespace slate {
 namespace internal {
 
+//------------------------------------------------------------------------------
+/// Frees all cached communicators.
+CommCache::~CommCache()
+{
+    try {
+        clear();
+    }
+    catch (std::exception const& ex) {
+        // If debugging, die on exceptions.
+        // Otherwise, ignore errors: destructors should not throw errors!
+        assert(false);
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Frees all cached communicators and their groups.
+/// If MPI is already finalized, e.g., for a global matrix, they are
+/// simply forgotten.
+void CommCache::clear()
+{
+    if (comms_.empty())
+        return;
+
+    int finalized;
+    slate_mpi_call(
+        MPI_Finalized(&finalized));
+    if (! finalized) {
+        #pragma omp critical(slate_mpi)
+        for (auto& iter : comms_) {
+            slate_mpi_call(
+                MPI_Comm_free(&iter.second.first));
+            slate_mpi_call(
+                MPI_Group_free(&iter.second.second));
+        }
+    }
+    comms_.clear();
+}
+
+//------------------------------------------------------------------------------
+/// @return communicator for the given set of ranks of mpi_comm,
+/// creating it on first use. Like MPI_Comm_create_group, this is
+/// collective over the ranks in the set when it creates the communicator.
+/// The communicator is owned by the cache, so must not be freed.
+///
+/// @param[in] ranks
+///     Set of ranks in mpi_comm.
+///
+/// @param[in] mpi_comm
+///     Parent communicator.
+///
+/// @param[in] mpi_group
+///     Group of mpi_comm.
+///
+/// @param[in] tag
+///     Tag for MPI_Comm_create_group, if it creates the communicator.
+///
+/// @param[out] group
+///     Group of the communicator.
+///
+MPI_Comm CommCache::get(const std::set<int>& ranks,
+                        MPI_Comm mpi_comm, MPI_Group mpi_group, int tag,
+                        MPI_Group* group)
+{
+    // Look up and create in one critical section, so tasks on this rank
+    // can't both create the communicator.
+    MPI_Comm comm;
+    #pragma omp critical(slate_mpi)
+    {
+        auto iter = comms_.find( ranks );
+        if (iter != comms_.end()) {
+            comm   = iter->second.first;
+            *group = iter->second.second;
+        }
+        else {
+            // Convert the set of ranks to a vector.
+            std::vector<int> ranks_vec(ranks.begin(), ranks.end());
+            slate_mpi_call(
+                MPI_Group_incl(mpi_group, ranks_vec.size(), ranks_vec.data(),
+                               group));
+
+            trace::Block trace_block("MPI_Comm_create_group");
+            slate_mpi_call(
+                MPI_Comm_create_group(mpi_comm, *group, tag, &comm));
+            comms_[ ranks ] = { comm, *group };
+        }
+    }
+    assert(comm != MPI_COMM_NULL);
+    return comm;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Creates a communicator for the given set of ranks of mpi_comm,
+/// and translates in_rank to it. The caller must free the communicator.
+///
 MPI_Comm commFromSet(const std::set<int>& bcast_set,
                      MPI_Comm mpi_comm, MPI_Group mpi_group,
                      const int in_rank, int& out_rank, int tag)
@@ -47,6 +145,30 @@ MPI_Comm commFromSet(const std::set<int>& bcast_set,
     return bcast_comm;
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Gets a communicator for the given set of ranks of mpi_comm from cache,
+/// creating it on first use, and translates in_rank to it.
+/// The communicator is owned by the cache, so must not be freed.
+///
+MPI_Comm commFromSet(const std::set<int>& bcast_set,
+                     MPI_Comm mpi_comm, MPI_Group mpi_group,
+                     const int in_rank, int& out_rank, int tag,
+                     CommCache& cache)
+{
+    MPI_Group bcast_group;
+    MPI_Comm bcast_comm = cache.get( bcast_set, mpi_comm, mpi_group, tag,
+                                     &bcast_group );
+
+    // Translate the input rank.
+    #pragma omp critical(slate_mpi)
+    slate_mpi_call(
+        MPI_Group_translate_ranks(mpi_group, 1, &in_rank,
+                                  bcast_group, &out_rank));
+
+    return bcast_comm;
+}
+
 //------------------------------------------------------------------------------
 /// [internal]
 /// Implements a hypercube broadcast pattern. For a given rank, finds the rank
@@ -122,5 +244,318 @@ void cubeReducePattern(int size, int rank, int radix,
     cubeBcastPattern(size, rank, radix, send_to, recv_from);
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Cache of the node of each rank, kept as an attribute of each
+/// communicator, so MPI deletes it when the communicator is freed and
+/// a later communicator reusing its handle starts without one.
+struct NodesCache {
+    int keyval = MPI_KEYVAL_INVALID;
+    omp_nest_lock_t lock;
+    NodesCache() { omp_init_nest_lock( &lock ); }
+    ~NodesCache() { omp_destroy_nest_lock( &lock ); }
+};
+
+static NodesCache& nodes_cache()
+{
+    static NodesCache cache;
+    return cache;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Deletes the nodes attribute when its communicator is freed.
+static int nodes_delete_fn(
+    MPI_Comm mpi_comm, int keyval, void* attribute, void* extra_state)
+{
+    delete static_cast< std::vector<int>* >( attribute );
+    return MPI_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return nodes attribute of mpi_comm, or null if it has none.
+/// The caller must hold the cache's lock.
+static std::vector<int>* nodes_attribute(NodesCache& cache, MPI_Comm mpi_comm)
+{
+    if (cache.keyval == MPI_KEYVAL_INVALID)
+        return nullptr;
+
+    void* attribute;
+    int found;
+    slate_mpi_call(
+        MPI_Comm_get_attr( mpi_comm, cache.keyval, &attribute, &found ) );
+    return found ? static_cast< std::vector<int>* >( attribute ) : nullptr;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Finds which ranks of mpi_comm share a node, i.e., shared memory,
+/// using MPI_Comm_split_type( MPI_COMM_TYPE_SHARED ).
+/// Collective over mpi_comm on the first call for mpi_comm, so it must be
+/// called by all ranks, outside of tasks; later calls return the result
+/// cached as an attribute of mpi_comm, which lives until mpi_comm is freed.
+/// Used by hierarchical broadcasts (Option::HierarchicalBcast).
+///
+/// @param[in] mpi_comm
+///     Communicator.
+///
+/// @return for each rank in mpi_comm, its node, identified by the lowest
+///     rank on it.
+///
+std::vector<int> const& commNodes(MPI_Comm mpi_comm)
+{
+    NodesCache& cache = nodes_cache();
+    LockGuard guard( &cache.lock );
+
+    int mpi_rank, mpi_size;
+    slate_mpi_call( MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+    slate_mpi_call( MPI_Comm_size( mpi_comm, &mpi_size ) );
+
+    std::vector<int>* cached = nodes_attribute( cache, mpi_comm );
+    if (cached != nullptr) {
+        slate_assert( int( cached->size() ) == mpi_size );
+        return *cached;
+    }
+
+    if (cache.keyval == MPI_KEYVAL_INVALID) {
+        slate_mpi_call(
+            MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, nodes_delete_fn,
+                                    &cache.keyval, nullptr ) );
+    }
+
+    MPI_Comm node_comm;
+    slate_mpi_call(
+        MPI_Comm_split_type( mpi_comm, MPI_COMM_TYPE_SHARED, mpi_rank,
+                             MPI_INFO_NULL, &node_comm ) );
+    int node;
+    slate_mpi_call(
+        MPI_Allreduce( &mpi_rank, &node, 1, MPI_INT, MPI_MIN, node_comm ) );
+    slate_mpi_call( MPI_Comm_free( &node_comm ) );
+
+    auto nodes = new std::vector<int>( mpi_size );
+    slate_mpi_call(
+        MPI_Allgather( &node, 1, MPI_INT, nodes->data(), 1, MPI_INT,
+                       mpi_comm ) );
+    slate_mpi_call( MPI_Comm_set_attr( mpi_comm, cache.keyval, nodes ) );
+    return *nodes;
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return nodes of ranks of mpi_comm if commNodes was already called for
+/// mpi_comm, otherwise null. Not collective, so it can be used in tasks.
+///
+std::vector<int> const* commNodesCached(MPI_Comm mpi_comm)
+{
+    NodesCache& cache = nodes_cache();
+    LockGuard guard( &cache.lock );
+
+    return nodes_attribute( cache, mpi_comm );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Implements a two-level broadcast pattern: a hypercube over one leader
+/// per node, then a hypercube within each node, so a tile crosses the
+/// network once per node and is forwarded over shared memory within a node.
+/// Unlike cubeBcastPattern, it works on ranks, not positions.
+///
+/// @param[in] bcast_ranks
+///     Ranks in the broadcast, root first. The leader of a node is its
+///     first rank in bcast_ranks, so the root leads its node.
+///
+/// @param[in] nodes
+///     Node of each rank, from commNodes.
+///
+/// @param[in] rank
+///     This rank; must be in bcast_ranks.
+///
+/// @param[in] radix
+///     Radix of both hypercubes.
+///
+/// @param[out] recv_from
+///     Rank to receive from; empty for the root.
+///
+/// @param[out] send_to
+///     Ranks to forward to, other nodes' leaders first.
+///
+void hierarchicalBcastPattern(std::vector<int> const& bcast_ranks,
+                              std::vector<int> const& nodes,
+                              int rank, int radix,
+                              std::list<int>& recv_from,
+                              std::list<int>& send_to)
+{
+    // Group ranks by node, in order of first appearance.
+    std::vector<int> leaders;
+    std::map< int, std::vector<int> > members;
+    for (int r : bcast_ranks) {
+        auto& node_ranks = members[ nodes[ r ] ];
+        if (node_ranks.empty())
+            leaders.push_back( r );
+        node_ranks.push_back( r );
+    }
+
+    std::list<int> from, to;
+    auto append = [&]( std::vector<int> const& ranks ) {
+        for (int r : from)
+            recv_from.push_back( ranks[ r ] );
+        for (int r : to)
+            send_to.push_back( ranks[ r ] );
+        from.clear();
+        to.clear();
+    };
+
+    // Between nodes, if this rank is its node's leader.
+    auto const& node_ranks = members[ nodes[ rank ] ];
+    if (node_ranks.front() == rank) {
+        int index = std::find( leaders.begin(), leaders.end(), rank )
+                    - leaders.begin();
+        cubeBcastPattern( leaders.size(), index, radix, from, to );
+        append( leaders );
+    }
+
+    // Within the node.
+    int index = std::find( node_ranks.begin(), node_ranks.end(), rank )
+                - node_ranks.begin();
+    cubeBcastPattern( node_ranks.size(), index, radix, from, to );
+    append( node_ranks );
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Implements the reduction tree of tournament pivoting (CALU), as a
+/// sequence of pairwise merges. A rank merges the candidates it receives,
+/// in order, into its own, then sends its candidates to its parent.
+/// Like hierarchicalBcastPattern, it works on ranks, not positions.
+///
+/// @param[in] ranks
+///     Ranks in the reduction, root first. The leader of a node is its
+///     first rank in ranks, so the root leads its node.
+///
+/// @param[in] nodes
+///     Node of each rank, from commNodes, or null if unknown.
+///     Used only by TournamentTree::Hybrid, which is Binary without it.
+///
+/// @param[in] tree
+///     Shape of the tree:
+///     - Binary: merge rank index + step at each level, step = 1, 2, 4, ...
+///     - Flat:   the root merges every other rank in turn.
+///     - Hybrid: Flat within each node, then Binary over node leaders,
+///               so candidates cross the network once per node.
+///
+/// @param[in] rank
+///     This rank; must be in ranks.
+///
+/// @param[out] recv_from
+///     Ranks to receive candidates from and merge, in order.
+///
+/// @param[out] send_to
+///     Rank to send merged candidates to; empty for the root.
+///
+void tournamentReducePattern(std::vector<int> const& ranks,
+                             std::vector<int> const* nodes,
+                             TournamentTree tree, int rank,
+                             std::list<int>& recv_from,
+                             std::list<int>& send_to)
+{
+    auto binary = [&]( std::vector<int> const& group ) {
+        int size = group.size();
+        int index = std::find( group.begin(), group.end(), rank )
+                    - group.begin();
+        for (int step = 1; step < size; step *= 2) {
+            if (index % (2*step) == 0) {
+                if (index + step < size)
+                    recv_from.push_back( group[ index + step ] );
+            }
+            else {
+                send_to.push_back( group[ index - step ] );
+                break;
+            }
+        }
+    };
+
+    if (tree == TournamentTree::Flat) {
+        if (rank == ranks[ 0 ])
+            recv_from.insert( recv_from.end(), ranks.begin() + 1, ranks.end() );
+        else
+            send_to.push_back( ranks[ 0 ] );
+    }
+    else if (tree == TournamentTree::Hybrid && nodes != nullptr) {
+        // Group ranks by node, in order of first appearance.
+        std::vector<int> leaders;
+        std::map< int, std::vector<int> > members;
+        for (int r : ranks) {
+            auto& node_ranks = members[ (*nodes)[ r ] ];
+            if (node_ranks.empty())
+                leaders.push_back( r );
+            node_ranks.push_back( r );
+        }
+
+        // Within the node, then between nodes if this rank leads its node.
+        auto const& node_ranks = members[ (*nodes)[ rank ] ];
+        if (node_ranks.front() == rank) {
+            recv_from.insert( recv_from.end(),
+                              node_ranks.begin() + 1, node_ranks.end() );
+            binary( leaders );
+        }
+        else {
+            send_to.push_back( node_ranks.front() );
+        }
+    }
+    else {
+        binary( ranks );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// @return committed MPI_Type_vector( count, blocklength, stride, oldtype ),
+/// created on first use and cached for the program lifetime, so sending
+/// strided tiles, e.g., of a matrix from ScaLAPACK with lda > mb, does not
+/// create, commit, and free a datatype for every message.
+/// Thread safe. The caller must not free the datatype.
+/// Cached datatypes are never freed, as MPI may already be finalized when
+/// the cache is destroyed; there is one per distinct tile shape and stride.
+///
+/// @param[in] count
+///     Number of blocks, e.g., columns of a ColMajor tile.
+///
+/// @param[in] blocklength
+///     Number of elements in each block, e.g., rows of a ColMajor tile.
+///
+/// @param[in] stride
+///     Number of elements between the start of each block.
+///
+/// @param[in] oldtype
+///     Element datatype, e.g., mpi_type<scalar_t>::value.
+///
+MPI_Datatype mpi_vector_type(int count, int blocklength, int stride,
+                             MPI_Datatype oldtype)
+{
+    using Key = std::tuple<MPI_Datatype, int, int, int>;
+    struct Cache {
+        std::map<Key, MPI_Datatype> types;
+        omp_nest_lock_t lock;
+        Cache() { omp_init_nest_lock( &lock ); }
+        ~Cache() { omp_destroy_nest_lock( &lock ); }
+    };
+    static Cache cache;
+
+    LockGuard guard( &cache.lock );
+
+    Key key( oldtype, count, blocklength, stride );
+    auto iter = cache.types.find( key );
+    if (iter != cache.types.end())
+        return iter->second;
+
+    MPI_Datatype newtype;
+    slate_mpi_call(
+        MPI_Type_vector( count, blocklength, stride, oldtype, &newtype ) );
+    slate_mpi_call( MPI_Type_commit( &newtype ) );
+    cache.types[ key ] = newtype;
+    return newtype;
+}
+
 } // namespace internal
 } // namespace slate
@@ -53,33 +53,38 @@ void copyhb2st(internal::TargetType<Target::HostTask>,
 
     int64_t nt = A.nt();
     int64_t n = A.n();
-    D.resize(n);
-    E.resize(n - 1);
+    D.assign(n, 0);
+    E.assign(n - 1, 0);
 
-    // Copy diagonal & super-diagonal.
+    // Copy diagonal & super-diagonal of local tiles; entries of other
+    // ranks' tiles are 0, so a sum over ranks gives all of D and E.
     int64_t D_index = 0;
     int64_t E_index = 0;
     for (int64_t i = 0; i < nt; ++i) {
         // Copy 1 element from super-diagonal tile to E.
         if (i > 0) {
-            auto T = A(i-1, i);
-            E[E_index] = real( T(T.mb()-1, 0) );
+            if (A.tileIsLocal(i-1, i)) {
+                auto T = A(i-1, i);
+                E[E_index] = real( T(T.mb()-1, 0) );
+            }
             E_index += 1;
         }
 
-        // Copy main diagonal to D.
-        auto T = A(i, i);
-        slate_assert(T.mb() == T.nb()); // square diagonal tile
-        auto len = T.nb();
-        for (int j = 0; j < len; ++j) {
-            D[D_index + j] = real( T(j, j) );
-        }
-        D_index += len;
+        auto len = A.tileNb(i);
+        if (A.tileIsLocal(i, i)) {
+            // Copy main diagonal to D.
+            auto T = A(i, i);
+            slate_assert(T.mb() == T.nb()); // square diagonal tile
+            for (int j = 0; j < len; ++j) {
+                D[D_index + j] = real( T(j, j) );
+            }
 
-        // Copy super-diagonal to E.
-        for (int j = 0; j < len-1; ++j) {
-            E[E_index + j] = real( T(j, j+1) );
+            // Copy super-diagonal to E.
+            for (int j = 0; j < len-1; ++j) {
+                E[E_index + j] = real( T(j, j+1) );
+            }
         }
+        D_index += len;
         E_index += len-1;
     }
 }
@@ -361,7 +361,7 @@ void norm(
             shared( A, devices_values, vals_host_arrays, jrange, irange ) \
             firstprivate(layout, in_norm, ldv, queue_index, device, i_end, i_begin, kut, klt)
         {
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             for (int64_t j = 0; j < A.nt(); ++j) {
                 i_begin = max(j - kut, 0);
@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/internal/device.hh"
+#include "slate/internal/DeviceGraph.hh"
 #include "internal/internal_batch.hh"
 #include "internal/internal.hh"
 #include "slate/internal/util.hh"
@@ -11,6 +12,8 @@
 #include "internal/Tile_lapack.hh"
 #include "slate/types.hh"
 
+#include <typeinfo>
+
 namespace slate {
 namespace internal {
 
@@ -120,7 +123,7 @@ void add(internal::TargetType<Target::Devices>,
             //       and possibly wrong, because an input matrix is being altered
             // todo: best, handle directly through the CUDA kernels
             auto layout = Layout::ColMajor;
-            std::set<ij_tuple> A_tiles_set, B_tiles_set;
+            TileSet A_tiles_set, B_tiles_set;
 
             for (int64_t i = 0; i < B.mt(); ++i) {
                 for (int64_t j = 0; j < B.nt(); ++j) {
@@ -165,15 +168,42 @@ void add(internal::TargetType<Target::Devices>,
                                 blas::MemcpyKind::HostToDevice,
                                 *queue);
 
-            for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
-                device::batch::geadd(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        alpha, a_array_dev, group_params[ g ].ld[0],
-                        beta, b_array_dev, group_params[ g ].ld[1],
-                        group_count, *queue);
-                a_array_dev += group_count;
-                b_array_dev += group_count;
+            if (group_params.size() == 1) {
+                // Replayed from a graph if gpu_graphs.
+                auto key = device_graph_key(
+                    "geadd", typeid( scalar_t ).hash_code(),
+                    group_params[ 0 ].mb, group_params[ 0 ].nb,
+                    alpha, a_array_dev, group_params[ 0 ].ld[0],
+                    beta,  b_array_dev, group_params[ 0 ].ld[1],
+                    group_params[ 0 ].count );
+                device_graph_run( *queue, key, [&]() {
+                    device::batch::geadd(
+                            group_params[ 0 ].mb, group_params[ 0 ].nb,
+                            alpha, a_array_dev, group_params[ 0 ].ld[0],
+                            beta, b_array_dev, group_params[ 0 ].ld[1],
+                            group_params[ 0 ].count, *queue);
+                });
+            }
+            else if (group_params.size() > 1) {
+                // Edge tiles: one variable-size launch for all regions.
+                std::vector<int64_t> dims;
+                int64_t max_m = device_regions_vbatch_dims( group_params, dims );
+                int64_t dims_size = ceildiv( int64_t( dims.size()*sizeof(int64_t) ),
+                                             int64_t( sizeof(scalar_t) ) );
+                int64_t* dims_dev = reinterpret_cast<int64_t*>(
+                    B.allocWorkspaceBuffer( device, dims_size ) );
+                blas::device_memcpy<int64_t>(
+                    dims_dev, dims.data(), dims.size(),
+                    blas::MemcpyKind::HostToDevice, *queue);
+
+                device::geadd_vbatch(
+                        &dims_dev[ 0 ], &dims_dev[ batch_size ],
+                        alpha, a_array_dev, &dims_dev[ 2*batch_size ],
+                        beta,  b_array_dev, &dims_dev[ 3*batch_size ],
+                        max_m, batch_size, *queue);
+
+                queue->sync();
+                B.freeWorkspaceBuffer( device, reinterpret_cast<scalar_t*>( dims_dev ) );
             }
 
             queue->sync();
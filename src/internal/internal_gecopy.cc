@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/internal/device.hh"
+#include "slate/internal/DeviceGraph.hh"
 #include "internal/internal_batch.hh"
 #include "internal/internal.hh"
 #include "slate/internal/util.hh"
@@ -12,6 +13,9 @@
 #include "slate/Tile_aux.hh"
 #include "slate/types.hh"
 
+#include <tuple>
+#include <typeinfo>
+
 namespace slate {
 
 namespace device {
@@ -80,10 +84,13 @@ void copy(internal::TargetType<Target::HostTask>,
                     priority(priority)
                 {
                     A.tileGetForReading(i, j, LayoutConvert::None);
-                    // tileAcquire() to avoid un-needed copy
-                    B.tileAcquire(i, j, A.tileLayout(i, j));
-                    B.tileModified(i, j, HostNum, true);
+                    // Read before A(i, j), which resets it.
+                    TileStructure structure = A.tileStructure( i, j );
+                    // B is overwritten, so avoid un-needed copy
+                    B.tileAcquireForOverwrite(
+                        i, j, HostNum, A.tileLayout(i, j) );
                     tile::gecopy( A(i, j), B(i, j) );
+                    B.tileStructure( i, j, structure );
                 }
             }
         }
@@ -130,7 +137,7 @@ void copy(internal::TargetType<Target::Devices>,
         #pragma omp task slate_omp_default_none priority( priority ) \
             shared( A, B ) firstprivate( device, queue_index )
         {
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
             for (int64_t i = 0; i < B.mt(); ++i) {
                 for (int64_t j = 0; j < B.nt(); ++j) {
                     if (B.tileIsLocal(i, j) && device == B.tileDevice(i, j)) {
@@ -138,24 +145,38 @@ void copy(internal::TargetType<Target::Devices>,
                     }
                 }
             }
+            blas::Queue* queue = B.compute_queue(device, queue_index);
+
+            // The queue, rather than this thread, waits for earlier
+            // device work on the tiles.
             // no need to convert layout
             // TODO kernel assumes column major
-            A.tileGetForReading(A_tiles_set, device, LayoutConvert::ColMajor);
+            A.tileGetForReading(A_tiles_set, device, LayoutConvert::ColMajor,
+                                *queue);
 
             // no need to copy old values
+            // The structures are read before the tiles are handed out
+            // below, which resets them, and recorded for B at the end.
+            std::vector< std::tuple< int64_t, int64_t, TileStructure > >
+                structures;
             for (int64_t i = 0; i < B.mt(); ++i) {
                 for (int64_t j = 0; j < B.nt(); ++j) {
                     if (B.tileIsLocal(i, j) && device == B.tileDevice(i, j)) {
-                        B.tileAcquire(i, j, device, A.tileLayout(i, j, device));
-                        B.tileModified(i, j, device, true);
+                        B.tileAcquireForOverwrite(
+                            i, j, device, A.tileLayout(i, j, device), queue );
+                        structures.push_back( { i, j, A.tileStructure( i, j ) } );
                     }
                 }
             }
 
-            // Usually the output matrix (B) provides all the batch arrays.
-            // Here we are using A, because of the possibly different types.
-            src_scalar_t** a_array_host = A.array_host(device, queue_index);
-            dst_scalar_t** b_array_host = B.array_host(device, queue_index);
+            // Since the queue isn't synchronized, the pointer arrays are
+            // copied from pageable vectors, which the host can free as soon
+            // as device_memcpy returns, rather than the pinned array_host,
+            // which the next routine on this queue would overwrite.
+            std::vector<src_scalar_t*> a_array_vec( A_tiles_set.size() );
+            std::vector<dst_scalar_t*> b_array_vec( A_tiles_set.size() );
+            src_scalar_t** a_array_host = a_array_vec.data();
+            dst_scalar_t** b_array_host = b_array_vec.data();
 
             // Because A and B may be different types and C++ doesn't easily
             // support iterating over tuples.  We manually handle A
@@ -185,8 +206,6 @@ void copy(internal::TargetType<Target::Devices>,
             src_scalar_t** a_array_dev = A.array_device(device, queue_index);
             dst_scalar_t** b_array_dev = B.array_device(device, queue_index);
 
-            blas::Queue* queue = B.compute_queue(device, queue_index);
-
             blas::device_memcpy<src_scalar_t*>(a_array_dev, a_array_host,
                                 batch_count,
                                 blas::MemcpyKind::HostToDevice,
@@ -203,28 +222,54 @@ void copy(internal::TargetType<Target::Devices>,
                 is_conj = (A.op() == Op::ConjTrans || B.op() == Op::ConjTrans);
             }
 
+            // Key the launches for graph replay (gpu_graphs).
+            auto key = device_graph_key(
+                "gecopy", typeid( src_scalar_t ).hash_code(),
+                typeid( dst_scalar_t ).hash_code(), is_trans, is_conj,
+                a_array_dev, b_array_dev );
             for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
-                if (is_trans) {
-                    device::transpose_batch(
-                            is_conj,
-                            group_params[ g ].mb, group_params[ g ].nb,
-                            a_array_dev, lda[ g ],
-                            b_array_dev, group_params[ g ].ld[0],
-                            group_count, *queue);
-                }
-                else {
-                    device::gecopy(
-                            group_params[ g ].mb, group_params[ g ].nb,
-                            a_array_dev, lda[ g ],
-                            b_array_dev, group_params[ g ].ld[0],
-                            group_count, *queue);
-                }
-                a_array_dev += group_count;
-                b_array_dev += group_count;
+                device_graph_key_append( key, group_params[ g ].mb );
+                device_graph_key_append( key, group_params[ g ].nb );
+                device_graph_key_append( key, lda[ g ] );
+                device_graph_key_append( key, group_params[ g ].ld[0] );
+                device_graph_key_append( key, group_params[ g ].count );
             }
 
-            queue->sync();
+            device_graph_run( *queue, key, [&]() {
+                src_scalar_t** a_group_dev = a_array_dev;
+                dst_scalar_t** b_group_dev = b_array_dev;
+                for (size_t g = 0; g < group_params.size(); ++g) {
+                    int64_t group_count = group_params[ g ].count;
+                    if (is_trans) {
+                        device::transpose_batch(
+                                is_conj,
+                                group_params[ g ].mb, group_params[ g ].nb,
+                                a_group_dev, lda[ g ],
+                                b_group_dev, group_params[ g ].ld[0],
+                                group_count, *queue);
+                    }
+                    else {
+                        device::gecopy(
+                                group_params[ g ].mb, group_params[ g ].nb,
+                                a_group_dev, lda[ g ],
+                                b_group_dev, group_params[ g ].ld[0],
+                                group_count, *queue);
+                    }
+                    a_group_dev += group_count;
+                    b_group_dev += group_count;
+                }
+            });
+
+            // Instead of synchronizing, record an event that later
+            // users of the tiles wait on.
+            auto event = DeviceEvent::record( *queue );
+            A.tileRecordEvent( A_tiles_set, device, event, false );
+            B.tileRecordEvent( A_tiles_set, device, event, true );
+
+            for (auto ijs : structures) {
+                B.tileStructure( std::get<0>( ijs ), std::get<1>( ijs ),
+                                 std::get<2>( ijs ) );
+            }
         }
     }
 }
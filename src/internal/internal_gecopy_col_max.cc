@@ -0,0 +1,617 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/device.hh"
+#include "internal/internal_batch.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+#include "slate/internal/util.hh"
+#include "slate/Matrix.hh"
+#include "slate/internal/mpi.hh"
+#include "slate/types.hh"
+
+#include <vector>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Copy (if add is false) or add (if add is true) with precision conversion,
+/// fused with the max norm of each column, in one pass over the tiles.
+/// If add is false, sets B = A and values = local column max norms of A.
+/// If add is true,  sets B = A + B and values = local column max norms of
+/// the updated B.
+/// Assumes A & B have same tile layout, dimensions, and distribution,
+/// and no transposition.
+/// Host OpenMP task implementation.
+/// @ingroup copy_internal
+///
+template <bool add, typename src_scalar_t, typename dst_scalar_t>
+void copy_col_max(
+    internal::TargetType<Target::HostTask>,
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    int priority, int queue_index )
+{
+    using real_t = blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >;
+
+    // The kernels assume column major.
+    const Layout layout = Layout::ColMajor;
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t A_n  = A.n();
+    assert(A_mt == B.mt());
+    assert(A_nt == B.nt());
+    assert(A.op() == B.op());
+
+    // Max of each column in each tile row.
+    std::vector<real_t> cols_maxima( A_n*A_mt, 0.0 );
+
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < A_mt; ++i) {
+        int64_t jj = 0;
+        for (int64_t j = 0; j < A_nt; ++j) {
+            if (B.tileIsLocal( i, j )) {
+                #pragma omp task slate_omp_default_none \
+                    shared( A, B, cols_maxima ) \
+                    firstprivate( i, j, jj, A_n, layout ) priority( priority )
+                {
+                    A.tileGetForReading( i, j, LayoutConvert( layout ) );
+                    if (add) {
+                        B.tileGetForWriting( i, j, LayoutConvert( layout ) );
+                    }
+                    else {
+                        // tileAcquire() to avoid un-needed copy
+                        B.tileAcquire( i, j, layout );
+                        B.tileModified( i, j, HostNum, true );
+                    }
+                    auto Aij = A( i, j );
+                    auto Bij = B( i, j );
+                    real_t* col_max = &cols_maxima[ A_n*i + jj ];
+                    for (int64_t jb = 0; jb < Aij.nb(); ++jb) {
+                        src_scalar_t const* Aj = &Aij.at( 0, jb );
+                        dst_scalar_t* Bj = &Bij.at( 0, jb );
+                        real_t max = 0;
+                        for (int64_t ib = 0; ib < Aij.mb(); ++ib) {
+                            real_t absx;
+                            if (add) {
+                                Bj[ ib ] += dst_scalar_t( Aj[ ib ] );
+                                absx = std::abs( Bj[ ib ] );
+                            }
+                            else {
+                                Bj[ ib ] = dst_scalar_t( Aj[ ib ] );
+                                absx = std::abs( Aj[ ib ] );
+                            }
+                            max = max_nan( absx, max );
+                        }
+                        col_max[ jb ] = max;
+                    }
+                }
+            }
+            jj += A.tileNb( j );
+        }
+    }
+
+    // Find max of each column.
+    std::fill_n( values, A_n, 0.0 );
+    for (int64_t i = 0; i < A_mt; ++i) {
+        for (int64_t j = 0; j < A_n; ++j) {
+            values[ j ] = max_nan( cols_maxima[ A_n*i + j ], values[ j ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copy or add with precision conversion, fused with column max norms.
+/// GPU device implementation.
+/// @ingroup copy_internal
+///
+template <bool add, typename src_scalar_t, typename dst_scalar_t>
+void copy_col_max(
+    internal::TargetType<Target::Devices>,
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    int priority, int queue_index )
+{
+    using real_t = blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >;
+    using ij_tuple = typename BaseMatrix<src_scalar_t>::ij_tuple;
+
+    // The kernels assume column major.
+    const Layout layout = Layout::ColMajor;
+
+    assert(A.mt() == B.mt());
+    assert(A.nt() == B.nt());
+    assert(A.op() == B.op());
+
+    int64_t A_n = A.n();
+    auto joffsets = tile_offsets( RowCol::Col, A );
+    auto jrange = device_regions_range( RowCol::Col, B );
+    int64_t ldv = 0;
+    for (size_t j = 0; j < jrange.size()-1; ++j) {
+        ldv = std::max( ldv, B.tileNb( jrange[j] ) );
+    }
+
+    // Local column max of each device.
+    std::vector< std::vector<real_t> > devices_values( B.num_devices() );
+
+    #pragma omp taskgroup
+    for (int device = 0; device < B.num_devices(); ++device) {
+        #pragma omp task slate_omp_default_none priority( priority ) \
+            shared( A, B, devices_values, joffsets ) \
+            firstprivate( device, queue_index, ldv, A_n, layout )
+        {
+            TileSet tiles_set;
+            for (int64_t i = 0; i < B.mt(); ++i) {
+                for (int64_t j = 0; j < B.nt(); ++j) {
+                    if (B.tileIsLocal( i, j ) && device == B.tileDevice( i, j )) {
+                        tiles_set.insert( { i, j } );
+                    }
+                }
+            }
+            A.tileGetForReading( tiles_set, device, LayoutConvert( layout ) );
+            if (add) {
+                B.tileGetForWriting( tiles_set, device, LayoutConvert( layout ) );
+            }
+            else {
+                // no need to copy old values
+                for (auto ij : tiles_set) {
+                    int64_t i = std::get<0>( ij );
+                    int64_t j = std::get<1>( ij );
+                    B.tileAcquire( i, j, device, layout );
+                    B.tileModified( i, j, device, true );
+                }
+            }
+
+            // As in copy, B provides the batch arrays, A is set up manually
+            // because of the different types.
+            src_scalar_t** a_array_host = A.array_host( device, queue_index );
+            dst_scalar_t** b_array_host = B.array_host( device, queue_index );
+
+            std::vector<int64_t> lda;
+            std::vector<int64_t> tile_cols;
+            int64_t batch_count = 0;
+            std::function<void(int64_t, int64_t, int64_t)>
+            setup_A = [&] (int64_t group, int64_t i, int64_t j) {
+                auto Aij = A( i, j, device );
+                a_array_host[ batch_count ] = Aij.data();
+                if (lda.size() == size_t(group)) {
+                    lda.push_back( Aij.stride() );
+                }
+                else {
+                    assert(lda.size() > size_t(group));
+                    assert(lda[group] == Aij.stride());
+                }
+                tile_cols.push_back( j );
+                ++batch_count;
+            };
+            auto group_params = device_regions_build<false, 1, dst_scalar_t>(
+                    {B},
+                    {b_array_host},
+                    device,
+                    setup_A );
+
+            src_scalar_t** a_array_dev = A.array_device( device, queue_index );
+            dst_scalar_t** b_array_dev = B.array_device( device, queue_index );
+
+            blas::Queue* queue = B.compute_queue( device, queue_index );
+
+            std::vector<real_t> vals_host( batch_count*ldv );
+            real_t* vals_dev = blas::device_malloc<real_t>(
+                std::max( batch_count*ldv, int64_t( 1 ) ), *queue );
+
+            blas::device_memcpy<src_scalar_t*>( a_array_dev, a_array_host,
+                                                 batch_count,
+                                                 blas::MemcpyKind::HostToDevice,
+                                                 *queue );
+
+            blas::device_memcpy<dst_scalar_t*>( b_array_dev, b_array_host,
+                                                 batch_count,
+                                                 blas::MemcpyKind::HostToDevice,
+                                                 *queue );
+
+            real_t* vals_dev_group = vals_dev;
+            for (size_t g = 0; g < group_params.size(); ++g) {
+                int64_t group_count = group_params[ g ].count;
+                if (add) {
+                    device::geadd_col_max(
+                            group_params[ g ].mb, group_params[ g ].nb,
+                            a_array_dev, lda[ g ],
+                            b_array_dev, group_params[ g ].ld[0],
+                            vals_dev_group, ldv,
+                            group_count, *queue );
+                }
+                else {
+                    device::gecopy_col_max(
+                            group_params[ g ].mb, group_params[ g ].nb,
+                            a_array_dev, lda[ g ],
+                            b_array_dev, group_params[ g ].ld[0],
+                            vals_dev_group, ldv,
+                            group_count, *queue );
+                }
+                a_array_dev += group_count;
+                b_array_dev += group_count;
+                vals_dev_group += group_count * ldv;
+            }
+
+            blas::device_memcpy<real_t>( vals_host.data(), vals_dev,
+                                         batch_count*ldv,
+                                         blas::MemcpyKind::DeviceToHost,
+                                         *queue );
+            queue->sync();
+            blas::device_free( vals_dev, *queue );
+
+            // Reduction over tiles to device result.
+            std::vector<real_t>& device_values = devices_values[ device ];
+            device_values.assign( A_n, 0.0 );
+            for (int64_t k = 0; k < batch_count; ++k) {
+                int64_t j = tile_cols[ k ];
+                for (int64_t jb = 0; jb < B.tileNb( j ); ++jb) {
+                    device_values[ joffsets[ j ] + jb ] = max_nan(
+                        vals_host[ k*ldv + jb ],
+                        device_values[ joffsets[ j ] + jb ] );
+                }
+            }
+        }
+    }
+
+    // Reduction over devices to local result.
+    std::fill_n( values, A_n, 0.0 );
+    for (auto& device_values : devices_values) {
+        for (size_t j = 0; j < device_values.size(); ++j) {
+            values[ j ] = max_nan( device_values[ j ], values[ j ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copy and precision conversion, fused with the max norm of each column.
+/// Sets B = A, and values[ j ] = max_i abs( A_{i,j} ) over local tiles;
+/// the caller reduces values over MPI ranks.
+/// Dispatches to target implementations.
+///
+/// @param[in] A
+///     Source matrix.
+///
+/// @param[out] B
+///     On exit, B = A, converted to B's precision. Same tile layout,
+///     dimensions, and distribution as A.
+///
+/// @param[out] values
+///     Array of length A.n(). On exit, local column max norms of A,
+///     in the higher precision of A and B.
+///
+/// @ingroup copy_internal
+///
+template <Target target, typename src_scalar_t, typename dst_scalar_t>
+void copy_col_max(
+    Matrix<src_scalar_t>&& A,
+    Matrix<dst_scalar_t>&& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    int priority, int queue_index )
+{
+    copy_col_max<false>( internal::TargetType<target>(),
+                         A, B, values,
+                         priority, queue_index );
+}
+
+//------------------------------------------------------------------------------
+/// Add and precision conversion, fused with the max norm of each column.
+/// Sets B = A + B, and values[ j ] = max_i abs( B_{i,j} ) of the updated B
+/// over local tiles; the caller reduces values over MPI ranks.
+/// Dispatches to target implementations.
+///
+/// @param[in] A
+///     Matrix to add to B.
+///
+/// @param[in,out] B
+///     On exit, B = A + B. Same tile layout, dimensions, and distribution
+///     as A.
+///
+/// @param[out] values
+///     Array of length A.n(). On exit, local column max norms of the
+///     updated B, in the higher precision of A and B.
+///
+/// @ingroup copy_internal
+///
+template <Target target, typename src_scalar_t, typename dst_scalar_t>
+void add_col_max(
+    Matrix<src_scalar_t>&& A,
+    Matrix<dst_scalar_t>&& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    int priority, int queue_index )
+{
+    copy_col_max<true>( internal::TargetType<target>(),
+                        A, B, values,
+                        priority, queue_index );
+}
+
+//------------------------------------------------------------------------------
+/// Driver-level copy_col_max or add_col_max: runs them in a parallel region,
+/// updates the origin of B, and reduces the column max norms over MPI ranks.
+///
+template <bool add, typename src_scalar_t, typename dst_scalar_t>
+void copy_colNorms(
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    Options const& opts )
+{
+    using real_t = blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >;
+
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    std::vector<real_t> local_maxes( A.n() );
+
+    // As in copy, A provides batch arrays too, because of the different types.
+    if (target == Target::Devices) {
+        A.allocateBatchArrays();
+        B.allocateBatchArrays();
+        B.reserveDeviceWorkspace();
+    }
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        if (target == Target::Devices) {
+            copy_col_max<add>( internal::TargetType<Target::Devices>(),
+                               A, B, local_maxes.data(), 0, 0 );
+        }
+        else {
+            copy_col_max<add>( internal::TargetType<Target::HostTask>(),
+                               A, B, local_maxes.data(), 0, 0 );
+        }
+        #pragma omp taskwait
+        B.tileUpdateAllOrigin();
+    }
+
+    B.releaseWorkspace();
+
+    MPI_Op op_max_nan;
+    #pragma omp critical(slate_mpi)
+    {
+        slate_mpi_call(
+            MPI_Op_create( mpi_max_nan, true, &op_max_nan ) );
+    }
+
+    #pragma omp critical(slate_mpi)
+    {
+        trace::Block trace_block("MPI_Allreduce");
+        slate_mpi_call(
+            MPI_Allreduce( local_maxes.data(), values,
+                           A.n(), mpi_type<real_t>::value,
+                           op_max_nan, A.mpiComm() ) );
+    }
+
+    #pragma omp critical(slate_mpi)
+    {
+        slate_mpi_call(
+            MPI_Op_free( &op_max_nan ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copy and precision conversion, fused with the max norm of each column,
+/// as copy( A, B, opts ) followed by colNorms( Norm::Max, A, values, opts ),
+/// in one pass over A.
+/// Used in mixed-precision iterative refinement to down-convert the
+/// residual R while computing its column norms.
+///
+/// @param[in] A
+///     Source matrix.
+///
+/// @param[out] B
+///     On exit, B = A, converted to B's precision. Same tile layout,
+///     dimensions, and distribution as A.
+///
+/// @param[out] values
+///     Array of length A.n(). On exit, column max norms of A,
+///     in the higher precision of A and B.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup copy_internal
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void copy_colNorms(
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    Options const& opts )
+{
+    copy_colNorms<false>( A, B, values, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Add and precision conversion, fused with the max norm of each column,
+/// as B = A + B followed by colNorms( Norm::Max, B, values, opts ),
+/// in one pass over B.
+/// Used in mixed-precision iterative refinement to up-convert the
+/// correction and update the solution X while computing its column norms.
+///
+/// @param[in] A
+///     Matrix to add to B.
+///
+/// @param[in,out] B
+///     On exit, B = A + B. Same tile layout, dimensions, and distribution
+///     as A.
+///
+/// @param[out] values
+///     Array of length A.n(). On exit, column max norms of the updated B,
+///     in the higher precision of A and B.
+///
+/// @param[in] opts
+///     Additional options, as for copy_colNorms.
+///
+/// @ingroup copy_internal
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void add_colNorms(
+    Matrix<src_scalar_t>& A,
+    Matrix<dst_scalar_t>& B,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* values,
+    Options const& opts )
+{
+    copy_colNorms<true>( A, B, values, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations, for the precision conversions of
+// mixed-precision solvers.
+//-----------------------------------------
+// double => float
+template
+void copy_col_max<Target::HostTask, double, float>(
+    Matrix<double>&& A, Matrix<float>&& B, double* values,
+    int priority, int queue_index );
+
+template
+void copy_col_max<Target::Devices, double, float>(
+    Matrix<double>&& A, Matrix<float>&& B, double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max<Target::HostTask, double, float>(
+    Matrix<double>&& A, Matrix<float>&& B, double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max<Target::Devices, double, float>(
+    Matrix<double>&& A, Matrix<float>&& B, double* values,
+    int priority, int queue_index );
+
+//-----------------------------------------
+// float => double
+template
+void copy_col_max<Target::HostTask, float, double>(
+    Matrix<float>&& A, Matrix<double>&& B, double* values,
+    int priority, int queue_index );
+
+template
+void copy_col_max<Target::Devices, float, double>(
+    Matrix<float>&& A, Matrix<double>&& B, double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max<Target::HostTask, float, double>(
+    Matrix<float>&& A, Matrix<double>&& B, double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max<Target::Devices, float, double>(
+    Matrix<float>&& A, Matrix<double>&& B, double* values,
+    int priority, int queue_index );
+
+//-----------------------------------------
+// complex-double => complex-float
+template
+void copy_col_max< Target::HostTask, std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >&& A, Matrix< std::complex<float> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+template
+void copy_col_max< Target::Devices, std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >&& A, Matrix< std::complex<float> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max< Target::HostTask, std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >&& A, Matrix< std::complex<float> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max< Target::Devices, std::complex<double>, std::complex<float> >(
+    Matrix< std::complex<double> >&& A, Matrix< std::complex<float> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+//-----------------------------------------
+// complex-float => complex-double
+template
+void copy_col_max< Target::HostTask, std::complex<float>, std::complex<double> >(
+    Matrix< std::complex<float> >&& A, Matrix< std::complex<double> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+template
+void copy_col_max< Target::Devices, std::complex<float>, std::complex<double> >(
+    Matrix< std::complex<float> >&& A, Matrix< std::complex<double> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max< Target::HostTask, std::complex<float>, std::complex<double> >(
+    Matrix< std::complex<float> >&& A, Matrix< std::complex<double> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+template
+void add_col_max< Target::Devices, std::complex<float>, std::complex<double> >(
+    Matrix< std::complex<float> >&& A, Matrix< std::complex<double> >&& B,
+    double* values,
+    int priority, int queue_index );
+
+//------------------------------------------------------------------------------
+// Explicit instantiations of the driver-level routines.
+//-----------------------------------------
+// double => float
+template
+void copy_colNorms(
+    Matrix<double>& A, Matrix<float>& B, double* values,
+    Options const& opts );
+
+template
+void add_colNorms(
+    Matrix<double>& A, Matrix<float>& B, double* values,
+    Options const& opts );
+
+//-----------------------------------------
+// float => double
+template
+void copy_colNorms(
+    Matrix<float>& A, Matrix<double>& B, double* values,
+    Options const& opts );
+
+template
+void add_colNorms(
+    Matrix<float>& A, Matrix<double>& B, double* values,
+    Options const& opts );
+
+//-----------------------------------------
+// complex-double => complex-float
+template
+void copy_colNorms(
+    Matrix< std::complex<double> >& A, Matrix< std::complex<float> >& B, double* values,
+    Options const& opts );
+
+template
+void add_colNorms(
+    Matrix< std::complex<double> >& A, Matrix< std::complex<float> >& B, double* values,
+    Options const& opts );
+
+//-----------------------------------------
+// complex-float => complex-double
+template
+void copy_colNorms(
+    Matrix< std::complex<float> >& A, Matrix< std::complex<double> >& B, double* values,
+    Options const& opts );
+
+template
+void add_colNorms(
+    Matrix< std::complex<float> >& A, Matrix< std::complex<double> >& B, double* values,
+    Options const& opts );
+
+} // namespace internal
+} // namespace slate
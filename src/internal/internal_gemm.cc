@@ -5,13 +5,453 @@
 
 #include "slate/Matrix.hh"
 #include "slate/types.hh"
+#include "slate/FlopStats.hh"
 #include "slate/Tile_blas.hh"
 #include "internal/internal.hh"
 #include "internal/internal_batch.hh"
+#include "internal/internal_queue.hh"
+
+#include <array>
+#include <cmath>
+#include <map>
 
 namespace slate {
 namespace internal {
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// @return true if the hybrid split computes tile column j, of nt, on the
+/// host, given the fraction of columns on the host.
+/// Host columns are spread evenly, counting from the last column, which
+/// stays the same column of the whole matrix as trailing matrices shrink,
+/// so a column, and its tiles, stay on the host from one update to the next.
+bool hybrid_on_host( int64_t j, int64_t nt, double fraction )
+{
+    int64_t r = nt - 1 - j;
+    return std::floor( (r + 1) * fraction ) > std::floor( r * fraction );
+}
+
+//------------------------------------------------------------------------------
+/// Adapts the hybrid host fraction: grows it if the host finished its
+/// columns before the devices, else shrinks it. It stays at least one step,
+/// so the host keeps some columns to measure.
+void hybrid_adapt( bool host_first )
+{
+    const double step = 0.01;
+    #pragma omp critical(slate_hybrid)
+    {
+        double fraction = hybrid_host_fraction();
+        fraction = host_first ? fraction + step : fraction - step;
+        hybrid_host_fraction( std::max( fraction, step ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return size, in real elements, of the device workspace of gemm3m_device
+/// for an m-by-n-by-k tile update.
+int64_t gemm3m_work_size( int64_t m, int64_t n, int64_t k )
+{
+    return 3*(m*k + k*n + m*n);
+}
+
+//------------------------------------------------------------------------------
+/// Device tile update by the 3M (Gauss) method, as in tile::gemm3m,
+/// $C = \alpha op(A) op(B) + \beta C$, on tiles in GPU memory.
+/// Splits A and B into real parts on the device, multiplies them with
+/// 3 real gemm's, and combines the products into C, all on queue.
+/// Does nothing for real types, which never use 3M.
+///
+/// @param[in] work
+///     Device workspace of gemm3m_work_size( m, n, k ) real elements.
+///
+template <typename scalar_t>
+void gemm3m_device(
+    Layout layout, Op opA, Op opB,
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha, scalar_t const* A, int64_t lda,
+                    scalar_t const* B, int64_t ldb,
+    scalar_t beta,  scalar_t*       C, int64_t ldc,
+    blas::real_type<scalar_t>* work, blas::Queue& queue )
+{
+    if constexpr (blas::is_complex<scalar_t>::value) {
+        using real_t = blas::real_type<scalar_t>;
+
+        if (layout == Layout::RowMajor) {
+            // Row-major C = op(A) op(B) is column-major C^T = op(B)^T op(A)^T.
+            gemm3m_device( Layout::ColMajor, opB, opA, n, m, k,
+                           alpha, B, ldb, A, lda, beta, C, ldc,
+                           work, queue );
+            return;
+        }
+
+        // Parts of A and B are split as stored, then transposed by the
+        // real gemm's; conj is applied while splitting.
+        int64_t am = (opA == Op::NoTrans ? m : k);
+        int64_t an = (opA == Op::NoTrans ? k : m);
+        int64_t bm = (opB == Op::NoTrans ? k : n);
+        int64_t bn = (opB == Op::NoTrans ? n : k);
+        real_t* Ar = work;
+        real_t* Ai = Ar + m*k;
+        real_t* As = Ai + m*k;
+        real_t* Br = As + m*k;
+        real_t* Bi = Br + k*n;
+        real_t* Bs = Bi + k*n;
+        real_t* T1 = Bs + k*n;
+        real_t* T2 = T1 + m*n;
+        real_t* T3 = T2 + m*n;
+
+        device::gemm3m_split( am, an, opA == Op::ConjTrans,
+                              A, lda, Ar, Ai, As, am, queue );
+        device::gemm3m_split( bm, bn, opB == Op::ConjTrans,
+                              B, ldb, Br, Bi, Bs, bm, queue );
+
+        Op opAr = (opA == Op::NoTrans ? Op::NoTrans : Op::Trans);
+        Op opBr = (opB == Op::NoTrans ? Op::NoTrans : Op::Trans);
+        const real_t one = 1, zero = 0;
+        blas::gemm( Layout::ColMajor, opAr, opBr, m, n, k,
+                    one, Ar, am, Br, bm, zero, T1, m, queue );
+        blas::gemm( Layout::ColMajor, opAr, opBr, m, n, k,
+                    one, Ai, am, Bi, bm, zero, T2, m, queue );
+        blas::gemm( Layout::ColMajor, opAr, opBr, m, n, k,
+                    one, As, am, Bs, bm, zero, T3, m, queue );
+
+        device::gemm3m_combine( m, n, alpha, T1, T2, T3, m,
+                                beta, C, ldc, queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// A super-tile: a block of local tiles of C, on one device, whose data are
+/// contiguous, as in one column-major array, so it is updated by one gemm.
+struct SuperTileBlock {
+    std::vector<int64_t> rows;  ///< tile rows, in increasing order
+    std::vector<int64_t> cols;  ///< tile cols, in increasing order
+    int64_t m = 0;              ///< rows of the block
+    int64_t n = 0;              ///< cols of the block
+};
+
+//------------------------------------------------------------------------------
+/// Finds super-tiles of C on device: greedily, from each tile not yet
+/// covered, extends down over the next local tiles of its column, then right
+/// over the next local tile columns, while the data stay contiguous with
+/// the same stride, up to max_size tiles each way.
+/// Tiles of columns on_host are skipped. Tiles in super-tiles of 2 or more
+/// tiles are marked in covered, indexed i + j*mt.
+/// C's tiles must already be on the device.
+///
+template <typename scalar_t>
+std::vector<SuperTileBlock> super_tiles_build(
+    Matrix<scalar_t>& C, int device,
+    std::vector<char> const& on_host, int64_t max_size,
+    std::vector<char>& covered )
+{
+    std::vector<SuperTileBlock> blocks;
+    if (max_size < 2 || C.op() != Op::NoTrans)
+        return blocks;
+
+    int64_t mt = C.mt();
+    int64_t nt = C.nt();
+    auto is_candidate = [&]( int64_t i, int64_t j ) {
+        return C.tileIsLocal( i, j ) && C.tileDevice( i, j ) == device
+               && ! on_host[ j ] && ! covered[ i + j*mt ];
+    };
+    auto is_device_local = [&]( int64_t i, int64_t j ) {
+        return C.tileIsLocal( i, j ) && C.tileDevice( i, j ) == device;
+    };
+
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (! is_candidate( i, j ))
+                continue;
+            auto T0 = C( i, j, device );
+            if (T0.layout() != Layout::ColMajor)
+                continue;
+            int64_t ld = T0.stride();
+
+            SuperTileBlock block;
+            block.rows.push_back( i );
+            block.cols.push_back( j );
+
+            // Extend down over the next local tiles, skipping other ranks'.
+            scalar_t* next = T0.data() + T0.mb();
+            for (int64_t i2 = i+1; i2 < mt
+                 && int64_t( block.rows.size() ) < max_size; ++i2) {
+                if (! is_device_local( i2, j ))
+                    continue;
+                if (! is_candidate( i2, j ))
+                    break;
+                auto T = C( i2, j, device );
+                if (T.layout() != Layout::ColMajor || T.stride() != ld
+                    || T.data() != next)
+                    break;
+                block.rows.push_back( i2 );
+                next = T.data() + T.mb();
+            }
+
+            // Extend right over the next local tile columns.
+            for (int64_t j2 = j+1; j2 < nt
+                 && int64_t( block.cols.size() ) < max_size; ++j2) {
+                if (! is_device_local( i, j2 ))
+                    continue;
+                int64_t j1 = block.cols.back();
+                bool contiguous = true;
+                for (int64_t i2 : block.rows) {
+                    if (! is_candidate( i2, j2 )) {
+                        contiguous = false;
+                        break;
+                    }
+                    auto T  = C( i2, j2, device );
+                    auto T1 = C( i2, j1, device );
+                    if (T.layout() != Layout::ColMajor || T.stride() != ld
+                        || T.data() != T1.data() + T1.nb()*ld) {
+                        contiguous = false;
+                        break;
+                    }
+                }
+                if (! contiguous)
+                    break;
+                block.cols.push_back( j2 );
+            }
+
+            if (block.rows.size() * block.cols.size() > 1) {
+                for (int64_t i2 : block.rows)
+                    block.m += C.tileMb( i2 );
+                for (int64_t j2 : block.cols)
+                    block.n += C.tileNb( j2 );
+                for (int64_t j2 : block.cols)
+                    for (int64_t i2 : block.rows)
+                        covered[ i2 + j2*mt ] = true;
+                blocks.push_back( std::move( block ) );
+            }
+        }
+    }
+    return blocks;
+}
+
+//------------------------------------------------------------------------------
+/// Updates a super-tile of C on device, $C = \alpha A B + \beta C$, by one
+/// gemm. The tiles of A and B, which are usually separate workspace tiles
+/// of the broadcast panels, are first gathered contiguously into work,
+/// as stored, so op(A) and op(B) are applied by the gemm.
+/// C.op() must be NoTrans, and C tiles ColMajor.
+///
+/// @param[in] opA
+///     op applying the stored tiles of A as ColMajor; see tiles_op_in_layout.
+///
+/// @param[in] opB
+///     op applying the stored tiles of B as ColMajor.
+///
+/// @param[in] work
+///     Device workspace of (block.m + block.n) * k elements.
+///
+template <typename scalar_t>
+void super_tile_gemm(
+    scalar_t alpha, Matrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Op opA, Op opB,
+    SuperTileBlock const& block, int device,
+    scalar_t* work, blas::Queue& queue )
+{
+    int64_t m = block.m;
+    int64_t n = block.n;
+    int64_t k = A.tileNb( 0 );
+
+    // op(A) is m-by-k; stored m-by-k (NoTrans) or k-by-m.
+    scalar_t* Awork = work;
+    int64_t lda = (opA == Op::NoTrans ? m : k);
+    int64_t off = 0;
+    for (int64_t i : block.rows) {
+        auto Ai = A( i, 0, device );
+        if (opA == Op::NoTrans) {
+            blas::device_copy_matrix( Ai.mb(), k, Ai.data(), Ai.stride(),
+                                      &Awork[ off ], lda, queue );
+        }
+        else {
+            blas::device_copy_matrix( k, Ai.mb(), Ai.data(), Ai.stride(),
+                                      &Awork[ off*lda ], lda, queue );
+        }
+        off += Ai.mb();
+    }
+
+    // op(B) is k-by-n; stored k-by-n (NoTrans) or n-by-k.
+    scalar_t* Bwork = work + m*k;
+    int64_t ldb = (opB == Op::NoTrans ? k : n);
+    off = 0;
+    for (int64_t j : block.cols) {
+        auto Bj = B( 0, j, device );
+        if (opB == Op::NoTrans) {
+            blas::device_copy_matrix( k, Bj.nb(), Bj.data(), Bj.stride(),
+                                      &Bwork[ off*ldb ], ldb, queue );
+        }
+        else {
+            blas::device_copy_matrix( Bj.nb(), k, Bj.data(), Bj.stride(),
+                                      &Bwork[ off ], ldb, queue );
+        }
+        off += Bj.nb();
+    }
+
+    auto C0 = C( block.rows[ 0 ], block.cols[ 0 ], device );
+    blas::gemm( Layout::ColMajor, opA, opB, m, n, k,
+                alpha, Awork, lda, Bwork, ldb,
+                beta,  C0.data(), C0.stride(), queue );
+}
+
+//------------------------------------------------------------------------------
+/// Converts to layout only the host tiles of A that can't be used in place,
+/// i.e., complex conj-transposed tiles in the other layout; see
+/// tile::op_in_layout(). Others are left as is, and tile::gemm applies
+/// them by an op relative to layout.
+///
+template <typename scalar_t>
+void tiles_convert_if_needed(
+    Matrix<scalar_t>& A, TileSet const& tiles_set, Layout layout)
+{
+    for (auto ij : tiles_set) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        Op op;
+        if (! tile::op_in_layout( A( i, j ), layout, &op ))
+            A.tileGetForReading( i, j, LayoutConvert( layout ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Finds the op that applies the device tiles of A in layout, if the
+/// batch can use them in place: all in one layout, and not complex
+/// conj-transposed in the other layout.
+///
+/// @param[out] op
+///     On exit, if possible, the op to use in layout.
+///
+/// @return true if the tiles can be used in place.
+///
+template <typename scalar_t>
+bool tiles_op_in_layout(
+    Matrix<scalar_t>& A, TileSet const& tiles_set, int device,
+    Layout layout, Op* op)
+{
+    Layout tiles_layout = layout;
+    bool first = true;
+    for (auto ij : tiles_set) {
+        auto T = A( std::get<0>( ij ), std::get<1>( ij ), device );
+        if (first) {
+            tiles_layout = T.layout();
+            first = false;
+        }
+        else if (T.layout() != tiles_layout) {
+            return false;
+        }
+    }
+    return tile::op_in_layout( A.op(), tiles_layout, layout, A.is_complex,
+                               op );
+}
+
+//------------------------------------------------------------------------------
+/// Host batched gemm, ColMajor, grouped as in cblas_gemm_batch:
+/// group g has group_size[ g ] gemms of the same m, n, k, lda, ldb, ldc,
+/// stored in turn in a_array, b_array, c_array.
+/// With Intel MKL, calls cblas_gemm_batch; otherwise, e.g., with
+/// OpenBLAS, BLIS, or Arm PL, runs each gemm as an OpenMP task.
+///
+template <typename scalar_t>
+void gemm_batch_host(
+    Op opA, Op opB,
+    std::vector<int64_t> const& m_array,
+    std::vector<int64_t> const& n_array,
+    std::vector<int64_t> const& k_array,
+    scalar_t alpha,
+    std::vector<scalar_t const*> const& a_array,
+    std::vector<int64_t> const& lda_array,
+    std::vector<scalar_t const*> const& b_array,
+    std::vector<int64_t> const& ldb_array,
+    scalar_t beta,
+    std::vector<scalar_t*> const& c_array,
+    std::vector<int64_t> const& ldc_array,
+    std::vector<int64_t> const& group_size )
+{
+    int group_count = group_size.size();
+#ifdef BLAS_HAVE_MKL
+    trace::Block trace_block("cblas_gemm_batch");
+
+    std::vector<CBLAS_TRANSPOSE> opA_(group_count, cblas_trans_const(opA));
+    std::vector<CBLAS_TRANSPOSE> opB_(group_count, cblas_trans_const(opB));
+    std::vector<scalar_t> alpha_(group_count, alpha);
+    std::vector<scalar_t>  beta_(group_count,  beta);
+    std::vector<int> m_  (m_array.begin(),   m_array.end());
+    std::vector<int> n_  (n_array.begin(),   n_array.end());
+    std::vector<int> k_  (k_array.begin(),   k_array.end());
+    std::vector<int> lda_(lda_array.begin(), lda_array.end());
+    std::vector<int> ldb_(ldb_array.begin(), ldb_array.end());
+    std::vector<int> ldc_(ldc_array.begin(), ldc_array.end());
+    std::vector<int> size_(group_size.begin(), group_size.end());
+    std::vector<const scalar_t*> a_(a_array), b_(b_array);
+    std::vector<scalar_t*> c_(c_array);
+
+    // mkl_set_num_threads_local(...);
+    cblas_gemm_batch(
+        CblasColMajor,
+        opA_.data(), opB_.data(),
+        m_.data(), n_.data(), k_.data(),
+        alpha_.data(), a_.data(), lda_.data(),
+                       b_.data(), ldb_.data(),
+        beta_.data(),  c_.data(), ldc_.data(),
+        group_count, size_.data());
+    // mkl_set_num_threads_local(1);
+#else
+    trace::Block trace_block("blas::gemm_batch");
+
+    #pragma omp taskgroup
+    {
+        int64_t index = 0;
+        for (int g = 0; g < group_count; ++g) {
+            for (int64_t t = 0; t < group_size[ g ]; ++t, ++index) {
+                #pragma omp task slate_omp_default_none \
+                    shared( m_array, n_array, k_array, a_array, lda_array, \
+                            b_array, ldb_array, c_array, ldc_array ) \
+                    firstprivate( opA, opB, alpha, beta, g, index )
+                {
+                    blas::gemm( Layout::ColMajor, opA, opB,
+                                m_array[ g ], n_array[ g ], k_array[ g ],
+                                alpha, a_array[ index ], lda_array[ g ],
+                                       b_array[ index ], ldb_array[ g ],
+                                beta,  c_array[ index ], ldc_array[ g ] );
+                }
+            }
+        }
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Updates C(i, j) = beta C(i, j) on the host, for a product A(i, 0) B(0, j)
+/// that is zero because A(i, 0) or B(0, j) is a Zero tile.
+/// Nothing is done if beta = 1 or C(i, j) is already a Zero tile.
+///
+template <typename scalar_t>
+void gemm_zero_product(
+    scalar_t beta, Matrix<scalar_t>& C, int64_t i, int64_t j, Layout layout)
+{
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    if (beta == one || C.tileStructure( i, j ) == TileStructure::Zero)
+        return;
+
+    if (beta == zero) {
+        C.tileAcquireForOverwrite( i, j, HostNum, layout );
+        C( i, j ).set( zero );
+        C.tileStructure( i, j, TileStructure::Zero );
+    }
+    else {
+        C.tileGetForWriting( i, j, LayoutConvert( layout ) );
+        tile::scale( beta, C( i, j ) );
+    }
+}
+
+} // namespace
+
 //------------------------------------------------------------------------------
 /// General matrix multiply to update trailing matrix,
 /// where A is a single block column and B is a single block row.
@@ -42,6 +482,16 @@ void gemm(scalar_t alpha, Matrix<scalar_t>&& A,
         throw std::exception();
     }
 
+    // Flops of local C tiles, 2 mb nb k each.
+    FlopCounter flop_counter( FlopRoutine::Gemm, target, [&]() {
+        double flops = 0;
+        for (int64_t i = 0; i < C.mt(); ++i)
+            for (int64_t j = 0; j < C.nt(); ++j)
+                if (C.tileIsLocal( i, j ))
+                    flops += 2. * C.tileMb( i ) * C.tileNb( j ) * A.n();
+        return flops * flop_scale<scalar_t>();
+    } );
+
     gemm(internal::TargetType<target>(),
          alpha, A,
                 B,
@@ -62,9 +512,6 @@ void gemm(internal::TargetType<Target::HostTask>,
           scalar_t beta,  Matrix<scalar_t>& C,
           Layout layout, int priority, int64_t queue_index )
 {
-    // todo: optimize for the number of layout conversions,
-    //       by watching 'layout' and 'C(i, j).layout()'
-
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
     // check dimensions
     assert(A.nt() == 1);
@@ -74,7 +521,7 @@ void gemm(internal::TargetType<Target::HostTask>,
 
     int err = 0;
     std::string err_msg;
-    std::set<ij_tuple> A_tiles_set, B_tiles_set;
+    TileSet A_tiles_set, B_tiles_set;
     for (int64_t i = 0; i < C.mt(); ++i) {
         for (int64_t j = 0; j < C.nt(); ++j) {
             if (C.tileIsLocal(i, j)) {
@@ -83,8 +530,15 @@ void gemm(internal::TargetType<Target::HostTask>,
             }
         }
     }
-    A.tileGetForReading(A_tiles_set, LayoutConvert(layout));
-    B.tileGetForReading(B_tiles_set, LayoutConvert(layout));
+    // Tiles of A and B in the other layout are used in place; only those
+    // tile::gemm can't apply are converted, here, before the tasks use them.
+    A.tileGetForReading(A_tiles_set, LayoutConvert::None);
+    B.tileGetForReading(B_tiles_set, LayoutConvert::None);
+    tiles_convert_if_needed( A, A_tiles_set, layout );
+    tiles_convert_if_needed( B, B_tiles_set, layout );
+
+    // With beta = 0, C is overwritten, so don't fetch it.
+    bool overwrite = beta == scalar_t( 0 );
 
     #pragma omp taskgroup
     for (int64_t i = 0; i < C.mt(); ++i) {
@@ -92,14 +546,25 @@ void gemm(internal::TargetType<Target::HostTask>,
             if (C.tileIsLocal(i, j)) {
                 #pragma omp task slate_omp_default_none \
                     shared( A, B, C, err, err_msg ) \
-                    firstprivate(i, j, layout, alpha, beta ) \
+                    firstprivate(i, j, layout, alpha, beta, overwrite, HostNum ) \
                     priority(priority)
                 {
                     try {
-                        C.tileGetForWriting(i, j, LayoutConvert(layout));
-                        tile::gemm(
-                            alpha, A(i, 0), B(0, j),
-                            beta,  C(i, j) );
+                        if (A.tileStructure( i, 0 ) == TileStructure::Zero
+                            || B.tileStructure( 0, j ) == TileStructure::Zero) {
+                            // C = beta C; nothing to do if beta = 1
+                            // or C is already zero.
+                            gemm_zero_product( beta, C, i, j, layout );
+                        }
+                        else {
+                            if (overwrite)
+                                C.tileAcquireForOverwrite( i, j, HostNum, layout );
+                            else
+                                C.tileGetForWriting(i, j, LayoutConvert(layout));
+                            tile::gemm(
+                                alpha, A(i, 0), B(0, j),
+                                beta,  C(i, j) );
+                        }
                     }
                     catch (std::exception& e) {
                         err = __LINE__;
@@ -183,7 +648,6 @@ void gemm(internal::TargetType<Target::HostBatch>,
           scalar_t beta,  Matrix<scalar_t>& C,
           Layout layout, int priority, int64_t queue_index )
 {
-#ifdef BLAS_HAVE_MKL
     using blas::conj;
     using std::swap;
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
@@ -197,7 +661,7 @@ void gemm(internal::TargetType<Target::HostBatch>,
     // load off-diagonal tiles to host, if not there
     // also count tiles
     int batch_count = 0;
-    std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+    TileSet A_tiles_set, B_tiles_set, C_tiles_set;
     for (int64_t i = 0; i < C.mt(); ++i) {
         for (int64_t j = 0; j < C.nt(); ++j) {
             if (C.tileIsLocal(i, j)) {
@@ -261,87 +725,74 @@ void gemm(internal::TargetType<Target::HostBatch>,
             beta  = conj(beta);
         }
 
-        // all same
-        std::vector<CBLAS_TRANSPOSE> opA_array(batch_count,
-                                               cblas_trans_const(opA));
-        // all same
-        std::vector<CBLAS_TRANSPOSE> opB_array(batch_count,
-                                               cblas_trans_const(opB));
-        std::vector<int> m_array(batch_count);
-        std::vector<int> n_array(batch_count);
-        std::vector<int> k_array(batch_count);
-        std::vector<scalar_t> alpha_array(batch_count, alpha);  // all same
-        std::vector<scalar_t>  beta_array(batch_count,  beta);  // all same
-        std::vector<const scalar_t*> a_array(batch_count);
-        std::vector<const scalar_t*> b_array(batch_count);
-        std::vector<scalar_t*> c_array(batch_count);
-        std::vector<int> lda_array(batch_count);
-        std::vector<int> ldb_array(batch_count);
-        std::vector<int> ldc_array(batch_count);
-        std::vector<int> group_size(batch_count, 1);  // all same
-
-        int index = 0;
-        for (int64_t i = 0; i < C.mt(); ++i) {
-            for (int64_t j = 0; j < C.nt(); ++j) {
-                if (C.tileIsLocal(i, j)) {
-                    m_array[ index ] = C(i, j).mb();
-                    n_array[ index ] = C(i, j).nb();
-                    k_array[ index ] = A(i, 0).nb();  // should be all same
-
-                    assert(A(i, 0).mb() == m_array[index]);
-                    assert(B(0, j).nb() == n_array[index]);
-                    assert(B(0, j).mb() == k_array[index]);
-
-                    a_array[ index ] = A(i, 0).data();
-                    b_array[ index ] = B(0, j).data();
-                    c_array[ index ] = C(i, j).data();
-
-                    lda_array[ index ] = A(i, 0).stride();
-                    ldb_array[ index ] = B(0, j).stride();
-                    ldc_array[ index ] = C(i, j).stride();
-
-                    ++index;
-                }
+        // Group tiles by (m, n, k, lda, ldb, ldc), as device_regions_build
+        // does; usually interior, last row, last column, and corner tiles,
+        // so at most 4 groups.
+        using group_key = std::array<int64_t, 6>;
+        std::map< group_key, std::vector<ij_tuple> > groups;
+        for (auto ij : C_tiles_set) {
+            int64_t i = std::get<0>( ij );
+            int64_t j = std::get<1>( ij );
+            auto Ai = A(i, 0);
+            auto Bj = B(0, j);
+            auto Cij = C(i, j);
+            assert(Ai.mb() == Cij.mb());
+            assert(Bj.nb() == Cij.nb());
+            assert(Bj.mb() == Ai.nb());
+            group_key key = { Cij.mb(), Cij.nb(), Ai.nb(),
+                              Ai.stride(), Bj.stride(), Cij.stride() };
+            groups[ key ].push_back( ij );
+        }
+
+        std::vector<int64_t> m_array, n_array, k_array, group_size;
+        std::vector<int64_t> lda_array, ldb_array, ldc_array;
+        std::vector<const scalar_t*> a_array, b_array;
+        std::vector<scalar_t*> c_array;
+        a_array.reserve( batch_count );
+        b_array.reserve( batch_count );
+        c_array.reserve( batch_count );
+        for (auto& group : groups) {
+            auto& key = group.first;
+            m_array.push_back( key[ 0 ] );
+            n_array.push_back( key[ 1 ] );
+            k_array.push_back( key[ 2 ] );
+            lda_array.push_back( key[ 3 ] );
+            ldb_array.push_back( key[ 4 ] );
+            ldc_array.push_back( key[ 5 ] );
+            group_size.push_back( group.second.size() );
+            for (auto ij : group.second) {
+                int64_t i = std::get<0>( ij );
+                int64_t j = std::get<1>( ij );
+                a_array.push_back( A(i, 0).data() );
+                b_array.push_back( B(0, j).data() );
+                c_array.push_back( C(i, j).data() );
             }
         }
 
         if (C.op() != Op::NoTrans) {
             // swap A <=> B; swap m <=> n
-            swap(opA_array, opB_array);
+            swap(opA, opB);
             swap(a_array,   b_array);
             swap(lda_array, ldb_array);
             swap(m_array,   n_array);
         }
 
-        {
-            trace::Block trace_block("cblas_gemm_batch");
-            // mkl_set_num_threads_local(...);
-            if (layout == Layout::ColMajor) {
-                cblas_gemm_batch(
-                    CblasColMajor,
-                    opA_array.data(), opB_array.data(),
-                    m_array.data(), n_array.data(), k_array.data(),
-                    alpha_array.data(), a_array.data(), lda_array.data(),
-                                        b_array.data(), ldb_array.data(),
-                    beta_array.data(),  c_array.data(), ldc_array.data(),
-                    batch_count, group_size.data());
-            }
-            else {
-                cblas_gemm_batch(
-                    CblasColMajor,
-                    opB_array.data(), opA_array.data(),
-                    n_array.data(), m_array.data(), k_array.data(),
-                    alpha_array.data(), b_array.data(), ldb_array.data(),
-                                        a_array.data(), lda_array.data(),
-                    beta_array.data(),  c_array.data(), ldc_array.data(),
-                    batch_count, group_size.data());
-            }
-            // mkl_set_num_threads_local(1);
+        if (layout == Layout::ColMajor) {
+            gemm_batch_host(
+                opA, opB, m_array, n_array, k_array,
+                alpha, a_array, lda_array,
+                       b_array, ldb_array,
+                beta,  c_array, ldc_array, group_size );
+        }
+        else {
+            // RowMajor C = A B is ColMajor C^T = B^T A^T.
+            gemm_batch_host(
+                opB, opA, n_array, m_array, k_array,
+                alpha, b_array, ldb_array,
+                       a_array, lda_array,
+                beta,  c_array, ldc_array, group_size );
         }
     }
-#else
-    slate_not_implemented( "HostBatch requires Intel MKL" );
-#endif
 }
 
 //------------------------------------------------------------------------------
@@ -361,6 +812,7 @@ void gemm(internal::TargetType<Target::Devices>,
     using blas::conj;
     using std::swap;
     using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    using real_t = blas::real_type<scalar_t>;
 
     // check dimensions
     assert(C.mt() > 0);
@@ -374,147 +826,315 @@ void gemm(internal::TargetType<Target::Devices>,
 
     int err = 0;
 
+    // Hybrid split: some tile columns are computed by host BLAS, while the
+    // devices compute the rest. A single column, e.g., a lookahead column,
+    // stays on the devices.
+    double host_fraction = C.nt() > 1 ? hybrid_host_fraction() : 0.;
+    if (host_fraction > 0 && hybrid_auto()) {
+        // Keep at least one host column to measure.
+        host_fraction = std::max( host_fraction, 1. / C.nt() );
+    }
+    std::vector<int64_t> host_cols;
+    for (int64_t j = 0; j < C.nt(); ++j) {
+        if (hybrid_on_host( j, C.nt(), host_fraction ))
+            host_cols.push_back( j );
+    }
+    std::vector<char> on_host( C.nt(), false );
+    for (int64_t j : host_cols)
+        on_host[ j ] = true;
+
+    // Completion of each part, to adapt the split.
+    double host_end = 0;
+    std::vector<double> device_end( C.num_devices(), 0 );
+    std::vector< std::shared_ptr< DeviceEvent > > device_events( C.num_devices() );
+
     #pragma omp taskgroup
-    for (int device = 0; device < C.num_devices(); ++device) {
-        #pragma omp task shared(A, B, C, err) priority(priority) \
-            firstprivate( alpha, beta, layout, queue_index, device )
-        {
-            // if op(C) is NoTrans, invert opA, opB if possible
-            Op opA = A.op();
-            if (C.op() != Op::NoTrans) {
-                if (opA == Op::NoTrans)
-                    opA = C.op();
-                else if (A.op() == C.op() || C.is_real) {
-                    // A and C are both Trans or both ConjTrans;
-                    // Trans == ConjTrans if real
-                    opA = Op::NoTrans;
+    {
+        if (! host_cols.empty()) {
+            #pragma omp task shared( A, B, C, err, host_cols, host_end ) \
+                priority( priority ) \
+                firstprivate( alpha, beta, layout, priority, queue_index )
+            {
+                try {
+                    for (int64_t j : host_cols) {
+                        auto B_j = B.sub( 0, 0, j, j );
+                        auto C_j = C.sub( 0, C.mt()-1, j, j );
+                        gemm( internal::TargetType<Target::HostTask>(),
+                              alpha, A, B_j, beta, C_j,
+                              layout, priority, queue_index );
+                    }
                 }
-                else {
-                    err = __LINE__;  // ConjNoTrans not supported
+                catch (std::exception& e) {
+                    err = __LINE__;
                 }
+                host_end = omp_get_wtime();
             }
+        }
 
-            Op opB = B.op();
-            if (C.op() != Op::NoTrans) {
-                if (opB == Op::NoTrans)
-                    opB = C.op();
-                else if (opB == C.op() || C.is_real) {
-                    // B and C are both Trans or both ConjTrans;
-                    // Trans == ConjTrans if real
-                    opB = Op::NoTrans;
-                }
-                else {
-                    err = __LINE__;  // ConjNoTrans not supported
+        for (int device = 0; device < C.num_devices(); ++device) {
+            #pragma omp task shared( A, B, C, err, on_host, device_end, device_events ) \
+                priority(priority) \
+                firstprivate( alpha, beta, layout, queue_index, device )
+            {
+                TileSet A_tiles_set, B_tiles_set, C_tiles_set;
+                for (int64_t i = 0; i < C.mt(); ++i) {
+                    for (int64_t j = 0; j < C.nt(); ++j) {
+                        if (C.tileIsLocal(i, j) && ! on_host[ j ]) {
+                            if (device == C.tileDevice(i, j)) {
+                                A_tiles_set.insert({i, 0});
+                                B_tiles_set.insert({0, j});
+                                C_tiles_set.insert({i, j});
+                            }
+                        }
+                    }
                 }
-            }
 
-            if (C.op() == Op::ConjTrans) {
-                alpha = conj(alpha);
-                beta  = conj(beta);
-            }
+                // With queue_index = AnyQueue, leases a free queue.
+                QueueLease<scalar_t> lease( C, device, queue_index );
+                blas::Queue* queue = lease.queue();
+                assert(queue != nullptr);
 
-            std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
-            for (int64_t i = 0; i < C.mt(); ++i) {
-                for (int64_t j = 0; j < C.nt(); ++j) {
-                    if (C.tileIsLocal(i, j)) {
-                        if (device == C.tileDevice(i, j)) {
-                            A_tiles_set.insert({i, 0});
-                            B_tiles_set.insert({0, j});
-                            C_tiles_set.insert({i, j});
-                        }
+                // The queue, rather than this thread, waits for earlier
+                // device work on the tiles.
+                #pragma omp taskgroup
+                {
+                    #pragma omp task slate_omp_default_none \
+                        shared( A, A_tiles_set ) firstprivate( layout, device, queue )
+                    {
+                        A.tileGetForReading(A_tiles_set, device, LayoutConvert::None,
+                                            *queue);
+                    }
+                    #pragma omp task slate_omp_default_none \
+                        shared( B, B_tiles_set ) firstprivate( layout, device, queue )
+                    {
+                        B.tileGetForReading(B_tiles_set, device, LayoutConvert::None,
+                                            *queue);
+                    }
+                    #pragma omp task slate_omp_default_none \
+                        shared( C, C_tiles_set ) \
+                        firstprivate( layout, device, beta, queue )
+                    {
+                        // With beta = 0, C is overwritten, so don't fetch it.
+                        if (beta == scalar_t( 0 ))
+                            C.tileAcquireForOverwrite( C_tiles_set, device, layout,
+                                                       queue );
+                        else
+                            C.tileGetForWriting(C_tiles_set, device, LayoutConvert(layout),
+                                                *queue);
                     }
                 }
-            }
 
-            #pragma omp taskgroup
-            {
-                #pragma omp task slate_omp_default_none \
-                    shared( A, A_tiles_set ) firstprivate( layout, device )
-                {
-                    A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
+                // Tiles of A and B in the other layout are used in place,
+                // by an op relative to layout, if the batch can; else
+                // they are converted.
+                Op opA, opB;
+                if (! tiles_op_in_layout( A, A_tiles_set, device, layout, &opA )) {
+                    A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout),
+                                        *queue);
+                    opA = A.op();
                 }
-                #pragma omp task slate_omp_default_none \
-                    shared( B, B_tiles_set ) firstprivate( layout, device )
-                {
-                    B.tileGetForReading(B_tiles_set, device, LayoutConvert(layout));
+                if (! tiles_op_in_layout( B, B_tiles_set, device, layout, &opB )) {
+                    B.tileGetForReading(B_tiles_set, device, LayoutConvert(layout),
+                                        *queue);
+                    opB = B.op();
                 }
-                #pragma omp task slate_omp_default_none \
-                    shared( C, C_tiles_set ) firstprivate( layout, device )
-                {
-                    C.tileGetForWriting(C_tiles_set, device, LayoutConvert(layout));
+                // Ops of the stored tiles, for super-tiles.
+                Op opA_stored = opA;
+                Op opB_stored = opB;
+
+                // if op(C) is NoTrans, invert opA, opB if possible
+                if (C.op() != Op::NoTrans) {
+                    if (opA == Op::NoTrans)
+                        opA = C.op();
+                    else if (opA == C.op() || C.is_real) {
+                        // A and C are both Trans or both ConjTrans;
+                        // Trans == ConjTrans if real
+                        opA = Op::NoTrans;
+                    }
+                    else {
+                        err = __LINE__;  // ConjNoTrans not supported
+                    }
                 }
-            }
 
-            int64_t batch_size = C_tiles_set.size();
+                if (C.op() != Op::NoTrans) {
+                    if (opB == Op::NoTrans)
+                        opB = C.op();
+                    else if (opB == C.op() || C.is_real) {
+                        // B and C are both Trans or both ConjTrans;
+                        // Trans == ConjTrans if real
+                        opB = Op::NoTrans;
+                    }
+                    else {
+                        err = __LINE__;  // ConjNoTrans not supported
+                    }
+                }
 
-            scalar_t** a_array_host = C.array_host(device, queue_index);
-            scalar_t** b_array_host = a_array_host + batch_size;
-            scalar_t** c_array_host = b_array_host + batch_size;
+                if (C.op() == Op::ConjTrans) {
+                    alpha = conj(alpha);
+                    beta  = conj(beta);
+                }
 
-            // C comes first since we do computation for a local C
-            auto group_params = device_regions_build<false, 3, scalar_t>(
-                    {C, A, B},
-                    {c_array_host, a_array_host, b_array_host},
-                    device );
+                // Blocks of C tiles contiguous on the device are updated
+                // as super-tiles, each by one gemm; the rest are batched.
+                std::vector<char> covered( C.mt() * C.nt(), false );
+                std::vector<SuperTileBlock> super_tiles;
+                if (layout == Layout::ColMajor) {
+                    super_tiles = super_tiles_build(
+                        C, device, on_host, super_tile(), covered );
+                }
+                if (! super_tiles.empty()) {
+                    trace::Block trace_block("blas::gemm super-tiles");
+
+                    int64_t k = A.tileNb( 0 );
+                    int64_t work_size = 0;
+                    for (auto& block : super_tiles)
+                        work_size = std::max( work_size, (block.m + block.n)*k );
+                    scalar_t* work
+                        = blas::device_malloc<scalar_t>( work_size, *queue );
+                    // Super-tiles share work, as they are serialized on queue.
+                    for (auto& block : super_tiles) {
+                        super_tile_gemm( alpha, A, B, beta, C,
+                                         opA_stored, opB_stored, block, device,
+                                         work, *queue );
+                    }
+                    queue->sync();
+                    blas::device_free( work, *queue );
+                }
 
-            if (C.op() != Op::NoTrans) {
-                swap(opA, opB);
-            }
+                int64_t batch_size = C_tiles_set.size();
+
+                scalar_t** a_array_host = lease.array_host();
+                scalar_t** b_array_host = a_array_host + batch_size;
+                scalar_t** c_array_host = b_array_host + batch_size;
+
+                // C comes first since we do computation for a local C.
+                // Host columns of the hybrid split, and super-tiles,
+                // are skipped.
+                int64_t C_mt = C.mt();
+                auto group_params = device_regions_build<false, 3, scalar_t>(
+                        {C, A, B},
+                        {c_array_host, a_array_host, b_array_host},
+                        device, {},
+                        [&on_host, &covered, C_mt]( int64_t i, int64_t j ) {
+                            return ! on_host[ j ] && ! covered[ i + j*C_mt ];
+                        } );
+
+                if (C.op() != Op::NoTrans) {
+                    swap(opA, opB);
+                }
 
-            {
-                trace::Block trace_block("blas::batch::gemm");
+                {
+                    trace::Block trace_block("blas::batch::gemm");
+
+                    std::vector<Op> opA_(1, opA);
+                    std::vector<Op> opB_(1, opB);
+                    std::vector<scalar_t> alpha_(1, alpha);
+                    std::vector<scalar_t> beta_(1, beta);
+                    std::vector<int64_t> k(1, A.tileNb(0));
+                    // info size 0 disables slow checks in batched BLAS++.
+                    std::vector<int64_t> info;
+
+                    trace::DeviceBlock device_block(
+                        "blas::batch::gemm", *queue, lease.index(), batch_size );
+
+                    // Device workspace for groups with large enough tiles
+                    // to use 3M; otherwise none is allocated.
+                    int64_t work3m_size = 0;
+                    for (size_t g = 0; g < group_params.size(); ++g) {
+                        int64_t mb = group_params[ g ].mb;
+                        int64_t nb = group_params[ g ].nb;
+                        if (tile::use_gemm3m<scalar_t>( mb, nb, k[0] )) {
+                            work3m_size = std::max(
+                                work3m_size, gemm3m_work_size( mb, nb, k[0] ) );
+                        }
+                    }
+                    real_t* work3m = nullptr;
+                    if (work3m_size > 0)
+                        work3m = blas::device_malloc<real_t>( work3m_size, *queue );
 
-                std::vector<Op> opA_(1, opA);
-                std::vector<Op> opB_(1, opB);
-                std::vector<scalar_t> alpha_(1, alpha);
-                std::vector<scalar_t> beta_(1, beta);
-                std::vector<int64_t> k(1, A.tileNb(0));
-                // info size 0 disables slow checks in batched BLAS++.
-                std::vector<int64_t> info;
+                    for (size_t g = 0; g < group_params.size(); ++g) {
 
-                blas::Queue* queue = C.compute_queue(device, queue_index);
-                assert(queue != nullptr);
+                        int64_t group_count = group_params[ g ].count;
 
-                for (size_t g = 0; g < group_params.size(); ++g) {
+                        std::vector<int64_t>    m(1, group_params[ g ].mb);
+                        std::vector<int64_t>    n(1, group_params[ g ].nb);
+                        std::vector<int64_t> ldda(1, group_params[ g ].ld[1]);
+                        std::vector<int64_t> lddb(1, group_params[ g ].ld[2]);
+                        std::vector<int64_t> lddc(1, group_params[ g ].ld[0]);
 
-                    int64_t group_count = group_params[ g ].count;
+                        std::vector<scalar_t*> a_array(a_array_host, a_array_host+group_count);
+                        std::vector<scalar_t*> b_array(b_array_host, b_array_host+group_count);
+                        std::vector<scalar_t*> c_array(c_array_host, c_array_host+group_count);
 
-                    std::vector<int64_t>    m(1, group_params[ g ].mb);
-                    std::vector<int64_t>    n(1, group_params[ g ].nb);
-                    std::vector<int64_t> ldda(1, group_params[ g ].ld[1]);
-                    std::vector<int64_t> lddb(1, group_params[ g ].ld[2]);
-                    std::vector<int64_t> lddc(1, group_params[ g ].ld[0]);
+                        if (C.op() != Op::NoTrans) {
+                            swap(m, n);
+                            swap(a_array, b_array);
+                            swap(ldda, lddb);
+                        }
 
-                    std::vector<scalar_t*> a_array(a_array_host, a_array_host+group_count);
-                    std::vector<scalar_t*> b_array(b_array_host, b_array_host+group_count);
-                    std::vector<scalar_t*> c_array(c_array_host, c_array_host+group_count);
+                        if (tile::use_gemm3m<scalar_t>( m[0], n[0], k[0] )) {
+                            // Tiles of the group share the workspace,
+                            // so they are updated in turn on the queue.
+                            for (int64_t t = 0; t < group_count; ++t) {
+                                gemm3m_device(
+                                    layout, opA_[0], opB_[0],
+                                    m[0], n[0], k[0],
+                                    alpha, a_array[ t ], ldda[0],
+                                           b_array[ t ], lddb[0],
+                                    beta,  c_array[ t ], lddc[0],
+                                    work3m, *queue );
+                            }
+                        }
+                        else {
+                            blas::batch::gemm(
+                                layout, opA_, opB_,
+                                m, n, k,
+                                alpha_, a_array, ldda,
+                                        b_array, lddb,
+                                beta_,  c_array, lddc,
+                                group_count, info, *queue);
+                        }
 
-                    if (C.op() != Op::NoTrans) {
-                        swap(m, n);
-                        swap(a_array, b_array);
-                        swap(ldda, lddb);
+                        a_array_host += group_count;
+                        b_array_host += group_count;
+                        c_array_host += group_count;
                     }
 
-                    blas::batch::gemm(
-                        layout, opA_, opB_,
-                        m, n, k,
-                        alpha_, a_array, ldda,
-                                b_array, lddb,
-                        beta_,  c_array, lddc,
-                        group_count, info, *queue);
-
-                    a_array_host += group_count;
-                    b_array_host += group_count;
-                    c_array_host += group_count;
-                }
+                    if (work3m != nullptr) {
+                        // The workspace is freed only after the 3M updates.
+                        queue->sync();
+                        blas::device_free( work3m, *queue );
+                    }
 
-                queue->sync();
+                    // Instead of synchronizing, record an event that later
+                    // users of the tiles wait on.
+                    auto event = DeviceEvent::record( *queue );
+                    A.tileRecordEvent( A_tiles_set, device, event, false );
+                    B.tileRecordEvent( B_tiles_set, device, event, false );
+                    C.tileRecordEvent( C_tiles_set, device, event, true );
+                    device_events[ device ] = event;
+                    device_end[ device ] = omp_get_wtime();
+                }
             }
         }
     }
 
     if (err)
         slate_error(std::to_string(err));
+
+    if (! host_cols.empty() && hybrid_auto()) {
+        // The host finished first if a device is still running now, or,
+        // for a device that synchronized (null event), finished later.
+        bool host_first = false;
+        for (int device = 0; device < C.num_devices(); ++device) {
+            auto& event = device_events[ device ];
+            if (event != nullptr ? ! event->done()
+                                 : device_end[ device ] > host_end) {
+                host_first = true;
+            }
+        }
+        hybrid_adapt( host_first );
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -236,10 +236,21 @@ void gemmA(internal::TargetType<Target::Devices>,
     // TODO add more?
     assert( A.mt() == C.mt() );
     assert( B.nt() == C.nt() );
-    assert( B.nt() == 1 ); // TODO for now, one. Could it be more?
 
     assert(C.num_devices() > 0);
 
+    // Batches below are for one block column of B and C;
+    // do several block columns one at a time.
+    if (B.nt() > 1) {
+        for (int64_t j = 0; j < B.nt(); ++j) {
+            auto B_j = B.sub( 0, B.mt()-1, j, j );
+            auto C_j = C.sub( 0, C.mt()-1, j, j );
+            gemmA( internal::TargetType<Target::Devices>(),
+                   alpha, A, B_j, beta, C_j, layout, priority, queue_index );
+        }
+        return;
+    }
+
     int err = 0;
     const scalar_t zero = 0;
     const scalar_t one  = 1.0;
@@ -347,7 +358,7 @@ void gemmA(internal::TargetType<Target::Devices>,
             blas::Queue* queue = A.compute_queue( device, queue_index );
             assert( queue != nullptr );
 
-            std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+            TileSet A_tiles_set, B_tiles_set, C_tiles_set;
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
                     if (A.tileIsLocal( i, j )) {
@@ -431,6 +442,8 @@ void gemmA(internal::TargetType<Target::Devices>,
                             device );
 
                     trace::Block trace_block("blas::batch::gemm");
+                    trace::DeviceBlock device_block(
+                        "blas::batch::gemm", *queue, queue_index, batch_size );
 
                     std::vector<int64_t> k(1, A.tileNb(j));
 
@@ -6,6 +6,7 @@
 #include "slate/internal/device.hh"
 #include "internal/internal_batch.hh"
 #include "internal/internal_util.hh"
+#include "internal/internal_queue.hh"
 #include "internal/internal.hh"
 #include "slate/internal/util.hh"
 #include "slate/Matrix.hh"
@@ -426,7 +427,7 @@ void norm(
             shared( A, devices_values, vals_host_arrays, irange, jrange ) \
             firstprivate(device, queue_index, ldv, scope, in_norm, layout)
         {
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
@@ -437,9 +438,12 @@ void norm(
             }
             A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
 
+            // With queue_index = AnyQueue, leases a free queue.
+            QueueLease<scalar_t> lease( A, device, queue_index );
+
             // Setup batched arguments.
             int64_t batch_size = A_tiles_set.size();
-            scalar_t** a_array_host = A.array_host( device, queue_index );
+            scalar_t** a_array_host = lease.array_host();
 
             auto group_params = device_regions_build<false, 1, scalar_t>(
                     {A},
@@ -448,11 +452,11 @@ void norm(
                     {},
                     irange, jrange );
 
-            scalar_t** a_array_dev = A.array_device(device, queue_index);
+            scalar_t** a_array_dev = lease.array_device();
 
             vals_host_arrays[ device ].resize( batch_size*ldv );
             real_t* vals_host_array = vals_host_arrays[ device ].data();
-            blas::Queue* queue = A.compute_queue( device, queue_index );
+            blas::Queue* queue = lease.queue();
             real_t* vals_dev_array = blas::device_malloc<real_t>( batch_size*ldv, *queue );
 
             // Batched call to compute partial results for each tile.
@@ -8,6 +8,7 @@
 #include "slate/types.hh"
 #include "internal/Tile_geqrf.hh"
 #include "internal/internal.hh"
+#include "slate/internal/PanelThreadPool.hh"
 #include "lapack.hh"
 #include "lapack/device.hh"
 #include "blas/device.hh"
@@ -91,30 +92,17 @@ void geqrf(
         real_t xnorm;
         std::vector< std::vector<scalar_t> > W(thread_size);
 
-        #if 1
-            #pragma omp parallel slate_omp_default_none \
-                num_threads(thread_size) \
-                shared(thread_barrier, scale, sumsq, xnorm, W, A, T00) \
-                shared(tile_indices, tiles) \
-                firstprivate(ib, thread_size)
-        #else
-            #pragma omp taskloop slate_omp_default_none \
-                num_tasks(thread_size) \
-                shared(thread_barrier, scale, sumsq, xnorm, W, A, T00) \
-                shared(tile_indices, tiles) \
-                firstprivate(ib, thread_size)
-        #endif
-        {
-            // Factor the panel in parallel.
-            // todo: double check the size of W.
-            int thread_rank = omp_get_thread_num();
+        // Factor the panel in parallel, in the panel thread pool or in
+        // new threads.
+        // todo: double check the size of W.
+        panel_parallel( thread_size, [&]( int thread_rank ) {
             W.at(thread_rank).resize(ib*A.tileNb(0));
             geqrf(ib,
                   tiles, tile_indices, T00,
                   thread_rank, thread_size,
                   thread_barrier,
                   scale, sumsq, xnorm, W);
-        }
+        } );
     }
 }
 
@@ -180,7 +168,7 @@ void geqrf(
     int64_t nb       = A.tileNb( 0 );
     int64_t mlocal   = 0;
 
-    std::set<ij_tuple> A_tiles_set;
+    TileSet A_tiles_set;
     int64_t tile_index_zero = -1;
 
     size_t dsize, hsize;
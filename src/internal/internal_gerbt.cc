@@ -13,468 +13,445 @@ namespace slate {
 namespace internal {
 
 //------------------------------------------------------------------------------
-/// Applies a single butterfly matrix to each side of A.  The matrices are
-/// divided into the submatrices along the halfs of the butterfly matrices.
+/// Number of tiles in the butterfly group starting at index g,
+/// i.e., indices g + r*inner_len < n, for 0 <= r < 2^d.
+///
+inline int64_t gerbt_group_len(int64_t g, int64_t n, int64_t d, int64_t inner_len)
+{
+    return std::min( int64_t(1) << d, (n - g - 1) / inner_len + 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Applies all d levels of a 2-sided butterfly transform, U^T A V.
+///
+/// The butterflies of every level only combine tiles whose indices are
+/// congruent modulo inner_len, so A splits into independent groups of up to
+/// 2^d x 2^d tiles, A( gi + r*inner_len, gj + c*inner_len ), for
+/// 0 <= gi, gj < inner_len. Each group is gathered once to the rank owning
+/// its leading tile A(gi, gj), transformed through all levels there while the
+/// tiles are in cache, and sent back, instead of one pass over A with a
+/// gather and scatter per level. Groups start as soon as their own tiles
+/// arrive.
+///
+/// Rows U(i, 0) and V(j, 0) must be available on the rank owning
+/// A(i % inner_len, j % inner_len).
+///
+/// @param[in] inner_len
+///     ceil( nt / 2^d ), the length of the smallest butterfly halves, in tiles.
+///
+/// @param[in, out] A
+///     The matrix to transform.
+///
+/// @param[in] U
+///     The left transform, in packed, non-transposed storage, with d columns.
+///
+/// @param[in] V
+///     The right transform, in packed storage, with d columns.
 ///
 /// @ingroup gesv_internal
 ///
 template<typename scalar_t>
-void gerbt(Matrix<scalar_t> A11,
-           Matrix<scalar_t> A12,
-           Matrix<scalar_t> A21,
-           Matrix<scalar_t> A22,
-           Matrix<scalar_t> U1,
-           Matrix<scalar_t> U2,
-           Matrix<scalar_t> V1,
-           Matrix<scalar_t> V2)
+void gerbt(int64_t inner_len,
+           Matrix<scalar_t> A,
+           Matrix<scalar_t> U,
+           Matrix<scalar_t> V)
 {
-    // Assuming U and V have same structure as the A's where they're multiplied
-
-    slate_assert(A11.mt() >= A22.mt());
-    slate_assert(A11.nt() >= A22.nt());
-
-    slate_assert(A11.mt() == A12.mt());
-    slate_assert(A22.nt() == A12.nt());
-    slate_assert(A22.mt() == A21.mt());
-    slate_assert(A11.nt() == A21.nt());
-
-    const int64_t mt = A22.mt();
-    const int64_t nt = A22.nt();
-    const int64_t mt_full = A11.mt();
-    const int64_t nt_full = A11.nt();
-
-    // Used to manage OpenMP task dependencies
-    std::vector<uint8_t> task_vect(mt_full*nt_full);
-    uint8_t* task = task_vect.data();
-    SLATE_UNUSED( task ); // Used only by OpenMP
-
+    const int64_t d = U.n();
+    const int64_t mt = A.mt();
+    const int64_t nt = A.nt();
+    const int64_t gmt = std::min( inner_len, mt );
+    const int64_t gnt = std::min( inner_len, nt );
+
+    // Gather each group to the owner of its leading tile.
+    std::vector< std::vector<MPI_Request> > gather( gmt*gnt );
     std::vector<MPI_Request> requests;
-    for (int64_t ii = 0; ii < mt_full; ++ii) {
-        for (int64_t jj = 0; jj < nt_full; ++jj) {
-            const int64_t tag = 4*(ii*nt_full + jj);
-            MPI_Request r;
-            if (A11.tileIsLocal(ii, jj)) {
-                if (jj < nt) {
-                    A12.tileIrecv( ii, jj, A12.tileRank(ii, jj),
-                                  Layout::ColMajor, tag+1, &r );
-                    if (r != MPI_REQUEST_NULL) {
-                        requests.push_back(r);
-                    }
-                }
-                if (ii < mt) {
-                    A21.tileIrecv( ii, jj, A21.tileRank(ii, jj),
-                                  Layout::ColMajor, tag+2, &r );
-                    if (r != MPI_REQUEST_NULL) {
-                        requests.push_back(r);
+    for (int64_t gi = 0; gi < gmt; ++gi) {
+        for (int64_t gj = 0; gj < gnt; ++gj) {
+            const int compute_rank = A.tileRank( gi, gj );
+            const int64_t rlen = gerbt_group_len( gi, mt, d, inner_len );
+            const int64_t clen = gerbt_group_len( gj, nt, d, inner_len );
+            for (int64_t r = 0; r < rlen; ++r) {
+                for (int64_t c = 0; c < clen; ++c) {
+                    const int64_t i = gi + r*inner_len;
+                    const int64_t j = gj + c*inner_len;
+                    const int64_t tag = i*nt + j;
+                    MPI_Request req;
+                    if (A.tileIsLocal( gi, gj )) {
+                        A.tileIrecv( i, j, A.tileRank( i, j ),
+                                     Layout::ColMajor, tag, &req );
+                        if (req != MPI_REQUEST_NULL) {
+                            gather[ gi*gnt + gj ].push_back( req );
+                        }
                     }
-                }
-                if (ii < mt && jj < nt) {
-                    A22.tileIrecv( ii, jj, A22.tileRank(ii, jj),
-                                  Layout::ColMajor, tag+3, &r );
-                    if (r != MPI_REQUEST_NULL) {
-                        requests.push_back(r);
+                    else if (A.tileIsLocal( i, j )) {
+                        A.tileIsend( i, j, compute_rank, tag, &req );
+                        requests.push_back( req );
                     }
                 }
             }
-            else {
-                const int64_t compute_rank = A11.tileRank(ii, jj);
-                // Don't need to keep the requests since we don't touch the tile
-                // until receiving the finished data
-                if (jj < nt && A12.tileIsLocal(ii, jj)) {
-                    A12.tileIsend( ii, jj, compute_rank, tag+1, &r );
-                    MPI_Request_free(&r);
-                }
-                if (ii < mt && A21.tileIsLocal(ii, jj)) {
-                    A21.tileIsend( ii, jj, compute_rank, tag+2, &r );
-                    MPI_Request_free(&r);
-                }
-                if (ii < mt && jj < nt && A22.tileIsLocal(ii, jj)) {
-                    A22.tileIsend( ii, jj, compute_rank, tag+3, &r );
-                    MPI_Request_free(&r);
-                }
-            }
         }
     }
+    // Tiles sent away are received back below, so wait for the sends first.
     slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
                                MPI_STATUSES_IGNORE));
     requests.clear();
 
-    for (int64_t ii = 0; ii < mt_full; ++ii) {
-        for (int64_t jj = 0; jj < nt_full; ++jj) {
-            if (A11.tileIsLocal(ii, jj)) {
-
-                #pragma omp task shared(A11, A12, A21, A22, U1, U2, V1, V2) \
-                                 firstprivate(ii, jj) priority(1) \
-                                 depend(inout:task[ii*nt_full + jj])
-                {
-                    scalar_t dummy;
-
-                    A11.tileGetForWriting(ii, jj, LayoutConvert::None);
-                    U1.tileGetForReading(ii, 0, LayoutConvert::None);
-                    V1.tileGetForReading(jj, 0, LayoutConvert::None);
-                    Tile<scalar_t> a11 = A11(ii, jj);
-                    Tile<scalar_t> u1 = U1(ii, 0);
-                    Tile<scalar_t> v1 = V1(jj, 0);
-
-                    Tile<scalar_t> a12;
-                    Tile<scalar_t> a21;
-                    Tile<scalar_t> a22;
-                    Tile<scalar_t> u2;
-                    Tile<scalar_t> v2;
-
-                    if (ii < mt) {
-                        A21.tileGetForWriting(ii, jj, LayoutConvert::None);
-                        U2.tileGetForWriting(ii, 0, LayoutConvert::None);
-                        a21 = A21(ii, jj);
-                        u2 = U2(ii, 0);
-                    }
-                    else {
-                        a21 = Tile<scalar_t>(0, a11.nb(), &dummy, 0, HostNum,
-                                             TileKind::SlateOwned, Layout::ColMajor);
-                        u2  = Tile<scalar_t>(0, u1.nb(), &dummy, 0, HostNum,
-                                             TileKind::SlateOwned, Layout::ColMajor);
-                    }
-
-                    if (jj < nt) {
-                        A12.tileGetForWriting(ii, jj, LayoutConvert::None);
-                        V2.tileGetForWriting(jj, 0, LayoutConvert::None);
-                        a12 = A12(ii, jj);
-                        v2 = V2(jj, 0);
+    for (int64_t gi = 0; gi < gmt; ++gi) {
+        for (int64_t gj = 0; gj < gnt; ++gj) {
+            if (A.tileIsLocal( gi, gj ))
+                continue;
+            const int compute_rank = A.tileRank( gi, gj );
+            const int64_t rlen = gerbt_group_len( gi, mt, d, inner_len );
+            const int64_t clen = gerbt_group_len( gj, nt, d, inner_len );
+            for (int64_t r = 0; r < rlen; ++r) {
+                for (int64_t c = 0; c < clen; ++c) {
+                    const int64_t i = gi + r*inner_len;
+                    const int64_t j = gj + c*inner_len;
+                    if (A.tileIsLocal( i, j )) {
+                        MPI_Request req;
+                        A.tileIrecv( i, j, compute_rank, Layout::ColMajor,
+                                     i*nt + j, &req );
+                        requests.push_back( req );
                     }
-                    else {
-                        a12 = Tile<scalar_t>(a11.mb(), 0, &dummy, a11.mb(), HostNum,
-                                             TileKind::SlateOwned, Layout::ColMajor);
-                        v2  = Tile<scalar_t>(0, v1.nb(), &dummy, 0, HostNum,
-                                             TileKind::SlateOwned, Layout::ColMajor);
-                    }
-
-                    if (ii < mt && jj < nt) {
-                        A22.tileGetForWriting(ii, jj, LayoutConvert::None);
-                        a22 = A22(ii, jj);
-                    }
-                    else {
-                        a22 = Tile<scalar_t>(a21.mb(), a12.nb(), &dummy, a21.mb(), HostNum,
-                                             TileKind::SlateOwned, Layout::ColMajor);
-                    }
-                    gerbt( a11, a12, a21, a22, u1, u2, v1, v2 );
                 }
             }
         }
     }
 
-    for (int64_t ii = 0; ii < mt_full; ++ii) {
-        for (int64_t jj = 0; jj < nt_full; ++jj) {
-            MPI_Request r;
-            const int64_t tag = 4*(ii*nt_full + jj);
-            if (A11.tileIsLocal(ii, jj)) {
-                // Use undefered task as a selective barrier
-                // TODO change to taskwait depend(...) once OpenMP 5.0 supported
-                #pragma omp task if(false) depend(in:task[ii*nt_full + jj])
-                {}
-                if (jj < nt) {
-                    A12.tileIsend( ii, jj, A12.tileRank(ii, jj), tag+1, &r );
-                    if (r != MPI_REQUEST_NULL) {
-                        requests.push_back(r);
+    for (int64_t gi = 0; gi < gmt; ++gi) {
+        for (int64_t gj = 0; gj < gnt; ++gj) {
+            if (! A.tileIsLocal( gi, gj ))
+                continue;
+
+            #pragma omp task shared(A, U, V, gather) firstprivate(gi, gj) \
+                             priority(1)
+            {
+                std::vector<MPI_Request>& group_requests = gather[ gi*gnt + gj ];
+                slate_mpi_call(MPI_Waitall(group_requests.size(),
+                                           group_requests.data(),
+                                           MPI_STATUSES_IGNORE));
+                group_requests.clear();
+
+                const int64_t rlen = gerbt_group_len( gi, mt, d, inner_len );
+                const int64_t clen = gerbt_group_len( gj, nt, d, inner_len );
+                for (int64_t r = 0; r < rlen; ++r) {
+                    const int64_t i = gi + r*inner_len;
+                    U.tileGetForReading( i, 0, LayoutConvert::None );
+                    for (int64_t c = 0; c < clen; ++c) {
+                        const int64_t j = gj + c*inner_len;
+                        A.tileGetForWriting( i, j, LayoutConvert::None );
                     }
                 }
-                if (ii < mt) {
-                    A21.tileIsend( ii, jj, A21.tileRank(ii, jj), tag+2, &r );
-                    if (r != MPI_REQUEST_NULL) {
-                        requests.push_back(r);
-                    }
+                for (int64_t c = 0; c < clen; ++c) {
+                    V.tileGetForReading( gj + c*inner_len, 0, LayoutConvert::None );
                 }
-                if (ii < mt && jj < nt) {
-                    A22.tileIsend( ii, jj, A22.tileRank(ii, jj), tag+3, &r );
-                    if (r != MPI_REQUEST_NULL) {
-                        requests.push_back(r);
+
+                // 2-sided butterflies are applied smallest to largest.
+                // At level k, butterfly halves are 2^(d-k-1) group members long.
+                scalar_t dummy;
+                for (int64_t k = d-1; k >= 0; --k) {
+                    const int64_t half = int64_t(1) << (d-k-1);
+                    for (int64_t r = 0; r < rlen; ++r) {
+                        if (r % (2*half) >= half)
+                            continue;
+                        const int64_t i1 = gi + r*inner_len;
+                        const int64_t i2 = i1 + half*inner_len;
+                        const bool has_i2 = r + half < rlen;
+
+                        for (int64_t c = 0; c < clen; ++c) {
+                            if (c % (2*half) >= half)
+                                continue;
+                            const int64_t j1 = gj + c*inner_len;
+                            const int64_t j2 = j1 + half*inner_len;
+                            const bool has_j2 = c + half < clen;
+
+                            Tile<scalar_t> a11 = A( i1, j1 );
+                            Tile<scalar_t> u1 = U( i1, 0 );
+                            Tile<scalar_t> v1 = V( j1, 0 );
+
+                            Tile<scalar_t> a12;
+                            Tile<scalar_t> a21;
+                            Tile<scalar_t> a22;
+                            Tile<scalar_t> u2;
+                            Tile<scalar_t> v2;
+
+                            if (has_i2) {
+                                a21 = A( i2, j1 );
+                                u2 = U( i2, 0 );
+                            }
+                            else {
+                                a21 = Tile<scalar_t>(0, a11.nb(), &dummy, 0, HostNum,
+                                                     TileKind::SlateOwned, Layout::ColMajor);
+                                u2  = Tile<scalar_t>(0, u1.nb(), &dummy, 0, HostNum,
+                                                     TileKind::SlateOwned, Layout::ColMajor);
+                            }
+
+                            if (has_j2) {
+                                a12 = A( i1, j2 );
+                                v2 = V( j2, 0 );
+                            }
+                            else {
+                                a12 = Tile<scalar_t>(a11.mb(), 0, &dummy, a11.mb(), HostNum,
+                                                     TileKind::SlateOwned, Layout::ColMajor);
+                                v2  = Tile<scalar_t>(0, v1.nb(), &dummy, 0, HostNum,
+                                                     TileKind::SlateOwned, Layout::ColMajor);
+                            }
+
+                            if (has_i2 && has_j2) {
+                                a22 = A( i2, j2 );
+                            }
+                            else {
+                                a22 = Tile<scalar_t>(a21.mb(), a12.nb(), &dummy, a21.mb(), HostNum,
+                                                     TileKind::SlateOwned, Layout::ColMajor);
+                            }
+                            gerbt( a11, a12, a21, a22, u1, u2, v1, v2 );
+                        }
                     }
                 }
-            }
-            else {
-                const int64_t compute_rank = A11.tileRank(ii, jj);
-                if (jj < nt && A12.tileIsLocal(ii, jj)) {
-                    A12.tileIrecv( ii, jj, compute_rank, Layout::ColMajor,
-                                   tag+1, &r );
-                    requests.push_back(r);
-                }
-                if (ii < mt && A21.tileIsLocal(ii, jj)) {
-                    A21.tileIrecv( ii, jj, compute_rank, Layout::ColMajor,
-                                   tag+2, &r );
-                    requests.push_back(r);
-                }
-                if (ii < mt && jj < nt && A22.tileIsLocal(ii, jj)) {
-                    A22.tileIrecv( ii, jj, compute_rank, Layout::ColMajor,
-                                   tag+3, &r );
-                    requests.push_back(r);
+
+                // Send the transformed tiles back to their owners.
+                for (int64_t r = 0; r < rlen; ++r) {
+                    for (int64_t c = 0; c < clen; ++c) {
+                        const int64_t i = gi + r*inner_len;
+                        const int64_t j = gj + c*inner_len;
+                        MPI_Request req;
+                        A.tileIsend( i, j, A.tileRank( i, j ), i*nt + j, &req );
+                        if (req != MPI_REQUEST_NULL) {
+                            group_requests.push_back( req );
+                        }
+                    }
                 }
+                slate_mpi_call(MPI_Waitall(group_requests.size(),
+                                           group_requests.data(),
+                                           MPI_STATUSES_IGNORE));
             }
         }
     }
 
+    // Groups block on MPI; run them before waiting on this rank's tiles,
+    // in case the master is the only thread.
+    #pragma omp taskwait
     slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
                                MPI_STATUSES_IGNORE));
-    #pragma omp taskwait
 
-    A12.releaseRemoteWorkspace();
-    A21.releaseRemoteWorkspace();
-    A22.releaseRemoteWorkspace();
+    A.releaseRemoteWorkspace();
 }
 
 template
-void gerbt(Matrix<float>,
-           Matrix<float>,
-           Matrix<float>,
-           Matrix<float>,
-           Matrix<float>,
+void gerbt(int64_t,
            Matrix<float>,
            Matrix<float>,
            Matrix<float>);
 
 template
-void gerbt(Matrix<double>,
-           Matrix<double>,
-           Matrix<double>,
-           Matrix<double>,
-           Matrix<double>,
+void gerbt(int64_t,
            Matrix<double>,
            Matrix<double>,
            Matrix<double>);
 
 template
-void gerbt(Matrix<std::complex<float>>,
-           Matrix<std::complex<float>>,
-           Matrix<std::complex<float>>,
-           Matrix<std::complex<float>>,
-           Matrix<std::complex<float>>,
+void gerbt(int64_t,
            Matrix<std::complex<float>>,
            Matrix<std::complex<float>>,
            Matrix<std::complex<float>>);
 
 template
-void gerbt(Matrix<std::complex<double>>,
-           Matrix<std::complex<double>>,
-           Matrix<std::complex<double>>,
-           Matrix<std::complex<double>>,
-           Matrix<std::complex<double>>,
+void gerbt(int64_t,
            Matrix<std::complex<double>>,
            Matrix<std::complex<double>>,
            Matrix<std::complex<double>>);
 
 //------------------------------------------------------------------------------
-/// Applies a single butterfly matrix to one side of B.  The matrices are
-/// divided into the submatrices along the half of the butterfly matrix.
+/// Applies all d levels of a 1-sided butterfly transform to the left of B,
+/// op(U) B.
+///
+/// As in the 2-sided case, B splits into independent groups of up to 2^d
+/// tiles, B( gi + r*inner_len, j ), for 0 <= gi < inner_len, each of which
+/// is gathered once to the rank owning B(gi, j), transformed through all
+/// levels, and sent back.
+///
+/// Rows U(i, 0) must be available on the ranks owning B(i % inner_len, :).
+///
+/// @param[in] trans
+///     Whether to apply U or U^T.
+///
+/// @param[in] inner_len
+///     ceil( mt / 2^d ), the length of the smallest butterfly halves, in tiles.
+///
+/// @param[in, out] B
+///     The matrix to transform.
+///
+/// @param[in] U
+///     The transform, in packed, non-transposed storage, with d columns.
 ///
 /// @ingroup gesv_internal
 ///
 template<typename scalar_t>
-void gerbt(Side side,
-           Op trans,
-           Matrix<scalar_t> B1,
-           Matrix<scalar_t> B2,
-           Matrix<scalar_t> U1,
-           Matrix<scalar_t> U2)
+void gerbt(Op trans,
+           int64_t inner_len,
+           Matrix<scalar_t> B,
+           Matrix<scalar_t> U)
 {
-    slate_assert(B1.mt() >= B2.mt());
-    slate_assert(B1.nt() >= B2.nt());
-    const int64_t mt      = B2.mt();
-    const int64_t mt_full = B1.mt();
-    const int64_t nt      = B2.nt();
-    const int64_t nt_full = B1.nt();
-    const bool leftp = side == Side::Left;
+    const int64_t d = U.n();
+    const int64_t mt = B.mt();
+    const int64_t nt = B.nt();
+    const int64_t gmt = std::min( inner_len, mt );
     const bool transp = trans == Op::Trans;
 
-    // Used to manage OpenMP task dependencies
-    std::vector<uint8_t> task_vect (mt_full*nt_full);
-    uint8_t* task = task_vect.data();
-    SLATE_UNUSED( task ); // Used only by OpenMP
-
+    // Gather each group to the owner of its leading tile.
+    std::vector< std::vector<MPI_Request> > gather( gmt*nt );
     std::vector<MPI_Request> requests;
-    for (int64_t ii = 0; ii < mt; ++ii) {
-        for (int64_t jj = 0; jj < nt; ++jj) {
-            const int64_t tag = ii*nt + jj;
-            MPI_Request r;
-            if (B1.tileIsLocal(ii, jj)) {
-                B2.tileIrecv( ii, jj, B2.tileRank(ii, jj),
-                              Layout::ColMajor, tag, &r );
-                if (r != MPI_REQUEST_NULL) {
-                    requests.push_back(r);
+    for (int64_t gi = 0; gi < gmt; ++gi) {
+        const int64_t rlen = gerbt_group_len( gi, mt, d, inner_len );
+        for (int64_t j = 0; j < nt; ++j) {
+            const int compute_rank = B.tileRank( gi, j );
+            for (int64_t r = 0; r < rlen; ++r) {
+                const int64_t i = gi + r*inner_len;
+                const int64_t tag = i*nt + j;
+                MPI_Request req;
+                if (B.tileIsLocal( gi, j )) {
+                    B.tileIrecv( i, j, B.tileRank( i, j ),
+                                 Layout::ColMajor, tag, &req );
+                    if (req != MPI_REQUEST_NULL) {
+                        gather[ gi*nt + j ].push_back( req );
+                    }
+                }
+                else if (B.tileIsLocal( i, j )) {
+                    B.tileIsend( i, j, compute_rank, tag, &req );
+                    requests.push_back( req );
                 }
-            }
-            else if (B2.tileIsLocal(ii, jj)) {
-                const int64_t compute_rank = B1.tileRank(ii, jj);
-                B2.tileIsend( ii, jj, compute_rank, tag, &r );
-                MPI_Request_free(&r);
             }
         }
     }
+    // Tiles sent away are received back below, so wait for the sends first.
     slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
                                MPI_STATUSES_IGNORE));
     requests.clear();
 
-    for (int64_t ii = 0; ii < mt; ++ii) {
-        for (int64_t jj = 0; jj < nt; ++jj) {
-            if (B1.tileIsLocal(ii, jj)) {
-                #pragma omp task shared(B1, B2, U1, U2) firstprivate(ii, jj) \
-                                 priority(1) depend(inout:task[ii*nt_full + jj])
-                {
-                    B1.tileGetForWriting(ii, jj, LayoutConvert::None);
-                    B2.tileGetForWriting(ii, jj, LayoutConvert::None);
-                    U1.tileGetForReading(ii, 0, LayoutConvert::None);
-                    U2.tileGetForReading(ii, 0, LayoutConvert::None);
-
-                    if (leftp) {
-                        if (transp) {
-                            gerbt_left_trans( B1(ii, jj),
-                                              B2(ii, jj),
-                                              U1(ii, 0),
-                                              U2(ii, 0) );
-                        }
-                        else {
-                            gerbt_left_notrans( B1(ii, jj),
-                                                B2(ii, jj),
-                                                U1(ii, 0),
-                                                U2(ii, 0) );
-                        }
-                    }
-                    else {
-                        if (transp) {
-                            gerbt_right_trans( B1(ii, jj),
-                                               B2(ii, jj),
-                                               U1(jj, 0),
-                                               U2(jj, 0) );
-                        }
-                        else {
-                            gerbt_right_notrans( B1(ii, jj),
-                                                 B2(ii, jj),
-                                                 U1(jj, 0),
-                                                 U2(jj, 0) );
-                        }
-                    }
+    for (int64_t gi = 0; gi < gmt; ++gi) {
+        const int64_t rlen = gerbt_group_len( gi, mt, d, inner_len );
+        for (int64_t j = 0; j < nt; ++j) {
+            if (B.tileIsLocal( gi, j ))
+                continue;
+            const int compute_rank = B.tileRank( gi, j );
+            for (int64_t r = 0; r < rlen; ++r) {
+                const int64_t i = gi + r*inner_len;
+                if (B.tileIsLocal( i, j )) {
+                    MPI_Request req;
+                    B.tileIrecv( i, j, compute_rank, Layout::ColMajor,
+                                 i*nt + j, &req );
+                    requests.push_back( req );
                 }
             }
         }
     }
-    if (leftp) {
-        for (int64_t ii = mt; ii < mt_full; ++ii) {
-            for (int64_t jj = 0; jj < nt; ++jj) {
-                if (B1.tileIsLocal(ii, jj)) {
-                    #pragma omp task shared(B1, U1) firstprivate(ii, jj) \
-                                     priority(1) depend(inout:task[ii*nt_full + jj])
-                    {
-                        scalar_t dummy;
-
-                        B1.tileGetForWriting(ii, jj, LayoutConvert::None);
-                        U1.tileGetForReading(ii, 0, LayoutConvert::None);
-
-                        Tile<scalar_t> b1 = B1(ii, jj);
-                        Tile<scalar_t> b2 (0, b1.nb(), &dummy, 0, 0,
-                                           TileKind::SlateOwned, Layout::ColMajor);
-                        Tile<scalar_t> u1 = U1(ii, 0);
-                        Tile<scalar_t> u2 (0, u1.nb(), &dummy, 0, 0,
-                                            TileKind::SlateOwned, Layout::ColMajor);
 
-                        if (transp) {
-                            gerbt_left_trans( b1, b2, u1, u2 );
+    for (int64_t gi = 0; gi < gmt; ++gi) {
+        for (int64_t j = 0; j < nt; ++j) {
+            if (! B.tileIsLocal( gi, j ))
+                continue;
+
+            #pragma omp task shared(B, U, gather) firstprivate(gi, j) \
+                             priority(1)
+            {
+                std::vector<MPI_Request>& group_requests = gather[ gi*nt + j ];
+                slate_mpi_call(MPI_Waitall(group_requests.size(),
+                                           group_requests.data(),
+                                           MPI_STATUSES_IGNORE));
+                group_requests.clear();
+
+                const int64_t rlen = gerbt_group_len( gi, mt, d, inner_len );
+                for (int64_t r = 0; r < rlen; ++r) {
+                    const int64_t i = gi + r*inner_len;
+                    B.tileGetForWriting( i, j, LayoutConvert::None );
+                    U.tileGetForReading( i, 0, LayoutConvert::None );
+                }
+
+                scalar_t dummy;
+                for (int64_t k_iter = 0; k_iter < d; ++k_iter) {
+                    // Regular butterflies are applied largest to smallest
+                    // Transposed butterflies are applied smallest to largest
+                    const int64_t k = transp ? d-k_iter-1 : k_iter;
+                    const int64_t half = int64_t(1) << (d-k-1);
+                    for (int64_t r = 0; r < rlen; ++r) {
+                        if (r % (2*half) >= half)
+                            continue;
+                        const int64_t i1 = gi + r*inner_len;
+                        const int64_t i2 = i1 + half*inner_len;
+
+                        Tile<scalar_t> b1 = B( i1, j );
+                        Tile<scalar_t> u1 = U( i1, 0 );
+                        Tile<scalar_t> b2;
+                        Tile<scalar_t> u2;
+                        if (r + half < rlen) {
+                            b2 = B( i2, j );
+                            u2 = U( i2, 0 );
                         }
                         else {
-                            gerbt_left_notrans( b1, b2, u1, u2 );
+                            b2 = Tile<scalar_t>(0, b1.nb(), &dummy, 0, HostNum,
+                                                TileKind::SlateOwned, Layout::ColMajor);
+                            u2 = Tile<scalar_t>(0, u1.nb(), &dummy, 0, HostNum,
+                                                TileKind::SlateOwned, Layout::ColMajor);
                         }
-                    }
-                }
-            }
-        }
-    }
-    else {
-        for (int64_t ii = 0; ii < mt; ++ii) {
-            for (int64_t jj = nt; jj < nt_full; ++jj) {
-                if (B1.tileIsLocal(ii, jj)) {
-                    #pragma omp task shared(B1, U1) firstprivate(ii, jj) \
-                                     priority(1) depend(inout:task[ii*nt_full + jj])
-                    {
-                        scalar_t dummy;
-
-                        B1.tileGetForWriting(ii, jj, LayoutConvert::None);
-                        U1.tileGetForReading(ii, 0, LayoutConvert::None);
-
-                        Tile<scalar_t> b1 = B1(ii, jj);
-                        Tile<scalar_t> b2 (b1.mb(), 0, &dummy, b1.mb(), 0,
-                                           TileKind::SlateOwned, Layout::ColMajor);
-                        Tile<scalar_t> u1 = U1(jj, 0);
-                        Tile<scalar_t> u2 (0, u1.nb(), &dummy, 0, 0,
-                                            TileKind::SlateOwned, Layout::ColMajor);
 
                         if (transp) {
-                            gerbt_right_trans( b1, b2, u1, u2 );
+                            gerbt_left_trans( b1, b2, u1, u2 );
                         }
                         else {
-                            gerbt_right_notrans( b1, b2, u1, u2 );
+                            gerbt_left_notrans( b1, b2, u1, u2 );
                         }
                     }
                 }
-            }
-        }
-    }
 
-    for (int64_t ii = 0; ii < mt; ++ii) {
-        for (int64_t jj = 0; jj < nt; ++jj) {
-            const int64_t tag = ii*nt + jj;
-            MPI_Request r = MPI_REQUEST_NULL;
-            if (B1.tileIsLocal(ii, jj)) {
-                // Use undefered task as a selective barrier
-                #pragma omp task if(false) depend(in:task[ii*nt_full + jj])
-                {}
-                B2.tileIsend( ii, jj, B2.tileRank(ii, jj), tag, &r );
-                if (r != MPI_REQUEST_NULL) {
-                    requests.push_back(r);
+                // Send the transformed tiles back to their owners.
+                for (int64_t r = 0; r < rlen; ++r) {
+                    const int64_t i = gi + r*inner_len;
+                    MPI_Request req;
+                    B.tileIsend( i, j, B.tileRank( i, j ), i*nt + j, &req );
+                    if (req != MPI_REQUEST_NULL) {
+                        group_requests.push_back( req );
+                    }
                 }
-            }
-            else if (B2.tileIsLocal(ii, jj)) {
-                const int64_t compute_rank = B1.tileRank(ii, jj);
-                B2.tileIrecv( ii, jj, compute_rank, Layout::ColMajor, tag, &r );
-                requests.push_back(r);
+                slate_mpi_call(MPI_Waitall(group_requests.size(),
+                                           group_requests.data(),
+                                           MPI_STATUSES_IGNORE));
             }
         }
     }
 
+    // Groups block on MPI; run them before waiting on this rank's tiles,
+    // in case the master is the only thread.
+    #pragma omp taskwait
     slate_mpi_call(MPI_Waitall(requests.size(), requests.data(),
                                MPI_STATUSES_IGNORE));
-    #pragma omp taskwait
-    B1.releaseRemoteWorkspace();
+
+    B.releaseRemoteWorkspace();
 }
 
 template
-void gerbt(Side,
-           Op,
-           Matrix<float>,
-           Matrix<float>,
+void gerbt(Op,
+           int64_t,
            Matrix<float>,
            Matrix<float>);
 
 template
-void gerbt(Side,
-           Op,
-           Matrix<double>,
-           Matrix<double>,
+void gerbt(Op,
+           int64_t,
            Matrix<double>,
            Matrix<double>);
 
 template
-void gerbt(Side,
-           Op,
-           Matrix<std::complex<float>>,
-           Matrix<std::complex<float>>,
+void gerbt(Op,
+           int64_t,
            Matrix<std::complex<float>>,
            Matrix<std::complex<float>>);
 
 template
-void gerbt(Side,
-           Op,
-           Matrix<std::complex<double>>,
-           Matrix<std::complex<double>>,
+void gerbt(Op,
+           int64_t,
            Matrix<std::complex<double>>,
            Matrix<std::complex<double>>);
 
-
 } // namespace internal
 
 } // namespace slate
@@ -77,6 +77,7 @@ void scale(internal::TargetType<Target::HostBatch>,
 
 //------------------------------------------------------------------------------
 /// Scale matrix entries by the real scalar numer/denom.
+/// Tiles are scaled in their current layout, without conversion.
 /// TODO handle transpose A case
 /// GPU device implementation.
 /// @ingroup scale_internal
@@ -93,12 +94,9 @@ void scale(internal::TargetType<Target::Devices>,
         #pragma omp task slate_omp_default_none priority( priority ) \
             shared( A ) firstprivate( device, queue_index, denom, numer )
         {
-            // temporarily, convert both into same layout
-            // todo: this is in-efficient, because both matrices may have same layout already
-            //       and possibly wrong, because an input matrix is being altered
-            // todo: best, handle directly through the CUDA kernels
-            auto layout = LayoutConvert::ColMajor;
-            std::set<ij_tuple> A_tiles_set;
+            // Scaling by a scalar is elementwise, so tiles are scaled in
+            // whichever layout they are in, without converting them.
+            TileSet A_tiles_set;
 
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
@@ -107,13 +105,48 @@ void scale(internal::TargetType<Target::Devices>,
                     }
                 }
             }
-            A.tileGetForWriting( A_tiles_set, device, layout );
+            A.tileGetForWriting( A_tiles_set, device, LayoutConvert::None );
+
+            bool all_col_major = true;
+            for (auto ij : A_tiles_set) {
+                int64_t i = std::get<0>( ij );
+                int64_t j = std::get<1>( ij );
+                if (A( i, j, device ).layout() != Layout::ColMajor) {
+                    all_col_major = false;
+                    break;
+                }
+            }
 
             int64_t batch_size = A_tiles_set.size();
             scalar_t** a_array_host = A.array_host( device, queue_index );
 
-            auto group_params = device_regions_build<false, 1, scalar_t>(
-                    {A}, {a_array_host}, device );
+            std::vector< device_regions_params<false, 1> > group_params;
+            std::vector<int64_t> dims;
+            int64_t max_m = 0;
+            if (all_col_major) {
+                group_params = device_regions_build<false, 1, scalar_t>(
+                        {A}, {a_array_host}, device );
+                if (group_params.size() > 1)
+                    max_m = device_regions_vbatch_dims( group_params, dims );
+            }
+            else {
+                // A RowMajor tile is scaled as its ColMajor transpose,
+                // with m and n swapped; one variable-size launch covers all.
+                dims.resize( 3*batch_size );
+                int64_t k = 0;
+                for (auto ij : A_tiles_set) {
+                    int64_t i = std::get<0>( ij );
+                    int64_t j = std::get<1>( ij );
+                    auto T = A( i, j, device );
+                    bool row_major = T.layout() == Layout::RowMajor;
+                    a_array_host[ k ] = T.data();
+                    dims[ k ]                = row_major ? T.nb() : T.mb();
+                    dims[ k +   batch_size ] = row_major ? T.mb() : T.nb();
+                    dims[ k + 2*batch_size ] = T.stride();
+                    max_m = std::max( max_m, dims[ k ] );
+                    ++k;
+                }
+            }
 
             blas::Queue* queue = A.compute_queue( device, queue_index );
 
@@ -122,13 +155,29 @@ void scale(internal::TargetType<Target::Devices>,
                 a_array_dev, a_array_host, batch_size,
                 blas::MemcpyKind::HostToDevice, *queue);
 
-            for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
+            if (all_col_major && group_params.size() == 1) {
                 device::batch::gescale(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        numer, denom, a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue);
-                a_array_dev += group_count;
+                        group_params[ 0 ].mb, group_params[ 0 ].nb,
+                        numer, denom, a_array_dev, group_params[ 0 ].ld[0],
+                        group_params[ 0 ].count, *queue);
+            }
+            else if (! dims.empty()) {
+                // Edge tiles or mixed layouts: one variable-size launch.
+                int64_t dims_size = ceildiv( int64_t( dims.size()*sizeof(int64_t) ),
+                                             int64_t( sizeof(scalar_t) ) );
+                int64_t* dims_dev = reinterpret_cast<int64_t*>(
+                    A.allocWorkspaceBuffer( device, dims_size ) );
+                blas::device_memcpy<int64_t>(
+                    dims_dev, dims.data(), dims.size(),
+                    blas::MemcpyKind::HostToDevice, *queue);
+
+                device::gescale_vbatch(
+                        &dims_dev[ 0 ], &dims_dev[ batch_size ],
+                        numer, denom, a_array_dev, &dims_dev[ 2*batch_size ],
+                        max_m, batch_size, *queue);
+
+                queue->sync();
+                A.freeWorkspaceBuffer( device, reinterpret_cast<scalar_t*>( dims_dev ) );
             }
 
             queue->sync();
@@ -13,6 +13,9 @@
 #include "slate/types.hh"
 #include "tile/scale_row_col.hh"
 
+#include <map>
+#include <tuple>
+
 namespace slate {
 
 namespace internal {
@@ -54,6 +57,7 @@ void scale_row_col(
 
 //------------------------------------------------------------------------------
 /// Apply row or column scaling, or both, to a Matrix.
+/// Tiles are scaled in their current layout, without conversion.
 /// TODO handle transpose A case
 /// GPU device implementation.
 /// @ingroup scale_internal
@@ -86,15 +90,17 @@ void scale_row_col(
             if (want_row) {
                 dR.resize( R.size(), device, *queue );
                 blas::device_memcpy( dR.data(), R.data(), R.size(), *queue );
-                r_array_host.resize( A.batchArraySize() );
-                r_array_dev .resize( A.batchArraySize(), device, *queue );
             }
             if (want_col) {
                 dC.resize( C.size(), device, *queue );
                 blas::device_memcpy( dC.data(), C.data(), C.size(), *queue );
-                c_array_host.resize( A.batchArraySize() );
-                c_array_dev .resize( A.batchArraySize(), device, *queue );
             }
+            // Both pointer arrays are needed, since RowMajor tiles swap
+            // the roles of R and C.
+            r_array_host.resize( A.batchArraySize() );
+            r_array_dev .resize( A.batchArraySize(), device, *queue );
+            c_array_host.resize( A.batchArraySize() );
+            c_array_dev .resize( A.batchArraySize(), device, *queue );
 
             std::vector< int64_t > ioffsets, joffsets;
             if (want_row) {
@@ -104,12 +110,10 @@ void scale_row_col(
                 joffsets = tile_offsets( RowCol::Col, A );
             }
 
-            // temporarily, convert both into same layout
-            // todo: this is in-efficient, because both matrices may have same layout already
-            //       and possibly wrong, because an input matrix is being altered
-            // todo: best, handle directly through the CUDA kernels
-            auto layout = LayoutConvert( Layout::ColMajor );
-            std::set<ij_tuple> A_tiles_set;
+            // Tiles are scaled in whichever layout they are in, without
+            // converting them. A RowMajor tile is scaled as its ColMajor
+            // transpose: m and n swapped, and R and C swapped.
+            TileSet A_tiles_set;
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
                     if (A.tileIsLocal(i, j) && device == A.tileDevice(i, j)) {
@@ -117,51 +121,73 @@ void scale_row_col(
                     }
                 }
             }
-            A.tileGetForWriting( A_tiles_set, device, layout );
+            A.tileGetForWriting( A_tiles_set, device, LayoutConvert::None );
+
+            // Group tiles by (layout, m, n, ld) as the kernel sees them.
+            using group_key = std::tuple< Layout, int64_t, int64_t, int64_t >;
+            using tile_ptrs = std::tuple< scalar_t*, scalar_t2*, scalar_t2* >;
+            std::map< group_key, std::vector< tile_ptrs > > groups;
+            for (auto ij : A_tiles_set) {
+                int64_t i = std::get<0>( ij );
+                int64_t j = std::get<1>( ij );
+                auto T = A( i, j, device );
+                scalar_t2* r = want_row ? &dR[ ioffsets[ i ] ] : nullptr;
+                scalar_t2* c = want_col ? &dC[ joffsets[ j ] ] : nullptr;
+                if (T.layout() == Layout::ColMajor) {
+                    groups[ { Layout::ColMajor, T.mb(), T.nb(), T.stride() } ]
+                        .push_back( { T.data(), r, c } );
+                }
+                else {
+                    groups[ { Layout::RowMajor, T.nb(), T.mb(), T.stride() } ]
+                        .push_back( { T.data(), c, r } );
+                }
+            }
 
             scalar_t** a_array_host = A.array_host( device, queue_index );
 
             int64_t batch_count = 0;
-            std::function<void(int64_t, int64_t, int64_t)>
-            store_rc = [&](int64_t group, int64_t i, int64_t j) {
-                    if (want_row)
-                        r_array_host[ batch_count ] = &dR[ ioffsets[ i ] ];
-                    if (want_col)
-                        c_array_host[ batch_count ] = &dC[ joffsets[ j ] ];
+            for (auto& group : groups) {
+                for (auto& ptrs : group.second) {
+                    a_array_host[ batch_count ] = std::get<0>( ptrs );
+                    r_array_host[ batch_count ] = std::get<1>( ptrs );
+                    c_array_host[ batch_count ] = std::get<2>( ptrs );
                     ++batch_count;
-            };
-            auto group_params = device_regions_build<false, 1, scalar_t>(
-                    {A}, {a_array_host}, device, store_rc );
-
+                }
+            }
 
             scalar_t** a_array_dev = A.array_device( device, queue_index );
 
             blas::device_memcpy< scalar_t* >(
                 &a_array_dev[ 0 ], &a_array_host[ 0 ], batch_count, *queue);
 
-            if (want_row) {
-                blas::device_memcpy< scalar_t2* >(
-                    &r_array_dev[ 0 ], &r_array_host[ 0 ], batch_count, *queue);
-            }
-
-            if (want_col) {
-                blas::device_memcpy< scalar_t2* >(
-                    &c_array_dev[ 0 ], &c_array_host[ 0 ], batch_count, *queue);
-            }
+            blas::device_memcpy< scalar_t2* >(
+                &r_array_dev[ 0 ], &r_array_host[ 0 ], batch_count, *queue);
+            blas::device_memcpy< scalar_t2* >(
+                &c_array_dev[ 0 ], &c_array_host[ 0 ], batch_count, *queue);
 
-            // r_array_data, c_array_data may be null, in which case
-            // they are incremented below but never dereferenced in
-            // gescale_row_col_batch.
+            // Entries of r_array_data, c_array_data may be null when
+            // equed doesn't use them; gescale_row_col_batch doesn't
+            // dereference those.
             scalar_t2** r_array_data = r_array_dev.data();
             scalar_t2** c_array_data = c_array_dev.data();
 
-            for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
+            for (auto& group : groups) {
+                Layout layout = std::get<0>( group.first );
+                int64_t mb    = std::get<1>( group.first );
+                int64_t nb    = std::get<2>( group.first );
+                int64_t lda   = std::get<3>( group.first );
+                int64_t group_count = group.second.size();
+                Equed group_equed = equed;
+                if (layout == Layout::RowMajor) {
+                    if (equed == Equed::Row)
+                        group_equed = Equed::Col;
+                    else if (equed == Equed::Col)
+                        group_equed = Equed::Row;
+                }
                 device::gescale_row_col_batch(
-                        equed,
-                        group_params[ g ].mb, group_params[ g ].nb,
+                        group_equed, mb, nb,
                         r_array_data, c_array_data,
-                        a_array_dev, group_params[ g ].ld[0],
+                        a_array_dev, lda,
                         group_count, *queue);
                 r_array_data += group_count;
                 c_array_data += group_count;
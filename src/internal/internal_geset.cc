@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/internal/device.hh"
+#include "slate/internal/DeviceGraph.hh"
 #include "internal/internal_batch.hh"
 #include "internal/internal.hh"
 #include "slate/internal/util.hh"
@@ -11,9 +12,38 @@
 #include "internal/Tile_lapack.hh"
 #include "slate/types.hh"
 
+#include <typeinfo>
+
 namespace slate {
 namespace internal {
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// Records the structure of tile A(i, j) after set wrote it:
+/// Zero, Identity for a square diagonal tile, otherwise Dense.
+///
+template <typename scalar_t>
+void set_tile_structure(
+    scalar_t offdiag_value, scalar_t diag_value, Matrix<scalar_t>& A,
+    int64_t i, int64_t j)
+{
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    TileStructure structure = TileStructure::Dense;
+    if (offdiag_value == zero) {
+        scalar_t value = (i == j ? diag_value : offdiag_value);
+        if (value == zero)
+            structure = TileStructure::Zero;
+        else if (value == one && A.tileMb( i ) == A.tileNb( j ))
+            structure = TileStructure::Identity;
+    }
+    A.tileStructure( i, j, structure );
+}
+
+} // namespace
+
 //------------------------------------------------------------------------------
 /// General matrix set.
 /// Dispatches to target implementations.
@@ -54,6 +84,7 @@ void set(
                         A.at(i, j).set( offdiag_value, diag_value );
                     else
                         A.at(i, j).set( offdiag_value, offdiag_value );
+                    set_tile_structure( offdiag_value, diag_value, A, i, j );
                 }
             }
         }
@@ -102,7 +133,7 @@ void set(internal::TargetType<Target::Devices>,
             // todo: this is in-efficient because the diagonal is independant of layout
             // todo: best, handle directly through the CUDA kernels
             auto layout = LayoutConvert::ColMajor;
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
@@ -132,25 +163,53 @@ void set(internal::TargetType<Target::Devices>,
                 a_array_dev, a_array_host, batch_size,
                 blas::MemcpyKind::HostToDevice, *queue);
 
-            for (size_t g = 0; g < group_params.size(); ++g) {
-                int64_t group_count = group_params[ g ].count;
-                if (group_params[ g ].is_diagonal) {
+            if (group_params.size() == 1) {
+                scalar_t group_diag_value = group_params[ 0 ].is_diagonal
+                                          ? diag_value : offdiag_value;
+                // Replayed from a graph if gpu_graphs.
+                auto key = device_graph_key(
+                    "geset", typeid( scalar_t ).hash_code(),
+                    group_params[ 0 ].mb, group_params[ 0 ].nb,
+                    offdiag_value, group_diag_value,
+                    a_array_dev, group_params[ 0 ].ld[0],
+                    group_params[ 0 ].count );
+                device_graph_run( *queue, key, [&]() {
                     device::batch::geset(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        offdiag_value, diag_value,
-                        a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue );
-                }
-                else {
-                    device::batch::geset(
-                        group_params[ g ].mb, group_params[ g ].nb,
-                        offdiag_value, offdiag_value,
-                        a_array_dev, group_params[ g ].ld[0],
-                        group_count, *queue );
-                }
-                a_array_dev += group_count;
+                        group_params[ 0 ].mb, group_params[ 0 ].nb,
+                        offdiag_value, group_diag_value,
+                        a_array_dev, group_params[ 0 ].ld[0],
+                        group_params[ 0 ].count, *queue );
+                });
+            }
+            else if (group_params.size() > 1) {
+                // Edge and diagonal tiles: one variable-size launch
+                // for all regions.
+                std::vector<int64_t> dims;
+                int64_t max_m = device_regions_vbatch_dims( group_params, dims );
+                int64_t dims_size = ceildiv( int64_t( dims.size()*sizeof(int64_t) ),
+                                             int64_t( sizeof(scalar_t) ) );
+                int64_t* dims_dev = reinterpret_cast<int64_t*>(
+                    A.allocWorkspaceBuffer( device, dims_size ) );
+                blas::device_memcpy<int64_t>(
+                    dims_dev, dims.data(), dims.size(),
+                    blas::MemcpyKind::HostToDevice, *queue);
+
+                device::geset_vbatch(
+                    &dims_dev[ 0 ], &dims_dev[ batch_size ],
+                    offdiag_value, diag_value,
+                    a_array_dev, &dims_dev[ 2*batch_size ],
+                    &dims_dev[ 3*batch_size ],
+                    max_m, batch_size, *queue );
+
+                queue->sync();
+                A.freeWorkspaceBuffer( device, reinterpret_cast<scalar_t*>( dims_dev ) );
             }
             queue->sync();
+
+            for (auto ij : A_tiles_set) {
+                set_tile_structure( offdiag_value, diag_value, A,
+                                    std::get<0>( ij ), std::get<1>( ij ) );
+            }
         } // end task
     } // end for dev
 }
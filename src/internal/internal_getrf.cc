@@ -6,8 +6,15 @@
 #include "slate/Matrix.hh"
 #include "slate/HermitianMatrix.hh"
 #include "slate/types.hh"
+#include "slate/FlopStats.hh"
 #include "internal/Tile_getrf.hh"
 #include "internal/internal.hh"
+#include "slate/internal/PanelThreadPool.hh"
+#include "slate/internal/device.hh"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace slate {
 
@@ -20,7 +27,9 @@ namespace internal {
 template <typename scalar_t>
 void getrf_panel(
     internal::TargetType<Target::HostTask>,
-    Matrix<scalar_t>& A, int64_t diag_len, int64_t ib,
+    Matrix<scalar_t>& A,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     blas::real_type<scalar_t> pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info )
@@ -31,7 +40,7 @@ void getrf_panel(
     *info = 0;
 
     // Move the panel to the host.
-    std::set<ij_tuple> A_tiles_set;
+    TileSet A_tiles_set;
     for (int64_t i = 0; i < A.mt(); ++i) {
         if (A.tileIsLocal(i, 0)) {
             A_tiles_set.insert({i, 0});
@@ -57,7 +66,7 @@ void getrf_panel(
     // If participating in the panel factorization.
     if (ranks_set.find( A.mpiRank() ) != ranks_set.end()) {
 
-        // Create the broadcast communicator.
+        // Get the broadcast communicator, cached by the matrix.
         // Translate the root rank.
         int bcast_rank;
         int bcast_root;
@@ -65,9 +74,9 @@ void getrf_panel(
         bcast_comm = commFromSet(ranks_set,
                                  A.mpiComm(), A.mpiGroup(),
                                  A.tileRank(0, 0), bcast_root,
-                                 tag);
+                                 tag, A.commCache());
         // Find the local rank.
-        MPI_Comm_rank(bcast_comm, &bcast_rank);
+        slate_mpi_call( MPI_Comm_rank(bcast_comm, &bcast_rank) );
 
         // Launch the panel tasks.
         int thread_size = max_panel_threads;
@@ -81,24 +90,9 @@ void getrf_panel(
         std::vector<scalar_t> top_block(ib*A.tileNb(0));
         std::vector< AuxPivot<scalar_t> > aux_pivot(diag_len);
 
-        #if 1
-            // Launching new threads for the panel guarantees progression.
-            // This should never deadlock, but may be detrimental to performance.
-            #pragma omp parallel for num_threads( thread_size ) slate_omp_default_none \
-                shared( thread_barrier, max_value, max_index, max_offset ) \
-                shared( top_block, aux_pivot, tiles, bcast_comm, info ) \
-                firstprivate( tile_indices, bcast_root, bcast_rank, ib, \
-                              diag_len, thread_size, pivot_threshold )
-        #else
-            // Issuing panel operation as tasks may cause a deadlock.
-            #pragma omp taskloop num_tasks(thread_size) slate_omp_default_none \
-                shared( thread_barrier, max_value, max_index, max_offset ) \
-                shared( top_block, aux_pivot, tiles, bcast_comm, info ) \
-                firstprivate( tile_indices, bcast_root, bcast_rank, ib, \
-                              diag_len, thread_size, pivot_threshold )
-        #endif
-        for (int thread_rank = 0; thread_rank < thread_size; ++thread_rank) {
-            // Factor the panel in parallel.
+        // Factor the panel in parallel, in the panel thread pool or in
+        // new threads; either guarantees progression.
+        panel_parallel( thread_size, [&]( int thread_rank ) {
             tile::getrf( diag_len, ib,
                          tiles, tile_indices,
                          aux_pivot,
@@ -107,16 +101,374 @@ void getrf_panel(
                          thread_barrier,
                          max_value, max_index, max_offset, top_block,
                          pivot_threshold, info );
-        }
+        } );
 
         // Copy pivot information from aux_pivot to pivot.
         for (int64_t i = 0; i < diag_len; ++i) {
             pivot[i] = Pivot(aux_pivot[i].tileIndex(),
                              aux_pivot[i].elementOffset());
         }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Swaps row dA[ 0, 0 : n-1 ], with stride lda in GPU memory, with another
+/// MPI process, staging it through host memory.
+///
+template <typename scalar_t>
+void getrf_swap_remote_row_device(
+    int64_t n, scalar_t* dA, int64_t lda,
+    int other_rank, MPI_Comm mpi_comm, blas::Queue& queue )
+{
+    std::vector<scalar_t> local_row( n );
+    std::vector<scalar_t> other_row( n );
+
+    blas::device_memcpy_2d<scalar_t>(
+        local_row.data(), 1, dA, lda, 1, n,
+        blas::MemcpyKind::DeviceToHost, queue );
+    queue.sync();
+
+    internal::comm_sendrecv(
+        local_row.data(), other_row.data(), n, mpi_type<scalar_t>::value,
+        other_rank, 0, mpi_comm );
+
+    blas::device_memcpy_2d<scalar_t>(
+        dA, lda, other_row.data(), 1, 1, n,
+        blas::MemcpyKind::HostToDevice, queue );
+}
+
+//------------------------------------------------------------------------------
+/// LU factorization of a column of tiles, GPU device implementation.
+/// Follows the host implementation, tile::getrf, but keeps the panel on
+/// the device: the local tiles are copied into a contiguous mlocal-by-nb
+/// array, where the pivot search (device::iamax), row swaps, scaling, and
+/// updates are done. Only the local maximum of each column, in a small
+/// device buffer, and the rows exchanged with other ranks go to the host,
+/// for the MPI reductions and broadcasts.
+/// The local tiles are gathered on the device of the first one; with a
+/// 1-D distribution of devices, they are all there already, but not if
+/// the panel spans devices, e.g., with a column-major device order.
+///
+/// @param[in,out] dwork_array
+///     Array of GPU device workspaces, dimension (num_devices).
+///     dwork_array[ dev ] is of size dwork_bytes, at least
+///     getrf_panel_work_bytes<scalar_t>( mlocal, nb, ib ).
+///
+/// @ingroup gesv_internal
+///
+template <typename scalar_t>
+void getrf_panel(
+    internal::TargetType<Target::Devices>,
+    Matrix<scalar_t>& A,
+    std::vector< char* >& dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    blas::real_type<scalar_t> pivot_threshold,
+    int max_panel_threads, int priority, int tag, int64_t* info )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    assert(A.nt() == 1);
+
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    *info = 0;
+
+    // Build the set of ranks in the panel.
+    // Build lists of local tiles, their indices, and their first row in dA.
+    std::set<int> ranks_set;
+    TileSet A_tiles_set;
+    std::vector<int64_t> tile_indices;
+    std::vector<int64_t> row_offsets;
+    int device = -1;
+    int64_t mlocal = 0;
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        ranks_set.insert( A.tileRank( i, 0 ) );
+        if (A.tileIsLocal( i, 0 )) {
+            if (device < 0)
+                device = A.tileDevice( i, 0 );
+            A_tiles_set.insert( { i, 0 } );
+            tile_indices.push_back( i );
+            row_offsets.push_back( mlocal );
+            mlocal += A.tileMb( i );
+        }
+    }
+
+    // If not participating in the panel factorization.
+    if (ranks_set.find( A.mpiRank() ) == ranks_set.end())
+        return;
+
+    // Get the broadcast communicator, cached by the matrix.
+    // Translate the root rank.
+    int bcast_rank;
+    int bcast_root;
+    MPI_Comm bcast_comm;
+    bcast_comm = commFromSet(ranks_set,
+                             A.mpiComm(), A.mpiGroup(),
+                             A.tileRank(0, 0), bcast_root,
+                             tag, A.commCache());
+    // Find the local rank.
+    slate_mpi_call( MPI_Comm_rank(bcast_comm, &bcast_rank) );
+    bool root = bcast_rank == bcast_root;
+
+    int64_t nb = A.tileNb( 0 );
+    int64_t lda = mlocal;
+
+    // Split workspace into dA, dtop, dvalue, dindex.
+    size_t size_A_bytes = roundup( mlocal * nb * sizeof( scalar_t ), size_t( 8 ) );
+    size_t top_bytes    = roundup( ib * nb * sizeof( scalar_t ), size_t( 8 ) );
+    size_t value_bytes  = roundup( sizeof( scalar_t ), size_t( 8 ) );
+    assert( size_A_bytes + top_bytes + value_bytes + sizeof( int64_t )
+            <= dwork_bytes );
+    char* dworkspace = dwork_array[ device ];
+    scalar_t* dA     = (scalar_t*) &dworkspace[ 0 ];
+    scalar_t* dtop   = (scalar_t*) &dworkspace[ size_A_bytes ];
+    scalar_t* dvalue = (scalar_t*) &dworkspace[ size_A_bytes + top_bytes ];
+    int64_t*  dindex = (int64_t*)  &dworkspace[ size_A_bytes + top_bytes
+                                                + value_bytes ];
+
+    blas::Queue* queue = A.compute_queue( device, 0 );
+
+    // Copy the local tiles into dA, first moving any on other devices.
+    A.tileGetForWriting( A_tiles_set, device, LayoutConvert::ColMajor );
+    for (size_t idx = 0; idx < tile_indices.size(); ++idx) {
+        auto Ai0 = A( tile_indices[ idx ], 0, device );
+        blas::device_memcpy_2d<scalar_t>(
+            &dA[ row_offsets[ idx ] ], lda,
+            Ai0.data(), Ai0.stride(),
+            Ai0.mb(), nb,
+            blas::MemcpyKind::Default, *queue );
+    }
+
+    std::vector<scalar_t> top_block( ib*nb );
+    std::vector< AuxPivot<scalar_t> > aux_pivot( diag_len );
+
+    // Loop over ib-wide stripes.
+    for (int64_t k = 0; k < diag_len; k += ib) {
+
+        //=======================
+        // ib panel factorization
+        int64_t kb = std::min(diag_len-k, ib);
+
+        // Loop over ib columns of a stripe.
+        for (int64_t j = k; j < k+kb; ++j) {
+
+            //------------------
+            // local max search, on the device
+            int64_t i0 = root ? j : 0;
+            int64_t max_row;
+            scalar_t max_value;
+            scalar_t diag_value = zero;
+            device::iamax( mlocal - i0, &dA[ i0 + j*lda ], 1,
+                           dindex, dvalue, *queue );
+            blas::device_memcpy<int64_t>( &max_row, dindex, 1, *queue );
+            blas::device_memcpy<scalar_t>( &max_value, dvalue, 1, *queue );
+            if (root)
+                blas::device_memcpy<scalar_t>( &diag_value, &dA[ j + j*lda ],
+                                               1, *queue );
+            queue->sync();
+            max_row += i0;
+
+            //------------------------------------
+            // global max reduction and pivot swap
+            // MPI max abs reduction
+            // Do two reductions that differ in the root's value
+            // * the diagonal entry
+            // * the largest entry
+            struct { real_t max; int loc; } max_loc_in[2], max_loc[2];
+            if (root) {
+                max_loc_in[0].max = cabs1( diag_value );
+                max_loc_in[1].max = cabs1( max_value );
+            }
+            else {
+                max_loc_in[0].max = cabs1( max_value )*pivot_threshold;
+                max_loc_in[1].max = max_loc_in[0].max;
+            }
+            max_loc_in[0].loc = bcast_rank;
+            max_loc_in[1].loc = bcast_rank;
+            slate_mpi_call(
+                MPI_Allreduce(max_loc_in, max_loc, 2,
+                              mpi_type< max_loc_type<real_t> >::value,
+                              MPI_MAXLOC, bcast_comm));
+
+            int pivot_rank;
+            if (max_loc[0].loc != bcast_root) {
+                // if diagonal isn't good enough for the remote entries,
+                // use the result of the second reduction
+                pivot_rank = max_loc[1].loc;
+            }
+            else {
+                pivot_rank = bcast_root;
+
+                // if the diagonal is good enough for the local entries,
+                // use it on the root
+                if (root
+                    && max_loc[0].max >= cabs1( max_value )*pivot_threshold) {
+                    max_row = j;
+                    max_value = diag_value;
+                }
+            }
+
+            // Broadcast the pivot information.
+            int64_t idx = std::upper_bound( row_offsets.begin(),
+                                            row_offsets.end(), max_row )
+                        - row_offsets.begin() - 1;
+            aux_pivot[j] = AuxPivot<scalar_t>( tile_indices[ idx ],
+                                               max_row - row_offsets[ idx ],
+                                               idx, max_value, pivot_rank );
+            slate_mpi_call(
+                MPI_Bcast(&aux_pivot[j], sizeof(AuxPivot<scalar_t>),
+                          MPI_BYTE, pivot_rank, bcast_comm));
+
+            // pivot swap
+            if (aux_pivot[j].rank() == bcast_rank) {
+                int64_t pivot_row = row_offsets[ aux_pivot[j].localTileIndex() ]
+                                  + aux_pivot[j].elementOffset();
+                if (root) {
+                    if (pivot_row != j) {
+                        blas::swap( nb, &dA[ j ], lda,
+                                        &dA[ pivot_row ], lda, *queue );
+                    }
+                }
+                else {
+                    getrf_swap_remote_row_device(
+                        nb, &dA[ pivot_row ], lda,
+                        bcast_root, bcast_comm, *queue );
+                }
+            }
+            else if (root) {
+                getrf_swap_remote_row_device(
+                    nb, &dA[ j ], lda,
+                    aux_pivot[j].rank(), bcast_comm, *queue );
+            }
+            scalar_t pivot_value = aux_pivot[j].value();
+
+            // Broadcast the top row for the rank-1 update.
+            int64_t n1 = k+kb-j-1;
+            scalar_t* dtop_row = dtop;
+            int64_t ldtop = 1;
+            if (n1 > 0) {
+                if (root) {
+                    dtop_row = &dA[ j + (j+1)*lda ];
+                    ldtop = lda;
+                    blas::device_memcpy_2d<scalar_t>(
+                        top_block.data(), 1, dtop_row, lda, 1, n1,
+                        blas::MemcpyKind::DeviceToHost, *queue );
+                    queue->sync();
+                }
+                slate_mpi_call(
+                    MPI_Bcast(top_block.data(),
+                              n1, mpi_type<scalar_t>::value,
+                              bcast_root, bcast_comm));
+                if (! root) {
+                    blas::device_memcpy<scalar_t>(
+                        dtop, top_block.data(), n1,
+                        blas::MemcpyKind::HostToDevice, *queue );
+                }
+            }
+
+            // column scaling and trailing update
+            int64_t i1 = root ? j+1 : 0;
+            int64_t m1 = mlocal - i1;
+            if (pivot_value != zero) {
+                real_t sfmin = std::numeric_limits<real_t>::min();
+                if (m1 > 0 && cabs1( pivot_value ) >= sfmin) {
+                    blas::scal( m1, one / pivot_value, &dA[ i1 + j*lda ], 1,
+                                *queue );
+                }
+                else if (m1 > 0) {
+                    // 1 / pivot_value would overflow, so divide, as
+                    // tile::getrf does. This is rare, so do it on the host.
+                    std::vector<scalar_t> column( m1 );
+                    blas::device_memcpy<scalar_t>(
+                        column.data(), &dA[ i1 + j*lda ], m1,
+                        blas::MemcpyKind::DeviceToHost, *queue );
+                    queue->sync();
+                    for (int64_t i = 0; i < m1; ++i)
+                        column[ i ] /= pivot_value;
+                    blas::device_memcpy<scalar_t>(
+                        &dA[ i1 + j*lda ], column.data(), m1,
+                        blas::MemcpyKind::HostToDevice, *queue );
+                    queue->sync();
+                }
+            }
+            else if (*info == 0 && root) {
+                // U(j,j) = 0; save info using 1-based index.
+                *info = j + 1;
+            }
+
+            if (n1 > 0 && m1 > 0) {
+                blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                            m1, n1, 1,
+                            -one, &dA[ i1 + j*lda ], lda,
+                                  dtop_row, ldtop,
+                            one,  &dA[ i1 + (j+1)*lda ], lda, *queue );
+            }
+        }
+
+        // If there is a trailing submatrix.
+        if (k+kb < nb) {
+            int64_t n1 = nb-k-kb;
+            scalar_t* dtop_block = dtop;
+            int64_t ldtop = kb;
+            if (root) {
+                // triangular solve
+                dtop_block = &dA[ k + (k+kb)*lda ];
+                ldtop = lda;
+                blas::trsm( Layout::ColMajor,
+                            Side::Left, Uplo::Lower,
+                            Op::NoTrans, Diag::Unit,
+                            kb, n1,
+                            one, &dA[ k + k*lda ], lda,
+                                 dtop_block, lda, *queue );
+
+                // Copy the top block for gemm to the host.
+                blas::device_memcpy_2d<scalar_t>(
+                    top_block.data(), kb, dtop_block, lda, kb, n1,
+                    blas::MemcpyKind::DeviceToHost, *queue );
+                queue->sync();
+            }
+            // Broadcast the top block for gemm.
+            slate_mpi_call(
+                MPI_Bcast(top_block.data(),
+                          kb*n1, mpi_type<scalar_t>::value,
+                          bcast_root, bcast_comm));
+            if (! root) {
+                blas::device_memcpy<scalar_t>(
+                    dtop, top_block.data(), kb*n1,
+                    blas::MemcpyKind::HostToDevice, *queue );
+            }
+
+            //============================
+            // rank-ib update to the right
+            int64_t i1 = root ? k+kb : 0;
+            int64_t m1 = mlocal - i1;
+            if (m1 > 0) {
+                blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                            m1, n1, kb,
+                            -one, &dA[ i1 + k*lda ], lda,
+                                  dtop_block, ldtop,
+                            one,  &dA[ i1 + (k+kb)*lda ], lda, *queue );
+            }
+        }
+    }
 
-        // Free the broadcast communicator.
-        slate_mpi_call(MPI_Comm_free(&bcast_comm));
+    // Copy dA back into the local tiles.
+    for (size_t idx = 0; idx < tile_indices.size(); ++idx) {
+        auto Ai0 = A( tile_indices[ idx ], 0, device );
+        blas::device_memcpy_2d<scalar_t>(
+            Ai0.data(), Ai0.stride(),
+            &dA[ row_offsets[ idx ] ], lda,
+            Ai0.mb(), nb,
+            blas::MemcpyKind::Default, *queue );
+    }
+    queue->sync();
+
+    // Copy pivot information from aux_pivot to pivot.
+    for (int64_t i = 0; i < diag_len; ++i) {
+        pivot[i] = Pivot(aux_pivot[i].tileIndex(),
+                         aux_pivot[i].elementOffset());
     }
 }
 
@@ -127,14 +479,30 @@ void getrf_panel(
 ///
 template <Target target, typename scalar_t>
 void getrf_panel(
-    Matrix<scalar_t>&& A, int64_t diag_len, int64_t ib,
+    Matrix<scalar_t>&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     blas::real_type<scalar_t> pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info )
 {
+    // Flops of local tiles, mb n^2 each, less n^3 / 3 for the diagonal tile.
+    FlopCounter flop_counter( FlopRoutine::GetrfPanel, target, [&]() {
+        double n = A.tileNb( 0 );
+        double flops = 0;
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal( i, 0 )) {
+                flops += A.tileMb( i ) * n * n;
+                if (i == 0)
+                    flops -= n * n * n / 3;
+            }
+        }
+        return flops * flop_scale<scalar_t>();
+    } );
+
     getrf_panel(
         internal::TargetType<target>(),
-        A, diag_len, ib, pivot,
+        A, dwork_array, dwork_bytes, diag_len, ib, pivot,
         pivot_threshold, max_panel_threads, priority, tag, info );
 }
 
@@ -143,7 +511,9 @@ void getrf_panel(
 // ----------------------------------------
 template
 void getrf_panel<Target::HostTask, float>(
-    Matrix<float>&& A, int64_t diag_len, int64_t ib,
+    Matrix<float>&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     float pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
@@ -151,7 +521,9 @@ void getrf_panel<Target::HostTask, float>(
 // ----------------------------------------
 template
 void getrf_panel<Target::HostTask, double>(
-    Matrix<double>&& A, int64_t diag_len, int64_t ib,
+    Matrix<double>&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     double pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
@@ -159,7 +531,9 @@ void getrf_panel<Target::HostTask, double>(
 // ----------------------------------------
 template
 void getrf_panel< Target::HostTask, std::complex<float> >(
-    Matrix< std::complex<float> >&& A, int64_t diag_len, int64_t ib,
+    Matrix< std::complex<float> >&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     float pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
@@ -167,7 +541,49 @@ void getrf_panel< Target::HostTask, std::complex<float> >(
 // ----------------------------------------
 template
 void getrf_panel< Target::HostTask, std::complex<double> >(
-    Matrix< std::complex<double> >&& A, int64_t diag_len, int64_t ib,
+    Matrix< std::complex<double> >&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    double pivot_threshold,
+    int max_panel_threads, int priority, int tag, int64_t* info );
+
+// ----------------------------------------
+template
+void getrf_panel<Target::Devices, float>(
+    Matrix<float>&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    float pivot_threshold,
+    int max_panel_threads, int priority, int tag, int64_t* info );
+
+// ----------------------------------------
+template
+void getrf_panel<Target::Devices, double>(
+    Matrix<double>&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    double pivot_threshold,
+    int max_panel_threads, int priority, int tag, int64_t* info );
+
+// ----------------------------------------
+template
+void getrf_panel< Target::Devices, std::complex<float> >(
+    Matrix< std::complex<float> >&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
+    std::vector<Pivot>& pivot,
+    float pivot_threshold,
+    int max_panel_threads, int priority, int tag, int64_t* info );
+
+// ----------------------------------------
+template
+void getrf_panel< Target::Devices, std::complex<double> >(
+    Matrix< std::complex<double> >&& A,
+    std::vector< char* > dwork_array, size_t dwork_bytes,
+    int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
     double pivot_threshold,
     int max_panel_threads, int priority, int tag, int64_t* info );
@@ -3,6 +3,7 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "slate/internal/device.hh"
 #include "slate/Matrix.hh"
 #include "slate/types.hh"
 #include "internal/Tile_getrf_nopiv.hh"
@@ -19,9 +20,11 @@ namespace internal {
 template <Target target, typename scalar_t>
 void getrf_nopiv(
     Matrix< scalar_t >&& A,
-    int64_t ib, int priority, int64_t* info )
+    int64_t ib, int priority, int64_t* info,
+    int64_t queue_index, lapack::device_info_int* device_info )
 {
-    getrf_nopiv( internal::TargetType<target>(), A, ib, priority, info );
+    getrf_nopiv( internal::TargetType<target>(), A, ib, priority, info,
+                 queue_index, device_info );
 }
 
 //------------------------------------------------------------------------------
@@ -39,7 +42,8 @@ template <typename scalar_t>
 void getrf_nopiv(
     internal::TargetType<Target::HostTask>,
     Matrix<scalar_t>& A,
-    int64_t ib, int priority, int64_t* info )
+    int64_t ib, int priority, int64_t* info,
+    int64_t queue_index, lapack::device_info_int* device_info )
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -52,6 +56,52 @@ void getrf_nopiv(
     }
 }
 
+//------------------------------------------------------------------------------
+/// LU factorization of single tile without pivoting, device implementation.
+/// Factors the tile in place on its device, in one kernel launch, so it
+/// need not be copied to the host and back; only info is copied back.
+///
+/// @param[in] queue_index
+///     Compute queue of the tile's device to execute in.
+///
+/// @param[in] device_info
+///     Device memory for one info value, on the tile's device.
+///
+/// @param[in,out] info
+///     Exit status.
+///     * 0: successful exit
+///     * i > 0: U(i,i) is exactly zero (1-based index). The factorization
+///       will have NaN due to division by zero.
+///
+/// @ingroup gesv_internal
+///
+template <typename scalar_t>
+void getrf_nopiv(
+    internal::TargetType<Target::Devices>,
+    Matrix<scalar_t>& A,
+    int64_t ib, int priority, int64_t* info,
+    int64_t queue_index, lapack::device_info_int* device_info )
+{
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+
+    *info = 0;
+
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice( 0, 0 );
+        A.tileGetForWriting( 0, 0, device, LayoutConvert::ColMajor );
+        blas::Queue* queue = A.compute_queue( device, queue_index );
+        auto A00 = A( 0, 0, device );
+        device::getrf_nopiv(
+            A00.mb(), A00.nb(), A00.data(), A00.stride(),
+            device_info, *queue );
+        lapack::device_info_int host_info;
+        blas::device_memcpy( &host_info, device_info, 1, *queue );
+        queue->sync();
+        *info = int64_t( host_info );
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -60,7 +110,9 @@ void getrf_nopiv<Target::HostTask, float>(
     Matrix<float>&& A,
     int64_t ib,
     int priority,
-    int64_t* info );
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
 
 // ----------------------------------------
 template
@@ -68,7 +120,9 @@ void getrf_nopiv<Target::HostTask, double>(
     Matrix<double>&& A,
     int64_t ib,
     int priority,
-    int64_t* info );
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
 
 // ----------------------------------------
 template
@@ -76,7 +130,9 @@ void getrf_nopiv< Target::HostTask, std::complex<float> >(
     Matrix< std::complex<float> >&& A,
     int64_t ib,
     int priority,
-    int64_t* info );
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
 
 // ----------------------------------------
 template
@@ -84,7 +140,49 @@ void getrf_nopiv< Target::HostTask, std::complex<double> >(
     Matrix< std::complex<double> >&& A,
     int64_t ib,
     int priority,
-    int64_t* info );
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
+
+// ----------------------------------------
+template
+void getrf_nopiv<Target::Devices, float>(
+    Matrix<float>&& A,
+    int64_t ib,
+    int priority,
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
+
+// ----------------------------------------
+template
+void getrf_nopiv<Target::Devices, double>(
+    Matrix<double>&& A,
+    int64_t ib,
+    int priority,
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
+
+// ----------------------------------------
+template
+void getrf_nopiv< Target::Devices, std::complex<float> >(
+    Matrix< std::complex<float> >&& A,
+    int64_t ib,
+    int priority,
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
+
+// ----------------------------------------
+template
+void getrf_nopiv< Target::Devices, std::complex<double> >(
+    Matrix< std::complex<double> >&& A,
+    int64_t ib,
+    int priority,
+    int64_t* info,
+    int64_t queue_index,
+    lapack::device_info_int* device_info );
 
 } // namespace internal
 } // namespace slate
@@ -8,6 +8,7 @@
 #include "slate/types.hh"
 #include "internal/Tile_getrf_tntpiv.hh"
 #include "internal/internal.hh"
+#include "slate/internal/PanelThreadPool.hh"
 #include "internal/internal_util.hh"
 #include "lapack.hh"
 #include "lapack/device.hh"
@@ -201,23 +202,9 @@ void getrf_tntpiv_local(
     std::vector<int64_t>  max_offset( thread_size );
     std::vector<scalar_t> top_block( ib * nb );
 
-    #if 1
-        // todo: this can be just `omp parallel` (no for). cf. internal_geqrf.cc
-        // Launching new threads for the panel guarantees progression.
-        // This should never deadlock, but may be detrimental to performance.
-        #pragma omp parallel for \
-                    num_threads( thread_size ) \
-                    shared( thread_barrier, max_value, max_index, max_offset, \
-                            top_block, aux_pivot )
-    #else
-        // Issuing panel operation as tasks may cause a deadlock.
-        #pragma omp taskloop \
-                    num_tasks( thread_size ) \
-                    shared( thread_barrier, max_value, max_index, max_offset, \
-                            top_block, aux_pivot )
-    #endif
-    for (int thread_id = 0; thread_id < thread_size; ++thread_id) {
-        // Factor the local panel in parallel.
+    // Factor the local panel in parallel, in the panel thread pool or in
+    // new threads; either guarantees progression.
+    panel_parallel( thread_size, [&]( int thread_id ) {
         tile::getrf_tntpiv_local(
             diag_len, ib, stage,
             tiles, tile_indices,
@@ -226,7 +213,7 @@ void getrf_tntpiv_local(
             thread_id, thread_size,
             thread_barrier,
             max_value, max_index, max_offset, top_block, info );
-    }
+    } );
 }
 
 //------------------------------------------------------------------------------
@@ -360,7 +347,7 @@ void getrf_tntpiv_panel(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info )
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info )
 {
     assert( A.nt() == 1 );
 
@@ -399,7 +386,7 @@ void getrf_tntpiv_panel(
 
     // Build the set of ranks in the panel.
     // Build lists of local tiles and their indices.
-    std::set<ij_tuple> A_tiles_set;
+    TileSet A_tiles_set;
     for (int64_t i = 0; i < A.mt(); ++i) {
         if (A.tileIsLocal( i, 0 )) {
             A_tiles_set.insert( { i, 0 } );
@@ -476,8 +463,6 @@ void getrf_tntpiv_panel(
 
     // If participating in the panel factorization.
     if (index < nranks) {
-        int nlevels = int( ceil( log2( nranks ) ) );
-
         std::vector< std::vector< AuxPivot< scalar_t > > > aux_pivot( 2 );
         aux_pivot[ 0 ].resize( mb );
         aux_pivot[ 1 ].resize( mb );
@@ -538,99 +523,102 @@ void getrf_tntpiv_panel(
                 aux_pivot[ 0 ][ ii ].set_elementOffset( permute[ 0 ][ ii ].second );
             }
 
-            int64_t step = 1;
-            for (int level = 0; level < nlevels; ++level) {
-                if (index % (2*step) == 0) {
-                    if (index + step < nranks) {
-                        // This is the top, rank1, of the pair;
-                        // recv tile from bottom, rank2, and do LU factorization.
-                        int rank2  = rank_rows[ index+step ].first;
-                        int64_t i2 = rank_rows[ index+step ].second;
-                        int64_t i1 = rank_rows[ index ].second;
-
-                        Awork.tileRecv( i2, 0, rank2, layout );
-                        Awork.tileGetForWriting( i1, 0, LayoutConvert( layout ));
-
-                        MPI_Status status;
-                        MPI_Recv( aux_pivot[ 1 ].data(),
-                                  sizeof(AuxPivot<scalar_t>) * aux_pivot[ 1 ].size(),
-                                  MPI_BYTE, rank2, 0, A.mpiComm(),  &status );
-
-                        // Alocate workspace to copy tiles in the tree reduction.
-                        std::vector<scalar_t> data1( Awork.tileMb( i1 ) * nb );
-                        std::vector<scalar_t> data2( Awork.tileMb( i2 ) * nb );
-
-                        Tile<scalar_t> tile1( Awork.tileMb( i1 ), nb,
-                                              &data1[ 0 ], Awork.tileMb( i1 ),
-                                              slate::HostNum, TileKind::Workspace );
-                        Tile<scalar_t> tile2( Awork.tileMb( i2 ), nb,
-                                              &data2[ 0 ], Awork.tileMb( i2 ),
-                                              slate::HostNum, TileKind::Workspace );
-
-                        Awork( i1, 0 ).copyData( &tile1 );
-                        Awork( i2, 0 ).copyData( &tile2 );
-
-                        piv_len = std::min( tile1.mb(), nb );
-
-                        std::vector< Tile< scalar_t > > tmp_tiles;
-                        tmp_tiles.push_back( tile1 );
-                        tmp_tiles.push_back( tile2 );
-
-                        // Factor the panel locally in parallel.
-                        getrf_tntpiv_local(
-                            internal::TargetType<Target::HostTask>(),
-                            tmp_tiles, dwork_array, work_bytes, mlocal, device,
-                            queue, piv_len, ib, 1, mb, nb, tile_indices,
-                            aux_pivot, A.mpiRank(), max_panel_threads, priority,
-                            info );
-
-                        std::vector< Tile< scalar_t > > work_tiles;
-                        work_tiles.push_back( Awork( i1, 0 ) );
-                        work_tiles.push_back( Awork( i2, 0 ) );
-
-                        // Swap rows in tiles in Awork.
-                        // Swap (tile, row) (0, ii) and (ip, iip).
-
-                        for (int64_t ii = 0; ii < piv_len; ++ii) {
-                            int64_t ip  = aux_pivot[ 0 ][ ii ].localTileIndex();
-                            int64_t iip = aux_pivot[ 0 ][ ii ].localOffset();
-                            if (ip > 0 || iip > ii) {
-                                swapLocalRow(
-                                    0, nb,
-                                    work_tiles[ 0  ], ii,
-                                    work_tiles[ ip ], iip );
-                            }
-                        }
-                        if (level == nlevels-1) {
-                            // Copy the last factorization back to panel tile
-                            tile1.copyData( &work_tiles[ 0 ] );
-                            permutation_to_sequential_pivot(
-                                aux_pivot[ 0 ], diag_len, A.mt(), mb );
-                        }
-
-                        Awork.tileRelease( i2, 0 );
+            // Ranks in the reduction, top-most first, and this rank's
+            // part of the tree.
+            std::vector<int> ranks( nranks );
+            std::map<int, int64_t> rank_first_row;
+            for (int r = 0; r < nranks; ++r) {
+                ranks[ r ] = rank_rows[ r ].first;
+                rank_first_row[ rank_rows[ r ].first ] = rank_rows[ r ].second;
+            }
+            std::list<int> recv_from, send_to;
+            tournamentReducePattern(
+                ranks, commNodesCached( A.mpiComm() ), tree, A.mpiRank(),
+                recv_from, send_to );
+
+            int64_t i1 = rank_rows[ index ].second;
+            for (int rank2 : recv_from) {
+                // This is the top, rank1, of the pair;
+                // recv tile from bottom, rank2, and do LU factorization.
+                int64_t i2 = rank_first_row[ rank2 ];
+
+                Awork.tileRecv( i2, 0, rank2, layout );
+                Awork.tileGetForWriting( i1, 0, LayoutConvert( layout ));
+
+                MPI_Status status;
+                MPI_Recv( aux_pivot[ 1 ].data(),
+                          sizeof(AuxPivot<scalar_t>) * aux_pivot[ 1 ].size(),
+                          MPI_BYTE, rank2, 0, A.mpiComm(),  &status );
+
+                // Alocate workspace to copy tiles in the tree reduction.
+                std::vector<scalar_t> data1( Awork.tileMb( i1 ) * nb );
+                std::vector<scalar_t> data2( Awork.tileMb( i2 ) * nb );
+
+                Tile<scalar_t> tile1( Awork.tileMb( i1 ), nb,
+                                      &data1[ 0 ], Awork.tileMb( i1 ),
+                                      slate::HostNum, TileKind::Workspace );
+                Tile<scalar_t> tile2( Awork.tileMb( i2 ), nb,
+                                      &data2[ 0 ], Awork.tileMb( i2 ),
+                                      slate::HostNum, TileKind::Workspace );
+
+                Awork( i1, 0 ).copyData( &tile1 );
+                Awork( i2, 0 ).copyData( &tile2 );
+
+                piv_len = std::min( tile1.mb(), nb );
+
+                std::vector< Tile< scalar_t > > tmp_tiles;
+                tmp_tiles.push_back( tile1 );
+                tmp_tiles.push_back( tile2 );
+
+                // Factor the panel locally in parallel.
+                getrf_tntpiv_local(
+                    internal::TargetType<Target::HostTask>(),
+                    tmp_tiles, dwork_array, work_bytes, mlocal, device,
+                    queue, piv_len, ib, 1, mb, nb, tile_indices,
+                    aux_pivot, A.mpiRank(), max_panel_threads, priority,
+                    info );
+
+                std::vector< Tile< scalar_t > > work_tiles;
+                work_tiles.push_back( Awork( i1, 0 ) );
+                work_tiles.push_back( Awork( i2, 0 ) );
+
+                // Swap rows in tiles in Awork.
+                // Swap (tile, row) (0, ii) and (ip, iip).
+
+                for (int64_t ii = 0; ii < piv_len; ++ii) {
+                    int64_t ip  = aux_pivot[ 0 ][ ii ].localTileIndex();
+                    int64_t iip = aux_pivot[ 0 ][ ii ].localOffset();
+                    if (ip > 0 || iip > ii) {
+                        swapLocalRow(
+                            0, nb,
+                            work_tiles[ 0  ], ii,
+                            work_tiles[ ip ], iip );
                     }
                 }
-                else {
-                    // This is bottom, rank2, of the pair;
-                    // send tile i2 and pivot data to top, rank1.
-                    int rank1  = rank_rows[ index - step ].first;
-                    int64_t i2 = rank_rows[ index ].second;
-                    Awork.tileSend( i2, 0, rank1 );
-
-                    MPI_Send( aux_pivot[ 0 ].data(),
-                              sizeof(AuxPivot<scalar_t>) * aux_pivot[ 0 ].size(),
-                              MPI_BYTE, rank1, 0, A.mpiComm() );
-
-                    // This rank's info is irrelevant;
-                    // the top rank will detect singularity.
-                    *info = 0;
-
-                    // This rank is done!
-                    break;
+                if (send_to.empty() && rank2 == recv_from.back()) {
+                    // Copy the last factorization back to panel tile
+                    tile1.copyData( &work_tiles[ 0 ] );
+                    permutation_to_sequential_pivot(
+                        aux_pivot[ 0 ], diag_len, A.mt(), mb );
                 }
-                step *= 2;
-            } // for loop over levels
+
+                Awork.tileRelease( i2, 0 );
+            } // for loop over merges
+
+            if (! send_to.empty()) {
+                // This is bottom, rank2, of the pair;
+                // send tile i1 and pivot data to top, rank1.
+                int rank1 = send_to.front();
+                Awork.tileSend( i1, 0, rank1 );
+
+                MPI_Send( aux_pivot[ 0 ].data(),
+                          sizeof(AuxPivot<scalar_t>) * aux_pivot[ 0 ].size(),
+                          MPI_BYTE, rank1, 0, A.mpiComm() );
+
+                // This rank's info is irrelevant;
+                // the top rank will detect singularity.
+                *info = 0;
+            }
         }
         else if (target == Target::Devices) {
             // Copy from contiguous memory back into workspace.
@@ -670,12 +658,12 @@ void getrf_tntpiv_panel(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info )
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info )
 {
     getrf_tntpiv_panel(
         internal::TargetType<target>(),
         A, Awork, dwork_array, work_bytes,
-        diag_len, ib, pivot, max_panel_threads, priority, info );
+        diag_len, ib, pivot, max_panel_threads, tree, priority, info );
 }
 
 //------------------------------------------------------------------------------
@@ -688,7 +676,7 @@ void getrf_tntpiv_panel<Target::HostTask, float>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -698,7 +686,7 @@ void getrf_tntpiv_panel<Target::HostTask, double>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -708,7 +696,7 @@ void getrf_tntpiv_panel< Target::HostTask, std::complex<float> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -718,7 +706,7 @@ void getrf_tntpiv_panel< Target::HostTask, std::complex<double> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -728,7 +716,7 @@ void getrf_tntpiv_panel<Target::HostNest, float>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -738,7 +726,7 @@ void getrf_tntpiv_panel<Target::HostNest, double>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -748,7 +736,7 @@ void getrf_tntpiv_panel<Target::HostNest, std::complex<float> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -758,7 +746,7 @@ void getrf_tntpiv_panel<Target::HostNest, std::complex<double> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -768,7 +756,7 @@ void getrf_tntpiv_panel<Target::HostBatch, float>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -778,7 +766,7 @@ void getrf_tntpiv_panel<Target::HostBatch, double>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -788,7 +776,7 @@ void getrf_tntpiv_panel<Target::HostBatch, std::complex<float> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -798,7 +786,7 @@ void getrf_tntpiv_panel<Target::HostBatch, std::complex<double> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -808,7 +796,7 @@ void getrf_tntpiv_panel<Target::Devices, float>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -818,7 +806,7 @@ void getrf_tntpiv_panel<Target::Devices, double>(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -828,7 +816,7 @@ void getrf_tntpiv_panel<Target::Devices, std::complex<float> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 // ----------------------------------------
 template
@@ -838,7 +826,7 @@ void getrf_tntpiv_panel<Target::Devices, std::complex<double> >(
     std::vector< char* > dwork_array, size_t work_bytes,
     int64_t diag_len, int64_t ib,
     std::vector<Pivot>& pivot,
-    int max_panel_threads, int priority, int64_t* info );
+    int max_panel_threads, TournamentTree tree, int priority, int64_t* info );
 
 } // namespace internal
 
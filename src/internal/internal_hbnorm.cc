@@ -424,7 +424,7 @@ void norm(
             firstprivate(device, irange, jrange, layout, in_norm, lower) \
             firstprivate(i_begin, i_end, kdt, queue_index, ldv) priority(priority)
         {
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             for (int64_t j = 0; j < A.nt(); ++j) {
                 if (lower) {
@@ -134,7 +134,7 @@ void he2hb_gemm(
             scalar_t** host_work = A.array_host(device, queue_index);
 
             for (int64_t k = 0; k < B.mt(); ++k) {
-                std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+                TileSet A_tiles_set, B_tiles_set, C_tiles_set;
                 for (int64_t i = 0; i < A.mt(); ++i) {
                     if (A.tileRank( i, k ) == panel_rank
                         && device == C.tileDevice( i, 0 )) {
@@ -125,7 +125,7 @@ void he2hb_hemm(
             priority( priority )
         {
 
-            std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+            TileSet A_tiles_set, B_tiles_set, C_tiles_set;
             for (int64_t j : panel_rank_rows) {
                 for (int64_t i = 0; i < mt; ++i) {
                     if (i >= j) { // lower or diagonal
@@ -301,7 +301,7 @@ void he2hb_hemm(internal::TargetType<Target::Devices>,
             shared( A, B, C, err ) \
             priority( priority )
         {
-            std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+            TileSet A_tiles_set, B_tiles_set, C_tiles_set;
             for (int64_t j : panel_rank_rows) {
                 for (int64_t i = 0; i < mt; ++i) {
                     if (i >= j) { // lower or diagonal
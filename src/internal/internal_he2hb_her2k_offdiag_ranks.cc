@@ -138,7 +138,7 @@ void he2hb_her2k_offdiag_ranks(
             opA = Op::NoTrans;
             opB = Op::ConjTrans;
 
-            std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+            TileSet A_tiles_set, B_tiles_set, C_tiles_set;
             for (int64_t j = 0; j < nt; ++j) {
                 for (int64_t i : panel_rank_rows) {
                     if (i > j) {
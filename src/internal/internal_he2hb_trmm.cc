@@ -159,7 +159,7 @@ void he2hb_trmm(
             firstprivate( device, queue_index, mpi_rank, layout, layoutc ) \
             priority( priority )
         {
-            std::set<ij_tuple> B_tiles_set, A0_tiles_set;
+            TileSet B_tiles_set, A0_tiles_set;
 
             for (int64_t i = 0; i < B.mt(); ++i) {
                 if (need_Bi0( AH, mpi_rank, i, panel_rank_rows )
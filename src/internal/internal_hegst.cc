@@ -8,6 +8,8 @@
 #include "slate/types.hh"
 #include "internal/Tile_lapack.hh"
 #include "internal/internal.hh"
+#include "internal/internal_queue.hh"
+#include "slate/internal/device.hh"
 
 namespace slate {
 namespace internal {
@@ -20,9 +22,10 @@ namespace internal {
 ///
 template <Target target, typename scalar_t>
 void hegst(int64_t itype, HermitianMatrix< scalar_t >&& A,
-                          HermitianMatrix< scalar_t >&& B)
+                          HermitianMatrix< scalar_t >&& B,
+           int priority, int64_t queue_index)
 {
-    hegst(internal::TargetType<target>(), itype, A, B);
+    hegst(internal::TargetType<target>(), itype, A, B, priority, queue_index);
 }
 
 //------------------------------------------------------------------------------
@@ -33,7 +36,8 @@ void hegst(int64_t itype, HermitianMatrix< scalar_t >&& A,
 template <typename scalar_t>
 void hegst(internal::TargetType<Target::HostTask>,
            int64_t itype, HermitianMatrix<scalar_t>& A,
-                          HermitianMatrix<scalar_t>& B)
+                          HermitianMatrix<scalar_t>& B,
+           int priority, int64_t queue_index)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -49,31 +53,145 @@ void hegst(internal::TargetType<Target::HostTask>,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Reduces a complex Hermitian positive-definite generalized eigenvalue problem
+/// to the standard form of single tile, device implementation.
+/// LAPACK++ has no device hegst, so the tile is expanded to a full matrix W
+/// by hemm with the identity I, transformed with trsm (itype = 1) or
+/// trmm (itype = 2, 3) by the Cholesky factor in B, and written back by
+/// her2k as (W + W^H)/2, which touches only A's uplo triangle.
+/// Needs 2 nb-by-nb device workspace buffers.
+/// @ingroup hegv_internal
+///
+template <typename scalar_t>
+void hegst(internal::TargetType<Target::Devices>,
+           int64_t itype, HermitianMatrix<scalar_t>& A,
+                          HermitianMatrix<scalar_t>& B,
+           int priority, int64_t queue_index)
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+    using real_t = blas::real_type<scalar_t>;
+
+    const scalar_t zero = 0.0;
+    const scalar_t half = 0.5;
+    const scalar_t one  = 1.0;
+    const Layout layout = Layout::ColMajor;
+
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+    assert(B.mt() == 1);
+    assert(B.nt() == 1);
+
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice(0, 0);
+
+        // With queue_index = AnyQueue, leases a free queue.
+        QueueLease<scalar_t> lease( A, device, queue_index );
+        blas::Queue* queue = lease.queue();
+
+        TileSet tiles_set = { { 0, 0 } };
+        A.tileGetForWriting(tiles_set, device, LayoutConvert(layout), *queue);
+        B.tileGetForReading(tiles_set, device, LayoutConvert(layout), *queue);
+        auto A00 = A(0, 0, device);
+        auto B00 = B(0, 0, device);
+
+        int64_t n = A00.nb();
+        Uplo uplo = A00.uploPhysical();
+        Uplo uploB = B00.uploPhysical();
+        scalar_t* I = A.allocWorkspaceBuffer( device, n*n );
+        scalar_t* W = A.allocWorkspaceBuffer( device, n*n );
+
+        // W = A, as a full matrix.
+        device::geset( n, n, zero, one, I, n, *queue );
+        blas::hemm( layout, Side::Left, uplo, n, n,
+                    one, A00.data(), A00.stride(), I, n,
+                    zero, W, n, *queue );
+
+        // B = L L^H: itype 1, W = L^{-1} W L^{-H}; else W = L^H W L.
+        // B = U^H U: itype 1, W = U^{-H} W U^{-1}; else W = U W U^H.
+        Op op_left  = uploB == Uplo::Lower ? Op::NoTrans : Op::ConjTrans;
+        Op op_right = uploB == Uplo::Lower ? Op::ConjTrans : Op::NoTrans;
+        if (itype == 1) {
+            blas::trsm( layout, Side::Left, uploB, op_left, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+            blas::trsm( layout, Side::Right, uploB, op_right, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+        }
+        else {
+            blas::trmm( layout, Side::Left, uploB, op_right, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+            blas::trmm( layout, Side::Right, uploB, op_left, Diag::NonUnit,
+                        n, n, one, B00.data(), B00.stride(), W, n, *queue );
+        }
+
+        // uplo triangle of A = (W I + I W^H) / 2.
+        blas::her2k( layout, uplo, Op::NoTrans, n, n,
+                     half, W, n, I, n,
+                     real_t( 0.0 ), A00.data(), A00.stride(), *queue );
+
+        queue->sync();
+        A.freeWorkspaceBuffer( device, I );
+        A.freeWorkspaceBuffer( device, W );
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
 template
 void hegst<Target::HostTask, float>(
     int64_t itype, HermitianMatrix<float>&& A,
-                   HermitianMatrix<float>&& B);
+                   HermitianMatrix<float>&& B,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void hegst<Target::HostTask, double>(
     int64_t itype, HermitianMatrix<double>&& A,
-                   HermitianMatrix<double>&& B);
+                   HermitianMatrix<double>&& B,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void hegst<Target::HostTask, std::complex<float>>(
     int64_t itype, HermitianMatrix<std::complex<float>>&& A,
-                   HermitianMatrix<std::complex<float>>&& B);
+                   HermitianMatrix<std::complex<float>>&& B,
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void hegst<Target::HostTask, std::complex<double>>(
     int64_t itype, HermitianMatrix<std::complex<double>>&& A,
-                   HermitianMatrix<std::complex<double>>&& B);
+                   HermitianMatrix<std::complex<double>>&& B,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void hegst<Target::Devices, float>(
+    int64_t itype, HermitianMatrix<float>&& A,
+                   HermitianMatrix<float>&& B,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void hegst<Target::Devices, double>(
+    int64_t itype, HermitianMatrix<double>&& A,
+                   HermitianMatrix<double>&& B,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void hegst<Target::Devices, std::complex<float>>(
+    int64_t itype, HermitianMatrix<std::complex<float>>&& A,
+                   HermitianMatrix<std::complex<float>>&& B,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void hegst<Target::Devices, std::complex<double>>(
+    int64_t itype, HermitianMatrix<std::complex<double>>&& A,
+                   HermitianMatrix<std::complex<double>>&& B,
+    int priority, int64_t queue_index);
 
 } // namespace internal
 } // namespace slate
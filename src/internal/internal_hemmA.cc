@@ -175,6 +175,94 @@ void hemmA(internal::TargetType<Target::HostNest>,
         throw std::exception();
 }
 
+//------------------------------------------------------------------------------
+/// Hermitian matrix multiply to update trailing matrix.
+/// GPU device implementation: each C tile is updated with a hemm on the
+/// device that owns the tile of A, all in one queue.
+/// @ingroup hemmA_internal
+///
+template <typename scalar_t>
+void hemmA(internal::TargetType<Target::Devices>,
+           Side side,
+           scalar_t alpha, HermitianMatrix<scalar_t>& A,
+                           Matrix<scalar_t>& B,
+           scalar_t beta,  Matrix<scalar_t>& C,
+           int priority )
+{
+    using blas::conj;
+    using std::swap;
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    // GPU uses ColMajor, as on CPU.
+    const Layout layout = Layout::ColMajor;
+
+    // 1 block tile for now
+    assert(A.nt() == B.mt());
+    assert(A.mt() == C.mt());
+
+    // Undo transpose of B and C, as in tile::hemm,
+    // by swapping left <=> right, m <=> n, conj alpha & beta.
+    bool trans = C.op() != Op::NoTrans;
+    if (trans) {
+        side  = (side == Side::Left ? Side::Right : Side::Left);
+        alpha = conj( alpha );
+        beta  = conj( beta );
+    }
+
+    int err = 0;
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            if (A.tileIsLocal(i, j)) {
+                #pragma omp task slate_omp_default_none \
+                    shared( A, B, C, err ) \
+                    firstprivate( i, j, layout, side, alpha, beta, trans ) \
+                    priority(priority)
+                {
+                    try {
+                        int device = A.tileDevice( i, j );
+                        TileSet B_tiles_set, C_tiles_set;
+                        for (int64_t k = 0; k < B.nt(); ++k) {
+                            B_tiles_set.insert( { j, k } );
+                            C_tiles_set.insert( { i, k } );
+                        }
+                        A.tileGetForReading(
+                            i, j, device, LayoutConvert( layout ) );
+                        B.tileGetForReading(
+                            B_tiles_set, device, LayoutConvert( layout ) );
+                        C.tileGetForWriting(
+                            C_tiles_set, device, LayoutConvert( layout ) );
+
+                        blas::Queue* queue = A.compute_queue( device, 0 );
+
+                        auto Aij = A( i, j, device );
+                        for (int64_t k = 0; k < B.nt(); ++k) {
+                            auto Bjk = B( j, k, device );
+                            auto Cik = C( i, k, device );
+                            int64_t m = Cik.mb();
+                            int64_t n = Cik.nb();
+                            if (trans)
+                                swap( m, n );
+                            blas::hemm(
+                                layout, side, Aij.uploPhysical(), m, n,
+                                alpha, Aij.data(), Aij.stride(),
+                                       Bjk.data(), Bjk.stride(),
+                                beta,  Cik.data(), Cik.stride(), *queue );
+                        }
+                        queue->sync();
+                    }
+                    catch (std::exception& e) {
+                        err = __LINE__;
+                    }
+                }
+            }
+        }
+    }
+
+    if (err)
+        throw std::exception();
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -194,6 +282,14 @@ void hemmA<Target::HostNest, float>(
     float beta,  Matrix<float>&& C,
     int priority );
 
+template
+void hemmA<Target::Devices, float>(
+    Side side,
+    float alpha, HermitianMatrix<float>&& A,
+                 Matrix<float>&& B,
+    float beta,  Matrix<float>&& C,
+    int priority );
+
 // ----------------------------------------
 template
 void hemmA<Target::HostTask, double>(
@@ -211,6 +307,14 @@ void hemmA<Target::HostNest, double>(
     double beta,  Matrix<double>&& C,
     int priority );
 
+template
+void hemmA<Target::Devices, double>(
+    Side side,
+    double alpha, HermitianMatrix<double>&& A,
+                  Matrix<double>&& B,
+    double beta,  Matrix<double>&& C,
+    int priority );
+
 // ----------------------------------------
 template
 void hemmA< Target::HostTask, std::complex<float> >(
@@ -228,6 +332,14 @@ void hemmA< Target::HostNest, std::complex<float> >(
     std::complex<float> beta,  Matrix< std::complex<float> >&& C,
     int priority );
 
+template
+void hemmA< Target::Devices, std::complex<float> >(
+    Side side,
+    std::complex<float> alpha, HermitianMatrix< std::complex<float> >&& A,
+                               Matrix< std::complex<float> >&& B,
+    std::complex<float> beta,  Matrix< std::complex<float> >&& C,
+    int priority );
+
 // ----------------------------------------
 template
 void hemmA< Target::HostTask, std::complex<double> >(
@@ -245,5 +357,13 @@ void hemmA< Target::HostNest, std::complex<double> >(
     std::complex<double> beta,  Matrix< std::complex<double> >&& C,
     int priority );
 
+template
+void hemmA< Target::Devices, std::complex<double> >(
+    Side side,
+    std::complex<double> alpha, HermitianMatrix< std::complex<double> >&& A,
+                                Matrix< std::complex<double> >&& B,
+    std::complex<double> beta,  Matrix< std::complex<double> >&& C,
+    int priority );
+
 } // namespace internal
 } // namespace slate
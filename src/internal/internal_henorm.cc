@@ -7,6 +7,7 @@
 #include "internal/internal.hh"
 #include "internal/internal_batch.hh"
 #include "internal/internal_util.hh"
+#include "internal/internal_queue.hh"
 #include "slate/internal/util.hh"
 #include "slate/HermitianMatrix.hh"
 #include "internal/Tile_lapack.hh"
@@ -377,7 +378,7 @@ void norm(
             firstprivate(device, layout, lower, queue_index, in_norm, ldv) \
             priority(priority)
         {
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
@@ -392,9 +393,12 @@ void norm(
             }
             A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
 
+            // With queue_index = AnyQueue, leases a free queue.
+            QueueLease<scalar_t> lease( A, device, queue_index );
+
             // Setup batched arguments.
             int64_t batch_size = A_tiles_set.size();
-            scalar_t** a_array_host = A.array_host( device, queue_index );
+            scalar_t** a_array_host = lease.array_host();
 
             auto group_params = device_regions_build<true, 1, scalar_t>(
                     {A},
@@ -403,11 +407,11 @@ void norm(
                     {},
                     ijrange, ijrange );
 
-            scalar_t** a_array_dev = A.array_device(device, queue_index);
+            scalar_t** a_array_dev = lease.array_device();
 
             vals_host_arrays[ device ].resize( batch_size*ldv );
             real_t* vals_host_array = vals_host_arrays[ device ].data();
-            blas::Queue* queue = A.compute_queue( device, queue_index );
+            blas::Queue* queue = lease.queue();
             real_t* vals_dev_array = blas::device_malloc<real_t>( batch_size*ldv, *queue );
 
             // Batched call to compute partial results for each tile.
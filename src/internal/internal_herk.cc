@@ -6,9 +6,11 @@
 #include "slate/Matrix.hh"
 #include "slate/HermitianMatrix.hh"
 #include "slate/types.hh"
+#include "slate/FlopStats.hh"
 #include "slate/Tile_blas.hh"
 #include "internal/internal.hh"
 #include "internal/internal_batch.hh"
+#include "internal/internal_queue.hh"
 
 namespace slate {
 namespace internal {
@@ -31,6 +33,21 @@ void herk(blas::real_type<scalar_t> alpha, Matrix<scalar_t>&& A,
                           A.op() != Op::Trans))))
         throw std::exception();
 
+    // Flops of local lower C tiles: mb (mb+1) k on the diagonal,
+    // 2 mb nb k off the diagonal.
+    FlopCounter flop_counter( FlopRoutine::Herk, target, [&]() {
+        double flops = 0;
+        for (int64_t j = 0; j < C.nt(); ++j) {
+            for (int64_t i = j; i < C.mt(); ++i) {
+                if (C.tileIsLocal( i, j )) {
+                    double mb = C.tileMb( i ), nb = C.tileNb( j );
+                    flops += (i == j ? mb * (mb + 1) : 2 * mb * nb) * A.n();
+                }
+            }
+        }
+        return flops * flop_scale<scalar_t>();
+    } );
+
     herk(internal::TargetType<target>(),
          alpha, A,
          beta,  C,
@@ -72,10 +89,17 @@ void herk(internal::TargetType<Target::HostTask>,
                     {
                         try {
                             A.tileGetForReading(j, 0, LayoutConvert(layout));
-                            C.tileGetForWriting(j, j, LayoutConvert(layout));
-                            tile::herk(
-                                alpha, A(j, 0),
-                                beta,  C(j, j) );
+                            // With a Zero tile of A, C = beta C.
+                            if (A.tileStructure( j, 0 ) != TileStructure::Zero) {
+                                C.tileGetForWriting(j, j, LayoutConvert(layout));
+                                tile::herk(
+                                    alpha, A(j, 0),
+                                    beta,  C(j, j) );
+                            }
+                            else if (beta != 1) {
+                                C.tileGetForWriting(j, j, LayoutConvert(layout));
+                                tile::scale( scalar_t( beta ), C(j, j) );
+                            }
                         }
                         catch (std::exception& e) {
                             err = __LINE__;
@@ -90,11 +114,19 @@ void herk(internal::TargetType<Target::HostTask>,
                         try {
                             A.tileGetForReading(i, 0, LayoutConvert(layout));
                             A.tileGetForReading(j, 0, LayoutConvert(layout));
-                            C.tileGetForWriting(i, j, LayoutConvert(layout));
-                            auto Aj0 = A(j, 0);
-                            tile::gemm(
-                                alpha_, A(i, 0), conj_transpose( Aj0 ),
-                                beta_,  C(i, j) );
+                            // With a Zero tile of A, C = beta C.
+                            if (A.tileStructure( i, 0 ) != TileStructure::Zero
+                                && A.tileStructure( j, 0 ) != TileStructure::Zero) {
+                                C.tileGetForWriting(i, j, LayoutConvert(layout));
+                                auto Aj0 = A(j, 0);
+                                tile::gemm(
+                                    alpha_, A(i, 0), conj_transpose( Aj0 ),
+                                    beta_,  C(i, j) );
+                            }
+                            else if (beta_ != scalar_t( 1 )) {
+                                C.tileGetForWriting(i, j, LayoutConvert(layout));
+                                tile::scale( beta_, C(i, j) );
+                            }
                         }
                         catch (std::exception& e) {
                             err = __LINE__;
@@ -372,7 +404,8 @@ void herk(internal::TargetType<Target::Devices>,
                 A.tileGetForReading(0, 0, device, LayoutConvert(layout));
                 C.tileGetForWriting(0, 0, device, LayoutConvert(layout));
 
-                blas::Queue* queue = C.compute_queue(device, queue_index);
+                QueueLease<scalar_t> lease( C, device, queue_index );
+                blas::Queue* queue = lease.queue();
 
                 auto A00 = A(0, 0, device);
                 auto C00 = C(0, 0, device);
@@ -412,39 +445,72 @@ void herk(internal::TargetType<Target::Devices>,
 
                     Op opB = (opA == Op::NoTrans ? Op::ConjTrans : Op::NoTrans);
 
-                    std::set<ij_tuple> A_tiles_set, C_tiles_set;
+                    // With beta = 0, off-diagonal tiles of C are
+                    // overwritten, so aren't fetched. Diagonal tiles are,
+                    // since herk leaves their other triangle unchanged.
+                    bool overwrite = beta == real_t( 0 );
+                    TileSet A_tiles_set, C_tiles_set, C_new_set;
                     for (int64_t j = 0; j < C.nt(); ++j) {
                         for (int64_t i = j; i < C.mt(); ++i) {  // lower
                             if (C.tileIsLocal(i, j)
                                 && device == C.tileDevice(i, j)) {
                                 A_tiles_set.insert({j, 0});
-                                C_tiles_set.insert({i, j});
                                 if (i != j) {
                                     A_tiles_set.insert({i, 0});
                                 }
+                                if (overwrite && i != j)
+                                    C_new_set.insert({i, j});
+                                else
+                                    C_tiles_set.insert({i, j});
                             }
                         }
                     }
 
+                    // Off-diagonal gemms are issued back to back on
+                    // queue_index; diagonal herks go on the last compute
+                    // queue, if there is a separate one, to overlap.
+                    // With queue_index = AnyQueue, both lease pooled queues.
+                    QueueLease<scalar_t> lease( C, device, queue_index );
+                    blas::Queue* queue = lease.queue();
+                    int diag_index = queue_index == AnyQueue
+                                   ? AnyQueue
+                                   : std::max( C.numComputeQueues() - 1,
+                                               queue_index );
+                    QueueLease<scalar_t> diag_lease( C, device, diag_index );
+                    blas::Queue* diag_queue = diag_lease.queue();
+
+                    // The queue, rather than this thread, waits for earlier
+                    // device work on the tiles.
                     #pragma omp taskgroup
                     {
                         #pragma omp task slate_omp_default_none \
                             shared( A, A_tiles_set ) \
-                            firstprivate(device, layout)
+                            firstprivate(device, layout, queue)
                         {
-                            A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout));
+                            A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout),
+                                                *queue);
                         }
                         #pragma omp task slate_omp_default_none \
-                            shared( C, C_tiles_set ) \
-                            firstprivate(device, layout)
+                            shared( C, C_tiles_set, C_new_set ) \
+                            firstprivate(device, layout, queue)
                         {
-                            C.tileGetForWriting(C_tiles_set, device, LayoutConvert(layout));
+                            C.tileGetForWriting(C_tiles_set, device, LayoutConvert(layout),
+                                                *queue);
+                            C.tileAcquireForOverwrite(C_new_set, device, layout,
+                                                      queue);
                         }
                     }
+                    if (diag_queue != queue) {
+                        // diag_queue inherits queue's waits.
+                        auto start = DeviceEvent::record( *queue );
+                        if (start != nullptr)
+                            start->wait( *diag_queue );
+                    }
+                    C_tiles_set.insert( C_new_set.begin(), C_new_set.end() );
 
                     int64_t batch_size = C_tiles_set.size();
 
-                    scalar_t** a_array_host = C.array_host(device, queue_index);
+                    scalar_t** a_array_host = lease.array_host();
                     scalar_t** b_array_host = a_array_host + batch_size;
                     scalar_t** c_array_host = b_array_host + batch_size;
 
@@ -475,52 +541,73 @@ void herk(internal::TargetType<Target::Devices>,
                         std::vector<scalar_t> beta_s (1, scalar_t(beta));
                         std::vector<Uplo> uplo(1, C.uploPhysical());
 
-                        blas::Queue* queue = C.compute_queue(device, queue_index);
+                        // Offsets of each group in the batch arrays.
+                        std::vector<int64_t> offset( group_params.size()+1, 0 );
+                        for (size_t g = 0; g < group_params.size(); ++g) {
+                            offset[ g+1 ] = offset[ g ] + group_params[ g ].count;
+                        }
 
                         for (size_t g = 0; g < group_params.size(); ++g) {
+                            if (group_params[ g ].is_diagonal)
+                                continue;
 
                             int64_t group_count = group_params[ g ].count;
 
+                            std::vector<int64_t>    m(1, group_params[ g ].mb);
                             std::vector<int64_t>    n(1, group_params[ g ].nb);
                             std::vector<int64_t> ldda(1, group_params[ g ].ld[1]);
+                            std::vector<int64_t> lddb(1, group_params[ g ].ld[2]);
                             std::vector<int64_t> lddc(1, group_params[ g ].ld[0]);
-                            std::vector<scalar_t*> a_array(a_array_host, a_array_host+group_count);
-                            std::vector<scalar_t*> c_array(c_array_host, c_array_host+group_count);
-
-                            if (group_params[ g ].is_diagonal) {
-                                blas::batch::herk(
-                                    layout, uplo, opA_,
-                                    n, k,
-                                    alpha_r, a_array, ldda,
-                                    beta_r,  c_array, lddc,
-                                    group_count, info, *queue);
+                            std::vector<scalar_t*> a_array(a_array_host + offset[ g ], a_array_host + offset[ g+1 ]);
+                            std::vector<scalar_t*> b_array(b_array_host + offset[ g ], b_array_host + offset[ g+1 ]);
+                            std::vector<scalar_t*> c_array(c_array_host + offset[ g ], c_array_host + offset[ g+1 ]);
+
+                            if (C.op() != Op::NoTrans) {
+                                swap(m, n);
+                                swap(a_array, b_array);
+                                swap(ldda, lddb);
                             }
-                            else {
-                                std::vector<int64_t>    m(1, group_params[ g ].mb);
-                                std::vector<int64_t> lddb(1, group_params[ g ].ld[2]);
 
-                                std::vector<scalar_t*> b_array(b_array_host, b_array_host+group_count);
+                            blas::batch::gemm(
+                                layout, opA_, opB_,
+                                m, n, k,
+                                alpha_s, a_array, ldda,
+                                         b_array, lddb,
+                                beta_s,  c_array, lddc,
+                                group_count, info, *queue);
+                        }
 
-                                if (C.op() != Op::NoTrans) {
-                                    swap(m, n);
-                                    swap(a_array, b_array);
-                                    swap(ldda, lddb);
-                                }
+                        for (size_t g = 0; g < group_params.size(); ++g) {
+                            if (! group_params[ g ].is_diagonal)
+                                continue;
 
-                                blas::batch::gemm(
-                                    layout, opA_, opB_,
-                                    m, n, k,
-                                    alpha_s, a_array, ldda,
-                                             b_array, lddb,
-                                    beta_s,  c_array, lddc,
-                                    group_count, info, *queue);
-                            }
-                            a_array_host += group_count;
-                            b_array_host += group_count;
-                            c_array_host += group_count;
+                            int64_t group_count = group_params[ g ].count;
+
+                            std::vector<int64_t>    n(1, group_params[ g ].nb);
+                            std::vector<int64_t> ldda(1, group_params[ g ].ld[1]);
+                            std::vector<int64_t> lddc(1, group_params[ g ].ld[0]);
+                            std::vector<scalar_t*> a_array(a_array_host + offset[ g ], a_array_host + offset[ g+1 ]);
+                            std::vector<scalar_t*> c_array(c_array_host + offset[ g ], c_array_host + offset[ g+1 ]);
+
+                            blas::batch::herk(
+                                layout, uplo, opA_,
+                                n, k,
+                                alpha_r, a_array, ldda,
+                                beta_r,  c_array, lddc,
+                                group_count, info, *diag_queue);
                         }
 
-                        queue->sync();
+                        // Instead of synchronizing, join diag_queue into
+                        // queue and record an event that later users of the
+                        // tiles wait on.
+                        if (diag_queue != queue) {
+                            auto diag_done = DeviceEvent::record( *diag_queue );
+                            if (diag_done != nullptr)
+                                diag_done->wait( *queue );
+                        }
+                        auto event = DeviceEvent::record( *queue );
+                        A.tileRecordEvent( A_tiles_set, device, event, false );
+                        C.tileRecordEvent( C_tiles_set, device, event, true );
                     }
                 }
                 catch (std::exception& e) {
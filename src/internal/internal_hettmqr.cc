@@ -58,18 +58,72 @@ void hettmqr(
              op, V, T, C, tag );
 }
 
+//------------------------------------------------------------------------------
+/// Applies Q from one tpqrt of the reduction tree to the local tiles of C
+/// on one device, as tpmqrt calls on the device's queue.
+/// Same as ttmqr_device, for Hermitian C: the pairs of tiles,
+/// C(i1, j1) received from the src rank and the local C(i, j),
+/// are listed in tiles.
+///
+template <typename scalar_t>
+void hettmqr_device(
+    Side side, Op op,
+    Matrix<scalar_t>& V,
+    Matrix<scalar_t>& T,
+    HermitianMatrix<scalar_t>& C,
+    int64_t iv, int device,
+    std::vector< std::array<int64_t, 4> > const& tiles )
+{
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+    const int queue_0 = 0;
+
+    V.tileGetForReading( iv, 0, device, LayoutConvert( layout ) );
+    T.tileGetForReading( iv, 0, device, LayoutConvert( layout ) );
+
+    int64_t ib = std::min( T.tileMb( iv ), V.tileNb( 0 ) );
+    int64_t work_size = 0;
+    for (auto& ij : tiles) {
+        int64_t i = ij[ 0 ], j = ij[ 1 ], i1 = ij[ 2 ], j1 = ij[ 3 ];
+        C.tileGetForWriting( i,  j,  device, LayoutConvert( layout ) );
+        C.tileGetForWriting( i1, j1, device, LayoutConvert( layout ) );
+        int64_t mn = (side == Side::Left ? C.tileNb( j ) : C.tileMb( i ));
+        work_size = std::max( work_size, 2*ib*mn );
+    }
+
+    blas::Queue* queue = C.compute_queue( device, queue_0 );
+    scalar_t* work = C.allocWorkspaceBuffer( device, work_size );
+
+    int64_t l = std::min( V.tileMb( iv ), V.tileNb( 0 ) );
+    auto V_ii = V( iv, 0, device );
+    auto T_ii = T( iv, 0, device );
+    for (auto& ij : tiles) {
+        int64_t i = ij[ 0 ], j = ij[ 1 ], i1 = ij[ 2 ], j1 = ij[ 3 ];
+        // Apply Q; tiles share work, as they are serialized on queue.
+        tpmqrt( side, op, l, V_ii, T_ii,
+                C( i1, j1, device ), C( i, j, device ),
+                work, *queue );
+    }
+    queue->sync();
+
+    C.freeWorkspaceBuffer( device, work );
+}
+
 //------------------------------------------------------------------------------
 /// Distributed multiply Hermitian matrix on left and right by Q from
 /// QR triangle-triangle factorization of column of tiles.
-/// Host implementation.
+/// Host and GPU device implementation.
+/// With Target::Devices, the off-diagonal updates (steps 2 and 3 below),
+/// which are most of the flops, are done on devices, batched per device;
+/// the 2-by-2 tile diagonal blocks (step 1) are updated on host.
 /// @ingroup heev_internal
 ///
 /// @param tag_base[in]
 ///     This process uses MPI tags from the range [tag_base, tag_base+mt*nt)
 ///
-template <typename scalar_t>
+template <Target target, typename scalar_t>
 void hettmqr(
-    internal::TargetType<Target::HostTask>,
+    internal::TargetType<target>,
     Op op,
     Matrix<scalar_t>& V,
     Matrix<scalar_t>& T,
@@ -232,6 +286,7 @@ void hettmqr(
                     }
                     else {
                         // Send transposed tile.
+                        C.tileGetForWriting(j, i1, LayoutConvert(layout));
                         tile::deepConjTranspose( C(j, i1) );
                         C.tileSend(j, i1, dst, tag);
                     }
@@ -245,6 +300,42 @@ void hettmqr(
                 }
             } // for j
 
+            if (target == Target::Devices) {
+                // Group tile pairs by device of the local tile,
+                // apply Q on devices, then send updated tiles back.
+                std::vector< std::vector< std::array<int64_t, 4> > >
+                    device_tiles( C.num_devices() );
+                for (int64_t j = 0; j < i2; ++j) {
+                    if (j != i1 && C.tileIsLocal(i2, j)) {
+                        device_tiles[ C.tileDevice( i2, j ) ].push_back(
+                            { i2, j, i1, j } );
+                    }
+                }
+
+                #pragma omp taskgroup
+                for (int device = 0; device < C.num_devices(); ++device) {
+                    if (! device_tiles[ device ].empty()) {
+                        #pragma omp task slate_omp_default_none \
+                            shared( V, T, C, device_tiles ) \
+                            firstprivate( op, i2, device )
+                        {
+                            hettmqr_device( Side::Left, op, V, T, C, i2,
+                                            device, device_tiles[ device ] );
+                        }
+                    }
+                }
+
+                for (int64_t j = 0; j < i2; ++j) {
+                    if (j != i1 && C.tileIsLocal(i2, j)) {
+                        int src = (i1 >= j
+                                  ? C.tileRank(i1, j)
+                                  : C.tileRank(j, i1));
+                        int tag = tag_base + i1 + j*C.mt();
+                        C.tileSend(i1, j, src, tag);
+                    }
+                }
+            }
+            else
             for (int64_t j = 0; j < i2; ++j) {
                 if (j == i1)
                     continue;
@@ -301,6 +392,8 @@ void hettmqr(
 
             //--------------------
             // 3: Multiply [ C(i, j1)  C(i, j2) ] * Q for i = j2+1, ..., mt-1.
+            std::vector< std::vector< std::array<int64_t, 4> > >
+                device_tiles( C.num_devices() );
             for (int64_t i = j2+1; i < C.mt(); ++i) {
                 int tag = tag_base + i + j1*C.mt();
                 if (C.tileIsLocal(i, j1)) {
@@ -308,12 +401,17 @@ void hettmqr(
                     int dst = C.tileRank(i, j2);
                     MPI_Request req;
                     C.tileIsend( i, j1, dst, tag, &req );
-                    MPI_Request_free( &req );
+                    slate_mpi_call( MPI_Request_free( &req ) );
                 }
                 else if (C.tileIsLocal(i, j2)) {
                     // Second node of each pair receives tile from src.
                     int src = C.tileRank(i, j1);
                     C.tileRecv(i, j1, src, layout, tag);
+                    if (target == Target::Devices) {
+                        device_tiles[ C.tileDevice( i, j2 ) ].push_back(
+                            { i, j2, i, j1 } );
+                        continue;
+                    }
                     // Applies Q, then sends updated tile back.
                     #pragma omp task shared( V, T, C ) firstprivate( src, tag )
                     {
@@ -330,6 +428,30 @@ void hettmqr(
                 }
             } // for i
 
+            if (target == Target::Devices) {
+                // Apply Q on devices, then send updated tiles back.
+                #pragma omp taskgroup
+                for (int device = 0; device < C.num_devices(); ++device) {
+                    if (! device_tiles[ device ].empty()) {
+                        #pragma omp task slate_omp_default_none \
+                            shared( V, T, C, device_tiles ) \
+                            firstprivate( opR, j2, device )
+                        {
+                            hettmqr_device( Side::Right, opR, V, T, C, j2,
+                                            device, device_tiles[ device ] );
+                        }
+                    }
+                }
+
+                for (int64_t i = j2+1; i < C.mt(); ++i) {
+                    if (! C.tileIsLocal(i, j1) && C.tileIsLocal(i, j2)) {
+                        int src = C.tileRank(i, j1);
+                        int tag = tag_base + i + j1*C.mt();
+                        C.tileSend(i, j1, src, tag);
+                    }
+                }
+            }
+
             for (int64_t i = j2+1; i < C.mt(); ++i) {
                 int tag = tag_base + i + j1*C.mt();
                 if (C.tileIsLocal(i, j1)) {
@@ -341,8 +463,7 @@ void hettmqr(
                 }
             } // for i
         } // for index
-        slate_mpi_call(
-            MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
+        internal::comm_waitall( requests.size(), requests.data() );
         #pragma omp taskwait
 
         //--------------------
@@ -365,6 +486,15 @@ void hettmqr<Target::HostTask, float>(
     HermitianMatrix<float>&& C,
     int tag );
 
+// ----------------------------------------
+template
+void hettmqr<Target::Devices, float>(
+    Op op,
+    Matrix<float>&& V,
+    Matrix<float>&& T,
+    HermitianMatrix<float>&& C,
+    int tag );
+
 // ----------------------------------------
 template
 void hettmqr<Target::HostTask, double>(
@@ -374,6 +504,15 @@ void hettmqr<Target::HostTask, double>(
     HermitianMatrix<double>&& C,
     int tag );
 
+// ----------------------------------------
+template
+void hettmqr<Target::Devices, double>(
+    Op op,
+    Matrix<double>&& V,
+    Matrix<double>&& T,
+    HermitianMatrix<double>&& C,
+    int tag );
+
 // ----------------------------------------
 template
 void hettmqr< Target::HostTask, std::complex<float> >(
@@ -383,6 +522,15 @@ void hettmqr< Target::HostTask, std::complex<float> >(
     HermitianMatrix< std::complex<float> >&& C,
     int tag );
 
+// ----------------------------------------
+template
+void hettmqr< Target::Devices, std::complex<float> >(
+    Op op,
+    Matrix< std::complex<float> >&& V,
+    Matrix< std::complex<float> >&& T,
+    HermitianMatrix< std::complex<float> >&& C,
+    int tag );
+
 // ----------------------------------------
 template
 void hettmqr< Target::HostTask, std::complex<double> >(
@@ -392,5 +540,14 @@ void hettmqr< Target::HostTask, std::complex<double> >(
     HermitianMatrix< std::complex<double> >&& C,
     int tag );
 
+// ----------------------------------------
+template
+void hettmqr< Target::Devices, std::complex<double> >(
+    Op op,
+    Matrix< std::complex<double> >&& V,
+    Matrix< std::complex<double> >&& T,
+    HermitianMatrix< std::complex<double> >&& C,
+    int tag );
+
 } // namespace internal
 } // namespace slate
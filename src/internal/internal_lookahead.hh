@@ -0,0 +1,160 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+#ifndef SLATE_INTERNAL_LOOKAHEAD_HH
+#define SLATE_INTERNAL_LOOKAHEAD_HH
+
+#include "slate/Exception.hh"
+#include "slate/internal/mpi.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Lookahead depth of a right-looking factorization, either fixed
+/// (Option::Lookahead), or adapted per step k between 1 and
+/// Option::MaxLookahead from the measured panel and trailing update times.
+///
+/// The adapted depth targets ceil( update time / panel time ), so panels
+/// run ahead of a long trailing update, and the lookahead shrinks as the
+/// trailing matrix does. It changes by at most one per step, so the
+/// drivers' column dependencies stay sufficient:
+/// - when it shrinks, the trailing update of step k covers the same
+///   columns as that of step k-1;
+/// - when it grows, the column joining the lookahead was in the trailing
+///   update of step k-1; see follows_trailing.
+///
+/// The depth determines the messages and their tags, so all ranks must
+/// agree on it: the ranks' targets are reduced (max) at each step, on
+/// a duplicate of the matrix's communicator that is used only by the
+/// master thread, and never concurrently with other collectives.
+///
+/// Constructor and destructor are collective over the communicator.
+///
+class Lookahead
+{
+public:
+    //--------------------------------------------------------------------------
+    /// @param[in] lookahead
+    ///     Initial depth, from Option::Lookahead.
+    ///
+    /// @param[in] max_lookahead
+    ///     Maximum depth, from Option::MaxLookahead. If <= lookahead,
+    ///     the depth is fixed at lookahead.
+    ///
+    /// @param[in] mpi_comm
+    ///     Communicator of the matrix.
+    ///
+    Lookahead( int64_t lookahead, int64_t max_lookahead, MPI_Comm mpi_comm )
+        : depth_( lookahead ),
+          prev_depth_( lookahead ),
+          min_depth_( std::min( lookahead, int64_t( 1 ) ) ),
+          max_depth_( std::max( lookahead, max_lookahead ) ),
+          adaptive_( max_lookahead > lookahead ),
+          panel_time_( 0.0 ),
+          update_time_( 0.0 ),
+          mpi_comm_( MPI_COMM_NULL )
+    {
+        if (adaptive())
+            slate_mpi_call( MPI_Comm_dup( mpi_comm, &mpi_comm_ ) );
+    }
+
+    ~Lookahead()
+    {
+        if (mpi_comm_ != MPI_COMM_NULL)
+            MPI_Comm_free( &mpi_comm_ );
+    }
+
+    Lookahead( Lookahead const& ) = delete;
+    Lookahead& operator=( Lookahead const& ) = delete;
+
+    /// @return true if the depth is adapted per step.
+    bool adaptive() const { return adaptive_; }
+
+    /// @return lookahead depth of the current step.
+    int64_t depth() const { return depth_; }
+
+    //--------------------------------------------------------------------------
+    /// Chooses the depth of step k, from the latest panel and trailing update
+    /// times recorded so far. Collective; called by the master thread at the
+    /// start of each step.
+    /// @return depth of step k.
+    ///
+    int64_t next( int64_t k )
+    {
+        prev_depth_ = depth_;
+        if (! adaptive() || k == 0)
+            return depth_;
+
+        double panel_time, update_time;
+        #pragma omp atomic read
+        panel_time = panel_time_;
+        #pragma omp atomic read
+        update_time = update_time_;
+
+        // Each rank's target depth, or -1 without both times yet.
+        int target = -1;
+        if (panel_time > 0 && update_time > 0) {
+            double ratio = std::ceil( update_time / panel_time );
+            target = int( std::max( double( min_depth_ ),
+                                    std::min( ratio, double( max_depth_ ) ) ) );
+        }
+        int max_target;
+        slate_mpi_call(
+            MPI_Allreduce( &target, &max_target, 1, MPI_INT, MPI_MAX,
+                           mpi_comm_ ) );
+
+        if (max_target >= 0) {
+            if (max_target > depth_)
+                ++depth_;
+            else if (max_target < depth_)
+                --depth_;
+        }
+        return depth_;
+    }
+
+    //--------------------------------------------------------------------------
+    /// @return true if the lookahead update of column j in step k must also
+    /// follow the trailing update of step k-1, i.e., depend on column nt-1,
+    /// because column j joined the lookahead this step.
+    ///
+    bool follows_trailing( int64_t k, int64_t j, int64_t nt ) const
+    {
+        return j > k + prev_depth_ && j < nt-1;
+    }
+
+    /// Records the time of a panel; called from its task.
+    void panel_time( double time )
+    {
+        #pragma omp atomic write
+        panel_time_ = time;
+    }
+
+    /// Records the time of a trailing update; called from its task.
+    void update_time( double time )
+    {
+        #pragma omp atomic write
+        update_time_ = time;
+    }
+
+private:
+    int64_t depth_;
+    int64_t prev_depth_;
+    int64_t min_depth_;
+    int64_t max_depth_;
+    bool adaptive_;
+    double panel_time_;
+    double update_time_;
+    MPI_Comm mpi_comm_;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_LOOKAHEAD_HH
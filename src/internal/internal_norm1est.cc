@@ -469,6 +469,273 @@ void norm1est(
     }
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel block estimate of the 1-norm of a square matrix B,
+/// with t vectors at a time (Higham and Tisseur, 2000).
+///
+/// Unlike norm1est, which uses reverse communication with one vector,
+/// this calls apply to overwrite an n-by-t X with B X or $B^H$ X, so each
+/// iteration does one multi-RHS solve, e.g., getrs or potrs, instead of t.
+/// Column norms, signs, and the search for the t largest rows are reduced
+/// with one or two small MPI_Allreduce or MPI_Allgather per iteration.
+/// t = 2 usually gives an estimate within a factor 3 of the 1-norm,
+/// in fewer iterations than norm1est.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] X
+///     The n-by-t workspace matrix X, in one block column, with tiles
+///     inserted on the host. t <= n.
+///
+/// @param[in] apply
+///     apply( op, X ) overwrites X with op(B) X, op NoTrans or ConjTrans.
+///     Collective.
+///
+/// @return an estimate of $\norm{B}_1$.
+///
+/// @ingroup cond_internal
+///
+template <typename scalar_t>
+blas::real_type<scalar_t> norm1est_block(
+    Matrix<scalar_t>& X,
+    std::function< void (Op, Matrix<scalar_t>&) > const& apply )
+{
+    using real_t = blas::real_type<scalar_t>;
+    const auto mpi_real_type = mpi_type<real_t>::value;
+    const real_t safmin = std::numeric_limits< real_t >::min();
+
+    const scalar_t one  = 1.0;
+    const scalar_t zero = 0.0;
+    const LayoutConvert layout = LayoutConvert::ColMajor;
+    const int itmax = 5;
+
+    assert( X.nt() == 1 );
+
+    int64_t n  = X.m();
+    int64_t t  = X.n();
+    int64_t mt = X.mt();
+    MPI_Comm comm = X.mpiComm();
+    auto row_offset = internal::tile_offsets( RowCol::Row, X );
+
+    // Deterministic pseudo-random +-1 from (row, col), same on all ranks.
+    auto rand_sign = []( int64_t i, int64_t j ) {
+        uint64_t z = uint64_t( i ) * 0x9E3779B97F4A7C15ull + uint64_t( j );
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return ((z ^ (z >> 31)) & 1) ? real_t( 1 ) : real_t( -1 );
+    };
+
+    // Calls f( X(i, 0) ) for each local tile i, for writing.
+    auto for_local = [&]( Matrix<scalar_t>& Y, auto&& f ) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (Y.tileIsLocal( i, 0 )) {
+                Y.tileGetForWriting( i, 0, layout );
+                f( i, Y( i, 0 ) );
+            }
+        }
+    };
+
+    // X = [ 1, rand(+-1), ... ] / n, so each column has 1-norm 1.
+    for_local( X, [&]( int64_t i, Tile<scalar_t> T ) {
+        for (int64_t jj = 0; jj < t; ++jj) {
+            for (int64_t ii = 0; ii < T.mb(); ++ii) {
+                real_t s = jj == 0 ? 1 : rand_sign( row_offset[ i ] + ii, jj );
+                T.at( ii, jj ) = s / real_t( n );
+            }
+        }
+    } );
+
+    // Signs of the previous iteration, to detect convergence (real only).
+    Matrix<scalar_t> S_old = X.emptyLike();
+    S_old.insertLocalTiles( Target::Host );
+    slate::set( zero, zero, S_old );
+
+    std::vector<int64_t> ind( t ), ind_hist;
+    for (int64_t j = 0; j < t; ++j)
+        ind[ j ] = -1;
+    int64_t ind_best = -1;
+    real_t est = 0, est_old = 0;
+
+    for (int k = 1; ; ++k) {
+        // Y = B X; est = largest column 1-norm of Y.
+        apply( Op::NoTrans, X );
+        std::vector<real_t> col_norms( t, 0 );
+        for_local( X, [&]( int64_t i, Tile<scalar_t> T ) {
+            for (int64_t jj = 0; jj < t; ++jj) {
+                for (int64_t ii = 0; ii < T.mb(); ++ii)
+                    col_norms[ jj ] += std::abs( T.at( ii, jj ) );
+            }
+        } );
+        slate_mpi_call(
+            MPI_Allreduce( MPI_IN_PLACE, col_norms.data(), t, mpi_real_type,
+                           MPI_SUM, comm ) );
+        int64_t j_best = std::max_element( col_norms.begin(), col_norms.end() )
+                       - col_norms.begin();
+        est = col_norms[ j_best ];
+        if (est > est_old || k == 2)
+            ind_best = ind[ j_best ];
+        if (k >= 2 && est <= est_old) {
+            est = est_old;
+            break;
+        }
+        est_old = est;
+        if (k > itmax)
+            break;
+
+        // S = sign(Y).
+        for_local( X, [&]( int64_t i, Tile<scalar_t> T ) {
+            for (int64_t jj = 0; jj < t; ++jj) {
+                for (int64_t ii = 0; ii < T.mb(); ++ii) {
+                    real_t absy = std::abs( T.at( ii, jj ) );
+                    if constexpr (blas::is_complex<scalar_t>::value)
+                        T.at( ii, jj ) = absy > safmin ? T.at( ii, jj ) / absy
+                                                       : one;
+                    else
+                        T.at( ii, jj ) = T.at( ii, jj ) >= zero ? one : -one;
+                }
+            }
+        } );
+
+        if constexpr (! blas::is_complex<scalar_t>::value) {
+            // G = S^T [ S_old, S ]; columns are parallel if |G(j, l)| = n.
+            std::vector<scalar_t> G( t*2*t, zero );
+            for (int64_t i = 0; i < mt; ++i) {
+                if (X.tileIsLocal( i, 0 )) {
+                    auto S  = X( i, 0 );
+                    auto So = S_old( i, 0 );
+                    blas::gemm( blas::Layout::ColMajor, Op::Trans, Op::NoTrans,
+                                t, t, S.mb(),
+                                one, S.data(), S.stride(), So.data(), So.stride(),
+                                one, &G[ 0 ], t );
+                    blas::gemm( blas::Layout::ColMajor, Op::Trans, Op::NoTrans,
+                                t, t, S.mb(),
+                                one, S.data(), S.stride(), S.data(), S.stride(),
+                                one, &G[ t*t ], t );
+                }
+            }
+            slate_mpi_call(
+                MPI_Allreduce( MPI_IN_PLACE, G.data(), G.size(),
+                               mpi_type<scalar_t>::value, MPI_SUM, comm ) );
+            auto parallel = [&]( int64_t j, int64_t l ) {
+                return std::abs( G[ j + l*t ] ) >= real_t( n ) - real_t( 0.5 );
+            };
+
+            // Converged if every column of S is parallel to one of S_old.
+            bool all_parallel = true;
+            for (int64_t j = 0; j < t && all_parallel; ++j) {
+                bool any = false;
+                for (int64_t l = 0; l < t; ++l)
+                    any = any || parallel( j, l );
+                all_parallel = any;
+            }
+            if (all_parallel)
+                break;
+
+            // Replace columns parallel to S_old or an earlier column of S.
+            std::vector<bool> resample( t, false );
+            for (int64_t j = 0; j < t; ++j) {
+                for (int64_t l = 0; l < t + j; ++l)
+                    resample[ j ] = resample[ j ] || parallel( j, l );
+            }
+            for_local( X, [&]( int64_t i, Tile<scalar_t> T ) {
+                for (int64_t jj = 0; jj < t; ++jj) {
+                    if (resample[ jj ]) {
+                        for (int64_t ii = 0; ii < T.mb(); ++ii)
+                            T.at( ii, jj ) = rand_sign( row_offset[ i ] + ii,
+                                                        k*t + jj );
+                    }
+                }
+            } );
+            copy( X, S_old );
+        }
+
+        // Z = B^H S; h_i = max_j |Z(i, j)|.
+        apply( Op::ConjTrans, X );
+        std::vector< std::pair<real_t, int64_t> > h;
+        for_local( X, [&]( int64_t i, Tile<scalar_t> T ) {
+            for (int64_t ii = 0; ii < T.mb(); ++ii) {
+                real_t h_i = 0;
+                for (int64_t jj = 0; jj < t; ++jj)
+                    h_i = std::max( h_i, real_t( std::abs( T.at( ii, jj ) ) ) );
+                h.push_back( { h_i, row_offset[ i ] + ii } );
+            }
+        } );
+
+        // Stop if the best row so far is still the largest.
+        real_t h_max[ 2 ] = { 0, 0 };
+        for (auto& h_i : h) {
+            h_max[ 0 ] = std::max( h_max[ 0 ], h_i.first );
+            if (h_i.second == ind_best)
+                h_max[ 1 ] = h_i.first;
+        }
+        slate_mpi_call(
+            MPI_Allreduce( MPI_IN_PLACE, h_max, 2, mpi_real_type,
+                           MPI_MAX, comm ) );
+        if (k >= 2 && h_max[ 0 ] == h_max[ 1 ])
+            break;
+
+        // t largest h_i not used before: local candidates, then gathered.
+        std::sort( h.begin(), h.end(), [] ( auto& a, auto& b ) {
+            return a.first > b.first
+                   || (a.first == b.first && a.second < b.second);
+        } );
+        std::vector<real_t> cand_h( t, -1 );
+        std::vector<int64_t> cand_i( t, -1 );
+        int64_t c = 0;
+        for (auto& h_i : h) {
+            if (c == t)
+                break;
+            if (std::find( ind_hist.begin(), ind_hist.end(), h_i.second )
+                == ind_hist.end()) {
+                cand_h[ c ] = h_i.first;
+                cand_i[ c ] = h_i.second;
+                ++c;
+            }
+        }
+        int mpi_size;
+        slate_mpi_call(
+            MPI_Comm_size( comm, &mpi_size ) );
+        std::vector<real_t> all_h( t*mpi_size );
+        std::vector<int64_t> all_i( t*mpi_size );
+        slate_mpi_call(
+            MPI_Allgather( cand_h.data(), t, mpi_real_type,
+                           all_h.data(), t, mpi_real_type, comm ) );
+        slate_mpi_call(
+            MPI_Allgather( cand_i.data(), t, MPI_INT64_T,
+                           all_i.data(), t, MPI_INT64_T, comm ) );
+        h.clear();
+        for (int64_t l = 0; l < t*mpi_size; ++l) {
+            if (all_i[ l ] >= 0)
+                h.push_back( { all_h[ l ], all_i[ l ] } );
+        }
+        if (h.empty())
+            break;
+        std::sort( h.begin(), h.end(), [] ( auto& a, auto& b ) {
+            return a.first > b.first
+                   || (a.first == b.first && a.second < b.second);
+        } );
+
+        // X = [ e_ind(0), ..., e_ind(t-1) ]; extra columns are zero.
+        for (int64_t j = 0; j < t; ++j) {
+            ind[ j ] = j < int64_t( h.size() ) ? h[ j ].second : -1;
+            if (ind[ j ] >= 0)
+                ind_hist.push_back( ind[ j ] );
+        }
+        for_local( X, [&]( int64_t i, Tile<scalar_t> T ) {
+            T.set( zero );
+            for (int64_t jj = 0; jj < t; ++jj) {
+                int64_t ii = ind[ jj ] - row_offset[ i ];
+                if (0 <= ii && ii < T.mb())
+                    T.at( ii, jj ) = one;
+            }
+        } );
+    }
+
+    return est;
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -508,5 +775,26 @@ void norm1est< std::complex<double> >(
     int* kase,
     std::vector<int64_t>& isave );
 
+//------------------------------------------------------------------------------
+template
+float norm1est_block<float>(
+    Matrix<float>& X,
+    std::function< void (Op, Matrix<float>&) > const& apply );
+
+template
+double norm1est_block<double>(
+    Matrix<double>& X,
+    std::function< void (Op, Matrix<double>&) > const& apply );
+
+template
+float norm1est_block< std::complex<float> >(
+    Matrix< std::complex<float> >& X,
+    std::function< void (Op, Matrix< std::complex<float> >&) > const& apply );
+
+template
+double norm1est_block< std::complex<double> >(
+    Matrix< std::complex<double> >& X,
+    std::function< void (Op, Matrix< std::complex<double> >&) > const& apply );
+
 } // namespace internal
 } // namespace slate
@@ -3,9 +3,11 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "slate/internal/device.hh"
 #include "slate/Matrix.hh"
 #include "slate/HermitianMatrix.hh"
 #include "slate/types.hh"
+#include "slate/FlopStats.hh"
 #include "internal/Tile_lapack.hh"
 #include "internal/internal.hh"
 
@@ -23,6 +25,13 @@ int64_t potrf(
     int priority, int64_t queue_index,
     lapack::device_info_int* device_info)
 {
+    // Flops of the tile, n^3 / 3, if local.
+    FlopCounter flop_counter( FlopRoutine::Potrf, target, [&]() {
+        double n = A.tileNb( 0 );
+        double flops = A.tileIsLocal( 0, 0 ) ? n * n * n / 3 : 0;
+        return flops * flop_scale<scalar_t>();
+    } );
+
     return potrf( internal::TargetType<target>(), A, priority,
                   queue_index, device_info );
 }
@@ -80,6 +89,64 @@ int64_t potrf(
     return info;
 }
 
+//------------------------------------------------------------------------------
+/// Cholesky factorization of single tile, also computing the inverse of
+/// its Cholesky factor in one fused launch.
+/// Dispatches to target implementations; only Target::Devices is provided.
+/// @ingroup posv_internal
+///
+template <Target target, typename scalar_t>
+int64_t potrf_trtri(
+    HermitianMatrix< scalar_t >&& A,
+    HermitianMatrix< scalar_t >&& Ainv,
+    int priority, int64_t queue_index,
+    lapack::device_info_int* device_info)
+{
+    return potrf_trtri( internal::TargetType<target>(), A, Ainv, priority,
+                        queue_index, device_info );
+}
+
+//------------------------------------------------------------------------------
+/// Cholesky factorization of single tile and inverse of its Cholesky
+/// factor, device implementation.
+/// On exit, A(0, 0) holds the factor L (or U), and Ainv(0, 0), which must
+/// already exist on the same device as A(0, 0), holds L^{-1} (or U^{-1})
+/// with the opposite triangle set to zero.
+/// If info > 0, the contents of Ainv(0, 0) are undefined.
+/// @ingroup posv_internal
+///
+template <typename scalar_t>
+int64_t potrf_trtri(
+    internal::TargetType<Target::Devices>,
+    HermitianMatrix<scalar_t>& A,
+    HermitianMatrix<scalar_t>& Ainv,
+    int priority, int64_t queue_index,
+    lapack::device_info_int* device_info)
+{
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+    assert(Ainv.mt() == 1);
+    assert(Ainv.nt() == 1);
+
+    int64_t info = 0;
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice( 0, 0 );
+        A.tileGetForWriting(0, 0, device, LayoutConvert::ColMajor);
+        Ainv.tileGetForWriting(0, 0, device, LayoutConvert::ColMajor);
+        lapack::Queue* queue = A.compute_queue( device, queue_index );
+        auto A00 = A( 0, 0, device );
+        auto Ainv00 = Ainv( 0, 0, device );
+        device::potrf_trtri(
+            A00.uploPhysical(), A00.mb(), A00.data(), A00.stride(),
+            Ainv00.data(), Ainv00.stride(), device_info, *queue );
+        lapack::device_info_int host_info;
+        blas::device_memcpy( &host_info, device_info, 1, *queue );
+        queue->sync();
+        info = int64_t( host_info );
+    }
+    return info;
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
@@ -137,5 +204,37 @@ int64_t potrf< Target::Devices, std::complex<double> >(
     int priority, int64_t queue_index,
     lapack::device_info_int* device_info);
 
+// ----------------------------------------
+template
+int64_t potrf_trtri<Target::Devices, float>(
+    HermitianMatrix<float>&& A,
+    HermitianMatrix<float>&& Ainv,
+    int priority, int64_t queue_index,
+    lapack::device_info_int* device_info);
+
+// ----------------------------------------
+template
+int64_t potrf_trtri<Target::Devices, double>(
+    HermitianMatrix<double>&& A,
+    HermitianMatrix<double>&& Ainv,
+    int priority, int64_t queue_index,
+    lapack::device_info_int* device_info);
+
+// ----------------------------------------
+template
+int64_t potrf_trtri< Target::Devices, std::complex<float> >(
+    HermitianMatrix< std::complex<float> >&& A,
+    HermitianMatrix< std::complex<float> >&& Ainv,
+    int priority, int64_t queue_index,
+    lapack::device_info_int* device_info);
+
+// ----------------------------------------
+template
+int64_t potrf_trtri< Target::Devices, std::complex<double> >(
+    HermitianMatrix< std::complex<double> >&& A,
+    HermitianMatrix< std::complex<double> >&& Ainv,
+    int priority, int64_t queue_index,
+    lapack::device_info_int* device_info);
+
 } // namespace internal
 } // namespace slate
@@ -0,0 +1,221 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Matrix.hh"
+#include "slate/types.hh"
+#include "internal/Tile_potrf_update.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Cholesky update or downdate of the diagonal tile of a factor.
+/// Dispatches to target implementations.
+/// @ingroup posv_internal
+///
+template <Target target, typename scalar_t>
+int64_t potrf_update_diag(
+    blas::real_type<scalar_t> sign,
+    Matrix<scalar_t>&& A,
+    Matrix<scalar_t>&& X,
+    int priority)
+{
+    return potrf_update_diag( internal::TargetType<target>(),
+                              sign, A, X, priority );
+}
+
+//------------------------------------------------------------------------------
+/// Cholesky update or downdate of the diagonal tile of a factor,
+/// host implementation.
+/// The rank owning A(0, 0) must hold the block row X(0, :) of the update.
+/// On exit, X(0, :) holds the rotations; see tile::potrf_update_diag().
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in,out] A
+///     The 1-by-1 tile diagonal block of the lower triangular factor.
+///
+/// @param[in,out] X
+///     The 1-by-kt block row of the update.
+///
+/// @return 0 if successful, or p > 0 if the downdated matrix is not
+///     positive definite at column p (1-based index) of A.
+///
+/// @ingroup posv_internal
+///
+template <typename scalar_t>
+int64_t potrf_update_diag(
+    internal::TargetType<Target::HostTask>,
+    blas::real_type<scalar_t> sign,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& X,
+    int priority)
+{
+    assert( A.mt() == 1 );
+    assert( A.nt() == 1 );
+    assert( X.mt() == 1 );
+
+    int64_t info = 0;
+    if (A.tileIsLocal( 0, 0 )) {
+        A.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
+        // Columns of X in turn, as one rank-1 update each.
+        for (int64_t c = 0; c < X.nt() && info == 0; ++c) {
+            X.tileGetForWriting( 0, c, LayoutConvert::ColMajor );
+            info = tile::potrf_update_diag( sign, A( 0, 0 ), X( 0, c ) );
+        }
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations of a Cholesky update or downdate to a block
+/// column of a factor below the diagonal, and the update rows.
+/// Dispatches to target implementations.
+/// @ingroup posv_internal
+///
+template <Target target, typename scalar_t>
+void potrf_update_apply(
+    blas::real_type<scalar_t> sign,
+    Matrix<scalar_t>&& S,
+    Matrix<scalar_t>&& A,
+    Matrix<scalar_t>&& X,
+    int priority)
+{
+    potrf_update_apply( internal::TargetType<target>(),
+                        sign, S, A, X, priority );
+}
+
+//------------------------------------------------------------------------------
+/// Applies the rotations of a Cholesky update or downdate,
+/// host OpenMP task implementation.
+/// Each rank owning a tile A(i, 0) must hold the block row X(i, :) of the
+/// update, and the rotations S.
+///
+/// @param[in] sign
+///     1 for an update, -1 for a downdate.
+///
+/// @param[in] S
+///     The 1-by-kt block row of rotations, from potrf_update_diag().
+///
+/// @param[in,out] A
+///     The mt-by-1 block column of the factor below the diagonal.
+///
+/// @param[in,out] X
+///     The mt-by-kt block rows of the update.
+///
+/// @ingroup posv_internal
+///
+template <typename scalar_t>
+void potrf_update_apply(
+    internal::TargetType<Target::HostTask>,
+    blas::real_type<scalar_t> sign,
+    Matrix<scalar_t>& S,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& X,
+    int priority)
+{
+    assert( A.nt() == 1 );
+    assert( S.mt() == 1 );
+    assert( X.mt() == A.mt() );
+    assert( X.nt() == S.nt() );
+
+    bool any_local = false;
+    for (int64_t i = 0; i < A.mt(); ++i)
+        any_local = any_local || A.tileIsLocal( i, 0 );
+    if (! any_local)
+        return;
+
+    for (int64_t c = 0; c < S.nt(); ++c)
+        S.tileGetForReading( 0, c, LayoutConvert::ColMajor );
+
+    #pragma omp taskgroup
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        if (A.tileIsLocal( i, 0 )) {
+            #pragma omp task slate_omp_default_none \
+                shared( S, A, X ) firstprivate( i, sign ) \
+                priority( priority )
+            {
+                A.tileGetForWriting( i, 0, LayoutConvert::ColMajor );
+                // Columns of X in turn, as in potrf_update_diag.
+                for (int64_t c = 0; c < X.nt(); ++c) {
+                    X.tileGetForWriting( i, c, LayoutConvert::ColMajor );
+                    tile::potrf_update_apply(
+                        sign, S( 0, c ), A( i, 0 ), X( i, c ) );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+int64_t potrf_update_diag<Target::HostTask, float>(
+    float sign,
+    Matrix<float>&& A,
+    Matrix<float>&& X,
+    int priority);
+
+template
+void potrf_update_apply<Target::HostTask, float>(
+    float sign,
+    Matrix<float>&& S,
+    Matrix<float>&& A,
+    Matrix<float>&& X,
+    int priority);
+
+// ----------------------------------------
+template
+int64_t potrf_update_diag<Target::HostTask, double>(
+    double sign,
+    Matrix<double>&& A,
+    Matrix<double>&& X,
+    int priority);
+
+template
+void potrf_update_apply<Target::HostTask, double>(
+    double sign,
+    Matrix<double>&& S,
+    Matrix<double>&& A,
+    Matrix<double>&& X,
+    int priority);
+
+// ----------------------------------------
+template
+int64_t potrf_update_diag< Target::HostTask, std::complex<float> >(
+    float sign,
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& X,
+    int priority);
+
+template
+void potrf_update_apply< Target::HostTask, std::complex<float> >(
+    float sign,
+    Matrix< std::complex<float> >&& S,
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& X,
+    int priority);
+
+// ----------------------------------------
+template
+int64_t potrf_update_diag< Target::HostTask, std::complex<double> >(
+    double sign,
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& X,
+    int priority);
+
+template
+void potrf_update_apply< Target::HostTask, std::complex<double> >(
+    double sign,
+    Matrix< std::complex<double> >&& S,
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& X,
+    int priority);
+
+} // namespace internal
+} // namespace slate
@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+#ifndef SLATE_INTERNAL_PRIORITY_HH
+#define SLATE_INTERNAL_PRIORITY_HH
+
+#include "slate/internal/openmp.hh"
+
+#include <cstdint>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Kinds of tasks in step k of a right-looking factorization, by their
+/// distance to the end of the task graph, in half steps: the critical path
+/// runs panel k, lookahead k (column k+1), panel k+1, ..., while the
+/// trailing update of step k feeds the lookahead of a later step.
+/// @see task_priority
+enum class TaskKind {
+    Panel     = 0,
+    Lookahead = 1,
+    Trailing  = 3,
+};
+
+//------------------------------------------------------------------------------
+/// @return OpenMP task priority of a task of the given kind in step k
+/// of a factorization with nt steps, from its distance to the end of the
+/// task graph: panel k > lookahead k > trailing k, and each decays with k,
+/// so panel k+1 still outranks trailing k. Scaled to
+/// [0, omp_get_max_task_priority()], which is 0 unless
+/// OMP_MAX_TASK_PRIORITY is set; then all priorities are 0.
+/// Tasks off the critical path, such as pivoting to the left and releasing
+/// workspace, keep priority 0.
+///
+/// Drivers compute the priorities of the panel, lookahead, and trailing
+/// tasks once per step, and pass them on to the internal routines those
+/// tasks call, so nested tasks inherit them.
+///
+/// @param[in] kind
+///     Kind of task.
+///
+/// @param[in] k
+///     Step of the task, 0 <= k < nt.
+///
+/// @param[in] nt
+///     Number of steps, usually min( mt, nt ) of the matrix.
+///
+inline int task_priority( TaskKind kind, int64_t k, int64_t nt )
+{
+    int max_priority = omp_get_max_task_priority();
+    if (max_priority <= 0 || nt <= 0)
+        return 0;
+
+    int64_t levels = 2*nt;
+    int64_t depth = 2*(nt - k) - int64_t( kind );
+    if (depth <= 0)
+        return 0;
+    // Round up, so only depth 0 gets priority 0.
+    return int( (depth*max_priority + levels - 1) / levels );
+}
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_PRIORITY_HH
@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+#ifndef SLATE_INTERNAL_QUEUE_HH
+#define SLATE_INTERNAL_QUEUE_HH
+
+#include "slate/BaseMatrix.hh"
+#include "slate/enums.hh"
+
+#include <cstdint>
+
+namespace slate {
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Compute queue and batch arrays used by a device task of an internal
+/// routine. With queue_index = AnyQueue, leases a free queue from the
+/// matrix's pool for the lifetime of the object; otherwise uses the fixed
+/// queue and batch arrays queue_index, as before.
+///
+/// Work left on a leased queue must be covered by events recorded on its
+/// tiles, or synchronized, before the object is destroyed, since the
+/// queue then goes to the next task.
+///
+template <typename scalar_t>
+class QueueLease {
+public:
+    QueueLease( BaseMatrix<scalar_t>& A, int device, int64_t queue_index )
+        : A_( A )
+    {
+        if (queue_index == AnyQueue) {
+            pooled_ = A.acquireComputeQueue( device );
+            queue_      = pooled_->queue;
+            array_host_ = pooled_->array_host;
+            array_dev_  = pooled_->array_dev;
+            index_      = A.numComputeQueues() + pooled_->index;
+        }
+        else {
+            queue_      = A.compute_queue( device, queue_index );
+            array_host_ = A.array_host( device, queue_index );
+            array_dev_  = A.array_device( device, queue_index );
+            index_      = int( queue_index );
+        }
+    }
+
+    ~QueueLease()
+    {
+        if (pooled_ != nullptr)
+            A_.releaseComputeQueue( pooled_ );
+    }
+
+    QueueLease( QueueLease const& ) = delete;
+    QueueLease& operator=( QueueLease const& ) = delete;
+
+    /// @return the compute queue.
+    lapack::Queue* queue() const { return queue_; }
+
+    /// @return the batch arrays on host, to send to device.
+    scalar_t** array_host() const { return array_host_; }
+
+    /// @return the batch arrays on device.
+    scalar_t** array_device() const { return array_dev_; }
+
+    /// @return index of the queue, for tracing; pooled queues follow the
+    /// fixed ones.
+    int index() const { return index_; }
+
+private:
+    BaseMatrix<scalar_t>& A_;
+    typename MatrixStorage<scalar_t>::PooledQueue* pooled_ = nullptr;
+    lapack::Queue* queue_;
+    scalar_t** array_host_;
+    scalar_t** array_dev_;
+    int index_;
+};
+
+} // namespace internal
+} // namespace slate
+
+#endif // SLATE_INTERNAL_QUEUE_HH
@@ -3,12 +3,15 @@
 // This program is free software: you can redistribute it and/or modify it under
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
+#include "slate/internal/device.hh"
 #include "slate/Matrix.hh"
 #include "slate/types.hh"
 #include "internal/internal.hh"
 #include "internal/internal_swap.hh"
 
+#include <algorithm>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace slate {
@@ -113,7 +116,6 @@ void permuteRows(
             int64_t nb = A.tileNb(j);
 
             std::vector<MPI_Request> requests;
-            std::vector<MPI_Status> statuses;
 
             // Make copies of src rows.
             // Make room for dst rows.
@@ -156,23 +158,24 @@ void permuteRows(
 
                     requests.resize(requests.size()+1);
                     int dest = A.tileRank(pivot.first.tileIndex(), j);
-                    MPI_Isend(src_rows[pivot.second].data(), nb,
-                              mpi_type<scalar_t>::value, dest, tag, A.mpiComm(),
-                              &requests[requests.size()-1]);
+                    slate_mpi_call(
+                        MPI_Isend(src_rows[pivot.second].data(), nb,
+                                  mpi_type<scalar_t>::value, dest, tag, A.mpiComm(),
+                                  &requests[requests.size()-1]) );
                 }
                 if (! src_local && dst_local) {
 
                     requests.resize(requests.size()+1);
                     int source = A.tileRank(pivot.second.tileIndex(), j);
-                    MPI_Irecv(dst_rows[pivot.first].data(), nb,
-                              mpi_type<scalar_t>::value, source, tag,
-                              A.mpiComm(), &requests[requests.size()-1]);
+                    slate_mpi_call(
+                        MPI_Irecv(dst_rows[pivot.first].data(), nb,
+                                  mpi_type<scalar_t>::value, source, tag,
+                                  A.mpiComm(), &requests[requests.size()-1]) );
                 }
             }
 
             // Waitall.
-            statuses.resize(requests.size());
-            MPI_Waitall(requests.size(), requests.data(), statuses.data());
+            internal::comm_waitall(requests.size(), requests.data());
 
             for (auto const& pivot : pivot_map) {
                 bool dst_local = A.tileIsLocal(pivot.first.tileIndex(), j);
@@ -206,7 +209,7 @@ void permuteRows(
 
     MPI_Comm comm = A.mpiComm();
     int comm_size;
-    MPI_Comm_size(comm, &comm_size);
+    slate_mpi_call( MPI_Comm_size(comm, &comm_size) );
 
     {
         trace::Block trace_block("internal::permuteRows");
@@ -241,7 +244,7 @@ void permuteRows(
             }
 
             // Get tiles needed locally for this block column
-            std::set< ij_tuple > local_tiles;
+            TileSet local_tiles;
             for (int64_t i : pivoted_tile_rows) {
                 if (A.tileIsLocal(i, j)) {
                     local_tiles.insert({i, j});
@@ -253,8 +256,8 @@ void permuteRows(
             int64_t nb = A.tileNb(j);
 
             MPI_Datatype row_type;
-            MPI_Type_contiguous(nb, mpi_scalar, &row_type);
-            MPI_Type_commit(&row_type);
+            slate_mpi_call( MPI_Type_contiguous(nb, mpi_scalar, &row_type) );
+            slate_mpi_call( MPI_Type_commit(&row_type) );
 
             if (root) {
                 // Build table mapping remote pivots to row index in workspace.
@@ -308,12 +311,13 @@ void permuteRows(
                     // Assumes remote_count[root_rank] == 0
                     if (remote_count[r] != 0) {
                         scalar_t* rows_r = remote_rows + nb*remote_offsets[r];
-                        MPI_Irecv(rows_r, remote_count[r], row_type,
-                                  r, tag, comm, &requests[request_count]);
+                        slate_mpi_call(
+                            MPI_Irecv(rows_r, remote_count[r], row_type,
+                                      r, tag, comm, &requests[request_count]) );
                         ++request_count;
                     }
                 }
-                MPI_Waitall(request_count, requests.data(), MPI_STATUSES_IGNORE);
+                internal::comm_waitall(request_count, requests.data());
 
                 int64_t stride_0j = A(0, j).rowIncrement();
 
@@ -355,12 +359,13 @@ void permuteRows(
                     // Assumes remote_count[root_rank] == 0
                     if (remote_count[r] != 0) {
                         scalar_t* rows_r = remote_rows + nb*remote_offsets[r];
-                        MPI_Isend(rows_r, remote_count[r], row_type,
-                                  r, tag, comm, &requests[request_count]);
+                        slate_mpi_call(
+                            MPI_Isend(rows_r, remote_count[r], row_type,
+                                      r, tag, comm, &requests[request_count]) );
                         ++request_count;
                     }
                 }
-                MPI_Waitall(request_count, requests.data(), MPI_STATUSES_IGNORE);
+                internal::comm_waitall(request_count, requests.data());
             }
             else { // not root
                 // Build table mapping my pivots to row index in workspace.
@@ -402,10 +407,15 @@ void permuteRows(
                     }
 
                     // Send rows, then recv updated rows.
-                    MPI_Send(remote_rows, remote_length, row_type,
-                             root_rank, tag, comm);
-                    MPI_Recv(remote_rows, remote_length, row_type,
-                             root_rank, tag, comm, MPI_STATUS_IGNORE);
+                    MPI_Request request;
+                    slate_mpi_call(
+                        MPI_Isend(remote_rows, remote_length, row_type,
+                                  root_rank, tag, comm, &request) );
+                    internal::comm_wait( &request );
+                    slate_mpi_call(
+                        MPI_Irecv(remote_rows, remote_length, row_type,
+                                  root_rank, tag, comm, &request) );
+                    internal::comm_wait( &request );
 
                     // Unpack pivot rows from workspace.
                     count = 0;
@@ -429,7 +439,7 @@ void permuteRows(
                 }
             }
 
-            MPI_Type_free(&row_type);
+            slate_mpi_call( MPI_Type_free(&row_type) );
         }
     }
 }
@@ -498,9 +508,375 @@ void permuteRows(
                 layout, priority, tag_base, queue_index);
 }
 
+//------------------------------------------------------------------------------
+/// Permutes rows of the local tile columns of A on one device,
+/// for permuteRows< Target::Devices >.
+/// The row swaps of all tile columns are batched into one
+/// device::swap_rows_batch launch on the root ranks, and one each for
+/// packing and unpacking the rows exchanged with the root on other ranks;
+/// the gathers and scatters of all tile columns are non-blocking.
+///
+/// @ingroup permute_internal
+///
+template <typename scalar_t>
+void permuteRowsDevice(
+    Direction direction,
+    Matrix<scalar_t>& A, std::vector<Pivot>& pivot,
+    std::set<int64_t> const& pivoted_tile_rows,
+    Layout layout, int device, int tag_base, int queue_index)
+{
+    MPI_Comm comm = A.mpiComm();
+    int comm_size;
+    slate_mpi_call( MPI_Comm_size(comm, &comm_size) );
+    MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
+    bool using_gpu_aware_mpi = gpu_aware_mpi();
+    int my_rank = A.mpiRank();
+
+    blas::Queue* compute_queue = A.compute_queue(device, queue_index);
+
+    // Apply pivots forward (0, ..., k-1) or reverse (k-1, ..., 0)
+    int64_t begin, end, inc;
+    if (direction == Direction::Forward) {
+        begin = 0;
+        end   = pivot.size();
+        inc   = 1;
+    }
+    else {
+        begin = pivot.size() - 1;
+        end   = -1;
+        inc   = -1;
+    }
+
+    // Tile columns on this device; those where this rank is
+    // root (owns tile row 0) and the others, with the local
+    // rows they exchange with the root.
+    std::vector<int64_t> root_cols, nonroot_cols;
+    TileSet local_tiles;
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        if (device != A.tileDevice(0, j)) {
+            continue;
+        }
+        for (int64_t i : pivoted_tile_rows) {
+            if (A.tileIsLocal(i, j)) {
+                local_tiles.insert({i, j});
+            }
+        }
+        if (A.tileRank(0, j) == my_rank)
+            root_cols.push_back(j);
+        else
+            nonroot_cols.push_back(j);
+    }
+    if (root_cols.empty() && nonroot_cols.empty())
+        return;
+
+    A.tileGetForWriting( local_tiles, device,
+                         LayoutConvert(layout) );
+
+    // For root columns, map remote pivots to their rank's
+    // section of the workspace. Row indices are stored in int
+    // b/c MPI counts can't use int64_t's.
+    // Pivot tile rows are the same for all columns, but their
+    // ranks differ with j, so the table is per column.
+    int64_t nroot = root_cols.size();
+    std::vector< std::vector<int> > remote_count(nroot);
+    std::vector< std::vector<int> > remote_offsets(nroot);
+    std::vector< std::map<Pivot, int> > remote_pivot_table(nroot);
+    for (int64_t jj = 0; jj < nroot; ++jj) {
+        int64_t j = root_cols[jj];
+        std::vector<int> remote_index(comm_size);
+        remote_count[jj].assign(comm_size, 0);
+        remote_offsets[jj].assign(comm_size + 1, 0);
+        for (int64_t i = begin; i != end; i += inc) {
+            auto swap_rank = A.tileRank(pivot[i].tileIndex(), j);
+            if (my_rank != swap_rank) {
+                ++remote_count[jj][swap_rank];
+            }
+        }
+        for (int r = 0; r < comm_size; ++r) {
+            remote_offsets[jj][r+1] = remote_offsets[jj][r]
+                                    + remote_count[jj][r];
+            remote_index[r] = remote_offsets[jj][r];
+        }
+        for (int64_t i = begin; i != end; i += inc) {
+            auto piv = pivot[i];
+            auto swap_rank = A.tileRank(piv.tileIndex(), j);
+            if (my_rank != swap_rank
+                && remote_pivot_table[jj].find(piv)
+                   == remote_pivot_table[jj].end()) {
+                int index = remote_index[swap_rank];
+                ++remote_index[swap_rank];
+                remote_pivot_table[jj].insert({piv, index});
+            }
+        }
+        for (int r = 0; r < comm_size; ++r) {
+            // trim the lengths to their actual values
+            // since a pivot can be repeated.
+            remote_count[jj][r] = remote_index[r]
+                                - remote_offsets[jj][r];
+        }
+    }
+
+    // For other columns, map my pivots to row index in workspace,
+    // in order of first use, as the root does.
+    int64_t nnonroot = nonroot_cols.size();
+    std::vector< std::vector<Pivot> > local_pivots(nnonroot);
+    for (int64_t jj = 0; jj < nnonroot; ++jj) {
+        int64_t j = nonroot_cols[jj];
+        std::set<Pivot> seen;
+        for (int64_t i = begin; i != end; i += inc) {
+            auto piv = pivot[i];
+            if (A.tileRank(piv.tileIndex(), j) == my_rank
+                && seen.insert(piv).second) {
+                local_pivots[jj].push_back(piv);
+            }
+        }
+    }
+
+    // Workspace sections: root columns first, then other columns,
+    // so each phase moves one contiguous region to/from the host.
+    std::vector<int64_t> root_section(nroot + 1, 0);
+    for (int64_t jj = 0; jj < nroot; ++jj) {
+        root_section[jj+1] = root_section[jj]
+            + remote_offsets[jj][comm_size]
+              * A.tileNb(root_cols[jj]);
+    }
+    std::vector<int64_t> nonroot_section(nnonroot + 1,
+                                         root_section[nroot]);
+    for (int64_t jj = 0; jj < nnonroot; ++jj) {
+        nonroot_section[jj+1] = nonroot_section[jj]
+            + local_pivots[jj].size() * A.tileNb(nonroot_cols[jj]);
+    }
+    int64_t root_size = root_section[nroot];
+    int64_t total_size = nonroot_section[nnonroot];
+
+    scalar_t* remote_rows_dev
+        = A.allocWorkspaceBuffer(device, std::max(total_size,
+                                                  int64_t(1)));
+    scalar_t* remote_rows = remote_rows_dev;
+    std::vector<scalar_t> remote_rows_vect;
+    if (! using_gpu_aware_mpi) {
+        remote_rows_vect.resize( total_size );
+        remote_rows = remote_rows_vect.data();
+    }
+
+    // Batch arguments for swap_rows_batch:
+    // pack (also unpack), one group per other column;
+    // root swaps, one group per root column.
+    std::vector<int64_t> pack_offsets(1, 0), pack_lengths;
+    std::vector<scalar_t*> pack_rows;
+    for (int64_t jj = 0; jj < nnonroot; ++jj) {
+        int64_t j = nonroot_cols[jj];
+        int64_t nb = A.tileNb(j);
+        for (size_t k = 0; k < local_pivots[jj].size(); ++k) {
+            auto piv = local_pivots[jj][k];
+            pack_rows.push_back(
+                &A(piv.tileIndex(), j, device).at(
+                    piv.elementOffset(), 0));
+            pack_rows.push_back(
+                remote_rows_dev + nonroot_section[jj] + nb*k);
+        }
+        pack_offsets.push_back(pack_rows.size() / 2);
+        pack_lengths.push_back(nb);
+    }
+    std::vector<int64_t> swap_offsets(1, 0), swap_lengths;
+    std::vector<scalar_t*> swap_rows;
+    for (int64_t jj = 0; jj < nroot; ++jj) {
+        int64_t j = root_cols[jj];
+        int64_t nb = A.tileNb(j);
+        assert(A(0, j, device).layout() == Layout::RowMajor);
+        for (int64_t i = begin; i != end; i += inc) {
+            int64_t idx2 = pivot[i].tileIndex();
+            int64_t i2 = pivot[i].elementOffset();
+            if (A.tileRank(idx2, j) == my_rank) {
+                // If pivot not on the diagonal.
+                if (idx2 > 0 || i2 > i) {
+                    swap_rows.push_back(&A(0, j, device).at(i, 0));
+                    swap_rows.push_back(&A(idx2, j, device).at(i2, 0));
+                }
+            }
+            else {
+                auto remote_idx = remote_pivot_table[jj][pivot[i]];
+                swap_rows.push_back(&A(0, j, device).at(i, 0));
+                swap_rows.push_back(
+                    remote_rows_dev + root_section[jj] + nb*remote_idx);
+            }
+        }
+        swap_offsets.push_back(swap_rows.size() / 2);
+        swap_lengths.push_back(nb);
+    }
+
+    // Upload batch arguments in one device buffer,
+    // int64_t and pointers being the same size.
+    static_assert(sizeof(int64_t) == sizeof(scalar_t*),
+                  "assumes 64-bit pointers");
+    int64_t npack_groups = pack_lengths.size();
+    int64_t nswap_groups = swap_lengths.size();
+    std::vector<int64_t> args;
+    args.reserve(2*(npack_groups + nswap_groups + 1)
+                 + pack_rows.size() + swap_rows.size());
+    args.insert(args.end(), pack_offsets.begin(), pack_offsets.end());
+    args.insert(args.end(), pack_lengths.begin(), pack_lengths.end());
+    args.insert(args.end(), swap_offsets.begin(), swap_offsets.end());
+    args.insert(args.end(), swap_lengths.begin(), swap_lengths.end());
+    int64_t pack_rows_offset = args.size();
+    for (scalar_t* p : pack_rows)
+        args.push_back(reinterpret_cast<int64_t>(p));
+    int64_t swap_rows_offset = args.size();
+    for (scalar_t* p : swap_rows)
+        args.push_back(reinterpret_cast<int64_t>(p));
+
+    int64_t args_scalars
+        = ceildiv(int64_t(args.size()*sizeof(int64_t)),
+                  int64_t(sizeof(scalar_t)));
+    scalar_t* args_buffer
+        = A.allocWorkspaceBuffer(device, args_scalars);
+    int64_t* args_dev = reinterpret_cast<int64_t*>(args_buffer);
+    blas::device_memcpy<int64_t>(
+        args_dev, args.data(), args.size(), *compute_queue);
+
+    int64_t* pack_offsets_dev = args_dev;
+    int64_t* pack_lengths_dev = pack_offsets_dev + npack_groups + 1;
+    int64_t* swap_offsets_dev = pack_lengths_dev + npack_groups;
+    int64_t* swap_lengths_dev = swap_offsets_dev + nswap_groups + 1;
+    scalar_t** pack_rows_dev
+        = reinterpret_cast<scalar_t**>(args_dev + pack_rows_offset);
+    scalar_t** swap_rows_dev
+        = reinterpret_cast<scalar_t**>(args_dev + swap_rows_offset);
+
+    // Pack my pivot rows of other columns into workspace,
+    // swapping rather than copying so unpacking is the same batch.
+    if (! pack_rows.empty()) {
+        device::swap_rows_batch(
+            npack_groups, pack_offsets_dev, pack_lengths_dev,
+            pack_rows_dev, *compute_queue);
+        if (! using_gpu_aware_mpi) {
+            blas::device_memcpy<scalar_t>(
+                remote_rows + root_size, remote_rows_dev + root_size,
+                total_size - root_size, *compute_queue );
+        }
+    }
+    compute_queue->sync();
+
+    std::vector<MPI_Datatype> row_types(A.nt(), MPI_DATATYPE_NULL);
+    auto row_type = [&](int64_t j) {
+        if (row_types[j] == MPI_DATATYPE_NULL) {
+            slate_mpi_call(
+                MPI_Type_contiguous(A.tileNb(j), mpi_scalar, &row_types[j]) );
+            slate_mpi_call( MPI_Type_commit(&row_types[j]) );
+        }
+        return row_types[j];
+    };
+
+    // Gather remote rows of root columns, and send rows of
+    // other columns to their roots.
+    std::vector<MPI_Request> gather_requests;
+    for (int64_t jj = 0; jj < nroot; ++jj) {
+        int64_t j = root_cols[jj];
+        for (int r = 0; r < comm_size; ++r) {
+            // Assumes remote_count[root_rank] == 0
+            if (remote_count[jj][r] != 0) {
+                scalar_t* rows_r = remote_rows + root_section[jj]
+                                 + A.tileNb(j)*remote_offsets[jj][r];
+                gather_requests.push_back(MPI_REQUEST_NULL);
+                slate_mpi_call(
+                    MPI_Irecv(rows_r, remote_count[jj][r], row_type(j),
+                              r, tag_base + j, comm,
+                              &gather_requests.back()) );
+            }
+        }
+    }
+    std::vector<MPI_Request> send_requests;
+    for (int64_t jj = 0; jj < nnonroot; ++jj) {
+        int64_t j = nonroot_cols[jj];
+        if (! local_pivots[jj].empty()) {
+            send_requests.push_back(MPI_REQUEST_NULL);
+            slate_mpi_call(
+                MPI_Isend(remote_rows + nonroot_section[jj],
+                          local_pivots[jj].size(), row_type(j),
+                          A.tileRank(0, j), tag_base + j, comm,
+                          &send_requests.back()) );
+        }
+    }
+    internal::comm_waitall(gather_requests.size(), gather_requests.data());
+
+    // Swap rows of root columns locally, then scatter remote rows
+    // back to their ranks.
+    std::vector<MPI_Request> requests;
+    if (nroot > 0) {
+        if (! using_gpu_aware_mpi) {
+            blas::device_memcpy<scalar_t>(
+                remote_rows_dev, remote_rows,
+                root_size, *compute_queue );
+        }
+        if (! swap_rows.empty()) {
+            device::swap_rows_batch(
+                nswap_groups, swap_offsets_dev, swap_lengths_dev,
+                swap_rows_dev, *compute_queue);
+        }
+        if (! using_gpu_aware_mpi) {
+            blas::device_memcpy<scalar_t>(
+                remote_rows, remote_rows_dev,
+                root_size, *compute_queue );
+        }
+        compute_queue->sync();
+
+        for (int64_t jj = 0; jj < nroot; ++jj) {
+            int64_t j = root_cols[jj];
+            for (int r = 0; r < comm_size; ++r) {
+                if (remote_count[jj][r] != 0) {
+                    scalar_t* rows_r = remote_rows + root_section[jj]
+                                     + A.tileNb(j)*remote_offsets[jj][r];
+                    requests.push_back(MPI_REQUEST_NULL);
+                    slate_mpi_call(
+                        MPI_Isend(rows_r, remote_count[jj][r], row_type(j),
+                                  r, tag_base + j, comm,
+                                  &requests.back()) );
+                }
+            }
+        }
+    }
+
+    // Recv updated rows of other columns, once sent.
+    internal::comm_waitall(send_requests.size(), send_requests.data());
+    for (int64_t jj = 0; jj < nnonroot; ++jj) {
+        int64_t j = nonroot_cols[jj];
+        if (! local_pivots[jj].empty()) {
+            requests.push_back(MPI_REQUEST_NULL);
+            slate_mpi_call(
+                MPI_Irecv(remote_rows + nonroot_section[jj],
+                          local_pivots[jj].size(), row_type(j),
+                          A.tileRank(0, j), tag_base + j, comm,
+                          &requests.back()) );
+        }
+    }
+    internal::comm_waitall(requests.size(), requests.data());
+
+    // Unpack pivot rows of other columns from workspace.
+    if (! pack_rows.empty()) {
+        if (! using_gpu_aware_mpi) {
+            blas::device_memcpy<scalar_t>(
+                remote_rows_dev + root_size, remote_rows + root_size,
+                total_size - root_size, *compute_queue );
+        }
+        device::swap_rows_batch(
+            npack_groups, pack_offsets_dev, pack_lengths_dev,
+            pack_rows_dev, *compute_queue);
+    }
+    compute_queue->sync();
+
+    for (auto& type : row_types) {
+        if (type != MPI_DATATYPE_NULL)
+            slate_mpi_call( MPI_Type_free(&type) );
+    }
+    A.freeWorkspaceBuffer(device, args_buffer);
+    A.freeWorkspaceBuffer(device, remote_rows_dev);
+}
+
 //------------------------------------------------------------------------------
 /// Permutes rows of a general matrix according to the pivot vector.
 /// GPU device implementation.
+/// Each device task handles all its local tile columns at once;
+/// see permuteRowsDevice.
 /// todo: Restructure similarly to Hermitian permute
 ///       (use the auxiliary swap functions).
 /// todo: Just one function forwarding target.
@@ -514,8 +890,6 @@ void permuteRows(
     Matrix<scalar_t>& A, std::vector<Pivot>& pivot,
     Layout layout, int priority, int tag_base, int queue_index)
 {
-    using ij_tuple = typename Matrix<scalar_t>::ij_tuple;
-
     // GPU uses RowMajor
     assert(layout == Layout::RowMajor);
 
@@ -533,273 +907,12 @@ void permuteRows(
         for (int device = 0; device < A.num_devices(); ++device) {
             // Remove default(none) because Cray MPI wants ompi_mpi_c_float_complex defined
             // as a task parameter.  To avoid that problem, remove default(none) here.
-            #pragma omp task shared(A, pivot) \
-                firstprivate(device, direction, tag_base, queue_index) priority(priority)
+            #pragma omp task shared(A, pivot, pivoted_tile_rows) \
+                firstprivate(device, direction, layout, tag_base, queue_index) \
+                priority(priority)
             {
-                MPI_Comm comm = A.mpiComm();
-                int comm_size;
-                MPI_Comm_size(comm, &comm_size);
-                MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
-                bool using_gpu_aware_mpi = gpu_aware_mpi();
-
-                blas::Queue* compute_queue = A.compute_queue(device, queue_index);
-
-                // this is likely an over estimation
-                int64_t max_nb = A.tileNb(0);
-                for (int64_t j = 1; j < A.nt(); ++j) {
-                    max_nb = std::max(max_nb, A.tileNb(j));
-                }
-
-                scalar_t* remote_rows_dev
-                    = A.allocWorkspaceBuffer(device, A.tileMb(0)*max_nb);
-
-                // Apply pivots forward (0, ..., k-1) or reverse (k-1, ..., 0)
-                int64_t begin, end, inc;
-                if (direction == Direction::Forward) {
-                    begin = 0;
-                    end   = pivot.size();
-                    inc   = 1;
-                }
-                else {
-                    begin = pivot.size() - 1;
-                    end   = -1;
-                    inc   = -1;
-                }
-
-                for (int64_t j = 0; j < A.nt(); ++j) {
-                    int root_rank = A.tileRank(0, j);
-                    bool root = A.mpiRank() == A.tileRank(0, j);
-                    int tag = tag_base + j;
-
-                    // TODO consider if there is a better mapping for remote rows
-                    if (device != A.tileDevice(0, j)) {
-                        continue;
-                    }
-
-                    // Get tiles needed locally for this block column
-                    std::set< ij_tuple > local_tiles;
-                    for (int64_t i : pivoted_tile_rows) {
-                        if (A.tileIsLocal(i, j)) {
-                            local_tiles.insert({i, j});
-                        }
-                    }
-                    A.tileGetForWriting( local_tiles, device,
-                                         LayoutConvert(layout) );
-
-                    // process pivots
-                    int64_t nb = A.tileNb(j);
-
-                    MPI_Datatype row_type;
-                    MPI_Type_contiguous(nb, mpi_scalar, &row_type);
-                    MPI_Type_commit(&row_type);
-
-                    if (root) {
-                        // Build table mapping remote pivots to row index in workspace.
-                        // row indices are stored in int b/c gather/scatter can't use int64_t's
-                        std::vector<int> remote_count(comm_size + 1);
-                        for (int64_t i = begin; i != end; i += inc) {
-                            auto piv = pivot[i];
-                            auto swap_rank = A.tileRank(piv.tileIndex(), j);
-                            if (root_rank != swap_rank) {
-                                ++remote_count[swap_rank];
-                            }
-                        }
-                        std::vector<int> remote_index(comm_size);
-                        std::vector<int> remote_offsets(comm_size+1);
-                        for (int r = 0; r < comm_size; ++r) {
-                            remote_offsets[r+1] += remote_offsets[r] + remote_count[r];
-                            remote_index[r] = remote_offsets[r];
-                        }
-                        std::map<Pivot, int> remote_pivot_table;
-                        for (int64_t i = begin; i != end; i += inc) {
-                            auto piv = pivot[i];
-                            auto swap_rank = A.tileRank(piv.tileIndex(), j);
-                            if (root_rank != swap_rank
-                                && remote_pivot_table.find(piv) == remote_pivot_table.end()) {
-                                int index = remote_index[swap_rank];
-                                ++remote_index[swap_rank];
-                                remote_pivot_table.insert({piv, index});
-                            }
-                        }
-                        for (int r = 0; r < comm_size; ++r) {
-                            // trim the lengths to their actual values
-                            // since a pivot can be repeated.
-                            remote_count[r] = remote_index[r] - remote_offsets[r];
-                        }
-
-                        scalar_t* remote_rows;
-                        std::vector<scalar_t> remote_rows_vect;
-                        int64_t remote_rows_size = remote_offsets[comm_size]*nb;
-                        if (using_gpu_aware_mpi) {
-                            remote_rows = remote_rows_dev;
-                        }
-                        else {
-                            remote_rows_vect.resize( remote_rows_size );
-                            remote_rows = remote_rows_vect.data();
-                        }
-
-                        // Gather remote rows to root.
-                        std::vector<MPI_Request> requests (comm_size);
-                        int request_count = 0;
-                        for (int r = 0; r < comm_size; ++r) {
-                            // Assumes remote_count[root_rank] == 0
-                            if (remote_count[r] != 0) {
-                                scalar_t* rows_r = remote_rows + nb*remote_offsets[r];
-                                MPI_Irecv(rows_r, remote_count[r], row_type,
-                                          r, tag, comm, &requests[request_count]);
-                                ++request_count;
-                            }
-                        }
-                        MPI_Waitall(request_count, requests.data(), MPI_STATUSES_IGNORE);
-
-                        if (!using_gpu_aware_mpi) {
-                            blas::device_memcpy<scalar_t>(
-                                remote_rows_dev, remote_rows,
-                                remote_rows_size, *compute_queue );
-                        }
-
-                        // Swap rows locally.
-                        for (int64_t i = begin; i != end; i += inc) {
-                            int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
-
-                            if (pivot_rank == root_rank) {
-                                // If pivot not on the diagonal.
-                                if (pivot[i].tileIndex() > 0 ||
-                                    pivot[i].elementOffset() > i)
-                                    {
-                                        assert(A(0, j, device).layout() == Layout::RowMajor);
-                                        int64_t i1 = i;
-                                        int64_t i2 = pivot[i].elementOffset();
-                                        int64_t idx2 = pivot[i].tileIndex();
-                                        blas::swap(
-                                                   A.tileNb(j),
-                                                   &A(0,    j, device).at(i1, 0), 1,
-                                                   &A(idx2, j, device).at(i2, 0), 1,
-                                                   *compute_queue);
-                                    }
-                            }
-                            else {
-                                auto remote_idx = remote_pivot_table[pivot[i]];
-                                blas::swap(
-                                           A.tileNb(j),
-                                           &A(0, j, device).at(i, 0), 1,
-                                           remote_rows_dev + nb*remote_idx, 1,
-                                           *compute_queue);
-                            }
-                        }
-                        compute_queue->sync();
-
-                        if (!using_gpu_aware_mpi) {
-                            blas::device_memcpy<scalar_t>(
-                                remote_rows, remote_rows_dev,
-                                remote_rows_size, *compute_queue );
-                        }
-
-                        // Scatter remote rows.
-                        // reuse requests array from before
-                        request_count = 0;
-                        for (int r = 0; r < comm_size; ++r) {
-                            // Assumes remote_count[root_rank] == 0
-                            if (remote_count[r] != 0) {
-                                scalar_t* rows_r = remote_rows + nb*remote_offsets[r];
-                                MPI_Isend(rows_r, remote_count[r], row_type,
-                                          r, tag, comm, &requests[request_count]);
-                                ++request_count;
-                            }
-                        }
-                        MPI_Waitall(request_count, requests.data(), MPI_STATUSES_IGNORE);
-                    }
-                    else { // not root
-                        // Build table mapping my pivots to row index in workspace.
-                        std::map<Pivot, int> remote_pivot_table;
-                        int remote_length = 0;
-                        for (int64_t i = begin; i != end; i += inc) {
-                            auto piv = pivot[i];
-                            auto swap_rank = A.tileRank(piv.tileIndex(), j);
-                            if (swap_rank == A.mpiRank()
-                                && remote_pivot_table.find(piv) == remote_pivot_table.end()) {
-
-                                remote_pivot_table.insert({piv, remote_length});
-                                ++remote_length;
-                            }
-                        }
-
-                        if (remote_length > 0) {
-
-                            // Pack pivot rows into workspace.
-                            int64_t count = 0;
-                            for (int64_t i = begin; i != end; i += inc) {
-                                int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
-                                if (pivot_rank == A.mpiRank()) {
-                                    auto remote_idx = remote_pivot_table[pivot[i]];
-                                    auto tile_index = pivot[i].tileIndex();
-                                    auto tile_offset = pivot[i].elementOffset();
-
-                                    if (remote_idx >= count) {
-                                        blas::copy(
-                                            nb,
-                                            &A(tile_index, j, device).at(tile_offset, 0), 1,
-                                            remote_rows_dev + nb*remote_idx, 1,
-                                            *compute_queue);
-                                        ++count; // only swap the first time
-                                    }
-                                }
-                            }
-                            compute_queue->sync();
-
-                            // Send rows, then recv updated rows.
-                            scalar_t* remote_rows;
-                            std::vector<scalar_t> remote_rows_vect;
-                            int64_t remote_rows_size = remote_length*nb;
-                            if (using_gpu_aware_mpi) {
-                                remote_rows = remote_rows_dev;
-                            }
-                            else {
-                                remote_rows_vect.resize( remote_rows_size );
-                                remote_rows = remote_rows_vect.data();
-                                blas::device_memcpy<scalar_t>(
-                                    remote_rows, remote_rows_dev,
-                                    remote_rows_size, *compute_queue );
-                            }
-
-                            MPI_Send(remote_rows, remote_length, row_type,
-                                     root_rank, tag, comm);
-                            MPI_Recv(remote_rows, remote_length, row_type,
-                                     root_rank, tag, comm, MPI_STATUS_IGNORE);
-
-                            if (!using_gpu_aware_mpi) {
-                                blas::device_memcpy<scalar_t>(
-                                    remote_rows_dev, remote_rows,
-                                    remote_rows_size, *compute_queue );
-                            }
-
-                            // Unpack pivot rows from workspace.
-                            count = 0;
-                            for (int64_t i = begin; i != end; i += inc) {
-                                int pivot_rank = A.tileRank(pivot[i].tileIndex(), j);
-                                if (pivot_rank == A.mpiRank()) {
-                                    auto remote_idx = remote_pivot_table[pivot[i]];
-                                    auto tile_index = pivot[i].tileIndex();
-                                    auto tile_offset = pivot[i].elementOffset();
-
-                                    if (remote_idx >= count) {
-                                        blas::copy(
-                                            A.tileNb(j),
-                                            remote_rows_dev + nb*remote_idx, 1,
-                                            &A(tile_index, j, device).at(tile_offset, 0), 1,
-                                            *compute_queue);
-                                        ++count; // only swap the first time
-                                    }
-                                }
-                            }
-                            compute_queue->sync();
-                        }
-                    }
-
-                    MPI_Type_free(&row_type);
-                }
-                compute_queue->sync();
-                A.freeWorkspaceBuffer(device, remote_rows_dev);
+                permuteRowsDevice( direction, A, pivot, pivoted_tile_rows,
+                                   layout, device, tag_base, queue_index );
             }
         }
     }
@@ -1091,6 +1204,160 @@ void permuteRowsCols(
                     priority, tag);
 }
 
+//------------------------------------------------------------------------------
+/// Applies the row interchanges of all panels of an LU factorization,
+/// as getrs does with one permuteRows per panel, but moving each row at
+/// most once. The interchanges are composed into one permutation, then
+/// each rank exchanges one message with each other rank per block column,
+/// instead of one round of messages per panel. Host implementation.
+///
+/// @param[in] direction
+///     - Forward:  apply pivots of panels 0, ..., mt-1, i.e., $B = P B$;
+///     - Backward: apply them in reverse order, i.e., $B = P^T B$.
+///
+/// @param[in,out] A
+///     Matrix whose rows are permuted; block row k matches panel k.
+///
+/// @param[in] pivots
+///     Pivots of each panel, as from getrf: pivots[ k ][ i ] is the row
+///     swapped with row i of block row k, relative to block row k.
+///
+/// @param[in] tag
+///     MPI tag of the messages, plus the block column index.
+///
+/// @ingroup permute_internal
+///
+template <typename scalar_t>
+void permuteRowsAll(
+    Direction direction,
+    Matrix<scalar_t>& A, Pivots& pivots, int tag)
+{
+    using ij_tuple = typename Matrix<scalar_t>::ij_tuple;
+
+    trace::Block trace_block("internal::permuteRowsAll");
+
+    int64_t mt = A.mt();
+    int64_t m  = A.m();
+    MPI_Comm comm = A.mpiComm();
+    int my_rank = A.mpiRank();
+    MPI_Datatype mpi_scalar = mpi_type<scalar_t>::value;
+
+    // Global offset of each block row, and block row of each row.
+    std::vector<int64_t> offset( mt+1, 0 );
+    for (int64_t i = 0; i < mt; ++i)
+        offset[ i+1 ] = offset[ i ] + A.tileMb( i );
+    auto block_row = [&]( int64_t r ) {
+        return int64_t( std::upper_bound( offset.begin(), offset.end(), r )
+                        - offset.begin() ) - 1;
+    };
+
+    // Compose the interchanges; row r of the result is row perm[ r ]
+    // of the input.
+    std::vector<int64_t> perm( m );
+    for (int64_t r = 0; r < m; ++r)
+        perm[ r ] = r;
+    int64_t npanels = std::min( mt, int64_t( pivots.size() ) );
+    for (int64_t kk = 0; kk < npanels; ++kk) {
+        int64_t k = direction == Direction::Forward ? kk : npanels-1 - kk;
+        auto& piv = pivots[ k ];
+        int64_t len = piv.size();
+        for (int64_t ii = 0; ii < len; ++ii) {
+            int64_t i = direction == Direction::Forward ? ii : len-1 - ii;
+            int64_t r1 = offset[ k ] + i;
+            int64_t r2 = offset[ k + piv[ i ].tileIndex() ]
+                       + piv[ i ].elementOffset();
+            std::swap( perm[ r1 ], perm[ r2 ] );
+        }
+    }
+
+    std::vector<int64_t> moved;
+    for (int64_t r = 0; r < m; ++r) {
+        if (perm[ r ] != r)
+            moved.push_back( r );
+    }
+    if (moved.empty())
+        return;
+
+    for (int64_t j = 0; j < A.nt(); ++j) {
+        int64_t nb = A.tileNb( j );
+
+        // Rows this rank sends to, and receives from, each other rank,
+        // in increasing order of destination row on both sides.
+        std::map< int, std::vector<int64_t> > send_rows, recv_rows;
+        std::vector<int64_t> local_rows;
+        TileSet local_tiles;
+        for (int64_t r : moved) {
+            int64_t s = perm[ r ];
+            int64_t rt = block_row( r ), st = block_row( s );
+            int dst_rank = A.tileRank( rt, j );
+            int src_rank = A.tileRank( st, j );
+            if (src_rank == my_rank) {
+                local_tiles.insert( { st, j } );
+                if (dst_rank == my_rank)
+                    local_rows.push_back( r );
+                else
+                    send_rows[ dst_rank ].push_back( r );
+            }
+            if (dst_rank == my_rank) {
+                local_tiles.insert( { rt, j } );
+                if (src_rank != my_rank)
+                    recv_rows[ src_rank ].push_back( r );
+            }
+        }
+        if (local_tiles.empty())
+            continue;
+
+        A.tileGetForWriting( local_tiles, LayoutConvert::ColMajor );
+
+        auto get_row = [&]( int64_t s, scalar_t* row ) {
+            int64_t st = block_row( s );
+            tile::copyRow( nb, A( st, j ), s - offset[ st ], 0, row );
+        };
+        auto set_row = [&]( scalar_t* row, int64_t r ) {
+            int64_t rt = block_row( r );
+            tile::copyRow( nb, row, A( rt, j ), r - offset[ rt ], 0 );
+        };
+
+        // Read all source rows before any row is overwritten.
+        std::vector<scalar_t> local_buf( local_rows.size() * nb );
+        for (size_t k = 0; k < local_rows.size(); ++k)
+            get_row( perm[ local_rows[ k ] ], &local_buf[ k*nb ] );
+
+        std::map< int, std::vector<scalar_t> > send_buf, recv_buf;
+        std::vector<MPI_Request> requests;
+        for (auto& rows : recv_rows) {
+            auto& buf = recv_buf[ rows.first ];
+            buf.resize( rows.second.size() * nb );
+            requests.push_back( MPI_REQUEST_NULL );
+            slate_mpi_call(
+                MPI_Irecv( buf.data(), int( buf.size() ), mpi_scalar, rows.first,
+                           tag + j, comm, &requests.back() ) );
+        }
+        for (auto& rows : send_rows) {
+            auto& buf = send_buf[ rows.first ];
+            buf.resize( rows.second.size() * nb );
+            for (size_t k = 0; k < rows.second.size(); ++k)
+                get_row( perm[ rows.second[ k ] ], &buf[ k*nb ] );
+            requests.push_back( MPI_REQUEST_NULL );
+            slate_mpi_call(
+                MPI_Isend( buf.data(), int( buf.size() ), mpi_scalar, rows.first,
+                           tag + j, comm, &requests.back() ) );
+        }
+
+        // Local moves overlap communication.
+        for (size_t k = 0; k < local_rows.size(); ++k)
+            set_row( &local_buf[ k*nb ], local_rows[ k ] );
+
+        internal::comm_waitall( requests.size(), requests.data() );
+
+        for (auto& rows : recv_rows) {
+            auto& buf = recv_buf[ rows.first ];
+            for (size_t k = 0; k < rows.second.size(); ++k)
+                set_row( &buf[ k*nb ], rows.second[ k ] );
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations for (general) Matrix.
 // ----------------------------------------
@@ -1233,5 +1500,27 @@ void permuteRowsCols< Target::HostTask, std::complex<double> >(
     std::vector<Pivot>& pivot,
     int priority, int tag);
 
+//------------------------------------------------------------------------------
+// Explicit instantiations for permuteRowsAll.
+template
+void permuteRowsAll<float>(
+    Direction direction,
+    Matrix<float>& A, Pivots& pivots, int tag);
+
+template
+void permuteRowsAll<double>(
+    Direction direction,
+    Matrix<double>& A, Pivots& pivots, int tag);
+
+template
+void permuteRowsAll< std::complex<float> >(
+    Direction direction,
+    Matrix< std::complex<float> >& A, Pivots& pivots, int tag);
+
+template
+void permuteRowsAll< std::complex<double> >(
+    Direction direction,
+    Matrix< std::complex<double> >& A, Pivots& pivots, int tag);
+
 } // namespace internal
 } // namespace slate
@@ -62,10 +62,9 @@ void swapRemoteRow(
     // todo: Perhaps create an MPI type and let MPI pack it?
     blas::copy(n, &A.at(i, j), A.rowIncrement(), &local_row[0], 1);
 
-    MPI_Sendrecv(
-        local_row.data(), n, mpi_type<scalar_t>::value, other_rank, tag,
-        other_row.data(), n, mpi_type<scalar_t>::value, other_rank, tag,
-        mpi_comm, MPI_STATUS_IGNORE);
+    internal::comm_sendrecv(
+        local_row.data(), other_row.data(), n, mpi_type<scalar_t>::value,
+        other_rank, tag, mpi_comm );
 
     blas::copy(n, &other_row[0], 1, &A.at(i, j), A.rowIncrement());
 }
@@ -107,10 +106,9 @@ void swapRemoteRowDevice(
 
     queue.sync();
 
-    MPI_Sendrecv(
-        local_row.data(), n, mpi_type<scalar_t>::value, other_rank, tag,
-        other_row.data(), n, mpi_type<scalar_t>::value, other_rank, tag,
-        mpi_comm, MPI_STATUS_IGNORE);
+    internal::comm_sendrecv(
+        local_row.data(), other_row.data(), n, mpi_type<scalar_t>::value,
+        other_rank, tag, mpi_comm );
 
     blas::device_memcpy<scalar_t>(
         &A.at(i, j), other_row.data(), n,
@@ -144,10 +142,9 @@ void swapRemoteElement(
     scalar_t local_element = A(i, j);
     scalar_t other_element;
 
-    MPI_Sendrecv(
-        &local_element, 1, mpi_type<scalar_t>::value, other_rank, tag,
-        &other_element, 1, mpi_type<scalar_t>::value, other_rank, tag,
-        mpi_comm, MPI_STATUS_IGNORE);
+    internal::comm_sendrecv(
+        &local_element, &other_element, 1, mpi_type<scalar_t>::value,
+        other_rank, tag, mpi_comm );
 
     A.at(i, j) = other_element;
 }
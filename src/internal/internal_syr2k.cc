@@ -461,7 +461,7 @@ void syr2k(internal::TargetType<Target::Devices>,
 
                     Op opB = (opA == Op::NoTrans ? Op::Trans : Op::NoTrans);
 
-                    std::set<ij_tuple> A_tiles_set, B_tiles_set, C_tiles_set;
+                    TileSet A_tiles_set, B_tiles_set, C_tiles_set;
                     for (int64_t j = 0; j < C.nt(); ++j) {
                         for (int64_t i = j; i < C.mt(); ++i) {  // lower
                             if (C.tileIsLocal(i, j)
@@ -175,7 +175,7 @@ void trmm(internal::TargetType<Target::Devices>,
             firstprivate( device, side, sideA, uploA, opA, diagA, alpha ) \
             firstprivate( queue_index, layout )
         {
-            std::set<ij_tuple> B_tiles_set;
+            TileSet B_tiles_set;
             if (side == Side::Right) {
                 for (int64_t i = 0; i < B.mt(); ++i) {
                     if (B.tileIsLocal(i, 0)
@@ -223,6 +223,8 @@ void trmm(internal::TargetType<Target::Devices>,
 
                     blas::Queue* queue = B.compute_queue(device, queue_index);
                     assert(queue != nullptr);
+                    trace::DeviceBlock device_block(
+                        "blas::batch::trmm", *queue, queue_index, batch_size );
 
                     for (size_t g = 0; g < group_params.size(); ++g) {
 
@@ -401,7 +401,7 @@ void norm(
             firstprivate(device, queue_index, in_norm, ldv, layout) \
             priority(priority)
         {
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             for (int64_t i = 0; i < A.mt(); ++i) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
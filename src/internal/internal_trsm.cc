@@ -6,13 +6,42 @@
 #include "slate/Matrix.hh"
 #include "slate/TriangularMatrix.hh"
 #include "slate/types.hh"
+#include "slate/FlopStats.hh"
 #include "slate/Tile_blas.hh"
 #include "internal/internal.hh"
 #include "internal/internal_batch.hh"
+#include "internal/internal_queue.hh"
 
 namespace slate {
 namespace internal {
 
+namespace {
+
+//------------------------------------------------------------------------------
+/// Solves op(A) X = alpha B(i, j) or X op(A) = alpha B(i, j) for one tile
+/// on the host, skipping the solve when B(i, j) is a Zero tile, and
+/// only scaling B(i, j) when A is an Identity tile.
+///
+template <typename scalar_t>
+void trsm_tile(
+    Side side, scalar_t alpha, TriangularMatrix<scalar_t>& A, bool A_identity,
+    Matrix<scalar_t>& B, int64_t i, int64_t j, Layout layout)
+{
+    if (B.tileStructure( i, j ) == TileStructure::Zero
+        || (A_identity && alpha == scalar_t( 1 )))
+        return;
+
+    B.tileGetForWriting( i, j, LayoutConvert( layout ) );
+    if (A_identity) {
+        tile::scale( alpha, B( i, j ) );
+    }
+    else {
+        tile::trsm( side, A.diag(), alpha, A( 0, 0 ), B( i, j ) );
+    }
+}
+
+} // namespace
+
 //------------------------------------------------------------------------------
 /// Triangular solve matrix (multiple right-hand sides).
 /// Dispatches to target implementations.
@@ -24,6 +53,22 @@ void trsm(Side side,
                                     Matrix<scalar_t>&& B,
           int priority, Layout layout, int64_t queue_index )
 {
+    // Flops of local B tiles: m^2 nb on the left, n^2 mb on the right,
+    // where A is m-by-m or n-by-n.
+    FlopCounter flop_counter( FlopRoutine::Trsm, target, [&]() {
+        double flops = 0;
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            for (int64_t j = 0; j < B.nt(); ++j) {
+                if (B.tileIsLocal( i, j )) {
+                    double an = A.n();
+                    flops += an * an * (side == Side::Left ? B.tileNb( j )
+                                                           : B.tileMb( i ));
+                }
+            }
+        }
+        return flops * flop_scale<scalar_t>();
+    } );
+
     trsm(internal::TargetType<target>(),
          side,
          alpha, A,
@@ -43,16 +88,21 @@ void trsm(internal::TargetType<Target::HostTask>,
                                     Matrix<scalar_t>& B,
           int priority, Layout layout, int64_t queue_index )
 {
-    // CPU assumes column major
-    // todo: relax this assumption, by allowing Tile_blas.hh::trsm()
-    //       to take layout param
     // todo: optimize for the number of layout conversions,
     //       by watching 'layout' and 'B(i, j).layout()'
-    assert(layout == Layout::ColMajor);
     assert(A.mt() == 1);
 
+    // With identity A, B = alpha B; a Zero tile of B stays zero.
+    bool A_identity = false;
     if (B.numLocalTiles() > 0) {
-        A.tileGetForReading(0, 0, LayoutConvert(layout));
+        // A in the other layout is used in place by tile::trsm, unless it
+        // is complex conj-transposed.
+        // Read the structure before A(0, 0), which resets it.
+        A_identity = A.tileStructure( 0, 0 ) == TileStructure::Identity;
+        A.tileGetForReading(0, 0, LayoutConvert::None);
+        Op opA;
+        if (! tile::op_in_layout( A(0, 0), layout, &opA ))
+            A.tileGetForReading(0, 0, LayoutConvert(layout));
     }
     // alternatively, if (side == right), (conj)-transpose both A and B,
     // then assume side == left; see slate::trsm
@@ -63,12 +113,10 @@ void trsm(internal::TargetType<Target::HostTask>,
             if (B.tileIsLocal(i, 0)) {
                 #pragma omp task slate_omp_default_none \
                     shared( A, B ) \
-                    firstprivate( i, layout, side, alpha ) priority( priority )
+                    firstprivate( i, layout, side, alpha, A_identity ) \
+                    priority( priority )
                 {
-                    B.tileGetForWriting(i, 0, LayoutConvert(layout));
-                    tile::trsm(
-                        side, A.diag(),
-                        alpha, A(0, 0), B(i, 0) );
+                    trsm_tile( side, alpha, A, A_identity, B, i, 0, layout );
                 }
             }
         }
@@ -79,12 +127,10 @@ void trsm(internal::TargetType<Target::HostTask>,
             if (B.tileIsLocal(0, j)) {
                 #pragma omp task slate_omp_default_none \
                     shared( A, B ) \
-                    firstprivate( j, layout, side, alpha ) priority( priority )
+                    firstprivate( j, layout, side, alpha, A_identity ) \
+                    priority( priority )
                 {
-                    B.tileGetForWriting(0, j, LayoutConvert(layout));
-                    tile::trsm(
-                        side, A.diag(),
-                        alpha, A(0, 0), B(0, j) );
+                    trsm_tile( side, alpha, A, A_identity, B, 0, j, layout );
                 }
             }
         }
@@ -176,7 +222,7 @@ void trsm(internal::TargetType<Target::Devices>,
             firstprivate(device, side, layout, sideA, uploA, opA, diagA) \
             firstprivate( alpha, queue_index )
         {
-            std::set<ij_tuple> B_tiles_set;
+            TileSet B_tiles_set;
             if (side == Side::Right) {
                 for (int64_t i = 0; i < B.mt(); ++i) {
                     if (B.tileIsLocal(i, 0)
@@ -199,10 +245,20 @@ void trsm(internal::TargetType<Target::Devices>,
             int64_t batch_size = B_tiles_set.size();
             if (batch_size > 0) {
 
-                A.tileGetForReading(0, 0, device, LayoutConvert(layout));
-                B.tileGetForWriting(B_tiles_set, device, LayoutConvert(layout));
+                // With queue_index = AnyQueue, leases a free queue.
+                QueueLease<scalar_t> lease( B, device, queue_index );
+                blas::Queue* queue = lease.queue();
+                assert(queue != nullptr);
+
+                // The queue, rather than this thread, waits for earlier
+                // device work on the tiles.
+                TileSet A_tiles_set = { { 0, 0 } };
+                A.tileGetForReading(A_tiles_set, device, LayoutConvert(layout),
+                                    *queue);
+                B.tileGetForWriting(B_tiles_set, device, LayoutConvert(layout),
+                                    *queue);
 
-                scalar_t** a_array_host = B.array_host(device, queue_index);
+                scalar_t** a_array_host = lease.array_host();
                 scalar_t** b_array_host = a_array_host + batch_size;
 
                 // B comes first since we do computation for a local B
@@ -222,8 +278,8 @@ void trsm(internal::TargetType<Target::Devices>,
                     // info size 0 disables slow checks in batched BLAS++.
                     std::vector<int64_t> info;
 
-                    blas::Queue* queue = B.compute_queue(device, queue_index);
-                    assert(queue != nullptr);
+                    trace::DeviceBlock device_block(
+                        "blas::batch::trsm", *queue, lease.index(), batch_size );
 
                     for (size_t g = 0; g < group_params.size(); ++g) {
 
@@ -252,7 +308,11 @@ void trsm(internal::TargetType<Target::Devices>,
                         b_array_host += group_count;
                     }
 
-                    queue->sync();
+                    // Instead of synchronizing, record an event that later
+                    // users of the tiles wait on.
+                    auto event = DeviceEvent::record( *queue );
+                    A.tileRecordEvent( A_tiles_set, device, event, false );
+                    B.tileRecordEvent( B_tiles_set, device, event, true );
                 }
             }
         }
@@ -190,7 +190,7 @@ void trsmA(internal::TargetType<Target::Devices>,
             firstprivate(device, side, layout, sideA, uploA, opA, diagA) \
             firstprivate(alpha, queue_index)
         {
-            std::set<ij_tuple> B_tiles_set;
+            TileSet B_tiles_set;
             if (side == Side::Right) {
                 for (int64_t i = 0; i < B.mt(); ++i) {
                     if (B.tileIsLocal( i, 0 )
@@ -312,6 +312,8 @@ void trsmA(internal::TargetType<Target::Devices>,
 
                     blas::Queue* queue = A.compute_queue( device, queue_index );
                     assert( queue != nullptr );
+                    trace::DeviceBlock device_block(
+                        "blas::batch::trsmA", *queue, queue_index, batch_size );
 
                     for (size_t g = 0; g < group_params.size(); ++g) {
 
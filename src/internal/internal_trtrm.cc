@@ -8,6 +8,8 @@
 #include "slate/types.hh"
 #include "internal/Tile_lapack.hh"
 #include "internal/internal.hh"
+#include "internal/internal_queue.hh"
+#include "slate/internal/device.hh"
 
 namespace slate {
 namespace internal {
@@ -21,9 +23,10 @@ namespace internal {
 /// @ingroup tr_internal
 ///
 template <Target target, typename scalar_t>
-void trtrm(TriangularMatrix< scalar_t >&& A, int priority)
+void trtrm(TriangularMatrix< scalar_t >&& A, int priority,
+           int64_t queue_index)
 {
-    trtrm(internal::TargetType<target>(), A, priority);
+    trtrm(internal::TargetType<target>(), A, priority, queue_index);
 }
 
 //------------------------------------------------------------------------------
@@ -32,7 +35,8 @@ void trtrm(TriangularMatrix< scalar_t >&& A, int priority)
 ///
 template <typename scalar_t>
 void trtrm(internal::TargetType<Target::HostTask>,
-           TriangularMatrix<scalar_t>& A, int priority)
+           TriangularMatrix<scalar_t>& A, int priority,
+           int64_t queue_index)
 {
     assert(A.mt() == 1);
     assert(A.nt() == 1);
@@ -43,31 +47,90 @@ void trtrm(internal::TargetType<Target::HostTask>,
     }
 }
 
+//------------------------------------------------------------------------------
+/// Triangular multiplication $L^H L$ or $U U^H$ of single tile,
+/// device implementation.
+/// Runs in one kernel launch on the tile's device, so the tile doesn't
+/// make a round trip to the host.
+/// @ingroup tr_internal
+///
+template <typename scalar_t>
+void trtrm(internal::TargetType<Target::Devices>,
+           TriangularMatrix<scalar_t>& A, int priority,
+           int64_t queue_index)
+{
+    using ij_tuple = typename BaseMatrix<scalar_t>::ij_tuple;
+
+    assert(A.mt() == 1);
+    assert(A.nt() == 1);
+
+    if (A.tileIsLocal(0, 0)) {
+        int device = A.tileDevice(0, 0);
+
+        // With queue_index = AnyQueue, leases a free queue.
+        QueueLease<scalar_t> lease( A, device, queue_index );
+        blas::Queue* queue = lease.queue();
+
+        TileSet A_tiles_set = { { 0, 0 } };
+        A.tileGetForWriting(A_tiles_set, device, LayoutConvert::ColMajor,
+                            *queue);
+        auto A00 = A(0, 0, device);
+        device::trtrm(
+            A00.uploPhysical(), A00.nb(),
+            A00.data(), A00.stride(), *queue );
+        queue->sync();
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 // ----------------------------------------
 template
 void trtrm<Target::HostTask, float>(
     TriangularMatrix<float>&& A,
-    int priority);
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtrm<Target::HostTask, double>(
     TriangularMatrix<double>&& A,
-    int priority);
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtrm< Target::HostTask, std::complex<float> >(
     TriangularMatrix< std::complex<float> >&& A,
-    int priority);
+    int priority, int64_t queue_index);
 
 // ----------------------------------------
 template
 void trtrm< Target::HostTask, std::complex<double> >(
     TriangularMatrix< std::complex<double> >&& A,
-    int priority);
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void trtrm<Target::Devices, float>(
+    TriangularMatrix<float>&& A,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void trtrm<Target::Devices, double>(
+    TriangularMatrix<double>&& A,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void trtrm< Target::Devices, std::complex<float> >(
+    TriangularMatrix< std::complex<float> >&& A,
+    int priority, int64_t queue_index);
+
+// ----------------------------------------
+template
+void trtrm< Target::Devices, std::complex<double> >(
+    TriangularMatrix< std::complex<double> >&& A,
+    int priority, int64_t queue_index);
 
 } // namespace internal
 } // namespace slate
@@ -152,7 +152,7 @@ void ttmlq(internal::TargetType<Target::HostTask>,
                         // until receiving it back
                         MPI_Request req;
                         C.tileIsend( i, j, dst, tag+k, &req );
-                        MPI_Request_free( &req );
+                        slate_mpi_call( MPI_Request_free( &req ) );
                         message_count++;
                     }
                 }
@@ -190,8 +190,7 @@ void ttmlq(internal::TargetType<Target::HostTask>,
                         requests.push_back( req );
                     }
                 }
-                slate_mpi_call(
-                    MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
+                internal::comm_waitall( requests.size(), requests.data() );
             }
             else {
                 int64_t k_src = rank_indices[ index - step ].second;
@@ -259,7 +258,7 @@ void ttmlq(internal::TargetType<Target::HostTask>,
                             firstprivate( side, op, tag, recv_index )
                         {
                             // Don't start compute until the tile's been recieved
-                            MPI_Wait( &requests[ recv_index ], MPI_STATUS_IGNORE );
+                            internal::comm_wait( &requests[ recv_index ] );
 
                             A.tileGetForReading(0, rank_ind, LayoutConvert(layout));
                             T.tileGetForReading(0, rank_ind, LayoutConvert(layout));
@@ -278,8 +277,7 @@ void ttmlq(internal::TargetType<Target::HostTask>,
                     }
                 }
                 #pragma omp taskwait
-                slate_mpi_call(
-                    MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
+                internal::comm_waitall( requests.size(), requests.data() );
             }
             break;
         }
@@ -9,6 +9,8 @@
 #include "internal/internal.hh"
 #include "internal/internal_util.hh"
 
+#include <array>
+
 namespace slate {
 namespace internal {
 
@@ -33,13 +35,64 @@ void ttmqr(Side side, Op op,
           side, op, A, T, C, tag );
 }
 
+//------------------------------------------------------------------------------
+/// Applies Q from one tpqrt of the reduction tree to the local tiles of C
+/// on one device, as tpmqrt calls on the device's queue.
+/// The pairs of tiles, C(i1, j1) received from the src rank and the local
+/// C(i, j), are listed in tiles.
+///
+template <typename scalar_t>
+void ttmqr_device(
+    Side side, Op op,
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& T,
+    Matrix<scalar_t>& C,
+    int64_t rank_ind, int device, int queue_index,
+    std::vector< std::array<int64_t, 4> > const& tiles )
+{
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    A.tileGetForReading( rank_ind, 0, device, LayoutConvert( layout ) );
+    T.tileGetForReading( rank_ind, 0, device, LayoutConvert( layout ) );
+
+    int64_t ib = std::min( T.tileMb( rank_ind ), A.tileNb( 0 ) );
+    int64_t work_size = 0;
+    for (auto& ij : tiles) {
+        int64_t i = ij[ 0 ], j = ij[ 1 ], i1 = ij[ 2 ], j1 = ij[ 3 ];
+        C.tileGetForWriting( i,  j,  device, LayoutConvert( layout ) );
+        C.tileGetForWriting( i1, j1, device, LayoutConvert( layout ) );
+        int64_t mn = (side == Side::Left ? C.tileNb( j ) : C.tileMb( i ));
+        work_size = std::max( work_size, 2*ib*mn );
+    }
+
+    blas::Queue* queue = C.compute_queue( device, queue_index );
+    scalar_t* work = C.allocWorkspaceBuffer( device, work_size );
+
+    int64_t l = std::min( A.tileMb( rank_ind ), A.tileNb( 0 ) );
+    auto A_ii = A( rank_ind, 0, device );
+    auto T_ii = T( rank_ind, 0, device );
+    for (auto& ij : tiles) {
+        int64_t i = ij[ 0 ], j = ij[ 1 ], i1 = ij[ 2 ], j1 = ij[ 3 ];
+        // Apply Q; tiles share work, as they are serialized on queue.
+        tpmqrt( side, op, l, A_ii, T_ii,
+                C( i1, j1, device ), C( i, j, device ),
+                work, *queue );
+    }
+    queue->sync();
+
+    C.freeWorkspaceBuffer( device, work );
+}
+
 //------------------------------------------------------------------------------
 /// Distributed multiply matrix by Q from QR triangle-triangle factorization of
-/// column of tiles, host implementation.
+/// column of tiles, host and GPU device implementation.
+/// With Target::Devices, C tiles are received to and updated on devices,
+/// batched per device; with GPU-aware MPI, they stay on devices.
 /// @ingroup geqrf_internal
 ///
-template <typename scalar_t>
-void ttmqr(internal::TargetType<Target::HostTask>,
+template <Target target, typename scalar_t>
+void ttmqr(internal::TargetType<target>,
            Side side, Op op,
            Matrix<scalar_t>& A,
            Matrix<scalar_t>& T,
@@ -153,7 +206,7 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                         // until receiving it back
                         MPI_Request req;
                         C.tileIsend( i, j, dst, tag+k, &req );
-                        MPI_Request_free( &req );
+                        slate_mpi_call( MPI_Request_free( &req ) );
                         message_count++;
                     }
                 }
@@ -186,12 +239,12 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                         }
                         int dst = C.tileRank(i_dst, j_dst);
                         MPI_Request req;
-                        C.tileIrecv( i, j, dst, layout, tag+k, &req );
+                        C.template tileIrecv<target>(
+                            i, j, dst, layout, tag+k, &req );
                         requests.push_back( req );
                     }
                 }
-                slate_mpi_call(
-                    MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
+                internal::comm_waitall( requests.size(), requests.data() );
 
             }
             else {
@@ -222,7 +275,8 @@ void ttmqr(internal::TargetType<Target::HostTask>,
 
                         int src = C.tileRank( i1, j1 );
                         MPI_Request req;
-                        C.tileIrecv( i1, j1, src, layout, tag+k, &req );
+                        C.template tileIrecv<target>(
+                            i1, j1, src, layout, tag+k, &req );
                         requests.push_back( req );
                         message_count++;
                     }
@@ -232,6 +286,70 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                     continue;
                 }
 
+                if (target == Target::Devices) {
+                    // Group tile pairs by device of the local tile.
+                    std::vector< std::vector< std::array<int64_t, 4> > >
+                        device_tiles( C.num_devices() );
+                    for (int64_t k = 0; k < k_end; ++k) {
+                        if (side == Side::Left) {
+                            i = rank_ind;
+                            j = k;
+                            i1 = k_src;
+                            j1 = k;
+                        }
+                        else {
+                            i = k;
+                            j = rank_ind;
+                            i1 = k;
+                            j1 = k_src;
+                        }
+                        if (C.tileIsLocal(i, j)) {
+                            device_tiles[ C.tileDevice( i, j ) ].push_back(
+                                { i, j, i1, j1 } );
+                        }
+                    }
+
+                    internal::comm_waitall( requests.size(), requests.data() );
+
+                    #pragma omp taskgroup
+                    for (int device = 0; device < C.num_devices(); ++device) {
+                        if (! device_tiles[ device ].empty()) {
+                            #pragma omp task slate_omp_default_none \
+                                shared( A, T, C, device_tiles ) \
+                                firstprivate( side, op, rank_ind, device )
+                            {
+                                ttmqr_device( side, op, A, T, C, rank_ind,
+                                              device, 0, device_tiles[ device ] );
+                            }
+                        }
+                    }
+
+                    // Send updated tiles back, from devices if GPU-aware.
+                    requests.clear();
+                    for (int64_t k = 0; k < k_end; ++k) {
+                        if (side == Side::Left) {
+                            i = rank_ind;
+                            j = k;
+                            i1 = k_src;
+                            j1 = k;
+                        }
+                        else {
+                            i = k;
+                            j = rank_ind;
+                            i1 = k;
+                            j1 = k_src;
+                        }
+                        if (C.tileIsLocal(i, j)) {
+                            int src = C.tileRank( i1, j1 );
+                            MPI_Request req;
+                            C.tileIsend( i1, j1, src, tag+k, &req );
+                            requests.push_back( req );
+                        }
+                    }
+                    internal::comm_waitall( requests.size(), requests.data() );
+                    break;
+                }
+
                 // The above and below loops iterate in the same order, so incrementing
                 // this counter gives the right request object
                 int64_t recv_index = 0;
@@ -260,7 +378,7 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                             firstprivate( side, op, tag, recv_index )
                         {
                             // Don't start compute until the tile's been recieved
-                            MPI_Wait( &requests[ recv_index ], MPI_STATUS_IGNORE );
+                            internal::comm_wait( &requests[ recv_index ] );
 
                             A.tileGetForReading(rank_ind, 0, LayoutConvert(layout));
                             T.tileGetForReading(rank_ind, 0, LayoutConvert(layout));
@@ -279,8 +397,7 @@ void ttmqr(internal::TargetType<Target::HostTask>,
                     }
                 }
                 #pragma omp taskwait
-                slate_mpi_call(
-                    MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE ) );
+                internal::comm_waitall( requests.size(), requests.data() );
             }
             break;
         }
@@ -302,6 +419,14 @@ void ttmqr<Target::HostTask, float>(
     Matrix<float>&& C,
     int tag );
 
+template
+void ttmqr<Target::Devices, float>(
+    Side side, Op op,
+    Matrix<float>&& A,
+    Matrix<float>&& T,
+    Matrix<float>&& C,
+    int tag );
+
 // ----------------------------------------
 template
 void ttmqr<Target::HostTask, double>(
@@ -311,6 +436,14 @@ void ttmqr<Target::HostTask, double>(
     Matrix<double>&& C,
     int tag );
 
+template
+void ttmqr<Target::Devices, double>(
+    Side side, Op op,
+    Matrix<double>&& A,
+    Matrix<double>&& T,
+    Matrix<double>&& C,
+    int tag );
+
 // ----------------------------------------
 template
 void ttmqr< Target::HostTask, std::complex<float> >(
@@ -320,6 +453,14 @@ void ttmqr< Target::HostTask, std::complex<float> >(
     Matrix< std::complex<float> >&& C,
     int tag );
 
+template
+void ttmqr< Target::Devices, std::complex<float> >(
+    Side side, Op op,
+    Matrix< std::complex<float> >&& A,
+    Matrix< std::complex<float> >&& T,
+    Matrix< std::complex<float> >&& C,
+    int tag );
+
 // ----------------------------------------
 template
 void ttmqr< Target::HostTask, std::complex<double> >(
@@ -329,5 +470,13 @@ void ttmqr< Target::HostTask, std::complex<double> >(
     Matrix< std::complex<double> >&& C,
     int tag );
 
+template
+void ttmqr< Target::Devices, std::complex<double> >(
+    Side side, Op op,
+    Matrix< std::complex<double> >&& A,
+    Matrix< std::complex<double> >&& T,
+    Matrix< std::complex<double> >&& C,
+    int tag );
+
 } // namespace internal
 } // namespace slate
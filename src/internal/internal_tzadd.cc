@@ -134,7 +134,7 @@ void add(internal::TargetType<Target::Devices>,
             //       and possibly wrong, because an input matrix is being altered
             // todo: best, handle directly through the CUDA kernels
             auto layout = Layout::ColMajor;
-            std::set<ij_tuple> A_tiles_set, B_tiles_set;
+            TileSet A_tiles_set, B_tiles_set;
 
             if (B.uplo() == Uplo::Lower) {
                 for (int64_t j = 0; j < B.nt(); ++j) {
@@ -66,8 +66,8 @@ void copy(internal::TargetType<Target::HostTask>,
                         firstprivate( i, j )
                     {
                         A.tileGetForReading(i, j, LayoutConvert::None);
-                        B.tileAcquire(i, j, A.tileLayout(i, j));
-                        B.tileModified(i, j, HostNum, true);
+                        B.tileAcquireForOverwrite(
+                            i, j, HostNum, A.tileLayout(i, j) );
                         tile::gecopy( A(i, j), B(i, j) );
                     }
                 }
@@ -81,8 +81,8 @@ void copy(internal::TargetType<Target::HostTask>,
                         firstprivate( i, j )
                     {
                         A.tileGetForReading(i, j, LayoutConvert::None);
-                        B.tileAcquire(i, j, A.tileLayout(i, j));
-                        B.tileModified(i, j, HostNum, true);
+                        B.tileAcquireForOverwrite(
+                            i, j, HostNum, A.tileLayout(i, j) );
                         tile::gecopy( A(i, j), B(i, j) );
                     }
                 }
@@ -114,7 +114,7 @@ void copy(internal::TargetType<Target::Devices>,
         #pragma omp task slate_omp_default_none priority( priority ) \
             shared( A, B ) firstprivate( device, lower, queue_index )
         {
-            std::set<ij_tuple> A_tiles, B_diag_tiles;
+            TileSet A_tiles, B_diag_tiles;
             for (int64_t i = 0; i < B.mt(); ++i) {
                 for (int64_t j = 0; j < B.nt(); ++j) {
                     if (B.tileIsLocal(i, j) && device == B.tileDevice(i, j)
@@ -126,15 +126,15 @@ void copy(internal::TargetType<Target::Devices>,
                             B_diag_tiles.insert( { i, j } );
                         }
                         else {
-                            B.tileAcquire( i, j, device, Layout::ColMajor );
-                            B.tileModified( i, j, device, true );
+                            B.tileAcquireForOverwrite(
+                                i, j, device, Layout::ColMajor );
                         }
                     }
                 }
             }
             // For B, diagonal tiles must be fetched for writing;
             // off-diagonal tiles can be fetched for over-writing
-            // (tileAcquire above).
+            // (tileAcquireForOverwrite above).
             // TODO no need to conver layout of A but kernel assumes column major
             A.tileGetForReading( A_tiles, device, LayoutConvert::ColMajor );
             B.tileGetForWriting( B_diag_tiles, device, LayoutConvert::ColMajor );
@@ -130,7 +130,7 @@ void set(
             //       and possibly wrong, because an input matrix is being altered
             // todo: best, handle directly through the CUDA kernels
             auto layout = LayoutConvert::ColMajor;
-            std::set<ij_tuple> A_tiles_set;
+            TileSet A_tiles_set;
 
             if (A.uplo() == Uplo::Lower) {
                 for (int64_t j = 0; j < A.nt(); ++j) {
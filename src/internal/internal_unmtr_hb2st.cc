@@ -20,9 +20,10 @@ template <Target target, typename scalar_t>
 void unmtr_hb2st(
     Side side, Op op,
     Matrix<scalar_t>& V,
-    Matrix<scalar_t>& C )
+    Matrix<scalar_t>& C,
+    int64_t group_size )
 {
-    unmtr_hb2st(internal::TargetType<target>(), side, op, V, C);
+    unmtr_hb2st(internal::TargetType<target>(), side, op, V, C, group_size);
 }
 
 //------------------------------------------------------------------------------
@@ -32,15 +33,28 @@ void unmtr_hb2st(
 /// Eigenvalue Solvers, SLATE Working Notes, no. 13.
 /// https://www.icl.utk.edu/publications/swan-013
 ///
+/// Q is the product of the sweeps, and within each sweep of the V tiles
+/// (i, j), each a block of nb reflectors acting on rows of C(i, :) and
+/// C(i+1, :). Applying Q C sweep by sweep, from the last sweep, is
+/// equivalent to the wavefront order of SWAN13. Here group_size consecutive
+/// V tiles of a sweep, starting at a multiple of group_size, are
+/// aggregated into one compact-WY block $I - V T V^H$ of up to
+/// group_size*nb reflectors, so the updates of C are gemms with inner
+/// dimension group_size*nb instead of nb. Group a acts on block rows
+/// a*group_size, ..., (a + 1)*group_size of C, so groups a and a+1 overlap
+/// in one block row, as tiles i and i+1 do when group_size = 1.
+///
 /// @ingroup heev_internal
 ///
 template <Target target, typename scalar_t>
 void unmtr_hb2st( internal::TargetType<target>,
                   Side side, Op op,
                   Matrix<scalar_t>& V,
-                  Matrix<scalar_t>& C )
+                  Matrix<scalar_t>& C,
+                  int64_t group_size )
 {
     slate_assert(side == Side::Left);
+    slate_assert(group_size >= 1);
 
     const scalar_t zero = 0, one = 1;
 
@@ -56,48 +70,44 @@ void unmtr_hb2st( internal::TargetType<target>,
     int64_t vm = V.m();
     int64_t vn = V.n();
     auto V_ = V.slice( 1, vm-1, 0, vn-1 );
-    vm -= 1;
 
-    // Local workspaces: T, VT = V T, VC = V^H C, tau is diag of each V tile.
-    // (I - V T V^H) C = C - (V T) V^H C = C - VT VC.
-    // todo: don't need distribution; these are local to each rank.
-    int64_t mt_2 = ceildiv(mt, int64_t(2));
-    Matrix<scalar_t>  T( mt_2*nb, nb, nb, nb, 1, 1, V_.mpiComm() );
-    Matrix<scalar_t> VT( mt_2*vm, nb, vm, nb, 1, 1, V_.mpiComm() );
+    // Number of groups of V tiles in each sweep. Concurrent tasks act on
+    // groups at least 2 apart, so they can share workspace slot a/2.
+    int64_t ngroups = ceildiv( mt, group_size );
+    int64_t nslots = ceildiv( ngroups, int64_t(2) );
+    int64_t gm_max = (group_size + 1)*nb;
+    int64_t gk_max = group_size*nb;
 
-    for (int64_t i = 0; i < mt_2; ++i) {
-        T.tileInsertWorkspace(i, 0);
-        VT.tileInsertWorkspace(i, 0);
+    // Local workspaces: Vg = aggregated V, VT = Vg T, VC = Vg^H C.
+    // (I - Vg T Vg^H) C = C - (Vg T) Vg^H C = C - VT VC.
+    // todo: don't need distribution; these are local to each rank.
+    Matrix<scalar_t> Vg( nslots*gm_max, gk_max, gm_max, gk_max,
+                         1, 1, V_.mpiComm() );
+    Matrix<scalar_t> VT( nslots*gm_max, gk_max, gm_max, gk_max,
+                         1, 1, V_.mpiComm() );
+    for (int64_t s = 0; s < nslots; ++s) {
+        Vg.tileInsertWorkspace(s, 0);
+        VT.tileInsertWorkspace(s, 0);
         if (target == Target::Devices) {
-            T.tileModified(i, 0);
-            VT.tileModified(i, 0);
+            Vg.tileModified(s, 0);
+            VT.tileModified(s, 0);
         }
     }
-    // Number of column blocks of VC
-    // Allocate temporary tile on each device
-    int64_t vc_nt;
-    if (target == Target::Devices) {
-        vc_nt = C.num_devices();
-    }
-    else {
-        vc_nt = 1;
-    }
 
-    Matrix<scalar_t> VC( mt_2*nb, vc_nt*nb, nb, nb, 1, 1, V_.mpiComm() );
-    for (int64_t i = 0; i < mt_2; ++i) {
-        for (int64_t j = 0; j < vc_nt; ++j) {
-            if (target == Target::Devices) {
-                int device = VC.tileDevice(i, j);
-                VC.tileInsertWorkspace(i, j, device);
-            }
-            else {
-                VC.tileInsertWorkspace(i, j);
+    // On devices, one VC tile per slot and device; on the host, each task
+    // has its own VC.
+    Matrix<scalar_t> VC;
+    if (target == Target::Devices) {
+        int num_devices = C.num_devices();
+        VC = Matrix<scalar_t>( nslots*gk_max, num_devices*nb, gk_max, nb,
+                               1, 1, V_.mpiComm() );
+        for (int64_t s = 0; s < nslots; ++s) {
+            for (int d = 0; d < num_devices; ++d) {
+                VC.tileInsertWorkspace(s, d, d);
             }
         }
     }
 
-    std::vector<scalar_t> tau_vector(mt_2*nb);
-
     // Early exit if this rank has no data in C.
     // This lets later code assume every rank gets tiles in V, etc.
     std::set<int> ranks;
@@ -107,348 +117,273 @@ void unmtr_hb2st( internal::TargetType<target>,
     if (ranks.find( C.mpiRank() ) == ranks.end())
         return;
 
+    // gemm on the host, or on a device queue.
+    auto gemm = [&](Op opA, int64_t m, int64_t n, int64_t k,
+                    scalar_t alpha, scalar_t const* A, int64_t lda,
+                                    scalar_t const* B, int64_t ldb,
+                    scalar_t beta,  scalar_t*       C_, int64_t ldc,
+                    blas::Queue* queue)
+    {
+        if (target == Target::Devices) {
+            blas::gemm(Layout::ColMajor, opA, Op::NoTrans, m, n, k,
+                       alpha, A, lda, B, ldb, beta, C_, ldc, *queue);
+        }
+        else {
+            blas::gemm(Layout::ColMajor, opA, Op::NoTrans, m, n, k,
+                       alpha, A, lda, B, ldb, beta, C_, ldc);
+        }
+    };
+
     // OpenMP needs pointer types, but vectors are exception safe.
-    // Add one phantom row at bottom to ease specifying dependencies.
-    std::vector< uint8_t > row_vector(mt+1);
-    uint8_t* row = row_vector.data();
-    SLATE_UNUSED( row ); // Used only by OpenMP
+    // Add one phantom group at bottom to ease specifying dependencies.
+    std::vector< uint8_t > group_vector(ngroups+1);
+    uint8_t* group = group_vector.data();
+    SLATE_UNUSED( group ); // Used only by OpenMP
 
-    // See SWAN13 for the definition of parallel tasks.
-    //
     // The following two for-loops submit tasks in the order
-    // that they become eligible, rather than by columns.
+    // that they become eligible, rather than by sweeps.
     // If OpenMP has a limited window of tasks that it queues,
     // discovering them in this order would be better.
     #pragma omp taskgroup
-    for (int j2 = mt-1; j2 > -mt; --j2) {
-        for (int j = 0; j < mt; ++j) {
-            int i = 2*j - j2;
-            if (j <= i && i < mt) {
-                // Each task updates C(i,:) and C(i+1,:)
-                // using V(r). See SWAN13 for storage layout of V.
-                #pragma omp task depend( inout: row[i] ) \
-                                 depend( inout: row[i+1] )
+    for (int64_t j2 = 2*(mt-1); j2 > -ngroups; --j2) {
+        for (int64_t j = 0; j < mt; ++j) {
+            int64_t a = 2*j - j2;
+            if (j / group_size <= a && a < ngroups) {
+                // Each task updates block rows a*group_size, ...,
+                // (a+1)*group_size of C, using V tiles (i, j) for
+                // i = i_begin, ..., i_end-1 of sweep j.
+                #pragma omp task depend( inout: group[a] ) \
+                                 depend( inout: group[a+1] )
                 {
-                    int64_t mb0 = C.tileMb(i) - 1;
-                    int64_t mb1 = i+1 < mt ? C.tileMb(i+1) : 0;
-                    int64_t vm_ = mb0 + mb1;
-                    int64_t vnb = std::min( nb, vm_ );
-                    assert(vm_ <= vm);
-
-                    // Index of block of V, using lower triangular packed indexing.
-                    int64_t r = i - j + j*mt - j*(j-1)/2;
-
-                    // Send V(0, r) across ranks owning row C(i, :).
-                    // Send from V to be contiguous, instead of V_.
-                    // todo make async; put in different task.
-                    V.tileBcast(0, r, C.sub(i, i, 0, nt-1), Layout::ColMajor, j);
-
-                    auto Vr = V_(0, r);
-                    scalar_t* Vr_data = Vr.data();
-                    int64_t ldv = Vr.stride();
-
-                    // Copy tau, which is stored on diag(Vr), and set diag(Vr) = 1.
-                    // diag(Vr) is restored later.
-                    scalar_t* tau = &tau_vector[ (i/2)*nb ];
-                    for (int64_t ii = 0; ii < vnb; ++ii) {
-                        tau[ii] = Vr_data[ii + ii*ldv];
-                        Vr_data[ii + ii*ldv] = 1;
+                    int64_t i_begin = std::max( a*group_size, j );
+                    int64_t i_end   = std::min( (a+1)*group_size, mt );
+                    int64_t i_last  = std::min( i_end, mt-1 );
+                    int64_t nblocks = i_end - i_begin;
+                    int64_t slot = a/2;
+
+                    // Rows of Vg of block row i of C: row_offset[ i - i_begin ]
+                    // to row_offset[ i - i_begin + 1 ]. Row 0 is row 1 of
+                    // C(i_begin, :), which V tiles don't touch.
+                    std::vector<int64_t> row_offset( i_last - i_begin + 2 );
+                    row_offset[ 0 ] = 0;
+                    for (int64_t i = i_begin; i <= i_last; ++i) {
+                        row_offset[ i - i_begin + 1 ] = row_offset[ i - i_begin ]
+                            + C.tileMb(i) - (i == i_begin ? 1 : 0);
+                    }
+                    int64_t gm = row_offset[ i_last - i_begin + 1 ];
+
+                    // V tile i starts at row 1 of C(i, :) and ends at the end
+                    // of C(i+1, :); it is columns col_offset[ i - i_begin ]
+                    // to col_offset[ i - i_begin + 1 ] of Vg.
+                    std::vector<int64_t> v_offset( nblocks ), v_rows( nblocks );
+                    std::vector<int64_t> col_offset( nblocks + 1 );
+                    col_offset[ 0 ] = 0;
+                    for (int64_t k = 0; k < nblocks; ++k) {
+                        int64_t k_end = std::min( k + 2, i_last - i_begin + 1 );
+                        v_offset[ k ] = row_offset[ k ] + (k > 0 ? 1 : 0);
+                        v_rows[ k ] = row_offset[ k_end ] - v_offset[ k ];
+                        col_offset[ k+1 ] = col_offset[ k ]
+                                          + std::min( nb, v_rows[ k ] );
+                    }
+                    int64_t gk = col_offset[ nblocks ];
+
+                    if (target == Target::Devices) {
+                        Vg.tileGetForWriting(slot, 0, LayoutConvert::None);
+                        VT.tileGetForWriting(slot, 0, LayoutConvert::None);
+                    }
+                    auto Vg_s = Vg(slot, 0);
+                    auto VT_s = VT(slot, 0);
+                    int64_t ldvg = Vg_s.stride();
+                    int64_t ldvt = VT_s.stride();
+                    Vg_s.set(zero, zero);
+
+                    // Copy the V tiles into Vg, with unit diagonal;
+                    // tau is stored on diag of each V tile.
+                    std::vector<scalar_t> tau( std::max( gk, int64_t(1) ) );
+                    for (int64_t i = i_begin; i < i_end; ++i) {
+                        int64_t k = i - i_begin;
+                        int64_t r = i - j + j*mt - j*(j-1)/2;
+                        int64_t vnb = col_offset[ k+1 ] - col_offset[ k ];
+
+                        // Send V(0, r) across ranks owning row C(i, :).
+                        // Send from V to be contiguous, instead of V_.
+                        // todo make async; put in different task.
+                        V.tileBcast(0, r, C.sub(i, i, 0, nt-1), Layout::ColMajor, j);
+
+                        auto Vr = V_(0, r);
+                        scalar_t* Vg_k = &Vg_s.at( v_offset[ k ], col_offset[ k ] );
+                        lapack::lacpy( lapack::MatrixType::Lower, v_rows[ k ], vnb,
+                                       Vr.data(), Vr.stride(), Vg_k, ldvg );
+                        for (int64_t ii = 0; ii < vnb; ++ii)
+                            tau[ col_offset[ k ] + ii ] = Vr( ii, ii );
+                        lapack::laset( lapack::MatrixType::Upper, vnb, vnb,
+                                       zero, one, Vg_k, ldvg );
+
+                        V.releaseLocalWorkspaceTile(0, r);
+                        V.releaseRemoteWorkspaceTile(0, r);
+                    }
+
+                    // T of each V tile, then merge them: the group applies
+                    // H_last ... H_first, so for Vp = tiles before k,
+                    // (I - Vk Tk Vk^H)(I - Vp Tp Vp^H) = I - V T V^H with
+                    // T = [ Tp, 0; -Tk Vk^H Vp Tp, Tk ], lower block triangular.
+                    int64_t ldt = std::max( gk, int64_t(1) );
+                    std::vector<scalar_t> T( ldt*ldt, zero );
+                    std::vector<scalar_t> W( nb*ldt );
+                    for (int64_t k = 0; k < nblocks; ++k) {
+                        int64_t ck  = col_offset[ k ];
+                        int64_t vnb = col_offset[ k+1 ] - ck;
+                        int64_t vm_ = gm - v_offset[ k ];
+                        if (vnb == 0)
+                            continue;
+                        scalar_t* Vg_k = &Vg_s.at( v_offset[ k ], ck );
+                        scalar_t* Tkk = &T[ ck + ck*ldt ];
+                        lapack::larft( Direction::Forward,
+                                       lapack::StoreV::Columnwise,
+                                       vm_, vnb, Vg_k, ldvg,
+                                       &tau[ ck ], Tkk, ldt );
+                        if (ck > 0) {
+                            // W = Vk^H Vp; Vk is zero above v_offset[ k ].
+                            blas::gemm( Layout::ColMajor,
+                                        Op::ConjTrans, Op::NoTrans,
+                                        vnb, ck, vm_,
+                                        one,  Vg_k, ldvg,
+                                              &Vg_s.at( v_offset[ k ], 0 ), ldvg,
+                                        zero, W.data(), vnb );
+                            // T( k, p ) = -Tk W Tp
+                            blas::gemm( Layout::ColMajor,
+                                        Op::NoTrans, Op::NoTrans,
+                                        vnb, ck, ck,
+                                        one,  W.data(), vnb,
+                                              T.data(), ldt,
+                                        zero, &T[ ck ], ldt );
+                            blas::trmm( Layout::ColMajor, Side::Left,
+                                        Uplo::Upper, Op::NoTrans, Diag::NonUnit,
+                                        vnb, ck,
+                                        -one, Tkk, ldt, &T[ ck ], ldt );
+                        }
                     }
 
-                    // larft and prefetch of V and C in parallel
-                    #pragma omp taskgroup
+                    // VT = Vg T.
+                    blas::gemm( Layout::ColMajor, Op::NoTrans, Op::NoTrans,
+                                gm, gk, gk,
+                                one,  Vg_s.data(), ldvg,
+                                      T.data(), ldt,
+                                zero, VT_s.data(), ldvt );
+
+                    // Block row t of C meets V tiles t-1 and t, which are
+                    // columns [ c_lo, c_mid ) and [ c_mid, c_hi ) of Vg.
+                    // Since T is lower block triangular, block row t of VT
+                    // is nonzero only in columns [ 0, c_hi ).
+                    auto columns = [&](int64_t t, int64_t* c_lo,
+                                       int64_t* c_mid, int64_t* c_hi)
+                    {
+                        int64_t k = t - i_begin;
+                        *c_lo  = col_offset[ std::max( k-1, int64_t(0) ) ];
+                        *c_mid = col_offset[ std::min( k, nblocks ) ];
+                        *c_hi  = col_offset[ std::min( k+1, nblocks ) ];
+                    };
+
+                    // C( i_begin : i_last, c ) = (I - Vg T Vg^H) C( ..., c ),
+                    // skipping the first row of C( i_begin, c ).
+                    auto apply = [&](int64_t c, int device,
+                                     scalar_t const* Vg_data,
+                                     scalar_t const* VT_data,
+                                     scalar_t* VC_data, int64_t ldvc,
+                                     blas::Queue* queue)
                     {
-                        // larft and then form VT = V * T.
-                        #pragma omp task
-                        {
-                            // larft and prefetch of V and VT in parallel
-                            #pragma omp taskgroup
+                        int64_t cnb = C.tileNb(c);
+                        assert( target != Target::Devices || cnb <= nb );
+                        // VC = Vg^H C.
+                        for (int64_t t = i_begin; t <= i_last; ++t) {
+                            // ensures 1D column block distribution for C
+                            assert( C.tileIsLocal(t, c) );
+                            auto Ct = C(t, c, device);
+                            int64_t r0 = (t == i_begin ? 1 : 0);
+                            int64_t mbt = Ct.mb() - r0;
+                            int64_t gr = row_offset[ t - i_begin ];
+                            int64_t c_lo, c_mid, c_hi;
+                            columns( t, &c_lo, &c_mid, &c_hi );
+                            // Columns of tile t-1 were set by block row t-1.
+                            gemm( Op::ConjTrans, c_mid - c_lo, cnb, mbt,
+                                  one, &Vg_data[ gr + c_lo*ldvg ], ldvg,
+                                       &Ct.data()[ r0 ], Ct.stride(),
+                                  one, &VC_data[ c_lo ], ldvc, queue );
+                            gemm( Op::ConjTrans, c_hi - c_mid, cnb, mbt,
+                                  one,  &Vg_data[ gr + c_mid*ldvg ], ldvg,
+                                        &Ct.data()[ r0 ], Ct.stride(),
+                                  zero, &VC_data[ c_mid ], ldvc, queue );
+                        }
+                        // C -= VT VC.
+                        for (int64_t t = i_begin; t <= i_last; ++t) {
+                            auto Ct = C(t, c, device);
+                            int64_t r0 = (t == i_begin ? 1 : 0);
+                            int64_t mbt = Ct.mb() - r0;
+                            int64_t gr = row_offset[ t - i_begin ];
+                            int64_t c_lo, c_mid, c_hi;
+                            columns( t, &c_lo, &c_mid, &c_hi );
+                            gemm( Op::NoTrans, mbt, cnb, c_hi,
+                                  -one, &VT_data[ gr ], ldvt,
+                                        VC_data, ldvc,
+                                  one,  &Ct.data()[ r0 ], Ct.stride(), queue );
+                        }
+                        if (queue != nullptr)
+                            queue->sync();
+                    };
+
+                    if (target == Target::Devices) {
+                        // One task per device, each over its columns of C.
+                        #pragma omp taskgroup
+                        for (int d = 0; d < C.num_devices(); ++d) {
+                            #pragma omp task slate_omp_default_none \
+                                firstprivate( d, slot, i_begin, i_last, nt ) \
+                                shared( Vg, VT, VC, C, apply )
                             {
-                                int device = C.tileDevice(i, 0);
-                                // larft on host and then prefetch output T of larft.
-                                #pragma omp task
-                                {
-                                    // Form T from Vr and tau.
-                                    if (target == Target::Devices) {
-                                        T.tileGetForWriting(i/2, 0, LayoutConvert::None);
-                                    }
-                                    T(i/2, 0).set(zero, zero);
-                                    lapack::larft(Direction::Forward, lapack::StoreV::Columnwise,
-                                                  vm_, vnb,
-                                                  Vr.data(), Vr.stride(), tau,
-                                                  T(i/2, 0).data(), T(i/2, 0).stride());
-                                    if (target == Target::Devices) {
-                                        T.tileGetForReading(i/2, 0, device, LayoutConvert::None);
-                                    }
-                                }
-                                if (target == Target::Devices) {
-                                    #pragma omp task slate_omp_default_none \
-                                        firstprivate( r, device ) shared( V_ )
-                                    {
-                                        V_.tileGetForReading(0, r, device, LayoutConvert::None);
-                                    }
-                                    #pragma omp task slate_omp_default_none \
-                                        firstprivate( i, device ) shared( VT )
-                                    {
-                                        // VT is only written so use tileAcquire
-                                        VT.tileAcquire(i/2, 0, device, Layout::ColMajor);
-                                        VT.tileModified(i/2, 0, device, true);
-                                    }
-                                }
-                            }
-                            // Form VT = V * T. Assumes 0's stored in lower T.
-                            // vm_-by-vnb = (vm_-by-vnb) (vnb-by-vnb)
-                            if (target == Target::Devices) {
-                                int device = C.tileDevice(i, 0);
-                                blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                blas::gemm(Layout::ColMajor,
-                                           Op::NoTrans, Op::NoTrans,
-                                           vm_, vnb, vnb,
-                                           one,
-                                           V_(0, r, device).data(),
-                                           V_(0, r, device).stride(),
-                                           T(i/2, 0, device).data(),
-                                           T(i/2, 0, device).stride(),
-                                           zero,
-                                           VT(i/2, 0, device).data(),
-                                           VT(i/2, 0, device).stride(),
-                                           *queue);
-                                queue->sync();
-                            }
-                            else {
-                                blas::gemm(Layout::ColMajor,
-                                           Op::NoTrans, Op::NoTrans,
-                                           vm_, vnb, vnb,
-                                           one,
-                                           V_(0, r).data(),
-                                           V_(0, r).stride(),
-                                           T(i/2, 0).data(),
-                                           T(i/2, 0).stride(),
-                                           zero,
-                                           VT(i/2, 0).data(),
-                                           VT(i/2, 0).stride());
-                            }
-                            if (target == Target::Devices) {
-                                #pragma omp taskgroup
-                                {
-                                    for (int d = 0; d < C.num_devices(); ++d)
-                                    {
-                                        // prefetch VT on all devices for C -= VT VC operation
-                                        #pragma omp task slate_omp_default_none \
-                                            firstprivate( d, i ) shared( VT )
-                                        {
-                                            VT.tileGetForReading(i/2, 0, d, LayoutConvert::None);
+                                bool have_tiles = false;
+                                for (int64_t c = 0; c < nt; ++c) {
+                                    if (C.tileIsLocal(i_begin, c)
+                                        && C.tileDevice(i_begin, c) == d) {
+                                        for (int64_t t = i_begin; t <= i_last; ++t) {
+                                            C.tileGetForWriting(t, c, d, LayoutConvert::None);
                                         }
+                                        have_tiles = true;
                                     }
                                 }
-                            }
-                        }
-                        if (target == Target::Devices) {
-                            // prefetch V on all devices for VC += V^H C
-                            for (int d = 0; d < C.num_devices(); ++d) {
-                                #pragma omp task slate_omp_default_none \
-                                    firstprivate( d, r ) shared( V_ )
-                                {
-                                    V_.tileGetForReading(0, r, d, LayoutConvert::None);
-                                }
-                            }
-                            // prefetch C for C -= VT VC operation
-                            for (int64_t k = 0; k < nt; ++k) {
-                                if (C.tileIsLocal(i, k)) {
-                                    int device = C.tileDevice(i, k);
-                                    #pragma omp task slate_omp_default_none \
-                                        firstprivate( i, k, device ) shared( C )
-                                    {
-                                        C.tileGetForWriting(i, k, device, LayoutConvert::None);
-                                    }
-                                    if (i+1 < mt) {
-                                        #pragma omp task slate_omp_default_none \
-                                            firstprivate( i, k, device ) shared( C )
-                                        {
-                                            // Device of C(i+1, k) is equal to C(i, k) since 1D column
-                                            // cyclic distribution is used.
-                                            C.tileGetForWriting(i+1, k, device, LayoutConvert::None);
+                                if (have_tiles) {
+                                    Vg.tileGetForReading(slot, 0, d, LayoutConvert::None);
+                                    VT.tileGetForReading(slot, 0, d, LayoutConvert::None);
+                                    auto VC_d = VC(slot, d, d);
+                                    blas::Queue* queue = C.compute_queue(d, omp_get_thread_num());
+                                    for (int64_t c = 0; c < nt; ++c) {
+                                        if (C.tileIsLocal(i_begin, c)
+                                            && C.tileDevice(i_begin, c) == d) {
+                                            apply( c, d, Vg(slot, 0, d).data(),
+                                                   VT(slot, 0, d).data(),
+                                                   VC_d.data(), VC_d.stride(),
+                                                   queue );
                                         }
                                     }
                                 }
                             }
                         }
                     }
-
-                    // Vr = [ Vr0 ],  VT = [ VT0 ],  [ Ci     ] = [ C0 ],
-                    //      [ Vr1 ]        [ VT1 ]   [ C{i+1} ] = [ C1 ]
-                    // Vr and VT are (mb0 + mb1)-by-vnb = vm_-by-vnb,
-                    // C0 is mb0-by-cnb,
-                    // C1 is mb1-by-cnb.
-                    for (int64_t k = 0; k < nt; ++k) { // todo This for-loop must be parallelized.
-                        if (C.tileIsLocal(i, k)) {
-                            auto C0 = C(i, k);
-                            int64_t cnb = C0.nb();
-                            if (target != Target::Devices) {
-                                assert( cnb <= VC(i/2, 0).nb() );
-                            }
-                            assert( C0.mb()-1 == mb0 );  // After 1st row sliced off.
-                            int device = C.tileDevice(i, k);
-
-                            // VC = Vr0^H C0
-                            // vnb-by-cnb = (mb0-by-vnb)^H (mb0-by-cnb)
-                            // Slice off 1st row of C0.
-                            // C0
-                            if (target == Target::Devices) {
-                                blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                blas::gemm(Layout::ColMajor,
-                                           Op::ConjTrans, Op::NoTrans,
-                                           vnb, cnb, mb0,
-                                           one,
-                                           V_(0, r, device).data(),
-                                           V_(0, r, device).stride(),
-                                           &C(i, k, device).data()[ 1 ],
-                                           C(i, k, device).stride(),
-                                           zero,
-                                           VC(i/2, device, device).data(),
-                                           VC(i/2, device, device).stride(),
-                                           *queue);
-                                queue->sync();
-                            }
-                            else {
-                                blas::gemm(Layout::ColMajor,
-                                           Op::ConjTrans, Op::NoTrans,
-                                           vnb, cnb, mb0,
-                                           one,
-                                           V_(0, r).data(),
-                                           V_(0, r).stride(),
-                                           &C(i, k).data()[ 1 ],
-                                           C(i, k).stride(),
-                                           zero,
-                                           VC(i/2, 0).data(),
-                                           VC(i/2, 0).stride());
-                            }
-
-                            // VC += Vr1^H C1
-                            // vnb-by-cnb += (mb1-by-vnb)^H (mb1-by-cnb)
-                            Tile<scalar_t> C1;
-                            if (i+1 < mt) {
-                                // ensures 1D column block distribution for C
-                                assert(C.tileIsLocal(i+1, k));
-                                C1 = C(i+1, k);
-                                if (target == Target::Devices) {
-                                    blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                    blas::gemm(Layout::ColMajor,
-                                               Op::ConjTrans, Op::NoTrans,
-                                               vnb, cnb, mb1,
-                                               one,
-                                               &(V_(0, r, device).data()[ mb0 ]),
-                                               V_(0, r, device).stride(),
-                                               C(i+1, k, device).data(),
-                                               C(i+1, k, device).stride(),
-                                               one,
-                                               VC(i/2, device, device).data(),
-                                               VC(i/2, device, device).stride(),
-                                               *queue);
-                                    queue->sync();
-                                }
-                                else {
-                                    blas::gemm(Layout::ColMajor,
-                                               Op::ConjTrans, Op::NoTrans,
-                                               vnb, cnb, mb1,
-                                               one,
-                                               &(V_(0, r).data()[ mb0 ]),
-                                               V_(0, r).stride(),
-                                               C(i+1, k).data(),
-                                               C(i+1, k).stride(),
-                                               one,
-                                               VC(i/2, 0).data(),
-                                               VC(i/2, 0).stride());
-                                }
-                            }
-                            #pragma omp taskgroup
-                            {
-                                // C0 -= (V0 T) VC
-                                // mb0-by-cnb -= (mb0-by-vnb) (vnb-by-cnb)
-                                // Slice off 1st row of C0.
-                                #pragma omp task
+                    else {
+                        // One task per column of C.
+                        #pragma omp taskgroup
+                        for (int64_t c = 0; c < nt; ++c) {
+                            if (C.tileIsLocal(i_begin, c)) {
+                                #pragma omp task slate_omp_default_none \
+                                    firstprivate( c, gk ) \
+                                    shared( Vg_s, VT_s, C, apply )
                                 {
-                                    if (target == Target::Devices) {
-                                        blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                        blas::gemm(Layout::ColMajor,
-                                                   Op::NoTrans, Op::NoTrans,
-                                                   mb0, cnb, vnb,
-                                                   -one,
-                                                   VT(i/2, 0, device).data(),
-                                                   VT(i/2, 0, device).stride(),
-                                                   VC(i/2, device, device).data(),
-                                                   VC(i/2, device, device).stride(),
-                                                   one,
-                                                   &C(i, k, device).data()[ 1 ],
-                                                   C(i, k, device).stride(),
-                                                   *queue);
-                                        queue->sync();
-                                    }
-                                    else {
-                                        blas::gemm(Layout::ColMajor,
-                                                   Op::NoTrans, Op::NoTrans,
-                                                   mb0, cnb, vnb,
-                                                   -one,
-                                                   VT(i/2, 0).data(),
-                                                   VT(i/2, 0).stride(),
-                                                   VC(i/2, 0).data(),
-                                                   VC(i/2, 0).stride(),
-                                                   one,
-                                                   &C(i, k).data()[ 1 ],
-                                                   C(i, k).stride());
-                                    }
-                                }
-
-                                // C1 -= (V1 T) VC
-                                // mb1-by-cnb -= (mb1-by-vnb) (vnb-by-cnb)
-                                if (i+1 < mt) {
-                                    #pragma omp task
-                                    {
-                                        if (target == Target::Devices)
-                                        {
-                                            blas::Queue* queue = C.compute_queue(device, omp_get_thread_num());
-                                            blas::gemm(Layout::ColMajor,
-                                                       Op::NoTrans, Op::NoTrans,
-                                                       mb1, cnb, vnb,
-                                                       -one,
-                                                       &VT(i/2, 0, device).data()[ mb0 ],
-                                                       VT(i/2, 0, device).stride(),
-                                                       VC(i/2, device, device).data(),
-                                                       VC(i/2, device, device).stride(),
-                                                       one,
-                                                       C(i+1, k, device).data(),
-                                                       C(i+1, k, device).stride(),
-                                                       *queue);
-                                            queue->sync();
-                                        }
-                                        else
-                                        {
-                                            blas::gemm(Layout::ColMajor,
-                                                       Op::NoTrans, Op::NoTrans,
-                                                       mb1, cnb, vnb,
-                                                       -one,
-                                                       &VT(i/2, 0).data()[ mb0 ],
-                                                       VT(i/2, 0).stride(),
-                                                       VC(i/2, 0).data(),
-                                                       VC(i/2, 0).stride(),
-                                                       one,
-                                                       C(i+1, k).data(),
-                                                       C(i+1, k).stride());
-                                        }
-                                    }
+                                    int64_t ldvc = std::max( gk, int64_t(1) );
+                                    std::vector<scalar_t> VC_c( ldvc*C.tileNb(c) );
+                                    apply( c, HostNum, Vg_s.data(), VT_s.data(),
+                                           VC_c.data(), ldvc, nullptr );
                                 }
                             }
-                        } // if C(i, k) is local
-                    } // inner for loop
-
-                    // Restore diag(Vr) = tau.
-                    if (V_.tileIsLocal(0, r)) {
-                        for (int64_t ii = 0; ii < vnb; ++ii) {
-                            Vr_data[ii + ii*ldv] = tau[ii];
                         }
                     }
-                    V.releaseLocalWorkspaceTile(0, r);
-                    V.releaseRemoteWorkspaceTile(0, r);
                 }
             }
         } // inner loop
@@ -461,49 +396,57 @@ template
 void unmtr_hb2st<Target::HostTask, float>(
     Side side, Op op,
     Matrix<float>& V,
-    Matrix<float>& C );
+    Matrix<float>& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::HostTask, double>(
     Side side, Op op,
     Matrix<double>& V,
-    Matrix<double>& C );
+    Matrix<double>& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::HostTask, std::complex<float> >(
     Side side, Op op,
     Matrix< std::complex<float> >& V,
-    Matrix< std::complex<float> >& C );
+    Matrix< std::complex<float> >& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::HostTask, std::complex<double> >(
     Side side, Op op,
     Matrix< std::complex<double> >& V,
-    Matrix< std::complex<double> >& C );
+    Matrix< std::complex<double> >& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::Devices, float>(
     Side side, Op op,
     Matrix<float>& V,
-    Matrix<float>& C );
+    Matrix<float>& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::Devices, double>(
     Side side, Op op,
     Matrix<double>& V,
-    Matrix<double>& C );
+    Matrix<double>& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::Devices, std::complex<float> >(
     Side side, Op op,
     Matrix< std::complex<float> >& V,
-    Matrix< std::complex<float> >& C );
+    Matrix< std::complex<float> >& C,
+    int64_t group_size );
 
 template
 void unmtr_hb2st<Target::Devices, std::complex<double> >(
     Side side, Op op,
     Matrix< std::complex<double> >& V,
-    Matrix< std::complex<double> >& C );
+    Matrix< std::complex<double> >& C,
+    int64_t group_size );
 
 } // namespace internal
 } // namespace slate
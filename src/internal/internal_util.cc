@@ -48,5 +48,53 @@ void mpi_max_nan(void* invec, void* inoutvec, int* len, MPI_Datatype* datatype)
     }
 }
 
+//------------------------------------------------------------------------------
+/// [internal]
+/// Reduces count entries per element: the first by max_nan, the rest by sum.
+///
+template <typename real_t>
+void max_nan_first_sum_rest(real_t* x, real_t* y, int len, int count)
+{
+    for (int k = 0; k < len; ++k) {
+        y[0] = max_nan(x[0], y[0]);
+        for (int i = 1; i < count; ++i)
+            y[i] += x[i];
+        x += count;
+        y += count;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// [internal]
+/// Implements a custom MPI reduction for slate::norms, which reduces the
+/// max norm and the sums of the other norms together.
+/// The datatype is a contiguous type of MPI_DOUBLE or MPI_FLOAT entries,
+/// whose first entry is reduced by max, propagating NaNs, and the rest by
+/// sum. Elements of a derived datatype aren't split by the reduction, so
+/// the first entry is always the max.
+///
+void mpi_max_nan_first_sum_rest(
+    void* invec, void* inoutvec, int* len, MPI_Datatype* datatype)
+{
+    int num_ints, num_addrs, num_types, combiner;
+    MPI_Type_get_envelope(*datatype, &num_ints, &num_addrs, &num_types,
+                          &combiner);
+    assert(combiner == MPI_COMBINER_CONTIGUOUS);
+
+    int count;
+    MPI_Aint addr;
+    MPI_Datatype base;
+    MPI_Type_get_contents(*datatype, 1, 0, 1, &count, &addr, &base);
+
+    if (base == MPI_DOUBLE) {
+        max_nan_first_sum_rest((double*) invec, (double*) inoutvec,
+                               *len, count);
+    }
+    else if (base == MPI_FLOAT) {
+        max_nan_first_sum_rest((float*) invec, (float*) inoutvec,
+                               *len, count);
+    }
+}
+
 } // namespace internal
 } // namespace slate
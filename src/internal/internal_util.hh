@@ -12,8 +12,10 @@
 #include "slate/internal/mpi.hh"
 #include "slate/Matrix.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <vector>
 
 #include <blas.hh>
 
@@ -25,6 +27,9 @@ T pow(T base, T exp);
 
 void mpi_max_nan(void* invec, void* inoutvec, int* len, MPI_Datatype* datatype);
 
+void mpi_max_nan_first_sum_rest(
+    void* invec, void* inoutvec, int* len, MPI_Datatype* datatype);
+
 //------------------------------------------
 inline float real(float val) { return val; }
 inline double real(double val) { return val; }
@@ -170,6 +175,74 @@ bool iterRefConverged(std::vector<scalar_t>& colnorms_R,
     return value;
 }
 
+//------------------------------------------------------------------------------
+/// Helper function to stop iterative refinement early.
+/// Extrapolates the average residual reduction per iteration, from r0 to r
+/// in iter iterations, and returns true if at that rate the residual can't
+/// reach target within itermax iterations, or has stagnated.
+/// Needs at least min_iter iterations to estimate the rate.
+template <typename real_t>
+bool iterRefPredictFailure(real_t r0, real_t r, real_t target,
+                           int64_t iter, int64_t itermax,
+                           int64_t min_iter = 3)
+{
+    if (iter < min_iter || r <= target)
+        return false;
+    if (r >= r0)
+        return true;
+
+    // log of the average reduction per iteration, < 0
+    real_t rate = std::log( r / r0 ) / iter;
+    return iter + std::log( target / r ) / rate > itermax;
+}
+
+//------------------------------------------------------------------------------
+/// Counts the block rows and block columns of A in which this rank has
+/// local tiles, for workspace queries: a panel broadcast sends a rank one
+/// remote tile per such block row or column.
+///
+/// @param[in] A
+///     The matrix.
+///
+/// @param[out] rows
+///     rows[ 0 ] is the number of block rows with local tiles, and
+///     rows[ device+1 ] the number with local tiles on device.
+///
+/// @param[out] cols
+///     As rows, for block columns.
+///
+template <typename scalar_t>
+void local_rows_cols(
+    slate::BaseMatrix<scalar_t>& A,
+    std::vector<int64_t>& rows, std::vector<int64_t>& cols )
+{
+    int num_devices = A.num_devices();
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    std::vector<char> has_row( (num_devices + 1)*mt, false );
+    std::vector<char> has_col( (num_devices + 1)*nt, false );
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j )) {
+                has_row[ i ] = has_col[ j ] = true;
+                int device = A.tileDevice( i, j );
+                if (0 <= device && device < num_devices) {
+                    has_row[ (device + 1)*mt + i ] = true;
+                    has_col[ (device + 1)*nt + j ] = true;
+                }
+            }
+        }
+    }
+    rows.assign( num_devices + 1, 0 );
+    cols.assign( num_devices + 1, 0 );
+    for (int d = 0; d <= num_devices; ++d) {
+        auto row_begin = has_row.begin() + d*mt;
+        auto col_begin = has_col.begin() + d*nt;
+        rows[ d ] = std::count( row_begin, row_begin + mt, true );
+        cols[ d ] = std::count( col_begin, col_begin + nt, true );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Helper function to allocate a krylov basis
 template<typename scalar_t>
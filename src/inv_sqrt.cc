@@ -0,0 +1,214 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel inverse square root,
+/// \[
+///     X = A^{-1/2},
+/// \]
+/// of an n-by-n Hermitian positive definite matrix A, e.g., the Löwdin
+/// orthogonalization $S^{-1/2}$ of an overlap matrix, without an
+/// eigendecomposition.
+///
+/// Both iterations start from $A / c$, with $c = \|A\|_F \ge \|A\|_2$,
+/// so its eigenvalues are in (0, 1], and converge quadratically once close.
+///
+/// The coupled Newton-Schulz iteration, with $Y_0 = A / c$, $Z_0 = I$,
+/// \[
+///     R_k = I - Z_k Y_k, \quad
+///     Y_{k+1} = Y_k (I + R_k / 2), \quad
+///     Z_{k+1} = (I + R_k / 2) Z_k,
+/// \]
+/// is 3 gemm's per iteration and nothing else, so it runs at gemm speed.
+/// Its residual $R_k$ is also the convergence measure, so checking
+/// convergence costs only a norm of a matrix already computed.
+/// The number of iterations grows with log( cond( A ) ).
+///
+/// The product form of the Denman-Beavers iteration, with $M_0 = A / c$,
+/// $Z_0 = I$,
+/// \[
+///     T_k = (I + M_k^{-1}) / 2, \quad
+///     Z_{k+1} = Z_k T_k, \quad
+///     M_{k+1} = (I + (M_k + M_k^{-1}) / 2) / 2,
+/// \]
+/// converges in fewer iterations for ill-conditioned A, but each one
+/// inverts $M_k$ with getrf and getri.
+/// It stops when $\|M_k - I\|_F$ is small.
+///
+/// Both stop at Option::Tolerance, or when the convergence measure stops
+/// decreasing below $\sqrt{\epsilon}$, at the rounding error level.
+/// Finally, $X = Z_k / \sqrt{c}$.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n Hermitian positive definite matrix $A$. Not modified.
+///
+/// @param[out] X
+///     The n-by-n matrix $X = A^{-1/2}$, distributed as A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target, as for gemm.
+///     - Option::MethodMatFunc:
+///       MethodMatFunc::NewtonSchulz (default, Auto) or
+///       MethodMatFunc::DenmanBeavers.
+///     - Option::Tolerance:
+///       Tolerance on the Frobenius norm of the convergence measure.
+///       Default n * epsilon.
+///     - Option::MaxIterations:
+///       Maximum number of iterations. Default 100.
+///
+/// @return number of iterations, >= 0, if it converged;
+///         -MaxIterations - 1 if it did not converge.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+int64_t inv_sqrt(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& X,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using std::sqrt;
+
+    trace::Block trace_block( "slate::inv_sqrt" );
+    Timer t_inv_sqrt;
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0, half = 0.5, quarter = 0.25;
+    const real_t r_one = 1.0;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+
+    int64_t n = A.n();
+    slate_assert( X.m() == n );
+    slate_assert( X.n() == n );
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 100 );
+    real_t tol = get_option<double>( opts, Option::Tolerance, n*eps );
+    Method method = get_option<Option::MethodMatFunc>(
+        opts, MethodMatFunc::Auto );
+
+    if (method == MethodMatFunc::Auto)
+        method = MethodMatFunc::select_algo( A, opts );
+    slate_assert( method == MethodMatFunc::NewtonSchulz
+                  || method == MethodMatFunc::DenmanBeavers );
+
+    real_t c = norm( Norm::Fro, A, opts );
+    slate_assert( c > 0 );
+
+    auto R = X.emptyLike();
+    R.insertLocalTiles( target );
+    auto W = X.emptyLike();
+    W.insertLocalTiles( target );
+
+    // Z = X; Z0 = I. Y0 = M0 = A / c, as a general matrix.
+    auto Y = X.emptyLike();
+    Y.insertLocalTiles( target );
+    set( zero, one, X, opts );
+    hemm( Side::Left, scalar_t( 1 / c ), A, X, zero, Y, opts );
+
+    int64_t iter = 0;
+    bool converged = false;
+    real_t rnorm_prev = 0;
+    for (; iter < itermax; ++iter) {
+        if (method == MethodMatFunc::NewtonSchulz) {
+            // R = I - Z Y.
+            set( zero, one, R, opts );
+            gemm( -one, X, Y, one, R, opts );
+        }
+        else {
+            // R = M - I, with M in Y.
+            set( zero, one, R, opts );
+            add( one, Y, -one, R, opts );
+        }
+
+        real_t rnorm = norm( Norm::Fro, R, opts );
+        converged = rnorm <= tol
+                    || (iter > 0 && rnorm > rnorm_prev / 2
+                        && rnorm_prev <= sqrt( eps ));
+        rnorm_prev = rnorm;
+        if (converged)
+            break;
+
+        if (method == MethodMatFunc::NewtonSchulz) {
+            // Y += Y R / 2, Z += R Z / 2.
+            gemm( half, Y, R, zero, W, opts );
+            add( one, W, one, Y, opts );
+            gemm( half, R, X, zero, W, opts );
+            add( one, W, one, X, opts );
+        }
+        else {
+            // W = M^{-1}.
+            Pivots pivots;
+            copy( Y, W, opts );
+            int64_t info = getrf( W, pivots, opts );
+            slate_assert( info == 0 );
+            getri( W, pivots, opts );
+
+            // R = T = (I + M^{-1}) / 2.
+            set( zero, half, R, opts );
+            add( half, W, one, R, opts );
+
+            // M = (M + M^{-1}) / 4 + I / 2.
+            add( quarter, W, quarter, Y, opts );
+            set( zero, half, W, opts );
+            add( one, W, one, Y, opts );
+
+            // Z = Z T, through W.
+            gemm( one, X, R, zero, W, opts );
+            copy( W, X, opts );
+        }
+    }
+
+    // X = Z / sqrt( c ).
+    scale( r_one, sqrt( c ), X, opts );
+
+    internal::timers_set( opts, "inv_sqrt", t_inv_sqrt.stop() );
+
+    return converged ? iter : -itermax - 1;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t inv_sqrt<float>(
+    HermitianMatrix<float>& A,
+    Matrix<float>& X,
+    Options const& opts);
+
+template
+int64_t inv_sqrt<double>(
+    HermitianMatrix<double>& A,
+    Matrix<double>& X,
+    Options const& opts);
+
+template
+int64_t inv_sqrt< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& X,
+    Options const& opts);
+
+template
+int64_t inv_sqrt< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& X,
+    Options const& opts);
+
+} // namespace slate
@@ -0,0 +1,197 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel matrix sign function,
+/// \[
+///     A = \operatorname{sign}( A ) = A (A^2)^{-1/2},
+/// \]
+/// of an n-by-n matrix A with no eigenvalues on the imaginary axis,
+/// e.g., for density matrix purification, without an eigendecomposition.
+///
+/// The Newton-Schulz iteration, with $X_0 = A / \|A\|_F$,
+/// \[
+///     R_k = I - X_k^2, \quad
+///     X_{k+1} = X_k (I + R_k / 2),
+/// \]
+/// is 2 gemm's per iteration and nothing else, so it runs at gemm speed.
+/// Its residual $R_k$ is also the convergence measure, so checking
+/// convergence costs only a norm of a matrix already computed.
+/// It converges if $\|I - X_0^2\|_2 < 1$, e.g., for Hermitian A, whose
+/// eigenvalues are then in [-1, 1] and nonzero; the number of iterations
+/// grows with log( cond( A ) ).
+///
+/// The scaled Newton iteration, with $X_0 = A$,
+/// \[
+///     X_{k+1} = (\mu_k X_k + \mu_k^{-1} X_k^{-1}) / 2, \quad
+///     \mu_k = \sqrt{ \|X_k^{-1}\|_F / \|X_k\|_F },
+/// \]
+/// converges for any A with no eigenvalues on the imaginary axis, but each
+/// iteration inverts $X_k$ with getrf and getri. Scaling is turned off
+/// once the iteration is close, to keep quadratic convergence.
+/// It stops when $\|X_{k+1} - X_k\|_F \le tol \|X_{k+1}\|_F$.
+///
+/// Both stop at Option::Tolerance, or when the convergence measure stops
+/// decreasing below $\sqrt{\epsilon}$, at the rounding error level.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the n-by-n matrix $A$.
+///     On exit, $\operatorname{sign}( A )$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target, as for gemm.
+///     - Option::MethodMatFunc:
+///       MethodMatFunc::NewtonSchulz (default, Auto) or
+///       MethodMatFunc::Newton.
+///     - Option::Tolerance:
+///       Tolerance on the convergence measure. Default n * epsilon.
+///     - Option::MaxIterations:
+///       Maximum number of iterations. Default 100.
+///
+/// @return number of iterations, >= 0, if it converged;
+///         -MaxIterations - 1 if it did not converge.
+///
+/// @ingroup heev
+///
+template <typename scalar_t>
+int64_t matrix_sign(
+    Matrix<scalar_t>& A,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using std::sqrt;
+
+    trace::Block trace_block( "slate::matrix_sign" );
+    Timer t_matrix_sign;
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0, half = 0.5;
+    const real_t r_one = 1.0;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+
+    int64_t n = A.n();
+    slate_assert( A.m() == n );
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 100 );
+    real_t tol = get_option<double>( opts, Option::Tolerance, n*eps );
+    Method method = get_option<Option::MethodMatFunc>(
+        opts, MethodMatFunc::Auto );
+
+    if (method == MethodMatFunc::Auto)
+        method = MethodMatFunc::select_algo( A, opts );
+    slate_assert( method == MethodMatFunc::NewtonSchulz
+                  || method == MethodMatFunc::Newton );
+
+    real_t c = norm( Norm::Fro, A, opts );
+    slate_assert( c > 0 );
+
+    auto R = A.emptyLike();
+    R.insertLocalTiles( target );
+    auto W = A.emptyLike();
+    W.insertLocalTiles( target );
+
+    if (method == MethodMatFunc::NewtonSchulz)
+        scale( r_one, c, A, opts );
+
+    int64_t iter = 0;
+    bool converged = false;
+    bool scaled = true;
+    real_t rnorm_prev = 0;
+    for (; iter < itermax; ++iter) {
+        real_t rnorm;
+        if (method == MethodMatFunc::NewtonSchulz) {
+            // R = I - X^2, with a copy of X, as gemm's A and B are
+            // broadcast separately.
+            copy( A, W, opts );
+            set( zero, one, R, opts );
+            gemm( -one, A, W, one, R, opts );
+            rnorm = norm( Norm::Fro, R, opts );
+        }
+        else {
+            // W = X^{-1}.
+            Pivots pivots;
+            copy( A, W, opts );
+            int64_t info = getrf( W, pivots, opts );
+            slate_assert( info == 0 );
+            getri( W, pivots, opts );
+
+            real_t mu = 1;
+            if (scaled) {
+                mu = sqrt( norm( Norm::Fro, W, opts ) / c );
+            }
+
+            // W = X_{k+1} = (mu X + X^{-1} / mu) / 2;
+            // A = X_k - X_{k+1}, whose relative norm is the measure.
+            add( scalar_t( mu / 2 ), A, scalar_t( 1 / (2*mu) ), W, opts );
+            add( -one, W, one, A, opts );
+            c = norm( Norm::Fro, W, opts );
+            rnorm = norm( Norm::Fro, A, opts ) / c;
+            copy( W, A, opts );
+            if (rnorm <= 1e-2)
+                scaled = false;
+        }
+
+        converged = rnorm <= tol
+                    || (iter > 0 && rnorm > rnorm_prev / 2
+                        && rnorm_prev <= sqrt( eps ));
+        rnorm_prev = rnorm;
+        if (converged) {
+            // Newton updated X before its convergence check.
+            if (method == MethodMatFunc::Newton)
+                ++iter;
+            break;
+        }
+
+        if (method == MethodMatFunc::NewtonSchulz) {
+            // X += X R / 2.
+            gemm( half, A, R, zero, W, opts );
+            add( one, W, one, A, opts );
+        }
+    }
+
+    internal::timers_set( opts, "matrix_sign", t_matrix_sign.stop() );
+
+    return converged ? iter : -itermax - 1;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t matrix_sign<float>(
+    Matrix<float>& A,
+    Options const& opts);
+
+template
+int64_t matrix_sign<double>(
+    Matrix<double>& A,
+    Options const& opts);
+
+template
+int64_t matrix_sign< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+int64_t matrix_sign< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    Options const& opts);
+
+} // namespace slate
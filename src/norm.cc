@@ -181,6 +181,150 @@ norm(
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Distributed parallel general matrix norms, several at once.
+/// Computes the local values, and starts their reduction; the returned
+/// request stores the norms in values when it completes.
+/// Generic implementation for any target.
+/// @ingroup norm_impl
+///
+template <Target target, typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+norms_start(
+    std::vector<Norm> in_norms, matrix_type A,
+    blas::real_type<typename matrix_type::value_type>* values,
+    Options const& opts )
+{
+    using scalar_t = typename matrix_type::value_type;
+    using real_t = blas::real_type<scalar_t>;
+    using Reduce = typename NormRequest<real_t>::Reduce;
+
+    // Undo any transpose, which switches one <=> inf norms.
+    if (A.op() == Op::ConjTrans || A.op() == Op::Trans) {
+        for (auto& in_norm : in_norms) {
+            if (in_norm == Norm::One)
+                in_norm = Norm::Inf;
+            else if (in_norm == Norm::Inf)
+                in_norm = Norm::One;
+        }
+    }
+    if (A.op() == Op::ConjTrans)
+        A = conj_transpose( A );
+    else if (A.op() == Op::Trans)
+        A = transpose(A);
+
+    bool do_max = false, do_one = false, do_inf = false, do_fro = false;
+    for (auto in_norm : in_norms) {
+        if (in_norm == Norm::Max)
+            do_max = true;
+        else if (in_norm == Norm::One)
+            do_one = true;
+        else if (in_norm == Norm::Inf)
+            do_inf = true;
+        else if (in_norm == Norm::Fro)
+            do_fro = true;
+        else
+            slate_error("invalid norm.");
+    }
+
+    // Each norm runs on its own queue, so they run concurrently.
+    if (target == Target::Devices) {
+        const int64_t batch_size_default = 0;
+        const int64_t num_queues = std::max( 1, do_max + do_one
+                                                + do_inf + do_fro );
+        A.allocateBatchArrays( batch_size_default, num_queues );
+        A.reserveDeviceWorkspace();
+    }
+
+    // Local values, packed for one reduction:
+    // [ max, column sums (one), row sums (inf), sum of squares (fro) ].
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t i_one = 1;
+    int64_t i_inf = i_one + (do_one ? n : 0);
+    int64_t i_fro = i_inf + (do_inf ? m : 0);
+    int64_t size  = i_fro + (do_fro ? 1 : 0);
+    std::vector<real_t> local_values( size, 0 );
+    real_t fro_values[2] = { 0, 1 };
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        int queue_index = 0;
+        if (do_max) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, local_values ) firstprivate( queue_index )
+            {
+                matrix_type A_ = A;
+                internal::norm<target>( Norm::Max, NormScope::Matrix,
+                                        std::move(A_), &local_values[ 0 ],
+                                        0, queue_index );
+            }
+            ++queue_index;
+        }
+        if (do_one) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, local_values ) firstprivate( queue_index, i_one )
+            {
+                matrix_type A_ = A;
+                internal::norm<target>( Norm::One, NormScope::Matrix,
+                                        std::move(A_), &local_values[ i_one ],
+                                        0, queue_index );
+            }
+            ++queue_index;
+        }
+        if (do_inf) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, local_values ) firstprivate( queue_index, i_inf )
+            {
+                matrix_type A_ = A;
+                internal::norm<target>( Norm::Inf, NormScope::Matrix,
+                                        std::move(A_), &local_values[ i_inf ],
+                                        0, queue_index );
+            }
+            ++queue_index;
+        }
+        if (do_fro) {
+            #pragma omp task slate_omp_default_none \
+                shared( A, fro_values ) firstprivate( queue_index )
+            {
+                matrix_type A_ = A;
+                internal::norm<target>( Norm::Fro, NormScope::Matrix,
+                                        std::move(A_), fro_values,
+                                        0, queue_index );
+            }
+            ++queue_index;
+        }
+    }
+    if (do_fro) {
+        // todo: propogate scale
+        local_values[ i_fro ] = fro_values[0] * fro_values[0] * fro_values[1];
+    }
+
+    A.releaseWorkspace();
+
+    // One reduction; with max, by an op that takes the max of the first
+    // entry and sums the others.
+    return NormRequest<real_t>(
+        std::move( local_values ),
+        do_max ? Reduce::MaxFirstSumRest : Reduce::Sum, A.mpiComm(),
+        [=]( real_t const* global_values ) {
+            for (size_t k = 0; k < in_norms.size(); ++k) {
+                if (in_norms[ k ] == Norm::Max)
+                    values[ k ] = global_values[ 0 ];
+                else if (in_norms[ k ] == Norm::One)
+                    values[ k ] = lapack::lange( Norm::Max, 1, n,
+                                                 &global_values[ i_one ], 1 );
+                else if (in_norms[ k ] == Norm::Inf)
+                    values[ k ] = lapack::lange( Norm::Max, 1, m,
+                                                 &global_values[ i_inf ], 1 );
+                else
+                    values[ k ] = sqrt( global_values[ i_fro ] );
+            }
+        } );
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -238,6 +382,89 @@ norm(
     return -1.0;  // unreachable; silence error
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel general matrix norms, computing several norms of
+/// the same matrix together: the internal norm routines run concurrently,
+/// and their results are combined in a single MPI reduction, instead of
+/// one pass and one reduction per norm() call.
+///
+//------------------------------------------------------------------------------
+/// @tparam matrix_type
+///     Any SLATE matrix type: Matrix, SymmetricMatrix, HermitianMatrix,
+///     TriangularMatrix, etc.
+//------------------------------------------------------------------------------
+/// @param[in] in_norms
+///     Norms to compute, each Norm::Max, One, Inf, or Fro, as in norm().
+///
+/// @param[in] A
+///     The matrix A.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @return norms of A, in the order of in_norms.
+///
+/// @ingroup norm
+///
+template <typename matrix_type>
+std::vector< blas::real_type<typename matrix_type::value_type> >
+norms(
+    std::vector<Norm> const& in_norms, matrix_type& A,
+    Options const& opts )
+{
+    std::vector< blas::real_type<typename matrix_type::value_type> >
+        values( in_norms.size() );
+    norms_start( in_norms, A, values.data(), opts ).wait();
+    return values;
+}
+
+//------------------------------------------------------------------------------
+/// Split-phase version of norms(): computes the local norms, and starts
+/// their reduction across MPI ranks without waiting for it, so the caller
+/// can overlap it with other work, e.g., the next residual update.
+///
+/// Arguments are as in norms(), plus:
+///
+/// @param[out] values
+///     Array of length in_norms.size(). When the returned request
+///     completes, the norms of A, in the order of in_norms.
+///
+/// @return request whose wait() completes the reduction and stores values.
+///
+/// @ingroup norm
+///
+template <typename matrix_type>
+NormRequest< blas::real_type<typename matrix_type::value_type> >
+norms_start(
+    std::vector<Norm> const& in_norms, matrix_type& A,
+    blas::real_type<typename matrix_type::value_type>* values,
+    Options const& opts )
+{
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+            return impl::norms_start<Target::HostTask>(
+                in_norms, A, values, opts );
+
+        case Target::HostBatch:
+        case Target::HostNest:
+            return impl::norms_start<Target::HostNest>(
+                in_norms, A, values, opts );
+
+        case Target::Devices:
+            return impl::norms_start<Target::Devices>(
+                in_norms, A, values, opts );
+    }
+    return {};  // unreachable; silence error
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -365,4 +592,283 @@ double norm(
     Norm in_norm, HermitianBandMatrix< std::complex<double> >& A,
     Options const& opts);
 
+
+//------------------------------------------------------------------------------
+// Explicit instantiations of norms.
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, Matrix<float>& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, Matrix<double>& A,
+    Options const& opts);
+
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, Matrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, Matrix< std::complex<double> >& A,
+    Options const& opts);
+
+//--------------------
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, HermitianMatrix<float>& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, HermitianMatrix<double>& A,
+    Options const& opts);
+
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, HermitianMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, HermitianMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+//--------------------
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, SymmetricMatrix<float>& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, SymmetricMatrix<double>& A,
+    Options const& opts);
+
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, SymmetricMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, SymmetricMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+//--------------------
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix<float>& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix<double>& A,
+    Options const& opts);
+
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+//--------------------
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, BandMatrix<float>& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, BandMatrix<double>& A,
+    Options const& opts);
+
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, BandMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, BandMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+//--------------------
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix<float>& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix<double>& A,
+    Options const& opts);
+
+template
+std::vector<float> norms(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix< std::complex<float> >& A,
+    Options const& opts);
+
+template
+std::vector<double> norms(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+//------------------------------------------------------------------------------
+// Explicit instantiations of norms_start.
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, Matrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, Matrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, Matrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, Matrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+//--------------------
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, HermitianMatrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, HermitianMatrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, HermitianMatrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, HermitianMatrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+//--------------------
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, SymmetricMatrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, SymmetricMatrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, SymmetricMatrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, SymmetricMatrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+//--------------------
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, TrapezoidMatrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+//--------------------
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, BandMatrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, BandMatrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, BandMatrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, BandMatrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
+//--------------------
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix<float>& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix<double>& A,
+    double* values,
+    Options const& opts);
+
+template
+NormRequest<float> norms_start(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix< std::complex<float> >& A,
+    float* values,
+    Options const& opts);
+
+template
+NormRequest<double> norms_start(
+    std::vector<Norm> const& in_norms, HermitianBandMatrix< std::complex<double> >& A,
+    double* values,
+    Options const& opts);
+
 } // namespace slate
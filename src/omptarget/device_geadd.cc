@@ -60,12 +60,11 @@ void geadd(
     queue.sync(); // sync queue before switching to openmp device execution
     // Use omp target offload
     #pragma omp target is_device_ptr(A, B) device(queue.device())
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[i];
-        scalar_t* rowB = &B[i];
-        for (int64_t j = 0; j < n; ++j) {
-            rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
+    // Threads take consecutive rows i, so accesses are coalesced.
+    #pragma omp teams distribute parallel for collapse(2)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            B[i + j*ldb] = alpha * A[i + j*lda] + beta * B[i + j*ldb];
         }
     }
 #else
@@ -167,13 +166,11 @@ void geadd(
     for (int64_t k = 0; k < batch_count; ++k) {
         scalar_t* tileA = Aarray[k];
         scalar_t* tileB = Barray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[i];
-            scalar_t* rowB = &tileB[i];
-            for (int64_t j = 0; j < n; ++j) {
-                rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
+        // distribute entries (i, j) to threads, consecutive rows i together
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                tileB[i + j*ldb] = alpha * tileA[i + j*lda] + beta * tileB[i + j*ldb];
             }
         }
     }
@@ -213,5 +210,82 @@ void geadd(
     int64_t batch_count, blas::Queue &queue);
 
 } // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile addition.
+/// Sets
+/// \[
+///     Barray[k] = \alpha Aarray[k] + \beta Barray[k],
+/// \]
+/// where tile k is m[k]-by-n[k] with leading dimensions lda[k] and ldb[k].
+/// The m, n, lda, ldb arrays are of dimension batch_count in GPU memory.
+/// max_m is the maximum of m[k].
+///
+template <typename scalar_t>
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t const* lda,
+    scalar_t const& beta,  scalar_t** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(m, n, Aarray, lda, Barray, ldb) \
+        device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t k = 0; k < batch_count; ++k) {
+        scalar_t* tileA = Aarray[k];
+        scalar_t* tileB = Barray[k];
+        int64_t mk = m[k], nk = n[k], ldak = lda[k], ldbk = ldb[k];
+        // distribute rows (i) to threads
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t i = 0; i < mk; ++i) {
+            scalar_t* rowA = &tileA[i];
+            scalar_t* rowB = &tileB[i];
+            for (int64_t j = 0; j < nk; ++j) {
+                rowB[j*ldbk] = alpha * rowA[j*ldak] + beta * rowB[j*ldbk];
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    float const& alpha, float** Aarray, int64_t const* lda,
+    float const& beta,  float** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    double const& alpha, double** Aarray, int64_t const* lda,
+    double const& beta,  double** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> const& alpha, std::complex<float>** Aarray, int64_t const* lda,
+    std::complex<float> const& beta,  std::complex<float>** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> const& alpha, std::complex<double>** Aarray, int64_t const* lda,
+    std::complex<double> const& beta,  std::complex<double>** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
 } // namespace device
 } // namespace slate
@@ -65,15 +65,13 @@ void gecopy(
     for (int64_t k = 0; k < batch_count; ++k) {
         src_scalar_t const* tileA = Aarray[k];
         dst_scalar_t* tileB = Barray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            src_scalar_t const* rowA = &tileA[i];
-            dst_scalar_t* rowB = &tileB[i];
-            for (int64_t j = 0; j < n; ++j) {
+        // distribute entries (i, j) to threads, consecutive rows i together
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
                 // todo: confirm type conversion float-complex -> double-complex
                 // todo: confirm type conversion double-complex -> float-complex
-                rowB[j*ldb] = rowA[j*lda];
+                tileB[i + j*ldb] = tileA[i + j*lda];
             }
         }
     }
@@ -0,0 +1,259 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <algorithm>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Copy or add with precision conversion, fused with the max norm of each
+/// column; see gecopy_col_max() and geadd_col_max().
+///
+template <bool add, typename src_scalar_t, typename dst_scalar_t,
+          typename real_t>
+void gecopy_col_max_omp(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    real_t* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    #pragma omp target is_device_ptr(Aarray, Barray, col_max) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t k = 0; k < batch_count; ++k) {
+        src_scalar_t const* tileA = Aarray[k];
+        dst_scalar_t* tileB = Barray[k];
+        // distribute columns (j) to threads
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t j = 0; j < n; ++j) {
+            src_scalar_t const* colA = &tileA[j*lda];
+            dst_scalar_t* colB = &tileB[j*ldb];
+            real_t max = 0;
+            for (int64_t i = 0; i < m; ++i) {
+                real_t absx;
+                if (add) {
+                    colB[i] += dst_scalar_t( colA[i] );
+                    absx = std::abs( colB[i] );
+                }
+                else {
+                    colB[i] = colA[i];
+                    absx = std::abs( colA[i] );
+                }
+                // propagate NaN
+                if (absx > max || std::isnan( absx ))
+                    max = absx;
+            }
+            col_max[ k*ldv + j ] = max;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise copy and precision conversion,
+/// copying A to B, fused with the max norm of each column of A. Sets
+/// \[
+///     Barray[k] = Aarray[k],
+///     col_max[ k*ldv + j ] = max_i abs( Aarray[k]_(i, j) ).
+/// \]
+/// Used to down-convert the residual in mixed-precision iterative
+/// refinement while computing its column norms, in one pass.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m-by-n matrix stored in an ldb-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[out] col_max
+///     Array in GPU memory of dimension batch_count * ldv, in the higher
+///     precision of A and B.
+///
+/// @param[in] ldv
+///     Leading dimension of col_max. ldv >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* col_max,
+    int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_omp<false>(
+        m, n, Aarray, lda, Barray, ldb, col_max, ldv, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise add and precision conversion,
+/// adding A to B, fused with the max norm of each column of the result. Sets
+/// \[
+///     Barray[k] = Aarray[k] + Barray[k],
+///     col_max[ k*ldv + j ] = max_i abs( Barray[k]_(i, j) ).
+/// \]
+/// Used to up-convert the correction and update the solution in
+/// mixed-precision iterative refinement while computing its column norms,
+/// in one pass.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in,out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m-by-n matrix stored in an ldb-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[out] col_max
+///     Array in GPU memory of dimension batch_count * ldv, in the higher
+///     precision of A and B.
+///
+/// @param[in] ldv
+///     Leading dimension of col_max. ldv >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename src_scalar_t, typename dst_scalar_t>
+void geadd_col_max(
+    int64_t m, int64_t n,
+    src_scalar_t const* const* Aarray, int64_t lda,
+    dst_scalar_t** Barray, int64_t ldb,
+    blas::real_type< blas::scalar_type< src_scalar_t, dst_scalar_t > >* col_max,
+    int64_t ldv,
+    int64_t batch_count, blas::Queue &queue)
+{
+    gecopy_col_max_omp<true>(
+        m, n, Aarray, lda, Barray, ldb, col_max, ldv, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations, for the precision conversions of
+// mixed-precision solvers.
+
+// double => float
+template
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    double const* const* Aarray, int64_t lda,
+    float** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// float => double
+template
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    float const* const* Aarray, int64_t lda,
+    double** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// complex-double => complex-float
+template
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    std::complex<float>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// complex-float => complex-double
+template
+void gecopy_col_max(
+    int64_t m, int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    std::complex<double>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// double => float
+template
+void geadd_col_max(
+    int64_t m, int64_t n,
+    double const* const* Aarray, int64_t lda,
+    float** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// float => double
+template
+void geadd_col_max(
+    int64_t m, int64_t n,
+    float const* const* Aarray, int64_t lda,
+    double** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// complex-double => complex-float
+template
+void geadd_col_max(
+    int64_t m, int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    std::complex<float>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+// complex-float => complex-double
+template
+void geadd_col_max(
+    int64_t m, int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    std::complex<double>** Barray, int64_t ldb,
+    double* col_max, int64_t ldv,
+    int64_t batch_count, blas::Queue &queue);
+
+} // namespace device
+} // namespace slate
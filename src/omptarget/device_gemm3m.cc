@@ -0,0 +1,207 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Splits a complex tile into the real parts used by 3M gemm,
+/// \[
+///     A_r = \Re A, \quad
+///     A_i = \Im A, \quad
+///     A_s = A_r + A_i,
+/// \]
+/// where A is conjugated first if conj_A is true.
+/// Defined only for complex types.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] conj_A
+///     Whether to split conj( A ) instead of A.
+///
+/// @param[in] A
+///     The m-by-n complex tile, stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[out] Ar
+///     The m-by-n real part, stored in an ldr-by-n array in GPU memory.
+///
+/// @param[out] Ai
+///     The m-by-n imaginary part, stored in an ldr-by-n array in GPU memory.
+///
+/// @param[out] As
+///     The m-by-n sum Ar + Ai, stored in an ldr-by-n array in GPU memory.
+///
+/// @param[in] ldr
+///     Leading dimension of Ar, Ai, As. ldr >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void gemm3m_split(
+    int64_t m, int64_t n, bool conj_A,
+    scalar_t const* A, int64_t lda,
+    blas::real_type<scalar_t>* Ar,
+    blas::real_type<scalar_t>* Ai,
+    blas::real_type<scalar_t>* As, int64_t ldr,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(A, Ar, Ai, As) device(queue.device())
+    // Threads take consecutive rows i, so accesses are coalesced.
+    #pragma omp teams distribute parallel for collapse(2)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            scalar_t a = A[ i + j*lda ];
+            real_t a_i = conj_A ? -imag( a ) : imag( a );
+            Ar[ i + j*ldr ] = real( a );
+            Ai[ i + j*ldr ] = a_i;
+            As[ i + j*ldr ] = real( a ) + a_i;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Combines the real products of 3M gemm,
+/// $T_1 = A_r B_r$, $T_2 = A_i B_i$, $T_3 = A_s B_s$, into
+/// \[
+///     C = \alpha ((T_1 - T_2) + i (T_3 - T_1 - T_2)) + \beta C.
+/// \]
+/// If beta = 0, C need not be set on input.
+/// Defined only for complex types.
+///
+/// @param[in] m
+///     Number of rows of C. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of C. n >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] T1
+///     The m-by-n real product Ar Br, stored in an ldt-by-n array
+///     in GPU memory.
+///
+/// @param[in] T2
+///     The m-by-n real product Ai Bi, stored in an ldt-by-n array
+///     in GPU memory.
+///
+/// @param[in] T3
+///     The m-by-n real product As Bs, stored in an ldt-by-n array
+///     in GPU memory.
+///
+/// @param[in] ldt
+///     Leading dimension of T1, T2, T3. ldt >= m.
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] C
+///     The m-by-n complex tile, stored in an ldc-by-n array in GPU memory.
+///
+/// @param[in] ldc
+///     Leading dimension of C. ldc >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void gemm3m_combine(
+    int64_t m, int64_t n,
+    scalar_t const& alpha,
+    blas::real_type<scalar_t> const* T1,
+    blas::real_type<scalar_t> const* T2,
+    blas::real_type<scalar_t> const* T3, int64_t ldt,
+    scalar_t const& beta, scalar_t* C, int64_t ldc,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    bool overwrite = beta == scalar_t( 0 );
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(T1, T2, T3, C) device(queue.device())
+    // Threads take consecutive rows i, so accesses are coalesced.
+    #pragma omp teams distribute parallel for collapse(2)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            real_t t1 = T1[ i + j*ldt ];
+            real_t t2 = T2[ i + j*ldt ];
+            scalar_t t( t1 - t2, T3[ i + j*ldt ] - t1 - t2 );
+            scalar_t c = alpha * t;
+            if (! overwrite)
+                c += beta * C[ i + j*ldc ];
+            C[ i + j*ldc ] = c;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gemm3m_split(
+    int64_t m, int64_t n, bool conj_A,
+    std::complex<float> const* A, int64_t lda,
+    float* Ar, float* Ai, float* As, int64_t ldr,
+    blas::Queue& queue);
+
+template
+void gemm3m_split(
+    int64_t m, int64_t n, bool conj_A,
+    std::complex<double> const* A, int64_t lda,
+    double* Ar, double* Ai, double* As, int64_t ldr,
+    blas::Queue& queue);
+
+template
+void gemm3m_combine(
+    int64_t m, int64_t n,
+    std::complex<float> const& alpha,
+    float const* T1, float const* T2, float const* T3, int64_t ldt,
+    std::complex<float> const& beta, std::complex<float>* C, int64_t ldc,
+    blas::Queue& queue);
+
+template
+void gemm3m_combine(
+    int64_t m, int64_t n,
+    std::complex<double> const& alpha,
+    double const* T1, double const* T2, double const* T3, int64_t ldt,
+    std::complex<double> const& beta, std::complex<double>* C, int64_t ldc,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
@@ -94,7 +94,6 @@ void genorm(
             }
             else {
                 assert(ldv == 1);
-                blas::device_memset(values, 0, batch_count, queue);
                 queue.sync(); // sync queue before switching to openmp device execution
                 // Use omp target offload
                 // note: the max_nan_reduction preserves nans
@@ -102,15 +101,15 @@ void genorm(
                 #pragma omp teams distribute
                 for (int64_t k = 0; k < batch_count; ++k) {
                     const scalar_t* tileA = Aarray[k];
-                    #pragma omp parallel for reduction(max_nan_reduction:values[k]) schedule(static, 1)
-                    for (int64_t i = 0; i < m; ++i) {
-                        const scalar_t* rowA = &tileA[i];
-                        real_t max = 0;
-                        for (int64_t j = 0; j < n; ++j) {
-                            max = max_nan(max, abs_val(rowA[j*lda]));
+                    real_t max = 0;
+                    // distribute entries (i, j) to threads, consecutive rows i together
+                    #pragma omp parallel for collapse(2) reduction(max_nan_reduction:max)
+                    for (int64_t j = 0; j < n; ++j) {
+                        for (int64_t i = 0; i < m; ++i) {
+                            max = max_nan(max, abs_val(tileA[i + j*lda]));
                         }
-                        values[k] = max_nan(values[k], max);
                     }
+                    values[k] = max;
                 }
             }
         }
@@ -127,13 +126,15 @@ void genorm(
                 #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
                 #pragma omp teams distribute
                 for (int64_t k = 0; k < batch_count; ++k) {
+                    const scalar_t* tileA = Aarray[k];
                     // distribute cols to threads (j)
-                    #pragma omp parallel for schedule(static, 1)
+                    #pragma omp parallel for
                     for (int64_t j = 0; j < n; ++j) {
-                        values[k*ldv + j] = 0;
+                        real_t sum = 0;
                         for (int64_t i = 0; i < m; ++i) {
-                            values[k*ldv + j] += abs_val( Aarray[k][i + j*lda] );
+                            sum += abs_val( tileA[i + j*lda] );
                         }
+                        values[k*ldv + j] = sum;
                     }
                 }
             }
@@ -151,13 +152,15 @@ void genorm(
                 #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
                 #pragma omp teams distribute
                 for (int64_t k = 0; k < batch_count; ++k) {
-                    // distribute rows to threads (i)
-                    #pragma omp parallel for schedule(static, 1)
+                    const scalar_t* tileA = Aarray[k];
+                    // distribute rows to threads (i), so reads are coalesced
+                    #pragma omp parallel for
                     for (int64_t i = 0; i < m; ++i) {
-                        values[k*ldv + i] = 0;
+                        real_t sum = 0;
                         for (int64_t j = 0; j < n; ++j) {
-                            values[k*ldv + i] += abs_val( Aarray[k][i + j*lda] );
+                            sum += abs_val( tileA[i + j*lda] );
                         }
+                        values[k*ldv + i] = sum;
                     }
                 }
             }
@@ -176,33 +179,16 @@ void genorm(
                 #pragma omp teams distribute
                 for (int64_t k = 0; k < batch_count; ++k) {
                     const scalar_t* tileA = Aarray[k];
-                    values[k*2 + 0] = 0; // scale_k
-                    values[k*2 + 1] = 1; // sumsq_k
-                    // distribute rows to threads (i)
-                    #pragma omp parallel for schedule(static, 1)
-                    for (int64_t i = 0; i < m; ++i) {
-                        real_t scale_ki = 0;
-                        real_t sumsq_ki = 1;
-                        for (int64_t j = 0; j < n; ++j)
-                            add_sumsq(scale_ki, sumsq_ki, abs_val( tileA[i + j*lda] ));
-                        // accumulate the scale and sumsq for each k
-                        // todo: critical section is slow, is there a better way?
-                        #pragma omp critical
-                        {
-                            real_t scale_k = values[k*2 + 0];
-                            real_t sumsq_k = values[k*2 + 1];
-                            if (scale_k > scale_ki) {
-                                sumsq_k = sumsq_k + sumsq_ki*(scale_ki / scale_k)*(scale_ki / scale_k);
-                                // scale_k stays same
-                            }
-                            else if (scale_ki != 0) {
-                                sumsq_k = sumsq_k*(scale_k / scale_ki)*(scale_k / scale_ki) + sumsq_ki;
-                                scale_k = scale_ki;
-                            }
-                            values[k*2 + 0] = scale_k;
-                            values[k*2 + 1] = sumsq_k;
+                    sumsq_t<real_t> ssq = { 0, 1 };
+                    // distribute entries (i, j) to threads, consecutive rows i together
+                    #pragma omp parallel for collapse(2) reduction(sumsq_reduction:ssq)
+                    for (int64_t j = 0; j < n; ++j) {
+                        for (int64_t i = 0; i < m; ++i) {
+                            add_sumsq(ssq.scale, ssq.sumsq, abs_val( tileA[i + j*lda] ));
                         }
                     }
+                    values[k*2 + 0] = ssq.scale;
+                    values[k*2 + 1] = ssq.sumsq;
                 }
             }
         }
@@ -215,9 +201,7 @@ void genorm(
                 blas::device_memset(values, 0, batch_count * n, queue);
             }
             else {
-                // todo:  NOTE THIS NORM IS NOT CHECKED YET
                 assert(ldv >= n);
-                blas::device_memset(values, 0, batch_count * n, queue);
                 queue.sync(); // sync queue before switching to openmp device execution
                 // Use omp target offload
                 #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
@@ -225,12 +209,14 @@ void genorm(
                 for (int64_t k = 0; k < batch_count; ++k) {
                     const scalar_t* tileA = Aarray[k];
                     // distribute cols to threads (j)
-                    #pragma omp parallel for collapse(1) schedule(static, 1)
+                    #pragma omp parallel for
                     for (int64_t j = 0; j < n; ++j) {
                         const scalar_t* colA = &tileA[j*lda];
+                        real_t max = 0;
                         for (int64_t i = 0; i < m; ++i) {
-                            values[j*ldv] = max_nan(values[j*ldv], abs_val(colA[i]));
+                            max = max_nan(max, abs_val(colA[i]));
                         }
+                        values[k*ldv + j] = max;
                     }
                 }
             }
@@ -0,0 +1,230 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+
+namespace slate {
+namespace device {
+
+#ifdef SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Philox-2x64 generator, as slate::random::philox_2x64 in matgen.
+/// Overwrites the counter (L, R) with 128 pseudorandom bits.
+///
+#pragma omp declare target
+inline void genrand_philox(
+    uint64_t& L, uint64_t& R, uint64_t seed)
+{
+    const uint64_t seed_inc = 0xD2B74407B1CE6E93ull;
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    const int rounds = 10;
+    const uint64_t mask_32 = (uint64_t( 1 ) << 32) - 1;
+
+    for (int i = 0; i < rounds; ++i) {
+        if (i != 0)
+            seed += seed_inc;
+
+        // 128-bit product R * multiplier
+        uint64_t hi1 = R >> 32;
+        uint64_t lo1 = R & mask_32;
+        uint64_t hi2 = multiplier >> 32;
+        uint64_t lo2 = multiplier & mask_32;
+        uint64_t lolo = lo1*lo2;
+        uint64_t mid  = hi1*lo2 + (lolo >> 32);
+        uint64_t mid2 = lo1*hi2 + (mid & mask_32);
+        uint64_t hi = hi1*hi2 + (mid >> 32) + (mid2 >> 32);
+        uint64_t lo = R * multiplier;
+
+        R = hi ^ seed ^ L;
+        L = lo;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// @return real number in [0, 1) from the high bits of bits,
+/// as slate::random::rand_to_real in matgen.
+///
+template <typename real_t>
+inline real_t genrand_to_real(uint64_t bits)
+{
+    const int digits = (sizeof(real_t) == 4 ? 24 : 53);
+    return real_t( bits >> (64 - digits) ) / real_t( uint64_t( 1 ) << digits );
+}
+#pragma omp end declare target
+
+#endif // SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Generates an m-by-n sub-matrix with random entries directly in GPU
+/// memory, with the same values as slate::random::generate in matgen.
+/// Values from distributions using sqrt, log, cos, or sin may differ in
+/// the last bits, depending on the device's math library.
+///
+/// @param[in] dist
+///     The distribution, as a slate::random::Dist value.
+///
+/// @param[in] seed
+///     The value to seed the random number generator.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] ioffset
+///     The first row of the sub-matrix in the global matrix.
+///
+/// @param[in] joffset
+///     The first column of the sub-matrix in the global matrix.
+///
+/// @param[in] diag_add
+///     Value added to the diagonal of A, e.g., to make it diagonally dominant.
+///
+/// @param[in] scale
+///     Value A is scaled by, after adding diag_add.
+///
+/// @param[out] A
+///     An m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void genrand(
+    int dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    blas::real_type<scalar_t> diag_add, blas::real_type<scalar_t> scale,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+    const bool is_complex = blas::is_complex<scalar_t>::value;
+    const real_t pi = 3.1415926535897932385;
+
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    // A is accessed as real_t, with the imaginary parts interleaved if complex.
+    real_t* Ar = (real_t*) A;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(Ar) device(queue.device())
+    #pragma omp teams distribute parallel for collapse(2) schedule(static, 1)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            uint64_t L = i + ioffset;
+            uint64_t R = j + joffset;
+            genrand_philox( L, R, uint64_t( seed ) );
+            real_t raw1 = genrand_to_real<real_t>( L );
+            real_t raw2 = genrand_to_real<real_t>( R );
+
+            // Same cases and formulas as slate::random::Dist.
+            real_t re = 0, im = 0;
+            switch (dist) {
+                case 1:  // Uniform
+                    re = raw1;
+                    im = raw2;
+                    break;
+                case 2:  // UniformSigned
+                    re = 2*raw1 - 1;
+                    im = 2*raw2 - 1;
+                    break;
+                case 3: {  // Normal
+                    real_t mag = sqrt( -2*log( 1 - raw1 ) );
+                    real_t arg = 2 * pi * raw2;
+                    re = mag * cos( arg );
+                    im = mag * sin( arg );
+                    break;
+                }
+                case 4: {  // UnitDisk
+                    real_t mag = sqrt( raw1 );
+                    real_t arg = 2 * pi * raw2;
+                    re = mag * cos( arg );
+                    im = mag * sin( arg );
+                    break;
+                }
+                case 5: {  // UnitCircle
+                    real_t arg = 2 * pi * raw2;
+                    re = cos( arg );
+                    im = sin( arg );
+                    break;
+                }
+                case 6:  // Binary
+                    re = raw1 >= 0.5 ? 1.0 : 0.0;
+                    im = raw2 >= 0.5 ? 1.0 : 0.0;
+                    break;
+                case 7:  // BinarySigned
+                    re = raw1 >= 0.5 ? 1.0 : -1.0;
+                    im = raw2 >= 0.5 ? 1.0 : -1.0;
+                    break;
+                default:
+                    break;
+            }
+            if (i == j)
+                re += diag_add;
+
+            if (is_complex) {
+                Ar[ 2*(i + j*lda)     ] = re * scale;
+                Ar[ 2*(i + j*lda) + 1 ] = im * scale;
+            }
+            else {
+                Ar[ i + j*lda ] = re * scale;
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void genrand(
+    int dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    float diag_add, float scale,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void genrand(
+    int dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    double diag_add, double scale,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void genrand(
+    int dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    float diag_add, float scale,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void genrand(
+    int dist, int64_t seed,
+    int64_t m, int64_t n, int64_t ioffset, int64_t joffset,
+    double diag_add, double scale,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
@@ -57,11 +57,11 @@ void gescale(
     queue.sync(); // sync queue before switching to openmp device execution
     // Use omp target offload
     #pragma omp target is_device_ptr(A) device(queue.device())
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[ i ];
-        for (int64_t j = 0; j < n; ++j)
-            rowA[ j*lda ] = rowA[ j*lda ] * mul;
+    // Threads take consecutive rows i, so accesses are coalesced.
+    #pragma omp teams distribute parallel for collapse(2)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i)
+            A[ i + j*lda ] = A[ i + j*lda ] * mul;
     }
 #else
     throw slate::Exception( "device routines not available" );
@@ -171,12 +171,11 @@ void gescale(
     #pragma omp teams distribute
     for (int64_t k = 0; k < batch_count; ++k) {
         scalar_t* A = Aarray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &A[ i ];
-            for (int64_t j = 0; j < n; ++j)
-                rowA[ j*lda ] = rowA[ j*lda ] * mul;
+        // distribute entries (i, j) to threads, consecutive rows i together
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i)
+                A[ i + j*lda ] = A[ i + j*lda ] * mul;
         }
     }
 #else
@@ -229,5 +228,91 @@ void gescale(
     int64_t batch_count, blas::Queue& queue);
 
 } // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile scale,
+/// Aarray[k] = (numer / denom) Aarray[k],
+/// where tile k is m[k]-by-n[k] with leading dimension lda[k].
+/// The m, n, lda arrays are of dimension batch_count in GPU memory.
+/// max_m is the maximum of m[k].
+///
+template <typename scalar_t, typename scalar_t2>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t2 numer, scalar_t2 denom,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    scalar_t2 mul = numer / denom;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(m, n, Aarray, lda) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t k = 0; k < batch_count; ++k) {
+        scalar_t* A = Aarray[k];
+        int64_t mk = m[k], nk = n[k], ldak = lda[k];
+        // distribute rows (i) to threads
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t i = 0; i < mk; ++i) {
+            scalar_t* rowA = &A[ i ];
+            for (int64_t j = 0; j < nk; ++j)
+                rowA[ j*ldak ] = rowA[ j*ldak ] * mul;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    float numer, float denom,
+    float** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    double numer, double denom,
+    double** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    float numer, float denom,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> numer, std::complex<float> denom,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    double numer, double denom,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> numer, std::complex<double> denom,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
 } // namespace device
 } // namespace slate
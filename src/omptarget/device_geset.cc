@@ -51,11 +51,11 @@ void geset(
     queue.sync(); // sync queue before switching to openmp device execution
     // Use omp target offload
     #pragma omp target is_device_ptr(A) device(queue.device())
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[i];
-        for (int64_t j = 0; j < n; ++j) {
-            rowA[j*lda] = (j != i) ? offdiag_value : diag_value;
+    // Threads take consecutive rows i, so accesses are coalesced.
+    #pragma omp teams distribute parallel for collapse(2)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            A[i + j*lda] = (j != i) ? offdiag_value : diag_value;
         }
     }
 #else
@@ -146,12 +146,11 @@ void geset(
     #pragma omp teams distribute
     for (int64_t k = 0; k < batch_count; ++k) {
         scalar_t* tileA = Aarray[k];
-        // distribute i to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[i];
-            for (int64_t j = 0; j < n; ++j) {
-                rowA[j*lda] = (j == i ? diag_value : offdiag_value);
+        // distribute entries (i, j) to threads, consecutive rows i together
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                tileA[i + j*lda] = (j == i ? diag_value : offdiag_value);
             }
         }
     }
@@ -191,5 +190,86 @@ void geset(
     int64_t batch_count, blas::Queue &queue);
 
 } // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile set.
+/// Tile k is m[k]-by-n[k] with leading dimension lda[k]. Tiles with
+/// is_diagonal[k] != 0 get diag_value on the diagonal; all other entries
+/// get offdiag_value.
+/// The m, n, lda, is_diagonal arrays are of dimension batch_count in
+/// GPU memory. max_m is the maximum of m[k].
+///
+template <typename scalar_t>
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    #pragma omp target is_device_ptr(m, n, Aarray, lda, is_diagonal) \
+        device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t k = 0; k < batch_count; ++k) {
+        scalar_t* tileA = Aarray[k];
+        int64_t mk = m[k], nk = n[k], ldak = lda[k];
+        scalar_t diag_k = is_diagonal[k] ? diag_value : offdiag_value;
+        // distribute i to threads
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t i = 0; i < mk; ++i) {
+            scalar_t* rowA = &tileA[i];
+            for (int64_t j = 0; j < nk; ++j) {
+                rowA[j*ldak] = (j == i ? diag_k : offdiag_value);
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    float const& offdiag_value, float const& diag_value,
+    float** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    double const& offdiag_value, double const& diag_value,
+    double** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> const& offdiag_value,
+    std::complex<float> const& diag_value,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> const& offdiag_value,
+    std::complex<double> const& diag_value,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
 } // namespace device
 } // namespace slate
@@ -0,0 +1,125 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// LU factorization of one tile without pivoting, A = L U, in a single
+/// kernel launch, so the diagonal tile of getrf_nopiv stays on the device.
+/// L is unit lower triangular (trapezoidal if m > n), U is upper
+/// triangular (trapezoidal if m < n).
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array in GPU memory.
+///     On exit, the factors L and U; the unit diagonal of L is not stored.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[out] info
+///     In GPU memory. On exit, 0 if successful, or i > 0 if U(i, i) is
+///     exactly zero (1-based index); the factorization is completed, but
+///     will have Inf or NaN due to division by zero.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    int64_t kmax = std::min( m, n );
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; one team does the whole tile, with the
+    // barriers of the worksharing loops between steps.
+    #pragma omp target is_device_ptr(A, info) device(queue.device())
+    {
+        int64_t iinfo = 0;
+        #pragma omp parallel
+        {
+            for (int64_t j = 0; j < kmax; ++j) {
+                scalar_t ajj = A[ j + j*lda ];
+                #pragma omp single
+                {
+                    // As in LAPACK, continue; the factors will have Inf or NaN.
+                    if (ajj == scalar_t( 0 ) && iinfo == 0)
+                        iinfo = j + 1;
+                }
+
+                // L(j+1:m, j) = A(j+1:m, j) / U(j, j)
+                #pragma omp for
+                for (int64_t i = j + 1; i < m; ++i)
+                    A[ i + j*lda ] /= ajj;
+
+                // A(j+1:m, j+1:n) -= L(j+1:m, j) U(j, j+1:n)
+                #pragma omp for
+                for (int64_t l = j + 1; l < n; ++l) {
+                    scalar_t ujl = A[ j + l*lda ];
+                    for (int64_t i = j + 1; i < m; ++i)
+                        A[ i + l*lda ] -= A[ i + j*lda ] * ujl;
+                }
+            }
+        }
+        *info = iinfo;
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void getrf_nopiv(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
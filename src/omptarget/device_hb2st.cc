@@ -0,0 +1,217 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+#include "slate/internal/openmp.hh"
+
+#include "device_householder.hh"
+
+#include <cstdio>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+#ifdef SLATE_HAVE_OMPTARGET
+//------------------------------------------------------------------------------
+/// Applies $H^H A H$, with $H = I - \tau v v^H$, to the m-by-m Hermitian
+/// block A( i0 : i0+m-1, i0 : i0+m-1 ), of which the lower triangle is
+/// stored, as SLATE's herf with conj( tau ). v[0] is taken as 1.
+/// w is workspace of length m.
+#pragma omp declare target
+template <typename scalar_t>
+void herf(
+    scalar_t tau, scalar_t const* v,
+    BandStorage<scalar_t> A, int64_t i0, int64_t m, scalar_t* w )
+{
+    using blas::conj;
+    using real_t = blas::real_type<scalar_t>;
+
+    #define v_( r_ ) ((r_) == 0 ? scalar_t( 1 ) : v[ r_ ])
+
+    // w = A v
+    #pragma omp parallel for
+    for (int64_t r = 0; r < m; ++r) {
+        scalar_t sum = 0;
+        for (int64_t k = 0; k < m; ++k) {
+            scalar_t Ark = r >= k ? A( i0 + r, i0 + k )
+                                  : conj( A( i0 + k, i0 + r ) );
+            sum += Ark * v_( k );
+        }
+        w[ r ] = sum;
+    }
+
+    // w = A v - 0.5 tau (w^H v) v
+    scalar_t dot = 0;
+    for (int64_t r = 0; r < m; ++r)
+        dot += conj( w[ r ] ) * v_( r );
+    scalar_t alpha = real_t( -0.5 ) * tau * dot;
+    for (int64_t r = 0; r < m; ++r)
+        w[ r ] += alpha * v_( r );
+
+    // A = A - tau v w^H - conj( tau ) w v^H, lower triangle
+    #pragma omp parallel for
+    for (int64_t k = 0; k < m; ++k) {
+        for (int64_t r = k; r < m; ++r) {
+            A( i0 + r, i0 + k ) -= tau * v_( r ) * conj( w[ k ] )
+                                   + conj( tau ) * w[ r ] * conj( v_( k ) );
+        }
+    }
+
+    #undef v_
+}
+#pragma omp end declare target
+#endif // SLATE_HAVE_OMPTARGET
+
+//------------------------------------------------------------------------------
+/// Reduces a Hermitian band matrix to real symmetric tridiagonal form by
+/// bulge chasing, computing the same Householder vectors as the host
+/// hb2st. This version does the sweeps one after another, in one
+/// target region.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in] band
+///     Bandwidth of A. band >= 1.
+///
+/// @param[in] nt
+///     Number of block columns of A, ceil( n / band ); determines
+///     where vectors are stored in V.
+///
+/// @param[in,out] AB
+///     The band of A, in GPU memory: A(i, j), for 0 <= i - j < 2*band,
+///     is AB[ i - j + j*ldab ]. On entry, rows band+1 to 2*band-1 of
+///     AB are zero, for the bulges. On exit, the real diagonal and
+///     subdiagonal of the tridiagonal matrix are in rows 0 and 1.
+///
+/// @param[in] ldab
+///     Leading dimension of AB. ldab >= 2*band.
+///
+/// @param[out] V
+///     The Householder vectors, in GPU memory, in the layout of the
+///     2*band-by-(nt*(nt + 1)/2*band) matrix V of hb2st with tile size
+///     band, stored column-wise. Entries not holding vectors are not
+///     referenced.
+///
+/// @param[in] ldv
+///     Leading dimension of V. ldv >= 2*band.
+///
+/// @param[out] progress
+///     Workspace of length n in GPU memory. Not used in this version.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+
+    if (n <= 1)
+        return;
+
+    scalar_t* w = (scalar_t*) omp_target_alloc(
+        sizeof(scalar_t) * (band + 1), queue.device() );
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; sweeps one after another, which satisfies
+    // the dependencies between steps of consecutive sweeps.
+    #pragma omp target is_device_ptr(AB, V, w) device(queue.device())
+    {
+        BandStorage<scalar_t> A = { AB, ldab, 0 };
+        for (int64_t sweep = 0; sweep < n-1; ++sweep) {
+            int64_t nsteps = 2*((n - 1 - sweep + band - 1) / band) - 1;
+
+            // Householder vector of step t is in column vindex*band + vj
+            // + t*band of V, starting in row vi, as in the host hb2st_step.
+            int64_t vj = sweep % band;
+            int64_t vi = vj + 1;
+            int64_t k  = sweep / band;
+            int64_t vindex = k*nt - k*(k - 1)/2;
+            scalar_t* Vsweep = &V[ vi + (vindex*band + vj)*ldv ];
+
+            for (int64_t step = 0; step < nsteps; ++step) {
+                int64_t block = step/2;
+                if (step == 0) {
+                    int64_t i = sweep;
+                    int64_t m1 = std::min( i+band, n-1 ) - i;
+                    larfg( m1, &A( i+1, i ), 1, false, Vsweep );
+                    apply_left( conj( Vsweep[ 0 ] ), Vsweep, A, i+1, i, m1, 1 );
+                    herf( conj( Vsweep[ 0 ] ), Vsweep, A, i+1, m1, w );
+                }
+                else if (step % 2 == 1) {
+                    int64_t i = (block+1)*band + 1 + sweep;
+                    int64_t j =  block   *band + 1 + sweep;
+                    if (i < n) {
+                        int64_t m2 = std::min( i+band-1, n-1 ) - i + 1;
+                        scalar_t* V1 = &Vsweep[ ((step-1)/2)*band*ldv ];
+                        scalar_t* V2 = &Vsweep[ ((step+1)/2)*band*ldv ];
+                        apply_right( V1[ 0 ], V1, A, i, j, m2, band );
+                        larfg( m2, &A( i, j ), 1, false, V2 );
+                        apply_left( conj( V2[ 0 ] ), V2, A, i, j, m2, band );
+                    }
+                }
+                else {
+                    int64_t i = block*band + 1 + sweep;
+                    if (i < n) {
+                        int64_t m1 = std::min( i+band-1, n-1 ) - i + 1;
+                        scalar_t* V1 = &Vsweep[ block*band*ldv ];
+                        herf( conj( V1[ 0 ] ), V1, A, i, m1, w );
+                    }
+                }
+            }
+        }
+    }
+
+    omp_target_free( w, queue.device() );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    float* AB, int64_t ldab,
+    float* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    double* AB, int64_t ldab,
+    double* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void hb2st(
+    int64_t n, int64_t band, int64_t nt,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
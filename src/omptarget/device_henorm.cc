@@ -86,16 +86,16 @@ void henorm(
         }
         else {
             assert(ldv == 1);
-            blas::device_memset(values, 0, batch_count, queue);
             queue.sync(); // sync queue before switching to openmp device execution
             // Use omp target offload
             #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
             #pragma omp teams distribute
             for (int64_t k = 0; k < batch_count; ++k) {
                 const scalar_t* tileA = Aarray[k];
+                real_t tile_max = 0;
                 // distribute rows (i) to threads
                 // note: the max_nan_reduction preserves nans
-                #pragma omp parallel for reduction(max_nan_reduction:values[k]) schedule(static, 1)
+                #pragma omp parallel for reduction(max_nan_reduction:tile_max)
                 for (int64_t i = 0; i < n; ++i) {
                     const scalar_t* rowA = &tileA[i];
                     real_t max = 0;
@@ -112,8 +112,9 @@ void henorm(
                         int64_t j = i;
                         max = max_nan(max, abs_val( std::real( rowA[j*lda] ))); // diag (real)
                     }
-                    values[k] = max_nan(values[0], max);
+                    tile_max = max_nan(tile_max, max);
                 }
+                values[k] = tile_max;
             }
         }
     }
@@ -173,10 +174,9 @@ void henorm(
             #pragma omp teams distribute
             for (int64_t k = 0; k < batch_count; ++k) {
                 const scalar_t* tileA = Aarray[k];
-                values[k*2 + 0] = 0; // scale_k
-                values[k*2 + 1] = 1; // sumsq_k
+                sumsq_t<real_t> ssq = { 0, 1 };
                 // distribute rows to threads (i)
-                #pragma omp parallel for schedule(static, 1)
+                #pragma omp parallel for reduction(sumsq_reduction:ssq)
                 for (int64_t i = 0; i < n; ++i) {
                     scalar_t const* rowI = &tileA[i];
                     real_t scale_ki = 0;
@@ -197,23 +197,10 @@ void henorm(
                         add_sumsq(scale_ki, sumsq_ki, abs_val( std::real( rowI[i*lda] )));
                     }
                     // accumulate the scale and sumsq for each k
-                    #pragma omp critical
-                    {
-                        real_t scale_k = values[k*2 + 0];
-                        real_t sumsq_k = values[k*2 + 1];
-                        if (scale_k > scale_ki) {
-                            sumsq_k = sumsq_k + sumsq_ki*(scale_ki / scale_k)*(scale_ki / scale_k);
-                            // scale_k stays same
-                        }
-                        else if (scale_ki != 0) {
-                            sumsq_k = sumsq_k*(scale_k / scale_ki)*(scale_k / scale_ki) + sumsq_ki;
-                            scale_k = scale_ki;
-                        }
-                        values[k*2 + 0] = scale_k;
-                        values[k*2 + 1] = sumsq_k;
-
-                    }
+                    combine_sumsq(ssq.scale, ssq.sumsq, scale_ki, sumsq_ki);
                 }
+                values[k*2 + 0] = ssq.scale;
+                values[k*2 + 1] = ssq.sumsq;
             }
         }
     }
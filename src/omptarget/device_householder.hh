@@ -0,0 +1,124 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_OMPTARGET_HOUSEHOLDER_HH
+#define SLATE_OMPTARGET_HOUSEHOLDER_HH
+
+#ifdef SLATE_HAVE_OMPTARGET
+
+#include <complex>
+#include <math.h>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Band matrix stored by diagonals, as in LAPACK: element A(i, j) is
+/// AB[ ku + i - j + j*ldab ], where ku is the number of superdiagonals
+/// stored. Used by the bulge chasing kernels.
+#pragma omp declare target
+template <typename scalar_t>
+struct BandStorage {
+    scalar_t* AB;
+    int64_t ldab;
+    int64_t ku;
+
+    scalar_t& operator()( int64_t i, int64_t j ) const
+    {
+        return AB[ ku + i - j + j*ldab ];
+    }
+};
+#pragma omp end declare target
+
+//------------------------------------------------------------------------------
+/// Generates a Householder reflector $H = I - \tau v v^H$ such that
+/// $H^H x = \beta e_1$, as LAPACK larfg, without the rescaling of tiny
+/// values. x is read with stride incx, and conjugated if conj_x.
+/// On exit, v[0] = tau and v[1:n-1] is the reflector, as in SLATE's gerfg.
+#pragma omp declare target
+template <typename scalar_t>
+void larfg(
+    int64_t n, scalar_t const* x, int64_t incx, bool conj_x, scalar_t* v )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    for (int64_t i = 0; i < n; ++i)
+        v[ i ] = conj_x ? blas::conj( x[ i*incx ] ) : x[ i*incx ];
+
+    real_t xnorm2 = 0;
+    for (int64_t i = 1; i < n; ++i)
+        xnorm2 += std::norm( v[ i ] );
+
+    scalar_t alpha = v[ 0 ];
+    real_t alphr = std::real( alpha );
+    real_t alphi = std::imag( alpha );
+    if (xnorm2 == 0 && alphi == 0) {
+        // H = I
+        v[ 0 ] = 0;
+        return;
+    }
+    real_t beta = -copysign(
+        sqrt( alphr*alphr + alphi*alphi + xnorm2 ), alphr );
+    scalar_t scal = real_t( 1 ) / (alpha - beta);
+    for (int64_t i = 1; i < n; ++i)
+        v[ i ] *= scal;
+    v[ 0 ] = (beta - alpha) / beta;
+}
+#pragma omp end declare target
+
+//------------------------------------------------------------------------------
+/// Applies $H = I - \tau v v^H$ from the left, $M = H M$, to the m-by-nc
+/// block M = A( i0 : i0+m-1, j0 : j0+nc-1 ), as SLATE's gerf.
+/// v[0] is taken as 1.
+#pragma omp declare target
+template <typename scalar_t>
+void apply_left(
+    scalar_t tau, scalar_t const* v,
+    BandStorage<scalar_t> A, int64_t i0, int64_t j0, int64_t m, int64_t nc )
+{
+    #pragma omp parallel for
+    for (int64_t k = 0; k < nc; ++k) {
+        // w = M(:, k)^H v
+        scalar_t w = blas::conj( A( i0, j0 + k ) );
+        for (int64_t r = 1; r < m; ++r)
+            w += blas::conj( A( i0 + r, j0 + k ) ) * v[ r ];
+        // M(:, k) -= tau v w^H
+        A( i0, j0 + k ) -= tau * blas::conj( w );
+        for (int64_t r = 1; r < m; ++r)
+            A( i0 + r, j0 + k ) -= tau * v[ r ] * blas::conj( w );
+    }
+}
+#pragma omp end declare target
+
+//------------------------------------------------------------------------------
+/// Applies $H = I - \tau v v^H$ from the right, $M = M H$, to the m-by-nc
+/// block M = A( i0 : i0+m-1, j0 : j0+nc-1 ), as SLATE's gerf applied
+/// to $M^H$. v[0] is taken as 1.
+#pragma omp declare target
+template <typename scalar_t>
+void apply_right(
+    scalar_t tau, scalar_t const* v,
+    BandStorage<scalar_t> A, int64_t i0, int64_t j0, int64_t m, int64_t nc )
+{
+    #pragma omp parallel for
+    for (int64_t r = 0; r < m; ++r) {
+        // w = M(r, :) v
+        scalar_t w = A( i0 + r, j0 );
+        for (int64_t k = 1; k < nc; ++k)
+            w += A( i0 + r, j0 + k ) * v[ k ];
+        // M(r, :) -= tau w v^H
+        A( i0 + r, j0 ) -= tau * w;
+        for (int64_t k = 1; k < nc; ++k)
+            A( i0 + r, j0 + k ) -= tau * w * blas::conj( v[ k ] );
+    }
+}
+#pragma omp end declare target
+
+} // namespace device
+} // namespace slate
+
+#endif // SLATE_HAVE_OMPTARGET
+
+#endif // SLATE_OMPTARGET_HOUSEHOLDER_HH
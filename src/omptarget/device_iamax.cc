@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Finds the first element of x with largest cabs1 = |real| + |imag|,
+/// as in BLAS iamax, without copying the result to the host.
+/// Used for the pivot search in the LU panel factorization.
+///
+/// @param[in] n
+///     Number of elements in x. n >= 1.
+///
+/// @param[in] x
+///     Array of dimension 1 + (n-1)*incx, in GPU memory.
+///
+/// @param[in] incx
+///     Stride between elements of x. incx >= 1.
+///
+/// @param[out] index
+///     On exit, 0-based index of the largest element, in GPU memory.
+///
+/// @param[out] value
+///     On exit, value of the largest element, in GPU memory.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void iamax(
+    int64_t n, scalar_t const* x, int64_t incx,
+    int64_t* index, scalar_t* value,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (n == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; a serial search, as n is a panel column.
+    #pragma omp target is_device_ptr(x, index, value) device(queue.device())
+    {
+        real_t  max_value = -1;
+        int64_t max_index = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            real_t absx = std::abs( std::real( x[ i*incx ] ) )
+                        + std::abs( std::imag( x[ i*incx ] ) );
+            if (absx > max_value) {
+                max_value = absx;
+                max_index = i;
+            }
+        }
+        *index = max_index;
+        *value = x[ max_index*incx ];
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void iamax(
+    int64_t n, float const* x, int64_t incx,
+    int64_t* index, float* value,
+    blas::Queue& queue);
+
+template
+void iamax(
+    int64_t n, double const* x, int64_t incx,
+    int64_t* index, double* value,
+    blas::Queue& queue);
+
+template
+void iamax(
+    int64_t n, std::complex<float> const* x, int64_t incx,
+    int64_t* index, std::complex<float>* value,
+    blas::Queue& queue);
+
+template
+void iamax(
+    int64_t n, std::complex<double> const* x, int64_t incx,
+    int64_t* index, std::complex<double>* value,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,184 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Fused Cholesky factorization and triangular inverse of one tile,
+/// computing A = L L^H (lower) or A = U^H U (upper), and
+/// Ainv = L^{-1} or U^{-1}, in a single kernel launch.
+/// Replaces a device potrf followed by trsm with the factor, which for
+/// small tiles is a chain of latency bound library calls; the panel can
+/// then be updated by trmm with Ainv.
+///
+/// @param[in] uplo
+///     Whether the lower or upper triangle of A is stored.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n Hermitian positive definite matrix A,
+///     stored in an lda-by-n array in GPU memory.
+///     On exit, the uplo triangle holds the Cholesky factor.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[out] Ainv
+///     The n-by-n array in GPU memory. On exit, if info = 0,
+///     the uplo triangle holds the inverse of the Cholesky factor, and
+///     the opposite triangle is set to zero.
+///
+/// @param[in] ldainv
+///     Leading dimension of Ainv. ldainv >= n.
+///
+/// @param[out] info
+///     In GPU memory. On exit, 0 if successful, or i > 0 if the leading
+///     minor of order i is not positive definite; then Ainv is not set.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+    using real_t = blas::real_type<scalar_t>;
+
+    bool lower = (uplo == Uplo::Lower);
+
+    // Element L(i, j), i >= j, of the factor, stored in the lower triangle,
+    // or as U = L^H in the upper triangle.
+    #define L_( A_, ld_, i_, j_ ) \
+        (lower ? A_[ (i_) + (j_)*ld_ ] : conj( A_[ (j_) + (i_)*ld_ ] ))
+    #define set_L_( A_, ld_, i_, j_, value_ ) \
+        do { \
+            if (lower) \
+                A_[ (i_) + (j_)*ld_ ] = (value_); \
+            else \
+                A_[ (j_) + (i_)*ld_ ] = conj( value_ ); \
+        } while (0)
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; one team does the whole tile, with the
+    // barriers of the worksharing loops between steps.
+    #pragma omp target is_device_ptr(A, Ainv, info) device(queue.device())
+    {
+        int64_t iinfo = 0;
+        real_t ajj = 0;
+        #pragma omp parallel
+        {
+            for (int64_t j = 0; j < n; ++j) {
+                #pragma omp single
+                {
+                    ajj = std::real( L_( A, lda, j, j ) );
+                    // ! (ajj > 0) also catches NaN.
+                    if (! (ajj > 0)) {
+                        iinfo = j + 1;
+                    }
+                    else {
+                        ajj = std::sqrt( ajj );
+                        set_L_( A, lda, j, j, scalar_t( ajj ) );
+                    }
+                }
+                if (iinfo != 0)
+                    break;
+
+                // L(j+1:n, j) = A(j+1:n, j) / L(j, j)
+                #pragma omp for
+                for (int64_t i = j + 1; i < n; ++i)
+                    set_L_( A, lda, i, j, L_( A, lda, i, j ) / ajj );
+
+                // Lower triangle of A(j+1:n, j+1:n) -= L(j+1:n, j) L(j+1:n, j)^H
+                #pragma omp for
+                for (int64_t l = j + 1; l < n; ++l) {
+                    scalar_t alj = conj( L_( A, lda, l, j ) );
+                    for (int64_t i = l; i < n; ++i)
+                        set_L_( A, lda, i, l,
+                                L_( A, lda, i, l ) - L_( A, lda, i, j ) * alj );
+                }
+            }
+
+            // Column j of L^{-1} solves L x = e_j; x(0:j-1) = 0.
+            if (iinfo == 0) {
+                #pragma omp for
+                for (int64_t j = 0; j < n; ++j) {
+                    for (int64_t i = 0; i < j; ++i)
+                        set_L_( Ainv, ldainv, i, j, scalar_t( 0 ) );
+                    set_L_( Ainv, ldainv, j, j,
+                            scalar_t( 1 ) / L_( A, lda, j, j ) );
+                    for (int64_t i = j + 1; i < n; ++i) {
+                        scalar_t sum = 0;
+                        for (int64_t l = j; l < i; ++l)
+                            sum += L_( A, lda, i, l ) * L_( Ainv, ldainv, l, j );
+                        set_L_( Ainv, ldainv, i, j, -sum / L_( A, lda, i, i ) );
+                    }
+                }
+            }
+        }
+        *info = iinfo;
+    }
+
+    #undef L_
+    #undef set_L_
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+template
+void potrf_trtri(
+    Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* Ainv, int64_t ldainv,
+    lapack::device_info_int* info,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,114 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Batched routine for row swaps, used to apply a pivot vector to all
+/// local tile columns on a device in one launch. Swaps are in groups,
+/// e.g., one group per tile column; within group g, swaps
+/// offsets[ g ], ..., offsets[ g+1 ] - 1 are applied in order to rows of
+/// length lengths[ g ], stored contiguously (row-major tiles).
+///
+/// @param[in] group_count
+///     Number of groups.
+///
+/// @param[in] offsets
+///     Array in GPU memory of dimension group_count + 1.
+///     Group g has swaps offsets[ g ] to offsets[ g+1 ] - 1.
+///
+/// @param[in] lengths
+///     Array in GPU memory of dimension group_count.
+///     Length of the rows in group g.
+///
+/// @param[in,out] rows
+///     Array in GPU memory of dimension 2*offsets[ group_count ],
+///     containing pointers to rows in GPU memory.
+///     Swap s exchanges rows[ 2*s ] and rows[ 2*s + 1 ].
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    scalar_t** rows,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    // quick return
+    if (group_count == 0)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload
+    // Each team does one group; each thread does one column,
+    // applying the group's swaps in order.
+    #pragma omp target is_device_ptr(offsets, lengths, rows) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t g = 0; g < group_count; ++g) {
+        int64_t begin = offsets[ g ];
+        int64_t end   = offsets[ g + 1 ];
+        int64_t n     = lengths[ g ];
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t s = begin; s < end; ++s) {
+                scalar_t* row1 = rows[ 2*s ];
+                scalar_t* row2 = rows[ 2*s + 1 ];
+                scalar_t tmp = row1[ j ];
+                row1[ j ] = row2[ j ];
+                row2[ j ] = tmp;
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    float** rows,
+    blas::Queue& queue);
+
+template
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    double** rows,
+    blas::Queue& queue);
+
+template
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    std::complex<float>** rows,
+    blas::Queue& queue);
+
+template
+void swap_rows_batch(
+    int64_t group_count,
+    int64_t const* offsets, int64_t const* lengths,
+    std::complex<double>** rows,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
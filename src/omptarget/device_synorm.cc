@@ -83,16 +83,16 @@ void synorm(
         }
         else {
             assert(ldv == 1);
-            blas::device_memset(values, 0, batch_count, queue);
             queue.sync(); // sync queue before switching to openmp device execution
             // Use omp target offload
             #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
             #pragma omp teams distribute
             for (int64_t k = 0; k < batch_count; ++k) {
                 const scalar_t* tileA = Aarray[k];
+                real_t tile_max = 0;
                 // distribute rows (i) to threads
                 // note: the max_nan_reduction preserves nans
-                #pragma omp parallel for reduction(max_nan_reduction:values[k]) schedule(static, 1)
+                #pragma omp parallel for reduction(max_nan_reduction:tile_max)
                 for (int64_t i = 0; i < n; ++i) {
                     const scalar_t* row = &tileA[i];
                     real_t max = 0;
@@ -105,8 +105,9 @@ void synorm(
                         for (int64_t j = n-1; j >= i; --j) // upper
                             max = max_nan(max, abs_val(row[j*lda]));
                     }
-                    values[k] = max_nan(values[k], max);
+                    tile_max = max_nan(tile_max, max);
                 }
+                values[k] = tile_max;
             }
         }
     }
@@ -164,10 +165,9 @@ void synorm(
             #pragma omp teams distribute
             for (int64_t k = 0; k < batch_count; ++k) {
                 const scalar_t* tileA = Aarray[k];
-                values[k*2 + 0] = 0; // scale_k
-                values[k*2 + 1] = 1; // sumsq_k
+                sumsq_t<real_t> ssq = { 0, 1 };
                 // distribute rows to threads (i)
-                #pragma omp parallel for schedule(static, 1)
+                #pragma omp parallel for reduction(sumsq_reduction:ssq)
                 for (int64_t i = 0; i < n; ++i) {
                     scalar_t const* rowI = &tileA[i];
                     real_t scale_ki = 0;
@@ -190,12 +190,10 @@ void synorm(
                         add_sumsq(scale_ki, sumsq_ki, abs_val(rowI[i*lda]));
                     }
                     // accumulate the scale and sumsq for each k
-                    // todo: try to speed this up
-                    #pragma omp critical
-                    {
-                        combine_sumsq(values[k*2+0], values[k*2+1], scale_ki, sumsq_ki);
-                    }
+                    combine_sumsq(ssq.scale, ssq.sumsq, scale_ki, sumsq_ki);
                 }
+                values[k*2 + 0] = ssq.scale;
+                values[k*2 + 1] = ssq.sumsq;
             }
         }
     }
@@ -0,0 +1,193 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_householder.hh"
+
+#include <cstdio>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Reduces an upper triangular band matrix to bidiagonal form by bulge
+/// chasing, computing the same Householder vectors as the host tb2bd.
+/// This version does the sweeps one after another, in one target region.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] band
+///     Upper bandwidth of A. band >= 1.
+///
+/// @param[in] nt
+///     Number of block columns of A, ceil( n / band ); determines
+///     where vectors are stored in U and V.
+///
+/// @param[in,out] AB
+///     The band of A, in GPU memory: A(i, j), for -band < j - i < 2*band,
+///     is AB[ 2*band - 1 + i - j + j*ldab ]. On entry, the diagonals
+///     outside the band are zero, for the bulges. On exit, the real
+///     diagonal and superdiagonal of the bidiagonal matrix are in rows
+///     2*band-1 and 2*band-2.
+///
+/// @param[in] ldab
+///     Leading dimension of AB. ldab >= 3*band - 1.
+///
+/// @param[out] U
+///     The Householder vectors applied from the left, in GPU memory, in the
+///     layout of the 2*band-by-(nt*(nt + 1)/2*band) matrix U of tb2bd with
+///     tile size band, stored column-wise.
+///
+/// @param[in] ldu
+///     Leading dimension of U. ldu >= 2*band.
+///
+/// @param[out] V
+///     The Householder vectors applied from the right, as for U.
+///
+/// @param[in] ldv
+///     Leading dimension of V. ldv >= 2*band.
+///
+/// @param[out] progress
+///     Workspace of length min( m, n ) in GPU memory.
+///     Not used in this version.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* U, int64_t ldu,
+    scalar_t* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+
+    int64_t diag_len = std::min( m, n );
+    if (diag_len <= 1)
+        return;
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; sweeps one after another, which satisfies
+    // the dependencies between steps of consecutive sweeps.
+    #pragma omp target is_device_ptr(AB, U, V) device(queue.device())
+    {
+        BandStorage<scalar_t> A = { AB, ldab, 2*band - 1 };
+        // Rows of A are stored with stride ldab - 1.
+        int64_t inc_row = ldab - 1;
+
+        for (int64_t sweep = 0; sweep < diag_len-1; ++sweep) {
+            int64_t nsteps = 2*((diag_len - 1 - sweep + band - 1) / band) - 1;
+
+            // Householder vectors of step t are in column vindex*band + vj
+            // + t*band of U and V, starting in row vi, as in the host
+            // tb2bd_step.
+            int64_t vj = sweep % band;
+            int64_t vi = vj + 1;
+            int64_t k  = sweep / band;
+            int64_t vindex = k*nt - k*(k - 1)/2;
+            scalar_t* Usweep = &U[ vi + (vindex*band + vj)*ldu ];
+            scalar_t* Vsweep = &V[ vi + (vindex*band + vj)*ldv ];
+
+            for (int64_t step = 0; step < nsteps; ++step) {
+                int64_t block = (step + 1)/2;
+                if (step == 0) {
+                    int64_t i = sweep;
+                    int64_t j = sweep + 1;
+                    if (i < m && j < n) {
+                        int64_t mb = std::min( i+band,   m-1 ) - i + 1;
+                        int64_t nb = std::min( j+band-1, n-1 ) - j + 1;
+                        scalar_t* V1 = Vsweep;
+                        scalar_t* U1 = Usweep;
+                        larfg( nb, &A( i, j ), inc_row, true, V1 );
+                        apply_right( V1[ 0 ], V1, A, i, j, mb, nb );
+                        larfg( mb-1, &A( i+1, j ), 1, false, U1 );
+                        apply_left( conj( U1[ 0 ] ), U1, A, i+1, j, mb-1, nb );
+                    }
+                }
+                else if (step % 2 == 1) {
+                    int64_t i = (block-1)*band + 1 + sweep;
+                    int64_t j =  block   *band + 1 + sweep;
+                    if (i < m && j < n) {
+                        int64_t mb = std::min( i+band-1, m-1 ) - i + 1;
+                        int64_t nb = std::min( j+band-1, n-1 ) - j + 1;
+                        scalar_t* U1 = &Usweep[ ((step-1)/2)*band*ldu ];
+                        scalar_t* V1 = &Vsweep[ ((step+1)/2)*band*ldv ];
+                        apply_left( conj( U1[ 0 ] ), U1, A, i, j, mb, nb );
+                        larfg( nb, &A( i, j ), inc_row, true, V1 );
+                        apply_right( V1[ 0 ], V1, A, i, j, mb, nb );
+                    }
+                }
+                else {
+                    int64_t i = block*band + 1 + sweep;
+                    int64_t j = i;
+                    if (i < m && j < n) {
+                        int64_t mb = std::min( i+band-1, m-1 ) - i + 1;
+                        int64_t nb = std::min( j+band-1, n-1 ) - j + 1;
+                        scalar_t* V1 = &Vsweep[ (step/2)*band*ldv ];
+                        scalar_t* U1 = &Usweep[ (step/2)*band*ldu ];
+                        apply_right( V1[ 0 ], V1, A, i, j, mb, nb );
+                        larfg( mb, &A( i, j ), 1, false, U1 );
+                        apply_left( conj( U1[ 0 ] ), U1, A, i, j, mb, nb );
+                    }
+                }
+            }
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    float* AB, int64_t ldab,
+    float* U, int64_t ldu,
+    float* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    double* AB, int64_t ldab,
+    double* U, int64_t ldu,
+    double* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    std::complex<float>* AB, int64_t ldab,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+template
+void tb2bd(
+    int64_t m, int64_t n, int64_t band, int64_t nt,
+    std::complex<double>* AB, int64_t ldab,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* V, int64_t ldv,
+    int* progress,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
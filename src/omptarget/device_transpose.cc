@@ -700,5 +700,258 @@ void transpose_batch(
 #endif
 }
 
+//------------------------------------------------------------------------------
+/// Device routine does in-place transpose of one contiguous, rectangular
+/// m-by-n matrix into an n-by-m matrix, by following the cycles of the
+/// permutation. Element k = i + j*m moves to j + i*n = k*n mod (m*n - 1),
+/// and element p is replaced by element p*m mod (m*n - 1).
+/// Start index k rotates its cycle only if k is the cycle's smallest index.
+/// Elements 0 and m*n - 1 are fixed.
+///
+template <typename scalar_t>
+void transpose_cycles_func(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+    int64_t size = m*n;
+    int64_t mod = size - 1;
+    bool is_vector = (m == 1 || n == 1);
+    queue.sync(); // sync queue before switching to openmp device execution
+    #pragma omp target is_device_ptr(A) device(queue.device())
+    #pragma omp teams distribute parallel for schedule(static, 1)
+    for (int64_t k = 0; k < size; ++k) {
+        if (is_vector || k == mod) {
+            // Vectors are already transposed; only conjugate.
+            if (is_conj)
+                A[ k ] = conj( A[ k ] );
+            continue;
+        }
+
+        // Leader test: walk forward until back at k or below k.
+        int64_t p = (k * n) % mod;
+        while (p > k)
+            p = (p * n) % mod;
+        if (p < k)
+            continue;
+
+        // Rotate the cycle, pulling each element from its source.
+        scalar_t tmp = A[ k ];
+        p = k;
+        int64_t q = (p * m) % mod;
+        while (q != k) {
+            A[ p ] = is_conj ? conj( A[ q ] ) : A[ q ];
+            p = q;
+            q = (p * m) % mod;
+        }
+        A[ p ] = is_conj ? conj( tmp ) : tmp;
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Device routine does in-place transpose of a batch of contiguous,
+/// rectangular matrices, one team per matrix; see transpose_cycles_func.
+///
+template <typename scalar_t>
+void transpose_cycles_batch_func(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray,
+    int64_t batch_count, blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+    int64_t size = m*n;
+    int64_t mod = size - 1;
+    bool is_vector = (m == 1 || n == 1);
+    queue.sync(); // sync queue before switching to openmp device execution
+    #pragma omp target is_device_ptr(Aarray) device(queue.device())
+    #pragma omp teams distribute
+    for (int64_t b = 0; b < batch_count; ++b) {
+        scalar_t* A = Aarray[ b ];
+        #pragma omp parallel for schedule(static, 1)
+        for (int64_t k = 0; k < size; ++k) {
+            if (is_vector || k == mod) {
+                // Vectors are already transposed; only conjugate.
+                if (is_conj)
+                    A[ k ] = conj( A[ k ] );
+                continue;
+            }
+
+            // Leader test: walk forward until back at k or below k.
+            int64_t p = (k * n) % mod;
+            while (p > k)
+                p = (p * n) % mod;
+            if (p < k)
+                continue;
+
+            // Rotate the cycle, pulling each element from its source.
+            scalar_t tmp = A[ k ];
+            p = k;
+            int64_t q = (p * m) % mod;
+            while (q != k) {
+                A[ p ] = is_conj ? conj( A[ q ] ) : A[ q ];
+                p = q;
+                q = (p * m) % mod;
+            }
+            A[ p ] = is_conj ? conj( tmp ) : tmp;
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a rectangular matrix in place.
+/// Unlike the out-of-place transpose, this requires no workspace; it is
+/// used to convert the layout of contiguous rectangular tiles when no
+/// workspace block is free. It is slower than copying to a workspace and
+/// transposing out of place, since each cycle is rotated by one thread.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in,out] A
+///     A rectangular m-by-n matrix stored contiguously in an m-by-n array
+///     in GPU memory.
+///     On output, A is the n-by-m transpose, stored in an n-by-m array.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    if ((m <= 0) || (n <= 0))
+        return;
+
+    transpose_cycles_func( is_conj, m, n, A, queue );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a batch of rectangular matrices in place.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to
+///     matrices, where each Aarray[k] is a rectangular m-by-n matrix stored
+///     contiguously in an m-by-n array in GPU memory.
+///     On output, each Aarray[k] is its n-by-m transpose.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    if (batch_count <= 0 || m <= 0 || n <= 0)
+        return;
+
+    transpose_cycles_batch_func( is_conj, m, n, Aarray, batch_count, queue );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+// ----------------------------------------
+// Explicit instantiations.
+// Rectangular matrix, in-place
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>* A,
+    blas::Queue& queue);
+
+// ----------------------------------------
+// Explicit instantiations.
+// Batch of rectangular matrices, in-place
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
 } // namespace device
 } // namespace slate
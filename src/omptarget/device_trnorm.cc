@@ -90,15 +90,15 @@ void trnorm(
         else {
             assert(ldv == 1);
             // use omp offload
-            blas::device_memset(values, 0, batch_count, queue);
             queue.sync(); // sync queue before switching to openmp device execution
             #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
             #pragma omp teams distribute
             for (int64_t k = 0; k < batch_count; ++k) {
                 const scalar_t* tileA = Aarray[k];
-                // distribute rows (i) to threads, each thread computes 1 column max
+                real_t tile_max = 0;
+                // distribute rows (i) to threads, each thread computes 1 row max
                 // nan-preserving max reduction operation
-                #pragma omp parallel for reduction(max_nan_reduction:values[k]) schedule(static, 1)
+                #pragma omp parallel for reduction(max_nan_reduction:tile_max)
                 for (int64_t i = 0; i < m; ++i) {
                     const scalar_t* row = &tileA[i];
                     real_t max = 0;
@@ -127,8 +127,9 @@ void trnorm(
                                 max = max_nan(max, abs_val(row[j*lda]));
                         }
                     }
-                    values[k] = max_nan(values[k], max);
+                    tile_max = max_nan(tile_max, max);
                 }
+                values[k] = tile_max;
             }
         }
     }
@@ -237,15 +238,15 @@ void trnorm(
         }
         else {
             assert(ldv == 2);
-            blas::device_memset(values, 0, batch_count * 2, queue);
             queue.sync(); // sync queue before switching to openmp device execution
             #pragma omp target is_device_ptr(Aarray, values) device(queue.device())
             #pragma omp teams distribute
             // distribute each batch array to a team
             for (int64_t k = 0; k < batch_count; ++k) {
                 const scalar_t* tileA = Aarray[k];
+                sumsq_t<real_t> ssq = { 0, 1 };
                 // distribute rows (i) to threads
-                #pragma omp parallel for schedule(static, 1)
+                #pragma omp parallel for reduction(sumsq_reduction:ssq)
                 for (int64_t i = 0; i < m; ++i) {
                     const scalar_t* row = &tileA[i];
                     real_t scale = 0;
@@ -276,23 +277,10 @@ void trnorm(
                         }
                     }
                     // accumulate the scale and sumsq for each k
-                    // todo: this is slow; (reduction with 2 values? two-reductions?)
-                    #pragma omp critical
-                    {
-                        real_t scale_k = values[k*2 + 0];
-                        real_t sumsq_k = values[k*2 + 1];
-                        if (scale_k > scale) {
-                            sumsq_k = sumsq_k + sumsq*(scale / scale_k)*(scale / scale_k);
-                            // scale_k stays same
-                        }
-                        else if (scale != 0) {
-                            sumsq_k = sumsq_k*(scale_k / scale)*(scale_k / scale) + sumsq;
-                            scale_k = scale;
-                        }
-                        values[k*2 + 0] = scale_k;
-                        values[k*2 + 1] = sumsq_k;
-                    }
+                    combine_sumsq(ssq.scale, ssq.sumsq, scale, sumsq);
                 }
+                values[k*2 + 0] = ssq.scale;
+                values[k*2 + 1] = ssq.sumsq;
             }
         }
     }
@@ -0,0 +1,217 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <complex>
+
+namespace slate {
+namespace device {
+
+// Element L(i, j), i >= j, of the triangular matrix, stored in the lower
+// triangle, or as U = L^H in the upper triangle.
+#define L_( A_, ld_, i_, j_ ) \
+    (lower ? A_[ (i_) + (j_)*ld_ ] : conj( A_[ (j_) + (i_)*ld_ ] ))
+#define set_L_( A_, ld_, i_, j_, value_ ) \
+    do { \
+        if (lower) \
+            A_[ (i_) + (j_)*ld_ ] = (value_); \
+        else \
+            A_[ (j_) + (i_)*ld_ ] = conj( value_ ); \
+    } while (0)
+
+//------------------------------------------------------------------------------
+/// Inverse of one triangular tile, in place, in a single kernel launch.
+/// Replaces a round trip of the diagonal tile to the host for LAPACK trtri
+/// in each step of the distributed trtri.
+///
+/// @param[in] uplo
+///     Whether A is lower or upper triangular.
+///
+/// @param[in] diag
+///     Whether A has a unit or non-unit diagonal.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n triangular matrix A,
+///     stored in an lda-by-n array in GPU memory.
+///     On exit, the uplo triangle holds the inverse of A.
+///     If A is singular, the result has Inf or NaN entries.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+
+    bool lower = (uplo == Uplo::Lower);
+    bool unit  = (diag == Diag::Unit);
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; one team does the whole tile, as LAPACK
+    // trti2, with the barriers of the worksharing loops between steps.
+    #pragma omp target is_device_ptr(A) device(queue.device())
+    #pragma omp parallel
+    for (int64_t j = n-1; j >= 0; --j) {
+        #pragma omp single
+        {
+            if (! unit)
+                set_L_( A, lda, j, j, scalar_t( 1 ) / L_( A, lda, j, j ) );
+        }
+
+        // L(j+1:n, j) = L(j+1:n, j+1:n)^{-1} L(j+1:n, j), as trmv
+        // with the already inverted trailing triangle, column by column
+        // from the bottom, so it is in place.
+        for (int64_t l = n-1; l > j; --l) {
+            scalar_t alj = L_( A, lda, l, j );
+            #pragma omp for
+            for (int64_t i = l + 1; i < n; ++i)
+                set_L_( A, lda, i, j, L_( A, lda, i, j ) + alj * L_( A, lda, i, l ) );
+            #pragma omp single
+            {
+                if (! unit)
+                    set_L_( A, lda, l, j, alj * L_( A, lda, l, l ) );
+            }
+        }
+
+        // L(j+1:n, j) *= -L(j, j)^{-1}
+        scalar_t ajj = unit ? scalar_t( -1 ) : -L_( A, lda, j, j );
+        #pragma omp for
+        for (int64_t i = j + 1; i < n; ++i)
+            set_L_( A, lda, i, j, ajj * L_( A, lda, i, j ) );
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Product of one triangular tile with its conjugate transpose, in place,
+/// A = L^H L (lower) or A = U U^H (upper), as LAPACK lauum,
+/// in a single kernel launch.
+///
+/// @param[in] uplo
+///     Whether A is lower or upper triangular.
+///
+/// @param[in] n
+///     Order of A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n triangular matrix L or U,
+///     stored in an lda-by-n array in GPU memory.
+///     On exit, the uplo triangle holds L^H L or U U^H.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void trtrm(
+    Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+#ifdef SLATE_HAVE_OMPTARGET
+    using blas::conj;
+
+    bool lower = (uplo == Uplo::Lower);
+
+    queue.sync(); // sync queue before switching to openmp device execution
+    // Use omp target offload; one team does the whole tile, as LAPACK
+    // lauu2, one row of the result per step.
+    #pragma omp target is_device_ptr(A) device(queue.device())
+    #pragma omp parallel
+    for (int64_t i = 0; i < n; ++i) {
+        // Read before the loop below overwrites it.
+        scalar_t aii = conj( L_( A, lda, i, i ) );
+        #pragma omp barrier
+
+        // L(i, 0:i) = L(i:n, i)^H L(i:n, 0:i)
+        #pragma omp for
+        for (int64_t l = 0; l <= i; ++l) {
+            scalar_t sum = aii * L_( A, lda, i, l );
+            for (int64_t k = i + 1; k < n; ++k)
+                sum += conj( L_( A, lda, k, i ) ) * L_( A, lda, k, l );
+            set_L_( A, lda, i, l, sum );
+        }
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+#undef L_
+#undef set_L_
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtri(
+    Uplo uplo, Diag diag, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtrm(
+    Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtrm(
+    Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtrm(
+    Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void trtrm(
+    Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
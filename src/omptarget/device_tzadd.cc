@@ -77,20 +77,13 @@ void tzadd(
     for (int64_t k = 0; k < batch_count; ++k) {
         scalar_t* tileA = Aarray[ k ];
         scalar_t* tileB = Barray[ k ];
-        // distribute rows (i) to thread
-        #pragma omp parallel for collapse(1) schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[ i ];
-            scalar_t* rowB = &tileB[ i ];
-            // add lower/upper
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                    rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
-                }
-            }
-            else {
-                for (int64_t j = n-1; j >= i; --j) { // upper
-                    rowB[j*ldb] = alpha * rowA[j*lda] + beta * rowB[j*ldb];
+        // distribute entries (i, j) to threads, consecutive rows i together;
+        // threads outside the lower/upper trapezoid do nothing
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                if (uplo == lapack::Uplo::Lower ? j <= i : j >= i) {
+                    tileB[i + j*ldb] = alpha * tileA[i + j*lda] + beta * tileB[i + j*ldb];
                 }
             }
         }
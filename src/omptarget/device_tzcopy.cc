@@ -59,18 +59,13 @@ void tzcopy(
     for (int64_t k = 0; k < batch_count; ++k) {
         src_scalar_t const* tileA = Aarray[k];
         dst_scalar_t* tileB = Barray[k];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            src_scalar_t const* rowA = &tileA[i];
-            dst_scalar_t* rowB = &tileB[i];
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) // lower
-                    rowB[j*ldb] = rowA[j*lda];
-            }
-            else {
-                for (int64_t j = n-1; j >= i; --j) // upper
-                    rowB[j*ldb] = rowA[j*lda];
+        // distribute entries (i, j) to threads, consecutive rows i together;
+        // threads outside the lower/upper trapezoid do nothing
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                    tileB[i + j*ldb] = tileA[i + j*lda];
             }
         }
     }
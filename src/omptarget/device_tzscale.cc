@@ -71,19 +71,13 @@ void tzscale(
     #pragma omp teams distribute
     for (int64_t k = 0; k < batch_count; ++k) {
         scalar_t* tileA = Aarray[ k ];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &tileA[ i ];
-            // lower or upper
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                    rowA[j*lda] = rowA[j*lda] * mul;
-                }
-            }
-            else {
-                for (int64_t j = n-1; j >= i; --j) // upper
-                    rowA[j*lda] = rowA[j*lda] * mul;
+        // distribute entries (i, j) to threads, consecutive rows i together;
+        // threads outside the lower/upper trapezoid do nothing
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                    tileA[i + j*lda] = tileA[i + j*lda] * mul;
             }
         }
     }
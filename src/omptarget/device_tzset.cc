@@ -57,20 +57,13 @@ void tzset(
     queue.sync(); // sync queue before switching to openmp device execution
     // Use omp target offload
     #pragma omp target is_device_ptr(A) device(queue.device())
-    // distribute rows (i) to threads
-    #pragma omp teams distribute parallel for schedule(static, 1)
-    for (int64_t i = 0; i < m; ++i) {
-        scalar_t* rowA = &A[ i ];
-        // lower or upper
-        if (uplo == lapack::Uplo::Lower) {
-            for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-            }
-        }
-        else {
-            for (int64_t j = n-1; j >= i; --j) { // upper
-                rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-            }
+    // distribute entries (i, j) to threads, consecutive rows i together;
+    // threads outside the lower/upper trapezoid do nothing
+    #pragma omp teams distribute parallel for collapse(2)
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < m; ++i) {
+            if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                A[ i + j*lda ] = i == j ? diag_value : offdiag_value;
         }
     }
 #else
@@ -170,20 +163,13 @@ void tzset(
     #pragma omp teams distribute
     for (int64_t k = 0; k < batch_count; ++k) {
         scalar_t* A = Aarray[ k ];
-        // distribute rows (i) to threads
-        #pragma omp parallel for schedule(static, 1)
-        for (int64_t i = 0; i < m; ++i) {
-            scalar_t* rowA = &A[ i ];
-            // lower or upper
-            if (uplo == lapack::Uplo::Lower) {
-                for (int64_t j = 0; j <= i && j < n; ++j) { // lower
-                    rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-                }
-            }
-            else {
-                for (int64_t j = n-1; j >= i; --j) { // upper
-                    rowA[ j*lda ] = i == j ? diag_value : offdiag_value;
-                }
+        // distribute entries (i, j) to threads, consecutive rows i together;
+        // threads outside the lower/upper trapezoid do nothing
+        #pragma omp parallel for collapse(2)
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                if (uplo == lapack::Uplo::Lower ? j <= i : j >= i)
+                    A[ i + j*lda ] = i == j ? diag_value : offdiag_value;
             }
         }
     }
@@ -80,6 +80,34 @@ inline void add_sumsq(
 }
 #pragma omp end declare target
 
+//------------------------------------------------------------------------------
+/// Scaled sum-of-squares, scale^2 sumsq, as one variable for
+/// sumsq_reduction. Initialize to { 0, 1 }, i.e., zero.
+template <typename real_t>
+struct sumsq_t {
+    real_t scale;
+    real_t sumsq;
+};
+
+#pragma omp declare target
+template <typename real_t>
+inline sumsq_t<real_t> combine_sumsq(
+    sumsq_t<real_t> x, sumsq_t<real_t> y )
+{
+    combine_sumsq( x.scale, x.sumsq, y.scale, y.sumsq );
+    return x;
+}
+#pragma omp end declare target
+
+// OpenMP reduction operation combining scaled sums-of-squares, so threads
+// accumulate (scale, sumsq) privately instead of in a critical section.
+#pragma omp declare reduction(sumsq_reduction: sumsq_t<float>: \
+    omp_out = combine_sumsq(omp_out, omp_in)) \
+    initializer(omp_priv = sumsq_t<float>{ 0, 1 })
+#pragma omp declare reduction(sumsq_reduction: sumsq_t<double>: \
+    omp_out = combine_sumsq(omp_out, omp_in)) \
+    initializer(omp_priv = sumsq_t<double>{ 0, 1 })
+
 //------------------------------------------------------------------------------
 /// Overloaded versions of absolute value on device.
 #pragma omp declare target
@@ -17,7 +17,9 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel band Cholesky factorization.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// Panel computed on host using Host OpenMP task.
+/// For Target::Devices, the lookahead and trailing band window updates
+/// run on the GPU device.
 ///
 /// Warning: ColMajor layout is assumed
 ///
@@ -34,6 +36,7 @@ int64_t pbtrf(
     const int priority_0 = 0;
     const int priority_1 = 1;
     const int queue_0 = 0;
+    const int64_t batch_size_default = 0;
 
     // Assumes column major
     const Layout layout = Layout::ColMajor;
@@ -58,6 +61,14 @@ int64_t pbtrf(
     // todo: initially, assume fixed size, square tiles for simplicity
     int64_t kdt = ceildiv( kd, A.tileNb(0) );
 
+    // Allocate batch arrays = number of kernels without lookahead + lookahead
+    // number of kernels without lookahead = 1
+    // (i.e., the trailing band window)
+    if (target == Target::Devices) {
+        A.allocateBatchArrays( batch_size_default, 1 + lookahead );
+        A.reserveDeviceWorkspace();
+    }
+
     #pragma omp parallel
     #pragma omp master
     {
@@ -97,7 +108,7 @@ int64_t pbtrf(
                     bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
                                                    A.sub(i, ij_end-1, i, i)}});
                 }
-                A.template listBcast(bcast_list_A, layout);
+                A.template listBcast<target>( bcast_list_A, layout );
             }
 
             // update trailing submatrix, normal priority
@@ -106,7 +117,7 @@ int64_t pbtrf(
                                  depend(inout:column[k+1+lookahead]) \
                                  depend(inout:column[A_nt-1])
                 {
-                    internal::herk<Target::HostTask>(
+                    internal::herk<target>(
                         -r_one, A.sub(k+1+lookahead, ij_end-1, k, k),
                         r_one,  A.sub(k+1+lookahead, ij_end-1),
                         priority_0, queue_0, layout );
@@ -118,18 +129,19 @@ int64_t pbtrf(
                 #pragma omp task depend(in:column[k]) \
                                  depend(inout:column[j])
                 {
-                    internal::herk<Target::HostTask>(
+                    int queue_jk = j-k;
+                    internal::herk<target>(
                         -r_one, A.sub(j, j, k, k),
                         r_one,  A.sub(j, j),
-                        priority_0, queue_0, layout );
+                        priority_0, queue_jk, layout );
 
-                    if (j+1 <= A_nt-1) {
+                    if (j+1 <= ij_end-1) {
                         auto Ajk = A.sub(j, j, k, k);
-                        internal::gemm<Target::HostTask>(
+                        internal::gemm<target>(
                             -one, A.sub(j+1, ij_end-1, k, k),
                                   conj_transpose( Ajk ),
                             one,  A.sub(j+1, ij_end-1, j, j),
-                            layout, priority_1 );
+                            layout, priority_1, queue_jk );
                     }
                 }
             }
@@ -41,6 +41,10 @@ namespace slate {
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::NormEstVectors:
+///       Number of vectors t in the block 1-norm estimator; each iteration
+///       does one potrs with t right-hand sides. If 1, uses
+///       the one-vector estimator of LAPACK's lacn2. Default 2.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
@@ -85,6 +89,26 @@ blas::real_type<scalar_t> pocondest(
 
     real_t Ainvnorm = 0.0;
 
+    int64_t t = std::min( get_option<Option::NormEstVectors>( opts, 2 ), m );
+    if (t > 1) {
+        slate::Matrix<scalar_t> X( m, t, A.tileMbFunc(),
+                                   func::uniform_blocksize( t, t ),
+                                   A.tileRankFunc(), A.tileDeviceFunc(),
+                                   A.mpiComm() );
+        X.insertLocalTiles( Target::Host );
+
+        // Block estimate of the 1-norm of inv(A); A is Hermitian, so both
+        // ops are the same. Each step is one potrs with all t vectors.
+        auto apply = [&]( Op, Matrix<scalar_t>& Y ) {
+            potrs( A, Y, opts );
+        };
+        Ainvnorm = internal::norm1est_block<scalar_t>( X, apply );
+        if (Ainvnorm != 0.0) {
+            return (1.0 / Ainvnorm) / Anorm;
+        }
+        return 0.;
+    }
+
     std::vector<int64_t> isave = {0, 0, 0, 0};
 
     auto tileMb = A.tileMbFunc();
@@ -0,0 +1,255 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel polar decomposition,
+/// \[
+///     A = U H,
+/// \]
+/// of an m-by-n matrix A, m >= n, where U has orthonormal columns and H is
+/// Hermitian positive semidefinite, by the QR-based dynamically weighted
+/// Halley iteration (QDWH) of Nakatsukasa, Bai, and Gygi (2010).
+///
+/// Starting from $U_0 = A / \alpha$, with $\alpha = \|A\|_F \ge \|A\|_2$,
+/// each iteration computes
+/// \[
+///     U_{k+1} = U_k (a_k I + b_k U_k^H U_k) (I + c_k U_k^H U_k)^{-1},
+/// \]
+/// with weights $a_k, b_k, c_k$ from a lower bound $l_k$ on the smallest
+/// singular value of $U_k$. While $c_k > 100$, it is computed stably as
+/// \[
+///     \begin{bmatrix} \sqrt{c_k} U_k \\ I \end{bmatrix}
+///     = \begin{bmatrix} Q_1 \\ Q_2 \end{bmatrix} R,
+///     \quad
+///     U_{k+1} = \frac{b_k}{c_k} U_k
+///             + \frac{1}{\sqrt{c_k}} \left( a_k - \frac{b_k}{c_k} \right)
+///               Q_1 Q_2^H,
+/// \]
+/// with geqrf and ungqr; afterwards, from the Cholesky factor of
+/// $I + c_k U_k^H U_k$, with herk, potrf, and trsm. In double precision,
+/// it converges in at most 6 iterations, at most 2 of them QR-based,
+/// so it is almost all Level 3 BLAS.
+/// Finally, $H = (U^H A + A^H U) / 2$, with her2k.
+///
+/// Tiles of A are assumed square (mb = nb), and A is not transposed.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the m-by-n matrix $A$, m >= n.
+///     On exit, the orthonormal polar factor $U$.
+///     If A = 0, it is unchanged, and H = 0.
+///
+/// @param[out] H
+///     On entry, if H is empty, does not compute H.
+///     Otherwise, the n-by-n Hermitian matrix $H$.
+///     On exit, the Hermitian positive semidefinite polar factor.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target, as for gemm, geqrf, and potrf.
+///
+/// @ingroup svd
+///
+template <typename scalar_t>
+void polar(
+    Matrix<scalar_t>& A,
+    HermitianMatrix<scalar_t>& H,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+    using std::sqrt;
+
+    trace::Block trace_block( "slate::polar" );
+    Timer t_polar;
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+    const real_t r_zero = 0.0, r_one = 1.0;
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    // Convergence tolerances, from Nakatsukasa and Higham (2013).
+    const real_t tol_l = 5*eps;
+    const real_t tol_u = std::cbrt( 5*eps );
+    const int64_t max_iter = 20;
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t mt = A.mt();
+    int64_t mb = A.tileMb( 0 );
+    slate_assert( m >= n );
+    slate_assert( A.op() == Op::NoTrans );
+
+    bool wanth = (H.mt() > 0);
+    if (wanth)
+        slate_assert( H.n() == n );
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    // A0 keeps A for H = U^H A.
+    Matrix<scalar_t> A0;
+    if (wanth) {
+        A0 = A.emptyLike();
+        A0.insertLocalTiles( target );
+        copy( A, A0, opts );
+    }
+
+    // U0 = A / alpha.
+    real_t alpha = norm( Norm::Fro, A, opts );
+    if (alpha == r_zero) {
+        if (wanth)
+            set( zero, H, opts );
+        return;
+    }
+    scale( r_one, alpha, A, opts );
+
+    auto X = A.emptyLike();
+    X.insertLocalTiles( target );
+
+    // l0 <= sigma_min( U0 ), estimated from U0 = QR, as
+    // sigma_min( R ) >= 1 / (sqrt( n ) ||R^{-1}||_1)
+    //                 = rcond( R ) ||R||_1 / sqrt( n ).
+    TriangularFactors<scalar_t> T;
+    copy( A, X, opts );
+    geqrf( X, T, opts );
+    auto X_nn = X.slice( 0, n-1, 0, n-1 );
+    TriangularMatrix<scalar_t> R( Uplo::Upper, Diag::NonUnit, X_nn );
+    real_t Rnorm = norm( Norm::One, R, opts );
+    real_t rcond = trcondest( Norm::One, R, Rnorm, opts );
+    real_t l = 0.9 * rcond * Rnorm / sqrt( real_t( n ) );
+    l = std::max( std::min( l, r_one ), eps );
+
+    // W = [ sqrt( c ) U; 0; I ] is (mt mb + n)-by-n. The zero rows pad U
+    // to whole tiles, so I starts at a tile boundary; they are zero in
+    // Q = [ Q1; 0; Q2 ] as well. Block row i of W has A's ranks and
+    // devices of block row i mod mt, so the top is distributed as U.
+    int64_t m_pad = mt * mb;
+    std::function<int64_t (int64_t)> tileMb_W
+        = [A, mt, mb]( int64_t i ) {
+            return i < mt ? mb : A.tileNb( i - mt );
+        };
+    std::function<int64_t (int64_t)> tileNb_W
+        = [A]( int64_t j ) {
+            return A.tileNb( j );
+        };
+    std::function<int (func::ij_tuple)> tileRank_W
+        = [A, mt]( func::ij_tuple ij ) {
+            return A.tileRank( std::get<0>( ij ) % mt, std::get<1>( ij ) );
+        };
+    std::function<int (func::ij_tuple)> tileDevice_W
+        = [A, mt]( func::ij_tuple ij ) {
+            return A.tileDevice( std::get<0>( ij ) % mt, std::get<1>( ij ) );
+        };
+    Matrix<scalar_t> W( m_pad + n, n, tileMb_W, tileNb_W,
+                        tileRank_W, tileDevice_W, A.mpiComm() );
+    W.insertLocalTiles( target );
+    auto W_top = W.slice( 0, m-1, 0, n-1 );
+    auto W_bot = W.slice( m_pad, m_pad + n-1, 0, n-1 );
+    Matrix<scalar_t> Q;
+
+    // The Cholesky-based iterations use the bottom of W as Z.
+    HermitianMatrix<scalar_t> Z( Uplo::Lower, W_bot );
+    TriangularMatrix<scalar_t> L( Diag::NonUnit, Z );
+    auto LH = conj_transpose( L );
+    auto AH = conj_transpose( A );
+
+    for (int64_t iter = 0; iter < max_iter; ++iter) {
+        // Dynamic weights, from l_k, and l_{k+1}.
+        real_t l2 = l*l;
+        real_t d  = std::cbrt( 4*(1 - l2) / (l2*l2) );
+        real_t sqrt_d1 = sqrt( 1 + d );
+        real_t a  = sqrt_d1 + sqrt( 8 - 4*d + 8*(2 - l2) / (l2*sqrt_d1) ) / 2;
+        real_t b  = (a - 1)*(a - 1) / 4;
+        real_t c  = a + b - 1;
+        l = l*(a + b*l2) / (1 + c*l2);
+
+        if (c > 100) {
+            // QR-based: X = (a - b/c) / sqrt( c ) Q1 Q2^H.
+            if (Q.mt() == 0) {
+                Q = W.emptyLike();
+                Q.insertLocalTiles( target );
+            }
+            set( zero, W, opts );
+            copy( A, W_top, opts );
+            scale( sqrt( c ), r_one, W_top, opts );
+            set( zero, one, W_bot, opts );
+            geqrf( W, T, opts );
+            ungqr( W, T, Q, opts );
+
+            auto Q1 = Q.slice( 0, m-1, 0, n-1 );
+            auto Q2 = Q.slice( m_pad, m_pad + n-1, 0, n-1 );
+            auto Q2H = conj_transpose( Q2 );
+            gemm( scalar_t( (a - b/c) / sqrt( c ) ), Q1, Q2H, zero, X, opts );
+        }
+        else {
+            // Cholesky-based: Z = I + c U^H U = L L^H,
+            // X = (a - b/c) U L^{-H} L^{-1}.
+            if (Q.mt() > 0)
+                Q = Matrix<scalar_t>();
+            set( zero, one, Z, opts );
+            herk( c, AH, r_one, Z, opts );
+            int64_t info = potrf( Z, opts );
+            slate_assert( info == 0 );
+            copy( A, X, opts );
+            trsm( Side::Right, scalar_t( a - b/c ), LH, X, opts );
+            trsm( Side::Right, one, L, X, opts );
+        }
+
+        // X = U_{k+1} - U_k = X + (b/c - 1) U_k, then U = U_{k+1}.
+        add( scalar_t( b/c - 1 ), A, one, X, opts );
+        add( one, X, one, A, opts );
+
+        real_t diff = norm( Norm::Fro, X, opts );
+        if (diff <= tol_u && std::abs( 1 - l ) <= tol_l)
+            break;
+    }
+
+    if (wanth) {
+        // H = (U^H A + A^H U) / 2, Hermitian by construction.
+        auto A0H = conj_transpose( A0 );
+        her2k( scalar_t( 0.5 ), AH, A0H, r_zero, H, opts );
+    }
+
+    internal::timers_set( opts, "polar", t_polar.stop() );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void polar<float>(
+    Matrix<float>& A,
+    HermitianMatrix<float>& H,
+    Options const& opts);
+
+template
+void polar<double>(
+    Matrix<double>& A,
+    HermitianMatrix<double>& H,
+    Options const& opts);
+
+template
+void polar< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    HermitianMatrix< std::complex<float> >& H,
+    Options const& opts);
+
+template
+void polar< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    HermitianMatrix< std::complex<double> >& H,
+    Options const& opts);
+
+} // namespace slate
@@ -74,6 +74,9 @@ int64_t posv(
     Matrix<scalar_t>& B,
     Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "posv", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "posv", A.mpiComm(), opts );
+
     Timer t_posv;
 
     slate_assert(B.mt() == A.mt());
@@ -81,16 +84,16 @@ int64_t posv(
     // factorization
     Timer t_potrf;
     int64_t info = potrf( A, opts );
-    timers[ "posv::potrf" ] = t_potrf.stop();
+    internal::timers_set( opts, "posv::potrf", t_potrf.stop() );
 
     // solve
     Timer t_potrs;
     if (info == 0) {
         potrs( A, B, opts );
     }
-    timers[ "posv::potrs" ] = t_potrs.stop();
+    internal::timers_set( opts, "posv::potrs", t_potrs.stop() );
 
-    timers[ "posv" ] = t_posv.stop();
+    internal::timers_set( opts, "posv", t_posv.stop() );
     return info;
 }
 
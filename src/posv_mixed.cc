@@ -95,6 +95,15 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to convergene, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::MathMode:
+///       Math mode of the low precision factorization on devices.
+///       MathMode::TF32 runs its single precision gemm updates on tensor
+///       cores; refinement recovers the accuracy. Default MathMode::Default
+///     - Option::MixedLowMemory:
+///       If true, with Target::Devices, A is kept on the host, where it is
+///       converted and its residual products are computed, so device
+///       memory holds only the low precision factor. See gesv_mixed.
+///       Default false
 ///
 /// @return 0: successful exit
 /// @return i > 0: the leading minor of order $i$ of $A$ is not
@@ -128,6 +137,12 @@ int64_t posv_mixed(
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    MathMode math_mode = get_option<Option::MathMode>( opts, MathMode::Default );
+    bool low_memory = target == Target::Devices
+                      && get_option<Option::MixedLowMemory>( opts, false );
+    Options opts_host = opts;
+    if (low_memory)
+        opts_host[ Option::Target ] = Target::HostTask;
     bool converged = false;
     iter = 0;
 
@@ -144,9 +159,14 @@ int64_t posv_mixed(
     // insert local tiles
     X_lo.insertLocalTiles( target );
     R.   insertLocalTiles( target );
-    A_lo.insertLocalTiles( target );
+    A_lo.insertLocalTiles( low_memory ? Target::Host : target );
 
     if (target == Target::Devices) {
+        // Low precision factorization may use reduced precision math.
+        A_lo.setMathMode( math_mode );
+    }
+
+    if (target == Target::Devices && ! low_memory) {
         #pragma omp parallel
         #pragma omp master
         {
@@ -169,7 +189,7 @@ int64_t posv_mixed(
     }
 
     // norm of A
-    real_hi Anorm = norm( Norm::Inf, A, opts );
+    real_hi Anorm = norm( Norm::Inf, A, opts_host );
 
     // stopping criteria
     real_hi cte = Anorm * tol;
@@ -178,12 +198,12 @@ int64_t posv_mixed(
     copy( B, X_lo, opts );
 
     // Convert A from high to low precision, store result in A_lo.
-    copy( A, A_lo, opts );
+    copy( A, A_lo, opts_host );
 
     // Compute the Cholesky factorization of A_lo.
     Timer t_potrf_lo;
     int64_t info = potrf( A_lo, opts );
-    timers[ "posv_mixed::potrf_lo" ] = t_potrf_lo.stop();
+    internal::timers_set( opts, "posv_mixed::potrf_lo", t_potrf_lo.stop() );
     if (info != 0) {
         iter = -3;
     }
@@ -191,7 +211,7 @@ int64_t posv_mixed(
         // Solve the system A_lo * X_lo = B_lo.
         Timer t_potrs_lo;
         potrs( A_lo, X_lo, opts );
-        timers[ "posv_mixed::potrs_lo" ] = t_potrs_lo.stop();
+        internal::timers_set( opts, "posv_mixed::potrs_lo", t_potrs_lo.stop() );
 
         // Convert X_lo to high precision.
         copy( X_lo, X, opts );
@@ -203,13 +223,13 @@ int64_t posv_mixed(
             Side::Left,
             -one_hi, A,
                      X,
-            one_hi,  R, opts );
-        timers[ "posv_mixed::hemm_hi" ] = t_hemm_hi.stop();
+            one_hi,  R, opts_host );
+        internal::timers_set( opts, "posv_mixed::hemm_hi", t_hemm_hi.stop() );
 
         // Check whether the nrhs normwise backward error satisfies the
         // stopping criterion. If yes, set iter=0 and return.
-        colNorms( Norm::Max, X, colnorms_X.data(), opts );
-        colNorms( Norm::Max, R, colnorms_R.data(), opts );
+        colNorms( Norm::Max, X, colnorms_X.data(),
+                             R, colnorms_R.data(), opts );
 
         if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
             iter = 0;
@@ -217,7 +237,7 @@ int64_t posv_mixed(
         }
 
         // iterative refinement
-        timers[ "posv_mixed::add_hi" ] = 0;
+        internal::timers_reset( opts, "posv_mixed::add_hi" );
         for (int iiter = 0; iiter < itermax && ! converged; ++iiter) {
             // Convert R from high to low precision, store result in X_lo.
             copy( R, X_lo, opts );
@@ -225,7 +245,8 @@ int64_t posv_mixed(
             // Solve the system A_lo * X_lo = R_lo.
             t_potrs_lo.start();
             potrs( A_lo, X_lo, opts );
-            timers[ "posv_mixed::potrs_lo" ] += t_potrs_lo.stop();
+            internal::timers_add( opts, "posv_mixed::potrs_lo",
+                                  t_potrs_lo.stop() );
 
             // Convert X_lo back to double precision and update the current iterate.
             copy( X_lo, R, opts );
@@ -233,7 +254,7 @@ int64_t posv_mixed(
             add<scalar_hi>(
                   one_hi, R,
                   one_hi, X, opts );
-            timers[ "posv_mixed::add_hi" ] += t_add_hi.stop();
+            internal::timers_add( opts, "posv_mixed::add_hi", t_add_hi.stop() );
 
             // Compute R = B - A * X.
             slate::copy( B, R, opts );
@@ -242,13 +263,14 @@ int64_t posv_mixed(
                 Side::Left,
                 -one_hi, A,
                          X,
-                one_hi,  R, opts );
-            timers[ "posv_mixed::hemm_hi" ] += t_hemm_hi.stop();
+                one_hi,  R, opts_host );
+            internal::timers_add( opts, "posv_mixed::hemm_hi",
+                                  t_hemm_hi.stop() );
 
             // Check whether nrhs normwise backward error satisfies the
             // stopping criterion. If yes, set iter = iiter > 0 and return.
-            colNorms( Norm::Max, X, colnorms_X.data(), opts );
-            colNorms( Norm::Max, R, colnorms_R.data(), opts );
+            colNorms( Norm::Max, X, colnorms_X.data(),
+                                 R, colnorms_R.data(), opts );
 
             if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
                 iter = iiter+1;
@@ -269,7 +291,8 @@ int64_t posv_mixed(
             // Compute the Cholesky factorization of A.
             Timer t_potrf_hi;
             info = potrf( A, opts );
-            timers[ "posv_mixed::potrf_hi" ] = t_potrf_hi.stop();
+            internal::timers_set( opts, "posv_mixed::potrf_hi",
+                                  t_potrf_hi.stop() );
 
             // Solve the system A * X = B.
             Timer t_potrs_hi;
@@ -277,17 +300,18 @@ int64_t posv_mixed(
                 slate::copy( B, X, opts );
                 potrs( A, X, opts );
             }
-            timers[ "posv_mixed::potrs_hi" ] = t_potrs_hi.stop();
+            internal::timers_set( opts, "posv_mixed::potrs_hi",
+                                  t_potrs_hi.stop() );
         }
     }
 
-    if (target == Target::Devices) {
+    if (target == Target::Devices && ! low_memory) {
         // clear instead of release due to previous hold
         A.clearWorkspace();
         B.clearWorkspace();
         X.clearWorkspace();
     }
-    timers[ "posv_mixed" ] = t_posv_mixed.stop();
+    internal::timers_set( opts, "posv_mixed", t_posv_mixed.stop() );
 
     return info;
 }
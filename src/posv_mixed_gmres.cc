@@ -29,6 +29,13 @@ namespace slate {
 /// quality (see below). If the approach fails, the method falls back to a
 /// high precision (double) factorization and solve.
 ///
+/// The residual reduction per GMRES iteration is monitored. If, at the
+/// average rate so far, the residual can't reach the tolerance within
+/// itermax iterations, GMRES-IR stops early and falls back, instead of
+/// running all itermax iterations first. The low precision work wasted
+/// on a failing problem is then only the low precision factorization
+/// and a few iterations.
+///
 /// GMRES-IR is not going to be a winning strategy if the ratio of
 /// low-precision performance over high-precision performance is too small.
 /// A reasonable strategy should take the number of right-hand sides and the
@@ -75,7 +82,7 @@ namespace slate {
 ///          precision factorization and solve.
 ///          -3: single precision matrix was exactly singular in getrf.
 ///          -(itermax+1): iterative refinement failed to converge in
-///          itermax iterations.
+///          itermax iterations, or was predicted to fail and stopped early.
 ///
 /// @param[in] opts
 ///     Additional options, as map of name = value pairs. Possible options:
@@ -99,6 +106,10 @@ namespace slate {
 ///     - Option::UseFallbackSolver:
 ///       If true and iterative refinement fails to convergene, the problem is
 ///       resolved with partial-pivoted LU. Default true
+///     - Option::MathMode:
+///       Math mode of the low precision factorization on devices.
+///       MathMode::TF32 runs its single precision gemm updates on tensor
+///       cores; refinement recovers the accuracy. Default MathMode::Default
 ///
 /// @return 0: successful exit
 /// @return i > 0: the leading minor of order $i$ of $A$ is not
@@ -132,8 +143,10 @@ int64_t posv_mixed_gmres(
     int64_t itermax = get_option<int64_t>( opts, Option::MaxIterations, 30 );
     double tol = get_option<double>( opts, Option::Tolerance, eps*std::sqrt(A.m()) );
     bool use_fallback = get_option<int64_t>( opts, Option::UseFallbackSolver, true );
+    MathMode math_mode = get_option<Option::MathMode>( opts, MathMode::Default );
     int64_t restart = blas::min( 30, itermax, A.tileMb( 0 )-1 );
     bool converged = false;
+    bool stalled = false;
     iter = 0;
 
     assert( B.mt() == A.mt() );
@@ -149,6 +162,10 @@ int64_t posv_mixed_gmres(
     R.insertLocalTiles( target );
     auto A_lo = A.template emptyLike<scalar_lo>();
     A_lo.insertLocalTiles( target );
+    if (target == Target::Devices) {
+        // Low precision factorization may use reduced precision math.
+        A_lo.setMathMode( math_mode );
+    }
     auto X_lo = X.template emptyLike<scalar_lo>();
     X_lo.insertLocalTiles( target );
 
@@ -205,7 +222,8 @@ int64_t posv_mixed_gmres(
     slate::copy( A, A_lo, opts );
     Timer t_potrf_lo;
     int64_t info = potrf( A_lo, opts );
-    timers[ "posv_mixed_gmres::potrf_lo" ] = t_potrf_lo.stop();
+    internal::timers_set( opts, "posv_mixed_gmres::potrf_lo",
+                          t_potrf_lo.stop() );
     if (info != 0) {
         iter = -3;
     }
@@ -214,13 +232,15 @@ int64_t posv_mixed_gmres(
         slate::copy( B, X_lo, opts );
         Timer t_potrs_lo;
         potrs( A_lo, X_lo, opts );
-        timers[ "posv_mixed_gmres::potrs_lo" ] = t_potrs_lo.stop();
+        internal::timers_set( opts, "posv_mixed_gmres::potrs_lo",
+                              t_potrs_lo.stop() );
         slate::copy( X_lo, X, opts );
 
         // IR
         int iiter = 0;
-        timers[ "posv_mixed_gmres::add_hi" ] = 0;
-        while (iiter < itermax) {
+        real_hi residual_0 = -1;
+        internal::timers_reset( opts, "posv_mixed_gmres::add_hi" );
+        while (iiter < itermax && ! stalled) {
 
             // Check for convergence
             slate::copy( B, R, opts );
@@ -231,9 +251,16 @@ int64_t posv_mixed_gmres(
                       X,
                 one,  R,
                 opts);
-            timers[ "posv_mixed_gmres::hemm_hi" ] = t_hemm_hi.stop();
-            colNorms( Norm::Max, X, colnorms_X.data(), opts );
-            colNorms( Norm::Max, R, colnorms_R.data(), opts );
+            internal::timers_set( opts, "posv_mixed_gmres::hemm_hi",
+                                  t_hemm_hi.stop() );
+            // Copy R to the first Krylov vector, needed unless converged,
+            // while the column norms are reduced.
+            auto colnorms_request = colNorms_start(
+                Norm::Max, X, colnorms_X.data(),
+                           R, colnorms_R.data(), opts );
+            auto v0 = V.slice( 0, V.m()-1, 0, 0 );
+            slate::copy( R, v0, opts );
+            colnorms_request.wait();
             if (internal::iterRefConverged<real_hi>( colnorms_R, colnorms_X, cte )) {
                 iter = iiter;
                 converged = true;
@@ -243,8 +270,6 @@ int64_t posv_mixed_gmres(
             // GMRES
 
             // Compute initial vector
-            auto v0 = V.slice( 0, V.m()-1, 0, 0 );
-            slate::copy( R, v0, opts );
 
             std::vector<real_hi> arnoldi_residual = { norm( Norm::Fro, v0, opts ) };
             if (arnoldi_residual[0] == 0) {
@@ -253,6 +278,8 @@ int64_t posv_mixed_gmres(
                 converged = false;
                 break;
             }
+            if (residual_0 < 0)
+                residual_0 = arnoldi_residual[0];
             scale( 1.0, arnoldi_residual[0], v0, opts );
             if (S.tileRank( 0, 0 ) == mpi_rank) {
                 S.tileGetForWriting( 0, 0, LayoutConvert::ColMajor );
@@ -280,7 +307,8 @@ int64_t posv_mixed_gmres(
                 slate::copy( Vj, X_lo, opts );
                 t_potrs_lo.start();
                 potrs( A_lo, X_lo, opts );
-                timers[ "posv_mixed_gmres::potrs_lo" ] += t_potrs_lo.stop();
+                internal::timers_add( opts, "posv_mixed_gmres::potrs_lo",
+                                      t_potrs_lo.stop() );
                 slate::copy( X_lo, Wj1, opts );
 
                 t_hemm_hi.start();
@@ -290,7 +318,8 @@ int64_t posv_mixed_gmres(
                           Wj1,
                     zero, Vj1,
                     opts );
-                timers[ "posv_mixed_gmres::hemm_hi" ] += t_hemm_hi.stop();
+                internal::timers_add( opts, "posv_mixed_gmres::hemm_hi",
+                                      t_hemm_hi.stop() );
 
                 // orthogonalize w/ CGS2
                 auto V0j = V.slice( 0, V.m()-1, 0, j );
@@ -307,7 +336,8 @@ int64_t posv_mixed_gmres(
                           Hj,
                     one,  Vj1,
                     opts );
-                timers[ "posv_mixed_gmres::gemm_hi" ] = t_gemm_hi.stop();
+                internal::timers_set( opts, "posv_mixed_gmres::gemm_hi",
+                                      t_gemm_hi.stop() );
                 auto zj = z.slice( 0, j, 0, 0 );
                 t_gemm_hi.start();
                 gemm<scalar_hi>(
@@ -320,10 +350,12 @@ int64_t posv_mixed_gmres(
                           zj,
                     one,  Vj1,
                     opts );
-                timers[ "posv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+                internal::timers_add( opts, "posv_mixed_gmres::gemm_hi",
+                                      t_gemm_hi.stop() );
                 Timer t_add_hi;
                 add( one, zj, one, Hj, opts );
-                timers[ "posv_mixed_gmres::add_hi" ] += t_add_hi.stop();
+                internal::timers_add( opts, "posv_mixed_gmres::add_hi",
+                                      t_add_hi.stop() );
                 auto Vj1_norm = norm( Norm::Fro, Vj1, opts );
                 scale( 1.0, Vj1_norm, Vj1, opts );
                 if (H.tileRank( 0, 0 ) == mpi_rank) {
@@ -349,10 +381,22 @@ int64_t posv_mixed_gmres(
                                givens_alpha[j], givens_beta[j] );
                     arnoldi_residual[0] = cabs1( S_00.at( j+1, 0 ) );
                 }
-                timers[ "posv_mixed_gmres::rotations" ] = t_posv_mixed_gmres_rotations.stop();
+                internal::timers_set( opts, "posv_mixed_gmres::rotations",
+                                      t_posv_mixed_gmres_rotations.stop() );
                 MPI_Bcast( arnoldi_residual.data(), arnoldi_residual.size(),
-                           mpi_type<scalar_hi>::value, S.tileRank( 0, 0 ),
+                           mpi_type<real_hi>::value, S.tileRank( 0, 0 ),
                            A.mpiComm() );
+
+                // Escalate to the fallback solver as soon as the rate so far
+                // predicts failure; all ranks have the same residuals.
+                if (use_fallback
+                    && internal::iterRefPredictFailure<real_hi>(
+                           residual_0, arnoldi_residual[0],
+                           cte * colnorms_X[0], iiter+1, itermax )) {
+                    stalled = true;
+                    ++j;
+                    break;
+                }
             }
             // update X
             auto H_j = H.slice( 0, j-1, 0, j-1 );
@@ -361,7 +405,8 @@ int64_t posv_mixed_gmres(
                     Uplo::Upper, Diag::NonUnit, H_j );
             Timer t_trsm_hi;
             trsm( Side::Left, one, H_tri, S_j, opts );
-            timers[ "posv_mixed_gmres::trsm_hi" ] = t_trsm_hi.stop();
+            internal::timers_set( opts, "posv_mixed_gmres::trsm_hi",
+                                  t_trsm_hi.stop() );
             auto W_0j = W.slice( 0, W.m()-1, 1, j ); // first column of W is unused
             Timer t_gemm_hi;
             gemm<scalar_hi>(
@@ -369,7 +414,8 @@ int64_t posv_mixed_gmres(
                      S_j,
                 one, X,
                 opts );
-            timers[ "posv_mixed_gmres::gemm_hi" ] += t_gemm_hi.stop();
+            internal::timers_add( opts, "posv_mixed_gmres::gemm_hi",
+                                  t_gemm_hi.stop() );
         }
     }
 
@@ -385,7 +431,8 @@ int64_t posv_mixed_gmres(
             // Compute the Cholesky factorization of A.
             Timer t_potrf_hi;
             info = potrf( A, opts );
-            timers[ "posv_mixed_gmres::potrf_hi" ] = t_potrf_hi.stop();
+            internal::timers_set( opts, "posv_mixed_gmres::potrf_hi",
+                                  t_potrf_hi.stop() );
 
             // Solve the system A * X = B.
             Timer t_potrs_hi;
@@ -393,7 +440,8 @@ int64_t posv_mixed_gmres(
                 slate::copy( B, X, opts );
                 potrs( A, X, opts );
             }
-            timers[ "posv_mixed_gmres::potrs_hi" ] = t_potrs_hi.stop();
+            internal::timers_set( opts, "posv_mixed_gmres::potrs_hi",
+                                  t_potrs_hi.stop() );
         }
     }
 
@@ -403,7 +451,7 @@ int64_t posv_mixed_gmres(
         B.clearWorkspace();
         X.clearWorkspace();
     }
-    timers[ "posv_mixed_gmres" ] = t_posv_mixed_gmres.stop();
+    internal::timers_set( opts, "posv_mixed_gmres", t_posv_mixed_gmres.stop() );
 
     return info;
 }
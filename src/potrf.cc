@@ -9,6 +9,10 @@
 #include "slate/HermitianMatrix.hh"
 #include "slate/TriangularMatrix.hh"
 #include "internal/internal.hh"
+#include "internal/internal_lookahead.hh"
+#include "internal/internal_priority.hh"
+#include "slate/internal/TaskGraph.hh"
+#include "slate/internal/TaskRuntime.hh"
 
 namespace slate {
 
@@ -17,106 +21,255 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel Cholesky factorization.
 /// Generic implementation for any target.
+/// If Anorm isn't null, also computes the one norm (= inf norm) of the
+/// original A, from sums of |A| taken by tasks that read each block
+/// column just before the first step modifies it, so A isn't read in a
+/// separate pass. The sums are reduced once, at the end.
 /// @ingroup posv_impl
 ///
 template <Target target, typename scalar_t>
 int64_t potrf(
     slate::internal::TargetType<target>,
     HermitianMatrix<scalar_t> A,
+    blas::real_type<scalar_t>* Anorm,
     Options const& opts )
 {
     using real_t = blas::real_type<scalar_t>;
     using BcastListTag = typename Matrix<scalar_t>::BcastListTag;
 
+    // Norms of tiles on devices use device kernels, otherwise host tasks.
+    const Target norm_target = target == Target::Devices
+                             ? Target::Devices : Target::HostTask;
+
     // Constants
     const scalar_t one = 1.0;
-    const int priority_0 = 0;
     const int queue_0 = 0;
     const int queue_1 = 1;
     const int queue_2 = 2;
+    // Largest tile the fused device potrf_trtri kernel handles.
+    const int64_t max_nb_invert_diag = 512;
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
     // Options
     int64_t lookahead = get_option<Option::Lookahead>( opts, 1 );
+    int64_t max_lookahead = get_option<Option::MaxLookahead>( opts, lookahead );
     bool hold_local_workspace = get_option<Option::HoldLocalWorkspace>( opts, false );
+    Workspace* workspace = get_option<Option::Workspace>( opts, nullptr );
+    bool invert_diag = target == Target::Devices
+                       && get_option<Option::InvertDiagonal>( opts, false );
+    bool hierarchical = get_option<Option::HierarchicalBcast>( opts, false );
+
+    // Collective; node grouping for Option::HierarchicalBcast.
+    if (hierarchical)
+        internal::commNodes( A.mpiComm() );
+
+    // Inverses of the diagonal Cholesky factors, with the same
+    // structure as A; only tile (k, k) exists while column k is processed.
+    HermitianMatrix<scalar_t> Dinv;
+    if (invert_diag) {
+        Dinv = A.template emptyLike<scalar_t>();
+    }
 
     // if upper, change to lower
     if (A.uplo() == Uplo::Upper) {
         A = conj_transpose( A );
+        if (invert_diag)
+            Dinv = conj_transpose( Dinv );
     }
 
     int64_t info = 0;
     int64_t A_nt = A.nt();
 
+    // Collective; lookahead depth per step.
+    internal::Lookahead depths( lookahead, max_lookahead, A.mpiComm() );
+
     // OpenMP needs pointer types, but vectors are exception safe
     std::vector< uint8_t > column_vector(A_nt);
     uint8_t* column = column_vector.data();
-    SLATE_UNUSED( column ); // Used only by OpenMP
-
-    // Allocate batch arrays = number of kernels without lookahead + lookahead
-    // number of kernels without lookahead = 3
-    // (internal::potrf, internal::gemm, and internal::trsm)
-    // whereas internal::herk will be executed as many as lookaheads, thus
-    // internal::herk needs batch arrays equal to the number of lookaheads
-    // and the batch_arrays_index starts from
-    // the number of kernels without lookahead, and then incremented by 1
-    // for every execution for the internal::herk
+    // Placeholder dependency for lookahead columns without an extra one.
+    uint8_t no_column;
+
+    // Stream final panels back to host while the factorization continues.
+    bool stream_origin = target == Target::Devices && async_origin();
+    // Placeholder dependency for the release of the first column.
+    uint8_t no_prev_column;
+
+    // Local sums of |A| by column, which for Hermitian A are also by row.
+    std::vector<real_t> norm_sums;
+    if (Anorm != nullptr)
+        norm_sums.assign( A.n(), 0.0 );
+
+    // Allocate batch arrays for the kernels without lookahead
+    // (internal::gemm on queue 0, internal::trsm on queue 1,
+    // internal::potrf on queue 2); one more queue, the last, is for the
+    // diagonal herks of the trailing update, which internal::herk overlaps
+    // with its off-diagonal gemms. Lookahead tasks lease queues and batch
+    // arrays from the pool (AnyQueue), so any ready lookahead task gets its
+    // own queue, regardless of the lookahead depth.
     const int64_t batch_size_default = 0;
-    int num_queues = 3 + lookahead;  // Number of kernels with lookahead
+    const int num_queues = 4;
     using lapack::device_info_int;
     std::vector< device_info_int* > device_info_array( A.num_devices(), nullptr );
 
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays( batch_size_default, num_queues );
         A.reserveDeviceWorkspace();
 
-        // Allocate
+        // Allocate, or reuse from workspace arena
         for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
-            blas::Queue* queue = A.comm_queue(dev);
-            device_info_array[dev] = blas::device_malloc<device_info_int>( 1, *queue );
+            if (workspace != nullptr) {
+                device_info_array[dev] = (device_info_int*)
+                    workspace->deviceBuffer( dev, sizeof(device_info_int) );
+            }
+            else {
+                blas::Queue* queue = A.comm_queue(dev);
+                device_info_array[dev] = blas::device_malloc<device_info_int>( 1, *queue );
+            }
         }
     }
 
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
+    trace::TaskGraph::region( "potrf" );
+
     #pragma omp parallel
     #pragma omp master
     {
+        internal::TaskRuntime rt;
         int64_t kk = 0;  // column index (not block-column)
         for (int64_t k = 0; k < A_nt; ++k) {
-            // Panel, normal priority
-            #pragma omp task depend(inout:column[k]) priority( priority_0 ) \
-                shared( info )
+            int64_t lookahead_k = depths.next( k );
+
+            // Priorities of step k, see internal::task_priority: the
+            // diagonal potrf with the trsm and broadcast of its column,
+            // then the herk and gemm of the lookahead and trailing columns,
+            // over nt steps.
+            int priority_panel = internal::task_priority(
+                internal::TaskKind::Panel, k, A_nt );
+            int priority_lookahead = internal::task_priority(
+                internal::TaskKind::Lookahead, k, A_nt );
+            int priority_trailing = internal::task_priority(
+                internal::TaskKind::Trailing, k, A_nt );
+
+            // Sums of |A| over block columns before step 0 modifies them:
+            // one task per column of the panel and the lookahead, and one
+            // for the trailing matrix, which the trailing update follows
+            // through column[ k+1+lookahead ]. Each off-diagonal tile
+            // A(i, j) adds its column sums to columns j and, as A(j, i),
+            // its row sums to columns i.
+            if (Anorm != nullptr && k == 0) {
+                int64_t kl1 = std::min( 1 + lookahead_k, A_nt );
+                int64_t jj = 0;
+                for (int64_t j = 0; j <= kl1 && j < A_nt; ++j) {
+                    int priority_norm = j == 0 ? priority_panel
+                                               : priority_lookahead;
+                    int64_t task_norm = trace::TaskGraph::task(
+                        "norm", k, j, {}, { &column[ j ] } );
+                    rt.spawn( {}, { &column[ j ] }, priority_norm,
+                              [=, &A, &norm_sums]()
+                    {
+                        trace::TaskBlock task_block( task_norm );
+                        trace::Step trace_step( k );
+
+                        // A(j:nt-1, j:nt-1) for the trailing matrix,
+                        // else A(j, j).
+                        int64_t j2 = j < kl1 ? j : A_nt-1;
+                        std::vector<real_t> sums( A.n() - jj, 0.0 );
+                        auto Ajj = A.sub( j, j2 );
+                        internal::norm<norm_target>(
+                            Norm::One, NormScope::Matrix, std::move( Ajj ),
+                            sums.data(), priority_norm, AnyQueue );
+
+                        // A(j+1:nt-1, j), for columns j and j+1:nt-1.
+                        if (j < kl1 && j+1 < A_nt) {
+                            int64_t nb = A.tileNb( j );
+                            std::vector<real_t> col_sums( nb );
+                            internal::norm<norm_target>(
+                                Norm::One, NormScope::Matrix,
+                                A.sub( j+1, A_nt-1, j, j ),
+                                col_sums.data(), priority_norm, AnyQueue );
+                            internal::norm<norm_target>(
+                                Norm::Inf, NormScope::Matrix,
+                                A.sub( j+1, A_nt-1, j, j ),
+                                &sums[ nb ], priority_norm, AnyQueue );
+                            for (int64_t i = 0; i < nb; ++i)
+                                sums[ i ] += col_sums[ i ];
+                        }
+
+                        #pragma omp critical(slate_norm_sums)
+                        {
+                            for (size_t i = 0; i < sums.size(); ++i)
+                                norm_sums[ jj + i ] += sums[ i ];
+                        }
+                    });
+                    jj += A.tileNb( j );
+                }
+            }
+
+            // Panel, highest priority
+            int64_t task_panel = trace::TaskGraph::task(
+                "panel", k, k, {}, { &column[k] } );
+            rt.spawn( {}, { &column[k] }, priority_panel,
+                      [=, &A, &Dinv, &info, &depths, &device_info_array]()
             {
-                // factor A(k, k)
+                trace::TaskBlock task_block( task_panel );
+                trace::Step trace_step( k );
+                Timer t_panel;
+
+                // factor A(k, k); with invert_diag, also form Dinv(k, k)
+                // in the same launch, if the tile fits the fused kernel.
+                bool invert_k = invert_diag
+                                && A.tileNb( k ) <= max_nb_invert_diag;
                 int64_t iinfo;
-                if (target == Target::Devices) {
+                if (invert_k) {
+                    if (Dinv.tileIsLocal( k, k ))
+                        Dinv.tileInsert( k, k, Dinv.tileDevice( k, k ) );
+                    iinfo = internal::potrf_trtri<Target::Devices>(
+                        A.sub(k, k), Dinv.sub(k, k), priority_panel, queue_2,
+                        device_info_array[ A.tileDevice( k, k ) ] );
+                }
+                else if (target == Target::Devices) {
                     iinfo = internal::potrf<target>(
-                        A.sub(k, k), priority_0, queue_2,
+                        A.sub(k, k), priority_panel, queue_2,
                         device_info_array[ A.tileDevice( k, k ) ] );
                 }
                 else {
                     iinfo = internal::potrf<target>(
-                        A.sub(k, k), priority_0, queue_2 );
+                        A.sub(k, k), priority_panel, queue_2 );
                 }
                 if (iinfo != 0 && info == 0)
                     info = kk + iinfo;
 
                 // send A(k, k) down col A(k+1:nt-1, k)
-                if (k+1 <= A_nt-1)
+                if (k+1 <= A_nt-1) {
                     A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout);
+                    if (invert_k)
+                        Dinv.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout);
+                }
 
                 // A(k+1:nt-1, k) * A(k, k)^{-H}
-                if (k+1 <= A_nt-1) {
+                if (k+1 <= A_nt-1 && invert_k) {
+                    // as trmm with the explicit inverse, Dinv(k, k)^H
+                    auto Dkk = Dinv.sub(k, k);
+                    auto Tkk = TriangularMatrix< scalar_t >(Diag::NonUnit, Dkk);
+                    internal::trmm<Target::Devices>(
+                        Side::Right,
+                        one, conj_transpose( Tkk ),
+                        A.sub(k+1, A_nt-1, k, k),
+                        priority_panel, queue_1 );
+                }
+                else if (k+1 <= A_nt-1) {
                     auto Akk = A.sub(k, k);
                     auto Tkk = TriangularMatrix< scalar_t >(Diag::NonUnit, Akk);
                     internal::trsm<target>(
                         Side::Right,
                         one, conj_transpose( Tkk ),
                         A.sub(k+1, A_nt-1, k, k),
-                        priority_0, layout, queue_1 );
+                        priority_panel, layout, queue_1 );
                 }
 
                 BcastListTag bcast_list_A;
@@ -129,40 +282,59 @@ int64_t potrf(
                 }
 
                 A.template listBcastMT<target>(
-                  bcast_list_A, layout);
-            }
-
-            // update trailing submatrix, normal priority
-            if (k+1+lookahead < A_nt) {
-                #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[k+1+lookahead]) \
-                                 depend(inout:column[A_nt-1])
+                  bcast_list_A, layout, false, 4, hierarchical);
+
+                depths.panel_time( t_panel.stop() );
+            });
+
+            // update trailing submatrix, lower priority
+            if (k+1+lookahead_k < A_nt) {
+                int64_t task_update = trace::TaskGraph::task(
+                    "update", k, k+1+lookahead_k, { &column[k] },
+                    { &column[k+1+lookahead_k], &column[A_nt-1] } );
+                rt.spawn( { &column[k] },
+                          { &column[k+1+lookahead_k], &column[A_nt-1] },
+                          priority_trailing,
+                          [=, &A, &Dinv, &info, &depths, &device_info_array]()
                 {
+                    trace::TaskBlock task_block( task_update );
+                    trace::Step trace_step( k );
+                    Timer t_update;
+
                     // A(kl+1:nt-1, kl+1:nt-1) -=
                     //     A(kl+1:nt-1, k) * A(kl+1:nt-1, k)^H
                     // where kl = k + lookahead
                     internal::herk<target>(
-                        real_t(-1.0), A.sub(k+1+lookahead, A_nt-1, k, k),
-                        real_t( 1.0), A.sub(k+1+lookahead, A_nt-1),
-                        priority_0, queue_0, layout );
-                }
+                        real_t(-1.0), A.sub(k+1+lookahead_k, A_nt-1, k, k),
+                        real_t( 1.0), A.sub(k+1+lookahead_k, A_nt-1),
+                        priority_trailing, queue_0, layout );
+
+                    depths.update_time( t_update.stop() );
+                });
             }
 
-            // update lookahead column(s), normal priority
-            // the batch_arrays_index_la must be initialized to the
-            // lookahead base index (i.e, number of kernels without lookahead),
-            // which is equal to "2" for slate::potrf, and then the variable is
-            // incremented with every lookahead column "j" ( j-k+1 = 2+j-(k+1) )
-            for (int64_t j = k+1; j < k+1+lookahead && j < A_nt; ++j) {
-                #pragma omp task depend(in:column[k]) \
-                                 depend(inout:column[j])
+            // update lookahead column(s), high priority,
+            // each on a queue leased from the pool
+            for (int64_t j = k+1; j < k+1+lookahead_k && j < A_nt; ++j) {
+                // A column joining the lookahead follows the trailing update.
+                uint8_t* trailing = depths.follows_trailing( k, j, A_nt )
+                                  ? &column[ A_nt-1 ] : &no_column;
+
+                int64_t task_lookahead = trace::TaskGraph::task(
+                    "lookahead", k, j, { &column[k], trailing },
+                    { &column[j] } );
+                rt.spawn( { &column[k], trailing }, { &column[j] },
+                          priority_lookahead,
+                          [=, &A, &Dinv, &info, &depths, &device_info_array]()
                 {
+                    trace::TaskBlock task_block( task_lookahead );
+                    trace::Step trace_step( k );
+
                     // A(j, j) -= A(j, k) * A(j, k)^H
-                    int queue_jk2 = j-k+2;
                     internal::herk<target>(
                         real_t(-1.0), A.sub(j, j, k, k),
                         real_t( 1.0), A.sub(j, j),
-                        priority_0, queue_jk2, layout );
+                        priority_lookahead, AnyQueue, layout );
 
                     // A(j+1:nt, j) -= A(j+1:nt-1, k) * A(j, k)^H
                     if (j+1 <= A_nt-1) {
@@ -171,37 +343,240 @@ int64_t potrf(
                             -one, A.sub(j+1, A_nt-1, k, k),
                                   conj_transpose( Ajk ),
                             one,  A.sub(j+1, A_nt-1, j, j),
-                            layout, priority_0, queue_jk2 );
+                            layout, priority_lookahead, AnyQueue );
                     }
-                }
+                });
             }
 
-            #pragma omp task depend(inout:column[k])
+            // When streaming, the release of column k also erases the
+            // device workspace of column k-1, so it follows that release.
+            uint8_t* prev_column = k > 0 ? &column[k-1] : &no_prev_column;
+            int64_t task_release = trace::TaskGraph::task(
+                "release", k, k, {}, { prev_column, &column[k] } );
+            rt.spawn( {}, { prev_column, &column[k] }, 0,
+                      [=, &A, &Dinv, &info, &depths, &device_info_array]()
             {
+                trace::TaskBlock task_block( task_release );
+                trace::Step trace_step( k );
                 auto panel = A.sub( k, A_nt-1, k, k );
 
                 // Erase remote tiles on all devices including host
                 panel.releaseRemoteWorkspace();
 
-                // Update the origin tiles before their
-                // workspace copies on devices are erased.
-                panel.tileUpdateAllOrigin();
+                if (stream_origin) {
+                    // Start copying the final panel to the origin tiles,
+                    // and erase the previous panel's local workspace,
+                    // whose copies have had a step to complete.
+                    panel.tileUpdateAllOriginAsync();
+                    if (k > 0)
+                        A.sub( k-1, A_nt-1, k-1, k-1 ).releaseLocalWorkspace();
+                }
+                else {
+                    // Update the origin tiles before their
+                    // workspace copies on devices are erased.
+                    panel.tileUpdateAllOrigin();
 
-                // Erase local workspace on devices.
-                panel.releaseLocalWorkspace();
-            }
+                    // Erase local workspace on devices.
+                    panel.releaseLocalWorkspace();
+                }
+
+                if (invert_diag)
+                    Dinv.tileErase( k, k, AllDevices );
+            });
             kk += A.tileNb( k );
         }
     }
     A.tileUpdateAllOrigin();
 
+    if (Anorm != nullptr) {
+        std::vector<real_t> global_sums( norm_sums.size() );
+
+        #pragma omp critical(slate_mpi)
+        {
+            trace::Block trace_block("MPI_Allreduce");
+            slate_mpi_call(
+                MPI_Allreduce(norm_sums.data(), global_sums.data(),
+                              norm_sums.size(), mpi_type<real_t>::value,
+                              MPI_SUM, A.mpiComm()));
+        }
+
+        *Anorm = lapack::lange(Norm::Max, 1, global_sums.size(),
+                               global_sums.data(), 1);
+    }
+
     if (hold_local_workspace == false) {
         A.releaseWorkspace();
     }
     if (target == Target::Devices) {
+        if (workspace == nullptr) {
+            for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
+                blas::Queue* queue = A.comm_queue(dev);
+                blas::device_free( device_info_array[dev], *queue );
+            }
+        }
+    }
+
+    internal::reduce_info( &info, A.mpiComm() );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel left-looking Cholesky factorization.
+/// At step k, block column k is updated by all previous block columns,
+/// then factored; the trailing submatrix is not touched until its own step.
+/// The update of A(k+1:nt-1, k) is done where the tiles of L are, with
+/// internal::gemmA, and reduced to the owners of A(:, k).
+/// Generic implementation for any target.
+/// @ingroup posv_impl
+///
+template <Target target, typename scalar_t>
+int64_t potrf_left(
+    slate::internal::TargetType<target>,
+    HermitianMatrix<scalar_t> A,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+    using ReduceList = typename Matrix<scalar_t>::ReduceList;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const int priority_0 = 0;
+    const int queue_0 = 0;
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    bool hold_local_workspace = get_option<Option::HoldLocalWorkspace>( opts, false );
+    Workspace* workspace = get_option<Option::Workspace>( opts, nullptr );
+
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t info = 0;
+    int64_t A_nt = A.nt();
+
+    // All kernels run one after another, on one queue.
+    const int64_t batch_size_default = 0;
+    const int num_queues = 1;
+    using lapack::device_info_int;
+    std::vector< device_info_int* > device_info_array( A.num_devices(), nullptr );
+
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
+    if (target == Target::Devices) {
+        if (A.num_devices() > 1)
+            slate_not_implemented( "left-looking potrf doesn't support multiple GPUs" );
+
+        A.attachWorkspace( workspace );
+        A.allocateBatchArrays( batch_size_default, num_queues );
+        A.reserveDeviceWorkspace();
+
+        // Allocate, or reuse from workspace arena
         for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
-            blas::Queue* queue = A.comm_queue(dev);
-            blas::device_free( device_info_array[dev], *queue );
+            if (workspace != nullptr) {
+                device_info_array[dev] = (device_info_int*)
+                    workspace->deviceBuffer( dev, sizeof(device_info_int) );
+            }
+            else {
+                blas::Queue* queue = A.comm_queue(dev);
+                device_info_array[dev] = blas::device_malloc<device_info_int>( 1, *queue );
+            }
+        }
+    }
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        int64_t kk = 0;  // column index (not block-column)
+        for (int64_t k = 0; k < A_nt; ++k) {
+            if (k > 0) {
+                // send L(k, j) down col L(k:nt-1, j), whose ranks update
+                // A(k+1:nt-1, k), and to the rank of A(k, k)
+                BcastList bcast_list_L;
+                for (int64_t j = 0; j < k; ++j) {
+                    bcast_list_L.push_back({k, j, {A.sub(k, A_nt-1, j, j),
+                                                   A.sub(k, k, k, k)}});
+                }
+                A.template listBcast<target>( bcast_list_L, layout );
+
+                // A(k, k) -= L(k, 0:k-1) * L(k, 0:k-1)^H
+                for (int64_t j = 0; j < k; ++j) {
+                    internal::herk<target>(
+                        real_t(-1.0), A.sub(k, k, j, j),
+                        real_t( 1.0), A.sub(k, k),
+                        priority_0, queue_0, layout );
+                }
+
+                // A(k+1:nt-1, k) -= L(k+1:nt-1, 0:k-1) * L(k, 0:k-1)^H
+                if (k+1 <= A_nt-1) {
+                    auto Lk = A.sub(k, k, 0, k-1);
+                    Lk = conj_transpose( Lk );
+                    internal::gemmA<target>(
+                        -one, A.sub(k+1, A_nt-1, 0, k-1),
+                              Lk.sub(0, k-1, 0, 0),
+                        one,  A.sub(k+1, A_nt-1, k, k),
+                        layout, priority_0, queue_0 );
+
+                    ReduceList reduce_list_A;
+                    for (int64_t i = k+1; i < A_nt; ++i) {
+                        reduce_list_A.push_back({i, k,
+                                                 A.sub(i, i, k, k),
+                                                 {A.sub(i, i, 0, k-1)}
+                                                });
+                    }
+                    A.template listReduce<target>( reduce_list_A, layout );
+                }
+            }
+
+            // factor A(k, k)
+            int64_t iinfo;
+            if (target == Target::Devices) {
+                iinfo = internal::potrf<target>(
+                    A.sub(k, k), priority_0, queue_0,
+                    device_info_array[ A.tileDevice( k, k ) ] );
+            }
+            else {
+                iinfo = internal::potrf<target>(
+                    A.sub(k, k), priority_0, queue_0 );
+            }
+            if (iinfo != 0 && info == 0)
+                info = kk + iinfo;
+
+            // A(k+1:nt-1, k) * A(k, k)^{-H}
+            if (k+1 <= A_nt-1) {
+                A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout);
+
+                auto Akk = A.sub(k, k);
+                auto Tkk = TriangularMatrix< scalar_t >(Diag::NonUnit, Akk);
+                internal::trsm<target>(
+                    Side::Right,
+                    one, conj_transpose( Tkk ),
+                    A.sub(k+1, A_nt-1, k, k),
+                    priority_0, layout, queue_0 );
+            }
+
+            // Erase remote copies of L(k, 0:k)
+            A.sub( k, k, 0, k ).releaseRemoteWorkspace();
+
+            kk += A.tileNb( k );
+        }
+    }
+    A.tileUpdateAllOrigin();
+
+    if (hold_local_workspace == false) {
+        A.releaseWorkspace();
+    }
+    if (target == Target::Devices) {
+        if (workspace == nullptr) {
+            for (int64_t dev = 0; dev < A.num_devices(); ++dev) {
+                blas::Queue* queue = A.comm_queue(dev);
+                blas::device_free( device_info_array[dev], *queue );
+            }
         }
     }
 
@@ -209,6 +584,69 @@ int64_t potrf(
     return info;
 }
 
+//------------------------------------------------------------------------------
+/// Distributed parallel recursive Cholesky factorization.
+/// Splits A into 2-by-2 blocks along tile boundaries,
+/// \[
+///     A = \begin{bmatrix} A_{11} & \\ A_{21} & A_{22} \end{bmatrix},
+/// \]
+/// factors $A_{11}$ recursively, forms $L_{21} = A_{21} L_{11}^{-H}$,
+/// updates $A_{22} -= L_{21} L_{21}^H$, and factors $A_{22}$ recursively.
+/// The trailing submatrix is swept about $\log_2( nt )$ times,
+/// instead of nt times as in the right-looking algorithm.
+/// Small blocks use the right-looking algorithm.
+/// Generic implementation for any target.
+/// @ingroup posv_impl
+///
+template <Target target, typename scalar_t>
+int64_t potrf_recursive(
+    slate::internal::TargetType<target>,
+    HermitianMatrix<scalar_t> A,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1.0;
+    // Largest number of block columns factored by right-looking potrf.
+    const int64_t max_nt_base = 4;
+
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t A_nt = A.nt();
+    if (A_nt <= max_nt_base)
+        return potrf( slate::internal::TargetType<target>(), A, nullptr, opts );
+
+    int64_t nt1 = A_nt / 2;
+    auto A11 = A.sub( 0, nt1-1 );
+    auto A21 = A.sub( nt1, A_nt-1, 0, nt1-1 );
+    auto A22 = A.sub( nt1, A_nt-1 );
+
+    // info is reduced over all ranks, so all ranks return together.
+    int64_t info = potrf_recursive(
+        slate::internal::TargetType<target>(), A11, opts );
+    if (info != 0)
+        return info;
+
+    // A21 = A21 * L11^{-H}
+    auto T11 = TriangularMatrix<scalar_t>( Diag::NonUnit, A11 );
+    auto T11H = conj_transpose( T11 );
+    slate::trsm( Side::Right, one, T11H, A21, opts );
+
+    // A22 -= A21 * A21^H
+    slate::herk( real_t(-1.0), A21, real_t(1.0), A22, opts );
+
+    info = potrf_recursive(
+        slate::internal::TargetType<target>(), A22, opts );
+    if (info != 0)
+        info += A11.n();
+
+    return info;
+}
+
 } // namespace impl
 
 //------------------------------------------------------------------------------
@@ -240,16 +678,47 @@ int64_t potrf(
 ///     If scalar_t is real, $A$ can be a SymmetricMatrix object.
 ///
 /// @param[in] opts
-///     Additional options, as map of name = value pairs. Possible options:
+///     Additional options, as map of name = value pairs.
+///     Lookahead, InnerBlocking, and MaxPanelThreads not given here
+///     default to the tuning file's values, if any; see tuned_options.
+///     Possible options:
 ///     - Option::Lookahead:
 ///       Number of panels to overlap with matrix updates.
 ///       lookahead >= 0. Default 1.
+///     - Option::MaxLookahead:
+///       If > lookahead, the lookahead adapts per panel, up to MaxLookahead,
+///       to the measured panel and trailing update times. Default lookahead.
+///       Used by the right-looking algorithm.
 ///     - Option::Target:
 ///       Implementation to target. Possible values:
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///     - Option::Workspace:
+///       Workspace arena to take device workspace from and return it to,
+///       instead of allocating and freeing it. Default none.
+///     - Option::HierarchicalBcast:
+///       Whether to broadcast panel tiles between nodes first, then within
+///       nodes; with a Workspace that has node-shared memory, each node
+///       receives a tile once; see Workspace::enableNodeShared.
+///       Default false. Used by the right-looking algorithm.
+///     - Option::MethodCholesky:
+///       Select the algorithm. Possible values:
+///       - RightLooking: update the trailing submatrix after each
+///         block column, with lookahead.
+///       - LeftLooking: update each block column by the previous ones
+///         just before factoring it. With Target::Devices, supports one
+///         GPU per rank; with more, falls back to RightLooking.
+///       - Recursive: split into 2-by-2 blocks, using trsm and herk.
+///       - Auto [default]: RightLooking.
+///
+///       Option::InvertDiagonal applies only to RightLooking.
+///     - Option::InvertDiagonal:
+///       With Target::Devices, factor each diagonal tile and invert its
+///       Cholesky factor in one fused kernel, then update the panel with
+///       trmm instead of trsm. Applies to tiles with nb <= 512;
+///       ignored for other targets. Default false.
 ///
 /// @return 0: successful exit
 /// @return i > 0: the leading minor of order $i$ of $A$ is not
@@ -263,19 +732,92 @@ int64_t potrf(
     HermitianMatrix<scalar_t>& A,
     Options const& opts)
 {
+    return potrf( A, Norm::One, nullptr, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky factorization, that also computes a norm
+/// of the original $A$, e.g., for pocondest, without a separate pass over
+/// $A$ before the factorization.
+///
+/// With MethodCholesky::RightLooking, the one norm, which equals the inf
+/// norm, is summed from the tiles of each block column as the
+/// factorization first reads them, and reduced once at the end. Other
+/// norms and methods compute the norm with slate::norm before factoring.
+///
+/// Arguments are as in potrf( A, opts ), plus:
+///
+/// @param[in] in_norm
+///     Norm to compute: Norm::One, Norm::Inf, Norm::Max, or Norm::Fro.
+///
+/// @param[out] Anorm
+///     The norm of the original matrix $A$. If null, no norm is computed.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t potrf(
+    HermitianMatrix<scalar_t>& A,
+    Norm in_norm, blas::real_type<scalar_t>* Anorm,
+    Options const& opts)
+{
+    internal::CommStatsScope comm_stats_scope( "potrf", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "potrf", A.mpiComm(), opts );
+
+    // Defaults for options not given, from the tuning file, if any.
+    Options tuned_opts = tuned_options( "potrf", A.n(), opts );
+
     using internal::TargetType;
 
     Target target = get_option<Option::Target>( opts, Target::HostTask );
+    Method method = get_option<Option::MethodCholesky>(
+        opts, MethodCholesky::Auto );
+
+    if (method == MethodCholesky::Auto)
+        method = MethodCholesky::select_algo( A, tuned_opts );
+
+    if (Anorm != nullptr
+        && (method == MethodCholesky::LeftLooking
+            || method == MethodCholesky::Recursive
+            || (in_norm != Norm::One && in_norm != Norm::Inf))) {
+        // Not fused with the factorization; norm A before it's overwritten.
+        *Anorm = norm( in_norm, A, opts );
+        Anorm = nullptr;
+    }
 
     switch (target) {
         case Target::Host:
         case Target::HostNest:
         case Target::HostBatch:
         case Target::HostTask:
-            return impl::potrf( TargetType<Target::HostTask>(), A, opts );
+            switch (method) {
+                case MethodCholesky::LeftLooking:
+                    return impl::potrf_left(
+                        TargetType<Target::HostTask>(), A, tuned_opts );
+                case MethodCholesky::Recursive:
+                    return impl::potrf_recursive(
+                        TargetType<Target::HostTask>(), A, tuned_opts );
+                default:
+                    return impl::potrf(
+                        TargetType<Target::HostTask>(), A, Anorm, tuned_opts );
+            }
 
         case Target::Devices:
-            return impl::potrf( TargetType<Target::Devices>(), A, opts );
+            // Left-looking runs all kernels on one queue of one device.
+            if (method == MethodCholesky::LeftLooking && A.num_devices() > 1)
+                method = MethodCholesky::RightLooking;
+
+            switch (method) {
+                case MethodCholesky::LeftLooking:
+                    return impl::potrf_left(
+                        TargetType<Target::Devices>(), A, tuned_opts );
+                case MethodCholesky::Recursive:
+                    return impl::potrf_recursive(
+                        TargetType<Target::Devices>(), A, tuned_opts );
+                default:
+                    return impl::potrf(
+                        TargetType<Target::Devices>(), A, Anorm, tuned_opts );
+            }
     }
     return -2;  // shouldn't happen
 }
@@ -302,4 +844,28 @@ int64_t potrf< std::complex<double> >(
     HermitianMatrix< std::complex<double> >& A,
     Options const& opts);
 
+template
+int64_t potrf<float>(
+    HermitianMatrix<float>& A,
+    Norm in_norm, float* Anorm,
+    Options const& opts);
+
+template
+int64_t potrf<double>(
+    HermitianMatrix<double>& A,
+    Norm in_norm, double* Anorm,
+    Options const& opts);
+
+template
+int64_t potrf< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Norm in_norm, float* Anorm,
+    Options const& opts);
+
+template
+int64_t potrf< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Norm in_norm, double* Anorm,
+    Options const& opts);
+
 } // namespace slate
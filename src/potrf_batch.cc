@@ -0,0 +1,174 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/HermitianMatrix.hh"
+#include "slate/Tile_blas.hh"
+#include "internal/internal.hh"
+#include "internal/Tile_lapack.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Creates the tasks of a right-looking tile Cholesky factorization of a
+/// lower matrix whose tiles are all local and on the host. Tasks depend on
+/// column[ 0 : A.nt()-1 ], which are distinct for each matrix of the batch,
+/// so the factorizations of all matrices proceed concurrently.
+/// Called by the master thread.
+/// @ingroup posv_impl
+///
+template <typename scalar_t>
+void potrf_batch_tasks(
+    HermitianMatrix<scalar_t> A, uint8_t* column, int64_t* info )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const scalar_t one = 1.0;
+    const real_t r_one = 1.0;
+
+    int64_t A_nt = A.nt();
+    SLATE_UNUSED( column ); // Used only by OpenMP
+
+    int64_t kk = 0;  // column index (not block-column)
+    for (int64_t k = 0; k < A_nt; ++k) {
+        // panel
+        #pragma omp task depend(inout:column[k]) \
+                         firstprivate( A, k, kk, info )
+        {
+            int64_t iinfo = potrf( A( k, k ) );
+            if (iinfo != 0 && *info == 0)
+                *info = kk + iinfo;
+
+            auto Lkk = A( k, k );
+            for (int64_t i = k+1; i < A_nt; ++i) {
+                tile::trsm( Side::Right, Diag::NonUnit,
+                            one, conj_transpose( Lkk ), A( i, k ) );
+            }
+        }
+
+        // trailing columns; each one starts as soon as its own
+        // previous update is done, giving a wavefront across steps
+        for (int64_t j = k+1; j < A_nt; ++j) {
+            #pragma omp task depend(in:column[k]) \
+                             depend(inout:column[j]) \
+                             firstprivate( A, k, j )
+            {
+                tile::herk( -r_one, A( j, k ), r_one, A( j, j ) );
+                for (int64_t i = j+1; i < A_nt; ++i) {
+                    tile::gemm( -one, A( i, k ), conj_transpose( A( j, k ) ),
+                                one,  A( i, j ) );
+                }
+            }
+        }
+        kk += A.tileNb( k );
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Cholesky factorization of a batch of independent Hermitian positive
+/// definite matrices.
+///
+/// Each matrix is factored as in potrf, but all factorizations are
+/// scheduled in one OpenMP task graph, so the parallel region, option
+/// parsing, and workspace setup are paid once for the batch, and small
+/// matrices run concurrently rather than one after another.
+///
+/// Intended for many small matrices: the tiles of each matrix must all be
+/// local to the calling MPI rank, e.g., a matrix created on a 1-by-1
+/// process grid. The call is not collective; each rank factors its own
+/// batch. Computation is on the host.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A_array
+///     On entry, the n_i-by-n_i Hermitian positive definite matrices $A_i$.
+///     On exit, if info[ i ] = 0, the factors $L_i$ or $U_i$, as in potrf.
+///
+/// @param[out] info
+///     Resized to A_array.size(). For each matrix, 0 on success,
+///     or j > 0 if its leading minor of order j is not positive definite.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Currently unused.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+void potrf_batch(
+    std::vector< HermitianMatrix<scalar_t> >& A_array,
+    std::vector<int64_t>& info,
+    Options const& opts )
+{
+    int64_t batch_count = A_array.size();
+    info.assign( batch_count, 0 );
+
+    // if upper, change to lower
+    std::vector< HermitianMatrix<scalar_t> > L_array;
+    L_array.reserve( batch_count );
+    for (auto& A : A_array) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            for (int64_t i = j; i < A.mt(); ++i) {
+                slate_error_if( ! A.tileIsLocal( i, j ) );
+            }
+        }
+        L_array.push_back( A.uplo() == Uplo::Upper ? conj_transpose( A ) : A );
+        L_array.back().tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    }
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< std::vector<uint8_t> > column_array( batch_count );
+    for (int64_t b = 0; b < batch_count; ++b)
+        column_array[ b ].resize( L_array[ b ].nt() );
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t b = 0; b < batch_count; ++b) {
+            impl::potrf_batch_tasks( L_array[ b ], column_array[ b ].data(),
+                                     &info[ b ] );
+        }
+        #pragma omp taskwait
+    }
+
+    for (auto& A : A_array)
+        A.tileUpdateAllOrigin();
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potrf_batch<float>(
+    std::vector< HermitianMatrix<float> >& A_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrf_batch<double>(
+    std::vector< HermitianMatrix<double> >& A_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrf_batch< std::complex<float> >(
+    std::vector< HermitianMatrix< std::complex<float> > >& A_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+template
+void potrf_batch< std::complex<double> >(
+    std::vector< HermitianMatrix< std::complex<double> > >& A_array,
+    std::vector<int64_t>& info,
+    Options const& opts);
+
+} // namespace slate
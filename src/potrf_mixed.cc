@@ -0,0 +1,384 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/HermitianMatrix.hh"
+#include "slate/TriangularMatrix.hh"
+#include "slate/Tile_blas.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky factorization with per-tile precision.
+/// Right-looking, with a task per block column and step, as in potrf_batch,
+/// so updates of later columns overlap the following panels.
+/// Tiles marked TilePrecision::Single are kept in A_lo from the start, and
+/// updated in scalar_lo with scalar_lo copies of the panel tiles, until
+/// their panel, where they return to A for the factorization of the panel
+/// in scalar_hi. Diagonal tiles and panels are always in scalar_hi.
+/// Host implementation.
+/// @ingroup posv_impl
+///
+template <typename scalar_hi, typename scalar_lo>
+int64_t potrf_mixed(
+    HermitianMatrix<scalar_hi> A,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_hi>;
+    using BcastListTag = typename Matrix<scalar_hi>::BcastListTag;
+
+    // Constants
+    const scalar_hi one = 1.0;
+    const scalar_lo one_lo = 1.0;
+    const int priority_0 = 0;
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+    const LayoutConvert layout_conv = LayoutConvert( layout );
+
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t info = 0;
+    int64_t A_nt = A.nt();
+
+    // The precision map is the same on all ranks.
+    bool any_single = false;
+    for (int64_t j = 0; j < A_nt; ++j) {
+        for (int64_t i = j+1; i < A_nt; ++i) {
+            if (A.tilePrecision( i, j ) == TilePrecision::Single)
+                any_single = true;
+        }
+    }
+
+    // Low precision tiles and copies of panel tiles.
+    auto A_lo = A.template emptyLike<scalar_lo>();
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > column_vector(A_nt);
+    uint8_t* column = column_vector.data();
+    SLATE_UNUSED( column ); // Used only by OpenMP
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        // Convert local tiles in low precision.
+        for (int64_t j = 0; j < A_nt; ++j) {
+            for (int64_t i = j+1; i < A_nt; ++i) {
+                if (A.tileIsLocal( i, j )
+                    && A.tilePrecision( i, j ) == TilePrecision::Single) {
+                    #pragma omp task firstprivate( i, j )
+                    {
+                        A.tileGetForReading( i, j, layout_conv );
+                        A_lo.tileInsert( i, j );
+                        tile::gecopy( A( i, j ), A_lo( i, j ) );
+                    }
+                }
+            }
+        }
+        #pragma omp taskwait
+
+        int64_t kk = 0;  // column index (not block-column)
+        for (int64_t k = 0; k < A_nt; ++k) {
+            // panel
+            #pragma omp task depend(inout:column[k]) shared( info )
+            {
+                // Column k is fully updated; return its low precision
+                // tiles to A.
+                for (int64_t i = k+1; i < A_nt; ++i) {
+                    if (A.tileIsLocal( i, k )
+                        && A.tilePrecision( i, k ) == TilePrecision::Single) {
+                        A.tileGetForWriting( i, k, layout_conv );
+                        tile::gecopy( A_lo( i, k ), A( i, k ) );
+                    }
+                }
+
+                int64_t iinfo = internal::potrf<Target::HostTask>(
+                    A.sub(k, k), priority_0 );
+                if (iinfo != 0 && info == 0)
+                    info = kk + iinfo;
+
+                // A(k+1:nt-1, k) * A(k, k)^{-H}
+                if (k+1 <= A_nt-1) {
+                    // send A(k, k) down col A(k+1:nt-1, k)
+                    A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout);
+
+                    auto Akk = A.sub(k, k);
+                    auto Tkk = TriangularMatrix< scalar_hi >(Diag::NonUnit, Akk);
+                    internal::trsm<Target::HostTask>(
+                        Side::Right,
+                        one, conj_transpose( Tkk ),
+                        A.sub(k+1, A_nt-1, k, k),
+                        priority_0, layout );
+                }
+
+                BcastListTag bcast_list_A;
+                for (int64_t i = k+1; i < A_nt; ++i) {
+                    // send A(i, k) across row A(i, k+1:i) and
+                    //                down col A(i:nt-1, i) with msg tag i
+                    bcast_list_A.push_back({i, k, {A.sub(i, i, k+1, i),
+                                                   A.sub(i, A_nt-1, i, i)},
+                                            i});
+                }
+                A.template listBcastMT<Target::HostTask>(
+                    bcast_list_A, layout);
+
+                // Low precision copies of the panel tiles on this rank.
+                if (any_single) {
+                    #pragma omp taskgroup
+                    for (int64_t i = k+1; i < A_nt; ++i) {
+                        if (A.tileExists( i, k )) {
+                            #pragma omp task firstprivate( i )
+                            {
+                                if (! A_lo.tileExists( i, k ))
+                                    A_lo.tileInsert( i, k );
+                                tile::gecopy( A( i, k ), A_lo( i, k ) );
+                            }
+                        }
+                    }
+                }
+            }
+
+            // trailing columns; each one starts as soon as its own
+            // previous update is done, giving a wavefront across steps
+            for (int64_t j = k+1; j < A_nt; ++j) {
+                #pragma omp task depend(in:column[k]) \
+                                 depend(inout:column[j])
+                {
+                    #pragma omp taskgroup
+                    for (int64_t i = j; i < A_nt; ++i) {
+                        if (A.tileIsLocal( i, j )) {
+                            #pragma omp task firstprivate( i )
+                            {
+                                if (i == j) {
+                                    // A(j, j) -= A(j, k) * A(j, k)^H
+                                    A.tileGetForWriting( j, j, layout_conv );
+                                    tile::herk(
+                                        real_t(-1.0), A( j, k ),
+                                        real_t( 1.0), A( j, j ) );
+                                }
+                                else if (A.tilePrecision( i, j )
+                                         == TilePrecision::Single) {
+                                    // A(i, j) -= A(i, k) * A(j, k)^H, low
+                                    tile::gemm(
+                                        -one_lo, A_lo( i, k ),
+                                                 conj_transpose( A_lo( j, k ) ),
+                                        one_lo,  A_lo( i, j ) );
+                                }
+                                else {
+                                    // A(i, j) -= A(i, k) * A(j, k)^H
+                                    A.tileGetForWriting( i, j, layout_conv );
+                                    tile::gemm(
+                                        -one, A( i, k ),
+                                              conj_transpose( A( j, k ) ),
+                                        one,  A( i, j ) );
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            #pragma omp task depend(inout:column[k])
+            {
+                // Erase remote tiles and low precision copies of the panel.
+                A.sub( k, A_nt-1, k, k ).releaseRemoteWorkspace();
+                for (int64_t i = k+1; i < A_nt; ++i) {
+                    if (A_lo.tileExists( i, k ))
+                        A_lo.tileErase( i, k, AllDevices );
+                }
+            }
+            kk += A.tileNb( k );
+        }
+    }
+    A.tileUpdateAllOrigin();
+    A.releaseWorkspace();
+
+    internal::reduce_info( &info, A.mpiComm() );
+    return info;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Selects the precision of each tile of a Hermitian matrix from its norm,
+/// for potrf_mixed.
+///
+/// An off-diagonal tile $A_{ij}$ is marked TilePrecision::Single if
+/// \[
+///     \norm{A_{ij}}_F \le tol \norm{A}_F / (nt \; u_{single}),
+/// \]
+/// where $u_{single}$ is the unit roundoff of single precision, so that
+/// rounding all such tiles changes $A$ by at most about $tol \norm{A}_F$.
+/// Other tiles, including the diagonal tiles, are TilePrecision::Full.
+/// The precisions are held in the matrix storage, shared by matrices that
+/// share it, and are the same on all ranks.
+///
+/// Collective over the ranks of A.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of double, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     The n-by-n Hermitian matrix $A$. On exit, its tile precisions are set.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Tolerance:
+///       Accuracy target, relative to $\norm{A}_F$.
+///       Default epsilon of scalar_t, which marks only tiles far below
+///       the norm of $A$.
+///
+/// @return number of tiles marked TilePrecision::Single.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t select_tile_precision(
+    HermitianMatrix<scalar_t>& A,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const real_t u_single = std::numeric_limits<float>::epsilon() / 2;
+
+    double tol = get_option<double>( opts, Option::Tolerance, eps );
+
+    // if upper, change to lower; precisions are by global index
+    HermitianMatrix<scalar_t> L = A;
+    if (L.uplo() == Uplo::Upper) {
+        L = conj_transpose( L );
+    }
+    int64_t nt = L.nt();
+
+    real_t Anorm = norm( Norm::Fro, L, opts );
+    real_t threshold = tol * Anorm / (nt * u_single);
+
+    // single[ i*(i-1)/2 + j ] for tile (i, j), i > j; reduced over ranks.
+    std::vector<int> single( nt*(nt-1)/2, 0 );
+
+    #pragma omp parallel for collapse(2) schedule(dynamic, 1)
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < nt; ++i) {
+            if (i > j && L.tileIsLocal( i, j )) {
+                L.tileGetForReading( i, j, LayoutConvert::ColMajor );
+                auto T = L( i, j );
+                // The Frobenius norm doesn't depend on op.
+                int64_t mb = T.op() == Op::NoTrans ? T.mb() : T.nb();
+                int64_t nb = T.op() == Op::NoTrans ? T.nb() : T.mb();
+                real_t Tnorm = lapack::lange(
+                    Norm::Fro, mb, nb, T.data(), T.stride() );
+                if (Tnorm <= threshold)
+                    single[ i*(i-1)/2 + j ] = 1;
+            }
+        }
+    }
+
+    slate_mpi_call(
+        MPI_Allreduce( MPI_IN_PLACE, single.data(), int( single.size() ),
+                       MPI_INT, MPI_MAX, L.mpiComm() ) );
+
+    int64_t count = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        L.tileSetPrecision( j, j, TilePrecision::Full );
+        for (int64_t i = j+1; i < nt; ++i) {
+            if (single[ i*(i-1)/2 + j ]) {
+                L.tileSetPrecision( i, j, TilePrecision::Single );
+                ++count;
+            }
+            else {
+                L.tileSetPrecision( i, j, TilePrecision::Full );
+            }
+        }
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky factorization with per-tile precision.
+///
+/// Performs the Cholesky factorization of a Hermitian positive definite
+/// matrix $A$, as potrf, except that off-diagonal tiles marked
+/// TilePrecision::Single, e.g., by select_tile_precision, are stored and
+/// updated in single precision until their block column is factored.
+/// For data-sparse matrices, whose tiles far from the diagonal are small,
+/// this saves most of the flops of the trailing updates, at an accuracy
+/// set by the selection tolerance.
+///
+/// Each marked tile is kept in a single precision copy while it is
+/// updated; the matrix itself stays in scalar_hi. Computation is on
+/// the host.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_hi
+///     One of double, std::complex<double>.
+///
+/// @tparam scalar_lo
+///     One of float, std::complex<float>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the n-by-n Hermitian positive definite matrix $A$, with
+///     its tile precisions set.
+///     On exit, if return value = 0, the factor $U$ or $L$ from the Cholesky
+///     factorization $A = U^H U$ or $A = L L^H$, with the accuracy of
+///     the tile precisions.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Currently unused.
+///
+/// @return 0: successful exit
+/// @return i > 0: the leading minor of order $i$ of $A$ is not
+///         positive definite, so the factorization could not
+///         be completed.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_hi, typename scalar_lo>
+int64_t potrf_mixed(
+    HermitianMatrix<scalar_hi>& A,
+    Options const& opts )
+{
+    return impl::potrf_mixed<scalar_hi, scalar_lo>( A, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t select_tile_precision<double>(
+    HermitianMatrix<double>& A,
+    Options const& opts);
+
+template
+int64_t select_tile_precision< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Options const& opts);
+
+template <>
+int64_t potrf_mixed<double>(
+    HermitianMatrix<double>& A,
+    Options const& opts)
+{
+    return potrf_mixed<double, float>( A, opts );
+}
+
+template <>
+int64_t potrf_mixed< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Options const& opts)
+{
+    return potrf_mixed< std::complex<double>, std::complex<float> >( A, opts );
+}
+
+} // namespace slate
@@ -0,0 +1,280 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <set>
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky update or downdate.
+/// Generic implementation; see potrf_update() and potrf_downdate().
+///
+/// At step j, block row V(j, :) of the update eliminates itself against
+/// the diagonal tile L(j, j) by rotations, which are then sent down the
+/// block column, as potrf sends L(j, j), and applied to L(j+1:nt-1, j) and
+/// V(j+1:nt-1, :). Each block row V(i, :) travels along its process row
+/// with the tiles L(i, j) it meets, so only O(n k) data moves per step.
+/// @ingroup posv_impl
+///
+template <typename scalar_t>
+int64_t potrf_update(
+    blas::real_type<scalar_t> sign,
+    HermitianMatrix<scalar_t> A,
+    Matrix<scalar_t>& V,
+    Options const& opts )
+{
+    // Constants
+    const int priority_0 = 0;
+    const int tag_0 = 0;
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    // if upper, change to lower
+    if (A.uplo() == Uplo::Upper) {
+        A = conj_transpose( A );
+    }
+
+    int64_t A_nt = A.nt();
+    int64_t V_nt = V.nt();
+    slate_assert( V.op() != Op::Trans );
+    slate_assert( V.m() == A.n() );
+    slate_assert( V.mt() == A_nt );
+    for (int64_t i = 0; i < A_nt; ++i)
+        slate_assert( V.tileMb( i ) == A.tileNb( i ) );
+
+    int mpi_rank = A.mpiRank();
+
+    // Rotations are computed on the host.
+    A.tileGetAllForWriting( HostNum, LayoutConvert( layout ) );
+    V.tileGetAllForWriting( HostNum, LayoutConvert( layout ) );
+
+    // Moves tile V(i, c) from src to dst, erasing the workspace copy left
+    // behind. All ranks loop over tiles in the same order, so the blocking
+    // sends and receives are matched.
+    auto move_tile = [&]( int64_t i, int64_t c, int src, int dst ) {
+        if (src == dst)
+            return;
+        if (mpi_rank == src) {
+            V.tileSend( i, c, dst, tag_0 );
+            if (! V.tileIsLocal( i, c ))
+                V.tileErase( i, c );
+        }
+        else if (mpi_rank == dst) {
+            V.tileRecv( i, c, src, layout, tag_0 );
+        }
+    };
+
+    int64_t info = 0;
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        int64_t jj = 0;  // column index (not block-column)
+        for (int64_t j = 0; j < A_nt; ++j) {
+            // Move V(j:nt-1, :) to the ranks of L(j:nt-1, j):
+            // initially from the ranks of V, then along process rows.
+            for (int64_t i = j; i < A_nt; ++i) {
+                int dst = A.tileRank( i, j );
+                for (int64_t c = 0; c < V_nt; ++c) {
+                    int src = (j == 0 ? V.tileRank( i, c )
+                                      : A.tileRank( i, j-1 ));
+                    move_tile( i, c, src, dst );
+                }
+            }
+
+            // Eliminate V(j, :) against L(j, j); V(j, :) becomes the
+            // rotations.
+            int64_t iinfo = internal::potrf_update_diag<Target::HostTask>(
+                sign, A.sub( j, j, j, j ), V.sub( j, j, 0, V_nt-1 ),
+                priority_0 );
+            if (iinfo != 0 && info == 0)
+                info = jj + iinfo;
+
+            if (j+1 <= A_nt-1) {
+                // Send the rotations down the block column.
+                int root = A.tileRank( j, j );
+                std::set<int> ranks;
+                A.sub( j+1, A_nt-1, j, j ).getRanks( &ranks );
+                ranks.erase( root );
+                for (int64_t c = 0; c < V_nt; ++c) {
+                    for (int dst : ranks) {
+                        if (mpi_rank == root)
+                            V.tileSend( j, c, dst, tag_0 );
+                        else if (mpi_rank == dst)
+                            V.tileRecv( j, c, root, layout, tag_0 );
+                    }
+                }
+
+                // Apply the rotations to L(j+1:nt-1, j) and V(j+1:nt-1, :).
+                internal::potrf_update_apply<Target::HostTask>(
+                    sign, V.sub( j, j, 0, V_nt-1 ),
+                    A.sub( j+1, A_nt-1, j, j ),
+                    V.sub( j+1, A_nt-1, 0, V_nt-1 ),
+                    priority_0 );
+            }
+
+            // Erase remote copies of V(j, :).
+            for (int64_t c = 0; c < V_nt; ++c) {
+                if (! V.tileIsLocal( j, c ) && V.tileExists( j, c ))
+                    V.tileErase( j, c );
+            }
+
+            jj += A.tileNb( j );
+        }
+    }
+    A.tileUpdateAllOrigin();
+
+    internal::reduce_info( &info, A.mpiComm() );
+    return info;
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky update,
+/// \[
+///     L L^H + V V^H = \tilde{L} \tilde{L}^H,
+/// \]
+/// of an existing Cholesky factor from potrf, by a rank-k term,
+/// without refactoring.
+/// Each column of V is eliminated by one Givens rotation per column of L,
+/// so the update costs $O(n^2 k)$ flops, instead of $O(n^3)$ for potrf.
+/// Rotations are computed on the host; they are sent down each block
+/// column, as potrf sends its diagonal tiles.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the Cholesky factor $L$ (or $U = L^H$, if A is upper)
+///     of the n-by-n Hermitian positive definite matrix $A$, from potrf.
+///     On exit, the factor of $A + V V^H$.
+///
+/// @param[in,out] V
+///     The n-by-k matrix $V$, distributed with the same row tile sizes as A.
+///     V may be conj-transposed, but not transposed.
+///     On exit, V is destroyed.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. None are used.
+///
+/// @return 0: successful exit; an update of a factor from potrf always
+///         succeeds.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t potrf_update(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+    return impl::potrf_update( real_t( 1 ), A, V, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel Cholesky downdate,
+/// \[
+///     L L^H - V V^H = \tilde{L} \tilde{L}^H,
+/// \]
+/// of an existing Cholesky factor from potrf, by a rank-k term,
+/// without refactoring.
+/// Each column of V is eliminated by one hyperbolic rotation per column
+/// of L, so the downdate costs $O(n^2 k)$ flops.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the Cholesky factor $L$ (or $U = L^H$, if A is upper)
+///     of the n-by-n Hermitian positive definite matrix $A$, from potrf.
+///     On exit, the factor of $A - V V^H$.
+///
+/// @param[in,out] V
+///     The n-by-k matrix $V$, distributed with the same row tile sizes as A.
+///     V may be conj-transposed, but not transposed.
+///     On exit, V is destroyed.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. None are used.
+///
+/// @return 0: successful exit.
+/// @return i > 0: $A - V V^H$ is not positive definite, found at
+///         column i (1-based index); the factor is not valid.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+int64_t potrf_downdate(
+    HermitianMatrix<scalar_t>& A,
+    Matrix<scalar_t>& V,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+    return impl::potrf_update( real_t( -1 ), A, V, opts );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+int64_t potrf_update<float>(
+    HermitianMatrix<float>& A,
+    Matrix<float>& V,
+    Options const& opts);
+
+template
+int64_t potrf_update<double>(
+    HermitianMatrix<double>& A,
+    Matrix<double>& V,
+    Options const& opts);
+
+template
+int64_t potrf_update< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& V,
+    Options const& opts);
+
+template
+int64_t potrf_update< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& V,
+    Options const& opts);
+
+template
+int64_t potrf_downdate<float>(
+    HermitianMatrix<float>& A,
+    Matrix<float>& V,
+    Options const& opts);
+
+template
+int64_t potrf_downdate<double>(
+    HermitianMatrix<double>& A,
+    Matrix<double>& V,
+    Options const& opts);
+
+template
+int64_t potrf_downdate< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& V,
+    Options const& opts);
+
+template
+int64_t potrf_downdate< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& V,
+    Options const& opts);
+
+} // namespace slate
@@ -0,0 +1,146 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "slate/HermitianMatrix.hh"
+#include "slate/TriangularMatrix.hh"
+#include "internal/internal.hh"
+
+namespace slate {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel diagonal of the inverse of a Hermitian positive
+/// definite matrix, from its Cholesky factor, without forming the inverse.
+///
+/// For $A = L L^H$, $A^{-1} = L^{-H} L^{-1}$, so $(A^{-1})_{ii}$ is the
+/// squared 2-norm of column i of $L^{-1}$. Block column j of $L^{-1}$ is
+/// zero above block row j, so it is computed by a triangular solve with
+/// the trailing factor $L(j:nt-1, j:nt-1)$ only, and its column norms
+/// summed. Likewise for $A = U^H U$, with rows of $U^{-1}$.
+///
+/// Complexity (in real): $\approx \frac{1}{3} n^{3}$ flops, half of potri.
+/// Workspace is one block column, instead of the whole inverse, and
+/// the factor is not overwritten.
+///
+/// To get an off-diagonal block of $A^{-1}$, solve with potrs for the
+/// corresponding columns of the identity.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The triangular factor $U$ or $L$ from the Cholesky factorization
+///     $A = U^H U$ or $A = L L^H$, as computed by `potrf`.
+///
+/// @param[out] D
+///     Vector of length n. On exit, on all ranks, $D_i = (A^{-1})_{ii}$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Lookahead:
+///       Number of panels to overlap with matrix updates.
+///       lookahead >= 0. Default 1.
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup posv_computational
+///
+template <typename scalar_t>
+void potri_diag(HermitianMatrix<scalar_t>& A,
+                std::vector< blas::real_type<scalar_t> >& D,
+                Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    slate_assert( A.op() == Op::NoTrans );
+
+    int64_t nt = A.nt();
+    bool lower = A.uplo() == Uplo::Lower;
+    auto T = TriangularMatrix<scalar_t>( Diag::NonUnit, A );
+
+    D.assign( A.n(), real_t( 0.0 ) );
+
+    int64_t offset = 0;
+    for (int64_t j = 0; j < nt; ++j) {
+        int64_t nb = A.tileNb( j );
+        auto Tj = T.sub( j, nt-1 );
+
+        // W = E_j, block column (block row if upper) j of the identity,
+        // from the diagonal on; then W = L^{-1} E_j or W = E_j^T U^{-1}.
+        auto W = lower ? A.sub( j, nt-1, j, j ).emptyLike()
+                       : A.sub( j, j, j, nt-1 ).emptyLike();
+        W.insertLocalTiles( target );
+        set( zero, one, W, opts );
+        if (lower) {
+            Options opts_trsm = MethodTrsm::solve_options( Tj, W, opts );
+            trsm( Side::Left, one, Tj, W, opts_trsm );
+        }
+        else {
+            trsm( Side::Right, one, Tj, W, opts );
+        }
+
+        // Sum squares of the columns (rows if upper) of the local tiles.
+        std::vector<real_t> local( nb, 0.0 );
+        for (int64_t i = 0; i < nt - j; ++i) {
+            int64_t ii = lower ? i : 0;
+            int64_t jj = lower ? 0 : i;
+            if (W.tileIsLocal( ii, jj )) {
+                W.tileGetForReading( ii, jj, LayoutConvert::ColMajor );
+                auto Wij = W( ii, jj );
+                for (int64_t c = 0; c < Wij.nb(); ++c) {
+                    for (int64_t r = 0; r < Wij.mb(); ++r) {
+                        real_t w = std::abs( Wij( r, c ) );
+                        local[ lower ? c : r ] += w * w;
+                    }
+                }
+            }
+        }
+        slate_mpi_call(
+            MPI_Allreduce( local.data(), &D[ offset ], nb,
+                           mpi_type<real_t>::value, MPI_SUM, A.mpiComm() ) );
+        offset += nb;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void potri_diag<float>(
+    HermitianMatrix<float>& A,
+    std::vector<float>& D,
+    Options const& opts);
+
+template
+void potri_diag<double>(
+    HermitianMatrix<double>& A,
+    std::vector<double>& D,
+    Options const& opts);
+
+template
+void potri_diag< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A,
+    std::vector<float>& D,
+    Options const& opts);
+
+template
+void potri_diag< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A,
+    std::vector<double>& D,
+    Options const& opts);
+
+} // namespace slate
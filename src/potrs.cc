@@ -49,6 +49,10 @@ namespace slate {
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///     - Option::MethodTrsm:
+///       Algorithm for the triangular solves; see trsm.
+///       Default trsmA if nrhs <= nb, which keeps the factor in place,
+///       else chosen by the cost model.
 ///
 /// @ingroup posv_computational
 ///
@@ -57,6 +61,9 @@ void potrs(HermitianMatrix<scalar_t>& A,
            Matrix<scalar_t>& B,
            Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "potrs", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "potrs", A.mpiComm(), opts );
+
     // Constants
     const scalar_t one  = 1;
 
@@ -72,9 +79,11 @@ void potrs(HermitianMatrix<scalar_t>& A,
     auto L = TriangularMatrix<scalar_t>(Diag::NonUnit, A_);
     auto LT = conj_transpose( L );
 
-    trsm(Side::Left, one, L, B, opts);
+    Options opts_trsm = MethodTrsm::solve_options( A, B, opts );
+
+    trsm(Side::Left, one, L, B, opts_trsm);
 
-    trsm(Side::Left, one, LT, B, opts);
+    trsm(Side::Left, one, LT, B, opts_trsm);
     // todo: return value for errors?
 }
 
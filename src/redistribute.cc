@@ -11,9 +11,187 @@
 
 namespace slate {
 
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Overlap of a block row (or column) of one tiling with one of another:
+/// rows [a_offset, a_offset + size) of block a are the same global rows as
+/// rows [b_offset, b_offset + size) of block b.
+struct Overlap {
+    int64_t a, a_offset;
+    int64_t b, b_offset;
+    int64_t size;
+};
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Merges the block boundaries of two tilings of the same dimension.
+/// Returns the overlaps in increasing order of global index; there are at
+/// most a_nt + b_nt - 1 of them.
+///
+inline std::vector<Overlap> tile_overlaps(
+    int64_t a_nt, std::function<int64_t (int64_t)> const& a_size,
+    int64_t b_nt, std::function<int64_t (int64_t)> const& b_size )
+{
+    std::vector<Overlap> overlaps;
+    int64_t a = 0, a_offset = 0;
+    int64_t b = 0, b_offset = 0;
+    while (true) {
+        // Skip exhausted (and empty) blocks.
+        while (a < a_nt && a_offset == a_size( a )) {
+            ++a;
+            a_offset = 0;
+        }
+        while (b < b_nt && b_offset == b_size( b )) {
+            ++b;
+            b_offset = 0;
+        }
+        if (a == a_nt || b == b_nt)
+            break;
+
+        int64_t size = std::min( a_size( a ) - a_offset,
+                                 b_size( b ) - b_offset );
+        overlaps.push_back( { a, a_offset, b, b_offset, size } );
+        a_offset += size;
+        b_offset += size;
+    }
+    return overlaps;
+}
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Copies A into B, where B has different tile sizes or a different
+/// distribution. Each overlap of a tile of A with a tile of B is sent as
+/// one message, described by a strided MPI datatype (see Tile::isend), so
+/// only the needed sub-blocks are sent and nothing is packed.
+/// Both matrices have op NoTrans.
+///
+template <typename scalar_t>
+void redistribute_retile(
+    Matrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    bool use_devices )
+{
+    const Layout layout = Layout::ColMajor;
+    int tag = 0;
+
+    auto rows = tile_overlaps( A.mt(), A.tileMbFunc(), B.mt(), B.tileMbFunc() );
+    auto cols = tile_overlaps( A.nt(), A.tileNbFunc(), B.nt(), B.tileNbFunc() );
+
+    auto a_device = [&]( int64_t i, int64_t j ) {
+        return use_devices ? A.tileDevice( i, j ) : HostNum;
+    };
+    auto b_device = [&]( int64_t i, int64_t j ) {
+        return use_devices ? B.tileDevice( i, j ) : HostNum;
+    };
+
+    // Every entry of a local tile of B is written below.
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            if (B.tileIsLocal( i, j ))
+                B.tileAcquireForOverwrite( i, j, b_device( i, j ), layout );
+        }
+    }
+
+    std::vector<MPI_Request> requests;
+
+    // Post all receives, then all sends. Messages between each pair of
+    // ranks are posted in the same (col, row) overlap order on both sides,
+    // so they match in order.
+    for (auto& c : cols) {
+        for (auto& r : rows) {
+            if (B.tileIsLocal( r.b, c.b ) && ! A.tileIsLocal( r.a, c.a )) {
+                int device = b_device( r.b, c.b );
+                auto Bij = B( r.b, c.b, device ).slice(
+                    Op::NoTrans, r.b_offset, c.b_offset, r.size, c.size,
+                    Uplo::General );
+                MPI_Request request;
+                Bij.irecv( A.tileRank( r.a, c.a ), A.mpiComm(), layout, tag,
+                           &request );
+                requests.push_back( request );
+            }
+        }
+    }
+
+    for (auto& c : cols) {
+        for (auto& r : rows) {
+            if (A.tileIsLocal( r.a, c.a ) && ! B.tileIsLocal( r.b, c.b )) {
+                int device = a_device( r.a, c.a );
+                A.tileGetForReading( r.a, c.a, device, LayoutConvert( layout ) );
+                auto Aij = A( r.a, c.a, device ).slice(
+                    Op::NoTrans, r.a_offset, c.a_offset, r.size, c.size,
+                    Uplo::General );
+                MPI_Request request;
+                Aij.isend( B.tileRank( r.b, c.b ), B.mpiComm(), tag,
+                           &request );
+                requests.push_back( request );
+            }
+        }
+    }
+
+    // Copy local overlaps while messages are in flight.
+    std::set<int> queues_used;
+    for (auto& c : cols) {
+        for (auto& r : rows) {
+            if (! (A.tileIsLocal( r.a, c.a ) && B.tileIsLocal( r.b, c.b )))
+                continue;
+
+            int src_device = a_device( r.a, c.a );
+            int dst_device = b_device( r.b, c.b );
+            A.tileGetForReading( r.a, c.a, src_device, LayoutConvert( layout ) );
+            auto Aij = A( r.a, c.a, src_device ).slice(
+                Op::NoTrans, r.a_offset, c.a_offset, r.size, c.size,
+                Uplo::General );
+            auto Bij = B( r.b, c.b, dst_device ).slice(
+                Op::NoTrans, r.b_offset, c.b_offset, r.size, c.size,
+                Uplo::General );
+            if (src_device == HostNum && dst_device == HostNum) {
+                tile::gecopy( Aij, Bij );
+            }
+            else {
+                int device = src_device != HostNum ? src_device : dst_device;
+                Aij.copyData( &Bij, *B.comm_queue( device ), true );
+                queues_used.insert( device );
+            }
+        }
+    }
+    for (int device : queues_used)
+        B.comm_queue( device )->sync();
+
+    if (! requests.empty()) {
+        internal::comm_waitall( requests.size(), requests.data() );
+    }
+}
+
+} // namespace impl
+
 //------------------------------------------------------------------------------
 /// Redistribute a matrix A from one distribution into matrix B with another
 /// distribution.
+///
+/// All receives are posted first, then all sends, so ranks don't
+/// serialize on each other. Local tiles are copied while messages are in
+/// flight, and received tiles are transposed, if needed, as they arrive.
+/// Messages between each pair of ranks are posted in the same (j, i)
+/// order on both sides, so they match in order.
+///
+/// With Target::Devices and GPU-aware MPI (see gpu_aware_mpi()), tiles are
+/// sent from and received into device memory, so device-resident matrices
+/// don't round-trip through the host. Redistributing between different
+/// ops (transposing) is always done on the host.
+///
+/// A and B may also have different tile sizes (re-tiling), e.g., to change
+/// nb or the process grid at once. Then each overlap of a tile of A with a
+/// tile of B is sent as a strided sub-block, without packing; this
+/// requires A and B to have the same op.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. If Devices, communicates device tiles
+///       when MPI is GPU-aware. Default HostTask.
+///
 /// @ingroup copy_internal
 ///
 template <typename scalar_t>
@@ -24,104 +202,175 @@ void redistribute(
 {
     trace::Block trace_block("slate::redistribute");
 
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    slate_assert( A.m() == B.m() );
+    slate_assert( A.n() == B.n() );
+
     int64_t mt = B.mt();
     int64_t nt = B.nt();
 
-    bool is_conj = false;
-    if (A.op() != B.op()) {
-        if (A.op() == Op::ConjTrans || B.op() == Op::ConjTrans)
-            is_conj = true;
-
-        auto BT = A.emptyLike();
-        for (int64_t j = 0; j < nt; ++j) {
-            for (int64_t i = 0; i < mt; ++i) {
-                if (B.tileIsLocal(i, j)) {
-                    B.tileGetForWriting( i, j, LayoutConvert::None );
-                    if (! A.tileIsLocal(i, j)) {
-                        auto Bij = B(i, j);
-                        if (Bij.mb() == Bij.nb()) {
-                            Bij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
-                            B.tileGetForWriting( i, j, LayoutConvert::None );
-                            if (is_conj)
-                                tile::deepConjTranspose( std::move(Bij) );
-                            else
-                                tile::deepTranspose( std::move(Bij) );
-                        }
-                        else {
-                            BT.tileInsert(i, j);
-                            auto BTij = BT(i, j);
-                            BT.tileGetForWriting( i, j, LayoutConvert::None );
-                            BTij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
-                            if (is_conj) {
-                                auto AijT = conj_transpose(BTij);
-                                tile::deepConjTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                            else {
-                                auto AijT = transpose(BTij);
-                                tile::deepTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                        }
-                    }
-                    else {
-                        A.tileGetForReading(i, j, LayoutConvert::None);
-                        // copy local tiles if needed.
-                        auto Aij = A(i, j);
-                        auto Bij = B(i, j);
-                        if (Bij.mb() == Bij.nb()) {
-                            if (is_conj)
-                                tile::deepConjTranspose( std::move(Aij), std::move(Bij) );
-                            else
-                                tile::deepTranspose( std::move(Aij), std::move(Bij) );
-                        }
-                        else {
-                            if (is_conj) {
-                                auto AijT = conj_transpose(Aij);
-                                tile::deepConjTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                            else {
-                                auto AijT = transpose(Aij);
-                                tile::deepTranspose( std::move(AijT), std::move(Bij) );
-                            }
-                        }
-                    }
+    bool is_trans = A.op() != B.op();
+    bool is_conj = is_trans
+                   && (A.op() == Op::ConjTrans || B.op() == Op::ConjTrans);
+    bool use_devices = target == Target::Devices && gpu_aware_mpi()
+                       && ! is_trans && B.num_devices() > 0;
+
+    bool same_tiles = A.mt() == mt && A.nt() == nt;
+    for (int64_t i = 0; i < mt && same_tiles; ++i)
+        same_tiles = A.tileMb( i ) == B.tileMb( i );
+    for (int64_t j = 0; j < nt && same_tiles; ++j)
+        same_tiles = A.tileNb( j ) == B.tileNb( j );
+
+    if (! same_tiles) {
+        slate_error_if( is_trans );
+        if (A.op() == Op::NoTrans) {
+            impl::redistribute_retile( A, B, use_devices );
+        }
+        else {
+            // Same op on both, so re-tile the matrices as stored.
+            auto A0 = A.op() == Op::Trans ? transpose( A ) : conj_transpose( A );
+            auto B0 = B.op() == Op::Trans ? transpose( B ) : conj_transpose( B );
+            impl::redistribute_retile( A0, B0, use_devices );
+        }
+        return;
+    }
+
+    int tag = 0;
+    auto BT = A.emptyLike();
+
+    // Out-of-place transposes work on the tiles as stored, ignoring op,
+    // so undo the op of each tile view.
+    auto stored = []( Tile<scalar_t> T ) {
+        if (T.op() == Op::Trans)
+            return transpose( T );
+        else if (T.op() == Op::ConjTrans)
+            return conj_transpose( T );
+        return T;
+    };
+    auto transpose_into = [&]( Tile<scalar_t> src, Tile<scalar_t> dst ) {
+        if (is_conj)
+            tile::deepConjTranspose( stored( src ), stored( dst ) );
+        else
+            tile::deepTranspose( stored( src ), stored( dst ) );
+    };
+
+    // Received tiles, in order of recv_requests.
+    // via_BT: rectangular tile received into BT, to transpose into B.
+    struct RecvTile {
+        int64_t i, j;
+        int device;
+        bool via_BT;
+    };
+    std::vector<RecvTile> recv_tiles;
+    std::vector<MPI_Request> recv_requests;
+    std::vector<MPI_Request> send_requests;
+
+    // Post all receives.
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (B.tileIsLocal( i, j ) && ! A.tileIsLocal( i, j )) {
+                int src = A.tileRank( i, j );
+                int device = use_devices ? B.tileDevice( i, j ) : HostNum;
+                bool via_BT = is_trans && B.tileMb( i ) != B.tileNb( j );
+                MPI_Request request;
+                if (via_BT) {
+                    BT.tileInsert( i, j );
+                    BT.tileGetForWriting( i, j, LayoutConvert::None );
+                    BT( i, j ).irecv( src, A.mpiComm(), A.layout(), tag,
+                                      &request );
                 }
-                else if (A.tileIsLocal(i, j)) {
-                    A.tileGetForReading(i, j, LayoutConvert::None);
-                    auto Aij = A(i, j);
-                    Aij.send(B.tileRank(i, j), B.mpiComm());
+                else {
+                    // Overwritten entirely, so acquire without copying.
+                    B.tileAcquire( i, j, device, A.layout() );
+                    B( i, j, device ).irecv( src, A.mpiComm(), A.layout(), tag,
+                                             &request );
                 }
+                recv_tiles.push_back( { i, j, device, via_BT } );
+                recv_requests.push_back( request );
             }
         }
     }
-    else {
-        for (int64_t j = 0; j < nt; ++j) {
-            for (int64_t i = 0; i < mt; ++i) {
-                if (B.tileIsLocal(i, j)) {
-                    B.tileGetForWriting( i, j, LayoutConvert::None );
-                    if (! A.tileIsLocal(i, j)) {
-                        auto Bij = B(i, j);
-                        Bij.recv(A.tileRank(i, j), A.mpiComm(),  A.layout());
-                    }
-                    else {
-                        A.tileGetForReading(i, j, LayoutConvert::None);
-                        // copy local tiles if needed.
-                        auto Aij = A(i, j);
-                        auto Bij = B(i, j);
-                        if (Aij.data() != Bij.data() ) {
-                            tile::gecopy( Aij, Bij );
-                            // deep conj tile after recieve if its square
-                            // if rectangular, recv in a tmp tile then transpose it
-                        }
-                    }
+
+    // Post all sends.
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (A.tileIsLocal( i, j ) && ! B.tileIsLocal( i, j )) {
+                int device = use_devices ? A.tileDevice( i, j ) : HostNum;
+                A.tileGetForReading( i, j, device, LayoutConvert::None );
+                MPI_Request request;
+                A( i, j, device ).isend( B.tileRank( i, j ), B.mpiComm(), tag,
+                                         &request );
+                send_requests.push_back( request );
+            }
+        }
+    }
+
+    // Copy local tiles while messages are in flight.
+    for (int64_t j = 0; j < nt; ++j) {
+        for (int64_t i = 0; i < mt; ++i) {
+            if (! (A.tileIsLocal( i, j ) && B.tileIsLocal( i, j )))
+                continue;
+
+            if (is_trans) {
+                A.tileGetForReading( i, j, LayoutConvert::None );
+                B.tileGetForWriting( i, j, LayoutConvert::None );
+                transpose_into( A( i, j ), B( i, j ) );
+            }
+            else if (use_devices && A.tileDevice( i, j ) == B.tileDevice( i, j )) {
+                int device = B.tileDevice( i, j );
+                A.tileGetForReading( i, j, device, LayoutConvert::None );
+                auto Aij = A( i, j, device );
+                bool is_same = B.tileExists( i, j, device )
+                               && B( i, j, device ).data() == Aij.data();
+                if (! is_same) {
+                    B.tileAcquire( i, j, device, Aij.layout() );
+                    auto Bij = B( i, j, device );
+                    Aij.copyData( &Bij, *B.comm_queue( device ) );
+                    B.tileModified( i, j, device, true );
                 }
-                else if (A.tileIsLocal(i, j)) {
-                    A.tileGetForReading(i, j, LayoutConvert::None);
-                    auto Aij = A(i, j);
-                    Aij.send(B.tileRank(i, j), B.mpiComm());
+            }
+            else {
+                A.tileGetForReading( i, j, LayoutConvert::None );
+                B.tileGetForWriting( i, j, LayoutConvert::None );
+                auto Aij = A( i, j );
+                auto Bij = B( i, j );
+                if (Aij.data() != Bij.data()) {
+                    tile::gecopy( Aij, Bij );
                 }
             }
         }
     }
+
+    // Complete receives in any order, transposing tiles as they arrive.
+    for (size_t k = 0; k < recv_requests.size(); ++k) {
+        int index;
+        internal::comm_waitany( recv_requests.size(), recv_requests.data(),
+                                &index );
+        auto& rt = recv_tiles[ index ];
+        int64_t i = rt.i;
+        int64_t j = rt.j;
+        if (rt.via_BT) {
+            B.tileGetForWriting( i, j, LayoutConvert::None );
+            transpose_into( BT( i, j ), B( i, j ) );
+            BT.tileErase( i, j );
+        }
+        else {
+            B.tileModified( i, j, rt.device, true );
+            if (is_trans) {
+                // Square tile, transpose in place.
+                auto Bij = B( i, j );
+                if (is_conj)
+                    tile::deepConjTranspose( std::move(Bij) );
+                else
+                    tile::deepTranspose( std::move(Bij) );
+            }
+        }
+    }
+
+    if (! send_requests.empty()) {
+        internal::comm_waitall( send_requests.size(), send_requests.data() );
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,220 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// @return the number of eigenvalues less than x of the symmetric
+/// tridiagonal matrix with diagonal D and squared off-diagonal E2,
+/// from the signs of the pivots of the LDL^T factorization of T - x I
+/// (Sturm count). Pivots smaller than pivmin are replaced by -pivmin.
+///
+template <typename real_t>
+int64_t sturm_count(
+    int64_t n, real_t const* D, real_t const* E2, real_t pivmin, real_t x )
+{
+    int64_t count = 0;
+    real_t d = D[ 0 ] - x;
+    if (std::abs( d ) < pivmin)
+        d = -pivmin;
+    if (d < 0)
+        ++count;
+    for (int64_t i = 1; i < n; ++i) {
+        d = (D[ i ] - x) - E2[ i-1 ] / d;
+        if (std::abs( d ) < pivmin)
+            d = -pivmin;
+        if (d < 0)
+            ++count;
+    }
+    return count;
+}
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues of a symmetric tridiagonal matrix by
+/// bisection, using Sturm counts.
+///
+/// Each eigenvalue is found independently, so the selected eigenvalues are
+/// split evenly over the ranks of mpi_comm, and over OpenMP threads within
+/// each rank, then gathered on all ranks. Unlike sterf, which is O(n^2) on
+/// one rank, the cost per rank is O(n m / p) for m eigenvalues on p ranks.
+/// Only the eigenvalues requested are computed.
+///
+//------------------------------------------------------------------------------
+/// @tparam real_t
+///     One of float, double.
+//------------------------------------------------------------------------------
+/// @param[in] range
+///     - Range::All:   all eigenvalues;
+///     - Range::Value: eigenvalues in the half-open interval [vl, vu);
+///     - Range::Index: eigenvalues il to iu.
+///
+/// @param[in] vl
+///     If range = Value, lower bound of the interval. Otherwise not used.
+///
+/// @param[in] vu
+///     If range = Value, upper bound of the interval, vl < vu.
+///     Otherwise not used.
+///
+/// @param[in] il
+///     If range = Index, 0-based index of the smallest eigenvalue returned,
+///     0 <= il <= iu + 1. Otherwise not used.
+///
+/// @param[in] iu
+///     If range = Index, 0-based index of the largest eigenvalue returned,
+///     iu < n. Otherwise not used.
+///
+/// @param[in] D
+///     The diagonal of the tridiagonal matrix, of length n.
+///
+/// @param[in] E
+///     The off-diagonal of the tridiagonal matrix, of length n-1.
+///
+/// @param[out] Lambda
+///     On exit, resized to the number of eigenvalues found, m, and holds
+///     them in ascending order, on all ranks.
+///
+/// @param[in] mpi_comm
+///     Ranks to split the work over. The call is collective over mpi_comm;
+///     all ranks must pass the same D and E.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Currently unused.
+///
+/// @ingroup heev_computational
+///
+template <typename real_t>
+void stebz(
+    lapack::Range range, real_t vl, real_t vu, int64_t il, int64_t iu,
+    std::vector<real_t> const& D,
+    std::vector<real_t> const& E,
+    std::vector<real_t>& Lambda,
+    MPI_Comm mpi_comm,
+    Options const& opts )
+{
+    trace::Block trace_block("slate::stebz");
+
+    using internal::sturm_count;
+
+    const real_t safe_min = std::numeric_limits<real_t>::min();
+    const real_t eps      = std::numeric_limits<real_t>::epsilon();
+
+    int64_t n = D.size();
+    if (n == 0) {
+        Lambda.clear();
+        return;
+    }
+
+    std::vector<real_t> E2( n-1 );
+    real_t max_e2 = 0;
+    for (int64_t i = 0; i < n-1; ++i) {
+        E2[ i ] = E[ i ] * E[ i ];
+        max_e2 = std::max( max_e2, E2[ i ] );
+    }
+    real_t pivmin = safe_min * std::max( real_t( 1 ), max_e2 );
+
+    // Gershgorin interval containing all eigenvalues, widened a little.
+    real_t gl = D[ 0 ], gu = D[ 0 ];
+    for (int64_t i = 0; i < n; ++i) {
+        real_t r = (i > 0   ? std::abs( E[ i-1 ] ) : 0)
+                 + (i < n-1 ? std::abs( E[ i   ] ) : 0);
+        gl = std::min( gl, D[ i ] - r );
+        gu = std::max( gu, D[ i ] + r );
+    }
+    real_t tnorm = std::max( std::abs( gl ), std::abs( gu ) );
+    gl -= 2*eps*tnorm*n + 2*pivmin;
+    gu += 2*eps*tnorm*n + 2*pivmin;
+
+    // Selected eigenvalues are ilo, ..., ihi-1.
+    int64_t ilo, ihi;
+    if (range == lapack::Range::Value) {
+        ilo = sturm_count( n, D.data(), E2.data(), pivmin, vl );
+        ihi = sturm_count( n, D.data(), E2.data(), pivmin, vu );
+    }
+    else if (range == lapack::Range::Index) {
+        slate_assert( 0 <= il && il <= iu + 1 && iu < n );
+        ilo = il;
+        ihi = iu + 1;
+    }
+    else {
+        ilo = 0;
+        ihi = n;
+    }
+    int64_t m = ihi - ilo;
+    Lambda.resize( m );
+
+    int mpi_rank, mpi_size;
+    slate_mpi_call(
+        MPI_Comm_rank( mpi_comm, &mpi_rank ) );
+    slate_mpi_call(
+        MPI_Comm_size( mpi_comm, &mpi_size ) );
+
+    // Contiguous chunk of the selected eigenvalues per rank.
+    std::vector<int> counts( mpi_size ), displs( mpi_size );
+    for (int r = 0; r < mpi_size; ++r) {
+        displs[ r ] = r * m / mpi_size;
+        counts[ r ] = (r + 1) * m / mpi_size - displs[ r ];
+    }
+
+    // Bisect until the interval is tiny, relative to the eigenvalue,
+    // or it can no longer shrink.
+    int64_t max_iters = int64_t( (std::log( tnorm + pivmin )
+                                  - std::log( pivmin )) / std::log( 2.0 ) ) + 2;
+
+    int64_t k_begin = displs[ mpi_rank ];
+    int64_t k_end   = k_begin + counts[ mpi_rank ];
+    #pragma omp parallel for schedule( dynamic, 16 )
+    for (int64_t k = k_begin; k < k_end; ++k) {
+        // Invariant: count( lo ) <= ilo + k < count( hi ).
+        real_t lo = gl, hi = gu;
+        for (int64_t iter = 0; iter < max_iters; ++iter) {
+            real_t tol = 2*eps*std::max( std::abs( lo ), std::abs( hi ) )
+                       + 2*pivmin;
+            if (hi - lo <= tol)
+                break;
+            real_t mid = lo + (hi - lo) / 2;
+            if (sturm_count( n, D.data(), E2.data(), pivmin, mid ) <= ilo + k)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        Lambda[ k ] = lo + (hi - lo) / 2;
+    }
+
+    slate_mpi_call(
+        MPI_Allgatherv( MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                        Lambda.data(), counts.data(), displs.data(),
+                        mpi_type<real_t>::value, mpi_comm ) );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stebz<float>(
+    lapack::Range range, float vl, float vu, int64_t il, int64_t iu,
+    std::vector<float> const& D,
+    std::vector<float> const& E,
+    std::vector<float>& Lambda,
+    MPI_Comm mpi_comm,
+    Options const& opts);
+
+template
+void stebz<double>(
+    lapack::Range range, double vl, double vu, int64_t il, int64_t iu,
+    std::vector<double> const& D,
+    std::vector<double> const& E,
+    std::vector<double>& Lambda,
+    MPI_Comm mpi_comm,
+    Options const& opts);
+
+} // namespace slate
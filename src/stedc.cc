@@ -38,7 +38,8 @@ namespace slate {
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   the eigenvector updates in the merges, which are
+///         gemms, run on GPU devices; the rest runs on the CPU host.
 ///
 /// @ingroup heev_computational
 ///
@@ -67,14 +68,20 @@ void stedc(
     lapack::lascl( MatrixType::General, 0, 0, Anorm, one, n,   1, &D[0], n   );
     lapack::lascl( MatrixType::General, 0, 0, Anorm, one, n-1, 1, &E[0], n-1 );
 
-    // For now, the algorithm is CPU-only.
+    // Except for the gemms in stedc_merge, the algorithm is CPU-only.
     // Move Q to the CPU and reset target.
     // todo: the MOSI API doesn't have a way to do Hold + Modified in one call.
     Q.tileGetAndHoldAll( HostNum, LayoutConvert::ColMajor ); // get for reading
     Q.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    Target target = get_option( opts, Option::Target, Target::HostTask );
     Options opts_local( opts );
     opts_local[ Option::Target ] = Target::HostTask;
 
+    // The eigenvector updates in stedc_merge can run on devices.
+    Options opts_merge( opts_local );
+    if (target == Target::Devices)
+        opts_merge[ Option::Target ] = Target::Devices;
+
     // Allocate workspace matrices W and U needed in stedc_merge.
     auto W = Q.emptyLike();
     W.insertLocalTiles();
@@ -87,19 +94,23 @@ void stedc(
     if (sort) {
         // Computing eigenvectors in W and sorting into Q saves a copy.
         set( zero, one, W, opts_local );
-        stedc_solve( D, E, W, Q, U, opts_local );
+        stedc_solve( D, E, W, Q, U, opts_merge );
         stedc_sort( D, W, Q, opts_local );
     }
     else {
         // Compute eigenvectors directly in Q.
         set( zero, one, Q, opts_local );
-        stedc_solve( D, E, Q, W, U, opts_local );
+        stedc_solve( D, E, Q, W, U, opts_merge );
     }
 
     // Scale eigenvalues back.
     lapack::lascl( MatrixType::General, 0, 0, one, Anorm, n, 1, &D[0], n );
 
     Q.tileUnsetHoldAll( HostNum );
+    if (target == Target::Devices) {
+        // Free device copies of Q made by the merges.
+        Q.releaseWorkspace();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 #include "slate/slate.hh"
 #include "internal/Array2D.hh"
 
+#include <map>
 #include <numeric>
 
 namespace slate {
@@ -169,7 +170,6 @@ void stedc_deflate(
     MPI_Comm comm = Q.mpiComm();
 
     // Constants.
-    const int tag_0 = 0;
     const MPI_Datatype mpi_real_t = mpi_type<real_t>::value;
 
     // Check arguments.
@@ -245,12 +245,17 @@ void stedc_deflate(
     // After deflation:
     //     D( ideflate( 0 : nsecular-1 ) ) are non-deflated, ascending;
     //     D( ideflate( nsecular : n-1 ) ) are deflated, descending.
-    std::vector<real_t> buf_vector( n );  // todo: only need nb?
-    real_t* buf = buf_vector.data();
     std::vector<int64_t> isort( n );        // (Was: indx, as workspace)
     std::vector<int64_t> ideflate( n );     // (Was: indxp)
     std::vector<int64_t> iglobal( n );      // (Was: indxc)
 
+    // Givens rotations from deflation, applied to Q after the search.
+    struct Rotation {
+        int64_t j1, j2;
+        real_t c, s;
+    };
+    std::vector<Rotation> rotations;
+
     // Determine permutation isort so eigenvalues D[ isort ] are ascending.
     // iota fills isort = [ 0, 1, ..., n-1 ]
     std::iota( isort.begin(), isort.end(), 0 );
@@ -336,51 +341,10 @@ void stedc_deflate(
                 }
                 coltype[ js1 ] = 4;
 
-                // Map js[12] col to jj[12] block col & offset.
-                int64_t jj1        = js1 / nb;
-                int64_t jj1_offset = js1 % nb;
-                int64_t jj2        = js2 / nb;
-                int64_t jj2_offset = js2 % nb;
-
-                // Apply Givens rotation on right to columns js1, js2 of Q
-                // Q( :, [js1, js2] ) = Q( :, [js1, js2] ) * G';
-                for (int64_t ii = 0; ii < nt; ++ii) {
-                    int64_t mb = Q.tileMb( ii );
-                    int rank1 = Q.tileRank( ii, jj1 );
-                    int rank2 = Q.tileRank( ii, jj2 );
-                    if (rank1 == mpi_rank && rank2 == mpi_rank) {
-                        // Both tiles are local; apply rot.
-                        auto T1 = Q( ii, jj1 );
-                        auto T2 = Q( ii, jj2 );
-                        real_t* x1 = &T1.at( 0, jj1_offset );
-                        real_t* x2 = &T2.at( 0, jj2_offset );
-                        blas::rot( mb, x1, 1, x2, 1, c, s );
-                    }
-                    else if (rank1 == mpi_rank) {
-                        // js1 is local; send js1, recv js2, apply rot.
-                        // rot is applied redundantly on both rank1 and rank2;
-                        // buf contents are discarded.
-                        auto T1 = Q( ii, jj1 );
-                        real_t* x1 = &T1.at( 0, jj1_offset );
-                        slate_mpi_call(
-                            MPI_Sendrecv(
-                                x1,  mb, mpi_real_t, rank2, tag_0,
-                                buf, mb, mpi_real_t, rank2, tag_0,
-                                comm, MPI_STATUS_IGNORE ));
-                        blas::rot( mb, x1, 1, buf, 1, c, s );
-                    }
-                    else if (rank2 == mpi_rank) {
-                        // js2 is local; recv js1, send js2, apply rot as above.
-                        auto T2 = Q( ii, jj2 );
-                        real_t* x2 = &T2.at( 0, jj2_offset );
-                        slate_mpi_call(
-                            MPI_Sendrecv(
-                                x2,  mb, mpi_real_t, rank1, tag_0,
-                                buf, mb, mpi_real_t, rank1, tag_0,
-                                comm, MPI_STATUS_IGNORE ));
-                        blas::rot( mb, buf, 1, x2, 1, c, s );
-                    }
-                }
+                // Apply Givens rotation on right to columns js1, js2 of Q,
+                // Q( :, [js1, js2] ) = Q( :, [js1, js2] ) * G',
+                // after the search; see below.
+                rotations.push_back( { js1, js2, c, s } );
 
                 // Apply Givens rotation on both sides of D (see offdiag above).
                 // Off-diagonal elements are negligible, per if condition.
@@ -428,6 +392,123 @@ void stedc_deflate(
 
     assert( nsecular == idx_deflate );
 
+    //----------------------------------------
+    // Apply the Givens rotations to columns of Q.
+    // Rotations form chains: js2 of one rotation is js1 of the next, and
+    // chains share no columns. Each chain, in each block row, is applied
+    // by the rank owning its last column. Its remote columns are gathered
+    // there with one all-to-all, rotated in order, and returned with a
+    // second all-to-all, instead of a Sendrecv per rotation per block row.
+    // Chains that are all local need no communication.
+    if (! rotations.empty()) {
+        int mpi_size;
+        slate_mpi_call(
+            MPI_Comm_size( comm, &mpi_size ) );
+
+        // root[ j ] is the last column of the chain containing column j.
+        // std::map gives the same column order on all ranks.
+        std::map<int64_t, int64_t> root;
+        for (auto r = rotations.rbegin(); r != rotations.rend(); ++r) {
+            int64_t root_j2 = root.count( r->j2 ) ? root[ r->j2 ] : r->j2;
+            root[ r->j2 ] = root_j2;
+            root[ r->j1 ] = root_j2;
+        }
+
+        // Count entries sent to and received from each rank.
+        std::vector<int> send_counts( mpi_size ), send_displs( mpi_size );
+        std::vector<int> recv_counts( mpi_size ), recv_displs( mpi_size );
+        for (int64_t ii = 0; ii < nt; ++ii) {
+            int64_t mb = Q.tileMb( ii );
+            for (auto& jr : root) {
+                int owner = Q.tileRank( ii, jr.first  / nb );
+                int home  = Q.tileRank( ii, jr.second / nb );
+                if (owner != home) {
+                    if (owner == mpi_rank)
+                        send_counts[ home ] += mb;
+                    else if (home == mpi_rank)
+                        recv_counts[ owner ] += mb;
+                }
+            }
+        }
+        for (int r = 1; r < mpi_size; ++r) {
+            send_displs[ r ] = send_displs[ r-1 ] + send_counts[ r-1 ];
+            recv_displs[ r ] = recv_displs[ r-1 ] + recv_counts[ r-1 ];
+        }
+        std::vector<real_t> send_buf(
+            send_displs[ mpi_size-1 ] + send_counts[ mpi_size-1 ] );
+        std::vector<real_t> recv_buf(
+            recv_displs[ mpi_size-1 ] + recv_counts[ mpi_size-1 ] );
+
+        // Pack local columns to send, and find where received columns go.
+        // col( ii, j ) is column j of block row ii on its home rank.
+        std::map< std::pair<int64_t, int64_t>, real_t* > col;
+        std::vector<int> send_pos = send_displs;
+        std::vector<int> recv_pos = recv_displs;
+        for (int64_t ii = 0; ii < nt; ++ii) {
+            int64_t mb = Q.tileMb( ii );
+            for (auto& jr : root) {
+                int64_t j = jr.first;
+                int owner = Q.tileRank( ii, j / nb );
+                int home  = Q.tileRank( ii, jr.second / nb );
+                if (owner == mpi_rank) {
+                    auto T = Q( ii, j / nb );
+                    real_t* x = &T.at( 0, j % nb );
+                    if (home == mpi_rank) {
+                        col[ { ii, j } ] = x;
+                    }
+                    else {
+                        blas::copy( mb, x, 1, &send_buf[ send_pos[ home ] ], 1 );
+                        send_pos[ home ] += mb;
+                    }
+                }
+                else if (home == mpi_rank) {
+                    col[ { ii, j } ] = &recv_buf[ recv_pos[ owner ] ];
+                    recv_pos[ owner ] += mb;
+                }
+            }
+        }
+
+        slate_mpi_call(
+            MPI_Alltoallv( send_buf.data(), send_counts.data(),
+                           send_displs.data(), mpi_real_t,
+                           recv_buf.data(), recv_counts.data(),
+                           recv_displs.data(), mpi_real_t, comm ) );
+
+        // Apply rotations, in order, on the home rank of each chain.
+        for (int64_t ii = 0; ii < nt; ++ii) {
+            int64_t mb = Q.tileMb( ii );
+            for (auto& r : rotations) {
+                if (Q.tileRank( ii, root[ r.j2 ] / nb ) == mpi_rank) {
+                    blas::rot( mb, col[ { ii, r.j1 } ], 1,
+                                   col[ { ii, r.j2 } ], 1, r.c, r.s );
+                }
+            }
+        }
+
+        // Return rotated columns to their owners.
+        slate_mpi_call(
+            MPI_Alltoallv( recv_buf.data(), recv_counts.data(),
+                           recv_displs.data(), mpi_real_t,
+                           send_buf.data(), send_counts.data(),
+                           send_displs.data(), mpi_real_t, comm ) );
+
+        send_pos = send_displs;
+        for (int64_t ii = 0; ii < nt; ++ii) {
+            int64_t mb = Q.tileMb( ii );
+            for (auto& jr : root) {
+                int64_t j = jr.first;
+                int owner = Q.tileRank( ii, j / nb );
+                int home  = Q.tileRank( ii, jr.second / nb );
+                if (owner == mpi_rank && home != mpi_rank) {
+                    auto T = Q( ii, j / nb );
+                    real_t* x = &T.at( 0, j % nb );
+                    blas::copy( mb, &send_buf[ send_pos[ home ] ], 1, x, 1 );
+                    send_pos[ home ] += mb;
+                }
+            }
+        }
+    }
+
     //----------------------------------------
     // Locally permute to sort col types:
     //     Qtype_local = [ Q11  Q12  0    Q14 ]
@@ -76,7 +76,8 @@ namespace slate {
 ///       - HostTask:  OpenMP tasks on CPU host [default].
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
-///       - Devices:   batched BLAS on GPU device.
+///       - Devices:   the eigenvector update gemms run on GPU devices;
+///         deflation and the secular equation run on the CPU host.
 ///
 /// @ingroup heev_computational
 ///
@@ -106,6 +107,16 @@ void stedc_merge(
     int64_t nt1 = nt / 2;  // smaller half first.
     assert( n1 == nt1 * nb );
 
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    if (target == Target::Devices) {
+        // Deflation and the secular equation update host tiles directly,
+        // so make the host copies current and invalidate device copies
+        // left by previous merges, so the gemms below fetch fresh data.
+        Q.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+        Qtype.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+        U.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+    }
+
     std::vector<real_t>  Dsecular( n ), z( n ), zsecular( n );
     std::vector<int64_t> itype( n );
 
@@ -190,6 +201,11 @@ void stedc_merge(
             gemm( one, Qt23, U23, zero, Q23, opts );
         }
 
+        if (target == Target::Devices) {
+            // Bring the updated eigenvectors back to the host.
+            Q.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+        }
+
         int r0 = Q.tileRank( 0, 0 );
         int dcol = r0 / nprow;  // todo: assumes col-major grid
 
@@ -85,7 +85,7 @@ void stedc_secular(
     slate_mpi_call(
         MPI_Comm_size( U.mpiComm(), &mpi_size ) );
 
-    int64_t info = 0, iinfo;
+    int64_t info = 0;
 
     // Assumes matrix is 2D block cyclic.
     GridOrder grid_order;
@@ -107,23 +107,47 @@ void stedc_secular(
 
     // ztilde_partial = 1.
     std::vector<real_t> ztilde( nsecular, 1.0 ),
-                        deltaJ( nsecular ),
                         Lambda_local( nsecular );
-    for (int64_t j = begin; j < end; ++j) {
-        iinfo = lapack::laed4( nsecular, j, &D[ 0 ], &z[ 0 ], &deltaJ[ 0 ],
-                               rho, &Lambda_local[ j ] );
-        if (iinfo != 0)
-            info = j;
 
-        // Update local partial product ztilde_partial
-        // ztilde_partial *= deltaJ / (d_i - d_j)
-        for (int64_t i = 0; i < j; ++i) {
-            ztilde[ i ] *= deltaJ[ i ] / (D[ i ] - D[ j ]);
+    // Roots are independent, so are found by OpenMP threads. Each thread
+    // accumulates its own partial product, and these are combined in
+    // thread order, so results don't depend on scheduling.
+    int nthreads = int( blas::max( blas::min( int64_t( omp_get_max_threads() ),
+                                              mycnt ),
+                                   int64_t( 1 ) ) );
+    std::vector<real_t> ztilde_thread( nthreads * nsecular, 1.0 );
+
+    #pragma omp parallel num_threads( nthreads ) reduction( max: info )
+    {
+        real_t* ztilde_t = &ztilde_thread[ omp_get_thread_num() * nsecular ];
+        std::vector<real_t> deltaJ( nsecular );
+
+        #pragma omp for schedule( static )
+        for (int64_t j = begin; j < end; ++j) {
+            int64_t iinfo = lapack::laed4(
+                nsecular, j, &D[ 0 ], &z[ 0 ], &deltaJ[ 0 ],
+                rho, &Lambda_local[ j ] );
+            if (iinfo != 0)
+                info = j;
+
+            // Update thread's partial product ztilde_partial
+            // ztilde_partial *= deltaJ / (d_i - d_j)
+            real_t Dj = D[ j ];
+            #pragma omp simd
+            for (int64_t i = 0; i < j; ++i) {
+                ztilde_t[ i ] *= deltaJ[ i ] / (D[ i ] - Dj);
+            }
+            // for i = j, exclude (d_i - d_j) term in denominator.
+            ztilde_t[ j ] *= deltaJ[ j ];
+            #pragma omp simd
+            for (int64_t i = j+1; i < nsecular; ++i) {
+                ztilde_t[ i ] *= deltaJ[ i ] / (D[ i ] - Dj);
+            }
         }
-        // for i = j, exclude (d_i - d_j) term in denominator.
-        ztilde[ j ] *= deltaJ[ j ];
-        for (int64_t i = j+1; i < nsecular; ++i) {
-            ztilde[ i ] *= deltaJ[ i ] / (D[ i ] - D[ j ]);
+    }
+    for (int t = 0; t < nthreads; ++t) {
+        for (int64_t i = 0; i < nsecular; ++i) {
+            ztilde[ i ] *= ztilde_thread[ t * nsecular + i ];
         }
     }
 
@@ -199,46 +223,54 @@ void stedc_secular(
 
     // Compute u vectors.
     // Each rank in processor column computes redundantly in order to get norm.
+    // Columns are independent, so are computed by OpenMP threads.
     // todo: cache delta_jj terms and compute other deltas from D[i] - Lambda[j],
     // rather than redundantly calling laed4.
-    for (int64_t jj = 0; jj < col_cnt; ++jj) {
-        int64_t j  = icol[ jj ];
-        int64_t jq = itype[ j ];
-        int64_t jq_tile   = jq / nb;
-        int64_t jq_offset = jq % nb;
+    #pragma omp parallel
+    {
+        std::vector<real_t> deltaJ( nsecular );
 
-        assert( 0 <= j  && j  < n );
-        assert( 0 <= jq && jq < n );
-        assert( 0 <= jq_tile   && jq_tile < U.nt() );
-        assert( 0 <= jq_offset && jq_offset < nb );
+        #pragma omp for schedule( dynamic, 1 )
+        for (int64_t jj = 0; jj < col_cnt; ++jj) {
+            int64_t j  = icol[ jj ];
+            int64_t jq = itype[ j ];
+            int64_t jq_tile   = jq / nb;
+            int64_t jq_offset = jq % nb;
 
-        real_t dummy;
-        iinfo = lapack::laed4( nsecular, j, &D[ 0 ], &z[ 0 ], &deltaJ[ 0 ],
-                               rho, &dummy );
+            assert( 0 <= j  && j  < n );
+            assert( 0 <= jq && jq < n );
+            assert( 0 <= jq_tile   && jq_tile < U.nt() );
+            assert( 0 <= jq_offset && jq_offset < nb );
 
-        real_t nrm;
-        if (nsecular <= 2) {
-            nrm = 1.0;
-        }
-        else {
-            for (int64_t i = 0; i < nsecular; ++i) {
-                deltaJ[ i ] = ztilde[ i ] / deltaJ[ i ];
+            real_t dummy;
+            lapack::laed4( nsecular, j, &D[ 0 ], &z[ 0 ], &deltaJ[ 0 ],
+                           rho, &dummy );
+
+            real_t nrm;
+            if (nsecular <= 2) {
+                nrm = 1.0;
             }
-            nrm = blas::nrm2( nsecular, &deltaJ[ 0 ], 1 );
-        }
-        for (int64_t ii = 0; ii < row_cnt; ++ii) {
-            int64_t i  = irow[ ii ];
-            int64_t iq = itype[ i ];
-            int64_t iq_tile   = iq / nb;
-            int64_t iq_offset = iq % nb;
+            else {
+                #pragma omp simd
+                for (int64_t i = 0; i < nsecular; ++i) {
+                    deltaJ[ i ] = ztilde[ i ] / deltaJ[ i ];
+                }
+                nrm = blas::nrm2( nsecular, &deltaJ[ 0 ], 1 );
+            }
+            for (int64_t ii = 0; ii < row_cnt; ++ii) {
+                int64_t i  = irow[ ii ];
+                int64_t iq = itype[ i ];
+                int64_t iq_tile   = iq / nb;
+                int64_t iq_offset = iq % nb;
 
-            assert( 0 <= i  && i  < n );
-            assert( 0 <= iq && iq < n );
-            assert( 0 <= iq_tile   && iq_tile < U.mt() );
-            assert( 0 <= iq_offset && iq_offset < nb );
+                assert( 0 <= i  && i  < n );
+                assert( 0 <= iq && iq < n );
+                assert( 0 <= iq_tile   && iq_tile < U.mt() );
+                assert( 0 <= iq_offset && iq_offset < nb );
 
-            auto Uij = U( iq_tile, jq_tile );
-            Uij.at( iq_offset, jq_offset ) = deltaJ[ i ] / nrm;
+                auto Uij = U( iq_tile, jq_tile );
+                Uij.at( iq_offset, jq_offset ) = deltaJ[ i ] / nrm;
+            }
         }
     }
 }
@@ -0,0 +1,343 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <cmath>
+
+namespace slate {
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// LU factorization with partial pivoting of T - x I, for the symmetric
+/// tridiagonal T, as LAPACK gttrf. Zero pivots are replaced by pert, so
+/// the factorization never fails.
+///
+template <typename real_t>
+class TridiagonalLU {
+public:
+    TridiagonalLU(
+        int64_t n, real_t const* D, real_t const* E, real_t x, real_t pert )
+        : n_( n ), dl_( E, E + n-1 ), d_( n ), du_( E, E + n-1 ),
+          du2_( std::max( n-2, int64_t( 0 ) ) ), swap_( n, false ),
+          pert_( pert )
+    {
+        for (int64_t i = 0; i < n; ++i)
+            d_[ i ] = D[ i ] - x;
+
+        for (int64_t i = 0; i < n-1; ++i) {
+            if (std::abs( d_[ i ] ) >= std::abs( dl_[ i ] )) {
+                // No row interchange.
+                if (d_[ i ] == 0)
+                    d_[ i ] = pert_;
+                real_t fact = dl_[ i ] / d_[ i ];
+                dl_[ i ] = fact;
+                d_[ i+1 ] -= fact * du_[ i ];
+            }
+            else {
+                // Interchange rows i and i+1.
+                real_t fact = d_[ i ] / dl_[ i ];
+                d_[ i ] = dl_[ i ];
+                dl_[ i ] = fact;
+                real_t temp = du_[ i ];
+                du_[ i ] = d_[ i+1 ];
+                d_[ i+1 ] = temp - fact * d_[ i+1 ];
+                if (i < n-2) {
+                    du2_[ i ] = du_[ i+1 ];
+                    du_[ i+1 ] = -fact * du_[ i+1 ];
+                }
+                swap_[ i ] = true;
+            }
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            if (std::abs( d_[ i ] ) < pert_)
+                d_[ i ] = (d_[ i ] < 0 ? -pert_ : pert_);
+        }
+    }
+
+    /// @return last pivot, U(n-1, n-1).
+    real_t last_pivot() const { return d_[ n_-1 ]; }
+
+    /// Solves (T - x I) y = b, overwriting b with y.
+    void solve( real_t* b ) const
+    {
+        for (int64_t i = 0; i < n_-1; ++i) {
+            if (swap_[ i ])
+                std::swap( b[ i ], b[ i+1 ] );
+            b[ i+1 ] -= dl_[ i ] * b[ i ];
+        }
+        b[ n_-1 ] /= d_[ n_-1 ];
+        if (n_ > 1)
+            b[ n_-2 ] = (b[ n_-2 ] - du_[ n_-2 ] * b[ n_-1 ]) / d_[ n_-2 ];
+        for (int64_t i = n_-3; i >= 0; --i) {
+            b[ i ] = (b[ i ] - du_[ i ] * b[ i+1 ] - du2_[ i ] * b[ i+2 ])
+                   / d_[ i ];
+        }
+    }
+
+private:
+    int64_t n_;
+    std::vector<real_t> dl_, d_, du_, du2_;
+    std::vector<bool> swap_;
+    real_t pert_;
+};
+
+//------------------------------------------------------------------------------
+/// Computes eigenvectors for a cluster of close eigenvalues by inverse
+/// iteration, reorthogonalizing each against the previous ones in the
+/// cluster, as LAPACK stein. The random starting vectors are seeded by
+/// the global index of each eigenvalue, so every rank computing a cluster
+/// gets the same vectors.
+///
+/// @param[in] Lambda
+///     The k eigenvalues of the cluster, in ascending order.
+///
+/// @param[in] first
+///     Global index of Lambda[ 0 ], for seeding.
+///
+/// @param[out] Zc
+///     The n-by-k eigenvectors, column-major with leading dimension n.
+///
+template <typename real_t>
+void stein_cluster(
+    int64_t n, real_t const* D, real_t const* E, real_t onenrm,
+    int64_t k, real_t const* Lambda, int64_t first, real_t* Zc )
+{
+    const real_t eps = std::numeric_limits<real_t>::epsilon();
+    const int64_t max_iters = 5;
+    const int64_t extra = 2;
+    const real_t dtpcrt = std::sqrt( real_t( 0.1 ) / n );
+
+    real_t pert = std::max( eps * onenrm, std::numeric_limits<real_t>::min() );
+    real_t xjm = 0;
+    for (int64_t j = 0; j < k; ++j) {
+        real_t* z = &Zc[ j*n ];
+
+        // Separate equal eigenvalues, so the vectors differ.
+        real_t xj = Lambda[ j ];
+        real_t pertol = 10 * std::abs( eps * xj );
+        if (j > 0 && xj - xjm < pertol)
+            xj = xjm + pertol;
+        xjm = xj;
+
+        TridiagonalLU<real_t> lu( n, D, E, xj, pert );
+
+        // Random starting vector, uniform in (-1, 1); a 64-bit LCG
+        // seeded by the global index.
+        uint64_t state = uint64_t( first + j ) * 6364136223846793005ull
+                       + 1442695040888963407ull;
+        for (int64_t i = 0; i < n; ++i) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            z[ i ] = real_t( int64_t( state >> 11 ) - (int64_t( 1 ) << 52) )
+                   / real_t( int64_t( 1 ) << 52 );
+        }
+
+        int64_t nrmchk = 0;
+        for (int64_t iter = 0; iter < max_iters; ++iter) {
+            // Scale so the solution cannot overflow.
+            real_t asum = blas::asum( n, z, 1 );
+            real_t scl = n * onenrm
+                       * std::max( eps, std::abs( lu.last_pivot() ) ) / asum;
+            blas::scal( n, scl, z, 1 );
+
+            lu.solve( z );
+
+            // Reorthogonalize against the previous vectors of the cluster,
+            // twice, since z can be mostly in their span.
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int64_t jj = 0; jj < j; ++jj) {
+                    real_t* zjj = &Zc[ jj*n ];
+                    real_t dot = blas::dot( n, zjj, 1, z, 1 );
+                    blas::axpy( n, -dot, zjj, 1, z, 1 );
+                }
+            }
+
+            // Converged when the solution is large enough, then do a few
+            // extra iterations.
+            real_t nrm = std::abs( z[ blas::iamax( n, z, 1 ) ] );
+            if (nrm >= dtpcrt) {
+                ++nrmchk;
+                if (nrmchk >= extra + 1)
+                    break;
+            }
+        }
+
+        // Normalize, with the largest entry positive.
+        real_t scl = 1 / blas::nrm2( n, z, 1 );
+        if (z[ blas::iamax( n, z, 1 ) ] < 0)
+            scl = -scl;
+        blas::scal( n, scl, z, 1 );
+    }
+}
+
+} // namespace internal
+
+//------------------------------------------------------------------------------
+/// Computes eigenvectors of a symmetric tridiagonal matrix for given
+/// eigenvalues, e.g., from stebz, by inverse iteration, as LAPACK stein.
+///
+/// Eigenvalues closer than 1e-3 ||T||_1 form a cluster, whose vectors are
+/// reorthogonalized against each other. Clusters are independent, so they
+/// run as OpenMP tasks. Each rank computes the vectors of clusters
+/// overlapping its block columns of Z, so no communication is needed;
+/// with a p-by-q grid, each vector is computed by the p ranks of its
+/// process column. Only the vectors for the given eigenvalues are
+/// computed, so a subset of the spectrum costs O(n m) for m vectors,
+/// apart from large clusters.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+///     For complex, the real eigenvectors are stored in complex Z,
+///     ready for the back-transformation.
+//------------------------------------------------------------------------------
+/// @param[in] D
+///     The diagonal of the tridiagonal matrix, of length n.
+///
+/// @param[in] E
+///     The off-diagonal of the tridiagonal matrix, of length n-1.
+///
+/// @param[in] Lambda
+///     The m eigenvalues, in ascending order.
+///
+/// @param[out] Z
+///     The n-by-m matrix of eigenvectors. Column j is the eigenvector
+///     for Lambda[ j ]. Local tiles must exist.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Currently unused.
+///
+/// @ingroup heev_computational
+///
+template <typename scalar_t>
+void stein(
+    std::vector< blas::real_type<scalar_t> > const& D,
+    std::vector< blas::real_type<scalar_t> > const& E,
+    std::vector< blas::real_type<scalar_t> > const& Lambda,
+    Matrix<scalar_t>& Z,
+    Options const& opts )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    trace::Block trace_block("slate::stein");
+
+    int64_t n = D.size();
+    int64_t m = Lambda.size();
+    slate_assert( Z.m() == n );
+    slate_assert( Z.n() == m );
+    if (n == 0 || m == 0)
+        return;
+
+    real_t onenrm = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        real_t r = std::abs( D[ i ] )
+                 + (i > 0   ? std::abs( E[ i-1 ] ) : 0)
+                 + (i < n-1 ? std::abs( E[ i   ] ) : 0);
+        onenrm = std::max( onenrm, r );
+    }
+    real_t ortol = real_t( 1e-3 ) * onenrm;
+
+    // Block column of each column of Z, and whether this rank has tiles
+    // in each block column.
+    std::vector<int64_t> col_tile( m );
+    std::vector<int64_t> col_offset( Z.nt() + 1, 0 );
+    std::vector<bool> local_col( Z.nt(), false );
+    for (int64_t j = 0; j < Z.nt(); ++j) {
+        col_offset[ j+1 ] = col_offset[ j ] + Z.tileNb( j );
+        for (int64_t jj = col_offset[ j ]; jj < col_offset[ j+1 ]; ++jj)
+            col_tile[ jj ] = j;
+        for (int64_t i = 0; i < Z.mt(); ++i) {
+            if (Z.tileIsLocal( i, j )) {
+                local_col[ j ] = true;
+                break;
+            }
+        }
+    }
+
+    Z.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        int64_t begin = 0;
+        while (begin < m) {
+            int64_t end = begin + 1;
+            while (end < m && Lambda[ end ] - Lambda[ end-1 ] <= ortol)
+                ++end;
+
+            bool needed = false;
+            for (int64_t j = col_tile[ begin ]; j <= col_tile[ end-1 ]; ++j)
+                needed = needed || local_col[ j ];
+
+            if (needed) {
+                #pragma omp task firstprivate( begin, end )
+                {
+                    int64_t k = end - begin;
+                    std::vector<real_t> Zc( n*k );
+                    internal::stein_cluster(
+                        n, D.data(), E.data(), onenrm,
+                        k, &Lambda[ begin ], begin, Zc.data() );
+
+                    // Copy into local tiles; clusters own disjoint columns.
+                    for (int64_t jj = begin; jj < end; ++jj) {
+                        int64_t j = col_tile[ jj ];
+                        if (! local_col[ j ])
+                            continue;
+                        int64_t c = jj - col_offset[ j ];
+                        int64_t ii = 0;
+                        for (int64_t i = 0; i < Z.mt(); ++i) {
+                            int64_t mb = Z.tileMb( i );
+                            if (Z.tileIsLocal( i, j )) {
+                                auto T = Z( i, j );
+                                for (int64_t r = 0; r < mb; ++r)
+                                    T.at( r, c ) = Zc[ ii + r + (jj-begin)*n ];
+                            }
+                            ii += mb;
+                        }
+                    }
+                }
+            }
+            begin = end;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void stein<float>(
+    std::vector<float> const& D,
+    std::vector<float> const& E,
+    std::vector<float> const& Lambda,
+    Matrix<float>& Z,
+    Options const& opts);
+
+template
+void stein<double>(
+    std::vector<double> const& D,
+    std::vector<double> const& E,
+    std::vector<double> const& Lambda,
+    Matrix<double>& Z,
+    Options const& opts);
+
+template
+void stein< std::complex<float> >(
+    std::vector<float> const& D,
+    std::vector<float> const& E,
+    std::vector<float> const& Lambda,
+    Matrix< std::complex<float> >& Z,
+    Options const& opts);
+
+template
+void stein< std::complex<double> >(
+    std::vector<double> const& D,
+    std::vector<double> const& E,
+    std::vector<double> const& Lambda,
+    Matrix< std::complex<double> >& Z,
+    Options const& opts);
+
+} // namespace slate
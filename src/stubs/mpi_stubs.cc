@@ -26,9 +26,12 @@ int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm)
 {
     assert(count == 1);
-    assert(op == MPI_MAX);
+    assert(op == MPI_MAX || op == MPI_MIN);
 
     switch (datatype) {
+        case MPI_INT:
+            *(int*)recvbuf = *(int*)sendbuf;
+            break;
         case MPI_FLOAT:
             *(float*)recvbuf = *(float*)sendbuf;
             break;
@@ -47,6 +50,16 @@ int MPI_Allreduce(const void* sendbuf, void* recvbuf, int count,
     return MPI_SUCCESS;
 }
 
+int MPI_Allgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void* recvbuf, int recvcount, MPI_Datatype recvtype,
+                  MPI_Comm comm)
+{
+    assert(sendcount == 1 && sendtype == MPI_INT);
+    assert(recvcount == 1 && recvtype == MPI_INT);
+    *(int*)recvbuf = *(int*)sendbuf;
+    return MPI_SUCCESS;
+}
+
 int MPI_Barrier(MPI_Comm comm)
 {
     return MPI_SUCCESS;
@@ -64,6 +77,39 @@ int MPI_Comm_create_group(MPI_Comm comm, MPI_Group group, int tag,
     return MPI_SUCCESS;
 }
 
+// Without MPI, there is one process, so one attribute per keyval suffices;
+// MPI_Comm_dup returns the same communicator.
+static void* attributes[ 8 ];
+static int num_keyvals = 0;
+
+int MPI_Comm_create_keyval(MPI_Comm_copy_attr_function* copy_fn,
+                           MPI_Comm_delete_attr_function* delete_fn,
+                           int* keyval, void* extra_state)
+{
+    assert(num_keyvals < 8);
+    *keyval = num_keyvals++;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_get_attr(MPI_Comm comm, int keyval, void* attribute, int* flag)
+{
+    *(void**) attribute = attributes[ keyval ];
+    *flag = attributes[ keyval ] != nullptr;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_set_attr(MPI_Comm comm, int keyval, void* attribute)
+{
+    attributes[ keyval ] = attribute;
+    return MPI_SUCCESS;
+}
+
+int MPI_Comm_dup(MPI_Comm comm, MPI_Comm* newcomm)
+{
+    *newcomm = comm;
+    return MPI_SUCCESS;
+}
+
 int MPI_Comm_free(MPI_Comm* comm)
 {
     return MPI_SUCCESS;
@@ -86,6 +132,13 @@ int MPI_Comm_size(MPI_Comm comm, int* size)
     return MPI_SUCCESS;
 }
 
+int MPI_Comm_split_type(MPI_Comm comm, int split_type, int key, MPI_Info info,
+                        MPI_Comm* newcomm)
+{
+    *newcomm = comm;
+    return MPI_SUCCESS;
+}
+
 MPI_Fint MPI_Comm_f2c(MPI_Comm comm)
 {
     assert(0);
@@ -120,12 +173,37 @@ int MPI_Initialized(int* flag)
     return MPI_SUCCESS;
 }
 
+int MPI_Finalized(int* flag)
+{
+    *flag = 0;
+    return MPI_SUCCESS;
+}
+
 int MPI_Init_thread(int* argc, char*** argv, int required, int* provided)
 {
     *provided = MPI_THREAD_MULTIPLE;
     return MPI_SUCCESS;
 }
 
+int MPI_Query_thread(int* provided)
+{
+    *provided = MPI_THREAD_MULTIPLE;
+    return MPI_SUCCESS;
+}
+
+int MPI_Iallreduce(const void* sendbuf, void* recvbuf, int count,
+                   MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                   MPI_Request* request)
+{
+    assert(0);
+}
+
+int MPI_Ibcast(void* buffer, int count, MPI_Datatype datatype, int root,
+               MPI_Comm comm, MPI_Request* request)
+{
+    assert(0);
+}
+
 int MPI_Irecv(void* buf, int count, MPI_Datatype datatype, int source,
               int tag, MPI_Comm comm, MPI_Request* request)
 {
@@ -144,6 +222,12 @@ int MPI_Recv(void* buf, int count, MPI_Datatype datatype, int source,
     assert(0);
 }
 
+int MPI_Recv_init(void* buf, int count, MPI_Datatype datatype, int source,
+                  int tag, MPI_Comm comm, MPI_Request* request)
+{
+    assert(0);
+}
+
 int MPI_Op_create(MPI_User_function* user_fn, int commute, MPI_Op* op)
 {
     assert(0);
@@ -190,6 +274,12 @@ int MPI_Send(const void* buf, int count, MPI_Datatype datatype, int dest,
     assert(0);
 }
 
+int MPI_Send_init(const void* buf, int count, MPI_Datatype datatype,
+                  int dest, int tag, MPI_Comm comm, MPI_Request* request)
+{
+    assert(0);
+}
+
 int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                  int dest, int sendtag, void* recvbuf, int recvcount,
                  MPI_Datatype recvtype, int source, int recvtag,
@@ -198,11 +288,28 @@ int MPI_Sendrecv(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
     assert(0);
 }
 
+int MPI_Start(MPI_Request* request)
+{
+    assert(0);
+}
+
+int MPI_Get_address(const void* location, MPI_Aint* address)
+{
+    assert(0);
+}
+
 int MPI_Type_commit(MPI_Datatype* datatype)
 {
     assert(0);
 }
 
+int MPI_Type_create_struct(int count, const int blocklengths[],
+                           const MPI_Aint displacements[],
+                           const MPI_Datatype types[], MPI_Datatype* newtype)
+{
+    assert(0);
+}
+
 int MPI_Type_free(MPI_Datatype* datatype)
 {
     assert(0);
@@ -214,6 +321,23 @@ int MPI_Type_vector(int count, int blocklength, int stride,
     assert(0);
 }
 
+int MPI_Test(MPI_Request* request, int* flag, MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_Testall(int count, MPI_Request requests[], int* flag,
+                MPI_Status statuses[])
+{
+    assert(0);
+}
+
+int MPI_Testany(int count, MPI_Request requests[], int* index, int* flag,
+                MPI_Status* status)
+{
+    assert(0);
+}
+
 int MPI_Wait(MPI_Request* request, MPI_Status* status)
 {
     assert(0);
@@ -224,6 +348,44 @@ int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[])
     assert(0);
 }
 
+int MPI_Waitany(int count, MPI_Request requests[], int* index,
+                MPI_Status* status)
+{
+    assert(0);
+}
+
+int MPI_Win_allocate_shared(MPI_Aint size, int disp_unit, MPI_Info info,
+                            MPI_Comm comm, void* baseptr, MPI_Win* win)
+{
+    assert(0);
+}
+
+int MPI_Win_free(MPI_Win* win)
+{
+    assert(0);
+}
+
+int MPI_Win_lock_all(int mode, MPI_Win win)
+{
+    assert(0);
+}
+
+int MPI_Win_shared_query(MPI_Win win, int rank, MPI_Aint* size,
+                         int* disp_unit, void* baseptr)
+{
+    assert(0);
+}
+
+int MPI_Win_sync(MPI_Win win)
+{
+    assert(0);
+}
+
+int MPI_Win_unlock_all(MPI_Win win)
+{
+    assert(0);
+}
+
 int MPI_Error_string(int errorcode, char* string, int* resultlen)
 {
     assert(0);
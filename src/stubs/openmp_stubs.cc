@@ -24,6 +24,11 @@ int omp_get_max_threads()
     return 1;
 }
 
+int omp_get_max_task_priority()
+{
+    return 0;
+}
+
 int omp_get_num_devices()
 {
     return 0;
@@ -52,6 +57,11 @@ double omp_get_wtime()
     return sec + usec/1000000.0;
 }
 
+int omp_in_parallel(void)
+{
+    return 0;
+}
+
 void omp_destroy_lock(omp_lock_t* lock)
 {
     return;
@@ -72,6 +82,11 @@ void omp_set_nested(int nested)
     return;
 }
 
+void omp_set_num_threads(int num_threads)
+{
+    return;
+}
+
 void omp_unset_lock(omp_lock_t* lock)
 {
     return;
@@ -54,6 +54,13 @@ namespace slate {
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///     - Option::MethodEig:
+///       Bidiagonal SVD solver, when computing singular vectors.
+///       Possible values:
+///       - DC: divide and conquer, via stedc on the Golub-Kahan tridiagonal
+///         matrix, distributed on A's grid [default]. Falls back to QR
+///         iteration if the singular vectors can't be separated.
+///       - QR: QR iteration, replicated on all ranks.
 ///
 /// @ingroup svd
 ///
@@ -69,6 +76,9 @@ void svd(
     Matrix<scalar_t>& VT,
     Options const& opts)
 {
+    internal::CommStatsScope comm_stats_scope( "svd", A.mpiComm(), opts );
+    internal::MemoryStatsScope memory_stats_scope( "svd", A.mpiComm(), opts );
+
     Timer t_svd;
 
     using real_t = blas::real_type<scalar_t>;
@@ -92,6 +102,7 @@ void svd(
 
     // Options
     Target target = get_option( opts, Option::Target, Target::HostTask );
+    MethodEig method = get_option( opts, Option::MethodEig, MethodEig::DC );
 
     int64_t m = A.m();
     int64_t n = A.n();
@@ -143,12 +154,12 @@ void svd(
     bool lq_path = n > m;
     Matrix<scalar_t> Ahat, Uhat, VThat;
     TriangularFactors<scalar_t> TQ;
-    timers[ "svd::geqrf" ] = 0;
-    timers[ "svd::gelqf" ] = 0;
+    internal::timers_reset( opts, "svd::geqrf" );
+    internal::timers_reset( opts, "svd::gelqf" );
     if (qr_path) {
         Timer t_geqrf;
         geqrf( A, TQ, opts );
-        timers[ "svd::geqrf" ] = t_geqrf.stop();
+        internal::timers_set( opts, "svd::geqrf", t_geqrf.stop() );
 
         // Upper triangular part of A (R).
         auto R_ = A.slice(0, n-1, 0, n-1);
@@ -174,7 +185,7 @@ void svd(
     else if (lq_path) {
         Timer t_gelqf;
         gelqf( A, TQ, opts );
-        timers[ "svd::gelqf" ] = t_gelqf.stop();
+        internal::timers_set( opts, "svd::gelqf", t_gelqf.stop() );
         swap(m, n);
 
         // Lower triangular part of A (R).
@@ -214,9 +225,9 @@ void svd(
     TriangularFactors<scalar_t> TU, TV;
     Timer t_ge2tb;
     ge2tb(Ahat, TU, TV, opts);
-    timers[ "svd::ge2tb" ] = t_ge2tb.stop();
+    internal::timers_set( opts, "svd::ge2tb", t_ge2tb.stop() );
 
-    // Currently, tb2bd and bdsqr run on a single node, gathers band matrix to rank 0.
+    // Currently, tb2bd runs on a single node, gathers band matrix to rank 0.
     TriangularBandMatrix<scalar_t> Aband( Uplo::Upper, Diag::NonUnit,
                                          n, A.tileNb(0), A.tileNb(0),
                                          1, 1, A.mpiComm() );
@@ -233,22 +244,28 @@ void svd(
     int64_t vm = 2*nb;
     int64_t vn = nt*(nt + 1)/2*nb;
 
+    // Without vectors, U2 and VT2 are left empty, so with Target::Devices
+    // the reflectors stay on the device.
     Matrix<scalar_t> U2, VT2;
-    VT2 = Matrix<scalar_t>( vm, vn, vm, nb, 1, 1, A.mpiComm() );
-    U2 = Matrix<scalar_t>( vm, vn, vm, nb, 1, 1, A.mpiComm() );
+    if (wantu || wantvt) {
+        VT2 = Matrix<scalar_t>( vm, vn, vm, nb, 1, 1, A.mpiComm() );
+        U2 = Matrix<scalar_t>( vm, vn, vm, nb, 1, 1, A.mpiComm() );
+    }
 
     // Allocate E for super-diagonal.
     std::vector<real_t> E(n - 1);
 
     // 2. Reduction to bi-diagonal
     if (A.mpiRank() == 0) {
-        VT2.insertLocalTiles();
-        U2.insertLocalTiles();
+        if (wantu || wantvt) {
+            VT2.insertLocalTiles();
+            U2.insertLocalTiles();
+        }
 
         // Reduce band to bi-diagonal.
         Timer t_tb2bd;
         tb2bd( Aband, U2, VT2, opts );
-        timers[ "svd::tb2bd" ] = t_tb2bd.stop();
+        internal::timers_set( opts, "svd::tb2bd", t_tb2bd.stop() );
 
         // Copy diagonal and super-diagonal to vectors.
         internal::copytb2bd(Aband, Sigma, E);
@@ -294,16 +311,56 @@ void svd(
             set( zero, one, V1d, opts );
         }
 
-        // QR iteration
-        //bdsqr<scalar_t>(jobu, jobvt, Sigma, E, Uhat, VThat, opts);
-        // Call the SVD
         Timer t_bdsvd;
-        lapack::bdsqr(Uplo::Upper, min_mn, ncvt, nru, 0,
-                      &Sigma[0], &E[0],
-                      &VT1D_row_cyclic_data[0], ldvt,
-                      &U1D_row_cyclic_data[0], ldu,
-                      dummy, 1);
-        timers[ "svd::bdsvd" ] = t_bdsvd.stop();
+        int64_t info = 1;
+        if (method == MethodEig::DC) {
+            // Divide and conquer, distributed on A's 2D grid, or 1D if
+            // A's distribution isn't 2D block-cyclic by columns.
+            GridOrder grid_order;
+            int p, q, myrow_bd, mycol_bd;
+            A.gridinfo( &grid_order, &p, &q, &myrow_bd, &mycol_bd );
+            if (p <= 0 || grid_order != GridOrder::Col) {
+                p = 1;
+                q = mpi_size;
+            }
+            Matrix<real_t> Ub( min_mn, min_mn, nb, p, q, A.mpiComm() );
+            auto VTb = Ub.emptyLike();
+            Ub.insertLocalTiles();
+            VTb.insertLocalTiles();
+            info = bdsdc( Sigma, E, Ub, VTb, opts );
+
+            // Bidiagonal vectors go into the top-left min_mn-by-min_mn
+            // block; the rest of U1d_row_cyclic and V1d stays zero.
+            auto copy_vectors = [&]( Matrix<real_t>& Xreal,
+                                     Matrix<scalar_t> X ) {
+                if constexpr (! is_complex<scalar_t>::value) {
+                    redistribute( Xreal, X, opts );
+                }
+                else {
+                    auto Xcplx = Xreal.template emptyLike<scalar_t>();
+                    Xcplx.insertLocalTiles();
+                    copy( Xreal, Xcplx, opts );
+                    redistribute( Xcplx, X, opts );
+                }
+            };
+            if (info == 0 && wantu) {
+                copy_vectors( Ub, U1d_row_cyclic.slice( 0, min_mn-1,
+                                                        0, min_mn-1 ) );
+            }
+            if (info == 0 && wantvt) {
+                copy_vectors( VTb, V1d.slice( 0, min_mn-1, 0, min_mn-1 ) );
+            }
+        }
+        if (info != 0) {
+            // QR iteration, replicated on each rank for its rows of U and
+            // columns of VT.
+            lapack::bdsqr(Uplo::Upper, min_mn, ncvt, nru, 0,
+                          &Sigma[0], &E[0],
+                          &VT1D_row_cyclic_data[0], ldvt,
+                          &U1D_row_cyclic_data[0], ldu,
+                          dummy, 1);
+        }
+        internal::timers_set( opts, "svd::bdsvd", t_bdsvd.stop() );
 
         // If matrix was scaled, then rescale singular values appropriately.
         if (is_scale) {
@@ -334,7 +391,8 @@ void svd(
             // First, U = U2 * U ===> U1d = U2 * U1d
             Timer t_unmbr_tb2bd_U;
             unmtr_hb2st( Side::Left, Op::NoTrans, U2, U1d, opts );
-            timers[ "svd::unmbr_tb2bd_U" ] = t_unmbr_tb2bd_U.stop();
+            internal::timers_set( opts, "svd::unmbr_tb2bd_U",
+                                  t_unmbr_tb2bd_U.stop() );
 
             // Redistribute U1d into U
             redistribute(U1d, Uhat, opts);
@@ -342,14 +400,15 @@ void svd(
             // Second, U = U1 * U ===> U = Ahat * U
             Timer t_unmbr_ge2tb_U;
             unmbr_ge2tb( Side::Left, Op::NoTrans, Ahat, TU, Uhat, opts );
-            timers[ "svd::unmbr_ge2tb_U" ] = t_unmbr_ge2tb_U.stop();
+            internal::timers_set( opts, "svd::unmbr_ge2tb_U",
+                                  t_unmbr_ge2tb_U.stop() );
             Timer t_unmqr;
             if (qr_path) {
                 // When initial QR was used.
                 // U = Q*U;
                 unmqr( Side::Left, slate::Op::NoTrans, A, TQ, U, opts );
             }
-            timers[ "svd::unmqr" ] = t_unmqr.stop();
+            internal::timers_set( opts, "svd::unmqr", t_unmqr.stop() );
         }
 
         // Back-transform: VT = VT * VT2 * VT1.
@@ -375,7 +434,8 @@ void svd(
             // First: V  = VT2 * V ===> V1d = VT2 * V1d
             Timer t_unmbr_tb2bd_V;
             unmtr_hb2st( Side::Left, Op::NoTrans, VT2, V1d, opts );
-            timers[ "svd::unmbr_tb2bd_V" ] = t_unmbr_tb2bd_V.stop();
+            internal::timers_set( opts, "svd::unmbr_tb2bd_V",
+                                  t_unmbr_tb2bd_V.stop() );
 
             // Redistribute V1d into V
             auto V1dT = conj_transpose(V1d);
@@ -384,13 +444,14 @@ void svd(
             // Second: VT = VT1 * VT ===> VT = Ahat * VT
             Timer t_unmbr_ge2tb_V;
             unmbr_ge2tb( Side::Right, Op::NoTrans, Ahat, TV, VThat, opts );
-            timers[ "svd::unmbr_ge2tb_V" ] = t_unmbr_ge2tb_V.stop();
+            internal::timers_set( opts, "svd::unmbr_ge2tb_V",
+                                  t_unmbr_ge2tb_V.stop() );
             Timer t_unmlq;
             if (lq_path) {
                 // VT = VT*Q;
                 unmlq( Side::Right, slate::Op::NoTrans, A, TQ, VT, opts );
             }
-            timers[ "svd::unmlq" ] = t_unmlq.stop();
+            internal::timers_set( opts, "svd::unmlq", t_unmlq.stop() );
         }
     }
     else {
@@ -415,10 +476,10 @@ void svd(
 
         // Bcast singular values.
         MPI_Bcast( &Sigma[0], min_mn, mpi_real_type, 0, A.mpiComm() );
-        timers[ "svd::bdsvd" ] = t_bdsvd.stop();
+        internal::timers_set( opts, "svd::bdsvd", t_bdsvd.stop() );
     }
 
-    timers[ "svd" ] = t_svd.stop();
+    internal::timers_set( opts, "svd", t_svd.stop() );
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,286 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Copies the l-by-l matrix W, replicated on all ranks, into the local
+/// tiles of M.
+///
+/// @ingroup svd_internal
+///
+template <typename scalar_t>
+void svd_rand_scatter(
+    std::vector<scalar_t> const& W, int64_t l,
+    Matrix<scalar_t>& M )
+{
+    const Layout layout = Layout::ColMajor;
+
+    auto row_offset = internal::tile_offsets( RowCol::Row, M );
+    auto col_offset = internal::tile_offsets( RowCol::Col, M );
+    for (int64_t i = 0; i < M.mt(); ++i) {
+        for (int64_t j = 0; j < M.nt(); ++j) {
+            if (M.tileIsLocal( i, j )) {
+                M.tileGetForWriting( i, j, HostNum, LayoutConvert( layout ) );
+                auto Mij = M( i, j );
+                lapack::lacpy( lapack::MatrixType::General, Mij.mb(), Mij.nb(),
+                               &W[ row_offset[ i ] + col_offset[ j ]*l ], l,
+                               Mij.data(), Mij.stride() );
+            }
+        }
+    }
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel randomized singular value decomposition.
+/// Computes the k largest singular values and, optionally, their singular
+/// vectors of an m-by-n matrix A,
+/// \[
+///     A \approx U \Sigma V^H,
+/// \]
+/// with a randomized range finder (Halko, Martinsson, and Tropp, 2011),
+/// instead of reducing all of A to bidiagonal form as svd does.
+///
+/// With l = k + oversampling columns, a Gaussian n-by-l $\Omega$ is
+/// sampled, and $Y = A \Omega$ is orthonormalized with cholqr; each power
+/// iteration then orthonormalizes $Z = A^H Y$ and $Y = A Z$ in turn.
+/// Finally, cholqr of $Z = A^H Y$ gives $Y^H A = R^H Z^H$, and the l-by-l
+/// $R^H = \hat{U} \Sigma \hat{V}^H$ is factored with LAPACK gesvd on rank 0,
+/// so $U = Y \hat{U}$ and $V^H = \hat{V}^H Z^H$, truncated to k.
+/// This costs O(m n l) flops in distributed gemm, per power iteration,
+/// instead of the O(m n min(m, n)) of svd.
+///
+/// Tiles of A are assumed square (mb = nb), as U and VT take their
+/// tiles from A.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The m-by-n matrix $A$. Not modified.
+///
+/// @param[out] Sigma
+///     On exit, the k largest singular values of A, in descending order.
+///
+/// @param[out] U
+///     On entry, if U is empty, does not compute the left singular vectors.
+///     Otherwise, the m-by-k matrix $U$, with A's row tiles.
+///     On exit, the left singular vectors.
+///
+/// @param[out] VT
+///     On entry, if VT is empty, does not compute the right singular vectors.
+///     Otherwise, the k-by-n matrix $V^H$, with A's column tiles.
+///     On exit, the right singular vectors.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Rank:
+///       Number of singular triplets k, 1 <= k <= min(m, n).
+///       Default min(10, m, n).
+///     - Option::Oversampling:
+///       Extra columns sampled, to improve accuracy. Default 10.
+///     - Option::PowerIterations:
+///       Power iterations, to improve accuracy when the singular values
+///       decay slowly. Default 2.
+///     - Option::CholQRPasses:
+///       Passes of cholqr for the orthonormalizations.
+///       Default 3 (shifted CholeskyQR3), which does not break down.
+///     - Option::Target:
+///       Implementation to target, as for gemm and cholqr.
+///
+/// @ingroup svd
+///
+template <typename scalar_t>
+void svd_rand(
+    Matrix<scalar_t>& A,
+    std::vector< blas::real_type<scalar_t> >& Sigma,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& VT,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    trace::Block trace_block( "slate::svd_rand" );
+
+    // Constants
+    const scalar_t zero = 0.0, one = 1.0;
+    const Layout layout = Layout::ColMajor;
+    const int root = 0;
+
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t min_mn = std::min( m, n );
+
+    // Options
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+    int64_t k = get_option<int64_t>( opts, Option::Rank,
+                                     std::min( min_mn, int64_t( 10 ) ) );
+    int64_t over = get_option<int64_t>( opts, Option::Oversampling, 10 );
+    int64_t power = get_option<int64_t>( opts, Option::PowerIterations, 2 );
+    slate_assert( 1 <= k && k <= min_mn );
+    slate_assert( over >= 0 );
+    slate_assert( power >= 0 );
+
+    Options opts_qr = opts;
+    if (opts.find( Option::CholQRPasses ) == opts.end())
+        opts_qr[ Option::CholQRPasses ] = int64_t( 3 );
+
+    bool wantu  = (U.mt() > 0);
+    bool wantvt = (VT.mt() > 0);
+    if (wantu)
+        slate_assert( U.m() == m && U.n() == k );
+    if (wantvt)
+        slate_assert( VT.m() == k && VT.n() == n );
+
+    int64_t l = std::min( k + over, min_mn );
+    auto AH = conj_transpose( A );
+
+    // Y is m-by-l, with the tiles of A; Z is n-by-l, with those of A^H.
+    auto Y = A.emptyLike().slice( 0, m-1, 0, l-1 );
+    auto Z = A.emptyLike( 0, 0, Op::ConjTrans ).slice( 0, n-1, 0, l-1 );
+    auto RY = Y.emptyLike().slice( 0, l-1, 0, l-1 );
+    auto RZ = Z.emptyLike().slice( 0, l-1, 0, l-1 );
+    Y.insertLocalTiles( target );
+    Z.insertLocalTiles( target );
+    RY.insertLocalTiles( target );
+    RZ.insertLocalTiles( target );
+
+    // Omega, in Z: Gaussian, seeded by tile, so independent of the grid.
+    for (int64_t i = 0; i < Z.mt(); ++i) {
+        for (int64_t j = 0; j < Z.nt(); ++j) {
+            if (Z.tileIsLocal( i, j )) {
+                Z.tileGetForWriting( i, j, HostNum, LayoutConvert( layout ) );
+                auto Zij = Z( i, j );
+                int64_t iseed[ 4 ] = { i % 4096, j % 4096, 0, 1 };
+                for (int64_t jj = 0; jj < Zij.nb(); ++jj)
+                    lapack::larnv( 3, iseed, Zij.mb(), &Zij.at( 0, jj ) );
+            }
+        }
+    }
+
+    // Range finder: Y = orth( A (A^H A)^power Omega ).
+    gemm( one, A, Z, zero, Y, opts );
+    cholqr( Y, RY, opts_qr );
+    for (int64_t iter = 0; iter < power; ++iter) {
+        gemm( one, AH, Y, zero, Z, opts );
+        cholqr( Z, RZ, opts_qr );
+        gemm( one, A, Z, zero, Y, opts );
+        cholqr( Y, RY, opts_qr );
+    }
+
+    // A^H Y = Z RZ, so Y^H A = RZ^H Z^H.
+    gemm( one, AH, Y, zero, Z, opts );
+    cholqr( Z, RZ, opts_qr );
+
+    // Gather RZ^H on the root.
+    std::vector<scalar_t> W( l*l, zero );
+    auto row_offset = internal::tile_offsets( RowCol::Row, RZ );
+    auto col_offset = internal::tile_offsets( RowCol::Col, RZ );
+    for (int64_t i = 0; i < RZ.mt(); ++i) {
+        for (int64_t j = i; j < RZ.nt(); ++j) {
+            if (RZ.tileIsLocal( i, j )) {
+                RZ.tileGetForReading( i, j, HostNum, LayoutConvert( layout ) );
+                auto Rij = RZ( i, j );
+                for (int64_t jj = 0; jj < Rij.nb(); ++jj) {
+                    for (int64_t ii = 0; ii < Rij.mb(); ++ii) {
+                        int64_t gi = row_offset[ i ] + ii;
+                        int64_t gj = col_offset[ j ] + jj;
+                        if (gi <= gj)
+                            W[ gj + gi*l ] = conj( Rij( ii, jj ) );
+                    }
+                }
+            }
+        }
+    }
+    int mpi_rank = A.mpiRank();
+    MPI_Comm comm = A.mpiComm();
+    slate_mpi_call(
+        MPI_Reduce( mpi_rank == root ? MPI_IN_PLACE : W.data(), W.data(),
+                    l*l, mpi_type<scalar_t>::value, MPI_SUM, root, comm ) );
+
+    // RZ^H = Uhat S Vhat^H, on the root.
+    std::vector<real_t> S( l );
+    std::vector<scalar_t> Uhat( l*l ), VhatH( l*l );
+    if (mpi_rank == root) {
+        lapack::gesvd( lapack::Job::AllVec, lapack::Job::AllVec, l, l,
+                       W.data(), l, S.data(),
+                       Uhat.data(), l, VhatH.data(), l );
+    }
+    slate_mpi_call(
+        MPI_Bcast( S.data(), l, mpi_type<real_t>::value, root, comm ) );
+    Sigma.assign( S.begin(), S.begin() + k );
+
+    // U = Y Uhat(:, 0:k-1).
+    if (wantu) {
+        slate_mpi_call(
+            MPI_Bcast( Uhat.data(), l*l, mpi_type<scalar_t>::value,
+                       root, comm ) );
+        auto Uhat_mat = Y.emptyLike().slice( 0, l-1, 0, l-1 );
+        Uhat_mat.insertLocalTiles( Target::Host );
+        impl::svd_rand_scatter( Uhat, l, Uhat_mat );
+        auto Uhat_k = Uhat_mat.slice( 0, l-1, 0, k-1 );
+        gemm( one, Y, Uhat_k, zero, U, opts );
+    }
+
+    // V^H = Vhat^H(0:k-1, :) Z^H.
+    if (wantvt) {
+        slate_mpi_call(
+            MPI_Bcast( VhatH.data(), l*l, mpi_type<scalar_t>::value,
+                       root, comm ) );
+        auto VhatH_mat = Z.emptyLike().slice( 0, l-1, 0, l-1 );
+        VhatH_mat.insertLocalTiles( Target::Host );
+        impl::svd_rand_scatter( VhatH, l, VhatH_mat );
+        auto VhatH_k = VhatH_mat.slice( 0, k-1, 0, l-1 );
+        auto ZH = conj_transpose( Z );
+        gemm( one, VhatH_k, ZH, zero, VT, opts );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void svd_rand<float>(
+    Matrix<float>& A,
+    std::vector<float>& Sigma,
+    Matrix<float>& U,
+    Matrix<float>& VT,
+    Options const& opts);
+
+template
+void svd_rand<double>(
+    Matrix<double>& A,
+    std::vector<double>& Sigma,
+    Matrix<double>& U,
+    Matrix<double>& VT,
+    Options const& opts);
+
+template
+void svd_rand< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    std::vector<float>& Sigma,
+    Matrix< std::complex<float> >& U,
+    Matrix< std::complex<float> >& VT,
+    Options const& opts);
+
+template
+void svd_rand< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    std::vector<double>& Sigma,
+    Matrix< std::complex<double> >& U,
+    Matrix< std::complex<double> >& VT,
+    Options const& opts);
+
+} // namespace slate
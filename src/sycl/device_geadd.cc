@@ -0,0 +1,264 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Routine for element-wise tile addition.
+/// Sets
+/// \[
+///     B = \alpha A + \beta B.
+/// \]
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] A
+///     is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] B
+///     is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geadd(
+    int64_t m, int64_t n,
+    scalar_t const& alpha, scalar_t* A, int64_t lda,
+    scalar_t const& beta, scalar_t* B, int64_t ldb,
+    blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    scalar_t alpha_ = alpha, beta_ = beta;
+    parallel_for_tiles( queue, m, n, 1,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            B[ i + j*ldb ] = alpha_ * A[ i + j*lda ] + beta_ * B[ i + j*ldb ];
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geadd(
+    int64_t m, int64_t n,
+    float const& alpha, float* Aarray, int64_t lda,
+    float const& beta, float* Barray, int64_t ldb,
+    blas::Queue &queue);
+
+template
+void geadd(
+    int64_t m, int64_t n,
+    double const& alpha, double* Aarray, int64_t lda,
+    double const& beta, double* Barray, int64_t ldb,
+    blas::Queue &queue);
+
+template
+void geadd(
+    int64_t m, int64_t n,
+    std::complex<float> const& alpha, std::complex<float>* Aarray, int64_t lda,
+    std::complex<float> const& beta, std::complex<float>* Barray, int64_t ldb,
+    blas::Queue &queue);
+
+template
+void geadd(
+    int64_t m, int64_t n,
+    std::complex<double> const& alpha, std::complex<double>* Aarray, int64_t lda,
+    std::complex<double> const& beta, std::complex<double>* Barray, int64_t ldb,
+    blas::Queue &queue);
+
+//==============================================================================
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise tile addition.
+/// Sets
+/// \[
+///     Barray[k] = \alpha Aarray[k] + \beta Barray[k].
+/// \]
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] Barray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Barray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] ldb
+///     Leading dimension of each tile in B. ldb >= m.
+///
+/// @param[in] batch_count
+///     Size of Aarray and Barray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geadd(
+    int64_t m, int64_t n,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t lda,
+    scalar_t const& beta, scalar_t** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (m == 0 || n == 0 || batch_count == 0)
+        return;
+
+    scalar_t alpha_ = alpha, beta_ = beta;
+    parallel_for_tiles( queue, m, n, batch_count,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            scalar_t const* A = Aarray[ k ];
+            scalar_t* B = Barray[ k ];
+            B[ i + j*ldb ] = alpha_ * A[ i + j*lda ] + beta_ * B[ i + j*ldb ];
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geadd(
+    int64_t m, int64_t n,
+    float const& alpha, float** Aarray, int64_t lda,
+    float const& beta, float** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd(
+    int64_t m, int64_t n,
+    double const& alpha, double** Aarray, int64_t lda,
+    double const& beta, double** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd(
+    int64_t m, int64_t n,
+    std::complex<float> const& alpha, std::complex<float>** Aarray, int64_t lda,
+    std::complex<float> const& beta, std::complex<float>** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd(
+    int64_t m, int64_t n,
+    std::complex<double> const& alpha, std::complex<double>** Aarray, int64_t lda,
+    std::complex<double> const& beta, std::complex<double>** Barray, int64_t ldb,
+    int64_t batch_count, blas::Queue &queue);
+
+} // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile addition.
+/// Sets
+/// \[
+///     Barray[k] = \alpha Aarray[k] + \beta Barray[k],
+/// \]
+/// where tile k is m[k]-by-n[k] with leading dimensions lda[k] and ldb[k].
+/// The m, n, lda, ldb arrays are of dimension batch_count in GPU memory.
+/// max_m is the maximum of m[k].
+///
+template <typename scalar_t>
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& alpha, scalar_t** Aarray, int64_t const* lda,
+    scalar_t const& beta,  scalar_t** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    scalar_t alpha_ = alpha, beta_ = beta;
+    parallel_for_vtiles( queue, m, n, max_m, batch_count,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            scalar_t const* A = Aarray[ k ];
+            scalar_t* B = Barray[ k ];
+            int64_t ldak = lda[ k ], ldbk = ldb[ k ];
+            B[ i + j*ldbk ] = alpha_ * A[ i + j*ldak ] + beta_ * B[ i + j*ldbk ];
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    float const& alpha, float** Aarray, int64_t const* lda,
+    float const& beta,  float** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    double const& alpha, double** Aarray, int64_t const* lda,
+    double const& beta,  double** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> const& alpha, std::complex<float>** Aarray, int64_t const* lda,
+    std::complex<float> const& beta,  std::complex<float>** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geadd_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> const& alpha, std::complex<double>** Aarray, int64_t const* lda,
+    std::complex<double> const& beta,  std::complex<double>** Barray, int64_t const* ldb,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+} // namespace device
+} // namespace slate
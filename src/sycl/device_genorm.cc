@@ -0,0 +1,324 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <complex>
+
+namespace slate {
+namespace device {
+
+#ifdef BLAS_HAVE_SYCL
+
+//------------------------------------------------------------------------------
+/// Reduces x over the work-group: first within each sub-group by shuffles,
+/// then across sub-groups through local memory.
+/// @return the reduction, valid in work-item 0.
+///
+template <typename real_t, int dim>
+real_t group_max_nan(
+    sycl::nd_item<dim> item, real_t x,
+    sycl::local_accessor<real_t, 1> const& partial )
+{
+    sycl::sub_group sg = item.get_sub_group();
+    x = sub_group_max_nan( sg, x );
+    if (sg.leader())
+        partial[ sg.get_group_linear_id() ] = x;
+    sycl::group_barrier( item.get_group() );
+    if (item.get_local_linear_id() == 0) {
+        for (size_t s = 1; s < sg.get_group_linear_range(); ++s)
+            x = max_nan( x, partial[ s ] );
+    }
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Work-group shape of kernels that reduce a whole tile: reduce_ny columns
+/// of reduce_nx work-items, each work-item striding over the tile, so
+/// consecutive work-items read consecutive rows.
+constexpr int reduce_nx = ew_nx;
+constexpr int reduce_ny = ew_ny;
+
+#endif // BLAS_HAVE_SYCL
+
+//------------------------------------------------------------------------------
+/// Batched routine that returns the largest absolute value of elements for
+/// each tile in Aarray. Sets
+///     tiles_maxima[k] = max_{i, j}( abs( A^(k)_(i, j) )),
+/// for each tile A^(k), where
+/// A^(k) = Aarray[k],
+/// k = 0, ..., blockDim.x-1,
+/// i = 0, ..., m-1,
+/// j = 0, ..., n-1.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile. lda >= m.
+///
+/// @param[out] values
+///     Array in GPU memory, dimension batch_count * ldv.
+///     - Norm::Max: ldv = 1.
+///         On exit, values[k] = max_{i, j} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count.
+///
+///     - Norm::One: ldv >= n.
+///         On exit, values[k*ldv + j] = sum_{i} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count, 0 <= j < n.
+///
+///     - Norm::Inf: ldv >= m.
+///         On exit, values[k*ldv + i] = sum_{j} abs( A^(k)_(i, j) )
+///         for 0 <= k < batch_count, 0 <= i < m.
+///
+///     - Norm::Fro: ldv = 2.
+///         On exit,
+///             values[k*2 + 0] = scale_k
+///             values[k*2 + 1] = sumsq_k
+///         where scale_k^2 sumsq_k = sum_{i,j} abs( A^(k)_(i, j) )^2
+///         for 0 <= k < batch_count.
+///
+/// @param[in] ldv
+///     Leading dimension of tiles_sums (values) array.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    scalar_t const* const* Aarray, int64_t lda,
+    blas::real_type<scalar_t>* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    using real_t = blas::real_type<scalar_t>;
+
+    // quick return
+    if (batch_count == 0)
+        return;
+
+    sycl::queue& q = sycl_queue( queue );
+
+    // One work-group per tile for whole-tile reductions,
+    // with a sub-group per column for column reductions.
+    sycl::nd_range<2> tile_range(
+        sycl::range<2>( batch_count, reduce_ny*reduce_nx ),
+        sycl::range<2>( 1, reduce_ny*reduce_nx ) );
+    sycl::nd_range<3> col_range(
+        sycl::range<3>( batch_count, round_up( n, ew_ny ), sg_size ),
+        sycl::range<3>( 1, ew_ny, sg_size ) );
+
+    if (scope == NormScope::Matrix) {
+
+        //---------
+        // max norm
+        if (norm == lapack::Norm::Max) {
+            if (m == 0 || n == 0) {
+                blas::device_memset(values, 0, batch_count, queue);
+            }
+            else {
+                assert(ldv == 1);
+                q.submit( [&]( sycl::handler& cgh ) {
+                    sycl::local_accessor<real_t, 1> partial( reduce_ny*reduce_nx, cgh );
+                    cgh.parallel_for( tile_range, [=]( sycl::nd_item<2> item ) {
+                        int64_t k  = item.get_global_id( 0 );
+                        int64_t tx = item.get_local_id( 1 ) % reduce_nx;
+                        int64_t ty = item.get_local_id( 1 ) / reduce_nx;
+                        scalar_t const* A = Aarray[ k ];
+                        real_t max = 0;
+                        for (int64_t j = ty; j < n; j += reduce_ny)
+                            for (int64_t i = tx; i < m; i += reduce_nx)
+                                max = max_nan( max, abs_val( A[ i + j*lda ] ) );
+                        max = group_max_nan( item, max, partial );
+                        if (item.get_local_linear_id() == 0)
+                            values[ k ] = max;
+                    });
+                });
+            }
+        }
+        //---------
+        // one norm
+        else if (norm == lapack::Norm::One) {
+            if (m == 0 || n == 0) {
+                blas::device_memset(values, 0, batch_count * n, queue);
+            }
+            else {
+                assert(ldv >= n);
+                // Each sub-group sums one column.
+                q.parallel_for( col_range, [=]( sycl::nd_item<3> item )
+                        [[sycl::reqd_sub_group_size( sg_size )]] {
+                    int64_t k = item.get_global_id( 0 );
+                    int64_t j = item.get_global_id( 1 );
+                    if (j >= n)
+                        return;
+                    scalar_t const* A = Aarray[ k ] + j*lda;
+                    real_t sum = 0;
+                    for (int64_t i = item.get_local_id( 2 ); i < m; i += sg_size)
+                        sum += abs_val( A[ i ] );
+                    sycl::sub_group sg = item.get_sub_group();
+                    sum = sycl::reduce_over_group( sg, sum, sycl::plus<real_t>() );
+                    if (sg.leader())
+                        values[ k*ldv + j ] = sum;
+                });
+            }
+        }
+        //---------
+        // inf norm
+        else if (norm == lapack::Norm::Inf) {
+            if (m == 0 || n == 0) {
+                blas::device_memset(values, 0, batch_count * m, queue);
+            }
+            else {
+                assert(ldv >= m);
+                // Each work-item sums one row; reads are coalesced across rows.
+                int64_t nt = reduce_ny*reduce_nx;
+                sycl::nd_range<2> row_range(
+                    sycl::range<2>( batch_count, round_up( m, nt ) ),
+                    sycl::range<2>( 1, nt ) );
+                q.parallel_for( row_range, [=]( sycl::nd_item<2> item ) {
+                    int64_t k = item.get_global_id( 0 );
+                    int64_t i = item.get_global_id( 1 );
+                    if (i >= m)
+                        return;
+                    scalar_t const* A = Aarray[ k ] + i;
+                    real_t sum = 0;
+                    for (int64_t j = 0; j < n; ++j)
+                        sum += abs_val( A[ j*lda ] );
+                    values[ k*ldv + i ] = sum;
+                });
+            }
+        }
+        //---------
+        // Frobenius norm
+        else if (norm == lapack::Norm::Fro) {
+            if (m == 0 || n == 0) {
+                blas::device_memset(values, 0, batch_count * 2, queue);
+            }
+            else {
+                assert(ldv == 2);
+                q.submit( [&]( sycl::handler& cgh ) {
+                    sycl::local_accessor<real_t, 1> partial( 2*reduce_ny*reduce_nx, cgh );
+                    cgh.parallel_for( tile_range, [=]( sycl::nd_item<2> item ) {
+                        int64_t k  = item.get_global_id( 0 );
+                        int64_t tx = item.get_local_id( 1 ) % reduce_nx;
+                        int64_t ty = item.get_local_id( 1 ) / reduce_nx;
+                        scalar_t const* A = Aarray[ k ];
+                        real_t scale = 0;
+                        real_t sumsq = 1;
+                        for (int64_t j = ty; j < n; j += reduce_ny)
+                            for (int64_t i = tx; i < m; i += reduce_nx)
+                                add_sumsq( scale, sumsq, abs_val( A[ i + j*lda ] ) );
+
+                        // Combine within sub-groups, then across sub-groups.
+                        sycl::sub_group sg = item.get_sub_group();
+                        sub_group_sumsq( sg, scale, sumsq );
+                        size_t s = sg.get_group_linear_id();
+                        if (sg.leader()) {
+                            partial[ 2*s + 0 ] = scale;
+                            partial[ 2*s + 1 ] = sumsq;
+                        }
+                        sycl::group_barrier( item.get_group() );
+                        if (item.get_local_linear_id() == 0) {
+                            for (s = 1; s < sg.get_group_linear_range(); ++s)
+                                combine_sumsq( scale, sumsq,
+                                               partial[ 2*s + 0 ], partial[ 2*s + 1 ] );
+                            values[ k*2 + 0 ] = scale;
+                            values[ k*2 + 1 ] = sumsq;
+                        }
+                    });
+                });
+            }
+        }
+    }
+    else if (scope == NormScope::Columns) {
+
+        if (norm == Norm::Max) {
+
+            if (m == 0 || n == 0) {
+                blas::device_memset(values, 0, batch_count * n, queue);
+            }
+            else {
+                assert(ldv >= n);
+                // Each sub-group reduces one column.
+                q.parallel_for( col_range, [=]( sycl::nd_item<3> item )
+                        [[sycl::reqd_sub_group_size( sg_size )]] {
+                    int64_t k = item.get_global_id( 0 );
+                    int64_t j = item.get_global_id( 1 );
+                    if (j >= n)
+                        return;
+                    scalar_t const* A = Aarray[ k ] + j*lda;
+                    real_t max = 0;
+                    for (int64_t i = item.get_local_id( 2 ); i < m; i += sg_size)
+                        max = max_nan( max, abs_val( A[ i ] ) );
+                    sycl::sub_group sg = item.get_sub_group();
+                    max = sub_group_max_nan( sg, max );
+                    if (sg.leader())
+                        values[ k*ldv + j ] = max;
+                });
+            }
+        }
+        else {
+            slate_not_implemented("The norm isn't yet supported");
+        }
+    }
+    else {
+        slate_not_implemented("The norm scope isn't yet supported.");
+    }
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    float const* const* Aarray, int64_t lda,
+    float* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    double const* const* Aarray, int64_t lda,
+    double* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    std::complex<float> const* const* Aarray, int64_t lda,
+    float* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+template
+void genorm(
+    lapack::Norm norm, NormScope scope,
+    int64_t m, int64_t n,
+    std::complex<double> const* const* Aarray, int64_t lda,
+    double* values, int64_t ldv, int64_t batch_count,
+    blas::Queue &queue);
+
+} // namespace device
+} // namespace slate
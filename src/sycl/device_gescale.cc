@@ -0,0 +1,288 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Element-wise tile scale, A = (numer / denom) A.
+/// Each work-item deals with one entry.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 1.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 1.
+///
+/// @param[in] numer
+///     Scale value numerator.
+///
+/// @param[in] denom
+///     Scale value denominator.
+///
+/// @param[in,out] A
+///     An m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in Aarray. lda >= m.
+///
+template <typename scalar_t, typename scalar_t2>
+void gescale(
+    int64_t m, int64_t n,
+    scalar_t2 numer, scalar_t2 denom,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    scalar_t2 mul = numer / denom;
+
+    parallel_for_tiles( queue, m, n, 1,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            A[ i + j*lda ] = A[ i + j*lda ] * mul;
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gescale(
+    int64_t m, int64_t n,
+    float numer, float denom,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    double numer, double denom,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    float numer, float denom,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    std::complex<float> numer, std::complex<float> denom,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    double numer,  double denom,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    std::complex<double> numer, std::complex<double> denom,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+
+//==============================================================================
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Batched routine for element-wise tile scale. Sets
+/// \[
+///     Aarray[k] *= (numer / denom).
+/// \]
+/// This does NOT currently take extra care to avoid over/underflow.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] numer
+///     Scale value numerator.
+///
+/// @param[in] denom
+///     Scale value denominator.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t, typename scalar_t2>
+void gescale(
+    int64_t m, int64_t n,
+    scalar_t2 numer, scalar_t2 denom,
+    scalar_t** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (m == 0 || n == 0 || batch_count == 0)
+        return;
+
+    scalar_t2 mul = numer / denom;
+
+    parallel_for_tiles( queue, m, n, batch_count,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            scalar_t* A = Aarray[ k ];
+            A[ i + j*lda ] = A[ i + j*lda ] * mul;
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gescale(
+    int64_t m, int64_t n,
+    float numer, float denom,
+    float** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    double numer, double denom,
+    double** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    float numer, float denom,
+    std::complex<float>** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    std::complex<float> numer, std::complex<float> denom,
+    std::complex<float>** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    double numer,  double denom,
+    std::complex<double>** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale(
+    int64_t m, int64_t n,
+    std::complex<double> numer, std::complex<double> denom,
+    std::complex<double>** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue& queue);
+
+} // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile scale,
+/// Aarray[k] = (numer / denom) Aarray[k],
+/// where tile k is m[k]-by-n[k] with leading dimension lda[k].
+/// The m, n, lda arrays are of dimension batch_count in GPU memory.
+/// max_m is the maximum of m[k].
+///
+template <typename scalar_t, typename scalar_t2>
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t2 numer, scalar_t2 denom,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    scalar_t2 mul = numer / denom;
+
+    parallel_for_vtiles( queue, m, n, max_m, batch_count,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            scalar_t* A = Aarray[ k ];
+            int64_t ldak = lda[ k ];
+            A[ i + j*ldak ] = A[ i + j*ldak ] * mul;
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    float numer, float denom,
+    float** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    double numer, double denom,
+    double** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    float numer, float denom,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> numer, std::complex<float> denom,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    double numer, double denom,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+template
+void gescale_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> numer, std::complex<double> denom,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t max_m, int64_t batch_count, blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
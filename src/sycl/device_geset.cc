@@ -0,0 +1,246 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Element-wise m-by-n matrix A
+/// to diag_value on the diagonal and offdiag_value on the off-diagonals.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in] offdiag_value
+///     The value to set outside of the diagonal.
+///
+/// @param[in] diag_value
+///     The value to set on the diagonal.
+///
+/// @param[out] A
+///     An m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= m.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geset(
+    int64_t m, int64_t n,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t* A, int64_t lda,
+    blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (m == 0 || n == 0)
+        return;
+
+    scalar_t offdiag = offdiag_value, diag = diag_value;
+    parallel_for_tiles( queue, m, n, 1,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            A[ i + j*lda ] = (j != i) ? offdiag : diag;
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geset(
+    int64_t m, int64_t n,
+    float const& offdiag_value, float const& diag_value,
+    float* A, int64_t lda,
+    blas::Queue &queue);
+
+template
+void geset(
+    int64_t m, int64_t n,
+    double const& offdiag_value, double const& diag_value,
+    double* A, int64_t lda,
+    blas::Queue &queue);
+
+template
+void geset(
+    int64_t m, int64_t n,
+    std::complex<float> const& offdiag_value, std::complex<float> const& diag_value,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue &queue);
+
+template
+void geset(
+    int64_t m, int64_t n,
+    std::complex<double> const& offdiag_value, std::complex<double> const& diag_value,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue &queue);
+
+//==============================================================================
+namespace batch {
+
+//------------------------------------------------------------------------------
+/// Initializes a batch of m-by-n matrices Aarray[k]
+/// to diag_value on the diagonal and offdiag_value on the off-diagonals.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in] offdiag_value
+///     The value to set outside of the diagonal.
+///
+/// @param[in] diag_value
+///     The value to set on the diagonal.
+///
+/// @param[in] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to tiles,
+///     where each Aarray[k] is an m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each tile in A. lda >= m.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void geset(
+    int64_t m, int64_t n,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (m == 0 || n == 0 || batch_count == 0)
+        return;
+
+    scalar_t offdiag = offdiag_value, diag = diag_value;
+    parallel_for_tiles( queue, m, n, batch_count,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            Aarray[ k ][ i + j*lda ] = (j != i) ? offdiag : diag;
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geset(
+    int64_t m, int64_t n,
+    float const& offdiag_value, float const& diag_value,
+    float** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue &queue);
+
+template
+void geset(
+    int64_t m, int64_t n,
+    double const& offdiag_value, double const& diag_value,
+    double** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue &queue);
+
+template
+void geset(
+    int64_t m, int64_t n,
+    std::complex<float> const& offdiag_value, std::complex<float> const& diag_value,
+    std::complex<float>** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue &queue);
+
+template
+void geset(
+    int64_t m, int64_t n,
+    std::complex<double> const& offdiag_value, std::complex<double> const& diag_value,
+    std::complex<double>** Aarray, int64_t lda,
+    int64_t batch_count, blas::Queue &queue);
+
+} // namespace batch
+
+//------------------------------------------------------------------------------
+/// Variable-size batched routine for element-wise tile set.
+/// Tile k is m[k]-by-n[k] with leading dimension lda[k]. Tiles with
+/// is_diagonal[k] != 0 get diag_value on the diagonal; all other entries
+/// get offdiag_value.
+/// The m, n, lda, is_diagonal arrays are of dimension batch_count in
+/// GPU memory. max_m is the maximum of m[k].
+///
+template <typename scalar_t>
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    scalar_t const& offdiag_value, scalar_t const& diag_value,
+    scalar_t** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    // quick return
+    if (batch_count == 0 || max_m == 0)
+        return;
+
+    scalar_t offdiag = offdiag_value, diag = diag_value;
+    parallel_for_vtiles( queue, m, n, max_m, batch_count,
+        [=]( int64_t k, int64_t i, int64_t j ) {
+            bool on_diag = (j == i && is_diagonal[ k ]);
+            Aarray[ k ][ i + j*lda[ k ] ] = on_diag ? diag : offdiag;
+        });
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    float const& offdiag_value, float const& diag_value,
+    float** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    double const& offdiag_value, double const& diag_value,
+    double** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<float> const& offdiag_value,
+    std::complex<float> const& diag_value,
+    std::complex<float>** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+template
+void geset_vbatch(
+    int64_t const* m, int64_t const* n,
+    std::complex<double> const& offdiag_value,
+    std::complex<double> const& diag_value,
+    std::complex<double>** Aarray, int64_t const* lda,
+    int64_t const* is_diagonal,
+    int64_t max_m, int64_t batch_count, blas::Queue &queue);
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,850 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/Exception.hh"
+#include "slate/internal/device.hh"
+
+#include "device_util.hh"
+
+namespace slate {
+namespace device {
+
+#ifdef BLAS_HAVE_SYCL
+
+//------------------------------------------------------------------------------
+/// Device routine handles a batch of square matrices in place;
+/// get_A( k ) returns matrix k.
+///
+/// Each work-group of ib x ib work-items takes a block A(i, j) below or on
+/// the diagonal, and its mirror A(j, i). It loads them into local memory,
+/// reading down columns so each sub-group reads consecutive addresses,
+/// and then writes them back transposed into the mirror location.
+///
+template <typename scalar_t, typename get_tile_t>
+void transpose_sqr_launch(
+    bool is_conj,
+    int n,
+    get_tile_t get_A, int64_t lda,
+    int64_t batch_count, blas::Queue& queue)
+{
+    static const int ib = 16;
+    int64_t nb = round_up( n, ib );
+    sycl::range<3> global( batch_count, nb, nb );
+    sycl::range<3> local( 1, ib, ib );
+    sycl_queue( queue ).submit( [&]( sycl::handler& cgh ) {
+        // +1 to avoid memory bank conflicts.
+        sycl::local_accessor<scalar_t, 2> sA1( sycl::range<2>( ib, ib+1 ), cgh );
+        sycl::local_accessor<scalar_t, 2> sA2( sycl::range<2>( ib, ib+1 ), cgh );
+        cgh.parallel_for( sycl::nd_range<3>( global, local ),
+            [=]( sycl::nd_item<3> item ) {
+                // i, j are row & column indices of top-left corner of block.
+                int64_t i = item.get_group( 2 ) * ib;
+                int64_t j = item.get_group( 1 ) * ib;
+                // Blocks above the diagonal are swapped by their mirrors.
+                // Uniform across the work-group, so no barrier is skipped.
+                if (j > i)
+                    return;
+
+                int tx = item.get_local_id( 2 );
+                int ty = item.get_local_id( 1 );
+                scalar_t* A = get_A( item.get_global_id( 0 ) );
+                bool in_ij = (i + tx < n && j + ty < n);  // A(i+tx, j+ty)
+                bool in_ji = (j + tx < n && i + ty < n);  // A(j+tx, i+ty)
+
+                // sA1 = A(i, j), sA2 = A(j, i).
+                if (in_ij)
+                    sA1[ ty ][ tx ] = A[ (i + tx) + (j + ty)*lda ];
+                if (i != j && in_ji)
+                    sA2[ ty ][ tx ] = A[ (j + tx) + (i + ty)*lda ];
+                sycl::group_barrier( item.get_group() );
+
+                if (i == j) {
+                    // A(i, i) = trans(sA1).
+                    if (in_ij)
+                        A[ (i + tx) + (j + ty)*lda ] = conj_if( is_conj, sA1[ tx ][ ty ] );
+                }
+                else {
+                    // A(i, j) = trans(sA2), A(j, i) = trans(sA1).
+                    if (in_ij)
+                        A[ (i + tx) + (j + ty)*lda ] = conj_if( is_conj, sA2[ tx ][ ty ] );
+                    if (in_ji)
+                        A[ (j + tx) + (i + ty)*lda ] = conj_if( is_conj, sA1[ tx ][ ty ] );
+                }
+            });
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Device routine handles batches of square matrices.
+///
+template <typename scalar_t>
+void transpose_sqr_batch_func(
+    bool is_conj,
+    int n,
+    scalar_t** Aarray, int64_t lda,
+    int batch_count, blas::Queue& queue)
+{
+    transpose_sqr_launch<scalar_t>(
+        is_conj, n, [=]( int64_t k ) { return Aarray[ k ]; }, lda,
+        batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Device routine handles single square matrix.
+///
+template <typename scalar_t>
+void transpose_sqr_func(
+    bool is_conj,
+    int n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+    transpose_sqr_launch<scalar_t>(
+        is_conj, n, [=]( int64_t k ) { return A; }, lda,
+        1, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Device routine handles a batch of rectangular matrices out-of-place;
+/// get_A( k ) and get_AT( k ) return matrix k and its transpose.
+///
+/// Each work-group takes an NX x NX block, loads it into local memory
+/// reading down columns, and writes it transposed, again down columns.
+/// Its NX x rows_ work-items each handle NX / rows_ rows of the block.
+///
+template <typename scalar_t, int NX, typename get_tile_t, typename get_tile_t2>
+void transpose_rect_launch(
+    bool is_conj,
+    int m, int n,
+    get_tile_t get_A, int64_t lda,
+    get_tile_t2 get_AT, int64_t ldat,
+    int64_t batch_count, blas::Queue& queue)
+{
+    static const int rows_ = 8;
+    sycl::range<3> global(
+        batch_count, round_up( n, NX ) / NX * rows_, round_up( m, NX ) );
+    sycl::range<3> local( 1, rows_, NX );
+    sycl_queue( queue ).submit( [&]( sycl::handler& cgh ) {
+        // +1 to avoid memory bank conflicts.
+        sycl::local_accessor<scalar_t, 2> sA( sycl::range<2>( NX, NX+1 ), cgh );
+        cgh.parallel_for( sycl::nd_range<3>( global, local ),
+            [=]( sycl::nd_item<3> item ) {
+                // i, j are row & column indices of top-left corner of block.
+                int64_t i = item.get_group( 2 ) * NX;
+                int64_t j = item.get_group( 1 ) * NX;
+                int tx = item.get_local_id( 2 );
+                int ty = item.get_local_id( 1 );
+                int64_t k = item.get_global_id( 0 );
+                scalar_t const* dA = get_A( k );
+                scalar_t* dAT = get_AT( k );
+
+                // sA(jj, ii) = dA(i + ii, j + jj)
+                for (int jj = ty; jj < NX; jj += rows_) {
+                    if (i + tx < m && j + jj < n)
+                        sA[ jj ][ tx ] = dA[ (i + tx) + (j + jj)*lda ];
+                }
+                sycl::group_barrier( item.get_group() );
+
+                // dAT(j + jj, i + ii) = sA(jj, ii)
+                for (int ii = ty; ii < NX; ii += rows_) {
+                    if (j + tx < n && i + ii < m)
+                        dAT[ (j + tx) + (i + ii)*ldat ] = conj_if( is_conj, sA[ tx ][ ii ] );
+                }
+            });
+    });
+}
+
+//------------------------------------------------------------------------------
+/// Device routine handles batches of rectangular matrices.
+///
+template <typename scalar_t, int NX>
+void transpose_rect_batch_func(
+    bool is_conj,
+    int m, int n,
+    scalar_t** dAarray, int64_t lda,
+    scalar_t** dATarray, int64_t ldat,
+    int batch_count, blas::Queue& queue)
+{
+    transpose_rect_launch<scalar_t, NX>(
+        is_conj, m, n,
+        [=]( int64_t k ) { return dAarray[ k ]; }, lda,
+        [=]( int64_t k ) { return dATarray[ k ]; }, ldat,
+        batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Device routine handles single rectangular matrix.
+///
+template <typename scalar_t, int NX>
+void transpose_rect_func(
+    bool is_conj,
+    int m, int n,
+    scalar_t* dA, int64_t lda,
+    scalar_t* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+    transpose_rect_launch<scalar_t, NX>(
+        is_conj, m, n,
+        [=]( int64_t k ) { return dA; }, lda,
+        [=]( int64_t k ) { return dAT; }, ldat,
+        1, queue );
+}
+
+#endif // BLAS_HAVE_SYCL
+
+//------------------------------------------------------------------------------
+/// Physically transpose a square matrix in place.
+///
+/// @param[in] n
+///     Number of rows and columns of each tile. n >= 0.
+///
+/// @param[in,out] A
+///     A square n-by-n matrix stored in an lda-by-n array in GPU memory.
+///     On output, A is transposed.
+///
+/// @param[in] lda
+///     Leading dimension of A. lda >= n.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    if (n <= 1)
+        return;
+    assert(lda >= n);
+
+    transpose_sqr_func(is_conj, n, A, lda, queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a batch of square matrices in place.
+///
+/// @param[in] n
+///     Number of rows and columns of each tile. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to
+///     matrices, where each Aarray[k] is a square n-by-n matrix stored in an
+///     lda-by-n array in GPU memory.
+///     On output, each Aarray[k] is transposed.
+///
+/// @param[in] lda
+///     Leading dimension of each tile. lda >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    scalar_t** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    if (batch_count < 0 || n <= 1)
+        return;
+    assert(lda >= n);
+
+    transpose_sqr_batch_func(
+        is_conj, n, Aarray, lda, batch_count, queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a rectangular matrix out-of-place.
+///
+/// @param[in] m
+///     Number of columns of tile. m >= 0.
+///
+/// @param[in] n
+///     Number of rows of tile. n >= 0.
+///
+/// @param[in] dA
+///     A rectangular m-by-n matrix stored in an lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of dA. lda >= m.
+///
+/// @param[out] dAT
+///     A rectangular m-by-n matrix stored in an ldat-by-m array in GPU memory.
+///     On output, dAT is the transpose of dA.
+///
+/// @param[in] ldat
+///     Leading dimension of dAT. ldat >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t, int NX>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* dA,  int64_t lda,
+    scalar_t* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    if ((m <= 0) || (n <= 0))
+        return;
+    assert(lda >= m);
+    assert(ldat >= n);
+
+    transpose_rect_func<scalar_t, NX>(
+        is_conj, m, n, dA, lda, dAT, ldat, queue );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a batch of rectangular matrices out-of-place.
+///
+/// @param[in] m
+///     Number of columns of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of rows of each tile. n >= 0.
+///
+/// @param[in] dA_array
+///     Array in GPU memory of dimension batch_count, containing pointers to
+///     matrices, where each dA_array[k] is a rectangular m-by-n matrix stored in an
+///     lda-by-n array in GPU memory.
+///
+/// @param[in] lda
+///     Leading dimension of each dA_array[k] tile. lda >= m.
+///
+/// @param[out] dAT_array
+///     Array in GPU memory of dimension batch_count, containing pointers to
+///     matrices, where each dAT_array[k] is a rectangular m-by-n matrix
+///     stored in an ldat-by-m array in GPU memory.
+///     On output, each dAT_array[k] is the transpose of dA_array[k].
+///
+/// @param[in] lda
+///     Leading dimension of each dAT_array[k] tile. ldat >= n.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t, int NX>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t **dA_array,  int64_t lda,
+    scalar_t **dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    if ((m <= 0) || (n <= 0))
+        return;
+    assert(lda >= m);
+    assert(ldat >= n);
+
+    transpose_rect_batch_func<scalar_t, NX>(
+        is_conj, m, n, dA_array, lda, dAT_array, ldat, batch_count, queue );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// Square matrix
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    float* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    double* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    std::complex<float>* A, int64_t lda,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t n,
+    std::complex<double>* A, int64_t lda,
+    blas::Queue& queue);
+
+// ----------------------------------------
+// Explicit instantiations.
+// Batch of square matrices
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    float** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    double** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    std::complex<float>** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t n,
+    std::complex<double>** Aarray, int64_t lda,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+
+// ----------------------------------------
+// Explicit instantiations.
+// Rectangular matrix
+
+template<>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float* dA,  int64_t lda,
+    float* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose<float,32>(
+        is_conj,
+        m, n,
+        dA,  lda,
+        dAT, ldat,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+template<>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double* dA,  int64_t lda,
+    double* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose<double,32>(
+        is_conj,
+        m, n,
+        dA,  lda,
+        dAT, ldat,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+template<>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>* dA,  int64_t lda,
+    std::complex<float>* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose<std::complex<float>,32>(
+        is_conj,
+        m, n,
+        dA,  lda,
+        dAT, ldat,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+template<>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>* dA,  int64_t lda,
+    std::complex<double>* dAT, int64_t ldat,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose<std::complex<double>,16>(
+        is_conj,
+        m, n,
+        dA,  lda,
+        dAT, ldat,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+// ----------------------------------------
+// Explicit instantiations.
+// Batch of rectangular matrices
+
+template<>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float **dA_array,  int64_t lda,
+    float **dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose_batch<float,32>(
+        is_conj,
+        m, n,
+        dA_array,  lda,
+        dAT_array, ldat,
+        batch_count,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+template<>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double **dA_array,  int64_t lda,
+    double **dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose_batch<double,32>(
+        is_conj,
+        m, n,
+        dA_array,  lda,
+        dAT_array, ldat,
+        batch_count,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+template<>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float> **dA_array,  int64_t lda,
+    std::complex<float> **dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose_batch<std::complex<float>,32>(
+        is_conj,
+        m, n,
+        dA_array,  lda,
+        dAT_array, ldat,
+        batch_count,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+template<>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double> **dA_array,  int64_t lda,
+    std::complex<double> **dAT_array, int64_t ldat,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    transpose_batch<std::complex<double>,16>(
+        is_conj,
+        m, n,
+        dA_array,  lda,
+        dAT_array, ldat,
+        batch_count,
+        queue);
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+#ifdef BLAS_HAVE_SYCL
+
+//------------------------------------------------------------------------------
+/// Device routine does in-place transpose of a batch of contiguous,
+/// rectangular m-by-n matrices into n-by-m matrices, by following the
+/// cycles of the permutation; get_A( b ) returns matrix b.
+/// Element k = i + j*m moves to j + i*n = k*n mod (m*n - 1),
+/// and element p is replaced by element p*m mod (m*n - 1).
+/// Each work-item takes one start index k, and rotates its cycle only if
+/// k is the cycle's smallest index. Elements 0 and m*n - 1 are fixed.
+///
+template <typename scalar_t, typename get_tile_t>
+void transpose_cycles_launch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    get_tile_t get_A,
+    int64_t batch_count, blas::Queue& queue)
+{
+    int64_t size = m*n;
+    int64_t mod = size - 1;
+    bool is_vector = (m == 1 || n == 1);
+    sycl_queue( queue ).parallel_for(
+        sycl::range<2>( batch_count, size ),
+        [=]( sycl::item<2> item ) {
+            scalar_t* A = get_A( item.get_id( 0 ) );
+            int64_t k = item.get_id( 1 );
+            if (is_vector || k == mod) {
+                // Vectors are already transposed; only conjugate.
+                if (is_conj)
+                    A[ k ] = conj_if( is_conj, A[ k ] );
+                return;
+            }
+
+            // Leader test: walk forward until back at k or below k.
+            int64_t p = (k * n) % mod;
+            while (p > k)
+                p = (p * n) % mod;
+            if (p < k)
+                return;
+
+            // Rotate the cycle, pulling each element from its source.
+            scalar_t tmp = A[ k ];
+            p = k;
+            int64_t q = (p * m) % mod;
+            while (q != k) {
+                A[ p ] = conj_if( is_conj, A[ q ] );
+                p = q;
+                q = (p * m) % mod;
+            }
+            A[ p ] = conj_if( is_conj, tmp );
+        });
+}
+
+//------------------------------------------------------------------------------
+/// Device routine does in-place transpose of one contiguous, rectangular
+/// matrix; see transpose_cycles_launch.
+///
+template <typename scalar_t>
+void transpose_cycles_func(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A,
+    blas::Queue& queue)
+{
+    transpose_cycles_launch<scalar_t>(
+        is_conj, m, n, [=]( int64_t b ) { return A; }, 1, queue );
+}
+
+//------------------------------------------------------------------------------
+/// Device routine does in-place transpose of a batch of contiguous,
+/// rectangular matrices; see transpose_cycles_launch.
+///
+template <typename scalar_t>
+void transpose_cycles_batch_func(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray,
+    int64_t batch_count, blas::Queue& queue)
+{
+    transpose_cycles_launch<scalar_t>(
+        is_conj, m, n, [=]( int64_t b ) { return Aarray[ b ]; },
+        batch_count, queue );
+}
+
+#endif // BLAS_HAVE_SYCL
+
+//------------------------------------------------------------------------------
+/// Physically transpose a rectangular matrix in place.
+/// Unlike the out-of-place transpose, this requires no workspace; it is
+/// used to convert the layout of contiguous rectangular tiles.
+///
+/// @param[in] m
+///     Number of rows of A. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of A. n >= 0.
+///
+/// @param[in,out] A
+///     A rectangular m-by-n matrix stored contiguously in an m-by-n array
+///     in GPU memory.
+///     On output, A is the n-by-m transpose, stored in an n-by-m array.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t* A,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    if ((m <= 0) || (n <= 0))
+        return;
+
+    transpose_cycles_func( is_conj, m, n, A, queue );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+//------------------------------------------------------------------------------
+/// Physically transpose a batch of rectangular matrices in place.
+///
+/// @param[in] m
+///     Number of rows of each tile. m >= 0.
+///
+/// @param[in] n
+///     Number of columns of each tile. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array in GPU memory of dimension batch_count, containing pointers to
+///     matrices, where each Aarray[k] is a rectangular m-by-n matrix stored
+///     contiguously in an m-by-n array in GPU memory.
+///     On output, each Aarray[k] is its n-by-m transpose.
+///
+/// @param[in] batch_count
+///     Size of Aarray. batch_count >= 0.
+///
+/// @param[in] queue
+///     BLAS++ queue to execute in.
+///
+template <typename scalar_t>
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    scalar_t** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue)
+{
+#ifdef BLAS_HAVE_SYCL
+    if (batch_count <= 0 || m <= 0 || n <= 0)
+        return;
+
+    transpose_cycles_batch_func( is_conj, m, n, Aarray, batch_count, queue );
+#else
+    throw slate::Exception( "device routines not available" );
+#endif
+}
+
+// ----------------------------------------
+// Explicit instantiations.
+// Rectangular matrix, in-place
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>* A,
+    blas::Queue& queue);
+
+template
+void transpose(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>* A,
+    blas::Queue& queue);
+
+// ----------------------------------------
+// Explicit instantiations.
+// Batch of rectangular matrices, in-place
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    float** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    double** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<float>** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+template
+void transpose_batch(
+    bool is_conj,
+    int64_t m, int64_t n,
+    std::complex<double>** Aarray,
+    int64_t batch_count,
+    blas::Queue& queue);
+
+} // namespace device
+} // namespace slate
@@ -0,0 +1,213 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef SLATE_SYCL_UTIL_HH
+#define SLATE_SYCL_UTIL_HH
+
+#ifdef BLAS_HAVE_SYCL
+
+#include <sycl/sycl.hpp>
+
+#include <complex>
+
+namespace slate {
+namespace device {
+
+//------------------------------------------------------------------------------
+/// Work-group shape of element-wise tile kernels: ew_nx work-items along
+/// rows, which are contiguous in column-major tiles, so each sub-group
+/// accesses consecutive addresses; ew_ny work-items along columns.
+constexpr int ew_nx = 32;
+constexpr int ew_ny = 8;
+
+/// Sub-group size of reduction kernels. All Intel GPUs support 16.
+constexpr int sg_size = 16;
+
+//------------------------------------------------------------------------------
+/// @return ceil( x / y ) * y, for the global range of an nd_range.
+inline size_t round_up( int64_t x, int64_t y )
+{
+    return size_t( ((x + y - 1) / y) * y );
+}
+
+//------------------------------------------------------------------------------
+/// @return the in-order SYCL queue underlying the BLAS++ queue, so kernels
+/// are ordered with oneMKL calls on the same queue without a sync.
+inline sycl::queue& sycl_queue( blas::Queue& queue )
+{
+    return queue.stream();
+}
+
+//------------------------------------------------------------------------------
+/// Launches kernel( k, i, j ) for each entry (i, j) of each m-by-n tile k,
+/// one work-item per entry, with ew_nx-by-ew_ny work-groups.
+///
+template <typename kernel_t>
+void parallel_for_tiles(
+    blas::Queue& queue, int64_t m, int64_t n, int64_t batch_count,
+    kernel_t kernel )
+{
+    sycl::range<3> global( batch_count, round_up( n, ew_ny ), round_up( m, ew_nx ) );
+    sycl::range<3> local( 1, ew_ny, ew_nx );
+    sycl_queue( queue ).parallel_for(
+        sycl::nd_range<3>( global, local ),
+        [=]( sycl::nd_item<3> item ) {
+            int64_t k = item.get_global_id( 0 );
+            int64_t j = item.get_global_id( 1 );
+            int64_t i = item.get_global_id( 2 );
+            if (i < m && j < n)
+                kernel( k, i, j );
+        });
+}
+
+//------------------------------------------------------------------------------
+/// Launches kernel( k, i, j ) for each entry of variable-size tiles, where
+/// tile k is m[k]-by-n[k], with m and n arrays in GPU memory. Since only
+/// max_m is known on the host, each work-item loops over columns.
+///
+template <typename kernel_t>
+void parallel_for_vtiles(
+    blas::Queue& queue, int64_t const* m, int64_t const* n, int64_t max_m,
+    int64_t batch_count, kernel_t kernel )
+{
+    sycl::range<3> global( batch_count, ew_ny, round_up( max_m, ew_nx ) );
+    sycl::range<3> local( 1, ew_ny, ew_nx );
+    sycl_queue( queue ).parallel_for(
+        sycl::nd_range<3>( global, local ),
+        [=]( sycl::nd_item<3> item ) {
+            int64_t k = item.get_global_id( 0 );
+            int64_t i = item.get_global_id( 2 );
+            int64_t mk = m[ k ], nk = n[ k ];
+            if (i < mk) {
+                for (int64_t j = item.get_local_id( 1 ); j < nk; j += ew_ny)
+                    kernel( k, i, j );
+            }
+        });
+}
+
+//------------------------------------------------------------------------------
+/// max that propagates nan consistently:
+///     max_nan( 1,   nan ) = nan
+///     max_nan( nan, 1   ) = nan
+template <typename real_t>
+inline real_t max_nan( real_t x, real_t y )
+{
+    return (sycl::isnan( y ) || y >= x ? y : x);
+}
+
+//------------------------------------------------------------------------------
+/// Square of number.
+/// @return x^2
+template <typename scalar_t>
+inline scalar_t sqr( scalar_t x )
+{
+    return x*x;
+}
+
+//------------------------------------------------------------------------------
+/// Adds two scaled, sum-of-squares representations.
+/// On exit, scale1 and sumsq1 are updated such that:
+///     scale1^2 sumsq1 := scale1^2 sumsq1 + scale2^2 sumsq2.
+template <typename real_t>
+inline void combine_sumsq(
+    real_t& scale1, real_t& sumsq1,
+    real_t  scale2, real_t  sumsq2 )
+{
+    if (scale1 > scale2) {
+        sumsq1 = sumsq1 + sumsq2*sqr( scale2 / scale1 );
+        // scale1 stays same
+    }
+    else if (scale2 != 0) {
+        sumsq1 = sumsq1*sqr( scale1 / scale2 ) + sumsq2;
+        scale1 = scale2;
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Adds new value to scaled, sum-of-squares representation.
+/// On exit, scale and sumsq are updated such that:
+///     scale^2 sumsq := scale^2 sumsq + (absx)^2
+template <typename real_t>
+inline void add_sumsq(
+    real_t& scale, real_t& sumsq,
+    real_t absx )
+{
+    if (scale < absx) {
+        sumsq = 1 + sumsq * sqr( scale / absx );
+        scale = absx;
+    }
+    else if (scale != 0) {
+        sumsq = sumsq + sqr( absx / scale );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Overloaded versions of absolute value on device.
+/// For complex, hypot scales to avoid overflow, as LAPACK does,
+/// and propagates nan.
+inline float abs_val( float x )
+{
+    return sycl::fabs( x );
+}
+
+inline double abs_val( double x )
+{
+    return sycl::fabs( x );
+}
+
+inline float abs_val( std::complex<float> x )
+{
+    return sycl::hypot( x.real(), x.imag() );
+}
+
+inline double abs_val( std::complex<double> x )
+{
+    return sycl::hypot( x.real(), x.imag() );
+}
+
+//------------------------------------------------------------------------------
+/// Conjugate, if is_conj; identity for real types.
+template <typename scalar_t>
+inline scalar_t conj_if( bool is_conj, scalar_t x )
+{
+    return x;
+}
+
+template <typename real_t>
+inline std::complex<real_t> conj_if( bool is_conj, std::complex<real_t> x )
+{
+    return is_conj ? std::complex<real_t>( x.real(), -x.imag() ) : x;
+}
+
+//------------------------------------------------------------------------------
+/// @return max_nan of x over the sub-group, in every work-item,
+/// by butterfly shuffles.
+template <typename real_t>
+inline real_t sub_group_max_nan( sycl::sub_group sg, real_t x )
+{
+    for (int d = sg.get_local_range()[ 0 ] / 2; d > 0; d /= 2)
+        x = max_nan( x, sycl::permute_group_by_xor( sg, x, d ) );
+    return x;
+}
+
+//------------------------------------------------------------------------------
+/// Combines (scale, sumsq) over the sub-group, in every work-item,
+/// by butterfly shuffles.
+template <typename real_t>
+inline void sub_group_sumsq( sycl::sub_group sg, real_t& scale, real_t& sumsq )
+{
+    for (int d = sg.get_local_range()[ 0 ] / 2; d > 0; d /= 2) {
+        real_t scale2 = sycl::permute_group_by_xor( sg, scale, d );
+        real_t sumsq2 = sycl::permute_group_by_xor( sg, sumsq, d );
+        combine_sumsq( scale, sumsq, scale2, sumsq2 );
+    }
+}
+
+} // namespace device
+} // namespace slate
+
+#endif // BLAS_HAVE_SYCL
+
+#endif // SLATE_SYCL_UTIL_HH
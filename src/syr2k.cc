@@ -41,6 +41,7 @@ void syr2k(
 
     // Options
     int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    bool aggregate = get_option<Option::AggregateBcast>( opts, false );
 
     // if upper, change to lower
     if (C.uplo() == Uplo::Upper)
@@ -87,8 +88,14 @@ void syr2k(
                 bcast_list_B.push_back({i, 0, {C.sub(i, i, 0, i),
                                                C.sub(i, C.mt()-1, i, i)}});
             }
-            A.template listBcast<target>(bcast_list_A, layout);
-            B.template listBcast<target>(bcast_list_B, layout);
+            if (aggregate) {
+                A.template listBcastAggregated<target>(
+                    bcast_list_A, B, layout );
+            }
+            else {
+                A.template listBcast<target>(bcast_list_A, layout);
+                B.template listBcast<target>(bcast_list_B, layout);
+            }
         }
 
         // send next lookahead block cols of A
@@ -106,8 +113,14 @@ void syr2k(
                     bcast_list_B.push_back({i, k, {C.sub(i, i, 0, i),
                                                    C.sub(i, C.mt()-1, i, i)}});
                 }
-                A.template listBcast<target>(bcast_list_A, layout);
-                B.template listBcast<target>(bcast_list_B, layout);
+                if (aggregate) {
+                    A.template listBcastAggregated<target>(
+                        bcast_list_A, B, layout );
+                }
+                else {
+                    A.template listBcast<target>(bcast_list_A, layout);
+                    B.template listBcast<target>(bcast_list_B, layout);
+                }
             }
         }
 
@@ -152,8 +165,14 @@ void syr2k(
                             {i, k+lookahead, {C.sub(i, i, 0, i),
                                               C.sub(i, C.mt()-1, i, i)}});
                     }
-                    A.template listBcast<target>(bcast_list_A, layout);
-                    B.template listBcast<target>(bcast_list_B, layout);
+                    if (aggregate) {
+                        A.template listBcastAggregated<target>(
+                            bcast_list_A, B, layout );
+                    }
+                    else {
+                        A.template listBcast<target>(bcast_list_A, layout);
+                        B.template listBcast<target>(bcast_list_B, layout);
+                    }
                 }
             }
 
@@ -229,6 +248,10 @@ void syr2k(
 ///         - Option::Lookahead:
 ///           Number of blocks to overlap communication and computation.
 ///           lookahead >= 0. Default 1.
+///         - Option::AggregateBcast:
+///           Whether to send the tiles of A and B going to the same rank
+///           in one message; see BaseMatrix::listBcastAggregated.
+///           Default false.
 ///         - Option::Target:
 ///           Implementation to target. Possible values:
 ///           - HostTask:  OpenMP tasks on CPU host [default].
@@ -224,6 +224,143 @@ void tb2bd_run(TriangularBandMatrix<scalar_t>& A,
     }
 }
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Bidiagonal bulge chasing on a GPU, in one kernel launch.
+/// The band, including zeros for the bulges, is copied to LAPACK-style band
+/// storage on the device, reduced by device::tb2bd, and copied back with
+/// the Householder vectors. Requires band equal to the tile size.
+/// Without reflectors, they stay on the device, and only the bidiagonal
+/// is copied back, so the transfer back is O(n) instead of O(n^2).
+///
+/// @param[in,out] A
+///     The band matrix A, with workspace tiles set up as in tb2bd.
+///
+/// @param[out] U
+///     Matrix of Householder reflectors applied from the left.
+///     Not referenced if want_reflectors is false.
+///
+/// @param[out] V
+///     Matrix of Householder reflectors applied from the right.
+///     Not referenced if want_reflectors is false.
+///
+/// @param[in] want_reflectors
+///     Whether to copy the reflectors back to U and V.
+///
+template <typename scalar_t>
+void tb2bd_device(
+    TriangularBandMatrix<scalar_t>& A,
+    Matrix<scalar_t>& U,
+    Matrix<scalar_t>& V,
+    bool want_reflectors)
+{
+    int64_t m = A.m();
+    int64_t n = A.n();
+    int64_t nt = A.nt();
+    int64_t band = A.bandwidth();
+
+    int device = A.tileDevice( 0, 0 );
+    blas::Queue* queue = A.compute_queue( device );
+
+    // A(i, j), for -band < j - i < 2*band, is in
+    // dAB[ 2*band-1 + i - j + j*ldab ], so tile (i, j), including the
+    // lower triangle of diagonal tiles, is a 2D copy with leading
+    // dimension ldab-1.
+    int64_t ldab = 3*band - 1;
+    // Reflectors are stored as in svd's U2 and VT2.
+    int64_t ldu  = 2*band;
+    int64_t ldv  = 2*band;
+    int64_t nu   = nt*(nt + 1)/2*band;
+    int64_t nv   = nu;
+    if (want_reflectors) {
+        ldu = U.m();
+        ldv = V.m();
+        nu  = U.n();
+        nv  = V.n();
+    }
+    scalar_t* dAB = blas::device_malloc<scalar_t>( ldab*n, *queue );
+    scalar_t* dU  = blas::device_malloc<scalar_t>( ldu*nu, *queue );
+    scalar_t* dV  = blas::device_malloc<scalar_t>( ldv*nv, *queue );
+    int* dprogress = blas::device_malloc<int>( std::min( m, n ), *queue );
+    blas::device_memset( dAB, 0, ldab*n, *queue );
+    blas::device_memset( dU,  0, ldu*nu, *queue );
+    blas::device_memset( dV,  0, ldv*nv, *queue );
+    blas::device_memset( dprogress, 0xff, std::min( m, n ), *queue );  // -1
+
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = i; j < std::min( i+2, nt ); ++j) {
+            auto T = A( i, j );
+            blas::device_copy_matrix(
+                T.mb(), T.nb(), T.data(), T.stride(),
+                &dAB[ 2*band-1 + i*band + j*band*(ldab-1) ], ldab-1, *queue );
+        }
+    }
+
+    device::tb2bd( m, n, band, nt, dAB, ldab, dU, ldu, dV, ldv,
+                   dprogress, *queue );
+
+    if (! want_reflectors) {
+        // Copy back only the superdiagonal and diagonal, which are rows
+        // 2*band-2 and 2*band-1 of dAB, and zero the rest of the band.
+        int64_t diag_len = std::min( m, n );
+        std::vector<scalar_t> bidiag( 2*diag_len );
+        blas::device_copy_matrix(
+            2, diag_len, &dAB[ 2*band-2 ], ldab, bidiag.data(), 2, *queue );
+        queue->sync();
+
+        blas::device_free( dAB, *queue );
+        blas::device_free( dU, *queue );
+        blas::device_free( dV, *queue );
+        blas::device_free( dprogress, *queue );
+
+        for (int64_t i = 0; i < A.mt(); ++i) {
+            for (int64_t j = i; j < std::min( i+2, nt ); ++j) {
+                A.tileGetForWriting( i, j, LayoutConvert::ColMajor );
+                auto T = A( i, j );
+                lapack::laset( lapack::MatrixType::General, T.mb(), T.nb(),
+                               0, 0, T.data(), T.stride() );
+            }
+        }
+        for (int64_t k = 0; k < diag_len; ++k) {
+            int64_t i = k / band, ii = k % band;
+            A( i, i ).at( ii, ii ) = bidiag[ 2*k + 1 ];
+            if (k > 0) {
+                // A( k-1, k ) is in tile ( i, i ), or ( i-1, i ) if ii == 0.
+                if (ii > 0)
+                    A( i, i ).at( ii-1, ii ) = bidiag[ 2*k ];
+                else
+                    A( i-1, i ).at( band-1, 0 ) = bidiag[ 2*k ];
+            }
+        }
+        return;
+    }
+
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = i; j < std::min( i+2, nt ); ++j) {
+            auto T = A( i, j );
+            blas::device_copy_matrix(
+                T.mb(), T.nb(), &dAB[ 2*band-1 + i*band + j*band*(ldab-1) ],
+                ldab-1, T.data(), T.stride(), *queue );
+        }
+    }
+    for (int64_t t = 0; t < V.nt(); ++t) {
+        auto TU = U( 0, t );
+        blas::device_copy_matrix(
+            TU.mb(), TU.nb(), &dU[ t*band*ldu ], ldu,
+            TU.data(), TU.stride(), *queue );
+        auto TV = V( 0, t );
+        blas::device_copy_matrix(
+            TV.mb(), TV.nb(), &dV[ t*band*ldv ], ldv,
+            TV.data(), TV.stride(), *queue );
+    }
+    queue->sync();
+
+    blas::device_free( dAB, *queue );
+    blas::device_free( dU, *queue );
+    blas::device_free( dV, *queue );
+    blas::device_free( dprogress, *queue );
+}
+
 //------------------------------------------------------------------------------
 /// @internal
 /// Reduces a band matrix to a bidiagonal matrix using bulge chasing.
@@ -241,6 +378,9 @@ void tb2bd(
     int64_t diag_len = std::min(A.m(), A.n());
     int64_t band = A.bandwidth();
 
+    // Without U and V, the reflectors are only workspace.
+    bool want_reflectors = U.n() > 0 || V.n() > 0;
+
     omp_lock_t lock;
     omp_init_lock(&lock);
     Reflectors<scalar_t> reflectors;
@@ -297,6 +437,37 @@ void tb2bd(
         jj += A.tileNb(j);
     }
 
+    bool on_device = target == Target::Devices && A.tileIsLocal( 0, 0 )
+                     && A.num_devices() > 0
+                     && A.tileNb( 0 ) == band && A.tileMb( 0 ) == band
+                     && (! want_reflectors
+                         || (U.tileNb( 0 ) == band && V.tileNb( 0 ) == band));
+    if (on_device) {
+        tb2bd_device( A, U, V, want_reflectors );
+
+        omp_destroy_lock(&lock);
+        A.bandwidth(1);
+        return;
+    }
+
+    // The host version stores the reflectors, so allocate them locally
+    // if not wanted, as in svd.
+    Matrix<scalar_t> U_work = U, V_work = V;
+    if (! want_reflectors) {
+        int64_t nb = A.tileNb( 0 );
+        int64_t nt = A.nt();
+        int64_t vm = 2*nb;
+        int64_t vn = nt*(nt + 1)/2*nb;
+        U_work = Matrix<scalar_t>( vm, vn, vm, nb, 1, 1, A.mpiComm() );
+        V_work = Matrix<scalar_t>( vm, vn, vm, nb, 1, 1, A.mpiComm() );
+        if (A.tileIsLocal( 0, 0 )) {
+            U_work.insertLocalTiles();
+            V_work.insertLocalTiles();
+        }
+        set( zero, U_work );
+        set( zero, V_work );
+    }
+
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
@@ -320,7 +491,7 @@ void tb2bd(
         #endif
         for (int thread_rank = 0; thread_rank < thread_size; ++thread_rank) {
             tb2bd_run(A,
-                      U, V,
+                      U_work, V_work,
                       band, diag_len,
                       pass_size,
                       thread_rank, thread_size,
@@ -347,6 +518,15 @@ void tb2bd(
 /// @param[in,out] A
 ///         The band matrix A.
 ///
+/// @param[out] U
+///         Householder reflectors applied from the left, as used by
+///         unmbr_tb2bd. If U and V are empty, the reflectors are not
+///         returned; with Target::Devices they then stay on the device,
+///         and only the bidiagonal is copied back to A.
+///
+/// @param[out] V
+///         Householder reflectors applied from the right.
+///
 /// @param[in] opts
 ///         Additional options, as map of name = value pairs. Possible options:
 ///         - Option::Target:
@@ -354,7 +534,8 @@ void tb2bd(
 ///           - HostTask:  OpenMP tasks on CPU host [default].
 ///           - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///           - HostBatch: batched BLAS on CPU host.
-///           - Devices:   batched BLAS on GPU device.
+///           - Devices:   bulge chasing kernel on GPU device, if the
+///             bandwidth is the tile size; otherwise as HostTask.
 ///
 /// @ingroup svd_computational
 ///
@@ -13,6 +13,140 @@ namespace slate {
 
 namespace impl {
 
+//------------------------------------------------------------------------------
+/// @internal
+/// Wavefront triangular band solve with pivoting, for host targets.
+/// Each tile column of B advances through the band in its own chain of
+/// tasks; at each step it applies that step's pivots to its column, then
+/// does the solve and update, so independent right-hand sides proceed
+/// concurrently instead of synchronizing all of B on every panel.
+/// Broadcasts of A run in a separate chain, ahead of the columns.
+/// Communication for B(:, j) uses MPI tag 1 + j; A uses tag 0.
+/// Called from within an omp parallel master region.
+/// @ingroup tbsm_impl
+///
+template <typename scalar_t>
+void tbsm_wavefront(
+    TriangularBandMatrix<scalar_t>& A, Pivots& pivots,
+              Matrix<scalar_t>& B,
+    int64_t kdt )
+{
+    using blas::min;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+
+    const scalar_t one = 1.0;
+    const Layout layout = Layout::ColMajor;
+    const int priority_1 = 1;
+
+    int64_t mt = B.mt();
+    int64_t nt = B.nt();
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector<uint8_t> panel_vector(mt);
+    std::vector<uint8_t> col_vector(nt);
+    uint8_t* panel = panel_vector.data();
+    uint8_t* col = col_vector.data();
+    SLATE_UNUSED( panel ); // Used only by OpenMP
+    SLATE_UNUSED( col );   // Used only by OpenMP
+
+    bool forward = A.uplo() == Uplo::Lower;
+    int64_t lastk = forward ? 0 : mt-1;
+    SLATE_UNUSED( lastk );
+    for (int64_t kk = 0; kk < mt; ++kk) {
+        int64_t k = forward ? kk : mt-1-kk;
+
+        // Forward:  A(k:i_end-1, k) is the panel, sent to block rows
+        //           B(k:i_end-1, :).
+        // Backward: A(k, k:k_end-1) is the k-th row, sent to block row
+        //           B(k, :).
+        int64_t i_end = min(k + kdt + 1, mt);
+        int64_t k_end = min(k + kdt + 1, A.nt());
+
+        #pragma omp task depend(in:panel[lastk]) depend(inout:panel[k]) \
+                         priority(1)
+        {
+            BcastList bcast_list_A;
+            if (forward) {
+                for (int64_t i = k; i < i_end; ++i)
+                    bcast_list_A.push_back({i, k, {B.sub(i, i, 0, nt-1)}});
+            }
+            else {
+                for (int64_t i = k; i < k_end; ++i)
+                    bcast_list_A.push_back({k, i, {B.sub(k, k, 0, nt-1)}});
+            }
+            A.template listBcast(bcast_list_A, layout);
+        }
+
+        for (int64_t j = 0; j < nt; ++j) {
+            #pragma omp task depend(in:panel[k]) depend(inout:col[j])
+            {
+                int tag = 1 + j;
+                if (forward) {
+                    // swap rows in B(k:mt-1, j), then
+                    // solve A(k, k) B(k, j) = B(k, j)
+                    internal::permuteRows<Target::HostTask>(
+                        Direction::Forward, B.sub(k, mt-1, j, j),
+                        pivots.at(k), layout, priority_1, tag);
+
+                    internal::trsm<Target::HostTask>(
+                        Side::Left,
+                        one, A.sub(k, k),
+                             B.sub(k, k, j, j),
+                        priority_1, layout );
+
+                    if (k+1 < i_end) {
+                        // B(k+1:i_end-1, j) -= A(k+1:i_end-1, k) B(k, j)
+                        B.template tileBcast(
+                            k, j, B.sub(k+1, i_end-1, j, j), layout, tag);
+
+                        internal::gemm<Target::HostTask>(
+                            -one, A.sub(k+1, i_end-1, k, k),
+                                  B.sub(k, k, j, j),
+                            one,  B.sub(k+1, i_end-1, j, j),
+                            layout, priority_1 );
+
+                        B.sub(k, k, j, j).releaseRemoteWorkspace();
+                    }
+                }
+                else {
+                    if (k+1 < k_end) {
+                        // B(k, j) -= A(k, k+1:k_end-1) B(k+1:k_end-1, j)
+                        BcastList bcast_list_B;
+                        for (int64_t i = k+1; i < k_end; ++i)
+                            bcast_list_B.push_back({i, j, {B.sub(k, k, j, j)}});
+                        B.template listBcast(bcast_list_B, layout, tag);
+
+                        for (int64_t i = k+1; i < k_end; ++i) {
+                            internal::gemm<Target::HostTask>(
+                                -one, A.sub(k, k, i, i),
+                                      B.sub(i, i, j, j),
+                                one,  B.sub(k, k, j, j),
+                                layout, priority_1 );
+                        }
+                        B.sub(k+1, k_end-1, j, j).releaseRemoteWorkspace();
+                    }
+
+                    // solve A(k, k) B(k, j) = B(k, j), then
+                    // swap rows in B(k:mt-1, j)
+                    internal::trsm<Target::HostTask>(
+                        Side::Left,
+                        one, A.sub(k, k),
+                             B.sub(k, k, j, j),
+                        priority_1, layout );
+
+                    internal::permuteRows<Target::HostTask>(
+                        Direction::Backward, B.sub(k, mt-1, j, j),
+                        pivots.at(k), layout, priority_1, tag);
+                }
+            }
+        }
+        lastk = k;
+    }
+
+    #pragma omp taskwait
+    A.releaseRemoteWorkspace();
+}
+
 //------------------------------------------------------------------------------
 /// @internal
 /// Distributed parallel triangular matrix solve.
@@ -107,7 +241,14 @@ void tbsm(
             }
         }
 
-        if (A.uplo() == Uplo::Lower) {
+        if (! pivots.empty() && target != Target::Devices) {
+            // ----------------------------------------
+            // With pivoting on host, each RHS tile column advances
+            // through the band concurrently.
+            #pragma omp taskwait
+            tbsm_wavefront( A, pivots, B, kdt );
+        }
+        else if (A.uplo() == Uplo::Lower) {
             // ----------------------------------------
             // Lower/NoTrans or Upper/Trans, Left case
             // Forward sweep
@@ -386,6 +527,10 @@ void tbsm(
 ///     auto AT = slate::transpose( A );
 ///     slate::tbsm( Side::Left, alpha, AT, pivots, B );
 ///
+/// With pivoting on host targets, each tile column of B is solved in
+/// its own chain of tasks, with the pivots applied to that column at each
+/// step, so many right-hand sides are solved concurrently.
+///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///         One of float, double, std::complex<float>, std::complex<double>.
@@ -0,0 +1,495 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/TileLowRankMatrix.hh"
+#include "internal/Tile_tlr.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// @internal
+/// Checks that B's block rows match A's tiles and that all of B's tiles
+/// are on this process, then gets them on the host for writing.
+///
+template <typename scalar_t>
+void tlr_get_rhs( TileLowRankMatrix<scalar_t>& A, Matrix<scalar_t>& B )
+{
+    slate_assert( B.mt() == A.nt() );
+    for (int64_t i = 0; i < B.mt(); ++i) {
+        slate_assert( B.tileMb( i ) == A.tileNb( i ) );
+        for (int64_t j = 0; j < B.nt(); ++j) {
+            if (! B.tileIsLocal( i, j ))
+                slate_error( "tlr: all tiles must be on this process" );
+        }
+    }
+    B.tileGetAllForWriting( HostNum, LayoutConvert::ColMajor );
+}
+
+} // namespace impl
+
+namespace tlr {
+
+//------------------------------------------------------------------------------
+/// Compresses Hermitian matrix A into a tile-low-rank matrix. Diagonal
+/// tiles are kept dense; off-diagonal tiles are truncated at singular
+/// values <= $tol \|A\|_F / nt$, so the error is about $tol \|A\|_F$.
+///
+/// All tiles of A must be on the calling process; see TileLowRankMatrix.
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     The n-by-n Hermitian matrix A. Only Uplo::Lower is supported.
+///
+/// @param[in] tol
+///     Relative truncation tolerance, e.g., 1e-8.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Unused.
+///
+/// @return the compressed matrix.
+///
+/// @ingroup tlr
+///
+template <typename scalar_t>
+TileLowRankMatrix<scalar_t> compress(
+    HermitianMatrix<scalar_t>& A,
+    blas::real_type<scalar_t> tol,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    slate_assert( A.uplo() == Uplo::Lower );
+    slate_assert( A.op() == Op::NoTrans );
+
+    int64_t nt = A.nt();
+    std::vector<int64_t> tile_nb( nt );
+    for (int64_t j = 0; j < nt; ++j) {
+        tile_nb[ j ] = A.tileNb( j );
+        for (int64_t i = j; i < nt; ++i) {
+            if (! A.tileIsLocal( i, j ))
+                slate_error( "tlr: all tiles must be on this process" );
+        }
+    }
+
+    real_t Anorm = norm( Norm::Fro, A, opts );
+    TileLowRankMatrix<scalar_t> T( tile_nb, tol * Anorm / std::max( nt, int64_t( 1 ) ) );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        #pragma omp taskgroup
+        for (int64_t j = 0; j < nt; ++j) {
+            for (int64_t i = j; i < nt; ++i) {
+                #pragma omp task shared( A, T ) firstprivate( i, j )
+                {
+                    A.tileGetForReading( i, j, LayoutConvert::ColMajor );
+                    auto Aij = A( i, j );
+                    if (i == j) {
+                        auto Tjj = T.diag( j );
+                        lapack::lacpy( lapack::MatrixType::General,
+                                       Aij.mb(), Aij.nb(),
+                                       Aij.data(), Aij.stride(),
+                                       Tjj.data(), Tjj.stride() );
+                    }
+                    else {
+                        tile::tlr_compress( Aij, T.tolerance(),
+                                            T.offdiag( i, j ) );
+                    }
+                }
+            }
+        }
+    }
+
+    return T;
+}
+
+//------------------------------------------------------------------------------
+/// Cholesky factorization $A = L L^H$ of a tile-low-rank matrix, in place.
+/// Off-diagonal tiles of L stay low rank: trailing updates are added to
+/// their factors and recompressed at A.tolerance().
+///
+/// Runs the tile Cholesky task graph with OpenMP task dependencies on
+/// the tiles, on the host.
+//------------------------------------------------------------------------------
+/// @param[in,out] A
+///     On entry, the TLR matrix A. On exit, its Cholesky factor L.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Unused.
+///
+/// @return 0: successful exit
+/// @return i > 0: the leading minor of order i of A is not
+///         positive definite, so the factorization could not
+///         be completed.
+///
+/// @ingroup tlr
+///
+template <typename scalar_t>
+int64_t potrf(
+    TileLowRankMatrix<scalar_t>& A,
+    Options const& opts)
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    const real_t r_one = 1.0;
+
+    int64_t nt = A.nt();
+    real_t tol = A.tolerance();
+
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > tile_vector( nt*nt );
+    uint8_t* tile = tile_vector.data();
+    SLATE_UNUSED( tile ); // Used only by OpenMP
+
+    std::vector<int64_t> offset( nt+1, 0 );
+    for (int64_t j = 0; j < nt; ++j)
+        offset[ j+1 ] = offset[ j ] + A.tileNb( j );
+
+    int64_t info = 0;
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t k = 0; k < nt; ++k) {
+            // factor diagonal tile
+            #pragma omp task depend( inout:tile[ k + k*nt ] ) \
+                shared( A, info, offset ) firstprivate( k )
+            {
+                auto Akk = A.diag( k );
+                int64_t iinfo = lapack::potrf( Uplo::Lower, Akk.nb(),
+                                               Akk.data(), Akk.stride() );
+                if (iinfo != 0) {
+                    #pragma omp critical(slate_tlr_info)
+                    {
+                        if (info == 0)
+                            info = offset[ k ] + iinfo;
+                    }
+                }
+            }
+
+            // panel: A(i, k) = A(i, k) L(k, k)^{-H}
+            for (int64_t i = k+1; i < nt; ++i) {
+                #pragma omp task depend( in:tile[ k + k*nt ] ) \
+                    depend( inout:tile[ i + k*nt ] ) \
+                    shared( A ) firstprivate( i, k )
+                {
+                    tile::tlr_trsm( A.diag( k ), A.offdiag( i, k ) );
+                }
+            }
+
+            // trailing update: A(i, j) -= A(i, k) A(j, k)^H
+            for (int64_t i = k+1; i < nt; ++i) {
+                #pragma omp task depend( in:tile[ i + k*nt ] ) \
+                    depend( inout:tile[ i + i*nt ] ) \
+                    shared( A ) firstprivate( i, k )
+                {
+                    tile::tlr_herk( -r_one, A.offdiag( i, k ), A.diag( i ) );
+                }
+
+                for (int64_t j = k+1; j < i; ++j) {
+                    #pragma omp task depend( in:tile[ i + k*nt ] ) \
+                        depend( in:tile[ j + k*nt ] ) \
+                        depend( inout:tile[ i + j*nt ] ) \
+                        shared( A ) firstprivate( i, j, k, tol )
+                    {
+                        tile::tlr_gemm( scalar_t( -1.0 ), A.offdiag( i, k ),
+                                                         A.offdiag( j, k ),
+                                        A.offdiag( i, j ), tol );
+                    }
+                }
+            }
+        }
+    }
+
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Triangular solve $op(L) X = B$, where L is the Cholesky factor of a
+/// tile-low-rank matrix from tlr::potrf, and B is overwritten by X.
+//------------------------------------------------------------------------------
+/// @param[in] op
+///     - Op::NoTrans:   solve $L X = B$;
+///     - Op::ConjTrans: solve $L^H X = B$.
+///
+/// @param[in] A
+///     The factor L from tlr::potrf.
+///
+/// @param[in,out] B
+///     On entry, the n-by-nrhs right-hand sides, with block rows matching
+///     A's tiles and all tiles on the calling process.
+///     On exit, the solution X.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Unused.
+///
+/// @ingroup tlr
+///
+template <typename scalar_t>
+void trsm(
+    Op op,
+    TileLowRankMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts)
+{
+    const scalar_t one = 1.0;
+
+    slate_assert( op == Op::NoTrans || op == Op::ConjTrans );
+    impl::tlr_get_rhs( A, B );
+
+    int64_t nt = A.nt();
+    int64_t B_nt = B.nt();
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        #pragma omp taskgroup
+        for (int64_t c = 0; c < B_nt; ++c) {
+            // Block columns of B are independent.
+            #pragma omp task shared( A, B ) firstprivate( c, op, nt )
+            {
+                for (int64_t kk = 0; kk < nt; ++kk) {
+                    // forward for L, backward for L^H
+                    int64_t k = (op == Op::NoTrans ? kk : nt-1 - kk);
+                    auto Akk = A.diag( k );
+                    auto Bkc = B( k, c );
+                    blas::trsm( blas::Layout::ColMajor, Side::Left,
+                                Uplo::Lower, op, Diag::NonUnit,
+                                Bkc.mb(), Bkc.nb(),
+                                one, Akk.data(), Akk.stride(),
+                                     Bkc.data(), Bkc.stride() );
+
+                    if (op == Op::NoTrans) {
+                        // B(i, c) -= L(i, k) B(k, c), i > k
+                        for (int64_t i = k+1; i < nt; ++i) {
+                            tile::tlr_gemm( Op::NoTrans,
+                                            -one, A.offdiag( i, k ), Bkc,
+                                            one,  B( i, c ) );
+                        }
+                    }
+                    else {
+                        // B(i, c) -= L(k, i)^H B(k, c), i < k
+                        for (int64_t i = 0; i < k; ++i) {
+                            tile::tlr_gemm( Op::ConjTrans,
+                                            -one, A.offdiag( k, i ), Bkc,
+                                            one,  B( i, c ) );
+                        }
+                    }
+                }
+            }
+        }
+        B.tileUpdateAllOrigin();
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Solves $A X = B$ using the Cholesky factor of a tile-low-rank matrix
+/// from tlr::potrf; B is overwritten by X.
+///
+/// @see tlr::trsm for the arguments.
+///
+/// @ingroup tlr
+///
+template <typename scalar_t>
+void potrs(
+    TileLowRankMatrix<scalar_t>& A,
+    Matrix<scalar_t>& B,
+    Options const& opts)
+{
+    trsm( Op::NoTrans,   A, B, opts );
+    trsm( Op::ConjTrans, A, B, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Hermitian matrix multiply $C = \alpha A B + \beta C$, where A is a
+/// tile-low-rank matrix from tlr::compress (not factored).
+//------------------------------------------------------------------------------
+/// @param[in] alpha
+///     The scalar alpha.
+///
+/// @param[in] A
+///     The n-by-n TLR matrix A.
+///
+/// @param[in] B
+///     The n-by-nrhs matrix B, with block rows matching A's tiles and all
+///     tiles on the calling process.
+///
+/// @param[in] beta
+///     The scalar beta.
+///
+/// @param[in,out] C
+///     The n-by-nrhs matrix C, distributed as B.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Unused.
+///
+/// @ingroup tlr
+///
+template <typename scalar_t>
+void hemm(
+    scalar_t alpha, TileLowRankMatrix<scalar_t>& A,
+                    Matrix<scalar_t>& B,
+    scalar_t beta,  Matrix<scalar_t>& C,
+    Options const& opts)
+{
+    const scalar_t one = 1.0;
+
+    impl::tlr_get_rhs( A, B );
+    impl::tlr_get_rhs( A, C );
+    slate_assert( B.n() == C.n() );
+
+    int64_t nt = A.nt();
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        #pragma omp taskgroup
+        for (int64_t c = 0; c < C.nt(); ++c) {
+            for (int64_t i = 0; i < nt; ++i) {
+                // Each tile of C is computed by one task.
+                #pragma omp task shared( A, B, C ) \
+                    firstprivate( c, i, nt, alpha, beta )
+                {
+                    auto Aii = A.diag( i );
+                    auto Bic = B( i, c );
+                    auto Cic = C( i, c );
+                    blas::hemm( blas::Layout::ColMajor, Side::Left, Uplo::Lower,
+                                Cic.mb(), Cic.nb(),
+                                alpha, Aii.data(), Aii.stride(),
+                                       Bic.data(), Bic.stride(),
+                                beta,  Cic.data(), Cic.stride() );
+                    for (int64_t j = 0; j < i; ++j) {
+                        tile::tlr_gemm( Op::NoTrans,
+                                        alpha, A.offdiag( i, j ), B( j, c ),
+                                        one,   C( i, c ) );
+                    }
+                    for (int64_t j = i+1; j < nt; ++j) {
+                        tile::tlr_gemm( Op::ConjTrans,
+                                        alpha, A.offdiag( j, i ), B( j, c ),
+                                        one,   C( i, c ) );
+                    }
+                }
+            }
+        }
+        C.tileUpdateAllOrigin();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+TileLowRankMatrix<float> compress<float>(
+    HermitianMatrix<float>& A, float tol, Options const& opts);
+
+template
+TileLowRankMatrix<double> compress<double>(
+    HermitianMatrix<double>& A, double tol, Options const& opts);
+
+template
+TileLowRankMatrix< std::complex<float> > compress< std::complex<float> >(
+    HermitianMatrix< std::complex<float> >& A, float tol, Options const& opts);
+
+template
+TileLowRankMatrix< std::complex<double> > compress< std::complex<double> >(
+    HermitianMatrix< std::complex<double> >& A, double tol, Options const& opts);
+
+// ----------------------------------------
+template
+int64_t potrf<float>(
+    TileLowRankMatrix<float>& A, Options const& opts);
+
+template
+int64_t potrf<double>(
+    TileLowRankMatrix<double>& A, Options const& opts);
+
+template
+int64_t potrf< std::complex<float> >(
+    TileLowRankMatrix< std::complex<float> >& A, Options const& opts);
+
+template
+int64_t potrf< std::complex<double> >(
+    TileLowRankMatrix< std::complex<double> >& A, Options const& opts);
+
+// ----------------------------------------
+template
+void trsm<float>(
+    Op op, TileLowRankMatrix<float>& A, Matrix<float>& B,
+    Options const& opts);
+
+template
+void trsm<double>(
+    Op op, TileLowRankMatrix<double>& A, Matrix<double>& B,
+    Options const& opts);
+
+template
+void trsm< std::complex<float> >(
+    Op op, TileLowRankMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void trsm< std::complex<double> >(
+    Op op, TileLowRankMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+// ----------------------------------------
+template
+void potrs<float>(
+    TileLowRankMatrix<float>& A, Matrix<float>& B,
+    Options const& opts);
+
+template
+void potrs<double>(
+    TileLowRankMatrix<double>& A, Matrix<double>& B,
+    Options const& opts);
+
+template
+void potrs< std::complex<float> >(
+    TileLowRankMatrix< std::complex<float> >& A,
+    Matrix< std::complex<float> >& B,
+    Options const& opts);
+
+template
+void potrs< std::complex<double> >(
+    TileLowRankMatrix< std::complex<double> >& A,
+    Matrix< std::complex<double> >& B,
+    Options const& opts);
+
+// ----------------------------------------
+template
+void hemm<float>(
+    float alpha, TileLowRankMatrix<float>& A, Matrix<float>& B,
+    float beta,  Matrix<float>& C,
+    Options const& opts);
+
+template
+void hemm<double>(
+    double alpha, TileLowRankMatrix<double>& A, Matrix<double>& B,
+    double beta,  Matrix<double>& C,
+    Options const& opts);
+
+template
+void hemm< std::complex<float> >(
+    std::complex<float> alpha, TileLowRankMatrix< std::complex<float> >& A,
+                               Matrix< std::complex<float> >& B,
+    std::complex<float> beta,  Matrix< std::complex<float> >& C,
+    Options const& opts);
+
+template
+void hemm< std::complex<double> >(
+    std::complex<double> alpha, TileLowRankMatrix< std::complex<double> >& A,
+                                Matrix< std::complex<double> >& B,
+    std::complex<double> beta,  Matrix< std::complex<double> >& C,
+    Options const& opts);
+
+} // namespace tlr
+} // namespace slate
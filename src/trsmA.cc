@@ -25,7 +25,13 @@ void trsmA(
 {
     // Options
     int64_t lookahead = get_option<int64_t>(opts, Option::Lookahead, 1);
+    Workspace* workspace = get_option<Workspace*>(opts, Option::Workspace, nullptr);
 
+    // Collective; node grouping for Option::HierarchicalBcast.
+    if (get_option<Option::HierarchicalBcast>( opts, false ))
+        internal::commNodes( B.mpiComm() );
+
+    WorkspaceGuard<scalar_t> workspace_guard_A( A );
     if (target == Target::Devices) {
         if (A.num_devices() > 1)
             slate_not_implemented( "trsmA doesn't support multiple GPUs" );
@@ -43,6 +49,7 @@ void trsmA(
         // for every execution for the internal::gemm with lookahead
         const int64_t batch_size_0 = 0;
         const int64_t num_queues = 2 + lookahead;
+        A.attachWorkspace( workspace );
         A.allocateBatchArrays( batch_size_0, num_queues );
         A.reserveDeviceWorkspace();
     }
@@ -123,6 +130,13 @@ void trsmA(
 ///           - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///           - HostBatch: batched BLAS on CPU host.
 ///           - Devices:   batched BLAS on GPU device.
+///         - Option::AggregateBcast:
+///           Whether to send all tiles of B going to the same rank in one
+///           message; see BaseMatrix::listBcastAggregated. Default false.
+///
+///         - Option::HierarchicalBcast:
+///           Whether to broadcast tiles between nodes first, then within
+///           nodes; see internal::hierarchicalBcastPattern. Default false.
 ///
 /// @ingroup trsm
 ///
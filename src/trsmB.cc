@@ -25,7 +25,14 @@ void trsmB(
 {
     // Options
     int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+    Workspace* workspace = get_option<Workspace*>( opts, Option::Workspace, nullptr );
+    int64_t groups = get_option<int64_t>( opts, Option::ColumnGroups, 1 );
 
+    // Right-hand sides are columns of B if side = left, else rows.
+    int64_t nrhs_tiles = side == Side::Left ? B.nt() : B.mt();
+    groups = std::max( std::min( groups, nrhs_tiles ), int64_t( 1 ) );
+
+    WorkspaceGuard<scalar_t> workspace_guard_B( B );
     if (target == Target::Devices) {
         // Allocate batch arrays = number of kernels without
         // lookahead + lookahead
@@ -44,14 +51,16 @@ void trsmB(
         // 1) trsm                            (         1 )
         // 2) gemm for trailing matrix update (         1 )
         // 3) lookahead number of gemm's      ( lookahead )
+        // for each group of right-hand sides.
         const int64_t batch_size_default = 0;
-        int num_queues = 2 + lookahead;
+        int num_queues = groups * (2 + lookahead);
+        B.attachWorkspace( workspace );
         B.allocateBatchArrays( batch_size_default, num_queues );
         B.reserveDeviceWorkspace();
     }
 
     // OpenMP needs pointer types, but vectors are exception safe
-    std::vector<uint8_t> row_vector( A.nt() );
+    std::vector<uint8_t> row_vector( groups * A.nt() );
     uint8_t* row = row_vector.data();
 
     // set min number for omp nested active parallel regions
@@ -62,7 +71,13 @@ void trsmB(
     {
         #pragma omp task
         {
-            work::trsm<target, scalar_t>( side, alpha, A, B, row, opts );
+            if (groups > 1) {
+                work::trsm_groups<target, scalar_t>(
+                    side, alpha, A, B, row, groups, opts );
+            }
+            else {
+                work::trsm<target, scalar_t>( side, alpha, A, B, row, opts );
+            }
             B.tileUpdateAllOrigin();
         }
     }
@@ -113,6 +128,11 @@ void trsmB(
 ///         - Option::Lookahead:
 ///           Number of panels to overlap with matrix updates.
 ///           lookahead >= 0. Default 1.
+///         - Option::ColumnGroups:
+///           Number of groups the right-hand sides are split into, each
+///           solved with its own lookahead and dependencies, while A is
+///           broadcast once for all. Useful when B has many more block
+///           columns than A. groups >= 1. Default 1.
 ///         - Option::Target:
 ///           Implementation to target. Possible values:
 ///           - HostTask:  OpenMP tasks on CPU host [default].
@@ -16,7 +16,8 @@ namespace impl {
 //------------------------------------------------------------------------------
 /// Distributed parallel inverse of a triangular matrix.
 /// Generic implementation for any target.
-/// Panel and lookahead computed on host using Host OpenMP task.
+/// Panel and lookahead computed on host using Host OpenMP task,
+/// or for Devices on the devices, including the diagonal tile inversions.
 /// @ingroup trtri_impl
 ///
 template <Target target, typename scalar_t>
@@ -32,6 +33,13 @@ void trtri(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
+    // With Devices, the panel, lookahead, and diagonal tiles also stay on
+    // the devices, instead of each diagonal tile going to the host and back.
+    // Those tasks lease queues from the pool (AnyQueue); the trailing
+    // update uses queue 0.
+    constexpr Target target_tile = (target == Target::Devices
+                                    ? Target::Devices : Target::HostTask);
+
     // Options
     int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
 
@@ -70,10 +78,10 @@ void trtri(
                 A.tileBcast(0, 0, A.sub(1, A_nt-1, 0, 0), layout, tag);
 
                 // A(1:nt-1, 0) * A(0, 0)^{-H}
-                internal::trsm<Target::HostTask>(
+                internal::trsm<target_tile>(
                     Side::Right,
                     -one, A.sub(0, 0), A.sub(1, A_nt-1, 0, 0),
-                    priority_0, layout );
+                    priority_0, layout, AnyQueue );
             }
             ++tag;
 
@@ -97,7 +105,7 @@ void trtri(
         // invert A(0, 0)
         #pragma omp task depend(inout:col[0])
         {
-            internal::trtri<Target::HostTask>(A.sub(0, 0));
+            internal::trtri<target_tile>(A.sub(0, 0), priority_0, AnyQueue);
         }
 
         // next lookahead columns trsms
@@ -110,10 +118,10 @@ void trtri(
                 A.tileBcast(k, k, A.sub(k+1, A_nt-1, k, k), layout, tag);
 
                 // leading column trsm, A(k+1:nt-1, k) * A(k, k)^{-H}
-                internal::trsm<Target::HostTask>(
+                internal::trsm<target_tile>(
                     Side::Right,
                     -one, A.sub(k, k), A.sub(k+1, A_nt-1, k, k),
-                    priority_0, layout );
+                    priority_0, layout, AnyQueue );
 
                 // send leading column to the left
                 BcastList bcast_list_A;
@@ -142,12 +150,12 @@ void trtri(
 
                     // leading column trsm,
                     // A(k+1+la:nt-1, k+la) * A(k+la, k+la)^{-H}
-                    internal::trsm<Target::HostTask>(
+                    internal::trsm<target_tile>(
                         Side::Right,
                         -one, A.sub(k+lookahead, k+lookahead),
                               A.sub(k+1+lookahead, A_nt-1,
                                     k+lookahead, k+lookahead),
-                        priority_0, layout );
+                        priority_0, layout, AnyQueue );
 
                     // send leading column to the left
                     BcastList bcast_list_A;
@@ -173,11 +181,11 @@ void trtri(
                                  depend(inout:row[i]) firstprivate(tag)
                 {
                     // A(i, 0:k-1) += A(i, k) * A(k, 0:k-1)
-                    internal::gemm<Target::HostTask>(
+                    internal::gemm<target_tile>(
                         one, A.sub(i, i, k, k),
                              A.sub(k, k, 0, k-1),
                         one, A.sub(i, i, 0, k-1),
-                        layout, priority_0 );
+                        layout, priority_0, AnyQueue );
 
                     if (i+1 < A_nt) {
                         // send the row down
@@ -230,13 +238,13 @@ void trtri(
                 A.tileBcast(k, k, A.sub(k, k, 0, k-1), layout, tag);
 
                 // solve A(k, k) A(k, :) = A(k, 0:k-1)
-                internal::trsm<Target::HostTask>(
+                internal::trsm<target_tile>(
                     Side::Left,
                     one, A.sub(k, k), A.sub(k, k, 0, k-1),
-                    priority_0, layout );
+                    priority_0, layout, AnyQueue );
 
                 // invert A(k, k)
-                internal::trtri<Target::HostTask>(A.sub(k, k));
+                internal::trtri<target_tile>(A.sub(k, k), priority_0, AnyQueue);
             }
             ++tag;
 
@@ -36,6 +36,12 @@ void trtrm(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
 
+    // With Devices, the diagonal tiles and the row trmm also stay on the
+    // devices, instead of each diagonal tile going to the host and back.
+    // The tasks are serialized, so all use queue 0.
+    constexpr Target target_tile = (target == Target::Devices
+                                    ? Target::Devices : Target::HostTask);
+
     // if upper, change to lower
     if (A.uplo() == Uplo::Upper) {
         A = conj_transpose( A );
@@ -62,7 +68,7 @@ void trtrm(
         #pragma omp task depend(inout:row[0])
         {
             // A(0, 0) = A(0, 0)^H * A(0, 0)
-            internal::trtrm<Target::HostTask>(A.sub(0, 0));
+            internal::trtrm<target_tile>(A.sub(0, 0), priority_0, queue_0);
         }
 
         for (int64_t k = 1; k < A_nt; ++k) {
@@ -104,17 +110,17 @@ void trtrm(
                 // A(k, 0:k-1) = A(k, 0:k-1) * A(k, k)^H
                 auto Akk = A.sub(k, k);
                 Akk = conj_transpose( Akk );
-                internal::trmm<Target::HostTask>(
+                internal::trmm<target_tile>(
                     Side::Left,
                     one, std::move( Akk ), A.sub(k, k, 0, k-1),
-                    priority_0 );
+                    priority_0, queue_0 );
             }
 
             // diagonal block, L = L^H L
             #pragma omp task depend(inout:row[0]) depend(inout:row[k])
             {
                 // A(k, k) = A(k, k)^H * A(k, k)
-                internal::trtrm<Target::HostTask>(A.sub(k, k));
+                internal::trtrm<target_tile>(A.sub(k, k), priority_0, queue_0);
             }
 
             #pragma omp task depend(inout:row[k])
@@ -0,0 +1,298 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel generation of Q from LQ factorization.
+/// Generic implementation for any target.
+/// @ingroup gelqf_impl
+///
+template <Target target, typename scalar_t>
+void unglq(
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts )
+{
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const Side side = Side::Right;
+    const Op op = Op::NoTrans;
+
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+    const int64_t tag_0 = 0;
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t Q_mt = Q.mt();
+    int64_t Q_nt = Q.nt();
+
+    // Q has A's block columns, and its block rows match them, so that
+    // Q(0:k-1, k:nt-1) stays zero while applying Hk.
+    slate_assert( Q_nt == A_nt );
+    for (int64_t i = 0; i < std::min( Q_mt, Q_nt ) - 1; ++i) {
+        slate_assert( Q.tileMb( i ) == A.tileNb( i ) );
+    }
+
+    // Reflectors k >= Q_mt don't touch the first Q_mt block rows.
+    int64_t k_end = std::min( std::min( A_mt, A_nt ), Q_mt );
+
+    if (target == Target::Devices) {
+        Q.allocateBatchArrays();
+        Q.reserveDeviceWorkspace();
+    }
+
+    // Reserve workspace
+    auto W = Q.emptyLike();
+
+    if (target == Target::Devices) {
+        W.allocateBatchArrays();
+    }
+
+    assert(T.size() == 2);
+    auto Tlocal  = T[0];
+    auto Treduce = T[1];
+
+    // Q = I.
+    set( zero, one, Q, opts );
+
+    // LQ tracks dependencies by block-row.
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > block_vector(A_mt);
+    uint8_t* block = block_vector.data();
+    SLATE_UNUSED( block ); // Used only by OpenMP
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        // Q = I HK ... H1, applied in reverse order of how Hk's were
+        // created. Before applying Hk, Q(k:mt-1, k:nt-1) is the only
+        // non-identity block in cols k:nt-1, so Hk is applied to the
+        // trailing Q(k:mt-1, k:nt-1) only, skipping zero tiles, about
+        // half the flops of unmlq on I.
+        int64_t lastk = k_end-1;
+        // OpenMP uses lastk; compiler doesn't, so warns it is unused.
+        SLATE_UNUSED(lastk);
+        for (int64_t k = k_end-1; k >= 0; --k) {
+
+            auto A_panel = A.sub(k, k, k, A_nt-1);
+
+            // Find each rank's first (left-most) col in this panel,
+            // where the triangular tile resulting from local gelqf
+            // panel will reside.
+            std::vector< int64_t > first_indices
+                            = internal::gelqf_compute_first_indices(A_panel, k);
+
+            #pragma omp task depend(inout:block[k]) \
+                             depend(in:block[lastk])
+            {
+                // Send V(j) across col Q(k:mt-1, j).
+                BcastList bcast_list_V;
+                for (int64_t j = k; j < A_nt; ++j) {
+                    bcast_list_V.push_back(
+                        {k, j, {Q.sub(k, Q_mt-1, j, j)}});
+                }
+                A.template listBcast<target>(bcast_list_V, layout);
+
+                // Send Tlocal(j) across col Q(k:mt-1, j).
+                if (first_indices.size() > 0) {
+                    BcastList bcast_list_T;
+                    for (int64_t j : first_indices) {
+                        bcast_list_T.push_back(
+                            {k, j, {Q.sub(k, Q_mt-1, j, j)}});
+                    }
+                    Tlocal.template listBcast(bcast_list_T, layout);
+                }
+
+                // Send Treduce(j) across col Q(k:mt-1, j).
+                if (first_indices.size() > 1) {
+                    BcastList bcast_list_T;
+                    for (int64_t j : first_indices) {
+                        // Exclude first col of this panel,
+                        // which doesn't have Treduce tile.
+                        if (j > k) {
+                            bcast_list_T.push_back(
+                                {k, j, {Q.sub(k, Q_mt-1, j, j)}});
+                        }
+                    }
+                    Treduce.template listBcast(bcast_list_T, layout);
+                }
+
+                auto Q_trail = Q.sub(k, Q_mt-1, k, Q_nt-1);
+                auto W_trail = W.sub(k, Q_mt-1, k, Q_nt-1);
+
+                // Q Hk = Q Hk_reduce Hk_local, do ttmlq then unmlq.
+                // Apply triangle-triangle reduction reflectors.
+                internal::ttmlq<Target::HostTask>(
+                                side, op,
+                                std::move(A_panel),
+                                Treduce.sub(k, k, k, A_nt-1),
+                                std::move(Q_trail),
+                                tag_0 );
+
+                // Apply local reflectors.
+                internal::unmlq<target>(
+                                side, op,
+                                std::move(A_panel),
+                                Tlocal.sub(k, k, k, A_nt-1),
+                                std::move(Q_trail),
+                                std::move(W_trail) );
+            }
+
+            #pragma omp task depend(in:block[k])
+            {
+                A_panel.releaseRemoteWorkspace();
+                A_panel.releaseLocalWorkspace();
+
+                for (int64_t j : first_indices) {
+                    if (Tlocal.tileIsLocal( k, j )) {
+                        // Tlocal and Treduce have the same process distribution
+                        Tlocal.releaseLocalWorkspaceTile( k, j );
+                        if (j != k) {
+                            // j == k is the root of the reduction tree
+                            // Treduce( k, k ) isn't allocated
+                            Treduce.releaseLocalWorkspaceTile( k, j );
+                        }
+                    }
+                    else {
+                        Tlocal.releaseRemoteWorkspaceTile( k, j );
+                        Treduce.releaseRemoteWorkspaceTile( k, j );
+                    }
+                }
+            }
+
+            lastk = k;
+        }
+
+        #pragma omp taskwait
+        Q.tileUpdateAllOrigin();
+    }
+
+    A.releaseWorkspace();
+    Q.releaseWorkspace();
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel generation of $Q$ from LQ factorization.
+///
+/// Generates the m-by-n matrix $Q$ with orthonormal rows, which is
+/// the first m rows of the product of k elementary reflectors
+/// \[
+///     Q = H(k)^H . . . H(2)^H H(1)^H
+/// \]
+/// as returned by gelqf.
+///
+/// This gives the same $Q$ as unmlq applied to the first m rows of
+/// the identity, but skips the zero tiles of the identity, for about
+/// half the flops.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     Details of the LQ factorization of the original matrix $A$ as returned
+///     by gelqf.
+///
+/// @param[in] T
+///     Triangular matrices of the block reflectors as returned by gelqf.
+///
+/// @param[out] Q
+///     The m-by-n matrix $Q$, with $m \le n$.
+///     It must have the same block columns and distribution as $A$, e.g.,
+///     created by A.emptyLike(), and its block rows the same sizes as
+///     its block columns. For the economy $Q$, m = min(A.m(), n).
+///     On exit, the first m rows of $Q$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup gelqf_computational
+///
+template <typename scalar_t>
+void unglq(
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts)
+{
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        default:
+            impl::unglq<Target::HostTask>( A, T, Q, opts );
+            break;
+
+        case Target::HostNest:
+            impl::unglq<Target::HostNest>( A, T, Q, opts );
+            break;
+
+        case Target::HostBatch:
+            impl::unglq<Target::HostBatch>( A, T, Q, opts );
+            break;
+
+        case Target::Devices:
+            impl::unglq<Target::Devices>( A, T, Q, opts );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void unglq<float>(
+    Matrix<float>& A,
+    TriangularFactors<float>& T,
+    Matrix<float>& Q,
+    Options const& opts);
+
+template
+void unglq<double>(
+    Matrix<double>& A,
+    TriangularFactors<double>& T,
+    Matrix<double>& Q,
+    Options const& opts);
+
+template
+void unglq< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    TriangularFactors< std::complex<float> >& T,
+    Matrix< std::complex<float> >& Q,
+    Options const& opts);
+
+template
+void unglq< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    TriangularFactors< std::complex<double> >& T,
+    Matrix< std::complex<double> >& Q,
+    Options const& opts);
+
+} // namespace slate
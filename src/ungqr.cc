@@ -0,0 +1,301 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "auxiliary/Debug.hh"
+#include "slate/Matrix.hh"
+#include "internal/internal.hh"
+#include "internal/internal_util.hh"
+
+namespace slate {
+
+namespace impl {
+
+//------------------------------------------------------------------------------
+/// Distributed parallel generation of Q from QR factorization.
+/// Generic implementation for any target.
+/// @ingroup geqrf_impl
+///
+template <Target target, typename scalar_t>
+void ungqr(
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts )
+{
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+
+    // Constants
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
+    const Side side = Side::Left;
+    const Op op = Op::NoTrans;
+
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+    const int64_t tag_0 = 0;
+    // ttmqr has host and device implementations.
+    constexpr Target target_tt = (target == Target::Devices
+                                  ? Target::Devices : Target::HostTask);
+
+    int64_t A_mt = A.mt();
+    int64_t A_nt = A.nt();
+    int64_t Q_mt = Q.mt();
+    int64_t Q_nt = Q.nt();
+
+    // Q has A's block rows, and its block columns match them, so that
+    // Q(k:mt-1, 0:k-1) stays zero while applying Hk.
+    slate_assert( Q_mt == A_mt );
+    for (int64_t j = 0; j < std::min( Q_mt, Q_nt ) - 1; ++j) {
+        slate_assert( Q.tileNb( j ) == A.tileMb( j ) );
+    }
+
+    // Reflectors k >= Q_nt don't touch the first Q_nt block columns.
+    int64_t k_end = std::min( std::min( A_mt, A_nt ), Q_nt );
+
+    if (target == Target::Devices) {
+        Q.allocateBatchArrays();
+        Q.reserveDeviceWorkspace();
+    }
+
+    // Reserve workspace
+    auto W = Q.emptyLike();
+
+    if (target == Target::Devices) {
+        W.allocateBatchArrays();
+    }
+
+    assert(T.size() == 2);
+    auto Tlocal  = T[0];
+    auto Treduce = T[1];
+
+    // Q = I.
+    set( zero, one, Q, opts );
+
+    // QR tracks dependencies by block-column.
+    // OpenMP needs pointer types, but vectors are exception safe
+    std::vector< uint8_t > block_vector(A_nt);
+    uint8_t* block = block_vector.data();
+    SLATE_UNUSED( block ); // Used only by OpenMP
+
+    // set min number for omp nested active parallel regions
+    slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        // Q = H1 ... HK I, applied in reverse order of how Hk's were
+        // created. Before applying Hk, Q(k:mt-1, k:nt-1) is the only
+        // non-identity block in rows k:mt-1, so Hk is applied to the
+        // trailing Q(k:mt-1, k:nt-1) only, skipping zero tiles, about
+        // half the flops of unmqr on I.
+        int64_t lastk = k_end-1;
+        // OpenMP uses lastk; compiler doesn't, so warns it is unused.
+        SLATE_UNUSED(lastk);
+        for (int64_t k = k_end-1; k >= 0; --k) {
+
+            auto A_panel = A.sub(k, A_mt-1, k, k);
+
+            // Find each rank's first (top-most) row in this panel,
+            // where the triangular tile resulting from local geqrf
+            // panel will reside.
+            std::vector< int64_t > first_indices
+                            = internal::geqrf_compute_first_indices(A_panel, k);
+
+            #pragma omp task depend(inout:block[k]) \
+                             depend(in:block[lastk])
+            {
+                // Send V(i) across row Q(i, k:nt-1).
+                BcastList bcast_list_V;
+                for (int64_t i = k; i < A_mt; ++i) {
+                    bcast_list_V.push_back(
+                        {i, k, {Q.sub(i, i, k, Q_nt-1)}});
+                }
+                A.template listBcast<target>(bcast_list_V, layout);
+
+                // Send Tlocal(i) across row Q(i, k:nt-1).
+                if (first_indices.size() > 0) {
+                    BcastList bcast_list_T;
+                    for (int64_t i : first_indices) {
+                        bcast_list_T.push_back(
+                            {i, k, {Q.sub(i, i, k, Q_nt-1)}});
+                    }
+                    Tlocal.template listBcast(bcast_list_T, layout);
+                }
+
+                // Send Treduce(i) across row Q(i, k:nt-1).
+                if (first_indices.size() > 1) {
+                    BcastList bcast_list_T;
+                    for (int64_t i : first_indices) {
+                        // Exclude first row of this panel,
+                        // which doesn't have Treduce tile.
+                        if (i > k) {
+                            bcast_list_T.push_back(
+                                {i, k, {Q.sub(i, i, k, Q_nt-1)}});
+                        }
+                    }
+                    Treduce.template listBcast(bcast_list_T, layout);
+                }
+
+                auto Q_trail = Q.sub(k, Q_mt-1, k, Q_nt-1);
+                auto W_trail = W.sub(k, Q_mt-1, k, Q_nt-1);
+
+                // Hk Q = Hk_local Hk_reduce Q, do ttmqr then unmqr.
+                // Apply triangle-triangle reduction reflectors.
+                internal::ttmqr<target_tt>(
+                                side, op,
+                                std::move(A_panel),
+                                Treduce.sub(k, A_mt-1, k, k),
+                                std::move(Q_trail),
+                                tag_0 );
+
+                // Apply local reflectors.
+                internal::unmqr<target>(
+                                side, op,
+                                std::move(A_panel),
+                                Tlocal.sub(k, A_mt-1, k, k),
+                                std::move(Q_trail),
+                                std::move(W_trail) );
+            }
+
+            #pragma omp task depend(in:block[k])
+            {
+                A_panel.releaseRemoteWorkspace();
+                A_panel.releaseLocalWorkspace();
+
+                for (int64_t i : first_indices) {
+                    if (Tlocal.tileIsLocal( i, k )) {
+                        // Tlocal and Treduce have the same process distribution
+                        Tlocal.releaseLocalWorkspaceTile( i, k );
+                        if (i != k) {
+                            // i == k is the root of the reduction tree
+                            // Treduce( k, k ) isn't allocated
+                            Treduce.releaseLocalWorkspaceTile( i, k );
+                        }
+                    }
+                    else {
+                        Treduce.releaseRemoteWorkspaceTile( i, k );
+                        Tlocal.releaseRemoteWorkspaceTile( i, k );
+                    }
+                }
+            }
+
+            lastk = k;
+        }
+
+        #pragma omp taskwait
+        Q.tileUpdateAllOrigin();
+    }
+
+    A.releaseWorkspace();
+    Q.releaseWorkspace();
+}
+
+} // namespace impl
+
+//------------------------------------------------------------------------------
+/// Distributed parallel generation of $Q$ from QR factorization.
+///
+/// Generates the m-by-n matrix $Q$ with orthonormal columns, which is
+/// the first n columns of the product of k elementary reflectors
+/// \[
+///     Q = H(1) H(2) . . . H(k)
+/// \]
+/// as returned by geqrf.
+///
+/// This gives the same $Q$ as unmqr applied to the first n columns of
+/// the identity, but skips the zero tiles of the identity, for about
+/// half the flops.
+///
+//------------------------------------------------------------------------------
+/// @tparam scalar_t
+///     One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] A
+///     Details of the QR factorization of the original matrix $A$ as returned
+///     by geqrf.
+///
+/// @param[in] T
+///     Triangular matrices of the block reflectors as returned by geqrf.
+///
+/// @param[out] Q
+///     The m-by-n matrix $Q$, with $n \le m$.
+///     It must have the same block rows and distribution as $A$, e.g.,
+///     created by A.emptyLike(), and its block columns the same sizes as
+///     its block rows. For the economy $Q$, n = min(m, A.n()).
+///     On exit, the first n columns of $Q$.
+///
+/// @param[in] opts
+///     Additional options, as map of name = value pairs. Possible options:
+///     - Option::Target:
+///       Implementation to target. Possible values:
+///       - HostTask:  OpenMP tasks on CPU host [default].
+///       - HostNest:  nested OpenMP parallel for loop on CPU host.
+///       - HostBatch: batched BLAS on CPU host.
+///       - Devices:   batched BLAS on GPU device.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void ungqr(
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    Matrix<scalar_t>& Q,
+    Options const& opts)
+{
+    Target target = get_option( opts, Option::Target, Target::HostTask );
+
+    switch (target) {
+        case Target::Host:
+        case Target::HostTask:
+        default:
+            impl::ungqr<Target::HostTask>( A, T, Q, opts );
+            break;
+
+        case Target::HostNest:
+            impl::ungqr<Target::HostNest>( A, T, Q, opts );
+            break;
+
+        case Target::HostBatch:
+            impl::ungqr<Target::HostBatch>( A, T, Q, opts );
+            break;
+
+        case Target::Devices:
+            impl::ungqr<Target::Devices>( A, T, Q, opts );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void ungqr<float>(
+    Matrix<float>& A,
+    TriangularFactors<float>& T,
+    Matrix<float>& Q,
+    Options const& opts);
+
+template
+void ungqr<double>(
+    Matrix<double>& A,
+    TriangularFactors<double>& T,
+    Matrix<double>& Q,
+    Options const& opts);
+
+template
+void ungqr< std::complex<float> >(
+    Matrix< std::complex<float> >& A,
+    TriangularFactors< std::complex<float> >& T,
+    Matrix< std::complex<float> >& Q,
+    Options const& opts);
+
+template
+void ungqr< std::complex<double> >(
+    Matrix< std::complex<double> >& A,
+    TriangularFactors< std::complex<double> >& T,
+    Matrix< std::complex<double> >& Q,
+    Options const& opts);
+
+} // namespace slate
@@ -24,7 +24,7 @@ void unmlq(
     Side side, Op op,
     Matrix<scalar_t>& A,
     TriangularFactors<scalar_t>& T,
-    Matrix<scalar_t>& C,
+    std::vector< Matrix<scalar_t> >& C_array,
     Options const& opts )
 {
     // trace::Block trace_block("unmlq");
@@ -37,24 +37,41 @@ void unmlq(
     int64_t A_mt = A.mt();
     int64_t A_nt = A.nt();
     int64_t A_min_mtnt = std::min(A_mt, A_nt);
-    int64_t C_mt = C.mt();
-    int64_t C_nt = C.nt();
-
-    if (target == Target::Devices) {
-        C.allocateBatchArrays();
-        C.reserveDeviceWorkspace();
+    int64_t batch_size = C_array.size();
+    if (batch_size == 0)
+        return;
+
+    // All C's are applied with the same V and T, broadcast once per panel,
+    // so they must have the same dimension and distribution along Q.
+    // Their other dimension can differ.
+    for (auto& C : C_array) {
+        if (side == Side::Left) {
+            slate_assert( C.mt() == C_array[ 0 ].mt() );
+        }
+        else {
+            slate_assert( C.nt() == C_array[ 0 ].nt() );
+        }
     }
 
     // Reserve workspace
-    auto W = C.emptyLike();
-
-    if (target == Target::Devices) {
-        W.allocateBatchArrays();
-        // todo: this is demanding too much device workspace memory
-        // only one tile-col of matrix W per MPI process is going to be used,
-        // but W with size of whole C is being allocated
-        // thus limiting the matrix size that can be processed
-        //W.reserveDeviceWorkspace();
+    std::vector< Matrix<scalar_t> > W_array;
+    for (auto& C : C_array) {
+        if (target == Target::Devices) {
+            C.allocateBatchArrays();
+            C.reserveDeviceWorkspace();
+        }
+
+        auto W = C.emptyLike();
+
+        if (target == Target::Devices) {
+            W.allocateBatchArrays();
+            // todo: this is demanding too much device workspace memory
+            // only one tile-col of matrix W per MPI process is going to be used,
+            // but W with size of whole C is being allocated
+            // thus limiting the matrix size that can be processed
+            //W.reserveDeviceWorkspace();
+        }
+        W_array.push_back( W );
     }
 
     assert(T.size() == 2);
@@ -109,31 +126,24 @@ void unmlq(
             #pragma omp task depend(inout:block[k]) \
                              depend(in:block[lastk])
             {
-                // Indices for row or col of C.
-                int64_t i0 = -1, i1 = -1, j0 = -1, j1 = -1;
-                if (side == Side::Left) {
-                    j0 = 0;
-                    j1 = C_nt-1;
-                }
-                else {
-                    i0 = 0;
-                    i1 = C_mt-1;
-                }
+                // Row C(j, 0:nt-1) or col C(0:mt-1, j) of each C,
+                // for side = left or right, respectively.
+                auto C_rows = [&]( int64_t j ) {
+                    std::list< BaseMatrix<scalar_t> > list;
+                    for (auto& C : C_array) {
+                        if (side == Side::Left)
+                            list.push_back( C.sub( j, j, 0, C.nt()-1 ) );
+                        else
+                            list.push_back( C.sub( 0, C.mt()-1, j, j ) );
+                    }
+                    return list;
+                };
 
                 // Send V(j) across row C(j, 0:nt-1) or col C(0:mt-1, j),
-                // for side = left or right, respectively.
+                // once for all C's.
                 BcastList bcast_list_V;
                 for (int64_t j = k; j < A_nt; ++j) {
-                    if (side == Side::Left) {
-                        i0 = j;
-                        i1 = j;
-                    }
-                    else {
-                        j0 = j;
-                        j1 = j;
-                    }
-                    bcast_list_V.push_back(
-                        {k, j, {C.sub(i0, i1, j0, j1)}});
+                    bcast_list_V.push_back( {k, j, C_rows( j )} );
                 }
                 A.template listBcast<target>(bcast_list_V, layout);
 
@@ -141,16 +151,7 @@ void unmlq(
                 if (first_indices.size() > 0) {
                     BcastList bcast_list_T;
                     for (int64_t j : first_indices) {
-                        if (side == Side::Left) {
-                            i0 = j;
-                            i1 = j;
-                        }
-                        else {
-                            j0 = j;
-                            j1 = j;
-                        }
-                        bcast_list_T.push_back(
-                            {k, j, {C.sub(i0, i1, j0, j1)}});
+                        bcast_list_T.push_back( {k, j, C_rows( j )} );
                     }
                     Tlocal.template listBcast(bcast_list_T, layout);
                 }
@@ -159,66 +160,64 @@ void unmlq(
                 if (first_indices.size() > 1) {
                     BcastList bcast_list_T;
                     for (int64_t j : first_indices) {
-                        if (side == Side::Left) {
-                            i0 = j;
-                            i1 = j;
-                        }
-                        else {
-                            j0 = j;
-                            j1 = j;
-                        }
                         // Exclude first col of this panel,
                         // which doesn't have Treduce tile.
                         if (j > k) {
-                            bcast_list_T.push_back(
-                                {k, j, {C.sub(i0, i1, j0, j1)}});
+                            bcast_list_T.push_back( {k, j, C_rows( j )} );
                         }
                     }
                     Treduce.template listBcast(bcast_list_T, layout);
                 }
 
-                Matrix<scalar_t> C_trail, W_trail;
-                if (side == Side::Left) {
-                    C_trail = C.sub(k, C_mt-1, 0, C_nt-1);
-                    W_trail = W.sub(k, C_mt-1, 0, C_nt-1);
-                }
-                else {
-                    C_trail = C.sub(0, C_mt-1, k, C_nt-1);
-                    W_trail = W.sub(0, C_mt-1, k, C_nt-1);
-                }
+                for (int64_t c = 0; c < batch_size; ++c) {
+                    auto& C = C_array[ c ];
+                    auto& W = W_array[ c ];
+                    int64_t C_mt = C.mt();
+                    int64_t C_nt = C.nt();
 
-                // Left,  (Conj)Trans: Qi^H C = Qi_local^H Qi_reduce^H C, or
-                // Right, NoTrans:     C Qi   = C Qi_reduce Qi_local,
-                // do ttmqr then unmqr.
-                if ((side == Side::Left) != (op == Op::NoTrans)) {
-                    // Apply triangle-triangle reduction reflectors.
-                    internal::ttmlq<Target::HostTask>(
-                                    side, op,
-                                    std::move(A_panel),
-                                    Treduce.sub(k, k, k, A_nt-1),
-                                    std::move(C_trail),
-                                    tag_0 );
-                }
+                    Matrix<scalar_t> C_trail, W_trail;
+                    if (side == Side::Left) {
+                        C_trail = C.sub(k, C_mt-1, 0, C_nt-1);
+                        W_trail = W.sub(k, C_mt-1, 0, C_nt-1);
+                    }
+                    else {
+                        C_trail = C.sub(0, C_mt-1, k, C_nt-1);
+                        W_trail = W.sub(0, C_mt-1, k, C_nt-1);
+                    }
 
-                // Apply local reflectors.
-                internal::unmlq<target>(
-                                side, op,
-                                std::move(A_panel),
-                                Tlocal.sub(k, k, k, A_nt-1),
-                                std::move(C_trail),
-                                std::move(W_trail) );
-
-                // Left,  NoTrans:     Qi C   = Qi_reduce Qi_local C, or
-                // Right, (Conj)Trans: C Qi^H = C Qi_local^H Qi_reduce^H,
-                // do unmqr then ttmqr.
-                if ((side == Side::Left) == (op == Op::NoTrans)) {
-                    // Apply triangle-triangle reduction reflectors.
-                    internal::ttmlq<Target::HostTask>(
+                    // Left,  (Conj)Trans: Qi^H C = Qi_local^H Qi_reduce^H C, or
+                    // Right, NoTrans:     C Qi   = C Qi_reduce Qi_local,
+                    // do ttmqr then unmqr.
+                    if ((side == Side::Left) != (op == Op::NoTrans)) {
+                        // Apply triangle-triangle reduction reflectors.
+                        internal::ttmlq<Target::HostTask>(
+                                        side, op,
+                                        std::move(A_panel),
+                                        Treduce.sub(k, k, k, A_nt-1),
+                                        std::move(C_trail),
+                                        tag_0 );
+                    }
+
+                    // Apply local reflectors.
+                    internal::unmlq<target>(
                                     side, op,
                                     std::move(A_panel),
-                                    Treduce.sub(k, k, k, A_nt-1),
+                                    Tlocal.sub(k, k, k, A_nt-1),
                                     std::move(C_trail),
-                                    tag_0 );
+                                    std::move(W_trail) );
+
+                    // Left,  NoTrans:     Qi C   = Qi_reduce Qi_local C, or
+                    // Right, (Conj)Trans: C Qi^H = C Qi_local^H Qi_reduce^H,
+                    // do unmqr then ttmqr.
+                    if ((side == Side::Left) == (op == Op::NoTrans)) {
+                        // Apply triangle-triangle reduction reflectors.
+                        internal::ttmlq<Target::HostTask>(
+                                        side, op,
+                                        std::move(A_panel),
+                                        Treduce.sub(k, k, k, A_nt-1),
+                                        std::move(C_trail),
+                                        tag_0 );
+                    }
                 }
             }
 
@@ -248,11 +247,13 @@ void unmlq(
         }
 
         #pragma omp taskwait
-        C.tileUpdateAllOrigin();
+        for (auto& C : C_array)
+            C.tileUpdateAllOrigin();
     }
 
     A.releaseWorkspace();
-    C.releaseWorkspace();
+    for (auto& C : C_array)
+        C.releaseWorkspace();
 }
 
 } // namespace impl
@@ -320,25 +321,54 @@ void unmlq(
     TriangularFactors<scalar_t>& T,
     Matrix<scalar_t>& C,
     Options const& opts )
+{
+    std::vector< Matrix<scalar_t> > C_array = { C };
+    unmlq( side, op, A, T, C_array, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel multiply of a batch of matrices by $Q$ from LQ
+/// factorization, $C_i = op(Q) C_i$ or $C_i = C_i op(Q)$ for each $C_i$.
+///
+/// Same as calling unmlq on each matrix, except the reflector panels and
+/// T factors are broadcast once per panel for the whole batch, instead of
+/// once per matrix.
+///
+/// @param[in,out] C_array
+///     The matrices $C_i$. For side = Left, all must have the same number
+///     and distribution of block rows; for side = Right, of block
+///     columns. Their other dimension can differ.
+///
+/// @see unmlq for the other arguments.
+///
+/// @ingroup gelqf_computational
+///
+template <typename scalar_t>
+void unmlq(
+    Side side, Op op,
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    std::vector< Matrix<scalar_t> >& C_array,
+    Options const& opts )
 {
     Target target = get_option( opts, Option::Target, Target::HostTask );
 
     switch (target) {
         case Target::Host:
         case Target::HostTask:
-            impl::unmlq<Target::HostTask>( side, op, A, T, C, opts  );
+            impl::unmlq<Target::HostTask>( side, op, A, T, C_array, opts );
             break;
 
         case Target::HostNest:
-            impl::unmlq<Target::HostNest>( side, op, A, T, C, opts  );
+            impl::unmlq<Target::HostNest>( side, op, A, T, C_array, opts );
             break;
 
         case Target::HostBatch:
-            impl::unmlq<Target::HostBatch>( side, op, A, T, C, opts  );
+            impl::unmlq<Target::HostBatch>( side, op, A, T, C_array, opts );
             break;
 
         case Target::Devices:
-            impl::unmlq<Target::Devices>( side, op, A, T, C, opts  );
+            impl::unmlq<Target::Devices>( side, op, A, T, C_array, opts );
             break;
     }
     // todo: return value for errors?
@@ -378,4 +408,36 @@ void unmlq< std::complex<double> >(
     Matrix< std::complex<double> >& C,
     Options const& opts);
 
+template
+void unmlq<float>(
+    Side side, Op op,
+    Matrix<float>& A,
+    TriangularFactors<float>& T,
+    std::vector< Matrix<float> >& C_array,
+    Options const& opts);
+
+template
+void unmlq<double>(
+    Side side, Op op,
+    Matrix<double>& A,
+    TriangularFactors<double>& T,
+    std::vector< Matrix<double> >& C_array,
+    Options const& opts);
+
+template
+void unmlq< std::complex<float> >(
+    Side side, Op op,
+    Matrix< std::complex<float> >& A,
+    TriangularFactors< std::complex<float> >& T,
+    std::vector< Matrix< std::complex<float> > >& C_array,
+    Options const& opts);
+
+template
+void unmlq< std::complex<double> >(
+    Side side, Op op,
+    Matrix< std::complex<double> >& A,
+    TriangularFactors< std::complex<double> >& T,
+    std::vector< Matrix< std::complex<double> > >& C_array,
+    Options const& opts);
+
 } // namespace slate
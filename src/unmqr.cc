@@ -24,7 +24,7 @@ void unmqr(
     Side side, Op op,
     Matrix<scalar_t>& A,
     TriangularFactors<scalar_t>& T,
-    Matrix<scalar_t>& C,
+    std::vector< Matrix<scalar_t> >& C_array,
     Options const& opts )
 {
     // trace::Block trace_block("unmqr");
@@ -33,32 +33,52 @@ void unmqr(
     // Assumes column major
     const Layout layout = Layout::ColMajor;
     const int64_t tag_0 = 0;
+    // ttmqr has host and device implementations.
+    constexpr Target target_tt = (target == Target::Devices
+                                  ? Target::Devices : Target::HostTask);
 
     int64_t A_mt = A.mt();
     int64_t A_nt = A.nt();
     int64_t A_min_mtnt = std::min(A_mt, A_nt);
-    int64_t C_mt = C.mt();
-    int64_t C_nt = C.nt();
+    int64_t batch_size = C_array.size();
+    if (batch_size == 0)
+        return;
+
+    // All C's are applied with the same V and T, broadcast once per panel,
+    // so they must have the same dimension and distribution along Q.
+    // Their other dimension can differ.
+    for (auto& C : C_array) {
+        if (side == Side::Left) {
+            slate_assert( C.mt() == C_array[ 0 ].mt() );
+        }
+        else {
+            slate_assert( C.nt() == C_array[ 0 ].nt() );
+        }
+    }
 
     if (is_complex<scalar_t>::value && op == Op::Trans) {
         throw Exception("Complex numbers uses Op::ConjTrans, not Op::Trans.");
     }
 
-    if (target == Target::Devices) {
-        C.allocateBatchArrays();
-        C.reserveDeviceWorkspace();
-    }
-
     // Reserve workspace
-    auto W = C.emptyLike();
-
-    if (target == Target::Devices) {
-        W.allocateBatchArrays();
-        // todo: this is demanding too much device workspace memory
-        // only one tile-row of matrix W per MPI process is going to be used,
-        // but W with size of whole C is being allocated
-        // thus limiting the matrix size that can be processed
-        //W.reserveDeviceWorkspace();
+    std::vector< Matrix<scalar_t> > W_array;
+    for (auto& C : C_array) {
+        if (target == Target::Devices) {
+            C.allocateBatchArrays();
+            C.reserveDeviceWorkspace();
+        }
+
+        auto W = C.emptyLike();
+
+        if (target == Target::Devices) {
+            W.allocateBatchArrays();
+            // todo: this is demanding too much device workspace memory
+            // only one tile-row of matrix W per MPI process is going to be used,
+            // but W with size of whole C is being allocated
+            // thus limiting the matrix size that can be processed
+            //W.reserveDeviceWorkspace();
+        }
+        W_array.push_back( W );
     }
 
     assert(T.size() == 2);
@@ -113,31 +133,24 @@ void unmqr(
             #pragma omp task depend(inout:block[k]) \
                              depend(in:block[lastk])
             {
-                // Indices for row or col of C.
-                int64_t i0 = -1, i1 = -1, j0 = -1, j1 = -1;
-                if (side == Side::Left) {
-                    j0 = 0;
-                    j1 = C_nt-1;
-                }
-                else {
-                    i0 = 0;
-                    i1 = C_mt-1;
-                }
+                // Row C(i, 0:nt-1) or col C(0:mt-1, i) of each C,
+                // for side = left or right, respectively.
+                auto C_rows = [&]( int64_t i ) {
+                    std::list< BaseMatrix<scalar_t> > list;
+                    for (auto& C : C_array) {
+                        if (side == Side::Left)
+                            list.push_back( C.sub( i, i, 0, C.nt()-1 ) );
+                        else
+                            list.push_back( C.sub( 0, C.mt()-1, i, i ) );
+                    }
+                    return list;
+                };
 
                 // Send V(i) across row C(i, 0:nt-1) or col C(0:mt-1, i),
-                // for side = left or right, respectively.
+                // once for all C's.
                 BcastList bcast_list_V;
                 for (int64_t i = k; i < A_mt; ++i) {
-                    if (side == Side::Left) {
-                        i0 = i;
-                        i1 = i;
-                    }
-                    else {
-                        j0 = i;
-                        j1 = i;
-                    }
-                    bcast_list_V.push_back(
-                        {i, k, {C.sub(i0, i1, j0, j1)}});
+                    bcast_list_V.push_back( {i, k, C_rows( i )} );
                 }
                 A.template listBcast<target>(bcast_list_V, layout);
 
@@ -145,16 +158,7 @@ void unmqr(
                 if (first_indices.size() > 0) {
                     BcastList bcast_list_T;
                     for (int64_t i : first_indices) {
-                        if (side == Side::Left) {
-                            i0 = i;
-                            i1 = i;
-                        }
-                        else {
-                            j0 = i;
-                            j1 = i;
-                        }
-                        bcast_list_T.push_back(
-                            {i, k, {C.sub(i0, i1, j0, j1)}});
+                        bcast_list_T.push_back( {i, k, C_rows( i )} );
                     }
                     Tlocal.template listBcast(bcast_list_T, layout);
                 }
@@ -163,66 +167,64 @@ void unmqr(
                 if (first_indices.size() > 1) {
                     BcastList bcast_list_T;
                     for (int64_t i : first_indices) {
-                        if (side == Side::Left) {
-                            i0 = i;
-                            i1 = i;
-                        }
-                        else {
-                            j0 = i;
-                            j1 = i;
-                        }
                         // Exclude first row of this panel,
                         // which doesn't have Treduce tile.
                         if (i > k) {
-                            bcast_list_T.push_back(
-                                {i, k, {C.sub(i0, i1, j0, j1)}});
+                            bcast_list_T.push_back( {i, k, C_rows( i )} );
                         }
                     }
                     Treduce.template listBcast(bcast_list_T, layout);
                 }
 
-                Matrix<scalar_t> C_trail, W_trail;
-                if (side == Side::Left) {
-                    C_trail = C.sub(k, C_mt-1, 0, C_nt-1);
-                    W_trail = W.sub(k, C_mt-1, 0, C_nt-1);
-                }
-                else {
-                    C_trail = C.sub(0, C_mt-1, k, C_nt-1);
-                    W_trail = W.sub(0, C_mt-1, k, C_nt-1);
-                }
+                for (int64_t c = 0; c < batch_size; ++c) {
+                    auto& C = C_array[ c ];
+                    auto& W = W_array[ c ];
+                    int64_t C_mt = C.mt();
+                    int64_t C_nt = C.nt();
 
-                // Left,  NoTrans:     Qi C   = Qi_local Qi_reduce C, or
-                // Right, (Conj)Trans: C Qi^H = C Qi_reduce^H Qi_local^H,
-                // do ttmqr then unmqr.
-                if ((side == Side::Left) == (op == Op::NoTrans)) {
-                    // Apply triangle-triangle reduction reflectors.
-                    internal::ttmqr<Target::HostTask>(
-                                    side, op,
-                                    std::move(A_panel),
-                                    Treduce.sub(k, A_mt-1, k, k),
-                                    std::move(C_trail),
-                                    tag_0 );
-                }
+                    Matrix<scalar_t> C_trail, W_trail;
+                    if (side == Side::Left) {
+                        C_trail = C.sub(k, C_mt-1, 0, C_nt-1);
+                        W_trail = W.sub(k, C_mt-1, 0, C_nt-1);
+                    }
+                    else {
+                        C_trail = C.sub(0, C_mt-1, k, C_nt-1);
+                        W_trail = W.sub(0, C_mt-1, k, C_nt-1);
+                    }
+
+                    // Left,  NoTrans:     Qi C   = Qi_local Qi_reduce C, or
+                    // Right, (Conj)Trans: C Qi^H = C Qi_reduce^H Qi_local^H,
+                    // do ttmqr then unmqr.
+                    if ((side == Side::Left) == (op == Op::NoTrans)) {
+                        // Apply triangle-triangle reduction reflectors.
+                        internal::ttmqr<target_tt>(
+                                        side, op,
+                                        std::move(A_panel),
+                                        Treduce.sub(k, A_mt-1, k, k),
+                                        std::move(C_trail),
+                                        tag_0 );
+                    }
 
-                // Apply local reflectors.
-                internal::unmqr<target>(
-                                side, op,
-                                std::move(A_panel),
-                                Tlocal.sub(k, A_mt-1, k, k),
-                                std::move(C_trail),
-                                std::move(W_trail) );
-
-                // Left,  (Conj)Trans: Qi^H C = Qi_reduce^H Qi_local^H C, or
-                // Right, NoTrans:     C Qi   = C Qi_local Qi_reduce,
-                // do unmqr then ttmqr.
-                if ((side == Side::Left) != (op == Op::NoTrans)) {
-                    // Apply triangle-triangle reduction reflectors.
-                    internal::ttmqr<Target::HostTask>(
+                    // Apply local reflectors.
+                    internal::unmqr<target>(
                                     side, op,
                                     std::move(A_panel),
-                                    Treduce.sub(k, A_mt-1, k, k),
+                                    Tlocal.sub(k, A_mt-1, k, k),
                                     std::move(C_trail),
-                                    tag_0 );
+                                    std::move(W_trail) );
+
+                    // Left,  (Conj)Trans: Qi^H C = Qi_reduce^H Qi_local^H C, or
+                    // Right, NoTrans:     C Qi   = C Qi_local Qi_reduce,
+                    // do unmqr then ttmqr.
+                    if ((side == Side::Left) != (op == Op::NoTrans)) {
+                        // Apply triangle-triangle reduction reflectors.
+                        internal::ttmqr<target_tt>(
+                                        side, op,
+                                        std::move(A_panel),
+                                        Treduce.sub(k, A_mt-1, k, k),
+                                        std::move(C_trail),
+                                        tag_0 );
+                    }
                 }
             }
             #pragma omp task depend(in:block[k])
@@ -251,11 +253,13 @@ void unmqr(
         }
 
         #pragma omp taskwait
-        C.tileUpdateAllOrigin();
+        for (auto& C : C_array)
+            C.tileUpdateAllOrigin();
     }
 
     A.releaseWorkspace();
-    C.releaseWorkspace();
+    for (auto& C : C_array)
+        C.releaseWorkspace();
 }
 
 } // namespace impl
@@ -323,6 +327,35 @@ void unmqr(
     TriangularFactors<scalar_t>& T,
     Matrix<scalar_t>& C,
     Options const& opts)
+{
+    std::vector< Matrix<scalar_t> > C_array = { C };
+    unmqr( side, op, A, T, C_array, opts );
+}
+
+//------------------------------------------------------------------------------
+/// Distributed parallel multiply of a batch of matrices by $Q$ from QR
+/// factorization, $C_i = op(Q) C_i$ or $C_i = C_i op(Q)$ for each $C_i$.
+///
+/// Same as calling unmqr on each matrix, except the reflector panels and
+/// T factors are broadcast once per panel for the whole batch, instead of
+/// once per matrix, e.g., when projecting many matrices with the same Q.
+///
+/// @param[in,out] C_array
+///     The matrices $C_i$. For side = Left, all must have the same number
+///     and distribution of block rows; for side = Right, of block
+///     columns. Their other dimension can differ.
+///
+/// @see unmqr for the other arguments.
+///
+/// @ingroup geqrf_computational
+///
+template <typename scalar_t>
+void unmqr(
+    Side side, Op op,
+    Matrix<scalar_t>& A,
+    TriangularFactors<scalar_t>& T,
+    std::vector< Matrix<scalar_t> >& C_array,
+    Options const& opts)
 {
     Target target = get_option( opts, Option::Target, Target::HostTask );
 
@@ -330,19 +363,19 @@ void unmqr(
         case Target::Host:
         case Target::HostTask:
         default:
-            impl::unmqr<Target::HostTask>( side, op, A, T, C, opts );
+            impl::unmqr<Target::HostTask>( side, op, A, T, C_array, opts );
             break;
 
         case Target::HostNest:
-            impl::unmqr<Target::HostNest>( side, op, A, T, C, opts );
+            impl::unmqr<Target::HostNest>( side, op, A, T, C_array, opts );
             break;
 
         case Target::HostBatch:
-            impl::unmqr<Target::HostBatch>( side, op, A, T, C, opts );
+            impl::unmqr<Target::HostBatch>( side, op, A, T, C_array, opts );
             break;
 
         case Target::Devices:
-            impl::unmqr<Target::Devices>( side, op, A, T, C, opts );
+            impl::unmqr<Target::Devices>( side, op, A, T, C_array, opts );
             break;
     }
     // todo: return value for errors?
@@ -382,4 +415,36 @@ void unmqr< std::complex<double> >(
     Matrix< std::complex<double> >& C,
     Options const& opts);
 
+template
+void unmqr<float>(
+    Side side, Op op,
+    Matrix<float>& A,
+    TriangularFactors<float>& T,
+    std::vector< Matrix<float> >& C_array,
+    Options const& opts);
+
+template
+void unmqr<double>(
+    Side side, Op op,
+    Matrix<double>& A,
+    TriangularFactors<double>& T,
+    std::vector< Matrix<double> >& C_array,
+    Options const& opts);
+
+template
+void unmqr< std::complex<float> >(
+    Side side, Op op,
+    Matrix< std::complex<float> >& A,
+    TriangularFactors< std::complex<float> >& T,
+    std::vector< Matrix< std::complex<float> > >& C_array,
+    Options const& opts);
+
+template
+void unmqr< std::complex<double> >(
+    Side side, Op op,
+    Matrix< std::complex<double> >& A,
+    TriangularFactors< std::complex<double> >& T,
+    std::vector< Matrix< std::complex<double> > >& C_array,
+    Options const& opts);
+
 } // namespace slate
@@ -34,6 +34,11 @@ void unmtr_hb2st(
         C.allocateBatchArrays( batch_size_default, num_queues );
     }
 
+    // Aggregate V tiles into blocks of about block_size reflectors.
+    int64_t nb = V.tileNb( 0 );
+    int64_t block_size = get_option<int64_t>( opts, Option::BlockSize, 4*nb );
+    int64_t group_size = std::max( int64_t( 1 ), block_size / nb );
+
     // set min number for omp nested active parallel regions
     slate::OmpSetMaxActiveLevels set_active_levels( MinOmpActiveLevels );
 
@@ -42,7 +47,7 @@ void unmtr_hb2st(
     {
         #pragma omp task
         {
-            internal::unmtr_hb2st<target>( side, op, V, C );
+            internal::unmtr_hb2st<target>( side, op, V, C, group_size );
         }
         #pragma omp taskwait
         C.tileUpdateAllOrigin();
@@ -70,6 +75,10 @@ void unmtr_hb2st(
 ///     Q = H(1) H(2) . . . H(k)
 /// \]
 ///
+/// Consecutive blocks of reflectors in each sweep of hb2st are aggregated
+/// into larger compact-WY blocks, so the update of C is done with gemms
+/// of inner dimension up to Option::BlockSize.
+///
 //------------------------------------------------------------------------------
 /// @tparam scalar_t
 ///     One of float, double, std::complex<float>, std::complex<double>.
@@ -101,6 +110,9 @@ void unmtr_hb2st(
 ///       - HostNest:  nested OpenMP parallel for loop on CPU host.
 ///       - HostBatch: batched BLAS on CPU host.
 ///       - Devices:   batched BLAS on GPU device.
+///     - Option::BlockSize:
+///       Number of reflectors to aggregate into one block, rounded down
+///       to a multiple of the tile size nb of V. Default 4 nb.
 ///
 /// @ingroup heev_computational
 ///
@@ -89,7 +89,9 @@ void unmtr_he2hb(
         int64_t i0 = (side == Side::Left) ? 1 : 0;
         int64_t i1 = (side == Side::Left) ? 0 : 1;
 
-        auto C_cub = C.sub(i0, A.nt()-1, i1, A.nt()-1);
+        // C may have fewer columns (left) or rows (right) than A,
+        // e.g., for a subset of eigenvectors.
+        auto C_cub = C.sub(i0, C.mt()-1, i1, C.nt()-1);
 
         slate::unmqr(side, op, A_sub, T_sub, C_cub, opts);
     }
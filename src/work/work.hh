@@ -35,6 +35,13 @@ void trsm(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
                                                Matrix<scalar_t> B,
           uint8_t* row, Options const& opts);
 
+//-----------------------------------------
+// trsm_groups()
+template <Target target=Target::HostTask, typename scalar_t>
+void trsm_groups(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
+                                                      Matrix<scalar_t> B,
+                 uint8_t* row, int64_t groups, Options const& opts);
+
 //-----------------------------------------
 // trsmA()
 template <Target target=Target::HostTask, typename scalar_t>
@@ -246,7 +246,8 @@ void trsmA(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
                     bcast_list_upd_B.push_back(
                         {k, j, { A.sub(k + 1, mt - 1, k, k), }});
                 }
-                B.template listBcast<target>( bcast_list_upd_B, layout, k );
+                B.template listBcast<target>(
+                    bcast_list_upd_B, layout, k, false, opts );
 
             }
 
@@ -400,7 +401,8 @@ void trsmA(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
                     bcast_list_upd_B.push_back(
                         {k, j, { A.sub(0, k - 1, k, k), }});
                 }
-                B.template listBcast<target>(bcast_list_upd_B, layout, k );
+                B.template listBcast<target>(
+                    bcast_list_upd_B, layout, k, false, opts );
             }
 
             // lookahead update, B(k-la:k-1, :) -= A(k-la:k-1, k) B(k, :)
@@ -0,0 +1,356 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+#include "work/work.hh"
+
+namespace slate {
+namespace work {
+
+//------------------------------------------------------------------------------
+/// Triangular solve matrix (multiple right-hand sides), with the columns of
+/// B split into independent groups.
+/// Same as work::trsm, except the block columns of B are partitioned into
+/// `groups` contiguous groups, each with its own row dependencies, panel
+/// solves, lookahead, and trailing updates, so a group doesn't wait on the
+/// updates of the others. Column k of A is broadcast once for all groups.
+/// All communication is chained in task creation order, which is the same
+/// on every rank.
+/// Note A and B are passed by value, so we can transpose if needed
+/// (for side = right) without affecting caller.
+///
+/// @tparam target
+///         One of HostTask, HostNest, HostBatch, Devices.
+///
+/// @tparam scalar_t
+///         One of float, double, std::complex<float>, std::complex<double>.
+//------------------------------------------------------------------------------
+/// @param[in] side
+///         Whether A appears on the left or on the right of X:
+///         - Side::Left:  solve $A X = \alpha B$
+///         - Side::Right: solve $X A = \alpha B$
+///
+/// @param[in] alpha
+///         The scalar alpha.
+///
+/// @param[in] A
+///         - If side = left,  the m-by-m triangular matrix A;
+///         - if side = right, the n-by-n triangular matrix A.
+///
+/// @param[in,out] B
+///         On entry, the m-by-n matrix B.
+///         On exit, overwritten by the result X.
+///
+/// @param[in] row
+///         A raw pointer to a dummy vector data, used for OpenMP dependencies
+///         tracking. Entries g*A.nt() to (g+1)*A.nt() - 1 represent the block
+///         rows of group g of B. The size of row should be
+///         groups * (number of block columns of A).
+///
+/// @param[in] groups
+///         Number of column groups, 1 <= groups <= number of block columns
+///         of op(B) (block rows if side = right).
+///
+/// @param[in] opts
+///         Additional options, as map of name = value pairs. Possible options:
+///         - Option::Lookahead:
+///           Number of blocks to overlap communication and computation
+///           in each group. lookahead >= 0. Default 1.
+///         With target Devices, group g uses compute queues
+///         g*(2 + lookahead) to (g+1)*(2 + lookahead) - 1.
+///
+/// @ingroup trsm_internal
+///
+template <Target target, typename scalar_t>
+void trsm_groups(Side side, scalar_t alpha, TriangularMatrix<scalar_t> A,
+                                                      Matrix<scalar_t> B,
+                 uint8_t* row, int64_t groups, Options const& opts)
+{
+    using blas::conj;
+    using BcastList = typename Matrix<scalar_t>::BcastList;
+
+    // Constants
+    const scalar_t one = 1.0;
+    const int priority_0 = 0;
+    const int priority_1 = 1;
+    // Assumes column major
+    const Layout layout = Layout::ColMajor;
+
+    // Options
+    int64_t lookahead = get_option<int64_t>( opts, Option::Lookahead, 1 );
+
+    // if on right, change to left by (conj)-transposing A and B to get
+    // op(B) = op(A)^{-1} * op(B)
+    if (side == Side::Right) {
+        if (A.op() == Op::ConjTrans || B.op() == Op::ConjTrans) {
+            A = conj_transpose(A);
+            B = conj_transpose(B);
+            alpha = conj(alpha);
+        }
+        else {
+            A = transpose(A);
+            B = transpose(B);
+        }
+    }
+
+    // B is mt-by-nt, A is mt-by-mt (assuming side = left)
+    assert(A.mt() == B.mt());
+    assert(A.nt() == B.mt());
+
+    int64_t mt = B.mt();
+    int64_t nt = B.nt();
+    assert(1 <= groups && groups <= nt);
+
+    // Requires groups*(2+lookahead) queues
+    int64_t queues_per_group = 2 + lookahead;
+    if (target == Target::Devices) {
+        assert(B.numComputeQueues() >= groups*queues_per_group);
+    }
+
+    // Dummy dependencies: acol[k] for the broadcast column k of A,
+    // comm to chain all communication.
+    std::vector<uint8_t> acol_vector( mt );
+    uint8_t* acol = acol_vector.data();
+    uint8_t comm;
+    SLATE_UNUSED( acol ); // Used only by OpenMP
+    SLATE_UNUSED( comm ); // Used only by OpenMP
+
+    bool lower = A.uplo() == Uplo::Lower;
+    for (int64_t kk = 0; kk < mt; ++kk) {
+        // Lower/NoTrans or Upper/Trans: forward sweep;
+        // Upper/NoTrans or Lower/Trans: backward sweep.
+        int64_t k = lower ? kk : mt-1 - kk;
+        scalar_t alph = kk == 0 ? alpha : one;
+
+        // Rows of B updated by column k of A.
+        int64_t i_begin = lower ? k+1 : 0;
+        int64_t i_end   = lower ? mt-1 : k-1;
+
+        // send A(k, k) and A(i_begin:i_end, k) to ranks owning
+        // block rows of B, once for all groups
+        #pragma omp task depend(inout:acol[k]) depend(inout:comm) priority(1)
+        {
+            A.template tileBcast(k, k, B.sub(k, k, 0, nt-1), layout);
+
+            BcastList bcast_list_A;
+            for (int64_t i = i_begin; i <= i_end; ++i)
+                bcast_list_A.push_back({i, k, {B.sub(i, i, 0, nt-1)}});
+            A.template listBcast<target>(bcast_list_A, layout);
+        }
+
+        for (int64_t g = 0; g < groups; ++g) {
+            int64_t j_begin = g*nt / groups;
+            int64_t j_end   = (g + 1)*nt / groups - 1;
+            uint8_t* row_g  = row + g*mt;
+            int queue_0 = g*queues_per_group;
+            int queue_1 = queue_0 + 1;
+            SLATE_UNUSED( row_g ); // Used only by OpenMP
+
+            // panel, B(k, group)
+            #pragma omp task depend(in:acol[k]) depend(inout:row_g[k]) \
+                             depend(inout:comm) priority(1)
+            {
+                // solve A(k, k) B(k, group) = alpha B(k, group)
+                internal::trsm<target>(
+                    Side::Left,
+                    alph, A.sub(k, k),
+                          B.sub(k, k, j_begin, j_end),
+                    priority_1, layout, queue_1 );
+
+                // send B(k, j) to ranks owning block col B(i_begin:i_end, j)
+                if (i_begin <= i_end) {
+                    BcastList bcast_list_B;
+                    for (int64_t j = j_begin; j <= j_end; ++j) {
+                        bcast_list_B.push_back(
+                            {k, j, {B.sub(i_begin, i_end, j, j)}});
+                    }
+                    B.template listBcast<target>(bcast_list_B, layout);
+                }
+            }
+
+            // lookahead update, la rows of B(i, group) nearest to k
+            for (int64_t d = 1; d <= lookahead; ++d) {
+                int64_t i = lower ? k+d : k-d;
+                if (i < 0 || i >= mt)
+                    break;
+
+                #pragma omp task depend(in:acol[k]) depend(in:row_g[k]) \
+                                 depend(inout:row_g[i]) priority(1)
+                {
+                    internal::gemm<target>(
+                        -one, A.sub(i, i, k, k),
+                              B.sub(k, k, j_begin, j_end),
+                        alph, B.sub(i, i, j_begin, j_end),
+                        layout, priority_1, queue_1 + d );
+                }
+            }
+
+            // trailing update of the remaining rows of B(:, group).
+            // Two depends are sufficient, as in work::trsm: the row needed
+            // in the next iteration, and the far end to daisy chain them.
+            int64_t t_begin = lower ? k+1+lookahead : 0;
+            int64_t t_end   = lower ? mt-1 : k-1-lookahead;
+            if (t_begin <= t_end) {
+                int64_t t_next = lower ? t_begin : t_end;
+                int64_t t_far  = lower ? t_end : t_begin;
+                #pragma omp task depend(in:acol[k]) depend(in:row_g[k]) \
+                                 depend(inout:row_g[t_next]) \
+                                 depend(inout:row_g[t_far])
+                {
+                    internal::gemm<target>(
+                        -one, A.sub(t_begin, t_end, k, k),
+                              B.sub(k, k, j_begin, j_end),
+                        alph, B.sub(t_begin, t_end, j_begin, j_end),
+                        layout, priority_0, queue_0 );
+                }
+            }
+
+            // Erase remote or workspace tiles of B(k, group).
+            #pragma omp task depend(inout:row_g[k])
+            {
+                auto B_panel = B.sub(k, k, j_begin, j_end);
+                B_panel.releaseRemoteWorkspace();
+
+                // Copy back modifications to tiles in the B panel
+                // before they are erased.
+                B_panel.tileUpdateAllOrigin();
+                B_panel.releaseLocalWorkspace();
+            }
+        }
+
+        // Erase remote or workspace tiles of column k of A,
+        // after every group has read it.
+        #pragma omp task depend(inout:acol[k])
+        {
+            auto A_panel = lower ? A.sub(k, mt-1, k, k) : A.sub(0, k, k, k);
+            A_panel.releaseRemoteWorkspace();
+            A_panel.releaseLocalWorkspace();
+        }
+    }
+
+    #pragma omp taskwait
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+// ----------------------------------------
+template
+void trsm_groups<Target::HostTask, float>(
+    Side side,
+    float alpha, TriangularMatrix<float> A,
+                           Matrix<float> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostNest, float>(
+    Side side,
+    float alpha, TriangularMatrix<float> A,
+                           Matrix<float> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostBatch, float>(
+    Side side,
+    float alpha, TriangularMatrix<float> A,
+                           Matrix<float> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::Devices, float>(
+    Side side,
+    float alpha, TriangularMatrix<float> A,
+                           Matrix<float> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+// ----------------------------------------
+template
+void trsm_groups<Target::HostTask, double>(
+    Side side,
+    double alpha, TriangularMatrix<double> A,
+                            Matrix<double> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostNest, double>(
+    Side side,
+    double alpha, TriangularMatrix<double> A,
+                            Matrix<double> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostBatch, double>(
+    Side side,
+    double alpha, TriangularMatrix<double> A,
+                            Matrix<double> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::Devices, double>(
+    Side side,
+    double alpha, TriangularMatrix<double> A,
+                            Matrix<double> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+// ----------------------------------------
+template
+void trsm_groups<Target::HostTask, std::complex<float>>(
+    Side side,
+    std::complex<float> alpha, TriangularMatrix<std::complex<float>> A,
+                                         Matrix<std::complex<float>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostNest, std::complex<float>>(
+    Side side,
+    std::complex<float> alpha, TriangularMatrix<std::complex<float>> A,
+                                         Matrix<std::complex<float>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostBatch, std::complex<float>>(
+    Side side,
+    std::complex<float> alpha, TriangularMatrix<std::complex<float>> A,
+                                         Matrix<std::complex<float>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::Devices, std::complex<float>>(
+    Side side,
+    std::complex<float> alpha, TriangularMatrix<std::complex<float>> A,
+                                         Matrix<std::complex<float>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+// ----------------------------------------
+template
+void trsm_groups<Target::HostTask, std::complex<double>>(
+    Side side,
+    std::complex<double> alpha, TriangularMatrix<std::complex<double>> A,
+                                          Matrix<std::complex<double>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostNest, std::complex<double>>(
+    Side side,
+    std::complex<double> alpha, TriangularMatrix<std::complex<double>> A,
+                                          Matrix<std::complex<double>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::HostBatch, std::complex<double>>(
+    Side side,
+    std::complex<double> alpha, TriangularMatrix<std::complex<double>> A,
+                                          Matrix<std::complex<double>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+template
+void trsm_groups<Target::Devices, std::complex<double>>(
+    Side side,
+    std::complex<double> alpha, TriangularMatrix<std::complex<double>> A,
+                                          Matrix<std::complex<double>> B,
+    uint8_t* row, int64_t groups, Options const& opts);
+
+} // namespace work
+} // namespace slate
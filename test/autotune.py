@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+# This program is free software: you can redistribute it and/or modify it under
+# the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+#
+# Tunes nb, ib, lookahead, and panel threads of factorizations by running
+# the tester in benchmark mode (--bench), and writes a tuning file that
+# SLATE reads via $SLATE_TUNING_FILE or slate::read_tuning_file().
+# The drivers use the tuned ib, lookahead, and panel threads when those
+# options are not given; the LAPACK and ScaLAPACK APIs also use the tuned nb.
+#
+# For each routine and size, this does a coordinate search: starting from
+# the tester's defaults, it varies one parameter at a time over its list,
+# keeping the fastest value, and repeats until a pass makes no change
+# or --passes is reached. Each trial is the median of --bench runs.
+#
+# Each size tunes a range of sizes, up to the geometric mean with the next
+# size; the largest size's parameters apply to all larger sizes.
+#
+# Example usage:
+# help
+#     ./autotune.py -h
+#
+# tune potrf and getrf on GPUs for 3 sizes, 4 ranks
+#     ./autotune.py --dim 5000,20000,50000 --grid 2x2 --target d \
+#         --output tuning.txt potrf getrf
+#     export SLATE_TUNING_FILE=$PWD/tuning.txt
+
+import argparse
+import math
+import os
+import re
+import subprocess
+import sys
+
+# ------------------------------------------------------------------------------
+# Parameters that affect each routine; also the routine whose tuning entries
+# the tester routine sets, e.g., gesv tunes getrf.
+routine_params = {
+    'potrf': ('potrf', [ 'nb', 'lookahead' ]),
+    'posv':  ('potrf', [ 'nb', 'lookahead' ]),
+    'getrf': ('getrf', [ 'nb', 'ib', 'lookahead', 'panel_threads' ]),
+    'gesv':  ('getrf', [ 'nb', 'ib', 'lookahead', 'panel_threads' ]),
+    'geqrf': ('geqrf', [ 'nb', 'ib', 'lookahead', 'panel_threads' ]),
+    'gels':  ('geqrf', [ 'nb', 'ib', 'lookahead', 'panel_threads' ]),
+}
+
+# tester option and default for each parameter
+param_options = {
+    'nb':            ('--nb',            384),
+    'ib':            ('--ib',            32),
+    'lookahead':     ('--lookahead',     1),
+    'panel_threads': ('--panel-threads', max( (os.cpu_count() or 2) // 2, 1 )),
+}
+
+target_names = {
+    't': 'HostTask', 'n': 'HostNest', 'b': 'HostBatch', 'd': 'Devices',
+}
+
+def powers_of_2( n ):
+    p = 1
+    while (p <= n):
+        yield p
+        p *= 2
+
+# ------------------------------------------------------------------------------
+# command line arguments
+parser = argparse.ArgumentParser()
+
+parser.add_argument( 'routines', nargs='+', help='routines to tune: '
+                     + ', '.join( sorted( routine_params.keys() ) ) )
+
+group_run = parser.add_argument_group( 'run' )
+group_run.add_argument( '--tester', action='store', default='./tester',
+    help='tester executable; default "%(default)s"' )
+group_run.add_argument( '--launcher', action='store', default='mpirun -np {np}',
+    help='MPI launcher, with {np} for the number of ranks; default "%(default)s"' )
+group_run.add_argument( '--grid', action='store', default='1x1',
+    help='p x q grid; default %(default)s' )
+group_run.add_argument( '--dry-run', action='store_true',
+    help='print commands, but do not execute them' )
+group_run.add_argument( '--timeout', action='store', type=float,
+    help='timeout in seconds for each trial' )
+
+group_tune = parser.add_argument_group( 'search space, as comma-separated lists' )
+group_tune.add_argument( '--dim', action='store', required=True,
+    help='sizes to tune, e.g., 5000,20000' )
+group_tune.add_argument( '--nb', action='store', default='192,256,320,384,512,768',
+    help='default %(default)s' )
+group_tune.add_argument( '--ib', action='store', default='8,16,32,64',
+    help='default %(default)s' )
+group_tune.add_argument( '--lookahead', action='store', default='0,1,2,3',
+    help='default %(default)s' )
+group_tune.add_argument( '--panel-threads', action='store',
+    default=','.join( map( str, powers_of_2( os.cpu_count() or 1 ) ) ),
+    help='default %(default)s' )
+group_tune.add_argument( '--passes', action='store', type=int, default=2,
+    help='max passes of the coordinate search; default %(default)s' )
+
+group_opt = parser.add_argument_group( 'tester options' )
+group_opt.add_argument( '--type',   action='store', default='d', help='default "%(default)s"' )
+group_opt.add_argument( '--target', action='store', default='t', help='default "%(default)s"' )
+group_opt.add_argument( '--bench',  action='store', type=int, default=3, help='timed calls per trial; default %(default)s' )
+group_opt.add_argument( '--warmup', action='store', type=int, default=1, help='untimed calls per trial; default %(default)s' )
+group_opt.add_argument( '--args',   action='store', default='',
+    help='additional tester arguments, e.g., "--origin d"' )
+
+group_out = parser.add_argument_group( 'output' )
+group_out.add_argument( '--output', action='store', default='slate_tuning.txt',
+    help='tuning file to write; entries for other routines or targets already'
+         + ' in it are kept; default "%(default)s"' )
+
+opts = parser.parse_args()
+
+# ------------------------------------------------------------------------------
+def parse_ints( s ):
+    return [ int( x ) for x in s.split( ',' ) if x.strip() ]
+
+# ------------------------------------------------------------------------------
+def parse_output( output ):
+    '''
+    Parses the tester's table. Returns dict of column name => value for the
+    first data row. Column names may have single spaces, e.g., "time (s)";
+    columns are separated by at least 2 spaces, and values are right aligned
+    under their names.
+    '''
+    lines = output.splitlines()
+    for i in range( len( lines ) ):
+        if ('time (s)' not in lines[ i ]):
+            continue
+        header = lines[ i ]
+        columns = [ (m.end(), m.group()) for m in
+                    re.finditer( r'\S+(?: \S+)*', header ) ]
+        for line in lines[ i+1: ]:
+            if (not line.strip() or line.startswith( '-' )):
+                continue
+            row = {}
+            for m in re.finditer( r'\S+', line ):
+                # column whose name ends nearest to the value's end
+                end, name = min( columns, key=lambda c: abs( c[0] - m.end() ) )
+                row[ name ] = (row[ name ] + ' ' + m.group()) if name in row else m.group()
+            return row
+    return None
+# end
+
+# ------------------------------------------------------------------------------
+s = re.search( r'^(\d+)(?:x(\d+))?$', opts.grid.strip() )
+if (not s):
+    raise ValueError( 'invalid grid: ' + opts.grid )
+p = int( s.group( 1 ) )
+q = int( s.group( 2 ) ) if s.group( 2 ) else 1
+
+space = {
+    'nb':            parse_ints( opts.nb ),
+    'ib':            parse_ints( opts.ib ),
+    'lookahead':     parse_ints( opts.lookahead ),
+    'panel_threads': parse_ints( opts.panel_threads ),
+}
+
+# ------------------------------------------------------------------------------
+cache = {}
+
+def run_trial( routine, n, point ):
+    '''
+    Runs the tester once for routine at size n with the parameters in point.
+    Returns its median time, or infinity if it failed.
+    '''
+    key = (routine, n) + tuple( sorted( point.items() ) )
+    if (key in cache):
+        return cache[ key ]
+
+    cmd = (opts.launcher.format( np=p*q ).split()
+           + [ opts.tester,
+               '--type', opts.type,
+               '--dim', str( n ),
+               '--grid', '%dx%d' % (p, q),
+               '--target', opts.target,
+               '--bench', str( opts.bench ),
+               '--warmup', str( opts.warmup ),
+               '--check', 'n', '--ref', 'n' ])
+    for (param, value) in sorted( point.items() ):
+        cmd += [ param_options[ param ][ 0 ], str( value ) ]
+    cmd += opts.args.split() + [ routine ]
+    print( ' '.join( cmd ), file=sys.stderr )
+
+    time = math.inf
+    if (not opts.dry_run):
+        try:
+            proc = subprocess.run( cmd, stdout=subprocess.PIPE,
+                                   stderr=subprocess.STDOUT,
+                                   universal_newlines=True,
+                                   timeout=opts.timeout )
+            row = parse_output( proc.stdout )
+            if (proc.returncode == 0 and row is not None):
+                time = float( row.get( 'time (s)' ) )
+            else:
+                print( proc.stdout, file=sys.stderr )
+        except (subprocess.TimeoutExpired, TypeError, ValueError):
+            pass
+        print( '    time %s' % ('%.4f' % time if time < math.inf else 'failed'),
+               file=sys.stderr )
+
+    cache[ key ] = time
+    return time
+# end
+
+# ------------------------------------------------------------------------------
+def tune( routine, n ):
+    '''
+    Coordinate search over the parameters of routine at size n.
+    Returns dict of the best parameters.
+    '''
+    params = routine_params[ routine ][ 1 ]
+
+    # start from the values nearest to the tester's defaults
+    point = {}
+    for param in params:
+        default = param_options[ param ][ 1 ]
+        point[ param ] = min( space[ param ], key=lambda v: abs( v - default ) )
+    best = run_trial( routine, n, point )
+
+    for it in range( opts.passes ):
+        changed = False
+        for param in params:
+            for value in space[ param ]:
+                if (value == point[ param ]):
+                    continue
+                trial = dict( point )
+                trial[ param ] = value
+                if ('ib' in trial and trial[ 'ib' ] > trial[ 'nb' ]):
+                    continue
+                time = run_trial( routine, n, trial )
+                if (time < best):
+                    best = time
+                    point = trial
+                    changed = True
+        if (not changed):
+            break
+    # end
+
+    print( '%s n %d: %s, time %s' % (routine, n, point,
+           '%.4f' % best if best < math.inf else 'failed'), file=sys.stderr )
+    return point if best < math.inf else None
+# end
+
+# ------------------------------------------------------------------------------
+dims = sorted( parse_ints( opts.dim ) )
+target = target_names.get( opts.target[ 0 ].lower(), opts.target )
+entries = []
+for routine in opts.routines:
+    if (routine not in routine_params):
+        print( 'unknown routine:', routine, file=sys.stderr )
+        sys.exit( 1 )
+    tuned_routine = routine_params[ routine ][ 0 ]
+    for (i, n) in enumerate( dims ):
+        point = tune( routine, n )
+        if (point is None):
+            continue
+        # range up to geometric mean with next size; last is any size (0)
+        n_max = (int( math.sqrt( n * dims[ i+1 ] ) ) if i+1 < len( dims ) else 0)
+        entries.append( (tuned_routine, target, n_max,
+                         point.get( 'nb', -1 ), point.get( 'ib', -1 ),
+                         point.get( 'lookahead', -1 ),
+                         point.get( 'panel_threads', -1 )) )
+# end
+
+if (opts.dry_run):
+    sys.exit( 0 )
+
+# keep existing entries for other routines or targets
+tuned_keys = set( (e[ 0 ], e[ 1 ]) for e in entries )
+kept = []
+if (os.path.exists( opts.output )):
+    with open( opts.output ) as f:
+        for line in f:
+            fields = line.split( '#' )[ 0 ].split()
+            if (len( fields ) == 7 and (fields[ 0 ], fields[ 1 ]) not in tuned_keys):
+                kept.append( line.rstrip( '\n' ) )
+
+with open( opts.output, 'w' ) as f:
+    f.write( '# SLATE tuned parameters, written by autotune.py\n' )
+    f.write( '# ' + ' '.join( sys.argv ) + '\n' )
+    f.write( '# routine  target     n_max     nb    ib  lookahead  panel_threads\n' )
+    for line in kept:
+        f.write( line + '\n' )
+    for e in entries:
+        f.write( '%-9s  %-9s  %7d  %5d  %4d  %9d  %13d\n' % e )
+print( 'wrote', opts.output, file=sys.stderr )
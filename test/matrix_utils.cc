@@ -8,6 +8,17 @@
 using nb_func_t = std::function< int64_t(int64_t) >;
 using dist_func_t = std::function< int(std::tuple<int64_t, int64_t>) >;
 
+//------------------------------------------------------------------------------
+/// @return pseudo-random hash of x (splitmix64 finalizer), so that the
+/// random tile sizes and rank maps are the same on all ranks.
+static uint64_t hash_index( uint64_t x )
+{
+    x += 0x9e3779b97f4a7c15;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+    return x ^ (x >> 31);
+}
+
 //------------------------------------------------------------------------------
 /// Shared logic of the allocate_test_* routines
 template <typename matrix_type, typename irregular_constructor_t,
@@ -22,7 +33,8 @@ static TestMatrix<matrix_type> allocate_test_shared(
     int p = params.grid.m();
     int q = params.grid.n();
     int64_t nb = params.nb();
-    bool nonuniform_nb = params.nonuniform_nb() == 'y';
+    char nonuniform = params.nonuniform_nb();
+    bool nonuniform_nb = nonuniform != 'n';
     slate::Origin origin = params.origin();
     slate::GridOrder grid_order = params.grid_order();
     slate::GridOrder dev_order = params.dev_order();
@@ -32,12 +44,19 @@ static TestMatrix<matrix_type> allocate_test_shared(
 
     // Functions for nonuniform tile sizes or row device distribution
     nb_func_t tileNb;
-    if (nonuniform_nb) {
+    if (nonuniform == 'y') {
         tileNb = [nb](int64_t j) {
             // for non-uniform tile size
             return (j % 2 != 0 ? nb*2 : nb);
         };
     }
+    else if (nonuniform_nb) {
+        // Random tile sizes in [ nb/2, 3nb/2 ], so the mean is about nb.
+        tileNb = [nb](int64_t j) {
+            int64_t nb_min = std::max( nb / 2, int64_t( 1 ) );
+            return nb_min + int64_t( hash_index( j ) % (nb + 1) );
+        };
+    }
     else {
         // NB. we let BaseMatrix truncate the final tile length
         // TrapezoidMatrix only takes 1 function for both dimensions (of different sizes)
@@ -46,15 +65,32 @@ static TestMatrix<matrix_type> allocate_test_shared(
         };
     }
 
-    auto tileRank = slate::func::process_2d_grid( grid_order, p, q );
+    dist_func_t tileRank;
+    if (nonuniform == 'x') {
+        // Irregular map: each block row (column) goes to a random process
+        // row (column), so ranks own different numbers of tiles, and a
+        // rank's tiles are not evenly spaced.
+        tileRank = [p, q, grid_order]( std::tuple<int64_t, int64_t> ij ) {
+            int64_t i = hash_index( std::get<0>( ij ) ) % p;
+            int64_t j = hash_index( ~std::get<1>( ij ) ) % q;
+            return int( grid_order == slate::GridOrder::Col ? i + j*p
+                                                            : i*q + j );
+        };
+    }
+    else {
+        tileRank = slate::func::process_2d_grid( grid_order, p, q );
+    }
     int num_devices_ = blas::get_device_count();
-    auto tileDevice = slate::func::device_1d_grid( dev_order, p, num_devices_ );
+    bool dev_peer = params.dev_peer() == 'y' && num_devices_ > 0;
+    auto tileDevice = dev_peer
+        ? slate::func::device_peer_grid( p, q, slate::device_peer_groups() )
+        : slate::func::device_1d_grid( dev_order, p, num_devices_ );
 
     // Setup matrix to test SLATE with
     if (origin != slate::Origin::ScaLAPACK) {
         // SLATE allocates CPU or GPU tiles.
         slate::Target origin_target = origin2target( origin );
-        if (nonuniform_nb || dev_order == slate::GridOrder::Col) {
+        if (nonuniform_nb || dev_order == slate::GridOrder::Col || dev_peer) {
             matrix.A = construct_irregular( tileNb, tileRank, tileDevice );
         }
         else {
@@ -270,6 +270,7 @@ inline void mark_params_for_test_Matrix(Params& params)
     params.origin();
     params.grid_order();
     params.dev_order();
+    params.dev_peer();
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+# This program is free software: you can redistribute it and/or modify it under
+# the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+#
+# Performance regression check: runs the tester benchmarks listed in a suite
+# file (default perf/suite.json) in benchmark mode (--bench), and compares
+# their gflop/s against the baseline for this machine,
+# perf/baseline_<machine>.json. Exits with status 1 if any benchmark is
+# slower than its baseline by more than the tolerance, so it can gate CI,
+# e.g., via `make perf-check`.
+#
+# Baselines are per machine, since rates are only comparable on the same
+# hardware; the machine name is --machine, $SLATE_PERF_MACHINE, or the
+# host name. Benchmarks without a baseline are reported but don't fail.
+# Baselines and results are JSON files, to be tracked in version control.
+#
+# Example usage:
+# help
+#     ./perf_check.py -h
+#
+# record a baseline on this machine, e.g., from a release
+#     ./perf_check.py --update
+#
+# check against it, saving results
+#     ./perf_check.py --results results.json
+#
+# check only gemm and potrf benchmarks, including GPU ones, 5% tolerance
+#     ./perf_check.py --devices --tolerance 0.05 gemm potrf
+
+import argparse
+import datetime
+import json
+import os
+import re
+import socket
+import subprocess
+import sys
+
+script_dir = os.path.dirname( os.path.abspath( __file__ ) )
+
+# ------------------------------------------------------------------------------
+# command line arguments
+parser = argparse.ArgumentParser()
+
+parser.add_argument( 'filters', nargs='*',
+    help='run only benchmarks whose name or routine contains one of these' )
+
+group_run = parser.add_argument_group( 'run' )
+group_run.add_argument( '--tester', action='store', default='./tester',
+    help='tester executable; default "%(default)s"' )
+group_run.add_argument( '--launcher', action='store', default='mpirun -np {np}',
+    help='MPI launcher, with {np} for the number of ranks; default "%(default)s"' )
+group_run.add_argument( '--suite', action='store',
+    default=os.path.join( script_dir, 'perf', 'suite.json' ),
+    help='suite file; default "%(default)s"' )
+group_run.add_argument( '--devices', action='store_true',
+    help='also run benchmarks that need GPUs' )
+group_run.add_argument( '--bench', action='store', type=int, default=5,
+    help='timed calls per benchmark; default %(default)s' )
+group_run.add_argument( '--warmup', action='store', type=int, default=1,
+    help='untimed calls per benchmark; default %(default)s' )
+group_run.add_argument( '--dry-run', action='store_true',
+    help='print commands, but do not execute them' )
+group_run.add_argument( '--timeout', action='store', type=float,
+    help='timeout in seconds for each benchmark' )
+
+group_base = parser.add_argument_group( 'baselines' )
+group_base.add_argument( '--machine', action='store',
+    default=os.environ.get( 'SLATE_PERF_MACHINE', socket.gethostname().split( '.' )[ 0 ] ),
+    help='machine name for the baseline file; default "%(default)s"' )
+group_base.add_argument( '--baseline', action='store',
+    help='baseline file; default perf/baseline_<machine>.json next to the suite' )
+group_base.add_argument( '--tolerance', action='store', type=float,
+    help='allowed relative slowdown, e.g., 0.1 for 10%%; default from suite' )
+group_base.add_argument( '--update', action='store_true',
+    help='write the results as the new baseline, instead of checking' )
+group_base.add_argument( '--results', action='store',
+    help='JSON file to write the results to' )
+
+opts = parser.parse_args()
+
+# ------------------------------------------------------------------------------
+def parse_output( output ):
+    '''
+    Parses the tester's table. Returns dict of column name => value for the
+    first data row. Column names may have single spaces, e.g., "time (s)";
+    columns are separated by at least 2 spaces, and values are right aligned
+    under their names.
+    '''
+    lines = output.splitlines()
+    for i in range( len( lines ) ):
+        if ('time (s)' not in lines[ i ]):
+            continue
+        header = lines[ i ]
+        columns = [ (m.end(), m.group()) for m in
+                    re.finditer( r'\S+(?: \S+)*', header ) ]
+        for line in lines[ i+1: ]:
+            if (not line.strip() or line.startswith( '-' )):
+                continue
+            row = {}
+            for m in re.finditer( r'\S+', line ):
+                # column whose name ends nearest to the value's end
+                end, name = min( columns, key=lambda c: abs( c[0] - m.end() ) )
+                row[ name ] = (row[ name ] + ' ' + m.group()) if name in row else m.group()
+            return row
+    return None
+# end
+
+# ------------------------------------------------------------------------------
+def to_float( value ):
+    try:
+        return float( value )
+    except (TypeError, ValueError):
+        return None
+# end
+
+# ------------------------------------------------------------------------------
+def run_benchmark( name, bm ):
+    '''
+    Runs one benchmark from the suite.
+    Returns dict of results, or None if it failed.
+    '''
+    s = re.search( r'^(\d+)x(\d+)$', bm.get( 'grid', '1x1' ) )
+    if (not s):
+        raise ValueError( name + ': invalid grid ' + bm[ 'grid' ] )
+    np = int( s.group( 1 ) ) * int( s.group( 2 ) )
+    cmd = (opts.launcher.format( np=np ).split()
+           + [ opts.tester,
+               '--type',   bm.get( 'type', 'd' ),
+               '--dim',    str( bm[ 'dim' ] ),
+               '--nb',     str( bm.get( 'nb', 384 ) ),
+               '--grid',   bm.get( 'grid', '1x1' ),
+               '--target', bm.get( 'target', 't' ),
+               '--bench',  str( opts.bench ),
+               '--warmup', str( opts.warmup ),
+               '--check', 'n', '--ref', 'n' ]
+           + bm.get( 'args', '' ).split()
+           + [ bm[ 'routine' ] ])
+    print( ' '.join( cmd ), file=sys.stderr )
+    if (opts.dry_run):
+        return None
+
+    try:
+        proc = subprocess.run( cmd, stdout=subprocess.PIPE,
+                               stderr=subprocess.STDOUT,
+                               universal_newlines=True,
+                               timeout=opts.timeout )
+        output = proc.stdout
+        status = proc.returncode
+    except subprocess.TimeoutExpired:
+        output = ''
+        status = 'timeout'
+    row = parse_output( output )
+    if (status != 0 or row is None or to_float( row.get( 'gflop/s' ) ) is None):
+        print( output, file=sys.stderr )
+        print( 'FAILED: status', status, file=sys.stderr )
+        return None
+
+    return {
+        'gflops':   to_float( row.get( 'gflop/s' ) ),
+        'time':     to_float( row.get( 'time (s)' ) ),
+        'time_min': to_float( row.get( 'min (s)' ) ),
+        'time_p95': to_float( row.get( 'p95 (s)' ) ),
+    }
+# end
+
+# ------------------------------------------------------------------------------
+with open( opts.suite ) as f:
+    suite = json.load( f )
+
+tolerance = opts.tolerance
+if (tolerance is None):
+    tolerance = suite.get( 'tolerance', 0.10 )
+
+baseline_file = opts.baseline
+if (baseline_file is None):
+    baseline_file = os.path.join( os.path.dirname( os.path.abspath( opts.suite ) ),
+                                  'baseline_' + opts.machine + '.json' )
+baseline = { 'machine': opts.machine, 'results': {} }
+if (os.path.exists( baseline_file )):
+    with open( baseline_file ) as f:
+        baseline = json.load( f )
+
+results = {}
+failed = []
+regressed = []
+
+for (name, bm) in sorted( suite[ 'benchmarks' ].items() ):
+    if (opts.filters and not any( flt in name or flt == bm[ 'routine' ]
+                                  for flt in opts.filters )):
+        continue
+    if (bm.get( 'devices', False ) and not opts.devices):
+        continue
+
+    result = run_benchmark( name, bm )
+    if (opts.dry_run):
+        continue
+    if (result is None):
+        failed.append( name )
+        continue
+    results[ name ] = result
+
+    base = baseline[ 'results' ].get( name )
+    if (base is None or not base.get( 'gflops' )):
+        status = 'no baseline'
+    else:
+        ratio = result[ 'gflops' ] / base[ 'gflops' ]
+        result[ 'ratio' ] = ratio
+        if (ratio < 1 - tolerance):
+            status = 'REGRESSION'
+            regressed.append( name )
+        elif (ratio > 1 + tolerance):
+            status = 'faster'
+        else:
+            status = 'ok'
+    print( '%-20s  %12.3f gflop/s  baseline %12s  %7s  %s'
+           % (name, result[ 'gflops' ],
+              '%.3f' % base[ 'gflops' ] if base and base.get( 'gflops' ) else '-',
+              '%.3f' % result[ 'ratio' ] if 'ratio' in result else '-',
+              status) )
+# end
+
+if (opts.dry_run):
+    sys.exit( 0 )
+
+now = datetime.datetime.now().isoformat( timespec='seconds' )
+if (opts.results):
+    with open( opts.results, 'w' ) as f:
+        json.dump( { 'machine':   opts.machine,
+                     'date':      now,
+                     'tolerance': tolerance,
+                     'results':   results,
+                     'regressed': regressed,
+                     'failed':    failed }, f, indent=4, sort_keys=True )
+        f.write( '\n' )
+
+if (opts.update):
+    # merge, keeping baselines of benchmarks not run
+    baseline[ 'machine' ] = opts.machine
+    baseline[ 'date' ] = now
+    for (name, result) in results.items():
+        result.pop( 'ratio', None )
+        baseline[ 'results' ][ name ] = result
+    with open( baseline_file, 'w' ) as f:
+        json.dump( baseline, f, indent=4, sort_keys=True )
+        f.write( '\n' )
+    print( 'wrote baseline', baseline_file, file=sys.stderr )
+    sys.exit( 1 if failed else 0 )
+
+print( '%d benchmarks, %d regressed, %d failed (tolerance %.0f%%, baseline %s)'
+       % (len( results ) + len( failed ), len( regressed ), len( failed ),
+          100 * tolerance, baseline_file) )
+sys.exit( 1 if (regressed or failed) else 0 )
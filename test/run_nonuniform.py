@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+# This program is free software: you can redistribute it and/or modify it under
+# the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+#
+# Runs routines with the tester in benchmark mode (--bench) on non-uniform
+# tile layouts, and reports each layout's performance relative to uniform
+# tiles of size nb, on the same matrix size. Layouts are the tester's
+# --nonuniform-nb values:
+#     n: uniform nb (the baseline)
+#     y: alternating nb, 2nb
+#     r: random tile sizes in [nb/2, 3nb/2]
+#     x: random tile sizes, with an irregular tile-to-rank map
+#
+# Matrix sizes are --dim, plus --fuzz random sizes in [dim/2, dim] drawn with
+# --seed, which are generally not multiples of nb, so the last tiles are
+# ragged. Non-uniform tiles exercise the 4-region batching fallbacks in
+# device_regions_build and oversized Memory blocks; the host MB and dev MB
+# columns show the peak memory of each run.
+#
+# Example usage:
+# help
+#     ./run_nonuniform.py -h
+#
+# gemm and potrf on 4 ranks, with 3 fuzzed sizes
+#     ./run_nonuniform.py --dim 8000 --grid 2x2 --fuzz 3 gemm potrf
+#
+# on GPUs, writing JSON
+#     ./run_nonuniform.py --dim 20000 --target d --json nonuniform.json gemm getrf
+
+import argparse
+import csv
+import json
+import random
+import re
+import subprocess
+import sys
+
+# ------------------------------------------------------------------------------
+# command line arguments
+parser = argparse.ArgumentParser()
+
+parser.add_argument( 'routines', nargs='*', default=[ 'gemm', 'potrf', 'getrf', 'geqrf' ],
+    help='routines to run; default gemm potrf getrf geqrf' )
+
+group_run = parser.add_argument_group( 'run' )
+group_run.add_argument( '--tester', action='store', default='./tester',
+    help='tester executable; default "%(default)s"' )
+group_run.add_argument( '--launcher', action='store', default='mpirun -np {np}',
+    help='MPI launcher, with {np} for the number of ranks; default "%(default)s"' )
+group_run.add_argument( '--dry-run', action='store_true',
+    help='print commands, but do not execute them' )
+group_run.add_argument( '--timeout', action='store', type=float,
+    help='timeout in seconds for each run' )
+
+group_shape = parser.add_argument_group( 'shapes' )
+group_shape.add_argument( '--dim', action='store', type=int, default=4000,
+    help='matrix size; default %(default)s' )
+group_shape.add_argument( '--fuzz', action='store', type=int, default=0,
+    help='number of additional random sizes in [dim/2, dim]; default %(default)s' )
+group_shape.add_argument( '--seed', action='store', type=int, default=42,
+    help='seed for the random sizes; default %(default)s' )
+group_shape.add_argument( '--layouts', action='store', default='n,y,r,x',
+    help='comma-separated --nonuniform-nb values; the first is the baseline; default "%(default)s"' )
+
+group_opt = parser.add_argument_group( 'tester options' )
+group_opt.add_argument( '--type',   action='store', default='d', help='default "%(default)s"' )
+group_opt.add_argument( '--nb',     action='store', type=int, default=256, help='default %(default)s' )
+group_opt.add_argument( '--grid',   action='store', default='1x1', help='default "%(default)s"' )
+group_opt.add_argument( '--target', action='store', default='t', help='default "%(default)s"' )
+group_opt.add_argument( '--bench',  action='store', type=int, default=5, help='timed calls; default %(default)s' )
+group_opt.add_argument( '--warmup', action='store', type=int, default=1, help='untimed calls; default %(default)s' )
+group_opt.add_argument( '--args',   action='store', default='',
+    help='additional tester arguments, e.g., "--lookahead 2"' )
+
+group_out = parser.add_argument_group( 'output' )
+group_out.add_argument( '--json', action='store', help='JSON file to write' )
+group_out.add_argument( '--csv',  action='store', help='CSV file to write' )
+
+opts = parser.parse_args()
+
+# ------------------------------------------------------------------------------
+def parse_output( output ):
+    '''
+    Parses the tester's table. Returns dict of column name => value for the
+    first data row. Column names may have single spaces, e.g., "time (s)";
+    columns are separated by at least 2 spaces, and values are right aligned
+    under their names.
+    '''
+    lines = output.splitlines()
+    for i in range( len( lines ) ):
+        if ('time (s)' not in lines[ i ]):
+            continue
+        header = lines[ i ]
+        columns = [ (m.end(), m.group()) for m in
+                    re.finditer( r'\S+(?: \S+)*', header ) ]
+        for line in lines[ i+1: ]:
+            if (not line.strip() or line.startswith( '-' )):
+                continue
+            row = {}
+            for m in re.finditer( r'\S+', line ):
+                # column whose name ends nearest to the value's end
+                end, name = min( columns, key=lambda c: abs( c[0] - m.end() ) )
+                row[ name ] = (row[ name ] + ' ' + m.group()) if name in row else m.group()
+            return row
+    return None
+# end
+
+# ------------------------------------------------------------------------------
+def to_float( value ):
+    try:
+        return float( value )
+    except (TypeError, ValueError):
+        return None
+# end
+
+# ------------------------------------------------------------------------------
+s = re.search( r'^(\d+)x(\d+)$', opts.grid )
+if (not s):
+    print( 'invalid grid: ' + opts.grid, file=sys.stderr )
+    sys.exit( 1 )
+np = int( s.group( 1 ) ) * int( s.group( 2 ) )
+
+rng = random.Random( opts.seed )
+dims = [ opts.dim ] + [ rng.randint( max( opts.dim // 2, 1 ), opts.dim )
+                        for i in range( opts.fuzz ) ]
+layouts = opts.layouts.split( ',' )
+
+results = []
+err = 0
+
+print( '%-8s  %7s  %6s  %10s  %12s  %8s  %9s  %9s'
+       % ('routine', 'n', 'layout', 'time (s)', 'gflop/s', 'relative',
+          'host MB', 'dev MB') )
+for routine in opts.routines:
+    for n in dims:
+        base = None
+        for layout in layouts:
+            cmd = (opts.launcher.format( np=np ).split()
+                   + [ opts.tester,
+                       '--type', opts.type,
+                       '--dim', str( n ),
+                       '--nb', str( opts.nb ),
+                       '--grid', opts.grid,
+                       '--target', opts.target,
+                       '--nonuniform-nb', layout,
+                       '--bench', str( opts.bench ),
+                       '--warmup', str( opts.warmup ),
+                       '--check', 'n', '--ref', 'n' ]
+                   + opts.args.split()
+                   + [ routine ])
+            print( ' '.join( cmd ), file=sys.stderr )
+            if (opts.dry_run):
+                continue
+
+            try:
+                proc = subprocess.run( cmd, stdout=subprocess.PIPE,
+                                       stderr=subprocess.STDOUT,
+                                       universal_newlines=True,
+                                       timeout=opts.timeout )
+                output = proc.stdout
+                status = proc.returncode
+            except subprocess.TimeoutExpired:
+                output = ''
+                status = 'timeout'
+            row = parse_output( output )
+            gflops = to_float( row.get( 'gflop/s' ) ) if row else None
+            if (status != 0 or gflops is None):
+                print( output, file=sys.stderr )
+                print( 'FAILED: status', status, file=sys.stderr )
+                err += 1
+                continue
+
+            result = {
+                'routine':  routine,
+                'type':     opts.type,
+                'target':   opts.target,
+                'grid':     opts.grid,
+                'n':        n,
+                'nb':       opts.nb,
+                'layout':   layout,
+                'time':     to_float( row.get( 'time (s)' ) ),
+                'time_min': to_float( row.get( 'min (s)' ) ),
+                'gflops':   gflops,
+                'relative': None,
+                'mem_host': to_float( row.get( 'host MB' ) ),
+                'mem_dev':  to_float( row.get( 'dev MB' ) ),
+            }
+            if (base is None):
+                base = result
+            if (base[ 'gflops' ]):
+                result[ 'relative' ] = gflops / base[ 'gflops' ]
+            results.append( result )
+
+            print( '%-8s  %7d  %6s  %10.4f  %12.3f  %8s  %9s  %9s'
+                   % (routine, n, layout, result[ 'time' ] or 0, gflops,
+                      '%.3f' % result[ 'relative' ]
+                      if result[ 'relative' ] is not None else '-',
+                      '%.1f' % result[ 'mem_host' ]
+                      if result[ 'mem_host' ] is not None else '-',
+                      '%.1f' % result[ 'mem_dev' ]
+                      if result[ 'mem_dev' ] is not None else '-') )
+        # end layouts
+    # end dims
+# end routines
+
+if (opts.json):
+    with open( opts.json, 'w' ) as f:
+        json.dump( results, f, indent=4 )
+        f.write( '\n' )
+
+if (opts.csv and results):
+    with open( opts.csv, 'w', newline='' ) as f:
+        writer = csv.DictWriter( f, fieldnames=list( results[ 0 ].keys() ) )
+        writer.writeheader()
+        writer.writerows( results )
+
+sys.exit( err )
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+# This program is free software: you can redistribute it and/or modify it under
+# the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+#
+# Runs weak or strong scaling studies of a routine with the tester in
+# benchmark mode (--bench), and writes the results as JSON and/or CSV.
+#
+# Weak scaling keeps n^2 / P fixed, starting from --dim on the first grid;
+# strong scaling keeps n = --dim fixed. Parallel efficiency is relative to
+# the first grid:
+#     strong: (time_1 * P_1) / (time * P)
+#     weak:   (gflops / P) / (gflops_1 / P_1)
+#
+# Example usage:
+# help
+#     ./run_scaling.py -h
+#
+# weak scaling of double precision gemm on 1, 4, 16 ranks
+#     ./run_scaling.py --weak --dim 10000 --grid 1x1,2x2,4x4 --json gemm.json gemm
+#
+# strong scaling of potrf on GPUs, with a site-specific launcher
+#     ./run_scaling.py --strong --dim 50000 --grid 1x2,2x2,2x4 --target d \
+#         --launcher 'srun -n {np}' --csv potrf.csv potrf
+
+import argparse
+import csv
+import json
+import math
+import re
+import subprocess
+import sys
+
+# ------------------------------------------------------------------------------
+# command line arguments
+parser = argparse.ArgumentParser()
+
+parser.add_argument( 'routine', help='routine to run, e.g., gemm' )
+
+group_run = parser.add_argument_group( 'run' )
+group_run.add_argument( '--tester', action='store', default='./tester',
+    help='tester executable; default "%(default)s"' )
+group_run.add_argument( '--launcher', action='store', default='mpirun -np {np}',
+    help='MPI launcher, with {np} for the number of ranks; default "%(default)s"' )
+group_run.add_argument( '--dry-run', action='store_true',
+    help='print commands, but do not execute them' )
+group_run.add_argument( '--timeout', action='store', type=float,
+    help='timeout in seconds for each run' )
+
+group_scale = parser.add_argument_group( 'scaling' )
+mode = group_scale.add_mutually_exclusive_group( required=True )
+mode.add_argument( '--weak',   action='store_true', help='keep n^2 / P fixed' )
+mode.add_argument( '--strong', action='store_true', help='keep n fixed' )
+group_scale.add_argument( '--dim', action='store', type=int, required=True,
+    help='n on the first grid' )
+group_scale.add_argument( '--grid', action='store', required=True,
+    help='comma-separated p x q grids, e.g., 1x1,2x2,4x4, or rank counts, e.g., 1,4,16, for p x 1 grids' )
+
+group_opt = parser.add_argument_group( 'tester options' )
+group_opt.add_argument( '--type',   action='store', default='d', help='default "%(default)s"' )
+group_opt.add_argument( '--nb',     action='store', type=int, default=384, help='default %(default)s' )
+group_opt.add_argument( '--target', action='store', default='t', help='default "%(default)s"' )
+group_opt.add_argument( '--origin', action='store', default='', help='default tester default' )
+group_opt.add_argument( '--bench',  action='store', type=int, default=5, help='timed calls; default %(default)s' )
+group_opt.add_argument( '--warmup', action='store', type=int, default=1, help='untimed calls; default %(default)s' )
+group_opt.add_argument( '--args',   action='store', default='',
+    help='additional tester arguments, e.g., "--lookahead 2"' )
+
+group_out = parser.add_argument_group( 'output' )
+group_out.add_argument( '--json', action='store', help='JSON file to write' )
+group_out.add_argument( '--csv',  action='store', help='CSV file to write' )
+
+opts = parser.parse_args()
+
+# ------------------------------------------------------------------------------
+def parse_grids( grid_str ):
+    '''
+    Returns list of (p, q) from "1x1,2x2" or "1,4".
+    '''
+    grids = []
+    for g in grid_str.split( ',' ):
+        s = re.search( r'^(\d+)(?:x(\d+))?$', g.strip() )
+        if (not s):
+            raise ValueError( 'invalid grid: ' + g )
+        p = int( s.group( 1 ) )
+        q = int( s.group( 2 ) ) if s.group( 2 ) else 1
+        grids.append( (p, q) )
+    return grids
+# end
+
+# ------------------------------------------------------------------------------
+def scaled_dim( n1, P1, P ):
+    '''
+    Returns n for P ranks: n1 for strong scaling; for weak scaling,
+    n1 * sqrt( P / P1 ), rounded to a multiple of nb.
+    '''
+    if (opts.strong):
+        return n1
+    n = n1 * math.sqrt( P / P1 )
+    return max( opts.nb, int( round( n / opts.nb ) ) * opts.nb )
+# end
+
+# ------------------------------------------------------------------------------
+def parse_output( output ):
+    '''
+    Parses the tester's table. Returns dict of column name => value for the
+    first data row. Column names may have single spaces, e.g., "time (s)";
+    columns are separated by at least 2 spaces, and values are right aligned
+    under their names.
+    '''
+    lines = output.splitlines()
+    for i in range( len( lines ) ):
+        if ('time (s)' not in lines[ i ]):
+            continue
+        header = lines[ i ]
+        columns = [ (m.end(), m.group()) for m in
+                    re.finditer( r'\S+(?: \S+)*', header ) ]
+        for line in lines[ i+1: ]:
+            if (not line.strip() or line.startswith( '-' )):
+                continue
+            row = {}
+            for m in re.finditer( r'\S+', line ):
+                # column whose name ends nearest to the value's end
+                end, name = min( columns, key=lambda c: abs( c[0] - m.end() ) )
+                row[ name ] = (row[ name ] + ' ' + m.group()) if name in row else m.group()
+            return row
+    return None
+# end
+
+# ------------------------------------------------------------------------------
+def to_float( value ):
+    try:
+        return float( value )
+    except (TypeError, ValueError):
+        return None
+# end
+
+# ------------------------------------------------------------------------------
+grids = parse_grids( opts.grid )
+P1 = grids[ 0 ][ 0 ] * grids[ 0 ][ 1 ]
+results = []
+base = None
+err = 0
+
+for (p, q) in grids:
+    P = p*q
+    n = scaled_dim( opts.dim, P1, P )
+    cmd = (opts.launcher.format( np=P ).split()
+           + [ opts.tester,
+               '--type', opts.type,
+               '--dim', str( n ),
+               '--nb', str( opts.nb ),
+               '--grid', '%dx%d' % (p, q),
+               '--target', opts.target,
+               '--bench', str( opts.bench ),
+               '--warmup', str( opts.warmup ),
+               '--check', 'n', '--ref', 'n' ]
+           + ([ '--origin', opts.origin ] if opts.origin else [])
+           + opts.args.split()
+           + [ opts.routine ])
+    print( ' '.join( cmd ), file=sys.stderr )
+    if (opts.dry_run):
+        continue
+
+    try:
+        proc = subprocess.run( cmd, stdout=subprocess.PIPE,
+                               stderr=subprocess.STDOUT,
+                               universal_newlines=True,
+                               timeout=opts.timeout )
+        output = proc.stdout
+        status = proc.returncode
+    except subprocess.TimeoutExpired:
+        output = ''
+        status = 'timeout'
+    row = parse_output( output )
+    if (status != 0 or row is None):
+        print( output, file=sys.stderr )
+        print( 'FAILED: status', status, file=sys.stderr )
+        err += 1
+        continue
+
+    time   = to_float( row.get( 'time (s)' ) )
+    gflops = to_float( row.get( 'gflop/s' ) )
+    result = {
+        'routine':     opts.routine,
+        'mode':        'weak' if opts.weak else 'strong',
+        'type':        opts.type,
+        'target':      opts.target,
+        'p':           p,
+        'q':           q,
+        'ranks':       P,
+        'n':           n,
+        'nb':          opts.nb,
+        'time':        time,
+        'time_min':    to_float( row.get( 'min (s)' ) ),
+        'time_p95':    to_float( row.get( 'p95 (s)' ) ),
+        'gflops':      gflops,
+        'comm_mbytes': to_float( row.get( 'comm MB' ) ),
+        'comm_msgs':   to_float( row.get( 'messages' ) ),
+        'efficiency':  None,
+    }
+    if (base is None):
+        base = result
+    if (opts.strong and time and base[ 'time' ]):
+        result[ 'efficiency' ] = (base[ 'time' ] * base[ 'ranks' ]) / (time * P)
+    elif (opts.weak and gflops and base[ 'gflops' ]):
+        result[ 'efficiency' ] = (gflops / P) / (base[ 'gflops' ] / base[ 'ranks' ])
+    results.append( result )
+
+    print( '%5d ranks  n %7d  time %10.4f s  %12.3f gflop/s  efficiency %s'
+           % (P, n, time or 0, gflops or 0,
+              '%.3f' % result[ 'efficiency' ]
+              if result[ 'efficiency' ] is not None else '-') )
+# end
+
+if (opts.json):
+    with open( opts.json, 'w' ) as f:
+        json.dump( results, f, indent=4 )
+        f.write( '\n' )
+
+if (opts.csv and results):
+    with open( opts.csv, 'w', newline='' ) as f:
+        writer = csv.DictWriter( f, fieldnames=list( results[ 0 ].keys() ) )
+        writer.writeheader()
+        writer.writerows( results )
+
+sys.exit( err )
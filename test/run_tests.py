@@ -348,6 +348,10 @@ incx_pos = ' --incx ' + filter_csv( ('1', '2'), opts.incx )
 incy_pos = ' --incy ' + filter_csv( ('1', '2'), opts.incy )
 
 # ------------------------------------------------------------------------------
+# Optional 3rd entry of a command: environment variables to set, e.g.,
+# to run drivers ported to the task runtime with its stealing backend.
+stealing = { 'SLATE_TASK_BACKEND': 'stealing' }
+
 cmds = []
 
 # Level 3
@@ -358,10 +362,12 @@ if (opts.blas3):
     [ 'gemm',  gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
     [ 'gemmA', gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
     [ 'gemmC', gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
+    [ 'gemmC', gen + dtype + la + transA + transB + mnk + ab + matrixBC + ge_matrix, stealing ],
+    [ 'gemm25D', gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
+    [ 'gemmStrassen', gen + dtype + la + transA + transB + mnk + ab + matrixBC + nonuniform_nb + ge_matrix ],
 
     [ 'hemm',  gen + dtype         + la + side + he_matrix     + mn + ab + matrixBC ],
-    # todo: hemmA GPU support
-    [ 'hemmA', gen_no_target + dtype + la + side + he_matrix   + mn + ab + matrixBC ],
+    [ 'hemmA', gen + dtype + la + side + he_matrix   + mn + ab + matrixBC ],
     [ 'hemmC', gen + dtype         + la + side + he_matrix     + mn + ab + matrixBC],
 
     [ 'hbmm',  gen + dtype         + la + side + uplo     + mn + ab + kd + matrixBC ],
@@ -400,6 +406,10 @@ if (opts.lu):
 
     # todo: mn
     [ 'getrf',        gen + dtype + la + n + ge_matrix + nonuniform_nb + thresh ],
+    [ 'getrf',        gen + dtype + la + n + ge_matrix + ' --max-lookahead 4' ],
+    [ 'getrf',        gen + dtype + la + n + ge_matrix, stealing ],
+    # Batched drivers are local to each rank; compared with getrf.
+    [ 'getrf_batch',  check + tol + repeat + nb + dtype + mn + ' --batch 1,7' ],
     [ 'getrf_tntpiv', gen + dtype + la + n + ge_matrix ],
     [ 'getrf_nopiv',  gen + dtype + la + n + ge_matrix + nonuniform_nb
                       + ' --matrix rand_dominant' ],
@@ -414,7 +424,9 @@ if (opts.lu):
     #[ 'gerfs', gen + dtype + la + n + trans ],
     #[ 'geequ', gen + dtype + la + n ],
     [ 'gesv_mixed',   gen + dtype_double + la + n + ge_matrix + nonuniform_nb ],
-    [ 'gesv_mixed_gmres',  gen + dtype_double + la + n + ' --nrhs 1' + ge_matrix + nonuniform_nb ],
+    [ 'gesv_mixed_gmres',  gen + dtype_double + la + n + ' --nrhs 1,4' + ge_matrix + nonuniform_nb ],
+    [ 'gesv_mixed_solve',  gen + dtype_double + la + n + ge_matrix ],
+    [ 'gesv_mixed_gmres_solve', gen + dtype_double + la + n + ' --nrhs 1,4' + ge_matrix ],
     [ 'gesv_rbt', gen + dtype + la + n + ge_matrix ],
     ]
 
@@ -432,9 +444,18 @@ if (opts.lu_band):
 if (opts.chol):
     cmds += [
     [ 'posv',  gen + dtype + la + n + he_matrix ],
+    [ 'posv',  gen + dtype + la + n + he_matrix + ' --invert-diag y' ],
+    [ 'posv',  gen + dtype + la + n + he_matrix + ' --method-cholesky left,recursive' ],
     [ 'potrf', gen + dtype + la + n + he_matrix ],
+    [ 'potrf', gen + dtype + la + n + he_matrix + ' --max-lookahead 4' ],
+    [ 'potrf', gen + dtype + la + n + he_matrix, stealing ],
+    [ 'potrf', gen + dtype + la + n + he_matrix + ' --invert-diag y' ],
+    [ 'potrf', gen + dtype + la + n + he_matrix + ' --method-cholesky left,recursive' ],
+    [ 'potrf_batch', check + tol + repeat + nb + dtype + n + ' --batch 1,7' ],
     [ 'potrs', gen + dtype + la + n + he_matrix ],
     [ 'potri', gen + dtype + la + n ],
+    [ 'potrf_update',   gen + dtype + la + mnk + uplo ],
+    [ 'potrf_downdate', gen + dtype + la + mnk + uplo ],
     #[ 'porfs', gen + dtype + la + n + uplo ],
     #[ 'poequ', gen + dtype + la + n ],  # only diagonal elements (no uplo)
     [ 'posv_mixed', gen + dtype_double + la + n + he_matrix ],
@@ -480,6 +501,9 @@ if (opts.least_squares):
     cmds += [
     # todo: mn (i.e., add wide)
     [ 'gels',   gen + dtype + la + n + tall + trans_nc + ' --method-gels qr' ],
+    # TSQR needs whole block rows per rank; other cases fall back to qr.
+    [ 'gels',   gen + dtype + la + n + tall + trans_nc + ' --method-gels tsqr' ],
+    [ 'gels',   gen + dtype + la + n + tall + trans_nc + ' --method-gels sketch' ],
     # Cholesky QR needs well-conditioned problem.
     [ 'gels',   gen + la + n + tall + trans_nc + ' --method-gels cholqr --matrix svd --cond 1e3 --type s,c' ],
     [ 'gels',   gen + la + n + tall + trans_nc + ' --method-gels cholqr --matrix svd --cond 1e3 --type d,z' ],
@@ -493,7 +517,14 @@ if (opts.least_squares):
 if (opts.qr):
     cmds += [
     [ 'cholqr', gen + dtype + la + n + tall ],  # not wide
+    [ 'cholqr', gen + la + n + tall + ' --cholqr-passes 2,3 --matrix svd --cond 1e3 --type s,c' ],
+    [ 'cholqr', gen + la + n + tall + ' --cholqr-passes 2,3 --matrix svd --cond 1e7 --type d,z' ],
     [ 'geqrf', gen + dtype + la + mn ],
+    [ 'geqrf', gen + dtype + la + mn + ' --max-lookahead 4' ],
+    [ 'geqrf', gen + dtype + la + mn, stealing ],
+    [ 'geqrf_batch', check + tol + repeat + nb + dtype + mn + ' --batch 1,7' ],
+    [ 'geqrf_append', gen + dtype + la + mnk ],  # m >= n
+    [ 'geqrf_delete', gen + dtype + la + mnk ],  # m >= n
     [ 'unmqr', gen + dtype + la + mn ],
     #[ 'ggqrf', gen + dtype + la + mnk ],
     #[ 'ungqr', gen + dtype + la + mn ],  # m >= n
@@ -535,10 +566,22 @@ if (opts.rq):
 if (opts.syev):
     # todo: uplo
     if ('n' in jobz):
-        # Requires ref to check. Only QR.
-        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz n --ref y --method-eig qr' ]]
+        # Requires ref to check. Only QR and bisection.
+        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz n --ref y --method-eig qr,bi' ]]
     if ('v' in jobz):
-        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz v --method-eig qr,dc' ]]
+        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz v --method-eig qr,dc,bi' ]]
+        cmds += [[ 'heev', gen + dtype + la + n + ' --jobz v --method-eig qdwh' ]]
+        # Small nb, so stedc merges several tiles, writing U after set()
+        # made its tiles Zero.
+        cmds += [[ 'heev', gen_no_nb + ' --nb 8' + dtype + la + n + ' --jobz v --method-eig dc' ]]
+    # Subset of eigenpairs, by index or value range.
+    cmds += [[ 'heev', gen + dtype + la + n + jobz + ' --ref y --range i,v' ]]
+    # Pipelined he2hb, gather, and hb2st.
+    cmds += [[ 'heev', gen + dtype + la + n + jobz + ' --pipeline y' ]]
+    # Matrix functions by iteration, without eigenvectors.
+    cmds += [[ 'inv_sqrt', gen + dtype + la + n + ' --method-matfunc ns,db' ]]
+    cmds += [[ 'matrix_sign', gen + dtype + la + n + ' --method-matfunc ns,newton --matrix rand_dominant' ]]
+    cmds += [[ 'matrix_sign', gen + dtype + la + n + ' --method-matfunc newton' ]]
 
     cmds += [
     # heev uses only side=l, no-trans. side=r and trans don't yet work
@@ -558,6 +601,7 @@ if (opts.syev):
     [ 'hb2st', gen_no_target + dtype + n ],
 
     [ 'stedc', gen + n ],
+    [ 'stedc', gen_no_nb + ' --nb 8' + n ],
     # Components of stedc; let's not test separately unless there's an issue.
     [ 'stedc_deflate',  gen_no_target + ' --ref y' + n ],
     [ 'stedc_secular',  gen_no_target + ' --ref y' + n ],
@@ -567,12 +611,14 @@ if (opts.syev):
     # sterf doesn't take origin, target, nb, uplo
     [ 'sterf',  grid + check + ref + tol + repeat + dtype + n ],
     [ 'steqr2', grid + check + ref + tol + repeat + dtype + n ],
+    [ 'stebz',  grid + check + ref + tol + repeat + dtype + n ],
     ]
 
 # generalized symmetric/Hermitian eigenvalues
 if (opts.sygv):
     cmds += [
     [ 'hegv',  gen + dtype + la + n + jobz + itype + uplo ],
+    [ 'hegv_factored', gen + dtype + la + n + jobz + itype + uplo ],
     [ 'hegst', gen + dtype + la + n + itype + uplo ],
     ]
 
@@ -594,9 +640,14 @@ if (opts.svd):
     if ('n' in jobu):
         cmds += [[ 'svd', gen + dtype + la + n + mnk + ' --jobu n --jobvt n' + ge_matrix ]]
     if ('v' in jobu):
-        cmds += [[ 'svd', gen + dtype + la + n + mnk + ' --jobu v --jobvt v' + ge_matrix ]]
+        cmds += [[ 'svd', gen + dtype + la + n + mnk + ' --jobu v --jobvt v --method-eig dc,qr' + ge_matrix ]]
+
+    # Randomized SVD of A = X W^H, with rank k from mnk, compared with svd.
+    cmds += [[ 'svd_rand', gen + dtype + la + mnk ]]
 
     cmds += [
+    [ 'polar', gen + dtype + la + n + tall + ge_matrix ],
+
     # todo: mn (wide), nb, jobu, jobvt
     [ 'ge2tb', gen + dtype + n + tall + ' --jobu v --jobvt v' ],
     # tb2bd, bdsqr don't take origin, target
@@ -623,10 +674,13 @@ if (opts.norms):
 if (opts.cond):
     cmds += [
     [ 'gecondest', gen + dtype + n ],
+    [ 'gecondest', gen + dtype + n + ' --normest-vectors 1,4' ],
     [ 'pocondest', gen + dtype + n + uplo ],
+    [ 'pocondest', gen + dtype + n + uplo + ' --normest-vectors 1,4' ],
 
     # Triangle
     [ 'trcondest', gen + dtype + n ],
+    [ 'trcondest', gen + dtype + n + ' --normest-vectors 1,4' ],
 
     #[ 'gbcon', gen + dtype + la + n  + kl + ku ],
     #[ 'pbcon', gen + dtype + la + n + kd + uplo ],
@@ -646,6 +700,9 @@ if (opts.aux):
     [ 'trcopy', gen + dtype + n       + nonuniform_nb + ge_matrix + uplo ],
     [ 'sycopy', gen + dtype + n       + nonuniform_nb + sy_matrix        ],
     [ 'hecopy', gen + dtype + n       + nonuniform_nb + he_matrix        ],
+    [ 'redistribute', gen + dtype + mn + nonuniform_nb + ge_matrix ],
+    [ 'file',   gen + dtype + mn + nonuniform_nb + ge_matrix ],
+    [ 'checkpoint', gen + dtype + mn + nonuniform_nb + ge_matrix ],
 
     [ 'scale',   gen + dtype + mn + ab + nonuniform_nb + ge_matrix        ],
     [ 'tzscale', gen + dtype + mn + ab + nonuniform_nb + ge_matrix + uplo ],
@@ -686,7 +743,13 @@ def print_tee( *args ):
 def run_test( cmd ):
     print( '-' * 80 )
     cmd_str = opts.test +' '+ cmd[1] +' '+ cmd[0]
-    print_tee( cmd_str )
+    env = None
+    if (len( cmd ) > 2):
+        env = dict( os.environ, **cmd[2] )
+        cmd_str_env = ' '.join( [ k +'='+ v for (k, v) in cmd[2].items() ] )
+        print_tee( cmd_str_env +' '+ cmd_str )
+    else:
+        print_tee( cmd_str )
 
     if (re.search( r'\?', cmd_str )):
         print_tee( 'skipping (see ?)' )
@@ -698,7 +761,7 @@ def run_test( cmd ):
     failure_reason = 'FAILED'
     output = ''
     p = subprocess.Popen( cmd_str.split(), stdout=subprocess.PIPE,
-                                           stderr=subprocess.STDOUT )
+                                           stderr=subprocess.STDOUT, env=env )
     p_out = p.stdout
     if (sys.version_info.major >= 3):
         p_out = io.TextIOWrapper(p.stdout, encoding='utf-8')
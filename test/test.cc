@@ -6,6 +6,7 @@
 #include <complex>
 
 #include <iostream>
+#include <limits>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
@@ -23,6 +24,8 @@ using testsweeper::ansi_bold;
 using testsweeper::ansi_red;
 using testsweeper::ansi_normal;
 
+using slate::MethodCholesky::methodCholesky2str;
+using slate::MethodCholesky::str2methodCholesky;
 using slate::MethodCholQR::methodCholQR2str;
 using slate::MethodCholQR::str2methodCholQR;
 using slate::MethodGels::methodGels2str;
@@ -33,6 +36,8 @@ using slate::MethodHemm::methodHemm2str;
 using slate::MethodHemm::str2methodHemm;
 using slate::MethodLU::methodLU2str;
 using slate::MethodLU::str2methodLU;
+using slate::MethodMatFunc::methodMatFunc2str;
+using slate::MethodMatFunc::str2methodMatFunc;
 using slate::MethodTrsm::methodTrsm2str;
 using slate::MethodTrsm::str2methodTrsm;
 
@@ -86,6 +91,8 @@ std::vector< testsweeper::routines_t > routines = {
     { "gemm",               test_gemm,         Section::blas3 },
     { "gemmA",              test_gemm,         Section::blas3 },
     { "gemmC",              test_gemm,         Section::blas3 },
+    { "gemm25D",            test_gemm,         Section::blas3 },
+    { "gemmStrassen",       test_gemm,         Section::blas3 },
     { "gbmm",               test_gbmm,         Section::blas3 },
     { "",                   nullptr,           Section::newline },
 
@@ -115,6 +122,8 @@ std::vector< testsweeper::routines_t > routines = {
     { "gesv_tntpiv",        test_gesv,         Section::gesv },
     { "gesv_mixed",         test_gesv,         Section::gesv },
     { "gesv_mixed_gmres",   test_gesv,         Section::gesv },
+    { "gesv_mixed_solve",   test_gesv,         Section::gesv },
+    { "gesv_mixed_gmres_solve", test_gesv,     Section::gesv },
     { "gesv_rbt",           test_gesv,         Section::gesv },
     { "gbsv",               test_gbsv,         Section::gesv },
     { "",                   nullptr,           Section::newline },
@@ -123,6 +132,7 @@ std::vector< testsweeper::routines_t > routines = {
     { "getrf_nopiv",        test_gesv,          Section::gesv },
     { "getrf_tntpiv",       test_gesv,          Section::gesv },
     { "gbtrf",              test_gbsv,          Section::gesv },
+    { "getrf_batch",        test_batch,         Section::gesv },
     { "",                   nullptr,            Section::newline },
 
     { "getrs",              test_gesv,         Section::gesv },
@@ -148,13 +158,19 @@ std::vector< testsweeper::routines_t > routines = {
     { "",                   nullptr,           Section::newline },
 
     { "potrf",              test_posv,         Section::posv },
+    { "potrf_mixed",        test_posv,         Section::posv },
     { "pbtrf",              test_pbsv,         Section::posv },
+    { "potrf_batch",        test_batch,        Section::posv },
     { "",                   nullptr,           Section::newline },
 
     { "potrs",              test_posv,         Section::posv },
     { "pbtrs",              test_pbsv,         Section::posv },
     { "",                   nullptr,           Section::newline },
 
+    { "potrf_update",       test_potrf_update, Section::posv },
+    { "potrf_downdate",     test_potrf_update, Section::posv },
+    { "",                   nullptr,           Section::newline },
+
     { "potri",              test_potri,        Section::posv },
     { "",                   nullptr,           Section::newline },
     { "pocondest",          test_pocondest,    Section::posv },
@@ -190,6 +206,9 @@ std::vector< testsweeper::routines_t > routines = {
     // QR, LQ, RQ, QL
     { "geqrf",              test_geqrf,     Section::qr },
     { "cholqr",             test_geqrf,     Section::qr },
+    { "geqrf_append",       test_geqrf_update, Section::qr },
+    { "geqrf_delete",       test_geqrf_update, Section::qr },
+    { "geqrf_batch",        test_batch,     Section::qr },
     { "gelqf",              test_gelqf,     Section::qr },
     //{ "geqlf",              test_geqlf,     Section::qr },
     //{ "gerqf",              test_gerqf,     Section::qr },
@@ -211,7 +230,10 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // symmetric/Hermitian eigenvalues
     { "heev",               test_heev,         Section::heev },
+    { "inv_sqrt",           test_inv_sqrt,     Section::heev },
+    { "matrix_sign",        test_matrix_sign,  Section::heev },
     { "sterf",              test_sterf,        Section::heev },
+    { "stebz",              test_stebz,        Section::heev },
     { "steqr2",             test_steqr2,       Section::heev },
     { "",                   nullptr,           Section::newline },
 
@@ -233,6 +255,7 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // generalized symmetric/Hermitian eigenvalues
     { "hegv",               test_hegv,         Section::sygv },
+    { "hegv_factored",      test_hegv,         Section::sygv },
     { "hegst",              test_hegst,        Section::sygv },
     { "",                   nullptr,           Section::newline },
 
@@ -242,6 +265,8 @@ std::vector< testsweeper::routines_t > routines = {
     // -----
     // SVD
     { "svd",                test_svd,          Section::svd },
+    { "svd_rand",           test_svd_rand,     Section::svd },
+    { "polar",              test_polar,        Section::svd },
     { "ge2tb",              test_ge2tb,        Section::svd },
     { "tb2bd",              test_tb2bd,        Section::svd },
     { "bdsqr",              test_bdsqr,        Section::svd },
@@ -276,6 +301,9 @@ std::vector< testsweeper::routines_t > routines = {
     { "trcopy",             test_copy,         Section::aux },
     { "sycopy",             test_copy,         Section::aux },
     { "hecopy",             test_copy,         Section::aux },
+    { "redistribute",       test_redistribute, Section::aux },
+    { "file",               test_file,         Section::aux },
+    { "checkpoint",         test_file,         Section::aux },
     { "",                   nullptr,           Section::newline },
 
     { "scale",              test_scale,        Section::aux },
@@ -307,16 +335,21 @@ Params::Params():
     // p = precision
     // ----- test framework parameters
     //         name,       w,    type,        default, valid, help
-    check     ("check",   0,    ParamType::Value, 'y', "ny",  "check the results"),
+    check     ("check",   0,    ParamType::Value, 'y', "nyr", "check the results; r = randomized O(n^2) residual check for getrf, otherwise same as y"),
     error_exit("error-exit", 0, ParamType::Value, 'n', "ny",  "check error exits"),
     ref       ("ref",     0,    ParamType::Value, 'n', "nyo", "run reference; sometimes check implies ref"),
     hold_local_workspace("hold-local-workspace", 0, ParamType::Value, 'n', "ny",  "do not erase tiles in local workspace"),
     trace     ("trace",   0,    ParamType::Value, 'n', "ny",  "enable/disable traces"),
     trace_scale("trace-scale", 0, 0, ParamType::Value, 1000, 1e-3, 1e6, "horizontal scale for traces, in pixels per sec"),
+    trace_format("trace-format", 0, ParamType::Value, 's', "sj", "trace file format: s = SVG, j = Chrome JSON (Perfetto)"),
+    trace_every("trace-every", 0, ParamType::Value, 1, 1, 1000000, "trace every n-th step (panel) of potrf and getrf; aggregate the rest"),
+    task_graph("task-graph", 0, ParamType::Value, 'n', "ny", "record task graphs of potrf and getrf; write DOT and JSON with critical paths"),
 
     //         name,      w, p, type,         default, min,  max, help
     tol       ("tol",     0, 0, ParamType::Value,  50,   1, 1000, "tolerance (e.g., error < tol*epsilon to pass)"),
     repeat    ("repeat",  0,    ParamType::Value,   1,   1, 1000, "number of times to repeat each test"),
+    warmup    ("warmup",  0,    ParamType::Value,   1,   0, 1000, "number of untimed calls before the timed calls in benchmark mode"),
+    bench     ("bench",   0,    ParamType::Value,   0,   0, 100000, "benchmark mode: number of timed calls on the same matrices, reporting median, min, and 95th percentile times; 0 times a single call"),
 
     verbose   ("verbose", 0,    ParamType::Value,   0,   0,   4,
                "verbose level:\n"
@@ -349,15 +382,18 @@ Params::Params():
     target    ("target",  6,    ParamType::List, slate::Target::HostTask, str2target,   target2str,   "target: t=HostTask, n=HostNest, b=HostBatch, d=Devices"),
 
     method_cholQR ("cholQR", 6, ParamType::List, 0, str2methodCholQR, methodCholQR2str, "auto=auto, herkC, gemmA, gemmC"),
-    method_eig    ("eig",    3, ParamType::List, slate::MethodEig::DC, str2methodEig, methodEig2str, "qr=QR iteration, dc=Divide and Conquer"),
-    method_gels   ("gels",   6, ParamType::List, 0, str2methodGels,   methodGels2str,   "auto=auto, qr, cholqr"),
-    method_gemm   ("gemm",   4, ParamType::List, 0, str2methodGemm,   methodGemm2str,   "auto=auto, A=gemmA, C=gemmC"),
+    method_cholesky ("chol", 9, ParamType::List, 0, str2methodCholesky, methodCholesky2str, "auto=auto, right, left, recursive"),
+    method_eig    ("eig",    3, ParamType::List, slate::MethodEig::DC, str2methodEig, methodEig2str, "qr=QR iteration, dc=Divide and Conquer, bi=Bisection and inverse iteration, qdwh=QDWH spectral divide and conquer"),
+    method_gels   ("gels",   6, ParamType::List, 0, str2methodGels,   methodGels2str,   "auto=auto, qr, cholqr, tsqr, sketch"),
+    method_gemm   ("gemm",   4, ParamType::List, 0, str2methodGemm,   methodGemm2str,   "auto=auto, A=gemmA, C=gemmC, 25D=gemm25D, Strassen=gemmStrassen"),
     method_hemm   ("hemm",   4, ParamType::List, 0, str2methodHemm,   methodHemm2str,   "auto=auto, A=hemmA, C=hemmC"),
     method_lu     ("lu",     5, ParamType::List, slate::MethodLU::PartialPiv, str2methodLU, methodLU2str, "PartialPiv, CALU, NoPiv"),
+    method_matfunc ("matfunc", 13, ParamType::List, 0, str2methodMatFunc, methodMatFunc2str, "auto=auto, ns=NewtonSchulz, db=DenmanBeavers (inv_sqrt), newton=Newton (matrix_sign)"),
     method_trsm   ("trsm",   4, ParamType::List, 0, str2methodTrsm,   methodTrsm2str,   "auto=auto, A=trsmA, B=trsmB"),
 
     grid_order("go",      3,    ParamType::List, slate::GridOrder::Col,   str2grid_order, grid_order2str, "(go) MPI grid order: c=Col, r=Row"),
     dev_order ("do",      3,    ParamType::List, slate::GridOrder::Row,   str2grid_order, grid_order2str, "(do) Device grid order: c=Col, r=Row"),
+    dev_peer  ("dp",      3,    ParamType::List, 'n',                     "ny",           "(dp) Distribute tiles to groups of peer-connected devices, overriding dev-order"),
 
     //         name,      w,    type,            default,                 char2enum,         enum2char,         enum2str,         help
     layout    ("layout",  6,    ParamType::List, slate::Layout::ColMajor, blas::char2layout, blas::layout2char, blas::layout2str, "layout: r=row major, c=column major"),
@@ -385,6 +421,7 @@ Params::Params():
     kl        ("kl",      6,    ParamType::List,  10,     0, 1000000, "lower bandwidth"),
     ku        ("ku",      6,    ParamType::List,  10,     0, 1000000, "upper bandwidth"),
     nrhs      ("nrhs",    6,    ParamType::List,  10,     0, 1000000, "number of right hand sides"),
+    batch     ("batch",   5,    ParamType::List,  10,     1, 1000000, "number of matrices in a batch"),
     vl        ("vl",      6, 3, ParamType::List,  10,     0, 1000000, "lower bound of eigen/singular values to find; default 10.0"),
     vu        ("vu",      6, 3, ParamType::List, 100,     0, 1000000, "upper bound of eigen/singular values to find; default 100.0"),
     il        ("il",      6,    ParamType::List,  10,     0, 1000000, "1-based index of smallest eigen/singular value to find; default 10"),
@@ -400,11 +437,12 @@ Params::Params():
     ib        ("ib",      2,    ParamType::List, 32,      0, 1000000, "inner blocking"),
     grid      ("grid",    3,    ParamType::List, "1x1",   0, 1000000, "MPI grid p x q dimensions"),
     lookahead ("la",      2,    ParamType::List, 1,       0, 1000000, "(la) number of lookahead panels"),
+    max_lookahead("mla",  3,    ParamType::List, 0,       0, 1000000, "(mla) max number of lookahead panels; if > la, lookahead adapts per panel"),
     panel_threads("pt",   2,    ParamType::List, std::max( omp_get_max_threads() / 2, 1 ),
                                                           0, 1000000, "(pt) max number of threads used in panel; default omp_num_threads / 2"),
     align     ("align",   5,    ParamType::List,  32,     1,    1024, "column alignment (sets lda, ldb, etc. to multiple of align)"),
     nonuniform_nb("nonuniform-nb",
-                          0,    ParamType::List, 'n', "ny", "generate matrix with nonuniform tile sizes"),
+                          0,    ParamType::List, 'n', "nyrx", "generate matrix with nonuniform tile sizes: y = alternating nb, 2nb; r = random in [nb/2, 3nb/2]; x = random, with an irregular tile-to-rank map"),
     debug     ("debug",   0,    ParamType::Value, -1,     0, 1000000,
                "given rank waits for debugger (gdb/lldb) to attach"),
     pivot_threshold(
@@ -415,6 +453,13 @@ Params::Params():
     itermax   ("itermax", 7,    ParamType::List, 30,     -1, 1000000, "Maximum number of iterations for refinement"),
     fallback  ("fallback",0,    ParamType::List, 'y',  "ny",          "If refinement fails, fallback to a robust solver"),
     depth     ("depth",   5,    ParamType::List,  2,      0, 1000,    "Number of butterflies to apply"),
+    pipeline  ("pipeline",0,    ParamType::List, 'n',  "ny",          "Overlap the stages of two-stage reductions (heev)"),
+    invert_diag("invert-diag",
+                          0,    ParamType::List, 'n',  "ny",          "Invert diagonal tiles to update panels with trmm (potrf, posv; target d)"),
+    cholqr_passes("cholqr-passes",
+                          6,    ParamType::List,  1,      1, 3,       "Cholesky QR passes: 1, 2 = CholeskyQR2, 3 = shifted CholeskyQR3"),
+    normest_vectors("normest-vectors",
+                          6,    ParamType::List,  2,      1, 1000,    "number of vectors t in the block 1-norm estimator of condest; 1 = lacn2"),
 
     // ----- output parameters
     // min, max are ignored
@@ -436,6 +481,13 @@ Params::Params():
     // 12.3 allows 99999999.999 Gflop/s = 100 Pflop/s
     time      ("time (s)",      9, 3, ParamType::Output, no_data_flag,   0,   0, "time to solution"),
     gflops    ("gflop/s",      12, 3, ParamType::Output, no_data_flag,   0,   0, "Gflop/s rate"),
+    gbytes    ("GB/s",         12, 3, ParamType::Output, no_data_flag,   0,   0, "achieved bandwidth, from the routine's bytes moved model"),
+    time_min  ("min (s)",       9, 3, ParamType::Output, no_data_flag,   0,   0, "minimum time in benchmark mode"),
+    time_p95  ("p95 (s)",       9, 3, ParamType::Output, no_data_flag,   0,   0, "95th percentile time in benchmark mode"),
+    comm_mbytes("comm MB",      9, 1, ParamType::Output, no_data_flag,   0,   0, "MB sent per call, summed over ranks, in benchmark mode"),
+    comm_msgs ("messages",      9, 0, ParamType::Output, no_data_flag,   0,   0, "messages sent per call, summed over ranks, in benchmark mode"),
+    mem_host  ("host MB",       9, 1, ParamType::Output, no_data_flag,   0,   0, "peak host memory pooled by SLATE, max over ranks"),
+    mem_dev   ("dev MB",        9, 1, ParamType::Output, no_data_flag,   0,   0, "peak memory pooled by SLATE per device, max over devices and ranks"),
     time2     ("time (s)",      9, 3, ParamType::Output, no_data_flag,   0,   0, "extra timer"),
     gflops2   ("gflop/s",      12, 3, ParamType::Output, no_data_flag,   0,   0, "Gflop/s rate"),
     time3     ("time (s)",      9, 3, ParamType::Output, no_data_flag,   0,   0, "extra timer"),
@@ -461,17 +513,21 @@ Params::Params():
 {
     // set header different than command line prefix
     lookahead.name("la", "lookahead");
+    max_lookahead.name("mla", "max-lookahead");
     panel_threads.name("pt", "panel-threads");
     grid_order.name("go", "grid-order");
     dev_order.name("do", "dev-order");
+    dev_peer.name("dp", "dev-peer");
 
     // Change name for the methods to use less space in the stdout
     method_cholQR.name("cholQR", "method-cholQR");
+    method_cholesky.name("chol", "method-cholesky");
     method_eig.name("eig", "method-eig");
     method_gels.name("gels", "method-gels");
     method_gemm.name("gemm", "method-gemm");
     method_hemm.name("hemm", "method-hemm");
     method_lu.name("lu", "method-lu");
+    method_matfunc.name("matfunc", "method-matfunc");
     method_trsm.name("trsm", "method-trsm");
 
     // change names of matrix B's params
@@ -499,8 +555,13 @@ Params::Params():
     ref();
     trace();
     trace_scale();
+    trace_format();
+    trace_every();
+    task_graph();
     tol();
     repeat();
+    warmup();
+    bench();
     verbose();
     cache();
     debug();
@@ -595,8 +656,13 @@ int run(int argc, char** argv)
     int status = 0;
     std::string msg;
     try {
-        if (provided < MPI_THREAD_MULTIPLE)
-            throw std::runtime_error("SLATE requires MPI_THREAD_MULTIPLE");
+        // With a communication thread, only it calls MPI within routines.
+        int required = slate::comm_thread() ? MPI_THREAD_SERIALIZED
+                                            : MPI_THREAD_MULTIPLE;
+        if (provided < required)
+            throw std::runtime_error(
+                "SLATE requires MPI_THREAD_MULTIPLE, or MPI_THREAD_SERIALIZED"
+                " with SLATE_COMM_THREAD=1");
 
         slate_mpi_call(
             MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank));
@@ -638,6 +704,9 @@ int run(int argc, char** argv)
             int num_devices = blas::get_device_count();
             if (num_devices > 0)
                 args += ", " + std::to_string( num_devices ) +  " GPU devices";
+            if (num_devices > 1)
+                args += " in " + std::to_string( slate::device_peer_groups().size() )
+                      + " peer groups";
             args += " per MPI rank\n";
 
             printf("%s", args.c_str());
@@ -695,6 +764,12 @@ int run(int argc, char** argv)
             throw;
         }
 
+        // Only getrf has a randomized check; others do the full check.
+        if (params.check() == 'r'
+            && std::string( routine ).compare( 0, 5, "getrf" ) != 0) {
+            params.check() = 'y';
+        }
+
         // After parsing parameters, call test routine again (with run=false)
         // to mark any new fields as used (e.g., timers).
         test_routine( params, false );
@@ -702,6 +777,12 @@ int run(int argc, char** argv)
         slate_assert(params.grid.m() * params.grid.n() == mpi_size);
 
         slate::trace::Trace::pixels_per_second(params.trace_scale());
+        slate::trace::Trace::format(
+            slate::trace::Format( params.trace_format() ) );
+        if (params.trace_every() > 1) {
+            slate::trace::Trace::sampleSteps(
+                0, std::numeric_limits<int64_t>::max(), params.trace_every() );
+        }
 
         // Wait for debugger to attach.
         // See https://www.open-mpi.org/faq/?category=debugging#serial-debuggers
@@ -738,12 +819,14 @@ int run(int argc, char** argv)
             }
 
             for (int iter = 0; iter < repeat; ++iter) {
+                slate::Memory::resetTotalPeaks();
                 try {
                     test_routine(params, true);
                 }
                 catch (const std::exception& ex) {
                     msg = ex.what();
                 }
+                record_memory_peaks( params, MPI_COMM_WORLD );
                 int err = print_reduce_error(msg, mpi_rank, MPI_COMM_WORLD);
                 if (err)
                     params.okay() = false;
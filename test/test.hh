@@ -14,9 +14,12 @@
 #include "slate/generate_matrix.hh"
 #include "matgen.hh"
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
 #include <complex>
 #include <ctype.h>
+#include <vector>
 
 // -----------------------------------------------------------------------------
 namespace slate {
@@ -51,8 +54,13 @@ public:
     testsweeper::ParamChar   hold_local_workspace;
     testsweeper::ParamChar   trace;
     testsweeper::ParamDouble trace_scale;
+    testsweeper::ParamChar   trace_format;
+    testsweeper::ParamInt    trace_every;
+    testsweeper::ParamChar   task_graph;
     testsweeper::ParamDouble tol;
     testsweeper::ParamInt    repeat;
+    testsweeper::ParamInt    warmup;
+    testsweeper::ParamInt    bench;
     testsweeper::ParamInt    verbose;
     testsweeper::ParamInt    print_edgeitems;
     testsweeper::ParamInt    print_width;
@@ -75,15 +83,18 @@ public:
     testsweeper::ParamEnum< slate::Target >         target;
 
     testsweeper::ParamEnum< slate::Method >         method_cholQR;
+    testsweeper::ParamEnum< slate::Method >         method_cholesky;
     testsweeper::ParamEnum< slate::MethodEig >      method_eig;
     testsweeper::ParamEnum< slate::Method >         method_gels;
     testsweeper::ParamEnum< slate::Method >         method_gemm;
     testsweeper::ParamEnum< slate::Method >         method_hemm;
     testsweeper::ParamEnum< slate::Method >         method_lu;
+    testsweeper::ParamEnum< slate::Method >         method_matfunc;
     testsweeper::ParamEnum< slate::Method >         method_trsm;
 
     testsweeper::ParamEnum< slate::GridOrder >      grid_order;
     testsweeper::ParamEnum< slate::GridOrder >      dev_order;
+    testsweeper::ParamChar                          dev_peer;
 
     // ----- test matrix parameters
     MatrixParams matrix;
@@ -114,6 +125,7 @@ public:
     testsweeper::ParamInt    kl;
     testsweeper::ParamInt    ku;
     testsweeper::ParamInt    nrhs;
+    testsweeper::ParamInt    batch;
     testsweeper::ParamDouble vl;
     testsweeper::ParamDouble vu;
     testsweeper::ParamInt    il;
@@ -129,6 +141,7 @@ public:
     testsweeper::ParamInt    ib;
     testsweeper::ParamInt3   grid;  // p x q
     testsweeper::ParamInt    lookahead;
+    testsweeper::ParamInt    max_lookahead;
     testsweeper::ParamInt    panel_threads;
     testsweeper::ParamInt    align;
     testsweeper::ParamChar   nonuniform_nb;
@@ -138,6 +151,10 @@ public:
     testsweeper::ParamInt    itermax;
     testsweeper::ParamChar   fallback;
     testsweeper::ParamInt    depth;
+    testsweeper::ParamChar   pipeline;
+    testsweeper::ParamChar   invert_diag;
+    testsweeper::ParamInt    cholqr_passes;
+    testsweeper::ParamInt    normest_vectors;
 
     // ----- output parameters
     testsweeper::ParamScientific value;
@@ -155,6 +172,13 @@ public:
 
     testsweeper::ParamDouble     time;
     testsweeper::ParamDouble     gflops;
+    testsweeper::ParamDouble     gbytes;
+    testsweeper::ParamDouble     time_min;
+    testsweeper::ParamDouble     time_p95;
+    testsweeper::ParamDouble     comm_mbytes;
+    testsweeper::ParamDouble     comm_msgs;
+    testsweeper::ParamDouble     mem_host;
+    testsweeper::ParamDouble     mem_dev;
     testsweeper::ParamDouble     time2;
     testsweeper::ParamDouble     gflops2;
     testsweeper::ParamDouble     time3;
@@ -215,6 +239,10 @@ void test_gbsv   (Params& params, bool run);
 void test_posv      (Params& params, bool run);
 void test_pocondest (Params& params, bool run);
 void test_potri     (Params& params, bool run);
+void test_potrf_update (Params& params, bool run);
+
+// batched factorizations: getrf_batch, potrf_batch, geqrf_batch
+void test_batch  (Params& params, bool run);
 
 // Cholesky, band
 void test_pbsv   (Params& params, bool run);
@@ -232,13 +260,17 @@ void test_hetrs  (Params& params, bool run);
 // QR, LQ, RQ, QL
 void test_gels      (Params& params, bool run);
 void test_geqrf     (Params& params, bool run);
+void test_geqrf_update (Params& params, bool run);
 void test_gelqf     (Params& params, bool run);
 void test_unmqr     (Params& params, bool run);
 void test_trcondest (Params& params, bool run);
 
 // symmetric/Hermitian eigenvalues
 void test_heev   (Params& params, bool run);
+void test_inv_sqrt    (Params& params, bool run);
+void test_matrix_sign (Params& params, bool run);
 void test_sterf  (Params& params, bool run);
+void test_stebz  (Params& params, bool run);
 void test_steqr2 (Params& params, bool run);
 void test_stedc  (Params& params, bool run);
 
@@ -258,6 +290,8 @@ void test_hegst  (Params& params, bool run);
 
 // SVD
 void test_svd    (Params& params, bool run);
+void test_svd_rand (Params& params, bool run);
+void test_polar  (Params& params, bool run);
 void test_ge2tb  (Params& params, bool run);
 void test_tb2bd  (Params& params, bool run);
 void test_bdsqr  (Params& params, bool run);
@@ -275,6 +309,8 @@ void test_trnorm (Params& params, bool run);
 // auxiliary matrix routines
 void test_add    (Params& params, bool run);
 void test_copy   (Params& params, bool run);
+void test_redistribute(Params& params, bool run);
+void test_file   (Params& params, bool run);
 void test_scale  (Params& params, bool run);
 void test_scale_row_col(Params& params, bool run);
 void test_set    (Params& params, bool run);
@@ -361,6 +397,10 @@ inline slate::MethodEig str2methodEig(const char* method_eig)
         return slate::MethodEig::QR;
     else if (method_eig_ == "d" || method_eig_ == "dc")
         return slate::MethodEig::DC;
+    else if (method_eig_ == "bi" || method_eig_ == "bisection")
+        return slate::MethodEig::Bisection;
+    else if (method_eig_ == "qdwh")
+        return slate::MethodEig::QDWH;
     else
         throw slate::Exception("unknown algorithm");
 }
@@ -370,6 +410,8 @@ inline const char* methodEig2str(slate::MethodEig method_eig)
     switch (method_eig) {
         case slate::MethodEig::QR:  return "qr";
         case slate::MethodEig::DC:  return "dc";
+        case slate::MethodEig::Bisection: return "bi";
+        case slate::MethodEig::QDWH: return "qdwh";
     }
     return "?";
 }
@@ -431,6 +473,138 @@ inline double barrier_get_wtime(MPI_Comm comm)
     return testsweeper::get_wtime();
 }
 
+//------------------------------------------------------------------------------
+/// Marks the peak memory outputs, set by run() for each test from the
+/// process-wide Memory peaks, which include the test matrices.
+///
+inline void mark_params_for_memory( Params& params )
+{
+    params.mem_host();
+    params.mem_dev();
+}
+
+//------------------------------------------------------------------------------
+/// Marks the outputs of benchmark mode, if enabled, for testers that time
+/// their routine with benchmark(), including the peak memory.
+///
+inline void mark_params_for_benchmark( Params& params )
+{
+    if (params.bench() > 0) {
+        params.time_min();
+        params.time_p95();
+        params.comm_mbytes();
+        params.comm_msgs();
+        mark_params_for_memory( params );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Times routine, which runs the routine being tested.
+/// By default, times a single call, like barrier_get_wtime around it.
+/// In benchmark mode, --bench > 0, makes --warmup untimed calls, then
+/// --bench timed calls, on the same prebuilt matrices. This excludes
+/// first-call effects, such as creating queues and growing memory pools,
+/// and later calls reuse the workspace pooled by earlier calls, as in a
+/// production loop. Also sets params.time_min(), params.time_p95(), and
+/// the communication per call, summed over ranks, in params.comm_mbytes()
+/// and params.comm_msgs().
+///
+/// @param[in] reset
+///     Called, untimed, before each call but the first, to restore inputs
+///     that routine overwrites, e.g., C in gemm.
+///
+/// @return time of the single call, or median time of the timed calls.
+///
+template <typename routine_t, typename reset_t>
+double benchmark( Params& params, routine_t&& routine, reset_t&& reset )
+{
+    int warmup = params.warmup();
+    int bench  = params.bench();
+    if (bench <= 0) {
+        double time = barrier_get_wtime( MPI_COMM_WORLD );
+        routine();
+        return barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    }
+
+    std::vector<double> times;
+    slate::CommStats comm_start;
+    for (int iter = 0; iter < warmup + bench; ++iter) {
+        if (iter > 0)
+            reset();
+        if (iter == warmup)
+            comm_start = slate::comm_stats();
+        double time = barrier_get_wtime( MPI_COMM_WORLD );
+        routine();
+        time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+        if (iter >= warmup)
+            times.push_back( time );
+    }
+    std::sort( times.begin(), times.end() );
+    int p95 = std::max( int( std::ceil( 0.95 * bench ) ) - 1, 0 );
+    params.time_min() = times.front();
+    params.time_p95() = times[ p95 ];
+
+    // Includes reset's communication, if any.
+    slate::CommStats comm = slate::comm_stats();
+    comm -= comm_start;
+    double comm_local[ 2 ] = { double( comm.bytes_sent ),
+                               double( comm.messages_sent ) };
+    double comm_sums[ 2 ];
+    MPI_Allreduce( comm_local, comm_sums, 2, MPI_DOUBLE, MPI_SUM,
+                   MPI_COMM_WORLD );
+    params.comm_mbytes() = comm_sums[ 0 ] / bench * 1e-6;
+    params.comm_msgs()   = comm_sums[ 1 ] / bench;
+    return (times[ (bench - 1) / 2 ] + times[ bench / 2 ]) / 2;
+}
+
+//------------------------------------------------------------------------------
+/// Marks the outputs of memory-bound testers, such as norm, copy, add,
+/// scale, and set, for which Gflop/s is not meaningful: the achieved
+/// bandwidth and the peak memory.
+///
+inline void mark_params_for_bandwidth( Params& params )
+{
+    params.gbytes();
+    mark_params_for_memory( params );
+}
+
+//------------------------------------------------------------------------------
+/// @return number of elements stored in an m-by-n matrix, or in its
+/// trapezoid if uplo is Lower or Upper, for bytes moved models.
+///
+inline double stored_elements( slate::Uplo uplo, int64_t m, int64_t n )
+{
+    if (uplo == slate::Uplo::General)
+        return double( m ) * n;
+    // Trapezoid with k = min( m, n ) columns or rows in the triangle.
+    int64_t k = std::min( m, n );
+    return double( m ) * n - 0.5 * double( k ) * (k - 1);
+}
+
+//------------------------------------------------------------------------------
+/// If the peak memory outputs are marked, sets them to the peaks of the
+/// memory pooled by SLATE since the last Memory::resetTotalPeaks, max over
+/// the ranks of comm. Collective on comm.
+///
+inline void record_memory_peaks( Params& params, MPI_Comm comm )
+{
+    if (! params.mem_host.used())
+        return;
+
+    // [ host, max over devices ]
+    double local[ 2 ] = {
+        double( slate::Memory::totalStats( slate::HostNum ).peak_pooled ), 0 };
+    for (int device = 0; device < slate::Memory::num_devices_; ++device) {
+        local[ 1 ] = std::max(
+            local[ 1 ],
+            double( slate::Memory::totalStats( device ).peak_pooled ) );
+    }
+    double max[ 2 ];
+    MPI_Allreduce( local, max, 2, MPI_DOUBLE, MPI_MAX, comm );
+    params.mem_host() = max[ 0 ] * 1e-6;
+    params.mem_dev()  = max[ 1 ] * 1e-6;
+}
+
 //------------------------------------------------------------------------------
 /// @return true if str ends with ending.
 /// std::string ends_with added in C++20. For now, do simple implementation.
@@ -60,6 +60,7 @@ void test_add_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -124,6 +125,9 @@ void test_add_work(Params& params, bool run)
 
         // compute and save timing/performance
         params.time() = time;
+        // Reads A and B, writes B.
+        double gbyte = 3 * stored_elements( uplo, m, n ) * sizeof( scalar_t ) * 1e-9;
+        params.gbytes() = gbyte / time;
 
         print_matrix( "Bfull_out", Bfull, params );
         print_matrix( "B_out", B, params );
@@ -193,6 +197,22 @@ void test_add_work(Params& params, bool run)
             // Allow for difference; A doesn't change.
             params.okay() = (errorA == 0.0 && errorB <= tol);
 
+            if constexpr (std::is_same< matrix_type,
+                                        slate::Matrix<scalar_t> >::value) {
+                // Check eval( C, alpha A + beta B0 ), which copies B0 to C,
+                // then adds, against the result of add in B, where B0 is
+                // B regenerated.
+                slate::Matrix<scalar_t> B0 = Bfull.emptyLike();
+                B0.insertLocalTiles();
+                slate::generate_matrix( params.matrix, B0 );
+                slate::Matrix<scalar_t> C = Bfull.emptyLike();
+                C.insertLocalTiles();
+                slate::eval( C, alpha*Afull + beta*B0, opts );
+                slate::eval( C, C - Bfull, opts );
+                real_t error_eval = slate::norm( slate::Norm::Max, C ) / B_norm;
+                params.okay() = params.okay() && error_eval <= tol;
+            }
+
             Cblacs_gridexit(ictxt);
             //Cblacs_exit(1) does not handle re-entering
         #else  // not SLATE_HAVE_SCALAPACK
@@ -0,0 +1,223 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Generates batch member b, with a seed distinct for each member,
+/// so results mixed up between members are detected.
+template <typename matrix_type>
+void generate_batch_member( Params& params, matrix_type& A, int64_t b )
+{
+    slate::MatgenParams mg_params;
+    mg_params.kind         = params.matrix.kind();
+    mg_params.cond_request = params.matrix.cond_request();
+    mg_params.condD        = params.matrix.condD();
+    mg_params.seed         = params.matrix.seed();
+    if (mg_params.seed != -1)
+        mg_params.seed += b;
+
+    slate::generate_matrix( mg_params, A );
+}
+
+//------------------------------------------------------------------------------
+/// Tests getrf_batch, potrf_batch, and geqrf_batch by comparing each member
+/// of the batch with the non-batched driver applied to the same matrix.
+/// The batched drivers aren't collective, so each rank factors its own
+/// batch of matrices on MPI_COMM_SELF.
+template <typename scalar_t>
+void test_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t ib = params.ib();
+    int64_t batch = params.batch();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    bool chol = params.routine == "potrf_batch";
+    bool lu   = params.routine == "getrf_batch";
+    params.matrix.mark();
+
+    params.time();
+    params.ref_time();
+    params.ref_time.name( "loop time (s)" );
+    params.error.name( "factor diff" );
+
+    if (! run) {
+        if (chol)
+            params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    if (chol)
+        m = n;
+
+    slate::Options const opts =  {
+        {slate::Option::InnerBlocking, ib},
+        {slate::Option::Target, slate::Target::HostTask},
+    };
+
+    std::vector< slate::Matrix<scalar_t> > A_array, Aref_array;
+    std::vector< slate::HermitianMatrix<scalar_t> > H_array, Href_array;
+    for (int64_t b = 0; b < batch; ++b) {
+        if (chol) {
+            slate::HermitianMatrix<scalar_t> H(
+                slate::Uplo::Lower, n, nb, 1, 1, MPI_COMM_SELF );
+            H.insertLocalTiles();
+            generate_batch_member( params, H, b );
+            auto Href = H.emptyLike();
+            Href.insertLocalTiles();
+            slate::copy( H, Href );
+            H_array.push_back( H );
+            Href_array.push_back( Href );
+        }
+        else {
+            slate::Matrix<scalar_t> A( m, n, nb, 1, 1, MPI_COMM_SELF );
+            A.insertLocalTiles();
+            generate_batch_member( params, A, b );
+            auto Aref = A.emptyLike();
+            Aref.insertLocalTiles();
+            slate::copy( A, Aref );
+            A_array.push_back( A );
+            Aref_array.push_back( Aref );
+        }
+    }
+
+    std::vector< slate::Pivots > pivots_array, pivots_ref( batch );
+    std::vector< slate::TriangularFactors<scalar_t> > T_array, T_ref( batch );
+    std::vector< int64_t > info;
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test: factor the whole batch.
+    //==================================================
+    if (chol)
+        slate::potrf_batch( H_array, info, opts );
+    else if (lu)
+        slate::getrf_batch( A_array, pivots_array, info, opts );
+    else
+        slate::geqrf_batch( A_array, T_array, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    if (check) {
+        //==================================================
+        // Factor each member with the non-batched driver.
+        //==================================================
+        std::vector< int64_t > info_ref( batch, 0 );
+        time = barrier_get_wtime( MPI_COMM_WORLD );
+        for (int64_t b = 0; b < batch; ++b) {
+            if (chol)
+                info_ref[ b ] = slate::potrf( Href_array[ b ], opts );
+            else if (lu)
+                info_ref[ b ] = slate::getrf( Aref_array[ b ], pivots_ref[ b ], opts );
+            else
+                slate::geqrf( Aref_array[ b ], T_ref[ b ], opts );
+        }
+        params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+        //==================================================
+        // Test results by comparing each member's factors
+        //
+        //      || A_b - Aref_b ||_1
+        //     ---------------------- < tol * epsilon
+        //      || Aref_b ||_1 N
+        //
+        // and, for getrf, that the pivots and info match.
+        //==================================================
+        real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+        real_t error = 0;
+        bool same_pivots = true;
+        for (int64_t b = 0; b < batch; ++b) {
+            real_t Aref_norm, diff_norm;
+            if (chol) {
+                print_matrix( "L", H_array[ b ], params );
+                Aref_norm = slate::norm( slate::Norm::One, Href_array[ b ] );
+                slate::add( -one, Href_array[ b ], one, H_array[ b ], opts );
+                diff_norm = slate::norm( slate::Norm::One, H_array[ b ] );
+            }
+            else {
+                print_matrix( "A", A_array[ b ], params );
+                Aref_norm = slate::norm( slate::Norm::One, Aref_array[ b ] );
+                slate::add( -one, Aref_array[ b ], one, A_array[ b ], opts );
+                diff_norm = slate::norm( slate::Norm::One, A_array[ b ] );
+            }
+            error = std::max( error, diff_norm / (n * Aref_norm) );
+
+            if (! info.empty() && info[ b ] != info_ref[ b ])
+                same_pivots = false;
+            if (lu) {
+                auto& piv = pivots_array[ b ];
+                auto& ref = pivots_ref[ b ];
+                if (piv.size() != ref.size())
+                    same_pivots = false;
+                for (size_t k = 0; k < piv.size() && same_pivots; ++k) {
+                    if (piv[ k ].size() != ref[ k ].size())
+                        same_pivots = false;
+                    for (size_t i = 0; i < piv[ k ].size() && same_pivots; ++i) {
+                        if (piv[ k ][ i ] != ref[ k ][ i ])
+                            same_pivots = false;
+                    }
+                }
+            }
+        }
+        params.error() = error;
+        params.okay() = (params.error() <= tol) && same_pivots;
+        if (! same_pivots)
+            params.msg() = "info or pivots differ";
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_batch_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_batch_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_batch_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_batch_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
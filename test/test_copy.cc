@@ -58,6 +58,7 @@ void test_copy_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -126,6 +127,9 @@ void test_copy_work(Params& params, bool run)
 
         // compute and save timing/performance
         params.time() = time;
+        // Reads A, writes B.
+        double gbyte = 2 * stored_elements( uplo, m, n ) * sizeof( scalar_t ) * 1e-9;
+        params.gbytes() = gbyte / time;
 
         print_matrix( "Bfull_out", Bfull, params );
         print_matrix( "B_out", B, params );
@@ -0,0 +1,210 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Tests write_file and read_file. For each file layout, writes A, with the
+/// tester's tiling on a p-by-q grid, then reads the file into B:
+/// for FileLayout::ColMajor, with tile size 3 nb / 2 + 1 on a q-by-p grid;
+/// for FileLayout::Tiled, which depends on the tile sizes, tiled as A.
+/// B must equal A exactly.
+///
+/// Routine checkpoint tests write_checkpoint and read_checkpoint: reads the
+/// checkpoint of A both into B, tiled and distributed as A, and into a new
+/// matrix; each must equal A exactly. Reading it into a matrix with a
+/// different tiling must throw.
+template <typename scalar_t>
+void test_file_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t p = params.grid.m();
+    int64_t q = params.grid.n();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Origin origin = params.origin();
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_Matrix( params );
+
+    // mark non-standard output values
+    params.time();
+    params.time2();
+    params.time.name( "write (s)" );
+    params.time2.name( "read (s)" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Target, target}
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( false, false, m, n, params );
+    auto& A = A_alloc.A;
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    const char* filename = "slate_test_file.bin";
+    slate::Target origin_target = origin2target( origin );
+    slate::FileLayout layouts[] = { slate::FileLayout::ColMajor,
+                                    slate::FileLayout::Tiled };
+    real_t error = 0;
+    double time_write = 0, time_read = 0;
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    if (params.routine == "checkpoint") {
+        auto B = A.emptyLike();
+        B.insertLocalTiles( origin_target );
+
+        //==================================================
+        // Run SLATE test.
+        // Checkpoint A, then restore it into B.
+        //==================================================
+        double time = barrier_get_wtime( MPI_COMM_WORLD );
+        slate::write_checkpoint( A, filename, opts );
+        time_write = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+        time = barrier_get_wtime( MPI_COMM_WORLD );
+        slate::read_checkpoint( filename, B, opts );
+        time_read = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+        print_matrix( "B", B, params );
+
+        if (check) {
+            //==================================================
+            // Test results: B and the matrix C restored with the
+            // checkpoint's tiling must equal A exactly.
+            //==================================================
+            auto C = slate::read_checkpoint<scalar_t>(
+                filename, MPI_COMM_WORLD, opts );
+
+            slate::add( -one, A, one, B, opts );
+            error = slate::norm( slate::Norm::Max, B );
+
+            slate::add( -one, A, one, C, opts );
+            error = std::max( error, slate::norm( slate::Norm::Max, C ) );
+
+            // Restoring into a matrix tiled differently must throw.
+            slate::Matrix<scalar_t> D( m, n, 3*nb/2 + 1, q, p, MPI_COMM_WORLD );
+            D.insertLocalTiles( origin_target );
+            try {
+                slate::read_checkpoint( filename, D, opts );
+                error = std::numeric_limits<real_t>::infinity();
+            }
+            catch (slate::Exception const&) {
+                // expected
+            }
+        }
+    }
+    else {
+        for (auto layout : layouts) {
+            slate::Matrix<scalar_t> B;
+            if (layout == slate::FileLayout::ColMajor) {
+                B = slate::Matrix<scalar_t>( m, n, 3*nb/2 + 1, q, p,
+                                             MPI_COMM_WORLD );
+            }
+            else {
+                B = A.emptyLike();
+            }
+            B.insertLocalTiles( origin_target );
+
+            //==================================================
+            // Run SLATE test.
+            // Write A to the file, then read it into B.
+            //==================================================
+            double time = barrier_get_wtime( MPI_COMM_WORLD );
+            slate::write_file( A, filename, layout, opts );
+            time_write += barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+            time = barrier_get_wtime( MPI_COMM_WORLD );
+            slate::read_file( filename, B, layout, opts );
+            time_read += barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+            print_matrix( "B", B, params );
+
+            if (check) {
+                //==================================================
+                // Test results by redistributing B into A2, tiled as A,
+                // which must equal A exactly.
+                //==================================================
+                auto A2 = A.emptyLike();
+                A2.insertLocalTiles( origin_target );
+                slate::redistribute( B, A2, opts );
+
+                slate::add( -one, A, one, A2, opts );
+                error = std::max( error, slate::norm( slate::Norm::Max, A2 ) );
+            }
+        }
+    }
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time()  = time_write;
+    params.time2() = time_read;
+
+    int mpi_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    if (mpi_rank == 0)
+        std::remove( filename );
+
+    if (check) {
+        params.error() = error;
+        params.okay() = (error == 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_file( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_file_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_file_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_file_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_file_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
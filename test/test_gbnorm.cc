@@ -46,6 +46,7 @@ void test_gbnorm_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -101,6 +102,9 @@ void test_gbnorm_work(Params& params, bool run)
 
     // compute and save timing/performance
     params.time() = time;
+    // Reads the band of A.
+    double gbyte = double( std::min( m, n ) ) * (kl + ku + 1) * sizeof( scalar_t ) * 1e-9;
+    params.gbytes() = gbyte / time;
 
     if (check || ref) {
         #ifdef SLATE_HAVE_SCALAPACK
@@ -16,6 +16,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <limits>
 #include <utility>
 
 //------------------------------------------------------------------------------
@@ -49,6 +50,7 @@ void test_gecondest_work(Params& params, bool run)
     SLATE_UNUSED(verbose);
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
+    int64_t normest_vectors = params.normest_vectors();
     slate::GridOrder grid_order = params.grid_order();
     params.matrix.mark();
     params.matrixB.mark();
@@ -100,6 +102,7 @@ void test_gecondest_work(Params& params, bool run)
         {slate::Option::InnerBlocking, ib},
         {slate::Option::PivotThreshold, pivot_threshold},
         {slate::Option::MethodLU, method},
+        {slate::Option::NormEstVectors, normest_vectors},
     };
 
     // Matrix A: figure out local size.
@@ -153,6 +156,7 @@ void test_gecondest_work(Params& params, bool run)
     // Compute the matrix norm
     real_t Anorm = 0;
     Anorm = slate::norm(norm, A, opts);
+    real_t Anorm_fused = Anorm;
     real_t slate_rcond = 0., scl_rcond = 0., exact_rcond = 0.;
 
     if (! ref_only) {
@@ -167,9 +171,9 @@ void test_gecondest_work(Params& params, bool run)
         //==================================================
 
         double time2 = barrier_get_wtime(MPI_COMM_WORLD);
-        slate::lu_factor(A, pivots, opts);
-        // Using traditional BLAS/LAPACK name
-        // slate::getrf(A, pivots, opts);
+        // getrf also computes the norm of A as it factors it,
+        // which should match the norm computed above.
+        slate::getrf(A, pivots, norm, &Anorm_fused, opts);
         // compute and save timing/performance
         time2 = barrier_get_wtime(MPI_COMM_WORLD) - time2;
         params.time2() = time2;
@@ -286,6 +290,10 @@ void test_gecondest_work(Params& params, bool run)
     real_t tol = params.tol();
     params.okay() = (params.error() <= tol);
 
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+    params.okay() = params.okay()
+                    && std::abs( Anorm_fused - Anorm ) <= 10*eps*Anorm;
+
 }
 
 // -----------------------------------------------------------------------------
@@ -48,6 +48,7 @@ void test_gelqf_work(Params& params, bool run)
 
     // mark non-standard output values
     params.time();
+    params.ortho();
     params.gflops();
     params.ref_time();
     params.ref_gflops();
@@ -182,6 +183,31 @@ void test_gelqf_work(Params& params, bool run)
         params.error() = residual;
         real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
         params.okay() = (params.error() <= tol);
+
+        //==================================================
+        // Test Q generated by unglq by checking orthogonality
+        //
+        //      || I - Q Q^H ||_1
+        //     ------------------- < tol * epsilon
+        //              n
+        //==================================================
+        slate::Target origin_target = origin2target( origin );
+        int64_t min_mn = std::min( m, n );
+
+        auto Q_full = A.emptyLike();
+        Q_full.insertLocalTiles( origin_target );
+        auto Q = Q_full.slice( 0, min_mn-1, 0, n-1 );
+        slate::lq_generate_q( A, T, Q, opts );
+        // Using traditional BLAS/LAPACK name
+        // slate::unglq( A, T, Q, opts );
+
+        slate::Matrix<scalar_t> R( min_mn, min_mn, nb, p, q, MPI_COMM_WORLD );
+        R.insertLocalTiles( origin_target );
+        slate::set( zero, one, R ); // identity
+        auto QH = conj_transpose( Q );
+        slate::gemm( -one, Q, QH, one, R );
+        params.ortho() = slate::norm( slate::Norm::One, R ) / n;
+        params.okay() = params.okay() && (params.ortho() <= tol);
     }
 
     if (ref) {
@@ -40,7 +40,7 @@ void test_genorm_work(Params& params, bool run)
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
     bool trace = params.trace() == 'y';
-    bool nonuniform_nb = params.nonuniform_nb() == 'y';
+    bool nonuniform_nb = params.nonuniform_nb() != 'n';
     bool ref_copy = nonuniform_nb && (check || ref);
     int verbose = params.verbose();
     int extended = params.extended();
@@ -54,6 +54,7 @@ void test_genorm_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -121,6 +122,9 @@ void test_genorm_work(Params& params, bool run)
 
         // compute and save timing/performance
         params.time() = time;
+        // Reads A.
+        double gbyte = stored_elements( slate::Uplo::General, m, n ) * sizeof( scalar_t ) * 1e-9;
+        params.gbytes() = gbyte / time;
     }
 
     if (check || ref) {
@@ -211,6 +215,33 @@ void test_genorm_work(Params& params, bool run)
             // Allow for difference
             params.okay() = (params.error() <= tol);
 
+            // norms computes several norms with one reduction;
+            // each should match norm.
+            if (scope == slate::NormScope::Matrix) {
+                std::vector<slate::Norm> all_norms = {
+                    slate::Norm::Max, slate::Norm::One,
+                    slate::Norm::Inf, slate::Norm::Fro };
+                std::vector<real_t> all_values
+                    = slate::norms( all_norms, A, opts );
+                for (size_t i = 0; i < all_norms.size(); ++i) {
+                    real_t value = slate::norm( all_norms[ i ], A, opts );
+                    real_t diff = std::abs( all_values[ i ] - value );
+                    if (verbose && A.mpiRank() == 0) {
+                        printf( "norms[ %s ] %15.8e, norm %15.8e\n",
+                                norm2str( all_norms[ i ] ),
+                                all_values[ i ], value );
+                    }
+                    params.okay() = params.okay() && diff <= 10*eps*value;
+                }
+
+                // norms_start gives the same norms after wait.
+                std::vector<real_t> start_values( all_norms.size() );
+                auto request = slate::norms_start(
+                    all_norms, A, start_values.data(), opts );
+                request.wait();
+                params.okay() = params.okay() && start_values == all_values;
+            }
+
             //---------- extended tests
             if (extended && scope == slate::NormScope::Matrix) {
                 if (grid_order != slate::GridOrder::Col) {
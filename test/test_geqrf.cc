@@ -37,6 +37,7 @@ void test_geqrf_work(Params& params, bool run)
     int64_t nb = params.nb();
     int64_t ib = params.ib();
     int64_t lookahead = params.lookahead();
+    int64_t max_lookahead = params.max_lookahead();
     int64_t panel_threads = params.panel_threads();
     bool ref_only = params.ref() == 'o';
     bool ref = params.ref() == 'y' || ref_only;
@@ -45,11 +46,16 @@ void test_geqrf_work(Params& params, bool run)
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
     slate::Method methodCholQR = params.method_cholQR();
+    int64_t cholqr_passes = 1;
+    if (params.routine == "cholqr")
+        cholqr_passes = params.cholqr_passes();
     params.matrix.mark();
 
     // mark non-standard output values
     params.time();
     params.gflops();
+    if (params.routine == "geqrf")
+        params.ortho();
     params.ref_time();
     params.ref_gflops();
 
@@ -63,10 +69,12 @@ void test_geqrf_work(Params& params, bool run)
 
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
+        {slate::Option::MaxLookahead, max_lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
-        {slate::Option::MethodCholQR, methodCholQR}
+        {slate::Option::MethodCholQR, methodCholQR},
+        {slate::Option::CholQRPasses, cholqr_passes},
     };
 
     // MPI variables
@@ -214,6 +222,33 @@ void test_geqrf_work(Params& params, bool run)
         params.error() = residual;
         real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
         params.okay() = (params.error() <= tol);
+
+        if (params.routine == "geqrf") {
+            //==================================================
+            // Test Q generated by ungqr by checking orthogonality
+            //
+            //      || I - Q^H Q ||_1
+            //     ------------------- < tol * epsilon
+            //              m
+            //==================================================
+            slate::Target origin_target = origin2target( origin );
+            int64_t min_mn = std::min( m, n );
+
+            auto Q_full = A.emptyLike();
+            Q_full.insertLocalTiles( origin_target );
+            auto Q = Q_full.slice( 0, m-1, 0, min_mn-1 );
+            slate::qr_generate_q( A, T, Q, opts );
+            // Using traditional BLAS/LAPACK name
+            // slate::ungqr( A, T, Q, opts );
+
+            slate::Matrix<scalar_t> R( min_mn, min_mn, nb, p, q, MPI_COMM_WORLD );
+            R.insertLocalTiles( origin_target );
+            slate::set( zero, one, R ); // identity
+            auto QH = conj_transpose( Q );
+            slate::gemm( -one, QH, Q, one, R );
+            params.ortho() = slate::norm( slate::Norm::One, R ) / m;
+            params.okay() = params.okay() && (params.ortho() <= tol);
+        }
     }
 
     if (ref) {
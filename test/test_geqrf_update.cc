@@ -0,0 +1,186 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_geqrf_update_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const real_t r_zero = 0;
+    const real_t r_one = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t ib = params.ib();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    bool del = params.routine == "geqrf_delete";
+    params.matrix.mark();
+    params.matrixB.mark();
+
+    mark_params_for_test_HermitianMatrix( params );
+
+    params.time();
+    params.ref_time();
+    params.ref_time.name( "geqrf time (s)" );
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::InnerBlocking, ib},
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( false, true, m, n, params );
+    auto W_alloc = allocate_test_Matrix<scalar_t>( false, true, k, n, params );
+    auto C_alloc = allocate_test_HermitianMatrix<scalar_t>( false, true, n, params );
+    auto& A = A_alloc.A;
+    auto& W = W_alloc.A;
+    auto& C = C_alloc.A;
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    slate::generate_matrix( params.matrix, A );
+    slate::generate_matrix( params.matrixB, W );
+
+    // Gram matrix of the rows expected in the result:
+    // C = A^H A + W^H W after an append, C = A^H A after a delete.
+    auto AH = conj_transpose( A );
+    auto WH = conj_transpose( W );
+    slate::herk( r_one, AH, r_zero, C, opts );
+    if (! del)
+        slate::herk( r_one, WH, r_one, C, opts );
+    real_t C_norm = slate::norm( slate::Norm::One, C );
+
+    print_matrix( "A", A, params );
+    print_matrix( "W", W, params );
+
+    slate::TriangularFactors<scalar_t> T;
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    slate::geqrf( A, T, opts );
+    params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    auto R = A.slice( 0, n-1, 0, n-1 );
+
+    // W is destroyed by the update, so append a copy before deleting W.
+    int64_t info = 0;
+    if (del) {
+        auto W2 = W.emptyLike();
+        W2.insertLocalTiles();
+        slate::copy( W, W2 );
+        info = slate::geqrf_append( R, W2, opts );
+        slate_assert( info == 0 );
+    }
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test: append or delete the rows W.
+    //==================================================
+    if (del)
+        info = slate::geqrf_delete( R, W, opts );
+    else
+        info = slate::geqrf_append( R, W, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    print_matrix( "R", R, params );
+
+    if (info != 0) {
+        params.okay() = false;
+        params.msg() = "info = " + std::to_string( info );
+        return;
+    }
+
+    if (check) {
+        //==================================================
+        // Test results by checking the Gram matrix
+        //
+        //      || C - R^H R ||_1
+        //     ------------------- < tol * epsilon
+        //        || C ||_1 n
+        //==================================================
+        auto Rfull = R.emptyLike();
+        Rfull.insertLocalTiles();
+        slate::set( zero, Rfull );
+        slate::TrapezoidMatrix<scalar_t> Rtz(
+            slate::Uplo::Upper, slate::Diag::NonUnit, R );
+        slate::TrapezoidMatrix<scalar_t> Rfull_tz(
+            slate::Uplo::Upper, slate::Diag::NonUnit, Rfull );
+        slate::copy( Rtz, Rfull_tz );
+
+        auto RH = conj_transpose( Rfull );
+        slate::herk( -r_one, RH, r_one, C, opts );
+        real_t E_norm = slate::norm( slate::Norm::One, C );
+
+        params.error() = E_norm / (n * C_norm);
+        params.okay() = (params.error() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_geqrf_update( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_geqrf_update_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_update_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_update_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_update_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
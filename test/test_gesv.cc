@@ -4,6 +4,8 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "slate/internal/TaskGraph.hh"
+#include "internal/internal.hh"
 #include "test.hh"
 #include "blas/flops.hh"
 #include "lapack/flops.hh"
@@ -18,6 +20,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <type_traits>
 #include <utility>
 
 //------------------------------------------------------------------------------
@@ -27,7 +30,8 @@ void test_gesv_work(Params& params, bool run)
     using real_t = blas::real_type<scalar_t>;
 
     // Constants
-    const scalar_t one = 1.0;
+    const scalar_t zero = 0.0;
+    const scalar_t one  = 1.0;
 
     // If routine is gesv, getrf, getrs (without suffix), the first time
     // this is called, with run = false, method = PartialPiv because the
@@ -61,11 +65,14 @@ void test_gesv_work(Params& params, bool run)
     int64_t nrhs = params.nrhs();
     int64_t ib = params.ib();
     int64_t lookahead = params.lookahead();
+    int64_t max_lookahead = params.max_lookahead();
     int64_t panel_threads = params.panel_threads();
     bool ref_only = params.ref() == 'o';
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
+    bool rand_check = params.check() == 'r' && ! ref_only;
     bool trace = params.trace() == 'y';
+    bool task_graph = params.task_graph() == 'y';
     int verbose = params.verbose();
     int timer_level = params.timer_level();
     SLATE_UNUSED(verbose);
@@ -87,6 +94,12 @@ void test_gesv_work(Params& params, bool run)
     // NoPiv and CALU ignore threshold.
     double pivot_threshold = params.pivot_threshold();
 
+    // The randomized check is only for square getrf; otherwise, check fully.
+    if (rand_check && (params.routine != "getrf" || m != n)) {
+        rand_check = false;
+        check = true;
+    }
+
     // mark non-standard output values
     params.time();
     params.gflops();
@@ -131,9 +144,12 @@ void test_gesv_work(Params& params, bool run)
         }
     }
 
+    bool is_mixed_solve = params.routine == "gesv_mixed_solve"
+                          || params.routine == "gesv_mixed_gmres_solve";
     bool is_iterative = params.routine == "gesv_mixed"
                         || params.routine == "gesv_mixed_gmres"
-                        || params.routine == "gesv_rbt";
+                        || params.routine == "gesv_rbt"
+                        || is_mixed_solve;
 
     int64_t itermax = 0;
     bool fallback = true;
@@ -156,7 +172,8 @@ void test_gesv_work(Params& params, bool run)
         return;
     }
 
-    if ((params.routine == "gesv_mixed" || params.routine == "gesv_mixed_gmres")
+    if ((params.routine == "gesv_mixed" || params.routine == "gesv_mixed_gmres"
+         || is_mixed_solve)
         && ! std::is_same<real_t, double>::value) {
         params.msg() = "skipping: unsupported mixed precision; must be type=d or z";
         return;
@@ -164,6 +181,7 @@ void test_gesv_work(Params& params, bool run)
 
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
+        {slate::Option::MaxLookahead, max_lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
@@ -208,11 +226,23 @@ void test_gesv_work(Params& params, bool run)
     print_matrix( "A", A, params );
     print_matrix( "B", B, params );
 
+    // For the randomized check, save Y = A X, with X = B random,
+    // and the norms, instead of a copy of A.
+    TestMatrix<slate::Matrix<scalar_t>> Y_alloc;
+    real_t A_norm_rand = 0, X_norm_rand = 0;
+    if (rand_check) {
+        Y_alloc = allocate_test_Matrix<scalar_t>( false, true, m, nrhs, params );
+        A_norm_rand = slate::norm( slate::Norm::One, A );
+        X_norm_rand = slate::norm( slate::Norm::One, B );
+        slate::multiply( one, A, B, zero, Y_alloc.A );
+    }
+
     double gflop;
     if (params.routine == "gesv"
         || params.routine == "gesv_mixed"
         || params.routine == "gesv_mixed_gmres"
-        || params.routine == "gesv_rbt")
+        || params.routine == "gesv_rbt"
+        || is_mixed_solve)
         gflop = lapack::Gflop<scalar_t>::gesv(n, nrhs);
     else
         gflop = lapack::Gflop<scalar_t>::getrf(m, n);
@@ -221,6 +251,7 @@ void test_gesv_work(Params& params, bool run)
 
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
+        if (task_graph) slate::trace::TaskGraph::on();
 
         //==================================================
         // Run SLATE test: getrf or gesv
@@ -253,6 +284,29 @@ void test_gesv_work(Params& params, bool run)
                 params.iters() = iters;
             }
         }
+        else if (is_mixed_solve) {
+            if constexpr (std::is_same<real_t, double>::value) {
+                // Factor once, then solve twice, as for successive
+                // right-hand sides; the second solve reuses the factors.
+                using scalar_lo = std::conditional_t<
+                    slate::is_complex<scalar_t>::value,
+                    std::complex<float>, float >;
+                slate::MixedFactorization<scalar_t, scalar_lo> F;
+                info = slate::gesv_mixed_factor( A, F, opts );
+                int iters = 0;
+                for (int solve = 0; solve < 2; ++solve) {
+                    if (params.routine == "gesv_mixed_solve") {
+                        info = slate::gesv_mixed_solve(
+                            A, F, B, X, iters, opts );
+                    }
+                    else {
+                        info = slate::gesv_mixed_gmres_solve(
+                            A, F, B, X, iters, opts );
+                    }
+                }
+                params.iters() = iters;
+            }
+        }
         else if (params.routine == "gesv_rbt") {
             int iters = 0;
             slate::gesv_rbt(A, B, X, iters, opts);
@@ -310,6 +364,7 @@ void test_gesv_work(Params& params, bool run)
         }
 
         if (trace) slate::trace::Trace::finish();
+        if (task_graph) slate::trace::TaskGraph::finish();
 
         if (info != 0) {
             char buf[ 80 ];
@@ -376,6 +431,48 @@ void test_gesv_work(Params& params, bool run)
         if (is_iterative)
             params.okay() = params.okay() && params.iters() >= 0;
     }
+    else if (rand_check) {
+        //==================================================
+        // Randomized (Freivalds) check of PA = LU, using Y = A X above
+        // for nrhs random vectors X:
+        //
+        //           || P Y - L (U X) ||_1
+        //     --------------------------- < tol * epsilon
+        //      || A ||_1 * || X ||_1 * N
+        //
+        // This costs O(n^2 nrhs), without the O(n^3) reference or
+        // the copy of A; errors in L or U are detected with high
+        // probability.
+        //==================================================
+        auto& Y = Y_alloc.A;
+        auto L = slate::TriangularMatrix<scalar_t>(
+            slate::Uplo::Lower, slate::Diag::Unit, A );
+        auto U = slate::TriangularMatrix<scalar_t>(
+            slate::Uplo::Upper, slate::Diag::NonUnit, A );
+
+        // B = L (U X)
+        slate::triangular_multiply( one, U, B, opts );
+        slate::triangular_multiply( one, L, B, opts );
+
+        // Y = P Y, applying pivots as getrs does.
+        if (method_lu != slate::MethodLU::NoPiv) {
+            for (int64_t k = 0; k < Y.mt(); ++k) {
+                slate::internal::permuteRows<slate::Target::HostTask>(
+                    slate::Direction::Forward,
+                    Y.sub( k, Y.mt()-1, 0, Y.nt()-1 ),
+                    pivots.at( k ), slate::Layout::ColMajor );
+            }
+        }
+
+        // Y -= B
+        slate::add( -one, B, one, Y, opts );
+
+        real_t R_norm = slate::norm( slate::Norm::One, Y );
+        params.error() = R_norm / (n * A_norm_rand * X_norm_rand);
+
+        real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+        params.okay() = (params.error() <= tol);
+    }
 
     if (ref) {
         #ifdef SLATE_HAVE_SCALAPACK
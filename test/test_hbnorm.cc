@@ -44,6 +44,7 @@ void test_hbnorm_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -98,6 +99,9 @@ void test_hbnorm_work(Params& params, bool run)
 
     // compute and save timing/performance
     params.time() = time;
+    // Reads the stored half of the band of A.
+    double gbyte = double( n ) * (kd + 1) * sizeof( scalar_t ) * 1e-9;
+    params.gbytes() = gbyte / time;
 
     if (check || ref) {
         #ifdef SLATE_HAVE_SCALAPACK
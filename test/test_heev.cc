@@ -11,6 +11,7 @@
 #include "scalapack_wrappers.hh"
 #include "scalapack_copy.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
@@ -32,6 +33,7 @@ void test_heev_work(Params& params, bool run)
 
     // get & mark input values
     slate::Job jobz = params.jobz();
+    lapack::Range range = params.range();
     slate::Uplo uplo = params.uplo();
     int64_t n = params.dim.n();
     int64_t p = params.grid.m();
@@ -49,8 +51,21 @@ void test_heev_work(Params& params, bool run)
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
     slate::MethodEig method_eig = params.method_eig();
+    bool pipeline = params.pipeline() == 'y';
     params.matrix.mark();
 
+    // Subset of eigenvalues; il, iu are 1-based, as in LAPACK.
+    real_t vl = 0, vu = 0;
+    int64_t il = 1, iu = n;
+    if (range == lapack::Range::Value) {
+        vl = params.vl();
+        vu = params.vu();
+    }
+    else if (range == lapack::Range::Index) {
+        il = params.il();
+        iu = std::min( params.iu(), n );
+    }
+
     // mark non-standard output values
     params.time();
     params.ref_time();
@@ -81,6 +96,7 @@ void test_heev_work(Params& params, bool run)
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
         {slate::Option::MethodEig, method_eig},
+        {slate::Option::Pipeline, pipeline},
     };
 
     // MPI variables
@@ -169,7 +185,13 @@ void test_heev_work(Params& params, bool run)
         //==================================================
         // Run SLATE test.
         //==================================================
-        if (jobz == slate::Job::NoVec) {
+        if (range != lapack::Range::All) {
+            if (jobz == slate::Job::NoVec)
+                slate::heevx( range, vl, vu, il-1, iu-1, A, Lambda, opts );
+            else
+                slate::heevx( range, vl, vu, il-1, iu-1, A, Lambda, Z, opts );
+        }
+        else if (jobz == slate::Job::NoVec) {
             slate::eig_vals( A, Lambda, opts );
             // Or slate::eig( A, Lambda, opts );
             // Using traditional BLAS/LAPACK name
@@ -195,7 +217,10 @@ void test_heev_work(Params& params, bool run)
             params.time6() = slate::timers[ "heev::unmtr_he2hb" ];
         }
 
-        if (check && jobz == slate::Job::Vec) {
+        // Number of eigenpairs computed, and their vectors.
+        int64_t k = Lambda.size();
+
+        if (check && jobz == slate::Job::Vec && k > 0) {
             //==================================================
             // Test results by checking backwards error
             //
@@ -210,15 +235,17 @@ void test_heev_work(Params& params, bool run)
             //              N
             //==================================================
 
+            auto Zk = Z.slice( 0, n-1, 0, k-1 );
+
             // Compute Z_Lambda = Z Lambda.
             // todo Z.copy()
-            auto Z_Lambda = Z.emptyLike();
+            auto Z_Lambda = Zk.emptyLike();
             Z_Lambda.insertLocalTiles();
-            slate::copy( Z, Z_Lambda );
+            slate::copy( Zk, Z_Lambda );
 
             // todo: refactor column scaling
-            int64_t mt = Z.mt();
-            int64_t nt = Z.nt();
+            int64_t mt = Zk.mt();
+            int64_t nt = Zk.nt();
             int64_t jj = 0;
             for (int64_t j = 0; j < nt; ++j) {
                 #pragma omp parallel for slate_omp_default_none \
@@ -241,20 +268,33 @@ void test_heev_work(Params& params, bool run)
             // Restore A.
             copy( Aref, A );
 
-            // A - Z_Lambda Z^H
-            // Aref_gen and Aref point to the same data.
-            // todo: implement herkx
-            auto ZH = conj_transpose( Z );
-            slate::gemm( -one, Z_Lambda, ZH, one, Aref_gen );
             real_t Anorm = slate::norm( slate::Norm::One, A );
-            params.error2() = slate::norm( slate::Norm::One, Aref ) / (Anorm * n);
-            params.okay() = (params.error2() <= tol);
-
-            // I - Z^H Z
-            slate::set( zero, one, Aref_gen );
-            slate::gemm( -one, ZH, Z, one, Aref_gen );
-            params.ortho() = slate::norm( slate::Norm::One, Aref_gen ) / n;
-            params.okay() = params.okay() && (params.ortho() <= tol);
+            auto ZH = conj_transpose( Zk );
+            if (range == lapack::Range::All) {
+                // A - Z_Lambda Z^H
+                // Aref_gen and Aref point to the same data.
+                slate::gemm( -one, Z_Lambda, ZH, one, Aref_gen );
+                params.error2() = slate::norm( slate::Norm::One, Aref ) / (Anorm * n);
+
+                // I - Z^H Z
+                slate::set( zero, one, Aref_gen );
+                slate::gemm( -one, ZH, Zk, one, Aref_gen );
+                params.ortho() = slate::norm( slate::Norm::One, Aref_gen ) / n;
+            }
+            else {
+                // A Z - Z_Lambda, for the k vectors.
+                slate::hemm( slate::Side::Left, one, A, Zk, -one, Z_Lambda );
+                params.error2() = slate::norm( slate::Norm::One, Z_Lambda ) / (Anorm * n);
+
+                // I - Z^H Z, k-by-k.
+                slate::Matrix<scalar_t> Ik( k, k, nb, p, q, MPI_COMM_WORLD );
+                Ik.insertLocalTiles();
+                slate::set( zero, one, Ik );
+                slate::gemm( -one, ZH, Zk, one, Ik );
+                params.ortho() = slate::norm( slate::Norm::One, Ik ) / n;
+            }
+            params.okay() = (params.error2() <= tol)
+                            && (params.ortho() <= tol);
 
             // Restore Aref.
             copy( A, Aref );
@@ -355,13 +395,26 @@ void test_heev_work(Params& params, bool run)
             params.ref_time() = time;
 
             if (! ref_only) {
-                // Reference Scalapack was run, check reference against test
-                // Perform a local operation to get differences Lambda = Lambda - Lambda_ref
-                blas::axpy( n, -1.0, &Lambda_ref[0], 1, &Lambda[0], 1 );
+                // Reference Scalapack was run, check reference against test.
+                // For a subset, compare with the matching reference values.
+                int64_t k = Lambda.size();
+                int64_t offset = il - 1;
+                if (range == lapack::Range::Value) {
+                    offset = std::lower_bound( Lambda_ref.begin(),
+                                               Lambda_ref.end(), vl )
+                             - Lambda_ref.begin();
+                }
+                if (offset + k > n) {
+                    params.error() = std::numeric_limits<real_t>::infinity();
+                }
+                else if (k > 0) {
+                    // Perform a local operation to get differences Lambda = Lambda - Lambda_ref
+                    blas::axpy( k, -1.0, &Lambda_ref[ offset ], 1, &Lambda[0], 1 );
 
-                // Relative forward error: || Lambda_ref - Lambda || / || Lambda_ref ||.
-                params.error() = blas::asum( n, &Lambda[0], 1 )
-                    / blas::asum( n, &Lambda_ref[0], 1 );
+                    // Relative forward error: || Lambda_ref - Lambda || / || Lambda_ref ||.
+                    params.error() = blas::asum( k, &Lambda[0], 1 )
+                        / blas::asum( k, &Lambda_ref[ offset ], 1 );
+                }
 
                 params.okay() = params.okay() && (params.error() <= tol);
             }
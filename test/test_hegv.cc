@@ -206,6 +206,17 @@ void test_hegv_work(Params& params, bool run)
 
     if (! ref_only) {
 
+        // hegv_factored takes B already factored, as by an earlier hegv;
+        // the factorization isn't timed.
+        bool factored = params.routine == "hegv_factored";
+        if (factored) {
+            int64_t info = slate::potrf( B, opts );
+            if (info != 0) {
+                params.msg() = "potrf of B failed";
+                return;
+            }
+        }
+
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
 
@@ -214,7 +225,13 @@ void test_hegv_work(Params& params, bool run)
         //==================================================
         // Run SLATE test.
         //==================================================
-        if (jobz == slate::Job::NoVec) {
+        if (factored) {
+            if (jobz == slate::Job::NoVec)
+                slate::hegv_factored( itype, A, B, Lambda, opts );
+            else
+                slate::hegv_factored( itype, A, B, Lambda, Z, opts );
+        }
+        else if (jobz == slate::Job::NoVec) {
             slate::eig_vals( itype, A, B, Lambda, opts );
             // Using traditional BLAS/LAPACK name
             // slate::hegv( itype, A, B, Lambda, opts );
@@ -37,7 +37,7 @@ void test_henorm_work(Params& params, bool run)
     bool check = params.check() == 'y';
     bool ref = params.ref() == 'y';
     bool trace = params.trace() == 'y';
-    bool nonuniform_nb = params.nonuniform_nb() == 'y';
+    bool nonuniform_nb = params.nonuniform_nb() != 'n';
     bool ref_copy = nonuniform_nb && (check || ref);
     int verbose = params.verbose();
     int extended = params.extended();
@@ -51,6 +51,7 @@ void test_henorm_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run) {
         params.matrix.kind.set_default( "rand" );
@@ -96,6 +97,9 @@ void test_henorm_work(Params& params, bool run)
 
     // compute and save timing/performance
     params.time() = time;
+    // Reads the stored triangle of A.
+    double gbyte = stored_elements( uplo, n, n ) * sizeof( scalar_t ) * 1e-9;
+    params.gbytes() = gbyte / time;
 
     if (check || ref) {
         #ifdef SLATE_HAVE_SCALAPACK
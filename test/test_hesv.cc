@@ -64,10 +64,6 @@ void test_hesv_work(Params& params, bool run)
         params.msg() = "skipping: currently only origin=scalapack is supported";
         return;
     }
-    if (target == slate::Target::Devices) {
-        params.msg() = "skipping: currently target=devices is not supported";
-        return;
-    }
     if (n % nb != 0) {
         params.msg() = "skipping: currently only (n %% nb == 0) is supported";
         return;
@@ -0,0 +1,132 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_inv_sqrt_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t lookahead = params.lookahead();
+    slate::Method method = params.method_matfunc();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_HermitianMatrix( params );
+
+    params.time();
+    params.iters();
+
+    if (! run) {
+        // inv_sqrt requires Hermitian positive definite A
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MethodMatFunc, method},
+    };
+
+    auto A_alloc = allocate_test_HermitianMatrix<scalar_t>( false, true, n, params );
+    auto X_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+    auto& A = A_alloc.A;
+    auto& X = X_alloc.A;
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test: X = A^{-1/2}.
+    //==================================================
+    params.iters() = slate::inv_sqrt( A, X, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    print_matrix( "X", X, params );
+
+    if (check) {
+        //==================================================
+        // Test results by checking X A X = I
+        //
+        //      || I - X A X ||_1
+        //     ------------------- < tol * epsilon
+        //              N
+        //==================================================
+        auto W_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+        auto R_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+        auto& W = W_alloc.A;
+        auto& R = R_alloc.A;
+        slate::hemm( slate::Side::Left, one, A, X, zero, W, opts );
+        slate::set( zero, one, R );
+        slate::gemm( -one, X, W, one, R, opts );
+        params.error() = slate::norm( slate::Norm::One, R ) / n;
+        params.okay() = (params.error() <= tol) && (params.iters() >= 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_inv_sqrt( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_inv_sqrt_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_inv_sqrt_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_inv_sqrt_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_inv_sqrt_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_matrix_sign_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t lookahead = params.lookahead();
+    slate::Method method = params.method_matfunc();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_Matrix( params );
+
+    params.time();
+    params.iters();
+    params.error2();
+    params.error.name( "S^2 = I" );
+    params.error2.name( "SA = AS" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MethodMatFunc, method},
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+    auto Acpy_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+    auto& A    = A_alloc.A;
+    auto& Acpy = Acpy_alloc.A;
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    if (check)
+        slate::copy( A, Acpy );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test: A = sign( A ).
+    //==================================================
+    params.iters() = slate::matrix_sign( A, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    print_matrix( "S", A, params );
+
+    if (check) {
+        auto W_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+        auto R_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+        auto& W = W_alloc.A;
+        auto& R = R_alloc.A;
+
+        //==================================================
+        // Test results by checking S is an involution
+        //
+        //      || I - S^2 ||_1
+        //     ----------------- < tol * epsilon
+        //             N
+        //==================================================
+        slate::copy( A, W );
+        slate::set( zero, one, R );
+        slate::gemm( -one, A, W, one, R, opts );
+        params.error() = slate::norm( slate::Norm::One, R ) / n;
+
+        //==================================================
+        // Test results by checking S commutes with Acpy
+        //
+        //      || S Acpy - Acpy S ||_1
+        //     ------------------------- < tol * epsilon
+        //         || A ||_1 * N
+        //==================================================
+        real_t Anorm = slate::norm( slate::Norm::One, Acpy );
+        slate::gemm( one, A, Acpy, zero, R, opts );
+        slate::gemm( -one, Acpy, A, one, R, opts );
+        params.error2() = slate::norm( slate::Norm::One, R ) / (Anorm * n);
+
+        params.okay() = (params.error() <= tol) && (params.error2() <= tol)
+                        && (params.iters() >= 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_matrix_sign( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_matrix_sign_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_matrix_sign_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_matrix_sign_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_matrix_sign_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
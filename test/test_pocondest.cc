@@ -16,6 +16,7 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <limits>
 #include <utility>
 
 //------------------------------------------------------------------------------
@@ -50,6 +51,7 @@ void test_pocondest_work(Params& params, bool run)
     SLATE_UNUSED(verbose);
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
+    int64_t normest_vectors = params.normest_vectors();
     slate::GridOrder grid_order = params.grid_order();
     params.matrix.mark();
     params.matrixB.mark();
@@ -96,6 +98,7 @@ void test_pocondest_work(Params& params, bool run)
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
         {slate::Option::MethodLU, method},
+        {slate::Option::NormEstVectors, normest_vectors},
     };
 
     // Matrix A: figure out local size.
@@ -147,6 +150,7 @@ void test_pocondest_work(Params& params, bool run)
     // Compute the matrix norm
     real_t Anorm = 0;
     Anorm = slate::norm(norm, A, opts);
+    real_t Anorm_fused = Anorm;
     real_t slate_rcond = 0., scl_rcond = 0., exact_rcond = 0.;
 
     if (! ref_only) {
@@ -161,9 +165,9 @@ void test_pocondest_work(Params& params, bool run)
         //==================================================
 
         double time2 = barrier_get_wtime(MPI_COMM_WORLD);
-        slate::chol_factor(A, opts);
-        // Using traditional BLAS/LAPACK name
-        // slate::potrf(A, opts);
+        // potrf also computes the norm of A as it factors it,
+        // which should match the norm computed above.
+        slate::potrf(A, norm, &Anorm_fused, opts);
         // compute and save timing/performance
         time2 = barrier_get_wtime(MPI_COMM_WORLD) - time2;
         params.time2() = time2;
@@ -277,6 +281,10 @@ void test_pocondest_work(Params& params, bool run)
     real_t tol = params.tol();
     params.okay() = (params.error() <= tol);
 
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+    params.okay() = params.okay()
+                    && std::abs( Anorm_fused - Anorm ) <= 10*eps*Anorm;
+
 }
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,179 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_polar_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t p = params.grid.m();
+    int64_t q = params.grid.n();
+    int64_t nb = params.nb();
+    int64_t ib = params.ib();
+    int64_t panel_threads = params.panel_threads();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Origin origin = params.origin();
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_Matrix( params );
+    // polar assumes square tiles
+    params.nonuniform_nb.used( false );
+
+    params.time();
+    params.error2();
+    params.ortho_U();
+    params.error.name( "H herm." );
+    params.error2.name( "Backward" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::MaxPanelThreads, panel_threads},
+        {slate::Option::InnerBlocking, ib},
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( false, true, m, n, params );
+    auto Acpy_alloc = allocate_test_Matrix<scalar_t>( false, true, m, n, params );
+    auto& A    = A_alloc.A;
+    auto& Acpy = Acpy_alloc.A;
+
+    slate::HermitianMatrix<scalar_t> H(
+        slate::Uplo::Lower, n, nb, p, q, MPI_COMM_WORLD );
+    H.insertLocalTiles( origin2target( origin ) );
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    if (check)
+        slate::copy( A, Acpy );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test: A = U H, with U overwriting A.
+    //==================================================
+    slate::polar( A, H, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    print_matrix( "U", A, params );
+    print_matrix( "H", H, params );
+
+    if (check) {
+        params.okay() = true;
+
+        //==================================================
+        // Test results by checking orthogonality of U
+        //
+        //      || I - U^H U ||_1
+        //     ------------------- < tol * epsilon
+        //              N
+        //==================================================
+        auto R_alloc = allocate_test_Matrix<scalar_t>( false, true, n, n, params );
+        auto& R = R_alloc.A;
+        slate::set( zero, one, R );
+        auto UH = conj_transpose( A );
+        slate::gemm( -one, UH, A, one, R, opts );
+        params.ortho_U() = slate::norm( slate::Norm::One, R ) / n;
+        params.okay() = params.okay() && (params.ortho_U() <= tol);
+
+        //==================================================
+        // Test results by checking that H = U^H Acpy
+        // is Hermitian, i.e., the skew-Hermitian part
+        //
+        //      || U^H Acpy - Acpy^H U ||_1
+        //     ----------------------------- < tol * epsilon
+        //            || A ||_1 * N
+        //==================================================
+        real_t Anorm = slate::norm( slate::Norm::One, Acpy );
+        auto AcpyH = conj_transpose( Acpy );
+        slate::gemm( one, UH, Acpy, zero, R, opts );
+        slate::gemm( -one, AcpyH, A, one, R, opts );
+        params.error() = slate::norm( slate::Norm::One, R ) / (Anorm * n);
+        params.okay() = params.okay() && (params.error() <= tol);
+
+        //==================================================
+        // Test results by checking backwards error
+        //
+        //      || Acpy - U H ||_1
+        //     -------------------- < tol * epsilon
+        //       || A ||_1 * N
+        //==================================================
+        slate::hemm( slate::Side::Right, -one, H, A, one, Acpy, opts );
+        params.error2() = slate::norm( slate::Norm::One, Acpy ) / (Anorm * n);
+        params.okay() = params.okay() && (params.error2() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_polar( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_polar_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_polar_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_polar_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_polar_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
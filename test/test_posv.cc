@@ -4,6 +4,7 @@
 // the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
 
 #include "slate/slate.hh"
+#include "slate/internal/TaskGraph.hh"
 #include "test.hh"
 #include "blas/flops.hh"
 #include "lapack/flops.hh"
@@ -36,17 +37,21 @@ void test_posv_work(Params& params, bool run)
     int64_t nrhs = params.nrhs();
     int64_t nb = params.nb();
     int64_t lookahead = params.lookahead();
+    int64_t max_lookahead = params.max_lookahead();
     bool ref_only = params.ref() == 'o';
     bool ref = params.ref() == 'y' || ref_only;
     bool check = params.check() == 'y' && ! ref_only;
     bool trace = params.trace() == 'y';
+    bool task_graph = params.task_graph() == 'y';
     bool hold_local_workspace = params.hold_local_workspace() == 'y';
+    bool invert_diag = params.invert_diag() == 'y';
     int verbose = params.verbose();
     int timer_level = params.timer_level();
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
     params.matrix.mark();
     params.matrixB.mark();
+    slate::Method methodCholesky = params.method_cholesky();
     slate::Method methodTrsm = params.method_trsm();
     slate::Method methodHemm = params.method_hemm();
 
@@ -68,9 +73,11 @@ void test_posv_work(Params& params, bool run)
     params.gflops();
     params.ref_time();
     params.ref_gflops();
+    mark_params_for_benchmark( params );
 
     bool do_potrs = params.routine == "potrs"
-                    || (check && params.routine == "potrf");
+                    || (check && (params.routine == "potrf"
+                                  || params.routine == "potrf_mixed"));
 
     if (do_potrs) {
         params.time2();
@@ -132,15 +139,19 @@ void test_posv_work(Params& params, bool run)
 
     slate::Options const opts =  {
         {slate::Option::Lookahead, lookahead},
+        {slate::Option::MaxLookahead, max_lookahead},
         {slate::Option::Target, target},
         {slate::Option::HoldLocalWorkspace, hold_local_workspace},
+        {slate::Option::InvertDiagonal, invert_diag},
+        {slate::Option::MethodCholesky, methodCholesky},
         {slate::Option::MethodTrsm, methodTrsm},
         {slate::Option::MethodHemm, methodHemm},
         {slate::Option::MaxIterations, itermax},
         {slate::Option::UseFallbackSolver, fallback},
     };
 
-    if ((params.routine == "posv_mixed" || params.routine == "posv_mixed_gmres")
+    if ((params.routine == "posv_mixed" || params.routine == "posv_mixed_gmres"
+         || params.routine == "potrf_mixed")
         && ! std::is_same<real_t, double>::value) {
         params.msg() = "skipping: unsupported mixed precision; must be type=d or z";
         return;
@@ -154,8 +165,9 @@ void test_posv_work(Params& params, bool run)
 
     int64_t info = 0;
 
-    auto A_alloc = allocate_test_HermitianMatrix<scalar_t>( check || ref, true, n, params );
-    auto B_alloc = allocate_test_Matrix<scalar_t>( check || ref, true, n, nrhs, params );
+    bool bench = params.bench() > 0;
+    auto A_alloc = allocate_test_HermitianMatrix<scalar_t>( check || ref || bench, true, n, params );
+    auto B_alloc = allocate_test_Matrix<scalar_t>( check || ref || bench, true, n, nrhs, params );
     TestMatrix<slate::Matrix<scalar_t>> X_alloc;
     if (is_iterative) {
         X_alloc = allocate_test_Matrix<scalar_t>( false, true, n, nrhs, params );
@@ -176,9 +188,10 @@ void test_posv_work(Params& params, bool run)
     print_matrix("A", A, params);
     print_matrix("B", B, params);
 
-    // if check is required, copy test data and create a descriptor for it
+    // if check is required, copy test data and create a descriptor for it;
+    // the copies also restore A and B between benchmark calls
     std::vector<scalar_t> B_orig;
-    if (check || ref) {
+    if (check || ref || bench) {
         slate::copy( A, Aref );
         slate::copy( B, Bref );
 
@@ -198,40 +211,51 @@ void test_posv_work(Params& params, bool run)
 
         if (trace) slate::trace::Trace::on();
         else slate::trace::Trace::off();
+        if (task_graph) slate::trace::TaskGraph::on();
 
         //==================================================
         // Run SLATE test: potrf or posv
         // potrf: Factor A = LL^H or A = U^H U.
         // posv:  Solve AX = B, including factoring A.
         //==================================================
-        double time = barrier_get_wtime(MPI_COMM_WORLD);
-
-        if (params.routine == "potrf" || params.routine == "potrs") {
-            // Factor matrix A.
-            info = slate::chol_factor( A, opts );
-            // Using traditional BLAS/LAPACK name
-            // slate::potrf(A, opts);
-        }
-        else if (params.routine == "posv") {
-            info = slate::chol_solve( A, B, opts );
-            // Using traditional BLAS/LAPACK name
-            // slate::posv(A, B, opts);
-        }
-        else if (params.routine == "posv_mixed") {
-            if constexpr (std::is_same<real_t, double>::value) {
-                int iters = 0;
-                info = slate::posv_mixed( A, B, X, iters, opts );
-                params.iters() = iters;
-            }
-        }
-        else if (params.routine == "posv_mixed_gmres") {
-            if constexpr (std::is_same<real_t, double>::value) {
-                int iters = 0;
-                info = slate::posv_mixed_gmres(A, B, X, iters, opts);
-                params.iters() = iters;
-            }
-        }
-        time = barrier_get_wtime(MPI_COMM_WORLD) - time;
+        double time = benchmark( params,
+            [&]() {
+                if (params.routine == "potrf" || params.routine == "potrs") {
+                    // Factor matrix A.
+                    info = slate::chol_factor( A, opts );
+                    // Using traditional BLAS/LAPACK name
+                    // slate::potrf(A, opts);
+                }
+                else if (params.routine == "potrf_mixed") {
+                    if constexpr (std::is_same<real_t, double>::value) {
+                        slate::select_tile_precision( A, opts );
+                        info = slate::potrf_mixed( A, opts );
+                    }
+                }
+                else if (params.routine == "posv") {
+                    info = slate::chol_solve( A, B, opts );
+                    // Using traditional BLAS/LAPACK name
+                    // slate::posv(A, B, opts);
+                }
+                else if (params.routine == "posv_mixed") {
+                    if constexpr (std::is_same<real_t, double>::value) {
+                        int iters = 0;
+                        info = slate::posv_mixed( A, B, X, iters, opts );
+                        params.iters() = iters;
+                    }
+                }
+                else if (params.routine == "posv_mixed_gmres") {
+                    if constexpr (std::is_same<real_t, double>::value) {
+                        int iters = 0;
+                        info = slate::posv_mixed_gmres(A, B, X, iters, opts);
+                        params.iters() = iters;
+                    }
+                }
+            },
+            [&]() {
+                slate::copy( Aref, A );
+                slate::copy( Bref, B );
+            } );
         // compute and save timing/performance
         params.time() = time;
         params.gflops() = gflop / time;
@@ -267,7 +291,8 @@ void test_posv_work(Params& params, bool run)
         if (do_potrs && info == 0) {
             double time2 = barrier_get_wtime(MPI_COMM_WORLD);
 
-            if ((check && params.routine == "potrf")
+            if ((check && (params.routine == "potrf"
+                           || params.routine == "potrf_mixed"))
                 || params.routine == "potrs")
             {
                 slate::chol_solve_using_factor(A, B, opts);
@@ -284,6 +309,7 @@ void test_posv_work(Params& params, bool run)
         }
 
         if (trace) slate::trace::Trace::finish();
+        if (task_graph) slate::trace::TaskGraph::finish();
 
         if (info != 0) {
             char buf[ 80 ];
@@ -369,7 +395,7 @@ void test_posv_work(Params& params, bool run)
             // Run ScaLAPACK reference routine.
             //==================================================
             double time = barrier_get_wtime(MPI_COMM_WORLD);
-            if (params.routine == "potrf") {
+            if (params.routine == "potrf" || params.routine == "potrf_mixed") {
                 scalapack_ppotrf(uplo2str(uplo), n, &Aref_data[0], 1, 1, Aref_desc, &info);
             }
             else if (params.routine == "potrs") {
@@ -389,7 +415,8 @@ void test_posv_work(Params& params, bool run)
                     slate::Debug::diffLapackMatrices<scalar_t>(
                         n, n, &A_data[0], A_alloc.lld,
                         &Aref_data[0], A_alloc.lld, nb, nb);
-                    if (params.routine != "potrf") {
+                    if (params.routine != "potrf"
+                        && params.routine != "potrf_mixed") {
                         slate::Debug::diffLapackMatrices<scalar_t>(
                             n, nrhs, &B_data[0], B_alloc.lld,
                             &Bref_data[0], B_alloc.lld, nb, nb);
@@ -0,0 +1,167 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void test_potrf_update_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1;
+    const real_t r_one = 1;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t nrhs = params.nrhs();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    bool downdate = params.routine == "potrf_downdate";
+    params.matrix.mark();
+    params.matrixB.mark();
+
+    mark_params_for_test_HermitianMatrix( params );
+
+    params.time();
+    params.ref_time();
+    params.ref_time.name( "potrf time (s)" );
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+    };
+
+    auto A_alloc    = allocate_test_HermitianMatrix<scalar_t>( false, true, n, params );
+    auto Aref_alloc = allocate_test_HermitianMatrix<scalar_t>( false, true, n, params );
+    auto V_alloc    = allocate_test_Matrix<scalar_t>( false, true, n, k, params );
+    auto& A    = A_alloc.A;
+    auto& Aref = Aref_alloc.A;
+    auto& V    = V_alloc.A;
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    slate::generate_matrix( params.matrix, A );
+    slate::generate_matrix( params.matrixB, V );
+    slate::copy( A, Aref );
+
+    // For an update, factor A and update it to Aref = A + V V^H.
+    // For a downdate, factor A + V V^H and downdate it to Aref = A.
+    if (downdate)
+        slate::herk( r_one, V, r_one, A, opts );
+    else
+        slate::herk( r_one, V, r_one, Aref, opts );
+    print_matrix( "A", A, params );
+    print_matrix( "V", V, params );
+
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+    int64_t info = slate::potrf( A, opts );
+    params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+    slate_assert( info == 0 );
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test: update or downdate the factor.
+    //==================================================
+    if (downdate)
+        info = slate::potrf_downdate( A, V, opts );
+    else
+        info = slate::potrf_update( A, V, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    print_matrix( "L", A, params );
+
+    if (info != 0) {
+        params.okay() = false;
+        params.msg() = "info = " + std::to_string( info );
+        return;
+    }
+
+    if (check) {
+        //==================================================
+        // Test results by solving with the updated factor
+        //
+        //      || Aref X - B ||_1
+        //     ------------------------ < tol * epsilon
+        //      || Aref ||_1 || X ||_1 N
+        //==================================================
+        auto B_alloc = allocate_test_Matrix<scalar_t>( false, true, n, nrhs, params );
+        auto X_alloc = allocate_test_Matrix<scalar_t>( false, true, n, nrhs, params );
+        auto& B = B_alloc.A;
+        auto& X = X_alloc.A;
+        slate::generate_matrix( params.matrixB, B );
+        slate::copy( B, X );
+
+        slate::potrs( A, X, opts );
+
+        real_t A_norm = slate::norm( slate::Norm::One, Aref );
+        real_t X_norm = slate::norm( slate::Norm::One, X );
+        slate::hemm( slate::Side::Left, -one, Aref, X, one, B, opts );
+        real_t R_norm = slate::norm( slate::Norm::One, B );
+
+        params.error() = R_norm / (n * A_norm * X_norm);
+        params.okay() = (params.error() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_potrf_update( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_potrf_update_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_update_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_update_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_update_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
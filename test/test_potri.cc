@@ -160,6 +160,38 @@ void test_potri_work(Params& params, bool run)
         slate::multiply(  one, Aref, X, zero, Y );  // hemm: Y = Aref X;
         slate::multiply( -one, A, Y, one, X );      // hemm: X = X - A^{-1} Y
         real_t error = slate::norm( slate::Norm::One, X ) / (n * normX);
+
+        //==================================================
+        // Check potri_diag against the diagonal of A^{-1}:
+        // max_i | D_i - A^{-1}_ii | / max_i | A^{-1}_ii |
+        //==================================================
+        auto Afac = Aref.emptyLike();
+        Afac.insertLocalTiles( origin_target );
+        slate::copy( Aref, Afac, opts );
+        slate::potrf( Afac, opts );
+        std::vector<real_t> D;
+        slate::potri_diag( Afac, D, opts );
+
+        std::vector<real_t> Ainv_diag( n, 0.0 );
+        int64_t offset = 0;
+        for (int64_t i = 0; i < A.nt(); ++i) {
+            if (A.tileIsLocal( i, i )) {
+                A.tileGetForReading( i, i, slate::LayoutConvert::ColMajor );
+                auto T = A( i, i );
+                for (int64_t ii = 0; ii < T.mb(); ++ii)
+                    Ainv_diag[ offset + ii ] = std::real( T( ii, ii ) );
+            }
+            offset += A.tileMb( i );
+        }
+        MPI_Allreduce( MPI_IN_PLACE, Ainv_diag.data(), n,
+                       slate::mpi_type<real_t>::value, MPI_SUM, MPI_COMM_WORLD );
+        real_t diag_err = 0, diag_max = 0;
+        for (int64_t i = 0; i < n; ++i) {
+            diag_err = std::max( diag_err, std::abs( D[ i ] - Ainv_diag[ i ] ) );
+            diag_max = std::max( diag_max, std::abs( Ainv_diag[ i ] ) );
+        }
+        error = std::max( error, diag_err / (n * diag_max) );
+
         params.error() = error;
         real_t tol = params.tol() * std::numeric_limits<real_t>::epsilon();
         params.okay() = (params.error() <= tol);
@@ -0,0 +1,146 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Tests redistribute from A, with the tester's tiling on a p-by-q grid,
+/// into B on a q-by-p grid, with tile size nb (same tiling) and with tile
+/// size 3 nb / 2 + 1 (re-tiling), then back into a matrix tiled as A.
+/// The round trip must reproduce A exactly.
+template <typename scalar_t>
+void test_redistribute_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t one = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t p = params.grid.m();
+    int64_t q = params.grid.n();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Origin origin = params.origin();
+    slate::Target target = params.target();
+    params.matrix.mark();
+
+    mark_params_for_test_Matrix( params );
+
+    // mark non-standard output values
+    params.time();
+    params.time2();
+    params.time.name( "same nb (s)" );
+    params.time2.name( "re-tile (s)" );
+    mark_params_for_bandwidth( params );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    slate::Options const opts =  {
+        {slate::Option::Target, target}
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( false, false, m, n, params );
+    auto& A = A_alloc.A;
+    slate::generate_matrix( params.matrix, A );
+    print_matrix( "A", A, params );
+
+    slate::Target origin_target = origin2target( origin );
+    int64_t nbs[] = { nb, 3*nb/2 + 1 };
+    real_t error = 0;
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    for (int64_t nb_B : nbs) {
+        slate::Matrix<scalar_t> B( m, n, nb_B, q, p, MPI_COMM_WORLD );
+        B.insertLocalTiles( origin_target );
+
+        //==================================================
+        // Run SLATE test.
+        // Redistribute A to B.
+        //==================================================
+        double time = barrier_get_wtime( MPI_COMM_WORLD );
+
+        slate::redistribute( A, B, opts );
+
+        time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+        if (nb_B == nb)
+            params.time() = time;
+        else
+            params.time2() = time;
+
+        print_matrix( "B", B, params );
+
+        if (check) {
+            //==================================================
+            // Test results by redistributing B back into A2, tiled as A,
+            // which must equal A exactly.
+            //==================================================
+            auto A2 = A.emptyLike();
+            A2.insertLocalTiles( origin_target );
+            slate::redistribute( B, A2, opts );
+
+            slate::add( -one, A, one, A2, opts );
+            error = std::max( error, slate::norm( slate::Norm::Max, A2 ) );
+        }
+    }
+
+    if (trace) slate::trace::Trace::finish();
+
+    // Reads A, writes B.
+    double gbyte = 2 * double( m ) * n * sizeof( scalar_t ) * 1e-9;
+    params.gbytes() = gbyte / params.time2();
+
+    if (check) {
+        params.error() = error;
+        params.okay() = (error == 0);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_redistribute( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_redistribute_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_redistribute_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_redistribute_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_redistribute_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
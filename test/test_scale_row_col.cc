@@ -64,6 +64,7 @@ void test_scale_row_col_work( Params& params, bool run )
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -132,6 +133,10 @@ void test_scale_row_col_work( Params& params, bool run )
 
         // compute and save timing/performance
         params.time() = time;
+        // Reads and writes A, reads R and C.
+        double gbyte = (2 * stored_elements( uplo, m, n ) * sizeof( scalar_t )
+                        + (m + n) * sizeof( real_t )) * 1e-9;
+        params.gbytes() = gbyte / time;
 
         print_matrix( "Afull_out", Afull, params );
         print_matrix( "A_out", A, params );
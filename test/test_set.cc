@@ -60,6 +60,7 @@ void test_set_work(Params& params, bool run)
     // mark non-standard output values
     params.time();
     params.ref_time();
+    mark_params_for_bandwidth( params );
 
     if (! run)
         return;
@@ -115,6 +116,9 @@ void test_set_work(Params& params, bool run)
 
         // compute and save timing/performance
         params.time() = time;
+        // Writes A.
+        double gbyte = stored_elements( uplo, m, n ) * sizeof( scalar_t ) * 1e-9;
+        params.gbytes() = gbyte / time;
 
         print_matrix( "Afull_out", Afull, params );
         print_matrix( "A_out", A, params );
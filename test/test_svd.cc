@@ -47,6 +47,7 @@ void test_svd_work( Params& params, bool run )
     int timer_level = params.timer_level();
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
+    slate::MethodEig method_eig = params.method_eig();
     params.matrix.mark();
 
     mark_params_for_test_Matrix( params );
@@ -102,7 +103,8 @@ void test_svd_work( Params& params, bool run )
         {slate::Option::Lookahead, lookahead},
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
-        {slate::Option::InnerBlocking, ib}
+        {slate::Option::InnerBlocking, ib},
+        {slate::Option::MethodEig, method_eig},
     };
 
     bool wantu  = (jobu  == slate::Job::Vec
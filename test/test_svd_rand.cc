@@ -0,0 +1,205 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "test.hh"
+#include "print_matrix.hh"
+
+#include "matrix_utils.hh"
+#include "test_utils.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+//------------------------------------------------------------------------------
+/// Tests svd_rand on A = X W^H of known rank k, where X is m-by-k and
+/// W is n-by-k, so the k triplets svd_rand computes are exact up to
+/// rounding. The singular values are compared with those of svd.
+template <typename scalar_t>
+void test_svd_rand_work( Params& params, bool run )
+{
+    using real_t = blas::real_type<scalar_t>;
+
+    // Constants
+    const scalar_t zero = 0;
+    const scalar_t one  = 1;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = params.dim.k();
+    int64_t lookahead = params.lookahead();
+    bool check = params.check() == 'y';
+    bool trace = params.trace() == 'y';
+    slate::Target target = params.target();
+    params.matrix.mark();
+    params.matrixB.mark();
+
+    mark_params_for_test_Matrix( params );
+    // svd_rand takes U and VT tiles from A, which must be square.
+    params.nonuniform_nb.used( false );
+
+    params.time();
+    params.ref_time();
+    params.ref_time.name( "svd time (s)" );
+    params.error2();
+    params.ortho_U();
+    params.ortho_V();
+    params.error.name( "S - Sref" );
+    params.error2.name( "Backward" );
+
+    if (! run)
+        return;
+
+    // Check for common invalid combinations
+    if (is_invalid_parameters( params )) {
+        return;
+    }
+
+    int64_t min_mn = std::min( m, n );
+    k = std::max( std::min( k, min_mn ), int64_t( 1 ) );
+
+    slate::Options const opts =  {
+        {slate::Option::Lookahead, lookahead},
+        {slate::Option::Target, target},
+        {slate::Option::Rank, k},
+    };
+
+    auto A_alloc = allocate_test_Matrix<scalar_t>( false, false, m, n, params );
+    auto& A = A_alloc.A;
+
+    // X has A's row tiles, W^H has A's column tiles.
+    auto X = A.emptyLike().slice( 0, m-1, 0, k-1 );
+    auto W = A.emptyLike( 0, 0, slate::Op::ConjTrans ).slice( 0, n-1, 0, k-1 );
+    auto U = A.emptyLike().slice( 0, m-1, 0, k-1 );
+    auto VT = A.emptyLike().slice( 0, k-1, 0, n-1 );
+    X.insertLocalTiles( target );
+    W.insertLocalTiles( target );
+    U.insertLocalTiles( target );
+    VT.insertLocalTiles( target );
+
+    slate::generate_matrix( params.matrix, X );
+    slate::generate_matrix( params.matrixB, W );
+    auto WH = conj_transpose( W );
+    slate::gemm( one, X, WH, zero, A, opts );
+    print_matrix( "A", A, params );
+
+    real_t tol = params.tol() * 0.5 * std::numeric_limits<real_t>::epsilon();
+
+    std::vector<real_t> Sigma;
+
+    if (trace) slate::trace::Trace::on();
+    else slate::trace::Trace::off();
+
+    double time = barrier_get_wtime( MPI_COMM_WORLD );
+
+    //==================================================
+    // Run SLATE test.
+    //==================================================
+    slate::svd_rand( A, Sigma, U, VT, opts );
+
+    time = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+    if (trace) slate::trace::Trace::finish();
+
+    params.time() = time;
+
+    print_matrix( "Sigma", 1, k, &Sigma[0], 1, params );
+    print_matrix( "U",  U,  params );
+    print_matrix( "VT", VT, params );
+
+    if (check) {
+        //==================================================
+        // Test results by comparing the singular values with svd
+        //
+        //      max_i | Sigma_i - Sigma_ref_i |
+        //     --------------------------------- < tol * epsilon
+        //              Sigma_ref_0
+        //==================================================
+        // svd overwrites its input; svd_rand doesn't.
+        std::vector<real_t> Sigma_ref( min_mn );
+        auto Aref = A.emptyLike();
+        Aref.insertLocalTiles( target );
+        slate::copy( A, Aref );
+
+        time = barrier_get_wtime( MPI_COMM_WORLD );
+        slate::svd_vals( Aref, Sigma_ref, opts );
+        params.ref_time() = barrier_get_wtime( MPI_COMM_WORLD ) - time;
+
+        real_t error = 0;
+        for (int64_t i = 0; i < k; ++i)
+            error = std::max( error, std::abs( Sigma[ i ] - Sigma_ref[ i ] ) );
+        params.error() = error / Sigma_ref[ 0 ];
+        params.okay() = (params.error() <= tol);
+
+        //==================================================
+        // Test results by checking orthogonality of U and V
+        //
+        //      || I - U^H U ||_1
+        //     ------------------- < tol * epsilon
+        //              N
+        //==================================================
+        auto R = U.emptyLike().slice( 0, k-1, 0, k-1 );
+        R.insertLocalTiles( target );
+
+        slate::set( zero, one, R );
+        auto UH = conj_transpose( U );
+        slate::gemm( -one, UH, U, one, R, opts );
+        params.ortho_U() = slate::norm( slate::Norm::One, R ) / n;
+
+        slate::set( zero, one, R );
+        auto V = conj_transpose( VT );
+        slate::gemm( -one, VT, V, one, R, opts );
+        params.ortho_V() = slate::norm( slate::Norm::One, R ) / n;
+
+        params.okay() = params.okay()
+                        && (params.ortho_U() <= tol)
+                        && (params.ortho_V() <= tol);
+
+        //==================================================
+        // Test results by checking backwards error; A has rank k,
+        // so the truncation is exact
+        //
+        //      || A - U Sigma VT ||_1
+        //     ------------------------ < tol * epsilon
+        //          || A ||_1 * N
+        //==================================================
+        slate::scale_row_col( slate::Equed::Col, Sigma, Sigma, U );
+
+        real_t Anorm = slate::norm( slate::Norm::One, A );
+        slate::gemm( -one, U, VT, one, A, opts );
+        params.error2() = slate::norm( slate::Norm::One, A ) / (Anorm * n);
+        params.okay() = params.okay() && (params.error2() <= tol);
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_svd_rand( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_svd_rand_work<float>( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_svd_rand_work<double>( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_svd_rand_work<std::complex<float>>( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_svd_rand_work<std::complex<double>>( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unknown datatype" );
+            break;
+    }
+}
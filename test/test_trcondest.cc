@@ -50,6 +50,7 @@ void test_trcondest_work(Params& params, bool run)
     SLATE_UNUSED(verbose);
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
+    int64_t normest_vectors = params.normest_vectors();
     slate::GridOrder grid_order = params.grid_order();
     params.matrix.mark();
     params.matrixB.mark();
@@ -89,6 +90,7 @@ void test_trcondest_work(Params& params, bool run)
         {slate::Option::Target, target},
         {slate::Option::MaxPanelThreads, panel_threads},
         {slate::Option::InnerBlocking, ib},
+        {slate::Option::NormEstVectors, normest_vectors},
     };
 
     // Matrix A: figure out local size.
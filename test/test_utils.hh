@@ -19,7 +19,7 @@ inline bool is_invalid_parameters(Params& params, bool keep_nonuniform_ref = fal
     slate::Origin origin = params.origin();
     slate::Target target = params.target();
     slate::GridOrder dev_order = params.dev_order();
-    bool nonuniform_nb = params.nonuniform_nb() == 'y';
+    bool nonuniform_nb = params.nonuniform_nb() != 'n';
 
     if (target != slate::Target::Devices && dev_order == slate::GridOrder::Col) {
         params.msg() = "skipping: dev_order = Col applies only to target devices";
@@ -31,6 +31,11 @@ inline bool is_invalid_parameters(Params& params, bool keep_nonuniform_ref = fal
         return true;
     }
 
+    if (params.dev_peer() == 'y' && origin == slate::Origin::ScaLAPACK) {
+        params.msg() = "skipping: dev_peer not supported with origin=ScaLAPACK";
+        return true;
+    }
+
     if (nonuniform_nb && origin == slate::Origin::ScaLAPACK) {
         params.msg() = "skipping: nonuniform tile not supported with origin=ScaLAPACK";
         return true;
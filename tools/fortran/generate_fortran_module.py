@@ -108,6 +108,8 @@ types_dict = {
     "slate_Target":                    ("character(kind=c_char)"),
     "slate_TileReleaseStrategy":       ("character(kind=c_char)"),
     "slate_MethodEig":                 ("character(kind=c_char)"),
+    "slate_MathMode":                  ("character(kind=c_char)"),
+    "slate_TournamentTree":            ("character(kind=c_char)"),
     "slate_Method":                    ("integer(kind=c_int)"),
     "slate_TileKind":                  ("integer(kind=c_int)"),
     "MPI_Comm":                        ("integer(kind=c_int)"),
@@ -136,6 +138,10 @@ exclude_list = [
     "slate_Matrix_create_fromScaLAPACK_r64",
     "slate_Matrix_create_fromScaLAPACK_c32",
     "slate_Matrix_create_fromScaLAPACK_c64",
+    "slate_Matrix_create_fromDevices_r32",
+    "slate_Matrix_create_fromDevices_r64",
+    "slate_Matrix_create_fromDevices_c32",
+    "slate_Matrix_create_fromDevices_c64",
 
     "slate_BandMatrix_create_r32",
     "slate_BandMatrix_create_r64",
@@ -150,6 +156,10 @@ exclude_list = [
     "slate_HermitianMatrix_create_fromScaLAPACK_r64",
     "slate_HermitianMatrix_create_fromScaLAPACK_c32",
     "slate_HermitianMatrix_create_fromScaLAPACK_c64",
+    "slate_HermitianMatrix_create_fromDevices_r32",
+    "slate_HermitianMatrix_create_fromDevices_r64",
+    "slate_HermitianMatrix_create_fromDevices_c32",
+    "slate_HermitianMatrix_create_fromDevices_c64",
 
     "slate_HermitianBandMatrix_create_r32",
     "slate_HermitianBandMatrix_create_r64",
@@ -164,6 +174,10 @@ exclude_list = [
     "slate_SymmetricMatrix_create_fromScaLAPACK_r64",
     "slate_SymmetricMatrix_create_fromScaLAPACK_c32",
     "slate_SymmetricMatrix_create_fromScaLAPACK_c64",
+    "slate_SymmetricMatrix_create_fromDevices_r32",
+    "slate_SymmetricMatrix_create_fromDevices_r64",
+    "slate_SymmetricMatrix_create_fromDevices_c32",
+    "slate_SymmetricMatrix_create_fromDevices_c64",
 
     "slate_TriangularMatrix_create_r32",
     "slate_TriangularMatrix_create_r64",
@@ -173,6 +187,10 @@ exclude_list = [
     "slate_TriangularMatrix_create_fromScaLAPACK_r64",
     "slate_TriangularMatrix_create_fromScaLAPACK_c32",
     "slate_TriangularMatrix_create_fromScaLAPACK_c64",
+    "slate_TriangularMatrix_create_fromDevices_r32",
+    "slate_TriangularMatrix_create_fromDevices_r64",
+    "slate_TriangularMatrix_create_fromDevices_c32",
+    "slate_TriangularMatrix_create_fromDevices_c64",
 
     "slate_TriangularBandMatrix_create_r32",
     "slate_TriangularBandMatrix_create_r64",
@@ -187,6 +205,10 @@ exclude_list = [
     "slate_TrapezoidMatrix_create_fromScaLAPACK_r64",
     "slate_TrapezoidMatrix_create_fromScaLAPACK_c32",
     "slate_TrapezoidMatrix_create_fromScaLAPACK_c64",
+    "slate_TrapezoidMatrix_create_fromDevices_r32",
+    "slate_TrapezoidMatrix_create_fromDevices_r64",
+    "slate_TrapezoidMatrix_create_fromDevices_c32",
+    "slate_TrapezoidMatrix_create_fromDevices_c64",
 
 ]
 
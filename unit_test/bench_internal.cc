@@ -0,0 +1,540 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+//------------------------------------------------------------------------------
+// Micro-benchmarks of the internal kernels that dominate the drivers:
+// internal::gemm, herk, trsm, permuteRows, BaseMatrix::listBcast, and
+// the device layout conversion of rectangular tiles (transpose).
+// Intended for tuning nb, the number of queues (lookahead), and the
+// broadcast radix on a given node, without running a whole factorization.
+//
+// The local kernels run on MPI_COMM_SELF on each rank, so are normally run
+// on 1 rank; listBcast broadcasts a block column over a 1 x P grid on
+// MPI_COMM_WORLD. Each parameter takes a comma-separated list; all
+// combinations are run. Reports median and min time over --iters calls,
+// after --warmup untimed calls.
+//
+// Example usage:
+//     ./bench_internal --target d --nb 256,384,512 --tiles 16 --queues 1,2,4 gemm
+//     mpirun -np 4 ./bench_internal --nb 512 --radix 2,4,8 listBcast
+//     ./bench_internal --target d --nb 128,256,512 --tiles 64 transpose
+
+#include "slate/slate.hh"
+#include "internal/internal.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+namespace bench {
+
+using slate::Target;
+using slate::Layout;
+
+//------------------------------------------------------------------------------
+// global variables
+int mpi_rank;
+int mpi_size;
+
+//------------------------------------------------------------------------------
+/// Parameters of one benchmark run.
+struct Params {
+    Target  target;
+    int64_t nb;
+    int64_t tiles;
+    int64_t queues;
+    int     radix;
+    int     iters;
+    int     warmup;
+};
+
+//------------------------------------------------------------------------------
+/// @return list of integers parsed from comma-separated str, e.g., "1,2,4".
+std::vector<int64_t> parse_list( const char* str )
+{
+    std::vector<int64_t> list;
+    const char* p = str;
+    while (*p != '\0') {
+        char* end;
+        long long val = strtoll( p, &end, 10 );
+        if (end == p) {
+            fprintf( stderr, "invalid list: %s\n", str );
+            exit( EXIT_FAILURE );
+        }
+        list.push_back( val );
+        p = (*end == ',' ? end + 1 : end);
+    }
+    return list;
+}
+
+//------------------------------------------------------------------------------
+/// Prepares matrix A for calls to internal routines: allocates batch
+/// arrays and queues, reserves workspace, and moves its tiles to the
+/// devices, as the drivers do before their task graph.
+template <typename matrix_t>
+void prepare( matrix_t& A, Params const& params )
+{
+    if (params.target == Target::Devices) {
+        A.allocateBatchArrays( A.mt() * A.nt(), params.queues );
+        A.reserveDeviceWorkspace();
+        A.tileGetAllForWritingOnDevices( slate::LayoutConvert::ColMajor );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Calls routine() warmup + iters times; reports the median and min time
+/// of the timed calls, and gflop/s and GB/s based on the median.
+/// Compute-bound kernels give gbyte = 0, memory-bound ones gflop = 0.
+/// Between calls, reset() is called outside the timed region.
+template <typename routine_t, typename reset_t>
+void run( const char* name, Params const& params, double gflop,
+          double gbyte, routine_t routine, reset_t reset )
+{
+    std::vector<double> times;
+    for (int iter = 0; iter < params.warmup + params.iters; ++iter) {
+        reset();
+        MPI_Barrier( MPI_COMM_WORLD );
+        double time = omp_get_wtime();
+
+        routine();
+
+        MPI_Barrier( MPI_COMM_WORLD );
+        time = omp_get_wtime() - time;
+        if (iter >= params.warmup)
+            times.push_back( time );
+    }
+    std::sort( times.begin(), times.end() );
+    double median = times[ times.size() / 2 ];
+
+    if (mpi_rank == 0) {
+        printf( "%-12s  %-7s  %6lld  %6lld  %6lld  %5d  %11.6f  %11.6f  %10.2f  %10.2f\n",
+                name,
+                params.target == Target::Devices ? "Devices" : "HostTask",
+                (long long) params.nb, (long long) params.tiles,
+                (long long) params.queues, params.radix,
+                median, times[ 0 ],
+                (gflop > 0 ? gflop / median : 0.0),
+                (gbyte > 0 ? gbyte / median : 0.0) );
+        fflush( stdout );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Runs body( group, i_begin, i_end ) as one OpenMP task per queue,
+/// splitting n block rows or columns into params.queues groups,
+/// similar to how the drivers spread lookahead columns across queues.
+template <typename body_t>
+void for_each_queue( int64_t n, Params const& params, body_t body )
+{
+    slate::OmpSetMaxActiveLevels set_active_levels( slate::MinOmpActiveLevels );
+
+    int64_t groups = std::min( params.queues, n );
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t g = 0; g < groups; ++g) {
+            int64_t i_begin = g * n / groups;
+            int64_t i_end   = (g + 1) * n / groups;
+            #pragma omp task firstprivate( g, i_begin, i_end )
+            body( g, i_begin, i_end );
+        }
+        #pragma omp taskwait
+    }
+}
+
+//------------------------------------------------------------------------------
+/// C += A B, with A and C tiles-by-1 block columns and B one tile,
+/// as in the trailing update of the factorizations.
+template <Target target>
+void bench_gemm( Params const& params )
+{
+    int64_t nb = params.nb;
+    int64_t m  = nb * params.tiles;
+
+    slate::Matrix<double> A( m,  nb, nb, 1, 1, MPI_COMM_SELF );
+    slate::Matrix<double> B( nb, nb, nb, 1, 1, MPI_COMM_SELF );
+    slate::Matrix<double> C( m,  nb, nb, 1, 1, MPI_COMM_SELF );
+    A.insertLocalTiles();
+    B.insertLocalTiles();
+    C.insertLocalTiles();
+    slate::set( 1.0, 1.0, A );
+    slate::set( 1.0 / nb, 1.0 / nb, B );
+    slate::set( 0.0, 0.0, C );
+    prepare( A, params );
+    prepare( B, params );
+    prepare( C, params );
+
+    int64_t mt = A.mt();
+    run( "gemm", params, 2. * m * nb * nb * 1e-9, 0.0,
+         [&]() {
+             for_each_queue( mt, params,
+                 [&]( int64_t queue, int64_t i_begin, int64_t i_end ) {
+                     slate::internal::gemm<target>(
+                         -1.0, A.sub( i_begin, i_end-1, 0, 0 ),
+                               B.sub( 0, 0, 0, 0 ),
+                          1.0, C.sub( i_begin, i_end-1, 0, 0 ),
+                         Layout::ColMajor, 0, queue );
+                 } );
+         },
+         []() {} );
+}
+
+//------------------------------------------------------------------------------
+/// C -= A A^H, with A a tiles-by-1 block column and C Hermitian,
+/// as in the trailing update of Cholesky.
+template <Target target>
+void bench_herk( Params const& params )
+{
+    int64_t nb = params.nb;
+    int64_t n  = nb * params.tiles;
+
+    slate::Matrix<double> A( n, nb, nb, 1, 1, MPI_COMM_SELF );
+    slate::HermitianMatrix<double> C(
+        slate::Uplo::Lower, n, nb, 1, 1, MPI_COMM_SELF );
+    A.insertLocalTiles();
+    C.insertLocalTiles();
+    slate::set( 1.0, 1.0, A );
+    slate::set( 0.0, 0.0, C );
+    prepare( A, params );
+    prepare( C, params );
+
+    // herk's off-diagonal tiles are a single batch on one queue.
+    run( "herk", params, double( n ) * n * nb * 1e-9, 0.0,
+         [&]() {
+             for_each_queue( 1, params,
+                 [&]( int64_t queue, int64_t i_begin, int64_t i_end ) {
+                     slate::internal::herk<target>(
+                         -1.0, A.sub( 0, A.mt()-1, 0, 0 ),
+                          1.0, C.sub( 0, C.mt()-1 ), 0, queue );
+                 } );
+         },
+         []() {} );
+}
+
+//------------------------------------------------------------------------------
+/// B = A^{-1} B, with A one lower triangular tile and B a 1-by-tiles
+/// block row, as in the U panel of LU.
+template <Target target>
+void bench_trsm( Params const& params )
+{
+    int64_t nb = params.nb;
+    int64_t n  = nb * params.tiles;
+
+    slate::TriangularMatrix<double> A(
+        slate::Uplo::Lower, slate::Diag::NonUnit, nb, nb, 1, 1, MPI_COMM_SELF );
+    slate::Matrix<double> B( nb, n, nb, 1, 1, MPI_COMM_SELF );
+    A.insertLocalTiles();
+    B.insertLocalTiles();
+    // Diagonally dominant, so repeated solves stay bounded.
+    slate::set( 0.5 / nb, 1.0, A );
+    slate::set( 1.0, 1.0, B );
+    prepare( A, params );
+    prepare( B, params );
+
+    int64_t nt = B.nt();
+    run( "trsm", params, double( nb ) * nb * n * 1e-9, 0.0,
+         [&]() {
+             for_each_queue( nt, params,
+                 [&]( int64_t queue, int64_t j_begin, int64_t j_end ) {
+                     slate::internal::trsm<target>(
+                         slate::Side::Left,
+                         1.0, A.sub( 0, 0 ),
+                              B.sub( 0, 0, j_begin, j_end-1 ),
+                         0, Layout::ColMajor, queue );
+                 } );
+         },
+         []() {} );
+}
+
+//------------------------------------------------------------------------------
+/// Applies nb random row interchanges to a tiles-by-tiles matrix,
+/// as in LU, one block column per task.
+template <Target target>
+void bench_permuteRows( Params const& params )
+{
+    int64_t nb = params.nb;
+    int64_t n  = nb * params.tiles;
+
+    slate::Matrix<double> A( n, n, nb, 1, 1, MPI_COMM_SELF );
+    A.insertLocalTiles();
+    slate::set( 1.0, 2.0, A );
+    prepare( A, params );
+
+    // LAPACK-style pivots: row i is swapped with a row >= i.
+    std::mt19937_64 gen( 42 );
+    std::vector<slate::Pivot> pivots;
+    for (int64_t i = 0; i < nb; ++i) {
+        int64_t row = std::uniform_int_distribution<int64_t>( i, n-1 )( gen );
+        pivots.push_back( slate::Pivot( row / nb, row % nb ) );
+    }
+
+    // As in getrf, devices swap rows in row-major tiles.
+    Layout layout = (target == Target::Devices ? Layout::RowMajor
+                                               : Layout::ColMajor);
+    int64_t nt = A.nt();
+    // Each interchange reads and writes 2 rows.
+    run( "permuteRows", params, 0.0, 4. * nb * n * sizeof( double ) * 1e-9,
+         [&]() {
+             for_each_queue( nt, params,
+                 [&]( int64_t queue, int64_t j_begin, int64_t j_end ) {
+                     for (int64_t j = j_begin; j < j_end; ++j) {
+                         slate::internal::permuteRows<target>(
+                             slate::Direction::Forward,
+                             A.sub( 0, A.mt()-1, j, j ), pivots,
+                             layout, 0, j, queue );
+                     }
+                 } );
+         },
+         []() {} );
+}
+
+//------------------------------------------------------------------------------
+/// Broadcasts each tile of block column 0 of a tiles-by-(P tiles) matrix
+/// on a 1 x P grid to its block row, as the panel broadcast in the
+/// factorizations.
+template <Target target>
+void bench_listBcast( Params const& params )
+{
+    int64_t nb = params.nb;
+    int64_t m  = nb * params.tiles;
+    int64_t n  = nb * mpi_size;
+
+    slate::Matrix<double> A( m, n, nb, 1, mpi_size, MPI_COMM_WORLD );
+    A.insertLocalTiles();
+    slate::set( 1.0, 1.0, A );
+    prepare( A, params );
+
+    int64_t mt = A.mt();
+    int64_t nt = A.nt();
+    // Each tile of block column 0 is received by the other ranks.
+    run( "listBcast", params, 0.0,
+         double( m ) * nb * (mpi_size - 1) * sizeof( double ) * 1e-9,
+         [&]() {
+             typename slate::Matrix<double>::BcastList bcast_list;
+             for (int64_t i = 0; i < mt; ++i)
+                 bcast_list.push_back( { i, 0, { A.sub( i, i, 1, nt-1 ) } } );
+             A.template listBcast<target>(
+                 bcast_list, Layout::ColMajor, 0, false, params.radix );
+         },
+         [&]() {
+             A.releaseRemoteWorkspace();
+         } );
+    A.releaseRemoteWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Converts a tiles-by-1 block column of rectangular nb-by-(nb/2) device
+/// tiles to RowMajor, as getrf and trsm do, and back between calls.
+/// Runs twice: "transpose_ip" with no free block in the pool, so tiles
+/// are transposed in place by following cycles, and "transpose_ws" with
+/// a free block per tile, so tiles are copied to a workspace and
+/// transposed out of place.
+template <Target target>
+void bench_transpose( Params const& params )
+{
+    if (target != Target::Devices) {
+        if (mpi_rank == 0)
+            fprintf( stderr, "transpose requires --target d\n" );
+        return;
+    }
+
+    int64_t nb = params.nb;
+    int64_t m  = nb * params.tiles;
+    int64_t n  = std::max( nb / 2, int64_t( 1 ) );
+
+    slate::Matrix<double> A( m, n, nb, 1, 1, MPI_COMM_SELF );
+    A.insertLocalTiles();
+    slate::set( 1.0, 2.0, A );
+    prepare( A, params );
+
+    // Each element is read and written.
+    double gbyte = 2. * m * n * sizeof( double ) * 1e-9;
+    for (bool use_workspace : { false, true }) {
+        if (use_workspace) {
+            // Grow the device pools by one free block per tile.
+            for (int device = 0; device < A.num_devices(); ++device) {
+                std::vector<double*> buffers;
+                for (int64_t i = 0; i < A.mt(); ++i)
+                    buffers.push_back( A.allocWorkspaceBuffer( device, nb*nb ) );
+                for (auto buffer : buffers)
+                    A.freeWorkspaceBuffer( device, buffer );
+            }
+        }
+        run( use_workspace ? "transpose_ws" : "transpose_ip",
+             params, 0.0, gbyte,
+             [&]() {
+                 A.tileLayoutConvertOnDevices( Layout::RowMajor );
+             },
+             [&]() {
+                 A.tileLayoutConvertOnDevices( Layout::ColMajor );
+             } );
+    }
+}
+
+//------------------------------------------------------------------------------
+void usage()
+{
+    printf( "Usage: bench_internal [options] [routines]\n"
+            "Routines: gemm herk trsm permuteRows listBcast transpose\n"
+            "          (default all; transpose only with --target d)\n"
+            "Options, with comma-separated lists:\n"
+            "  --target  t|d   HostTask or Devices; default t\n"
+            "  --nb      list  tile sizes; default 256\n"
+            "  --tiles   list  tiles in the block column or row; default 8\n"
+            "  --queues  list  queues (tasks) to split the work across; default 1\n"
+            "  --radix   list  listBcast radix; default 2\n"
+            "  --iters   n     timed calls; default 10\n"
+            "  --warmup  n     untimed calls; default 2\n" );
+}
+
+} // namespace bench
+
+//------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    using namespace bench;
+
+    int provided = 0;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &mpi_size );
+
+    Target target = Target::HostTask;
+    std::vector<int64_t> nbs    = { 256 };
+    std::vector<int64_t> tiles  = { 8 };
+    std::vector<int64_t> queues = { 1 };
+    std::vector<int64_t> radixs = { 2 };
+    int iters  = 10;
+    int warmup = 2;
+    std::vector<std::string> routines;
+
+    // parse options
+    for (int i = 1; i < argc; ++i) {
+        std::string arg( argv[ i ] );
+        bool has_value = (i + 1 < argc);
+        if (arg == "-h" || arg == "--help") {
+            if (mpi_rank == 0)
+                usage();
+            MPI_Finalize();
+            return 0;
+        }
+        else if (arg == "--target" && has_value) {
+            char t = argv[ ++i ][ 0 ];
+            target = (t == 'd' || t == 'D' ? Target::Devices : Target::HostTask);
+        }
+        else if (arg == "--nb" && has_value)
+            nbs = parse_list( argv[ ++i ] );
+        else if (arg == "--tiles" && has_value)
+            tiles = parse_list( argv[ ++i ] );
+        else if (arg == "--queues" && has_value)
+            queues = parse_list( argv[ ++i ] );
+        else if (arg == "--radix" && has_value)
+            radixs = parse_list( argv[ ++i ] );
+        else if (arg == "--iters" && has_value)
+            iters = std::max( 1, atoi( argv[ ++i ] ) );
+        else if (arg == "--warmup" && has_value)
+            warmup = std::max( 0, atoi( argv[ ++i ] ) );
+        else if (arg[ 0 ] == '-') {
+            if (mpi_rank == 0) {
+                fprintf( stderr, "unknown option: %s\n", arg.c_str() );
+                usage();
+            }
+            MPI_Finalize();
+            return EXIT_FAILURE;
+        }
+        else
+            routines.push_back( arg );
+    }
+    if (routines.empty()) {
+        routines = { "gemm", "herk", "trsm", "permuteRows", "listBcast" };
+        if (target == Target::Devices)
+            routines.push_back( "transpose" );
+    }
+
+    if (target == Target::Devices && blas::get_device_count() == 0) {
+        if (mpi_rank == 0)
+            fprintf( stderr, "no devices available\n" );
+        MPI_Finalize();
+        return EXIT_FAILURE;
+    }
+
+    if (mpi_rank == 0) {
+        printf( "ranks %d, threads %d, devices %d\n",
+                mpi_size, omp_get_max_threads(), blas::get_device_count() );
+        printf( "%-12s  %-7s  %6s  %6s  %6s  %5s  %11s  %11s  %10s  %10s\n",
+                "routine", "target", "nb", "tiles", "queues", "radix",
+                "median (s)", "min (s)", "gflop/s", "GB/s" );
+    }
+
+    for (auto& routine : routines) {
+        for (int64_t nb : nbs) {
+        for (int64_t nt : tiles) {
+        for (int64_t nq : queues) {
+        for (int64_t radix : radixs) {
+            Params params = { target, nb, nt, std::max( int64_t( 1 ), nq ),
+                              int( radix ), iters, warmup };
+            // radix only applies to listBcast; queues don't apply to
+            // listBcast, herk, or transpose.
+            if (routine != "listBcast" && radix != radixs[ 0 ])
+                continue;
+            if ((routine == "listBcast" || routine == "herk"
+                 || routine == "transpose")
+                && nq != queues[ 0 ])
+                continue;
+
+            if (routine == "gemm") {
+                if (target == Target::Devices)
+                    bench_gemm<Target::Devices>( params );
+                else
+                    bench_gemm<Target::HostTask>( params );
+            }
+            else if (routine == "herk") {
+                if (target == Target::Devices)
+                    bench_herk<Target::Devices>( params );
+                else
+                    bench_herk<Target::HostTask>( params );
+            }
+            else if (routine == "trsm") {
+                if (target == Target::Devices)
+                    bench_trsm<Target::Devices>( params );
+                else
+                    bench_trsm<Target::HostTask>( params );
+            }
+            else if (routine == "permuteRows") {
+                if (target == Target::Devices)
+                    bench_permuteRows<Target::Devices>( params );
+                else
+                    bench_permuteRows<Target::HostTask>( params );
+            }
+            else if (routine == "listBcast") {
+                if (target == Target::Devices)
+                    bench_listBcast<Target::Devices>( params );
+                else
+                    bench_listBcast<Target::Host>( params );
+            }
+            else if (routine == "transpose") {
+                if (target == Target::Devices)
+                    bench_transpose<Target::Devices>( params );
+                else
+                    bench_transpose<Target::HostTask>( params );
+            }
+            else {
+                if (mpi_rank == 0)
+                    fprintf( stderr, "unknown routine: %s\n", routine.c_str() );
+                MPI_Finalize();
+                return EXIT_FAILURE;
+            }
+        }}}}
+    }
+
+    MPI_Finalize();
+    return 0;
+}
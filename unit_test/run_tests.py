@@ -56,20 +56,26 @@ cmds = [
     'test_Matrix',
     'test_Memory',
     'test_SymmetricMatrix',
+    'test_TaskRuntime',
     'test_TrapezoidMatrix',
     'test_TriangularBandMatrix',
     'test_TriangularMatrix',
     'test_Tile',
+    'test_TileDirectory',
     'test_Tile_kernels',
+    'test_async',
     #'test_c_api',  # only if c_api was compiled
     'test_func',
     'test_geadd',
     'test_gecopy',
     'test_geset',
+    'test_iamax',
     'test_internal_blas',
     'test_lq',
     'test_norm',
     'test_qr',
+    'test_swap_rows',
+    'test_tlr',
     'test_util',
 ]
 
@@ -205,6 +205,34 @@ void test_BandMatrix_tileInsert_new()
     }
 }
 
+//------------------------------------------------------------------------------
+void test_BandMatrix_insertLocalTilesLazy()
+{
+    auto A = slate::BandMatrix<double>(m, n, kl, ku, nb, p, q, mpi_comm);
+    A.insertLocalTilesLazy();
+
+    int64_t klt = slate::ceildiv( kl, nb );
+    int64_t kut = slate::ceildiv( ku, nb );
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (! A.tileIsLocal( i, j ))
+                continue;
+
+            if (j - kut <= i && i <= j + klt) {
+                // Lazy tiles read as zero.
+                auto T = A( i, j );
+                test_assert( T.data() != nullptr );
+                test_assert( T( 0, 0 ) == 0.0 );
+                test_assert( T( T.mb()-1, T.nb()-1 ) == 0.0 );
+            }
+            else {
+                // outside band, tiles don't exist
+                test_assert( ! A.tileExists( i, j ) );
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void test_BandMatrix_tileInsert_data()
 {
@@ -451,6 +479,7 @@ void run_tests()
     run_test(test_BandMatrix_swap,            "swap",           mpi_comm);
     run_test(test_BandMatrix_tileInsert_new,  "BandMatrix::tileInsert(i, j, dev) ", mpi_comm);
     run_test(test_BandMatrix_tileInsert_data, "BandMatrix::tileInsert(i, j, dev, data, lda)",  mpi_comm);
+    run_test(test_BandMatrix_insertLocalTilesLazy, "BandMatrix::insertLocalTilesLazy", mpi_comm);
     run_test(test_BandMatrix_sub,             "BandMatrix::sub",       mpi_comm);
     run_test(test_BandMatrix_sub_trans,       "BandMatrix::sub(A^T)",  mpi_comm);
     run_test(test_TriangularBandMatrix_gatherAll, "TriangularBandMatrix::gatherAll()",  mpi_comm);
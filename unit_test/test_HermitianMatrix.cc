@@ -1087,6 +1087,41 @@ void test_Hermitian_from_Matrix()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Tests that insertLocalTiles inserts only the stored triangle, and that
+/// eraseOppositeTriangle drops the other triangle of a full Matrix.
+///
+void test_Hermitian_eraseOppositeTriangle()
+{
+    for (auto uplo : { slate::Uplo::Lower, slate::Uplo::Upper }) {
+        auto in_triangle = [uplo]( int64_t i, int64_t j ) {
+            return uplo == slate::Uplo::Lower ? i >= j : i <= j;
+        };
+
+        slate::HermitianMatrix<double> H( uplo, n, nb, p, q, mpi_comm );
+        H.insertLocalTiles();
+        for (int64_t j = 0; j < H.nt(); ++j) {
+            for (int64_t i = 0; i < H.mt(); ++i) {
+                if (H.tileIsLocal( i, j )) {
+                    test_assert( H.tileExists( i, j ) == in_triangle( i, j ) );
+                }
+            }
+        }
+
+        slate::Matrix<double> A( n, n, nb, p, q, mpi_comm );
+        A.insertLocalTiles();
+        auto F = slate::HermitianMatrix<double>( uplo, A );
+        F.eraseOppositeTriangle();
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                if (A.tileIsLocal( i, j )) {
+                    test_assert( A.tileExists( i, j ) == in_triangle( i, j ) );
+                }
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Tests HermitianMatrix( Trapezoid (BaseTrapezoid) A ).
 /// todo: what about Unit diag?
@@ -1225,6 +1260,8 @@ void run_tests()
     run_test(test_Hermitian_from_Symmetric,  "HermitianMatrix( SymmetricMatrix )",  mpi_comm);
     run_test(test_Hermitian_from_Trapezoid,  "HermitianMatrix( TrapezoidMatrix )",  mpi_comm);
     run_test(test_Hermitian_from_Triangular, "HermitianMatrix( TriangularMatrix )", mpi_comm);
+    run_test(test_Hermitian_eraseOppositeTriangle,
+             "HermitianMatrix::eraseOppositeTriangle", mpi_comm);
 }
 
 }  // namespace test
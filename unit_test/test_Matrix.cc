@@ -9,6 +9,8 @@
 #include "unit_test.hh"
 #include "util_matrix.hh"
 
+#include <stdexcept>
+
 using slate::ceildiv;
 using slate::roundup;
 using slate::GridOrder;
@@ -388,6 +390,59 @@ void test_Matrix_fromScaLAPACK_rect()
     }
 }
 
+//------------------------------------------------------------------------------
+/// rebindLAPACK, rebindScaLAPACK
+/// Test that rebinding makes tiles, of the matrix and its copies, point
+/// into the new array, and drops workspace tiles.
+void test_Matrix_rebind()
+{
+    int lda = roundup(m, mb);
+    std::vector<double> Ad( lda*n ), Bd( lda*n );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, mb, nb, p, q, mpi_comm );
+    auto A_copy = A;
+
+    // remote tiles are workspace
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (! A.tileIsLocal(i, j))
+                A.tileInsert(i, j);
+        }
+    }
+
+    A.rebindLAPACK( Bd.data(), lda );
+
+    test_assert(A.mt() == ceildiv(m, mb));
+    test_assert(A.nt() == ceildiv(n, nb));
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            test_assert( A_copy.tileExists(i, j) == A.tileIsLocal(i, j) );
+            verify_tile_lapack(A_copy, i, j, mb, nb, m, n, Bd.data(), lda);
+        }
+    }
+
+    int mtiles, mtiles_local, m_local, lda_local;
+    int ntiles, ntiles_local, n_local;
+    get_2d_cyclic_dimensions(
+        m, n, mb, nb,
+        mtiles, mtiles_local, m_local,
+        ntiles, ntiles_local, n_local, lda_local );
+
+    std::vector<double> Cd( lda_local*n_local ), Dd( lda_local*n_local );
+
+    auto C = slate::Matrix<double>::fromScaLAPACK(
+        m, n, Cd.data(), lda_local, mb, nb, p, q, mpi_comm );
+
+    C.rebindScaLAPACK( Dd.data(), lda_local );
+
+    for (int j = 0; j < C.nt(); ++j) {
+        for (int i = 0; i < C.mt(); ++i) {
+            verify_tile_scalapack(C, i, j, mb, nb, m, n, Dd.data(), lda_local);
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// fromDevices
 /// Test Matrix::fromDevices, A(i, j), tileIsLocal, tileMb, tileNb.
@@ -446,6 +501,52 @@ void test_Matrix_fromDevices()
         delete dev_queues[dev];
 }
 
+//------------------------------------------------------------------------------
+/// Tests that the inline tile size, rank, and device lookups of a uniform
+/// 2D block-cyclic matrix agree with its functions, for both grid orders
+/// and a partial last tile.
+void test_Matrix_uniformGrid()
+{
+    for (auto order : { slate::GridOrder::Col, slate::GridOrder::Row }) {
+        int64_t m2 = m + 3, n2 = n + 5;  // partial last tiles
+        auto A = slate::Matrix<double>( m2, n2, nb, nb, order, p, q, mpi_comm );
+        auto tileMb     = A.tileMbFunc();
+        auto tileNb     = A.tileNbFunc();
+        auto tileRank   = A.tileRankFunc();
+        auto tileDevice = A.tileDeviceFunc();
+        for (int64_t i = 0; i < A.mt(); ++i)
+            test_assert( A.tileMb( i ) == tileMb( i ) );
+        for (int64_t j = 0; j < A.nt(); ++j)
+            test_assert( A.tileNb( j ) == tileNb( j ) );
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            for (int64_t i = 0; i < A.mt(); ++i) {
+                test_assert( A.tileRank( i, j ) == tileRank( { i, j } ) );
+                test_assert( A.tileDevice( i, j ) == tileDevice( { i, j } ) );
+            }
+        }
+
+        // getRanks and getLocalDevices of trailing submatrices,
+        // vs. all their tiles.
+        for (int64_t i1 = 0; i1 < A.mt(); i1 += 2) {
+            for (int64_t j1 = 0; j1 < A.nt(); ++j1) {
+                auto B = A.sub( i1, A.mt()-1, j1, A.nt()-1 );
+                std::set<int> ranks, ranks_ref, devices, devices_ref;
+                B.getRanks( &ranks );
+                B.getLocalDevices( &devices );
+                for (int64_t j = 0; j < B.nt(); ++j) {
+                    for (int64_t i = 0; i < B.mt(); ++i) {
+                        ranks_ref.insert( B.tileRank( i, j ) );
+                        if (B.tileIsLocal( i, j ))
+                            devices_ref.insert( B.tileDevice( i, j ) );
+                    }
+                }
+                test_assert( ranks == ranks_ref );
+                test_assert( devices == devices_ref );
+            }
+        }
+    }
+}
+
 //==============================================================================
 // Methods
 
@@ -1066,6 +1167,41 @@ void test_Matrix_insertLocalTiles_dev()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Tests insertLocalTilesLazy on host: tiles are read as zero,
+/// and written tiles keep their values.
+void test_Matrix_insertLocalTilesLazy()
+{
+    slate::Matrix<double> A(m, n, mb, nb, p, q, mpi_comm);
+
+    A.insertLocalTilesLazy();
+    test_assert(A.origin() == slate::Target::Host);
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                test_assert(A.tileExists(i, j));
+                test_assert(A.tileState(i, j) == slate::MOSI::Shared);
+
+                // Never-written tile is zero.
+                A.tileGetForReading(i, j, slate::LayoutConvert::ColMajor);
+                auto T = A(i, j);
+                test_assert(T.mb() == A.tileMb(i));
+                test_assert(T.nb() == A.tileNb(j));
+                test_assert(T.stride() == A.tileMb(i));
+                test_assert(T.data() != nullptr);
+                for (int jj = 0; jj < T.nb(); ++jj)
+                    for (int ii = 0; ii < T.mb(); ++ii)
+                        test_assert(T(ii, jj) == 0.0);
+
+                A.tileGetForWriting(i, j, slate::LayoutConvert::ColMajor);
+                T = A(i, j);
+                T.at(0, 0) = i + j*1000.;
+                test_assert(A(i, j)(0, 0) == i + j*1000.);
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Test allocateBatchArrays, clearBatchArrays, batchArraySize.
 ///
@@ -1125,6 +1261,34 @@ void test_Matrix_allocateBatchArrays()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Tests that matrices share the communication queue and compute queue 0,
+/// and that setMathMode gives a matrix its own compute queues.
+void test_Matrix_sharedQueues()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    auto A = slate::Matrix<double>( m, n, nb, p, q, mpi_comm );
+    auto B = A.emptyLike();
+    auto C = slate::Matrix<float>( m, n, nb, p, q, mpi_comm );
+
+    for (int device = 0; device < num_devices; ++device) {
+        test_assert( A.comm_queue( device ) == B.comm_queue( device ) );
+        test_assert( A.comm_queue( device ) == C.comm_queue( device ) );
+        test_assert( A.compute_queue( device ) == B.compute_queue( device ) );
+        test_assert( A.compute_queue( device ) == C.compute_queue( device ) );
+        test_assert( A.compute_queue( device ) != A.comm_queue( device ) );
+    }
+
+    C.setMathMode( slate::MathMode::TF32 );
+    for (int device = 0; device < num_devices; ++device) {
+        test_assert( A.comm_queue( device ) == C.comm_queue( device ) );
+        test_assert( A.compute_queue( device ) != C.compute_queue( device ) );
+    }
+}
+
 //==============================================================================
 // Sub-matrices
 
@@ -1703,6 +1867,293 @@ void test_releaseRemoteWorkspace()
     test_assert_all_ranks( A.tileExists( 0, 0 ) == is_rank_0, mpi_comm );
 }
 
+//------------------------------------------------------------------------------
+/// Tests a hierarchical listBcast with node-shared memory: every rank gets
+/// the tile, the other ranks on the root's node read it as a NodeShared
+/// tile, and a rank that writes it gets a private copy, so other ranks
+/// still read the original.
+void test_listBcast_nodeShared()
+{
+    if (mpi_size <= 1) {
+        test_skip("requires mpi_size > 1");
+    }
+
+    slate::Workspace workspace;
+    workspace.enableNodeShared( mpi_comm, sizeof(double) * nb * nb, 4 );
+    auto const& nodes = slate::internal::commNodes( mpi_comm );
+    int shared = workspace.nodeSharedPool() != nullptr, all_shared;
+    MPI_Allreduce( &shared, &all_shared, 1, MPI_INT, MPI_MIN, mpi_comm );
+    if (! all_shared) {
+        test_skip("requires all ranks to share a node with another rank");
+    }
+
+    // Tile (0, 0) is on rank 0; broadcast it to every rank.
+    slate::Matrix<double> A( nb, nb*mpi_size, nb, 1, mpi_size, mpi_comm );
+    A.insertLocalTiles();
+    if (mpi_rank == 0) {
+        auto T = A( 0, 0 );
+        for (int j = 0; j < nb; ++j)
+            for (int i = 0; i < nb; ++i)
+                T.at( i, j ) = i + j*nb;
+    }
+
+    A.attachWorkspace( &workspace );
+    slate::Matrix<double>::BcastList bcast_list = { { 0, 0, { A } } };
+    A.listBcast( bcast_list, slate::Layout::ColMajor, 0, false, 2, true );
+
+    auto T = A( 0, 0 );
+    for (int j = 0; j < nb; ++j)
+        for (int i = 0; i < nb; ++i)
+            test_assert( T( i, j ) == i + j*nb );
+    if (mpi_rank != 0 && nodes[ mpi_rank ] == nodes[ 0 ])
+        test_assert( T.kind() == slate::TileKind::NodeShared );
+
+    // Rank 1 writes its copy.
+    if (mpi_rank == 1) {
+        A.tileGetForWriting( 0, 0, slate::LayoutConvert::ColMajor );
+        A( 0, 0 ).at( 0, 0 ) = -1;
+        test_assert( A( 0, 0 ).kind() == slate::TileKind::Workspace );
+    }
+    MPI_Barrier( mpi_comm );
+    if (mpi_rank != 1)
+        test_assert( A( 0, 0 )( 0, 0 ) == 0 );
+
+    A.releaseRemoteWorkspace();
+    A.detachWorkspace();
+    test_assert_all_ranks( A.tileExists( 0, 0 ) == (mpi_rank == 0), mpi_comm );
+}
+
+//------------------------------------------------------------------------------
+/// Tests listBcast with Option::AggregateBcast, and the two-matrix
+/// listBcastAggregated: broadcasts block column 0 of A, on a p-by-q grid,
+/// and of B, on a q-by-p grid, along each block row of A, so each rank
+/// receives all its tiles from a root in one message. Every rank with a
+/// tile in block row i must then hold tiles (i, 0) of A and B.
+void test_listBcastAggregated()
+{
+    slate::Matrix<double> A( m, n, nb, p, q, mpi_comm );
+    slate::Matrix<double> B( m, n, nb, q, p, mpi_comm );
+    A.insertLocalTiles();
+    B.insertLocalTiles();
+
+    // X(i, j) = sign (i + j m), with i, j global indices.
+    auto entry = [] ( int64_t i, int64_t j, int64_t ii, int64_t jj,
+                      double sign ) {
+        return sign * ((i*nb + ii) + (j*nb + jj) * double( m ));
+    };
+    auto fill = [&entry] ( slate::Matrix<double>& X, double sign ) {
+        for (int64_t j = 0; j < X.nt(); ++j) {
+            for (int64_t i = 0; i < X.mt(); ++i) {
+                if (X.tileIsLocal( i, j )) {
+                    auto T = X( i, j );
+                    for (int64_t jj = 0; jj < T.nb(); ++jj)
+                        for (int64_t ii = 0; ii < T.mb(); ++ii)
+                            T.at( ii, jj ) = entry( i, j, ii, jj, sign );
+                }
+            }
+        }
+    };
+    auto check = [&entry] ( slate::Matrix<double>& X, int64_t i,
+                            double sign ) {
+        test_assert( X.tileExists( i, 0 ) );
+        auto T = X( i, 0 );
+        for (int64_t jj = 0; jj < T.nb(); ++jj)
+            for (int64_t ii = 0; ii < T.mb(); ++ii)
+                test_assert( T( ii, jj ) == entry( i, 0, ii, jj, sign ) );
+    };
+    fill( A, 1.0 );
+    fill( B, -1.0 );
+
+    slate::Matrix<double>::BcastList bcast_list;
+    for (int64_t i = 0; i < A.mt(); ++i)
+        bcast_list.push_back( { i, 0, { A.sub( i, i, 0, A.nt()-1 ) } } );
+
+    // One matrix, through the listBcast option.
+    slate::Options opts = { { slate::Option::AggregateBcast, true } };
+    A.listBcast( bcast_list, slate::Layout::ColMajor, 0, false, opts );
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            if (A.tileIsLocal( i, j )) {
+                check( A, i, 1.0 );
+                break;
+            }
+        }
+    }
+    A.releaseRemoteWorkspace();
+
+    // Two matrices with different distributions, in one message per pair
+    // of ranks.
+    A.listBcastAggregated( bcast_list, B, slate::Layout::ColMajor, 1 );
+    for (int64_t i = 0; i < A.mt(); ++i) {
+        for (int64_t j = 0; j < A.nt(); ++j) {
+            if (A.tileIsLocal( i, j )) {
+                check( A, i, 1.0 );
+                check( B, i, -1.0 );
+                break;
+            }
+        }
+    }
+    A.releaseRemoteWorkspace();
+    B.releaseRemoteWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Tests split-phase listReduceBegin and listReduceEnd against the blocking
+/// listReduce, reducing tiles (i, k) of C across block row i of A, as gemmA
+/// does. Each rank in block row i contributes a tile of (rank + 1).
+/// C_block reduces each block column with listReduce; C_split reduces all
+/// block columns with outstanding split-phase reductions, begun before any
+/// ends, with other work between, and ended in the opposite order.
+/// Both must give the same sums.
+void test_listReduceBegin_End()
+{
+    if (mpi_size <= 1) {
+        test_skip("requires mpi_size > 1");
+    }
+
+    int64_t num_cols = 3;
+    slate::Matrix<double> A( m, q*nb, nb, p, q, mpi_comm );
+    slate::Matrix<double> C_block( m, num_cols*nb, nb, p, q, mpi_comm );
+    auto C_split = C_block.emptyLike();
+
+    // Sets every tile (i, k) this rank contributes to (rank + 1), and
+    // returns the reduce list of each block column.
+    auto setup = [&A, num_cols] ( slate::Matrix<double>& C ) {
+        C.insertLocalTiles();
+        std::vector< slate::Matrix<double>::ReduceList > reduce_lists(
+            num_cols );
+        for (int64_t k = 0; k < num_cols; ++k) {
+            for (int64_t i = 0; i < C.mt(); ++i) {
+                std::set<int> ranks;
+                A.sub( i, i, 0, A.nt()-1 ).getRanks( &ranks );
+                if (ranks.count( mpi_rank ) > 0 || C.tileIsLocal( i, k )) {
+                    if (! C.tileIsLocal( i, k ))
+                        C.tileInsertWorkspace( i, k );
+                    auto T = C( i, k );
+                    for (int64_t jj = 0; jj < T.nb(); ++jj)
+                        for (int64_t ii = 0; ii < T.mb(); ++ii)
+                            T.at( ii, jj ) = mpi_rank + 1;
+                }
+                reduce_lists[ k ].push_back(
+                    { i, k, C.sub( i, i, k, k ),
+                      { A.sub( i, i, 0, A.nt()-1 ) } } );
+            }
+        }
+        return reduce_lists;
+    };
+
+    auto lists_block = setup( C_block );
+    for (int64_t k = 0; k < num_cols; ++k)
+        C_block.listReduce( lists_block[ k ], slate::Layout::ColMajor, k );
+
+    auto lists_split = setup( C_split );
+    std::vector< slate::Matrix<double>::ReduceRequests > requests;
+    for (int64_t k = 0; k < num_cols; ++k) {
+        requests.push_back( C_split.listReduceBegin(
+            lists_split[ k ], slate::Layout::ColMajor, k ) );
+    }
+    MPI_Barrier( mpi_comm );
+    for (int64_t k = num_cols-1; k >= 0; --k) {
+        C_split.listReduceEnd( requests[ k ] );
+        test_assert( requests[ k ].tiles.empty() );
+    }
+
+    for (int64_t k = 0; k < num_cols; ++k) {
+        for (int64_t i = 0; i < C_block.mt(); ++i) {
+            // Non-owners' partial sums are erased.
+            test_assert( C_split.tileExists( i, k )
+                         == C_split.tileIsLocal( i, k ) );
+            if (C_block.tileIsLocal( i, k )) {
+                std::set<int> ranks;
+                A.sub( i, i, 0, A.nt()-1 ).getRanks( &ranks );
+                ranks.insert( C_block.tileRank( i, k ) );
+                double sum = 0;
+                for (int rank : ranks)
+                    sum += rank + 1;
+
+                auto T_block = C_block( i, k );
+                auto T_split = C_split( i, k );
+                for (int64_t jj = 0; jj < T_block.nb(); ++jj) {
+                    for (int64_t ii = 0; ii < T_block.mb(); ++ii) {
+                        test_assert( T_block( ii, jj ) == sum );
+                        test_assert( T_split( ii, jj ) == T_block( ii, jj ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+/// Tests that Workspace::reserve preallocates the blocks a matrix attached
+/// to the arena takes, so inserting workspace tiles doesn't grow its pool,
+/// and that reserving again reuses them.
+void test_Workspace_reserve()
+{
+    const int num_tiles = 3;
+
+    slate::WorkspaceSize size;
+    slate::WorkspaceSize::Pool pool;
+    pool.block_size = sizeof(double) * nb * nb;
+    pool.host_tiles = num_tiles;
+    size.pools.push_back( pool );
+    test_assert( size.hostBytes() >= num_tiles * pool.block_size );
+
+    slate::Workspace workspace;
+    workspace.reserve( size );
+    workspace.reserve( size );
+
+    slate::Matrix<double> A( nb*num_tiles, nb, nb, 1, 1, mpi_comm );
+    test_assert( A.memoryBlockSize() == pool.block_size );
+    A.attachWorkspace( &workspace );
+    for (int i = 0; i < num_tiles; ++i)
+        A.tileInsert( i, 0 );
+
+    slate::MemoryStats stats = A.memoryStats( slate::HostNum );
+    test_assert( stats.growths == 0 );
+    test_assert( stats.fallbacks == 0 );
+
+    A.detachWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Tests that WorkspaceGuard detaches a matrix from the arena when a driver
+/// throws: the matrix's pool is parked in the arena, so the next matrix
+/// attached to it takes the pool and inserts its tiles without growing it.
+void test_WorkspaceGuard_exception()
+{
+    const int num_tiles = 3;
+
+    slate::Workspace workspace;
+    slate::Matrix<double> A( nb*num_tiles, nb, nb, 1, 1, mpi_comm );
+    auto driver = [&A, &workspace]() {
+        slate::WorkspaceGuard<double> workspace_guard( A );
+        A.attachWorkspace( &workspace );
+        for (int i = 0; i < num_tiles; ++i)
+            A.tileInsert( i, 0 );
+        for (int i = 0; i < num_tiles; ++i)
+            A.tileErase( i, 0 );
+        throw std::logic_error( "driver error" );
+    };
+    test_assert_throw( driver(), std::logic_error );
+    test_assert( A.memoryStats( slate::HostNum ).growths > 0 );
+
+    slate::Matrix<double> B( nb*num_tiles, nb, nb, 1, 1, mpi_comm );
+    {
+        slate::WorkspaceGuard<double> workspace_guard( B );
+        B.attachWorkspace( &workspace );
+        for (int i = 0; i < num_tiles; ++i)
+            B.tileInsert( i, 0 );
+
+        slate::MemoryStats stats = B.memoryStats( slate::HostNum );
+        test_assert( stats.growths == 0 );
+        test_assert( stats.fallbacks == 0 );
+
+        for (int i = 0; i < num_tiles; ++i)
+            B.tileErase( i, 0 );
+    }
+}
 
 //==============================================================================
 // tile MOSI & Layout conversion
@@ -1883,6 +2334,193 @@ void test_Matrix_MOSI()
     }
 }
 
+//------------------------------------------------------------------------------
+/// Test transferStats counts a host-device round trip of each local tile.
+void test_Matrix_transferStats()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int lda = roundup(m, nb);
+    std::vector<double> Ad( lda*n );
+
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        m, n, Ad.data(), lda, nb, p, q, mpi_comm );
+    A.transferHeatMap( true );
+
+    int64_t num_local = 0, bytes = 0;
+    for (int j = 0; j < A.nt(); ++j) {
+        for (int i = 0; i < A.mt(); ++i) {
+            if (A.tileIsLocal(i, j)) {
+                num_local += 1;
+                bytes += A.tileMb(i) * A.tileNb(j) * sizeof(double);
+            }
+        }
+    }
+
+    A.reserveDeviceWorkspace();
+
+    // Host to device, invalidating host; then device to host.
+    A.tileGetAllForWritingOnDevices(slate::LayoutConvert::None);
+    A.tileUpdateAllOrigin();
+
+    slate::TransferStats stats = A.transferStats();
+    test_assert(stats.h2d_count == num_local);
+    test_assert(stats.d2h_count == num_local);
+    test_assert(stats.d2d_count == 0);
+    test_assert(stats.h2d_bytes == bytes);
+    test_assert(stats.d2h_bytes == bytes);
+    // Device copy made valid, host made Invalid, host made valid.
+    test_assert(stats.mosi_transitions == 3*num_local);
+    test_assert(stats.layout_conversions == 0);
+
+    auto heat = A.transferHeat();
+    test_assert(int64_t( heat.size() ) == num_local);
+    for (auto const& iter : heat)
+        test_assert(iter.second == 2);
+
+    A.transferStatsReset();
+    test_assert(A.transferStats().h2d_count == 0);
+
+    A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Test eviction past deviceHighWater: Modified device tiles are written back
+/// to the host before being evicted, and tiles handed out by tileGet whose
+/// device work isn't enqueued (pinned) are not evicted.
+void test_Matrix_deviceHighWater()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int64_t nt_ = 4 * p * q;
+    int64_t n_ = nt_ * nb;
+    int lda = n_;
+    std::vector<double> Ad( lda*n_ );
+
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( 1, iseed, Ad.size(), Ad.data() );
+    std::vector<double> Aref( Ad );
+
+    auto A = slate::Matrix<double>::fromLAPACK(
+        n_, n_, Ad.data(), lda, nb, p, q, mpi_comm );
+    int64_t high_water = 2;
+    A.deviceHighWater( high_water );
+
+    int device = 0;
+    std::vector< std::tuple<int64_t, int64_t> > local;
+    for (int64_t j = 0; j < A.nt(); ++j)
+        for (int64_t i = 0; i < A.mt(); ++i)
+            if (A.tileIsLocal( i, j ))
+                local.push_back( { i, j } );
+    test_assert( int64_t( local.size() ) > high_water + 1 );
+
+    // Get each tile for writing on the device, making it the only valid
+    // copy, then clobber the host data, which eviction must write back.
+    // The first tile stays pinned; the rest are released, as after
+    // enqueuing device work on them.
+    for (size_t k = 0; k < local.size(); ++k) {
+        int64_t i = std::get<0>( local[ k ] );
+        int64_t j = std::get<1>( local[ k ] );
+        std::set< std::tuple<int64_t, int64_t> > tile_set = { local[ k ] };
+        A.tileGetForWriting( tile_set, device, slate::LayoutConvert::ColMajor );
+        test_assert( A.tileState( i, j, HostNum ) == slate::MOSI::Invalid );
+
+        auto T = A( i, j, HostNum );
+        for (int64_t jj = 0; jj < T.nb(); ++jj)
+            for (int64_t ii = 0; ii < T.mb(); ++ii)
+                T.at( ii, jj ) = -1.0;
+
+        if (k > 0)
+            A.tileRecordEvent( tile_set, device, nullptr, true );
+    }
+
+    // The pinned tile was least recently used, but is kept;
+    // others were evicted to stay near the high-water mark.
+    test_assert( A.tileExists( std::get<0>( local[ 0 ] ),
+                               std::get<1>( local[ 0 ] ), device ) );
+    int64_t on_device = 0;
+    for (auto ij : local) {
+        if (A.tileExists( std::get<0>( ij ), std::get<1>( ij ), device ))
+            ++on_device;
+    }
+    test_assert( on_device < int64_t( local.size() ) );
+
+    // Evicted tiles were written back; retained ones are copied back.
+    for (auto ij : local) {
+        int64_t i = std::get<0>( ij );
+        int64_t j = std::get<1>( ij );
+        A.tileGetForReading( i, j, HostNum, slate::LayoutConvert::ColMajor );
+        auto T = A( i, j, HostNum );
+        for (int64_t jj = 0; jj < T.nb(); ++jj)
+            for (int64_t ii = 0; ii < T.mb(); ++ii)
+                test_assert( T( ii, jj ) == Aref[ i*nb + ii + (j*nb + jj)*lda ] );
+    }
+
+    A.releaseWorkspace();
+}
+
+//------------------------------------------------------------------------------
+/// Test tileStructure is recorded only if tracking is on, and only for
+/// whole tiles in SLATE memory, and is reset to Dense by writes.
+void test_Matrix_tileStructure()
+{
+    slate::Matrix<double> A( m, n, nb, p, q, mpi_comm );
+    A.insertLocalTiles();
+
+    if (! A.tileIsLocal(0, 0)) {
+        test_skip("requires tile (0, 0) to be local");
+    }
+
+    // Inserted tiles have no known structure.
+    test_assert(A.tileStructure(0, 0) == slate::TileStructure::Dense);
+
+    // Without tracking, which is off by default, nothing is recorded.
+    test_assert(! A.trackTileStructure());
+    A.tileStructure(0, 0, slate::TileStructure::Zero);
+    test_assert(A.tileStructure(0, 0) == slate::TileStructure::Dense);
+
+    A.trackTileStructure( true );
+    test_assert(A.trackTileStructure());
+
+    A.tileStructure(0, 0, slate::TileStructure::Zero);
+    test_assert(A.tileStructure(0, 0) == slate::TileStructure::Zero);
+    test_assert(transpose(A).tileStructure(0, 0)
+                == slate::TileStructure::Zero);
+
+    // A slice of a Zero tile is Zero, but can't make the whole tile Zero.
+    if (A.tileMb(0) > 1 && A.tileNb(0) > 1) {
+        auto A1 = A.slice(1, A.m()-1, 1, A.n()-1);
+        test_assert(A1.tileStructure(0, 0) == slate::TileStructure::Zero);
+
+        A.tileStructure(0, 0, slate::TileStructure::Identity);
+        test_assert(A1.tileStructure(0, 0) == slate::TileStructure::Dense);
+
+        A1.tileStructure(0, 0, slate::TileStructure::Zero);
+        test_assert(A.tileStructure(0, 0) == slate::TileStructure::Dense);
+    }
+
+    // Writing the tile resets its structure.
+    A.tileStructure(0, 0, slate::TileStructure::Zero);
+    A.tileGetForWriting(0, 0, slate::LayoutConvert::None);
+    test_assert(A.tileStructure(0, 0) == slate::TileStructure::Dense);
+
+    // The user can write user memory directly, so it is never recorded.
+    int lda = roundup(m, nb);
+    std::vector<double> Bd( lda*n );
+    auto B = slate::Matrix<double>::fromLAPACK(
+        m, n, Bd.data(), lda, nb, p, q, mpi_comm );
+    B.trackTileStructure( true );
+    B.tileStructure(0, 0, slate::TileStructure::Zero);
+    test_assert(B.tileStructure(0, 0) == slate::TileStructure::Dense);
+}
+
 //------------------------------------------------------------------------------
 /// Test tileLayoutConvert.
 void test_Matrix_tileLayoutConvert()
@@ -2117,7 +2755,9 @@ void run_tests()
     run_test(test_Matrix_fromLAPACK_rect,    "Matrix::fromLAPACK_rect",    mpi_comm);
     run_test(test_Matrix_fromScaLAPACK,      "Matrix::fromScaLAPACK",      mpi_comm);
     run_test(test_Matrix_fromScaLAPACK_rect, "Matrix::fromScaLAPACK_rect", mpi_comm);
+    run_test(test_Matrix_rebind,             "Matrix::rebind",             mpi_comm);
     run_test(test_Matrix_fromDevices,        "Matrix::fromDevices",        mpi_comm);
+    run_test(test_Matrix_uniformGrid,        "Matrix uniform grid lookups", mpi_comm);
 
     if (mpi_rank == 0)
         printf("\nMethods\n");
@@ -2133,9 +2773,14 @@ void run_tests()
     run_test(test_Matrix_tileReduceFromSet,    "Matrix::tileReduceFromSet(i, j, set,...)", mpi_comm);
     run_test(test_Matrix_insertLocalTiles,     "Matrix::insertLocalTiles()",               mpi_comm);
     run_test(test_Matrix_insertLocalTiles_dev, "Matrix::insertLocalTiles(on_devices)",     mpi_comm);
+    run_test(test_Matrix_insertLocalTilesLazy, "Matrix::insertLocalTilesLazy()",           mpi_comm);
     run_test(test_Matrix_allocateBatchArrays,  "Matrix::allocateBatchArrays",              mpi_comm);
+    run_test(test_Matrix_sharedQueues,         "Matrix shared device queues",              mpi_comm);
     run_test(test_Matrix_MOSI,                 "Matrix::tileMOSI",                         mpi_comm);
+    run_test(test_Matrix_transferStats,        "Matrix::transferStats",                    mpi_comm);
     run_test(test_Matrix_tileLayoutConvert,    "Matrix::tileLayoutConvert",                mpi_comm);
+    run_test(test_Matrix_deviceHighWater,      "Matrix::deviceHighWater eviction",         mpi_comm);
+    run_test(test_Matrix_tileStructure,        "Matrix::tileStructure",                    mpi_comm);
 
     if (mpi_rank == 0)
         printf("\nSub-matrices and slices\n");
@@ -2148,6 +2793,11 @@ void run_tests()
         printf("\nCommunication\n");
     run_test(test_tileSend_tileRecv, "tileSend, tileRecv", mpi_comm);
     run_test(test_releaseRemoteWorkspace, "releaseRemoteWorkspace", mpi_comm);
+    run_test(test_listBcast_nodeShared, "listBcast with node-shared memory", mpi_comm);
+    run_test(test_listBcastAggregated, "listBcastAggregated", mpi_comm);
+    run_test(test_listReduceBegin_End, "listReduceBegin, listReduceEnd", mpi_comm);
+    run_test(test_Workspace_reserve, "Workspace::reserve", mpi_comm);
+    run_test(test_WorkspaceGuard_exception, "WorkspaceGuard on exception", mpi_comm);
 }
 
 }  // namespace test
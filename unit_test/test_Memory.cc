@@ -7,6 +7,7 @@
 
 #include "unit_test.hh"
 #include "slate/Exception.hh"
+#include "slate/config.hh"
 
 using std::max;
 using slate::HostNum;
@@ -40,17 +41,16 @@ void test_addHostBlocks()
 
     const int cnt = 5;
     mem.addHostBlocks(cnt);
-    // Memory class no longer reserves CPU blocks, it allocates on-the-fly.
-    //test_assert( int( mem.available( HostNum ) ) == cnt );
-    //test_assert( int( mem.capacity(  HostNum ) ) == cnt );
-    test_assert( int( mem.available( HostNum ) ) == 0 );
-    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
 
     // Devices still 0.
     for (int dev = 0; dev < mem.num_devices_; ++dev) {
         test_assert(int(mem.available(dev)) == 0);
         test_assert(int(mem.capacity (dev)) == 0);
     }
+
+    mem.clearHostBlocks();
 }
 
 //------------------------------------------------------------------------------
@@ -108,11 +108,8 @@ void test_alloc_host()
     for (int i = 0; i < 2*cnt; ++i) {
         hx[i] = (double*) mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr );
         test_assert(hx[i] != nullptr);
-        // Memory class no longer reserves CPU blocks, it allocates on-the-fly.
-        //test_assert( int( mem.available( HostNum ) ) == max( cnt-(i+1), 0 ) );
-        //test_assert( int( mem.capacity(  HostNum ) ) == max( cnt, i+1 ) );
-        test_assert( int( mem.available( HostNum ) ) == 0 );
-        test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+        test_assert( int( mem.available( HostNum ) ) == max( cnt-(i+1), 0 ) );
+        test_assert( int( mem.capacity(  HostNum ) ) == max( cnt, i+1 ) );
 
         // Touch memory to verify it is valid.
         for (int j = 0; j < nb*nb; ++j) {
@@ -125,21 +122,322 @@ void test_alloc_host()
     for (int i = 0; i < some; ++i) {
         mem.free( hx[i], HostNum );
         hx[i] = nullptr;
-        //test_assert( int( mem.available( HostNum ) ) == i+1 );
-        //test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
-        test_assert( int( mem.available( HostNum ) ) == 0 );
-        test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+        test_assert( int( mem.available( HostNum ) ) == i+1 );
+        test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
     }
 
     // Re-alloc some.
     for (int i = 0; i < some; ++i) {
         hx[i] = (double*) mem.alloc( HostNum, sizeof(double) * nb * nb, nullptr);
         test_assert(hx[i] != nullptr);
-        //test_assert( int( mem.available( HostNum ) ) == some - ( i+1 ) );
-        //test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
-        test_assert( int( mem.available( HostNum ) ) == 0 );
-        test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+        test_assert( int( mem.available( HostNum ) ) == some - ( i+1 ) );
+        test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
+    }
+
+    mem.clearHostBlocks();
+    test_assert( int( mem.available( HostNum ) ) == 0 );
+    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests allocating and freeing blocks larger than the block size,
+/// which come from size classes.
+void test_alloc_size_classes()
+{
+    slate::Memory mem(sizeof(double) * nb * nb);
+
+    test_assert( mem.sizeClass( 1 ) == 0 );
+    test_assert( mem.sizeClass( sizeof(double) * nb * nb ) == 0 );
+    test_assert( mem.sizeClass( sizeof(double) * nb * nb + 1 ) == 1 );
+    test_assert( mem.sizeClass( sizeof(double) * 3 * nb * nb ) == 2 );
+    test_assert( mem.sizeClass( sizeof(double) * 4 * nb * nb ) == 2 );
+
+    // 2x and 3x block size, i.e., classes 1 and 2
+    size_t size1 = sizeof(double) * 2 * nb * nb;
+    size_t size2 = sizeof(double) * 3 * nb * nb;
+    double* hx1 = (double*) mem.alloc( HostNum, size1, nullptr );
+    double* hx2 = (double*) mem.alloc( HostNum, size2, nullptr );
+    test_assert( hx1 != nullptr );
+    test_assert( hx2 != nullptr );
+    test_assert( mem.numSizeClasses( HostNum ) == 3 );
+    test_assert( int( mem.capacity(  HostNum, 1 ) ) == 1 );
+    test_assert( int( mem.capacity(  HostNum, 2 ) ) == 1 );
+    test_assert( int( mem.available( HostNum, 2 ) ) == 0 );
+    test_assert( int( mem.allocated( HostNum ) ) == 2 );
+
+    // Default class is not affected.
+    test_assert( int( mem.capacity( HostNum ) ) == 0 );
+
+    // Touch memory to verify it is valid.
+    for (int j = 0; j < 3*nb*nb; ++j) {
+        hx2[j] = j;
+    }
+
+    // Freed blocks go back to their class and are reused.
+    mem.free( hx2, HostNum );
+    test_assert( int( mem.available( HostNum, 2 ) ) == 1 );
+    test_assert( int( mem.allocated( HostNum ) ) == 1 );
+
+    double* hx3 = (double*) mem.alloc( HostNum, sizeof(double) * 4 * nb * nb,
+                                       nullptr );
+    test_assert( hx3 == hx2 );
+    test_assert( int( mem.capacity(  HostNum, 2 ) ) == 1 );
+    test_assert( int( mem.available( HostNum, 2 ) ) == 0 );
+
+    mem.free( hx1, HostNum );
+    mem.free( hx3, HostNum );
+    test_assert( int( mem.allocated( HostNum ) ) == 0 );
+
+    mem.clearHostBlocks();
+    test_assert( mem.numSizeClasses( HostNum ) == 1 );
+    test_assert( int( mem.capacity( HostNum, 2 ) ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests usage counters: in use, peaks, growths, and fallback allocations.
+void test_stats_host()
+{
+    slate::Memory mem(sizeof(double) * nb * nb);
+    int64_t block = sizeof(double) * nb * nb;
+
+    slate::MemoryStats total0 = slate::Memory::totalStats( HostNum );
+
+    // Reserved blocks count as pooled, not in use.
+    mem.addHostBlocks( 2 );
+    slate::MemoryStats stats = mem.stats( HostNum );
+    test_assert( stats.pooled == 2*block );
+    test_assert( stats.in_use == 0 );
+    test_assert( stats.growths == 1 );
+
+    // 2 blocks from the pool, then 1 fallback allocation.
+    void* b1 = mem.alloc( HostNum, block, nullptr );
+    void* b2 = mem.alloc( HostNum, block, nullptr );
+    void* b3 = mem.alloc( HostNum, block, nullptr );
+    stats = mem.stats( HostNum );
+    test_assert( stats.in_use == 3*block );
+    test_assert( stats.peak_in_use == 3*block );
+    test_assert( stats.pooled == 3*block );
+    test_assert( stats.allocs == 3 );
+    test_assert( stats.fallbacks == 1 );
+
+    slate::MemoryStats total = slate::Memory::totalStats( HostNum );
+    test_assert( total.in_use - total0.in_use == 3*block );
+    test_assert( total.fallbacks - total0.fallbacks == 1 );
+
+    // Peak stays after free, until reset.
+    mem.free( b1, HostNum );
+    mem.free( b2, HostNum );
+    stats = mem.stats( HostNum );
+    test_assert( stats.in_use == block );
+    test_assert( stats.peak_in_use == 3*block );
+    test_assert( stats.frees == 2 );
+
+    mem.resetPeak( HostNum );
+    test_assert( mem.stats( HostNum ).peak_in_use == block );
+
+    mem.free( b3, HostNum );
+    mem.clearHostBlocks();
+    stats = mem.stats( HostNum );
+    test_assert( stats.in_use == 0 );
+    test_assert( stats.pooled == 0 );
+    test_assert( stats.peak_pooled == 3*block );
+
+    total = slate::Memory::totalStats( HostNum );
+    test_assert( total.in_use == total0.in_use );
+    test_assert( total.pooled == total0.pooled );
+}
+
+//------------------------------------------------------------------------------
+/// Tests allocating and freeing blocks from size classes on devices.
+void test_alloc_size_classes_device()
+{
+    slate::Memory mem(sizeof(double) * nb * nb);
+    if (mem.num_devices_ == 0) {
+        test_skip("no GPU devices available");
+    }
+
+    for (int dev = 0; dev < mem.num_devices_; ++dev) {
+        blas::Queue queue( dev );
+
+        // Varying sizes; after warm up, no new allocations.
+        const int cnt = 3;
+        void* dx[ cnt ];
+        for (int iter = 0; iter < 2; ++iter) {
+            for (int i = 0; i < cnt; ++i) {
+                size_t size = sizeof(double) * (i + 1) * nb * nb;
+                dx[i] = mem.alloc( dev, size, &queue );
+                test_assert( dx[i] != nullptr );
+            }
+            for (int i = 0; i < cnt; ++i) {
+                mem.free( dx[i], dev );
+            }
+            // classes 0, 1, 2 each have one block
+            test_assert( int( mem.capacity( dev, 0 ) ) == 1 );
+            test_assert( int( mem.capacity( dev, 1 ) ) == 1 );
+            test_assert( int( mem.capacity( dev, 2 ) ) == 1 );
+            test_assert( int( mem.allocated( dev ) ) == 0 );
+        }
+        mem.clearDeviceBlocks( dev, &queue );
+        test_assert( mem.numSizeClasses( dev ) == 1 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests moving host blocks, including size classes, between pools,
+/// as done by a Workspace arena.
+void test_moveBlocks_host()
+{
+    slate::Memory mem(sizeof(double) * nb * nb);
+    slate::Memory mem2(sizeof(double) * nb * nb);
+
+    mem.addHostBlocks(5);
+    double* hx = (double*) mem.alloc( HostNum, sizeof(double) * 2 * nb * nb,
+                                      nullptr );
+    mem.free( hx, HostNum );
+    test_assert( int( mem.allocated( HostNum ) ) == 0 );
+
+    mem2.moveBlocks( mem, HostNum );
+    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.available( HostNum ) ) == 0 );
+    test_assert( mem.numSizeClasses( HostNum ) == 1 );
+    test_assert( int( mem2.capacity(  HostNum ) ) == 5 );
+    test_assert( int( mem2.available( HostNum ) ) == 5 );
+    test_assert( int( mem2.capacity(  HostNum, 1 ) ) == 1 );
+
+    // Moved blocks are reused, without new allocations.
+    double* hx2 = (double*) mem2.alloc( HostNum, sizeof(double) * 2 * nb * nb,
+                                        nullptr );
+    test_assert( hx2 == hx );
+    test_assert( int( mem2.capacity( HostNum, 1 ) ) == 1 );
+    mem2.free( hx2, HostNum );
+
+    mem.clearHostBlocks();
+    mem2.clearHostBlocks();
+    test_assert( int( mem2.capacity( HostNum ) ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests the process-wide shared pools, and releasing blocks only if unused.
+void test_shared_host()
+{
+    size_t block_size = sizeof(double) * nb * nb;
+    slate::Memory& mem = slate::Memory::shared( block_size );
+    test_assert( &mem == &slate::Memory::shared( block_size ) );
+    test_assert( &mem != &slate::Memory::shared( 2*block_size ) );
+
+    // Blocks freed by one user are reused by another.
+    double* hx = (double*) mem.alloc( HostNum, block_size, nullptr );
+    mem.free( hx, HostNum );
+    double* hx2 = (double*) mem.alloc( HostNum, block_size, nullptr );
+    test_assert( hx2 == hx );
+    test_assert( int( mem.capacity( HostNum ) ) == 1 );
+
+    // Not released while a block is in use.
+    test_assert( ! mem.releaseHostBlocks() );
+    test_assert( int( mem.capacity( HostNum ) ) == 1 );
+
+    mem.free( hx2, HostNum );
+    test_assert( mem.releaseHostBlocks() );
+    test_assert( int( mem.capacity( HostNum ) ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests per-NUMA-node stats of host blocks placed on a NUMA node.
+void test_alloc_host_numa()
+{
+    size_t block_size = sizeof(double) * nb * nb;
+    slate::Memory mem( block_size );
+    int num_nodes = slate::Memory::num_numa_nodes_;
+    test_assert( num_nodes >= 1 );
+
+    // Without a NUMA node, blocks are not counted.
+    double* hx = (double*) mem.alloc( HostNum, block_size, nullptr );
+    for (int node = 0; node < num_nodes; ++node)
+        test_assert( mem.numaAllocated( node ) == 0 );
+
+    // Placement is ignored with only one NUMA node.
+    int node = num_nodes - 1;
+    double* hy = (double*) mem.alloc( HostNum, block_size, nullptr, node );
+    hy[ 0 ] = 1.0;  // touch
+    int expect = (num_nodes > 1 ? 1 : 0);
+    test_assert( mem.numaAllocated( node ) == expect );
+    test_assert( mem.numaCapacity( node ) == expect );
+
+    mem.free( hy, HostNum );
+    test_assert( mem.numaAllocated( node ) == 0 );
+    test_assert( mem.numaCapacity( node ) == expect );
+
+    mem.free( hx, HostNum );
+    mem.clearHostBlocks();
+    test_assert( mem.numaCapacity( node ) == 0 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests that host blocks of at least 2 MiB are 2 MiB aligned
+/// with huge pages.
+void test_alloc_host_huge_pages()
+{
+    bool huge_pages = slate::host_huge_pages();
+    slate::host_huge_pages( true );
+
+    size_t huge_page_size = 2*1024*1024;
+    slate::Memory mem( huge_page_size + 8 );
+    void* hx = mem.alloc( HostNum, huge_page_size + 8, nullptr );
+    test_assert( uintptr_t( hx ) % huge_page_size == 0 );
+    mem.free( hx, HostNum );
+    mem.clearHostBlocks();
+
+    slate::host_huge_pages( huge_pages );
+}
+
+//------------------------------------------------------------------------------
+/// Tests allocating and freeing pinned host blocks.
+void test_alloc_host_pinned()
+{
+    slate::Memory mem(sizeof(double) * nb * nb);
+    if (mem.num_devices_ == 0) {
+        test_skip("no GPU devices available");
     }
+
+    blas::Queue queue( 0 );
+
+    const int cnt = 4;
+    mem.addHostBlocks( cnt, &queue );
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
+
+    double* dx = blas::device_malloc<double>( nb*nb, queue );
+    double* hx[ 2*cnt ];
+    for (int i = 0; i < 2*cnt; ++i) {
+        hx[i] = (double*) mem.alloc( HostNum, sizeof(double) * nb * nb, &queue );
+        test_assert( hx[i] != nullptr );
+        test_assert( int( mem.available( HostNum ) ) == max( cnt-(i+1), 0 ) );
+        test_assert( int( mem.capacity(  HostNum ) ) == max( cnt, i+1 ) );
+
+        // Round trip through the device to verify memory is valid.
+        for (int j = 0; j < nb*nb; ++j) {
+            hx[i][j] = i*1000000 + j;
+        }
+        blas::device_memcpy<double>( dx, hx[i], nb*nb,
+                                     blas::MemcpyKind::HostToDevice, queue );
+        queue.sync();
+        for (int j = 0; j < nb*nb; ++j) {
+            hx[i][j] = 0;
+        }
+        blas::device_memcpy<double>( hx[i], dx, nb*nb,
+                                     blas::MemcpyKind::DeviceToHost, queue );
+        queue.sync();
+        test_assert( hx[i][ nb*nb-1 ] == i*1000000 + nb*nb-1 );
+    }
+
+    for (int i = 0; i < 2*cnt; ++i) {
+        mem.free( hx[i], HostNum );
+    }
+    test_assert( int( mem.available( HostNum ) ) == 2*cnt );
+
+    blas::device_free( dx, queue );
+    mem.clearHostBlocks( &queue );
+    test_assert( int( mem.capacity( HostNum ) ) == 0 );
 }
 
 //------------------------------------------------------------------------------
@@ -217,10 +515,8 @@ void test_clearHostBlocks()
 
     const int cnt = 5;
     mem.addHostBlocks(cnt);
-    //test_assert( int( mem.available( HostNum ) ) == cnt );
-    //test_assert( int( mem.capacity(  HostNum ) ) == cnt );
-    test_assert( int( mem.available( HostNum ) ) == 0 );
-    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.available( HostNum ) ) == cnt );
+    test_assert( int( mem.capacity(  HostNum ) ) == cnt );
 
     // Allocate 2*cnt blocks.
     for (int i = 0; i < 2*cnt; ++i) {
@@ -228,8 +524,7 @@ void test_clearHostBlocks()
     }
 
     test_assert( int( mem.available( HostNum ) ) == 0 );
-    //test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
-    test_assert( int( mem.capacity(  HostNum ) ) == 0 );
+    test_assert( int( mem.capacity(  HostNum ) ) == 2*cnt );
 
     mem.clearHostBlocks();
 
@@ -291,6 +586,14 @@ void run_tests()
     run_test(test_addHostBlocks,     "addHostBlocks");
     run_test(test_addDeviceBlocks,   "addDeviceBlocks");
     run_test(test_alloc_host,        "alloc and free (alloc_host)");
+    run_test(test_alloc_host_pinned, "alloc and free (alloc_host_pinned)");
+    run_test(test_alloc_host_numa,   "alloc and free (NUMA nodes)");
+    run_test(test_alloc_host_huge_pages, "alloc and free (huge pages)");
+    run_test(test_alloc_size_classes, "alloc and free (size classes)");
+    run_test(test_alloc_size_classes_device, "alloc and free (size classes, device)");
+    run_test(test_stats_host,        "stats (host)");
+    run_test(test_moveBlocks_host,   "moveBlocks (host)");
+    run_test(test_shared_host,       "shared and releaseHostBlocks (host)");
     run_test(test_alloc_device,      "alloc and free (alloc_device)");
     run_test(test_clearHostBlocks,   "clearHostBlocks");
     run_test(test_clearDeviceBlocks, "clearDeviceBlocks");
@@ -8,8 +8,12 @@
 
 #include "slate/internal/openmp.hh"
 #include "slate/internal/OmpSetMaxActiveLevels.hh"
+#include "slate/config.hh"
 #include "unit_test.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <unistd.h>
 
 namespace test {
@@ -92,11 +96,65 @@ void test_OmpSetMaxActiveLevels()
     test_assert( info == 0 );
 }
 
+//------------------------------------------------------------------------------
+/// Tests objects on concurrent application threads: the level stays raised
+/// until the last one is destroyed, and with shared_threads(), calls split
+/// the threads.
+void test_OmpSetMaxActiveLevels_concurrent()
+{
+    int orig_levels = 1;
+    omp_set_max_active_levels( orig_levels );
+    slate::shared_threads( true );
+
+    // Threads created by std::thread start with the default nthreads-var.
+    int max_threads = 0;
+    std::thread query( [&max_threads] {
+        max_threads = omp_get_max_threads();
+    });
+    query.join();
+
+    // Errors are saved, since a thread throwing an exception causes an abort.
+    std::atomic<int> info( 0 );
+    std::atomic<int> entered( 0 );
+    std::atomic<int> exited( 0 );
+    int shares[ 2 ];
+    auto call = [&] {
+        slate::OmpSetMaxActiveLevels set_active_levels( 2 );
+        int order = entered.fetch_add( 1 );
+        shares[ order ] = omp_get_max_threads();
+
+        // Wait for both calls to start, then finish one at a time.
+        while (entered.load() < 2)
+            std::this_thread::yield();
+        while (exited.load() < order)
+            std::this_thread::yield();
+
+        if (omp_get_max_active_levels() != 2)
+            info = __LINE__;
+        exited.fetch_add( 1 );
+    };
+    std::thread thread1( call );
+    std::thread thread2( call );
+    thread1.join();
+    thread2.join();
+
+    slate::shared_threads( false );
+    test_assert( info == 0 );
+
+    // The call that started first got all threads, the other half.
+    test_assert( std::max( shares[ 0 ], shares[ 1 ] ) == max_threads );
+    test_assert( std::min( shares[ 0 ], shares[ 1 ] )
+                 == std::max( 1, max_threads / 2 ) );
+    test_assert( omp_get_max_active_levels() == orig_levels );
+}
+
 //------------------------------------------------------------------------------
 /// Runs all tests. Called by unit test main().
 void run_tests()
 {
     run_test( test_OmpSetMaxActiveLevels, "OmpSetMaxActiveLevels()" );
+    run_test( test_OmpSetMaxActiveLevels_concurrent,
+              "OmpSetMaxActiveLevels() concurrent" );
 }
 
 }  // namespace test
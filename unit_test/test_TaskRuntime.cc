@@ -0,0 +1,223 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/TaskRuntime.hh"
+#include "slate/internal/openmp.hh"
+
+#include "unit_test.hh"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using slate::TaskBackend;
+using slate::internal::TaskRuntime;
+
+namespace test {
+
+const TaskBackend backends[] = { TaskBackend::OpenMP, TaskBackend::Stealing };
+
+//------------------------------------------------------------------------------
+/// Tests that tasks run after the tasks they depend on: a chain of writers,
+/// readers that overlap each other but not the writers around them, and
+/// tasks with several in and inout addresses.
+void test_dependencies()
+{
+    for (TaskBackend backend : backends) {
+        std::vector<int> order;
+        int value = 0;
+        int a = 0, b = 0, c = 0, d = 0;
+        std::atomic<int> readers { 0 };
+        std::atomic<bool> okay { true };
+        int n = 20;
+
+        #pragma omp parallel
+        #pragma omp master
+        {
+            TaskRuntime rt( backend );
+
+            // Writers of the same address run in spawn order.
+            // order needs no lock, since the writers don't overlap.
+            for (int i = 0; i < n; ++i) {
+                rt.spawn( {}, { &order }, 0, [i, &order]() {
+                    usleep( 100 );
+                    order.push_back( i );
+                });
+            }
+
+            // Readers see the first write, and run before the second.
+            rt.spawn( {}, { &value }, 0, [&value]() {
+                usleep( 1000 );
+                value = 1;
+            });
+            for (int i = 0; i < 8; ++i) {
+                rt.spawn( { &value }, {}, 0, [&]() {
+                    usleep( 100 );
+                    if (value != 1)
+                        okay = false;
+                    ++readers;
+                });
+            }
+            rt.spawn( {}, { &value }, 0, [&]() {
+                if (readers != 8)
+                    okay = false;
+                value = 2;
+            });
+
+            // Several addresses: d = (a + b) + c, with c, d written by
+            // one task.
+            rt.spawn( {}, { &a }, 0, [&a]() { usleep( 500 ); a = 1; } );
+            rt.spawn( {}, { &b }, 0, [&b]() { usleep( 500 ); b = 2; } );
+            rt.spawn( { &a, &b }, { &c, &d }, 0, [&]() {
+                c = a + b;
+                d = c;
+            });
+            rt.spawn( { &a, &b, &c }, { &d }, 0, [&]() {
+                d += c;
+            });
+
+            rt.wait();
+        }
+
+        test_assert( okay );
+        test_assert( value == 2 );
+        test_assert( readers == 8 );
+        test_assert( c == 3 );
+        test_assert( d == 6 );
+        test_assert( int( order.size() ) == n );
+        for (int i = 0; i < n; ++i)
+            test_assert( order[ i ] == i );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests priorities. With one thread, TaskBackend::Stealing runs ready
+/// tasks in wait(), highest priority first. OpenMP priorities are only
+/// hints, so for TaskBackend::OpenMP this checks just that all tasks ran.
+void test_priorities()
+{
+    for (TaskBackend backend : backends) {
+        std::vector<int> order;
+        int n = 16;
+
+        #pragma omp parallel num_threads( 1 )
+        #pragma omp master
+        {
+            TaskRuntime rt( backend );
+            for (int i = 0; i < n; ++i) {
+                int priority = i % 4;
+                rt.spawn( {}, {}, priority, [priority, &order]() {
+                    order.push_back( priority );
+                });
+            }
+            rt.wait();
+        }
+
+        test_assert( int( order.size() ) == n );
+        if (backend == TaskBackend::Stealing) {
+            for (int i = 1; i < n; ++i)
+                test_assert( order[ i-1 ] >= order[ i ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests that wait() rethrows an exception thrown by a task, after the
+/// other tasks, including its successors, have run. An exception that
+/// leaves an OpenMP task terminates the program, so this checks only
+/// TaskBackend::Stealing.
+void test_exception()
+{
+    std::atomic<int> count { 0 };
+    bool caught = false;
+    bool caught_again = false;
+    int x = 0;
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        TaskRuntime rt( TaskBackend::Stealing );
+        rt.spawn( {}, { &x }, 0, [&count]() {
+            ++count;
+            throw std::runtime_error( "task error" );
+        });
+        for (int i = 0; i < 8; ++i) {
+            rt.spawn( { &x }, {}, 0, [&count]() { ++count; } );
+        }
+        try {
+            rt.wait();
+        }
+        catch (std::runtime_error const&) {
+            caught = true;
+        }
+
+        // The exception is rethrown once.
+        rt.spawn( {}, { &x }, 0, [&count]() { ++count; } );
+        try {
+            rt.wait();
+        }
+        catch (...) {
+            caught_again = true;
+        }
+    }
+
+    test_assert( caught );
+    test_assert( ! caught_again );
+    test_assert( count == 10 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests that with TaskBackend::Stealing, other threads of the team take
+/// tasks spawned by the master thread.
+void test_stealing()
+{
+    if (omp_get_max_threads() < 2)
+        test_skip( "requires at least 2 OpenMP threads" );
+
+    std::mutex mutex;
+    std::set<int> threads;
+    std::atomic<int> count { 0 };
+    int n = 64;
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        TaskRuntime rt( TaskBackend::Stealing );
+        for (int i = 0; i < n; ++i) {
+            rt.spawn( {}, {}, 0, [&]() {
+                usleep( 500 );
+                ++count;
+                std::lock_guard< std::mutex > guard( mutex );
+                threads.insert( omp_get_thread_num() );
+            });
+        }
+        rt.wait();
+    }
+
+    test_assert( count == n );
+    test_assert( threads.size() > 1 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_dependencies, "TaskRuntime dependencies");
+    run_test(test_priorities,   "TaskRuntime priorities");
+    run_test(test_exception,    "TaskRuntime exception");
+    run_test(test_stealing,     "TaskRuntime stealing");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return unit_test_main();  // which calls run_tests()
+}
@@ -585,6 +585,120 @@ void test_send_recv_ss()
     test_send_recv(32, 32);
 }
 
+//------------------------------------------------------------------------------
+/// Tests isendChunk() and irecvChunk() between MPI ranks, sending the
+/// tile in uneven chunks of columns, as pipelined broadcasts do.
+/// src/dst lda is rounded up to multiple of align_src/dst, respectively.
+void test_send_recv_chunk(int align_src, int align_dst)
+{
+    if (mpi_size == 1) {
+        test_skip("requires MPI comm size > 1");
+    }
+
+    const int m = 20;
+    const int n = 30;
+    const int chunk = 7;
+    // even is src, odd is dst
+    int lda = roundup(m, (mpi_rank % 2 == 0 ? align_src : align_dst));
+    double* data = new double[ lda * n ];
+    assert(data != nullptr);
+    slate::Tile<double> A(m, n, data, lda, -1, slate::TileKind::UserOwned);
+    setup_data(A);
+
+    int r = int(mpi_rank / 2) * 2;
+    if (r+1 < mpi_size) {
+        std::vector<MPI_Request> requests;
+        for (int first = 0; first < n; first += chunk) {
+            int count = std::min( chunk, n - first );
+            MPI_Request request;
+            if (r == mpi_rank)
+                A.isendChunk(first, count, r+1, MPI_COMM_WORLD, 0, &request);
+            else
+                A.irecvChunk(first, count, r, MPI_COMM_WORLD, 0, &request);
+            requests.push_back( request );
+        }
+        MPI_Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE );
+        verify_data(A, r);
+    }
+    else {
+        verify_data(A, mpi_rank);
+    }
+
+    delete[] data;
+}
+
+// contiguous => strided
+void test_send_recv_chunk_cs()
+{
+    test_send_recv_chunk(1, 32);
+}
+
+// strided => contiguous
+void test_send_recv_chunk_sc()
+{
+    test_send_recv_chunk(32, 1);
+}
+
+//------------------------------------------------------------------------------
+/// Tests isend() and irecv() with a CommPlan: the second epoch reuses the
+/// persistent request recorded by the first.
+/// src/dst lda is rounded up to multiple of align_src/dst, respectively.
+void test_send_recv_plan(int align_src, int align_dst)
+{
+    if (mpi_size == 1) {
+        test_skip("requires MPI comm size > 1");
+    }
+
+    const int m = 20;
+    const int n = 30;
+    // even is src, odd is dst
+    int lda = roundup(m, (mpi_rank % 2 == 0 ? align_src : align_dst));
+    double* data = new double[ lda * n ];
+    assert(data != nullptr);
+    slate::Tile<double> A(m, n, data, lda, -1, slate::TileKind::UserOwned);
+
+    slate::CommPlan plan;
+    int r = int(mpi_rank / 2) * 2;
+    size_t num_requests = 0;
+    for (int epoch = 0; epoch < 2; ++epoch) {
+        plan.nextEpoch();
+        setup_data(A);
+        if (r+1 < mpi_size) {
+            MPI_Request request;
+            if (r == mpi_rank)
+                A.isend(r+1, MPI_COMM_WORLD, 0, &request, &plan);
+            else
+                A.irecv(r, MPI_COMM_WORLD, A.layout(), 0, &request, &plan);
+            MPI_Wait( &request, MPI_STATUS_IGNORE );
+            verify_data(A, r);
+
+            if (epoch == 0)
+                num_requests = plan.numRequests();
+            test_assert( num_requests == 1 );
+            test_assert( plan.numRequests() == num_requests );
+        }
+        else {
+            verify_data(A, mpi_rank);
+        }
+    }
+    plan.clear();
+    test_assert( plan.numRequests() == 0 );
+
+    delete[] data;
+}
+
+// contiguous => strided
+void test_send_recv_plan_cs()
+{
+    test_send_recv_plan(1, 32);
+}
+
+// strided => contiguous
+void test_send_recv_plan_sc()
+{
+    test_send_recv_plan(32, 1);
+}
+
 //------------------------------------------------------------------------------
 /// Tests bcast() between MPI ranks.
 /// src/dst lda is rounded up to multiple of align_src/dst, respectively.
@@ -832,6 +946,18 @@ void run_tests()
     run_test(
         test_send_recv_ss,
         "send and recv, strided => strided",       MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_chunk_cs,
+        "send and recv chunks, contiguous => strided", MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_chunk_sc,
+        "send and recv chunks, strided => contiguous", MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_plan_cs,
+        "send and recv with plan, contiguous => strided", MPI_COMM_WORLD);
+    run_test(
+        test_send_recv_plan_sc,
+        "send and recv with plan, strided => contiguous", MPI_COMM_WORLD);
     run_test(
         test_bcast_cc,
         "bcast, contiguous => contiguous",         MPI_COMM_WORLD);
@@ -0,0 +1,161 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/MatrixStorage.hh"
+
+#include "unit_test.hh"
+
+#include <set>
+
+using slate::GridOrder;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+/// Minimal node type for the directory.
+struct Node {
+    Node(int64_t v) : value(v) {}
+    int64_t value;
+};
+
+using Directory = slate::TileDirectory<Node>;
+using ij_tuple  = Directory::ij_tuple;
+
+//------------------------------------------------------------------------------
+/// Tests which tiles are dense for each rank of a 2x3 grid.
+void test_isDense()
+{
+    int64_t mt = 7, nt = 8;
+    int p = 2, q = 3;
+    for (GridOrder order : { GridOrder::Col, GridOrder::Row }) {
+        auto rank_func = slate::func::process_2d_grid( order, p, q );
+        for (int rank = 0; rank < p*q; ++rank) {
+            Directory dir;
+            dir.initDense( mt, nt, order, p, q, rank );
+            for (int64_t i = 0; i < mt; ++i) {
+                for (int64_t j = 0; j < nt; ++j) {
+                    test_assert( dir.isDense( {i, j} )
+                                 == (rank_func( {i, j} ) == rank) );
+                }
+            }
+            // outside the matrix goes to the map
+            test_assert( ! dir.isDense( {mt, 0} ) );
+            test_assert( ! dir.isDense( {-1, 0} ) );
+        }
+    }
+
+    // rank outside grid has no dense tiles
+    Directory dir;
+    dir.initDense( mt, nt, GridOrder::Col, p, q, p*q );
+    test_assert( ! dir.isDense( {0, 0} ) );
+}
+
+//------------------------------------------------------------------------------
+/// Tests insert, find, at, erase, and iteration over dense and map parts.
+void test_insert_erase()
+{
+    int64_t mt = 5, nt = 4;
+    Directory dir;
+    dir.initDense( mt, nt, GridOrder::Col, 2, 2, 0 );
+
+    // insert all tiles; local ones are dense, others in the map
+    for (int64_t i = 0; i < mt; ++i) {
+        for (int64_t j = 0; j < nt; ++j) {
+            dir.insert( {i, j}, std::make_shared<Node>( i*100 + j ) );
+        }
+    }
+    test_assert( int( dir.size() ) == mt*nt );
+
+    for (int64_t i = 0; i < mt; ++i) {
+        for (int64_t j = 0; j < nt; ++j) {
+            test_assert( dir.at( {i, j} ).value == i*100 + j );
+            auto iter = dir.find( {i, j} );
+            test_assert( iter != dir.end() );
+            test_assert( iter->first == ij_tuple( i, j ) );
+            test_assert( iter->second->value == i*100 + j );
+        }
+    }
+    test_assert( dir.find( {mt, nt} ) == dir.end() );
+    test_assert( dir.get( {mt, nt} ) == nullptr );
+
+    // iteration visits each tile once
+    std::set<ij_tuple> visited;
+    for (auto iter = dir.begin(); iter != dir.end(); ++iter) {
+        test_assert( visited.count( iter->first ) == 0 );
+        visited.insert( iter->first );
+    }
+    test_assert( int( visited.size() ) == mt*nt );
+
+    // erase while iterating, as MatrixStorage::clear does
+    for (auto iter = dir.begin(); iter != dir.end(); /* incremented below */) {
+        int64_t i = std::get<0>( iter->first );
+        if (i % 2 == 0)
+            dir.erase( (iter++)->first );
+        else
+            ++iter;
+    }
+    for (int64_t i = 0; i < mt; ++i) {
+        for (int64_t j = 0; j < nt; ++j) {
+            test_assert( (dir.get( {i, j} ) == nullptr) == (i % 2 == 0) );
+        }
+    }
+    test_assert( int( dir.size() ) == (mt/2)*nt );
+
+    test_assert( dir.erase( {0, 0} ) == 0 );
+    for (auto iter = dir.begin(); iter != dir.end(); /* incremented below */) {
+        dir.erase( (iter++)->first );
+    }
+    test_assert( dir.size() == 0 );
+    test_assert( dir.begin() == dir.end() );
+
+    try {
+        dir.at( {1, 1} );
+        test_assert( false );
+    }
+    catch (std::out_of_range const& ex) {
+        // expected
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests concurrent lookups of dense tiles.
+void test_concurrent()
+{
+    int64_t mt = 64, nt = 64;
+    Directory dir;
+    dir.initDense( mt, nt, GridOrder::Col, 1, 1, 0 );
+    for (int64_t i = 0; i < mt; ++i) {
+        for (int64_t j = 0; j < nt; ++j) {
+            dir.insert( {i, j}, std::make_shared<Node>( i + j*mt ) );
+        }
+    }
+
+    int64_t sum = 0;
+    #pragma omp parallel for collapse(2) reduction(+:sum)
+    for (int64_t i = 0; i < mt; ++i) {
+        for (int64_t j = 0; j < nt; ++j) {
+            sum += dir.at( {i, j} ).value;
+        }
+    }
+    int64_t n = mt*nt;
+    test_assert( sum == n*(n - 1)/2 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_isDense,      "TileDirectory isDense");
+    run_test(test_insert_erase, "TileDirectory insert, find, erase");
+    run_test(test_concurrent,   "TileDirectory concurrent lookup");
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    return unit_test_main();  // which calls run_tests()
+}
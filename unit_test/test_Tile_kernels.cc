@@ -263,6 +263,88 @@ void test_gemm()
     test_gemm< std::complex<double> >();
 }
 
+//------------------------------------------------------------------------------
+/// Tests gemm with A and B RowMajor and C ColMajor, used in place.
+template <typename scalar_t>
+void test_gemm_layout()
+{
+    using real_t = blas::real_type<scalar_t>;
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    // square tiles, to convert layout in place
+    int n = 40;
+    int ld = n + 1;
+
+    scalar_t alpha, beta;
+    lapack::larnv( 1, iseed, 1, &alpha );
+    lapack::larnv( 1, iseed, 1, &beta  );
+
+    for (int ib = 0; ib < 3; ++ib) {
+    for (int ia = 0; ia < 3; ++ia) {
+        std::vector< scalar_t > Adata( ld*n ), Bdata( ld*n ), Cdata( ld*n );
+        lapack::larnv( 1, iseed, Adata.size(), Adata.data() );
+        lapack::larnv( 1, iseed, Bdata.size(), Bdata.data() );
+        lapack::larnv( 1, iseed, Cdata.size(), Cdata.data() );
+        std::vector< scalar_t > Aref = Adata, Bref = Bdata, Cref = Cdata;
+
+        slate::Tile< scalar_t > A( n, n, Adata.data(), ld, HostNum,
+                                   slate::TileKind::UserOwned );
+        slate::Tile< scalar_t > B( n, n, Bdata.data(), ld, HostNum,
+                                   slate::TileKind::UserOwned );
+        slate::Tile< scalar_t > C( n, n, Cdata.data(), ld, HostNum,
+                                   slate::TileKind::UserOwned );
+        A.layoutConvert();
+        B.layoutConvert();
+        A.op( ops[ia] );
+        B.op( ops[ib] );
+
+        if (verbose) {
+            printf( "gemm( opA=%c, opB=%c ), A, B RowMajor\n",
+                    char(A.op()), char(B.op()) );
+        }
+
+        // It should throw error if and only if
+        // A or B is complex conj-transposed.
+        bool conj_trans = slate::is_complex< scalar_t >::value
+                          && (ia == 2 || ib == 2);
+        try {
+            slate::tile::gemm( alpha, A, B, beta, C );
+            test_assert( ! conj_trans );
+        }
+        catch (std::exception& e) {
+            test_assert( conj_trans );
+            continue;
+        }
+
+        blas::gemm( blas::Layout::ColMajor, A.op(), B.op(), n, n, n,
+                    alpha, Aref.data(), ld,
+                           Bref.data(), ld,
+                    beta,  Cref.data(), ld );
+
+        test_assert_equal( C, Cref.data(), ld, 3*sqrt(n)*eps, 3*sqrt(n)*eps );
+    }}
+}
+
+void test_gemm_layout()
+{
+    test_gemm_layout< float  >();
+    test_gemm_layout< double >();
+    test_gemm_layout< std::complex<float>  >();
+    test_gemm_layout< std::complex<double> >();
+}
+
+//------------------------------------------------------------------------------
+/// Tests gemm with 3M (Gauss) complex multiplies for all tile sizes.
+void test_gemm3m()
+{
+    int64_t threshold = slate::gemm3m_threshold();
+    slate::gemm3m_threshold( 1 );
+    test_gemm< std::complex<float>  >();
+    test_gemm< std::complex<double> >();
+    slate::gemm3m_threshold( threshold );
+}
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void test_syrk()
@@ -662,6 +744,219 @@ void test_trsm()
     test_trsm< std::complex<double> >();
 }
 
+//------------------------------------------------------------------------------
+// sizes for the micro kernel tests: each dispatch bucket, and partial
+// register blocks.
+int micro_sizes[] = { 1, 7, 16, 33, 64 };
+
+//------------------------------------------------------------------------------
+/// Tests micro::gemm against blas::gemm for all op(A), op(B),
+/// and dimensions <= micro::max_nb.
+template <typename scalar_t>
+void test_micro_gemm()
+{
+    using real_t = blas::real_type<scalar_t>;
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    scalar_t alpha, beta;
+    lapack::larnv( 1, iseed, 1, &alpha );
+    lapack::larnv( 1, iseed, 1, &beta  );
+
+    for (int ia = 0; ia < 3; ++ia) {
+    for (int ib = 0; ib < 3; ++ib) {
+    for (int m : micro_sizes) {
+    for (int n : micro_sizes) {
+    for (int k : micro_sizes) {
+    for (int ibeta = 0; ibeta < 2; ++ibeta) {
+        blas::Op opA = ops[ia];
+        blas::Op opB = ops[ib];
+        scalar_t beta_ = (ibeta == 0 ? beta : scalar_t( 0 ));
+
+        // op(A) is m-by-k, op(B) is k-by-n
+        int Am = (ia == 0 ? m : k);
+        int An = (ia == 0 ? k : m);
+        int lda = Am + 1;
+        std::vector< scalar_t > Adata( lda*An );
+        lapack::larnv( 1, iseed, Adata.size(), Adata.data() );
+
+        int Bm = (ib == 0 ? k : n);
+        int Bn = (ib == 0 ? n : k);
+        int ldb = Bm + 1;
+        std::vector< scalar_t > Bdata( ldb*Bn );
+        lapack::larnv( 1, iseed, Bdata.size(), Bdata.data() );
+
+        int ldc = m + 1;
+        std::vector< scalar_t > Cdata( ldc*n );
+        lapack::larnv( 1, iseed, Cdata.size(), Cdata.data() );
+        std::vector< scalar_t > Cref( Cdata );
+
+        if (verbose > 1) {
+            printf( "micro::gemm( opA=%c, opB=%c, m=%d, n=%d, k=%d, beta=%d )\n",
+                    char(opA), char(opB), m, n, k, ibeta );
+        }
+
+        slate::tile::micro::gemm(
+            blas::Layout::ColMajor, opA, opB, m, n, k,
+            alpha, Adata.data(), lda,
+                   Bdata.data(), ldb,
+            beta_, Cdata.data(), ldc );
+
+        blas::gemm(
+            blas::Layout::ColMajor, opA, opB, m, n, k,
+            alpha, Adata.data(), lda,
+                   Bdata.data(), ldb,
+            beta_, Cref.data(), ldc );
+
+        slate::Tile< scalar_t > C( m, n, Cdata.data(), ldc, HostNum,
+                                   slate::TileKind::UserOwned );
+        test_assert_equal( C, Cref.data(), ldc, 3*sqrt(k)*eps, 3*sqrt(k)*eps );
+    }}}}}}
+}
+
+void test_micro_gemm()
+{
+    test_micro_gemm< float  >();
+    test_micro_gemm< double >();
+    test_micro_gemm< std::complex<float>  >();
+    test_micro_gemm< std::complex<double> >();
+}
+
+//------------------------------------------------------------------------------
+/// Tests micro::herk against blas::herk for all uplo, op(A),
+/// and dimensions <= micro::max_nb. The whole of C is compared,
+/// to check that the opposite triangle is not modified.
+template <typename scalar_t>
+void test_micro_herk()
+{
+    using real_t = blas::real_type<scalar_t>;
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    real_t alpha, beta;
+    lapack::larnv( 1, iseed, 1, &alpha );
+    lapack::larnv( 1, iseed, 1, &beta  );
+
+    for (int iu = 0; iu < 2; ++iu) {
+    for (int ia = 0; ia < 3; ++ia) {
+    for (int n : micro_sizes) {
+    for (int k : micro_sizes) {
+        blas::Uplo uplo = uplos[iu];
+        blas::Op op = ops[ia];
+        // complex herk doesn't allow Trans
+        if (slate::is_complex< scalar_t >::value && op == blas::Op::Trans)
+            continue;
+
+        // op(A) is n-by-k
+        int Am = (ia == 0 ? n : k);
+        int An = (ia == 0 ? k : n);
+        int lda = Am + 1;
+        std::vector< scalar_t > Adata( lda*An );
+        lapack::larnv( 1, iseed, Adata.size(), Adata.data() );
+
+        int ldc = n + 1;
+        std::vector< scalar_t > Cdata( ldc*n );
+        lapack::larnv( 1, iseed, Cdata.size(), Cdata.data() );
+        std::vector< scalar_t > Cref( Cdata );
+
+        if (verbose > 1) {
+            printf( "micro::herk( uplo=%c, op=%c, n=%d, k=%d )\n",
+                    char(uplo), char(op), n, k );
+        }
+
+        slate::tile::micro::herk(
+            blas::Layout::ColMajor, uplo, op, n, k,
+            alpha, Adata.data(), lda,
+            beta,  Cdata.data(), ldc );
+
+        blas::herk(
+            blas::Layout::ColMajor, uplo, op, n, k,
+            alpha, Adata.data(), lda,
+            beta,  Cref.data(), ldc );
+
+        slate::Tile< scalar_t > C( n, n, Cdata.data(), ldc, HostNum,
+                                   slate::TileKind::UserOwned );
+        test_assert_equal( C, Cref.data(), ldc, 3*sqrt(k)*eps, 3*sqrt(k)*eps );
+    }}}}
+}
+
+void test_micro_herk()
+{
+    test_micro_herk< float  >();
+    test_micro_herk< double >();
+    test_micro_herk< std::complex<float>  >();
+    test_micro_herk< std::complex<double> >();
+}
+
+//------------------------------------------------------------------------------
+/// Tests micro::trsm against blas::trsm for all side, uplo, op(A), diag,
+/// and dimensions <= micro::max_nb.
+template <typename scalar_t>
+void test_micro_trsm()
+{
+    using real_t = blas::real_type<scalar_t>;
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    scalar_t alpha;
+    lapack::larnv( 1, iseed, 1, &alpha );
+
+    for (int is = 0; is < 2; ++is) {
+    for (int iu = 0; iu < 2; ++iu) {
+    for (int ia = 0; ia < 3; ++ia) {
+    for (int id = 0; id < 2; ++id) {
+    for (int m : micro_sizes) {
+    for (int n : micro_sizes) {
+        blas::Side side = sides[is];
+        blas::Uplo uplo = uplos[iu];
+        blas::Op op = ops[ia];
+        blas::Diag diag = diags[id];
+
+        // A is na-by-na; small off-diagonal entries keep both the unit
+        // and non-unit triangles well conditioned.
+        int na = (side == blas::Side::Left ? m : n);
+        int lda = na + 1;
+        std::vector< scalar_t > Adata( lda*na );
+        lapack::larnv( 2, iseed, Adata.size(), Adata.data() );
+        for (auto& a : Adata)
+            a /= real_t( na );
+        for (int j = 0; j < na; ++j)
+            Adata[ j + j*lda ] += real_t( 1 );
+
+        int ldb = m + 1;
+        std::vector< scalar_t > Bdata( ldb*n );
+        lapack::larnv( 2, iseed, Bdata.size(), Bdata.data() );
+        std::vector< scalar_t > Bref( Bdata );
+
+        if (verbose > 1) {
+            printf( "micro::trsm( side=%c, uplo=%c, op=%c, diag=%c, m=%d, n=%d )\n",
+                    char(side), char(uplo), char(op), char(diag), m, n );
+        }
+
+        slate::tile::micro::trsm(
+            blas::Layout::ColMajor, side, uplo, op, diag, m, n,
+            alpha, Adata.data(), lda,
+                   Bdata.data(), ldb );
+
+        blas::trsm(
+            blas::Layout::ColMajor, side, uplo, op, diag, m, n,
+            alpha, Adata.data(), lda,
+                   Bref.data(), ldb );
+
+        slate::Tile< scalar_t > B( m, n, Bdata.data(), ldb, HostNum,
+                                   slate::TileKind::UserOwned );
+        test_assert_equal( B, Bref.data(), ldb, 10*na*eps, 10*na*eps );
+    }}}}}}
+}
+
+void test_micro_trsm()
+{
+    test_micro_trsm< float  >();
+    test_micro_trsm< double >();
+    test_micro_trsm< std::complex<float>  >();
+    test_micro_trsm< std::complex<double> >();
+}
+
 //------------------------------------------------------------------------------
 template <typename scalar_t>
 void test_potrf()
@@ -984,8 +1279,9 @@ void test_convert_layout()
 }
 
 //------------------------------------------------------------------------------
+/// If use_workspace is false, rectangular tiles are transposed in place.
 template <typename scalar_t>
-void test_device_convert_layout(int m, int n)
+void test_device_convert_layout(int m, int n, bool use_workspace = true)
 {
     if (num_devices == 0) {
         test_skip("requires num_devices > 0");
@@ -1051,7 +1347,7 @@ void test_device_convert_layout(int m, int n)
         double time = omp_get_wtime();
 
         for (int k = 0; k < batch_count; ++k) {
-            if (m == n)
+            if (m == n || ! use_workspace)
                 Atiles_dev[k].layoutConvert(queue);
             else
                 Atiles_dev[k].layoutConvert(dev_work, queue);
@@ -1126,6 +1422,16 @@ void test_device_convert_layout()
     test_device_convert_layout< double >(m, n);
     test_device_convert_layout< std::complex<float>  >(m, n);
     test_device_convert_layout< std::complex<double> >(m, n);
+
+    // rectangular tiles, in-place without workspace
+    test_device_convert_layout< float  >(m, n, false);
+    test_device_convert_layout< double >(m, n, false);
+    test_device_convert_layout< std::complex<float>  >(m, n, false);
+    test_device_convert_layout< std::complex<double> >(m, n, false);
+
+    m = 200; n = 72; // edge tiles
+    test_device_convert_layout< double >(m, n, false);
+    test_device_convert_layout< std::complex<double> >(m, n, false);
 }
 
 //------------------------------------------------------------------------------
@@ -1242,6 +1548,7 @@ void test_deepConjTranspose()
 enum class Section {
     newline = 0,  // zero flag forces newline
     blas_section,
+    micro,
     norm,
     factor,
     convert,
@@ -1261,11 +1568,18 @@ typedef struct {
 //------------------------------------------------------------------------------
 std::vector< routines_t > routines = {
     { "gemm",   test_gemm,   Section::blas_section },
+    { "gemm3m", test_gemm3m, Section::blas_section },
+    { "gemm_layout", test_gemm_layout, Section::blas_section },
     { "syrk",   test_syrk,   Section::blas_section },
     { "herk",   test_herk,   Section::blas_section },
     { "trsm",   test_trsm,   Section::blas_section },
     { "",       nullptr,     Section::newline      },
 
+    { "micro_gemm", test_micro_gemm, Section::micro },
+    { "micro_herk", test_micro_herk, Section::micro },
+    { "micro_trsm", test_micro_trsm, Section::micro },
+    { "",           nullptr,         Section::newline },
+
     { "genorm", test_genorm, Section::norm         },
     { "",       nullptr,     Section::newline      },
 
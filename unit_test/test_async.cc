@@ -0,0 +1,222 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+
+#include "unit_test.hh"
+#include "util_matrix.hh"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int n, nrhs, nb, p, q;
+int mpi_rank;
+int mpi_size;
+MPI_Comm mpi_comm;
+int num_devices = 0;
+int verbose = 0;
+
+//------------------------------------------------------------------------------
+/// Checks that all entries of B are x.
+void check_solution( slate::Matrix<double>& B, double x )
+{
+    double tol = 100 * n * std::numeric_limits<double>::epsilon();
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        for (int64_t i = 0; i < B.mt(); ++i) {
+            if (B.tileIsLocal( i, j )) {
+                B.tileGetForReading( i, j, slate::LayoutConvert::ColMajor );
+                auto T = B( i, j );
+                for (int64_t jj = 0; jj < T.nb(); ++jj)
+                    for (int64_t ii = 0; ii < T.mb(); ++ii)
+                        test_assert( std::abs( T( ii, jj ) - x ) < tol*x );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Makes A = ones + n I, which is positive definite; A ones = 2n ones.
+void make_A( slate::Matrix<double>& A )
+{
+    A = slate::Matrix<double>( n, n, nb, p, q, mpi_comm );
+    A.insertLocalTiles();
+    slate::set( 1.0, n + 1.0, A );
+}
+
+void make_A( slate::HermitianMatrix<double>& A )
+{
+    A = slate::HermitianMatrix<double>(
+        slate::Uplo::Lower, n, nb, p, q, mpi_comm );
+    A.insertLocalTiles();
+    slate::set( 1.0, n + 1.0, A );
+}
+
+//------------------------------------------------------------------------------
+/// Tests potrs queued right after potrf of the same matrix, without waiting.
+/// B = A X with X = ones.
+void test_potrf_potrs()
+{
+    slate::HermitianMatrix<double> A;
+    make_A( A );
+    slate::Matrix<double> B( n, nrhs, nb, p, q, mpi_comm );
+    B.insertLocalTiles();
+    slate::set( 2.0*n, 2.0*n, B );
+
+    auto info = slate::async::potrf( A );
+    auto solve = slate::async::potrs( A, B );
+    test_assert( info.valid() );
+    test_assert( solve.valid() );
+
+    solve.wait();
+    // potrf completed before potrs started.
+    test_assert( info.test() );
+    test_assert( info.wait() == 0 );
+
+    check_solution( B, 1.0 );
+    slate::async::wait_all();
+}
+
+//------------------------------------------------------------------------------
+/// Tests that Future::wait rethrows an exception thrown by a call, and that
+/// later calls still run.
+void test_exception()
+{
+    auto failed = slate::async::launch<int>( []() -> int {
+        throw std::logic_error( "call error" );
+    });
+    auto next = slate::async::launch<int>( []() { return 42; } );
+
+    test_assert_throw( failed.wait(), std::logic_error );
+    // Each copy of the future rethrows.
+    auto copy = failed;
+    test_assert_throw( copy.wait(), std::logic_error );
+    test_assert( next.wait() == 42 );
+    slate::async::wait_all();
+}
+
+//------------------------------------------------------------------------------
+/// Tests slate::LU and slate::Cholesky: factor once, then solve several
+/// right-hand sides, B_s = A X_s with X_s = s + 1, alternating solve and
+/// solve_async, with the factorization going out of scope while solves
+/// are still queued.
+template <typename Factorization>
+void test_factorization_solves()
+{
+    const int num_solves = 4;
+    slate::Target targets[] = { slate::Target::HostTask,
+                                slate::Target::Devices };
+    for (auto target : targets) {
+        if (target == slate::Target::Devices && num_devices == 0)
+            continue;
+        slate::Options opts = { { slate::Option::Target, target } };
+
+        std::vector< slate::Matrix<double> > B_array;
+        for (int s = 0; s < num_solves; ++s) {
+            slate::Matrix<double> B( n, nrhs, nb, p, q, mpi_comm );
+            B.insertLocalTiles();
+            slate::set( 2.0*n*(s + 1), 2.0*n*(s + 1), B );
+            B_array.push_back( B );
+        }
+
+        std::vector< slate::Future<void> > futures;
+        {
+            Factorization F;
+            typename std::remove_reference< decltype( F.A() ) >::type A;
+            make_A( A );
+
+            test_assert( F.factor( A, opts ) == 0 );
+            for (int s = 0; s < num_solves; ++s) {
+                if (s % 2 == 0)
+                    F.solve( B_array[ s ], opts );
+                else
+                    futures.push_back( F.solve_async( B_array[ s ], opts ) );
+            }
+            // ~Factorization waits for the queued solves.
+        }
+        for (auto& future : futures)
+            test_assert( future.test() );
+
+        for (int s = 0; s < num_solves; ++s)
+            check_solution( B_array[ s ], s + 1.0 );
+    }
+    slate::async::wait_all();
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    run_test(test_potrf_potrs, "async potrf, potrs", mpi_comm);
+    run_test(test_exception,   "async exception",    mpi_comm);
+    run_test(test_factorization_solves< slate::LU<double> >,
+             "LU factor, solves", mpi_comm);
+    run_test(test_factorization_solves< slate::Cholesky<double> >,
+             "Cholesky factor, solves", mpi_comm);
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    // Calls run on the worker thread only with MPI_THREAD_MULTIPLE;
+    // otherwise they run synchronously, which is also tested.
+    int provided = 0;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+
+    mpi_comm = MPI_COMM_WORLD;
+
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
+    MPI_Comm_size(mpi_comm, &mpi_size);
+
+    num_devices = blas::get_device_count();
+
+    // globals
+    n    = 100;
+    nrhs = 10;
+    nb   = 16;
+    init_process_grid(mpi_size, &p, &q);
+
+    // parse command line
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-n" && i+1 < argc)
+            n = atoi( argv[++i] );
+        else if (arg == "-nrhs" && i+1 < argc)
+            nrhs = atoi( argv[++i] );
+        else if (arg == "-nb" && i+1 < argc)
+            nb = atoi( argv[++i] );
+        else if (arg == "-p" && i+1 < argc)
+            p = atoi( argv[++i] );
+        else if (arg == "-q" && i+1 < argc)
+            q = atoi( argv[++i] );
+        else if (arg == "-v")
+            ++verbose;
+        else {
+            printf( "unknown argument: %s\n", argv[i] );
+            return 1;
+        }
+    }
+    if (mpi_rank == 0) {
+        printf("Usage: %s [-n %d] [-nrhs %d] [-nb %d] [-p %d] [-q %d] [-v]\n"
+               "MPI thread level %s\n",
+               argv[0], n, nrhs, nb, p, q,
+               provided >= MPI_THREAD_MULTIPLE ? "multiple" : "below multiple");
+    }
+
+    int err = unit_test_main(mpi_comm);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
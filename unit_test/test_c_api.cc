@@ -14,6 +14,7 @@ void test_enums()
     assert( slate_TileKind_Workspace  == int( slate::TileKind::Workspace  ) );
     assert( slate_TileKind_SlateOwned == int( slate::TileKind::SlateOwned ) );
     assert( slate_TileKind_UserOwned  == int( slate::TileKind::UserOwned  ) );
+    assert( slate_TileKind_NodeShared == int( slate::TileKind::NodeShared ) );
 
     //----------
     assert( slate_Target_Host      == int( slate::Target::Host      ) );
@@ -26,6 +27,8 @@ void test_enums()
     //----------
     assert( slate_MethodEig_QR == int( slate::MethodEig::QR ) );
     assert( slate_MethodEig_DC == int( slate::MethodEig::DC ) );
+    assert( slate_MethodEig_Bisection == int( slate::MethodEig::Bisection ) );
+    assert( slate_MethodEig_QDWH == int( slate::MethodEig::QDWH ) );
 
     //----------
     assert( slate_Option_ChunkSize           == int( slate::Option::ChunkSize           ) );
@@ -42,6 +45,24 @@ void test_enums()
     assert( slate_Option_PrintWidth          == int( slate::Option::PrintWidth          ) );
     assert( slate_Option_PrintPrecision      == int( slate::Option::PrintPrecision      ) );
     assert( slate_Option_PivotThreshold      == int( slate::Option::PivotThreshold      ) );
+    assert( slate_Option_Workspace           == int( slate::Option::Workspace           ) );
+    assert( slate_Option_AggregateBcast      == int( slate::Option::AggregateBcast      ) );
+    assert( slate_Option_HierarchicalBcast   == int( slate::Option::HierarchicalBcast   ) );
+    assert( slate_Option_MathMode            == int( slate::Option::MathMode            ) );
+    assert( slate_Option_InvertDiagonal      == int( slate::Option::InvertDiagonal      ) );
+    assert( slate_Option_TournamentTree      == int( slate::Option::TournamentTree      ) );
+    assert( slate_Option_MaxLookahead        == int( slate::Option::MaxLookahead        ) );
+    assert( slate_Option_Pipeline            == int( slate::Option::Pipeline            ) );
+    assert( slate_Option_Layers              == int( slate::Option::Layers              ) );
+    assert( slate_Option_MaxWorkspace        == int( slate::Option::MaxWorkspace        ) );
+    assert( slate_Option_ColumnGroups        == int( slate::Option::ColumnGroups        ) );
+    assert( slate_Option_CholQRPasses        == int( slate::Option::CholQRPasses        ) );
+    assert( slate_Option_NormEstVectors      == int( slate::Option::NormEstVectors      ) );
+    assert( slate_Option_MixedLowMemory      == int( slate::Option::MixedLowMemory      ) );
+    assert( slate_Option_Rank                == int( slate::Option::Rank                ) );
+    assert( slate_Option_Oversampling        == int( slate::Option::Oversampling        ) );
+    assert( slate_Option_PowerIterations     == int( slate::Option::PowerIterations     ) );
+    assert( slate_Option_Timers              == int( slate::Option::Timers              ) );
 
     assert( slate_Option_MethodCholQR        == int( slate::Option::MethodCholQR        ) );
     assert( slate_Option_MethodEig           == int( slate::Option::MethodEig           ) );
@@ -50,6 +71,8 @@ void test_enums()
     assert( slate_Option_MethodHemm          == int( slate::Option::MethodHemm          ) );
     assert( slate_Option_MethodLU            == int( slate::Option::MethodLU            ) );
     assert( slate_Option_MethodTrsm          == int( slate::Option::MethodTrsm          ) );
+    assert( slate_Option_MethodCholesky      == int( slate::Option::MethodCholesky      ) );
+    assert( slate_Option_MethodMatFunc       == int( slate::Option::MethodMatFunc       ) );
 
     //----------
     assert( slate_Op_NoTrans   == int( slate::Op::NoTrans   ) );
@@ -225,6 +225,63 @@ void test_device_1d_grid()
     }
 }
 
+//------------------------------------------------------------------------------
+void test_device_peer_grid()
+{
+    // Single group is device_1d_grid( Row, q, size ) in the group's order.
+    auto grid_one = slate::func::device_peer_grid( 2, 3, { { 1, 0, 2 } } );
+    auto grid_1d  = slate::func::device_1d_grid( slate::GridOrder::Row, 3, 3 );
+    int perm[] = { 1, 0, 2 };
+    for (int i = 0; i < 20; ++i) {
+        for (int j = 0; j < 40; ++j) {
+            test_assert( grid_one( {i, j} ) == perm[ grid_1d( {i, j} ) ] );
+        }
+    }
+
+    // Local tile rows cycle over groups, local tile columns over the
+    // devices in each group.
+    std::vector< std::vector<int> > groups = { { 0, 1 }, { 2, 3, 4 } };
+    auto grid = slate::func::device_peer_grid( 2, 3, groups );
+    for (int i = 0; i < 20; ++i) {
+        auto const& group = groups[ (i / 2) % 2 ];
+        for (int j = 0; j < 40; ++j) {
+            test_assert( grid( {i, j} ) == group[ (j / 3) % group.size() ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_device_peer_groups()
+{
+    // Devices 0, 2 and 1, 3 are peers; device 4 has no peers.
+    slate::DeviceTopology topology;
+    topology.num_devices = 5;
+    topology.pci_bus_id.resize( 5 );
+    topology.numa_node = { 0, 1, 0, 1, 1 };
+    topology.peer.assign( 5, std::vector<bool>( 5, false ) );
+    for (int i = 0; i < 5; ++i)
+        topology.peer[ i ][ i ] = true;
+    for (auto ij : { std::pair<int, int>( 0, 2 ), std::pair<int, int>( 1, 3 ) }) {
+        topology.peer[ ij.first ][ ij.second ] = true;
+        topology.peer[ ij.second ][ ij.first ] = true;
+    }
+    // One-way access is not enough.
+    topology.peer[ 4 ][ 1 ] = true;
+
+    auto groups = slate::device_peer_groups( topology );
+    test_assert( groups.size() == 3 );
+    test_assert( (groups[ 0 ] == std::vector<int>{ 0, 2 }) );
+    test_assert( (groups[ 1 ] == std::vector<int>{ 1, 3 }) );
+    test_assert( (groups[ 2 ] == std::vector<int>{ 4 }) );
+
+    // Fully connected.
+    for (auto& row : topology.peer)
+        row.assign( 5, true );
+    groups = slate::device_peer_groups( topology );
+    test_assert( groups.size() == 1 );
+    test_assert( (groups[ 0 ] == std::vector<int>{ 0, 2, 1, 3, 4 }) );
+}
+
 //------------------------------------------------------------------------------
 void test_grid_transpose()
 {
@@ -410,6 +467,8 @@ void run_tests()
     run_test( test_process_1d_grid,   "test_process_1d_grid" );
     run_test( test_device_2d_grid,    "test_device_2d_grid" );
     run_test( test_device_1d_grid,    "test_device_1d_grid" );
+    run_test( test_device_peer_grid,  "test_device_peer_grid" );
+    run_test( test_device_peer_groups, "test_device_peer_groups" );
     run_test( test_grid_transpose,    "test_transpose_grid" );
     run_test( test_is_2d_cyclic_grid, "test_is_2d_cyclic_grid" );
 }
@@ -0,0 +1,146 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/device.hh"
+#include "slate/internal/util.hh"
+
+#include "unit_test.hh"
+#include "testsweeper.hh"
+
+#include <list>
+#include <tuple>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int mpi_rank;
+int mpi_size;
+int verbose;
+int num_devices;
+
+//------------------------------------------------------------------------------
+/// Tests device::iamax on a strided vector,
+/// with its maximum at index imax, repeated at index imax2 > imax
+/// to check that the first one is found.
+template <typename scalar_t>
+void test_iamax_dev_worker(
+    int n, int incx, int imax, int imax2,
+    blas::Queue& queue)
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    int lx = 1 + (n - 1)*incx;
+    std::vector<scalar_t> x( lx );
+    for (int i = 0; i < lx; ++i) {
+        // |x_i| < 1, with alternating signs.
+        x[ i ] = testsweeper::make_scalar<scalar_t>(
+                     std::complex<double>( (i % 2 ? -0.5 : 0.5) * i / lx,
+                                           0.25 ) );
+    }
+    scalar_t big = testsweeper::make_scalar<scalar_t>(
+                       std::complex<double>( -2.0, 1.0 ) );
+    x[ imax*incx ] = big;
+    if (imax2 < n)
+        x[ imax2*incx ] = big;
+
+    scalar_t* dx = blas::device_malloc<scalar_t>( lx, queue );
+    int64_t* dindex = blas::device_malloc<int64_t>( 1, queue );
+    scalar_t* dvalue = blas::device_malloc<scalar_t>( 1, queue );
+    test_assert( dx != nullptr );
+
+    blas::device_memcpy<scalar_t>(
+        dx, x.data(), lx, blas::MemcpyKind::HostToDevice, queue );
+
+    slate::device::iamax( n, dx, incx, dindex, dvalue, queue );
+
+    int64_t index;
+    scalar_t value;
+    blas::device_memcpy<int64_t>( &index, dindex, 1, queue );
+    blas::device_memcpy<scalar_t>( &value, dvalue, 1, queue );
+    queue.sync();
+
+    if (verbose) {
+        printf( "\n(n %4d, incx %d, imax %4d): index %lld ",
+                n, incx, imax, llong( index ) );
+    }
+
+    blas::device_free( dx, queue );
+    blas::device_free( dindex, queue );
+    blas::device_free( dvalue, queue );
+
+    test_assert( index == imax );
+    test_assert( value == big );
+}
+
+template <typename scalar_t>
+void test_iamax_dev()
+{
+    // Each tuple contains (n, incx, imax, imax2)
+    std::list< std::tuple< int, int, int, int > > dims_list{
+            {    1, 1,    0,    1 },
+            {   10, 1,    0,    5 },
+            {   10, 1,    9,   10 },
+            {  100, 3,   37,   38 },
+            { 1000, 1,  999, 1000 },
+            { 1000, 2,  511,  700 },
+            { 5000, 1, 1234, 4000 },
+        };
+
+    int device_idx = 0;
+    blas::Queue queue( device_idx );
+
+    for (auto dims : dims_list) {
+        test_iamax_dev_worker<scalar_t>(
+            std::get<0>( dims ), std::get<1>( dims ),
+            std::get<2>( dims ), std::get<3>( dims ), queue );
+    }
+}
+
+template <typename... scalar_t>
+void run_tests_iamax_device()
+{
+    ( run_test<scalar_t>(
+                          test_iamax_dev<scalar_t>, "iamax_dev" ),
+      ... );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    if (mpi_rank == 0) {
+        //-------------------- iamax_dev
+        run_tests_iamax_device<
+            float, double, std::complex<float>, std::complex<double>
+            >();
+    }
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    MPI_Init( &argc, &argv );
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &mpi_size );
+
+    num_devices = blas::get_device_count();
+
+    verbose = 0;
+    for (int i = 1; i < argc; ++i)
+        if (argv[i] == std::string( "-v" ))
+            verbose += 1;
+
+    int err = unit_test_main( MPI_COMM_WORLD );  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -449,6 +449,280 @@ void test_gemm(slate::Target target)
     }}}
 }
 
+// -----------------------------------------------------------------------------
+/// Tests internal::gemm with A set to zero by set(). Without tracking the
+/// tile structure, A(0, 0) is then written through a Tile taken before set(),
+/// which SLATE doesn't see, so gemm must not skip it. With tracking, the
+/// Zero tiles are skipped, and the result must still be correct.
+template <typename scalar_t>
+void test_gemm_structure(slate::Target target)
+{
+    auto msg = __func__ + ("< " + type_name<scalar_t>() + ", " + target_name(target) + " >");
+    Test name(msg.c_str());
+
+    if (target == slate::Target::Devices && blas::get_device_count() == 0) {
+        printf( "requires num_devices > 0" );
+        return;
+    }
+
+    using real_t = blas::real_type<scalar_t>;
+    const blas::Layout layout = blas::Layout::ColMajor;
+    const scalar_t zero = 0;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    int nb = 16;
+    int m = 2*nb;
+    int n = 2*nb;
+    int k = nb;
+    int p = 1;
+    int q = 1;
+
+    scalar_t alpha, beta;
+    lapack::larnv(1, iseed, 1, &alpha);
+    lapack::larnv(1, iseed, 1, &beta);
+
+    for (int track = 0; track < 2; ++track) {
+        test_message("gemm( track structure %d )", track);
+
+        slate::Matrix<scalar_t> A( m, k, nb, p, q, g_mpi_comm );
+        slate::Matrix<scalar_t> B( k, n, nb, p, q, g_mpi_comm );
+        slate::Matrix<scalar_t> C( m, n, nb, p, q, g_mpi_comm );
+        for (auto X : { A, B, C }) {
+            X.insertLocalTiles();
+            for (int64_t j = 0; j < X.nt(); ++j) {
+                for (int64_t i = 0; i < X.mt(); ++i) {
+                    auto T = X( i, j );
+                    for (int64_t jj = 0; jj < T.nb(); ++jj)
+                        lapack::larnv(1, iseed, T.mb(), &T.at( 0, jj ));
+                }
+            }
+        }
+        A.trackTileStructure( track == 1 );
+        if (target == slate::Target::Devices)
+            C.allocateBatchArrays();
+
+        auto T00 = A( 0, 0 );
+        slate::internal::set<slate::Target::HostTask>(
+            zero, zero, A.sub( 0, A.mt()-1, 0, A.nt()-1 ) );
+        if (track == 1) {
+            test_assert(A.tileStructure( 0, 0 ) == slate::TileStructure::Zero);
+        }
+        else {
+            // Write through the Tile taken before set().
+            test_assert(A.tileStructure( 0, 0 ) == slate::TileStructure::Dense);
+            for (int64_t jj = 0; jj < T00.nb(); ++jj)
+                lapack::larnv(1, iseed, T00.mb(), &T00.at( 0, jj ));
+        }
+
+        int lda = m, ldb = k, ldc = m;
+        std::vector<scalar_t> Aref( lda*k ), Bref( ldb*n ), Cref( ldc*n );
+        copy( A, Aref.data(), lda );
+        copy( B, Bref.data(), ldb );
+        copy( C, Cref.data(), ldc );
+
+        switch (target) {
+            case slate::Target::HostTask:
+                slate::internal::gemm<slate::Target::HostTask>(
+                        alpha, std::move(A), std::move(B),
+                        beta,  std::move(C), layout);
+                break;
+            case slate::Target::HostNest:
+                slate::internal::gemm<slate::Target::HostNest>(
+                        alpha, std::move(A), std::move(B),
+                        beta,  std::move(C), layout);
+                break;
+            case slate::Target::HostBatch:
+                slate::internal::gemm<slate::Target::HostBatch>(
+                        alpha, std::move(A), std::move(B),
+                        beta,  std::move(C), layout);
+                break;
+            case slate::Target::Devices:
+                slate::internal::gemm<slate::Target::Devices>(
+                        alpha, std::move(A), std::move(B),
+                        beta,  std::move(C), layout);
+                for (int j = 0; j < C.nt(); ++j)
+                    for (int i = 0; i < C.mt(); ++i)
+                        C.tileGetForReading(i, j, slate::LayoutConvert(layout));
+                break;
+            default:
+                assert(false);
+        }
+
+        blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                   m, n, k,
+                   alpha, Aref.data(), lda,
+                          Bref.data(), ldb,
+                   beta,  Cref.data(), ldc);
+
+        real_t eps = std::numeric_limits<real_t>::epsilon();
+        test_assert_equal(C, Cref.data(), ldc, 3*sqrt(k)*eps, 3*sqrt(k)*eps);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Tests internal::gemm on devices with beta = 0 and C a slice whose first
+/// tile is only part of a tile valid on the host, so the device can't just
+/// overwrite it: the rest of the tile, outside the slice, must be kept.
+template <typename scalar_t>
+void test_gemm_slice()
+{
+    auto msg = __func__ + ("< " + type_name<scalar_t>() + " >");
+    Test name(msg.c_str());
+
+    if (blas::get_device_count() == 0) {
+        printf( "requires num_devices > 0" );
+        return;
+    }
+
+    using real_t = blas::real_type<scalar_t>;
+    const blas::Layout layout = blas::Layout::ColMajor;
+    const scalar_t zero = 0;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    int nb = 16;
+    int m = 2*nb;
+    int n = 2*nb;
+    int k = nb;
+    int p = 1;
+    int q = 1;
+
+    scalar_t alpha;
+    lapack::larnv(1, iseed, 1, &alpha);
+
+    slate::Matrix<scalar_t> A( m, k, nb, p, q, g_mpi_comm );
+    slate::Matrix<scalar_t> B( k, n, nb, p, q, g_mpi_comm );
+    slate::Matrix<scalar_t> C( m, n, nb, p, q, g_mpi_comm );
+    for (auto X : { A, B, C }) {
+        X.insertLocalTiles();
+        for (int64_t j = 0; j < X.nt(); ++j) {
+            for (int64_t i = 0; i < X.mt(); ++i) {
+                auto T = X( i, j );
+                for (int64_t jj = 0; jj < T.nb(); ++jj)
+                    lapack::larnv(1, iseed, T.mb(), &T.at( 0, jj ));
+            }
+        }
+    }
+    C.allocateBatchArrays();
+
+    int lda = m, ldb = k, ldc = m;
+    std::vector<scalar_t> Aref( lda*k ), Bref( ldb*n ), Cref( ldc*n );
+    copy( A, Aref.data(), lda );
+    copy( B, Bref.data(), ldb );
+    copy( C, Cref.data(), ldc );
+
+    // Slices offset by one row and col; C( 0, 0 ) is part of a tile.
+    auto As = A.slice( 1, m-1, 0, k-1 );
+    auto Bs = B.slice( 0, k-1, 1, n-1 );
+    auto Cs = C.slice( 1, m-1, 1, n-1 );
+    slate::internal::gemm<slate::Target::Devices>(
+            alpha, std::move(As), std::move(Bs),
+            zero,  std::move(Cs), layout);
+    for (int j = 0; j < C.nt(); ++j)
+        for (int i = 0; i < C.mt(); ++i)
+            C.tileGetForReading(i, j, slate::LayoutConvert(layout));
+
+    blas::gemm(blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+               m-1, n-1, k,
+               alpha, &Aref[ 1 ], lda,
+                      &Bref[ ldb ], ldb,
+               zero,  &Cref[ 1 + ldc ], ldc);
+
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+    test_assert_equal(C, Cref.data(), ldc, 3*sqrt(k)*eps, 3*sqrt(k)*eps);
+}
+
+// -----------------------------------------------------------------------------
+/// Tests internal::gemm on devices with C from one contiguous device array,
+/// which it updates by super-tiles of up to 3-by-3 tiles, each by one gemm.
+template <typename scalar_t>
+void test_gemm_super_tile()
+{
+    auto msg = __func__ + ("< " + type_name<scalar_t>() + " >");
+    Test name(msg.c_str());
+
+    if (blas::get_device_count() == 0) {
+        printf( "requires num_devices > 0" );
+        return;
+    }
+
+    using blas::real;
+    using real_t = blas::real_type<scalar_t>;
+    const blas::Layout layout = blas::Layout::ColMajor;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+
+    int nb = 16;
+    int m = 80;
+    int n = 64;
+    int k = 16;  // block col * block row update
+    int p = 1;
+    int q = 1;
+
+    scalar_t alpha, beta;
+    lapack::larnv(1, iseed, 1, &alpha);
+    lapack::larnv(1, iseed, 1, &beta);
+
+    int64_t super_tile_save = slate::super_tile();
+    slate::super_tile( 3 );
+
+    blas::Queue queue( 0 );
+
+    // op(B) is NoTrans or ConjTrans, e.g., as in getrf and potrf updates.
+    for (int ib = 0; ib < 3; ib += 2) {
+        // C is m-by-n, on device 0.
+        int ldc = m;
+        std::vector<scalar_t> Cdata(ldc*n);
+        lapack::larnv(1, iseed, Cdata.size(), Cdata.data());
+        std::vector<scalar_t> Cref( Cdata );
+        scalar_t* dC = blas::device_malloc<scalar_t>( ldc*n, queue );
+        blas::device_copy_matrix( m, n, Cdata.data(), ldc, dC, ldc, queue );
+        queue.sync();
+        auto C = slate::Matrix<scalar_t>::fromDevices(
+            m, n, &dC, 1, ldc, nb, p, q, g_mpi_comm );
+        C.allocateBatchArrays();
+
+        int Bm = (ib == 0 ? k : n);
+        int Bn = (ib == 0 ? n : k);
+        int ldb = Bm + 1;
+        std::vector<scalar_t> Bdata(ldb*Bn);
+        lapack::larnv(1, iseed, Bdata.size(), Bdata.data());
+        auto B = slate::Matrix<scalar_t>::fromLAPACK(Bm, Bn, Bdata.data(), ldb, nb, p, q, g_mpi_comm);
+        if (ib == 2)
+            B = conj_transpose( B );
+
+        int lda = m + 1;
+        std::vector<scalar_t> Adata(lda*k);
+        lapack::larnv(1, iseed, Adata.size(), Adata.data());
+        auto A = slate::Matrix<scalar_t>::fromLAPACK(m, k, Adata.data(), lda, nb, p, q, g_mpi_comm);
+
+        test_message("gemm( opA=%c, opB=%c, opC=%c )",
+                     char(A.op()), char(B.op()), char(C.op()));
+
+        slate::internal::gemm<slate::Target::Devices>(
+                alpha, std::move(A), std::move(B),
+                beta,  std::move(C), layout);
+
+        blas::device_copy_matrix( m, n, dC, ldc, Cdata.data(), ldc, queue );
+        queue.sync();
+        blas::device_free( dC, queue );
+
+        // reference solution
+        blas::gemm(blas::Layout::ColMajor, A.op(), B.op(), m, n, k,
+                   alpha, Adata.data(), lda,
+                          Bdata.data(), ldb,
+                   beta, Cref.data(), ldc);
+
+        real_t eps = std::numeric_limits<real_t>::epsilon();
+        real_t error = 0;
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < m; ++i)
+                error = std::max( error, std::abs( Cdata[ i + j*ldc ]
+                                                   - Cref[ i + j*ldc ] ) );
+        test_assert( error <= 3*sqrt(k)*eps );
+    }
+
+    slate::super_tile( super_tile_save );
+}
+
 // -----------------------------------------------------------------------------
 template <typename scalar_t>
 void test_syrk(slate::Target target)
@@ -847,6 +1121,12 @@ int main(int argc, char** argv)
             test_gemm<double>(targets[it]);
             test_gemm< std::complex<double> >(targets[it]);
         }
+        for (int it = 0; it < numtargets; ++it) {
+            test_gemm_structure<double>(targets[it]);
+        }
+        test_gemm_slice<double>();
+        test_gemm_super_tile<double>();
+        test_gemm_super_tile< std::complex<double> >();
     }
     if (do_all || do_syrk) {
         for (int it = 0; it < numtargets; ++it) {
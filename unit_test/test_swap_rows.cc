@@ -0,0 +1,190 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/internal/device.hh"
+#include "slate/internal/util.hh"
+
+#include "unit_test.hh"
+#include "testsweeper.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// global variables
+int mpi_rank;
+int mpi_size;
+int verbose;
+int num_devices;
+
+//------------------------------------------------------------------------------
+/// Tests device::swap_rows_batch, as permuteRows uses it: each group is a
+/// row-major block of nrows rows of its own length, with num_swaps random
+/// swaps, applied in order, so repeated rows and swaps of a row with
+/// itself occur. Compares with the same swaps applied on the host.
+template <typename scalar_t>
+void test_swap_rows_batch_dev_worker(
+    std::vector<int64_t> const& lengths, int nrows, int num_swaps,
+    blas::Queue& queue)
+{
+    int64_t group_count = lengths.size();
+
+    // Group g is the nrows-by-lengths[ g ] row-major block at section[ g ].
+    std::vector<int64_t> section( group_count + 1, 0 );
+    for (int64_t g = 0; g < group_count; ++g)
+        section[ g+1 ] = section[ g ] + nrows * lengths[ g ];
+    int64_t size = section[ group_count ];
+
+    std::vector<scalar_t> A( size ), A_ref( size );
+    for (int64_t k = 0; k < size; ++k) {
+        A[ k ] = testsweeper::make_scalar<scalar_t>(
+                     std::complex<double>( k, -k ) );
+    }
+    A_ref = A;
+
+    scalar_t* dA = blas::device_malloc<scalar_t>(
+                       std::max( size, int64_t( 1 ) ), queue );
+    test_assert( dA != nullptr );
+    blas::device_memcpy<scalar_t>(
+        dA, A.data(), size, blas::MemcpyKind::HostToDevice, queue );
+
+    // Random swaps, applied to A_ref on the host as the reference.
+    std::vector<int64_t> offsets( 1, 0 );
+    std::vector<scalar_t*> rows;
+    for (int64_t g = 0; g < group_count; ++g) {
+        int64_t n = lengths[ g ];
+        for (int s = 0; s < num_swaps; ++s) {
+            int r1 = rand() % nrows;
+            int r2 = rand() % nrows;
+            rows.push_back( dA + section[ g ] + r1*n );
+            rows.push_back( dA + section[ g ] + r2*n );
+            for (int64_t j = 0; j < n; ++j) {
+                std::swap( A_ref[ section[ g ] + r1*n + j ],
+                           A_ref[ section[ g ] + r2*n + j ] );
+            }
+        }
+        offsets.push_back( rows.size() / 2 );
+    }
+
+    int64_t* doffsets = blas::device_malloc<int64_t>( group_count + 1, queue );
+    int64_t* dlengths = blas::device_malloc<int64_t>(
+                            std::max( group_count, int64_t( 1 ) ), queue );
+    scalar_t** drows = blas::device_malloc<scalar_t*>(
+                           std::max( rows.size(), size_t( 1 ) ), queue );
+    blas::device_memcpy<int64_t>(
+        doffsets, offsets.data(), offsets.size(), queue );
+    blas::device_memcpy<int64_t>(
+        dlengths, lengths.data(), lengths.size(), queue );
+    blas::device_memcpy<scalar_t*>(
+        drows, rows.data(), rows.size(), queue );
+
+    slate::device::swap_rows_batch(
+        group_count, doffsets, dlengths, drows, queue );
+
+    blas::device_memcpy<scalar_t>(
+        A.data(), dA, size, blas::MemcpyKind::DeviceToHost, queue );
+    queue.sync();
+
+    int64_t errors = 0;
+    for (int64_t k = 0; k < size; ++k) {
+        if (A[ k ] != A_ref[ k ])
+            ++errors;
+    }
+
+    if (verbose) {
+        printf( "\n(groups %4lld, nrows %4d, swaps %4d): errors %lld ",
+                llong( group_count ), nrows, num_swaps, llong( errors ) );
+    }
+
+    blas::device_free( dA, queue );
+    blas::device_free( doffsets, queue );
+    blas::device_free( dlengths, queue );
+    blas::device_free( drows, queue );
+
+    test_assert( errors == 0 );
+}
+
+template <typename scalar_t>
+void test_swap_rows_batch_dev()
+{
+    if (num_devices == 0) {
+        test_skip("requires num_devices > 0");
+    }
+
+    // Each tuple contains (lengths of groups, nrows, num_swaps)
+    std::list< std::tuple< std::vector<int64_t>, int, int > > dims_list{
+            // Corner cases
+            { {},              10,   5 },
+            { { 16 },           1,   3 },
+            { { 16 },          10,   0 },
+            // One group
+            { { 1 },           10,  20 },
+            { { 100 },         50,  50 },
+            // Groups of different lengths, as for edge tile columns
+            { { 32, 32, 7 },   40,  40 },
+            { { 256, 1, 100 }, 64, 200 },
+        };
+
+    int device_idx = 0;
+    blas::Queue queue( device_idx );
+
+    srand( 1 );
+    for (auto dims : dims_list) {
+        test_swap_rows_batch_dev_worker<scalar_t>(
+            std::get<0>( dims ), std::get<1>( dims ),
+            std::get<2>( dims ), queue );
+    }
+}
+
+template <typename... scalar_t>
+void run_tests_swap_rows_batch_device()
+{
+    ( run_test<scalar_t>(
+                          test_swap_rows_batch_dev<scalar_t>,
+                          "swap_rows_batch_dev" ),
+      ... );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    if (mpi_rank == 0) {
+        //-------------------- swap_rows_batch_dev
+        run_tests_swap_rows_batch_device<
+            float, double, std::complex<float>, std::complex<double>
+            >();
+    }
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    MPI_Init( &argc, &argv );
+    MPI_Comm_rank( MPI_COMM_WORLD, &mpi_rank );
+    MPI_Comm_size( MPI_COMM_WORLD, &mpi_size );
+
+    num_devices = blas::get_device_count();
+
+    verbose = 0;
+    for (int i = 1; i < argc; ++i)
+        if (argv[i] == std::string( "-v" ))
+            verbose += 1;
+
+    int err = unit_test_main( MPI_COMM_WORLD );  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -0,0 +1,164 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "slate/slate.hh"
+#include "slate/TileLowRankMatrix.hh"
+
+#include "unit_test.hh"
+
+using slate::HostNum;
+
+namespace test {
+
+//------------------------------------------------------------------------------
+// globals
+int      g_argc      = 0;
+char**   g_argv      = nullptr;
+int      verbose     = 0;
+int      mpi_rank    = -1;
+int      mpi_size    = 0;
+int      num_devices = 0;
+MPI_Comm mpi_comm;
+
+//------------------------------------------------------------------------------
+/// Sets A to the exponential covariance kernel on n points in [0, 1],
+/// A(i, j) = exp( -|x_i - x_j| / 0.25 ), plus 1 on the diagonal.
+/// Its off-diagonal tiles have numerical rank 1.
+template <typename scalar_t>
+void exp_kernel( int64_t n, std::vector<scalar_t>& A )
+{
+    using real_t = blas::real_type<scalar_t>;
+    A.resize( n*n );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i < n; ++i) {
+            real_t d = std::abs( real_t( i - j ) ) / n;
+            A[ i + j*n ] = std::exp( -d / real_t( 0.25 ) )
+                         + (i == j ? real_t( 1.0 ) : real_t( 0.0 ));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Test tlr::compress, tlr::hemm, and tlr::potrf + tlr::potrs against
+/// dense BLAS on the kernel matrix.
+template <typename scalar_t>
+void test_tlr_work( int64_t n, int64_t nb, int64_t nrhs )
+{
+    using real_t = blas::real_type<scalar_t>;
+    using blas::Layout;
+    using blas::Side;
+    using blas::Uplo;
+    using lapack::Norm;
+
+    real_t eps = std::numeric_limits<real_t>::epsilon();
+    real_t tol = std::sqrt( eps );
+    scalar_t one = 1.0, zero = 0.0;
+
+    std::vector<scalar_t> Adata;
+    exp_kernel( n, Adata );
+    auto A = slate::HermitianMatrix<scalar_t>::fromLAPACK(
+        Uplo::Lower, n, Adata.data(), n, nb, 1, 1, MPI_COMM_SELF );
+
+    auto T = slate::tlr::compress( A, tol );
+    test_assert( T.nt() == A.nt() );
+    test_assert( T.n() == n );
+    test_assert( T.maxRank() < nb );
+    test_assert( T.storedElements() < n*(n+1)/2 );
+
+    std::vector<scalar_t> Bdata( n*nrhs ), Cdata( n*nrhs ), Rdata( n*nrhs );
+    srand( 1234 );
+    for (auto& b : Bdata)
+        b = rand() / real_t( RAND_MAX );
+    auto B = slate::Matrix<scalar_t>::fromLAPACK(
+        n, nrhs, Bdata.data(), n, nb, 1, 1, MPI_COMM_SELF );
+    auto C = slate::Matrix<scalar_t>::fromLAPACK(
+        n, nrhs, Cdata.data(), n, nb, 1, 1, MPI_COMM_SELF );
+
+    real_t Anorm = lapack::lange( Norm::Fro, n, n, Adata.data(), n );
+    real_t Bnorm = lapack::lange( Norm::Fro, n, nrhs, Bdata.data(), n );
+
+    //---------------------
+    // hemm: || T B - A B || / (|| A || || B ||)
+    slate::tlr::hemm( one, T, B, zero, C );
+    Rdata = Cdata;
+    blas::hemm( Layout::ColMajor, Side::Left, Uplo::Lower, n, nrhs,
+                -one, Adata.data(), n, Bdata.data(), n,
+                one,  Rdata.data(), n );
+    real_t err = lapack::lange( Norm::Fro, n, nrhs, Rdata.data(), n )
+               / (Anorm * Bnorm);
+    if (verbose) {
+        printf( "\nhemm  n %4lld, nb %3lld, max rank %3lld, error %8.2e, %s\n",
+                llong( n ), llong( nb ), llong( T.maxRank() ), err,
+                (err < 10*tol ? "pass" : "FAILED") );
+    }
+    test_assert( err < 10*tol );
+
+    //---------------------
+    // potrf, potrs: || A X - B || / (|| A || || X ||)
+    int64_t info = slate::tlr::potrf( T );
+    test_assert( info == 0 );
+
+    Cdata = Bdata;
+    slate::tlr::potrs( T, C );
+    Rdata = Bdata;
+    blas::hemm( Layout::ColMajor, Side::Left, Uplo::Lower, n, nrhs,
+                -one, Adata.data(), n, Cdata.data(), n,
+                one,  Rdata.data(), n );
+    real_t Xnorm = lapack::lange( Norm::Fro, n, nrhs, Cdata.data(), n );
+    err = lapack::lange( Norm::Fro, n, nrhs, Rdata.data(), n )
+        / (Anorm * Xnorm);
+    if (verbose) {
+        printf( "potrs n %4lld, nb %3lld, error %8.2e, %s\n",
+                llong( n ), llong( nb ), err,
+                (err < 10*tol ? "pass" : "FAILED") );
+    }
+    test_assert( err < 10*tol );
+}
+
+//------------------------------------------------------------------------------
+void test_tlr()
+{
+    if (mpi_rank != 0)
+        return;
+
+    // Last tile is partial in the second case.
+    test_tlr_work< float  >( 200, 50, 7 );
+    test_tlr_work< double >( 200, 50, 7 );
+    test_tlr_work< double >( 230, 64, 3 );
+    test_tlr_work< std::complex<float>  >( 200, 50, 7 );
+    test_tlr_work< std::complex<double> >( 230, 64, 3 );
+}
+
+//------------------------------------------------------------------------------
+/// Runs all tests. Called by unit test main().
+void run_tests()
+{
+    if (g_argc > 1 && std::string( g_argv[ 1 ] ) == "-v")
+        verbose = 1;
+
+    run_test( test_tlr, "tlr::compress, potrf, potrs, hemm", mpi_comm );
+}
+
+}  // namespace test
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    using namespace test;  // for globals mpi_rank, etc.
+
+    g_argc = argc;
+    g_argv = argv;
+    MPI_Init(&argc, &argv);
+    mpi_comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(mpi_comm, &mpi_rank);
+    MPI_Comm_size(mpi_comm, &mpi_size);
+
+    num_devices = blas::get_device_count();
+
+    int err = unit_test_main(mpi_comm);  // which calls run_tests()
+
+    MPI_Finalize();
+    return err;
+}
@@ -30,6 +30,113 @@ void test_gpu_aware_mpi()
     test_assert( ! slate::gpu_aware_mpi() );
 }
 
+//------------------------------------------------------------------------------
+/// Tests querying the MPI library whether it is GPU-aware.
+void test_query_gpu_aware_mpi()
+{
+    bool value = slate::internal::query_gpu_aware_mpi();
+    if (verbose)
+        printf( "\nquery_gpu_aware_mpi = %d\n", value );
+
+    // Without a GPU backend, MPI can't be GPU-aware.
+    #if ! defined( BLAS_HAVE_CUBLAS ) && ! defined( BLAS_HAVE_ROCBLAS )
+        test_assert( ! value );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Tests that internal::mpi_vector_type caches committed datatypes.
+void test_mpi_vector_type()
+{
+    MPI_Datatype type1 = slate::internal::mpi_vector_type( 30, 20, 32, MPI_DOUBLE );
+    MPI_Datatype type2 = slate::internal::mpi_vector_type( 30, 20, 32, MPI_DOUBLE );
+    MPI_Datatype type3 = slate::internal::mpi_vector_type( 30, 20, 64, MPI_DOUBLE );
+    test_assert( type1 == type2 );
+    test_assert( type1 != type3 );
+}
+
+//------------------------------------------------------------------------------
+/// Tests that internal::hierarchicalBcastPattern forms a tree over the
+/// broadcast set: every non-root rank receives exactly once, from the
+/// rank that sends to it, and at most one message per node crosses nodes.
+void test_hierarchicalBcastPattern()
+{
+    // 12 ranks on 3 nodes, root 5 on node 1.
+    std::vector<int> nodes = { 0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8 };
+    std::vector<int> bcast_ranks = { 5, 0, 1, 2, 3, 4, 7, 8, 9, 11 };
+    for (int radix : { 2, 3, 4 }) {
+        std::vector<int> recv_count( nodes.size(), 0 );
+        std::vector<int> sends_to( nodes.size(), -1 );
+        int inter_node = 0;
+        for (int rank : bcast_ranks) {
+            std::list<int> recv_from, send_to;
+            slate::internal::hierarchicalBcastPattern(
+                bcast_ranks, nodes, rank, radix, recv_from, send_to );
+            if (rank == bcast_ranks[ 0 ])
+                test_assert( recv_from.empty() );
+            else
+                test_assert( recv_from.size() == 1 );
+            for (int dst : send_to) {
+                ++recv_count[ dst ];
+                sends_to[ dst ] = rank;
+                if (nodes[ dst ] != nodes[ rank ])
+                    ++inter_node;
+            }
+            for (int src : recv_from)
+                test_assert( sends_to[ rank ] == -1 || sends_to[ rank ] == src );
+        }
+        for (int rank : bcast_ranks)
+            test_assert( recv_count[ rank ] == (rank == bcast_ranks[ 0 ] ? 0 : 1) );
+        test_assert( inter_node == 2 );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Tests that internal::tournamentReducePattern forms a tree rooted at the
+/// first rank: every other rank sends exactly once, to a rank that merges
+/// it, and with Hybrid at most one message per node crosses nodes.
+void test_tournamentReducePattern()
+{
+    // 12 ranks on 3 nodes; the panel's top rank 5 is on node 4.
+    std::vector<int> nodes = { 0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8 };
+    std::vector<int> ranks = { 5, 9, 1, 6, 10, 2, 7, 11, 3 };
+    for (auto tree : { slate::TournamentTree::Binary,
+                       slate::TournamentTree::Flat,
+                       slate::TournamentTree::Hybrid }) {
+        std::vector<int> merges( nodes.size(), 0 );
+        std::vector<int> parent( nodes.size(), -1 );
+        int inter_node = 0;
+        for (int rank : ranks) {
+            std::list<int> recv_from, send_to;
+            slate::internal::tournamentReducePattern(
+                ranks, &nodes, tree, rank, recv_from, send_to );
+            if (rank == ranks[ 0 ])
+                test_assert( send_to.empty() );
+            else
+                test_assert( send_to.size() == 1 );
+            for (int src : recv_from) {
+                ++merges[ src ];
+                parent[ src ] = rank;
+                if (nodes[ src ] != nodes[ rank ])
+                    ++inter_node;
+            }
+            if (tree == slate::TournamentTree::Flat)
+                test_assert( rank == ranks[ 0 ] || send_to.front() == ranks[ 0 ] );
+        }
+        for (int rank : ranks)
+            test_assert( merges[ rank ] == (rank == ranks[ 0 ] ? 0 : 1) );
+        // Each rank reaches the root.
+        for (int rank : ranks) {
+            int r = rank;
+            for (int hops = 0; r != ranks[ 0 ] && hops < int( ranks.size() ); ++hops)
+                r = parent[ r ];
+            test_assert( r == ranks[ 0 ] );
+        }
+        if (tree == slate::TournamentTree::Hybrid)
+            test_assert( inter_node == 2 );
+    }
+}
+
 //------------------------------------------------------------------------------
 /// Runs all tests. Called by unit test main().
 void run_tests()
@@ -37,6 +144,14 @@ void run_tests()
     if (mpi_rank == 0) {
         run_test(
             test_gpu_aware_mpi, "gpu_aware_mpi()");
+        run_test(
+            test_query_gpu_aware_mpi, "internal::query_gpu_aware_mpi()");
+        run_test(
+            test_mpi_vector_type, "internal::mpi_vector_type()");
+        run_test(
+            test_hierarchicalBcastPattern, "internal::hierarchicalBcastPattern()");
+        run_test(
+            test_tournamentReducePattern, "internal::tournamentReducePattern()");
     }
 }
 